@@ -9,9 +9,17 @@
 #include "VectorMath.h"
 #include <vector>
 #include <stack>
+#include <algorithm>
 
 #include "AABB.h"
 
+#if defined(ENABLE_TBB) && !defined(__HIPCC__)
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_invoke.h>
+#include <tbb/parallel_sort.h>
+#endif
+
 #ifndef __AABB_TREE_H__
 #define __AABB_TREE_H__
 
@@ -39,9 +47,68 @@ namespace detail
 
 const unsigned int NODE_CAPACITY = 16;           //!< Maximum number of particles in a node
 const unsigned int INVALID_NODE = 0xffffffff;   //!< Invalid node index sentinel
+const Scalar REBUILD_COST_RATIO = 1.5;          //!< Cost increase of a refitted tree that calls for a rebuild
+const Scalar REINSERT_AREA_RATIO = 1.25;        //!< Leaf area increase due to one particle that calls for reinsertion
+const unsigned int MORTON_TASK_LEAVES = 64;     //!< Smallest subtree that buildTreeMorton() builds in its own task
 
 #ifndef __HIPCC__
 
+//! Spread the lower 10 bits of \a v so that two zero bits separate each of them
+inline unsigned int mortonExpandBits(unsigned int v)
+    {
+    v = (v * 0x00010001u) & 0xFF0000FFu;
+    v = (v * 0x00000101u) & 0x0F00F00Fu;
+    v = (v * 0x00000011u) & 0xC30C30C3u;
+    v = (v * 0x00000005u) & 0x49249249u;
+    return v;
+    }
+
+//! Compute the 30-bit Morton code of a point
+/*! \param f Fractional coordinates of the point in the bounding box of all points, in [0,1]
+*/
+inline unsigned int mortonCode(const vec3<Scalar>& f)
+    {
+    unsigned int x = (unsigned int)std::min(std::max(f.x * Scalar(1024.0), Scalar(0.0)), Scalar(1023.0));
+    unsigned int y = (unsigned int)std::min(std::max(f.y * Scalar(1024.0), Scalar(0.0)), Scalar(1023.0));
+    unsigned int z = (unsigned int)std::min(std::max(f.z * Scalar(1024.0), Scalar(0.0)), Scalar(1023.0));
+    return (mortonExpandBits(x) << 2) | (mortonExpandBits(y) << 1) | mortonExpandBits(z);
+    }
+
+//! Split a range of particles sorted by Morton code
+/*! \param keys Morton code and index of each particle, sorted
+    \param begin First particle of the range
+    \param end One past the last particle of the range, at least begin + 2
+
+    \returns The first particle of the right side: the first particle with a 1 in the highest bit in which the codes
+              of the range differ, or the middle of the range when all codes are equal
+*/
+inline unsigned int mortonSplit(const std::vector< std::pair<unsigned int, unsigned int> >& keys,
+                                unsigned int begin,
+                                unsigned int end)
+    {
+    unsigned int code_first = keys[begin].first;
+    unsigned int code_last = keys[end-1].first;
+    if (code_first == code_last)
+        return begin + (end - begin) / 2;
+
+    unsigned int bit = 1u << 31;
+    while (!((code_first ^ code_last) & bit))
+        bit >>= 1;
+
+    // binary search, keys[lo] has a 0 and keys[hi] has a 1 in bit
+    unsigned int lo = begin;
+    unsigned int hi = end - 1;
+    while (hi - lo > 1)
+        {
+        unsigned int mid = lo + (hi - lo) / 2;
+        if (keys[mid].first & bit)
+            hi = mid;
+        else
+            lo = mid;
+        }
+    return hi;
+    }
+
 //! Node in an AABBTree
 /*! Stores data for a node in the AABB tree
 */
@@ -78,6 +145,10 @@ struct PYBIND11_EXPORT AABBNode
                an update will only increase the volume of nodes. The tree should be rebuilt periodically instead of
                continually updated.
     - buildTree : build an efficiently arranged tree given a complete set of AABBs, one for each particle.
+    - refit : Update the AABBs of all particles in O(N) time, keeping the tree topology. In each leaf, the particle that
+              enlarges the leaf the most is moved to the leaf that grows least to hold it. needsRebuild() compares
+              the cost of the refitted tree to the cost of the tree when it was built, so that callers can rebuild
+              when the tree quality has degraded.
 
     **Implementation details**
 
@@ -96,7 +167,7 @@ class PYBIND11_EXPORT AABBTree
     public:
         //! Construct an AABBTree
         AABBTree()
-            : m_nodes(0), m_num_nodes(0), m_node_capacity(0), m_root(0)
+            : m_nodes(0), m_num_nodes(0), m_node_capacity(0), m_root(0), m_build_cost(0)
             {
             }
 
@@ -113,6 +184,7 @@ class PYBIND11_EXPORT AABBTree
             m_num_nodes = from.m_num_nodes;
             m_node_capacity = from.m_node_capacity;
             m_root = from.m_root;
+            m_build_cost = from.m_build_cost;
             m_mapping = from.m_mapping;
 
             m_nodes = NULL;
@@ -137,6 +209,7 @@ class PYBIND11_EXPORT AABBTree
             m_num_nodes = from.m_num_nodes;
             m_node_capacity = from.m_node_capacity;
             m_root = from.m_root;
+            m_build_cost = from.m_build_cost;
             m_mapping = from.m_mapping;
 
             if (m_nodes)
@@ -162,12 +235,39 @@ class PYBIND11_EXPORT AABBTree
         //! Build a tree smartly from a list of AABBs
         inline void buildTree(AABB *aabbs, unsigned int N);
 
+        //! Build a tree from a list of AABBs sorted along a Morton curve
+        inline void buildTreeMorton(const AABB *aabbs, unsigned int N);
+
         //! Find all particles that overlap with the query AABB
         inline unsigned int query(std::vector<unsigned int>& hits, const AABB& aabb) const;
 
-        //! Update the AABB of a particle
+        //! Call a function on every leaf node that overlaps with the query AABB
+        template<class Visitor>
+        inline unsigned int traverse(const AABB& aabb, Visitor&& visit) const;
+
         inline void update(unsigned int idx, const AABB& aabb);
 
+        //! Update the AABBs of all particles without rebuilding the tree
+        inline void refit(const AABB *aabbs, unsigned int N);
+
+        //! Move a particle to the leaf that grows least to hold it
+        inline bool reinsert(unsigned int idx, const AABB *aabbs);
+
+        //! Get the cost of traversing the tree
+        inline Scalar getCost() const;
+
+        //! Test if the tree has degraded enough since it was built to need a rebuild
+        bool needsRebuild() const
+            {
+            return getCost() > REBUILD_COST_RATIO * m_build_cost;
+            }
+
+        //! Get the number of particles in the tree
+        unsigned int getNumParticles() const
+            {
+            return (unsigned int)m_mapping.size();
+            }
+
         //! Get the height of a given particle's leaf node
         inline unsigned int height(unsigned int idx);
 
@@ -247,6 +347,7 @@ class PYBIND11_EXPORT AABBTree
         unsigned int m_node_capacity;       //!< Capacity of the nodes array
         unsigned int m_root;                //!< Index to the root node of the tree
         std::vector<unsigned int> m_mapping;//!< Reverse mapping to find node given a particle index
+        Scalar m_build_cost;                //!< Cost of the tree when it was built
 
         //! Initialize the tree to hold N particles
         inline void init(unsigned int N);
@@ -254,11 +355,30 @@ class PYBIND11_EXPORT AABBTree
         //! Build a node of the tree recursively
         inline unsigned int buildNode(AABB *aabbs, std::vector<unsigned int>& idx, unsigned int start, unsigned int len, unsigned int parent);
 
+        //! Build the subtree of a range of Morton sorted leaves
+        inline AABB buildMortonNode(const AABB *aabbs,
+                                    const std::vector< std::pair<unsigned int, unsigned int> >& keys,
+                                    const std::vector<unsigned int>& leaf_begin,
+                                    unsigned int first,
+                                    unsigned int last,
+                                    unsigned int node_idx,
+                                    unsigned int parent);
+
         //! Allocate a new node
         inline unsigned int allocateNode();
 
         //! Update the skip value for a node
         inline unsigned int updateSkip(unsigned int idx);
+
+        //! Recompute the AABBs of all nodes from the particle AABBs
+        inline void refitNodes(const AABB *aabbs);
+
+        //! Get the surface area of an AABB
+        static Scalar surfaceArea(const AABB& aabb)
+            {
+            vec3<Scalar> d = aabb.getUpper() - aabb.getLower();
+            return Scalar(2.0)*(d.x*d.y + d.y*d.z + d.z*d.x);
+            }
     };
 
 
@@ -288,25 +408,37 @@ inline void AABBTree::init(unsigned int N)
 */
 inline unsigned int AABBTree::query(std::vector<unsigned int>& hits, const AABB& aabb) const
     {
-    unsigned int box_overlap_counts = 0;
+    return traverse(aabb, [&](const AABBNode& node)
+        {
+        for (unsigned int i = 0; i < node.num_particles; i++)
+            hits.push_back(node.particles[i]);
+        });
+    }
 
-    // avoid pointer indirection overhead of std::vector
-    AABBNode* nodes = &m_nodes[0];
+/*! \param aabb The AABB to query
+    \param visit Function called with the AABBNode of every intersecting leaf
+    \returns the number of box overlap checks made during the traversal
+
+    traverse() is the stackless search shared by query() and other callers that process the hits directly. Nodes are
+    stored in depth first order, so the search advances to the next node when a node overlaps with \a aabb and skips
+    the subtree of the node otherwise. Both buildTree() and buildTreeMorton() produce this layout.
+*/
+template<class Visitor>
+inline unsigned int AABBTree::traverse(const AABB& aabb, Visitor&& visit) const
+    {
+    unsigned int box_overlap_counts = 0;
 
     // stackless search
     for (unsigned int current_node_idx = 0; current_node_idx < m_num_nodes; current_node_idx++)
         {
         // cache current node pointer
-        const AABBNode& current_node = nodes[current_node_idx];
+        const AABBNode& current_node = m_nodes[current_node_idx];
 
         box_overlap_counts++;
         if (overlap(current_node.aabb, aabb))
             {
             if (current_node.left == INVALID_NODE)
-                {
-                for (unsigned int i = 0; i < current_node.num_particles; i++)
-                    hits.push_back(current_node.particles[i]);
-                }
+                visit(current_node);
             }
         else
             {
@@ -395,6 +527,235 @@ inline void AABBTree::buildTree(AABB *aabbs, unsigned int N)
 
     m_root = buildNode(aabbs, idx, 0, N, INVALID_NODE);
     updateSkip(m_root);
+    m_build_cost = getCost();
+    }
+
+/*! \param aabbs List of AABBs for each particle, indexed by particle
+    \param N Number of AABBs in the list
+
+    Builds a linear BVH: the particles are sorted by the Morton codes of their AABB centers, and each node splits its
+    range of sorted particles with mortonSplit() until at most NODE_CAPACITY particles remain for a leaf. A first pass
+    finds only the leaf ranges. A subtree of n leaves has 2n-1 nodes regardless of its shape, so the position of every
+    node in the depth first layout is then known before its parent is complete. With TBB, the Morton codes, the sort,
+    and the subtrees are computed in parallel and the node AABBs are fit bottom up as the subtrees complete. The tree quality is somewhat lower than that of buildTree(), but the build is much faster
+    for large N. Unlike buildTree(), buildTreeMorton() does not modify \a aabbs.
+*/
+inline void AABBTree::buildTreeMorton(const AABB *aabbs, unsigned int N)
+    {
+    init(N);
+    m_num_nodes = 0;
+    m_build_cost = Scalar(0.0);
+    if (N == 0)
+        return;
+
+    // bounding box of the AABB centers
+    vec3<Scalar> lower = aabbs[0].getPosition();
+    vec3<Scalar> upper = lower;
+    for (unsigned int i = 1; i < N; i++)
+        {
+        vec3<Scalar> p = aabbs[i].getPosition();
+        lower = vec3<Scalar>(std::min(lower.x, p.x), std::min(lower.y, p.y), std::min(lower.z, p.z));
+        upper = vec3<Scalar>(std::max(upper.x, p.x), std::max(upper.y, p.y), std::max(upper.z, p.z));
+        }
+    vec3<Scalar> extent = upper - lower;
+    vec3<Scalar> scale(extent.x > Scalar(0.0) ? Scalar(1.0) / extent.x : Scalar(0.0),
+                       extent.y > Scalar(0.0) ? Scalar(1.0) / extent.y : Scalar(0.0),
+                       extent.z > Scalar(0.0) ? Scalar(1.0) / extent.z : Scalar(0.0));
+
+    // sort the particles by (Morton code, index), the index breaks ties deterministically
+    std::vector< std::pair<unsigned int, unsigned int> > keys(N);
+    auto make_key = [&](unsigned int i)
+        {
+        vec3<Scalar> f = aabbs[i].getPosition() - lower;
+        keys[i] = std::make_pair(mortonCode(vec3<Scalar>(f.x * scale.x, f.y * scale.y, f.z * scale.z)), i);
+        };
+    #ifdef ENABLE_TBB
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+        [&](const tbb::blocked_range<unsigned int>& r)
+        {
+        for (unsigned int i = r.begin(); i != r.end(); ++i)
+            make_key(i);
+        });
+    tbb::parallel_sort(keys.begin(), keys.end());
+    #else
+    for (unsigned int i = 0; i < N; i++)
+        make_key(i);
+    std::sort(keys.begin(), keys.end());
+    #endif
+
+    // find the first particle of every leaf, in depth first order
+    std::vector<unsigned int> leaf_begin;
+    std::vector< std::pair<unsigned int, unsigned int> > ranges(1, std::make_pair(0u, N));
+    while (!ranges.empty())
+        {
+        std::pair<unsigned int, unsigned int> range = ranges.back();
+        ranges.pop_back();
+        if (range.second - range.first <= NODE_CAPACITY)
+            {
+            leaf_begin.push_back(range.first);
+            }
+        else
+            {
+            unsigned int split = mortonSplit(keys, range.first, range.second);
+            ranges.push_back(std::make_pair(split, range.second));
+            ranges.push_back(std::make_pair(range.first, split));
+            }
+        }
+    unsigned int n_leaves = (unsigned int)leaf_begin.size();
+    leaf_begin.push_back(N);
+
+    // allocate all nodes at once, the subtree builds write to disjoint ranges
+    unsigned int n_nodes = 2*n_leaves - 1;
+    if (n_nodes > m_node_capacity)
+        {
+        if (m_nodes)
+            free(m_nodes);
+        m_nodes = NULL;
+        m_node_capacity = 0;
+
+        int retval = posix_memalign((void**)&m_nodes, 32, n_nodes*sizeof(AABBNode));
+        if (retval != 0)
+            {
+            throw std::runtime_error("Error allocating AABBTree memory");
+            }
+        m_node_capacity = n_nodes;
+        }
+    m_num_nodes = n_nodes;
+    m_root = 0;
+
+    buildMortonNode(aabbs, keys, leaf_begin, 0, n_leaves - 1, 0, INVALID_NODE);
+    m_build_cost = getCost();
+    }
+
+/*! \param aabbs List of AABBs for each particle, indexed by particle
+    \param N Number of AABBs in the list, must match the number of particles in the tree
+
+    refit() keeps the topology of the tree and recomputes the node AABBs bottom up. When the particles have moved
+    little since the tree was built, this is much cheaper than buildTree(). Then, in each leaf, it reinserts the
+    particle whose removal would shrink the leaf the most, when that particle enlarges the leaf area by more than
+    REINSERT_AREA_RATIO. Unlike buildTree(), refit() does not modify \a aabbs.
+*/
+inline void AABBTree::refit(const AABB *aabbs, unsigned int N)
+    {
+    assert(N == m_mapping.size());
+
+    refitNodes(aabbs);
+
+    AABB prefix[NODE_CAPACITY];
+    AABB suffix[NODE_CAPACITY];
+    for (unsigned int node_idx = 0; node_idx < m_num_nodes; node_idx++)
+        {
+        const AABBNode& node = m_nodes[node_idx];
+        unsigned int n = node.num_particles;
+        if (!isNodeLeaf(node_idx) || n < 2)
+            continue;
+
+        // merge all but one particle AABB with prefix and suffix sums
+        prefix[0] = aabbs[node.particles[0]];
+        suffix[n-1] = aabbs[node.particles[n-1]];
+        for (unsigned int k = 1; k < n; k++)
+            {
+            prefix[k] = merge(prefix[k-1], aabbs[node.particles[k]]);
+            suffix[n-1-k] = merge(suffix[n-k], aabbs[node.particles[n-1-k]]);
+            }
+
+        Scalar min_area = surfaceArea(suffix[1]);
+        unsigned int min_k = 0;
+        for (unsigned int k = 1; k < n; k++)
+            {
+            Scalar area = surfaceArea(k == n-1 ? prefix[n-2] : merge(prefix[k-1], suffix[k+1]));
+            if (area < min_area)
+                {
+                min_area = area;
+                min_k = k;
+                }
+            }
+
+        if (surfaceArea(node.aabb) > REINSERT_AREA_RATIO * min_area)
+            reinsert(node.particles[min_k], aabbs);
+        }
+
+    refitNodes(aabbs);
+    }
+
+/*! \param idx Particle index to reinsert
+    \param aabbs List of AABBs for each particle, indexed by particle
+    \returns true when the particle was moved to a different leaf
+
+    reinsert() descends from the root to the leaf whose surface area grows least when it holds the particle, and moves
+    the particle there. The particle stays in place when that leaf is full, or when it is the only particle in its
+    leaf. The tree topology is unchanged. The new leaf and its parents grow to hold the particle, the old leaf shrinks
+    at the next refit().
+*/
+inline bool AABBTree::reinsert(unsigned int idx, const AABB *aabbs)
+    {
+    assert(idx < m_mapping.size());
+
+    const AABB& aabb = aabbs[idx];
+    unsigned int old_leaf = m_mapping[idx];
+
+    unsigned int node_idx = m_root;
+    while (!isNodeLeaf(node_idx))
+        {
+        unsigned int left_idx = m_nodes[node_idx].left;
+        unsigned int right_idx = m_nodes[node_idx].right;
+
+        Scalar growth_left = surfaceArea(merge(m_nodes[left_idx].aabb, aabb)) - surfaceArea(m_nodes[left_idx].aabb);
+        Scalar growth_right = surfaceArea(merge(m_nodes[right_idx].aabb, aabb)) - surfaceArea(m_nodes[right_idx].aabb);
+        node_idx = (growth_left <= growth_right) ? left_idx : right_idx;
+        }
+
+    if (node_idx == old_leaf || m_nodes[node_idx].num_particles >= NODE_CAPACITY
+        || m_nodes[old_leaf].num_particles < 2)
+        return false;
+
+    // remove the particle from the old leaf
+    AABBNode& old_node = m_nodes[old_leaf];
+    for (unsigned int k = 0; k < old_node.num_particles; k++)
+        {
+        if (old_node.particles[k] == idx)
+            {
+            old_node.particles[k] = old_node.particles[old_node.num_particles-1];
+            old_node.particle_tags[k] = old_node.particle_tags[old_node.num_particles-1];
+            old_node.num_particles--;
+            break;
+            }
+        }
+
+    // and add it to the new one
+    AABBNode& new_node = m_nodes[node_idx];
+    new_node.particles[new_node.num_particles] = idx;
+    new_node.particle_tags[new_node.num_particles] = aabb.tag;
+    new_node.num_particles++;
+    m_mapping[idx] = node_idx;
+
+    update(idx, aabb);
+    return true;
+    }
+
+/*! \returns The cost of the tree
+
+    The cost is the surface area heuristic: the sum of the surface areas of the internal nodes, plus the surface areas
+    of the leaves times the number of particles in them, relative to the surface area of the root. It is proportional
+    to the expected number of box overlap and particle checks in a query.
+*/
+inline Scalar AABBTree::getCost() const
+    {
+    if (m_num_nodes == 0)
+        return Scalar(0.0);
+
+    Scalar root_area = surfaceArea(m_nodes[m_root].aabb);
+    if (root_area <= Scalar(0.0))
+        return Scalar(0.0);
+
+    Scalar cost(0.0);
+    for (unsigned int node_idx = 0; node_idx < m_num_nodes; node_idx++)
+        {
+        const AABBNode& node = m_nodes[node_idx];
+        cost += surfaceArea(node.aabb) * (isNodeLeaf(node_idx) ? Scalar(node.num_particles) : Scalar(1.0));
+        }
+
+    return cost / root_area;
     }
 
 /*! \param aabbs List of AABBs
@@ -548,6 +909,85 @@ inline unsigned int AABBTree::buildNode(AABB *aabbs,
     return my_idx;
     }
 
+/*! \param aabbs List of AABBs for each particle, indexed by particle
+    \param keys Morton code and index of each particle, sorted
+    \param leaf_begin First sorted particle of each leaf, followed by the number of particles
+    \param first First leaf of the subtree
+    \param last Last leaf of the subtree (inclusive)
+    \param node_idx Index of the root node of the subtree
+    \param parent Index of the parent node
+    \returns The AABB of the subtree
+
+    The node splits its particles where the first pass in buildTreeMorton() did, which is always the start of a leaf.
+    The left subtree directly follows \a node_idx and the right subtree follows the 2*n_left - 1 nodes of the left
+    subtree.
+*/
+inline AABB AABBTree::buildMortonNode(const AABB *aabbs,
+                                      const std::vector< std::pair<unsigned int, unsigned int> >& keys,
+                                      const std::vector<unsigned int>& leaf_begin,
+                                      unsigned int first,
+                                      unsigned int last,
+                                      unsigned int node_idx,
+                                      unsigned int parent)
+    {
+    AABBNode& node = m_nodes[node_idx];
+    node.parent = parent;
+
+    if (first == last)
+        {
+        unsigned int begin = leaf_begin[first];
+        unsigned int end = leaf_begin[first+1];
+
+        node.left = node.right = INVALID_NODE;
+        node.skip = 0;
+        node.num_particles = end - begin;
+        node.aabb = aabbs[keys[begin].second];
+        for (unsigned int k = begin; k < end; k++)
+            {
+            unsigned int idx = keys[k].second;
+            node.particles[k - begin] = idx;
+            node.particle_tags[k - begin] = aabbs[idx].tag;
+            node.aabb = merge(node.aabb, aabbs[idx]);
+
+            // each particle is in exactly one leaf, so concurrent builds write different elements
+            m_mapping[idx] = node_idx;
+            }
+        return node.aabb;
+        }
+
+    // the left side ends with the leaf before the one that starts at the split
+    unsigned int split_begin = mortonSplit(keys, leaf_begin[first], leaf_begin[last+1]);
+    unsigned int split = (unsigned int)(std::lower_bound(leaf_begin.begin() + first + 1,
+                                                         leaf_begin.begin() + last + 1,
+                                                         split_begin) - leaf_begin.begin()) - 1;
+
+    unsigned int n_left = split - first + 1;
+    unsigned int left_idx = node_idx + 1;
+    unsigned int right_idx = node_idx + 2*n_left;
+
+    AABB left_aabb, right_aabb;
+    auto build_left = [&]() { left_aabb = buildMortonNode(aabbs, keys, leaf_begin, first, split, left_idx, node_idx); };
+    auto build_right = [&]() { right_aabb = buildMortonNode(aabbs, keys, leaf_begin, split + 1, last, right_idx, node_idx); };
+    #ifdef ENABLE_TBB
+    if (last - first + 1 >= MORTON_TASK_LEAVES)
+        {
+        tbb::parallel_invoke(build_left, build_right);
+        }
+    else
+    #endif
+        {
+        build_left();
+        build_right();
+        }
+
+    node.left = left_idx;
+    node.right = right_idx;
+    node.skip = 2*(last - first + 1) - 2;
+    node.num_particles = 0;
+    node.aabb = merge(left_aabb, right_aabb);
+    return node.aabb;
+    }
+
 /*! \param idx Index of the node to update
 
     updateSkip() updates the skip field of every node in the tree. The skip field is used in the stackless
@@ -574,6 +1014,33 @@ inline unsigned int AABBTree::updateSkip(unsigned int idx)
         }
     }
 
+/*! \param aabbs List of AABBs for each particle, indexed by particle
+
+    buildNode() allocates the children after their parent, so a reverse sweep over the nodes updates the children
+    first.
+*/
+inline void AABBTree::refitNodes(const AABB *aabbs)
+    {
+    for (unsigned int node_idx = m_num_nodes; node_idx-- > 0; )
+        {
+        AABBNode& node = m_nodes[node_idx];
+        if (node.left == INVALID_NODE)
+            {
+            node.aabb = aabbs[node.particles[0]];
+            node.particle_tags[0] = aabbs[node.particles[0]].tag;
+            for (unsigned int k = 1; k < node.num_particles; k++)
+                {
+                node.aabb = merge(node.aabb, aabbs[node.particles[k]]);
+                node.particle_tags[k] = aabbs[node.particles[k]].tag;
+                }
+            }
+        else
+            {
+            node.aabb = merge(m_nodes[node.left].aabb, m_nodes[node.right].aabb);
+            }
+        }
+    }
+
 /*! Allocates a new node in the tree
 */
 inline unsigned int AABBTree::allocateNode()
@@ -95,6 +95,16 @@ class PYBIND11_EXPORT Analyzer
             return PDataFlags(0);
             }
 
+        //! Get the particle data arrays read on the host
+        /*! On the steps an analyzer runs, System copies the arrays that all triggered analyzers return here to the
+            host in one batch before the first analyzer runs. Derived classes that read particle data on the host
+            should return the arrays they access.
+        */
+        virtual HostArrays getRequestedHostArrays()
+            {
+            return HostArrays();
+            }
+
         std::shared_ptr<const ExecutionConfiguration> getExecConf()
             {
             return m_exec_conf;
@@ -133,6 +143,12 @@ class PYBIND11_EXPORT Analyzer
         /// Python will notify C++ objects when they are detached from Simulation
         virtual void notifyDetach() { };
 
+        //! Complete any output that is still pending
+        /*! Analyzers that perform output asynchronously must complete it in flush(). System calls flush() on all
+            analyzers at the end of every run().
+        */
+        virtual void flush() { }
+
     protected:
         const std::shared_ptr<SystemDefinition> m_sysdef; //!< The system definition this analyzer is associated with
         const std::shared_ptr<ParticleData> m_pdata;      //!< The particle data this analyzer is associated with
@@ -11,6 +11,7 @@
 #include <stdexcept>
 #include <algorithm>
 #include <cfloat>
+#include <numeric>
 
 using namespace std;
 namespace py = pybind11;
@@ -57,14 +58,30 @@ Autotuner::Autotuner(const std::vector<unsigned int>& parameters,
 
     m_current_param = m_parameters[m_current_element];
 
-    // create CUDA events
+    // create CUDA events, CPU execution configurations time with the wall clock
+    m_gpu_timing = false;
     #ifdef ENABLE_HIP
-    hipEventCreate(&m_start);
-    hipEventCreate(&m_stop);
-    CHECK_CUDA_ERROR();
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        m_gpu_timing = true;
+        hipEventCreate(&m_start);
+        hipEventCreate(&m_stop);
+        CHECK_CUDA_ERROR();
+        }
     #endif
 
     m_sync = false;
+    m_database_checked = false;
+
+    m_search = search_exhaustive;
+    m_budget = 0;
+    m_launches = 0;
+    m_num_taken.resize(m_parameters.size(), 0);
+    m_candidate = 0;
+    m_stage_samples = 1;
+    m_scan_set.resize(m_parameters.size());
+    std::iota(m_scan_set.begin(), m_scan_set.end(), 0);
+    m_scan_pos = 0;
     }
 
 
@@ -121,41 +138,70 @@ Autotuner::Autotuner(unsigned int start,
 
     m_current_param = m_parameters[m_current_element];
 
-    // create CUDA events
+    // create CUDA events, CPU execution configurations time with the wall clock
+    m_gpu_timing = false;
     #ifdef ENABLE_HIP
-    hipEventCreate(&m_start);
-    hipEventCreate(&m_stop);
-    CHECK_CUDA_ERROR();
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        m_gpu_timing = true;
+        hipEventCreate(&m_start);
+        hipEventCreate(&m_stop);
+        CHECK_CUDA_ERROR();
+        }
     #endif
 
     m_sync = false;
+    m_database_checked = false;
+
+    m_search = search_exhaustive;
+    m_budget = 0;
+    m_launches = 0;
+    m_num_taken.resize(m_parameters.size(), 0);
+    m_candidate = 0;
+    m_stage_samples = 1;
+    m_scan_set.resize(m_parameters.size());
+    std::iota(m_scan_set.begin(), m_scan_set.end(), 0);
+    m_scan_pos = 0;
     }
 
 Autotuner::~Autotuner()
     {
     m_exec_conf->msg->notice(5) << "Destroying Autotuner " << m_name << endl;
     #ifdef ENABLE_HIP
-    hipEventDestroy(m_start);
-    hipEventDestroy(m_stop);
-    CHECK_CUDA_ERROR();
+    if (m_gpu_timing)
+        {
+        hipEventDestroy(m_start);
+        hipEventDestroy(m_stop);
+        CHECK_CUDA_ERROR();
+        }
     #endif
     }
 
 void Autotuner::begin()
     {
+    if (!m_database_checked)
+        seedFromDatabase();
+
     // skip if disabled
     if (!m_enabled)
         return;
 
-    #ifdef ENABLE_HIP
-    // if we are scanning, record a cuda event - otherwise do nothing
+    // if we are scanning, record a cuda event or the wall clock time - otherwise do nothing
     if (m_state == STARTUP || m_state == SCANNING)
         {
-        hipEventRecord(m_start, 0);
-        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
+        #ifdef ENABLE_HIP
+        if (m_gpu_timing)
+            {
+            hipEventRecord(m_start, 0);
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+        else
+        #endif
+            {
+            m_start_time = std::chrono::steady_clock::now();
+            }
         }
-    #endif
     }
 
 void Autotuner::end()
@@ -164,23 +210,44 @@ void Autotuner::end()
     if (!m_enabled)
         return;
 
-    #ifdef ENABLE_HIP
+    // fill the samples of each element in order, then overwrite them in a circular fashion
+    unsigned int slot = m_current_sample;
+    if ((m_state == STARTUP || m_state == SCANNING) && m_num_taken[m_current_element] < m_nsamples)
+        slot = m_num_taken[m_current_element];
+
     // handle timing updates if scanning
     if (m_state == STARTUP || m_state == SCANNING)
         {
-        hipEventRecord(m_stop, 0);
-        hipEventSynchronize(m_stop);
-        hipEventElapsedTime(&m_samples[m_current_element][m_current_sample], m_start, m_stop);
-        m_exec_conf->msg->notice(9) << "Autotuner " << m_name << ": t(" << m_current_param << "," << m_current_sample
-                                     << ") = " << m_samples[m_current_element][m_current_sample] << endl;
-
-        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
+        #ifdef ENABLE_HIP
+        if (m_gpu_timing)
+            {
+            hipEventRecord(m_stop, 0);
+            hipEventSynchronize(m_stop);
+            hipEventElapsedTime(&m_samples[m_current_element][slot], m_start, m_stop);
+
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+        else
+        #endif
+            {
+            std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - m_start_time;
+            m_samples[m_current_element][slot] = elapsed.count();
+            }
+
+        m_exec_conf->msg->notice(9) << "Autotuner " << m_name << ": t(" << m_current_param << "," << slot
+                                     << ") = " << m_samples[m_current_element][slot] << endl;
         }
-    #endif
+
+    if ((m_state == STARTUP || m_state == SCANNING) && m_num_taken[m_current_element] < m_nsamples)
+        m_num_taken[m_current_element]++;
 
     // handle state data updates and transitions
-    if (m_state == STARTUP)
+    if (m_state == STARTUP && m_search == search_halving)
+        {
+        advanceHalving();
+        }
+    else if (m_state == STARTUP)
         {
         // move on to the next sample
         m_current_sample++;
@@ -207,14 +274,15 @@ void Autotuner::end()
         }
     else if (m_state == SCANNING)
         {
-        // move on to the next element
-        m_current_element++;
+        // move on to the next element of the scan set
+        m_scan_pos++;
 
-        // if we hit the end of the elements, transition to the IDLE state and compute the optimal parameter, and move
+        // if we hit the end of the scan set, transition to the IDLE state and compute the optimal parameter, and move
         // on to the next sample for next time
-        if (m_current_element >= m_parameters.size())
+        if (m_scan_pos >= m_scan_set.size())
             {
-            m_current_element = 0;
+            m_scan_pos = 0;
+            m_current_element = m_scan_set[0];
             m_state = IDLE;
             m_current_param = computeOptimalParameter();
             m_current_sample = (m_current_sample + 1) % m_nsamples;
@@ -222,6 +290,7 @@ void Autotuner::end()
         else
             {
             // if moving on to the next element, update the cached parameter to set
+            m_current_element = m_scan_set[m_scan_pos];
             m_current_param = m_parameters[m_current_element];
             }
         }
@@ -236,6 +305,8 @@ void Autotuner::end()
             m_calls = 0;
 
             // initialize a scan
+            m_scan_pos = 0;
+            m_current_element = m_scan_set[0];
             m_current_param = m_parameters[m_current_element];
             m_state = SCANNING;
             m_exec_conf->msg->notice(4) << "Autotuner " << m_name << " - beginning scan" << std::endl;
@@ -243,12 +314,90 @@ void Autotuner::end()
         }
     }
 
-/*! \returns The optimal parameter given the current data in m_samples
+/*! Successive halving samples all candidates once per pass. When every candidate has m_stage_samples samples, the
+    slower half of the candidates is dropped and the number of samples per candidate doubles, up to m_nsamples. The
+    sweep ends with one candidate left, with m_nsamples samples of each candidate, or when the budget is used up.
+*/
+void Autotuner::advanceHalving()
+    {
+    m_launches++;
 
-    computeOptimalParameter computes the median time among all samples for a given element. It then chooses the
-    fastest time (with the lowest index breaking a tie) and returns the parameter that resulted in that time.
+    // move on to the next candidate of this pass
+    m_candidate++;
+    if (m_candidate >= m_candidates.size())
+        {
+        m_candidate = 0;
+
+        // every pass adds one sample to each candidate, so all candidates complete a stage together
+        if (m_num_taken[m_candidates[0]] >= m_stage_samples)
+            {
+            std::vector<float> medians = computeMedians();
+            std::stable_sort(m_candidates.begin(), m_candidates.end(),
+                             [&medians](unsigned int a, unsigned int b) { return medians[a] < medians[b]; });
+            m_candidates.resize((m_candidates.size() + 1) / 2);
+
+            if (m_candidates.size() == 1 || m_stage_samples >= m_nsamples)
+                {
+                finishHalving(medians);
+                return;
+                }
+
+            m_stage_samples = std::min(2 * m_stage_samples, m_nsamples);
+            m_exec_conf->msg->notice(5) << "Autotuner " << m_name << " keeps " << m_candidates.size()
+                                        << " candidates, " << m_stage_samples << " samples each" << endl;
+            }
+        }
+
+    if (m_budget > 0 && m_launches >= m_budget)
+        {
+        m_exec_conf->msg->notice(4) << "Autotuner " << m_name << " used its budget of " << m_budget
+                                    << " launches" << endl;
+        finishHalving(computeMedians());
+        return;
+        }
+
+    m_current_element = m_candidates[m_candidate];
+    m_current_param = m_parameters[m_current_element];
+    }
+
+/*! \param medians Median time of each element
+
+    The fastest measured elements, at most four, are remeasured by later scans.
 */
-unsigned int Autotuner::computeOptimalParameter()
+void Autotuner::finishHalving(const std::vector<float>& medians)
+    {
+    std::vector<unsigned int> order(m_parameters.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&medians](unsigned int a, unsigned int b) { return medians[a] < medians[b]; });
+
+    m_scan_set.clear();
+    for (unsigned int i = 0; i < order.size() && m_scan_set.size() < 4; i++)
+        {
+        if (m_num_taken[order[i]] > 0)
+            m_scan_set.push_back(order[i]);
+        }
+
+    m_state = IDLE;
+    m_calls = 0;
+    m_scan_pos = 0;
+    m_current_sample = 0;
+    m_current_element = m_scan_set[0];
+    m_current_param = m_parameters[m_current_element];
+
+    m_exec_conf->msg->notice(4) << "Autotuner " << m_name << " found optimal parameter " << m_current_param
+                                << " after " << m_launches << " launches" << endl;
+    m_exec_conf->getAutotunerDatabase()->record(m_key, m_current_param, medians[m_current_element]);
+    }
+
+/*! 
+eturns The median (or average, or maximum) time of the samples taken of each element, FLT_MAX for elements
+             without samples
+
+    With synchronization, the samples of all ranks are combined on rank zero and the result is broadcast, so all ranks
+    make the same choices.
+*/
+std::vector<float> Autotuner::computeMedians()
     {
     bool is_root = true;
 
@@ -261,11 +410,10 @@ unsigned int Autotuner::computeOptimalParameter()
         }
     #endif
 
-    // start by computing the median for each element
     std::vector<float> v;
     for (unsigned int i = 0; i < m_parameters.size(); i++)
         {
-        v = m_samples[i];
+        v.assign(m_samples[i].begin(), m_samples[i].begin() + m_num_taken[i]);
         #ifdef ENABLE_MPI
         if (m_sync && nranks)
             {
@@ -284,7 +432,11 @@ unsigned int Autotuner::computeOptimalParameter()
         #endif
         if (is_root)
             {
-            if (m_mode == mode_avg)
+            if (v.size() == 0)
+                {
+                m_sample_median[i] = FLT_MAX;
+                }
+            else if (m_mode == mode_avg)
                 {
                 // compute average
                 float sum = 0.0f;
@@ -314,44 +466,120 @@ unsigned int Autotuner::computeOptimalParameter()
             }
         }
 
-    unsigned int opt = 0;
+    #ifdef ENABLE_MPI
+    if (m_sync && nranks)
+        bcast(m_sample_median, 0, m_exec_conf->getMPICommunicator());
+    #endif
 
-    if (is_root)
-        {
-        // now find the minimum and maximum times in the medians
-        float min = m_sample_median[0];
-        unsigned int min_idx = 0;
-        //float max = m_sample_median[0];
-        //unsigned int max_idx = 0;
+    return m_sample_median;
+    }
 
-        for (unsigned int i = 1; i < m_parameters.size(); i++)
-            {
-            if (m_sample_median[i] < min)
-                {
-                min = m_sample_median[i];
-                min_idx = i;
-                }
-            /*if (m_sample_median[i] > max)
-                {
-                max = m_sample_median[i];
-                max_idx = i;
-                }*/
-            }
+/*! \returns The optimal parameter given the current data in m_samples
 
-        // get the optimal param
-        opt = m_parameters[min_idx];
-        // unsigned int percent = int(max/min * 100.0f)-100;
+    computeOptimalParameter computes the median time among all samples for a given element. It then chooses the
+    fastest time (with the lowest index breaking a tie) and returns the parameter that resulted in that time.
+*/
+unsigned int Autotuner::computeOptimalParameter()
+    {
+    std::vector<float> medians = computeMedians();
 
-        // print stats
-        m_exec_conf->msg->notice(4) << "Autotuner " << m_name << " found optimal parameter " << opt << endl;
+    // only the elements of the scan set have up to date samples
+    unsigned int min_idx = m_scan_set[0];
+    for (unsigned int i = 1; i < m_scan_set.size(); i++)
+        {
+        if (medians[m_scan_set[i]] < medians[min_idx])
+            min_idx = m_scan_set[i];
         }
 
+    // get the optimal param
+    unsigned int opt = m_parameters[min_idx];
+    float opt_time = medians[min_idx];
+
+    // print stats
+    bool is_root = true;
     #ifdef ENABLE_MPI
-    if (m_sync && nranks) bcast(opt, 0, m_exec_conf->getMPICommunicator());
+    if (m_sync)
+        is_root = !m_exec_conf->getRank();
     #endif
+    if (is_root)
+        m_exec_conf->msg->notice(4) << "Autotuner " << m_name << " found optimal parameter " << opt << endl;
+
+    m_exec_conf->getAutotunerDatabase()->record(m_key, opt, opt_time);
     return opt;
     }
 
+/*! The key names the device by the descriptions of the active GPUs without their indices, so ranks that run on
+    different GPUs of the same model share entries. Wall clock timings also depend on the number of CPU threads.
+*/
+void Autotuner::seedFromDatabase()
+    {
+    m_database_checked = true;
+
+    std::string device;
+    std::vector<std::string> descriptions = m_exec_conf->getActiveDevices();
+    for (unsigned int i = 0; i < descriptions.size(); i++)
+        {
+        std::string description = descriptions[i];
+        size_t start = description.find(']');
+        start = (start == std::string::npos) ? 0 : start+1;
+        start = description.find_first_not_of(' ', start);
+        if (i > 0)
+            device += ",";
+        if (start != std::string::npos)
+            device += description.substr(start);
+        }
+
+    #ifdef ENABLE_TBB
+    if (!m_gpu_timing)
+        device += " x" + std::to_string(m_exec_conf->getNumThreads());
+    #endif
+
+    std::shared_ptr<AutotunerDatabase> database = m_exec_conf->getAutotunerDatabase();
+    m_key = database->makeKey(m_name, device, m_parameters);
+
+    unsigned int param;
+    float time;
+    unsigned int idx = (unsigned int)m_parameters.size();
+    if (database->lookup(m_key, param, time))
+        idx = (unsigned int)(std::find(m_parameters.begin(), m_parameters.end(), param) - m_parameters.begin());
+
+    if (idx == m_parameters.size())
+        {
+        if (m_search == search_halving)
+            {
+            // start successive halving with all parameters as candidates
+            m_candidates.resize(m_parameters.size());
+            std::iota(m_candidates.begin(), m_candidates.end(), 0);
+            m_candidate = 0;
+            m_stage_samples = 1;
+            m_launches = 0;
+            m_current_element = m_candidates[0];
+            m_current_param = m_parameters[m_current_element];
+            }
+        return;
+        }
+
+    // the other parameters have not been measured yet
+    for (unsigned int i = 0; i < m_parameters.size(); i++)
+        std::fill(m_samples[i].begin(), m_samples[i].end(), i == idx ? time : FLT_MAX);
+    std::fill(m_num_taken.begin(), m_num_taken.end(), m_nsamples);
+
+    // successive halving only rescans the stored parameter
+    if (m_search == search_halving)
+        m_scan_set.assign(1, idx);
+
+    m_state = IDLE;
+    m_current_element = 0;
+    m_current_sample = 0;
+    m_calls = 0;
+    m_current_param = param;
+    m_exec_conf->msg->notice(4) << "Autotuner " << m_name << " starts with parameter " << param
+                                << " from the database" << endl;
+
+    if (database->getFrozen())
+        m_enabled = false;
+    }
+
 void export_Autotuner(py::module& m)
     {
     py::class_<Autotuner>(m,"Autotuner")
@@ -12,6 +12,7 @@
 
 #include "ExecutionConfiguration.h"
 
+#include <chrono>
 #include <vector>
 #include <string>
 
@@ -23,7 +24,7 @@
 #include <pybind11/pybind11.h>
 #endif
 
-//! Autotuner for low level GPU kernel parameters
+//! Autotuner for low level GPU kernel parameters and CPU code paths
 /*! **Overview** <br>
     Autotuner is a helper class that autotunes GPU kernel parameters (such as block size) for performance. It runs an
     internal state machine and makes sweeps over all valid parameter values. Performance is measured just for the single
@@ -42,17 +43,31 @@
     isComplete() queries if the initial scan is complete. setPeriod() changes the period at which the autotuner performs
     new scans.
 
+    The exhaustive search takes all samples of every parameter in the initial sweep. Large parameter spaces, such as
+    the block size and group size pairs of the HPMC kernels, can select successive halving with setSearch() instead.
+    It takes one sample of every parameter, drops the slower half, and doubles the number of samples of the remaining
+    candidates until one is left or each has the full number of samples. With P parameters, this takes about
+    P (1 + log2(nsamples)/2) launches instead of P nsamples. An optional budget caps the number of launches in the sweep. Later scans only
+    remeasure the fastest four parameters of the sweep.
+
     Each Autotuner instance has a string name to help identify it's output on the notice stream.
 
-    Autotuner is not useful in non-GPU builds. Timing is performed with CUDA events and requires ENABLE_HIP=on.
-    Behavior of Autotuner is undefined when ENABLE_HIP=off.
+    Before its first sample, the Autotuner looks up its name, the GPU model, the system size, and its parameters in
+    the AutotunerDatabase of the execution configuration. When it finds an entry, it starts in the idle state with the
+    stored parameter and skips the initial sweep. The samples of the other parameters start at FLT_MAX, so the stored
+    parameter stays optimal until later scans have measured more than half of the samples of another one. The result
+    of every sweep and scan is recorded in the database. Autotuners seeded from a frozen database are disabled.
+
+    With an execution configuration that does not use the GPU, Autotuner times the code between begin() and end()
+    with the wall clock instead. CPU code uses it to choose between alternatives of the same computation, such as the
+    TBB grain size of a parallel loop. The database key of such an Autotuner includes the number of TBB threads.
 
     ** Implementation ** <br>
     Internally, m_nsamples is the number of samples to take (odd for median computation). m_current_sample is the
     current sample being taken in a circular fashion, and m_current_element is the index of the current parameter being
     sampled. m_samples stores the time of each sampled kernel launch, and m_sample_median stores the current median of
     each set of samples. When idle, the number of calls is counted in m_calls. m_state lists the current state in the
-    state machine.
+    state machine. m_num_taken counts the samples of each element, and scans visit the elements in m_scan_set.
 */
 class PYBIND11_EXPORT Autotuner
     {
@@ -90,6 +105,8 @@ class PYBIND11_EXPORT Autotuner
         */
         unsigned int getParam()
             {
+            if (!m_database_checked)
+                seedFromDatabase();
             return m_current_param;
             }
 
@@ -181,6 +198,24 @@ class PYBIND11_EXPORT Autotuner
             m_mode = mode;
             }
 
+        //! Search strategies for the initial sweep
+        enum search_Enum {
+            search_exhaustive = 0, //!< All samples of every parameter
+            search_halving         //!< Successive halving
+            };
+
+        //! Set the search strategy of the initial sweep
+        /*! \param search Search strategy
+            \param budget Maximum number of kernel launches in a successive halving sweep, 0 for no limit
+
+            Call before the first kernel launch.
+         */
+        void setSearch(search_Enum search, unsigned int budget=0)
+            {
+            m_search = search;
+            m_budget = budget;
+            }
+
 
         //! build list of thread per particle targets
         static std::vector<unsigned int> getTppListPow2(unsigned int warpSize)
@@ -199,6 +234,18 @@ class PYBIND11_EXPORT Autotuner
     protected:
         unsigned int computeOptimalParameter();
 
+        //! Compute the median time of each element from the samples taken
+        std::vector<float> computeMedians();
+
+        //! Advance the successive halving sweep after a sample
+        void advanceHalving();
+
+        //! End the successive halving sweep
+        void finishHalving(const std::vector<float>& medians);
+
+        //! Start with the parameter stored in the database, if there is one
+        void seedFromDatabase();
+
         //! State names
         enum State
            {
@@ -230,9 +277,24 @@ class PYBIND11_EXPORT Autotuner
         hipEvent_t m_start;      //!< CUDA event for recording start times
         hipEvent_t m_stop;       //!< CUDA event for recording end times
         #endif
+        bool m_gpu_timing;       //!< True when timing with CUDA events, false for the wall clock
+        std::chrono::steady_clock::time_point m_start_time; //!< Wall clock time of the last begin()
 
         bool m_sync;              //!< If true, synchronize results via MPI
         mode_Enum m_mode;         //!< The sampling mode
+
+        bool m_database_checked;  //!< True once the database has been searched for m_key
+        std::string m_key;        //!< Key of this Autotuner in the database
+
+        search_Enum m_search;       //!< Search strategy of the initial sweep
+        unsigned int m_budget;      //!< Maximum number of launches of a successive halving sweep, 0 for no limit
+        unsigned int m_launches;    //!< Number of launches in the successive halving sweep
+        std::vector<unsigned int> m_num_taken;  //!< Number of samples taken of each element, at most m_nsamples
+        std::vector<unsigned int> m_candidates; //!< Remaining elements of the successive halving sweep
+        unsigned int m_candidate;       //!< Index of the current candidate in m_candidates
+        unsigned int m_stage_samples;   //!< Number of samples of each candidate in the current stage
+        std::vector<unsigned int> m_scan_set;   //!< Elements that scans remeasure
+        unsigned int m_scan_pos;        //!< Index of the current element in m_scan_set
     };
 
 //! Export the Autotuner class to python
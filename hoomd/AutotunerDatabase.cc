@@ -0,0 +1,154 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file AutotunerDatabase.cc
+    \brief Defines AutotunerDatabase
+*/
+
+#include "AutotunerDatabase.h"
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace py = pybind11;
+using namespace std;
+
+AutotunerDatabase::AutotunerDatabase()
+    : m_problem_size(0), m_frozen(false)
+    {
+    }
+
+/*! \param filename File to read
+
+    Entries of the file replace entries with the same key.
+*/
+void AutotunerDatabase::load(const std::string& filename)
+    {
+    ifstream f(filename.c_str());
+    if (!f.good())
+        throw runtime_error("Unable to open autotuner database " + filename);
+
+    string line;
+    unsigned int line_number = 0;
+    while (getline(f, line))
+        {
+        line_number++;
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        size_t tab1 = line.find('\t');
+        size_t tab2 = tab1 == string::npos ? string::npos : line.find('\t', tab1+1);
+        if (tab2 == string::npos)
+            {
+            ostringstream s;
+            s << "Malformed entry on line " << line_number << " of autotuner database " << filename;
+            throw runtime_error(s.str());
+            }
+
+        Entry entry;
+        istringstream values(line.substr(tab1+1));
+        if (!(values >> entry.param >> entry.time))
+            {
+            ostringstream s;
+            s << "Malformed entry on line " << line_number << " of autotuner database " << filename;
+            throw runtime_error(s.str());
+            }
+
+        m_entries[line.substr(0, tab1)] = entry;
+        }
+    }
+
+/*! \param filename File to write, overwritten
+*/
+void AutotunerDatabase::save(const std::string& filename) const
+    {
+    ofstream f(filename.c_str());
+    if (!f.good())
+        throw runtime_error("Unable to open autotuner database " + filename + " for writing");
+
+    f << "# HOOMD-blue autotuner database: key, parameter, time [ms]" << endl;
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        f << it->first << '\t' << it->second.param << '\t' << it->second.time << '\n';
+
+    if (!f.good())
+        throw runtime_error("Error writing autotuner database " + filename);
+    }
+
+/*! \param name Name of the Autotuner
+    \param device Description of the device the kernel runs on
+    \param parameters Valid parameters of the Autotuner
+
+    The number of particles enters the key as the exponent of the largest power of two that does not exceed it. The
+    parameter list enters as its length and FNV-1a hash, so changing the parameter space of a kernel invalidates its
+    entries.
+*/
+std::string AutotunerDatabase::makeKey(const std::string& name,
+                                       const std::string& device,
+                                       const std::vector<unsigned int>& parameters) const
+    {
+    unsigned int log2_N = 0;
+    while ((m_problem_size >> (log2_N+1)) != 0)
+        log2_N++;
+
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned int i = 0; i < parameters.size(); i++)
+        {
+        for (unsigned int byte = 0; byte < sizeof(unsigned int); byte++)
+            {
+            hash ^= (parameters[i] >> (8*byte)) & 0xff;
+            hash *= 1099511628211ull;
+            }
+        }
+
+    ostringstream s;
+    s << name << '|' << device << "|N=2^" << log2_N << "|P=" << parameters.size() << ':' << hex << hash;
+    return s.str();
+    }
+
+/*! \param key Key to look up
+    \param param Tuned parameter (output)
+    \param time Kernel time of the tuned parameter in milliseconds (output)
+    \returns true when the key is in the database
+*/
+bool AutotunerDatabase::lookup(const std::string& key, unsigned int& param, float& time) const
+    {
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return false;
+
+    param = it->second.param;
+    time = it->second.time;
+    return true;
+    }
+
+/*! \param key Key of the Autotuner
+    \param param Tuned parameter
+    \param time Kernel time of the tuned parameter in milliseconds
+*/
+void AutotunerDatabase::record(const std::string& key, unsigned int param, float time)
+    {
+    if (m_frozen)
+        return;
+
+    Entry entry;
+    entry.param = param;
+    entry.time = time;
+    m_entries[key] = entry;
+    }
+
+void export_AutotunerDatabase(py::module& m)
+    {
+    py::class_<AutotunerDatabase, std::shared_ptr<AutotunerDatabase> >(m, "AutotunerDatabase")
+    .def(py::init<>())
+    .def("load", &AutotunerDatabase::load)
+    .def("save", &AutotunerDatabase::save)
+    .def("clear", &AutotunerDatabase::clear)
+    .def("getNumEntries", &AutotunerDatabase::getNumEntries)
+    .def("setProblemSize", &AutotunerDatabase::setProblemSize)
+    .def("getProblemSize", &AutotunerDatabase::getProblemSize)
+    .def("setFrozen", &AutotunerDatabase::setFrozen)
+    .def("getFrozen", &AutotunerDatabase::getFrozen)
+    ;
+    }
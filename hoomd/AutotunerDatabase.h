@@ -0,0 +1,106 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+/*! \file AutotunerDatabase.h
+    \brief Declares a database of tuned kernel parameters shared by the Autotuners of an execution configuration
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+//! Database of tuned kernel parameters
+/*! Every Autotuner of an ExecutionConfiguration looks up its key in the shared database before its first sample. When
+    the key is found, the Autotuner starts with the stored parameter instead of sweeping all parameters first, and
+    records the result of every later scan. load() and save() persist the database in a text file, so that tuning
+    results carry over between jobs.
+
+    The key combines the name of the Autotuner, the model of the GPU, the power of two range of the number of particles
+    (set by ParticleData with setProblemSize()), and a hash of the parameter list. A frozen database is never updated,
+    and the Autotuners seeded from it do not scan at all.
+
+    The file has one entry per line: the key, the parameter, and the kernel time in milliseconds, separated by tabs.
+    Lines starting with # are comments.
+*/
+class PYBIND11_EXPORT AutotunerDatabase
+    {
+    public:
+        //! Constructs an empty database
+        AutotunerDatabase();
+
+        //! Add the entries of a file to the database
+        void load(const std::string& filename);
+
+        //! Write all entries to a file
+        void save(const std::string& filename) const;
+
+        //! Remove all entries
+        void clear()
+            {
+            m_entries.clear();
+            }
+
+        //! Get the number of entries
+        unsigned int getNumEntries() const
+            {
+            return (unsigned int)m_entries.size();
+            }
+
+        //! Build the key of an Autotuner
+        std::string makeKey(const std::string& name,
+                            const std::string& device,
+                            const std::vector<unsigned int>& parameters) const;
+
+        //! Look up the tuned parameter of a key
+        bool lookup(const std::string& key, unsigned int& param, float& time) const;
+
+        //! Record the tuned parameter of a key, does nothing when frozen
+        void record(const std::string& key, unsigned int param, float time);
+
+        //! Set the number of particles used in the keys
+        void setProblemSize(unsigned int N)
+            {
+            m_problem_size = N;
+            }
+
+        //! Get the number of particles used in the keys
+        unsigned int getProblemSize() const
+            {
+            return m_problem_size;
+            }
+
+        //! Freeze the database
+        void setFrozen(bool frozen)
+            {
+            m_frozen = frozen;
+            }
+
+        //! Test if the database is frozen
+        bool getFrozen() const
+            {
+            return m_frozen;
+            }
+
+    private:
+        //! Tuned parameter and its kernel time
+        struct Entry
+            {
+            unsigned int param; //!< Tuned parameter
+            float time;         //!< Kernel time of the parameter in milliseconds
+            };
+
+        std::map<std::string, Entry> m_entries; //!< Entries by key
+        unsigned int m_problem_size;             //!< Number of particles used in the keys
+        bool m_frozen;                           //!< True when the database is not updated
+    };
+
+//! Exports AutotunerDatabase to python
+void export_AutotunerDatabase(pybind11::module& m);
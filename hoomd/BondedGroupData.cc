@@ -43,14 +43,15 @@ template<unsigned int group_size, typename Group, const char *name, bool has_typ
 BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata,
     unsigned int n_group_types)
-    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true)
+    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0),
+      m_groups_dirty(true), m_particles_sorted(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name<< "s, n=" << group_size << ") "
         << endl;
 
     // connect to particle sort signal
     m_pdata->getParticleSortSignal().template connect<BondedGroupData<group_size, Group, name, has_type_mapping>,
-        &BondedGroupData<group_size, Group, name, has_type_mapping>::setDirty>(this);
+        &BondedGroupData<group_size, Group, name, has_type_mapping>::slotParticleSort>(this);
     #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
@@ -80,13 +81,14 @@ template<unsigned int group_size, typename Group, const char *name, bool has_typ
 BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata,
     const Snapshot& snapshot)
-    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true)
+    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0),
+      m_groups_dirty(true), m_particles_sorted(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name << ") " << endl;
 
     // connect to particle sort signal
     m_pdata->getParticleSortSignal().template connect<BondedGroupData<group_size, Group, name, has_type_mapping>,
-        &BondedGroupData<group_size, Group, name, has_type_mapping>::setDirty>(this);
+        &BondedGroupData<group_size, Group, name, has_type_mapping>::slotParticleSort>(this);
 
     // initialize from snapshot
     initializeFromSnapshot(snapshot);
@@ -105,7 +107,7 @@ template<unsigned int group_size, typename Group, const char *name, bool has_typ
 BondedGroupData<group_size, Group, name, has_type_mapping>::~BondedGroupData()
     {
     m_pdata->getParticleSortSignal().template disconnect<BondedGroupData<group_size, Group, name, has_type_mapping>,
-        &BondedGroupData<group_size, Group, name, has_type_mapping>::setDirty>(this);
+        &BondedGroupData<group_size, Group, name, has_type_mapping>::slotParticleSort>(this);
     #ifdef ENABLE_MPI
     m_pdata->getSingleParticleMoveSignal().template disconnect<BondedGroupData<group_size, Group, name, has_type_mapping>,
         &BondedGroupData<group_size, Group, name, has_type_mapping>::moveParticleGroups>(this);
@@ -145,16 +147,19 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initialize()
     GPUVector<unsigned int> group_rtag(m_exec_conf);
     m_group_rtag.swap(group_rtag);
 
-    // Lookup by particle index table
-    GPUVector<members_t> gpu_table(m_exec_conf);
+    // Lookup by particle index table, in managed memory so that force computes can read it from all GPUs
+    GlobalVector<members_t> gpu_table(m_exec_conf);
     m_gpu_table.swap(gpu_table);
 
-    GPUVector<unsigned int> gpu_pos_table(m_exec_conf);
+    GlobalVector<unsigned int> gpu_pos_table(m_exec_conf);
     m_gpu_pos_table.swap(gpu_pos_table);
 
-    GPUVector<unsigned int> n_groups(m_exec_conf);
+    GlobalVector<unsigned int> n_groups(m_exec_conf);
     m_gpu_n_groups.swap(n_groups);
 
+    GlobalVector<unsigned int> gpu_table_tag(m_exec_conf);
+    m_gpu_table_tag.swap(gpu_table_tag);
+
     #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
@@ -815,8 +820,121 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTable
                 }
             }
 
-        if (m_prof) m_prof->pop();
+        // remember which particle each row belongs to, for remapping the table after a sort
+        unsigned int N = m_pdata->getN()+m_pdata->getNGhosts();
+        m_gpu_table_tag.resize(N);
+            {
+            ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_gpu_table_tag(m_gpu_table_tag, access_location::host, access_mode::overwrite);
+            memcpy(h_gpu_table_tag.data, h_tag.data, sizeof(unsigned int)*N);
+            }
+
+        if (m_prof) m_prof->pop(0, m_gpu_table_indexer.getNumElements()*(sizeof(members_t)+sizeof(unsigned int)));
+        }
+    }
+
+/*! After a particle sort, the groups are the same and every particle keeps its table row, only at a new index. The
+    row of the particle with tag t moves from its old index to rtag[t], and the members listed in the row are mapped
+    the same way. Only the rows that move or that list a particle that moved are rewritten, which avoids counting and
+    scattering all groups again as rebuildGPUTable() does.
+*/
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::remapGPUTable()
+    {
+    unsigned int N = m_pdata->getN()+m_pdata->getNGhosts();
+
+    // the table is for a different set of particles, build it from scratch
+    if (m_gpu_table_tag.size() != N || m_gpu_table_indexer.getW() != N)
+        {
+        rebuildGPUTable();
+        return;
+        }
+
+    #ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        remapGPUTableGPU();
+        return;
+        }
+    #endif
+
+    if (m_prof) m_prof->push("remap " + std::string(name) + " table");
+
+    unsigned int n_rows_changed = 0;
+        {
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_gpu_table_tag(m_gpu_table_tag, access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_n_groups(m_gpu_n_groups, access_location::host, access_mode::readwrite);
+        ArrayHandle<members_t> h_gpu_table(m_gpu_table, access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_gpu_pos_table(m_gpu_pos_table, access_location::host, access_mode::readwrite);
+
+        // new index of each row
+        std::vector<unsigned int> new_idx(N);
+        for (unsigned int idx = 0; idx < N; ++idx)
+            new_idx[idx] = h_rtag.data[h_gpu_table_tag.data[idx]];
+
+        // find the rows to rewrite and save their contents, since they are overwritten in place
+        std::vector<unsigned int> changed;
+        std::vector<members_t> old_groups;
+        std::vector<unsigned int> old_pos;
+        for (unsigned int idx = 0; idx < N; ++idx)
+            {
+            unsigned int n = h_n_groups.data[idx];
+            bool moved = new_idx[idx] != idx;
+            for (unsigned int j = 0; j < n && !moved; ++j)
+                {
+                const members_t& h = h_gpu_table.data[m_gpu_table_indexer(idx, j)];
+                for (unsigned int k = 0; k < group_size-1; ++k)
+                    moved |= new_idx[h.idx[k]] != h.idx[k];
+                }
+
+            if (!moved)
+                continue;
+
+            changed.push_back(idx);
+            for (unsigned int j = 0; j < n; ++j)
+                {
+                old_groups.push_back(h_gpu_table.data[m_gpu_table_indexer(idx, j)]);
+                old_pos.push_back(h_gpu_pos_table.data[m_gpu_table_indexer(idx, j)]);
+                }
+            }
+
+        // the destination of a moved row has moved too, so the saved rows can be written back in any order
+        std::vector<unsigned int> old_n_groups(changed.size());
+        std::vector<unsigned int> old_tag(changed.size());
+        for (unsigned int i = 0; i < changed.size(); ++i)
+            {
+            old_n_groups[i] = h_n_groups.data[changed[i]];
+            old_tag[i] = h_gpu_table_tag.data[changed[i]];
+            }
+
+        unsigned int offset = 0;
+        for (unsigned int i = 0; i < changed.size(); ++i)
+            {
+            unsigned int idx = new_idx[changed[i]];
+            unsigned int n = old_n_groups[i];
+
+            h_n_groups.data[idx] = n;
+            h_gpu_table_tag.data[idx] = old_tag[i];
+            for (unsigned int j = 0; j < n; ++j)
+                {
+                members_t h = old_groups[offset+j];
+
+                // the last element is the type or group index, not a particle
+                for (unsigned int k = 0; k < group_size-1; ++k)
+                    h.idx[k] = new_idx[h.idx[k]];
+
+                h_gpu_table.data[m_gpu_table_indexer(idx, j)] = h;
+                h_gpu_pos_table.data[m_gpu_table_indexer(idx, j)] = old_pos[offset+j];
+                }
+            offset += n;
+            }
+
+        n_rows_changed = (unsigned int)changed.size();
         }
+
+    if (m_prof)
+        m_prof->pop(0, n_rows_changed*m_gpu_table_indexer.getH()*(sizeof(members_t)+sizeof(unsigned int)));
     }
 
 #ifdef ENABLE_HIP
@@ -905,7 +1023,56 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTable
             done = true;
         }
 
-    if (m_prof) m_prof->pop(m_exec_conf);
+    // remember which particle each row belongs to, for remapping the table after a sort
+    unsigned int N = m_pdata->getN()+m_pdata->getNGhosts();
+    m_gpu_table_tag.resize(N);
+        {
+        ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_gpu_table_tag(m_gpu_table_tag, access_location::device, access_mode::overwrite);
+        hipMemcpyAsync(d_gpu_table_tag.data, d_tag.data, sizeof(unsigned int)*N, hipMemcpyDeviceToDevice);
+        }
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf, 0, m_gpu_table_indexer.getNumElements()*(sizeof(members_t)+sizeof(unsigned int)));
+    }
+
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::remapGPUTableGPU()
+    {
+    if (m_prof) m_prof->push(m_exec_conf, "remap " + std::string(name) + " table");
+
+        {
+        ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(), access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_gpu_table_tag(m_gpu_table_tag, access_location::device, access_mode::readwrite);
+        ArrayHandle<unsigned int> d_n_groups(m_gpu_n_groups, access_location::device, access_mode::readwrite);
+        ArrayHandle<members_t> d_gpu_table(m_gpu_table, access_location::device, access_mode::readwrite);
+        ArrayHandle<unsigned int> d_gpu_pos_table(m_gpu_pos_table, access_location::device, access_mode::readwrite);
+
+        // allocate scratch buffers for the old table
+        CachedAllocator& alloc = m_exec_conf->getCachedAllocator();
+        unsigned int N = m_gpu_table_indexer.getW();
+        ScopedAllocation<unsigned int> d_old_tag(alloc, N);
+        ScopedAllocation<unsigned int> d_old_n_groups(alloc, N);
+        ScopedAllocation<members_t> d_old_table(alloc, m_gpu_table_indexer.getNumElements());
+        ScopedAllocation<unsigned int> d_old_pos_table(alloc, m_gpu_table_indexer.getNumElements());
+
+        gpu_remap_group_table<group_size, members_t>(
+            N,
+            m_gpu_table_indexer.getH(),
+            d_rtag.data,
+            d_gpu_table_tag.data,
+            d_n_groups.data,
+            d_gpu_table.data,
+            d_gpu_pos_table.data,
+            d_old_tag.data,
+            d_old_n_groups.data,
+            d_old_table.data,
+            d_old_pos_table.data);
+        }
+    if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf, 0, m_gpu_table_indexer.getNumElements()*(sizeof(members_t)+sizeof(unsigned int)));
     }
 #endif
 
@@ -1062,6 +1229,70 @@ std::map<unsigned int, unsigned int> BondedGroupData<group_size, Group, name, ha
     return index;
     }
 
+/*! \param checkpoint Checkpoint to copy the local and ghost groups to
+ */
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::takeCheckpoint(Checkpoint& checkpoint) const
+    {
+    const unsigned int n = m_n_groups + m_n_ghost;
+    const unsigned int n_rtag = (unsigned int)m_group_rtag.size();
+
+    reserveArrayElements(checkpoint.groups, n, m_exec_conf);
+    reserveArrayElements(checkpoint.typeval, n, m_exec_conf);
+    reserveArrayElements(checkpoint.tag, n, m_exec_conf);
+    reserveArrayElements(checkpoint.rtag, n_rtag, m_exec_conf);
+
+    copyArrayElements(checkpoint.groups, m_groups, n, m_exec_conf);
+    copyArrayElements(checkpoint.typeval, m_group_typeval, n, m_exec_conf);
+    copyArrayElements(checkpoint.tag, m_group_tag, n, m_exec_conf);
+    copyArrayElements(checkpoint.rtag, m_group_rtag, n_rtag, m_exec_conf);
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        reserveArrayElements(checkpoint.ranks, n, m_exec_conf);
+        copyArrayElements(checkpoint.ranks, m_group_ranks, n, m_exec_conf);
+        }
+    #endif
+
+    checkpoint.n_groups = m_n_groups;
+    checkpoint.n_ghost = m_n_ghost;
+    checkpoint.nglobal = m_nglobal;
+    checkpoint.n_rtag = n_rtag;
+    }
+
+/*! \param checkpoint Checkpoint taken by takeCheckpoint()
+
+    No groups may be added or removed between taking and restoring the checkpoint. The lookup table by particle index
+    is rebuilt on its next use.
+ */
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::restoreCheckpoint(const Checkpoint& checkpoint)
+    {
+    if (checkpoint.nglobal != m_nglobal || checkpoint.n_rtag != m_group_rtag.size())
+        {
+        m_exec_conf->msg->error() << name << "s were added or removed since the checkpoint was taken." << std::endl;
+        throw std::runtime_error(std::string("Error restoring ") + name + std::string(" data."));
+        }
+
+    const unsigned int n = checkpoint.n_groups + checkpoint.n_ghost;
+    reallocate(n);
+    m_n_groups = checkpoint.n_groups;
+    m_n_ghost = checkpoint.n_ghost;
+
+    copyArrayElements(m_groups, checkpoint.groups, n, m_exec_conf);
+    copyArrayElements(m_group_typeval, checkpoint.typeval, n, m_exec_conf);
+    copyArrayElements(m_group_tag, checkpoint.tag, n, m_exec_conf);
+    copyArrayElements(m_group_rtag, checkpoint.rtag, checkpoint.n_rtag, m_exec_conf);
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        copyArrayElements(m_group_ranks, checkpoint.ranks, n, m_exec_conf);
+    #endif
+
+    notifyGroupReorder();
+    }
+
 #ifdef ENABLE_MPI
 template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
 void BondedGroupData<group_size, Group, name, has_type_mapping>::moveParticleGroups(unsigned int tag, unsigned int old_rank, unsigned int new_rank)
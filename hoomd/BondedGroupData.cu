@@ -213,6 +213,113 @@ void gpu_update_group_table(
         }
     }
 
+//! Move the rows of the group table to the new particle indices after a sort
+/*! \param N Number of rows (local and ghost particles)
+    \param d_rtag Particle reverse-lookup table after the sort
+    \param d_old_tag Tag of the particle in each row before the sort
+    \param d_old_n_groups Number of groups in each row before the sort
+    \param d_old_group_table Group table before the sort
+    \param d_old_gpos_table Position in group table before the sort
+    \param d_pidx_tag Tag of the particle in each row (output)
+    \param d_n_groups Number of groups in each row (output)
+    \param d_pidx_group_table Group table (output)
+    \param d_pidx_gpos_table Position in group table (output)
+    \param pitch Pitch of the group tables
+
+    One thread handles one row. Since the sort is a permutation, every output row is written by exactly one thread.
+*/
+template<unsigned int group_size, typename group_t>
+__global__ void gpu_group_remap_kernel(
+    const unsigned int N,
+    const unsigned int *d_rtag,
+    const unsigned int *d_old_tag,
+    const unsigned int *d_old_n_groups,
+    const group_t *d_old_group_table,
+    const unsigned int *d_old_gpos_table,
+    unsigned int *d_pidx_tag,
+    unsigned int *d_n_groups,
+    group_t *d_pidx_group_table,
+    unsigned int *d_pidx_gpos_table,
+    const unsigned int pitch
+    )
+    {
+    unsigned int old_idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (old_idx >= N) return;
+
+    unsigned int tag = d_old_tag[old_idx];
+    unsigned int idx = d_rtag[tag];
+    unsigned int n = d_old_n_groups[old_idx];
+
+    d_pidx_tag[idx] = tag;
+    d_n_groups[idx] = n;
+
+    for (unsigned int j = 0; j < n; ++j)
+        {
+        group_t g = d_old_group_table[j*pitch + old_idx];
+
+        // the last element is the type or group index, not a particle
+        for (unsigned int k = 0; k < group_size-1; ++k)
+            g.idx[k] = d_rtag[d_old_tag[g.idx[k]]];
+
+        d_pidx_group_table[j*pitch + idx] = g;
+        d_pidx_gpos_table[j*pitch + idx] = d_old_gpos_table[j*pitch + old_idx];
+        }
+    }
+
+/*! \param N Number of rows (local and ghost particles), also the pitch of the group tables
+    \param max_n_groups Maximum number of groups per row
+    \param d_rtag Particle reverse-lookup table after the sort
+    \param d_pidx_tag Tag of the particle in each row, updated in place
+    \param d_n_groups Number of groups in each row, updated in place
+    \param d_pidx_group_table Group table, updated in place
+    \param d_pidx_gpos_table Position in group table, updated in place
+    \param d_scratch_tag Scratch array of N elements
+    \param d_scratch_n_groups Scratch array of N elements
+    \param d_scratch_group_table Scratch array of N*max_n_groups elements
+    \param d_scratch_gpos_table Scratch array of N*max_n_groups elements
+*/
+template<unsigned int group_size, typename group_t>
+void gpu_remap_group_table(
+    const unsigned int N,
+    const unsigned int max_n_groups,
+    const unsigned int *d_rtag,
+    unsigned int *d_pidx_tag,
+    unsigned int *d_n_groups,
+    group_t *d_pidx_group_table,
+    unsigned int *d_pidx_gpos_table,
+    unsigned int *d_scratch_tag,
+    unsigned int *d_scratch_n_groups,
+    group_t *d_scratch_group_table,
+    unsigned int *d_scratch_gpos_table
+    )
+    {
+    if (N == 0) return;
+
+    hipMemcpyAsync(d_scratch_tag, d_pidx_tag, sizeof(unsigned int)*N, hipMemcpyDeviceToDevice);
+    hipMemcpyAsync(d_scratch_n_groups, d_n_groups, sizeof(unsigned int)*N, hipMemcpyDeviceToDevice);
+    hipMemcpyAsync(d_scratch_group_table, d_pidx_group_table, sizeof(group_t)*N*max_n_groups,
+        hipMemcpyDeviceToDevice);
+    hipMemcpyAsync(d_scratch_gpos_table, d_pidx_gpos_table, sizeof(unsigned int)*N*max_n_groups,
+        hipMemcpyDeviceToDevice);
+
+    unsigned int block_size = 256;
+    unsigned n_blocks = N / block_size + 1;
+
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_group_remap_kernel<group_size>), dim3(n_blocks), dim3(block_size), 0, 0,
+        N,
+        d_rtag,
+        d_scratch_tag,
+        d_scratch_n_groups,
+        d_scratch_group_table,
+        d_scratch_gpos_table,
+        d_pidx_tag,
+        d_n_groups,
+        d_pidx_group_table,
+        d_pidx_gpos_table,
+        N);
+    }
+
 /*
  * Explicit template instantiations
  */
@@ -282,3 +389,48 @@ template void gpu_update_group_table<4>(
     bool has_type_mapping,
     CachedAllocator& alloc
     );
+
+//! BondData
+template void gpu_remap_group_table<2>(
+    const unsigned int N,
+    const unsigned int max_n_groups,
+    const unsigned int *d_rtag,
+    unsigned int *d_pidx_tag,
+    unsigned int *d_n_groups,
+    group_storage<2> *d_pidx_group_table,
+    unsigned int *d_pidx_gpos_table,
+    unsigned int *d_scratch_tag,
+    unsigned int *d_scratch_n_groups,
+    group_storage<2> *d_scratch_group_table,
+    unsigned int *d_scratch_gpos_table
+    );
+
+//! AngleData
+template void gpu_remap_group_table<3>(
+    const unsigned int N,
+    const unsigned int max_n_groups,
+    const unsigned int *d_rtag,
+    unsigned int *d_pidx_tag,
+    unsigned int *d_n_groups,
+    group_storage<3> *d_pidx_group_table,
+    unsigned int *d_pidx_gpos_table,
+    unsigned int *d_scratch_tag,
+    unsigned int *d_scratch_n_groups,
+    group_storage<3> *d_scratch_group_table,
+    unsigned int *d_scratch_gpos_table
+    );
+
+//! DihedralData and ImproperData
+template void gpu_remap_group_table<4>(
+    const unsigned int N,
+    const unsigned int max_n_groups,
+    const unsigned int *d_rtag,
+    unsigned int *d_pidx_tag,
+    unsigned int *d_n_groups,
+    group_storage<4> *d_pidx_group_table,
+    unsigned int *d_pidx_gpos_table,
+    unsigned int *d_scratch_tag,
+    unsigned int *d_scratch_n_groups,
+    group_storage<4> *d_scratch_group_table,
+    unsigned int *d_scratch_gpos_table
+    );
@@ -77,4 +77,18 @@ void gpu_update_group_table(
     bool has_type_mapping,
     CachedAllocator& alloc
     );
+template<unsigned int group_size, typename group_t>
+void gpu_remap_group_table(
+    const unsigned int N,
+    const unsigned int max_n_groups,
+    const unsigned int *d_rtag,
+    unsigned int *d_pidx_tag,
+    unsigned int *d_n_groups,
+    group_t *d_pidx_group_table,
+    unsigned int *d_pidx_gpos_table,
+    unsigned int *d_scratch_tag,
+    unsigned int *d_scratch_n_groups,
+    group_t *d_scratch_group_table,
+    unsigned int *d_scratch_gpos_table
+    );
 #endif // __BONDED_GROUP_DATA_CUH__
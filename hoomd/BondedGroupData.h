@@ -212,9 +212,10 @@ class BondedGroupData
              */
             void bcast(unsigned int root, MPI_Comm mpi_comm)
                 {
-                ::bcast(type_id, root, mpi_comm);
-                ::bcast(val, root, mpi_comm);
-                ::bcast(groups, root, mpi_comm);
+                NodeBroadcast node_bcast(root, mpi_comm);
+                node_bcast.bcast(type_id);
+                node_bcast.bcast(val);
+                node_bcast.bcast(groups);
                 ::bcast(type_mapping, root, mpi_comm);
                 ::bcast(size, root, mpi_comm);
                 }
@@ -239,6 +240,25 @@ class BondedGroupData
             unsigned int size;                             //!< Number of bonds in the snapshot
             };
 
+        //! Copy of the local groups that restoreCheckpoint() restores in place
+        /*! The arrays hold the local and the ghost groups. They grow only when the number of groups exceeds their
+            size.
+         */
+        struct Checkpoint
+            {
+            GlobalArray<members_t> groups;          //!< Group members
+            GlobalArray<typeval_t> typeval;         //!< Group types or constraint values
+            GlobalArray<unsigned int> tag;          //!< Group tags
+            GlobalArray<unsigned int> rtag;         //!< Reverse lookup tags
+            #ifdef ENABLE_MPI
+            GlobalArray<ranks_t> ranks;             //!< Ranks of the group members
+            #endif
+            unsigned int n_groups = 0;              //!< Number of local groups
+            unsigned int n_ghost = 0;               //!< Number of ghost groups
+            unsigned int nglobal = 0;               //!< Global number of groups
+            unsigned int n_rtag = 0;                //!< Number of reverse lookup tags
+            };
+
         //! Constructor for empty BondedGroupData
         BondedGroupData(std::shared_ptr<ParticleData> pdata,
             unsigned int n_group_types);
@@ -255,6 +275,18 @@ class BondedGroupData
         //! Take a snapshot
         virtual std::map<unsigned int, unsigned int> takeSnapshot(Snapshot& snapshot) const;
 
+        //! Copy the local groups into a checkpoint
+        void takeCheckpoint(Checkpoint& checkpoint) const;
+
+        //! Restore the local groups from a checkpoint
+        void restoreCheckpoint(const Checkpoint& checkpoint);
+
+        //! Access the execution configuration
+        std::shared_ptr<const ExecutionConfiguration> getExecConf() const
+            {
+            return m_exec_conf;
+            }
+
         //! Get local number of bonded groups
         unsigned int getN() const
             {
@@ -520,27 +552,19 @@ class BondedGroupData
          */
 
         //! Return GPU bonded groups list
-        const GPUVector<members_t>& getGPUTable()
+        const GlobalVector<members_t>& getGPUTable()
             {
-            // rebuild lookup table if necessary
-            if (m_groups_dirty)
-                {
-                rebuildGPUTable();
-                m_groups_dirty = false;
-                }
+            // rebuild or remap lookup table if necessary
+            updateGPUTable();
 
             return m_gpu_table;
             }
 
         //! Return GPU list of particle in group position
-        const GPUArray<unsigned >& getGPUPosTable()
+        const GlobalArray<unsigned >& getGPUPosTable()
             {
-            // rebuild lookup table if necessary
-            if (m_groups_dirty)
-                {
-                rebuildGPUTable();
-                m_groups_dirty = false;
-                }
+            // rebuild or remap lookup table if necessary
+            updateGPUTable();
 
             return m_gpu_pos_table;
             }
@@ -548,18 +572,14 @@ class BondedGroupData
         //! Return two-dimensional group-by-ptl-index lookup table
         const Index2D& getGPUTableIndexer()
             {
-            // rebuild lookup table if necessary
-            if (m_groups_dirty)
-                {
-                rebuildGPUTable();
-                m_groups_dirty = false;
-                }
+            // rebuild or remap lookup table if necessary
+            updateGPUTable();
 
             return m_gpu_table_indexer;
             }
 
         //! Return list of number of groups per particle
-        const GPUArray<unsigned int>& getNGroupsArray() const
+        const GlobalArray<unsigned int>& getNGroupsArray() const
             {
             return m_gpu_n_groups;
             }
@@ -615,6 +635,14 @@ class BondedGroupData
             m_groups_dirty = true;
             }
 
+        //! Indicate that the particles have been reordered
+        /*! The groups themselves are unchanged, so the GPU table only needs its particle indices remapped
+         */
+        void slotParticleSort()
+            {
+            m_particles_sorted = true;
+            }
+
     protected:
         #ifdef ENABLE_MPI
         //! Helper function to transfer bonded groups connected to a single particle
@@ -632,10 +660,10 @@ class BondedGroupData
         GPUVector<typeval_t> m_group_typeval;        //!< List of group types/constraint values
         GPUVector<unsigned int> m_group_tag;         //!< List of group tags
         GPUVector<unsigned int> m_group_rtag;        //!< Global reverse-lookup table for group tags
-        GPUVector<members_t> m_gpu_table;            //!< Storage for groups by particle index for access on the GPU
-        GPUVector<unsigned int> m_gpu_pos_table;     //!< Position of particle idx in group table
+        GlobalVector<members_t> m_gpu_table;         //!< Storage for groups by particle index for access on the GPU
+        GlobalVector<unsigned int> m_gpu_pos_table;  //!< Position of particle idx in group table
         Index2D m_gpu_table_indexer;                 //!< Indexer for GPU table
-        GPUVector<unsigned int> m_gpu_n_groups;      //!< Number of entries in lookup table per particle
+        GlobalVector<unsigned int> m_gpu_n_groups;   //!< Number of entries in lookup table per particle
         std::vector<std::string> m_type_mapping;     //!< Mapping of types of bonded groups
 
         unsigned int m_n_groups;                     //!< Number of local groups
@@ -662,6 +690,8 @@ class BondedGroupData
 
     private:
         bool m_groups_dirty;                         //!< Is it necessary to rebuild the lookup-by-index table?
+        bool m_particles_sorted;                     //!< Have the particles been reordered since the last table update?
+        GlobalVector<unsigned int> m_gpu_table_tag;  //!< Tag of the particle in each row of the GPU table
 
         Nano::Signal<void ()> m_group_num_change_signal; //!< Signal that is triggered when groups are added or deleted (globally)
         Nano::Signal<void ()> m_group_reorder_signal;    //!< Signal that is triggered when groups are added or deleted locally
@@ -672,9 +702,28 @@ class BondedGroupData
         //! Helper function to rebuild the active tag cache if necessary
         void maybe_rebuild_tag_cache();
 
+        //! Helper function to rebuild or remap the lookup by index table when it is out of date
+        void updateGPUTable()
+            {
+            if (m_groups_dirty)
+                {
+                rebuildGPUTable();
+                m_groups_dirty = false;
+                m_particles_sorted = false;
+                }
+            else if (m_particles_sorted)
+                {
+                remapGPUTable();
+                m_particles_sorted = false;
+                }
+            }
+
         //! Helper function to rebuild lookup by index table
         void rebuildGPUTable();
 
+        //! Helper function to remap the particle indices in the lookup by index table after a particle sort
+        void remapGPUTable();
+
         //! Resize internal tables
         /*! \param new_size New size of local group tables, new_size = n_local + n_ghost
          */
@@ -695,6 +744,9 @@ class BondedGroupData
         //! Helper function to rebuild lookup by index table on the GPU
         void rebuildGPUTableGPU();
 
+        //! Helper function to remap the particle indices in the lookup by index table on the GPU
+        void remapGPUTableGPU();
+
         GPUArray<unsigned int> m_condition;          //!< Condition variable for rebuilding GPU table on the GPU
         unsigned int m_next_flag;                    //!< Next flag value for GPU table rebuild
         #endif
@@ -1087,6 +1139,8 @@ void export_LocalGroupData(pybind11::module& m, std::string name)
     .def("getRTags", &LocalGroupData<Output, Data>::getRTags)
     .def("getTypeVal", &LocalGroupData<Output, Data>::getTypeVal)
     .def("getMembers", &LocalGroupData<Output, Data>::getMembers)
+    .def("selectRows", &LocalGroupData<Output, Data>::selectRows)
+    .def("selectAllRows", &LocalGroupData<Output, Data>::selectAllRows)
     .def("enter", &LocalGroupData<Output, Data>::enter)
     .def("exit", &LocalGroupData<Output, Data>::exit)
     ;
@@ -246,6 +246,12 @@ BoxDim
             return m_yz;
             }
 
+        //! Test if all tilt factors are zero
+        HOSTDEVICE bool isOrthorhombic() const
+            {
+            return m_xy == Scalar(0.0) && m_xz == Scalar(0.0) && m_yz == Scalar(0.0);
+            }
+
         //! Compute fractional coordinates, allowing for a ghost layer
         /*! \param v Vector to scale
             \param ghost_width Width of extra ghost padding layer to take into account (along reciprocal lattice directions)
@@ -291,25 +297,45 @@ BoxDim
             \return a vector that is the minimum image vector of \a v, obeying the periodic settings
             \note \a v must not extend more than 1 image beyond the box
         */
+        HOSTDEVICE Scalar3 minImage(const Scalar3& v) const
+            {
+            return minImage<true, true>(v);
+            }
+
+        //! Compute minimum image for a box shape known at compile time
+        /*! \tparam triclinic Set to false when the box is orthorhombic, see isOrthorhombic()
+            \tparam three_d Set to false in 2D systems, where the z component of \a v is zero
+            \param v Vector to compute
+            \return a vector that is the minimum image vector of \a v, obeying the periodic settings
+            \note \a v must not extend more than 1 image beyond the box
+
+            The tilt terms and the z image are left out when the template parameters rule them out. The result is the
+            same as that of minImage(v). Loops over many pairs select the parameters once with dispatchBoxShape().
+        */
+        template<bool triclinic, bool three_d>
         HOSTDEVICE Scalar3 minImage(const Scalar3& v) const
             {
             Scalar3 w = v;
             Scalar3 L = getL();
 
             #ifdef __HIPCC__
-            if (m_periodic.z)
+            if (three_d && m_periodic.z)
                 {
                 Scalar img = rint(w.z * m_Linv.z);
                 w.z -= L.z * img;
-                w.y -= L.z * m_yz * img;
-                w.x -= L.z * m_xz * img;
+                if (triclinic)
+                    {
+                    w.y -= L.z * m_yz * img;
+                    w.x -= L.z * m_xz * img;
+                    }
                 }
 
             if (m_periodic.y)
                 {
                 Scalar img = rint(w.y * m_Linv.y);
                 w.y -= L.y * img;
-                w.x -= L.y * m_xy * img;
+                if (triclinic)
+                    w.x -= L.y * m_xy * img;
                 }
 
             if (m_periodic.x)
@@ -318,19 +344,25 @@ BoxDim
                 }
             #else
             // on the cpu, branches are faster than calling rint
-            if (m_periodic.z)
+            if (three_d && m_periodic.z)
                 {
                 if (w.z >= m_hi.z)
                     {
                     w.z -= L.z;
-                    w.y -= L.z * m_yz;
-                    w.x -= L.z * m_xz;
+                    if (triclinic)
+                        {
+                        w.y -= L.z * m_yz;
+                        w.x -= L.z * m_xz;
+                        }
                     }
                 else if (w.z < m_lo.z)
                     {
                     w.z += L.z;
-                    w.y += L.z * m_yz;
-                    w.x += L.z * m_xz;
+                    if (triclinic)
+                        {
+                        w.y += L.z * m_yz;
+                        w.x += L.z * m_xz;
+                        }
                     }
                 }
 
@@ -340,13 +372,15 @@ BoxDim
                     {
                     int i = int(w.y*m_Linv.y+Scalar(0.5));
                     w.y -= (Scalar)i*L.y;
-                    w.x -= (Scalar)i*L.y * m_xy;
+                    if (triclinic)
+                        w.x -= (Scalar)i*L.y * m_xy;
                     }
                 else if (w.y < m_lo.y)
                     {
                     int i = int(-w.y*m_Linv.y+Scalar(0.5));
                     w.y += (Scalar)i*L.y;
-                    w.x += (Scalar)i*L.y * m_xy;
+                    if (triclinic)
+                        w.x += (Scalar)i*L.y * m_xy;
                     }
                 }
 
@@ -630,6 +664,43 @@ BoxDim
 
     };
 
+//! Compile time shape of a box, passed to the functor of dispatchBoxShape()
+template<bool _triclinic, bool _three_d>
+struct BoxShape
+    {
+    static constexpr bool triclinic = _triclinic;
+    static constexpr bool three_d = _three_d;
+    };
+
+//! Call \a f with the BoxShape that matches a box
+/*! \param box The box
+    \param three_d True in 3D systems
+    \param f Functor that takes a BoxShape
+
+    Use this to select BoxDim::minImage<triclinic, three_d>() once for a loop over many pairs:
+    \code
+    dispatchBoxShape(box, ndim == 3, [&](auto shape)
+        {
+        typedef decltype(shape) Shape;
+        for (...)
+            dx = box.minImage<Shape::triclinic, Shape::three_d>(dx);
+        });
+    \endcode
+*/
+template<class Function>
+inline void dispatchBoxShape(const BoxDim& box, bool three_d, Function&& f)
+    {
+    bool triclinic = !box.isOrthorhombic();
+    if (triclinic && three_d)
+        f(BoxShape<true, true>());
+    else if (triclinic)
+        f(BoxShape<true, false>());
+    else if (three_d)
+        f(BoxShape<false, true>());
+    else
+        f(BoxShape<false, false>());
+    }
+
 // undefine HOSTDEVICE so we don't interfere with other headers
 #undef HOSTDEVICE
 #endif // __BOXDIM_H__
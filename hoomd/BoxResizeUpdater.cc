@@ -109,55 +109,53 @@ void BoxResizeUpdater::update(unsigned int timestep)
         // set the new box
         m_pdata->setGlobalBox(new_box);
 
-        // scale the particle positions (if we have been asked to)
+        // scale the particle positions (if we have been asked to) and keep them in the local box
+        scaleAndWrapParticles(cur_box, new_box);
+        }
+    if (m_prof) m_prof->pop();
+    }
+
+/** Scale the particles with the box (if requested) and wrap them back into the local box
+    \param cur_box Global box before the update
+    \param new_box Global box after the update
+*/
+void BoxResizeUpdater::scaleAndWrapParticles(const BoxDim& cur_box, const BoxDim& new_box)
+    {
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                               access_location::host,
+                               access_mode::readwrite);
+
+    ArrayHandle<int3> h_image(m_pdata->getImages(),
+                              access_location::host,
+                              access_mode::readwrite);
+
+    const BoxDim& local_box = m_pdata->getBox();
+
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        {
         if (m_scale_particles)
             {
-            // move the particles to be inside the new box
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
-                                       access_location::host,
-                                       access_mode::readwrite);
-
-            for (unsigned int i = 0; i < m_pdata->getN(); i++)
-                {
-                // obtain scaled coordinates in the old global box
-                Scalar3 fractional_pos = cur_box.makeFraction(
-                    make_scalar3(h_pos.data[i].x,
-                                 h_pos.data[i].y,
-                                 h_pos.data[i].z));
-
-                // intentionally scale both rigid body and free particles, this
-                // may waste a few cycles but it enables the debug inBox checks
-                // to be left as is (otherwise, setRV cannot fixup rigid body
-                // positions without failing the check)
-                Scalar3 scaled_pos = new_box.makeCoordinates(fractional_pos);
-                h_pos.data[i].x = scaled_pos.x;
-                h_pos.data[i].y = scaled_pos.y;
-                h_pos.data[i].z = scaled_pos.z;
-                }
-            }
-        // otherwise, we need to ensure that the particles are still in their
-        // local boxes by wrapping them if they are not
-        else
-            {
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
-                                       access_location::host,
-                                       access_mode::readwrite);
-
-            ArrayHandle<int3> h_image(m_pdata->getImages(),
-                                      access_location::host,
-                                      access_mode::readwrite);
-
-            const BoxDim& local_box = m_pdata->getBox();
-
-            for (unsigned int i = 0; i < m_pdata->getN(); i++)
-                {
-                // need to update the image if we move particles from one side
-                // of the box to the other
-                local_box.wrap(h_pos.data[i], h_image.data[i]);
-                }
+            // obtain scaled coordinates in the old global box
+            Scalar3 fractional_pos = cur_box.makeFraction(
+                make_scalar3(h_pos.data[i].x,
+                             h_pos.data[i].y,
+                             h_pos.data[i].z));
+
+            // intentionally scale both rigid body and free particles, this
+            // may waste a few cycles but it enables the debug inBox checks
+            // to be left as is (otherwise, setRV cannot fixup rigid body
+            // positions without failing the check)
+            Scalar3 scaled_pos = new_box.makeCoordinates(fractional_pos);
+            h_pos.data[i].x = scaled_pos.x;
+            h_pos.data[i].y = scaled_pos.y;
+            h_pos.data[i].z = scaled_pos.z;
             }
+
+        // need to update the image if we move particles from one side
+        // of the box to the other, or round off moved a scaled particle
+        // out of the box
+        local_box.wrap(h_pos.data[i], h_image.data[i]);
         }
-    if (m_prof) m_prof->pop();
     }
 
 BoxDim& getBoxDimFromPyObject(pybind11::object box)
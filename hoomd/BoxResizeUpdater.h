@@ -76,7 +76,10 @@ class PYBIND11_EXPORT BoxResizeUpdater : public Updater
         /// Update box interpolation based on provided timestep
         virtual void update(unsigned int timestep);
 
-    private:
+    protected:
+        /// Scale the particles with the box (if requested) and wrap them back into the local box
+        virtual void scaleAndWrapParticles(const BoxDim& cur_box, const BoxDim& new_box);
+
         pybind11::object m_py_box1;  ///< The python box assoc with min
         pybind11::object m_py_box2;  ///< The python box assoc with max
         BoxDim& m_box1;  ///< C++ box assoc with min
@@ -0,0 +1,75 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file BoxResizeUpdaterGPU.cc
+    \brief Defines the BoxResizeUpdaterGPU class
+*/
+
+#ifdef ENABLE_HIP
+
+#include "BoxResizeUpdaterGPU.h"
+#include "BoxResizeUpdaterGPU.cuh"
+
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+namespace py = pybind11;
+
+BoxResizeUpdaterGPU::BoxResizeUpdaterGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                         pybind11::object box1,
+                                         pybind11::object box2,
+                                         std::shared_ptr<Variant> variant)
+    : BoxResizeUpdater(sysdef, box1, box2, variant)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing BoxResizeUpdaterGPU" << endl;
+
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error() << "Creating a BoxResizeUpdaterGPU with no GPU in the execution configuration"
+                                  << endl;
+        throw std::runtime_error("Error initializing BoxResizeUpdaterGPU");
+        }
+
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_tuner.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "box_resize", m_exec_conf));
+    }
+
+BoxResizeUpdaterGPU::~BoxResizeUpdaterGPU()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying BoxResizeUpdaterGPU" << endl;
+    }
+
+/** \param cur_box Global box before the update
+    \param new_box Global box after the update
+*/
+void BoxResizeUpdaterGPU::scaleAndWrapParticles(const BoxDim& cur_box, const BoxDim& new_box)
+    {
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::readwrite);
+    ArrayHandle<int3> d_image(m_pdata->getImages(), access_location::device, access_mode::readwrite);
+
+    m_tuner->begin();
+    gpu_box_resize_scale_and_wrap(m_pdata->getN(),
+                                  d_pos.data,
+                                  d_image.data,
+                                  cur_box,
+                                  new_box,
+                                  m_pdata->getBox(),
+                                  m_scale_particles,
+                                  m_tuner->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner->end();
+    }
+
+void export_BoxResizeUpdaterGPU(py::module& m)
+    {
+    py::class_<BoxResizeUpdaterGPU, BoxResizeUpdater,
+               std::shared_ptr<BoxResizeUpdaterGPU> >(m, "BoxResizeUpdaterGPU")
+    .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                        pybind11::object, pybind11::object,
+                        std::shared_ptr<Variant> >())
+    ;
+    }
+
+#endif // ENABLE_HIP
@@ -0,0 +1,82 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "BoxResizeUpdaterGPU.cuh"
+
+/*! \file BoxResizeUpdaterGPU.cu
+    \brief Defines GPU functions used by BoxResizeUpdaterGPU
+*/
+
+//! Kernel that scales the particles with the box and wraps them back into the local box
+/*! \param N Number of local particles
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param cur_box Global box before the update
+    \param new_box Global box after the update
+    \param local_box Local box after the update
+    \param scale_particles Set to true to scale the particle positions with the box
+*/
+__global__ void gpu_box_resize_scale_and_wrap_kernel(const unsigned int N,
+                                                     Scalar4 *d_pos,
+                                                     int3 *d_image,
+                                                     const BoxDim cur_box,
+                                                     const BoxDim new_box,
+                                                     const BoxDim local_box,
+                                                     const bool scale_particles)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    Scalar4 postype = d_pos[idx];
+    Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+
+    if (scale_particles)
+        {
+        // obtain scaled coordinates in the old global box and map them into the new one
+        Scalar3 f = cur_box.makeFraction(pos);
+        pos = new_box.makeCoordinates(f);
+        }
+
+    int3 image = d_image[idx];
+    local_box.wrap(pos, image);
+
+    d_pos[idx] = make_scalar4(pos.x, pos.y, pos.z, postype.w);
+    d_image[idx] = image;
+    }
+
+/*! \param N Number of local particles
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param cur_box Global box before the update
+    \param new_box Global box after the update
+    \param local_box Local box after the update
+    \param scale_particles Set to true to scale the particle positions with the box
+    \param block_size Block size of the kernel
+*/
+void gpu_box_resize_scale_and_wrap(const unsigned int N,
+                                   Scalar4 *d_pos,
+                                   int3 *d_image,
+                                   const BoxDim& cur_box,
+                                   const BoxDim& new_box,
+                                   const BoxDim& local_box,
+                                   const bool scale_particles,
+                                   const unsigned int block_size)
+    {
+    if (N == 0)
+        return;
+
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, reinterpret_cast<const void *>(&gpu_box_resize_scale_and_wrap_kernel));
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    unsigned int n_blocks = N/run_block_size + 1;
+
+    hipLaunchKernelGGL(gpu_box_resize_scale_and_wrap_kernel, dim3(n_blocks), dim3(run_block_size), 0, 0,
+                       N, d_pos, d_image, cur_box, new_box, local_box, scale_particles);
+    }
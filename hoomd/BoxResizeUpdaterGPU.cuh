@@ -0,0 +1,24 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __BOXRESIZEUPDATER_GPU_CUH__
+#define __BOXRESIZEUPDATER_GPU_CUH__
+
+#include "HOOMDMath.h"
+#include "BoxDim.h"
+
+/*! \file BoxResizeUpdaterGPU.cuh
+    \brief Declares GPU functions used by BoxResizeUpdaterGPU
+*/
+
+//! Scale the particles with the box and wrap them back into the local box
+void gpu_box_resize_scale_and_wrap(const unsigned int N,
+                                   Scalar4 *d_pos,
+                                   int3 *d_image,
+                                   const BoxDim& cur_box,
+                                   const BoxDim& new_box,
+                                   const BoxDim& local_box,
+                                   const bool scale_particles,
+                                   const unsigned int block_size);
+
+#endif // __BOXRESIZEUPDATER_GPU_CUH__
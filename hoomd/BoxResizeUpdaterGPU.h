@@ -0,0 +1,61 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file BoxResizeUpdaterGPU.h
+    \brief Declares the BoxResizeUpdaterGPU class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifdef ENABLE_HIP
+
+#include "BoxResizeUpdater.h"
+#include "Autotuner.h"
+
+#include <memory>
+#include <pybind11/pybind11.h>
+
+#ifndef __BOXRESIZEUPDATER_GPU_H__
+#define __BOXRESIZEUPDATER_GPU_H__
+
+/// Updates the simulation box over time on the GPU
+/** The particles are scaled and wrapped in a single kernel, so a box ramp does not copy the particle data to the
+    host.
+    \ingroup updaters
+*/
+class PYBIND11_EXPORT BoxResizeUpdaterGPU : public BoxResizeUpdater
+    {
+    public:
+        /// Constructor
+        BoxResizeUpdaterGPU(std::shared_ptr<SystemDefinition> sysdef,
+                            pybind11::object box1,
+                            pybind11::object box2,
+                            std::shared_ptr<Variant> variant);
+
+        /// Destructor
+        virtual ~BoxResizeUpdaterGPU();
+
+        /// Set autotuner parameters
+        virtual void setAutotunerParams(bool enable, unsigned int period)
+            {
+            BoxResizeUpdater::setAutotunerParams(enable, period);
+            m_tuner->setPeriod(period);
+            m_tuner->setEnabled(enable);
+            }
+
+    protected:
+        /// Scale the particles with the box (if requested) and wrap them back into the local box
+        virtual void scaleAndWrapParticles(const BoxDim& cur_box, const BoxDim& new_box);
+
+    private:
+        std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for the block size of the scaling kernel
+    };
+
+/// Export the BoxResizeUpdaterGPU to python
+void export_BoxResizeUpdaterGPU(pybind11::module& m);
+
+#endif // __BOXRESIZEUPDATER_GPU_H__
+
+#endif // ENABLE_HIP
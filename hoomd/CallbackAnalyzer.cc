@@ -40,7 +40,8 @@ CallbackAnalyzer::~CallbackAnalyzer()
 */
 void CallbackAnalyzer::analyze(unsigned int timestep)
     {
-      callback(timestep);
+    pybind11::gil_scoped_acquire acquire;
+    callback(timestep);
     }
 
 void export_CallbackAnalyzer(py::module& m)
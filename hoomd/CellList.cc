@@ -13,6 +13,11 @@
 
 #include <algorithm>
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 using namespace std;
 namespace py = pybind11;
 
@@ -166,6 +171,8 @@ void CellList::compute(unsigned int timestep)
     // only update if we need to
     if (shouldCompute(timestep) || force)
         {
+        // computeCellList() sizes the cell list before filling it, the loop only repeats if an implementation
+        // reports an overflow
         bool overflowed = false;
         do
             {
@@ -448,21 +455,8 @@ void CellList::computeCellList()
     ArrayHandle< Scalar > h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
     const BoxDim& box = m_pdata->getBox();
 
-    // access the cell list data arrays
-    ArrayHandle<unsigned int> h_cell_size(m_cell_size, access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar4> h_xyzf(m_xyzf, access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar4> h_cell_orientation(m_orientation, access_location::host, access_mode::overwrite);
-    ArrayHandle<unsigned int> h_cell_idx(m_idx, access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar4> h_tdb(m_tdb, access_location::host, access_mode::overwrite);
     uint3 conditions = make_uint3(0,0,0);
 
-    // shorthand copies of the indexers
-    Index3D ci = m_cell_indexer;
-    Index2D cli = m_cell_list_indexer;
-
-    // clear the bin sizes to 0
-    memset(h_cell_size.data, 0, sizeof(unsigned int) * m_cell_indexer.getNumElements());
-
     Scalar3 ghost_width = getGhostWidth();
 
     // get periodic flags
@@ -471,17 +465,17 @@ void CellList::computeCellList()
     // for each particle
     unsigned n_tot_particles = m_pdata->getN() + m_pdata->getNGhosts();
 
-    for (unsigned int n = 0; n < n_tot_particles; n++)
+    // markers for particles without a bin
+    const unsigned int nan_bin = 0xffffffff;
+    const unsigned int out_of_bounds_bin = 0xfffffffe;
+
+    // find the bin each particle belongs in
+    auto find_bin = [&](unsigned int n) -> unsigned int
         {
         Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
         if (std::isnan(p.x) || std::isnan(p.y) || std::isnan(p.z))
-            {
-            conditions.y = n+1;
-            continue;
-            }
+            return nan_bin;
 
-
-        // find the bin each particle belongs in
         Scalar3 f = box.makeFraction(p,ghost_width);
         int ib = (int)(f.x * m_dim.x);
         int jb = (int)(f.y * m_dim.y);
@@ -491,12 +485,7 @@ void CellList::computeCellList()
         if ((f.x < Scalar(-0.00001) || f.x >= Scalar(1.00001)) ||
             (f.y < Scalar(-0.00001) || f.y >= Scalar(1.00001)) ||
             (f.z < Scalar(-0.00001) || f.z >= Scalar(1.00001)) )
-            {
-            // if a ghost particle is out of bounds, silently ignore it
-            if (n < m_pdata->getN())
-                conditions.z = n+1;
-            continue;
-            }
+            return out_of_bounds_bin;
 
         // need to handle the case where the particle is exactly at the box hi
         if (ib == (int)m_dim.x && periodic.x)
@@ -509,34 +498,138 @@ void CellList::computeCellList()
         // sanity check
         assert((ib < (int)(m_dim.x) && jb < (int)(m_dim.y) && kb < (int)(m_dim.z)) || n>=m_pdata->getN());
 
-        // record its bin
-        unsigned int bin = ci(ib, jb, kb);
-
         // all particles should be in a valid cell
         if (ib < 0 || ib >= (int)m_dim.x ||
             jb < 0 || jb >= (int)m_dim.y ||
             kb < 0 || kb >= (int)m_dim.z)
+            return out_of_bounds_bin;
+
+        return m_cell_indexer(ib, jb, kb);
+        };
+
+    /* The cell list is built by a counting sort over contiguous chunks of particles, one chunk per thread. The first
+       pass finds the bin of every particle and counts the particles per cell in each chunk. A prefix sum over the
+       chunks gives the first slot of each chunk in every cell, and the cell sizes, so the cell list can be enlarged
+       before the second pass scatters the particles. The particles in each cell are in index order regardless of the
+       number of threads.
+    */
+    unsigned int n_chunks = 1;
+    #ifdef ENABLE_TBB
+    n_chunks = std::max(1u, std::min(m_exec_conf->getNumThreads(), n_tot_particles));
+    #endif
+
+    auto chunk_begin = [&](unsigned int chunk)
+        {
+        return (unsigned int)((uint64_t)n_tot_particles * chunk / n_chunks);
+        };
+
+    // for each chunk, the count (and later the next free slot) per cell, and the last invalid particles + 1
+    const unsigned int n_cells = m_cell_indexer.getNumElements();
+    m_particle_bin.resize(n_tot_particles);
+    m_chunk_cell_offset.resize(n_chunks*n_cells);
+    std::vector<uint2> chunk_conditions(n_chunks, make_uint2(0,0));
+
+    auto count_chunk = [&](unsigned int chunk)
+        {
+        unsigned int *count = m_chunk_cell_offset.data() + chunk*n_cells;
+        memset(count, 0, sizeof(unsigned int)*n_cells);
+        for (unsigned int n = chunk_begin(chunk); n < chunk_begin(chunk+1); n++)
             {
-            // but ghost particles that are out of range should not produce an error
-            if (n < m_pdata->getN())
-                conditions.z = n+1;
-            continue;
+            unsigned int bin = find_bin(n);
+            m_particle_bin[n] = bin;
+
+            if (bin == nan_bin)
+                chunk_conditions[chunk].x = n+1;
+            else if (bin == out_of_bounds_bin)
+                {
+                // if a ghost particle is out of bounds, silently ignore it
+                if (n < m_pdata->getN())
+                    chunk_conditions[chunk].y = n+1;
+                }
+            else
+                count[bin]++;
             }
+        };
 
-        // setup the flag value to store
-        Scalar flag;
-        if (m_flag_charge)
-            flag = h_charge.data[n];
-        else if (m_flag_type)
-            flag = h_pos.data[n].w;
-        else
-            flag = __int_as_scalar(n);
+    #ifdef ENABLE_TBB
+    if (n_chunks > 1)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_chunks),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int chunk = r.begin(); chunk != r.end(); ++chunk)
+                count_chunk(chunk);
+            });
+        }
+    else
+    #endif
+        {
+        count_chunk(0);
+        }
 
-        // store the bin entries
-        unsigned int offset = h_cell_size.data[bin];
+    for (unsigned int chunk = 0; chunk < n_chunks; chunk++)
+        {
+        conditions.y = std::max(conditions.y, chunk_conditions[chunk].x);
+        conditions.z = std::max(conditions.z, chunk_conditions[chunk].y);
+        }
 
-        if (offset < m_Nmax)
+    // turn the counts into the first slot of each chunk, and find the largest cell
+    std::vector<unsigned int> cell_size(n_cells);
+    unsigned int max_cell_size = 0;
+    for (unsigned int bin = 0; bin < n_cells; bin++)
+        {
+        unsigned int offset = 0;
+        for (unsigned int chunk = 0; chunk < n_chunks; chunk++)
             {
+            unsigned int count = m_chunk_cell_offset[chunk*n_cells + bin];
+            m_chunk_cell_offset[chunk*n_cells + bin] = offset;
+            offset += count;
+            }
+        cell_size[bin] = offset;
+        max_cell_size = std::max(max_cell_size, offset);
+        }
+
+    // enlarge the cell list before filling it, so it never overflows
+    if (max_cell_size > m_Nmax)
+        {
+        m_exec_conf->msg->notice(6) << "cell list: growing Nmax " << m_Nmax << " -> " << max_cell_size << endl;
+        m_Nmax = max_cell_size;
+        initializeMemory();
+        }
+
+    // access the cell list data arrays
+    ArrayHandle<unsigned int> h_cell_size(m_cell_size, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_xyzf(m_xyzf, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_cell_orientation(m_orientation, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_cell_idx(m_idx, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_tdb(m_tdb, access_location::host, access_mode::overwrite);
+
+    std::copy(cell_size.begin(), cell_size.end(), h_cell_size.data);
+
+    // shorthand copy of the indexer
+    Index2D cli = m_cell_list_indexer;
+
+    auto fill_chunk = [&](unsigned int chunk)
+        {
+        unsigned int *next_slot = m_chunk_cell_offset.data() + chunk*n_cells;
+        for (unsigned int n = chunk_begin(chunk); n < chunk_begin(chunk+1); n++)
+            {
+            unsigned int bin = m_particle_bin[n];
+            if (bin == nan_bin || bin == out_of_bounds_bin)
+                continue;
+
+            // setup the flag value to store
+            Scalar flag;
+            if (m_flag_charge)
+                flag = h_charge.data[n];
+            else if (m_flag_type)
+                flag = h_pos.data[n].w;
+            else
+                flag = __int_as_scalar(n);
+
+            // store the bin entries
+            unsigned int offset = next_slot[bin]++;
+
             if (m_compute_xyzf)
                 {
                 h_xyzf.data[cli(offset, bin)] = make_scalar4(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z, flag);
@@ -560,13 +653,22 @@ void CellList::computeCellList()
                 h_cell_idx.data[cli(offset, bin)] = n;
                 }
             }
-        else
-            {
-            conditions.x = max((unsigned int)conditions.x, offset+1);
-            }
+        };
 
-        // increment the cell occupancy counter
-        h_cell_size.data[bin]++;
+    #ifdef ENABLE_TBB
+    if (n_chunks > 1)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_chunks),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int chunk = r.begin(); chunk != r.end(); ++chunk)
+                fill_chunk(chunk);
+            });
+        }
+    else
+    #endif
+        {
+        fill_chunk(0);
         }
 
         {
@@ -11,6 +11,7 @@
 #include "Compute.h"
 
 #include <memory>
+#include <vector>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 
 /*! \file CellList.h
@@ -86,8 +87,8 @@
     <b>Overflow and error flag handling:</b>
     For easy support of derived GPU classes to implement overflow detection and error handling, all error flags are
     stored in the GlobalArray \a d_conditions.
-     - 0: Maximum cell size (implementations are free to write to this element only in overflow conditions if they
-          choose.)
+     - 0: Maximum cell size (implementations count the particles per cell and enlarge the cell list before filling
+          it, they are free to write to this element only in overflow conditions if they choose.)
      - 1: Set to non-zero if any particle has nan coordinates
      - 2: Set to non-zero if any particle is outside of the addressable bins
 
@@ -389,6 +390,8 @@ class PYBIND11_EXPORT CellList : public Compute
         GlobalArray<Scalar4> m_orientation;     //!< Cell list with orientation
         GlobalArray<unsigned int> m_idx;        //!< Cell list with index
         GlobalArray<uint3> m_conditions;        //!< Condition flags set during the computeCellList() call
+        std::vector<unsigned int> m_particle_bin; //!< Bin of each particle, found by computeCellList()
+        std::vector<unsigned int> m_chunk_cell_offset; //!< Per chunk of particles, the next free slot in each cell
 
         bool m_sort_cell_list;               //!< If true, sort cell list
         bool m_compute_adj_list;            //!< If true, compute the cell adjacency lists
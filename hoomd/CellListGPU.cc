@@ -26,8 +26,9 @@ CellListGPU::CellListGPU(std::shared_ptr<SystemDefinition> sysdef)
         throw std::runtime_error("Error initializing CellListGPU");
         }
 
-    m_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "cell_list", this->m_exec_conf));
-    m_tuner_combine.reset(new Autotuner(32, 1024, 32, 5, 100000, "cell_list_combine", this->m_exec_conf));
+    unsigned int warp_size = this->m_exec_conf->dev_prop.warpSize;
+    m_tuner.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "cell_list", this->m_exec_conf));
+    m_tuner_combine.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "cell_list_combine", this->m_exec_conf));
 
     }
 
@@ -46,6 +47,42 @@ void CellListGPU::computeCellList()
     BoxDim box = m_pdata->getBox();
     unsigned int ngpu = m_exec_conf->getNumActiveGPUs();
 
+        {
+        // count the particles in each cell of the combined list, which bounds the per-GPU lists as well
+        ArrayHandle<unsigned int> d_cell_size(m_cell_size, access_location::device, access_mode::overwrite);
+        ArrayHandle<uint3> d_conditions(m_conditions, access_location::device, access_mode::readwrite);
+
+        hipMemsetAsync(d_cell_size.data, 0, sizeof(unsigned int)*m_cell_indexer.getNumElements(),0);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+
+        m_exec_conf->beginMultiGPU();
+
+        gpu_count_cell_list(d_cell_size.data,
+                            d_conditions.data,
+                            d_pos.data,
+                            m_pdata->getN(),
+                            m_pdata->getNGhosts(),
+                            box,
+                            m_cell_indexer,
+                            getGhostWidth(),
+                            m_tuner->getParam(),
+                            m_pdata->getGPUPartition());
+        if(m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+
+        m_exec_conf->endMultiGPU();
+        }
+
+    // enlarge the cell list before filling it, so it never overflows
+    uint3 conditions = readConditions();
+    if (conditions.x > m_Nmax)
+        {
+        m_exec_conf->msg->notice(6) << "cell list: growing Nmax " << m_Nmax << " -> " << conditions.x << endl;
+        m_Nmax = conditions.x;
+        initializeMemory();
+        }
+
         {
         // access the cell list data arrays
         ArrayHandle<unsigned int> d_cell_size(m_cell_size, access_location::device, access_mode::overwrite);
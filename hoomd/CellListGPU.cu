@@ -16,6 +16,139 @@
     \brief Defines GPU kernel code for cell list generation on the GPU
 */
 
+//! Marker for particles with a NaN position
+const unsigned int cell_list_nan_bin = 0xffffffff;
+
+//! Marker for particles outside of the addressable bins
+const unsigned int cell_list_out_of_bounds_bin = 0xfffffffe;
+
+//! Find the bin of a particle
+/*! \param pos Particle position
+    \param box Box dimensions
+    \param ci Indexer to compute cell id from cell grid coords
+    \param ghost_width Width of ghost layer
+
+    \returns The cell index, cell_list_nan_bin, or cell_list_out_of_bounds_bin
+*/
+__device__ inline unsigned int gpu_cell_list_find_bin(const Scalar3& pos,
+                                                      const BoxDim& box,
+                                                      const Index3D& ci,
+                                                      const Scalar3& ghost_width)
+    {
+    // check for nan pos
+    if (isnan(pos.x) || isnan(pos.y) || isnan(pos.z))
+        return cell_list_nan_bin;
+
+    uchar3 periodic = box.getPeriodic();
+    Scalar3 f = box.makeFraction(pos,ghost_width);
+
+    // check if the particle is inside the unit cell + ghost layer in all dimensions
+    if ((f.x < Scalar(-0.00001) || f.x >= Scalar(1.00001)) ||
+        (f.y < Scalar(-0.00001) || f.y >= Scalar(1.00001)) ||
+        (f.z < Scalar(-0.00001) || f.z >= Scalar(1.00001)) )
+        return cell_list_out_of_bounds_bin;
+
+    // find the bin each particle belongs in
+    int ib = (int)(f.x * ci.getW());
+    int jb = (int)(f.y * ci.getH());
+    int kb = (int)(f.z * ci.getD());
+
+    // need to handle the case where the particle is exactly at the box hi
+    if (ib == ci.getW() && periodic.x)
+        ib = 0;
+    if (jb == ci.getH() && periodic.y)
+        jb = 0;
+    if (kb == ci.getD() && periodic.z)
+        kb = 0;
+
+    // all particles should be in a valid cell
+    if (ib < 0 || ib >= (int)ci.getW() ||
+        jb < 0 || jb >= (int)ci.getH() ||
+        kb < 0 || kb >= (int)ci.getD())
+        return cell_list_out_of_bounds_bin;
+
+    return ci(ib, jb, kb);
+    }
+
+//! Record the error conditions of a particle without a bin
+/*! \param d_conditions Conditions flags for detecting overflow and other error conditions
+    \param bin Bin of the particle
+    \param idx Index of the particle
+    \param N Number of particles
+
+    \returns True if the particle has no bin
+*/
+__device__ inline bool gpu_cell_list_check_bin(uint3 *d_conditions,
+                                               const unsigned int bin,
+                                               const unsigned int idx,
+                                               const unsigned int N)
+    {
+    if (bin == cell_list_nan_bin)
+        {
+        (*d_conditions).y = idx+1;
+        return true;
+        }
+
+    if (bin == cell_list_out_of_bounds_bin)
+        {
+        // but ghost particles that are out of range should not produce an error
+        if (idx < N)
+            {
+            #if (__CUDA_ARCH__ >= 600)
+            atomicMax_system(&(*d_conditions).z, idx+1);
+            #else
+            atomicMax(&(*d_conditions).z, idx+1);
+            #endif
+            }
+        return true;
+        }
+
+    return false;
+    }
+
+//! Kernel that counts the particles in each cell
+/*! \param d_cell_size Number of particles in each cell
+    \param d_conditions Conditions flags for detecting overflow and other error conditions
+    \param d_pos Particle position array
+    \param N Number of particles
+    \param box Box dimensions
+    \param ci Indexer to compute cell id from cell grid coords
+    \param ghost_width Width of ghost layer
+    \param nwork Number of particles to process
+    \param offset Index of the first particle to process
+
+    The largest cell size is written to d_conditions.x, so that the cell list can be allocated before it is filled.
+*/
+__global__ void gpu_count_cell_list_kernel(unsigned int *d_cell_size,
+                                           uint3 *d_conditions,
+                                           const Scalar4 *d_pos,
+                                           const unsigned int N,
+                                           const BoxDim box,
+                                           const Index3D ci,
+                                           const Scalar3 ghost_width,
+                                           const unsigned int nwork,
+                                           const unsigned int offset)
+    {
+    unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+    if (idx >= nwork)
+        return;
+
+    idx += offset;
+
+    Scalar4 postype = d_pos[idx];
+    unsigned int bin = gpu_cell_list_find_bin(make_scalar3(postype.x, postype.y, postype.z), box, ci, ghost_width);
+    if (gpu_cell_list_check_bin(d_conditions, bin, idx, N))
+        return;
+
+    #if (__CUDA_ARCH__ >= 600)
+    unsigned int size = atomicAdd_system(&d_cell_size[bin], 1);
+    atomicMax_system(&(*d_conditions).x, size+1);
+    #else
+    unsigned int size = atomicAdd(&d_cell_size[bin], 1);
+    atomicMax(&(*d_conditions).x, size+1);
+    #endif
+    }
+
 //! Kernel that computes the cell list on the GPU
 /*! \param d_cell_size Number of particles in each cell
     \param d_xyzf Cell XYZF data array
@@ -73,6 +206,10 @@ __global__ void gpu_compute_cell_list_kernel(unsigned int *d_cell_size,
     Scalar4 postype = d_pos[idx];
     Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
 
+    unsigned int bin = gpu_cell_list_find_bin(pos, box, ci, ghost_width);
+    if (gpu_cell_list_check_bin(d_conditions, bin, idx, N))
+        return;
+
     Scalar flag = 0;
     Scalar diameter = 0;
     Scalar body = 0;
@@ -95,60 +232,6 @@ __global__ void gpu_compute_cell_list_kernel(unsigned int *d_cell_size,
     else
         flag = __int_as_scalar(idx);
 
-    // check for nan pos
-    if (isnan(pos.x) || isnan(pos.y) || isnan(pos.z))
-        {
-        (*d_conditions).y = idx+1;
-        return;
-        }
-
-    uchar3 periodic = box.getPeriodic();
-    Scalar3 f = box.makeFraction(pos,ghost_width);
-
-    // check if the particle is inside the unit cell + ghost layer in all dimensions
-    if ((f.x < Scalar(-0.00001) || f.x >= Scalar(1.00001)) ||
-        (f.y < Scalar(-0.00001) || f.y >= Scalar(1.00001)) ||
-        (f.z < Scalar(-0.00001) || f.z >= Scalar(1.00001)) )
-        {
-        // if a ghost particle is out of bounds, silently ignore it
-        if (idx < N)
-            (*d_conditions).z = idx+1;
-        return;
-        }
-
-    // find the bin each particle belongs in
-    int ib = (int)(f.x * ci.getW());
-    int jb = (int)(f.y * ci.getH());
-    int kb = (int)(f.z * ci.getD());
-
-    // need to handle the case where the particle is exactly at the box hi
-    if (ib == ci.getW() && periodic.x)
-        ib = 0;
-    if (jb == ci.getH() && periodic.y)
-        jb = 0;
-    if (kb == ci.getD() && periodic.z)
-        kb = 0;
-
-    unsigned int bin = ci(ib, jb, kb);
-
-    // all particles should be in a valid cell
-    // all particles should be in a valid cell
-    if (ib < 0 || ib >= (int)ci.getW() ||
-        jb < 0 || jb >= (int)ci.getH() ||
-        kb < 0 || kb >= (int)ci.getD())
-        {
-        // but ghost particles that are out of range should not produce an error
-        if (idx < N)
-            {
-            #if (__CUDA_ARCH__ >= 600)
-            atomicMax_system(&(*d_conditions).z, idx+1);
-            #else
-            atomicMax(&(*d_conditions).z, idx+1);
-            #endif
-            }
-        return;
-        }
-
     unsigned int size = atomicInc(&d_cell_size[bin], 0xffffffff);
 
     if (size < Nmax)
@@ -174,6 +257,52 @@ __global__ void gpu_compute_cell_list_kernel(unsigned int *d_cell_size,
         }
     }
 
+void gpu_count_cell_list(unsigned int *d_cell_size,
+                         uint3 *d_conditions,
+                         const Scalar4 *d_pos,
+                         const unsigned int N,
+                         const unsigned int n_ghost,
+                         const BoxDim& box,
+                         const Index3D& ci,
+                         const Scalar3& ghost_width,
+                         const unsigned int block_size,
+                         const GPUPartition& gpu_partition)
+    {
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, reinterpret_cast<const void *>(&gpu_count_cell_list_kernel));
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
+    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+
+        // process ghosts in final range
+        if (idev == (int)gpu_partition.getNumActiveGPUs()-1)
+            nwork += n_ghost;
+
+        unsigned int run_block_size = min(block_size, max_block_size);
+        int n_blocks = nwork/run_block_size + 1;
+
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_count_cell_list_kernel), dim3(n_blocks), dim3(run_block_size), 0, 0,
+                                                                 d_cell_size,
+                                                                 d_conditions,
+                                                                 d_pos,
+                                                                 N,
+                                                                 box,
+                                                                 ci,
+                                                                 ghost_width,
+                                                                 nwork,
+                                                                 range.first);
+        }
+    }
+
 void gpu_compute_cell_list(unsigned int *d_cell_size,
                                   Scalar4 *d_xyzf,
                                   Scalar4 *d_tdb,
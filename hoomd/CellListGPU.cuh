@@ -20,6 +20,18 @@
     \brief Declares GPU kernel code for cell list generation on the GPU
 */
 
+//! Kernel driver for gpu_count_cell_list_kernel()
+void gpu_count_cell_list(unsigned int *d_cell_size,
+                         uint3 *d_conditions,
+                         const Scalar4 *d_pos,
+                         const unsigned int N,
+                         const unsigned int n_ghost,
+                         const BoxDim& box,
+                         const Index3D& ci,
+                         const Scalar3& ghost_width,
+                         const unsigned int block_size,
+                         const GPUPartition& gpu_partition);
+
 //! Kernel driver for gpu_compute_cell_list_kernel()
 void gpu_compute_cell_list(unsigned int *d_cell_size,
                                   Scalar4 *d_xyzf,
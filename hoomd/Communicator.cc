@@ -224,7 +224,6 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
             {
             ArrayHandle<unsigned int> h_begin(m_comm.m_begin, access_location::host, access_mode::read);
             ArrayHandle<unsigned int> h_end(m_comm.m_end, access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors, access_location::host, access_mode::read);
 
             unsigned int send_bytes = 0;
             unsigned int recv_bytes = 0;
@@ -234,24 +233,10 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
             for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
                 n_send_groups[ineigh] = h_end.data[ineigh] - h_begin.data[ineigh];
 
-            MPI_Request req[2*m_comm.m_n_unique_neigh];
-            MPI_Status stat[2*m_comm.m_n_unique_neigh];
-
-            unsigned int nreq = 0;
-
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                MPI_Isend(&n_send_groups[ineigh], 1, MPI_UNSIGNED, neighbor, 0, m_comm.m_mpi_comm, & req[nreq++]);
-                MPI_Irecv(&n_recv_groups[ineigh], 1, MPI_UNSIGNED, neighbor, 0, m_comm.m_mpi_comm, & req[nreq++]);
-                send_bytes += (unsigned int)sizeof(unsigned int);
-                recv_bytes += (unsigned int)sizeof(unsigned int);
-                } // end neighbor loop
-
-            MPI_Waitall(nreq, req, stat);
+            // exchange the counts over the persistent neighbor requests
+            unsigned int n_active = m_comm.exchangeNeighborCounts(n_send_groups, n_recv_groups);
+            send_bytes += (unsigned int)(n_active*sizeof(unsigned int));
+            recv_bytes += (unsigned int)(n_active*sizeof(unsigned int));
 
             // sum up receive counts
             for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
@@ -507,7 +492,6 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
             {
             ArrayHandle<unsigned int> h_begin(m_comm.m_begin, access_location::host, access_mode::read);
             ArrayHandle<unsigned int> h_end(m_comm.m_end, access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors, access_location::host, access_mode::read);
 
             unsigned int send_bytes = 0;
             unsigned int recv_bytes = 0;
@@ -517,24 +501,10 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
             for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
                 n_send_groups[ineigh] = h_end.data[ineigh] - h_begin.data[ineigh];
 
-            MPI_Request req[2*m_comm.m_n_unique_neigh];
-            MPI_Status stat[2*m_comm.m_n_unique_neigh];
-
-            unsigned int nreq = 0;
-
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                MPI_Isend(&n_send_groups[ineigh], 1, MPI_UNSIGNED, neighbor, 0, m_comm.m_mpi_comm, & req[nreq++]);
-                MPI_Irecv(&n_recv_groups[ineigh], 1, MPI_UNSIGNED, neighbor, 0, m_comm.m_mpi_comm, & req[nreq++]);
-                send_bytes += (unsigned int)sizeof(unsigned int);
-                recv_bytes += (unsigned int)sizeof(unsigned int);
-                } // end neighbor loop
-
-            MPI_Waitall(nreq, req, stat);
+            // exchange the counts over the persistent neighbor requests
+            unsigned int n_active = m_comm.exchangeNeighborCounts(n_send_groups, n_recv_groups);
+            send_bytes += (unsigned int)(n_active*sizeof(unsigned int));
+            recv_bytes += (unsigned int)(n_active*sizeof(unsigned int));
 
             // sum up receive counts
             for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
@@ -1078,6 +1048,11 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
             m_nettorque_copybuf(m_exec_conf),
             m_netvirial_copybuf(m_exec_conf),
             m_netvirial_recvbuf(m_exec_conf),
+            m_ghost_field_copybuf(m_exec_conf),
+            m_pos_update_copybuf(m_exec_conf),
+            m_pos_update_recvbuf(m_exec_conf),
+            m_vel_update_copybuf(m_exec_conf),
+            m_vel_update_recvbuf(m_exec_conf),
             m_plan(m_exec_conf),
             m_plan_reverse(m_exec_conf),
             m_tag_reverse(m_exec_conf),
@@ -1086,9 +1061,16 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
             m_r_ghost_max(Scalar(0.0)),
             m_r_extra_ghost_max(Scalar(0.0)),
             m_ghosts_added(0),
+            m_body_center_ghosts(false),
             m_has_ghost_particles(false),
             m_last_flags(0),
             m_comm_pending(false),
+            m_defer_ghost_update(false),
+            m_ghost_update_dir(0),
+            m_ghost_update_start(0),
+            m_migrate_time(0),
+            m_exchange_ghosts_time(0),
+            m_update_ghosts_time(0),
             m_bond_comm(*this, m_sysdef->getBondData()),
             m_angle_comm(*this, m_sysdef->getAngleData()),
             m_dihedral_comm(*this, m_sysdef->getDihedralData()),
@@ -1144,6 +1126,9 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
     GlobalArray<Scalar> r_ghost(m_pdata->getNTypes(), m_exec_conf);
     m_r_ghost.swap(r_ghost);
 
+    GlobalArray<Scalar> r_ghost_send(m_pdata->getNTypes(), m_exec_conf);
+    m_r_ghost_send.swap(r_ghost_send);
+
     GlobalArray<Scalar> r_ghost_body(m_pdata->getNTypes(), m_exec_conf);
     m_r_ghost_body.swap(r_ghost_body);
 
@@ -1234,6 +1219,7 @@ Communicator::~Communicator()
     m_sysdef->getConstraintData()->getGroupNumChangeSignal().disconnect<Communicator, &Communicator::setConstraintsChanged>(this);
     m_sysdef->getPairData()->getGroupNumChangeSignal().disconnect<Communicator, &Communicator::setPairsChanged>(this);
 
+    freeNeighborCountRequests();
     MPI_Type_free(&m_mpi_pdata_element);
     }
 
@@ -1327,6 +1313,92 @@ void Communicator::initializeNeighborArrays()
         h_adj_mask.data[n] = it->second;
         n++;
         }
+
+    initializeNeighborCountRequests();
+    }
+
+/*! The neighbor ranks are fixed by the processor grid, and load balancing only moves the domain boundaries.
+    The requests are therefore set up once with MPI_Send_init and MPI_Recv_init, and every exchange only starts
+    and completes them.
+*/
+void Communicator::initializeNeighborCountRequests()
+    {
+    freeNeighborCountRequests();
+
+    m_neigh_send_count.resize(m_n_unique_neigh);
+    m_neigh_recv_count.resize(m_n_unique_neigh);
+    m_neigh_count_reqs.resize(2*m_n_unique_neigh);
+
+    ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors, access_location::host, access_mode::read);
+    for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
+        {
+        unsigned int neighbor = h_unique_neighbors.data[ineigh];
+        MPI_Send_init(&m_neigh_send_count[ineigh], 1, MPI_UNSIGNED, neighbor, 0, m_mpi_comm,
+                      &m_neigh_count_reqs[2*ineigh]);
+        MPI_Recv_init(&m_neigh_recv_count[ineigh], 1, MPI_UNSIGNED, neighbor, 0, m_mpi_comm,
+                      &m_neigh_count_reqs[2*ineigh+1]);
+        }
+    }
+
+void Communicator::freeNeighborCountRequests()
+    {
+    for (auto& req : m_neigh_count_reqs)
+        MPI_Request_free(&req);
+    m_neigh_count_reqs.clear();
+    }
+
+/*! \param send_counts Count to send to each unique neighbor
+    \param recv_counts Count received from each unique neighbor (output)
+    \param stages Communication stage of each unique neighbor, or NULL if all neighbors participate
+    \param stage Stage to exchange counts in
+    \returns The number of neighbors that participated
+
+    Both count arrays are indexed like m_unique_neighbors. The counts of neighbors that do not participate in
+    \a stage are set to zero.
+*/
+unsigned int Communicator::exchangeNeighborCounts(unsigned int *send_counts, unsigned int *recv_counts,
+                                                  const int *stages, int stage)
+    {
+    unsigned int n_active = 0;
+    for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
+        {
+        if (stages && stages[ineigh] != stage)
+            {
+            // skip neighbor if not participating in this communication stage
+            send_counts[ineigh] = 0;
+            recv_counts[ineigh] = 0;
+            continue;
+            }
+
+        m_neigh_send_count[ineigh] = send_counts[ineigh];
+        MPI_Start(&m_neigh_count_reqs[2*ineigh]);
+        MPI_Start(&m_neigh_count_reqs[2*ineigh+1]);
+        n_active++;
+        }
+
+    if (n_active && n_active == m_n_unique_neigh)
+        {
+        MPI_Waitall((int)m_neigh_count_reqs.size(), &m_neigh_count_reqs.front(), MPI_STATUSES_IGNORE);
+        }
+    else
+        {
+        for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
+            {
+            if (stages[ineigh] != stage)
+                continue;
+
+            MPI_Wait(&m_neigh_count_reqs[2*ineigh], MPI_STATUS_IGNORE);
+            MPI_Wait(&m_neigh_count_reqs[2*ineigh+1], MPI_STATUS_IGNORE);
+            }
+        }
+
+    for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
+        {
+        if (! stages || stages[ineigh] == stage)
+            recv_counts[ineigh] = m_neigh_recv_count[ineigh];
+        }
+
+    return n_active;
     }
 
 //! Interface to the communication methods.
@@ -1346,8 +1418,10 @@ void Communicator::communicate(unsigned int timestep)
     if (!m_force_migrate && !m_compute_callbacks.empty() && m_has_ghost_particles)
         {
         // do an obligatory update before determining whether to migrate
+        int64_t start = m_comm_clk.getTime();
         beginUpdateGhosts(timestep);
         finishUpdateGhosts(timestep);
+        m_update_ghosts_time += m_comm_clk.getTime() - start;
 
         // call subscribers after ghost update, but before distance check
         m_compute_callbacks.emit(timestep);
@@ -1373,9 +1447,13 @@ void Communicator::communicate(unsigned int timestep)
     // Update ghosts if we are not migrating
     if (!migrate && m_compute_callbacks.empty())
         {
+        int64_t start = m_comm_clk.getTime();
         beginUpdateGhosts(timestep);
 
-        finishUpdateGhosts(timestep);
+        // beginCommunicate() leaves the update in flight for the caller to finish
+        if (! m_defer_ghost_update)
+            finishUpdateGhosts(timestep);
+        m_update_ghosts_time += m_comm_clk.getTime() - start;
         }
 
     // Check if migration of particles is requested
@@ -1384,10 +1462,14 @@ void Communicator::communicate(unsigned int timestep)
         m_force_migrate = false;
 
         // If so, migrate atoms
+        int64_t start = m_comm_clk.getTime();
         migrateParticles();
+        int64_t end = m_comm_clk.getTime();
+        m_migrate_time += end - start;
 
         // Construct ghost send lists, exchange ghost atom data
         exchangeGhosts();
+        m_exchange_ghosts_time += m_comm_clk.getTime() - end;
 
         // update particle data now that ghosts are available
         m_compute_callbacks.emit(timestep);
@@ -1398,6 +1480,37 @@ void Communicator::communicate(unsigned int timestep)
     m_is_communicating = false;
     }
 
+/*! \param timestep The time step
+*/
+void Communicator::beginCommunicate(unsigned int timestep)
+    {
+    m_defer_ghost_update = true;
+    communicate(timestep);
+    m_defer_ghost_update = false;
+    }
+
+/*! \param timestep The time step
+*/
+void Communicator::endCommunicate(unsigned int timestep)
+    {
+    int64_t start = m_comm_clk.getTime();
+    finishUpdateGhosts(timestep);
+    m_update_ghosts_time += m_comm_clk.getTime() - start;
+    }
+
+/*! The times accumulate over all calls to communicate() since construction or the last call to
+    resetCommunicationTimes(). They measure the wall clock time on this rank, including the time spent waiting
+    for the neighboring ranks.
+*/
+pybind11::dict Communicator::getCommunicationTimes() const
+    {
+    pybind11::dict result;
+    result["migrate"] = double(m_migrate_time) / 1e9;
+    result["exchange_ghosts"] = double(m_exchange_ghosts_time) / 1e9;
+    result["update_ghosts"] = double(m_update_ghosts_time) / 1e9;
+    return result;
+    }
+
 //! Transfer particles between neighboring domains
 void Communicator::migrateParticles()
     {
@@ -1548,21 +1661,46 @@ void Communicator::updateGhostWidth()
             }
         }
 
-    if (!m_ghost_layer_width_requests.empty())
+    const unsigned int ntypes = m_pdata->getNTypes();
+    m_r_ghost_type.assign(ntypes, Scalar(0.0));
+    m_r_ghost_pair.assign(ntypes*ntypes, Scalar(0.0));
+
+    if (!m_ghost_layer_pair_width_requests.empty())
+        {
+        // reduce per type pair using the signals
+        for (unsigned int type_i = 0; type_i < ntypes; ++type_i)
+            for (unsigned int type_j = 0; type_j < ntypes; ++type_j)
+                {
+                Scalar& r_ghost_ij = m_r_ghost_pair[type_i*ntypes + type_j];
+                m_ghost_layer_pair_width_requests.emit_accumulate([&](Scalar r)
+                                                                    {
+                                                                    if (r > r_ghost_ij) r_ghost_ij = r;
+                                                                    }
+                                                                    ,type_i, type_j);
+                }
+        }
+
+    if (!m_ghost_layer_width_requests.empty() || !m_ghost_layer_pair_width_requests.empty())
         {
         // update the ghost layer width only if subscribers are available
         ArrayHandle<Scalar> h_r_ghost(m_r_ghost, access_location::host, access_mode::readwrite);
 
         // reduce per type using the signals, and then overall
         Scalar r_ghost_max = 0.0;
-        for (unsigned int cur_type = 0; cur_type < m_pdata->getNTypes(); ++cur_type)
+        for (unsigned int cur_type = 0; cur_type < ntypes; ++cur_type)
             {
-            Scalar r_ghost_i = 0.0;
+            Scalar& r_ghost_type = m_r_ghost_type[cur_type];
             m_ghost_layer_width_requests.emit_accumulate([&](Scalar r)
                                                             {
-                                                            if (r > r_ghost_i) r_ghost_i = r;
+                                                            if (r > r_ghost_type) r_ghost_type = r;
                                                             }
                                                             ,cur_type);
+
+            // the full ghost layer width covers interactions with all types
+            Scalar r_ghost_i = r_ghost_type;
+            for (unsigned int type_j = 0; type_j < ntypes; ++type_j)
+                r_ghost_i = std::max(r_ghost_i, m_r_ghost_pair[cur_type*ntypes + type_j]);
+
             h_r_ghost.data[cur_type] = r_ghost_i;
             if (r_ghost_i > r_ghost_max) r_ghost_max = r_ghost_i;
             }
@@ -1590,6 +1728,70 @@ void Communicator::updateGhostWidth()
         }
     }
 
+/*! The ghost layer of a type only needs to reach the particles it interacts with. This method marks the types
+    present in this domain and in the 26 neighboring domains, and sets m_r_ghost_send to the largest pair width of each
+    type with the present types. A ghost sent to a face neighbor may be forwarded to an edge or corner neighbor in a
+    later stage, so the union over the full neighborhood is needed, computed by exchanging the type flags with the two
+    neighbors along each dimension in turn. m_r_ghost and m_r_ghost_max remain the widths for all types, as used to
+    size the cell list and to check the domain size.
+ */
+void Communicator::updateGhostSendWidth()
+    {
+    const unsigned int ntypes = m_pdata->getNTypes();
+    ArrayHandle<Scalar> h_r_ghost_send(m_r_ghost_send, access_location::host, access_mode::overwrite);
+
+    if (m_ghost_layer_pair_width_requests.empty())
+        {
+        // no pair widths to prune
+        ArrayHandle<Scalar> h_r_ghost(m_r_ghost, access_location::host, access_mode::read);
+        std::copy(h_r_ghost.data, h_r_ghost.data + ntypes, h_r_ghost_send.data);
+        return;
+        }
+
+    std::vector<unsigned int> types(ntypes, 0);
+    findLocalTypes(types);
+
+    std::vector<unsigned int> recv_types(2*ntypes);
+    for (unsigned int dim = 0; dim < 3; ++dim)
+        {
+        if (! isCommunicating(2*dim)) continue;
+
+        // exchange the flags with both neighbors along this dimension, including those received along previous ones
+        MPI_Request reqs[4];
+        MPI_Isend(&types.front(), ntypes, MPI_UNSIGNED, m_decomposition->getNeighborRank(2*dim), 0, m_mpi_comm,
+            &reqs[0]);
+        MPI_Isend(&types.front(), ntypes, MPI_UNSIGNED, m_decomposition->getNeighborRank(2*dim+1), 0, m_mpi_comm,
+            &reqs[1]);
+        MPI_Irecv(&recv_types.front(), ntypes, MPI_UNSIGNED, m_decomposition->getNeighborRank(2*dim+1), 0,
+            m_mpi_comm, &reqs[2]);
+        MPI_Irecv(&recv_types.front() + ntypes, ntypes, MPI_UNSIGNED, m_decomposition->getNeighborRank(2*dim), 0,
+            m_mpi_comm, &reqs[3]);
+        MPI_Waitall(4, reqs, MPI_STATUSES_IGNORE);
+
+        for (unsigned int cur_type = 0; cur_type < ntypes; ++cur_type)
+            types[cur_type] |= recv_types[cur_type] | recv_types[ntypes + cur_type];
+        }
+
+    for (unsigned int type_i = 0; type_i < ntypes; ++type_i)
+        {
+        Scalar r_ghost_i = m_r_ghost_type[type_i];
+        for (unsigned int type_j = 0; type_j < ntypes; ++type_j)
+            {
+            if (types[type_j])
+                r_ghost_i = std::max(r_ghost_i, m_r_ghost_pair[type_i*ntypes + type_j]);
+            }
+        h_r_ghost_send.data[type_i] = r_ghost_i;
+        }
+    }
+
+void Communicator::findLocalTypes(std::vector<unsigned int>& types)
+    {
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+
+    for (unsigned int idx = 0; idx < m_pdata->getN(); ++idx)
+        types[__scalar_as_int(h_pos.data[idx].w)] = 1;
+    }
+
 //! Build ghost particle list, exchange ghost particle data
 void Communicator::exchangeGhosts()
     {
@@ -1622,23 +1824,30 @@ void Communicator::exchangeGhosts()
      * Mark non-bonded atoms for sending
      */
     updateGhostWidth();
+    updateGhostSendWidth();
 
     // compute the ghost layer widths as fractions
-    ArrayHandle<Scalar> h_r_ghost(m_r_ghost, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_r_ghost(m_r_ghost_send, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_r_ghost_body(m_r_ghost_body, access_location::host, access_mode::read);
     const Scalar3 box_dist = box.getNearestPlaneDistance();
     std::vector<Scalar3> ghost_fractions(m_pdata->getNTypes());
     std::vector<Scalar3> ghost_fractions_body(m_pdata->getNTypes());
+    Scalar r_ghost_send_max(0.0);
     for (unsigned int cur_type = 0; cur_type < m_pdata->getNTypes(); ++cur_type)
         {
         ghost_fractions[cur_type] = h_r_ghost.data[cur_type] / box_dist;
         ghost_fractions_body[cur_type] = h_r_ghost_body.data[cur_type] / box_dist;
+        r_ghost_send_max = std::max(r_ghost_send_max, h_r_ghost.data[cur_type]);
         }
 
+    // in body center ghost mode, a central particle carries the ghost layer of any of its constituents
+    const Scalar3 ghost_fraction_center = r_ghost_send_max / box_dist;
+
         {
         // scan all local atom positions if they are within r_ghost from a neighbor
         ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
         ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
         ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::readwrite);
 
         for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
@@ -1652,6 +1861,15 @@ void Communicator::exchangeGhosts()
 
             if (h_body.data[idx] < MIN_FLOPPY)
                 {
+                if (m_body_center_ghosts)
+                    {
+                    // constituents are rebuilt from their central particle on the receiving side
+                    if (h_body.data[idx] != h_tag.data[idx])
+                        continue;
+
+                    ghost_fraction = ghost_fraction_center;
+                    }
+
                 ghost_fraction += ghost_fractions_body[type];
                 }
 
@@ -2079,6 +2297,20 @@ void Communicator::exchangeGhosts()
             }
         } // end dir loop
 
+    if (m_body_center_ghosts)
+        {
+        // append the constituents of the central particles after the ghosts received in all directions, so
+        // that they are neither updated nor forwarded with the ghost exchange plan
+        unsigned int n_recv_ghosts = m_pdata->getNGhosts();
+        m_ghost_constituents_requests.emit();
+
+        m_plan.resize(m_pdata->getN() + m_pdata->getNGhosts());
+
+        ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::readwrite);
+        for (unsigned int i = n_recv_ghosts; i < m_pdata->getNGhosts(); ++i)
+            h_plan.data[m_pdata->getN() + i] = 0;
+        }
+
     m_ghosts_added = m_pdata->getNGhosts();
 
     // exchange ghost constraints along with ghost particles
@@ -2332,173 +2564,230 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
     {
     // we have a current m_copy_ghosts liss which contain the indices of particles
     // to send to neighboring processors
-    if (m_prof)
-        m_prof->push("comm_ghost_update");
-
     m_exec_conf->msg->notice(7) << "Communicator: update ghosts" << std::endl;
 
-    // update data in these arrays
+    // post the first direction, the others forward ghosts received in it and are updated in finishUpdateGhosts()
+    m_ghost_update_dir = 0;
+    while (m_ghost_update_dir < 6 && ! isCommunicating(m_ghost_update_dir))
+        m_ghost_update_dir++;
 
-    unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
+    m_ghost_update_start = m_pdata->getN();
+    m_comm_pending = true;
 
-    for (unsigned int dir = 0; dir < 6; dir ++)
+    if (m_ghost_update_dir < 6)
         {
-        if (! isCommunicating(dir) ) continue;
+        if (m_prof)
+            m_prof->push("comm_ghost_update");
 
-        CommFlags flags = getFlags();
+        postGhostUpdate(m_ghost_update_dir, m_ghost_update_start);
 
-        if (flags[comm_flag::position])
-            {
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::overwrite);
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+        if (m_prof)
+            m_prof->pop();
+        }
+    }
 
-            // copy positions of ghost particles
-            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
-                {
-                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+void Communicator::finishUpdateGhosts(unsigned int timestep)
+    {
+    if (! m_comm_pending)
+        return;
 
-                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+    m_comm_pending = false;
 
-                // copy position into send buffer
-                h_pos_copybuf.data[ghost_idx] = h_pos.data[idx];
-                }
-            }
+    if (m_ghost_update_dir >= 6)
+        return;
 
-        if (flags[comm_flag::velocity])
-            {
-            ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::overwrite);
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    if (m_prof)
+        m_prof->push("comm_ghost_update");
 
-            // copy velocity of ghost particles
-            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
-                {
-                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+    waitGhostUpdate(m_ghost_update_dir, m_ghost_update_start);
 
-                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+    // the remaining directions relay the ghosts received in the previous ones, update them one at a time
+    unsigned int start_idx = m_ghost_update_start + m_num_recv_ghosts[m_ghost_update_dir];
+    for (unsigned int dir = m_ghost_update_dir + 1; dir < 6; dir++)
+        {
+        if (! isCommunicating(dir) ) continue;
 
-                // copy velocity into send buffer
-                h_velocity_copybuf.data[ghost_idx] = h_vel.data[idx];
-                }
-            }
+        postGhostUpdate(dir, start_idx);
+        waitGhostUpdate(dir, start_idx);
+        start_idx += m_num_recv_ghosts[dir];
+        }
 
-        if (flags[comm_flag::orientation])
-            {
-            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::overwrite);
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    if (m_prof)
+        m_prof->pop();
+    }
 
-            // copy orientation of ghost particles
-            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
-                {
-                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+/*! \param dir Direction to update
+    \param start_idx Index of the first ghost particle received from this direction
+*/
+void Communicator::postGhostUpdate(unsigned int dir, unsigned int start_idx)
+    {
+    CommFlags flags = getFlags();
 
-                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+    // the type and the mass of the ghosts do not change between ghost exchanges, send only x, y, and z of the
+    // positions and velocities
+    if (flags[comm_flag::position])
+        {
+        m_pos_update_copybuf.resize(m_num_copy_ghosts[dir]);
+        m_pos_update_recvbuf.resize(m_num_recv_ghosts[dir]);
 
-                // copy orientation into send buffer
-                h_orientation_copybuf.data[ghost_idx] = h_orientation.data[idx];
-                }
-            }
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_pos_copybuf(m_pos_update_copybuf, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
+        // copy positions of ghost particles
+        for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+            {
+            unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
 
-        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+            assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
 
-        // we receive from the direction opposite to the one we send to
-        unsigned int recv_neighbor;
-        if (dir % 2 == 0)
-            recv_neighbor = m_decomposition->getNeighborRank(dir+1);
-        else
-            recv_neighbor = m_decomposition->getNeighborRank(dir-1);
+            // copy position into send buffer
+            const Scalar4 postype = h_pos.data[idx];
+            h_pos_copybuf.data[ghost_idx] = make_scalar3(postype.x, postype.y, postype.z);
+            }
+        }
 
+    if (flags[comm_flag::velocity])
+        {
+        m_vel_update_copybuf.resize(m_num_copy_ghosts[dir]);
+        m_vel_update_recvbuf.resize(m_num_recv_ghosts[dir]);
 
-        unsigned int start_idx;
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_velocity_copybuf(m_vel_update_copybuf, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
-        if (m_prof)
-            m_prof->push("MPI send/recv");
+        // copy velocity of ghost particles
+        for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+            {
+            unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
 
-        start_idx = m_pdata->getN() + num_tot_recv_ghosts;
+            assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
 
-        num_tot_recv_ghosts += m_num_recv_ghosts[dir];
+            // copy velocity into send buffer
+            const Scalar4 vel = h_vel.data[idx];
+            h_velocity_copybuf.data[ghost_idx] = make_scalar3(vel.x, vel.y, vel.z);
+            }
+        }
 
-        size_t sz = 0;
-        // only non-permanent fields (position, velocity, orientation) need to be considered here
-        // charge, body, image and diameter are not updated between neighbor list builds
-        if (flags[comm_flag::position])
-            {
-            m_reqs.resize(2);
-            m_stats.resize(2);
+    if (flags[comm_flag::orientation])
+        {
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
-            ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::read);
+        // copy orientation of ghost particles
+        for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+            {
+            unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
 
-            // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_pos_copybuf.data, (unsigned int)(m_num_copy_ghosts[dir]*sizeof(Scalar4)), MPI_BYTE, send_neighbor, 1, m_mpi_comm, &m_reqs[0]);
-            MPI_Irecv(h_pos.data + start_idx, (unsigned int)(m_num_recv_ghosts[dir]*sizeof(Scalar4)), MPI_BYTE, recv_neighbor, 1, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
 
-            sz += sizeof(Scalar4);
+            // copy orientation into send buffer
+            h_orientation_copybuf.data[ghost_idx] = h_orientation.data[idx];
             }
+        }
 
-        if (flags[comm_flag::velocity])
-            {
-            m_reqs.resize(2);
-            m_stats.resize(2);
+    unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
 
-            ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
-            ArrayHandle<Scalar4> h_vel_copybuf(m_velocity_copybuf, access_location::host, access_mode::read);
+    // we receive from the direction opposite to the one we send to
+    unsigned int recv_neighbor;
+    if (dir % 2 == 0)
+        recv_neighbor = m_decomposition->getNeighborRank(dir+1);
+    else
+        recv_neighbor = m_decomposition->getNeighborRank(dir-1);
 
-            // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_vel_copybuf.data, (unsigned int)(m_num_copy_ghosts[dir]*sizeof(Scalar4)), MPI_BYTE, send_neighbor, 2, m_mpi_comm, &m_reqs[0]);
-            MPI_Irecv(h_vel.data + start_idx, (unsigned int)(m_num_recv_ghosts[dir]*sizeof(Scalar4)), MPI_BYTE, recv_neighbor, 2, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+    // only non-permanent fields (position, velocity, orientation) need to be considered here
+    // charge, body, image and diameter are not updated between neighbor list builds
+    // the requests stay outstanding until waitGhostUpdate(), the host buffers do not move in the meantime
+    m_reqs.clear();
 
-            sz += sizeof(Scalar4);
-            }
+    if (flags[comm_flag::position])
+        {
+        ArrayHandle<Scalar3> h_pos_recvbuf(m_pos_update_recvbuf, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_pos_copybuf(m_pos_update_copybuf, access_location::host, access_mode::read);
 
-        if (flags[comm_flag::orientation])
-            {
-            m_reqs.resize(2);
-            m_stats.resize(2);
+        // exchange particle data, waitGhostUpdate() copies the received positions into the particle data arrays
+        m_reqs.resize(m_reqs.size()+2);
+        MPI_Isend(h_pos_copybuf.data, (unsigned int)(m_num_copy_ghosts[dir]*sizeof(Scalar3)), MPI_BYTE, send_neighbor, 1, m_mpi_comm, &m_reqs[m_reqs.size()-2]);
+        MPI_Irecv(h_pos_recvbuf.data, (unsigned int)(m_num_recv_ghosts[dir]*sizeof(Scalar3)), MPI_BYTE, recv_neighbor, 1, m_mpi_comm, &m_reqs[m_reqs.size()-1]);
+        }
 
-            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
-            ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::read);
+    if (flags[comm_flag::velocity])
+        {
+        ArrayHandle<Scalar3> h_vel_recvbuf(m_vel_update_recvbuf, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_vel_copybuf(m_vel_update_copybuf, access_location::host, access_mode::read);
 
-            // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_orientation_copybuf.data, (unsigned int)(m_num_copy_ghosts[dir]*sizeof(Scalar4)), MPI_BYTE, send_neighbor, 3, m_mpi_comm, &m_reqs[0]);
-            MPI_Irecv(h_orientation.data + start_idx, (unsigned int)(m_num_recv_ghosts[dir]*sizeof(Scalar4)), MPI_BYTE, recv_neighbor, 3, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+        // exchange particle data, waitGhostUpdate() copies the received velocities into the particle data arrays
+        m_reqs.resize(m_reqs.size()+2);
+        MPI_Isend(h_vel_copybuf.data, (unsigned int)(m_num_copy_ghosts[dir]*sizeof(Scalar3)), MPI_BYTE, send_neighbor, 2, m_mpi_comm, &m_reqs[m_reqs.size()-2]);
+        MPI_Irecv(h_vel_recvbuf.data, (unsigned int)(m_num_recv_ghosts[dir]*sizeof(Scalar3)), MPI_BYTE, recv_neighbor, 2, m_mpi_comm, &m_reqs[m_reqs.size()-1]);
+        }
 
-            sz += sizeof(Scalar4);
-            }
+    if (flags[comm_flag::orientation])
+        {
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::read);
 
-        if (m_prof)
-            m_prof->pop(0, (m_num_recv_ghosts[dir]+m_num_copy_ghosts[dir])*sz);
+        // exchange particle data, write directly to the particle data arrays
+        m_reqs.resize(m_reqs.size()+2);
+        MPI_Isend(h_orientation_copybuf.data, (unsigned int)(m_num_copy_ghosts[dir]*sizeof(Scalar4)), MPI_BYTE, send_neighbor, 3, m_mpi_comm, &m_reqs[m_reqs.size()-2]);
+        MPI_Irecv(h_orientation.data + start_idx, (unsigned int)(m_num_recv_ghosts[dir]*sizeof(Scalar4)), MPI_BYTE, recv_neighbor, 3, m_mpi_comm, &m_reqs[m_reqs.size()-1]);
+        }
+    }
 
+/*! \param dir Direction to complete
+    \param start_idx Index of the first ghost particle received from this direction
+*/
+void Communicator::waitGhostUpdate(unsigned int dir, unsigned int start_idx)
+    {
+    CommFlags flags = getFlags();
 
-        // wrap particle positions (only if copying positions)
-        if (flags[comm_flag::position])
-            {
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    if (m_prof)
+        m_prof->push("MPI send/recv");
 
-            const BoxDim shifted_box = getShiftedBox();
-            for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
-                {
-                Scalar4& pos = h_pos.data[idx];
+    m_stats.resize(m_reqs.size());
+    if (m_reqs.size())
+        MPI_Waitall((int)m_reqs.size(), &m_reqs.front(), &m_stats.front());
 
-                // wrap particles received across a global boundary
-                int3 img = make_int3(0,0,0);
-                shifted_box.wrap(pos, img);
-                }
+    if (m_prof)
+        m_prof->pop(0, (m_num_recv_ghosts[dir]+m_num_copy_ghosts[dir])*sizeof(Scalar4)*(m_reqs.size()/2));
+
+    if (flags[comm_flag::velocity])
+        {
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar3> h_vel_recvbuf(m_vel_update_recvbuf, access_location::host, access_mode::read);
+
+        // copy the received velocities, keep the masses
+        for (unsigned int ghost_idx = 0; ghost_idx < m_num_recv_ghosts[dir]; ghost_idx++)
+            {
+            Scalar4& vel = h_vel.data[start_idx + ghost_idx];
+            const Scalar3 v = h_vel_recvbuf.data[ghost_idx];
+            vel.x = v.x; vel.y = v.y; vel.z = v.z;
             }
+        }
 
-        } // end dir loop
+    // copy and wrap particle positions (only if copying positions)
+    if (flags[comm_flag::position])
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar3> h_pos_recvbuf(m_pos_update_recvbuf, access_location::host, access_mode::read);
 
-        if (m_prof)
-            m_prof->pop();
+        const BoxDim shifted_box = getShiftedBox();
+        for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
+            {
+            // keep the type
+            Scalar4& pos = h_pos.data[idx];
+            const Scalar3 r = h_pos_recvbuf.data[idx - start_idx];
+            pos.x = r.x; pos.y = r.y; pos.z = r.z;
+
+            // wrap particles received across a global boundary
+            int3 img = make_int3(0,0,0);
+            shifted_box.wrap(pos, img);
+            }
+        }
     }
 
 void Communicator::updateNetForce(unsigned int timestep)
@@ -2822,6 +3111,197 @@ void Communicator::updateNetForce(unsigned int timestep)
     }
 
 
+void Communicator::updateGhostField(const GlobalArray<Scalar>& field)
+    {
+    assert(field.getNumElements() >= m_pdata->getN() + m_pdata->getNGhosts());
+
+    if (m_prof)
+        m_prof->push("comm_ghost_field");
+
+    m_exec_conf->msg->notice(7) << "Communicator: update ghost field" << std::endl;
+
+    unsigned int num_tot_recv_ghosts = 0;
+    for (unsigned int dir = 0; dir < 6; dir ++)
+        {
+        if (! isCommunicating(dir) ) continue;
+
+        m_ghost_field_copybuf.resize(m_num_copy_ghosts[dir]);
+
+        ArrayHandle<Scalar> h_field(field, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_ghost_field_copybuf(m_ghost_field_copybuf, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+        // the list includes ghosts received in previous directions, which are forwarded
+        for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+            {
+            unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+            assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+            h_ghost_field_copybuf.data[ghost_idx] = h_field.data[idx];
+            }
+
+        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+
+        // we receive from the direction opposite to the one we send to
+        unsigned int recv_neighbor;
+        if (dir % 2 == 0)
+            recv_neighbor = m_decomposition->getNeighborRank(dir+1);
+        else
+            recv_neighbor = m_decomposition->getNeighborRank(dir-1);
+
+        unsigned int start_idx = m_pdata->getN() + num_tot_recv_ghosts;
+        num_tot_recv_ghosts += m_num_recv_ghosts[dir];
+
+        if (m_prof)
+            m_prof->push("MPI send/recv");
+
+        m_reqs.resize(2);
+        m_stats.resize(2);
+        MPI_Isend(h_ghost_field_copybuf.data, (unsigned int)(m_num_copy_ghosts[dir]*sizeof(Scalar)), MPI_BYTE,
+            send_neighbor, 1, m_mpi_comm, &m_reqs[0]);
+        MPI_Irecv(h_field.data + start_idx, (unsigned int)(m_num_recv_ghosts[dir]*sizeof(Scalar)), MPI_BYTE,
+            recv_neighbor, 1, m_mpi_comm, &m_reqs[1]);
+        MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+
+        if (m_prof)
+            m_prof->pop(0, (m_num_recv_ghosts[dir]+m_num_copy_ghosts[dir])*sizeof(Scalar));
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+void Communicator::reduceGhostBodyForces(const GlobalArray<Scalar4>& force,
+                                         const GlobalArray<Scalar4>& torque,
+                                         const GlobalArray<Scalar>& virial,
+                                         bool reduce_virial)
+    {
+    assert(force.getNumElements() >= m_pdata->getN() + m_pdata->getNGhosts());
+    assert(torque.getNumElements() >= m_pdata->getN() + m_pdata->getNGhosts());
+
+    if (m_prof)
+        m_prof->push("comm_ghost_body_force");
+
+    m_exec_conf->msg->notice(7) << "Communicator: reduce ghost body forces" << std::endl;
+
+    // force (with energy) and torque, and optionally the six virial components
+    const unsigned int n_fields = reduce_virial ? 14 : 8;
+
+    // index of the first ghost received in every direction
+    unsigned int start_idx[6];
+    unsigned int num_tot_recv_ghosts = 0;
+    for (unsigned int dir = 0; dir < 6; dir ++)
+        {
+        start_idx[dir] = m_pdata->getN() + num_tot_recv_ghosts;
+        if (isCommunicating(dir))
+            num_tot_recv_ghosts += m_num_recv_ghosts[dir];
+        }
+
+    ArrayHandle<Scalar4> h_force(force, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_torque(torque, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_virial(virial, access_location::host, access_mode::readwrite);
+    size_t virial_pitch = virial.getPitch();
+
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    std::vector<Scalar> sendbuf;
+    std::vector<Scalar> recvbuf;
+
+    // a ghost received in one direction may have been forwarded by the sender from an earlier direction, so the
+    // directions are processed in reverse to pass the sums back to the owner
+    for (int dir = 5; dir >= 0; dir--)
+        {
+        if (! isCommunicating(dir) ) continue;
+
+        // pack the ghost central particles in the order they were received
+        sendbuf.clear();
+        for (unsigned int idx = start_idx[dir]; idx < start_idx[dir] + m_num_recv_ghosts[dir]; idx++)
+            {
+            if (h_body.data[idx] != h_tag.data[idx]) continue;
+
+            Scalar4 f = h_force.data[idx];
+            Scalar4 t = h_torque.data[idx];
+            sendbuf.push_back(f.x); sendbuf.push_back(f.y); sendbuf.push_back(f.z); sendbuf.push_back(f.w);
+            sendbuf.push_back(t.x); sendbuf.push_back(t.y); sendbuf.push_back(t.z); sendbuf.push_back(t.w);
+            h_force.data[idx] = make_scalar4(0.0, 0.0, 0.0, 0.0);
+            h_torque.data[idx] = make_scalar4(0.0, 0.0, 0.0, 0.0);
+
+            if (reduce_virial)
+                {
+                for (unsigned int i = 0; i < 6; ++i)
+                    {
+                    sendbuf.push_back(h_virial.data[i*virial_pitch+idx]);
+                    h_virial.data[i*virial_pitch+idx] = Scalar(0.0);
+                    }
+                }
+            }
+
+        // the central particles among the ghosts this rank sent in this direction
+        ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
+        unsigned int n_recv_centers = 0;
+        for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+            {
+            unsigned int tag = h_copy_ghosts.data[ghost_idx];
+            if (h_body.data[h_rtag.data[tag]] == tag)
+                n_recv_centers++;
+            }
+        recvbuf.resize(n_recv_centers*n_fields);
+
+        // send back to the rank the ghosts came from, receive from the one they were sent to
+        unsigned int send_neighbor;
+        if (dir % 2 == 0)
+            send_neighbor = m_decomposition->getNeighborRank(dir+1);
+        else
+            send_neighbor = m_decomposition->getNeighborRank(dir-1);
+        unsigned int recv_neighbor = m_decomposition->getNeighborRank(dir);
+
+        if (m_prof)
+            m_prof->push("MPI send/recv");
+
+        m_reqs.resize(2);
+        m_stats.resize(2);
+        MPI_Isend(sendbuf.data(), (unsigned int)(sendbuf.size()*sizeof(Scalar)), MPI_BYTE,
+            send_neighbor, 1, m_mpi_comm, &m_reqs[0]);
+        MPI_Irecv(recvbuf.data(), (unsigned int)(recvbuf.size()*sizeof(Scalar)), MPI_BYTE,
+            recv_neighbor, 1, m_mpi_comm, &m_reqs[1]);
+        MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+
+        if (m_prof)
+            m_prof->pop(0, (sendbuf.size()+recvbuf.size())*sizeof(Scalar));
+
+        // add the sums to the local or ghost copies
+        const Scalar *val = recvbuf.data();
+        for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+            {
+            unsigned int tag = h_copy_ghosts.data[ghost_idx];
+            unsigned int idx = h_rtag.data[tag];
+            if (h_body.data[idx] != tag) continue;
+
+            h_force.data[idx].x += val[0];
+            h_force.data[idx].y += val[1];
+            h_force.data[idx].z += val[2];
+            h_force.data[idx].w += val[3];
+            h_torque.data[idx].x += val[4];
+            h_torque.data[idx].y += val[5];
+            h_torque.data[idx].z += val[6];
+            h_torque.data[idx].w += val[7];
+
+            if (reduce_virial)
+                {
+                for (unsigned int i = 0; i < 6; ++i)
+                    h_virial.data[i*virial_pitch+idx] += val[8+i];
+                }
+
+            val += n_fields;
+            }
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
 void Communicator::removeGhostParticleTags()
     {
     // wipe out reverse-lookup tag -> idx for old ghost atoms
@@ -2927,6 +3407,8 @@ void export_Communicator(py::module& m)
     .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition> >())
     .def_property_readonly("domain_decomposition",
                            &Communicator::getDomainDecomposition)
+    .def("getCommunicationTimes", &Communicator::getCommunicationTimes)
+    .def("resetCommunicationTimes", &Communicator::resetCommunicationTimes)
     ;
     }
 #endif // ENABLE_MPI
@@ -19,6 +19,7 @@
 #include "ParticleData.h"
 #include "BondedGroupData.h"
 #include "DomainDecomposition.h"
+#include "ClockSource.h"
 
 #include <memory>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
@@ -187,6 +188,17 @@ class PYBIND11_EXPORT Communicator
             return m_ghost_layer_width_requests;
             }
 
+        //! Subscribe to list of functions that request a minimum ghost layer width for a pair of types
+        /*! A subscriber returns the width needed for ghosts of the first type to interact with particles of the
+         * second type. The ghost layer of a type is the max over the inputs for the types present in this domain and
+         * its neighbors, so a type is not sent further than the partners that can receive it need.
+         * \return A connection to the present class
+         */
+        Nano::Signal<Scalar (unsigned int, unsigned int)>& getGhostLayerPairWidthRequestSignal()
+            {
+            return m_ghost_layer_pair_width_requests;
+            }
+
         //! Subscribe to list of functions that request a minimum extra ghost layer width (added to the maximum ghost layer)
         /*! This method keeps track of all functions that request a minimum ghost layer width
          * The actual ghost layer width is chosen from the max over the inputs
@@ -198,6 +210,17 @@ class PYBIND11_EXPORT Communicator
             }
 
 
+        //! Subscribe to list of functions that add the constituents of ghost rigid bodies
+        /*! In body center ghost mode (setBodyCenterGhosts()), the subscribers are called at the end of
+         * exchangeGhosts(), after the central particles have been received, and append the missing constituent
+         * particles as ghosts.
+         * \return A Nano::Signal object reference to be used for connect and disconnect calls.
+         */
+        Nano::Signal<void ()>& getGhostConstituentsRequestSignal()
+            {
+            return m_ghost_constituents_requests;
+            }
+
         //! Subscribe to list of functions that determine the communication flags
         /*! This method keeps track of all functions that may request communication flags
          * \return A connection to the present class
@@ -283,8 +306,78 @@ class PYBIND11_EXPORT Communicator
          */
         void communicate(unsigned int timestep);
 
+        /*! Communicate like communicate(), but leave a ghost update in flight
+         * When the particles do not migrate in this time step, the ghost update is started and not completed,
+         * so that the caller can compute the forces that do not depend on ghost particles in the meantime.
+         * The caller must call endCommunicate() when isGhostUpdatePending() returns true.
+         */
+        void beginCommunicate(unsigned int timestep);
+
+        //! Complete the ghost update left in flight by beginCommunicate()
+        void endCommunicate(unsigned int timestep);
+
+        //! Test if a ghost update has been started and not completed yet
+        bool isGhostUpdatePending() const
+            {
+            return m_comm_pending;
+            }
+
+        //! Get the wall clock time spent in each communication phase, in seconds
+        pybind11::dict getCommunicationTimes() const;
+
+        //! Get the total wall clock time spent in all communication phases, in nanoseconds
+        int64_t getCommunicationTime() const
+            {
+            return m_migrate_time + m_exchange_ghosts_time + m_update_ghosts_time;
+            }
+
+        //! Reset the communication phase times
+        void resetCommunicationTimes()
+            {
+            m_migrate_time = 0;
+            m_exchange_ghosts_time = 0;
+            m_update_ghosts_time = 0;
+            }
+
         //@}
 
+        //! Set the body center ghost mode
+        /*! \param enable If true, only the central particles of rigid bodies are sent as non-bonded ghosts, with a
+         *         ghost layer that covers their constituents, and the subscribers of
+         *         getGhostConstituentsRequestSignal() rebuild the constituents locally. Constituent particles are
+         *         still sent as ghosts of bonded groups. Ownership of the particles does not change.
+         */
+        void setBodyCenterGhosts(bool enable)
+            {
+            if (enable != m_body_center_ghosts)
+                {
+                m_body_center_ghosts = enable;
+                forceMigrate();
+                }
+            }
+
+        //! Get the body center ghost mode
+        bool getBodyCenterGhosts() const
+            {
+            return m_body_center_ghosts;
+            }
+
+        /*! Add the forces, torques, and virials on ghost central particles back to their local copies
+         * \param force Force per particle, with at least getN() + getNGhosts() elements
+         * \param torque Torque per particle
+         * \param virial Virial per particle (6 rows)
+         * \param reduce_virial If true, also reduce the virial
+         *
+         * The central particles of rigid bodies collect the forces of the local constituents on every rank where
+         * they are present. This sends the sums on the ghost central particles back along the ghost exchange plan of
+         * the last call to exchangeGhosts(), in the reverse order of the directions, so that forwarded ghosts reach
+         * the owner. The entries of the ghost central particles are zeroed.
+         */
+        virtual void reduceGhostBodyForces(const GlobalArray<Scalar4>& force,
+                                           const GlobalArray<Scalar4>& torque,
+                                           const GlobalArray<Scalar>& virial,
+                                           bool reduce_virial);
+
         //! Force particle migration
         void forceMigrate()
             {
@@ -309,20 +402,29 @@ class PYBIND11_EXPORT Communicator
         virtual void beginUpdateGhosts(unsigned int timestep);
 
         /*! Finish ghost update
+         *
+         * beginUpdateGhosts() only posts the first direction, because the later directions forward ghosts that
+         * were received in the earlier ones. This method completes it and updates the remaining directions.
          *
          * \param timestep The time step
          */
-        virtual void finishUpdateGhosts(unsigned int timestep)
-            {
-            // the base class implementation is currently empty
-            m_comm_pending = false;
-            }
+        virtual void finishUpdateGhosts(unsigned int timestep);
 
         /*! Communicate the net particle force
          * \parm timestep The time step
          */
         virtual void updateNetForce(unsigned int timestep);
 
+        /*! Communicate a per-particle scalar field to the ghost particles
+         * \param field Array with at least getN() + getNGhosts() elements
+         *
+         * The values of the local particles are copied into the entries of their ghost copies on the neighboring
+         * processors, following the ghost exchange plan of the last call to exchangeGhosts(). Computes that need an
+         * intermediate per-particle quantity of their neighbors, such as the embedding derivative of EAM, use this
+         * to avoid a second ghost exchange.
+         */
+        virtual void updateGhostField(const GlobalArray<Scalar>& field);
+
         /*! This methods finds all the particles that are no longer inside the domain
          * boundaries and transfers them to neighboring processors.
          *
@@ -478,6 +580,14 @@ class PYBIND11_EXPORT Communicator
         GlobalArray<unsigned int> m_begin;                //!< Begin index for every neighbor in send buf
         GlobalArray<unsigned int> m_end;                  //!< End index for every neighbor in send buf
 
+        std::vector<unsigned int> m_neigh_send_count;    //!< Send buffer of the neighbor count exchange
+        std::vector<unsigned int> m_neigh_recv_count;    //!< Receive buffer of the neighbor count exchange
+        std::vector<MPI_Request> m_neigh_count_reqs;     //!< Persistent requests of the neighbor count exchange
+
+        //! Send one count to every unique neighbor and receive one count from each
+        unsigned int exchangeNeighborCounts(unsigned int *send_counts, unsigned int *recv_counts,
+                                            const int *stages = NULL, int stage = 0);
+
         GlobalVector<Scalar4> m_pos_copybuf;         //!< Buffer for particle positions to be copied
         GlobalVector<Scalar> m_charge_copybuf;       //!< Buffer for particle charges to be copied
         GlobalVector<Scalar> m_diameter_copybuf;     //!< Buffer for particle diameters to be copied
@@ -491,6 +601,11 @@ class PYBIND11_EXPORT Communicator
         GlobalVector<Scalar4> m_nettorque_copybuf;   //!< Buffer for net torque
         GlobalVector<Scalar> m_netvirial_copybuf;   //!< Buffer for net virial
         GlobalVector<Scalar> m_netvirial_recvbuf;   //!< Buffer for net virial (receive)
+        GlobalVector<Scalar> m_ghost_field_copybuf; //!< Buffer for per-particle scalar fields
+        GlobalVector<Scalar3> m_pos_update_copybuf;  //!< Buffer for ghost position updates, without the type
+        GlobalVector<Scalar3> m_pos_update_recvbuf;  //!< Buffer for ghost position updates (receive)
+        GlobalVector<Scalar3> m_vel_update_copybuf;  //!< Buffer for ghost velocity updates, without the mass
+        GlobalVector<Scalar3> m_vel_update_recvbuf;  //!< Buffer for ghost velocity updates (receive)
 
         GlobalVector<unsigned int> m_copy_ghosts[6]; //!< Per-direction list of indices of particles to send as ghosts
         unsigned int m_num_copy_ghosts[6];       //!< Number of local particles that are sent to neighboring processors
@@ -517,11 +632,15 @@ class PYBIND11_EXPORT Communicator
 
         BoxDim m_global_box;                     //!< Global simulation box
         GlobalArray<Scalar> m_r_ghost;              //!< Width of ghost layer
+        GlobalArray<Scalar> m_r_ghost_send;         //!< Width of ghost layer for the types present in the neighborhood
+        std::vector<Scalar> m_r_ghost_type;         //!< Ghost layer width requested per type
+        std::vector<Scalar> m_r_ghost_pair;         //!< Ghost layer width requested per type pair
         GlobalArray<Scalar> m_r_ghost_body;         //!< Extra ghost width for rigid bodies
         Scalar m_r_ghost_max;                    //!< Maximum ghost layer width
         Scalar m_r_extra_ghost_max;              //!< Maximum extra ghost layer width
 
         unsigned int m_ghosts_added;             //!< Number of ghosts added
+        bool m_body_center_ghosts;               //!< True if only central particles of rigid bodies are sent as ghosts
         bool m_has_ghost_particles;              //!< True if we have a current copy of ghost particles
 
         MPI_Datatype m_mpi_pdata_element;        //!< A datatype for the (non-packed) pdata_element struct
@@ -529,6 +648,14 @@ class PYBIND11_EXPORT Communicator
         //! Update the ghost width array
         void updateGhostWidth();
 
+        //! Update the ghost width array for sending, pruned to the types present in the neighborhood
+        void updateGhostSendWidth();
+
+        //! Mark the types of the local particles
+        /*! \param types Output: nonzero for each type that has a particle in this domain
+         */
+        virtual void findLocalTypes(std::vector<unsigned int>& types);
+
         Nano::Signal<bool(unsigned int timestep)>
             m_migrate_requests; //!< List of functions that may request particle migration
 
@@ -538,12 +665,18 @@ class PYBIND11_EXPORT Communicator
         Nano::Signal<Scalar(unsigned int type) >
             m_ghost_layer_width_requests;  //!< List of functions that request a minimum ghost layer width
 
+        Nano::Signal<Scalar(unsigned int type_i, unsigned int type_j) >
+            m_ghost_layer_pair_width_requests;  //!< List of functions that request a ghost layer width per type pair
+
         Nano::Signal<Scalar(unsigned int type) >
             m_extra_ghost_layer_width_requests;  //!< List of functions that request an extra ghost layer width
 
         Nano::Signal<void (unsigned int timestep)>
             m_compute_callbacks;   //!< List of functions that are called after ghost communication
 
+        Nano::Signal<void ()>
+            m_ghost_constituents_requests;   //!< List of functions that add the constituents of ghost bodies
+
         Nano::Signal<void (const GlobalArray<unsigned int>& )>
             m_comm_callbacks;   //!< List of functions that are called after the compute callbacks
 
@@ -551,6 +684,13 @@ class PYBIND11_EXPORT Communicator
         CommFlags m_last_flags;                       //!< Flags of last ghost exchange
 
         bool m_comm_pending;                     //!< If true, a communication is in process
+        bool m_defer_ghost_update;               //!< If true, communicate() leaves the ghost update in flight
+        unsigned int m_ghost_update_dir;         //!< Direction of the ghost update that is in flight
+        unsigned int m_ghost_update_start;       //!< Index of the first ghost received in m_ghost_update_dir
+        ClockSource m_comm_clk;                  //!< Clock for the communication phase times
+        int64_t m_migrate_time;                  //!< Time spent in migrateParticles() (ns)
+        int64_t m_exchange_ghosts_time;          //!< Time spent in exchangeGhosts() (ns)
+        int64_t m_update_ghosts_time;            //!< Time spent updating ghosts (ns)
         std::vector<MPI_Request> m_reqs; //!< Container for all MPI communication requests
         std::vector<MPI_Status> m_stats; //!< Container for all MPI communication statuses
 
@@ -667,6 +807,9 @@ class PYBIND11_EXPORT Communicator
             GlobalArray<Scalar> r_ghost(m_pdata->getNTypes(), m_exec_conf);
             m_r_ghost.swap(r_ghost);
 
+            GlobalArray<Scalar> r_ghost_send(m_pdata->getNTypes(), m_exec_conf);
+            m_r_ghost_send.swap(r_ghost_send);
+
             GlobalArray<Scalar> r_ghost_body(m_pdata->getNTypes(), m_exec_conf);
             m_r_ghost_body.swap(r_ghost_body);
             }
@@ -674,6 +817,18 @@ class PYBIND11_EXPORT Communicator
         //! Helper function to initialize adjacency arrays
         void initializeNeighborArrays();
 
+        //! Set up the persistent requests of the neighbor count exchange
+        void initializeNeighborCountRequests();
+
+        //! Free the persistent requests of the neighbor count exchange
+        void freeNeighborCountRequests();
+
+        //! Pack the ghost update of one direction and post its non-blocking sends and receives
+        void postGhostUpdate(unsigned int dir, unsigned int start_idx);
+
+        //! Wait for the ghost update of one direction and wrap the received positions
+        void waitGhostUpdate(unsigned int dir, unsigned int start_idx);
+
         //! Method that is called when ghost particles are requested to be removed
         void slotGhostParticlesRemoved()
             {
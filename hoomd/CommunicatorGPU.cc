@@ -17,6 +17,42 @@
 
 namespace py = pybind11;
 #include <algorithm>
+#include <memory>
+
+//! Access a buffer passed to MPI on the device or on the host
+/*! With device-direct MPI, the buffer is accessed on the device and its device pointer is handed to the MPI library.
+    Otherwise, the buffer is staged on the host. The host access is asynchronous, the caller must synchronize before
+    the first MPI call.
+*/
+template<class T>
+class MPIBufferHandle
+    {
+    public:
+        //! Constructor
+        /*! \param array Array to access
+            \param device_direct True to access the device copy
+            \param mode Access mode
+        */
+        MPIBufferHandle(const GlobalArray<T>& array, bool device_direct, access_mode::Enum mode)
+            {
+            if (device_direct)
+                {
+                m_device_handle.reset(new ArrayHandle<T>(array, access_location::device, mode));
+                data = m_device_handle->data;
+                }
+            else
+                {
+                m_host_handle.reset(new ArrayHandleAsync<T>(array, access_location::host, mode));
+                data = m_host_handle->data;
+                }
+            }
+
+        T* data;    //!< Pointer to pass to MPI
+
+    private:
+        std::unique_ptr< ArrayHandle<T> > m_device_handle;      //!< Handle to the device copy
+        std::unique_ptr< ArrayHandleAsync<T> > m_host_handle;   //!< Handle to the host copy
+    };
 
 //! Constructor
 CommunicatorGPU::CommunicatorGPU(std::shared_ptr<SystemDefinition> sysdef,
@@ -53,6 +89,7 @@ CommunicatorGPU::CommunicatorGPU(std::shared_ptr<SystemDefinition> sysdef,
 CommunicatorGPU::~CommunicatorGPU()
     {
     m_exec_conf->msg->notice(5) << "Destroying CommunicatorGPU";
+    printBufferStatistics();
     hipEventDestroy(m_event);
     }
 
@@ -82,6 +119,9 @@ void CommunicatorGPU::allocateBuffers()
     GlobalVector<unsigned int> tag_ghost_sendbuf(m_exec_conf);
     m_tag_ghost_sendbuf.swap(tag_ghost_sendbuf);
 
+    GlobalVector<unsigned int> local_types(m_exec_conf);
+    m_local_types.swap(local_types);
+
     GlobalVector<unsigned int> tag_ghost_recvbuf(m_exec_conf);
     m_tag_ghost_recvbuf.swap(tag_ghost_recvbuf);
 
@@ -145,6 +185,12 @@ void CommunicatorGPU::allocateBuffers()
     GlobalVector<Scalar> netvirial_ghost_recvbuf(m_exec_conf);
     m_netvirial_ghost_recvbuf.swap(netvirial_ghost_recvbuf);
 
+    GlobalVector<Scalar> field_ghost_sendbuf(m_exec_conf);
+    m_field_ghost_sendbuf.swap(field_ghost_sendbuf);
+
+    GlobalVector<Scalar> field_ghost_recvbuf(m_exec_conf);
+    m_field_ghost_recvbuf.swap(field_ghost_recvbuf);
+
     GlobalVector<unsigned int> ghost_begin(m_exec_conf);
     m_ghost_begin.swap(ghost_begin);
 
@@ -165,6 +211,30 @@ void CommunicatorGPU::allocateBuffers()
 
     GlobalVector<unsigned int> scan(m_exec_conf);
     m_scan.swap(scan);
+
+    // the migration buffers follow the number of particles that cross domain boundaries, which jumps after load
+    // balancing and particle insertion: grow them in larger steps and return the memory once the peak has passed
+    const double migrate_growth_factor = 1.5;
+    const unsigned int migrate_shrink_period = 1000;
+    m_gpu_sendbuf.setGrowthFactor(migrate_growth_factor);
+    m_gpu_sendbuf.setShrinkPeriod(migrate_shrink_period);
+    m_gpu_recvbuf.setGrowthFactor(migrate_growth_factor);
+    m_gpu_recvbuf.setShrinkPeriod(migrate_shrink_period);
+    m_comm_flags.setGrowthFactor(migrate_growth_factor);
+    m_comm_flags.setShrinkPeriod(migrate_shrink_period);
+    m_send_keys.setGrowthFactor(migrate_growth_factor);
+    m_send_keys.setShrinkPeriod(migrate_shrink_period);
+    }
+
+//! Print the high water marks and reallocation counts of the particle migration buffers
+void CommunicatorGPU::printBufferStatistics()
+    {
+    m_exec_conf->msg->notice(3) << "CommunicatorGPU: migration send buffer high water mark "
+        << m_gpu_sendbuf.getHighWaterMark() << " particles, " << m_gpu_sendbuf.getNumReallocations()
+        << " reallocations" << std::endl;
+    m_exec_conf->msg->notice(3) << "CommunicatorGPU: migration receive buffer high water mark "
+        << m_gpu_recvbuf.getHighWaterMark() << " particles, " << m_gpu_recvbuf.getNumReallocations()
+        << " reallocations" << std::endl;
     }
 
 void CommunicatorGPU::initializeCommunicationStages()
@@ -571,7 +641,6 @@ void CommunicatorGPU::GroupCommunicatorGPU<group_data>::migrateGroups(bool incom
             {
             ArrayHandle<unsigned int> h_begin(m_gpu_comm.m_begin, access_location::host, access_mode::read);
             ArrayHandle<unsigned int> h_end(m_gpu_comm.m_end, access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_gpu_comm.m_unique_neighbors, access_location::host, access_mode::read);
 
             unsigned int send_bytes = 0;
             unsigned int recv_bytes = 0;
@@ -581,24 +650,10 @@ void CommunicatorGPU::GroupCommunicatorGPU<group_data>::migrateGroups(bool incom
             for (unsigned int ineigh = 0; ineigh < m_gpu_comm.m_n_unique_neigh; ineigh++)
                 n_send_groups[ineigh] = h_end.data[ineigh] - h_begin.data[ineigh];
 
-            MPI_Request req[2*m_gpu_comm.m_n_unique_neigh];
-            MPI_Status stat[2*m_gpu_comm.m_n_unique_neigh];
-
-            unsigned int nreq = 0;
-
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_gpu_comm.m_n_unique_neigh; ineigh++)
-                {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                MPI_Isend(&n_send_groups[ineigh], 1, MPI_UNSIGNED, neighbor, 0, m_gpu_comm.m_mpi_comm, & req[nreq++]);
-                MPI_Irecv(&n_recv_groups[ineigh], 1, MPI_UNSIGNED, neighbor, 0, m_gpu_comm.m_mpi_comm, & req[nreq++]);
-                send_bytes += (unsigned int)sizeof(unsigned int);
-                recv_bytes += (unsigned int)sizeof(unsigned int);
-                } // end neighbor loop
-
-            MPI_Waitall(nreq, req, stat);
+            // exchange the counts over the persistent neighbor requests
+            unsigned int n_active = m_gpu_comm.exchangeNeighborCounts(n_send_groups, n_recv_groups);
+            send_bytes += (unsigned int)(n_active*sizeof(unsigned int));
+            recv_bytes += (unsigned int)(n_active*sizeof(unsigned int));
 
             // sum up receive counts
             for (unsigned int ineigh = 0; ineigh < m_gpu_comm.m_n_unique_neigh; ineigh++)
@@ -624,16 +679,13 @@ void CommunicatorGPU::GroupCommunicatorGPU<group_data>::migrateGroups(bool incom
 
             if (m_gpu_comm.m_prof) m_gpu_comm.m_prof->push(m_exec_conf,"MPI send/recv");
 
-            #ifdef ENABLE_MPI_CUDA
-            ArrayHandle<rank_element_t> ranks_sendbuf_handle(m_ranks_sendbuf, access_location::device, access_mode::read);
-            ArrayHandle<rank_element_t> ranks_recvbuf_handle(m_ranks_recvbuf, access_location::device, access_mode::overwrite);
+            bool device_direct = m_exec_conf->isMPIDeviceDirect();
+            MPIBufferHandle<rank_element_t> ranks_sendbuf_handle(m_ranks_sendbuf, device_direct, access_mode::read);
+            MPIBufferHandle<rank_element_t> ranks_recvbuf_handle(m_ranks_recvbuf, device_direct,
+                access_mode::overwrite);
 
-            // MPI library may use non-zero stream
+            // complete outstanding copies, the MPI library may also use a non-zero stream
             hipDeviceSynchronize();
-            #else
-            ArrayHandle<rank_element_t> ranks_sendbuf_handle(m_ranks_sendbuf, access_location::host, access_mode::read);
-            ArrayHandle<rank_element_t> ranks_recvbuf_handle(m_ranks_recvbuf, access_location::host, access_mode::overwrite);
-            #endif
 
             std::vector<MPI_Request> reqs;
             MPI_Request req;
@@ -850,7 +902,6 @@ void CommunicatorGPU::GroupCommunicatorGPU<group_data>::migrateGroups(bool incom
             {
             ArrayHandle<unsigned int> h_begin(m_gpu_comm.m_begin, access_location::host, access_mode::read);
             ArrayHandle<unsigned int> h_end(m_gpu_comm.m_end, access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_gpu_comm.m_unique_neighbors, access_location::host, access_mode::read);
 
             unsigned int send_bytes = 0;
             unsigned int recv_bytes = 0;
@@ -860,24 +911,10 @@ void CommunicatorGPU::GroupCommunicatorGPU<group_data>::migrateGroups(bool incom
             for (unsigned int ineigh = 0; ineigh < m_gpu_comm.m_n_unique_neigh; ineigh++)
                 n_send_groups[ineigh] = h_end.data[ineigh] - h_begin.data[ineigh];
 
-            MPI_Request req[2*m_gpu_comm.m_n_unique_neigh];
-            MPI_Status stat[2*m_gpu_comm.m_n_unique_neigh];
-
-            unsigned int nreq = 0;
-
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_gpu_comm.m_n_unique_neigh; ineigh++)
-                {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                MPI_Isend(&n_send_groups[ineigh], 1, MPI_UNSIGNED, neighbor, 0, m_gpu_comm.m_mpi_comm, & req[nreq++]);
-                MPI_Irecv(&n_recv_groups[ineigh], 1, MPI_UNSIGNED, neighbor, 0, m_gpu_comm.m_mpi_comm, & req[nreq++]);
-                send_bytes += (unsigned int)sizeof(unsigned int);
-                recv_bytes += (unsigned int)sizeof(unsigned int);
-                } // end neighbor loop
-
-            MPI_Waitall(nreq, req, stat);
+            // exchange the counts over the persistent neighbor requests
+            unsigned int n_active = m_gpu_comm.exchangeNeighborCounts(n_send_groups, n_recv_groups);
+            send_bytes += (unsigned int)(n_active*sizeof(unsigned int));
+            recv_bytes += (unsigned int)(n_active*sizeof(unsigned int));
 
             // sum up receive counts
             for (unsigned int ineigh = 0; ineigh < m_gpu_comm.m_n_unique_neigh; ineigh++)
@@ -1200,7 +1237,6 @@ void CommunicatorGPU::GroupCommunicatorGPU<group_data>::exchangeGhostGroups(
                 {
                 ArrayHandle<unsigned int> h_ghost_group_begin(m_ghost_group_begin, access_location::host, access_mode::read);
                 ArrayHandle<unsigned int> h_ghost_group_end(m_ghost_group_end, access_location::host, access_mode::read);
-                ArrayHandle<unsigned int> h_unique_neighbors(m_gpu_comm.m_unique_neighbors, access_location::host, access_mode::read);
 
                 if (m_gpu_comm.m_prof) m_gpu_comm.m_prof->push(m_exec_conf, "MPI send/recv");
 
@@ -1209,33 +1245,11 @@ void CommunicatorGPU::GroupCommunicatorGPU<group_data>::exchangeGhostGroups(
                     n_send_ghost_groups[stage][ineigh] = h_ghost_group_end.data[ineigh+stage*m_gpu_comm.m_n_unique_neigh]
                         - h_ghost_group_begin.data[ineigh+stage*m_gpu_comm.m_n_unique_neigh];
 
-                MPI_Request req[2*m_gpu_comm.m_n_unique_neigh];
-                MPI_Status stat[2*m_gpu_comm.m_n_unique_neigh];
-
-                unsigned int nreq = 0;
-
-                // loop over neighbors
-                for (unsigned int ineigh = 0; ineigh < m_gpu_comm.m_n_unique_neigh; ineigh++)
-                    {
-                    if (m_gpu_comm.m_stages[ineigh] != (int) stage)
-                        {
-                        // skip neighbor if not participating in this communication stage
-                        n_send_ghost_groups[stage][ineigh] = 0;
-                        n_recv_ghost_groups[stage][ineigh] = 0;
-                        continue;
-                        }
-
-                    // rank of neighbor processor
-                    unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                    MPI_Isend(&n_send_ghost_groups[stage][ineigh], 1, MPI_UNSIGNED, neighbor, 0, m_gpu_comm.m_mpi_comm, & req[nreq++]);
-                    MPI_Irecv(&n_recv_ghost_groups[stage][ineigh], 1, MPI_UNSIGNED, neighbor, 0, m_gpu_comm.m_mpi_comm, & req[nreq++]);
-
-                    send_bytes += (unsigned int)sizeof(unsigned int);
-                    recv_bytes += (unsigned int)sizeof(unsigned int);
-                    }
-
-                MPI_Waitall(nreq, req, stat);
+                // exchange the counts over the persistent neighbor requests
+                unsigned int n_active = m_gpu_comm.exchangeNeighborCounts(n_send_ghost_groups[stage].data(),
+                    n_recv_ghost_groups[stage].data(), m_gpu_comm.m_stages.data(), (int) stage);
+                send_bytes += (unsigned int)(n_active*sizeof(unsigned int));
+                recv_bytes += (unsigned int)(n_active*sizeof(unsigned int));
 
                 // total up receive counts
                 for (unsigned int ineigh = 0; ineigh < m_gpu_comm.m_n_unique_neigh; ineigh++)
@@ -1572,7 +1586,6 @@ void CommunicatorGPU::migrateParticles()
             {
             ArrayHandle<unsigned int> h_begin(m_begin, access_location::host, access_mode::read);
             ArrayHandle<unsigned int> h_end(m_end, access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors, access_location::host, access_mode::read);
 
             unsigned int send_bytes = 0;
             unsigned int recv_bytes = 0;
@@ -1582,32 +1595,10 @@ void CommunicatorGPU::migrateParticles()
             for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
                 n_send_ptls[ineigh] = h_end.data[ineigh] - h_begin.data[ineigh];
 
-            MPI_Request req[2*m_n_unique_neigh];
-            MPI_Status stat[2*m_n_unique_neigh];
-
-            unsigned int nreq = 0;
-
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
-                {
-                if (m_stages[ineigh] != (int) stage)
-                    {
-                    // skip neighbor if not participating in this communication stage
-                    n_send_ptls[ineigh] = 0;
-                    n_recv_ptls[ineigh] = 0;
-                    continue;
-                    }
-
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                MPI_Isend(&n_send_ptls[ineigh], 1, MPI_UNSIGNED, neighbor, 0, m_mpi_comm, & req[nreq++]);
-                MPI_Irecv(&n_recv_ptls[ineigh], 1, MPI_UNSIGNED, neighbor, 0, m_mpi_comm, & req[nreq++]);
-                send_bytes += (unsigned int)sizeof(unsigned int);
-                recv_bytes += (unsigned int)sizeof(unsigned int);
-                } // end neighbor loop
-
-            MPI_Waitall(nreq, req, stat);
+            // exchange the counts over the persistent neighbor requests
+            unsigned int n_active = exchangeNeighborCounts(n_send_ptls, n_recv_ptls, m_stages.data(), (int) stage);
+            send_bytes += (unsigned int)(n_active*sizeof(unsigned int));
+            recv_bytes += (unsigned int)(n_active*sizeof(unsigned int));
 
             // sum up receive counts
             for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
@@ -1633,13 +1624,10 @@ void CommunicatorGPU::migrateParticles()
 
             if (m_prof) m_prof->push(m_exec_conf,"MPI send/recv");
 
-            #if defined(ENABLE_MPI_CUDA) && 0
-            ArrayHandle<pdata_element> gpu_sendbuf_handle(m_gpu_sendbuf, access_location::device, access_mode::read);
-            ArrayHandle<pdata_element> gpu_recvbuf_handle(m_gpu_recvbuf, access_location::device, access_mode::overwrite);
-            #else
+            // the send buffer is reordered by neighbor on the host, only the receive buffer can be device-direct
+            bool device_direct = m_exec_conf->isMPIDeviceDirect();
             ArrayHandle<pdata_element> gpu_sendbuf_handle(m_gpu_sendbuf, access_location::host, access_mode::read);
-            ArrayHandle<pdata_element> gpu_recvbuf_handle(m_gpu_recvbuf, access_location::host, access_mode::overwrite);
-            #endif
+            MPIBufferHandle<pdata_element> gpu_recvbuf_handle(m_gpu_recvbuf, device_direct, access_mode::overwrite);
 
             std::vector<MPI_Request> reqs;
             MPI_Request req;
@@ -1684,6 +1672,10 @@ void CommunicatorGPU::migrateParticles()
             std::vector<MPI_Status> stats(reqs.size());
             MPI_Waitall((unsigned int)(reqs.size()), &reqs.front(), &stats.front());
 
+            // MPI library may use non-zero stream
+            if (device_direct)
+                hipDeviceSynchronize();
+
             if (m_prof) m_prof->pop(m_exec_conf,0,send_bytes+recv_bytes);
             }
 
@@ -1728,6 +1720,27 @@ void CommunicatorGPU::removeGhostParticleTags()
     m_ghosts_added = 0;
     }
 
+void CommunicatorGPU::findLocalTypes(std::vector<unsigned int>& types)
+    {
+    m_local_types.resize(m_pdata->getNTypes());
+
+        {
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_local_types(m_local_types, access_location::device, access_mode::overwrite);
+
+        gpu_find_local_types(m_pdata->getN(),
+                             d_pos.data,
+                             d_local_types.data,
+                             m_pdata->getNTypes());
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+    ArrayHandle<unsigned int> h_local_types(m_local_types, access_location::host, access_mode::read);
+    std::copy(h_local_types.data, h_local_types.data + m_pdata->getNTypes(), types.begin());
+    }
+
 //! Build a ghost particle list, exchange ghost particle data with neighboring processors
 void CommunicatorGPU::exchangeGhosts()
     {
@@ -1746,6 +1759,7 @@ void CommunicatorGPU::exchangeGhosts()
 
     // update the subscribed ghost layer width
     updateGhostWidth();
+    updateGhostSendWidth();
 
     // resize arrays
     m_n_send_ghosts.resize(m_num_stages);
@@ -1783,7 +1797,7 @@ void CommunicatorGPU::exchangeGhosts()
             ArrayHandle<unsigned int> d_body(m_pdata->getBodies(), access_location::device, access_mode::read);
             ArrayHandle<unsigned int> d_ghost_plan(m_ghost_plan, access_location::device, access_mode::overwrite);
 
-            ArrayHandle<Scalar> d_r_ghost(m_r_ghost, access_location::device, access_mode::read);
+            ArrayHandle<Scalar> d_r_ghost(m_r_ghost_send, access_location::device, access_mode::read);
             ArrayHandle<Scalar> d_r_ghost_body(m_r_ghost_body, access_location::device, access_mode::read);
 
             gpu_make_ghost_exchange_plan(d_ghost_plan.data,
@@ -1978,7 +1992,6 @@ void CommunicatorGPU::exchangeGhosts()
             {
             ArrayHandle<unsigned int> h_ghost_begin(m_ghost_begin, access_location::host, access_mode::read);
             ArrayHandle<unsigned int> h_ghost_end(m_ghost_end, access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors, access_location::host, access_mode::read);
 
             if (m_prof) m_prof->push(m_exec_conf, "MPI send/recv");
 
@@ -1987,33 +2000,11 @@ void CommunicatorGPU::exchangeGhosts()
                 m_n_send_ghosts[stage][ineigh] = h_ghost_end.data[ineigh+stage*m_n_unique_neigh]
                     - h_ghost_begin.data[ineigh+stage*m_n_unique_neigh];
 
-            MPI_Request req[2*m_n_unique_neigh];
-            MPI_Status stat[2*m_n_unique_neigh];
-
-            unsigned int nreq = 0;
-
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
-                {
-                if (m_stages[ineigh] != (int) stage)
-                    {
-                    // skip neighbor if not participating in this communication stage
-                    m_n_send_ghosts[stage][ineigh] = 0;
-                    m_n_recv_ghosts[stage][ineigh] = 0;
-                    continue;
-                    }
-
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                MPI_Isend(&m_n_send_ghosts[stage][ineigh], 1, MPI_UNSIGNED, neighbor, 0, m_mpi_comm, & req[nreq++]);
-                MPI_Irecv(&m_n_recv_ghosts[stage][ineigh], 1, MPI_UNSIGNED, neighbor, 0, m_mpi_comm, & req[nreq++]);
-
-                send_bytes += (unsigned int)sizeof(unsigned int);
-                recv_bytes += (unsigned int)sizeof(unsigned int);
-                }
-
-            MPI_Waitall(nreq, req, stat);
+            // exchange the counts over the persistent neighbor requests
+            unsigned int n_active = exchangeNeighborCounts(m_n_send_ghosts[stage].data(),
+                m_n_recv_ghosts[stage].data(), m_stages.data(), (int) stage);
+            send_bytes += (unsigned int)(n_active*sizeof(unsigned int));
+            recv_bytes += (unsigned int)(n_active*sizeof(unsigned int));
 
             // total up receive counts
             for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
@@ -2050,54 +2041,43 @@ void CommunicatorGPU::exchangeGhosts()
         m_pdata->addGhostParticles(m_n_recv_ghosts_tot[stage]);
 
             {
-            unsigned int offs = 0;
-            #ifdef ENABLE_MPI_CUDA
-            // recv buffers, write directly into particle data arrays
-            offs = first_idx;
-            ArrayHandle<unsigned int> tag_ghost_recvbuf_handle(m_pdata->getTags(), access_location::device, access_mode::readwrite);
-            ArrayHandle<Scalar4> pos_ghost_recvbuf_handle(m_pdata->getPositions(), access_location::device, access_mode::readwrite);
-            ArrayHandle<Scalar4> vel_ghost_recvbuf_handle(m_pdata->getVelocities(), access_location::device, access_mode::readwrite);
-            ArrayHandle<Scalar> charge_ghost_recvbuf_handle(m_pdata->getCharges(), access_location::device, access_mode::readwrite);
-            ArrayHandle<Scalar> diameter_ghost_recvbuf_handle(m_pdata->getDiameters(), access_location::device, access_mode::readwrite);
-            ArrayHandle<unsigned int> body_ghost_recvbuf_handle(m_pdata->getBodies(), access_location::device, access_mode::readwrite);
-            ArrayHandle<int3> image_ghost_recvbuf_handle(m_pdata->getImages(), access_location::device, access_mode::readwrite);
-            ArrayHandle<Scalar4> orientation_ghost_recvbuf_handle(m_pdata->getOrientationArray(), access_location::device, access_mode::readwrite);
-
-            // send buffers
-            ArrayHandle<unsigned int> tag_ghost_sendbuf_handle(m_tag_ghost_sendbuf, access_location::device, access_mode::read);
-            ArrayHandle<Scalar4> pos_ghost_sendbuf_handle(m_pos_ghost_sendbuf, access_location::device, access_mode::read);
-            ArrayHandle<Scalar4> vel_ghost_sendbuf_handle(m_vel_ghost_sendbuf, access_location::device, access_mode::read);
-            ArrayHandle<Scalar> charge_ghost_sendbuf_handle(m_charge_ghost_sendbuf, access_location::device, access_mode::read);
-            ArrayHandle<unsigned int> body_ghost_sendbuf_handle(m_body_ghost_sendbuf, access_location::device, access_mode::read);
-            ArrayHandle<int3> image_ghost_sendbuf_handle(m_image_ghost_sendbuf, access_location::device, access_mode::read);
-            ArrayHandle<Scalar> diameter_ghost_sendbuf_handle(m_diameter_ghost_sendbuf, access_location::device, access_mode::read);
-            ArrayHandle<Scalar4> orientation_ghost_sendbuf_handle(m_orientation_ghost_sendbuf, access_location::device, access_mode::read);
+            // with device direct MPI, receive directly into the particle data arrays on the device
+            bool device_direct = m_exec_conf->isMPIDeviceDirect();
+            unsigned int offs = device_direct ? first_idx : 0;
+            access_mode::Enum recv_mode = device_direct ? access_mode::readwrite : access_mode::overwrite;
 
-            // MPI library may use non-zero stream
-            hipDeviceSynchronize();
-            #else
             // recv buffers
-            ArrayHandleAsync<unsigned int> tag_ghost_recvbuf_handle(m_tag_ghost_recvbuf, access_location::host, access_mode::overwrite);
-            ArrayHandleAsync<Scalar4> pos_ghost_recvbuf_handle(m_pos_ghost_recvbuf, access_location::host, access_mode::overwrite);
-            ArrayHandleAsync<Scalar4> vel_ghost_recvbuf_handle(m_vel_ghost_recvbuf, access_location::host, access_mode::overwrite);
-            ArrayHandleAsync<Scalar> charge_ghost_recvbuf_handle(m_charge_ghost_recvbuf, access_location::host, access_mode::overwrite);
-            ArrayHandleAsync<unsigned int> body_ghost_recvbuf_handle(m_body_ghost_recvbuf, access_location::host, access_mode::overwrite);
-            ArrayHandleAsync<int3> image_ghost_recvbuf_handle(m_image_ghost_recvbuf, access_location::host, access_mode::overwrite);
-            ArrayHandleAsync<Scalar> diameter_ghost_recvbuf_handle(m_diameter_ghost_recvbuf, access_location::host, access_mode::overwrite);
-            ArrayHandleAsync<Scalar4> orientation_ghost_recvbuf_handle(m_orientation_ghost_recvbuf, access_location::host, access_mode::overwrite);
+            MPIBufferHandle<unsigned int> tag_ghost_recvbuf_handle(
+                device_direct ? m_pdata->getTags() : m_tag_ghost_recvbuf, device_direct, recv_mode);
+            MPIBufferHandle<Scalar4> pos_ghost_recvbuf_handle(
+                device_direct ? m_pdata->getPositions() : m_pos_ghost_recvbuf, device_direct, recv_mode);
+            MPIBufferHandle<Scalar4> vel_ghost_recvbuf_handle(
+                device_direct ? m_pdata->getVelocities() : m_vel_ghost_recvbuf, device_direct, recv_mode);
+            MPIBufferHandle<Scalar> charge_ghost_recvbuf_handle(
+                device_direct ? m_pdata->getCharges() : m_charge_ghost_recvbuf, device_direct, recv_mode);
+            MPIBufferHandle<unsigned int> body_ghost_recvbuf_handle(
+                device_direct ? m_pdata->getBodies() : m_body_ghost_recvbuf, device_direct, recv_mode);
+            MPIBufferHandle<int3> image_ghost_recvbuf_handle(
+                device_direct ? m_pdata->getImages() : m_image_ghost_recvbuf, device_direct, recv_mode);
+            MPIBufferHandle<Scalar> diameter_ghost_recvbuf_handle(
+                device_direct ? m_pdata->getDiameters() : m_diameter_ghost_recvbuf, device_direct, recv_mode);
+            MPIBufferHandle<Scalar4> orientation_ghost_recvbuf_handle(
+                device_direct ? m_pdata->getOrientationArray() : m_orientation_ghost_recvbuf, device_direct, recv_mode);
+
             // send buffers
-            ArrayHandleAsync<unsigned int> tag_ghost_sendbuf_handle(m_tag_ghost_sendbuf, access_location::host, access_mode::read);
-            ArrayHandleAsync<Scalar4> pos_ghost_sendbuf_handle(m_pos_ghost_sendbuf, access_location::host, access_mode::read);
-            ArrayHandleAsync<Scalar4> vel_ghost_sendbuf_handle(m_vel_ghost_sendbuf, access_location::host, access_mode::read);
-            ArrayHandleAsync<Scalar> charge_ghost_sendbuf_handle(m_charge_ghost_sendbuf, access_location::host, access_mode::read);
-            ArrayHandleAsync<unsigned int> body_ghost_sendbuf_handle(m_body_ghost_sendbuf, access_location::host, access_mode::read);
-            ArrayHandleAsync<int3> image_ghost_sendbuf_handle(m_image_ghost_sendbuf, access_location::host, access_mode::read);
-            ArrayHandleAsync<Scalar> diameter_ghost_sendbuf_handle(m_diameter_ghost_sendbuf, access_location::host, access_mode::read);
-            ArrayHandleAsync<Scalar4> orientation_ghost_sendbuf_handle(m_orientation_ghost_sendbuf, access_location::host, access_mode::read);
-
-            // lump together into one synchronization call
+            MPIBufferHandle<unsigned int> tag_ghost_sendbuf_handle(m_tag_ghost_sendbuf, device_direct, access_mode::read);
+            MPIBufferHandle<Scalar4> pos_ghost_sendbuf_handle(m_pos_ghost_sendbuf, device_direct, access_mode::read);
+            MPIBufferHandle<Scalar4> vel_ghost_sendbuf_handle(m_vel_ghost_sendbuf, device_direct, access_mode::read);
+            MPIBufferHandle<Scalar> charge_ghost_sendbuf_handle(m_charge_ghost_sendbuf, device_direct, access_mode::read);
+            MPIBufferHandle<unsigned int> body_ghost_sendbuf_handle(m_body_ghost_sendbuf, device_direct, access_mode::read);
+            MPIBufferHandle<int3> image_ghost_sendbuf_handle(m_image_ghost_sendbuf, device_direct, access_mode::read);
+            MPIBufferHandle<Scalar> diameter_ghost_sendbuf_handle(m_diameter_ghost_sendbuf, device_direct,
+                                                                  access_mode::read);
+            MPIBufferHandle<Scalar4> orientation_ghost_sendbuf_handle(m_orientation_ghost_sendbuf, device_direct,
+                                                                      access_mode::read);
+
+            // lump together into one synchronization call, the MPI library may also use a non-zero stream
             hipDeviceSynchronize();
-            #endif
 
             ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors, access_location::host, access_mode::read);
             ArrayHandle<unsigned int> h_ghost_begin(m_ghost_begin, access_location::host, access_mode::read);
@@ -2347,12 +2327,14 @@ void CommunicatorGPU::exchangeGhosts()
             if (m_prof) m_prof->pop(m_exec_conf,0,send_bytes+recv_bytes);
             } // end ArrayHandle scope
 
-        #ifdef ENABLE_MPI_CUDA
-        // MPI library may use non-zero stream
-        hipDeviceSynchronize();
-        #else
-        // only unpack in non-CUDA MPI builds
+        if (m_exec_conf->isMPIDeviceDirect())
             {
+            // MPI library may use non-zero stream
+            hipDeviceSynchronize();
+            }
+        else
+            {
+            // only unpack when the data was received on the host
             // access receive buffers
             ArrayHandle<unsigned int> d_tag_ghost_recvbuf(m_tag_ghost_recvbuf, access_location::device, access_mode::read);
             ArrayHandle<Scalar4> d_pos_ghost_recvbuf(m_pos_ghost_recvbuf, access_location::device, access_mode::read);
@@ -2402,7 +2384,6 @@ void CommunicatorGPU::exchangeGhosts()
 
             if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
             }
-        #endif
 
         if (flags[comm_flag::tag])
             {
@@ -2493,6 +2474,31 @@ void CommunicatorGPU::beginUpdateGhosts(unsigned int timestep)
                 global_box);
 
             if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+
+            // the type and the mass do not change between ghost exchanges, stage only x, y, and z of the positions and
+            // velocities
+            if (!m_exec_conf->isMPIDeviceDirect())
+                {
+                if (flags[comm_flag::position])
+                    {
+                    m_pos_update_copybuf.resize(m_n_send_ghosts_tot[stage]);
+                    ArrayHandle<Scalar3> d_pos_update_sendbuf(m_pos_update_copybuf, access_location::device,
+                        access_mode::overwrite);
+                    gpu_compact_ghost_update(m_n_send_ghosts_tot[stage], d_pos_ghost_sendbuf.data,
+                        d_pos_update_sendbuf.data);
+                    }
+
+                if (flags[comm_flag::velocity])
+                    {
+                    m_vel_update_copybuf.resize(m_n_send_ghosts_tot[stage]);
+                    ArrayHandle<Scalar3> d_vel_update_sendbuf(m_vel_update_copybuf, access_location::device,
+                        access_mode::overwrite);
+                    gpu_compact_ghost_update(m_n_send_ghosts_tot[stage], d_vel_ghost_sendbuf.data,
+                        d_vel_update_sendbuf.data);
+                    }
+
+                if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+                }
             }
         if (m_prof) m_prof->pop(m_exec_conf);
 
@@ -2510,43 +2516,52 @@ void CommunicatorGPU::beginUpdateGhosts(unsigned int timestep)
             }
 
             {
-            unsigned int offs = 0;
-            // access particle data
-            #ifdef ENABLE_MPI_CUDA
-            offs = first_idx;
-            // recv buffers, directly write into particle data arrays
-            ArrayHandle<Scalar4> pos_ghost_recvbuf_handle(m_pdata->getPositions(), access_location::device, access_mode::readwrite);
-            ArrayHandle<Scalar4> vel_ghost_recvbuf_handle(m_pdata->getVelocities(), access_location::device, access_mode::readwrite);
-            ArrayHandle<Scalar4> orientation_ghost_recvbuf_handle(m_pdata->getOrientationArray(), access_location::device, access_mode::readwrite);
-
-            // send buffers
-            ArrayHandle<Scalar4> pos_ghost_sendbuf_handle(m_pos_ghost_sendbuf, access_location::device, access_mode::read);
-            ArrayHandle<Scalar4> vel_ghost_sendbuf_handle(m_vel_ghost_sendbuf, access_location::device, access_mode::read);
-            ArrayHandle<Scalar4> orientation_ghost_sendbuf_handle(m_orientation_ghost_sendbuf, access_location::device, access_mode::read);
+            // with device direct MPI, receive directly into the particle data arrays on the device
+            bool device_direct = m_exec_conf->isMPIDeviceDirect();
+            unsigned int offs = device_direct ? first_idx : 0;
+            access_mode::Enum recv_mode = device_direct ? access_mode::readwrite : access_mode::overwrite;
 
-            ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors, access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_ghost_begin(m_ghost_begin, access_location::host, access_mode::read);
+            if (!device_direct)
+                {
+                if (flags[comm_flag::position]) m_pos_update_recvbuf.resize(m_n_recv_ghosts_tot[stage]);
+                if (flags[comm_flag::velocity]) m_vel_update_recvbuf.resize(m_n_recv_ghosts_tot[stage]);
+                }
 
-            // MPI library may use non-zero stream
-            hipDeviceSynchronize();
-            #else
             // recv buffers
-            ArrayHandle<Scalar4> pos_ghost_recvbuf_handle(m_pos_ghost_recvbuf, access_location::host, access_mode::overwrite);
-            ArrayHandle<Scalar4> vel_ghost_recvbuf_handle(m_vel_ghost_recvbuf, access_location::host, access_mode::overwrite);
-            ArrayHandle<Scalar4> orientation_ghost_recvbuf_handle(m_orientation_ghost_recvbuf, access_location::host, access_mode::overwrite);
+            MPIBufferHandle<Scalar4> pos_ghost_recvbuf_handle(
+                device_direct ? m_pdata->getPositions() : m_pos_ghost_recvbuf, device_direct, recv_mode);
+            MPIBufferHandle<Scalar4> vel_ghost_recvbuf_handle(
+                device_direct ? m_pdata->getVelocities() : m_vel_ghost_recvbuf, device_direct, recv_mode);
+            MPIBufferHandle<Scalar4> orientation_ghost_recvbuf_handle(
+                device_direct ? m_pdata->getOrientationArray() : m_orientation_ghost_recvbuf, device_direct, recv_mode);
 
             // send buffers
-            ArrayHandleAsync<Scalar4> pos_ghost_sendbuf_handle(m_pos_ghost_sendbuf, access_location::host, access_mode::read);
-            ArrayHandleAsync<Scalar4> vel_ghost_sendbuf_handle(m_vel_ghost_sendbuf, access_location::host, access_mode::read);
-            ArrayHandleAsync<Scalar4> orientation_ghost_sendbuf_handle(m_orientation_ghost_sendbuf, access_location::host, access_mode::read);
+            MPIBufferHandle<Scalar4> pos_ghost_sendbuf_handle(m_pos_ghost_sendbuf, device_direct, access_mode::read);
+            MPIBufferHandle<Scalar4> vel_ghost_sendbuf_handle(m_vel_ghost_sendbuf, device_direct, access_mode::read);
+            MPIBufferHandle<Scalar4> orientation_ghost_sendbuf_handle(m_orientation_ghost_sendbuf, device_direct,
+                                                                      access_mode::read);
+
+            // host staged x, y, and z of the positions and velocities, these are empty with device direct MPI
+            MPIBufferHandle<Scalar3> pos_update_sendbuf_handle(m_pos_update_copybuf, false, access_mode::read);
+            MPIBufferHandle<Scalar3> pos_update_recvbuf_handle(m_pos_update_recvbuf, false, access_mode::overwrite);
+            MPIBufferHandle<Scalar3> vel_update_sendbuf_handle(m_vel_update_copybuf, false, access_mode::read);
+            MPIBufferHandle<Scalar3> vel_update_recvbuf_handle(m_vel_update_recvbuf, false, access_mode::overwrite);
+            const unsigned int update_size = device_direct ? sizeof(Scalar4) : sizeof(Scalar3);
 
             ArrayHandleAsync<unsigned int> h_unique_neighbors(m_unique_neighbors, access_location::host, access_mode::read);
             ArrayHandleAsync<unsigned int> h_ghost_begin(m_ghost_begin, access_location::host, access_mode::read);
 
-            // lump together into one synchronization call
-            hipEventRecord(m_event);
-            hipEventSynchronize(m_event);
-            #endif
+            if (device_direct)
+                {
+                // MPI library may use non-zero stream
+                hipDeviceSynchronize();
+                }
+            else
+                {
+                // lump together into one synchronization call
+                hipEventRecord(m_event);
+                hipEventSynchronize(m_event);
+                }
 
             // access send buffers
             if (m_prof) m_prof->push(m_exec_conf, "MPI send/recv");
@@ -2567,8 +2582,11 @@ void CommunicatorGPU::beginUpdateGhosts(unsigned int timestep)
                     {
                     if (m_n_send_ghosts[stage][ineigh])
                         {
-                        MPI_Isend(pos_ghost_sendbuf_handle.data+h_ghost_begin.data[ineigh + stage*m_n_unique_neigh],
-                            int(m_n_send_ghosts[stage][ineigh]*sizeof(Scalar4)),
+                        void *sendbuf = device_direct ?
+                            (void *)(pos_ghost_sendbuf_handle.data+h_ghost_begin.data[ineigh + stage*m_n_unique_neigh]) :
+                            (void *)(pos_update_sendbuf_handle.data+h_ghost_begin.data[ineigh + stage*m_n_unique_neigh]);
+                        MPI_Isend(sendbuf,
+                            int(m_n_send_ghosts[stage][ineigh]*update_size),
                             MPI_BYTE,
                             neighbor,
                             2,
@@ -2576,12 +2594,15 @@ void CommunicatorGPU::beginUpdateGhosts(unsigned int timestep)
                             &req);
                         m_reqs.push_back(req);
                         }
-                    send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh]*sizeof(Scalar4));
+                    send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh]*update_size);
 
                     if (m_n_recv_ghosts[stage][ineigh])
                         {
-                        MPI_Irecv(pos_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh] + offs,
-                            int(m_n_recv_ghosts[stage][ineigh]*sizeof(Scalar4)),
+                        void *recvbuf = device_direct ?
+                            (void *)(pos_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh] + offs) :
+                            (void *)(pos_update_recvbuf_handle.data + m_ghost_offs[stage][ineigh]);
+                        MPI_Irecv(recvbuf,
+                            int(m_n_recv_ghosts[stage][ineigh]*update_size),
                             MPI_BYTE,
                             neighbor,
                             2,
@@ -2589,15 +2610,18 @@ void CommunicatorGPU::beginUpdateGhosts(unsigned int timestep)
                             &req);
                         m_reqs.push_back(req);
                         }
-                    recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh]*sizeof(Scalar4));
+                    recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh]*update_size);
                     }
 
                 if (flags[comm_flag::velocity])
                     {
                     if (m_n_send_ghosts[stage][ineigh])
                         {
-                        MPI_Isend(vel_ghost_sendbuf_handle.data+h_ghost_begin.data[ineigh + stage*m_n_unique_neigh],
-                            int(m_n_send_ghosts[stage][ineigh]*sizeof(Scalar4)),
+                        void *sendbuf = device_direct ?
+                            (void *)(vel_ghost_sendbuf_handle.data+h_ghost_begin.data[ineigh + stage*m_n_unique_neigh]) :
+                            (void *)(vel_update_sendbuf_handle.data+h_ghost_begin.data[ineigh + stage*m_n_unique_neigh]);
+                        MPI_Isend(sendbuf,
+                            int(m_n_send_ghosts[stage][ineigh]*update_size),
                             MPI_BYTE,
                             neighbor,
                             3,
@@ -2605,12 +2629,15 @@ void CommunicatorGPU::beginUpdateGhosts(unsigned int timestep)
                             &req);
                         m_reqs.push_back(req);
                         }
-                    send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh]*sizeof(Scalar4));
+                    send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh]*update_size);
 
                     if (m_n_recv_ghosts[stage][ineigh])
                         {
-                        MPI_Irecv(vel_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh] + offs,
-                            int(m_n_recv_ghosts[stage][ineigh]*sizeof(Scalar4)),
+                        void *recvbuf = device_direct ?
+                            (void *)(vel_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh] + offs) :
+                            (void *)(vel_update_recvbuf_handle.data + m_ghost_offs[stage][ineigh]);
+                        MPI_Irecv(recvbuf,
+                            int(m_n_recv_ghosts[stage][ineigh]*update_size),
                             MPI_BYTE,
                             neighbor,
                             3,
@@ -2618,7 +2645,7 @@ void CommunicatorGPU::beginUpdateGhosts(unsigned int timestep)
                             &req);
                         m_reqs.push_back(req);
                         }
-                    recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh]*sizeof(Scalar4));
+                    recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh]*update_size);
                     }
 
                 if (flags[comm_flag::orientation])
@@ -2669,51 +2696,13 @@ void CommunicatorGPU::beginUpdateGhosts(unsigned int timestep)
 
         if (!m_comm_pending)
             {
-            #ifndef ENABLE_MPI_CUDA
-            //only unpack in non-CUDA MPI builds
-            if (m_prof) m_prof->push(m_exec_conf,"unpack");
+            // device-direct MPI receives into the particle data, only unpack the host staged buffers
+            if (!m_exec_conf->isMPIDeviceDirect())
                 {
-                // access receive buffers
-                ArrayHandle<Scalar4> d_pos_ghost_recvbuf(m_pos_ghost_recvbuf, access_location::device, access_mode::read);
-                ArrayHandle<Scalar4> d_vel_ghost_recvbuf(m_vel_ghost_recvbuf, access_location::device, access_mode::read);
-                ArrayHandle<Scalar4> d_orientation_ghost_recvbuf(m_orientation_ghost_recvbuf, access_location::device, access_mode::read);
-                // access particle data
-                ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::readwrite);
-                ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(), access_location::device, access_mode::readwrite);
-                ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(), access_location::device, access_mode::readwrite);
-
-                // copy recv buf into particle data
-                gpu_exchange_ghosts_copy_buf(
-                    m_n_recv_ghosts_tot[stage],
-                    NULL,
-                    d_pos_ghost_recvbuf.data,
-                    d_vel_ghost_recvbuf.data,
-                    NULL,
-                    NULL,
-                    NULL,
-                    NULL,
-                    d_orientation_ghost_recvbuf.data,
-                    NULL,
-                    d_pos.data + first_idx,
-                    d_vel.data + first_idx,
-                    NULL,
-                    NULL,
-                    NULL,
-                    NULL,
-                    d_orientation.data + first_idx,
-                    false,
-                    flags[comm_flag::position],
-                    flags[comm_flag::velocity],
-                    false,
-                    false,
-                    false,
-                    false,
-                    flags[comm_flag::orientation]);
-
-                if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+                if (m_prof) m_prof->push(m_exec_conf,"unpack");
+                unpackGhostUpdate(m_n_recv_ghosts_tot[stage], first_idx, flags);
+                if (m_prof) m_prof->pop(m_exec_conf);
                 }
-            if (m_prof) m_prof->pop(m_exec_conf);
-            #endif
             }
         } // end main communication loop
 
@@ -2738,63 +2727,89 @@ void CommunicatorGPU::finishUpdateGhosts(unsigned int timestep)
         MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &stats.front());
         if (m_prof) m_prof->pop(m_exec_conf);
 
-        #ifdef ENABLE_MPI_CUDA
-        // MPI library may use non-zero stream
-        hipDeviceSynchronize();
-        #else
-        // only unpack in non-CUDA-MPI builds
-        assert(m_num_stages == 1);
-        unsigned int stage = 0;
-        unsigned int first_idx = m_pdata->getN();
-        CommFlags flags = m_last_flags;
-        if (m_prof) m_prof->push(m_exec_conf,"unpack");
+        if (m_exec_conf->isMPIDeviceDirect())
             {
-            // access receive buffers
-            ArrayHandle<Scalar4> d_pos_ghost_recvbuf(m_pos_ghost_recvbuf, access_location::device, access_mode::read);
-            ArrayHandle<Scalar4> d_vel_ghost_recvbuf(m_vel_ghost_recvbuf, access_location::device, access_mode::read);
-            ArrayHandle<Scalar4> d_orientation_ghost_recvbuf(m_orientation_ghost_recvbuf, access_location::device, access_mode::read);
-            // access particle data
-            ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::readwrite);
-            ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(), access_location::device, access_mode::readwrite);
-            ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(), access_location::device, access_mode::readwrite);
-
-            // copy recv buf into particle data
-            gpu_exchange_ghosts_copy_buf(
-                m_n_recv_ghosts_tot[stage],
-                NULL,
-                d_pos_ghost_recvbuf.data,
-                d_vel_ghost_recvbuf.data,
-                NULL,
-                NULL,
-                NULL,
-                NULL,
-                d_orientation_ghost_recvbuf.data,
-                NULL,
-                d_pos.data + first_idx,
-                d_vel.data + first_idx,
-                NULL,
-                NULL,
-                NULL,
-                NULL,
-                d_orientation.data + first_idx,
-                false,
-                flags[comm_flag::position],
-                flags[comm_flag::velocity],
-                false,
-                false,
-                false,
-                false,
-                flags[comm_flag::orientation]);
-
-            if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+            // MPI library may use non-zero stream
+            hipDeviceSynchronize();
+            }
+        else
+            {
+            // only unpack the host staged buffers
+            assert(m_num_stages == 1);
+            unsigned int stage = 0;
+            unsigned int first_idx = m_pdata->getN();
+            CommFlags flags = m_last_flags;
+            if (m_prof) m_prof->push(m_exec_conf,"unpack");
+            unpackGhostUpdate(m_n_recv_ghosts_tot[stage], first_idx, flags);
+            if (m_prof) m_prof->pop(m_exec_conf);
             }
-        if (m_prof) m_prof->pop(m_exec_conf);
-        #endif
 
         if (m_prof) m_prof->pop(m_exec_conf);
         }
     }
 
+/*! \param n_recv Number of received ghosts
+    \param first_idx Index of the first received ghost in the particle data
+    \param flags Fields that were sent
+
+    Positions and velocities are received as x, y, and z, orientations as whole quaternions.
+ */
+void CommunicatorGPU::unpackGhostUpdate(unsigned int n_recv, unsigned int first_idx, const CommFlags& flags)
+    {
+    if (flags[comm_flag::position])
+        {
+        ArrayHandle<Scalar3> d_pos_update_recvbuf(m_pos_update_recvbuf, access_location::device, access_mode::read);
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::readwrite);
+
+        gpu_expand_ghost_update(n_recv, d_pos_update_recvbuf.data, d_pos.data + first_idx);
+        }
+
+    if (flags[comm_flag::velocity])
+        {
+        ArrayHandle<Scalar3> d_vel_update_recvbuf(m_vel_update_recvbuf, access_location::device, access_mode::read);
+        ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(), access_location::device, access_mode::readwrite);
+
+        gpu_expand_ghost_update(n_recv, d_vel_update_recvbuf.data, d_vel.data + first_idx);
+        }
+
+    if (flags[comm_flag::orientation])
+        {
+        ArrayHandle<Scalar4> d_orientation_ghost_recvbuf(m_orientation_ghost_recvbuf, access_location::device,
+            access_mode::read);
+        ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(), access_location::device,
+            access_mode::readwrite);
+
+        gpu_exchange_ghosts_copy_buf(
+            n_recv,
+            NULL,
+            NULL,
+            NULL,
+            NULL,
+            NULL,
+            NULL,
+            NULL,
+            d_orientation_ghost_recvbuf.data,
+            NULL,
+            NULL,
+            NULL,
+            NULL,
+            NULL,
+            NULL,
+            NULL,
+            d_orientation.data + first_idx,
+            false,
+            false,
+            false,
+            false,
+            false,
+            false,
+            false,
+            true);
+        }
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+    }
+
 //! Perform ghosts update
 void CommunicatorGPU::updateNetForce(unsigned int timestep)
     {
@@ -3122,6 +3137,135 @@ void CommunicatorGPU::updateNetForce(unsigned int timestep)
     if (m_prof) m_prof->pop(m_exec_conf);
     }
 
+void CommunicatorGPU::updateGhostField(const GlobalArray<Scalar>& field)
+    {
+    assert(field.getNumElements() >= m_pdata->getN() + m_pdata->getNGhosts());
+
+    m_exec_conf->msg->notice(7) << "CommunicatorGPU: update ghost field" << std::endl;
+
+    if (m_prof) m_prof->push(m_exec_conf, "comm_ghost_field");
+
+    for (unsigned int stage = 0; stage < m_num_stages; ++stage)
+        {
+        if (m_prof) m_prof->push(m_exec_conf,"pack");
+
+        // compute maximum send buf size
+        unsigned int n_max = 0;
+        for (unsigned int istage = 0; istage <= stage; ++istage)
+            if (m_n_send_ghosts_tot[istage] > n_max) n_max = m_n_send_ghosts_tot[istage];
+
+        m_field_ghost_sendbuf.resize(n_max);
+
+            {
+            ArrayHandle<Scalar> d_field(field, access_location::device, access_mode::read);
+            ArrayHandle<uint2> d_ghost_idx_adj(m_ghost_idx_adj, access_location::device, access_mode::read);
+            ArrayHandle<Scalar> d_field_ghost_sendbuf(m_field_ghost_sendbuf, access_location::device, access_mode::overwrite);
+
+            // Pack ghosts into send buffers
+            gpu_exchange_ghosts_pack_field(
+                m_n_send_ghosts_tot[stage],
+                d_ghost_idx_adj.data + m_idx_offs[stage],
+                d_field.data,
+                d_field_ghost_sendbuf.data);
+
+            if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+            }
+
+        if (m_prof) m_prof->pop(m_exec_conf);
+
+        n_max = 0;
+        // compute maximum number of received ghosts
+        for (unsigned int istage = 0; istage <= stage; ++istage)
+            if (m_n_recv_ghosts_tot[istage] > n_max) n_max = m_n_recv_ghosts_tot[istage];
+
+        m_field_ghost_recvbuf.resize(n_max);
+
+        // first ghost ptl index
+        unsigned int first_idx = m_pdata->getN();
+
+        // total up ghosts received thus far
+        for (unsigned int istage = 0; istage < stage; ++istage)
+            {
+            first_idx += m_n_recv_ghosts_tot[istage];
+            }
+
+            {
+            unsigned int offs = 0;
+            ArrayHandle<Scalar> h_field_ghost_recvbuf(m_field_ghost_recvbuf, access_location::host, access_mode::overwrite);
+            ArrayHandle<Scalar> h_field_ghost_sendbuf(m_field_ghost_sendbuf, access_location::host, access_mode::read);
+
+            ArrayHandleAsync<unsigned int> h_unique_neighbors(m_unique_neighbors, access_location::host, access_mode::read);
+            ArrayHandleAsync<unsigned int> h_ghost_begin(m_ghost_begin, access_location::host, access_mode::read);
+
+            if (m_prof) m_prof->push(m_exec_conf, "MPI send/recv");
+
+            m_reqs.clear();
+            MPI_Request req;
+
+            unsigned int send_bytes = 0;
+            unsigned int recv_bytes = 0;
+
+            // loop over neighbors
+            for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
+                {
+                // rank of neighbor processor
+                unsigned int neighbor = h_unique_neighbors.data[ineigh];
+
+                if (m_n_send_ghosts[stage][ineigh])
+                    {
+                    MPI_Isend(h_field_ghost_sendbuf.data+h_ghost_begin.data[ineigh + stage*m_n_unique_neigh],
+                        int(m_n_send_ghosts[stage][ineigh]*sizeof(Scalar)),
+                        MPI_BYTE,
+                        neighbor,
+                        5,
+                        m_mpi_comm,
+                        &req);
+                    m_reqs.push_back(req);
+                    }
+                send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh]*sizeof(Scalar));
+
+                if (m_n_recv_ghosts[stage][ineigh])
+                    {
+                    MPI_Irecv(h_field_ghost_recvbuf.data + m_ghost_offs[stage][ineigh] + offs,
+                        int(m_n_recv_ghosts[stage][ineigh]*sizeof(Scalar)),
+                        MPI_BYTE,
+                        neighbor,
+                        5,
+                        m_mpi_comm,
+                        &req);
+                    m_reqs.push_back(req);
+                    }
+                recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh]*sizeof(Scalar));
+                }
+
+            // complete communication
+            std::vector<MPI_Status> stats(m_reqs.size());
+            MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &stats.front());
+
+            if (m_prof) m_prof->pop(m_exec_conf,0,send_bytes+recv_bytes);
+            } // end ArrayHandle scope
+
+        if (m_prof) m_prof->push(m_exec_conf,"unpack");
+
+            {
+            ArrayHandle<Scalar> d_field_ghost_recvbuf(m_field_ghost_recvbuf, access_location::device, access_mode::read);
+            ArrayHandle<Scalar> d_field(field, access_location::device, access_mode::readwrite);
+
+            // copy recv buf into the ghost entries of the field
+            gpu_exchange_ghosts_copy_field_buf(
+                m_n_recv_ghosts_tot[stage],
+                d_field_ghost_recvbuf.data,
+                d_field.data + first_idx);
+
+            if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+            }
+
+        if (m_prof) m_prof->pop(m_exec_conf);
+        } // end main communication loop
+
+    if (m_prof) m_prof->pop(m_exec_conf);
+    }
+
  //! Export CommunicatorGPU class to python
 void export_CommunicatorGPU(py::module& m)
     {
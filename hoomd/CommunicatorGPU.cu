@@ -299,6 +299,45 @@ void gpu_reset_rtags(unsigned int n_delete_ptls,
     }
 
 //! Kernel to select ghost atoms due to non-bonded interactions
+//! Kernel to mark the types of the local particles
+__global__ void gpu_find_local_types_kernel(unsigned int N,
+                                            const Scalar4 *d_pos,
+                                            unsigned int *d_types)
+    {
+    unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+
+    if (idx >= N) return;
+
+    // concurrent writes store the same value
+    d_types[__scalar_as_int(d_pos[idx].w)] = 1;
+    }
+
+/*! \param N Number of local particles
+    \param d_pos Device array of particle positions and types
+    \param d_types Output: nonzero for each type present
+    \param ntypes Number of particle types
+ */
+void gpu_find_local_types(unsigned int N,
+                          const Scalar4 *d_pos,
+                          unsigned int *d_types,
+                          unsigned int ntypes)
+    {
+    assert(d_pos);
+    assert(d_types);
+
+    hipMemset(d_types, 0, sizeof(unsigned int)*ntypes);
+
+    if (N == 0) return;
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = N/block_size + 1;
+
+    hipLaunchKernelGGL(gpu_find_local_types_kernel, dim3(n_blocks), dim3(block_size), 0, 0,
+        N,
+        d_pos,
+        d_types);
+    }
+
 __global__ void gpu_make_ghost_exchange_plan_kernel(
     unsigned int N,
     const Scalar4 *d_postype,
@@ -976,6 +1015,22 @@ void gpu_exchange_ghosts_pack_netforce(
         n_out, d_ghost_idx_adj, d_netforce, d_netforce_sendbuf);
     }
 
+void gpu_exchange_ghosts_pack_field(
+    unsigned int n_out,
+    const uint2 *d_ghost_idx_adj,
+    const Scalar *d_field,
+    Scalar *d_field_sendbuf)
+    {
+    assert(d_ghost_idx_adj);
+    assert(d_field);
+    assert(d_field_sendbuf);
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = n_out/block_size + 1;
+    hipLaunchKernelGGL(gpu_pack_kernel, dim3(n_blocks), dim3(block_size), 0, 0,
+        n_out, d_ghost_idx_adj, d_field, d_field_sendbuf);
+    }
+
 __global__ void gpu_pack_netvirial_kernel(
     unsigned int n_out,
     const uint2 *d_ghost_idx_adj,
@@ -1159,6 +1214,79 @@ void gpu_exchange_ghosts_copy_netforce_buf(
         n_recv, d_netforce_recvbuf, d_netforce);
     }
 
+void gpu_exchange_ghosts_copy_field_buf(
+    unsigned int n_recv,
+    const Scalar *d_field_recvbuf,
+    Scalar *d_field)
+    {
+    assert(d_field_recvbuf);
+    assert(d_field);
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = n_recv/block_size + 1;
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_unpack_kernel<Scalar>), dim3(n_blocks), dim3(block_size), 0, 0,
+        n_recv, d_field_recvbuf, d_field);
+    }
+
+__global__ void gpu_compact_ghost_update_kernel(
+    unsigned int n,
+    const Scalar4 *d_in,
+    Scalar3 *d_out)
+    {
+    unsigned int idx = blockIdx.x*blockDim.x + threadIdx.x;
+    if (idx >= n) return;
+
+    Scalar4 in = d_in[idx];
+    d_out[idx] = make_scalar3(in.x, in.y, in.z);
+    }
+
+/*! \param n Number of ghosts
+    \param d_in Packed positions or velocities
+    \param d_out Output: x, y, and z of the packed values
+ */
+void gpu_compact_ghost_update(unsigned int n,
+                              const Scalar4 *d_in,
+                              Scalar3 *d_out)
+    {
+    assert(d_in);
+    assert(d_out);
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = n/block_size + 1;
+    hipLaunchKernelGGL(gpu_compact_ghost_update_kernel, dim3(n_blocks), dim3(block_size), 0, 0,
+        n, d_in, d_out);
+    }
+
+__global__ void gpu_expand_ghost_update_kernel(
+    unsigned int n,
+    const Scalar3 *d_in,
+    Scalar4 *d_out)
+    {
+    unsigned int idx = blockIdx.x*blockDim.x + threadIdx.x;
+    if (idx >= n) return;
+
+    Scalar3 in = d_in[idx];
+    Scalar4 out = d_out[idx];
+    d_out[idx] = make_scalar4(in.x, in.y, in.z, out.w);
+    }
+
+/*! \param n Number of ghosts
+    \param d_in Received x, y, and z
+    \param d_out Output: ghost positions or velocities, the type or mass is kept
+ */
+void gpu_expand_ghost_update(unsigned int n,
+                             const Scalar3 *d_in,
+                             Scalar4 *d_out)
+    {
+    assert(d_in);
+    assert(d_out);
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = n/block_size + 1;
+    hipLaunchKernelGGL(gpu_expand_ghost_update_kernel, dim3(n_blocks), dim3(block_size), 0, 0,
+        n, d_in, d_out);
+    }
+
 __global__ void gpu_unpack_netvirial_kernel(
     unsigned int n_in,
     const Scalar *in,
@@ -84,6 +84,12 @@ void gpu_reset_rtags(unsigned int n_delete_ptls,
                      unsigned int *d_delete_tags,
                      unsigned int *d_rtag);
 
+//! Mark the types of the local particles
+void gpu_find_local_types(unsigned int N,
+                          const Scalar4 *d_pos,
+                          unsigned int *d_types,
+                          unsigned int ntypes);
+
 //! Construct plans for sending non-bonded ghost particles
 void gpu_make_ghost_exchange_plan(unsigned int *d_plan,
                                   unsigned int N,
@@ -184,6 +190,16 @@ void gpu_exchange_ghosts_copy_buf(
     bool send_image,
     bool send_orientation);
 
+//! Copy x, y, and z of ghost positions or velocities into a staging buffer
+void gpu_compact_ghost_update(unsigned int n,
+                              const Scalar4 *d_in,
+                              Scalar3 *d_out);
+
+//! Copy x, y, and z of ghost positions or velocities from a staging buffer, keep w
+void gpu_expand_ghost_update(unsigned int n,
+                             const Scalar3 *d_in,
+                             Scalar4 *d_out);
+
 //! Compute ghost rtags
 void gpu_compute_ghost_rtags(unsigned int first_idx,
      unsigned int n_ghost,
@@ -360,4 +376,15 @@ void gpu_exchange_ghosts_copy_netvirial_buf(
     const Scalar *d_netvirial_recvbuf,
     Scalar *d_netvirial,
     unsigned int pitch_out);
+
+void gpu_exchange_ghosts_pack_field(
+    unsigned int n_out,
+    const uint2 *d_ghost_idx_adj,
+    const Scalar *d_field,
+    Scalar *d_field_sendbuf);
+
+void gpu_exchange_ghosts_copy_field_buf(
+    unsigned int n_recv,
+    const Scalar *d_field_recvbuf,
+    Scalar *d_field);
 #endif // ENABLE_MPI
@@ -69,6 +69,9 @@ class PYBIND11_EXPORT CommunicatorGPU : public Communicator
          * \parm timestep The time step
          */
         virtual void updateNetForce(unsigned int timestep);
+
+        //! Communicate a per-particle scalar field to the ghost particles
+        virtual void updateGhostField(const GlobalArray<Scalar>& field);
         //@}
 
         //! Set maximum number of communication stages
@@ -152,6 +155,12 @@ class PYBIND11_EXPORT CommunicatorGPU : public Communicator
         //! Remove tags of ghost particles
         virtual void removeGhostParticleTags();
 
+        //! Mark the types of the local particles on the GPU
+        virtual void findLocalTypes(std::vector<unsigned int>& types);
+
+        //! Copy the host staged ghost updates into the particle data
+        void unpackGhostUpdate(unsigned int n_recv, unsigned int first_idx, const CommFlags& flags);
+
     private:
         /* General communication */
         unsigned int m_max_stages;                     //!< Maximum number of (dependent) communication stages
@@ -166,6 +175,9 @@ class PYBIND11_EXPORT CommunicatorGPU : public Communicator
 
         GlobalVector<unsigned int> m_send_keys;           //!< Destination rank for particles
 
+        /* Ghost exchange */
+        GlobalVector<unsigned int> m_local_types;         //!< Flag per type that is present in the local domain
+
         /* Communication of bonded groups */
         GroupCommunicatorGPU<BondData> m_bond_comm;    //!< Communication helper for bonds
         friend class GroupCommunicatorGPU<BondData>;
@@ -219,6 +231,9 @@ class PYBIND11_EXPORT CommunicatorGPU : public Communicator
         GlobalVector<Scalar> m_netvirial_ghost_sendbuf;    //!< Send buffer for netvirial
         GlobalVector<Scalar> m_netvirial_ghost_recvbuf;    //!< Recv buffer for netvirial
 
+        GlobalVector<Scalar> m_field_ghost_sendbuf;        //!< Send buffer for per-particle scalar fields
+        GlobalVector<Scalar> m_field_ghost_recvbuf;        //!< Recv buffer for per-particle scalar fields
+
         GlobalVector<unsigned int> m_ghost_begin;          //!< Begin index for every stage and neighbor in send buf
         GlobalVector<unsigned int> m_ghost_end;            //!< Begin index for every and neighbor in send buf
 
@@ -242,6 +257,9 @@ class PYBIND11_EXPORT CommunicatorGPU : public Communicator
         //! Helper function to allocate various buffers
         void allocateBuffers();
 
+        //! Print the statistics of the particle migration buffers (on destruction)
+        void printBufferStatistics();
+
         //! Helper function to set up communication stages
         void initializeCommunicationStages();
     };
@@ -62,6 +62,8 @@ ConstForceCompute::~ConstForceCompute()
 */
 void ConstForceCompute::setForce(Scalar fx, Scalar fy, Scalar fz, Scalar tx, Scalar ty, Scalar tz)
     {
+    m_energy_sum_valid = false;
+
     assert(m_pdata != NULL);
 
     m_fx = fx;
@@ -105,6 +107,8 @@ void ConstForceCompute::setForce(Scalar fx, Scalar fy, Scalar fz, Scalar tx, Sca
 */
 void ConstForceCompute::setParticleForce(unsigned int tag, Scalar fx, Scalar fy, Scalar fz, Scalar tx, Scalar ty, Scalar tz)
     {
+    m_energy_sum_valid = false;
+
     if (tag > m_pdata->getMaximumTag())
         {
         m_exec_conf->msg->error() << "Particle tag needs to be smaller or equal the maximum tag in the system." << std::endl;
@@ -127,6 +131,8 @@ void ConstForceCompute::setParticleForce(unsigned int tag, Scalar fx, Scalar fy,
 */
 void ConstForceCompute::setGroupForce(std::shared_ptr<ParticleGroup> group, Scalar fx, Scalar fy, Scalar fz, Scalar tx, Scalar ty, Scalar tz)
     {
+    m_energy_sum_valid = false;
+
     ArrayHandle<Scalar4> h_force(m_force,access_location::host,access_mode::overwrite);
     ArrayHandle<Scalar4> h_torque(m_torque,access_location::host,access_mode::overwrite);
 
@@ -67,8 +67,8 @@ DCDDumpWriter::DCDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
                              bool overwrite)
     : Analyzer(sysdef), m_fname(fname), m_start_timestep(0), m_period(period), m_group(group),
       m_num_frames_written(0), m_last_written_step(0), m_appending(false),
-      m_unwrap_full(false), m_unwrap_rigid(false), m_angle(false),
-      m_overwrite(overwrite), m_is_initialized(false)
+      m_unwrap_full(false), m_unwrap_rigid(false), m_angle(false), m_streaming(false),
+      m_overwrite(overwrite), m_is_initialized(false), m_group_rows(m_exec_conf)
     {
     m_exec_conf->msg->notice(5) << "Constructing DCDDumpWriter: " << fname << " " << period << " " << overwrite << endl;
     }
@@ -145,10 +145,13 @@ void DCDDumpWriter::analyze(unsigned int timestep)
     if (m_prof)
         m_prof->push("Dump DCD");
 
-    // take particle data snapshot
+    // take particle data snapshot, or gather only the positions when streaming
     SnapshotParticleData<Scalar> snapshot;
 
-    m_pdata->takeSnapshot(snapshot);
+    if (m_streaming)
+        gather_stream_data();
+    else
+        m_pdata->takeSnapshot(snapshot);
 
 #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
@@ -185,7 +188,10 @@ void DCDDumpWriter::analyze(unsigned int timestep)
     // write the data for the current time step
     m_file.seekp(0, std::ios_base::end);
     write_frame_header(m_file);
-    write_frame_data(m_file, snapshot);
+    if (m_streaming)
+        write_stream_data(m_file);
+    else
+        write_frame_data(m_file, snapshot);
 
     // update the header with the number of frames written
     m_num_frames_written++;
@@ -349,9 +355,7 @@ void DCDDumpWriter::write_frame_data(std::fstream &file, const SnapshotParticleD
         }
 
     // write x coords
-    write_int(file, (unsigned int)(nparticles * sizeof(float)));
-    file.write((char *)m_staging_buffer, nparticles * sizeof(float));
-    write_int(file, (unsigned int)(nparticles * sizeof(float)));
+    write_coordinates(file, m_staging_buffer, nparticles);
 
     // prepare y coords for writing
     for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
@@ -361,9 +365,7 @@ void DCDDumpWriter::write_frame_data(std::fstream &file, const SnapshotParticleD
         }
 
     // write y coords
-    write_int(file, (unsigned int)(nparticles * sizeof(float)));
-    file.write((char *)m_staging_buffer, nparticles * sizeof(float));
-    write_int(file, (unsigned int)(nparticles * sizeof(float)));
+    write_coordinates(file, m_staging_buffer, nparticles);
 
     // prepare z coords for writing
     for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
@@ -380,9 +382,150 @@ void DCDDumpWriter::write_frame_data(std::fstream &file, const SnapshotParticleD
         }
 
     // write z coords
-    write_int(file, (unsigned int)(nparticles * sizeof(float)));
-    file.write((char *)m_staging_buffer, nparticles * sizeof(float));
-    write_int(file, (unsigned int)(nparticles * sizeof(float)));
+    write_coordinates(file, m_staging_buffer, nparticles);
+
+    // check for errors
+    if (!file.good())
+        {
+        m_exec_conf->msg->error() << "I/O error while writing DCD frame data" << endl;
+        throw runtime_error("Error writing DCD file");
+        }
+    }
+
+/*! \param file File to write to
+    \param data Coordinates to write
+    \param n Number of coordinates
+*/
+void DCDDumpWriter::write_coordinates(std::fstream &file, const float *data, unsigned int n)
+    {
+    write_int(file, (unsigned int)(n * sizeof(float)));
+    file.write((const char *)data, n * sizeof(float));
+    write_int(file, (unsigned int)(n * sizeof(float)));
+    }
+
+/*! Each rank takes a distributed snapshot of the positions and images of its particles and converts the positions of
+    the group members to single precision. The root rank gathers the coordinates together with their row in the file
+    and places them directly into the x, y, and z blocks of m_stream_buffer. No other particle properties are copied
+    and no rank holds a global snapshot. Must be called on all ranks.
+*/
+void DCDDumpWriter::gather_stream_data()
+    {
+    if (m_unwrap_rigid || m_angle)
+        {
+        m_exec_conf->msg->error() << "dump.dcd: streaming cannot unwrap rigid bodies or write orientation angles"
+                                  << endl;
+        throw runtime_error("Error writing DCD file");
+        }
+
+    unsigned int nparticles = m_group->getNumMembersGlobal();
+
+    // the row of a particle in the file is the position of its tag in the group
+    if (m_group_rows.size() != nparticles)
+        {
+        std::vector<unsigned int> member_tags(nparticles);
+        for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
+            member_tags[group_idx] = m_group->getMemberTag(group_idx);
+        m_group_rows.build(member_tags.data(), nparticles);
+        }
+
+    DistributedSnapshotParticleData<Scalar> snapshot;
+    m_pdata->takeDistributedSnapshot(snapshot, true);
+
+    BoxDim box = m_pdata->getGlobalBox();
+
+    // rows and interleaved coordinates of the local group members
+    std::vector<unsigned int> rows;
+    std::vector<float> coords;
+    rows.reserve(snapshot.size);
+    coords.reserve(3*snapshot.size);
+
+        {
+        ArrayHandle<uint2> h_group_rows(m_group_rows.getTable(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < snapshot.size; i++)
+            {
+            unsigned int row = tag_index_map_find(h_group_rows.data, m_group_rows.getMask(), snapshot.tag[i]);
+            if (row == TAG_INDEX_MAP_EMPTY)
+                continue;
+
+            vec3<Scalar> pos = snapshot.pos[i];
+            if (m_unwrap_full)
+                pos = box.shift(pos, snapshot.image[i]);
+
+            rows.push_back(row);
+            coords.push_back(float(pos.x));
+            coords.push_back(float(pos.y));
+            coords.push_back(float(pos.z));
+            }
+        }
+
+    std::vector<unsigned int> all_rows;
+    std::vector<float> all_coords;
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        bool root = m_exec_conf->isRoot();
+        unsigned int nranks = m_exec_conf->getNRanks();
+        MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+
+        int n_local = int(rows.size());
+        std::vector<int> counts(root ? nranks : 0);
+        MPI_Gather(&n_local, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, mpi_comm);
+
+        std::vector<int> displs(root ? nranks : 0);
+        std::vector<int> coord_counts(root ? nranks : 0);
+        std::vector<int> coord_displs(root ? nranks : 0);
+        if (root)
+            {
+            int offset = 0;
+            for (unsigned int rank = 0; rank < nranks; rank++)
+                {
+                displs[rank] = offset;
+                coord_counts[rank] = 3*counts[rank];
+                coord_displs[rank] = 3*offset;
+                offset += counts[rank];
+                }
+            all_rows.resize(offset);
+            all_coords.resize(3*size_t(offset));
+            }
+
+        MPI_Gatherv(rows.data(), n_local, MPI_UNSIGNED,
+                    all_rows.data(), counts.data(), displs.data(), MPI_UNSIGNED, 0, mpi_comm);
+        MPI_Gatherv(coords.data(), 3*n_local, MPI_FLOAT,
+                    all_coords.data(), coord_counts.data(), coord_displs.data(), MPI_FLOAT, 0, mpi_comm);
+
+        if (!root)
+            return;
+        }
+    else
+#endif
+        {
+        all_rows.swap(rows);
+        all_coords.swap(coords);
+        }
+
+    // place the coordinates at their rows
+    m_stream_buffer.resize(3*size_t(nparticles));
+    for (unsigned int i = 0; i < all_rows.size(); i++)
+        {
+        unsigned int row = all_rows[i];
+        m_stream_buffer[row] = all_coords[3*i];
+        m_stream_buffer[nparticles + row] = all_coords[3*i+1];
+        m_stream_buffer[2*nparticles + row] = all_coords[3*i+2];
+        }
+    }
+
+/*! \param file File to write to
+    Writes the positions gathered by gather_stream_data()
+*/
+void DCDDumpWriter::write_stream_data(std::fstream &file)
+    {
+    unsigned int nparticles = m_group->getNumMembersGlobal();
+    assert(m_stream_buffer.size() == 3*size_t(nparticles));
+
+    write_coordinates(file, m_stream_buffer.data(), nparticles);
+    write_coordinates(file, m_stream_buffer.data() + nparticles, nparticles);
+    write_coordinates(file, m_stream_buffer.data() + 2*nparticles, nparticles);
 
     // check for errors
     if (!file.good())
@@ -414,5 +557,7 @@ void export_DCDDumpWriter(py::module& m)
     .def("setUnwrapFull", &DCDDumpWriter::setUnwrapFull)
     .def("setUnwrapRigid", &DCDDumpWriter::setUnwrapRigid)
     .def("setAngleZ", &DCDDumpWriter::setAngleZ)
+    .def("setStreaming", &DCDDumpWriter::setStreaming)
+    .def("getStreaming", &DCDDumpWriter::getStreaming)
     ;
     }
@@ -9,10 +9,12 @@
 
 #include "Analyzer.h"
 #include "ParticleGroup.h"
+#include "TagIndexMap.h"
 
 #include <string>
 #include <memory>
 #include <fstream>
+#include <vector>
 
 /*! \file DCDDumpWriter.h
     \brief Declares the DCDDumpWriter class
@@ -46,6 +48,11 @@
     Due to a limitation in the DCD format, the time step period between calls to
     analyze() \b must be specified up front. If analyze() detects that this period is
     not being maintained, it will print a warning but continue.
+
+    By default, every frame takes a global snapshot of all particle properties on the root rank. In streaming mode
+    (setStreaming()), each rank takes a distributed snapshot of only the positions and images of its own particles,
+    and the root rank gathers the coordinates of the group members directly into the file order. Streaming cannot
+    unwrap rigid bodies or write orientation angles, because these need properties of other particles.
     \ingroup analyzers
 */
 class PYBIND11_EXPORT DCDDumpWriter : public Analyzer
@@ -82,6 +89,31 @@ class PYBIND11_EXPORT DCDDumpWriter : public Analyzer
             m_angle = enable;
             }
 
+        //! Set whether frames are gathered from distributed snapshots of the positions only
+        void setStreaming(bool enable)
+            {
+            m_streaming = enable;
+            }
+
+        //! Get whether frames are gathered from distributed snapshots of the positions only
+        bool getStreaming()
+            {
+            return m_streaming;
+            }
+
+        //! Get the particle data arrays read on the host
+        virtual HostArrays getRequestedHostArrays()
+            {
+            if (!m_streaming)
+                return HostArrays().set();
+
+            HostArrays arrays;
+            arrays[host_array::position] = true;
+            arrays[host_array::image] = true;
+            arrays[host_array::tag] = true;
+            return arrays;
+            }
+
     private:
         std::string m_fname;                //!< The file name we are writing to
         unsigned int m_start_timestep;      //!< First time step written to the file
@@ -93,12 +125,15 @@ class PYBIND11_EXPORT DCDDumpWriter : public Analyzer
         bool m_unwrap_full;                 //!< True if coordinates should be written out fully unwrapped in the box
         bool m_unwrap_rigid;                //!< True if rigid bodies should be written out unwrapped
         bool m_angle;                       //!< True if the z-component should be set to the orientation angle
+        bool m_streaming;                   //!< True if frames are gathered from distributed snapshots
 
         bool m_overwrite;                   //!< True if file should be overwritten
         bool m_is_initialized;              //!< True if file IO has been initialized
         unsigned int m_nglobal;             //!< Initial number of particles
 
         float *m_staging_buffer;            //!< Buffer for staging particle positions in tag order
+        std::vector<float> m_stream_buffer; //!< x, y, and z blocks of the streamed frame, in group order (root only)
+        TagIndexMap m_group_rows;           //!< Position of each member tag in the group, used when streaming
         std::fstream m_file;                //!< The file object
 
         // helper functions
@@ -109,6 +144,12 @@ class PYBIND11_EXPORT DCDDumpWriter : public Analyzer
         void write_frame_header(std::fstream &file);
         //! Writes the particle positions for a frame
         void write_frame_data(std::fstream &file, const SnapshotParticleData<Scalar>& snapshot);
+        //! Gathers the positions of the group members into m_stream_buffer on the root rank
+        void gather_stream_data();
+        //! Writes the particle positions gathered by gather_stream_data()
+        void write_stream_data(std::fstream &file);
+        //! Writes one block of coordinates
+        void write_coordinates(std::fstream &file, const float *data, unsigned int n);
         //! Updates the file header
         void write_updated_header(std::fstream &file, unsigned int timestep);
         //! Initializes the output file for writing
@@ -145,15 +145,13 @@ void DomainDecomposition::initializeDomainGrid(Scalar3 L,
             // every node has the same number of ranks, so nranks == num_nodes * num_ranks_per_node
             unsigned int n_nodes = (unsigned int)(m_nodes.size());
 
-            // subdivide the global grid
-            findDecomposition(nranks, L, nx, ny, nz);
+            // choose the node grid and the grid in every node together
+            findTwoLevelDecomposition(n_nodes, nranks/n_nodes, L,
+                nx_node, ny_node, nz_node, nx_intra, ny_intra, nz_intra);
 
-            // subdivide the local grid
-            subdivide(nranks/n_nodes, L, nx, ny, nz, nx_intra, ny_intra, nz_intra);
-
-            nx_node = nx/nx_intra;
-            ny_node = ny/ny_intra;
-            nz_node = nz/nz_intra;
+            nx = nx_node*nx_intra;
+            ny = ny_node*ny_intra;
+            nz = nz_node*nz_intra;
             }
         else
             {
@@ -370,9 +368,22 @@ bool DomainDecomposition::findDecomposition(unsigned int nranks, const Scalar3 L
     return found_decomposition;
     }
 
-//! Find a two-level decomposition of the global grid
-void DomainDecomposition::subdivide(unsigned int n_node_ranks, Scalar3 L,
-    unsigned int nx, unsigned int ny, unsigned int nz,
+/*! \param n_nodes Number of nodes
+    \param n_node_ranks Number of ranks on every node
+    \param L Box lengths of global box to sub-divide
+    \param nx_node Number of nodes along the x direction (output)
+    \param ny_node Number of nodes along the y direction (output)
+    \param nz_node Number of nodes along the z direction (output)
+    \param nx_intra Number of domains per node along the x direction (output)
+    \param ny_intra Number of domains per node along the y direction (output)
+    \param nz_intra Number of domains per node along the z direction (output)
+
+    Ghost particles that cross a node boundary go over the network, while the MPI library passes the others through
+    shared memory. The node grid is chosen to minimize the surface area between nodes, and among the grids with the
+    same off-node area, the grid in every node to minimize the total surface area between domains.
+*/
+void DomainDecomposition::findTwoLevelDecomposition(unsigned int n_nodes, unsigned int n_node_ranks, Scalar3 L,
+    unsigned int& nx_node, unsigned int& ny_node, unsigned int& nz_node,
     unsigned int& nx_intra, unsigned int &ny_intra, unsigned int& nz_intra)
     {
     assert(L.x > 0);
@@ -380,21 +391,46 @@ void DomainDecomposition::subdivide(unsigned int n_node_ranks, Scalar3 L,
     assert(L.z > 0);
 
     // initial guess
+    nx_node = 1;
+    ny_node = 1;
+    nz_node = n_nodes;
     nx_intra = 1;
     ny_intra = 1;
     nz_intra = n_node_ranks;
 
-    for (unsigned int nx_intra_try = 1; nx_intra_try <= n_node_ranks; nx_intra_try++)
-        for (unsigned int ny_intra_try = 1; nx_intra_try*ny_intra_try <= n_node_ranks; ny_intra_try++)
-            for (unsigned int nz_intra_try = 1; nx_intra_try*ny_intra_try*nz_intra_try <= n_node_ranks; nz_intra_try++)
-                {
-                if (nx_intra_try*ny_intra_try*nz_intra_try != n_node_ranks) continue;
-                if (nx % nx_intra_try || ny % ny_intra_try || nz % nz_intra_try) continue;
+    bool found = false;
+    double min_node_area = 0.0;
+    double min_area = 0.0;
 
-                nx_intra = nx_intra_try;
-                ny_intra = ny_intra_try;
-                nz_intra = nz_intra_try;
-                }
+    for (unsigned int nx_n = 1; nx_n <= n_nodes; nx_n++)
+        for (unsigned int ny_n = 1; nx_n*ny_n <= n_nodes; ny_n++)
+            {
+            if (n_nodes % (nx_n*ny_n)) continue;
+            unsigned int nz_n = n_nodes/(nx_n*ny_n);
+
+            double node_area = L.x*L.y*(double)(nz_n-1) + L.x*L.z*(double)(ny_n-1) + L.y*L.z*(double)(nx_n-1);
+
+            for (unsigned int nx_i = 1; nx_i <= n_node_ranks; nx_i++)
+                for (unsigned int ny_i = 1; nx_i*ny_i <= n_node_ranks; ny_i++)
+                    {
+                    if (n_node_ranks % (nx_i*ny_i)) continue;
+                    unsigned int nz_i = n_node_ranks/(nx_i*ny_i);
+
+                    unsigned int nx = nx_n*nx_i;
+                    unsigned int ny = ny_n*ny_i;
+                    unsigned int nz = nz_n*nz_i;
+                    double area = L.x*L.y*(double)(nz-1) + L.x*L.z*(double)(ny-1) + L.y*L.z*(double)(nx-1);
+
+                    if (!found || node_area < min_node_area || (node_area == min_node_area && area < min_area))
+                        {
+                        nx_node = nx_n; ny_node = ny_n; nz_node = nz_n;
+                        nx_intra = nx_i; ny_intra = ny_i; nz_intra = nz_i;
+                        min_node_area = node_area;
+                        min_area = area;
+                        found = true;
+                        }
+                    }
+            }
     }
 
 
@@ -524,6 +560,62 @@ void DomainDecomposition::setCumulativeFractions(unsigned int dir,
         }
     }
 
+/*!
+ * \param cum_frac_x Vector of cumulative fractions along x, beginning with 0 and ending with 1
+ * \param cum_frac_y Vector of cumulative fractions along y, beginning with 0 and ending with 1
+ * \param cum_frac_z Vector of cumulative fractions along z, beginning with 0 and ending with 1
+ * \param root Rank to broadcast the set fractions from
+ *
+ * The fractions of all dimensions are packed behind a flag that they match the topology, so that a single broadcast
+ * synchronizes the decomposition.
+ *
+ * \note Setting the cumulative fractions is a collective call requiring all ranks to participate in order to keep the
+ *       decomposition properly synchronized between ranks.
+ */
+void DomainDecomposition::setCumulativeFractions(const std::vector<Scalar>& cum_frac_x,
+                                                 const std::vector<Scalar>& cum_frac_y,
+                                                 const std::vector<Scalar>& cum_frac_z,
+                                                 unsigned int root)
+    {
+    std::vector<Scalar> buf(m_nx + m_ny + m_nz + 4, Scalar(0.0));
+    if (m_exec_conf->getRank() == root)
+        {
+        if (cum_frac_x.size() == m_cum_frac_x.size() && cum_frac_y.size() == m_cum_frac_y.size()
+            && cum_frac_z.size() == m_cum_frac_z.size())
+            {
+            buf[0] = Scalar(1.0);
+            std::copy(cum_frac_x.begin(), cum_frac_x.end(), buf.begin() + 1);
+            std::copy(cum_frac_y.begin(), cum_frac_y.end(), buf.begin() + 1 + (m_nx+1));
+            std::copy(cum_frac_z.begin(), cum_frac_z.end(), buf.begin() + 1 + (m_nx+1) + (m_ny+1));
+            }
+        }
+
+    // sync the update from the root to all ranks
+    MPI_Bcast(&buf[0], (int)buf.size(), MPI_HOOMD_SCALAR, root, m_mpi_comm);
+
+    // if no change, it's because things don't match up
+    if (buf[0] == Scalar(0.0))
+        {
+        m_exec_conf->msg->error() << "comm: domain decomposition cannot change topology after construction" << std::endl;
+        throw std::runtime_error("comm: domain decomposition cannot change topology after construction");
+        }
+
+    std::vector<Scalar>::const_iterator it = buf.begin() + 1;
+    m_cum_frac_x.assign(it, it + (m_nx+1));
+    it += m_nx+1;
+    m_cum_frac_y.assign(it, it + (m_ny+1));
+    it += m_ny+1;
+    m_cum_frac_z.assign(it, it + (m_nz+1));
+
+    if (m_cum_frac_x.front() != Scalar(0.0) || m_cum_frac_x.back() != Scalar(1.0)
+        || m_cum_frac_y.front() != Scalar(0.0) || m_cum_frac_y.back() != Scalar(1.0)
+        || m_cum_frac_z.front() != Scalar(0.0) || m_cum_frac_z.back() != Scalar(1.0))
+        {
+        m_exec_conf->msg->error() << "comm: specified fractions are invalid" << std::endl;
+        throw std::runtime_error("comm: specified fractions are invalid");
+        }
+    }
+
 /*!
  * \param global_box The global simulation box
  * \returns The local simulation box for the current rank
@@ -678,6 +770,11 @@ void export_DomainDecomposition(py::module& m)
               const std::vector<Scalar>&,
               const std::vector<Scalar>&>())
     .def("getCumulativeFractions", &DomainDecomposition::getCumulativeFractions)
+    .def("setCumulativeFractions",
+         static_cast<void (DomainDecomposition::*)(const std::vector<Scalar>&,
+                                                   const std::vector<Scalar>&,
+                                                   const std::vector<Scalar>&,
+                                                   unsigned int)>(&DomainDecomposition::setCumulativeFractions))
     ;
     }
 #endif // ENABLE_MPI
@@ -56,7 +56,7 @@ class PYBIND11_EXPORT DomainDecomposition
          * \param nx Requested number of domains along the x direction (0 == choose default)
          * \param ny Requested number of domains along the y direction (0 == choose default)
          * \param nz Requested number of domains along the z direction (0 == choose default)
-         * \param twolevel If true, attempt two level decomposition (default == false)
+         * \param twolevel If true, map the grid onto the nodes with a two level decomposition (default == false)
          */
         DomainDecomposition(std::shared_ptr<ExecutionConfiguration> exec_conf,
                        Scalar3 L,
@@ -152,6 +152,12 @@ class PYBIND11_EXPORT DomainDecomposition
         //! Collectively set the cumulative fractions along a dimension from a given rank
         void setCumulativeFractions(unsigned int dir, const std::vector<Scalar>& cum_frac, unsigned int root);
 
+        //! Collectively set the cumulative fractions along all dimensions from a given rank
+        void setCumulativeFractions(const std::vector<Scalar>& cum_frac_x,
+                                    const std::vector<Scalar>& cum_frac_y,
+                                    const std::vector<Scalar>& cum_frac_z,
+                                    unsigned int root);
+
         //! Get the dimensions of the local simulation box
         const BoxDim calculateLocalBox(const BoxDim& global_box);
 
@@ -182,9 +188,9 @@ class PYBIND11_EXPORT DomainDecomposition
         bool findDecomposition(unsigned int nranks, Scalar3 L,
             unsigned int& nx, unsigned int& ny, unsigned int& nz);
 
-        //! Find a two-level decomposition of the global grid
-        void subdivide(unsigned int n_node_ranks, Scalar3 L,
-            unsigned int nx, unsigned int ny, unsigned int nz,
+        //! Find a two-level decomposition that minimizes the area between nodes
+        void findTwoLevelDecomposition(unsigned int n_nodes, unsigned int n_node_ranks, Scalar3 L,
+            unsigned int& nx_node, unsigned int& ny_node, unsigned int& nz_node,
             unsigned int& nx_intra, unsigned int &ny_intra, unsigned int& nz_intra);
 
         //! Helper method to group ranks by nodes
@@ -29,6 +29,7 @@ using namespace std;
 
 #if defined(ENABLE_HIP)
 #include "CachedAllocator.h"
+#include "ManagedMemoryPool.h"
 #endif
 
 /*! \file ExecutionConfiguration.cc
@@ -54,7 +55,9 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
                                                std::shared_ptr<MPIConfiguration> mpi_config,
                                                std::shared_ptr<Messenger> _msg
                                                )
-    : msg(_msg), m_hip_error_checking(false), m_mpi_config(mpi_config)
+    : msg(_msg), m_hip_error_checking(false), m_mpi_device_direct(false), m_deterministic_reductions(false),
+      m_host_huge_pages(false), m_host_numa_interleave(false), m_mpi_config(mpi_config), m_transferred_bytes(0),
+      m_autotuner_database(new AutotunerDatabase())
     {
     if (! m_mpi_config)
         {
@@ -97,6 +100,7 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
     #else
     m_concurrent = false;
     #endif
+    m_peer_access = false;
 
     m_in_multigpu_block = false;
 
@@ -137,6 +141,7 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
 
     exec_mode = CPU;
     m_concurrent = false;
+    m_peer_access = false;
 #endif
 
     setupStats();
@@ -171,6 +176,8 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
                     msg->warning() << "Continuing anyways, but autotuner may not work correctly and simulation may crash." << endl;
                     }
                 }
+
+            enablePeerAccess();
             }
 
         // select first device by default
@@ -182,6 +189,14 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
         // initialize cached allocator, max allocation 0.5*global mem
         m_cached_alloc.reset(new CachedAllocator(false, (unsigned int)(0.5f*(float)dev_prop.totalGlobalMem)));
         m_cached_alloc_managed.reset(new CachedAllocator(true, (unsigned int)(0.5f*(float)dev_prop.totalGlobalMem)));
+
+        // keep up to 1/8 of the global memory in freed GlobalArray blocks
+        m_managed_pool.reset(new ManagedMemoryPool(dev_prop.totalGlobalMem/8));
+
+        #ifdef ENABLE_MPI_CUDA
+        // builds against a CUDA-aware MPI pass device buffers to MPI by default
+        m_mpi_device_direct = true;
+        #endif
         }
     #endif
 
@@ -241,9 +256,17 @@ ExecutionConfiguration::~ExecutionConfiguration()
     #endif
 
     #if defined(ENABLE_HIP)
+    if (m_managed_pool && m_memory_traceback)
+        {
+        const ManagedMemoryPool::Statistics& stats = m_managed_pool->getStatistics();
+        msg->notice(2) << "GlobalArray memory pool: " << stats.num_hits << " allocations reused a cached block, "
+                       << stats.num_misses << " called hipMallocManaged" << endl;
+        }
+
     // the destructors of these objects can issue hip calls, so free them before the device reset
     m_cached_alloc.reset();
     m_cached_alloc_managed.reset();
+    m_managed_pool.reset();
     #endif
     }
 
@@ -252,6 +275,30 @@ ExecutionConfiguration::~ExecutionConfiguration()
 /*! \returns Compute capability of the GPU formatted as 210 (for compute 2.1 as an example)
     \note Silently returns 0 if no GPU is being used
 */
+/*! \param mpi_device_direct True to pass device buffers to MPI
+
+    Device-direct communication requires a GPU execution configuration and a build against a CUDA-aware MPI
+    (ENABLE_MPI_CUDA). Otherwise the communicator stages all buffers on the host.
+*/
+void ExecutionConfiguration::setMPIDeviceDirect(bool mpi_device_direct)
+    {
+    #ifdef ENABLE_MPI_CUDA
+    if (mpi_device_direct && exec_mode != GPU)
+        {
+        msg->error() << "Device-direct MPI requires a GPU device" << endl;
+        throw runtime_error("Error setting MPI device direct mode");
+        }
+    #else
+    if (mpi_device_direct)
+        {
+        msg->error() << "This build of HOOMD does not support device-direct MPI (ENABLE_MPI_CUDA is off)" << endl;
+        throw runtime_error("Error setting MPI device direct mode");
+        }
+    #endif
+
+    m_mpi_device_direct = mpi_device_direct;
+    }
+
 unsigned int ExecutionConfiguration::getComputeCapability(unsigned int idev) const
     {
     unsigned int result = 0;
@@ -427,6 +474,55 @@ void ExecutionConfiguration::scanGPUs()
         }
     }
 
+/*! Kernels on one GPU read the particle data that the other GPUs own, for example the neighbors of a particle near
+    the edge of its range. With peer access, these reads of managed memory go directly over NVLink or PCIe instead of
+    through host memory.
+*/
+void ExecutionConfiguration::enablePeerAccess()
+    {
+    m_peer_access = true;
+
+    for (unsigned int idev = 0; idev < m_gpu_id.size(); ++idev)
+        {
+        hipSetDevice(m_gpu_id[idev]);
+        for (unsigned int jdev = 0; jdev < m_gpu_id.size(); ++jdev)
+            {
+            if (idev == jdev)
+                continue;
+
+            int can_access = 0;
+            hipDeviceCanAccessPeer(&can_access, m_gpu_id[idev], m_gpu_id[jdev]);
+            if (!can_access)
+                {
+                m_peer_access = false;
+                continue;
+                }
+
+            hipError_t error = hipDeviceEnablePeerAccess(m_gpu_id[jdev], 0);
+            if (error == hipErrorPeerAccessAlreadyEnabled)
+                {
+                // clear the error, access is already enabled in this context
+                hipGetLastError();
+                }
+            else if (error != hipSuccess)
+                {
+                hipGetLastError();
+                m_peer_access = false;
+                }
+            }
+        }
+
+    if (m_peer_access)
+        {
+        msg->notice(2) << "Enabled peer access between all " << m_gpu_id.size() << " GPUs" << endl;
+        }
+    else
+        {
+        msg->warning() << "Not all pairs of GPUs support peer access, reads of the particle data of other GPUs go "
+                       << "through host memory" << endl;
+        }
+    }
+
 #endif
 
 /*! Print out GPU stats if running on the GPU, otherwise determine and print out the CPU stats
@@ -643,11 +739,21 @@ void export_ExecutionConfiguration(py::module& m)
         .def("isCUDAEnabled", &ExecutionConfiguration::isCUDAEnabled)
         .def("setCUDAErrorChecking", &ExecutionConfiguration::setCUDAErrorChecking)
         .def("isCUDAErrorCheckingEnabled", &ExecutionConfiguration::isCUDAErrorCheckingEnabled)
+        .def("setMPIDeviceDirect", &ExecutionConfiguration::setMPIDeviceDirect)
+        .def("isMPIDeviceDirect", &ExecutionConfiguration::isMPIDeviceDirect)
+        .def("setDeterministicReductions", &ExecutionConfiguration::setDeterministicReductions)
+        .def("isDeterministicReductions", &ExecutionConfiguration::isDeterministicReductions)
         .def("getNumActiveGPUs", &ExecutionConfiguration::getNumActiveGPUs)
+        .def("setHostHugePages", &ExecutionConfiguration::setHostHugePages)
+        .def("getHostHugePages", &ExecutionConfiguration::getHostHugePages)
+        .def("setHostNUMAInterleave", &ExecutionConfiguration::setHostNUMAInterleave)
+        .def("getHostNUMAInterleave", &ExecutionConfiguration::getHostNUMAInterleave)
         .def_readonly("msg", &ExecutionConfiguration::msg)
 #if defined(ENABLE_HIP)
         .def("hipProfileStart", &ExecutionConfiguration::hipProfileStart)
         .def("hipProfileStop", &ExecutionConfiguration::hipProfileStop)
+        .def("getGPUMemoryUsed", &ExecutionConfiguration::getGPUMemoryUsed)
+        .def("getComputeCapability", &ExecutionConfiguration::getComputeCapability)
 #endif
         .def("getPartition", &ExecutionConfiguration::getPartition)
         .def("getNRanks", &ExecutionConfiguration::getNRanks)
@@ -659,6 +765,7 @@ void export_ExecutionConfiguration(py::module& m)
         .def("setMemoryTracing", &ExecutionConfiguration::setMemoryTracing)
         .def("getMemoryTracer", &ExecutionConfiguration::getMemoryTracer)
         .def("memoryTracingEnabled", &ExecutionConfiguration::memoryTracingEnabled)
+        .def("getAutotunerDatabase", &ExecutionConfiguration::getAutotunerDatabase)
         .def_static("getCapableDevices", &ExecutionConfiguration::getCapableDevices)
         .def_static("getScanMessages", &ExecutionConfiguration::getScanMessages)
         .def("getActiveDevices", &ExecutionConfiguration::getActiveDevices)
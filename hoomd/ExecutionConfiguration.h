@@ -15,6 +15,7 @@
 
 #include "MPIConfiguration.h"
 
+#include <atomic>
 #include <vector>
 #include <string>
 #include <memory>
@@ -34,6 +35,7 @@
 
 #include "Messenger.h"
 #include "MemoryTraceback.h"
+#include "AutotunerDatabase.h"
 
 /*! \file ExecutionConfiguration.h
     \brief Declares ExecutionConfiguration and related classes
@@ -49,6 +51,7 @@
 #if defined(ENABLE_HIP)
 //! Forward declaration
 class CachedAllocator;
+class ManagedMemoryPool;
 #endif
 
 //! Defines the execution configuration for the simulation
@@ -134,6 +137,70 @@ class PYBIND11_EXPORT ExecutionConfiguration
         m_hip_error_checking = hip_error_checking;
         }
 
+    //! Returns true if MPI calls are passed device pointers
+    bool isMPIDeviceDirect() const
+        {
+        return m_mpi_device_direct;
+        }
+
+    //! Sets whether MPI calls are passed device pointers
+    void setMPIDeviceDirect(bool mpi_device_direct);
+
+    //! Returns true if the GPU kernels accumulate forces in a reproducible order
+    bool isDeterministicReductions() const
+        {
+        return m_deterministic_reductions;
+        }
+
+    //! Sets whether the GPU kernels accumulate forces in a reproducible order
+    /*! Kernels that add to the same element from several threads with floating point atomics then use fixed point
+        accumulators (FixedPointAtomics.cuh) instead, so their results are bitwise identical from run to run.
+    */
+    void setDeterministicReductions(bool deterministic)
+        {
+        m_deterministic_reductions = deterministic;
+        }
+
+    //! Count bytes copied between the host and the device
+    void countTransferredBytes(uint64_t bytes) const
+        {
+        m_transferred_bytes += bytes;
+        }
+
+    //! Get the total number of bytes copied between the host and the device by GPUArray
+    uint64_t getTransferredBytes() const
+        {
+        return m_transferred_bytes;
+        }
+
+    //! Set whether large host arrays of GlobalArray are backed by transparent huge pages
+    /*! Applies to arrays allocated afterwards. See hoomd::detail::host_memory_advise().
+    */
+    void setHostHugePages(bool huge_pages)
+        {
+        m_host_huge_pages = huge_pages;
+        }
+
+    //! Returns true if large host arrays of GlobalArray are backed by transparent huge pages
+    bool getHostHugePages() const
+        {
+        return m_host_huge_pages;
+        }
+
+    //! Set whether the pages of large host arrays of GlobalArray are interleaved over the NUMA nodes
+    /*! Applies to arrays allocated afterwards. When false, pages are placed on the node that first touches them.
+    */
+    void setHostNUMAInterleave(bool numa_interleave)
+        {
+        m_host_numa_interleave = numa_interleave;
+        }
+
+    //! Returns true if the pages of large host arrays of GlobalArray are interleaved over the NUMA nodes
+    bool getHostNUMAInterleave() const
+        {
+        return m_host_numa_interleave;
+        }
+
     //! Get the number of active GPUs
     unsigned int getNumActiveGPUs() const
         {
@@ -151,6 +218,23 @@ class PYBIND11_EXPORT ExecutionConfiguration
         return m_gpu_id;
         }
 
+    //! Get the device memory in use on each active GPU, in bytes
+    /*! The values are the total minus the free memory reported by the driver, so they include allocations of other
+        processes that share the GPU.
+    */
+    std::vector<uint64_t> getGPUMemoryUsed() const
+        {
+        std::vector<uint64_t> used(m_gpu_id.size());
+        for (int idev = (unsigned int)(m_gpu_id.size()-1); idev >= 0; idev--)
+            {
+            hipSetDevice(m_gpu_id[idev]);
+            size_t free_bytes = 0, total_bytes = 0;
+            hipMemGetInfo(&free_bytes, &total_bytes);
+            used[idev] = total_bytes - free_bytes;
+            }
+        return used;
+        }
+
     void hipProfileStart() const
         {
         for (int idev = (unsigned int)(m_gpu_id.size()-1); idev >= 0; idev--)
@@ -204,6 +288,12 @@ class PYBIND11_EXPORT ExecutionConfiguration
         return m_concurrent;
         }
 
+    //! Get whether every pair of active GPUs has peer access enabled
+    bool allPeerAccess() const
+        {
+        return m_peer_access;
+        }
+
 #ifdef ENABLE_HIP
     hipDeviceProp_t dev_prop;              //!< Cached device properties of the first GPU
 
@@ -288,6 +378,12 @@ class PYBIND11_EXPORT ExecutionConfiguration
         {
         return *m_cached_alloc_managed;
         }
+
+    //! Returns the pool of managed memory blocks for GlobalArray allocations
+    ManagedMemoryPool& getManagedMemoryPool() const
+        {
+        return *m_managed_pool;
+        }
     #endif
 
     //! Set up memory tracing
@@ -310,6 +406,12 @@ class PYBIND11_EXPORT ExecutionConfiguration
         return m_memory_traceback.get() != nullptr;
         }
 
+    //! Returns the database of tuned kernel parameters shared by all Autotuners
+    std::shared_ptr<AutotunerDatabase> getAutotunerDatabase() const
+        {
+        return m_autotuner_database;
+        }
+
     //! Returns true if we are in a multi-GPU block
     bool inMultiGPUBlock() const
         {
@@ -335,7 +437,7 @@ class PYBIND11_EXPORT ExecutionConfiguration
         }
 
     /// Get the active devices
-    std::vector<std::string> getActiveDevices()
+    std::vector<std::string> getActiveDevices() const
         {
         return m_active_device_descriptions;
         }
@@ -351,6 +453,9 @@ private:
     //! Initialize the GPU with the given id (where gpu_id is an index into s_capable_gpu_ids)
     void initializeGPU(int gpu_id);
 
+    //! Enable peer access between all pairs of active GPUs
+    void enablePeerAccess();
+
     /// Provide a string that describes a GPU device
     static std::string describeGPU(int id, hipDeviceProp_t prop);
 
@@ -378,6 +483,18 @@ private:
     /// True when GPU error checking is enabled
     bool m_hip_error_checking;
 
+    /// True when communication buffers are passed to MPI on the device
+    bool m_mpi_device_direct;
+
+    /// True when the GPU kernels use order independent accumulation
+    bool m_deterministic_reductions;
+
+    /// True when large host arrays are backed by transparent huge pages
+    bool m_host_huge_pages;
+
+    /// True when the pages of large host arrays are interleaved over the NUMA nodes
+    bool m_host_numa_interleave;
+
     /// The MPI configuration
     std::shared_ptr<MPIConfiguration> m_mpi_config;
 
@@ -397,12 +514,16 @@ private:
     std::vector<std::string> m_active_device_descriptions;
 
     bool m_concurrent;                      //!< True if all GPUs have concurrentManagedAccess flag
+    bool m_peer_access;                     //!< True if all pairs of active GPUs have peer access enabled
 
     mutable bool m_in_multigpu_block;       //!< Tracks whether we are in a multi-GPU block
 
+    mutable std::atomic<uint64_t> m_transferred_bytes; //!< Bytes copied between the host and the device
+
     #if defined(ENABLE_HIP)
     std::unique_ptr<CachedAllocator> m_cached_alloc;       //!< Cached allocator for temporary allocations
     std::unique_ptr<CachedAllocator> m_cached_alloc_managed; //!< Cached allocator for temporary allocations in managed memory
+    std::unique_ptr<ManagedMemoryPool> m_managed_pool;     //!< Pool of managed memory blocks for GlobalArray
     #endif
 
     #ifdef ENABLE_TBB
@@ -414,6 +535,7 @@ private:
     void setupStats();
 
     std::unique_ptr<MemoryTraceback> m_memory_traceback;    //!< Keeps track of allocations
+    std::shared_ptr<AutotunerDatabase> m_autotuner_database; //!< Tuned kernel parameters of all Autotuners
     };
 
 
@@ -0,0 +1,399 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "Expression.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace
+    {
+    /// A named function of one argument
+    struct Function1
+        {
+        const char *name;
+        double (*f)(double);
+        };
+
+    /// A named function of two arguments
+    struct Function2
+        {
+        const char *name;
+        double (*f)(double, double);
+        };
+
+    const Function1 functions1[] = {
+        {"sin", [](double x) { return std::sin(x); }},
+        {"cos", [](double x) { return std::cos(x); }},
+        {"tan", [](double x) { return std::tan(x); }},
+        {"exp", [](double x) { return std::exp(x); }},
+        {"log", [](double x) { return std::log(x); }},
+        {"sqrt", [](double x) { return std::sqrt(x); }},
+        {"abs", [](double x) { return std::fabs(x); }},
+        {"floor", [](double x) { return std::floor(x); }},
+        {"ceil", [](double x) { return std::ceil(x); }},
+        };
+
+    const Function2 functions2[] = {
+        {"min", [](double a, double b) { return std::min(a, b); }},
+        {"max", [](double a, double b) { return std::max(a, b); }},
+        {"pow", [](double a, double b) { return std::pow(a, b); }},
+        };
+    }
+
+Expression::Expression(const std::string& source)
+    : m_source(source), m_pos(0), m_depth(0), m_max_depth(0)
+    {
+    parseOr();
+    while (m_pos < m_source.size() && std::isspace((unsigned char)m_source[m_pos]))
+        m_pos++;
+    if (m_pos != m_source.size())
+        fail("unexpected input");
+
+    m_stack.resize(m_max_depth);
+    }
+
+double Expression::operator()(double t) const
+    {
+    double *top = m_stack.data() - 1;
+    for (const Instruction& instruction : m_program)
+        {
+        switch (instruction.op)
+            {
+            case Op::constant:
+                *(++top) = instruction.value;
+                break;
+            case Op::timestep:
+                *(++top) = t;
+                break;
+            case Op::neg:
+                *top = -*top;
+                break;
+            case Op::logical_not:
+                *top = *top == 0.0 ? 1.0 : 0.0;
+                break;
+            case Op::call1:
+                *top = instruction.f1(*top);
+                break;
+            case Op::clip:
+                top -= 2;
+                *top = std::min(std::max(top[0], top[1]), top[2]);
+                break;
+            default:
+                {
+                // binary operations
+                top--;
+                double a = top[0];
+                double b = top[1];
+                double r = 0.0;
+                switch (instruction.op)
+                    {
+                    case Op::add: r = a + b; break;
+                    case Op::sub: r = a - b; break;
+                    case Op::mul: r = a * b; break;
+                    case Op::div: r = a / b; break;
+                    case Op::mod: r = a - b * std::floor(a / b); break;
+                    case Op::pow: r = std::pow(a, b); break;
+                    case Op::lt: r = a < b; break;
+                    case Op::le: r = a <= b; break;
+                    case Op::gt: r = a > b; break;
+                    case Op::ge: r = a >= b; break;
+                    case Op::eq: r = a == b; break;
+                    case Op::ne: r = a != b; break;
+                    case Op::logical_and: r = (a != 0.0 && b != 0.0); break;
+                    case Op::logical_or: r = (a != 0.0 || b != 0.0); break;
+                    case Op::call2: r = instruction.f2(a, b); break;
+                    default: break;
+                    }
+                *top = r;
+                }
+            }
+        }
+    return *top;
+    }
+
+void Expression::emit(Op op, double value, double (*f1)(double), double (*f2)(double, double))
+    {
+    Instruction instruction;
+    instruction.op = op;
+    instruction.value = value;
+    instruction.f1 = f1;
+    instruction.f2 = f2;
+    m_program.push_back(instruction);
+
+    if (op == Op::constant || op == Op::timestep)
+        m_depth++;
+    else if (op == Op::clip)
+        m_depth -= 2;
+    else if (op != Op::neg && op != Op::logical_not && op != Op::call1)
+        m_depth--;
+    m_max_depth = std::max(m_max_depth, m_depth);
+    }
+
+void Expression::parseOr()
+    {
+    parseAnd();
+    while (acceptWord("or"))
+        {
+        parseAnd();
+        emit(Op::logical_or);
+        }
+    }
+
+void Expression::parseAnd()
+    {
+    parseNot();
+    while (acceptWord("and"))
+        {
+        parseNot();
+        emit(Op::logical_and);
+        }
+    }
+
+void Expression::parseNot()
+    {
+    if (acceptWord("not"))
+        {
+        parseNot();
+        emit(Op::logical_not);
+        }
+    else
+        {
+        parseComparison();
+        }
+    }
+
+void Expression::parseComparison()
+    {
+    parseSum();
+    while (true)
+        {
+        // test the two character operators first
+        Op op;
+        if (accept("<="))
+            op = Op::le;
+        else if (accept(">="))
+            op = Op::ge;
+        else if (accept("=="))
+            op = Op::eq;
+        else if (accept("!="))
+            op = Op::ne;
+        else if (accept("<"))
+            op = Op::lt;
+        else if (accept(">"))
+            op = Op::gt;
+        else
+            return;
+
+        parseSum();
+        emit(op);
+        }
+    }
+
+void Expression::parseSum()
+    {
+    parseProduct();
+    while (true)
+        {
+        if (accept("+"))
+            {
+            parseProduct();
+            emit(Op::add);
+            }
+        else if (accept("-"))
+            {
+            parseProduct();
+            emit(Op::sub);
+            }
+        else
+            {
+            return;
+            }
+        }
+    }
+
+void Expression::parseProduct()
+    {
+    parseUnary();
+    while (true)
+        {
+        if (accept("*"))
+            {
+            parseUnary();
+            emit(Op::mul);
+            }
+        else if (accept("/"))
+            {
+            parseUnary();
+            emit(Op::div);
+            }
+        else if (accept("%"))
+            {
+            parseUnary();
+            emit(Op::mod);
+            }
+        else
+            {
+            return;
+            }
+        }
+    }
+
+void Expression::parseUnary()
+    {
+    if (accept("-"))
+        {
+        parseUnary();
+        emit(Op::neg);
+        }
+    else if (accept("+"))
+        {
+        parseUnary();
+        }
+    else
+        {
+        parsePower();
+        }
+    }
+
+void Expression::parsePower()
+    {
+    parseAtom();
+    if (accept("**"))
+        {
+        // right associative, and binds tighter than a unary minus on its left only
+        parseUnary();
+        emit(Op::pow);
+        }
+    }
+
+void Expression::parseAtom()
+    {
+    while (m_pos < m_source.size() && std::isspace((unsigned char)m_source[m_pos]))
+        m_pos++;
+    if (m_pos == m_source.size())
+        fail("unexpected end of expression");
+
+    char c = m_source[m_pos];
+    if (std::isdigit((unsigned char)c) || c == '.')
+        {
+        const char *start = m_source.c_str() + m_pos;
+        char *end = nullptr;
+        double value = std::strtod(start, &end);
+        if (end == start)
+            fail("invalid number");
+        m_pos += end - start;
+        emit(Op::constant, value);
+        }
+    else if (std::isalpha((unsigned char)c) || c == '_')
+        {
+        size_t start = m_pos;
+        while (m_pos < m_source.size() && (std::isalnum((unsigned char)m_source[m_pos]) || m_source[m_pos] == '_'))
+            m_pos++;
+        std::string name = m_source.substr(start, m_pos - start);
+
+        if (name == "t")
+            {
+            emit(Op::timestep);
+            return;
+            }
+        if (name == "pi")
+            {
+            emit(Op::constant, 3.14159265358979323846);
+            return;
+            }
+
+        for (const Function1& function : functions1)
+            {
+            if (name == function.name)
+                {
+                expect("(");
+                parseOr();
+                expect(")");
+                emit(Op::call1, 0, function.f);
+                return;
+                }
+            }
+
+        for (const Function2& function : functions2)
+            {
+            if (name == function.name)
+                {
+                expect("(");
+                parseOr();
+                expect(",");
+                parseOr();
+                expect(")");
+                emit(Op::call2, 0, nullptr, function.f);
+                return;
+                }
+            }
+
+        if (name == "clip")
+            {
+            expect("(");
+            parseOr();
+            expect(",");
+            parseOr();
+            expect(",");
+            parseOr();
+            expect(")");
+            emit(Op::clip);
+            return;
+            }
+
+        m_pos = start;
+        fail("unknown name " + name);
+        }
+    else if (accept("("))
+        {
+        parseOr();
+        expect(")");
+        }
+    else
+        {
+        fail("unexpected character");
+        }
+    }
+
+bool Expression::accept(const std::string& token)
+    {
+    while (m_pos < m_source.size() && std::isspace((unsigned char)m_source[m_pos]))
+        m_pos++;
+    if (m_source.compare(m_pos, token.size(), token) == 0)
+        {
+        m_pos += token.size();
+        return true;
+        }
+    return false;
+    }
+
+bool Expression::acceptWord(const std::string& word)
+    {
+    size_t pos = m_pos;
+    if (!accept(word))
+        return false;
+
+    // the keyword must not be the start of a longer name
+    if (m_pos < m_source.size() && (std::isalnum((unsigned char)m_source[m_pos]) || m_source[m_pos] == '_'))
+        {
+        m_pos = pos;
+        return false;
+        }
+    return true;
+    }
+
+void Expression::expect(const std::string& token)
+    {
+    if (!accept(token))
+        fail("expected " + token);
+    }
+
+void Expression::fail(const std::string& message) const
+    {
+    throw std::invalid_argument("Error parsing expression '" + m_source + "' at position "
+                                + std::to_string(m_pos) + ": " + message);
+    }
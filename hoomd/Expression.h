@@ -0,0 +1,96 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+
+/** Arithmetic expression of the time step
+
+    Expression compiles a formula in the time step `t` into a program for a small stack machine, so that variants and
+    triggers defined by a formula evaluate in C++ without calls to Python. The syntax follows Python:
+
+    - numbers, `t`, `pi`, and parentheses
+    - `+`, `-`, `*`, `/`, `%` (floored, as in Python), `**` (right associative), and unary `-`
+    - `<`, `<=`, `>`, `>=`, `==`, `!=`, which evaluate to 1 or 0
+    - `and`, `or`, `not`, which treat nonzero values as true and evaluate to 1 or 0
+    - the functions `sin`, `cos`, `tan`, `exp`, `log`, `sqrt`, `abs`, `floor`, `ceil`, `min(a, b)`, `max(a, b)`,
+      `pow(a, b)`, and `clip(x, lo, hi)`
+
+    The constructor throws std::invalid_argument with the position of the first syntax error.
+*/
+class PYBIND11_EXPORT Expression
+    {
+    public:
+        /** Compile an expression
+
+            @param source The formula
+        */
+        explicit Expression(const std::string& source);
+
+        /// Evaluate the expression at time step *t*
+        double operator()(double t) const;
+
+        /// Get the formula
+        const std::string& getSource() const
+            {
+            return m_source;
+            }
+
+    private:
+        /// Stack machine operations
+        enum class Op : unsigned char
+            {
+            constant,
+            timestep,
+            add, sub, mul, div, mod, pow, neg,
+            lt, le, gt, ge, eq, ne,
+            logical_and, logical_or, logical_not,
+            call1, call2, clip
+            };
+
+        /// One instruction of the program
+        struct Instruction
+            {
+            Op op;                          //!< Operation
+            double value;                   //!< Value of constants
+            double (*f1)(double);           //!< Function of call1
+            double (*f2)(double, double);   //!< Function of call2
+            };
+
+        std::string m_source;                   //!< The formula
+        std::vector<Instruction> m_program;     //!< Compiled program in postfix order
+        mutable std::vector<double> m_stack;    //!< Evaluation stack, sized for the deepest point of the program
+
+        size_t m_pos;       //!< Parser position in m_source
+        int m_depth;        //!< Stack depth after the last emitted instruction
+        int m_max_depth;    //!< Deepest stack of the program
+
+        /// Append an instruction and track the stack depth
+        void emit(Op op, double value=0, double (*f1)(double)=nullptr, double (*f2)(double, double)=nullptr);
+
+        void parseOr();
+        void parseAnd();
+        void parseNot();
+        void parseComparison();
+        void parseSum();
+        void parseProduct();
+        void parseUnary();
+        void parsePower();
+        void parseAtom();
+
+        /// Skip white space and test whether the input continues with *token*, consume it if so
+        bool accept(const std::string& token);
+
+        /// Skip white space and test whether the input continues with the keyword *word*, consume it if so
+        bool acceptWord(const std::string& word);
+
+        /// Consume *token* or throw
+        void expect(const std::string& token);
+
+        /// Throw a syntax error at the current position
+        [[noreturn]] void fail(const std::string& message) const;
+    };
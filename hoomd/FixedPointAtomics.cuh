@@ -0,0 +1,55 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*!
+ * \file FixedPointAtomics.cuh
+ * \brief Order independent atomic accumulation for deterministic GPU reductions.
+ */
+
+#ifndef HOOMD_FIXED_POINT_ATOMICS_CUH_
+#define HOOMD_FIXED_POINT_ATOMICS_CUH_
+
+#include "hoomd/HOOMDMath.h"
+
+#define DEVICE __device__ __forceinline__
+
+namespace hoomd
+{
+namespace detail
+{
+
+//! Scale factor of the fixed point representation
+/*!
+ * Values are stored as 64-bit integers in units of 2^-32: the resolution is 2.3e-10 and the magnitude of a sum must be
+ * below 2^31 (2.1e9).
+ */
+const double fixed_point_scale = 4294967296.0;
+
+#ifdef __HIPCC__
+//! Atomically add a value to a fixed point accumulator
+/*!
+ * \param address Address of the accumulator
+ * \param val Value to add
+ *
+ * Integer addition is associative, so the accumulated sum does not depend on the order in which the threads add to it,
+ * unlike atomicAdd() on floating point numbers. The accumulator may be in shared or global memory and must be set to
+ * zero before the first addition.
+ */
+DEVICE void atomicAddFixedPoint(unsigned long long int *address, Scalar val)
+    {
+    atomicAdd(address, (unsigned long long int)__double2ll_rn((double)val * fixed_point_scale));
+    }
+
+//! Convert a fixed point accumulator to a floating point number
+DEVICE Scalar fixedPointToScalar(unsigned long long int val)
+    {
+    return Scalar((double)(long long int)val / fixed_point_scale);
+    }
+#endif
+
+} // end namespace detail
+} // end namespace hoomd
+
+#undef DEVICE
+
+#endif // HOOMD_FIXED_POINT_ATOMICS_CUH_
@@ -29,7 +29,8 @@ namespace py = pybind11;
     \post All forces are initialized to 0
 */
 ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef)
-     : Compute(sysdef), m_particles_sorted(false)
+     : Compute(sysdef), m_particles_sorted(false), m_interior_computed(false), m_respa_period(1),
+       m_energy_sum_valid(false), m_energy_sum(0)
     {
     assert(m_pdata);
     assert(m_pdata->getMaxN() > 0);
@@ -96,6 +97,7 @@ ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef)
  */
 void ForceCompute::reallocate()
     {
+    m_energy_sum_valid = false;
     m_force.resize(m_pdata->getMaxN());
     m_virial.resize(m_pdata->getMaxN(),6);
     m_torque.resize(m_pdata->getMaxN());
@@ -168,9 +170,15 @@ ForceCompute::~ForceCompute()
     }
 
 /*! Sums the total potential energy calculated by the last call to compute() and returns it.
+
+    The sum and its MPI reduction are cached until the forces are computed again, so that several loggers and
+    computes reading the energy of the same step sum it only once.
 */
 Scalar ForceCompute::calcEnergySum()
     {
+    if (m_energy_sum_valid)
+        return m_energy_sum;
+
     ArrayHandle<Scalar4> h_force(m_force,access_location::host,access_mode::read);
     // always perform the sum in double precision for better accuracy
     // this is cheating and is really just a temporary hack to get logging up and running
@@ -188,7 +196,9 @@ Scalar ForceCompute::calcEnergySum()
         MPI_Allreduce(MPI_IN_PLACE, &pe_total, 1, MPI_DOUBLE, MPI_SUM, m_exec_conf->getMPICommunicator());
         }
 #endif
-    return Scalar(pe_total);
+    m_energy_sum = Scalar(pe_total);
+    m_energy_sum_valid = true;
+    return m_energy_sum;
     }
 
 /*! Sums the potential energy of a particle group calculated by the last call to compute() and returns it.
@@ -465,13 +475,35 @@ void ForceCompute::compute(unsigned int timestep)
         shouldCompute(timestep) ||
         m_pdata->getFlags() != m_computed_flags)
         {
-        computeForces(timestep);
+        m_energy_sum_valid = false;
+        if (m_interior_computed)
+            computeBoundaryForces(timestep);
+        else
+            computeForces(timestep);
         }
 
+    m_interior_computed = false;
     m_particles_sorted = false;
     m_computed_flags = m_pdata->getFlags();
     }
 
+/*! \param timestep Current Timestep
+
+    Uses the same criteria as compute() to test if the forces need to be computed, without consuming the time step.
+    The next call to compute() completes the forces.
+*/
+void ForceCompute::computeInterior(unsigned int timestep)
+    {
+    m_interior_computed = false;
+    if (m_particles_sorted ||
+        peekCompute(timestep) ||
+        m_pdata->getFlags() != m_computed_flags)
+        {
+        m_energy_sum_valid = false;
+        m_interior_computed = computeInteriorForces(timestep);
+        }
+    }
+
 /*! \param num_iters Number of iterations to average for the benchmark
     \returns Milliseconds of execution time per calculation
 
@@ -481,6 +513,8 @@ void ForceCompute::compute(unsigned int timestep)
 double ForceCompute::benchmark(unsigned int num_iters)
     {
     ClockSource t;
+    m_energy_sum_valid = false;
+
     // warm up run
     computeForces(0);
 
@@ -613,5 +647,6 @@ void export_ForceCompute(py::module& m)
     .def("getForces", &ForceCompute::getForcesPython)
     .def("getTorques", &ForceCompute::getTorquesPython)
     .def("getVirials", &ForceCompute::getVirialsPython)
+    .def_property("respa_period", &ForceCompute::getRESPAPeriod, &ForceCompute::setRESPAPeriod)
     ;
     }
@@ -7,6 +7,7 @@
 #include "Compute.h"
 #include "Index1D.h"
 #include "ParticleGroup.h"
+#include "PythonLocalDataAccess.h"
 
 #include "GlobalArray.h"
 #include "GlobalArray.h"
@@ -20,6 +21,7 @@
 #endif
 
 #include <memory>
+#include <stdexcept>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 
 /*! \file ForceCompute.h
@@ -75,6 +77,13 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         //! Computes the forces
         virtual void compute(unsigned int timestep);
 
+        //! Compute the forces that do not depend on ghost particles
+        /*! This method is called in MPI simulations while a ghost update is in flight. Forces that split their
+            work compute the part that only involves local particles here, and compute() adds the rest after the
+            ghost update is complete.
+        */
+        void computeInterior(unsigned int timestep);
+
         //! Benchmark the force compute
         virtual double benchmark(unsigned int num_iters);
 
@@ -144,6 +153,48 @@ class PYBIND11_EXPORT ForceCompute : public Compute
             return m_torque;
             }
 
+        //! Get the array of computed forces (read only access to the handle)
+        const GlobalArray<Scalar4>& getForceArray() const
+            {
+            return m_force;
+            }
+
+        //! Get the array of computed virials (read only access to the handle)
+        const GlobalArray<Scalar>& getVirialArray() const
+            {
+            return m_virial;
+            }
+
+        //! Get the array of computed torques (read only access to the handle)
+        const GlobalArray<Scalar4>& getTorqueArray() const
+            {
+            return m_torque;
+            }
+
+        //! Get the number of local particles (used by LocalForceComputeData)
+        unsigned int getN() const
+            {
+            return m_pdata->getN();
+            }
+
+        //! Get the number of ghost particles (used by LocalForceComputeData)
+        unsigned int getNGhosts() const
+            {
+            return m_pdata->getNGhosts();
+            }
+
+        //! Get the number of particles in the whole system (used by LocalForceComputeData)
+        unsigned int getNGlobal() const
+            {
+            return m_pdata->getNGlobal();
+            }
+
+        //! Get the execution configuration (used by LocalForceComputeData)
+        std::shared_ptr<const ExecutionConfiguration> getExecConf() const
+            {
+            return m_exec_conf;
+            }
+
         //! Get the contribution to the external virial
         Scalar getExternalVirial(unsigned int dir)
             {
@@ -176,6 +227,25 @@ class PYBIND11_EXPORT ForceCompute : public Compute
             return false;
             }
 
+        //! Set the number of time steps between evaluations in multiple time step integration
+        /*! \param period Evaluate the force on time steps that are a multiple of \a period
+
+            The integrator applies the force as an impulse, \a period times the force, on the time steps it is
+            evaluated (see Integrator::computeNetForce()).
+        */
+        void setRESPAPeriod(unsigned int period)
+            {
+            if (period == 0)
+                throw std::domain_error("respa_period must be a positive integer");
+            m_respa_period = period;
+            }
+
+        //! Get the number of time steps between evaluations in multiple time step integration
+        unsigned int getRESPAPeriod()
+            {
+            return m_respa_period;
+            }
+
     protected:
         bool m_particles_sorted;    //!< Flag set to true when particles are resorted in memory
 
@@ -216,17 +286,143 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         /// Store the particle data flags used during the last computation
         PDataFlags m_computed_flags;
 
+        bool m_interior_computed;   //!< True when computeInterior() computed part of the forces of this step
+        unsigned int m_respa_period; //!< Number of time steps between evaluations in multiple time step integration
+        bool m_energy_sum_valid;     //!< True when m_energy_sum holds the sum of the current forces
+        Scalar m_energy_sum;         //!< Total potential energy cached by calcEnergySum()
+
         //! Actually perform the computation of the forces
         /*! This is pure virtual here. Sub-classes must implement this function. It will be called by
             the base class compute() when the forces need to be computed.
             \param timestep Current time step
         */
         virtual void computeForces(unsigned int timestep){}
+
+        //! Compute the forces that involve only local particles
+        /*! Sub-classes that can split their work around a ghost update override this method and
+            computeBoundaryForces(). The ghost particle data must not be accessed, it is being received.
+            \param timestep Current time step
+            \returns true if the forces were computed, false if computeForces() must compute all of them later
+        */
+        virtual bool computeInteriorForces(unsigned int timestep)
+            {
+            return false;
+            }
+
+        //! Add the forces that involve ghost particles to those computed by computeInteriorForces()
+        /*! \param timestep Current time step
+        */
+        virtual void computeBoundaryForces(unsigned int timestep){}
+    };
+
+/// Allow writing the arrays of a ForceCompute from Python.
+/** Uses the LocalDataAccess templated class to expose the force, potential
+ *  energy, torque, and virial arrays of a ForceCompute to Python without
+ *  copies. The arrays of the local particles are writable, the ghost arrays
+ *  are read only. For an explanation of the methods and structure see the
+ *  documentation of LocalDataAccess.
+ *
+ *  Template Parameters
+ *  Output: The buffer output type (either HOOMDHostBuffer or HOOMDDeviceBuffer)
+*/
+template<class Output>
+class PYBIND11_EXPORT LocalForceComputeData :
+        public LocalDataAccess<Output, ForceCompute>
+    {
+    public:
+        LocalForceComputeData(ForceCompute& data)
+          : LocalDataAccess<Output, ForceCompute>(data),
+            m_force_compute(data),
+            m_force_handle(),
+            m_virial_handle(),
+            m_torque_handle()
+            {}
+
+        virtual ~LocalForceComputeData() = default;
+
+        Output getForce(GhostDataFlag flag)
+            {
+            return this->template getBuffer<Scalar4, Scalar>(
+                m_force_handle,
+                &ForceCompute::getForceArray,
+                flag,
+                3
+            );
+            }
+
+        Output getPotentialEnergy(GhostDataFlag flag)
+            {
+            return this->template getBuffer<Scalar4, Scalar>(
+                m_force_handle,
+                &ForceCompute::getForceArray,
+                flag,
+                0,
+                3 * sizeof(Scalar)
+            );
+            }
+
+        Output getTorque(GhostDataFlag flag)
+            {
+            return this->template getBuffer<Scalar4, Scalar>(
+                m_torque_handle,
+                &ForceCompute::getTorqueArray,
+                flag,
+                3
+            );
+            }
+
+        /// The virial is stored as 6 rows of pitch elements, one per component
+        Output getVirial(GhostDataFlag flag)
+            {
+            const ssize_t pitch = m_force_compute.getVirialArray().getPitch();
+            return this->template getBuffer<Scalar, Scalar>(
+                m_virial_handle,
+                &ForceCompute::getVirialArray,
+                flag,
+                6,
+                0,
+                std::vector<ssize_t>({sizeof(Scalar), pitch * sizeof(Scalar)})
+            );
+            }
+
+    protected:
+        void clear()
+            {
+            m_force_handle.reset(nullptr);
+            m_virial_handle.reset(nullptr);
+            m_torque_handle.reset(nullptr);
+            }
+
+    private:
+        ForceCompute& m_force_compute;
+        std::unique_ptr<ArrayHandle<Scalar4> > m_force_handle;
+        std::unique_ptr<ArrayHandle<Scalar> > m_virial_handle;
+        std::unique_ptr<ArrayHandle<Scalar4> > m_torque_handle;
     };
 
 //! Exports the ForceCompute class to python
 #ifndef __HIPCC__
 void export_ForceCompute(pybind11::module& m);
+
+/// Export local access to the arrays of a ForceCompute
+template<class Output>
+void export_LocalForceComputeData(pybind11::module& m, std::string name)
+    {
+    pybind11::class_<LocalForceComputeData<Output>,
+                     std::shared_ptr<LocalForceComputeData<Output> > >(
+        m, name.c_str())
+    .def(pybind11::init<ForceCompute&>())
+    .def("getForce", &LocalForceComputeData<Output>::getForce)
+    .def("getPotentialEnergy",
+         &LocalForceComputeData<Output>::getPotentialEnergy)
+    .def("getTorque", &LocalForceComputeData<Output>::getTorque)
+    .def("getVirial", &LocalForceComputeData<Output>::getVirial)
+    .def("selectRows", &LocalForceComputeData<Output>::selectRows)
+    .def("selectAllRows", &LocalForceComputeData<Output>::selectAllRows)
+    .def("enter", &LocalForceComputeData<Output>::enter)
+    .def("exit", &LocalForceComputeData<Output>::exit)
+    ;
+    }
 #endif
 
 #endif
@@ -18,6 +18,9 @@
 // 4 GB is considered a large allocation for a single GPU buffer, and user should be warned
 #define LARGEALLOCBYTES 0xffffffff
 
+//! Granularity of the host to device copies of ranges written on the host
+#define GPUARRAY_PAGE_BYTES 4096
+
 // for vector types
 #ifdef ENABLE_HIP
 #include <hip/hip_runtime.h>
@@ -258,6 +261,13 @@ class GPUArrayBase
                 );
             }
 
+        //! Acquires the data pointer to access a range of elements
+        inline ArrayHandleDispatch<T> acquireRange(const access_location::Enum location,
+            const access_mode::Enum mode, size_t first, size_t count) const
+            {
+            return static_cast<Derived const&>(*this).acquireRange(location, mode, first, count);
+            }
+
         //! Release the data pointer
         inline void release() const
             {
@@ -336,6 +346,14 @@ class ArrayHandle
         template<class Derived>
         inline ArrayHandle(const GPUArrayBase<T, Derived>& gpu_array, const access_location::Enum location = access_location::host,
                            const access_mode::Enum mode = access_mode::readwrite);
+
+        //! Aquires the data and sets \a data, only elements first to first + count - 1 are valid on the host
+        /*! \tparam Derived the type of GPUArray implementation
+         */
+        template<class Derived>
+        inline ArrayHandle(const GPUArrayBase<T, Derived>& gpu_array, const access_location::Enum location,
+                           const access_mode::Enum mode, size_t first, size_t count);
+
         //! Notifies the containing GPUArray that the handle has been released
         virtual inline ~ArrayHandle() = default;
 
@@ -424,6 +442,15 @@ mode specifies that the data is to be read and written to, necessitating possibl
 before the data can be accessed and again before the next access. If the data is to be completely overwritten
 \b without reading it first, then an expensive memory copy can be avoided by using the \a overwrite mode.
 
+Code that accesses only a few elements on the host can pass the range of elements to the ArrayHandle. When the data
+was last updated on the device, only the pages (GPUARRAY_PAGE_BYTES) that cover the range are copied to the host.
+Pages acquired for writing are recorded as dirty and are copied back to the device before the next acquire, while
+the array otherwise stays valid on the device. Outside of the range, the host data is undefined.
+\code
+ArrayHandle<int> h_handle(gpu_array, access_location::host, access_mode::readwrite, i, 1);
+h_handle.data[i] = 5;
+\endcode
+
 Data with both 1-D and 2-D representations can be allocated by using the appropriate constructor.
 2-D allocated data is still just a flat pointer, but the row width is rounded up to a multiple of
 16 elements to facilitate coalescing. The actual allocated width is accessible with getPitch(). Here
@@ -536,6 +563,10 @@ class GPUArray : public GPUArrayBase<T, GPUArray<T> >
         #endif
                         ) const;
 
+        //! Acquires the data pointer to access a range of elements
+        inline ArrayHandleDispatch<T> acquireRange(const access_location::Enum location,
+            const access_mode::Enum mode, size_t first, size_t count) const;
+
         //! Release the data pointer
         inline void release() const
             {
@@ -566,6 +597,8 @@ class GPUArray : public GPUArrayBase<T, GPUArray<T> >
         mutable data_location::Enum m_data_location;    //!< Tracks the current location of the data
 #ifdef ENABLE_HIP
         bool m_mapped;                          //!< True if we are using mapped memory
+        mutable size_t m_dirty_begin = 0;       //!< First byte of the host pages not yet copied to the device
+        mutable size_t m_dirty_end = 0;         //!< End of the host pages not yet copied to the device
 #endif
 
     // ok, this looks weird, but I want m_exec_conf to be protected and not have to go reorder all of the initializers
@@ -587,6 +620,8 @@ class GPUArray : public GPUArrayBase<T, GPUArray<T> >
         inline void memcpyDeviceToHost(bool async) const;
         //! Helper function to copy memory from the host to device
         inline void memcpyHostToDevice(bool async) const;
+        //! Helper function to copy the dirty host pages to the device
+        inline void flushHostPages() const;
 #endif
 
         //! Helper function to resize host array
@@ -618,6 +653,20 @@ ArrayHandle<T>::ArrayHandle(const GPUArrayBase<T, Derived>& array, const access_
     {
     }
 
+/*! \param gpu_array GPUArray host to the pointer data
+    \param location Desired location to access the data
+    \param mode Mode to access the data with
+    \param first First element to access
+    \param count Number of elements to access
+*/
+template<class T>
+template<class Derived>
+ArrayHandle<T>::ArrayHandle(const GPUArrayBase<T, Derived>& array, const access_location::Enum location,
+                            const access_mode::Enum mode, size_t first, size_t count) :
+        dispatch(array.acquireRange(location, mode, first, count)), data(dispatch.get())
+    {
+    }
+
 #ifdef ENABLE_HIP
 template<class T>
 template<class Derived>
@@ -783,6 +832,10 @@ template<class T> GPUArray<T>& GPUArray<T>::operator=(const GPUArray& rhs) noexc
 #endif
         // initialize state variables
         m_data_location = data_location::host;
+#ifdef ENABLE_HIP
+        m_dirty_begin = 0;
+        m_dirty_end = 0;
+#endif
 
         // copy over the data to the new GPUArray
         if (rhs.h_data)
@@ -816,6 +869,8 @@ template<class T> GPUArray<T>::GPUArray(GPUArray&& from) noexcept
     m_data_location(std::move(from.m_data_location)),
 #ifdef ENABLE_HIP
     m_mapped(std::move(from.m_mapped)),
+    m_dirty_begin(std::move(from.m_dirty_begin)),
+    m_dirty_end(std::move(from.m_dirty_end)),
     d_data(std::move(from.d_data)),
 #endif
     h_data(std::move(from.h_data)),
@@ -833,6 +888,8 @@ template<class T> GPUArray<T>& GPUArray<T>::operator=(GPUArray&& rhs) noexcept
         m_exec_conf = std::move(rhs.m_exec_conf);
     #ifdef ENABLE_HIP
         m_mapped = std::move(rhs.m_mapped);
+        m_dirty_begin = std::move(rhs.m_dirty_begin);
+        m_dirty_end = std::move(rhs.m_dirty_end);
         d_data = std::move(rhs.d_data);
     #endif
         h_data = std::move(rhs.h_data);
@@ -870,6 +927,8 @@ template<class T> void GPUArray<T>::swap(GPUArray& from)
 #ifdef ENABLE_HIP
     std::swap(d_data, from.d_data);
     std::swap(m_mapped, from.m_mapped);
+    std::swap(m_dirty_begin, from.m_dirty_begin);
+    std::swap(m_dirty_end, from.m_dirty_end);
 #endif
     std::swap(h_data, from.h_data);
     }
@@ -1006,8 +1065,11 @@ template<class T> void GPUArray<T>::memcpyDeviceToHost(bool async) const
         }
 
     if (m_exec_conf)
+        {
         m_exec_conf->msg->notice(8) << "GPUArray: Copying " << float(m_num_elements*sizeof(T))/1024.0f/1024.0f << " MB device->host " <<
            (async ? std::string("async") : std::string()) << std::endl;
+        m_exec_conf->countTransferredBytes(m_num_elements*sizeof(T));
+        }
     #ifdef ENABLE_HIP
     if (async)
         {
@@ -1038,8 +1100,11 @@ template<class T> void GPUArray<T>::memcpyHostToDevice(bool async) const
         }
 
     if (m_exec_conf)
+        {
         m_exec_conf->msg->notice(8) << "GPUArray: Copying " << float(m_num_elements*sizeof(T))/1024.0f/1024.0f << " MB host->device " <<
            (async ? std::string("async") : std::string()) << std::endl;
+        m_exec_conf->countTransferredBytes(m_num_elements*sizeof(T));
+        }
     if (async)
         #ifdef ENABLE_HIP
         hipMemcpyAsync(d_data.get(), h_data.get(), sizeof(T)*m_num_elements, hipMemcpyHostToDevice);
@@ -1051,6 +1116,29 @@ template<class T> void GPUArray<T>::memcpyHostToDevice(bool async) const
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
     }
+
+/*! \post The host pages written through acquireRange() are copied to the device
+*/
+template<class T> void GPUArray<T>::flushHostPages() const
+    {
+    if (m_dirty_end == m_dirty_begin)
+        return;
+
+    size_t bytes = m_dirty_end - m_dirty_begin;
+    if (m_exec_conf)
+        {
+        m_exec_conf->msg->notice(8) << "GPUArray: Copying " << float(bytes)/1024.0f/1024.0f
+            << " MB of dirty pages host->device" << std::endl;
+        m_exec_conf->countTransferredBytes(bytes);
+        }
+    hipMemcpy(reinterpret_cast<char *>(d_data.get()) + m_dirty_begin,
+              reinterpret_cast<const char *>(h_data.get()) + m_dirty_begin, bytes, hipMemcpyHostToDevice);
+    m_dirty_begin = 0;
+    m_dirty_end = 0;
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
 #endif
 
 /*! \param location Desired location to access the data
@@ -1080,6 +1168,11 @@ ArrayHandleDispatch<T> GPUArray<T>::acquire(const access_location::Enum location
     if (isNull())
         return GPUArrayDispatch<T>(nullptr, *this);
 
+#ifdef ENABLE_HIP
+    // the state changes below assume that the device holds all data not written on the host
+    flushHostPages();
+#endif
+
     // first, break down based on where the data is to be acquired
     if (location == access_location::host)
         {
@@ -1233,6 +1326,63 @@ ArrayHandleDispatch<T> GPUArray<T>::acquire(const access_location::Enum location
         }
     }
 
+/*! \param location Desired location to access the data
+    \param mode Mode to access the data with
+    \param first First element to access
+    \param count Number of elements to access
+
+    Host access to data that was last updated on the device copies only the pages that hold the elements, and the
+    array stays on the device. When the mode allows writes, the pages are copied back by the next acquire. All other
+    accesses are the same as acquire().
+*/
+template<class T>
+ArrayHandleDispatch<T> GPUArray<T>::acquireRange(const access_location::Enum location, const access_mode::Enum mode,
+    size_t first, size_t count) const
+    {
+#ifdef ENABLE_HIP
+    if (location == access_location::host && m_data_location != data_location::host && !m_mapped && !isNull()
+        && m_exec_conf && m_exec_conf->isCUDAEnabled())
+        {
+        if (m_acquired)
+            {
+            throw std::runtime_error("Cannot acquire access to array in use.");
+            }
+        m_acquired = true;
+
+        assert(first + count <= m_num_elements);
+        flushHostPages();
+
+        size_t begin = first*sizeof(T)/GPUARRAY_PAGE_BYTES*GPUARRAY_PAGE_BYTES;
+        size_t end = ((first + count)*sizeof(T) + GPUARRAY_PAGE_BYTES - 1)/GPUARRAY_PAGE_BYTES*GPUARRAY_PAGE_BYTES;
+        end = std::min(end, m_num_elements*sizeof(T));
+
+        if (m_data_location == data_location::device && end > begin)
+            {
+            if (m_exec_conf)
+                {
+                m_exec_conf->msg->notice(8) << "GPUArray: Copying " << float(end - begin)/1024.0f/1024.0f
+                    << " MB of pages device->host" << std::endl;
+                m_exec_conf->countTransferredBytes(end - begin);
+                }
+            hipMemcpy(reinterpret_cast<char *>(h_data.get()) + begin,
+                      reinterpret_cast<const char *>(d_data.get()) + begin, end - begin, hipMemcpyDeviceToHost);
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+
+        if (mode != access_mode::read)
+            {
+            m_dirty_begin = begin;
+            m_dirty_end = end;
+            }
+
+        return GPUArrayDispatch<T>(h_data.get(), *this);
+        }
+#endif
+
+    return acquire(location, mode);
+    }
+
 /*! \post Memory on the host is resized, the newly allocated part of the array
  *        is reset to zero
  *! \returns a pointer to the newly allocated memory area
@@ -1465,6 +1615,11 @@ template<class T> void GPUArray<T>::resize(size_t num_elements)
         return;
         };
 
+#ifdef ENABLE_HIP
+    if (m_exec_conf && m_exec_conf->isCUDAEnabled())
+        flushHostPages();
+#endif
+
     // notify at a high level if a large allocation is about to occur
     if (m_num_elements > LARGEALLOCBYTES/(size_t)sizeof(T) && m_exec_conf)
         {
@@ -1510,6 +1665,11 @@ template<class T> void GPUArray<T>::resize(size_t width, size_t height)
         return;
         };
 
+#ifdef ENABLE_HIP
+    if (m_exec_conf && m_exec_conf->isCUDAEnabled())
+        flushHostPages();
+#endif
+
     // notify at a high level if a large allocation is about to occur
     if (m_num_elements > LARGEALLOCBYTES/(size_t)sizeof(T) && m_exec_conf)
         {
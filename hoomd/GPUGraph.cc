@@ -0,0 +1,84 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file GPUGraph.cc
+    \brief Defines the GPUGraph class
+*/
+
+#include "GPUGraph.h"
+
+#include <assert.h>
+
+using namespace std;
+
+/*! \param exec_conf Execution configuration
+*/
+GPUGraph::GPUGraph(std::shared_ptr<const ExecutionConfiguration> exec_conf)
+    : m_exec_conf(exec_conf), m_stream(0), m_instantiated(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing GPUGraph" << endl;
+
+    hipError_t err = hipStreamCreate(&m_stream);
+    m_exec_conf->handleHIPError(err, __FILE__, __LINE__);
+    }
+
+GPUGraph::~GPUGraph()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying GPUGraph" << endl;
+
+    invalidate();
+    hipStreamDestroy(m_stream);
+    }
+
+void GPUGraph::beginCapture()
+    {
+    invalidate();
+
+    // thread local mode allows other threads to continue using the default stream during capture
+    hipError_t err = hipStreamBeginCapture(m_stream, hipStreamCaptureModeThreadLocal);
+    m_exec_conf->handleHIPError(err, __FILE__, __LINE__);
+    }
+
+/*! \param key Key that identifies the arguments of the captured kernels
+*/
+void GPUGraph::endCapture(const std::vector<char>& key)
+    {
+    hipError_t err = hipStreamEndCapture(m_stream, &m_graph);
+    m_exec_conf->handleHIPError(err, __FILE__, __LINE__);
+
+    err = hipGraphInstantiate(&m_graph_exec, m_graph, nullptr, nullptr, 0);
+    if (err != hipSuccess)
+        hipGraphDestroy(m_graph);
+    m_exec_conf->handleHIPError(err, __FILE__, __LINE__);
+
+    m_instantiated = true;
+    m_key = key;
+    }
+
+void GPUGraph::launch()
+    {
+    assert(m_instantiated);
+
+    hipError_t err = hipGraphLaunch(m_graph_exec, m_stream);
+    m_exec_conf->handleHIPError(err, __FILE__, __LINE__);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        {
+        err = hipStreamSynchronize(m_stream);
+        m_exec_conf->handleHIPError(err, __FILE__, __LINE__);
+        }
+    }
+
+void GPUGraph::invalidate()
+    {
+    if (m_instantiated)
+        {
+        hipGraphExecDestroy(m_graph_exec);
+        hipGraphDestroy(m_graph);
+        m_instantiated = false;
+        }
+    m_key.clear();
+    }
@@ -0,0 +1,94 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file GPUGraph.h
+    \brief Defines the GPUGraph class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __GPUGRAPH_H__
+#define __GPUGRAPH_H__
+
+#ifdef ENABLE_HIP
+#include <hip/hip_runtime.h>
+
+#include "ExecutionConfiguration.h"
+
+#include <memory>
+#include <vector>
+
+//! Captures a sequence of kernel launches once and replays it
+/*! GPUGraph records the kernels launched in its stream between beginCapture() and endCapture() into a HIP graph.
+    launch() replays the whole sequence with a single call, which avoids the per kernel launch overhead.
+
+    A graph replays its kernels with the arguments they had during capture. The caller identifies those arguments
+    with a key, an arbitrary byte string that must change whenever any argument changes: array pointers, particle
+    counts, the box, parameters, ... isValid() compares the key of the instantiated graph to the current one, and
+    the caller captures a new graph when they differ.
+
+    Code that runs during capture must launch all kernels in getStream() and must not synchronize with the host,
+    which excludes memory copies, event queries, and error checks that call hipDeviceSynchronize().
+
+    The stream is a blocking stream, so replayed graphs are ordered with respect to work in the default stream.
+
+    \ingroup data_structs
+*/
+class PYBIND11_EXPORT GPUGraph
+    {
+    public:
+        //! Constructor
+        GPUGraph(std::shared_ptr<const ExecutionConfiguration> exec_conf);
+
+        //! Destructor
+        ~GPUGraph();
+
+        //! Get the stream to launch kernels in during capture
+        hipStream_t getStream() const
+            {
+            return m_stream;
+            }
+
+        //! Test if the instantiated graph was captured with the given key
+        bool isValid(const std::vector<char>& key) const
+            {
+            return m_instantiated && key == m_key;
+            }
+
+        //! Start capturing kernel launches in the stream
+        void beginCapture();
+
+        //! Finish capturing and instantiate the graph
+        void endCapture(const std::vector<char>& key);
+
+        //! Replay the captured kernel launches
+        void launch();
+
+        //! Discard the captured graph
+        void invalidate();
+
+        //! Append the bytes of a value to a key
+        template<class T>
+        static void appendToKey(std::vector<char>& key, const T& value)
+            {
+            const char *bytes = reinterpret_cast<const char *>(&value);
+            key.insert(key.end(), bytes, bytes + sizeof(T));
+            }
+
+    private:
+        std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration
+        hipStream_t m_stream;           //!< Stream to capture in and replay in
+        hipGraph_t m_graph;             //!< Captured graph
+        hipGraphExec_t m_graph_exec;    //!< Instantiated graph
+        bool m_instantiated;            //!< True when m_graph and m_graph_exec are valid
+        std::vector<char> m_key;        //!< Key that the graph was captured with
+    };
+
+#endif // ENABLE_HIP
+
+#endif // __GPUGRAPH_H__
@@ -0,0 +1,103 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file GPUReorder.cu
+    \brief Defines the kernel that permutes several per-particle arrays in one pass
+*/
+
+#include "GPUReorder.cuh"
+
+#include <climits>
+
+//! Copy one element of \a num_words 32 bit words using the widest aligned loads
+/*! \param dst Destination array
+    \param src Source array
+    \param num_words Element size in 32 bit words
+    \param new_idx Index of the element in the destination
+    \param old_idx Index of the element in the source
+*/
+__device__ inline void gpu_reorder_copy_element(void *dst,
+                                                const void *src,
+                                                unsigned int num_words,
+                                                unsigned int new_idx,
+                                                unsigned int old_idx)
+    {
+    if (num_words % 4 == 0)
+        {
+        const unsigned int n = num_words / 4;
+        const uint4 *s = (const uint4 *)src + old_idx*n;
+        uint4 *d = (uint4 *)dst + new_idx*n;
+        for (unsigned int w = 0; w < n; w++)
+            d[w] = s[w];
+        }
+    else if (num_words % 2 == 0)
+        {
+        const unsigned int n = num_words / 2;
+        const uint2 *s = (const uint2 *)src + old_idx*n;
+        uint2 *d = (uint2 *)dst + new_idx*n;
+        for (unsigned int w = 0; w < n; w++)
+            d[w] = s[w];
+        }
+    else
+        {
+        const unsigned int *s = (const unsigned int *)src + old_idx*num_words;
+        unsigned int *d = (unsigned int *)dst + new_idx*num_words;
+        for (unsigned int w = 0; w < num_words; w++)
+            d[w] = s[w];
+        }
+    }
+
+//! Kernel to gather all arrays of a table into a new order
+/*! \param table Arrays to permute
+    \param d_order Old index of the particle at each new index
+    \param N Number of particles
+
+    One thread per particle reads its old index once and copies the element of every array in the table. All threads
+    of a warp work on the same array at the same time, so the element size branch does not diverge.
+*/
+__global__ void gpu_apply_reorder_kernel(const gpu_reorder_table table,
+                                         const unsigned int *d_order,
+                                         const unsigned int N)
+    {
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    const unsigned int old_idx = d_order[idx];
+    for (unsigned int i = 0; i < table.num_arrays; i++)
+        gpu_reorder_copy_element(table.dst[i], table.src[i], table.num_words[i], idx, old_idx);
+    }
+
+/*! \param table Arrays to permute
+    \param d_order Old index of the particle at each new index
+    \param N Number of particles
+    \param block_size Number of threads per block
+
+    The destination arrays receive the first \a N elements of the source arrays in the new order. Elements past \a N
+    are not touched.
+*/
+hipError_t gpu_apply_reorder(const gpu_reorder_table& table,
+                             const unsigned int *d_order,
+                             unsigned int N,
+                             unsigned int block_size)
+    {
+    if (N == 0 || table.num_arrays == 0)
+        return hipSuccess;
+
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(gpu_apply_reorder_kernel));
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    unsigned int n_blocks = N/run_block_size + 1;
+
+    hipLaunchKernelGGL(gpu_apply_reorder_kernel, dim3(n_blocks), dim3(run_block_size), 0, 0,
+        table, d_order, N);
+
+    return hipSuccess;
+    }
@@ -0,0 +1,56 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __GPU_REORDER_CUH__
+#define __GPU_REORDER_CUH__
+
+#include <hip/hip_runtime.h>
+
+#include <cassert>
+
+/*! \file GPUReorder.cuh
+    \brief Declares a kernel driver that permutes several per-particle arrays in one pass
+*/
+
+//! Maximum number of arrays in a gpu_reorder_table
+const unsigned int GPU_REORDER_MAX_ARRAYS = 24;
+
+//! Table of type-erased per-particle arrays to permute with gpu_apply_reorder()
+/*! Each entry gathers the elements of a source array into a destination array. The elements are copied as 32 bit
+    words, so any element type whose size is a multiple of 4 bytes can be added. The table is passed to the kernel by
+    value.
+*/
+struct gpu_reorder_table
+    {
+    const void *src[GPU_REORDER_MAX_ARRAYS]; //!< Source arrays
+    void *dst[GPU_REORDER_MAX_ARRAYS];       //!< Destination arrays
+    unsigned int num_words[GPU_REORDER_MAX_ARRAYS]; //!< Element size of each array in 32 bit words
+    unsigned int num_arrays;                 //!< Number of arrays in the table
+
+    //! Constructs an empty table
+    gpu_reorder_table() : num_arrays(0) {}
+
+    //! Add an array to the table
+    /*! \param d_src Source array
+        \param d_dst Destination array, must not overlap \a d_src
+    */
+    template<class T>
+    void add(const T *d_src, T *d_dst)
+        {
+        static_assert(sizeof(T) % 4 == 0, "element size must be a multiple of 4 bytes");
+        assert(num_arrays < GPU_REORDER_MAX_ARRAYS);
+        src[num_arrays] = d_src;
+        dst[num_arrays] = d_dst;
+        num_words[num_arrays] = sizeof(T) / 4;
+        num_arrays++;
+        }
+    };
+
+//! Gather all arrays of a table into a new order (GPU driver function)
+hipError_t __attribute__((visibility("default")))
+gpu_apply_reorder(const gpu_reorder_table& table,
+                  const unsigned int *d_order,
+                  unsigned int N,
+                  unsigned int block_size);
+
+#endif // __GPU_REORDER_CUH__
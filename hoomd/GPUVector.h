@@ -34,7 +34,11 @@ class GlobalVector;
     It uses a GPUArray as the underlying storage class, thus the data in a GPUVectorBase can also be accessed
     directly using ArrayHandles.
 
-    In the current implementation, a GPUVectorBase can only grow (but not shrink) in size until it is destroyed.
+    The allocation grows geometrically by the growth factor (RESIZE_FACTOR by default, see setGrowthFactor()). By
+    default it never shrinks. When a shrink period is set (setShrinkPeriod()), the allocation is reduced after that
+    many consecutive resizes to sizes much smaller than the allocation, so that a buffer that grew during a transient
+    event (such as a load balancing step) does not keep its peak size forever. The largest size ever requested and the
+    number of reallocations are kept for logging (getHighWaterMark(), getNumReallocations()).
 
     \ingroup data_structs
 */
@@ -89,6 +93,42 @@ class GPUVectorBase : public Array
         //! Clear the list
         virtual void clear();
 
+        //! Set the factor by which the allocation grows
+        /*! \param growth_factor Factor (> 1) by which the allocated size is multiplied until the requested size fits
+        */
+        void setGrowthFactor(double growth_factor)
+            {
+            assert(growth_factor > 1.0);
+            m_growth_factor = growth_factor;
+            }
+
+        //! Set the number of resizes after which an oversized allocation is reduced
+        /*! \param shrink_period Number of consecutive resizes to at most 1/growth_factor^2 of the allocated size
+                                  before the allocation shrinks to growth_factor times the largest of them. 0 disables
+                                  shrinking.
+        */
+        void setShrinkPeriod(unsigned int shrink_period)
+            {
+            m_shrink_period = shrink_period;
+            m_num_small_resizes = 0;
+            m_window_high_water = 0;
+            }
+
+        //! Reduce the allocation to the current size
+        void shrinkToFit();
+
+        //! Get the largest size the vector ever had
+        size_t getHighWaterMark() const
+            {
+            return m_high_water;
+            }
+
+        //! Get the number of times the underlying array was reallocated
+        unsigned int getNumReallocations() const
+            {
+            return m_num_reallocations;
+            }
+
         //! Proxy class to provide access to the data elements of the vector
         class data_proxy
             {
@@ -100,7 +140,7 @@ class GPUVectorBase : public Array
                 //! Type cast
                 operator T() const
                     {
-                    auto dispatch = vec.acquireHost(access_mode::read);
+                    auto dispatch = vec.acquireHost(access_mode::read, n, 1);
                     T *data  = dispatch.get();
                     T val = data[n];
                     return val;
@@ -109,7 +149,7 @@ class GPUVectorBase : public Array
                 //! Assignment
                 data_proxy& operator= (T rhs)
                     {
-                    auto dispatch = vec.acquireHost(access_mode::readwrite);
+                    auto dispatch = vec.acquireHost(access_mode::readwrite, n, 1);
                     T *data  = dispatch.get();
                     data[n] = rhs;
                     return *this;
@@ -153,13 +193,36 @@ class GPUVectorBase : public Array
 
     private:
         size_t m_size;                    //!< Number of elements
+        double m_growth_factor;           //!< Factor by which the allocation grows
+        unsigned int m_shrink_period;     //!< Number of small resizes before shrinking (0 to never shrink)
+        unsigned int m_num_small_resizes; //!< Consecutive resizes that left most of the allocation unused
+        size_t m_window_high_water;       //!< Largest size in the current run of small resizes
+        size_t m_high_water;              //!< Largest size ever requested
+        unsigned int m_num_reallocations; //!< Number of reallocations of the underlying array
+
+        //! Initialize the growth policy and statistics
+        void initializePolicy()
+            {
+            m_growth_factor = RESIZE_FACTOR;
+            m_shrink_period = 0;
+            m_num_small_resizes = 0;
+            m_window_high_water = 0;
+            m_high_water = m_size;
+            m_num_reallocations = 0;
+            }
 
         //! Helper function to reallocate the GPUArray (using amortized array resizing)
         void reallocate(size_t new_size);
 
+        //! Shrink the allocation after a stable period of small sizes
+        void updateShrinkPolicy(size_t new_size);
+
         //! Acquire the underlying GPU array on the host
         ArrayHandleDispatch<T> acquireHost(const access_mode::Enum mode) const;
 
+        //! Acquire elements first to first + count - 1 of the underlying GPU array on the host
+        ArrayHandleDispatch<T> acquireHost(const access_mode::Enum mode, size_t first, size_t count) const;
+
         friend class data_proxy;
     };
 
@@ -176,6 +239,7 @@ template<class T, class Array>
 GPUVectorBase<T,Array>::GPUVectorBase()
     : Array(), m_size(0)
     {
+    initializePolicy();
     }
 
 /*! \param exec_conf Shared pointer to the execution configuration
@@ -184,6 +248,7 @@ template<class T, class Array>
 GPUVectorBase<T, Array>::GPUVectorBase(std::shared_ptr<const ExecutionConfiguration> exec_conf)
     : Array(0,exec_conf), m_size(0)
     {
+    initializePolicy();
     }
 
 /*! \param size Number of elements to allocate initial memory for in the array
@@ -193,11 +258,14 @@ template<class T, class Array>
 GPUVectorBase<T, Array>::GPUVectorBase(size_t size, std::shared_ptr<const ExecutionConfiguration> exec_conf)
      : Array(size, exec_conf), m_size(size)
     {
+    initializePolicy();
     }
 
 template<class T, class Array>
 GPUVectorBase<T,Array>::GPUVectorBase(const GPUVectorBase& from)
-    : Array(from), m_size(from.m_size)
+    : Array(from), m_size(from.m_size), m_growth_factor(from.m_growth_factor), m_shrink_period(from.m_shrink_period),
+      m_num_small_resizes(from.m_num_small_resizes), m_window_high_water(from.m_window_high_water),
+      m_high_water(from.m_high_water), m_num_reallocations(from.m_num_reallocations)
     {
     }
 
@@ -207,6 +275,12 @@ GPUVectorBase<T, Array>& GPUVectorBase<T,Array>::operator=(const GPUVectorBase&
     if (this != &rhs) // protect against invalid self-assignment
         {
         m_size = rhs.m_size;
+        m_growth_factor = rhs.m_growth_factor;
+        m_shrink_period = rhs.m_shrink_period;
+        m_num_small_resizes = rhs.m_num_small_resizes;
+        m_window_high_water = rhs.m_window_high_water;
+        m_high_water = rhs.m_high_water;
+        m_num_reallocations = rhs.m_num_reallocations;
         // invoke base class operator
         (Array) *this = rhs;
         }
@@ -220,6 +294,12 @@ template<class T, class Array>
 void GPUVectorBase<T, Array>::swap(GPUVectorBase<T, Array>& from)
     {
     std::swap(m_size, from.m_size);
+    std::swap(m_growth_factor, from.m_growth_factor);
+    std::swap(m_shrink_period, from.m_shrink_period);
+    std::swap(m_num_small_resizes, from.m_num_small_resizes);
+    std::swap(m_window_high_water, from.m_window_high_water);
+    std::swap(m_high_water, from.m_high_water);
+    std::swap(m_num_reallocations, from.m_num_reallocations);
     Array::swap(from);
     }
 
@@ -237,13 +317,62 @@ void GPUVectorBase<T, Array>::reallocate(size_t size)
         // reallocate
         size_t new_allocated_size = Array::getNumElements() ? Array::getNumElements() : 1;
 
-        // double the size as often as necessary
+        // grow the size as often as necessary
         while (size > new_allocated_size)
-            new_allocated_size = ((size_t) (((double) new_allocated_size) * RESIZE_FACTOR)) + 1 ;
+            new_allocated_size = ((size_t) (((double) new_allocated_size) * m_growth_factor)) + 1 ;
 
         // actually resize the underlying GPUArray
         Array::resize(new_allocated_size);
+        m_num_reallocations++;
+        }
+    }
+
+/*! \param new_size Size requested by the last resize()
+
+    Counts the consecutive resizes whose size leaves most of the allocation unused. Once there have been
+    m_shrink_period of them, the allocation is reduced to m_growth_factor times the largest size among them, so that the
+    next fluctuation does not trigger a reallocation right away.
+*/
+template<class T, class Array>
+void GPUVectorBase<T, Array>::updateShrinkPolicy(size_t new_size)
+    {
+    size_t allocated_size = Array::getNumElements();
+    if ((double)new_size*m_growth_factor*m_growth_factor >= (double)allocated_size)
+        {
+        // the allocation is in use, start over
+        m_num_small_resizes = 0;
+        m_window_high_water = 0;
+        return;
+        }
+
+    m_window_high_water = std::max(m_window_high_water, new_size);
+    if (++m_num_small_resizes < m_shrink_period)
+        return;
+
+    size_t shrunk_size = (size_t)((double)m_window_high_water*m_growth_factor) + 1;
+    if (shrunk_size < allocated_size)
+        {
+        Array::resize(shrunk_size);
+        m_num_reallocations++;
         }
+
+    m_num_small_resizes = 0;
+    m_window_high_water = 0;
+    }
+
+/*! \post The allocation holds exactly size() elements (at least one)
+*/
+template<class T, class Array>
+void GPUVectorBase<T, Array>::shrinkToFit()
+    {
+    size_t fit_size = m_size ? m_size : 1;
+    if (fit_size < Array::getNumElements())
+        {
+        Array::resize(fit_size);
+        m_num_reallocations++;
+        }
+    m_num_small_resizes = 0;
+    m_window_high_water = 0;
     }
 
 /*! \param new_size New size of vector
@@ -263,6 +392,10 @@ void GPUVectorBase<T, Array>::resize(size_t new_size)
 
     // set new size
     m_size = new_size;
+    m_high_water = std::max(m_high_water, new_size);
+
+    if (m_shrink_period)
+        updateShrinkPolicy(new_size);
     }
 
 
@@ -272,9 +405,10 @@ void GPUVectorBase<T, Array>::push_back(const T& val)
     {
     reallocate(m_size+1);
 
-    auto dispatch = acquireHost(access_mode::readwrite);
+    auto dispatch = acquireHost(access_mode::readwrite, m_size, 1);
     T * data = dispatch.get();
     data[m_size++] = val;
+    m_high_water = std::max(m_high_water, m_size);
     }
 
 //! Remove an element from the end of the list
@@ -325,6 +459,17 @@ ArrayHandleDispatch<T> GPUVectorBase<T,Array>::acquireHost(const access_mode::En
     #endif
     }
 
+/*! \param mode Access mode
+    \param first First element to access
+    \param count Number of elements to access
+*/
+template<class T, class Array>
+ArrayHandleDispatch<T> GPUVectorBase<T,Array>::acquireHost(const access_mode::Enum mode, size_t first,
+    size_t count) const
+    {
+    return GPUArrayBase<T,Array>::acquireRange(access_location::host, mode, first, count);
+    }
+
 //! Forward declarations
 template<class T>
 class GPUArray;
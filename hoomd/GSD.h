@@ -4,6 +4,10 @@
 #pragma once
 
 #include "hoomd/extern/gsd.h"
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <mutex>
 #include <string>
 #include <sstream>
 #include <stdexcept>
@@ -98,6 +102,146 @@ class GSDUtils
             throw std::runtime_error(s.str());
             }
         }
+
+    /// Encode a fractional box coordinate in [0,1) as a 16-bit fixed point number
+    static uint16_t quantizeFraction(double f)
+        {
+        double q = std::floor(f * 65536.0);
+        if (q < 0.0)
+            q = 0.0;
+        if (q > 65535.0)
+            q = 65535.0;
+        return uint16_t(q);
+        }
+
+    /// Decode a fractional box coordinate, the error is at most 1/131072
+    static double dequantizeFraction(uint16_t q)
+        {
+        return (double(q) + 0.5) / 65536.0;
+        }
+
+    /// Encode a value in [-1,1] as a 16-bit fixed point number
+    static int16_t quantizeUnit(double v)
+        {
+        double q = std::round(v * 32767.0);
+        if (q < -32767.0)
+            q = -32767.0;
+        if (q > 32767.0)
+            q = 32767.0;
+        return int16_t(q);
+        }
+
+    /// Decode a value in [-1,1]
+    static double dequantizeUnit(int16_t q)
+        {
+        return double(q) / 32767.0;
+        }
+    };
+
+/// Remembers the contents of the chunks in frame 0 of a GSD file
+/*! Readers of the hoomd schema use the chunk in frame 0 when a chunk is missing in a later frame. A chunk whose bytes
+    match frame 0 is therefore redundant, and writers skip it. GSDChunkCache stores a 64-bit FNV-1a hash of each chunk
+    written in frame 0 by this process, so nothing is skipped after appending to an existing file. Chunks under log/ are
+    always written.
+
+    The cache of an open file is registered by the address of its handle, which lets the slots of
+    GSDDumpWriter::getWriteSignal() deduplicate the chunks they write directly to the handle.
+*/
+class GSDChunkCache
+    {
+    public:
+    /// Forget all chunks, called when the file is created or truncated
+    void clear()
+        {
+        m_frame0.clear();
+        }
+
+    /// Check if a chunk needs to be written
+    /*! \param frame Index of the frame being written
+        \param name Chunk name
+        \param type Data type
+        \param N Number of rows
+        \param M Number of columns
+        \param data Chunk data
+
+        \returns false when the chunk is identical to the same chunk in frame 0
+    */
+    bool needsWrite(uint64_t frame,
+                    const std::string& name,
+                    gsd_type type,
+                    uint64_t N,
+                    uint32_t M,
+                    const void* data)
+        {
+        if (name.compare(0, 4, "log/") == 0)
+            return true;
+
+        const uint64_t h = hash(type, N, M, data);
+        if (frame == 0)
+            {
+            m_frame0[name] = h;
+            return true;
+            }
+
+        auto it = m_frame0.find(name);
+        return it == m_frame0.end() || it->second != h;
+        }
+
+    /// Register \a cache for the file open in \a handle
+    static void attach(const gsd_handle& handle, GSDChunkCache* cache)
+        {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        registry()[&handle] = cache;
+        }
+
+    /// Remove the cache of \a handle
+    static void detach(const gsd_handle& handle)
+        {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        registry().erase(&handle);
+        }
+
+    /// Get the cache registered for \a handle, or nullptr
+    static GSDChunkCache* find(const gsd_handle& handle)
+        {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        auto it = registry().find(&handle);
+        return it == registry().end() ? nullptr : it->second;
+        }
+
+    private:
+    std::map<std::string, uint64_t> m_frame0; //!< Hashes of the chunks in frame 0
+
+    /// FNV-1a hash of the chunk layout and data
+    static uint64_t hash(gsd_type type, uint64_t N, uint32_t M, const void* data)
+        {
+        uint64_t h = 14695981039346656037ull;
+        auto mix = [&h](const unsigned char* bytes, size_t size)
+        {
+            for (size_t i = 0; i < size; i++)
+                {
+                h ^= bytes[i];
+                h *= 1099511628211ull;
+                }
+        };
+
+        const uint64_t layout[3] = {uint64_t(type), N, uint64_t(M)};
+        mix(reinterpret_cast<const unsigned char*>(layout), sizeof(layout));
+        mix(static_cast<const unsigned char*>(data), N * M * gsd_sizeof_type(type));
+        return h;
+        }
+
+    static std::map<const gsd_handle*, GSDChunkCache*>& registry()
+        {
+        static std::map<const gsd_handle*, GSDChunkCache*> caches;
+        return caches;
+        }
+
+    static std::mutex& registryMutex()
+        {
+        static std::mutex mutex;
+        return mutex;
+        }
     };
     } // namespace detail
     } // namespace hoomd
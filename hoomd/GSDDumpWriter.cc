@@ -14,13 +14,41 @@
 #include <pybind11/numpy.h>
 
 #include <string.h>
+#include <cstdio>
 #include <stdexcept>
 #include <sstream>
 #include <list>
+#include <algorithm>
 using namespace std;
 using namespace hoomd::detail;
 namespace py = pybind11;
 
+namespace
+{
+//! Releases the GIL while the simulation thread waits for the writer thread
+/*! The simulation thread holds the GIL in analyze(), flush(), and in the destructor unless the run released it.
+    Waiting for the writer thread without the GIL keeps other Python threads running, and cannot deadlock even if
+    the writer thread ever needs the GIL.
+*/
+class ReleaseGILWhileWaiting
+    {
+    public:
+        ReleaseGILWhileWaiting()
+            : m_thread_state(Py_IsInitialized() && PyGILState_Check() ? PyEval_SaveThread() : nullptr)
+            {
+            }
+
+        ~ReleaseGILWhileWaiting()
+            {
+            if (m_thread_state)
+                PyEval_RestoreThread(m_thread_state);
+            }
+
+    private:
+        PyThreadState *m_thread_state;  //!< State of the calling thread, null when it did not hold the GIL
+    };
+}
+
 std::list<std::string> GSDDumpWriter::particle_chunks {"particles/typeid",
                                                        "particles/mass",
                                                        "particles/charge",
@@ -40,6 +68,8 @@ std::list<std::string> GSDDumpWriter::particle_chunks {"particles/typeid",
     \param group Group of particles to include in the output
     \param mode File open mode ("wb", "xb", or "ab")
     \param truncate If true, truncate the file to 0 frames every time analyze() called, then write out one frame
+    \param async_queue_depth Maximum number of frames waiting for the background writer thread, 0 writes frames
+           synchronously
 
     If the group does not include all particles, then topology information cannot be written to the file.
 */
@@ -47,10 +77,28 @@ GSDDumpWriter::GSDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
                              const std::string &fname,
                              std::shared_ptr<ParticleGroup> group,
                              std::string mode,
-                             bool truncate)
+                             bool truncate,
+                             unsigned int async_queue_depth)
     : Analyzer(sysdef), m_fname(fname), m_mode(mode),
                         m_truncate(truncate),
                         m_is_initialized(false),
+                        m_write_attribute(false),
+                        m_write_property(false),
+                        m_write_momentum(false),
+                        m_write_topology(false),
+                        m_parallel_io(false),
+                        m_quantize(false),
+                        m_atomic(false),
+                        m_write_integrator_state(false),
+                        m_region_set(false),
+                        m_region_lo(make_scalar3(0,0,0)),
+                        m_region_hi(make_scalar3(0,0,0)),
+                        m_nframes(0),
+                        m_async_queue_depth(async_queue_depth),
+                        m_write_signal_used(false),
+                        m_stage(false),
+                        m_writer_busy(false),
+                        m_writer_stop(false),
                         m_group(group)
     {
     m_exec_conf->msg->notice(5) << "Constructing GSDDumpWriter: " << m_fname << " " << mode << " " << truncate << endl;
@@ -61,24 +109,56 @@ GSDDumpWriter::GSDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
     m_log_writer = pybind11::none();
     }
 
+/*! \param fname File name
+    \param exclusive Fail if the file exists
+
+    Called by the writer thread in atomic mode, so createFile() must not access the messenger.
+*/
+void GSDDumpWriter::createFile(const std::string& fname, bool exclusive)
+    {
+    ostringstream o;
+    o << "HOOMD-blue " << HOOMD_VERSION;
+
+    int retval = gsd_create_and_open(&m_handle,
+                                    fname.c_str(),
+                                    o.str().c_str(),
+                                    "hoomd",
+                                    gsd_make_version(1,4),
+                                    GSD_OPEN_APPEND,
+                                    exclusive);
+    GSDUtils::checkError(retval, fname);
+    }
+
+/*! gsd_close() syncs the file to disk before the rename makes it visible as m_fname, and rename() replaces m_fname
+    atomically. Called by the writer thread in atomic mode.
+*/
+void GSDDumpWriter::replaceFile()
+    {
+    const std::string tmp_fname = getWriteFilename();
+    int retval = gsd_close(&m_handle);
+    GSDUtils::checkError(retval, tmp_fname);
+
+    if (std::rename(tmp_fname.c_str(), m_fname.c_str()) != 0)
+        throw runtime_error("GSD: could not rename " + tmp_fname + " to " + m_fname);
+    }
+
 //! Initializes the output file for writing
 void GSDDumpWriter::initFileIO()
     {
+    if (m_atomic)
+        {
+        // analyze() creates a new file for every frame
+        m_exec_conf->msg->notice(3) << "GSD: replace gsd file " << m_fname << " with every frame" << endl;
+        for (auto const& chunk : particle_chunks)
+            {
+            m_nondefault[chunk] = false;
+            }
+        }
     // create a new file or overwrite an existing one
-    if (m_mode == "wb" || m_mode == "xb" || (m_mode == "ab" && !filesystem::exists(m_fname)))
+    else if (m_mode == "wb" || m_mode == "xb" || (m_mode == "ab" && !filesystem::exists(m_fname)))
         {
-        ostringstream o;
-        o << "HOOMD-blue " << HOOMD_VERSION;
-
         m_exec_conf->msg->notice(3) << "GSD: create or overwrite gsd file " << m_fname << endl;
-        int retval = gsd_create_and_open(&m_handle,
-                                        m_fname.c_str(),
-                                        o.str().c_str(),
-                                        "hoomd",
-                                        gsd_make_version(1,4),
-                                        GSD_OPEN_APPEND,
-                                        m_mode == "xb");
-        GSDUtils::checkError(retval, m_fname);
+        createFile(m_fname, m_mode == "xb");
 
         // in a created or overwritten file, all quantities are default
         for (auto const& chunk : particle_chunks)
@@ -115,7 +195,15 @@ void GSDDumpWriter::initFileIO()
         throw std::invalid_argument("Invalid GSD file mode: " + m_mode);
         }
 
+    m_nframes = m_atomic ? 0 : gsd_get_nframes(&m_handle);
     m_is_initialized = true;
+
+    // slots of the write signal look up the cache by the handle
+    GSDChunkCache::attach(m_handle, &m_chunk_cache);
+
+    // the writer thread starts only after the file is open, it never touches the handle before then
+    if (m_async_queue_depth > 0)
+        m_writer_thread = std::thread(&GSDDumpWriter::writerThreadFunc, this);
     }
 
 GSDDumpWriter::~GSDDumpWriter()
@@ -127,7 +215,37 @@ GSDDumpWriter::~GSDDumpWriter()
     root = m_exec_conf->isRoot();
     #endif
 
-    if (root && m_is_initialized)
+    if (m_writer_thread.joinable())
+        {
+        // the writer thread writes all queued frames before it exits
+            {
+            std::unique_lock<std::mutex> lock(m_queue_mutex);
+            m_writer_stop = true;
+            }
+        m_queue_cv.notify_all();
+            {
+            ReleaseGILWhileWaiting release;
+            m_writer_thread.join();
+            }
+
+        if (m_writer_error)
+            {
+            try
+                {
+                std::rethrow_exception(m_writer_error);
+                }
+            catch (const std::exception& e)
+                {
+                m_exec_conf->msg->error() << e.what() << endl;
+                }
+            }
+        }
+
+    if (m_is_initialized)
+        GSDChunkCache::detach(m_handle);
+
+    // in atomic mode, the file is closed after every frame
+    if (root && m_is_initialized && !m_atomic)
         {
         m_exec_conf->msg->notice(5) << "GSD: close gsd file " << m_fname << endl;
         gsd_close(&m_handle);
@@ -138,6 +256,9 @@ GSDDumpWriter::~GSDDumpWriter()
 
     The first call to analyze() will create or overwrite the file and write out the current system configuration
     as frame 0. Subsequent calls will append frames to the file, or keep overwriting frame 0 if m_truncate is true.
+    In atomic mode, every call writes frame 0 of a new file that replaces the previous one.
+
+    In asynchronous mode, analyze() stages the frame and returns after the writer thread accepts it.
 */
 void GSDDumpWriter::analyze(unsigned int timestep)
     {
@@ -147,32 +268,76 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     if (m_prof)
         m_prof->push("Dump GSD");
 
-    // take particle data snapshot
-    m_exec_conf->msg->notice(10) << "GSD: taking particle data snapshot" << endl;
-    SnapshotParticleData<float> snapshot;
-    const std::map<unsigned int, unsigned int>& map = m_pdata->takeSnapshot<float>(snapshot);
-
 #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
     root = m_exec_conf->isRoot();
 #endif
 
+    // take particle data snapshot, the parallel path writes the particle data directly and the subset path gathers
+    // only the selected particles
+    bool parallel_io = useParallelIO();
+    bool subset = useSubset();
+    SnapshotParticleData<float> snapshot;
+    std::map<unsigned int, unsigned int> map;
+    if (subset)
+        {
+        m_exec_conf->msg->notice(10) << "GSD: taking subset snapshot" << endl;
+        takeSubsetSnapshot(snapshot, map);
+        }
+    else if (!parallel_io)
+        {
+        m_exec_conf->msg->notice(10) << "GSD: taking particle data snapshot" << endl;
+        map = m_pdata->takeSnapshot<float>(snapshot);
+
+        if (root)
+            {
+            m_frame_tags.resize(m_group->getNumMembersGlobal());
+            for (unsigned int group_idx = 0; group_idx < m_frame_tags.size(); group_idx++)
+                m_frame_tags[group_idx] = m_group->getMemberTag(group_idx);
+            }
+        }
+
     // open the file if it is not yet opened
     if (! m_is_initialized && root)
         initFileIO();
 
-    // truncate the file if requested
-    if (m_truncate && root)
+    // stage the frame unless slots need to write directly to the file handle
+    m_stage = root && m_writer_thread.joinable() && !m_write_signal_used;
+    m_frame = Frame();
+    if (root && m_writer_thread.joinable() && !m_stage)
+        flush();
+
+    // write every frame to a new file in atomic mode, or truncate the file if requested
+    if (m_atomic && root)
+        {
+        m_exec_conf->msg->notice(10) << "GSD: creating " << getWriteFilename() << endl;
+        if (m_stage)
+            m_frame.atomic = true;
+        else
+            createFile(getWriteFilename(), false);
+        m_nframes = 0;
+        m_chunk_cache.clear();
+        }
+    else if (m_truncate && root)
         {
         m_exec_conf->msg->notice(10) << "GSD: truncating file" << endl;
-        retval = gsd_truncate(&m_handle);
-        GSDUtils::checkError(retval, m_fname);
+        if (m_stage)
+            {
+            m_frame.truncate = true;
+            }
+        else
+            {
+            retval = gsd_truncate(&m_handle);
+            GSDUtils::checkError(retval, m_fname);
+            }
+        m_nframes = 0;
+        m_chunk_cache.clear();
         }
 
     uint64_t nframes = 0;
     if (root)
         {
-        nframes = gsd_get_nframes(&m_handle);
+        nframes = m_nframes;
         m_exec_conf->msg->notice(10) << "GSD: " << m_fname << " has " << nframes << " frames" << endl;
         }
 
@@ -183,19 +348,44 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     if (root)
         {
         // write out the frame header on all frames
-        writeFrameHeader(timestep);
+        writeFrameHeader(timestep, parallel_io ? m_pdata->getNGlobal() : uint32_t(m_frame_tags.size()));
 
-        // only write out data chunk categories if requested, or if on frame 0
-        if (m_write_attribute || nframes == 0)
+        if (m_write_integrator_state)
+            {
+            writeIntegratorState();
+            #ifdef ENABLE_MPI
+            writeDomainDecomposition();
+            #endif
+            }
+        }
+
+    if (parallel_io)
+        {
+        #ifdef ENABLE_MPI
+        writeParticlesMPI(nframes);
+        #endif
+        }
+    else if (root)
+        {
+        // only write out data chunk categories if requested, or if on frame 0. The particles in a region change from
+        // frame to frame, so all categories are written in every frame, together with the tags.
+        if (m_write_attribute || nframes == 0 || m_region_set)
             writeAttributes(snapshot, map);
-        if (m_write_property || nframes == 0)
+        if (m_write_property || nframes == 0 || m_region_set)
             writeProperties(snapshot, map);
-        if (m_write_momentum || nframes == 0)
+        if (m_write_momentum || nframes == 0 || m_region_set)
             writeMomenta(snapshot, map);
+
+        if (m_region_set)
+            {
+            m_exec_conf->msg->notice(10) << "GSD: writing log/particles/tag" << endl;
+            writeChunk("log/particles/tag", GSD_TYPE_UINT32, m_frame_tags.size(), 1, m_frame_tags.data());
+            }
         }
 
     // topology is only meaningful if this is the all group
-    if (m_group->getNumMembersGlobal() == m_pdata->getNGlobal() && (m_write_topology || nframes == 0))
+    if (m_group->getNumMembersGlobal() == m_pdata->getNGlobal() && !m_region_set
+        && (m_write_topology || nframes == 0))
         {
         BondData::Snapshot bdata_snapshot;
         m_sysdef->getBondData()->takeSnapshot(bdata_snapshot);
@@ -224,20 +414,182 @@ void GSDDumpWriter::analyze(unsigned int timestep)
 
     if (!m_log_writer.is_none())
         {
+        pybind11::gil_scoped_acquire acquire;
         m_log_writer.attr("_write_frame")(this);
         }
 
     if (root)
         {
-        m_exec_conf->msg->notice(10) << "GSD: ending frame" << endl;
-        retval = gsd_end_frame(&m_handle);
-        GSDUtils::checkError(retval, m_fname);
+        if (m_stage)
+            {
+            m_exec_conf->msg->notice(10) << "GSD: queueing frame" << endl;
+                {
+                ReleaseGILWhileWaiting release;
+                std::unique_lock<std::mutex> lock(m_queue_mutex);
+                m_queue_cv.wait(lock, [this]{ return m_queue.size() < m_async_queue_depth || m_writer_error; });
+                if (!m_writer_error)
+                    m_queue.push_back(std::move(m_frame));
+                }
+            m_queue_cv.notify_all();
+            m_stage = false;
+            checkWriterError();
+            }
+        else
+            {
+            m_exec_conf->msg->notice(10) << "GSD: ending frame" << endl;
+            retval = gsd_end_frame(&m_handle);
+            GSDUtils::checkError(retval, m_fname);
+
+            if (m_atomic)
+                {
+                m_exec_conf->msg->notice(10) << "GSD: replacing " << m_fname << endl;
+                replaceFile();
+                }
+            }
+        m_nframes++;
         }
 
     if (m_prof)
         m_prof->pop();
     }
 
+/*! Blocks until the writer thread has written all queued frames to the file.
+*/
+void GSDDumpWriter::flush()
+    {
+    if (m_writer_thread.joinable())
+        {
+        ReleaseGILWhileWaiting release;
+        std::unique_lock<std::mutex> lock(m_queue_mutex);
+        m_queue_cv.wait(lock, [this]{ return m_queue.empty() && !m_writer_busy; });
+        }
+    checkWriterError();
+    }
+
+/*! \param name Chunk name
+    \param type Data type
+    \param N Number of rows
+    \param M Number of columns
+    \param data Data to write
+
+    Skip the chunk when it is identical to the same chunk in frame 0, readers fall back to that one. In synchronous
+    mode, write the chunk to the file. When staging a frame, copy the data into m_frame so that the caller may release
+    it immediately.
+*/
+void GSDDumpWriter::writeChunk(const char *name, gsd_type type, uint64_t N, uint32_t M, const void *data)
+    {
+    if (!m_chunk_cache.needsWrite(m_nframes, name, type, N, M, data))
+        {
+        m_exec_conf->msg->notice(10) << "GSD: " << name << " is unchanged since frame 0" << endl;
+        return;
+        }
+
+    if (m_stage)
+        {
+        Chunk chunk;
+        chunk.name = name;
+        chunk.type = type;
+        chunk.N = N;
+        chunk.M = M;
+        const char *bytes = static_cast<const char *>(data);
+        chunk.data.assign(bytes, bytes + N * M * gsd_sizeof_type(type));
+        m_frame.chunks.push_back(std::move(chunk));
+        }
+    else
+        {
+        int retval = gsd_write_chunk(&m_handle, name, type, N, M, 0, data);
+        GSDUtils::checkError(retval, m_fname);
+        }
+    }
+
+/*! \param frame Frame to write
+
+    Called by the writer thread. writeFrame() must not access the messenger or any other state shared with the
+    simulation thread.
+*/
+void GSDDumpWriter::writeFrame(const Frame& frame)
+    {
+    int retval;
+    if (frame.atomic)
+        {
+        createFile(getWriteFilename(), false);
+        }
+    else if (frame.truncate)
+        {
+        retval = gsd_truncate(&m_handle);
+        GSDUtils::checkError(retval, m_fname);
+        }
+
+    for (auto const& chunk : frame.chunks)
+        {
+        retval = gsd_write_chunk(&m_handle,
+                                 chunk.name.c_str(),
+                                 chunk.type,
+                                 chunk.N,
+                                 chunk.M,
+                                 0,
+                                 chunk.data.data());
+        GSDUtils::checkError(retval, m_fname);
+        }
+
+    retval = gsd_end_frame(&m_handle);
+    GSDUtils::checkError(retval, m_fname);
+
+    if (frame.atomic)
+        replaceFile();
+    }
+
+/*! The writer thread writes queued frames in order until m_writer_stop is set and the queue is empty. After an
+    error, it discards the queued frames and leaves the error in m_writer_error for the simulation thread, which
+    reports it. The writer thread never logs: the messenger writes to sys.stdout, which needs the GIL.
+*/
+void GSDDumpWriter::writerThreadFunc()
+    {
+    std::unique_lock<std::mutex> lock(m_queue_mutex);
+    while (true)
+        {
+        m_queue_cv.wait(lock, [this]{ return m_writer_stop || !m_queue.empty(); });
+        if (m_queue.empty())
+            break;
+
+        Frame frame = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_writer_busy = true;
+        lock.unlock();
+        m_queue_cv.notify_all();
+
+        std::exception_ptr error;
+        try
+            {
+            writeFrame(frame);
+            }
+        catch (...)
+            {
+            error = std::current_exception();
+            }
+
+        lock.lock();
+        if (error)
+            {
+            m_writer_error = error;
+            m_queue.clear();
+            }
+        m_writer_busy = false;
+        m_queue_cv.notify_all();
+        }
+    }
+
+void GSDDumpWriter::checkWriterError()
+    {
+    std::exception_ptr error;
+        {
+        std::unique_lock<std::mutex> lock(m_queue_mutex);
+        std::swap(error, m_writer_error);
+        }
+
+    if (error)
+        std::rethrow_exception(error);
+    }
 
 void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string > type_mapping)
     {
@@ -253,8 +605,7 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string
         std::vector<char> types(max_len * type_mapping.size());
         for (unsigned int i = 0; i < type_mapping.size(); i++)
             strncpy(&types[max_len*i], type_mapping[i].c_str(), max_len);
-        int retval = gsd_write_chunk(&m_handle, chunk.c_str(), GSD_TYPE_UINT8, type_mapping.size(), max_len, 0, (void *)&types[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk(chunk.c_str(), GSD_TYPE_UINT8, type_mapping.size(), max_len, &types[0]);
         }
 
     }
@@ -267,20 +618,17 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string
     N is not strictly necessary for constant N data, but is always written in case the user fails to select
     dynamic attributes with a variable N file.
 */
-void GSDDumpWriter::writeFrameHeader(unsigned int timestep)
+void GSDDumpWriter::writeFrameHeader(unsigned int timestep, uint32_t N)
     {
-    int retval;
     m_exec_conf->msg->notice(10) << "GSD: writing configuration/step" << endl;
     uint64_t step = timestep;
-    retval = gsd_write_chunk(&m_handle, "configuration/step", GSD_TYPE_UINT64, 1, 1, 0, (void *)&step);
-    GSDUtils::checkError(retval, m_fname);
+    writeChunk("configuration/step", GSD_TYPE_UINT64, 1, 1, &step);
 
-    if (gsd_get_nframes(&m_handle) == 0)
+    if (m_nframes == 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing configuration/dimensions" << endl;
         uint8_t dimensions = (uint8_t)m_sysdef->getNDimensions();
-        retval = gsd_write_chunk(&m_handle, "configuration/dimensions", GSD_TYPE_UINT8, 1, 1, 0, (void *)&dimensions);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("configuration/dimensions", GSD_TYPE_UINT8, 1, 1, &dimensions);
         }
 
     m_exec_conf->msg->notice(10) << "GSD: writing configuration/box" << endl;
@@ -292,14 +640,74 @@ void GSDDumpWriter::writeFrameHeader(unsigned int timestep)
     box_a[3] = (float)box.getTiltFactorXY();
     box_a[4] = (float)box.getTiltFactorXZ();
     box_a[5] = (float)box.getTiltFactorYZ();
-    retval = gsd_write_chunk(&m_handle, "configuration/box", GSD_TYPE_FLOAT, 6, 1, 0, (void *)box_a);
-    GSDUtils::checkError(retval, m_fname);
+    writeChunk("configuration/box", GSD_TYPE_FLOAT, 6, 1, box_a);
 
     m_exec_conf->msg->notice(10) << "GSD: writing particles/N" << endl;
-    uint32_t N = m_group->getNumMembersGlobal();
-    retval = gsd_write_chunk(&m_handle, "particles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-    GSDUtils::checkError(retval, m_fname);
+    writeChunk("particles/N", GSD_TYPE_UINT32, 1, 1, &N);
+    }
+
+/*! Write the type, number of variables, and variables of each integrator in IntegratorData to
+    state/hoomd/integrator/type, state/hoomd/integrator/N, and state/hoomd/integrator/variables. The variables of all
+    integrators are concatenated in registration order.
+*/
+void GSDDumpWriter::writeIntegratorState()
+    {
+    std::shared_ptr<IntegratorData> integrator_data = m_sysdef->getIntegratorData();
+    unsigned int n = integrator_data->getNumIntegrators();
+    if (n == 0)
+        return;
+
+    std::vector<std::string> types(n);
+    std::vector<uint32_t> counts(n);
+    std::vector<double> variables;
+    for (unsigned int i = 0; i < n; i++)
+        {
+        const IntegratorVariables& v = integrator_data->getIntegratorVariables(i);
+        types[i] = v.type;
+        counts[i] = uint32_t(v.variable.size());
+        variables.insert(variables.end(), v.variable.begin(), v.variable.end());
+        }
+
+    writeTypeMapping("state/hoomd/integrator/type", types);
+
+    m_exec_conf->msg->notice(10) << "GSD: writing state/hoomd/integrator/N" << endl;
+    writeChunk("state/hoomd/integrator/N", GSD_TYPE_UINT32, n, 1, counts.data());
+
+    if (!variables.empty())
+        {
+        m_exec_conf->msg->notice(10) << "GSD: writing state/hoomd/integrator/variables" << endl;
+        writeChunk("state/hoomd/integrator/variables", GSD_TYPE_DOUBLE, variables.size(), 1, variables.data());
+        }
+    }
+
+#ifdef ENABLE_MPI
+/*! Write the grid of the domain decomposition to state/hoomd/domain/grid and the cumulative fractions of the box
+    along each direction to state/hoomd/domain/cumulative_x, _y, and _z. A simulation that continues from the file on
+    the same number of ranks starts with these domains, including the boundaries moved by the load balancer.
+*/
+void GSDDumpWriter::writeDomainDecomposition()
+    {
+    std::shared_ptr<DomainDecomposition> decomposition = m_pdata->getDomainDecomposition();
+    if (!decomposition)
+        return;
+
+    uint3 grid = decomposition->getGridSize();
+    uint32_t grid_a[3] = {grid.x, grid.y, grid.z};
+    m_exec_conf->msg->notice(10) << "GSD: writing state/hoomd/domain/grid" << endl;
+    writeChunk("state/hoomd/domain/grid", GSD_TYPE_UINT32, 3, 1, grid_a);
+
+    const char *names[3] = {"state/hoomd/domain/cumulative_x",
+                            "state/hoomd/domain/cumulative_y",
+                            "state/hoomd/domain/cumulative_z"};
+    for (unsigned int dir = 0; dir < 3; dir++)
+        {
+        std::vector<Scalar> cum_frac = decomposition->getCumulativeFractions(dir);
+        std::vector<double> cum_frac_d(cum_frac.begin(), cum_frac.end());
+        m_exec_conf->msg->notice(10) << "GSD: writing " << names[dir] << endl;
+        writeChunk(names[dir], GSD_TYPE_DOUBLE, cum_frac_d.size(), 1, cum_frac_d.data());
+        }
     }
+#endif
 
 /*! \param snapshot particle data snapshot to write out to the file
 
@@ -307,9 +715,8 @@ void GSDDumpWriter::writeFrameHeader(unsigned int timestep)
 */
 void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map)
     {
-    uint32_t N = m_group->getNumMembersGlobal();
-    int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint32_t N = uint32_t(m_frame_tags.size());
+    uint64_t nframes = m_nframes;
 
     writeTypeMapping("particles/types", snapshot.type_mapping);
 
@@ -320,7 +727,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_frame_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -335,8 +742,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/typeid"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/typeid" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&type[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/typeid", GSD_TYPE_UINT32, N, 1, &type[0]);
             if (nframes == 0)
                 m_nondefault["particles/typeid"] = true;
             }
@@ -349,7 +755,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_frame_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -364,8 +770,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/mass"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/mass" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/mass", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/mass", GSD_TYPE_FLOAT, N, 1, &data[0]);
             if (nframes == 0)
                 m_nondefault["particles/mass"] = true;
             }
@@ -374,7 +779,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_frame_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -388,8 +793,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/charge"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/charge" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/charge", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/charge", GSD_TYPE_FLOAT, N, 1, &data[0]);
             if (nframes == 0)
                 m_nondefault["particles/charge"] = true;
             }
@@ -398,7 +802,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_frame_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -413,8 +817,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/diameter"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/diameter" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/diameter", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/diameter", GSD_TYPE_FLOAT, N, 1, &data[0]);
             if (nframes == 0)
                 m_nondefault["particles/diameter"] = true;
             }
@@ -427,7 +830,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_frame_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -442,8 +845,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/body"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/body" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/body", GSD_TYPE_INT32, N, 1, 0, (void *)&body[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/body", GSD_TYPE_INT32, N, 1, &body[0]);
             if (nframes == 0)
                 m_nondefault["particles/body"] = true;
             }
@@ -456,7 +858,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_frame_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -477,8 +879,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/moment_inertia"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/moment_inertia" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/moment_inertia", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/moment_inertia", GSD_TYPE_FLOAT, N, 3, &data[0]);
             if (nframes == 0)
                 m_nondefault["particles/moment_inertia"] = true;
             }
@@ -491,17 +892,42 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 */
 void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map)
     {
-    uint32_t N = m_group->getNumMembersGlobal();
-    int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint32_t N = uint32_t(m_frame_tags.size());
+    uint64_t nframes = m_nframes;
+
+    if (m_quantize)
+        {
+        const BoxDim box = m_pdata->getGlobalBox();
+        std::vector<uint16_t> data(uint64_t(N)*3);
+        data.reserve(1); //! make sure we allocate
 
+        for (unsigned int group_idx = 0; group_idx < N; group_idx++)
+            {
+            unsigned int t = m_frame_tags[group_idx];
+
+            // look up tag in snapshot
+            auto it = map.find(t);
+            assert(it != map.end());
+
+            // snapshot positions are wrapped into the box
+            const vec3<float>& pos = snapshot.pos[it->second];
+            Scalar3 f = box.makeFraction(make_scalar3(pos.x, pos.y, pos.z));
+            data[group_idx*3+0] = GSDUtils::quantizeFraction(f.x);
+            data[group_idx*3+1] = GSDUtils::quantizeFraction(f.y);
+            data[group_idx*3+2] = GSDUtils::quantizeFraction(f.z);
+            }
+
+        m_exec_conf->msg->notice(10) << "GSD: writing particles/quantized/position" << endl;
+        writeChunk("particles/quantized/position", GSD_TYPE_UINT16, N, 3, &data[0]);
+        }
+    else
         {
         std::vector<float> data(uint64_t(N)*3);
         data.reserve(1); //! make sure we allocate
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_frame_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -513,8 +939,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
             }
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/position" << endl;
-        retval = gsd_write_chunk(&m_handle, "particles/position", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("particles/position", GSD_TYPE_FLOAT, N, 3, &data[0]);
         }
 
         {
@@ -524,7 +949,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_frame_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -546,9 +971,21 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/orientation"]))
             {
-            m_exec_conf->msg->notice(10) << "GSD: writing particles/orientation" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/orientation", GSD_TYPE_FLOAT, N, 4, 0, (void *)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            if (m_quantize)
+                {
+                std::vector<int16_t> qdata(uint64_t(N)*4);
+                qdata.reserve(1); //! make sure we allocate
+                for (uint64_t i = 0; i < uint64_t(N)*4; i++)
+                    qdata[i] = GSDUtils::quantizeUnit(data[i]);
+
+                m_exec_conf->msg->notice(10) << "GSD: writing particles/quantized/orientation" << endl;
+                writeChunk("particles/quantized/orientation", GSD_TYPE_INT16, N, 4, &qdata[0]);
+                }
+            else
+                {
+                m_exec_conf->msg->notice(10) << "GSD: writing particles/orientation" << endl;
+                writeChunk("particles/orientation", GSD_TYPE_FLOAT, N, 4, &data[0]);
+                }
             if (nframes == 0)
                 m_nondefault["particles/orientation"] = true;
             }
@@ -561,9 +998,8 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
 */
 void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map)
     {
-    uint32_t N = m_group->getNumMembersGlobal();
-    int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint32_t N = uint32_t(m_frame_tags.size());
+    uint64_t nframes = m_nframes;
 
         {
         std::vector<float> data(uint64_t(N)*3);
@@ -572,7 +1008,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_frame_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -593,8 +1029,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         if (!all_default || (nframes > 0 && m_nondefault["particles/velocity"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/velocity" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/velocity", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/velocity", GSD_TYPE_FLOAT, N, 3, &data[0]);
             if (nframes == 0)
                 m_nondefault["particles/velocity"] = true;
             }
@@ -607,7 +1042,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_frame_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -630,8 +1065,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         if (!all_default || (nframes > 0 && m_nondefault["particles/angmom"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/angmom" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/angmom", GSD_TYPE_FLOAT, N, 4, 0, (void *)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/angmom", GSD_TYPE_FLOAT, N, 4, &data[0]);
             if (nframes == 0)
                 m_nondefault["particles/angmom"] = true;
             }
@@ -644,7 +1078,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_frame_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -665,14 +1099,501 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         if (!all_default || (nframes > 0 && m_nondefault["particles/image"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/image" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/image", GSD_TYPE_INT32, N, 3, 0, (void *)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/image", GSD_TYPE_INT32, N, 3, &data[0]);
             if (nframes == 0)
                 m_nondefault["particles/image"] = true;
             }
         }
     }
 
+/*! The parallel path writes the particle data in the file order (ascending tag), which matches the local tags only
+    when the group includes all particles and the tags are contiguous.
+*/
+bool GSDDumpWriter::useParallelIO()
+    {
+#ifdef ENABLE_MPI
+    return m_parallel_io && m_pdata->getDomainDecomposition() && !m_region_set
+           && m_group->getNumMembersGlobal() == m_pdata->getNGlobal()
+           && m_pdata->getNGlobal() > 0
+           && m_pdata->getMaximumTag() + 1 == m_pdata->getNGlobal();
+#else
+    return false;
+#endif
+    }
+
+/*! Subsets are selected on each rank before any communication, so the particles that are not written are never
+    gathered.
+*/
+bool GSDDumpWriter::useSubset()
+    {
+    return m_region_set || m_group->getNumMembersGlobal() < m_pdata->getNGlobal();
+    }
+
+//! Fields of one selected particle, gathered to the root rank as raw bytes
+struct gsd_subset_element
+    {
+    float pos[3];
+    float vel[3];
+    float accel[3];
+    float orientation[4];
+    float angmom[4];
+    float inertia[3];
+    float mass;
+    float charge;
+    float diameter;
+    int32_t image[3];
+    uint32_t type;
+    uint32_t body;
+    uint32_t tag;
+    };
+
+/*! \param snapshot Snapshot to fill with the selected particles on the root rank
+    \param map Map from tag to snapshot index to fill on the root rank
+
+    Each rank selects its local group members that are inside the region, if one is set, and packs only their fields.
+    The root rank gathers the packed particles and orders them by tag in the snapshot and in m_frame_tags. Must be
+    called on all ranks.
+*/
+void GSDDumpWriter::takeSubsetSnapshot(SnapshotParticleData<float>& snapshot, std::map<unsigned int, unsigned int>& map)
+    {
+    std::vector<gsd_subset_element> local;
+
+        {
+        // the group index array must be acquired before the particle data arrays, it may rebuild from the tags
+        const GlobalArray<unsigned int>& index_array = m_group->getIndexArray();
+        unsigned int n_members = m_group->getNumMembers();
+        ArrayHandle<unsigned int> h_index(index_array, access_location::host, access_mode::read);
+
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+        const BoxDim& box = m_pdata->getGlobalBox();
+        Scalar3 origin = m_pdata->getOrigin();
+        int3 o_image = m_pdata->getOriginImage();
+
+        // select by position first, so that the other properties are only read for the written particles
+        std::vector<unsigned int> selected;
+        std::vector<Scalar3> selected_pos;
+        std::vector<int3> selected_image;
+        selected.reserve(n_members);
+        for (unsigned int i = 0; i < n_members; i++)
+            {
+            unsigned int idx = h_index.data[i];
+
+            // same conventions as the snapshot, relative to the origin and wrapped into the global box
+            Scalar3 pos = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - origin;
+            int3 img = h_image.data[idx];
+            img.x -= o_image.x;
+            img.y -= o_image.y;
+            img.z -= o_image.z;
+            box.wrap(pos, img);
+
+            if (m_region_set
+                && (pos.x < m_region_lo.x || pos.x >= m_region_hi.x
+                    || pos.y < m_region_lo.y || pos.y >= m_region_hi.y
+                    || pos.z < m_region_lo.z || pos.z >= m_region_hi.z))
+                continue;
+
+            selected.push_back(idx);
+            selected_pos.push_back(pos);
+            selected_image.push_back(img);
+            }
+
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host,
+                                       access_mode::read);
+
+        local.resize(selected.size());
+        for (unsigned int i = 0; i < selected.size(); i++)
+            {
+            unsigned int idx = selected[i];
+            gsd_subset_element& e = local[i];
+
+            e.pos[0] = float(selected_pos[i].x);
+            e.pos[1] = float(selected_pos[i].y);
+            e.pos[2] = float(selected_pos[i].z);
+            e.vel[0] = float(h_vel.data[idx].x);
+            e.vel[1] = float(h_vel.data[idx].y);
+            e.vel[2] = float(h_vel.data[idx].z);
+            e.accel[0] = float(h_accel.data[idx].x);
+            e.accel[1] = float(h_accel.data[idx].y);
+            e.accel[2] = float(h_accel.data[idx].z);
+            e.orientation[0] = float(h_orientation.data[idx].x);
+            e.orientation[1] = float(h_orientation.data[idx].y);
+            e.orientation[2] = float(h_orientation.data[idx].z);
+            e.orientation[3] = float(h_orientation.data[idx].w);
+            e.angmom[0] = float(h_angmom.data[idx].x);
+            e.angmom[1] = float(h_angmom.data[idx].y);
+            e.angmom[2] = float(h_angmom.data[idx].z);
+            e.angmom[3] = float(h_angmom.data[idx].w);
+            e.inertia[0] = float(h_inertia.data[idx].x);
+            e.inertia[1] = float(h_inertia.data[idx].y);
+            e.inertia[2] = float(h_inertia.data[idx].z);
+            e.mass = float(h_vel.data[idx].w);
+            e.charge = float(h_charge.data[idx]);
+            e.diameter = float(h_diameter.data[idx]);
+            e.image[0] = selected_image[i].x;
+            e.image[1] = selected_image[i].y;
+            e.image[2] = selected_image[i].z;
+            e.type = __scalar_as_int(h_pos.data[idx].w);
+            e.body = h_body.data[idx];
+            e.tag = h_tag.data[idx];
+            }
+        }
+
+    std::vector<gsd_subset_element> all;
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        bool root = m_exec_conf->isRoot();
+        unsigned int nranks = m_exec_conf->getNRanks();
+        MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+
+        int n_bytes = int(local.size()*sizeof(gsd_subset_element));
+        std::vector<int> counts(root ? nranks : 0);
+        MPI_Gather(&n_bytes, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, mpi_comm);
+
+        std::vector<int> displs(root ? nranks : 0);
+        if (root)
+            {
+            int offset = 0;
+            for (unsigned int rank = 0; rank < nranks; rank++)
+                {
+                displs[rank] = offset;
+                offset += counts[rank];
+                }
+            all.resize(offset/sizeof(gsd_subset_element));
+            }
+
+        MPI_Gatherv(local.data(), n_bytes, MPI_BYTE, all.data(), counts.data(), displs.data(), MPI_BYTE, 0,
+                    mpi_comm);
+
+        if (!root)
+            return;
+        }
+    else
+#endif
+        {
+        all.swap(local);
+        }
+
+    // the file stores the particles in ascending tag order
+    std::sort(all.begin(), all.end(),
+              [](const gsd_subset_element& a, const gsd_subset_element& b) { return a.tag < b.tag; });
+
+    snapshot.resize((unsigned int)all.size());
+    m_frame_tags.resize(all.size());
+    for (unsigned int i = 0; i < all.size(); i++)
+        {
+        const gsd_subset_element& e = all[i];
+        snapshot.pos[i] = vec3<float>(e.pos[0], e.pos[1], e.pos[2]);
+        snapshot.vel[i] = vec3<float>(e.vel[0], e.vel[1], e.vel[2]);
+        snapshot.accel[i] = vec3<float>(e.accel[0], e.accel[1], e.accel[2]);
+        snapshot.orientation[i] = quat<float>(e.orientation[0],
+                                              vec3<float>(e.orientation[1], e.orientation[2], e.orientation[3]));
+        snapshot.angmom[i] = quat<float>(e.angmom[0], vec3<float>(e.angmom[1], e.angmom[2], e.angmom[3]));
+        snapshot.inertia[i] = vec3<float>(e.inertia[0], e.inertia[1], e.inertia[2]);
+        snapshot.mass[i] = e.mass;
+        snapshot.charge[i] = e.charge;
+        snapshot.diameter[i] = e.diameter;
+        snapshot.image[i] = make_int3(e.image[0], e.image[1], e.image[2]);
+        snapshot.type[i] = e.type;
+        snapshot.body[i] = e.body;
+        m_frame_tags[i] = e.tag;
+        map[e.tag] = i;
+        }
+
+    snapshot.type_mapping.clear();
+    for (unsigned int i = 0; i < m_pdata->getNTypes(); i++)
+        snapshot.type_mapping.push_back(m_pdata->getNameByType(i));
+    }
+
+#ifdef ENABLE_MPI
+/*! \param nframes Number of frames in the file
+
+    Write the particle chunks in the same categories and with the same default value logic as writeAttributes(),
+    writeProperties() and writeMomenta(). Each rank converts only its local particles, so no rank holds more than its
+    own share of the system. Must be called on all ranks.
+*/
+void GSDDumpWriter::writeParticlesMPI(uint64_t nframes)
+    {
+    bool root = m_exec_conf->isRoot();
+
+    if (root && (m_write_attribute || nframes == 0))
+        {
+        std::vector<std::string> type_mapping;
+        for (unsigned int i = 0; i < m_pdata->getNTypes(); i++)
+            type_mapping.push_back(m_pdata->getNameByType(i));
+        writeTypeMapping("particles/types", type_mapping);
+        }
+
+    // the distributed snapshot holds the local particles in tag order, which file views require
+    DistributedSnapshotParticleData<float> snapshot;
+    m_pdata->takeDistributedSnapshot(snapshot);
+    const unsigned int N = snapshot.size;
+
+    std::vector<int> offsets(snapshot.tag.begin(), snapshot.tag.end());
+
+    const std::string fname = getWriteFilename();
+    MPI_File fh;
+    int err = MPI_File_open(m_exec_conf->getMPICommunicator(), fname.c_str(), MPI_MODE_WRONLY, MPI_INFO_NULL, &fh);
+    if (err != MPI_SUCCESS)
+        throw runtime_error("GSD: MPI-IO could not open " + fname);
+
+    try
+        {
+        if (m_write_attribute || nframes == 0)
+            {
+            bool all_default = true;
+            for (unsigned int i = 0; i < N; i++)
+                {
+                if (snapshot.type[i] != 0)
+                    all_default = false;
+                }
+            writeChunkMPI(fh, offsets, "particles/typeid", GSD_TYPE_UINT32, 1, snapshot.type.data(), all_default,
+                          nframes);
+
+            all_default = true;
+            for (unsigned int i = 0; i < N; i++)
+                {
+                if (snapshot.mass[i] != float(1.0))
+                    all_default = false;
+                }
+            writeChunkMPI(fh, offsets, "particles/mass", GSD_TYPE_FLOAT, 1, snapshot.mass.data(), all_default,
+                          nframes);
+
+            all_default = true;
+            for (unsigned int i = 0; i < N; i++)
+                {
+                if (snapshot.charge[i] != float(0.0))
+                    all_default = false;
+                }
+            writeChunkMPI(fh, offsets, "particles/charge", GSD_TYPE_FLOAT, 1, snapshot.charge.data(), all_default,
+                          nframes);
+
+            all_default = true;
+            for (unsigned int i = 0; i < N; i++)
+                {
+                if (snapshot.diameter[i] != float(1.0))
+                    all_default = false;
+                }
+            writeChunkMPI(fh, offsets, "particles/diameter", GSD_TYPE_FLOAT, 1, snapshot.diameter.data(),
+                          all_default, nframes);
+
+            // body ids are written as signed integers, NO_BODY becomes -1
+            all_default = true;
+            for (unsigned int i = 0; i < N; i++)
+                {
+                if (snapshot.body[i] != NO_BODY)
+                    all_default = false;
+                }
+            writeChunkMPI(fh, offsets, "particles/body", GSD_TYPE_INT32, 1, snapshot.body.data(), all_default,
+                          nframes);
+
+            all_default = true;
+            for (unsigned int i = 0; i < N; i++)
+                {
+                const vec3<float>& I = snapshot.inertia[i];
+                if (I.x != float(0.0) || I.y != float(0.0) || I.z != float(0.0))
+                    all_default = false;
+                }
+            writeChunkMPI(fh, offsets, "particles/moment_inertia", GSD_TYPE_FLOAT, 3, snapshot.inertia.data(),
+                          all_default, nframes);
+            }
+
+        if (m_write_property || nframes == 0)
+            {
+            if (m_quantize)
+                {
+                const BoxDim& box = m_pdata->getGlobalBox();
+                std::vector<uint16_t> qdata(uint64_t(N)*3);
+                for (unsigned int i = 0; i < N; i++)
+                    {
+                    Scalar3 f = box.makeFraction(make_scalar3(snapshot.pos[i].x,
+                                                              snapshot.pos[i].y,
+                                                              snapshot.pos[i].z));
+                    qdata[i*3+0] = GSDUtils::quantizeFraction(f.x);
+                    qdata[i*3+1] = GSDUtils::quantizeFraction(f.y);
+                    qdata[i*3+2] = GSDUtils::quantizeFraction(f.z);
+                    }
+                writeChunkMPI(fh, offsets, "particles/quantized/position", GSD_TYPE_UINT16, 3, qdata.data(),
+                              false, nframes);
+                }
+            else
+                {
+                writeChunkMPI(fh, offsets, "particles/position", GSD_TYPE_FLOAT, 3, snapshot.pos.data(), false,
+                              nframes);
+                }
+
+            bool all_default = true;
+            for (unsigned int i = 0; i < N; i++)
+                {
+                const quat<float>& q = snapshot.orientation[i];
+                if (q.s != float(1.0) || q.v.x != float(0.0) || q.v.y != float(0.0) || q.v.z != float(0.0))
+                    all_default = false;
+                }
+            if (m_quantize)
+                {
+                std::vector<int16_t> qdata(uint64_t(N)*4);
+                for (unsigned int i = 0; i < N; i++)
+                    {
+                    const quat<float>& q = snapshot.orientation[i];
+                    qdata[i*4+0] = GSDUtils::quantizeUnit(q.s);
+                    qdata[i*4+1] = GSDUtils::quantizeUnit(q.v.x);
+                    qdata[i*4+2] = GSDUtils::quantizeUnit(q.v.y);
+                    qdata[i*4+3] = GSDUtils::quantizeUnit(q.v.z);
+                    }
+                writeChunkMPI(fh, offsets, "particles/quantized/orientation", GSD_TYPE_INT16, 4, qdata.data(),
+                              all_default, nframes, "particles/orientation");
+                }
+            else
+                {
+                writeChunkMPI(fh, offsets, "particles/orientation", GSD_TYPE_FLOAT, 4, snapshot.orientation.data(),
+                              all_default, nframes);
+                }
+            }
+
+        if (m_write_momentum || nframes == 0)
+            {
+            bool all_default = true;
+            for (unsigned int i = 0; i < N; i++)
+                {
+                const vec3<float>& v = snapshot.vel[i];
+                if (v.x != float(0.0) || v.y != float(0.0) || v.z != float(0.0))
+                    all_default = false;
+                }
+            writeChunkMPI(fh, offsets, "particles/velocity", GSD_TYPE_FLOAT, 3, snapshot.vel.data(), all_default,
+                          nframes);
+
+            all_default = true;
+            for (unsigned int i = 0; i < N; i++)
+                {
+                const quat<float>& a = snapshot.angmom[i];
+                if (a.s != float(0.0) || a.v.x != float(0.0) || a.v.y != float(0.0) || a.v.z != float(0.0))
+                    all_default = false;
+                }
+            writeChunkMPI(fh, offsets, "particles/angmom", GSD_TYPE_FLOAT, 4, snapshot.angmom.data(), all_default,
+                          nframes);
+
+            all_default = true;
+            for (unsigned int i = 0; i < N; i++)
+                {
+                const int3& img = snapshot.image[i];
+                if (img.x != 0 || img.y != 0 || img.z != 0)
+                    all_default = false;
+                }
+            writeChunkMPI(fh, offsets, "particles/image", GSD_TYPE_INT32, 3, snapshot.image.data(), all_default,
+                          nframes);
+            }
+        }
+    catch (...)
+        {
+        MPI_File_close(&fh);
+        throw;
+        }
+
+    // closing the file completes the writes before the root rank writes the frame index
+    MPI_File_close(&fh);
+    }
+
+/*! \param fh MPI-IO file handle
+    \param offsets File row of each local particle, in ascending order
+    \param name Chunk name
+    \param type Data type
+    \param M Number of columns
+    \param data Local particle data, one row per entry in \a offsets
+    \param all_default True if all local values are the default
+    \param nframes Number of frames in the file
+    \param key Name that tracks whether the values were non-default in frame 0, defaults to \a name
+
+    The chunk is skipped when the values are default on all ranks, following the same rules as the gathered path.
+    Otherwise, the root rank reserves the chunk in the file and all ranks write their rows collectively.
+*/
+void GSDDumpWriter::writeChunkMPI(MPI_File fh,
+                                  const std::vector<int>& offsets,
+                                  const char *name,
+                                  gsd_type type,
+                                  uint32_t M,
+                                  const void *data,
+                                  bool all_default,
+                                  uint64_t nframes,
+                                  const char *key)
+    {
+    MPI_Comm comm = m_exec_conf->getMPICommunicator();
+    bool root = m_exec_conf->isRoot();
+
+    int global_default = all_default;
+    MPI_Allreduce(MPI_IN_PLACE, &global_default, 1, MPI_INT, MPI_LAND, comm);
+
+    if (key == nullptr)
+        key = name;
+
+    int write = 0;
+    int retval = GSD_SUCCESS;
+    int64_t location = 0;
+    if (root)
+        {
+        write = !global_default || (nframes > 0 && m_nondefault[key]);
+        if (write)
+            {
+            m_exec_conf->msg->notice(10) << "GSD: writing " << name << " with MPI-IO" << endl;
+            retval = gsd_reserve_chunk(&m_handle, name, type, m_pdata->getNGlobal(), M, 0, &location);
+            if (nframes == 0)
+                m_nondefault[key] = true;
+            }
+        }
+
+    bcast(write, 0, comm);
+    bcast(retval, 0, comm);
+    bcast(location, 0, comm);
+    GSDUtils::checkError(retval, m_fname);
+
+    if (!write)
+        return;
+
+    MPI_Datatype element;
+    if (type == GSD_TYPE_FLOAT)
+        element = MPI_FLOAT;
+    else if (type == GSD_TYPE_UINT32)
+        element = MPI_UINT32_T;
+    else if (type == GSD_TYPE_INT32)
+        element = MPI_INT32_T;
+    else if (type == GSD_TYPE_UINT16)
+        element = MPI_UINT16_T;
+    else if (type == GSD_TYPE_INT16)
+        element = MPI_INT16_T;
+    else
+        throw std::invalid_argument("GSD: unsupported MPI-IO chunk type");
+
+    // one row per particle, placed at the row given by the particle's tag
+    MPI_Datatype row, filetype;
+    MPI_Type_contiguous(M, element, &row);
+    MPI_Type_commit(&row);
+    MPI_Type_create_indexed_block((int)offsets.size(), 1, offsets.data(), row, &filetype);
+    MPI_Type_commit(&filetype);
+
+    int err = MPI_File_set_view(fh, location, row, filetype, "native", MPI_INFO_NULL);
+    if (err == MPI_SUCCESS)
+        err = MPI_File_write_all(fh, data, (int)offsets.size(), row, MPI_STATUS_IGNORE);
+
+    MPI_Type_free(&filetype);
+    MPI_Type_free(&row);
+
+    int error = (err != MPI_SUCCESS);
+    MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_INT, MPI_LOR, comm);
+    if (error)
+        throw runtime_error(std::string("GSD: MPI-IO error writing ") + name + " to " + m_fname);
+    }
+#endif
+
 /*! \param bond Bond data snapshot
     \param angle Angle data snapshot
     \param dihedral Dihedral data snapshot
@@ -693,77 +1614,64 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/N" << endl;
         uint32_t N = bond.size;
-        int retval = gsd_write_chunk(&m_handle, "bonds/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("bonds/N", GSD_TYPE_UINT32, 1, 1, &N);
 
         writeTypeMapping("bonds/types", bond.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "bonds/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&bond.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("bonds/typeid", GSD_TYPE_UINT32, N, 1, &bond.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "bonds/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&bond.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("bonds/group", GSD_TYPE_UINT32, N, 2, &bond.groups[0]);
         }
     if (angle.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing angles/N" << endl;
         uint32_t N = angle.size;
-        int retval = gsd_write_chunk(&m_handle, "angles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("angles/N", GSD_TYPE_UINT32, 1, 1, &N);
 
         writeTypeMapping("angles/types", angle.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing angles/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "angles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&angle.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("angles/typeid", GSD_TYPE_UINT32, N, 1, &angle.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing angles/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "angles/group", GSD_TYPE_UINT32, N, 3, 0, (void *)&angle.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("angles/group", GSD_TYPE_UINT32, N, 3, &angle.groups[0]);
         }
     if (dihedral.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/N" << endl;
         uint32_t N = dihedral.size;
-        int retval = gsd_write_chunk(&m_handle, "dihedrals/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("dihedrals/N", GSD_TYPE_UINT32, 1, 1, &N);
 
         writeTypeMapping("dihedrals/types", dihedral.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "dihedrals/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&dihedral.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("dihedrals/typeid", GSD_TYPE_UINT32, N, 1, &dihedral.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "dihedrals/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&dihedral.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("dihedrals/group", GSD_TYPE_UINT32, N, 4, &dihedral.groups[0]);
         }
     if (improper.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/N" << endl;
         uint32_t N = improper.size;
-        int retval = gsd_write_chunk(&m_handle, "impropers/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("impropers/N", GSD_TYPE_UINT32, 1, 1, &N);
 
         writeTypeMapping("impropers/types", improper.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "impropers/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&improper.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("impropers/typeid", GSD_TYPE_UINT32, N, 1, &improper.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "impropers/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&improper.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("impropers/group", GSD_TYPE_UINT32, N, 4, &improper.groups[0]);
         }
 
     if (constraint.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/N" << endl;
         uint32_t N = constraint.size;
-        int retval = gsd_write_chunk(&m_handle, "constraints/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("constraints/N", GSD_TYPE_UINT32, 1, 1, &N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/value" << endl;
             {
@@ -772,31 +1680,26 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
             for (unsigned int i = 0; i < N; i++)
                 data[i] = float(constraint.val[i]);
 
-            retval = gsd_write_chunk(&m_handle, "constraints/value", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("constraints/value", GSD_TYPE_FLOAT, N, 1, &data[0]);
             }
 
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "constraints/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&constraint.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("constraints/group", GSD_TYPE_UINT32, N, 2, &constraint.groups[0]);
         }
 
     if (pair.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/N" << endl;
         uint32_t N = pair.size;
-        int retval = gsd_write_chunk(&m_handle, "pairs/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("pairs/N", GSD_TYPE_UINT32, 1, 1, &N);
 
         writeTypeMapping("pairs/types", pair.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "pairs/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&pair.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("pairs/typeid", GSD_TYPE_UINT32, N, 1, &pair.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "pairs/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&pair.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("pairs/group", GSD_TYPE_UINT32, N, 2, &pair.groups[0]);
         }
     }
 
@@ -896,14 +1799,7 @@ void GSDDumpWriter::writeLogQuantities(pybind11::dict dict)
                 throw invalid_argument("Invalid numpy dimension in gsd log data [" + name + "]");
                 }
 
-            int retval = gsd_write_chunk(&m_handle,
-                                        name.c_str(),
-                                        type,
-                                        N,
-                                        (uint32_t)M,
-                                        0,
-                                        (void *)arr.data());
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk(name.c_str(), type, N, (uint32_t)M, arr.data());
             }
         }
     }
@@ -940,6 +1836,10 @@ void GSDDumpWriter::populateNonDefault()
         m_nondefault[chunk] = (entry != nullptr);
         }
 
+    // quantized orientations replace the full precision chunk
+    if (gsd_find_chunk(&m_handle, 0, "particles/quantized/orientation") != nullptr)
+        m_nondefault["particles/orientation"] = true;
+
     // close the file
     gsd_close(&m_handle);
     }
@@ -949,17 +1849,30 @@ void export_GSDDumpWriter(py::module& m)
     py::bind_map<std::map<std::string, pybind11::function>>(m, "MapStringFunction");
 
     py::class_<GSDDumpWriter, Analyzer, std::shared_ptr<GSDDumpWriter> >(m,"GSDDumpWriter")
-        .def(py::init< std::shared_ptr<SystemDefinition>, std::string, std::shared_ptr<ParticleGroup>, std::string, bool>())
+        .def(py::init< std::shared_ptr<SystemDefinition>,
+                       std::string,
+                       std::shared_ptr<ParticleGroup>,
+                       std::string,
+                       bool,
+                       unsigned int>())
         .def("setWriteAttribute", &GSDDumpWriter::setWriteAttribute)
         .def("setWriteProperty", &GSDDumpWriter::setWriteProperty)
         .def("setWriteMomentum", &GSDDumpWriter::setWriteMomentum)
         .def("setWriteTopology", &GSDDumpWriter::setWriteTopology)
+        .def_property("parallel_io", &GSDDumpWriter::getParallelIO, &GSDDumpWriter::setParallelIO)
+        .def_property("quantize", &GSDDumpWriter::getQuantize, &GSDDumpWriter::setQuantize)
+        .def_property("region", &GSDDumpWriter::getRegion, &GSDDumpWriter::setRegion)
+        .def_property("atomic", &GSDDumpWriter::getAtomic, &GSDDumpWriter::setAtomic)
+        .def_property("integrator_state",
+                      &GSDDumpWriter::getWriteIntegratorState,
+                      &GSDDumpWriter::setWriteIntegratorState)
         .def("writeLogQuantities", &GSDDumpWriter::writeLogQuantities)
         .def_property("log_writer", &GSDDumpWriter::getLogWriter, &GSDDumpWriter::setLogWriter)
         .def_property_readonly("filename", &GSDDumpWriter::getFilename)
         .def_property_readonly("mode", &GSDDumpWriter::getMode)
         .def_property_readonly("dynamic", &GSDDumpWriter::getDynamic)
         .def_property_readonly("truncate", &GSDDumpWriter::getTruncate)
+        .def_property_readonly("async_queue_depth", &GSDDumpWriter::getAsyncQueueDepth)
         .def_property_readonly("filter", [](const std::shared_ptr<GSDDumpWriter> gsd)
                                              {
                                              return gsd->getGroup()->getFilter();
@@ -9,6 +9,12 @@
 
 #include <string>
 #include <memory>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include "hoomd/extern/gsd.h"
 
 /*! \file GSDDumpWriter.h
@@ -21,6 +27,10 @@
 
 #include <pybind11/pybind11.h>
 
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
 //! Analyzer for writing out GSD dump files
 /*! GSDDumpWriter writes out the current state of the system to a GSD file
     every time analyze() is called. When a group is specified, only write out the
@@ -28,6 +38,28 @@
 
     The file is not opened until the first call to analyze().
 
+    When \a async_queue_depth is non-zero, analyze() copies the frame's data chunks into a staging buffer and
+    hands it to a background thread, which writes the chunks and ends the frame. analyze() blocks only when
+    \a async_queue_depth frames are already waiting to be written. flush() waits until all queued frames are in the
+    file, and System calls it at the end of every run. Errors in the background thread are raised by the next call to
+    analyze() or flush(). Frames are written synchronously once any slot connects to the write signal, because slots
+    write to the file handle directly.
+
+    By default, analyze() gathers all particles to the root rank with ParticleData::takeSnapshot and the root rank
+    writes the file. With parallel I/O enabled, the root rank reserves space for each per-particle chunk with
+    gsd_reserve_chunk and every rank writes its local particles at their tag offsets with collective MPI-IO. This
+    path requires the group of all particles and contiguous tags, otherwise analyze() uses the gathered snapshot.
+    Bond, angle, and other topology chunks are always gathered.
+
+    In atomic mode, every frame is written to a new file named \a fname with the suffix .tmp, which replaces \a fname
+    with a rename once the frame is complete. The file therefore holds exactly one frame, and a run that stops while
+    writing leaves the previous frame intact. Together with the integrator variables of IntegratorData, which are
+    written to state/hoomd/integrator/ chunks on request, such a file is a checkpoint that GSDReader can restore.
+
+    With quantization enabled, positions are written to particles/quantized/position as 16-bit fractional box
+    coordinates and orientations to particles/quantized/orientation as 16-bit fixed point components in place of
+    particles/position and particles/orientation. GSDReader decodes both.
+
     \ingroup analyzers
 */
 class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
@@ -38,7 +70,8 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
                       const std::string &fname,
                       std::shared_ptr<ParticleGroup> group,
                       std::string mode="ab",
-                      bool truncate=false);
+                      bool truncate=false,
+                      unsigned int async_queue_depth=0);
 
         //! Control attribute writes
         void setWriteAttribute(bool b)
@@ -64,6 +97,85 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
             m_write_topology = b;
             }
 
+        //! Control quantized position and orientation output
+        void setQuantize(bool b)
+            {
+            m_quantize = b;
+            }
+
+        bool getQuantize()
+            {
+            return m_quantize;
+            }
+
+        //! Control parallel file I/O
+        void setParallelIO(bool b)
+            {
+            if (b && m_async_queue_depth > 0)
+                throw std::invalid_argument("GSD: parallel I/O cannot be combined with asynchronous output");
+            m_parallel_io = b;
+            }
+
+        bool getParallelIO()
+            {
+            return m_parallel_io;
+            }
+
+        //! Control atomic replacement of the file with each frame
+        void setAtomic(bool b)
+            {
+            m_atomic = b;
+            }
+
+        bool getAtomic()
+            {
+            return m_atomic;
+            }
+
+        //! Control integrator state writes
+        void setWriteIntegratorState(bool b)
+            {
+            m_write_integrator_state = b;
+            }
+
+        bool getWriteIntegratorState()
+            {
+            return m_write_integrator_state;
+            }
+
+        //! Restrict the output to the particles inside an axis aligned region
+        /*! \param region None to write all particles in the group, or a (lower, upper) tuple of corners
+        */
+        void setRegion(pybind11::object region)
+            {
+            if (region.is_none())
+                {
+                m_region_set = false;
+                return;
+                }
+
+            pybind11::tuple corners = pybind11::cast<pybind11::tuple>(region);
+            if (pybind11::len(corners) != 2)
+                throw std::invalid_argument("GSD: region must be a (lower, upper) tuple");
+            pybind11::tuple lo = pybind11::cast<pybind11::tuple>(corners[0]);
+            pybind11::tuple hi = pybind11::cast<pybind11::tuple>(corners[1]);
+            if (pybind11::len(lo) != 3 || pybind11::len(hi) != 3)
+                throw std::invalid_argument("GSD: region corners must have 3 components");
+
+            m_region_lo = make_scalar3(lo[0].cast<Scalar>(), lo[1].cast<Scalar>(), lo[2].cast<Scalar>());
+            m_region_hi = make_scalar3(hi[0].cast<Scalar>(), hi[1].cast<Scalar>(), hi[2].cast<Scalar>());
+            m_region_set = true;
+            }
+
+        //! Get the output region
+        pybind11::object getRegion()
+            {
+            if (!m_region_set)
+                return pybind11::none();
+            return pybind11::make_tuple(pybind11::make_tuple(m_region_lo.x, m_region_lo.y, m_region_lo.z),
+                                        pybind11::make_tuple(m_region_hi.x, m_region_hi.y, m_region_hi.z));
+            }
+
         std::string getFilename()
             {
             return m_fname;
@@ -79,6 +191,11 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
             return m_truncate;
             }
 
+        unsigned int getAsyncQueueDepth()
+            {
+            return m_async_queue_depth;
+            }
+
         std::shared_ptr<ParticleGroup> getGroup()
             {
             return m_group;
@@ -105,7 +222,15 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         //! Write out the data for the current timestep
         void analyze(unsigned int timestep);
 
-        hoomd::detail::SharedSignal<int (gsd_handle&)>& getWriteSignal() { return m_write_signal; }
+        //! Wait for all queued frames to be written
+        virtual void flush();
+
+        hoomd::detail::SharedSignal<int (gsd_handle&)>& getWriteSignal()
+            {
+            // slots write to m_handle directly, which is only safe when frames are written synchronously
+            m_write_signal_used = true;
+            return m_write_signal;
+            }
 
         /// Write a logged quantities
         void writeLogQuantities(pybind11::dict dict);
@@ -127,14 +252,22 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
             {
             PDataFlags flags;
 
+            // request only the flags that the logged quantities need
             if (!m_log_writer.is_none())
                 {
-                flags.set();
+                for (auto flag: m_log_writer.attr("flags"))
+                    flags.set(flag.cast<size_t>());
                 }
 
             return flags;
             }
 
+        /// Get the particle data arrays read on the host, all of them are written to the frame
+        virtual HostArrays getRequestedHostArrays()
+            {
+            return HostArrays().set();
+            }
+
 
     private:
         std::string m_fname;                //!< The file name we are writing to
@@ -145,7 +278,47 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         bool m_write_property;              //!< True if properties should be written
         bool m_write_momentum;              //!< True if momenta should be written
         bool m_write_topology;              //!< True if topology should be written
+        bool m_parallel_io;                 //!< True if ranks should write their particles with MPI-IO
+        bool m_quantize;                    //!< True if positions and orientations are stored in 16-bit fixed point
+        bool m_atomic;                      //!< True if each frame replaces the file through a temporary file
+        bool m_write_integrator_state;      //!< True if the integrator variables should be written
+        bool m_region_set;                  //!< True if only the group members inside the region are written
+        Scalar3 m_region_lo;                //!< Lower corner of the region
+        Scalar3 m_region_hi;                //!< Upper corner of the region
+        std::vector<unsigned int> m_frame_tags; //!< Tags of the particles in the current frame, ascending (root only)
         gsd_handle m_handle;                //!< Handle to the file
+        uint64_t m_nframes;                 //!< Number of frames in the file, including queued frames
+
+        //! A data chunk staged for writing
+        struct Chunk
+            {
+            std::string name;               //!< Chunk name
+            gsd_type type;                  //!< Data type
+            uint64_t N;                     //!< Number of rows
+            uint32_t M;                     //!< Number of columns
+            std::vector<char> data;         //!< Copy of the data
+            };
+
+        //! A frame staged for writing
+        struct Frame
+            {
+            bool truncate = false;          //!< True if the file should be truncated before writing the frame
+            bool atomic = false;            //!< True if the frame is written to a new file that replaces m_fname
+            std::vector<Chunk> chunks;      //!< Chunks in the frame
+            };
+
+        unsigned int m_async_queue_depth;   //!< Maximum number of frames waiting to be written, 0 for synchronous
+        bool m_write_signal_used;           //!< True once a slot may have connected to m_write_signal
+        bool m_stage;                       //!< True when the current frame goes to m_frame instead of the file
+        Frame m_frame;                      //!< Frame that analyze() is staging
+
+        std::deque<Frame> m_queue;          //!< Frames waiting for the writer thread
+        std::mutex m_queue_mutex;           //!< Protects the members shared with the writer thread
+        std::condition_variable m_queue_cv; //!< Signals changes to m_queue and m_writer_busy
+        std::thread m_writer_thread;        //!< Background thread that writes frames
+        bool m_writer_busy;                 //!< True while the writer thread is writing a frame
+        bool m_writer_stop;                 //!< Set to request the writer thread to exit
+        std::exception_ptr m_writer_error;  //!< Error raised in the writer thread
 
         static std::list<std::string> particle_chunks;
 
@@ -154,17 +327,50 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
 
         std::shared_ptr<ParticleGroup> m_group;   //!< Group to write out to the file
         std::map<std::string, bool> m_nondefault; //!< Map of quantities (true when non-default in frame 0)
+        hoomd::detail::GSDChunkCache m_chunk_cache; //!< Contents of frame 0, to skip unchanged chunks
 
         hoomd::detail::SharedSignal<int (gsd_handle&)> m_write_signal;
 
+        //! Write a data chunk to the file or stage it in m_frame
+        void writeChunk(const char *name, gsd_type type, uint64_t N, uint32_t M, const void *data);
+
+        //! Write a staged frame to the file
+        void writeFrame(const Frame& frame);
+
+        //! Main loop of the writer thread
+        void writerThreadFunc();
+
+        //! Rethrow an error raised in the writer thread
+        void checkWriterError();
+
         //! Write a type mapping out to the file
         void writeTypeMapping(std::string chunk, std::vector< std::string > type_mapping);
 
         //! Initializes the output file for writing
         void initFileIO();
 
+        //! Create and open a new file
+        void createFile(const std::string& fname, bool exclusive);
+
+        //! Get the name of the file that frames are written to
+        std::string getWriteFilename()
+            {
+            return m_atomic ? m_fname + ".tmp" : m_fname;
+            }
+
+        //! Close the temporary file and rename it to m_fname
+        void replaceFile();
+
+        //! Write the integrator variables
+        void writeIntegratorState();
+
+        #ifdef ENABLE_MPI
+        //! Write the domain decomposition
+        void writeDomainDecomposition();
+        #endif
+
         //! Write frame header
-        void writeFrameHeader(unsigned int timestep);
+        void writeFrameHeader(unsigned int timestep, uint32_t N);
 
         //! Write particle attributes
         void writeAttributes(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map);
@@ -175,6 +381,31 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         //! Write particle momenta
         void writeMomenta(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map);
 
+        //! Test if analyze() should write the particle data in parallel
+        bool useParallelIO();
+
+        //! Test if analyze() should select the written particles on each rank
+        bool useSubset();
+
+        //! Gather only the selected particles into a snapshot on the root rank
+        void takeSubsetSnapshot(SnapshotParticleData<float>& snapshot, std::map<unsigned int, unsigned int>& map);
+
+#ifdef ENABLE_MPI
+        //! Write the particle chunks from all ranks with MPI-IO
+        void writeParticlesMPI(uint64_t nframes);
+
+        //! Write one chunk of local particle data with MPI-IO
+        void writeChunkMPI(MPI_File fh,
+                           const std::vector<int>& offsets,
+                           const char *name,
+                           gsd_type type,
+                           uint32_t M,
+                           const void *data,
+                           bool all_default,
+                           uint64_t nframes,
+                           const char *key=nullptr);
+#endif
+
         //! Write bond topology
         void writeTopology(BondData::Snapshot& bond,
                            AngleData::Snapshot& angle,
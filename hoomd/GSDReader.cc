@@ -5,10 +5,16 @@
 #include "GSDReader.h"
 #include "SnapshotSystemData.h"
 #include "ExecutionConfiguration.h"
+#include "SystemDefinition.h"
 #include "hoomd/extern/gsd.h"
 #include <string.h>
 #include <sstream>
 
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#include <sys/mman.h>
+#endif
+
 #include <stdexcept>
 using namespace std;
 using namespace hoomd::detail;
@@ -19,6 +25,7 @@ namespace py = pybind11;
     \param name File name to read
     \param frame Frame index to read from the file
     \param from_end Count frames back from the end of the file
+    \param parallel_io Leave the particles and topology for readParticlesParallel()
 
     The GSDReader constructor opens the GSD file, initializes an empty snapshot, and reads the file into
     memory (on the root rank).
@@ -26,10 +33,18 @@ namespace py = pybind11;
 GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                      const std::string &name,
                      const uint64_t frame,
-                     bool from_end)
-    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame)
+                     bool from_end,
+                     bool parallel_io)
+    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame), m_open(false),
+      m_parallel_io(parallel_io), m_N(0)
     {
     m_snapshot = std::shared_ptr< SnapshotSystemData<float> >(new SnapshotSystemData<float>);
+    m_topology = std::shared_ptr< SnapshotSystemData<float> >(new SnapshotSystemData<float>);
+
+    #ifndef ENABLE_MPI
+    // there is only one rank, which reads all particles into the snapshot
+    m_parallel_io = false;
+    #endif
 
     #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
@@ -43,6 +58,7 @@ GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
     m_exec_conf->msg->notice(3) << "data.gsd_snapshot: open gsd file " << name << endl;
     int retval = gsd_open(&m_handle, name.c_str(), GSD_OPEN_READONLY);
     GSDUtils::checkError(retval, m_name);
+    m_open = true;
 
     // validate schema
     if (string(m_handle.header.schema) != string("hoomd"))
@@ -70,20 +86,56 @@ GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
 
     readHeader();
     readParticles();
-    readTopology();
+    readIntegratorState();
+    readDomainDecomposition();
+
+    // bonded groups may only be added after their particles, which readParticlesParallel() adds later
+    if (m_parallel_io)
+        readTopology(*m_topology);
+    else
+        readTopology(*m_snapshot);
     }
 
 GSDReader::~GSDReader()
     {
-    #ifdef ENABLE_MPI
-    // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
+    if (m_open)
+        gsd_close(&m_handle);
+    }
+
+/*! \param frame Frame index to read from
+    \param name Name of the data chunk
+    \param cur_n N in the current frame.
+
+    Find the data chunk of the given name at the given frame, or at frame 0 when it is not present at this frame.
+    Return NULL when neither frame has it, or when its N does not match the current N.
+*/
+const gsd_index_entry* GSDReader::findChunk(uint64_t frame, const char *name, unsigned int cur_n)
+    {
+    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, frame, name);
+    if (entry == NULL && frame != 0)
+        entry = gsd_find_chunk(&m_handle, 0, name);
+
+    if (entry == NULL || (cur_n != 0 && entry->N != cur_n))
         {
-        return;
+        m_exec_conf->msg->notice(10) << "data.gsd_snapshot: chunk not found " << name << endl;
+        return NULL;
         }
-    #endif
 
-    gsd_close(&m_handle);
+    return entry;
+    }
+
+/*! \param entry Data chunk to check
+    \param name Name of the data chunk
+    \param expected_size Expected size of the data chunk in bytes.
+*/
+void GSDReader::checkChunkSize(const gsd_index_entry* entry, const char *name, size_t expected_size)
+    {
+    size_t actual_size = entry->N * entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+    if (actual_size != expected_size)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Expecting " << expected_size << " bytes in " << name << " but found " << actual_size << endl;
+        throw runtime_error("Error reading GSD file");
+        }
     }
 
 /*! \param data Pointer to data to read into
@@ -102,24 +154,16 @@ GSDReader::~GSDReader()
 */
 bool GSDReader::readChunk(void *data, uint64_t frame, const char *name, size_t expected_size, unsigned int cur_n)
     {
-    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, frame, name);
-    if (entry == NULL && frame != 0)
-        entry = gsd_find_chunk(&m_handle, 0, name);
+    const struct gsd_index_entry* entry = findChunk(frame, name, cur_n);
 
-    if (entry == NULL || (cur_n != 0 && entry->N != cur_n))
+    if (entry == NULL)
         {
-        m_exec_conf->msg->notice(10) << "data.gsd_snapshot: chunk not found " << name << endl;
         return false;
         }
     else
         {
         m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading chunk " << name << endl;
-        size_t actual_size = entry->N * entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
-        if (actual_size != expected_size)
-            {
-            m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Expecting " << expected_size << " bytes in " << name << " but found " << actual_size << endl;
-            throw runtime_error("Error reading GSD file");
-            }
+        checkChunkSize(entry, name, expected_size);
         int retval = gsd_read_chunk(&m_handle, data, entry);
         GSDUtils::checkError(retval, m_name);
 
@@ -169,6 +213,50 @@ std::vector<std::string> GSDReader::readTypes(uint64_t frame, const char *name)
         }
     }
 
+/*! \param data Pointer to data to read into
+    \param name Name of the full precision data chunk
+    \param quantized_name Name of the quantized data chunk
+    \param expected_size Expected size of the quantized data chunk in bytes
+    \param cur_n N in the current frame
+
+    GSDDumpWriter writes \a quantized_name in place of \a name when quantization is enabled. Read the quantized
+    chunk from the current frame when it is present there. Otherwise, fall back to the quantized chunk in frame 0 only
+    when \a name is not available in either frame, matching the precedence of readChunk().
+
+    Return true if the quantized data chunk is read from the file.
+*/
+bool GSDReader::readQuantizedChunk(void *data, const char *name, const char *quantized_name, size_t expected_size,
+                                   unsigned int cur_n)
+    {
+    const struct gsd_index_entry* entry = findQuantizedChunk(name, quantized_name, cur_n);
+    if (entry == NULL)
+        return false;
+
+    return readChunk(data, entry->frame, quantized_name, expected_size, cur_n);
+    }
+
+/*! \param name Name of the full precision data chunk
+    \param quantized_name Name of the quantized data chunk
+    \param cur_n N in the current frame
+
+    Return the quantized data chunk that readQuantizedChunk() reads, or NULL when it reads none.
+*/
+const gsd_index_entry* GSDReader::findQuantizedChunk(const char *name, const char *quantized_name,
+                                                     unsigned int cur_n)
+    {
+    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, m_frame, quantized_name);
+    if (entry == NULL && m_frame != 0 && gsd_find_chunk(&m_handle, m_frame, name) == NULL
+        && gsd_find_chunk(&m_handle, 0, name) == NULL)
+        {
+        entry = gsd_find_chunk(&m_handle, 0, quantized_name);
+        }
+
+    if (entry == NULL || entry->N != cur_n)
+        return NULL;
+
+    return entry;
+    }
+
 /*! Read the same data chunks written by GSDDumpWriter::writeFrameHeader
 */
 void GSDReader::readHeader()
@@ -191,7 +279,123 @@ void GSDReader::readHeader()
         m_exec_conf->msg->error() << "data.gsd_snapshot: " << "cannot read a file with 0 particles" << endl;
         throw runtime_error("Error reading GSD file");
         }
-    m_snapshot->particle_data.resize(N);
+    m_N = N;
+
+    // with parallel_io, readParticlesParallel() adds the particles directly to the particle data
+    if (!m_parallel_io)
+        m_snapshot->particle_data.resize(N);
+    }
+
+/*! Read the integrator variables that GSDDumpWriter stores in state/hoomd/integrator/ chunks. Files without them leave
+    m_integrator_variables empty.
+*/
+void GSDReader::readIntegratorState()
+    {
+    std::vector<std::string> types = readTypes(m_frame, "state/hoomd/integrator/type");
+    if (types.empty())
+        return;
+
+    unsigned int n = (unsigned int)types.size();
+    std::vector<uint32_t> counts(n);
+    if (!readChunk(&counts[0], m_frame, "state/hoomd/integrator/N", n*4, n))
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "state/hoomd/integrator/N is missing" << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    size_t total = 0;
+    for (unsigned int i = 0; i < n; i++)
+        total += counts[i];
+
+    std::vector<double> variables(total);
+    if (total > 0)
+        readChunk(&variables[0], m_frame, "state/hoomd/integrator/variables", total*8);
+
+    m_integrator_variables.resize(n);
+    size_t offset = 0;
+    for (unsigned int i = 0; i < n; i++)
+        {
+        m_integrator_variables[i].type = types[i];
+        m_integrator_variables[i].variable.assign(variables.begin() + offset, variables.begin() + offset + counts[i]);
+        offset += counts[i];
+        }
+    }
+
+/*! Read state/hoomd/domain/grid and the cumulative fractions of the box along each direction, as written by
+    GSDDumpWriter with the integrator state. Leaves m_domain_grid empty when the frame has no domain decomposition.
+*/
+void GSDReader::readDomainDecomposition()
+    {
+    uint32_t grid[3];
+    if (!readChunk(grid, m_frame, "state/hoomd/domain/grid", 3*4, 3))
+        return;
+
+    const char *names[3] = {"state/hoomd/domain/cumulative_x",
+                            "state/hoomd/domain/cumulative_y",
+                            "state/hoomd/domain/cumulative_z"};
+    for (unsigned int dir = 0; dir < 3; dir++)
+        {
+        m_domain_cum_frac[dir].resize(grid[dir] + 1);
+        if (!readChunk(&m_domain_cum_frac[dir][0], m_frame, names[dir], (grid[dir] + 1)*8))
+            {
+            m_exec_conf->msg->error() << "data.gsd_snapshot: " << names[dir] << " is missing" << endl;
+            throw runtime_error("Error reading GSD file");
+            }
+        }
+    m_domain_grid.assign(grid, grid + 3);
+    }
+
+/*! \returns None when the frame stores no domain decomposition, otherwise a tuple of the grid (nx, ny, nz) and the
+    lists of cumulative fractions along x, y, and z
+*/
+pybind11::object GSDReader::getDomainDecomposition()
+    {
+    std::vector<unsigned int> grid = m_domain_grid;
+    std::vector<double> cum_frac[3] = {m_domain_cum_frac[0], m_domain_cum_frac[1], m_domain_cum_frac[2]};
+
+    #ifdef ENABLE_MPI
+    // the domains are only read on the root rank
+    bcast(grid, 0, m_exec_conf->getMPICommunicator());
+    for (unsigned int dir = 0; dir < 3; dir++)
+        bcast(cum_frac[dir], 0, m_exec_conf->getMPICommunicator());
+    #endif
+
+    if (grid.empty())
+        return pybind11::none();
+
+    pybind11::list cum_frac_list[3];
+    for (unsigned int dir = 0; dir < 3; dir++)
+        {
+        for (auto f : cum_frac[dir])
+            cum_frac_list[dir].append(f);
+        }
+
+    return pybind11::make_tuple(pybind11::make_tuple(grid[0], grid[1], grid[2]),
+                                cum_frac_list[0],
+                                cum_frac_list[1],
+                                cum_frac_list[2]);
+    }
+
+/*! \param sysdef System definition to restore the integrator variables into
+
+    Integrators constructed afterwards in the same order as in the simulation that wrote the file continue with the
+    stored thermostat and barostat variables. See IntegratorData::restore().
+*/
+void GSDReader::restoreIntegratorData(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    std::vector<IntegratorVariables> variables = m_integrator_variables;
+
+    #ifdef ENABLE_MPI
+    // the variables are only read on the root rank
+    bcast(variables, 0, m_exec_conf->getMPICommunicator());
+    #endif
+
+    if (!variables.empty())
+        {
+        m_exec_conf->msg->notice(3) << "data.gsd_snapshot: restoring " << variables.size()
+                                    << " integrator variable sets" << endl;
+        sysdef->getIntegratorData()->restore(variables);
+        }
     }
 
 /*! Read the same data chunks for particles
@@ -201,6 +405,9 @@ void GSDReader::readParticles()
     unsigned int N = m_snapshot->particle_data.size;
     m_snapshot->particle_data.type_mapping = readTypes(m_frame, "particles/types");
 
+    if (m_parallel_io)
+        return;
+
     // the snapshot already has default values, if a chunk is not found, the value
     // is already at the default, and the failed read is not a problem
     readChunk(&m_snapshot->particle_data.type[0], m_frame, "particles/typeid", N*4, N);
@@ -209,68 +416,109 @@ void GSDReader::readParticles()
     readChunk(&m_snapshot->particle_data.diameter[0], m_frame, "particles/diameter", N*4, N);
     readChunk(&m_snapshot->particle_data.body[0], m_frame, "particles/body", N*4, N);
     readChunk(&m_snapshot->particle_data.inertia[0], m_frame, "particles/moment_inertia", N*12, N);
-    readChunk(&m_snapshot->particle_data.pos[0], m_frame, "particles/position", N*12, N);
-    readChunk(&m_snapshot->particle_data.orientation[0], m_frame, "particles/orientation", N*16, N);
+
+    std::vector<uint16_t> qpos(uint64_t(N)*3);
+    if (readQuantizedChunk(&qpos[0], "particles/position", "particles/quantized/position", N*6, N))
+        {
+        const BoxDim& box = m_snapshot->global_box;
+        for (unsigned int i = 0; i < N; i++)
+            {
+            Scalar3 f = make_scalar3(GSDUtils::dequantizeFraction(qpos[i*3+0]),
+                                     GSDUtils::dequantizeFraction(qpos[i*3+1]),
+                                     GSDUtils::dequantizeFraction(qpos[i*3+2]));
+            Scalar3 pos = box.makeCoordinates(f);
+            if (m_snapshot->dimensions == 2)
+                pos.z = 0;
+            m_snapshot->particle_data.pos[i] = vec3<float>(float(pos.x), float(pos.y), float(pos.z));
+            }
+        }
+    else
+        {
+        readChunk(&m_snapshot->particle_data.pos[0], m_frame, "particles/position", N*12, N);
+        }
+
+    std::vector<int16_t> qorientation(uint64_t(N)*4);
+    if (readQuantizedChunk(&qorientation[0], "particles/orientation", "particles/quantized/orientation", N*8, N))
+        {
+        for (unsigned int i = 0; i < N; i++)
+            {
+            quat<float> q(float(GSDUtils::dequantizeUnit(qorientation[i*4+0])),
+                          vec3<float>(float(GSDUtils::dequantizeUnit(qorientation[i*4+1])),
+                                      float(GSDUtils::dequantizeUnit(qorientation[i*4+2])),
+                                      float(GSDUtils::dequantizeUnit(qorientation[i*4+3]))));
+            float n = fast::sqrt(norm2(q));
+            if (n > 0)
+                q = q * (float(1.0) / n);
+            m_snapshot->particle_data.orientation[i] = q;
+            }
+        }
+    else
+        {
+        readChunk(&m_snapshot->particle_data.orientation[0], m_frame, "particles/orientation", N*16, N);
+        }
+
     readChunk(&m_snapshot->particle_data.vel[0], m_frame, "particles/velocity", N*12, N);
     readChunk(&m_snapshot->particle_data.angmom[0], m_frame, "particles/angmom", N*16, N);
     readChunk(&m_snapshot->particle_data.image[0], m_frame, "particles/image", N*12, N);
     }
 
-/*! Read the same data chunks for topology
+/*! \param snapshot Snapshot to read the topology into
+
+    Read the same data chunks for topology
 */
-void GSDReader::readTopology()
+void GSDReader::readTopology(SnapshotSystemData<float>& snapshot)
     {
     unsigned int N = 0;
     readChunk(&N, m_frame, "bonds/N", 4);
     if (N > 0)
         {
-        m_snapshot->bond_data.resize(N);
-        m_snapshot->bond_data.type_mapping = readTypes(m_frame, "bonds/types");
-        readChunk(&m_snapshot->bond_data.type_id[0], m_frame, "bonds/typeid", N*4, N);
-        readChunk(&m_snapshot->bond_data.groups[0], m_frame, "bonds/group", N*8, N);
+        snapshot.bond_data.resize(N);
+        snapshot.bond_data.type_mapping = readTypes(m_frame, "bonds/types");
+        readChunk(&snapshot.bond_data.type_id[0], m_frame, "bonds/typeid", N*4, N);
+        readChunk(&snapshot.bond_data.groups[0], m_frame, "bonds/group", N*8, N);
         }
 
     N = 0;
     readChunk(&N, m_frame, "angles/N", 4);
     if (N > 0)
         {
-        m_snapshot->angle_data.resize(N);
-        m_snapshot->angle_data.type_mapping = readTypes(m_frame, "angles/types");
-        readChunk(&m_snapshot->angle_data.type_id[0], m_frame, "angles/typeid", N*4, N);
-        readChunk(&m_snapshot->angle_data.groups[0], m_frame, "angles/group", N*12, N);
+        snapshot.angle_data.resize(N);
+        snapshot.angle_data.type_mapping = readTypes(m_frame, "angles/types");
+        readChunk(&snapshot.angle_data.type_id[0], m_frame, "angles/typeid", N*4, N);
+        readChunk(&snapshot.angle_data.groups[0], m_frame, "angles/group", N*12, N);
         }
 
     N = 0;
     readChunk(&N, m_frame, "dihedrals/N", 4);
     if (N > 0)
         {
-        m_snapshot->dihedral_data.resize(N);
-        m_snapshot->dihedral_data.type_mapping = readTypes(m_frame, "dihedrals/types");
-        readChunk(&m_snapshot->dihedral_data.type_id[0], m_frame, "dihedrals/typeid", N*4, N);
-        readChunk(&m_snapshot->dihedral_data.groups[0], m_frame, "dihedrals/group", N*16, N);
+        snapshot.dihedral_data.resize(N);
+        snapshot.dihedral_data.type_mapping = readTypes(m_frame, "dihedrals/types");
+        readChunk(&snapshot.dihedral_data.type_id[0], m_frame, "dihedrals/typeid", N*4, N);
+        readChunk(&snapshot.dihedral_data.groups[0], m_frame, "dihedrals/group", N*16, N);
         }
 
     N = 0;
     readChunk(&N, m_frame, "impropers/N", 4);
     if (N > 0)
         {
-        m_snapshot->improper_data.resize(N);
-        m_snapshot->improper_data.type_mapping = readTypes(m_frame, "impropers/types");
-        readChunk(&m_snapshot->improper_data.type_id[0], m_frame, "impropers/typeid", N*4, N);
-        readChunk(&m_snapshot->improper_data.groups[0], m_frame, "impropers/group", N*16, N);
+        snapshot.improper_data.resize(N);
+        snapshot.improper_data.type_mapping = readTypes(m_frame, "impropers/types");
+        readChunk(&snapshot.improper_data.type_id[0], m_frame, "impropers/typeid", N*4, N);
+        readChunk(&snapshot.improper_data.groups[0], m_frame, "impropers/group", N*16, N);
         }
 
     N = 0;
     readChunk(&N, m_frame, "constraints/N", 4);
     if (N > 0)
         {
-        m_snapshot->constraint_data.resize(N);
+        snapshot.constraint_data.resize(N);
         std::vector<float> data(N);
         readChunk(&data[0], m_frame, "constraints/value", N*4, N);
         for (unsigned int i=0; i < N; i++)
-            m_snapshot->constraint_data.val[i] = Scalar(data[i]);
+            snapshot.constraint_data.val[i] = Scalar(data[i]);
 
-        readChunk(&m_snapshot->constraint_data.groups[0], m_frame, "constraints/group", N*8, N);
+        readChunk(&snapshot.constraint_data.groups[0], m_frame, "constraints/group", N*8, N);
         }
 
     if (m_handle.header.schema_version >= gsd_make_version(1,1))
@@ -279,14 +527,242 @@ void GSDReader::readTopology()
         readChunk(&N, m_frame, "pairs/N", 4);
         if (N > 0)
             {
-            m_snapshot->pair_data.resize(N);
-            m_snapshot->pair_data.type_mapping = readTypes(m_frame, "pairs/types");
-            readChunk(&m_snapshot->pair_data.type_id[0], m_frame, "pairs/typeid", N*4, N);
-            readChunk(&m_snapshot->pair_data.groups[0], m_frame, "pairs/group", N*8, N);
+            snapshot.pair_data.resize(N);
+            snapshot.pair_data.type_mapping = readTypes(m_frame, "pairs/types");
+            readChunk(&snapshot.pair_data.type_id[0], m_frame, "pairs/typeid", N*4, N);
+            readChunk(&snapshot.pair_data.groups[0], m_frame, "pairs/group", N*8, N);
             }
         }
     }
 
+#ifdef ENABLE_MPI
+namespace hoomd
+    {
+namespace detail
+    {
+//! Read only memory map of a whole file, unmapped when the object goes out of scope
+class GSDMappedFile
+    {
+    public:
+        GSDMappedFile(int fd, size_t size, const std::string& name)
+            : m_data(nullptr), m_size(size)
+            {
+            if (m_size == 0)
+                return;
+
+            void *data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (data == MAP_FAILED)
+                throw runtime_error("Error memory mapping GSD file " + name);
+            m_data = (const char *)data;
+
+            // ranks read every chunk in increasing particle order
+            madvise(data, m_size, MADV_SEQUENTIAL);
+            }
+
+        ~GSDMappedFile()
+            {
+            if (m_data)
+                munmap((void *)m_data, m_size);
+            }
+
+        GSDMappedFile(const GSDMappedFile&) = delete;
+        GSDMappedFile& operator=(const GSDMappedFile&) = delete;
+
+        //! Get a pointer to the given location in the file
+        const char *get(int64_t location) const
+            {
+            return m_data + location;
+            }
+
+    private:
+        const char *m_data;   //!< Start of the mapping
+        size_t m_size;        //!< Length of the mapping
+    };
+    } // namespace detail
+    } // namespace hoomd
+
+//! Copy the elements of the given particles out of a memory mapped chunk
+/*! \param out Array to copy the elements to
+    \param chunk Start of the chunk in the mapping, may be NULL to keep the defaults in \a out
+    \param element_size Size of the per particle element in bytes
+    \param idx Index of each particle to copy from the chunk
+*/
+static void gatherElements(void *out, const char *chunk, size_t element_size,
+                           const std::vector<unsigned int>& idx)
+    {
+    if (chunk == NULL)
+        return;
+
+    char *dst = (char *)out;
+    for (size_t k = 0; k < idx.size(); k++)
+        memcpy(dst + k * element_size, chunk + size_t(idx[k]) * element_size, element_size);
+    }
+
+/*! \param sysdef System definition built from the snapshot of a GSDReader constructed with parallel_io
+
+    Every rank opens and memory maps the file. Each rank scans the positions and images, places the particles with
+    ParticleData::placeSnapshotParticle() and copies the remaining fields of the particles that it owns straight out
+    of the mapping, so the particle data never passes through the root rank and no rank reads the other fields of
+    particles outside its domain. The root rank then adds the topology held back by the constructor.
+
+    This method is collective.
+*/
+void GSDReader::readParticlesParallel(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    std::shared_ptr<DomainDecomposition> decomposition = pdata->getDomainDecomposition();
+    if (!m_parallel_io || !decomposition)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: parallel reads require parallel_io and a domain decomposition"
+                                  << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    bcast(m_frame, 0, mpi_comm);
+    bcast(m_N, 0, mpi_comm);
+
+    // the constructor opens the file on the root rank only
+    if (!m_open)
+        {
+        m_exec_conf->msg->notice(3) << "data.gsd_snapshot: open gsd file " << m_name << endl;
+        int retval = gsd_open(&m_handle, m_name.c_str(), GSD_OPEN_READONLY);
+        GSDUtils::checkError(retval, m_name);
+        m_open = true;
+        }
+
+    m_exec_conf->msg->notice(7) << "data.gsd_snapshot: mapping " << m_name << endl;
+    GSDMappedFile file(m_handle.fd, size_t(m_handle.file_size), m_name);
+
+    // find the chunks that readParticles() reads, NULL when the defaults apply
+    auto mapped_chunk = [&](const gsd_index_entry* entry, const char *name, size_t element_size) -> const char*
+        {
+        if (entry == NULL)
+            return NULL;
+        checkChunkSize(entry, name, size_t(m_N) * element_size);
+        return file.get(entry->location);
+        };
+    auto find_chunk = [&](const char *name, size_t element_size) -> const char*
+        {
+        return mapped_chunk(findChunk(m_frame, name, m_N), name, element_size);
+        };
+
+    const char *qpos = mapped_chunk(findQuantizedChunk("particles/position", "particles/quantized/position", m_N),
+                                    "particles/quantized/position", 6);
+    const char *pos = qpos ? NULL : find_chunk("particles/position", 12);
+    const char *image = find_chunk("particles/image", 12);
+    const char *qorientation = mapped_chunk(findQuantizedChunk("particles/orientation",
+                                                               "particles/quantized/orientation",
+                                                               m_N),
+                                            "particles/quantized/orientation", 8);
+    const char *orientation = qorientation ? NULL : find_chunk("particles/orientation", 16);
+
+    // place all particles, keep those in the local domain
+    std::vector<unsigned int> local_tags;
+    std::vector<Scalar3> local_pos;
+    std::vector<int3> local_image;
+    const BoxDim& global_box = pdata->getGlobalBox();
+    unsigned int my_rank = m_exec_conf->getRank();
+    unsigned int n_ranks = m_exec_conf->getNRanks();
+
+        {
+        ArrayHandle<unsigned int> h_cart_ranks(decomposition->getCartRanks(), access_location::host,
+                                               access_mode::read);
+
+        for (unsigned int tag = 0; tag < m_N; tag++)
+            {
+            Scalar3 p = make_scalar3(0, 0, 0);
+            if (qpos)
+                {
+                uint16_t q[3];
+                memcpy(q, qpos + size_t(tag) * 6, 6);
+                p = global_box.makeCoordinates(make_scalar3(GSDUtils::dequantizeFraction(q[0]),
+                                                            GSDUtils::dequantizeFraction(q[1]),
+                                                            GSDUtils::dequantizeFraction(q[2])));
+                if (sysdef->getNDimensions() == 2)
+                    p.z = 0;
+                }
+            else if (pos)
+                {
+                float v[3];
+                memcpy(v, pos + size_t(tag) * 12, 12);
+                p = make_scalar3(v[0], v[1], v[2]);
+                }
+
+            int3 img = make_int3(0, 0, 0);
+            if (image)
+                memcpy(&img, image + size_t(tag) * 12, 12);
+
+            unsigned int rank = pdata->placeSnapshotParticle(p, img, h_cart_ranks.data);
+            if (rank >= n_ranks)
+                {
+                m_exec_conf->msg->error() << "data.gsd_snapshot: Particle " << tag << " out of bounds at ("
+                                          << p.x << ", " << p.y << ", " << p.z << ")" << endl;
+                throw runtime_error("Error reading GSD file");
+                }
+
+            if (rank == my_rank)
+                {
+                local_tags.push_back(tag);
+                local_pos.push_back(p);
+                local_image.push_back(img);
+                }
+            }
+        }
+
+    unsigned int n_local = (unsigned int)local_tags.size();
+    DistributedSnapshotParticleData<float> local;
+    local.resize(n_local);
+    local.tag = local_tags;
+    local.nglobal = m_N;
+    for (unsigned int i = 0; i < pdata->getNTypes(); i++)
+        local.type_mapping.push_back(pdata->getNameByType(i));
+
+    for (unsigned int k = 0; k < n_local; k++)
+        {
+        local.pos[k] = vec3<float>(float(local_pos[k].x), float(local_pos[k].y), float(local_pos[k].z));
+        local.image[k] = local_image[k];
+        }
+
+    gatherElements(local.type.data(), find_chunk("particles/typeid", 4), 4, local_tags);
+    gatherElements(local.mass.data(), find_chunk("particles/mass", 4), 4, local_tags);
+    gatherElements(local.charge.data(), find_chunk("particles/charge", 4), 4, local_tags);
+    gatherElements(local.diameter.data(), find_chunk("particles/diameter", 4), 4, local_tags);
+    gatherElements(local.body.data(), find_chunk("particles/body", 4), 4, local_tags);
+    gatherElements(local.inertia.data(), find_chunk("particles/moment_inertia", 12), 12, local_tags);
+    gatherElements(local.orientation.data(), orientation, 16, local_tags);
+    gatherElements(local.vel.data(), find_chunk("particles/velocity", 12), 12, local_tags);
+    gatherElements(local.angmom.data(), find_chunk("particles/angmom", 16), 16, local_tags);
+
+    if (qorientation)
+        {
+        for (unsigned int k = 0; k < n_local; k++)
+            {
+            int16_t q[4];
+            memcpy(q, qorientation + size_t(local_tags[k]) * 8, 8);
+            quat<float> o(float(GSDUtils::dequantizeUnit(q[0])),
+                          vec3<float>(float(GSDUtils::dequantizeUnit(q[1])),
+                                      float(GSDUtils::dequantizeUnit(q[2])),
+                                      float(GSDUtils::dequantizeUnit(q[3]))));
+            float n = fast::sqrt(norm2(o));
+            if (n > 0)
+                o = o * (float(1.0) / n);
+            local.orientation[k] = o;
+            }
+        }
+
+    pdata->initializeFromDistributedSnapshot(local);
+
+    // bonded groups find their particles through the tags, which are now all present
+    sysdef->getBondData()->initializeFromSnapshot(m_topology->bond_data);
+    sysdef->getAngleData()->initializeFromSnapshot(m_topology->angle_data);
+    sysdef->getDihedralData()->initializeFromSnapshot(m_topology->dihedral_data);
+    sysdef->getImproperData()->initializeFromSnapshot(m_topology->improper_data);
+    sysdef->getConstraintData()->initializeFromSnapshot(m_topology->constraint_data);
+    sysdef->getPairData()->initializeFromSnapshot(m_topology->pair_data);
+    }
+#endif
+
 pybind11::list GSDReader::readTypeShapesPy(uint64_t frame)
     {
     std::vector<std::string> type_mapping = this->readTypes(frame, "particles/type_shapes");
@@ -443,11 +919,16 @@ pybind11::array GSDStateReader::readChunk(const std::string& name)
 void export_GSDReader(py::module& m)
     {
     py::class_< GSDReader, std::shared_ptr<GSDReader> >(m,"GSDReader")
-    .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&, const uint64_t, bool>())
+    .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&, const uint64_t, bool, bool>())
     .def("getTimeStep", &GSDReader::getTimeStep)
     .def("getSnapshot", &GSDReader::getSnapshot)
     .def("clearSnapshot", &GSDReader::clearSnapshot)
+    .def("restoreIntegratorData", &GSDReader::restoreIntegratorData)
+    .def("getDomainDecomposition", &GSDReader::getDomainDecomposition)
     .def("readTypeShapesPy", &GSDReader::readTypeShapesPy)
+#ifdef ENABLE_MPI
+    .def("readParticlesParallel", &GSDReader::readParticlesParallel)
+#endif
     ;
 
     py::class_< GSDStateReader, std::shared_ptr<GSDStateReader> >(m, "GSDStateReader")
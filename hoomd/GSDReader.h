@@ -6,6 +6,7 @@
 #endif
 
 #include "ParticleData.h"
+#include "IntegratorData.h"
 #include <string>
 #include "hoomd/extern/gsd.h"
 
@@ -17,11 +18,17 @@
 
 //! Forward declarations
 template <class Real> struct SnapshotSystemData;
+class SystemDefinition;
 
 //! Reads a GSD input file
 /*! Read an input GSD file and generate a system snapshot. GSDReader can read any frame from a GSD
     file into the snapshot. For information on the GSD specification, see http://gsd.readthedocs.io/
 
+    With \a parallel_io, the root rank reads only the header, the particle types, and the topology. The snapshot then
+    holds no particles and no bonded groups. After the system definition is built from it, every rank calls
+    readParticlesParallel(), which memory maps the file and copies the particles in the rank's domain straight from the
+    mapping to the particle data. The particle data never passes through the root rank.
+
     \ingroup data_structs
 */
 class PYBIND11_EXPORT GSDReader
@@ -31,7 +38,8 @@ class PYBIND11_EXPORT GSDReader
         GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                   const std::string &name,
                   const uint64_t frame,
-                  bool from_end);
+                  bool from_end,
+                  bool parallel_io=false);
 
         //! Destructor
         ~GSDReader();
@@ -69,8 +77,26 @@ class PYBIND11_EXPORT GSDReader
         void clearSnapshot()
             {
             m_snapshot.reset();
+            m_topology.reset();
+            }
+
+        //! Test if the particles are read by readParticlesParallel()
+        bool getParallelIO() const
+            {
+            return m_parallel_io;
             }
 
+#ifdef ENABLE_MPI
+        //! Read the particles of each rank's domain and the topology into the system (collective)
+        void readParticlesParallel(std::shared_ptr<SystemDefinition> sysdef);
+#endif
+
+        //! Restore the integrator variables stored in the frame (collective)
+        void restoreIntegratorData(std::shared_ptr<SystemDefinition> sysdef);
+
+        //! Get the domain decomposition stored in the frame (collective)
+        pybind11::object getDomainDecomposition();
+
         //! get handle
         gsd_handle getHandle(void) const
             {
@@ -86,14 +112,36 @@ class PYBIND11_EXPORT GSDReader
         uint64_t m_frame;                                            //!< Cached frame
         std::shared_ptr< SnapshotSystemData<float> > m_snapshot;   //!< The snapshot to read
         gsd_handle m_handle;                                         //!< Handle to the file
+        bool m_open;                                                 //!< True when m_handle is open on this rank
+        bool m_parallel_io;                                          //!< True when each rank reads its particles
+        unsigned int m_N;                                            //!< Number of particles in the frame
+        std::shared_ptr< SnapshotSystemData<float> > m_topology;   //!< Topology held back with parallel_io
+        std::vector<IntegratorVariables> m_integrator_variables;     //!< Integrator variables stored in the frame
+        std::vector<unsigned int> m_domain_grid;                     //!< Domain grid stored in the frame, if any
+        std::vector<double> m_domain_cum_frac[3];                    //!< Cumulative domain fractions in the frame
+
+        //! Find the data chunk that readChunk() reads
+        const gsd_index_entry* findChunk(uint64_t frame, const char *name, unsigned int cur_n);
+
+        //! Find the quantized data chunk that readQuantizedChunk() reads
+        const gsd_index_entry* findQuantizedChunk(const char *name, const char *quantized_name, unsigned int cur_n);
+
+        //! Check that a data chunk has the expected size
+        void checkChunkSize(const gsd_index_entry* entry, const char *name, size_t expected_size);
 
         //! Helper function to read a type list from the file
         std::vector<std::string> readTypes(uint64_t frame, const char *name);
 
+        //! Helper function to read a quantized chunk that replaces a full precision chunk
+        bool readQuantizedChunk(void *data, const char *name, const char *quantized_name, size_t expected_size,
+                                unsigned int cur_n);
+
         // helper functions to read sections of the file
         void readHeader();
         void readParticles();
-        void readTopology();
+        void readTopology(SnapshotSystemData<float>& snapshot);
+        void readIntegratorState();
+        void readDomainDecomposition();
     };
 
 /** Read state information from a GSD file
@@ -29,6 +29,16 @@ class GSDShapeSpecWriter
             std::vector<char> types(max_len * type_shape_mapping.size());
             for (unsigned int i = 0; i < type_shape_mapping.size(); i++)
                 strncpy(&types[max_len*i], type_shape_mapping[i].c_str(), max_len);
+
+            // skip the shapes when they match frame 0, which is where readers look for missing chunks
+            GSDChunkCache *cache = GSDChunkCache::find(handle);
+            if (cache && !cache->needsWrite(gsd_get_nframes(&handle), m_field_name, GSD_TYPE_UINT8,
+                                            type_shape_mapping.size(), max_len, (void *)&types[0]))
+                {
+                m_exec_conf->msg->notice(10) << "GSD: " << m_field_name << " is unchanged since frame 0" << std::endl;
+                return 0;
+                }
+
             int retval = gsd_write_chunk(&handle, m_field_name.c_str(), GSD_TYPE_UINT8, type_shape_mapping.size(), max_len, 0, (void *)&types[0]);
             GSDUtils::checkError(retval, "");
             return retval;
@@ -8,6 +8,10 @@
 #include <cstdio>
 #include <iostream>
 
+#ifdef ENABLE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 namespace py = pybind11;
 
 namespace getardump{
@@ -295,11 +299,19 @@ namespace getardump{
         return needs[(unsigned int) index];
         }
 
+    /// True if writing the property accesses the particle data arrays instead of the snapshot
+    static bool readsParticleArrays(Property prop)
+        {
+        return prop == PotentialEnergy || prop == Virial;
+        }
+
     GetarDumpWriter::GetarDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
-        const std::string &filename, GetarDumpMode operationMode, unsigned int offset):
+        const std::string &filename, GetarDumpMode operationMode, unsigned int offset,
+        unsigned int asyncQueueDepth):
         Analyzer(sysdef), m_archive(), m_periods(), m_offset(offset),
         m_staticRecords(), m_operationMode(operationMode), m_filename(filename),
-        m_tempName(), m_systemSnap(), m_neededSnapshots()
+        m_tempName(), m_systemSnap(), m_neededSnapshots(),
+        m_asyncQueueDepth(asyncQueueDepth), m_writerBusy(false), m_writerStop(false)
         {
         if(m_operationMode == getardump::OneShot)
             {
@@ -326,15 +338,41 @@ namespace getardump{
             }
 
         m_systemSnap = takeSystemSnapshot(m_sysdef);
+
+        // only the root processor writes frames
+        bool root(true);
+#ifdef ENABLE_MPI
+        root = m_exec_conf->isRoot();
+#endif
+        if(root && m_asyncQueueDepth > 0)
+            m_writerThread = std::thread(&GetarDumpWriter::writerThreadFunc, this);
         }
 
     GetarDumpWriter::~GetarDumpWriter()
-        {}
+        {
+        stopWriterThread();
+
+        if(m_writerError)
+            {
+            try
+                {
+                std::rethrow_exception(m_writerError);
+                }
+            catch(std::exception &e)
+                {
+                m_exec_conf->msg->error() << "getar: error writing queued frames: " << e.what() << endl;
+                }
+            }
+        }
 
     void GetarDumpWriter::close()
         {
+        stopWriterThread();
+
         if(m_archive)
             m_archive->close();
+
+        checkWriterError();
         }
 
     void GetarDumpWriter::analyze(unsigned int timestep)
@@ -363,82 +401,227 @@ namespace getardump{
             return;
 #endif
 
-        if(m_operationMode == OneShot)
+        for(PeriodMap::iterator pIter(m_periods.begin());
+            pIter != m_periods.end(); ++pIter)
+            if(!(shiftedTimestep%pIter->first))
+                ranThisStep = true;
+
+        if(!ranThisStep)
+            return;
+
+        const vector<std::pair<const GetarDumpDescription*, unsigned int> > due(dueRecords(timestep));
+
+        if(m_writerThread.joinable())
             {
-            for(PeriodMap::iterator pIter(m_periods.begin());
-                pIter != m_periods.end(); ++pIter)
-                if(!(shiftedTimestep%pIter->first))
-                    ranThisStep = true;
+            checkWriterError();
 
-            if(ranThisStep)
+            // copy the records out of the snapshot, one task per record; the potential energy and virial
+            // are read through ArrayHandles, which must not be acquired concurrently
+            vector<vector<StagedRecord> > parts(due.size());
+            for(size_t i(0); i < due.size(); ++i)
                 {
-                m_archive.reset(new GTAR(m_tempName, gtar::Write));
+                if(readsParticleArrays(due[i].first->m_prop))
                     {
-                    GTAR::BulkWriter writer(*m_archive);
-
-                    for(PeriodMap::iterator pIter(m_periods.begin());
-                        pIter != m_periods.end(); ++pIter)
-                        {
-                        if(!(shiftedTimestep%pIter->first))
-                            {
-                            for(vector<GetarDumpDescription>::iterator dIter(pIter->second.begin());
-                                dIter != pIter->second.end(); ++dIter)
-                                {
-                                write(writer, *dIter, timestep);
-                                // const Property prop(dIter->m_prop);
-                                // const Resolution res(dIter->m_res);
-
-                                // string path(dIter->getFormattedPath(timestep));
-                                }
-                            }
-                        }
-
-                    for(vector<GetarDumpDescription>::const_iterator iter(m_staticRecords.begin());
-                        iter != m_staticRecords.end(); ++iter)
-                        write(writer, *iter, 0);
-
+                    RecordWriter writer(parts[i]);
+                    write(writer, *due[i].first, due[i].second);
                     }
+                }
 
-                m_archive.reset();
-                int result(rename(m_tempName.c_str(), m_filename.c_str()));
-
-                if(result)
+#ifdef ENABLE_TBB
+            tbb::parallel_for(size_t(0), due.size(), [&](size_t i)
+#else
+            for(size_t i(0); i < due.size(); ++i)
+#endif
+                {
+                if(!readsParticleArrays(due[i].first->m_prop))
                     {
-                    stringstream msg;
-                    msg << "Error " << result << " in one-shot file: " << strerror(result);
-                    m_exec_conf->msg->error() << msg.str() << endl;
-                    throw runtime_error(msg.str());
+                    RecordWriter writer(parts[i]);
+                    write(writer, *due[i].first, due[i].second);
                     }
                 }
+#ifdef ENABLE_TBB
+                );
+#endif
+
+            Frame frame;
+            for(size_t i(0); i < parts.size(); ++i)
+                {
+                for(size_t j(0); j < parts[i].size(); ++j)
+                    frame.records.push_back(std::move(parts[i][j]));
+                }
+
+                {
+                std::unique_lock<std::mutex> lock(m_queueMutex);
+                m_queueCV.wait(lock, [this]{ return m_queue.size() < m_asyncQueueDepth || m_writerError; });
+                if(!m_writerError)
+                    m_queue.push_back(std::move(frame));
+                }
+            m_queueCV.notify_all();
+            checkWriterError();
+            }
+        else if(m_operationMode == OneShot)
+            {
+            m_archive.reset(new GTAR(m_tempName, gtar::Write));
+                {
+                GTAR::BulkWriter bulkWriter(*m_archive);
+                RecordWriter writer(bulkWriter);
+
+                for(size_t i(0); i < due.size(); ++i)
+                    write(writer, *due[i].first, due[i].second);
+                }
+
+            m_archive.reset();
+            renameOneShot();
             }
         else if(m_archive)
             {
-            GTAR::BulkWriter writer(*m_archive);
+            GTAR::BulkWriter bulkWriter(*m_archive);
+            RecordWriter writer(bulkWriter);
+
+            for(size_t i(0); i < due.size(); ++i)
+                write(writer, *due[i].first, due[i].second);
+            }
+        }
 
-            for(PeriodMap::iterator pIter(m_periods.begin());
-                pIter != m_periods.end(); ++pIter)
+    vector<std::pair<const GetarDumpDescription*, unsigned int> > GetarDumpWriter::dueRecords(
+        unsigned int timestep) const
+        {
+        const unsigned int shiftedTimestep(timestep - m_offset);
+        vector<std::pair<const GetarDumpDescription*, unsigned int> > result;
+
+        for(PeriodMap::const_iterator pIter(m_periods.begin());
+            pIter != m_periods.end(); ++pIter)
+            {
+            if(!(shiftedTimestep%pIter->first))
                 {
-                if(!(shiftedTimestep%pIter->first))
-                    {
-                    ranThisStep = true;
+                for(vector<GetarDumpDescription>::const_iterator dIter(pIter->second.begin());
+                    dIter != pIter->second.end(); ++dIter)
+                    result.push_back(std::make_pair(&*dIter, timestep));
+                }
+            }
 
-                    for(vector<GetarDumpDescription>::iterator dIter(pIter->second.begin());
-                        dIter != pIter->second.end(); ++dIter)
-                        {
-                        write(writer, *dIter, timestep);
-                        // const Property prop(dIter->m_prop);
-                        // const Resolution res(dIter->m_res);
+        // one-shot files are rewritten from scratch, so they need the static records every time
+        if(m_operationMode == OneShot)
+            {
+            for(vector<GetarDumpDescription>::const_iterator iter(m_staticRecords.begin());
+                iter != m_staticRecords.end(); ++iter)
+                result.push_back(std::make_pair(&*iter, 0u));
+            }
 
-                        // string path(dIter->getFormattedPath(timestep));
-                        }
-                    }
+        return result;
+        }
+
+    void GetarDumpWriter::renameOneShot()
+        {
+        int result(rename(m_tempName.c_str(), m_filename.c_str()));
+
+        if(result)
+            {
+            stringstream msg;
+            msg << "Error " << result << " in one-shot file: " << strerror(result);
+            m_exec_conf->msg->error() << msg.str() << endl;
+            throw runtime_error(msg.str());
+            }
+        }
+
+    void GetarDumpWriter::flush()
+        {
+        if(m_writerThread.joinable())
+            {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCV.wait(lock, [this]{ return m_queue.empty() && !m_writerBusy; });
+            }
+        checkWriterError();
+        }
+
+    void GetarDumpWriter::writeFrame(const Frame &frame)
+        {
+        if(m_operationMode == OneShot)
+            {
+            GTAR archive(m_tempName, gtar::Write);
+                {
+                GTAR::BulkWriter writer(archive);
+                for(vector<StagedRecord>::const_iterator iter(frame.records.begin());
+                    iter != frame.records.end(); ++iter)
+                    writer.writePtr(iter->path, iter->bytes.data(), iter->bytes.size(), iter->mode);
                 }
+            archive.close();
+            renameOneShot();
+            }
+        else if(m_archive)
+            {
+            GTAR::BulkWriter writer(*m_archive);
+            for(vector<StagedRecord>::const_iterator iter(frame.records.begin());
+                iter != frame.records.end(); ++iter)
+                writer.writePtr(iter->path, iter->bytes.data(), iter->bytes.size(), iter->mode);
             }
         }
 
-    void GetarDumpWriter::write(GTAR::BulkWriter &writer, const GetarDumpDescription &desc, unsigned int timestep)
+    void GetarDumpWriter::writerThreadFunc()
         {
-        if(!m_archive)
+        std::unique_lock<std::mutex> lock(m_queueMutex);
+        while(true)
+            {
+            m_queueCV.wait(lock, [this]{ return m_writerStop || !m_queue.empty(); });
+            if(m_queue.empty())
+                break;
+
+            Frame frame(std::move(m_queue.front()));
+            m_queue.pop_front();
+            m_writerBusy = true;
+            lock.unlock();
+            m_queueCV.notify_all();
+
+            std::exception_ptr error;
+            try
+                {
+                writeFrame(frame);
+                }
+            catch(...)
+                {
+                error = std::current_exception();
+                }
+
+            lock.lock();
+            if(error)
+                {
+                m_writerError = error;
+                m_queue.clear();
+                }
+            m_writerBusy = false;
+            m_queueCV.notify_all();
+            }
+        }
+
+    void GetarDumpWriter::stopWriterThread()
+        {
+        if(!m_writerThread.joinable())
+            return;
+
+        // the writer thread writes all queued frames before it exits
+            {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_writerStop = true;
+            }
+        m_queueCV.notify_all();
+        m_writerThread.join();
+        }
+
+    void GetarDumpWriter::checkWriterError()
+        {
+        std::exception_ptr error;
+            {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            std::swap(error, m_writerError);
+            }
+
+        if(error)
+            std::rethrow_exception(error);
+        }
+
+    void GetarDumpWriter::write(RecordWriter &writer, const GetarDumpDescription &desc, unsigned int timestep)
+        {
+        if(!writer.isStaging() && !m_archive)
             return;
 
         if(desc.m_res == Individual)
@@ -449,7 +632,7 @@ namespace getardump{
             writeUniform(writer, desc, timestep);
         }
 
-    void GetarDumpWriter::writeIndividual(GTAR::BulkWriter &writer, const GetarDumpDescription &desc, unsigned int timestep)
+    void GetarDumpWriter::writeIndividual(RecordWriter &writer, const GetarDumpDescription &desc, unsigned int timestep)
         {
         if(desc.m_prop == AngularMomentum)
             {
@@ -720,7 +903,7 @@ namespace getardump{
             }
         }
 
-    void GetarDumpWriter::writeUniform(GTAR::BulkWriter &writer, const GetarDumpDescription &desc, unsigned int timestep)
+    void GetarDumpWriter::writeUniform(RecordWriter &writer, const GetarDumpDescription &desc, unsigned int timestep)
         {
         if(desc.m_prop == Box)
             {
@@ -757,7 +940,7 @@ namespace getardump{
             }
         }
 
-    void GetarDumpWriter::writeText(GTAR::BulkWriter &writer, const GetarDumpDescription &desc, unsigned int timestep)
+    void GetarDumpWriter::writeText(RecordWriter &writer, const GetarDumpDescription &desc, unsigned int timestep)
         {
         if(desc.m_prop == TypeNames)
             {
@@ -824,9 +1007,12 @@ namespace getardump{
         if(behavior == Constant)
             {
             m_staticRecords.push_back(desc);
+            // static records go straight into the archive, after any queued frames
+            flush();
             if(m_archive)
                 {
-                GTAR::BulkWriter writer(*m_archive);
+                GTAR::BulkWriter bulkWriter(*m_archive);
+                RecordWriter writer(bulkWriter);
                 write(writer, desc, 0);
                 }
             }
@@ -886,6 +1072,8 @@ namespace getardump{
             rec = gtar::Record("", name, conv.str(), gtar::Discrete, gtar::UInt8, gtar::Text);
             }
 
+        flush();
+
 #ifdef ENABLE_MPI
         // only write on root rank
         if (m_exec_conf->isRoot())
@@ -896,7 +1084,9 @@ namespace getardump{
     void export_GetarDumpWriter(py::module& m)
         {
         py::class_<GetarDumpWriter, Analyzer, std::shared_ptr<GetarDumpWriter> >(m,"GetarDumpWriter")
-            .def(py::init< std::shared_ptr<SystemDefinition>, std::string, getardump::GetarDumpMode, unsigned int>())
+            .def(py::init< std::shared_ptr<SystemDefinition>, std::string, getardump::GetarDumpMode, unsigned int,
+                           unsigned int>())
+            .def("flush", &GetarDumpWriter::flush)
             .def("close", &GetarDumpWriter::close)
             .def("getPeriod", &GetarDumpWriter::getPeriod)
             .def("setPeriod", &GetarDumpWriter::setPeriod)
@@ -11,8 +11,14 @@
 #include "hoomd/GetarDumpIterators.h"
 #include <memory>
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #ifndef __HIPCC__
@@ -209,7 +215,105 @@ namespace getardump{
             std::string m_suffix;
         };
 
+    /// A record whose data has been copied out of the system snapshot
+    struct StagedRecord
+        {
+        /// Path of the record in the archive
+        std::string path;
+        /// Raw bytes of the record
+        std::vector<char> bytes;
+        /// Compression mode for the record
+        gtar::CompressMode mode;
+        };
+
+    /// Writes records either through a BulkWriter or into a list of
+    /// staged records, which are written later by the background thread
+    ///
+    /// The write methods mirror those of gtar::GTAR::BulkWriter.
+    class RecordWriter
+        {
+        public:
+            /// Write records immediately through the given bulk writer
+            RecordWriter(gtar::GTAR::BulkWriter &writer):
+                m_writer(&writer), m_records(nullptr)
+                {}
+
+            /// Copy records into the given list
+            RecordWriter(std::vector<StagedRecord> &records):
+                m_writer(nullptr), m_records(&records)
+                {}
+
+            /// True if records are staged instead of written
+            bool isStaging() const
+                {
+                return m_records != nullptr;
+                }
+
+            /// Write a string record
+            void writeString(const std::string &path, const std::string &contents,
+                gtar::CompressMode mode)
+                {
+                if(m_writer)
+                    m_writer->writeString(path, contents, mode);
+                else
+                    stage(path, contents.data(), contents.size(), mode);
+                }
+
+            /// Write an individual record, converting each element to T
+            template<typename iter, typename T>
+            void writeIndividual(const std::string &path, iter start, iter end,
+                gtar::CompressMode mode)
+                {
+                if(m_writer)
+                    {
+                    m_writer->writeIndividual<iter, T>(path, start, end, mode);
+                    return;
+                    }
+
+                std::vector<T> values;
+                for(; start != end; ++start)
+                    values.push_back(T(*start));
+                stage(path, values.data(), values.size()*sizeof(T), mode);
+                }
+
+            /// Write a uniform record (uncompressed, as BulkWriter does)
+            template<typename T>
+            void writeUniform(const std::string &path, const T &val)
+                {
+                if(m_writer)
+                    m_writer->writeUniform<T>(path, val);
+                else
+                    stage(path, &val, sizeof(T), gtar::NoCompress);
+                }
+
+        private:
+            /// Append a copy of the given bytes to the staged records
+            void stage(const std::string &path, const void *data, size_t size,
+                gtar::CompressMode mode)
+                {
+                const char *bytes(static_cast<const char*>(data));
+                StagedRecord record;
+                record.path = path;
+                record.bytes.assign(bytes, bytes + size);
+                record.mode = mode;
+                m_records->push_back(std::move(record));
+                }
+
+            /// Bulk writer of the archive, or null when staging
+            gtar::GTAR::BulkWriter *m_writer;
+            /// Staged records, or null when writing immediately
+            std::vector<StagedRecord> *m_records;
+        };
+
     /// HOOMD analyzer which periodically dumps a set of properties
+    ///
+    /// When asyncQueueDepth is non-zero, analyze() copies the records of
+    /// each frame out of the snapshot and hands them to a background
+    /// thread, which writes (and compresses) them into the archive while
+    /// the simulation continues. analyze() blocks only when
+    /// asyncQueueDepth frames are already waiting. Errors in the
+    /// background thread are raised by the next call to analyze() or
+    /// flush(); System calls flush() at the end of every run.
     class PYBIND11_EXPORT GetarDumpWriter: public Analyzer
         {
         public:
@@ -222,8 +326,10 @@ namespace getardump{
             /// :param filename: File name to dump to
             /// :param operationMode: Operation mode
             /// :param offset: Timestep offset
+            /// :param asyncQueueDepth: Maximum number of frames waiting to be written, 0 to write synchronously
             GetarDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
-                const std::string &filename, GetarDumpMode operationMode, unsigned int offset=0);
+                const std::string &filename, GetarDumpMode operationMode, unsigned int offset=0,
+                unsigned int asyncQueueDepth=0);
 
             /// Destructor: closes the file and finalizes any IO
             ~GetarDumpWriter();
@@ -251,6 +357,9 @@ namespace getardump{
             /// Called every timestep
             void analyze(unsigned int timestep);
 
+            /// Wait for all queued frames to be written
+            virtual void flush();
+
             /// Calculate the correct period for all of the properties
             /// activated on this analyzer
             unsigned int getPeriod() const;
@@ -269,14 +378,34 @@ namespace getardump{
             void writeStr(const std::string &name, const std::string &contents, int timestep);
 
         private:
+            /// A frame of staged records waiting for the writer thread
+            struct Frame
+                {
+                /// Records in the frame
+                std::vector<StagedRecord> records;
+                };
+
+            /// Descriptions due at the given timestep, with the timestep to write each at
+            std::vector<std::pair<const GetarDumpDescription*, unsigned int> > dueRecords(unsigned int timestep) const;
             /// Write any GetarDumpDescription for the given timestep
-            void write(gtar::GTAR::BulkWriter &writer, const GetarDumpDescription &desc, unsigned int timestep);
+            void write(RecordWriter &writer, const GetarDumpDescription &desc, unsigned int timestep);
             /// Write an individual GetarDumpDescription for the given timestep
-            void writeIndividual(gtar::GTAR::BulkWriter &writer, const GetarDumpDescription &desc, unsigned int timestep);
+            void writeIndividual(RecordWriter &writer, const GetarDumpDescription &desc, unsigned int timestep);
             /// Write a uniform GetarDumpDescription for the given timestep
-            void writeUniform(gtar::GTAR::BulkWriter &writer, const GetarDumpDescription &desc, unsigned int timestep);
+            void writeUniform(RecordWriter &writer, const GetarDumpDescription &desc, unsigned int timestep);
             /// Write a text GetarDumpDescription for the given timestep
-            void writeText(gtar::GTAR::BulkWriter &writer, const GetarDumpDescription &desc, unsigned int timestep);
+            void writeText(RecordWriter &writer, const GetarDumpDescription &desc, unsigned int timestep);
+
+            /// Write a staged frame into the archive (in the writer thread)
+            void writeFrame(const Frame &frame);
+            /// Move the one-shot temporary file to the dump filename
+            void renameOneShot();
+            /// Main loop of the writer thread
+            void writerThreadFunc();
+            /// Stop the writer thread after it has written all queued frames
+            void stopWriterThread();
+            /// Rethrow an error raised in the writer thread
+            void checkWriterError();
 
             /// File archive interface
             std::shared_ptr<gtar::GTAR> m_archive;
@@ -297,6 +426,23 @@ namespace getardump{
             std::shared_ptr<SystemSnapshot> m_systemSnap;
             /// Map detailing when we need which snapshots
             NeedSnapshotMap m_neededSnapshots;
+
+            /// Maximum number of frames waiting to be written, 0 for synchronous
+            unsigned int m_asyncQueueDepth;
+            /// Frames waiting for the writer thread
+            std::deque<Frame> m_queue;
+            /// Protects the members shared with the writer thread
+            std::mutex m_queueMutex;
+            /// Signals changes to m_queue and m_writerBusy
+            std::condition_variable m_queueCV;
+            /// Background thread that writes frames
+            std::thread m_writerThread;
+            /// True while the writer thread is writing a frame
+            bool m_writerBusy;
+            /// Set to request the writer thread to exit
+            bool m_writerStop;
+            /// Error raised in the writer thread
+            std::exception_ptr m_writerError;
         };
 
 void export_GetarDumpWriter(pybind11::module& m);
@@ -37,7 +37,9 @@
 #include <memory>
 
 #include "GPUArray.h"
+#include "HostMemory.h"
 #include "MemoryTraceback.h"
+#include "ManagedMemoryPool.h"
 
 #include <type_traits>
 #include <string>
@@ -91,7 +93,7 @@ class managed_deleter
             \param use_device whether the array is managed or on the host
             \param N number of elements
             \param allocation_ptr true start of allocation, before alignment
-            \param allocation_bytes Size of allocation
+            \param allocation_bytes Size of allocation (of the pool block for managed memory)
          */
         managed_deleter(std::shared_ptr<const ExecutionConfiguration> exec_conf,
             bool use_device, std::size_t N, void *allocation_ptr, size_t allocation_bytes)
@@ -134,19 +136,15 @@ class managed_deleter
             if (m_use_device)
                 {
                 std::ostringstream oss;
-                oss << "Freeing " << m_allocation_bytes
-                    << " bytes of managed memory";
+                oss << "Returning " << m_allocation_bytes
+                    << " bytes of managed memory to the pool";
                 if (m_tag != "")
                     oss << " [" << m_tag << "]";
                 oss << std::endl;
                 this->m_exec_conf->msg->notice(10) << oss.str();
 
-                #if __HIP_PLATFORM_NVCC__
-                hipFree(m_allocation_ptr);
-                #else
-                // HIP doesn't yet support hipFree on managed memory
-                hipHostFree(m_allocation_ptr);
-                #endif
+                // the device was synchronized above, so the block can be handed out again right away
+                m_exec_conf->getManagedMemoryPool().deallocate(m_allocation_ptr, m_allocation_bytes);
                 CHECK_CUDA_ERROR();
                 }
             else
@@ -643,6 +641,20 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
         #endif
                         ) const;
 
+        //! Acquires the data pointer to access a range of elements
+        /*! Managed memory migrates on demand, so only the fall back array makes use of the range.
+         */
+        inline ArrayHandleDispatch<T> acquireRange(const access_location::Enum location,
+            const access_mode::Enum mode, size_t first, size_t count) const
+            {
+            #ifndef ALWAYS_USE_MANAGED_MEMORY
+            if (!this->m_exec_conf || ! m_is_managed)
+                return m_fallback.acquireRange(location, mode, first, count);
+            #endif
+
+            return acquire(location, mode);
+            }
+
         //! Release the data pointer
         inline void release() const
             {
@@ -697,6 +709,7 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
             void *allocation_ptr = nullptr;
             bool use_device = this->m_exec_conf && this->m_exec_conf->isCUDAEnabled();
             size_t allocation_bytes;
+            size_t block_bytes = 0;
 
             #ifdef ENABLE_HIP
             if (use_device)
@@ -710,7 +723,8 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
                 this->m_exec_conf->msg->notice(10) << "Allocating " << allocation_bytes
                     << " bytes of managed memory." << std::endl;
 
-                hipMallocManaged(&ptr, allocation_bytes, hipMemAttachGlobal);
+                // reuse a freed block of similar size when possible, the pool calls hipMallocManaged otherwise
+                ptr = this->m_exec_conf->getManagedMemoryPool().allocate(allocation_bytes, block_bytes);
                 CHECK_CUDA_ERROR();
 
                 allocation_ptr = ptr;
@@ -731,13 +745,26 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
             else
             #endif
                 {
-                int retval = posix_memalign((void **) &ptr, 32, m_num_elements*sizeof(T));
+                allocation_bytes = m_num_elements*sizeof(T);
+
+                // give large arrays huge page and NUMA placement hints before their pages are touched
+                bool huge_pages = this->m_exec_conf && this->m_exec_conf->getHostHugePages();
+                bool numa_interleave = this->m_exec_conf && this->m_exec_conf->getHostNUMAInterleave();
+                bool advise = (huge_pages || numa_interleave)
+                    && allocation_bytes >= hoomd::detail::HOST_HUGE_PAGE_BYTES;
+
+                size_t alignment = advise ? hoomd::detail::HOST_HUGE_PAGE_BYTES : 32;
+                int retval = posix_memalign((void **) &ptr, alignment, allocation_bytes);
                 if (retval != 0)
                     {
                     throw std::runtime_error("Error allocating aligned memory");
                     }
-                allocation_bytes = m_num_elements*sizeof(T);
+
+                if (advise)
+                    hoomd::detail::host_memory_advise(ptr, allocation_bytes, huge_pages, numa_interleave);
+
                 allocation_ptr = ptr;
+                block_bytes = allocation_bytes;
                 }
 
             #ifdef ENABLE_HIP
@@ -759,7 +786,7 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
 
             // store allocation and custom deleter in unique_ptr
             hoomd::detail::managed_deleter<T> deleter(this->m_exec_conf,use_device,
-                m_num_elements, allocation_ptr, allocation_bytes);
+                m_num_elements, allocation_ptr, block_bytes);
             deleter.setTag(m_tag);
             m_data = std::unique_ptr<T, decltype(deleter)>(reinterpret_cast<T *>(ptr), deleter);
 
@@ -22,7 +22,11 @@
 
 #include <mpi.h>
 
+#include <algorithm>
+#include <climits>
+#include <cstring>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
 #include <cereal/types/set.hpp>
@@ -228,6 +232,140 @@ void bcast(T& val, unsigned int root, const MPI_Comm mpi_comm)
     delete[] buf;
     }
 
+//! True for element types that vectors are sent as packed bytes of, without serialization
+/*! These are plain data types such as Scalar, int3, or vec3<Real>. The latter have a user provided copy constructor
+    and are not formally trivially copyable, but they are copied bytewise by the GPUArray types as well.
+*/
+template<typename T>
+struct is_packed_mpi_type
+    {
+    static const bool value = std::is_standard_layout<T>::value && std::is_trivially_destructible<T>::value
+                              && !std::is_same<T, bool>::value;
+    };
+
+//! Wrapper around MPI_Bcast for a contiguous buffer of any size
+/*! \param buf Buffer to send from (on \a root) or receive to
+    \param n_bytes Size of the buffer in bytes, the same on all ranks
+    \param root Rank to send from
+    \param mpi_comm Communicator
+
+    The buffer is sent in pieces of at most INT_MAX bytes (the limit of the MPI count argument).
+*/
+inline void bcast_bytes(void *buf, size_t n_bytes, unsigned int root, const MPI_Comm mpi_comm)
+    {
+    char *ptr = (char *)buf;
+    for (size_t offset = 0; offset < n_bytes; offset += INT_MAX)
+        {
+        int count = (int)std::min(n_bytes - offset, (size_t)INT_MAX);
+        MPI_Bcast(ptr + offset, count, MPI_BYTE, root, mpi_comm);
+        }
+    }
+
+//! Wrapper around MPI_Bcast for vectors of plain data elements
+/*! The elements are sent as they are in memory, which avoids the serialization of the generic bcast().
+*/
+template<typename T>
+typename std::enable_if<is_packed_mpi_type<T>::value>::type
+bcast(std::vector<T>& val, unsigned int root, const MPI_Comm mpi_comm)
+    {
+    unsigned long long int n = val.size();
+    MPI_Bcast(&n, 1, MPI_UNSIGNED_LONG_LONG, root, mpi_comm);
+
+    val.resize((size_t)n);
+    bcast_bytes(val.data(), val.size()*sizeof(T), root, mpi_comm);
+    }
+
+//! Broadcasts vectors with one copy per node
+/*! A plain MPI_Bcast sends the data to every rank. This class splits the communicator into the ranks on each node
+    (sharing memory) and one leader per node. The vector is broadcast between the leaders only, and each leader copies
+    it into an MPI-3 shared memory window that the other ranks of its node read from. The root is the leader of its
+    node.
+
+    The communicators are created once in the constructor, which is collective on \a mpi_comm, so that several vectors
+    can be broadcast with the same object.
+*/
+class NodeBroadcast
+    {
+    public:
+        //! Constructor
+        /*! \param root Rank to send from
+            \param mpi_comm Communicator
+        */
+        NodeBroadcast(unsigned int root, const MPI_Comm mpi_comm)
+            : m_root(root), m_mpi_comm(mpi_comm), m_leader_comm(MPI_COMM_NULL)
+            {
+            int rank;
+            MPI_Comm_rank(mpi_comm, &rank);
+
+            // order the ranks such that the root comes first on its node and among the leaders
+            int key = (rank == (int)root) ? 0 : rank + 1;
+            MPI_Comm_split_type(mpi_comm, MPI_COMM_TYPE_SHARED, key, MPI_INFO_NULL, &m_node_comm);
+            MPI_Comm_rank(m_node_comm, &m_node_rank);
+            MPI_Comm_size(m_node_comm, &m_node_size);
+
+            MPI_Comm_split(mpi_comm, m_node_rank == 0 ? 0 : MPI_UNDEFINED, key, &m_leader_comm);
+            }
+
+        //! Destructor
+        ~NodeBroadcast()
+            {
+            if (m_leader_comm != MPI_COMM_NULL)
+                MPI_Comm_free(&m_leader_comm);
+            MPI_Comm_free(&m_node_comm);
+            }
+
+        //! Broadcast a vector of plain data elements from the root
+        template<typename T>
+        void bcast(std::vector<T>& val)
+            {
+            static_assert(is_packed_mpi_type<T>::value, "NodeBroadcast sends packed elements only");
+
+            unsigned long long int n = val.size();
+            MPI_Bcast(&n, 1, MPI_UNSIGNED_LONG_LONG, m_root, m_mpi_comm);
+            val.resize((size_t)n);
+
+            size_t n_bytes = val.size()*sizeof(T);
+            if (m_leader_comm != MPI_COMM_NULL)
+                bcast_bytes(val.data(), n_bytes, 0, m_leader_comm);
+
+            if (m_node_size == 1 || n_bytes == 0)
+                return;
+
+            // the leader publishes the data in memory shared by the node
+            char *shared = NULL;
+            MPI_Win win;
+            MPI_Win_allocate_shared(m_node_rank == 0 ? (MPI_Aint)n_bytes : 0, 1, MPI_INFO_NULL, m_node_comm,
+                                    &shared, &win);
+            MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+
+            if (m_node_rank == 0)
+                memcpy(shared, val.data(), n_bytes);
+
+            MPI_Win_sync(win);
+            MPI_Barrier(m_node_comm);
+            MPI_Win_sync(win);
+
+            if (m_node_rank != 0)
+                {
+                MPI_Aint size;
+                int disp_unit;
+                MPI_Win_shared_query(win, 0, &size, &disp_unit, &shared);
+                memcpy((void*)val.data(), shared, n_bytes);
+                }
+
+            MPI_Win_unlock_all(win);
+            MPI_Win_free(&win);
+            }
+
+    private:
+        unsigned int m_root;        //!< Rank to send from
+        MPI_Comm m_mpi_comm;        //!< Communicator of all ranks
+        MPI_Comm m_node_comm;       //!< Ranks on the same node
+        MPI_Comm m_leader_comm;     //!< First rank of each node, MPI_COMM_NULL on the other ranks
+        int m_node_rank;            //!< Rank in m_node_comm
+        int m_node_size;            //!< Number of ranks in m_node_comm
+    };
+
 //! Wrapper around MPI_Scatterv that scatters a vector of serializable objects
 template<typename T>
 void scatter_v(const std::vector<T>& in_values, T& out_value, unsigned int root, const MPI_Comm mpi_comm)
@@ -298,6 +436,55 @@ void scatter_v(const std::vector<T>& in_values, T& out_value, unsigned int root,
     delete[] rbuf;
     }
 
+//! Wrapper around MPI_Scatterv that scatters vectors of plain data elements
+/*! The elements are sent as they are in memory, which avoids the serialization of the generic scatter_v().
+*/
+template<typename T>
+typename std::enable_if<is_packed_mpi_type<T>::value>::type
+scatter_v(const std::vector< std::vector<T> >& in_values, std::vector<T>& out_value, unsigned int root,
+          const MPI_Comm mpi_comm)
+    {
+    int rank;
+    int size;
+    MPI_Comm_rank(mpi_comm, &rank);
+    MPI_Comm_size(mpi_comm, &size);
+
+    MPI_Datatype mpi_type;
+    MPI_Type_contiguous((int)sizeof(T), MPI_BYTE, &mpi_type);
+    MPI_Type_commit(&mpi_type);
+
+    std::vector<int> send_counts;
+    std::vector<int> displs;
+    std::vector<T> sbuf;
+    if (rank == (int)root)
+        {
+        assert(in_values.size() == (unsigned int) size);
+        send_counts.resize(size);
+        displs.resize(size);
+
+        // pack the vectors into the send buffer
+        size_t len = 0;
+        for (unsigned int idx = 0; idx < in_values.size(); idx++)
+            {
+            send_counts[idx] = (int)in_values[idx].size();
+            displs[idx] = (int)len;
+            len += in_values[idx].size();
+            }
+        sbuf.reserve(len);
+        for (unsigned int idx = 0; idx < in_values.size(); idx++)
+            sbuf.insert(sbuf.end(), in_values[idx].begin(), in_values[idx].end());
+        }
+
+    int recv_count;
+    MPI_Scatter(send_counts.data(), 1, MPI_INT, &recv_count, 1, MPI_INT, root, mpi_comm);
+
+    out_value.resize(recv_count);
+    MPI_Scatterv(sbuf.data(), send_counts.data(), displs.data(), mpi_type, out_value.data(), recv_count, mpi_type,
+                 root, mpi_comm);
+
+    MPI_Type_free(&mpi_type);
+    }
+
 //! Wrapper around MPI_Gatherv
 template<typename T>
 void gather_v(const T& in_value, std::vector<T> & out_values, unsigned int root, const MPI_Comm mpi_comm)
@@ -36,6 +36,12 @@ std::string BuildInfo::getCompileFlags()
 #ifdef ENABLE_HPMC_MIXED_PRECISION
     o << "HPMC_MIXED ";
 #endif
+#ifdef ENABLE_MD_MIXED_PRECISION
+    o << "MD_MIXED ";
+#endif
+#ifdef ENABLE_MPCD_MIXED_PRECISION
+    o << "MPCD_MIXED ";
+#endif
 #endif
 
 #ifdef ENABLE_MPI
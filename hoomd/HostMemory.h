@@ -0,0 +1,87 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file HostMemory.h
+    \brief Declares placement hints for large host allocations and the page fault counter
+*/
+
+#ifndef __HOST_MEMORY_H__
+#define __HOST_MEMORY_H__
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace hoomd
+{
+namespace detail
+{
+
+//! Size of a transparent huge page, host arrays at least this large are aligned to it and receive placement hints
+const size_t HOST_HUGE_PAGE_BYTES = 2*1024*1024;
+
+//! Advise the kernel how to place the pages of a host allocation
+/*! \param ptr Start of the allocation, aligned to HOST_HUGE_PAGE_BYTES
+    \param num_bytes Size of the allocation
+    \param huge_pages Back the allocation with transparent huge pages
+    \param numa_interleave Interleave the pages over all NUMA nodes the process may allocate on
+
+    The hints must be given before the pages are first touched. They are only hints: kernels without transparent huge
+    pages or NUMA support ignore them, and so does this function on other operating systems. Without
+    \a numa_interleave, Linux places each page on the node of the thread that first touches it.
+
+    mbind is called through syscall() so that HOOMD does not need to link libnuma.
+*/
+inline void host_memory_advise(void *ptr, size_t num_bytes, bool huge_pages, bool numa_interleave)
+    {
+    #ifdef __linux__
+    #ifdef MADV_HUGEPAGE
+    if (huge_pages)
+        madvise(ptr, num_bytes, MADV_HUGEPAGE);
+    #endif
+
+    #if defined(SYS_mbind) && defined(SYS_get_mempolicy)
+    if (numa_interleave)
+        {
+        // constants from linux/mempolicy.h
+        const int mpol_interleave = 3;
+        const unsigned long mpol_f_mems_allowed = 4;
+
+        // room for 1024 nodes
+        unsigned long nodemask[1024/(8*sizeof(unsigned long))] = {0};
+        const unsigned long maxnode = sizeof(nodemask)*8;
+        if (syscall(SYS_get_mempolicy, NULL, nodemask, maxnode, NULL, mpol_f_mems_allowed) == 0)
+            syscall(SYS_mbind, ptr, num_bytes, mpol_interleave, nodemask, maxnode, 0);
+        }
+    #endif
+    #endif
+    }
+
+//! Get the number of page faults of this process so far
+/*! \returns The sum of the minor and major page faults of all threads, or 0 when the operating system does not
+    report them
+*/
+inline uint64_t host_memory_page_faults()
+    {
+    #ifdef __linux__
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+        return uint64_t(usage.ru_minflt) + uint64_t(usage.ru_majflt);
+    #endif
+    return 0;
+    }
+
+} // end namespace detail
+} // end namespace hoomd
+
+#endif // __HOST_MEMORY_H__
@@ -10,6 +10,7 @@
 
 #include "IMDInterface.h"
 #include "SignalHandler.h"
+#include "hoomd/filter/ParticleFilterAll.h"
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
@@ -22,10 +23,82 @@ namespace py = pybind11;
 #include "hoomd/extern/vmdsock.h"
 #include "hoomd/extern/imd.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <stdexcept>
 
 using namespace std;
 
+//! Frame position of the tags that are not sent
+static const unsigned int NOT_SENT = 0xffffffff;
+
+//! Round a float to the nearest 16-bit float
+/*! Values beyond the largest 16-bit float become infinities, and values below the smallest subnormal become zeros.
+*/
+static uint16_t floatToHalf(float f)
+    {
+    uint32_t x;
+    std::memcpy(&x, &f, sizeof(x));
+    const uint32_t sign = (x >> 16) & 0x8000;
+    const uint32_t a = x & 0x7fffffff;
+
+    // infinities and NaNs
+    if (a >= 0x7f800000)
+        return uint16_t(sign | 0x7c00 | (a > 0x7f800000 ? 0x200 : 0));
+
+    // values that round past 65504
+    if (a >= 0x477ff000)
+        return uint16_t(sign | 0x7c00);
+
+    // subnormal 16-bit floats, round the mantissa with its implicit bit to nearest even
+    if (a < 0x38800000)
+        {
+        if (a < 0x33000000)
+            return uint16_t(sign);
+
+        const uint32_t m = (a & 0x7fffff) | 0x800000;
+        const uint32_t shift = 126 - (a >> 23);
+        uint32_t h = m >> shift;
+        const uint32_t rem = m & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (rem > halfway || (rem == halfway && (h & 1)))
+            h++;
+        return uint16_t(sign | h);
+        }
+
+    // normal 16-bit floats, a carry out of the mantissa correctly increments the exponent
+    uint32_t h = (a - 0x38000000) >> 13;
+    const uint32_t rem = a & 0x1fff;
+    if (rem > 0x1000 || (rem == 0x1000 && (h & 1)))
+        h++;
+    return uint16_t(sign | h);
+    }
+
+//! Convert a 16-bit float to a float
+static float halfToFloat(uint16_t h)
+    {
+    const uint32_t sign = uint32_t(h & 0x8000) << 16;
+    const uint32_t e = (h >> 10) & 0x1f;
+    const uint32_t m = h & 0x3ff;
+
+    if (e == 0)
+        {
+        const float v = std::ldexp(float(m), -24);
+        return sign ? -v : v;
+        }
+
+    uint32_t x;
+    if (e == 31)
+        x = sign | 0x7f800000 | (m << 13);
+    else
+        x = sign | ((e + 112) << 23) | (m << 13);
+
+    float f;
+    std::memcpy(&f, &x, sizeof(f));
+    return f;
+    }
+
 /*! After construction, IMDInterface is listening for connections on port \a port.
     analyze() must be called to handle any incoming connections.
     \param sysdef SystemDefinition containing the ParticleData that will be transmitted to VMD
@@ -34,14 +107,22 @@ using namespace std;
     \param rate Initial rate at which to send data
     \param force Constant force used to apply forces received from VMD
     \param force_scale Factor by which to scale all forces from IMD
+    \param group Particles that may be sent, all particles when null
+    \param stride Send every \a stride -th member of \a group
+    \param half_precision Gather the positions as 16-bit floats
 */
 IMDInterface::IMDInterface(std::shared_ptr<SystemDefinition> sysdef,
                            int port,
                            bool pause,
                            unsigned int rate,
                            std::shared_ptr<ConstForceCompute> force,
-                           float force_scale)
-    : Analyzer(sysdef)
+                           float force_scale,
+                           std::shared_ptr<ParticleGroup> group,
+                           unsigned int stride,
+                           bool half_precision)
+    : Analyzer(sysdef), m_group(group), m_stride(stride), m_half_precision(half_precision),
+      m_subset_initialized(false), m_has_pending(false), m_sender_busy(false), m_sender_stop(false),
+      m_send_failed(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing IMDInterface: " << port << " " << pause << " " << rate << " " << force_scale << endl;
 
@@ -51,6 +132,16 @@ IMDInterface::IMDInterface(std::shared_ptr<SystemDefinition> sysdef,
         throw runtime_error("Error initializing IMDInterface");
         }
 
+    if (stride == 0)
+        {
+        m_exec_conf->msg->error() << "analyze.imd: The stride must be positive" << endl;
+        throw runtime_error("Error initializing IMDInterface");
+        }
+
+    if (!m_group)
+        m_group = std::shared_ptr<ParticleGroup>(new ParticleGroup(sysdef,
+                                                                   std::make_shared<ParticleFilterAll>()));
+
     // initialize state
     m_active = false;
     m_paused = pause;
@@ -59,20 +150,20 @@ IMDInterface::IMDInterface(std::shared_ptr<SystemDefinition> sysdef,
     m_force = force;
     m_force_scale = force_scale;
     m_port = port;
+    m_nglobal = m_pdata->getNGlobal();
     if (m_force)
         m_force->setForce(0,0,0);
 
     // TCP socket will be initialized later
     m_is_initialized = false;
+    m_listen_sock = NULL;
+    m_connected_sock = NULL;
     }
 
 void IMDInterface::initConnection()
     {
     int err = 0;
 
-    // start by initializing memory
-    m_tmp_coords = new float[m_pdata->getNGlobal() * 3];
-
     // initialize the listening socket
     vmdsock_init();
     m_listen_sock = vmdsock_create();
@@ -105,21 +196,30 @@ void IMDInterface::initConnection()
     m_exec_conf->msg->notice(2) << "analyze.imd: listening on port " << m_port << endl;
 
     m_is_initialized = true;
-    m_nglobal = m_pdata->getNGlobal();
+
+    m_sender_thread = std::thread(&IMDInterface::senderThreadFunc, this);
     }
 
 IMDInterface::~IMDInterface()
     {
     m_exec_conf->msg->notice(5) << "Destroying IMDInterface" << endl;
 
+    if (m_sender_thread.joinable())
+        {
+        // a frame that is still waiting is dropped
+            {
+            std::unique_lock<std::mutex> lock(m_send_mutex);
+            m_sender_stop = true;
+            }
+        m_send_cv.notify_all();
+        m_sender_thread.join();
+        }
+
     if (m_is_initialized)
         {
-        // free all used memory
-        delete[] m_tmp_coords;
         vmdsock_destroy(m_connected_sock);
         vmdsock_destroy(m_listen_sock);
 
-        m_tmp_coords = NULL;
         m_connected_sock = NULL;
         m_listen_sock = NULL;
         }
@@ -136,6 +236,17 @@ void IMDInterface::analyze(unsigned int timestep)
     if (m_prof)
         m_prof->push("IMD");
 
+    if (m_nglobal != m_pdata->getNGlobal())
+        {
+        m_exec_conf->msg->error() << "analyze.imd: Change in number of particles unsupported by IMD."
+            << std::endl;
+        throw std::runtime_error("Error sending IMD data");
+        }
+
+    // all ranks select the sent particles
+    if (!m_subset_initialized)
+        initSubset();
+
 #ifdef ENABLE_MPI
     bool is_root = true;
     if (m_comm)
@@ -150,16 +261,21 @@ void IMDInterface::analyze(unsigned int timestep)
         initConnection();
 #endif
 
-    if (m_nglobal != m_pdata->getNGlobal())
-        {
-        m_exec_conf->msg->error() << "analyze.imd: Change in number of particles unsupported by IMD."
-            << std::endl;
-        throw std::runtime_error("Error sending IMD data");
-        }
-
         {
         m_count++;
 
+        // the sender thread leaves the connection alone and only reports I/O errors
+        bool send_failed;
+            {
+            std::unique_lock<std::mutex> lock(m_send_mutex);
+            send_failed = m_send_failed;
+            }
+        if (send_failed && m_connected_sock)
+            {
+            m_exec_conf->msg->error() << "analyze.imd: I/O error while sending coordinates, disconnecting" << endl;
+            processDeadConnection();
+            }
+
         do
             {
             // establish a connection if one has not been made
@@ -333,11 +449,18 @@ void IMDInterface::processIMD_MDCOMM(unsigned int n)
 
     if (m_force)
         {
-        ArrayHandle< unsigned int > h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+        // VMD indexes the particles in the order they are sent
         m_force->setForce(0,0,0);
         for (unsigned int i = 0; i < n; i++)
             {
-            m_force->setParticleForce(indices[i],
+            if (indices[i] < 0 || (unsigned int)indices[i] >= m_sent_tags.size())
+                {
+                m_exec_conf->msg->warning() << "analyze.imd: Ignoring a force on particle " << indices[i]
+                                            << ", which is not sent" << endl;
+                continue;
+                }
+
+            m_force->setParticleForce(m_sent_tags[indices[i]],
                                       forces[3*i+0]*m_force_scale,
                                       forces[3*i+1]*m_force_scale,
                                       forces[3*i+2]*m_force_scale);
@@ -379,6 +502,14 @@ void IMDInterface::processIMD_IOERROR()
 
 void IMDInterface::processDeadConnection()
     {
+    // drop the waiting frame and let the sender thread finish with the socket before it is destroyed
+        {
+        std::unique_lock<std::mutex> lock(m_send_mutex);
+        m_has_pending = false;
+        m_send_cv.wait(lock, [this]{ return !m_sender_busy; });
+        m_send_failed = false;
+        }
+
     vmdsock_destroy(m_connected_sock);
     m_connected_sock = NULL;
     m_active = false;
@@ -424,13 +555,12 @@ void IMDInterface::establishConnectionAttempt()
 /*! \param timestep Current time step of the simulation
     \pre A connection has been established
 
-    Sends the current coordinates to VMD for display.
+    Gathers the current positions and hands them to the sender thread. A frame that the thread has not started to
+    send is replaced.
 */
 void IMDInterface::sendCoords(unsigned int timestep)
     {
-    // take a snapshot of the particle data
-    SnapshotParticleData<Scalar> snapshot;
-    m_pdata->takeSnapshot(snapshot);
+    gatherCoords();
 
 #ifdef ENABLE_MPI
     // return now if not root rank
@@ -440,9 +570,191 @@ void IMDInterface::sendCoords(unsigned int timestep)
 
     assert(m_connected_sock != NULL);
 
+    m_frame.sock = m_connected_sock;
+    m_frame.timestep = timestep;
+
+        {
+        std::unique_lock<std::mutex> lock(m_send_mutex);
+        std::swap(m_frame, m_pending);
+        m_has_pending = true;
+        }
+    m_send_cv.notify_all();
+    }
+
+/*! Every m_stride-th member of the group, in tag order, is sent. Called on all ranks.
+*/
+void IMDInterface::initSubset()
+    {
+    const unsigned int n_members = m_group->getNumMembersGlobal();
+
+    m_sent_tags.clear();
+    for (unsigned int i = 0; i < n_members; i += m_stride)
+        m_sent_tags.push_back(m_group->getMemberTag(i));
+
+    unsigned int max_tag = 0;
+    for (unsigned int i = 0; i < m_sent_tags.size(); i++)
+        max_tag = std::max(max_tag, m_sent_tags[i]);
+
+    m_tag_slot.assign(m_sent_tags.empty() ? 0 : max_tag + 1, NOT_SENT);
+    for (unsigned int i = 0; i < m_sent_tags.size(); i++)
+        m_tag_slot[m_sent_tags[i]] = i;
+
+    m_exec_conf->msg->notice(3) << "analyze.imd: sending " << m_sent_tags.size() << " of " << n_members
+                                << " particles" << endl;
+
+    m_subset_initialized = true;
+    }
+
+/*! Each rank packs the positions of its own particles that are sent, so the other particles are never
+    communicated. The root rank places them in m_frame in the order of m_sent_tags.
+*/
+void IMDInterface::gatherCoords()
+    {
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+    m_local_slots.clear();
+    m_local_coords.clear();
+    m_local_half.clear();
+
+    for (unsigned int j = 0; j < m_group->getNumMembers(); j++)
+        {
+        const unsigned int idx = m_group->getMemberIndex(j);
+        const unsigned int tag = h_tag.data[idx];
+        if (tag >= m_tag_slot.size() || m_tag_slot[tag] == NOT_SENT)
+            continue;
+
+        m_local_slots.push_back(m_tag_slot[tag]);
+        const Scalar4 pos = h_pos.data[idx];
+        if (m_half_precision)
+            {
+            m_local_half.push_back(floatToHalf(float(pos.x)));
+            m_local_half.push_back(floatToHalf(float(pos.y)));
+            m_local_half.push_back(floatToHalf(float(pos.z)));
+            }
+        else
+            {
+            m_local_coords.push_back(float(pos.x));
+            m_local_coords.push_back(float(pos.y));
+            m_local_coords.push_back(float(pos.z));
+            }
+        }
+
+    const unsigned int *slots = m_local_slots.data();
+    const float *coords = m_local_coords.data();
+    const uint16_t *half = m_local_half.data();
+    unsigned int n = (unsigned int)m_local_slots.size();
+
+#ifdef ENABLE_MPI
+    std::vector<unsigned int> all_slots;
+    std::vector<float> all_coords;
+    std::vector<uint16_t> all_half;
+
+    if (m_comm)
+        {
+        bool root = m_exec_conf->isRoot();
+        unsigned int nranks = m_exec_conf->getNRanks();
+        MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+
+        int n_local = int(n);
+        std::vector<int> counts(root ? nranks : 0);
+        MPI_Gather(&n_local, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, mpi_comm);
+
+        std::vector<int> displs(root ? nranks : 0);
+        std::vector<int> counts3(root ? nranks : 0);
+        std::vector<int> displs3(root ? nranks : 0);
+        int n_all = 0;
+        if (root)
+            {
+            for (unsigned int rank = 0; rank < nranks; rank++)
+                {
+                displs[rank] = n_all;
+                counts3[rank] = 3*counts[rank];
+                displs3[rank] = 3*n_all;
+                n_all += counts[rank];
+                }
+            all_slots.resize(n_all);
+            if (m_half_precision)
+                all_half.resize(3*n_all);
+            else
+                all_coords.resize(3*n_all);
+            }
+
+        MPI_Gatherv(m_local_slots.data(), n_local, MPI_UNSIGNED, all_slots.data(), counts.data(), displs.data(),
+                    MPI_UNSIGNED, 0, mpi_comm);
+        if (m_half_precision)
+            MPI_Gatherv(m_local_half.data(), 3*n_local, MPI_UNSIGNED_SHORT, all_half.data(), counts3.data(),
+                        displs3.data(), MPI_UNSIGNED_SHORT, 0, mpi_comm);
+        else
+            MPI_Gatherv(m_local_coords.data(), 3*n_local, MPI_FLOAT, all_coords.data(), counts3.data(),
+                        displs3.data(), MPI_FLOAT, 0, mpi_comm);
+
+        if (!root)
+            return;
+
+        slots = all_slots.data();
+        coords = all_coords.data();
+        half = all_half.data();
+        n = n_all;
+        }
+#endif
+
+    const unsigned int n_sent = (unsigned int)m_sent_tags.size();
+    if (m_half_precision)
+        {
+        m_frame.half_coords.resize(3*n_sent);
+        for (unsigned int i = 0; i < n; i++)
+            std::copy(half + 3*i, half + 3*i + 3, m_frame.half_coords.begin() + 3*slots[i]);
+        }
+    else
+        {
+        m_frame.coords.resize(3*n_sent);
+        for (unsigned int i = 0; i < n; i++)
+            std::copy(coords + 3*i, coords + 3*i + 3, m_frame.coords.begin() + 3*slots[i]);
+        }
+    }
+
+/*! The sender thread sends the latest frame until m_sender_stop is set. After an I/O error, it sets m_send_failed
+    and analyze() drops the connection.
+*/
+void IMDInterface::senderThreadFunc()
+    {
+    Frame frame;
+    std::vector<float> coords;
+
+    std::unique_lock<std::mutex> lock(m_send_mutex);
+    while (true)
+        {
+        m_send_cv.wait(lock, [this]{ return m_sender_stop || m_has_pending; });
+        if (m_sender_stop)
+            break;
+
+        std::swap(frame, m_pending);
+        m_has_pending = false;
+        m_sender_busy = true;
+        lock.unlock();
+
+        bool sent = sendFrame(frame, coords);
+
+        lock.lock();
+        if (!sent)
+            m_send_failed = true;
+        m_sender_busy = false;
+        m_send_cv.notify_all();
+        }
+    }
+
+/*! \param frame Frame to send
+    \param coords Scratch space to expand 16-bit positions in
+
+    Called by the sender thread. sendFrame() must not access the messenger or any other state shared with the
+    simulation thread.
+*/
+bool IMDInterface::sendFrame(const Frame& frame, std::vector<float>& coords)
+    {
     // setup and send the energies structure
     IMDEnergies energies;
-    energies.tstep = timestep;
+    energies.tstep = frame.timestep;
     energies.T = 0.0f;
     energies.Etot = 0.0f;
     energies.Epot = 0.0f;
@@ -453,34 +765,28 @@ void IMDInterface::sendCoords(unsigned int timestep)
     energies.Edihe = 0.0f;
     energies.Eimpr = 0.0f;
 
-    int err = imd_send_energies(m_connected_sock, &energies);
-    if (err)
-        {
-        m_exec_conf->msg->error() << "analyze.imd: I/O error while sending energies, disconnecting" << endl;
-        processDeadConnection();
-        return;
-        }
+    if (imd_send_energies(frame.sock, &energies))
+        return false;
 
-    // copy the particle data to the holding array and send it
-    for (unsigned int tag = 0; tag < m_pdata->getNGlobal(); tag++)
+    const float *data = frame.coords.data();
+    unsigned int n = (unsigned int)frame.coords.size() / 3;
+    if (m_half_precision)
         {
-        m_tmp_coords[tag*3] = float(snapshot.pos[tag].x);
-        m_tmp_coords[tag*3 + 1] = float(snapshot.pos[tag].y);
-        m_tmp_coords[tag*3 + 2] = float(snapshot.pos[tag].z);
+        coords.resize(frame.half_coords.size());
+        for (unsigned int i = 0; i < frame.half_coords.size(); i++)
+            coords[i] = halfToFloat(frame.half_coords[i]);
+        data = coords.data();
+        n = (unsigned int)frame.half_coords.size() / 3;
         }
-    err = imd_send_fcoords(m_connected_sock, m_pdata->getNGlobal(), m_tmp_coords);
 
-    if (err)
-        {
-        m_exec_conf->msg->error() << "analyze.imd: I/O error while sending coordinates, disconnecting" << endl;
-        processDeadConnection();
-        return;
-        }
+    return imd_send_fcoords(frame.sock, n, data) == 0;
     }
 
 void export_IMDInterface(py::module& m)
     {
     py::class_<IMDInterface, Analyzer, std::shared_ptr<IMDInterface> >(m,"IMDInterface")
     .def(py::init< std::shared_ptr<SystemDefinition>, int, bool, unsigned int, std::shared_ptr<ConstForceCompute> >())
+    .def(py::init< std::shared_ptr<SystemDefinition>, int, bool, unsigned int, std::shared_ptr<ConstForceCompute>,
+                   float, std::shared_ptr<ParticleGroup>, unsigned int, bool >())
         ;
     }
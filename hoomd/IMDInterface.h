@@ -16,8 +16,14 @@
 
 #include "Analyzer.h"
 #include "ConstForceCompute.h"
+#include "ParticleGroup.h"
 
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #ifndef __IMD_INTERFACE_H__
 #define __IMD_INTERFACE_H__
@@ -31,6 +37,20 @@
     In its current implementation, only a barebones set of commands are
     supported. The sending of any command that is not understood will
     result in the socket closing the connection.
+
+    Coordinates are sent by a background thread. analyze() gathers the
+    positions of the sent particles into a frame and hands it to the
+    thread through a single slot. A frame that is still waiting when the
+    next one arrives is replaced, so a slow viewer drops frames instead
+    of stalling the simulation. Commands from VMD are still read in
+    analyze().
+
+    Only every \a stride -th member of \a group (in tag order) is sent,
+    and VMD indexes the sent particles in that order. With \a
+    half_precision, the positions are rounded to 16-bit floats when they
+    are gathered, which halves the gathered data and the frame buffers.
+    The IMD protocol carries 32-bit floats, so the thread expands the
+    positions again before it sends them.
     \ingroup analyzers
 */
 class PYBIND11_EXPORT IMDInterface : public Analyzer
@@ -42,7 +62,10 @@ class PYBIND11_EXPORT IMDInterface : public Analyzer
                      bool pause = false,
                      unsigned int rate=1,
                      std::shared_ptr<ConstForceCompute> force = std::shared_ptr<ConstForceCompute>(),
-                     float force_scale=1.0);
+                     float force_scale=1.0,
+                     std::shared_ptr<ParticleGroup> group = std::shared_ptr<ParticleGroup>(),
+                     unsigned int stride=1,
+                     bool half_precision=false);
 
         //! Destructor
         ~IMDInterface();
@@ -52,7 +75,6 @@ class PYBIND11_EXPORT IMDInterface : public Analyzer
     private:
         void *m_listen_sock;    //!< Socket we are listening on
         void *m_connected_sock; //!< Socket to transmit/receive data
-        float *m_tmp_coords;    //!< Temporary holding location for coordinate data
 
         bool m_active;          //!< True if we have received a go command
         bool m_paused;          //!< True if we are paused
@@ -66,6 +88,36 @@ class PYBIND11_EXPORT IMDInterface : public Analyzer
         std::shared_ptr<ConstForceCompute> m_force;   //!< Force for applying IMD forces
         float m_force_scale;                            //!< Factor by which to scale all IMD forces
 
+        std::shared_ptr<ParticleGroup> m_group;       //!< Particles that may be sent
+        unsigned int m_stride;                          //!< Send every m_stride-th member of the group
+        bool m_half_precision;                          //!< Gather the positions as 16-bit floats
+        bool m_subset_initialized;                      //!< True once the sent particles have been selected
+        std::vector<unsigned int> m_tag_slot;           //!< Position of each tag in a frame, NOT_SENT if not sent
+        std::vector<unsigned int> m_sent_tags;          //!< Tag of each particle in a frame
+
+        //! Frame handed to the sender thread
+        struct Frame
+            {
+            void *sock;                         //!< Socket to send the frame on
+            unsigned int timestep;              //!< Time step of the frame
+            std::vector<float> coords;          //!< Positions of the sent particles
+            std::vector<uint16_t> half_coords;  //!< Positions of the sent particles as 16-bit floats
+            };
+
+        Frame m_frame;                          //!< Frame that analyze() is gathering
+        Frame m_pending;                        //!< Latest frame waiting for the sender thread
+        std::vector<unsigned int> m_local_slots; //!< Frame positions of the local particles that are sent
+        std::vector<float> m_local_coords;      //!< Positions of the local particles that are sent
+        std::vector<uint16_t> m_local_half;     //!< 16-bit positions of the local particles that are sent
+
+        std::mutex m_send_mutex;                //!< Protects the members shared with the sender thread
+        std::condition_variable m_send_cv;      //!< Signals changes to m_has_pending and m_sender_busy
+        std::thread m_sender_thread;            //!< Background thread that sends frames
+        bool m_has_pending;                     //!< True when m_pending holds a frame that was not sent
+        bool m_sender_busy;                     //!< True while the sender thread is sending a frame
+        bool m_sender_stop;                     //!< Set to request the sender thread to exit
+        bool m_send_failed;                     //!< Set by the sender thread after an I/O error
+
         //! Helper function that reads message headers and dispatches them to the relevant process functions
         void dispatch();
         //! Helper function to determine of messages are still available
@@ -89,8 +141,16 @@ class PYBIND11_EXPORT IMDInterface : public Analyzer
 
         //! Helper function to establish a connection
         void establishConnectionAttempt();
-        //! Helper function to send current data to VMD
+        //! Helper function to hand the current positions to the sender thread
         void sendCoords(unsigned int timestep);
+        //! Select the particles that are sent
+        void initSubset();
+        //! Gather the positions of the sent particles into m_frame on the root rank
+        void gatherCoords();
+        //! Main loop of the sender thread
+        void senderThreadFunc();
+        //! Send a frame to VMD, returns false on an I/O error
+        bool sendFrame(const Frame& frame, std::vector<float>& coords);
 
         //! Initialize socket and internal state variables for communication
         void initConnection();
@@ -5,6 +5,9 @@
 
 #include "Initializers.h"
 #include "SnapshotSystemData.h"
+#include "SystemDefinition.h"
+#include "RandomNumbers.h"
+#include "RNGIdentifiers.h"
 
 #include <stdlib.h>
 
@@ -16,6 +19,8 @@ using namespace std;
 
 #include <pybind11/pybind11.h>
 
+using namespace hoomd;
+
 /*! \file Initializers.cc
     \brief Defines a few initializers for setting up ParticleData instances
 */
@@ -178,3 +183,328 @@ std::shared_ptr< SnapshotSystemData<Scalar> > RandomInitializer::getSnapshot() c
     pdata.type_mapping.push_back(m_type_name);
     return snapshot;
     }
+
+/////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+//! Range of fractional coordinates of the local domain
+/*! \param pdata Particle data
+    \param lo Lower fractional coordinates of the local domain (output)
+    \param hi Upper fractional coordinates of the local domain (output)
+*/
+void getLocalFractions(std::shared_ptr<ParticleData> pdata, Scalar3& lo, Scalar3& hi)
+    {
+    lo = make_scalar3(0,0,0);
+    hi = make_scalar3(1,1,1);
+    #ifdef ENABLE_MPI
+    std::shared_ptr<DomainDecomposition> decomposition = pdata->getDomainDecomposition();
+    if (decomposition)
+        {
+        uint3 grid_pos = decomposition->getGridPos();
+        lo = make_scalar3(decomposition->getCumulativeFraction(0, grid_pos.x),
+                          decomposition->getCumulativeFraction(1, grid_pos.y),
+                          decomposition->getCumulativeFraction(2, grid_pos.z));
+        hi = make_scalar3(decomposition->getCumulativeFraction(0, grid_pos.x+1),
+                          decomposition->getCumulativeFraction(1, grid_pos.y+1),
+                          decomposition->getCumulativeFraction(2, grid_pos.z+1));
+        }
+    #endif
+    }
+
+//! Checks that a particle belongs to the local domain
+/*! \param pdata Particle data
+    \param pos Position of the particle, wrapped if it is on the boundary of the global box (input/output)
+    \param img Image of the particle (input/output)
+    \param cart_ranks Lookup table of the domain ranks, or NULL without domain decomposition
+*/
+bool isLocal(std::shared_ptr<ParticleData> pdata, Scalar3& pos, int3& img, const unsigned int *cart_ranks)
+    {
+    #ifdef ENABLE_MPI
+    if (cart_ranks)
+        return pdata->placeSnapshotParticle(pos, img, cart_ranks) == pdata->getExecConf()->getRank();
+    #endif
+    return true;
+    }
+
+//! Adds the local particles to the particle data
+/*! \param pdata Particle data
+    \param N Number of particles on all ranks
+    \param tag Tags of the local particles
+    \param pos Positions of the local particles
+    \param image Images of the local particles
+    \param type Type ids of the local particles
+*/
+void initializeLocalParticles(std::shared_ptr<ParticleData> pdata,
+                              unsigned int N,
+                              const std::vector<unsigned int>& tag,
+                              const std::vector<Scalar3>& pos,
+                              const std::vector<int3>& image,
+                              const std::vector<unsigned int>& type)
+    {
+    unsigned int n_local = (unsigned int)tag.size();
+    DistributedSnapshotParticleData<Scalar> local;
+    local.resize(n_local);
+    local.tag = tag;
+    local.nglobal = N;
+    for (unsigned int i = 0; i < pdata->getNTypes(); i++)
+        local.type_mapping.push_back(pdata->getNameByType(i));
+
+    for (unsigned int k = 0; k < n_local; k++)
+        {
+        local.pos[k] = vec3<Scalar>(pos[k]);
+        local.image[k] = image[k];
+        local.type[k] = type[k];
+        }
+
+    pdata->initializeFromDistributedSnapshot(local);
+    }
+
+//! Lookup table of the domain ranks, or NULL without domain decomposition
+/*! \param pdata Particle data
+*/
+std::unique_ptr< ArrayHandle<unsigned int> > getCartRanks(std::shared_ptr<ParticleData> pdata)
+    {
+    #ifdef ENABLE_MPI
+    std::shared_ptr<DomainDecomposition> decomposition = pdata->getDomainDecomposition();
+    if (decomposition)
+        return std::unique_ptr< ArrayHandle<unsigned int> >(new ArrayHandle<unsigned int>(
+            decomposition->getCartRanks(), access_location::host, access_mode::read));
+    #endif
+    return std::unique_ptr< ArrayHandle<unsigned int> >();
+    }
+} // end anonymous namespace
+
+/*! \param nx Number of unit cells along the first box vector
+    \param ny Number of unit cells along the second box vector
+    \param nz Number of unit cells along the third box vector
+    \param basis Positions of the particles in the unit cell, in fractions of the cell in [0,1)
+    \param basis_type Type id of each particle in the basis
+*/
+DistributedLatticeInitializer::DistributedLatticeInitializer(unsigned int nx,
+                                                             unsigned int ny,
+                                                             unsigned int nz,
+                                                             const std::vector<Scalar3>& basis,
+                                                             const std::vector<unsigned int>& basis_type)
+    : m_n(make_uint3(nx, ny, nz)), m_basis(basis), m_basis_type(basis_type), m_N(0)
+    {
+    if (nx == 0 || ny == 0 || nz == 0)
+        {
+        throw runtime_error("DistributedLatticeInitializer: the lattice needs at least one unit cell");
+        }
+    if (basis.size() == 0 || basis.size() != basis_type.size())
+        {
+        throw runtime_error("DistributedLatticeInitializer: each particle in the basis needs one type");
+        }
+    for (const Scalar3& b : basis)
+        {
+        if (b.x < 0 || b.x >= 1 || b.y < 0 || b.y >= 1 || b.z < 0 || b.z >= 1)
+            {
+            throw runtime_error("DistributedLatticeInitializer: the basis must lie in [0,1) of the unit cell");
+            }
+        }
+
+    uint64_t N = uint64_t(nx) * uint64_t(ny) * uint64_t(nz) * uint64_t(basis.size());
+    if (N > UINT_MAX)
+        {
+        throw runtime_error("DistributedLatticeInitializer: too many particles in the lattice");
+        }
+    m_N = (unsigned int)N;
+    }
+
+/*! \param sysdef System definition with the global box and the particle types, and no particles
+
+    This method is collective.
+*/
+void DistributedLatticeInitializer::initialize(std::shared_ptr<SystemDefinition> sysdef) const
+    {
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    const BoxDim& global_box = pdata->getGlobalBox();
+    const bool is_2d = sysdef->getNDimensions() == 2;
+    const unsigned int n_basis = (unsigned int)m_basis.size();
+
+    if (is_2d && m_n.z != 1)
+        {
+        throw runtime_error("DistributedLatticeInitializer: 2D lattices have one unit cell along z");
+        }
+    for (unsigned int t : m_basis_type)
+        {
+        if (t >= pdata->getNTypes())
+            {
+            throw runtime_error("DistributedLatticeInitializer: invalid type id in the basis");
+            }
+        }
+
+    Scalar3 lo, hi;
+    getLocalFractions(pdata, lo, hi);
+
+    // cells that overlap the local domain, padded by one cell for round off
+    auto cell_range = [](Scalar lo, Scalar hi, unsigned int n)
+        {
+        int first = std::max(int(floor(lo * n)) - 1, 0);
+        int last = std::min(int(ceil(hi * n)) + 1, int(n));
+        return std::make_pair(first, last);
+        };
+    std::pair<int, int> range_x = cell_range(lo.x, hi.x, m_n.x);
+    std::pair<int, int> range_y = cell_range(lo.y, hi.y, m_n.y);
+    std::pair<int, int> range_z = cell_range(lo.z, hi.z, m_n.z);
+
+    std::vector<unsigned int> tag;
+    std::vector<Scalar3> pos;
+    std::vector<int3> image;
+    std::vector<unsigned int> type;
+
+        {
+        std::unique_ptr< ArrayHandle<unsigned int> > h_cart_ranks = getCartRanks(pdata);
+        const unsigned int *cart_ranks = h_cart_ranks ? h_cart_ranks->data : NULL;
+
+        for (int k = range_z.first; k < range_z.second; k++)
+            for (int j = range_y.first; j < range_y.second; j++)
+                for (int i = range_x.first; i < range_x.second; i++)
+                    for (unsigned int b = 0; b < n_basis; b++)
+                        {
+                        Scalar3 f = make_scalar3((Scalar(i) + m_basis[b].x) / Scalar(m_n.x),
+                                                 (Scalar(j) + m_basis[b].y) / Scalar(m_n.y),
+                                                 (Scalar(k) + m_basis[b].z) / Scalar(m_n.z));
+                        Scalar3 p = global_box.makeCoordinates(f);
+                        if (is_2d)
+                            p.z = 0;
+
+                        int3 img = make_int3(0,0,0);
+                        if (!isLocal(pdata, p, img, cart_ranks))
+                            continue;
+
+                        tag.push_back(((unsigned int)(k * m_n.y + j) * m_n.x + i) * n_basis + b);
+                        pos.push_back(p);
+                        image.push_back(img);
+                        type.push_back(m_basis_type[b]);
+                        }
+        }
+
+    initializeLocalParticles(pdata, m_N, tag, pos, image, type);
+    }
+
+/*! \param N Number of particles to place
+    \param seed Random seed
+*/
+DistributedRandomInitializer::DistributedRandomInitializer(unsigned int N, unsigned int seed)
+    : m_N(N), m_seed(seed)
+    {
+    if (N == 0)
+        {
+        throw runtime_error("DistributedRandomInitializer: Cannot generate 0 particles");
+        }
+    }
+
+/*! \param sysdef System definition with the global box and the particle types, and no particles
+
+    This method is collective. All ranks use the seed of rank 0.
+*/
+void DistributedRandomInitializer::initialize(std::shared_ptr<SystemDefinition> sysdef) const
+    {
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    const BoxDim& global_box = pdata->getGlobalBox();
+    const bool is_2d = sysdef->getNDimensions() == 2;
+
+    unsigned int seed = m_seed;
+    unsigned int offset = 0;
+    unsigned int n_local = m_N;
+
+    #ifdef ENABLE_MPI
+    std::shared_ptr<DomainDecomposition> decomposition = pdata->getDomainDecomposition();
+    if (decomposition)
+        {
+        bcast(seed, 0, pdata->getExecConf()->getMPICommunicator());
+
+        // split the particles by the volume fractions of the domains, accumulated in the order of the domain grid
+        const Index3D& di = decomposition->getDomainIndexer();
+        const uint3 grid_pos = decomposition->getGridPos();
+        const unsigned int my_domain = di(grid_pos.x, grid_pos.y, grid_pos.z);
+        double cum_volume = 0.0;
+        unsigned int first = 0;
+        for (unsigned int d = 0; d < di.getNumElements(); d++)
+            {
+            const unsigned int x = d % di.getW();
+            const unsigned int y = (d / di.getW()) % di.getH();
+            const unsigned int z = d / (di.getW() * di.getH());
+            auto width = [&](unsigned int dir, unsigned int idx)
+                {
+                return double(decomposition->getCumulativeFraction(dir, idx+1)
+                              - decomposition->getCumulativeFraction(dir, idx));
+                };
+            cum_volume += width(0, x) * width(1, y) * width(2, z);
+            unsigned int last = (d + 1 == di.getNumElements()) ? m_N
+                                : std::min((unsigned int)floor(double(m_N) * cum_volume), m_N);
+            if (d == my_domain)
+                {
+                offset = first;
+                n_local = last - first;
+                }
+            first = last;
+            }
+        }
+    #endif
+
+    Scalar3 lo, hi;
+    getLocalFractions(pdata, lo, hi);
+
+    std::vector<unsigned int> tag(n_local);
+    std::vector<Scalar3> pos(n_local);
+    std::vector<int3> image(n_local, make_int3(0,0,0));
+    std::vector<unsigned int> type(n_local, 0);
+
+        {
+        std::unique_ptr< ArrayHandle<unsigned int> > h_cart_ranks = getCartRanks(pdata);
+        const unsigned int *cart_ranks = h_cart_ranks ? h_cart_ranks->data : NULL;
+
+        for (unsigned int k = 0; k < n_local; k++)
+            {
+            tag[k] = offset + k;
+            RandomGenerator rng(RNGIdentifier::DistributedRandomInitializer, seed, tag[k]);
+            UniformDistribution<Scalar> uniform(0, 1);
+
+            // draw again in the rare case that round off places the particle in a neighboring domain
+            unsigned int tries = 0;
+            bool done = false;
+            while (!done)
+                {
+                Scalar3 f = make_scalar3(lo.x + uniform(rng) * (hi.x - lo.x),
+                                         lo.y + uniform(rng) * (hi.y - lo.y),
+                                         lo.z + uniform(rng) * (hi.z - lo.z));
+                pos[k] = global_box.makeCoordinates(f);
+                if (is_2d)
+                    pos[k].z = 0;
+                image[k] = make_int3(0,0,0);
+                done = isLocal(pdata, pos[k], image[k], cart_ranks);
+
+                tries++;
+                if (!done && tries > 100)
+                    {
+                    throw runtime_error("Unable to place a particle in the local domain");
+                    }
+                }
+            }
+        }
+
+    initializeLocalParticles(pdata, m_N, tag, pos, image, type);
+    }
+
+void export_DistributedInitializers(pybind11::module& m)
+    {
+    pybind11::class_<DistributedLatticeInitializer, std::shared_ptr<DistributedLatticeInitializer> >(m,
+        "DistributedLatticeInitializer")
+        .def(pybind11::init<unsigned int,
+                            unsigned int,
+                            unsigned int,
+                            const std::vector<Scalar3>&,
+                            const std::vector<unsigned int>& >())
+        .def("initialize", &DistributedLatticeInitializer::initialize)
+        ;
+
+    pybind11::class_<DistributedRandomInitializer, std::shared_ptr<DistributedRandomInitializer> >(m,
+        "DistributedRandomInitializer")
+        .def(pybind11::init<unsigned int, unsigned int>())
+        .def("initialize", &DistributedRandomInitializer::initialize)
+        ;
+    }
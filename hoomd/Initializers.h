@@ -20,6 +20,9 @@
 //! Forward declaration of SnapshotSystemData
 template <class Real> struct SnapshotSystemData;
 
+//! Forward declaration of SystemDefinition
+class SystemDefinition;
+
 //! Inits a ParticleData with a simple cubic array of particles
 /*! A number of particles along each axis are specified along with a spacing
     between particles. This initializer only generates a single particle type.
@@ -70,4 +73,59 @@ class PYBIND11_EXPORT RandomInitializer
         std::string m_type_name;    //!< Name of the particle type created
     };
 
+//! Generates a lattice of particles in the local domain of each rank
+/*! The lattice has nx by ny by nz unit cells that fill the global box, and each cell holds the same basis of
+    particles, given in fractions of the cell. Each rank visits only the cells that overlap its domain and adds the
+    sites in its domain to the particle data, so neither a global snapshot on the root rank nor a scatter is needed.
+    The tag of a site follows from its cell and basis indices and does not depend on the domain decomposition.
+    \ingroup data_structs
+*/
+class PYBIND11_EXPORT DistributedLatticeInitializer
+    {
+    public:
+        //! Set the parameters
+        DistributedLatticeInitializer(unsigned int nx,
+                                      unsigned int ny,
+                                      unsigned int nz,
+                                      const std::vector<Scalar3>& basis,
+                                      const std::vector<unsigned int>& basis_type);
+        //! Empty Destructor
+        virtual ~DistributedLatticeInitializer() { }
+
+        //! Initializes the particle data with the sites in the local domain
+        void initialize(std::shared_ptr<SystemDefinition> sysdef) const;
+
+    private:
+        uint3 m_n;                                  //!< Number of unit cells along each box vector
+        std::vector<Scalar3> m_basis;               //!< Positions of the basis in fractions of the unit cell
+        std::vector<unsigned int> m_basis_type;     //!< Type id of each basis particle
+        unsigned int m_N;                           //!< Total number of particles
+    };
+
+//! Places particles uniformly at random in the local domain of each rank
+/*! The ranks split the N particles in proportion to the volumes of their domains, in the order of the domain grid,
+    so that every rank knows its number of particles and the first of its tags without communication. The position
+    of each particle is drawn from a random stream seeded with its tag. The particles may overlap and all have the
+    first type.
+    \ingroup data_structs
+*/
+class PYBIND11_EXPORT DistributedRandomInitializer
+    {
+    public:
+        //! Set the parameters
+        DistributedRandomInitializer(unsigned int N, unsigned int seed);
+        //! Empty Destructor
+        virtual ~DistributedRandomInitializer() { }
+
+        //! Initializes the particle data with the particles in the local domain
+        void initialize(std::shared_ptr<SystemDefinition> sysdef) const;
+
+    private:
+        unsigned int m_N;       //!< Total number of particles
+        unsigned int m_seed;    //!< Random seed
+    };
+
+//! Exports the distributed initializers to python
+void export_DistributedInitializers(pybind11::module& m);
+
 #endif
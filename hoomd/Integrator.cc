@@ -304,12 +304,33 @@ Scalar Integrator::computeTotalMomentum(unsigned int timestep)
     \post All added force computes in \a m_forces are computed and totaled up in \a m_net_force and \a m_net_virial
     \note The summation step is performed <b>on the CPU</b> and will result in a lot of data traffic back and forth
           if the forces and/or integrator are on the GPU. Call computeNetForcesGPU() to sum the forces on the GPU
+    \note When the communicator has a ghost update in flight, the forces that only involve local particles are
+          computed before and the remaining forces after completing it.
+    \note Forces with a RESPA period are skipped on the steps they are not active and scaled by their period on the
+          others (see the class documentation).
 */
 void Integrator::computeNetForce(unsigned int timestep)
     {
     std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
+
+    #ifdef ENABLE_MPI
+    if (m_comm && m_comm->isGhostUpdatePending())
+        {
+        for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+            {
+            if (isForceActive(*force_compute, timestep))
+                (*force_compute)->computeInterior(timestep);
+            }
+
+        m_comm->endCommunicate(timestep);
+        }
+    #endif
+
     for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->compute(timestep);
+        {
+        if (isForceActive(*force_compute, timestep))
+            (*force_compute)->compute(timestep);
+        }
 
     if (m_prof)
         {
@@ -349,6 +370,12 @@ void Integrator::computeNetForce(unsigned int timestep)
 
         for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
             {
+            if (!isForceActive(*force_compute, timestep))
+                continue;
+
+            // impulse of a slow force over its period
+            Scalar impulse = Scalar((*force_compute)->getRESPAPeriod());
+
             GlobalArray<Scalar4>& h_force_array = (*force_compute)->getForceArray();
             GlobalArray<Scalar>& h_virial_array = (*force_compute)->getVirialArray();
             GlobalArray<Scalar4>& h_torque_array = (*force_compute)->getTorqueArray();
@@ -364,14 +391,14 @@ void Integrator::computeNetForce(unsigned int timestep)
             size_t virial_pitch = h_virial_array.getPitch();
             for (unsigned int j = 0; j < nparticles; j++)
                 {
-                h_net_force.data[j].x += h_force.data[j].x;
-                h_net_force.data[j].y += h_force.data[j].y;
-                h_net_force.data[j].z += h_force.data[j].z;
+                h_net_force.data[j].x += impulse*h_force.data[j].x;
+                h_net_force.data[j].y += impulse*h_force.data[j].y;
+                h_net_force.data[j].z += impulse*h_force.data[j].z;
                 h_net_force.data[j].w += h_force.data[j].w;
 
-                h_net_torque.data[j].x += h_torque.data[j].x;
-                h_net_torque.data[j].y += h_torque.data[j].y;
-                h_net_torque.data[j].z += h_torque.data[j].z;
+                h_net_torque.data[j].x += impulse*h_torque.data[j].x;
+                h_net_torque.data[j].y += impulse*h_torque.data[j].y;
+                h_net_torque.data[j].z += impulse*h_torque.data[j].z;
                 h_net_torque.data[j].w += h_torque.data[j].w;
 
                 for (unsigned int k = 0; k < 6; k++)
@@ -497,12 +524,16 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         throw runtime_error("Error computing accelerations");
         }
 
-    // compute all the normal forces first
-
-    std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
-
-    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->compute(timestep);
+    // compute all the normal forces first, only those active in this step are computed and summed
+    std::vector< std::shared_ptr<ForceCompute> > forces;
+    for (auto& force_compute : m_forces)
+        {
+        if (isForceActive(force_compute, timestep))
+            {
+            force_compute->compute(timestep);
+            forces.push_back(force_compute);
+            }
+        }
 
     if (m_prof)
         {
@@ -539,7 +570,7 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         // there is no need to zero out the initial net force and virial here, the first call to the addition kernel
         // will do that
         // ahh!, but we do need to zer out the net force and virial if there are 0 forces!
-        if (m_forces.size() == 0)
+        if (forces.size() == 0)
             {
             // start by zeroing the net force and virial arrays
             hipMemset(d_net_force.data, 0, sizeof(Scalar4)*net_force.getNumElements());
@@ -552,86 +583,92 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         // now, add up the accelerations
         // sum all the forces into the net force
         // perform the sum in groups of 6 to avoid kernel launch and memory access overheads
-        for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force += 6)
+        for (unsigned int cur_force = 0; cur_force < forces.size(); cur_force += 6)
             {
             // grab the device pointers for the current set
             gpu_force_list force_list;
 
-            const GlobalArray<Scalar4>& d_force_array0 = m_forces[cur_force]->getForceArray();
+            const GlobalArray<Scalar4>& d_force_array0 = forces[cur_force]->getForceArray();
             ArrayHandle<Scalar4> d_force0(d_force_array0,access_location::device,access_mode::read);
-            const GlobalArray<Scalar>& d_virial_array0 = m_forces[cur_force]->getVirialArray();
+            const GlobalArray<Scalar>& d_virial_array0 = forces[cur_force]->getVirialArray();
             ArrayHandle<Scalar> d_virial0(d_virial_array0,access_location::device,access_mode::read);
-            const GlobalArray<Scalar4>& d_torque_array0 = m_forces[cur_force]->getTorqueArray();
+            const GlobalArray<Scalar4>& d_torque_array0 = forces[cur_force]->getTorqueArray();
             ArrayHandle<Scalar4> d_torque0(d_torque_array0,access_location::device,access_mode::read);
             force_list.f0 = d_force0.data;
             force_list.v0 = d_virial0.data;
             force_list.vpitch0 = d_virial_array0.getPitch();
             force_list.t0 = d_torque0.data;
+            force_list.s0 = Scalar(forces[cur_force]->getRESPAPeriod());
 
-            if (cur_force+1 < m_forces.size())
+            if (cur_force+1 < forces.size())
                 {
-                const GlobalArray<Scalar4>& d_force_array1 = m_forces[cur_force+1]->getForceArray();
+                const GlobalArray<Scalar4>& d_force_array1 = forces[cur_force+1]->getForceArray();
                 ArrayHandle<Scalar4> d_force1(d_force_array1,access_location::device,access_mode::read);
-                const GlobalArray<Scalar>& d_virial_array1 = m_forces[cur_force+1]->getVirialArray();
+                const GlobalArray<Scalar>& d_virial_array1 = forces[cur_force+1]->getVirialArray();
                 ArrayHandle<Scalar> d_virial1(d_virial_array1,access_location::device,access_mode::read);
-                const GlobalArray<Scalar4>& d_torque_array1 = m_forces[cur_force+1]->getTorqueArray();
+                const GlobalArray<Scalar4>& d_torque_array1 = forces[cur_force+1]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque1(d_torque_array1,access_location::device,access_mode::read);
                 force_list.f1 = d_force1.data;
                 force_list.v1 = d_virial1.data;
                 force_list.vpitch1 = d_virial_array1.getPitch();
                 force_list.t1 = d_torque1.data;
+                force_list.s1 = Scalar(forces[cur_force+1]->getRESPAPeriod());
                 }
-            if (cur_force+2 < m_forces.size())
+            if (cur_force+2 < forces.size())
                 {
-                const GlobalArray<Scalar4>& d_force_array2 = m_forces[cur_force+2]->getForceArray();
+                const GlobalArray<Scalar4>& d_force_array2 = forces[cur_force+2]->getForceArray();
                 ArrayHandle<Scalar4> d_force2(d_force_array2,access_location::device,access_mode::read);
-                const GlobalArray<Scalar>& d_virial_array2 = m_forces[cur_force+2]->getVirialArray();
+                const GlobalArray<Scalar>& d_virial_array2 = forces[cur_force+2]->getVirialArray();
                 ArrayHandle<Scalar> d_virial2(d_virial_array2,access_location::device,access_mode::read);
-                const GlobalArray<Scalar4>& d_torque_array2 = m_forces[cur_force+2]->getTorqueArray();
+                const GlobalArray<Scalar4>& d_torque_array2 = forces[cur_force+2]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque2(d_torque_array2,access_location::device,access_mode::read);
                 force_list.f2 = d_force2.data;
                 force_list.v2 = d_virial2.data;
                 force_list.vpitch2 = d_virial_array2.getPitch();
                 force_list.t2 = d_torque2.data;
+                force_list.s2 = Scalar(forces[cur_force+2]->getRESPAPeriod());
                 }
-            if (cur_force+3 < m_forces.size())
+            if (cur_force+3 < forces.size())
                 {
-                const GlobalArray<Scalar4>& d_force_array3 = m_forces[cur_force+3]->getForceArray();
+                const GlobalArray<Scalar4>& d_force_array3 = forces[cur_force+3]->getForceArray();
                 ArrayHandle<Scalar4> d_force3(d_force_array3,access_location::device,access_mode::read);
-                const GlobalArray<Scalar>& d_virial_array3 = m_forces[cur_force+3]->getVirialArray();
+                const GlobalArray<Scalar>& d_virial_array3 = forces[cur_force+3]->getVirialArray();
                 ArrayHandle<Scalar> d_virial3(d_virial_array3,access_location::device,access_mode::read);
-                const GlobalArray<Scalar4>& d_torque_array3 = m_forces[cur_force+3]->getTorqueArray();
+                const GlobalArray<Scalar4>& d_torque_array3 = forces[cur_force+3]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque3(d_torque_array3,access_location::device,access_mode::read);
                 force_list.f3 = d_force3.data;
                 force_list.v3 = d_virial3.data;
                 force_list.vpitch3 = d_virial_array3.getPitch();
                 force_list.t3 = d_torque3.data;
+                force_list.s3 = Scalar(forces[cur_force+3]->getRESPAPeriod());
                 }
-            if (cur_force+4 < m_forces.size())
+            if (cur_force+4 < forces.size())
                 {
-                const GlobalArray<Scalar4>& d_force_array4 = m_forces[cur_force+4]->getForceArray();
+                const GlobalArray<Scalar4>& d_force_array4 = forces[cur_force+4]->getForceArray();
                 ArrayHandle<Scalar4> d_force4(d_force_array4,access_location::device,access_mode::read);
-                const GlobalArray<Scalar>& d_virial_array4 = m_forces[cur_force+4]->getVirialArray();
+                const GlobalArray<Scalar>& d_virial_array4 = forces[cur_force+4]->getVirialArray();
                 ArrayHandle<Scalar> d_virial4(d_virial_array4,access_location::device,access_mode::read);
-                const GlobalArray<Scalar4>& d_torque_array4 = m_forces[cur_force+4]->getTorqueArray();
+                const GlobalArray<Scalar4>& d_torque_array4 = forces[cur_force+4]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque4(d_torque_array4,access_location::device,access_mode::read);
                 force_list.f4 = d_force4.data;
                 force_list.v4 = d_virial4.data;
                 force_list.vpitch4 = d_virial_array4.getPitch();
                 force_list.t4 = d_torque4.data;
+                force_list.s4 = Scalar(forces[cur_force+4]->getRESPAPeriod());
                 }
-            if (cur_force+5 < m_forces.size())
+            if (cur_force+5 < forces.size())
                 {
-                const GlobalArray<Scalar4>& d_force_array5 = m_forces[cur_force+5]->getForceArray();
+                const GlobalArray<Scalar4>& d_force_array5 = forces[cur_force+5]->getForceArray();
                 ArrayHandle<Scalar4> d_force5(d_force_array5,access_location::device,access_mode::read);
-                const GlobalArray<Scalar>& d_virial_array5 = m_forces[cur_force+5]->getVirialArray();
+                const GlobalArray<Scalar>& d_virial_array5 = forces[cur_force+5]->getVirialArray();
                 ArrayHandle<Scalar> d_virial5(d_virial_array5,access_location::device,access_mode::read);
-                const GlobalArray<Scalar4>& d_torque_array5 = m_forces[cur_force+5]->getTorqueArray();
+                const GlobalArray<Scalar4>& d_torque_array5 = forces[cur_force+5]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque5(d_torque_array5,access_location::device,access_mode::read);
                 force_list.f5 = d_force5.data;
                 force_list.v5 = d_virial5.data;
                 force_list.vpitch5 = d_virial_array5.getPitch();
                 force_list.t5 = d_torque5.data;
+                force_list.s5 = Scalar(forces[cur_force+5]->getRESPAPeriod());
                 }
 
             // clear on the first iteration only
@@ -660,11 +697,11 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         }
 
     // add up external virials and energies
-    for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force ++)
+    for (unsigned int cur_force = 0; cur_force < forces.size(); cur_force ++)
         {
         for (unsigned int k = 0; k < 6; k++)
-            external_virial[k] += m_forces[cur_force]->getExternalVirial(k);
-        external_energy += m_forces[cur_force]->getExternalEnergy();
+            external_virial[k] += forces[cur_force]->getExternalVirial(k);
+        external_energy += forces[cur_force]->getExternalEnergy();
         }
 
     for (unsigned int k = 0; k < 6; k++)
@@ -844,6 +881,143 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         }
 
     }
+
+/** @param timestep Time step the forces are computed at
+
+    The integration kernel can sum the net force when nothing reads the net force before the second half step: there
+    are no constraint forces and no HalfStepHook, and no forces on ghost particles are sent back to their owners. It
+    sums at most 6 forces, as many as one gpu_force_list holds.
+*/
+bool Integrator::canFuseNetForceGPU(unsigned int timestep)
+    {
+    if (!m_exec_conf->isCUDAEnabled() || m_constraint_forces.size() > 0 || m_half_step_hook)
+        return false;
+
+    unsigned int n_active = 0;
+    for (auto& force_compute : m_forces)
+        {
+        if (isForceActive(force_compute, timestep))
+            n_active++;
+        }
+
+    if (n_active > 6)
+        return false;
+
+    #ifdef ENABLE_MPI
+    if (m_comm && determineFlags(timestep)[comm_flag::reverse_net_force])
+        return false;
+    #endif
+
+    return true;
+    }
+
+/** @param timestep Current time step of the simulation
+    @param fused Net force sum for the integration kernel
+    \pre canFuseNetForceGPU() returns true
+    \post All active force computes are computed, and \a fused holds their force arrays and the net virial and torque
+          arrays. The integration kernel writes the net force of the particles it integrates.
+*/
+void Integrator::computeFusedNetForceGPU(unsigned int timestep, gpu_fused_net_force& fused)
+    {
+    // compute all the normal forces first, only those active in this step are computed and summed
+    std::vector< std::shared_ptr<ForceCompute> > forces;
+    for (auto& force_compute : m_forces)
+        {
+        if (isForceActive(force_compute, timestep))
+            {
+            force_compute->compute(timestep);
+            forces.push_back(force_compute);
+            }
+        }
+    assert(forces.size() <= 6);
+
+    if (m_prof)
+        {
+        m_prof->push(m_exec_conf, "Integrate");
+        m_prof->push(m_exec_conf, "Net force");
+        }
+
+    Scalar4 *f[6] = {NULL, NULL, NULL, NULL, NULL, NULL};
+    Scalar4 *t[6] = {NULL, NULL, NULL, NULL, NULL, NULL};
+    Scalar *v[6] = {NULL, NULL, NULL, NULL, NULL, NULL};
+    size_t vpitch[6] = {0, 0, 0, 0, 0, 0};
+    Scalar s[6] = {1, 1, 1, 1, 1, 1};
+
+    Scalar external_virial[6] = {0, 0, 0, 0, 0, 0};
+    Scalar external_energy(0.0);
+
+    for (unsigned int cur_force = 0; cur_force < forces.size(); cur_force++)
+        {
+        ArrayHandle<Scalar4> d_force(forces[cur_force]->getForceArray(), access_location::device, access_mode::read);
+        ArrayHandle<Scalar> d_virial(forces[cur_force]->getVirialArray(), access_location::device, access_mode::read);
+        ArrayHandle<Scalar4> d_torque(forces[cur_force]->getTorqueArray(), access_location::device,
+            access_mode::read);
+        f[cur_force] = d_force.data;
+        t[cur_force] = d_torque.data;
+        v[cur_force] = d_virial.data;
+        vpitch[cur_force] = forces[cur_force]->getVirialArray().getPitch();
+        s[cur_force] = Scalar(forces[cur_force]->getRESPAPeriod());
+
+        for (unsigned int k = 0; k < 6; k++)
+            external_virial[k] += forces[cur_force]->getExternalVirial(k);
+        external_energy += forces[cur_force]->getExternalEnergy();
+        }
+
+    gpu_force_list& force_list = fused.force_list;
+    force_list.f0 = f[0];
+    force_list.t0 = t[0];
+    force_list.v0 = v[0];
+    force_list.vpitch0 = vpitch[0];
+    force_list.s0 = s[0];
+    force_list.f1 = f[1];
+    force_list.t1 = t[1];
+    force_list.v1 = v[1];
+    force_list.vpitch1 = vpitch[1];
+    force_list.s1 = s[1];
+    force_list.f2 = f[2];
+    force_list.t2 = t[2];
+    force_list.v2 = v[2];
+    force_list.vpitch2 = vpitch[2];
+    force_list.s2 = s[2];
+    force_list.f3 = f[3];
+    force_list.t3 = t[3];
+    force_list.v3 = v[3];
+    force_list.vpitch3 = vpitch[3];
+    force_list.s3 = s[3];
+    force_list.f4 = f[4];
+    force_list.t4 = t[4];
+    force_list.v4 = v[4];
+    force_list.vpitch4 = vpitch[4];
+    force_list.s4 = s[4];
+    force_list.f5 = f[5];
+    force_list.t5 = t[5];
+    force_list.v5 = v[5];
+    force_list.vpitch5 = vpitch[5];
+    force_list.s5 = s[5];
+
+        {
+        ArrayHandle<Scalar> d_net_virial(m_pdata->getNetVirial(), access_location::device, access_mode::readwrite);
+        ArrayHandle<Scalar4> d_net_torque(m_pdata->getNetTorqueArray(), access_location::device,
+            access_mode::readwrite);
+
+        fused.enabled = true;
+        fused.d_net_virial = d_net_virial.data;
+        fused.net_virial_pitch = m_pdata->getNetVirial().getPitch();
+        fused.d_net_torque = d_net_torque.data;
+        fused.compute_virial = m_pdata->getFlags()[pdata_flag::pressure_tensor];
+        }
+
+    for (unsigned int k = 0; k < 6; k++)
+        m_pdata->setExternalVirial(k, external_virial[k]);
+
+    m_pdata->setExternalEnergy(external_energy);
+
+    if (m_prof)
+        {
+        m_prof->pop(m_exec_conf);
+        m_prof->pop(m_exec_conf);
+        }
+    }
 #endif
 
 /** The base class integrator actually does nothing in update()
@@ -14,33 +14,6 @@
     \brief Defines methods and data structures used by the Integrator class on the GPU
 */
 
-//! helper to add a given force/virial pointer pair
-template< unsigned int compute_virial >
-__device__ void add_force_total(Scalar4& net_force, Scalar *net_virial, Scalar4& net_torque, Scalar4* d_f, Scalar* d_v, const size_t virial_pitch, Scalar4* d_t, int idx)
-    {
-    if (d_f != NULL && d_v != NULL && d_t != NULL)
-        {
-        Scalar4 f = d_f[idx];
-        Scalar4 t = d_t[idx];
-
-        net_force.x += f.x;
-        net_force.y += f.y;
-        net_force.z += f.z;
-        net_force.w += f.w;
-
-        if (compute_virial)
-            {
-            for (int i=0; i < 6; i++)
-                net_virial[i] += d_v[i*virial_pitch+idx];
-            }
-
-        net_torque.x += t.x;
-        net_torque.y += t.y;
-        net_torque.z += t.z;
-        net_torque.w += t.w;
-        }
-    }
-
 //! Kernel for summing forces on the GPU
 /*! The specified forces and virials are summed for every particle into \a d_net_force and \a d_net_virial
 
@@ -100,12 +73,12 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4 *d_net_force,
             }
 
         // sum up the totals
-        add_force_total<compute_virial>(net_force, net_virial, net_torque, force_list.f0, force_list.v0, force_list.vpitch0, force_list.t0, idx);
-        add_force_total<compute_virial>(net_force, net_virial, net_torque, force_list.f1, force_list.v1, force_list.vpitch1, force_list.t1, idx);
-        add_force_total<compute_virial>(net_force, net_virial, net_torque, force_list.f2, force_list.v2, force_list.vpitch2, force_list.t2, idx);
-        add_force_total<compute_virial>(net_force, net_virial, net_torque, force_list.f3, force_list.v3, force_list.vpitch3, force_list.t3, idx);
-        add_force_total<compute_virial>(net_force, net_virial, net_torque, force_list.f4, force_list.v4, force_list.vpitch4, force_list.t4, idx);
-        add_force_total<compute_virial>(net_force, net_virial, net_torque, force_list.f5, force_list.v5, force_list.vpitch5, force_list.t5, idx);
+        add_force_total<compute_virial>(net_force, net_virial, net_torque, force_list.f0, force_list.v0, force_list.vpitch0, force_list.t0, force_list.s0, idx);
+        add_force_total<compute_virial>(net_force, net_virial, net_torque, force_list.f1, force_list.v1, force_list.vpitch1, force_list.t1, force_list.s1, idx);
+        add_force_total<compute_virial>(net_force, net_virial, net_torque, force_list.f2, force_list.v2, force_list.vpitch2, force_list.t2, force_list.s2, idx);
+        add_force_total<compute_virial>(net_force, net_virial, net_torque, force_list.f3, force_list.v3, force_list.vpitch3, force_list.t3, force_list.s3, idx);
+        add_force_total<compute_virial>(net_force, net_virial, net_torque, force_list.f4, force_list.v4, force_list.vpitch4, force_list.t4, force_list.s4, idx);
+        add_force_total<compute_virial>(net_force, net_virial, net_torque, force_list.f5, force_list.v5, force_list.vpitch5, force_list.t5, force_list.s5, idx);
 
         // write out the final result
         d_net_force[idx] = net_force;
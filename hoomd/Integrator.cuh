@@ -27,7 +27,8 @@ struct gpu_force_list
         : f0(NULL), f1(NULL), f2(NULL), f3(NULL), f4(NULL), f5(NULL),
           t0(NULL), t1(NULL), t2(NULL), t3(NULL), t4(NULL), t5(NULL),
           v0(NULL), v1(NULL), v2(NULL), v3(NULL), v4(NULL), v5(NULL),
-          vpitch0(0), vpitch1(0), vpitch2(0), vpitch3(0), vpitch4(0), vpitch5(0)
+          vpitch0(0), vpitch1(0), vpitch2(0), vpitch3(0), vpitch4(0), vpitch5(0),
+          s0(1), s1(1), s2(1), s3(1), s4(1), s5(1)
           {
           }
 
@@ -58,8 +59,108 @@ struct gpu_force_list
     size_t vpitch3; //!< Pitch of virial array 3
     size_t vpitch4; //!< Pitch of virial array 4
     size_t vpitch5; //!< Pitch of virial array 5
+
+    Scalar s0; //!< Factor applied to force and torque 0 (the RESPA period)
+    Scalar s1; //!< Factor applied to force and torque 1
+    Scalar s2; //!< Factor applied to force and torque 2
+    Scalar s3; //!< Factor applied to force and torque 3
+    Scalar s4; //!< Factor applied to force and torque 4
+    Scalar s5; //!< Factor applied to force and torque 5
  };
 
+//! Arguments to sum the net force inside the kernel of an integration method
+/*! When \a enabled is set, the integration kernel sums \a force_list into the net force, net virial, and net torque of
+    each particle it integrates before using the net force, as gpu_integrator_sum_net_force() would.
+*/
+struct gpu_fused_net_force
+    {
+    //! Initializes to a disabled sum
+    gpu_fused_net_force()
+        : enabled(false), d_net_virial(NULL), net_virial_pitch(0), d_net_torque(NULL), compute_virial(false)
+        {
+        }
+
+    bool enabled;                   //!< True if the integration kernel sums the net force
+    gpu_force_list force_list;      //!< Forces to sum
+    Scalar *d_net_virial;           //!< Net virial to write
+    size_t net_virial_pitch;        //!< Pitch of the net virial array
+    Scalar4 *d_net_torque;          //!< Net torque to write
+    bool compute_virial;            //!< True if the net virial is summed
+    };
+
+#ifdef __HIPCC__
+//! helper to add a given force/virial pointer pair
+template< unsigned int compute_virial >
+__device__ inline void add_force_total(Scalar4& net_force, Scalar *net_virial, Scalar4& net_torque, Scalar4* d_f, Scalar* d_v, const size_t virial_pitch, Scalar4* d_t, Scalar s, int idx)
+    {
+    if (d_f != NULL && d_v != NULL && d_t != NULL)
+        {
+        Scalar4 f = d_f[idx];
+        Scalar4 t = d_t[idx];
+
+        // the energy and virial are not scaled
+        net_force.x += s*f.x;
+        net_force.y += s*f.y;
+        net_force.z += s*f.z;
+        net_force.w += f.w;
+
+        if (compute_virial)
+            {
+            for (int i=0; i < 6; i++)
+                net_virial[i] += d_v[i*virial_pitch+idx];
+            }
+
+        net_torque.x += s*t.x;
+        net_torque.y += s*t.y;
+        net_torque.z += s*t.z;
+        net_torque.w += t.w;
+        }
+    }
+
+//! Sum and write the net force of one particle in an integration kernel
+/*! \param fused Forces to sum and net virial and torque arrays
+    \param d_net_force Net force array
+    \param idx Particle index
+
+    \returns The net force on particle \a idx
+*/
+__device__ inline Scalar4 gpu_fused_net_force_sum(const gpu_fused_net_force& fused, Scalar4 *d_net_force, int idx)
+    {
+    const gpu_force_list& force_list = fused.force_list;
+
+    Scalar4 net_force = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
+    Scalar4 net_torque = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
+    Scalar net_virial[6] = {Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0)};
+
+    if (fused.compute_virial)
+        {
+        add_force_total<1>(net_force, net_virial, net_torque, force_list.f0, force_list.v0, force_list.vpitch0, force_list.t0, force_list.s0, idx);
+        add_force_total<1>(net_force, net_virial, net_torque, force_list.f1, force_list.v1, force_list.vpitch1, force_list.t1, force_list.s1, idx);
+        add_force_total<1>(net_force, net_virial, net_torque, force_list.f2, force_list.v2, force_list.vpitch2, force_list.t2, force_list.s2, idx);
+        add_force_total<1>(net_force, net_virial, net_torque, force_list.f3, force_list.v3, force_list.vpitch3, force_list.t3, force_list.s3, idx);
+        add_force_total<1>(net_force, net_virial, net_torque, force_list.f4, force_list.v4, force_list.vpitch4, force_list.t4, force_list.s4, idx);
+        add_force_total<1>(net_force, net_virial, net_torque, force_list.f5, force_list.v5, force_list.vpitch5, force_list.t5, force_list.s5, idx);
+
+        for (int i=0; i < 6; i++)
+            fused.d_net_virial[i*fused.net_virial_pitch+idx] = net_virial[i];
+        }
+    else
+        {
+        add_force_total<0>(net_force, net_virial, net_torque, force_list.f0, force_list.v0, force_list.vpitch0, force_list.t0, force_list.s0, idx);
+        add_force_total<0>(net_force, net_virial, net_torque, force_list.f1, force_list.v1, force_list.vpitch1, force_list.t1, force_list.s1, idx);
+        add_force_total<0>(net_force, net_virial, net_torque, force_list.f2, force_list.v2, force_list.vpitch2, force_list.t2, force_list.s2, idx);
+        add_force_total<0>(net_force, net_virial, net_torque, force_list.f3, force_list.v3, force_list.vpitch3, force_list.t3, force_list.s3, idx);
+        add_force_total<0>(net_force, net_virial, net_torque, force_list.f4, force_list.v4, force_list.vpitch4, force_list.t4, force_list.s4, idx);
+        add_force_total<0>(net_force, net_virial, net_torque, force_list.f5, force_list.v5, force_list.vpitch5, force_list.t5, force_list.s5, idx);
+        }
+
+    d_net_force[idx] = net_force;
+    fused.d_net_torque[idx] = net_torque;
+
+    return net_force;
+    }
+#endif
+
 //! Driver for gpu_integrator_sum_net_force_kernel()
 hipError_t gpu_integrator_sum_net_force(Scalar4 *d_net_force,
                                          Scalar *d_net_virial,
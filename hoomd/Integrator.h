@@ -18,6 +18,7 @@
 
 #ifdef ENABLE_HIP
 #include <hip/hip_runtime.h>
+#include "Integrator.cuh"
 #endif
 
 /// Base class that defines an integrator
@@ -42,6 +43,12 @@
     via the constraint forces can be totaled up with a call to getNDOFRemoved for convenience in derived classes
     implementing correct counting in getTranslationalDOF() and getRotationalDOF().
 
+    A ForceCompute with ForceCompute::getRESPAPeriod() \a k > 1 is only computed on the time steps that are a
+    multiple of \a k, where its force and torque enter the net force multiplied by \a k. The half step kicks of the
+    integration methods on either side of such a step then apply the impulse of the slow force over the whole period,
+    which is r-RESPA in impulse form with the other forces integrated at \a deltaT. Energies and virials are not
+    multiplied, and only include the slow forces on the steps they are computed.
+
     Integrators take "ownership" of the particle's accelerations. Any other updater
     that modifies the particles accelerations will produce undefined results. If
     accelerations are to be modified, they must be done through forces, and added to
@@ -175,8 +182,20 @@ class PYBIND11_EXPORT Integrator : public Updater
 #ifdef ENABLE_HIP
         /// helper function to compute net force/virial on the GPU
         void computeNetForceGPU(unsigned int timestep);
+
+        /// Test if the net force sum can be performed by the integration kernel
+        bool canFuseNetForceGPU(unsigned int timestep);
+
+        /// helper function to compute the forces and set up the net force sum in the integration kernel
+        void computeFusedNetForceGPU(unsigned int timestep, gpu_fused_net_force& fused);
 #endif
 
+        /// Test if a force is computed at the given time step in multiple time step integration
+        static bool isForceActive(const std::shared_ptr<ForceCompute>& fc, unsigned int timestep)
+            {
+            return timestep % fc->getRESPAPeriod() == 0;
+            }
+
 #ifdef ENABLE_MPI
         /// helper function to determine the ghost communication flags
         CommFlags determineFlags(unsigned int timestep);
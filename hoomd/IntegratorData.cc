@@ -25,3 +25,19 @@ unsigned int IntegratorData::registerIntegrator()
     // return the handle
     return i;
     }
+
+/*! Each registered integrator whose variables have the restored type and count gets the restored variables. Integrators
+    that did not accept the restored variables when they were constructed keep their own. The restored variables are
+    applied only once.
+*/
+void IntegratorData::applyRestored()
+    {
+    for (unsigned int i = 0; i < m_restored.size() && i < m_num_registered; i++)
+        {
+        const IntegratorVariables& v = m_restored[i];
+        if (m_integrator_variables[i].type == v.type && m_integrator_variables[i].variable.size() == v.variable.size())
+            m_integrator_variables[i] = v;
+        }
+
+    m_restored.clear();
+    }
@@ -115,9 +115,26 @@ class PYBIND11_EXPORT IntegratorData
             assert(i < m_integrator_variables.size()); m_integrator_variables[i] = v;
             }
 
+        //! Restore integrator variables read from a file
+        /*! \param variables Variables of the integrators in registration order
+
+            The variables are preloaded like load(), so integrators that register later find them. Python operations
+            set their parameters when they attach, which may overwrite the preloaded values, so the variables are also
+            kept until applyRestored() sets them again at the start of the next run.
+        */
+        void restore(const std::vector<IntegratorVariables>& variables)
+            {
+            m_integrator_variables = variables;
+            m_restored = variables;
+            }
+
+        //! Set the restored variables of the registered integrators
+        void applyRestored();
+
     private:
         unsigned int m_num_registered;                                  //!< Number of integrators that have registered
         std::vector<IntegratorVariables> m_integrator_variables;        //!< List of the integrator variables defined
+        std::vector<IntegratorVariables> m_restored;                    //!< Restored variables not yet applied
 
     };
 
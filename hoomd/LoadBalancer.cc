@@ -14,6 +14,7 @@
 #include "hoomd/extern/BVLSSolver.h"
 #include <Eigen/Dense>
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <vector>
@@ -34,7 +35,9 @@ LoadBalancer::LoadBalancer(std::shared_ptr<SystemDefinition> sysdef,
         : Tuner(sysdef, trigger), m_decomposition(decomposition),
           m_mpi_comm(m_exec_conf->getMPICommunicator()), m_max_imbalance(Scalar(1.0)),
           m_recompute_max_imbalance(true), m_needs_migrate(false),
-          m_needs_recount(false), m_tolerance(Scalar(1.05)), m_maxiter(1),
+          m_fit(false), m_fit_pending(false), m_needs_recount(false), m_time_weighted(false),
+          m_cost_per_particle(Scalar(1.0)), m_last_time(0),
+          m_last_comm_time(0), m_last_timestep(0), m_has_measurement(false), m_tolerance(Scalar(1.05)), m_maxiter(1),
           m_max_scale(Scalar(0.05)), m_N_own(m_pdata->getN()),
           m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0),
           m_n_iterations(0), m_n_rebalances(0)
@@ -53,11 +56,79 @@ LoadBalancer::~LoadBalancer()
     m_exec_conf->msg->notice(5) << "Destroying LoadBalancer" << endl;
     }
 
+/*!
+ * \param weight "particles" or "time"
+ */
+void LoadBalancer::setWeight(const std::string& weight)
+    {
+    if (weight == "particles")
+        {
+        m_time_weighted = false;
+        }
+    else if (weight == "time")
+        {
+        m_time_weighted = true;
+        }
+    else
+        {
+        m_exec_conf->msg->error() << "comm.balance: unknown weight " << weight << endl;
+        throw runtime_error("Error setting load balancer weight");
+        }
+
+    // the next call starts a fresh measurement
+    m_has_measurement = false;
+    m_cost_per_particle = Scalar(1.0);
+    m_recompute_max_imbalance = true;
+    }
+
+/*!
+ * \param timestep Current time step of the simulation
+ *
+ * The compute time of a rank is the wall clock time per step since startMeasurement() minus the time spent in
+ * communication, which includes the time spent waiting on slower ranks. The cost of a particle is the compute time
+ * divided by the number of particles on the rank, normalized by the average over all ranks that own particles. Ranks
+ * without particles get the average cost.
+ *
+ * Without a measurement, or when weighting by particles, every particle has cost 1.
+ */
+void LoadBalancer::measureCost(unsigned int timestep)
+    {
+    m_cost_per_particle = Scalar(1.0);
+    if (!m_time_weighted || !m_has_measurement || timestep <= m_last_timestep)
+        return;
+
+    int64_t elapsed = (m_clk.getTime() - m_last_time) - (m_comm->getCommunicationTime() - m_last_comm_time);
+    double compute_time = double(std::max(elapsed, int64_t(0))) / double(timestep - m_last_timestep);
+
+    unsigned int N = m_pdata->getN();
+    double cost[2];
+    cost[0] = (N > 0) ? compute_time / double(N) : 0.0;
+    cost[1] = (N > 0) ? 1.0 : 0.0;
+    MPI_Allreduce(MPI_IN_PLACE, cost, 2, MPI_DOUBLE, MPI_SUM, m_mpi_comm);
+
+    double mean_cost = (cost[1] > 0.0) ? cost[0] / cost[1] : 0.0;
+    if (N > 0 && mean_cost > 0.0)
+        m_cost_per_particle = Scalar((compute_time / double(N)) / mean_cost);
+
+    m_recompute_max_imbalance = true;
+    }
+
+/*!
+ * \param timestep Current time step of the simulation
+ */
+void LoadBalancer::startMeasurement(unsigned int timestep)
+    {
+    m_last_time = m_clk.getTime();
+    m_last_comm_time = m_comm->getCommunicationTime();
+    m_last_timestep = timestep;
+    m_has_measurement = true;
+    }
+
 /*!
  * \param timestep Current time step of the simulation
  *
- * Computes the load imbalance along each slice and adjusts the domain boundaries. This process is repeated iteratively
- * in each dimension taking into account the adjusted boundaries each time.
+ * Computes the load imbalance along each slice and adjusts the domain boundaries. Each iteration reduces the loads of
+ * all dimensions at once and adjusts them together, taking into account the adjusted boundaries of the previous one.
  */
 void LoadBalancer::update(unsigned int timestep)
     {
@@ -69,6 +140,9 @@ void LoadBalancer::update(unsigned int timestep)
     // no adjustment has been made yet, so set m_N_own to the number of particles on the rank
     resetNOwn(m_pdata->getN());
 
+    // weight the particles by the compute time measured since the last call
+    measureCost(timestep);
+
     // figure out which rank is the reduction root for broadcasting
     const Index3D& di = m_decomposition->getDomainIndexer();
     unsigned int reduce_root(0);
@@ -82,57 +156,35 @@ void LoadBalancer::update(unsigned int timestep)
     Scalar3 L = box.getL();
     const Scalar3 min_domain_frac = Scalar(2.0)*m_comm->getGhostLayerMaxWidth()/box.getNearestPlaneDistance();
 
-    // compute the current imbalance always for the average in printed stats
-    m_total_max_imbalance += getMaxImbalance();
-    ++m_n_calls;
-
-    // attempt load balancing
-    for (unsigned int cur_iter=0; cur_iter < m_maxiter && getMaxImbalance() > m_tolerance; ++cur_iter)
+    // place the boundaries at the quantiles of the load once, the iterations below refine them
+    if (m_fit_pending)
         {
-        // increment the number of attempted balances
-        ++m_n_iterations;
+        m_fit_pending = false;
 
-        for (unsigned int dim=0; dim < m_sysdef->getNDimensions() && getMaxImbalance() > m_tolerance; ++dim)
+        for (unsigned int dim=0; dim < m_sysdef->getNDimensions(); ++dim)
             {
-            Scalar L_i(0.0);
             Scalar min_frac_i(0.0);
             if (dim == 0)
                 {
-                if (!m_enable_x || di.getW() == 1) continue; // skip this dimension if balancing is turned off
-                L_i = L.x;
+                if (!m_enable_x || di.getW() == 1) continue;
                 min_frac_i = min_domain_frac.x;
                 }
             else if (dim == 1)
                 {
                 if (!m_enable_y || di.getH() == 1) continue;
-                L_i = L.y;
                 min_frac_i = min_domain_frac.y;
                 }
             else
                 {
                 if (!m_enable_z || di.getD() == 1) continue;
-                L_i = L.z;
                 min_frac_i = min_domain_frac.z;
                 }
 
-            vector<unsigned int> N_i;
-            bool adjusted = false;
-
-            // reduce the number of particles in the slice along dim
-            bool active = reduce(N_i, dim, reduce_root);
-
-            // attempt an adjustment
             vector<Scalar> cum_frac = m_decomposition->getCumulativeFractions(dim);
-            if (active)
-                {
-                adjusted = adjust(cum_frac, N_i, L_i, min_frac_i);
-                }
+            bool fitted = fitQuantiles(cum_frac, dim, reduce_root, min_frac_i);
 
-            // broadcast if an adjustment has been made on the root
-            bcast(adjusted, reduce_root, m_mpi_comm);
-
-            // update the cumulative fractions and signal
-            if (adjusted)
+            bcast(fitted, reduce_root, m_mpi_comm);
+            if (fitted)
                 {
                 m_decomposition->setCumulativeFractions(dim, cum_frac, reduce_root);
                 m_pdata->setGlobalBox(box); // force a domain resizing to trigger
@@ -140,143 +192,267 @@ void LoadBalancer::update(unsigned int timestep)
                 }
             }
 
-        // force a particle migration if one is needed
         if (m_needs_migrate)
+            migrate(timestep);
+        }
+
+    // compute the current imbalance always for the average in printed stats, along with the loads in the slices
+    vector<Scalar> W_x, W_y, W_z;
+    Scalar max_imbalance = reduceLoads(W_x, W_y, W_z);
+    m_total_max_imbalance += max_imbalance;
+    ++m_n_calls;
+
+    // attempt load balancing
+    for (unsigned int cur_iter=0; cur_iter < m_maxiter && max_imbalance > m_tolerance; ++cur_iter)
+        {
+        // increment the number of attempted balances
+        ++m_n_iterations;
+
+        vector<Scalar> old_cum_frac[3];
+        vector<Scalar> cum_frac[3];
+        for (unsigned int dim=0; dim < 3; ++dim)
             {
-            m_comm->forceMigrate();
-            m_comm->communicate(timestep);
-            resetNOwn(m_pdata->getN());
-            m_needs_migrate = false;
+            old_cum_frac[dim] = m_decomposition->getCumulativeFractions(dim);
+            cum_frac[dim] = old_cum_frac[dim];
+            }
 
-            // increment the number of rebalances actually performed
-            ++m_n_rebalances;
+        // The load in a slice along one dimension does not depend on the cuts along the others, so the root adjusts
+        // all dimensions from the same reduction
+        if (m_exec_conf->getRank() == reduce_root)
+            {
+            for (unsigned int dim=0; dim < m_sysdef->getNDimensions(); ++dim)
+                {
+                if (dim == 0)
+                    {
+                    if (!m_enable_x || di.getW() == 1) continue; // skip this dimension if balancing is turned off
+                    adjust(cum_frac[0], W_x, L.x, min_domain_frac.x);
+                    }
+                else if (dim == 1)
+                    {
+                    if (!m_enable_y || di.getH() == 1) continue;
+                    adjust(cum_frac[1], W_y, L.y, min_domain_frac.y);
+                    }
+                else
+                    {
+                    if (!m_enable_z || di.getD() == 1) continue;
+                    adjust(cum_frac[2], W_z, L.z, min_domain_frac.z);
+                    }
+                }
             }
+
+        // broadcast the fractions of all dimensions at once
+        m_decomposition->setCumulativeFractions(cum_frac[0], cum_frac[1], cum_frac[2], reduce_root);
+
+        bool adjusted = false;
+        for (unsigned int dim=0; dim < 3; ++dim)
+            {
+            if (m_decomposition->getCumulativeFractions(dim) != old_cum_frac[dim])
+                adjusted = true;
+            }
+
+        // stop if the root could not improve any dimension
+        if (!adjusted)
+            break;
+
+        m_pdata->setGlobalBox(box); // force a domain resizing to trigger
+        signalResize();
+
+        // force a particle migration if one is needed
+        if (m_needs_migrate)
+            migrate(timestep);
+
+        // the next iteration starts from the new loads
+        if (cur_iter + 1 < m_maxiter)
+            max_imbalance = reduceLoads(W_x, W_y, W_z);
         }
 
+    // exclude the balancing itself from the next measurement
+    if (m_time_weighted)
+        startMeasurement(timestep);
+
     if (m_prof) m_prof->pop(m_exec_conf);
     }
 
 /*!
- * Computes the imbalance factor I = N / <N> for each rank, and computes the maximum among all ranks.
+ * \param timestep Current time step of the simulation
  */
-Scalar LoadBalancer::getMaxImbalance()
+void LoadBalancer::migrate(unsigned int timestep)
     {
-    if (m_recompute_max_imbalance)
-        {
-        Scalar cur_imb = Scalar(getNOwn()) / (Scalar(m_pdata->getNGlobal()) / Scalar(m_exec_conf->getNRanks()));
-        Scalar max_imb(0.0);
-        MPI_Allreduce(&cur_imb, &max_imb, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_mpi_comm);
-
-        m_max_imbalance = max_imb;
-        m_recompute_max_imbalance = false;
+    m_comm->forceMigrate();
+    m_comm->communicate(timestep);
+    resetNOwn(m_pdata->getN());
+    m_needs_migrate = false;
 
-        // save as a statistic if new max imbalance
-        if (m_max_imbalance > m_max_max_imbalance)
-            m_max_max_imbalance = m_max_imbalance;
-        }
-    return m_max_imbalance;
+    // increment the number of rebalances actually performed
+    ++m_n_rebalances;
     }
 
 /*!
- * \param N_i Vector holding the total number of particles in each slice (will be allocated on call)
- * \param dim The dimension of the slices (x=0, y=1, z=2)
+ * \param cum_frac_i The cumulative fraction array to write output into
+ * \param dim The dimension of the cut planes (x=0, y=1, z=2)
  * \param reduce_root The rank to perform the reduction on
- * \returns true if the current rank holds the active \a N_i
+ * \param min_domain_frac The minimum fractional width of a domain
+ * \returns true on \a reduce_root if new fractions were computed
  *
- * \post \a N_i holds the number of particles in each slice along \a dim
- *
- * \note reduce() relies on collective MPI calls, and so all ranks must call it. However, for efficiency the data will
- *       be active only on Cartesian rank \a reduce_root, as indicated by the return value. As a result, only \a reduce_root
- *       actually needs to allocate memory for \a N_i.
- *
- * The reduction is performed by performing an all-to-one gather, followed by summation on \a reduce_root. This
- * operation may be suboptimal for very large numbers of processors, and could be replaced by cascading send operations
- * down dimensions. Generally, load balancing should not be performed too frequently, and so we do not pursue this
- * optimization right now.
+ * Every rank bins the loads of its particles by their fractional coordinate along \a dim, and the histograms are
+ * summed on \a reduce_root. The cut plane below domain j is placed where the cumulative load reaches j/n of the total,
+ * interpolating linearly within a bin. The cuts are then moved apart as needed so that every domain is at least
+ * \a min_domain_frac wide.
  */
-bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root)
+bool LoadBalancer::fitQuantiles(std::vector<Scalar>& cum_frac_i,
+                                unsigned int dim,
+                                unsigned int reduce_root,
+                                Scalar min_domain_frac)
     {
-    // do nothing if there is only one rank
-    if (N_i.size() == 1) return false;
+    const unsigned int n_domains = (unsigned int)cum_frac_i.size() - 1;
+    const unsigned int n_bins = 64 * n_domains;
 
-    const Index3D& di = m_decomposition->getDomainIndexer();
-    std::vector<unsigned int> N_per_rank(di.getNumElements());
+    std::vector<double> hist(n_bins, 0.0);
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        const BoxDim& global_box = m_pdata->getGlobalBox();
 
-    // get the number of particles the current rank owns (the quantity to be reduced)
-    unsigned int N_own = getNOwn();
+        for (unsigned int cur_p=0; cur_p < m_pdata->getN(); ++cur_p)
+            {
+            const Scalar4 postype = h_pos.data[cur_p];
+            const Scalar3 f = global_box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+            const Scalar f_i = (dim == 0) ? f.x : ((dim == 1) ? f.y : f.z);
 
-    MPI_Gather(&N_own, 1, MPI_UNSIGNED, &N_per_rank[0], 1, MPI_UNSIGNED, reduce_root, m_mpi_comm);
+            int bin = int(f_i * Scalar(n_bins));
+            bin = std::min(std::max(bin, 0), int(n_bins) - 1);
+            hist[bin] += double(m_cost_per_particle);
+            }
+        }
 
-    // only the root rank performs the reduction
+    std::vector<double> total_hist(n_bins, 0.0);
+    MPI_Reduce(&hist[0], &total_hist[0], n_bins, MPI_DOUBLE, MPI_SUM, reduce_root, m_mpi_comm);
+
+    // only the root rank places the cuts
     if (m_exec_conf->getRank() != reduce_root)
         return false;
 
-    // rearrange the data from ranks to cartesian order in case it is jumbled around
-    ArrayHandle<unsigned int> h_cart_ranks_inv(m_decomposition->getInverseCartRanks(), access_location::host, access_mode::read);
-    std::vector<unsigned int> N_per_cart_rank(di.getNumElements());
-    for (unsigned int cur_rank=0; cur_rank < di.getNumElements(); ++cur_rank)
-        {
-        N_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = N_per_rank[cur_rank];
-        }
+    // make the minimum domain slightly bigger, as in adjust()
+    min_domain_frac *= Scalar(1.00001);
+    const double total = std::accumulate(total_hist.begin(), total_hist.end(), 0.0);
+    if (total <= 0.0 || min_domain_frac * Scalar(n_domains) >= Scalar(1.0))
+        return false;
 
-    // perform the summation along dim in as cache friendly of a way as we can manage
-    if (dim == 0) // to x
-        {
-        N_i.clear(); N_i.resize(di.getW());
-        for (unsigned int i=0; i < di.getW(); ++i)
-            {
-            N_i[i] = 0;
-            for (unsigned int k=0; k < di.getD(); ++k)
-                {
-                for (unsigned int j=0; j < di.getH(); ++j)
-                    {
-                    N_i[i] += N_per_cart_rank[di(i,j,k)];
-                    }
-                }
-            }
-        }
-    else if (dim == 1) // to y
+    unsigned int bin = 0;
+    double cum = 0.0;
+    for (unsigned int j=1; j < n_domains; ++j)
         {
-        N_i.clear(); N_i.resize(di.getH());
-        for (unsigned int j=0; j < di.getH(); ++j)
+        const double target = total * double(j) / double(n_domains);
+        while (bin < n_bins && cum + total_hist[bin] < target)
             {
-            N_i[j] = 0;
-            for (unsigned int k=0; k < di.getD(); ++k)
-                {
-                for (unsigned int i=0; i < di.getW(); ++i)
-                    {
-                    N_i[j] += N_per_cart_rank[di(i,j,k)];
-                    }
-                }
-            }
-        }
-    else if (dim == 2) // to z
-        {
-        N_i.clear(); N_i.resize(di.getD());
-        for (unsigned int k=0; k < di.getD(); ++k)
-            {
-            N_i[k] = 0;
-            for (unsigned int j=0; j < di.getH(); ++j)
-                {
-                for (unsigned int i=0; i < di.getW(); ++i)
-                    {
-                    N_i[k] += N_per_cart_rank[di(i,j,k)];
-                    }
-                }
+            cum += total_hist[bin];
+            ++bin;
             }
+
+        double f = 0.0;
+        if (bin < n_bins && total_hist[bin] > 0.0)
+            f = (target - cum) / total_hist[bin];
+        cum_frac_i[j] = Scalar((double(bin) + f) / double(n_bins));
         }
-    else
+
+    // enforce the minimum domain size, first from below and then from above
+    for (unsigned int j=1; j < n_domains; ++j)
+        cum_frac_i[j] = std::max(cum_frac_i[j], cum_frac_i[j-1] + min_domain_frac);
+    for (unsigned int j=n_domains-1; j > 0; --j)
+        cum_frac_i[j] = std::min(cum_frac_i[j], cum_frac_i[j+1] - min_domain_frac);
+
+    return true;
+    }
+
+namespace
+{
+//! Sums packed loads elementwise, except for the last entry which holds their maximum
+/*!
+ * The operation acts on whole elements of a contiguous datatype, which MPI never splits between calls, so that the last
+ * entry of each element can be identified from the size of the datatype.
+ */
+void sum_loads_max_last(void *invec, void *inoutvec, int *len, MPI_Datatype *datatype)
+    {
+    int type_size;
+    MPI_Type_size(*datatype, &type_size);
+    const int n = type_size / int(sizeof(Scalar));
+
+    const Scalar *in = (const Scalar *)invec;
+    Scalar *inout = (Scalar *)inoutvec;
+    for (int e=0; e < *len; ++e)
         {
-        m_exec_conf->msg->error() << "comm.balance: unknown dimension for particle reduction" << endl;
-        throw runtime_error("Unknown dimension for particle reduction");
+        for (int k=0; k < n-1; ++k)
+            inout[k] += in[k];
+        inout[n-1] = std::max(inout[n-1], in[n-1]);
+
+        in += n;
+        inout += n;
         }
+    }
+} // end namespace
 
-    return true;
+/*!
+ * \param W_x Vector holding the total load in each slice along x (will be allocated on call)
+ * \param W_y Vector holding the total load in each slice along y (will be allocated on call)
+ * \param W_z Vector holding the total load in each slice along z (will be allocated on call)
+ * \returns The maximum imbalance factor I = W / <W> among all ranks
+ *
+ * Every rank adds its load to the slices it belongs to along each dimension and to the maximum load in one packed
+ * buffer, which is reduced by a single MPI_Allreduce. The slice loads and the imbalance are therefore known on all
+ * ranks after one collective call, instead of one gather per dimension and two reductions for the imbalance.
+ *
+ * \note reduceLoads() is a collective call, all ranks must participate.
+ */
+Scalar LoadBalancer::reduceLoads(std::vector<Scalar>& W_x, std::vector<Scalar>& W_y, std::vector<Scalar>& W_z)
+    {
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    const uint3 grid_pos = m_decomposition->getGridPos();
+    const unsigned int n = di.getW() + di.getH() + di.getD() + 1;
+
+    // get the load of the current rank (the quantity to be reduced)
+    const Scalar W_own = getLoad();
+
+    std::vector<Scalar> buf(n, Scalar(0.0));
+    buf[grid_pos.x] = W_own;
+    buf[di.getW() + grid_pos.y] = W_own;
+    buf[di.getW() + di.getH() + grid_pos.z] = W_own;
+    buf[n-1] = W_own;
+
+    MPI_Datatype load_type;
+    MPI_Type_contiguous(n, MPI_HOOMD_SCALAR, &load_type);
+    MPI_Type_commit(&load_type);
+    MPI_Op load_op;
+    MPI_Op_create(&sum_loads_max_last, 1, &load_op);
+
+    MPI_Allreduce(MPI_IN_PLACE, &buf[0], 1, load_type, load_op, m_mpi_comm);
+
+    MPI_Op_free(&load_op);
+    MPI_Type_free(&load_type);
+
+    std::vector<Scalar>::const_iterator it = buf.begin();
+    W_x.assign(it, it + di.getW());
+    it += di.getW();
+    W_y.assign(it, it + di.getH());
+    it += di.getH();
+    W_z.assign(it, it + di.getD());
+
+    const Scalar total_load = std::accumulate(W_x.begin(), W_x.end(), Scalar(0.0));
+    Scalar max_imb(1.0);
+    if (total_load > Scalar(0.0))
+        max_imb = buf[n-1] / (total_load / Scalar(m_exec_conf->getNRanks()));
+
+    m_max_imbalance = max_imb;
+    m_recompute_max_imbalance = false;
+
+    // save as a statistic if new max imbalance
+    if (m_max_imbalance > m_max_max_imbalance)
+        m_max_max_imbalance = m_max_imbalance;
+
+    return m_max_imbalance;
     }
 
 /*!
  * \param cum_frac_i The cumulative fraction array to write output into
- * \param N_i The reduced number of particles along the dimension
+ * \param W_i The reduced load along the dimension
  * \param L_i The global box length along the dimension
  * \param min_frac_i The minimum fractional width of a domain
  *
@@ -294,30 +470,30 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
  *     successful, apply the adjustment to \a cum_frac_i.
  */
 bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
-                          const vector<unsigned int>& N_i,
+                          const vector<Scalar>& W_i,
                           Scalar L_i,
                           Scalar min_frac_i)
     {
-    if (N_i.size() == 1)
+    if (W_i.size() == 1)
         return false;
 
-    // target particles per rank is uniform distribution
-    const Scalar target = Scalar(m_pdata->getNGlobal()) / Scalar(N_i.size());
+    // target load per slice is uniform distribution
+    const Scalar target = std::accumulate(W_i.begin(), W_i.end(), Scalar(0.0)) / Scalar(W_i.size());
 
     // make the minimum domain slightly bigger so that the optimization won't fail at equality
     const Scalar min_domain_size = Scalar(1.00001) * min_frac_i * L_i;
     // if system is overconstrained (exactly decomposed) don't do any adjusting
-    if (min_domain_size * Scalar(N_i.size()) >= L_i)
+    if (min_domain_size * Scalar(W_i.size()) >= L_i)
         {
         return false;
         }
 
     // imbalance factors for each rank
-    vector<Scalar> new_widths(N_i.size());
-    for (unsigned int i=0; i < N_i.size(); ++i)
+    vector<Scalar> new_widths(W_i.size());
+    for (unsigned int i=0; i < W_i.size(); ++i)
         {
-        const Scalar imb_factor = Scalar(N_i[i]) / target;
-        Scalar scale_factor = (N_i[i] > 0) ? Scalar(1.0) / imb_factor : (Scalar(1.0) + m_max_scale); // as in gromacs, use half the imbalance factor to scale
+        const Scalar imb_factor = W_i[i] / target;
+        Scalar scale_factor = (W_i[i] > Scalar(0.0)) ? Scalar(1.0) / imb_factor : (Scalar(1.0) + m_max_scale); // as in gromacs, use half the imbalance factor to scale
 
         // limit rescaling to 5% either direction
         // we should use absolute distance here, it is necessary to control balancing in corrugated systems
@@ -337,7 +513,7 @@ bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
     // setup the augmented A matrix, with scale factor eps for the actual least squares part (to enforce the inequality
     // constraints correctly)
     const Scalar eps(0.001);
-    unsigned int m = (unsigned int)N_i.size();
+    unsigned int m = (unsigned int)W_i.size();
     unsigned int n = m - 1;
     Eigen::MatrixXd A = Eigen::MatrixXd::Zero(2*m,n+m);
     A(0,0) = 1.0; A(m,0) = eps;
@@ -570,6 +746,8 @@ void export_LoadBalancer(py::module& m)
     .def_property("x", &LoadBalancer::getEnableX, &LoadBalancer::setEnableX)
     .def_property("y", &LoadBalancer::getEnableY, &LoadBalancer::setEnableY)
     .def_property("z", &LoadBalancer::getEnableZ, &LoadBalancer::setEnableZ)
+    .def_property("weight", &LoadBalancer::getWeight, &LoadBalancer::setWeight)
+    .def_property("fit", &LoadBalancer::getFit, &LoadBalancer::setFit)
     ;
     }
 #endif // ENABLE_MPI
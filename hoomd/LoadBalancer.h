@@ -18,6 +18,7 @@
 #define __LOADBALANCER_H__
 #include "Tuner.h"
 #include "Trigger.h"
+#include "ClockSource.h"
 
 #include <memory>
 #include <pybind11/pybind11.h>
@@ -28,8 +29,9 @@
 //! Updates domain decompositions to balance the load
 /*!
  * Adjusts the boundaries of the processor domains to distribute the load close to evenly between them. The load imbalance
- * is defined as the number of particles owned by a rank divided by the average number of particles per rank if the
- * particles had a uniform distribution.
+ * is defined as the load of a rank divided by the average load per rank. By default, the load is the number of particles
+ * owned by the rank. With time weighting, each particle on a rank is weighted by the measured compute time per particle
+ * on that rank, so that ranks with expensive particles (dense regions, rigid bodies) own fewer of them.
  *
  * At each load balancing step, we attempt to rescale the domain size by the inverse of the load balance, subject to the
  * following constraints that are imposed to both maintain a stable balancing and to keep communication isolated to the
@@ -41,6 +43,11 @@
  * Constraints are satisfied by solving a least-squares problem with box constraints, where the cost function is the
  * deviation of the domain sizes from the proposed rescaled width.
  *
+ * The incremental rescaling takes many updates to follow a strongly non-uniform distribution, such as a droplet or a
+ * slab. Optionally, the first update fits the domain boundaries to the distribution directly: along each dimension,
+ * the cut planes are placed at the quantiles of the load histogram (a coordinate bisection restricted to the grid),
+ * subject to the minimum domain size. The incremental rescaling then refines the fit.
+ *
  * \ingroup updaters
  */
 class PYBIND11_EXPORT LoadBalancer : public Tuner
@@ -120,6 +127,31 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
         /// Get value of m_enable_z
         bool getEnableZ(bool enable) {return m_enable_z;}
 
+        //! Get the load weighting ("particles" or "time")
+        std::string getWeight() const
+            {
+            return m_time_weighted ? "time" : "particles";
+            }
+
+        //! Set the load weighting
+        /*!
+         * \param weight "particles" to balance the number of particles, "time" to balance the measured compute time
+         */
+        void setWeight(const std::string& weight);
+
+        //! Get whether the first update fits the boundaries to the load distribution
+        bool getFit() const
+            {
+            return m_fit;
+            }
+
+        //! Set whether the next update fits the boundaries to the load distribution
+        void setFit(bool fit)
+            {
+            m_fit = fit;
+            m_fit_pending = fit;
+            }
+
         //! Take one timestep forward
         virtual void update(unsigned int timestep);
 
@@ -132,14 +164,11 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
 
         const MPI_Comm m_mpi_comm;  //!< MPI communicator for all ranks
 
-        //! Computes the maximum imbalance factor
-        Scalar getMaxImbalance();
+        //! Reduce the loads per rank to the slices along every dimension and compute the maximum imbalance factor
+        Scalar reduceLoads(std::vector<Scalar>& W_x, std::vector<Scalar>& W_y, std::vector<Scalar>& W_z);
         Scalar m_max_imbalance;             //!< Maximum imbalance
         bool m_recompute_max_imbalance;     //!< Flag if maximum imbalance needs to be computed
 
-        //! Reduce the particle numbers per rank down to one dimension
-        bool reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root);
-
         //! Set flags within the class that a resize has been performed
         void signalResize()
             {
@@ -150,7 +179,7 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
 
         //! Adjust the partitioning along a single dimension
         bool adjust(std::vector<Scalar>& cum_frac_i,
-                    const std::vector<unsigned int>& N_i,
+                    const std::vector<Scalar>& W_i,
                     Scalar L_i,
                     Scalar min_domain_frac);
         bool m_needs_migrate;   //!< Flag to signal that migration is necessary
@@ -158,6 +187,18 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
         //! Compute the number of particles on each rank after an adjustment
         void computeOwnedParticles();
 
+        //! Place the cut planes along a dimension at the quantiles of the load
+        bool fitQuantiles(std::vector<Scalar>& cum_frac_i,
+                          unsigned int dim,
+                          unsigned int reduce_root,
+                          Scalar min_domain_frac);
+
+        //! Migrate particles after the domains were resized
+        void migrate(unsigned int timestep);
+
+        bool m_fit;             //!< True to fit the boundaries to the load distribution
+        bool m_fit_pending;     //!< True when the next update should fit the boundaries
+
         //! Count the number of particles that have gone off the rank
         virtual void countParticlesOffRank(std::map<unsigned int, unsigned int>& cnts);
 
@@ -180,6 +221,26 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
             }
         bool m_needs_recount;   //!< Flag if a particle change needs to be computed
 
+        //! Gets the load of this rank
+        Scalar getLoad()
+            {
+            return Scalar(getNOwn()) * m_cost_per_particle;
+            }
+
+        //! Measure the compute time per particle since the last balancing step
+        void measureCost(unsigned int timestep);
+
+        //! Start the next compute time measurement
+        void startMeasurement(unsigned int timestep);
+
+        bool m_time_weighted;           //!< True to weight particles by the measured compute time
+        Scalar m_cost_per_particle;     //!< Relative cost of a particle on this rank
+        ClockSource m_clk;              //!< Clock to measure the compute time
+        int64_t m_last_time;            //!< Clock time at the start of the measurement
+        int64_t m_last_comm_time;       //!< Communication time at the start of the measurement
+        unsigned int m_last_timestep;   //!< Time step at the start of the measurement
+        bool m_has_measurement;         //!< True when a measurement has been started
+
         Scalar m_tolerance;     //!< Load imbalance to tolerate
         unsigned int m_maxiter; //!< Maximum number of iterations to attempt
         bool m_enable_x;        //!< Flag to enable balancing in x
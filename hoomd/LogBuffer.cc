@@ -0,0 +1,271 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file LogBuffer.cc
+    \brief Defines the LogBuffer class
+*/
+
+#include "LogBuffer.h"
+#include "Filesystem.h"
+
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace py = pybind11;
+using namespace std;
+
+/*! \param sysdef System definition
+    \param capacity Maximum number of buffered rows
+    \param fname File name to write the rows to, or an empty string to only buffer them
+    \param delimiter Delimiter to place between columns in the file
+    \param overwrite Overwrite an existing file if true, append otherwise
+*/
+LogBuffer::LogBuffer(std::shared_ptr<SystemDefinition> sysdef,
+                     unsigned int capacity,
+                     const std::string& fname,
+                     const std::string& delimiter,
+                     bool overwrite)
+    : Analyzer(sysdef), m_capacity(capacity), m_first(0), m_num_samples(0), m_filename(fname),
+      m_delimiter(delimiter), m_appending(!overwrite), m_header_written(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing LogBuffer: " << capacity << " " << fname << endl;
+
+    if (m_capacity == 0)
+        {
+        throw runtime_error("LogBuffer: the capacity must be positive");
+        }
+
+    resetBuffer();
+    }
+
+LogBuffer::~LogBuffer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying LogBuffer" << endl;
+
+    try
+        {
+        flush();
+        }
+    catch (const std::exception& e)
+        {
+        m_exec_conf->msg->error() << "LogBuffer: " << e.what() << endl;
+        }
+    }
+
+/*! \param provided Quantities provided by the source
+    \param quantity Requested quantity
+*/
+void LogBuffer::checkQuantity(const std::vector<std::string>& provided, const std::string& quantity)
+    {
+    if (std::find(provided.begin(), provided.end(), quantity) == provided.end())
+        {
+        ostringstream s;
+        s << "LogBuffer: " << quantity << " is not provided by this operation, the available quantities are:";
+        for (const auto& q : provided)
+            s << " " << q;
+        throw runtime_error(s.str());
+        }
+    }
+
+/*! \param name Column name
+    \param compute Compute that provides the quantity
+    \param quantity Name of the quantity in Compute::getLogValue()
+
+    Adding a quantity discards the buffered rows, so flush() or getSamples() them first.
+*/
+void LogBuffer::addQuantity(const std::string& name,
+                            std::shared_ptr<Compute> compute,
+                            const std::string& quantity)
+    {
+    checkQuantity(compute->getProvidedLogQuantities(), quantity);
+
+    Source source;
+    source.name = name;
+    source.compute = compute;
+    source.quantity = quantity;
+    m_sources.push_back(source);
+    resetBuffer();
+    }
+
+/*! \param name Column name
+    \param updater Updater that provides the quantity
+    \param quantity Name of the quantity in Updater::getLogValue()
+
+    Adding a quantity discards the buffered rows, so flush() or getSamples() them first.
+*/
+void LogBuffer::addQuantity(const std::string& name,
+                            std::shared_ptr<Updater> updater,
+                            const std::string& quantity)
+    {
+    checkQuantity(updater->getProvidedLogQuantities(), quantity);
+
+    Source source;
+    source.name = name;
+    source.updater = updater;
+    source.quantity = quantity;
+    m_sources.push_back(source);
+    resetBuffer();
+    }
+
+void LogBuffer::resetBuffer()
+    {
+    m_first = 0;
+    m_num_samples = 0;
+    m_timesteps.resize(m_capacity);
+    m_values.resize(size_t(m_capacity)*m_sources.size());
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    When the buffer is full, the rows are first written to the file. Without a file, the oldest row is replaced.
+*/
+void LogBuffer::analyze(unsigned int timestep)
+    {
+    if (m_prof) m_prof->push("LogBuffer");
+
+    if (m_num_samples == m_capacity)
+        {
+        if (!m_filename.empty())
+            {
+            flush();
+            }
+        else
+            {
+            // drop the oldest row
+            m_first = (m_first + 1) % m_capacity;
+            m_num_samples--;
+            }
+        }
+
+    unsigned int row = (m_first + m_num_samples) % m_capacity;
+    Scalar *values = m_values.data() + size_t(row)*m_sources.size();
+    for (unsigned int i = 0; i < m_sources.size(); i++)
+        {
+        const Source& source = m_sources[i];
+        if (source.compute)
+            {
+            source.compute->compute(timestep);
+            values[i] = source.compute->getLogValue(source.quantity, timestep);
+            }
+        else
+            {
+            values[i] = source.updater->getLogValue(source.quantity, timestep);
+            }
+        }
+    m_timesteps[row] = timestep;
+    m_num_samples++;
+
+    if (m_prof) m_prof->pop();
+    }
+
+void LogBuffer::openOutputFile()
+    {
+    if (filesystem::exists(m_filename) && m_appending)
+        {
+        m_exec_conf->msg->notice(3) << "LogBuffer: Appending log to existing file \"" << m_filename << "\"" << endl;
+        m_file.open(m_filename.c_str(), ios_base::in | ios_base::out | ios_base::ate);
+        m_header_written = true;
+        }
+    else
+        {
+        m_exec_conf->msg->notice(3) << "LogBuffer: Creating new log in file \"" << m_filename << "\"" << endl;
+        m_file.open(m_filename.c_str(), ios_base::out);
+        }
+
+    if (!m_file.good())
+        {
+        m_exec_conf->msg->error() << "LogBuffer: Error opening log file " << m_filename << endl;
+        throw runtime_error("Error initializing LogBuffer");
+        }
+    }
+
+/*! All buffered rows are formatted into one string and written to the file with a single call. Without a file,
+    flush() keeps the rows for getSamples().
+*/
+void LogBuffer::flush()
+    {
+    if (m_filename.empty())
+        return;
+
+    if (m_exec_conf->isRoot() && (m_num_samples > 0 || !m_header_written))
+        {
+        if (!m_file.is_open())
+            openOutputFile();
+
+        ostringstream s;
+        s << setprecision(10);
+        if (!m_header_written)
+            {
+            s << "timestep";
+            for (const auto& source : m_sources)
+                s << m_delimiter << source.name;
+            s << "\n";
+            m_header_written = true;
+            }
+
+        for (unsigned int n = 0; n < m_num_samples; n++)
+            {
+            unsigned int row = (m_first + n) % m_capacity;
+            const Scalar *values = m_values.data() + size_t(row)*m_sources.size();
+            s << m_timesteps[row];
+            for (unsigned int i = 0; i < m_sources.size(); i++)
+                s << m_delimiter << values[i];
+            s << "\n";
+            }
+
+        const string& out = s.str();
+        m_file.write(out.data(), out.size());
+        m_file.flush();
+
+        if (!m_file.good())
+            {
+            m_exec_conf->msg->error() << "LogBuffer: I/O error while writing log file" << endl;
+            throw runtime_error("Error writing log file");
+            }
+        }
+
+    m_first = 0;
+    m_num_samples = 0;
+    }
+
+/*! \returns A tuple of the time steps of the buffered rows and the row major values, oldest row first
+
+    The buffer is empty afterwards.
+*/
+pybind11::tuple LogBuffer::getSamples()
+    {
+    std::vector<unsigned int> timesteps(m_num_samples);
+    std::vector<Scalar> values(size_t(m_num_samples)*m_sources.size());
+    for (unsigned int n = 0; n < m_num_samples; n++)
+        {
+        unsigned int row = (m_first + n) % m_capacity;
+        timesteps[n] = m_timesteps[row];
+        std::copy(m_values.begin() + size_t(row)*m_sources.size(),
+                  m_values.begin() + size_t(row+1)*m_sources.size(),
+                  values.begin() + size_t(n)*m_sources.size());
+        }
+
+    m_first = 0;
+    m_num_samples = 0;
+    return pybind11::make_tuple(timesteps, values);
+    }
+
+void export_LogBuffer(py::module& m)
+    {
+    py::class_<LogBuffer, Analyzer, std::shared_ptr<LogBuffer> >(m, "LogBuffer")
+    .def(py::init< std::shared_ptr<SystemDefinition>, unsigned int, const std::string&, const std::string&, bool >())
+    .def("addQuantity", (void (LogBuffer::*)(const std::string&, std::shared_ptr<Compute>, const std::string&))
+        &LogBuffer::addQuantity)
+    .def("addQuantity", (void (LogBuffer::*)(const std::string&, std::shared_ptr<Updater>, const std::string&))
+        &LogBuffer::addQuantity)
+    .def("getNames", &LogBuffer::getNames)
+    .def("getCapacity", &LogBuffer::getCapacity)
+    .def("getNumSamples", &LogBuffer::getNumSamples)
+    .def("flush", &LogBuffer::flush)
+    .def("getSamples", &LogBuffer::getSamples)
+    ;
+    }
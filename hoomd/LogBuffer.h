@@ -0,0 +1,140 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file LogBuffer.h
+    \brief Declares the LogBuffer class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "Analyzer.h"
+#include "Compute.h"
+#include "Updater.h"
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <pybind11/pybind11.h>
+#include <memory>
+
+#ifndef __LOG_BUFFER_H__
+#define __LOG_BUFFER_H__
+
+//! Samples scalar log quantities into a preallocated buffer and writes them out in bulk
+/*! Logging through Python evaluates every loggable property through pybind11 and formats a line of text each time
+    the writer triggers. LogBuffer instead samples the getLogValue() quantities of registered computes and updaters
+    directly in analyze() and stores them in a buffer of a fixed number of rows, allocated once.
+
+    Each quantity is added with addQuantity() under a column name, together with the Compute or Updater that provides
+    it. The sources are resolved when they are added, so sampling does not look up quantities by name.
+
+    When a file name is given, the buffered rows are written to the file as delimited text in one call when the buffer
+    is full, at the end of every run (flush()), and when the LogBuffer is destroyed. Without a file, the buffer is a
+    ring that keeps the most recent rows, and getSamples() drains it so that Python can write the rows in bulk, for
+    example as GSD log chunks or HDF5 datasets.
+
+    In MPI simulations, all ranks sample the quantities (many of them reduce over ranks) and only the root rank
+    writes the file.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT LogBuffer : public Analyzer
+    {
+    public:
+        //! Constructs an empty buffer
+        LogBuffer(std::shared_ptr<SystemDefinition> sysdef,
+                  unsigned int capacity,
+                  const std::string& fname,
+                  const std::string& delimiter,
+                  bool overwrite);
+
+        //! Destructor
+        virtual ~LogBuffer();
+
+        //! Add a quantity provided by a compute
+        void addQuantity(const std::string& name, std::shared_ptr<Compute> compute, const std::string& quantity);
+
+        //! Add a quantity provided by an updater
+        void addQuantity(const std::string& name, std::shared_ptr<Updater> updater, const std::string& quantity);
+
+        //! Get the column names
+        std::vector<std::string> getNames() const
+            {
+            std::vector<std::string> names;
+            for (const auto& source : m_sources)
+                names.push_back(source.name);
+            return names;
+            }
+
+        //! Get the maximum number of buffered rows
+        unsigned int getCapacity() const
+            {
+            return m_capacity;
+            }
+
+        //! Get the number of buffered rows
+        unsigned int getNumSamples() const
+            {
+            return m_num_samples;
+            }
+
+        //! Sample all quantities into the buffer
+        virtual void analyze(unsigned int timestep);
+
+        //! Request the flags that pressures and kinetic energies need on the sampled steps
+        virtual PDataFlags getRequestedPDataFlags()
+            {
+            PDataFlags flags;
+            if (!m_sources.empty())
+                {
+                flags[pdata_flag::pressure_tensor] = 1;
+                flags[pdata_flag::rotational_kinetic_energy] = 1;
+                }
+            return flags;
+            }
+
+        //! Write the buffered rows to the file
+        virtual void flush();
+
+        //! Remove the buffered rows and return them to Python
+        pybind11::tuple getSamples();
+
+    private:
+        //! A logged quantity and its source
+        struct Source
+            {
+            std::string name;                   //!< Column name
+            std::shared_ptr<Compute> compute;   //!< Compute that provides the quantity, if any
+            std::shared_ptr<Updater> updater;   //!< Updater that provides the quantity, if any
+            std::string quantity;               //!< Name of the quantity in getLogValue()
+            };
+
+        std::vector<Source> m_sources;          //!< Logged quantities
+        unsigned int m_capacity;                //!< Maximum number of buffered rows
+        unsigned int m_first;                   //!< Row of the oldest sample
+        unsigned int m_num_samples;             //!< Number of buffered rows
+        std::vector<unsigned int> m_timesteps;  //!< Time step of each row
+        std::vector<Scalar> m_values;           //!< Row major values, m_sources.size() per row
+
+        std::string m_filename;                 //!< The output file name, empty when not writing a file
+        std::string m_delimiter;                //!< The delimiter to put between columns in the file
+        bool m_appending;                       //!< True when appending to an existing file
+        bool m_header_written;                  //!< True after the header has been written
+        std::ofstream m_file;                   //!< The file we write out to
+
+        //! Check that a source provides a quantity
+        void checkQuantity(const std::vector<std::string>& provided, const std::string& quantity);
+
+        //! Discard the buffered rows and size the buffer for the current quantities
+        void resetBuffer();
+
+        //! Open the output file on first use
+        void openOutputFile();
+    };
+
+//! Exports the LogBuffer class to python
+void export_LogBuffer(pybind11::module& m);
+
+#endif
@@ -8,6 +8,9 @@
 
 #include "LogHDF5.h"
 
+#include <pybind11/stl.h>
+#include <stdexcept>
+
 #ifdef ENABLE_MPI
 #include "Communicator.h"
 #endif
@@ -23,9 +26,10 @@ using namespace std;
 LogHDF5::LogHDF5(std::shared_ptr<SystemDefinition> sysdef,
                  pybind11::function python_analyze)
     : LogMatrix(sysdef),
-      m_python_analyze(python_analyze)
+      m_python_analyze(python_analyze), m_chunk_size(1), m_num_rows(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing LogHDF5: "  << endl;
+    resetChunk();
     }
 
 LogHDF5::~LogHDF5(void)
@@ -42,21 +46,104 @@ void LogHDF5::analyze(unsigned int timestep)
 
     if (m_prof) m_prof->push("LogHDF5");
 
-    //Prepare the non-matrix data
+    //Prepare the non-matrix data in the next row of the chunk
     auto numpy_array_buf = m_quantities_array.request();
-    assert( numpy_array_buf.shape[0] == m_logged_quantities.size());
+    assert( numpy_array_buf.size == m_chunk_size*m_logged_quantities.size());
     assert( numpy_array_buf.itemsize == sizeof(Scalar));
-    Scalar*const numpy_array_data = static_cast<Scalar*>(numpy_array_buf.ptr);
-    //Prepare non-matrix data in a single array.
+    Scalar*const numpy_array_data = static_cast<Scalar*>(numpy_array_buf.ptr) + m_num_rows*m_logged_quantities.size();
     for(unsigned int i=0; i < m_logged_quantities.size(); i++)
         {
         numpy_array_data[i] = this->getQuantity(m_logged_quantities[i],timestep,true);
         }
 
+    //Keep copies of the matrices, the computes may reuse their memory in the next time step
+    if (m_chunk_size > 1)
+        {
+        for(unsigned int i=0; i < m_cached_matrix_quantities.size(); i++)
+            {
+            const py::array& matrix = m_cached_matrix_quantities[i];
+            if (!matrix)
+                {
+                m_matrix_chunks[i].append(py::none());
+                continue;
+                }
+            std::vector<ssize_t> shape(matrix.shape(), matrix.shape() + matrix.ndim());
+            std::vector<ssize_t> strides(matrix.strides(), matrix.strides() + matrix.ndim());
+            m_matrix_chunks[i].append(py::array(matrix.dtype(), shape, strides, matrix.data()));
+            }
+        }
+
+    m_timesteps[m_num_rows] = timestep;
+    m_num_rows++;
+
+    //Call the python function once the chunk is complete
+    if (m_num_rows == m_chunk_size)
+        writeChunk(timestep);
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! \param timestep Time step of the last buffered row
+ */
+void LogHDF5::writeChunk(unsigned int timestep)
+    {
     //Call the python function, which manages the prepared data and writes it to disk.
     m_python_analyze(timestep);
 
-    if (m_prof) m_prof->pop();
+    m_num_rows = 0;
+    for(unsigned int i=0; i < m_matrix_chunks.size(); i++)
+        m_matrix_chunks[i] = py::list();
+    }
+
+/*! Writes the buffered rows of an incomplete chunk, the python function sees getNumRows() < getChunkSize().
+ */
+void LogHDF5::flush()
+    {
+    if (m_num_rows > 0)
+        writeChunk(m_timesteps[m_num_rows-1]);
+    }
+
+/*! \param chunk_size Number of rows buffered before each call of the python writer
+
+    Changing the chunk size drops the buffered rows, flush() them first.
+*/
+void LogHDF5::setChunkSize(unsigned int chunk_size)
+    {
+    if (chunk_size == 0)
+        {
+        throw runtime_error("LogHDF5: the chunk size must be positive");
+        }
+
+    m_chunk_size = chunk_size;
+    resetChunk();
+    }
+
+void LogHDF5::resetChunk()
+    {
+    m_num_rows = 0;
+    m_timesteps.resize(m_chunk_size);
+
+    m_holder_array.resize(m_chunk_size*m_logged_quantities.size());
+    //Create a new numpy array of the correct size, a single row keeps the one dimensional layout
+    if (m_chunk_size == 1)
+        m_quantities_array = py::array(m_logged_quantities.size(),m_holder_array.data());
+    else
+        m_quantities_array = py::array_t<Scalar>({ (ssize_t)m_chunk_size, (ssize_t)m_logged_quantities.size() },
+                                                 m_holder_array.data());
+
+    m_matrix_chunks.assign(m_logged_matrix_quantities.size(), py::list());
+    }
+
+/*! \param quantity Matrix quantity
+    eturns A list with a copy of the matrix of each buffered row, empty when the chunk size is 1
+*/
+py::list LogHDF5::getMatrixChunk(const std::string& quantity)
+    {
+    for(unsigned int i=0; i< m_logged_matrix_quantities.size(); i++)
+        if( m_logged_matrix_quantities[i] == quantity )
+            return m_matrix_chunks[i];
+    m_exec_conf->msg->error() << "Matrix quantity " << quantity << " unknow to analyzer Unable to return."<<endl;
+    return py::list();
     }
 
 /*! \param quantities A list of quantities to log
@@ -64,10 +151,15 @@ void LogHDF5::analyze(unsigned int timestep)
 void LogHDF5::setLoggedQuantities(const std::vector< std::string >& quantities)
     {
     Logger::setLoggedQuantities(quantities);
+    resetChunk();
+    }
 
-    m_holder_array.resize(quantities.size());
-    //Create a new numpy array of the correct size.
-    m_quantities_array = py::array(quantities.size(),m_holder_array.data());
+/*! \param quantities A list of matrix quantities to log
+*/
+void LogHDF5::setLoggedMatrixQuantities(const std::vector< std::string >& quantities)
+    {
+    LogMatrix::setLoggedMatrixQuantities(quantities);
+    resetChunk();
     }
 
 void export_LogHDF5(py::module& m)
@@ -75,5 +167,11 @@ void export_LogHDF5(py::module& m)
     py::class_<LogHDF5, LogMatrix, std::shared_ptr<LogHDF5> >(m,"LogHDF5")
         .def(py::init< std::shared_ptr<SystemDefinition>, pybind11::function >())
         .def("get_quantity_array",&LogHDF5::getQuantitiesArray,py::return_value_policy::copy)
+        .def("setChunkSize", &LogHDF5::setChunkSize)
+        .def("getChunkSize", &LogHDF5::getChunkSize)
+        .def("getNumRows", &LogHDF5::getNumRows)
+        .def("getTimesteps", &LogHDF5::getTimesteps)
+        .def("getMatrixChunk", &LogHDF5::getMatrixChunk)
+        .def("flush", &LogHDF5::flush)
         ;
     }
@@ -20,6 +20,13 @@
   Logger. This class offers access to single value variables and
   matrix quantities.
 
+  LogHDF5 buffers chunk_size rows (see setChunkSize()) before it calls the python writer, so that the writer can append
+  a whole chunk to chunked and compressed datasets at once. With the default chunk size of 1, the quantity array holds
+  the values of the current time step and the writer is called in every analyze(). With a larger chunk size, the
+  quantity array has one row per buffered time step, getNumRows() rows of which are valid, getTimesteps() lists their
+  time steps, and getMatrixChunk() returns the buffered matrices. flush() writes an incomplete chunk at the end of a
+  run.
+
     \ingroup analyzers
 */
 class LogHDF5 : public LogMatrix
@@ -38,6 +45,36 @@ class LogHDF5 : public LogMatrix
         //! Write out the data for the current timestep
         void analyze(unsigned int timestep);
 
+        //! Selects which matrix quantities to log
+        virtual void setLoggedMatrixQuantities(const std::vector< std::string >& quantities);
+
+        //! Set the number of rows buffered before each call of the python writer
+        void setChunkSize(unsigned int chunk_size);
+
+        //! Get the number of rows buffered before each call of the python writer
+        unsigned int getChunkSize() const
+            {
+            return m_chunk_size;
+            }
+
+        //! Get the number of buffered rows
+        unsigned int getNumRows() const
+            {
+            return m_num_rows;
+            }
+
+        //! Get the time steps of the buffered rows
+        std::vector<unsigned int> getTimesteps() const
+            {
+            return std::vector<unsigned int>(m_timesteps.begin(), m_timesteps.begin() + m_num_rows);
+            }
+
+        //! Get the buffered matrices of a matrix quantity
+        pybind11::list getMatrixChunk(const std::string& quantity);
+
+        //! Write the buffered rows
+        virtual void flush();
+
         //! Get numpy array containing all logged non-matrix quantities.
         pybind11::array getQuantitiesArray(void){return m_quantities_array;}
 
@@ -48,6 +85,20 @@ class LogHDF5 : public LogMatrix
         pybind11::array m_quantities_array;
         //! memory space of the numpy array m_quantities_array
         std::vector<Scalar> m_holder_array;
+        //! Number of rows buffered before each call of the python writer
+        unsigned int m_chunk_size;
+        //! Number of buffered rows
+        unsigned int m_num_rows;
+        //! Time steps of the buffered rows
+        std::vector<unsigned int> m_timesteps;
+        //! Copies of the buffered matrices, one list per matrix quantity
+        std::vector<pybind11::list> m_matrix_chunks;
+
+        //! Size the quantity array and drop the buffered rows
+        void resetChunk();
+
+        //! Call the python writer and drop the buffered rows
+        void writeChunk(unsigned int timestep);
     };
 
 //! exports the LogHDF5 class to python
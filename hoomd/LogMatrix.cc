@@ -135,6 +135,8 @@ void LogMatrix::setLoggedMatrixQuantities(const std::vector< std::string >& quan
 */
 void LogMatrix::analyze(unsigned int timestep)
     {
+    // the cached matrices are Python objects
+    py::gil_scoped_acquire acquire;
     Logger::analyze(timestep);
 
     //Cache all matrices
@@ -89,6 +89,7 @@ void export_MPIConfiguration(pybind11::module& m)
     mpiconfiguration.def(pybind11::init< >())
         .def("splitPartitions", &MPIConfiguration::splitPartitions)
         .def("getPartition", &MPIConfiguration::getPartition)
+        .def("getNPartitions", &MPIConfiguration::getNPartitions)
         .def("getNRanks", &MPIConfiguration::getNRanks)
         .def("getRank", &MPIConfiguration::getRank)
         .def("barrier", &MPIConfiguration::barrier)
@@ -0,0 +1,196 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ManagedArena.h
+    \brief Declares a packed arena of managed memory for small ManagedArray allocations
+*/
+
+#ifndef __MANAGED_ARENA_H__
+#define __MANAGED_ARENA_H__
+
+#ifdef ENABLE_HIP
+#include <hip/hip_runtime.h>
+
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//! Packs the small managed memory allocations of ManagedArray into large slabs
+/*! Shape parameters hold many small ManagedArrays per type (vertices, hull indices, the nodes of the GPUTree of each
+    union). Allocated one by one with hipMallocManaged, every array occupies its own pages: the first kernel that reads
+    the parameters faults on each of them, and the scattered pages put pressure on the TLB.
+
+    ManagedArena carves these arrays out of contiguous slabs of slab_bytes. Blocks are rounded up to granularity bytes,
+    which also satisfies the alignment requests of ManagedArray. Freed blocks are kept for reuse by later allocations of
+    a similar size; the slabs themselves are never released. Allocations larger than a quarter of a slab, or with a
+    larger alignment than granularity, get their own hipMallocManaged allocation.
+
+    prefetch() marks all slabs read mostly and prefetches them to the given GPUs, so that a parameter update is followed
+    by one prefetch per slab instead of one page fault per array.
+
+    The arena is a process wide singleton, like the managed memory it hands out. It is never destroyed, so that arrays
+    in static objects can be freed after the end of main().
+*/
+class __attribute__((visibility("default"))) ManagedArena
+    {
+    public:
+        static const size_t slab_bytes = 2*1024*1024;   //!< Size of a slab
+        static const size_t granularity = 256;           //!< Block size granularity and alignment
+
+        //! Get the arena
+        static ManagedArena& get()
+            {
+            static ManagedArena *arena = new ManagedArena();
+            return *arena;
+            }
+
+        ManagedArena(const ManagedArena&) = delete;
+        ManagedArena& operator=(const ManagedArena&) = delete;
+
+        //! Allocate a block
+        /*! \param num_bytes Requested size in bytes
+            \param align Requested alignment in bytes, 0 for none
+            \returns Pointer to the managed memory block
+        */
+        void *allocate(size_t num_bytes, size_t align)
+            {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            size_t block_bytes = (num_bytes + granularity - 1) / granularity * granularity;
+            if (block_bytes == 0)
+                block_bytes = granularity;
+
+            if (block_bytes > slab_bytes/4 || align > granularity)
+                {
+                void *ptr = mallocManaged(block_bytes);
+                m_direct[ptr] = block_bytes;
+                return ptr;
+                }
+
+            // reuse a freed block of a similar size
+            size_t max_bytes = block_bytes + block_bytes/4;
+            auto free_block = m_free_blocks.lower_bound(block_bytes);
+            if (free_block != m_free_blocks.end() && free_block->first <= max_bytes)
+                {
+                void *ptr = free_block->second;
+                m_blocks[ptr] = free_block->first;
+                m_free_blocks.erase(free_block);
+                return ptr;
+                }
+
+            // carve the block out of the last slab, or start a new one
+            if (m_slabs.empty() || m_slab_offset + block_bytes > slab_bytes)
+                {
+                m_slabs.push_back((char *)mallocManaged(slab_bytes));
+                m_slab_offset = 0;
+                }
+
+            void *ptr = m_slabs.back() + m_slab_offset;
+            m_slab_offset += block_bytes;
+            m_blocks[ptr] = block_bytes;
+            return ptr;
+            }
+
+        //! Return a block to the arena
+        /*! \param ptr Pointer returned by allocate()
+            \pre The device has been synchronized since the last kernel that accessed the block
+        */
+        void deallocate(void *ptr)
+            {
+            if (ptr == nullptr)
+                return;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            auto block = m_blocks.find(ptr);
+            if (block != m_blocks.end())
+                {
+                m_free_blocks.insert(std::make_pair(block->second, ptr));
+                m_blocks.erase(block);
+                return;
+                }
+
+            auto direct = m_direct.find(ptr);
+            if (direct == m_direct.end())
+                throw std::runtime_error("ManagedArena: Freeing a block that was not allocated by the arena");
+
+            #ifdef __HIP_PLATFORM_HCC__
+            // HIP doesn't yet support hipFree on managed memory
+            hipError_t error = hipHostFree(ptr);
+            #else
+            hipError_t error = hipFree(ptr);
+            #endif
+            if (error != hipSuccess)
+                {
+                std::cerr << hipGetErrorString(error) << std::endl;
+                throw std::runtime_error("ManagedArena: Error freeing managed memory");
+                }
+            m_direct.erase(direct);
+            }
+
+        //! Mark all allocations read mostly and prefetch them to the given GPUs
+        /*! \param gpu_ids Devices that read the data
+        */
+        void prefetch(const std::vector<unsigned int>& gpu_ids)
+            {
+            #ifdef __HIP_PLATFORM_NVCC__
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            for (unsigned int i = 0; i < m_slabs.size(); ++i)
+                {
+                // only the used part of the last slab
+                size_t bytes = (i + 1 == m_slabs.size()) ? m_slab_offset : slab_bytes;
+                prefetchRange(m_slabs[i], bytes, gpu_ids);
+                }
+
+            for (auto const& direct : m_direct)
+                prefetchRange(direct.first, direct.second, gpu_ids);
+            #endif
+            }
+
+    private:
+        //! Constructor
+        ManagedArena()
+            : m_slab_offset(0)
+            { }
+
+        std::vector<char *> m_slabs;                    //!< Slabs that blocks are carved from
+        size_t m_slab_offset;                           //!< Bytes in use at the start of the last slab
+        std::map<void *, size_t> m_blocks;              //!< Size of the blocks handed out from the slabs
+        std::multimap<size_t, void *> m_free_blocks;    //!< Returned blocks by size
+        std::map<void *, size_t> m_direct;              //!< Size of the blocks with their own allocation
+        std::mutex m_mutex;                             //!< Protects the arena from concurrent allocations
+
+        //! Allocate managed memory
+        static void *mallocManaged(size_t bytes)
+            {
+            void *ptr = nullptr;
+            hipError_t error = hipMallocManaged(&ptr, bytes, hipMemAttachGlobal);
+            if (error != hipSuccess)
+                {
+                throw std::runtime_error("ManagedArena: Error allocating managed memory: "
+                    + std::string(hipGetErrorString(error)));
+                }
+            return ptr;
+            }
+
+        #ifdef __HIP_PLATFORM_NVCC__
+        //! Advise and prefetch one range
+        static void prefetchRange(void *ptr, size_t bytes, const std::vector<unsigned int>& gpu_ids)
+            {
+            if (bytes == 0)
+                return;
+
+            cudaMemAdvise(ptr, bytes, cudaMemAdviseSetReadMostly, 0);
+            for (auto gpu : gpu_ids)
+                cudaMemPrefetchAsync(ptr, bytes, gpu);
+            }
+        #endif
+    };
+
+#endif // ENABLE_HIP
+#endif // __MANAGED_ARENA_H__
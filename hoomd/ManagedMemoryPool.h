@@ -0,0 +1,172 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ManagedMemoryPool.h
+    \brief Declares a pool of managed memory blocks for GlobalArray allocations
+*/
+
+#ifndef __MANAGED_MEMORY_POOL_H__
+#define __MANAGED_MEMORY_POOL_H__
+
+#ifdef ENABLE_HIP
+#include <hip/hip_runtime.h>
+
+#include <map>
+#include <cassert>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+//! Caches freed managed memory blocks for reuse by later GlobalArray allocations
+/*! GlobalArray and GlobalVector allocate managed memory with hipMallocManaged and free it with hipFree. Both calls
+    synchronize the device and are slow, and arrays are reallocated often: the neighbor list grows after an overflow,
+    the communication buffers grow with the number of migrating particles, and groups are rebuilt. Freed blocks are
+    kept in the pool and handed out again to allocations of a similar size, so that steady state resizes do not call
+    into the driver.
+
+    A cached block is reused for a request of \a num_bytes when it is at most (1+cache_reltol)*num_bytes large. When
+    the cached bytes exceed the maximum, the largest cached blocks are released. The number of bytes in use and in the
+    cache and the number of cache hits and misses are reported by getStatistics().
+
+    Blocks are returned to the pool only after the device has been synchronized (see hoomd::detail::managed_deleter),
+    so a block that is handed out again is never still in use by a kernel.
+*/
+class __attribute__((visibility("default"))) ManagedMemoryPool
+    {
+    public:
+        //! Statistics of the pool
+        struct Statistics
+            {
+            size_t bytes_in_use;    //!< Bytes of the blocks currently handed out
+            size_t bytes_cached;    //!< Bytes of the free blocks kept in the cache
+            size_t num_hits;        //!< Allocations served from the cache
+            size_t num_misses;      //!< Allocations that called hipMallocManaged
+            };
+
+        //! Constructor
+        /*! \param max_cached_bytes Maximum number of bytes kept in free blocks
+            \param cache_reltol Relative tolerance for cache hits
+        */
+        ManagedMemoryPool(size_t max_cached_bytes, float cache_reltol = 0.25f)
+            : m_max_cached_bytes(max_cached_bytes), m_cache_reltol(cache_reltol)
+            {
+            m_stats.bytes_in_use = 0;
+            m_stats.bytes_cached = 0;
+            m_stats.num_hits = 0;
+            m_stats.num_misses = 0;
+            }
+
+        ManagedMemoryPool(const ManagedMemoryPool&) = delete;
+        ManagedMemoryPool& operator=(const ManagedMemoryPool&) = delete;
+
+        //! Destructor
+        ~ManagedMemoryPool()
+            {
+            // every GlobalArray holds a reference to the execution configuration that owns the pool, so no block is
+            // outstanding here
+            releaseCache(0);
+            }
+
+        //! Set the maximum number of cached bytes
+        void setMaxCachedBytes(size_t max_cached_bytes)
+            {
+            m_max_cached_bytes = max_cached_bytes;
+            releaseCache(m_max_cached_bytes);
+            }
+
+        //! Allocate a block
+        /*! \param num_bytes Requested size in bytes
+            \param block_bytes (Return value) Actual size of the block, to be passed to deallocate()
+            \returns Pointer to the managed memory block
+        */
+        void *allocate(size_t num_bytes, size_t& block_bytes)
+            {
+            void *ptr = nullptr;
+            size_t max_bytes = num_bytes + (size_t)((float)num_bytes*m_cache_reltol);
+
+            free_blocks_type::iterator free_block = m_free_blocks.lower_bound(num_bytes);
+            if (free_block != m_free_blocks.end() && free_block->first <= max_bytes)
+                {
+                block_bytes = free_block->first;
+                ptr = free_block->second;
+                m_free_blocks.erase(free_block);
+                m_stats.bytes_cached -= block_bytes;
+                m_stats.num_hits++;
+                }
+            else
+                {
+                hipError_t error = hipMallocManaged(&ptr, num_bytes, hipMemAttachGlobal);
+                if (error == hipErrorOutOfMemory && m_free_blocks.size())
+                    {
+                    // release the cache and try again
+                    hipGetLastError();
+                    releaseCache(0);
+                    error = hipMallocManaged(&ptr, num_bytes, hipMemAttachGlobal);
+                    }
+                if (error != hipSuccess)
+                    {
+                    throw std::runtime_error("ManagedMemoryPool: Error allocating managed memory: "
+                        + std::string(hipGetErrorString(error)));
+                    }
+                block_bytes = num_bytes;
+                m_stats.num_misses++;
+                }
+
+            m_stats.bytes_in_use += block_bytes;
+            return ptr;
+            }
+
+        //! Return a block to the pool
+        /*! \param ptr Pointer returned by allocate()
+            \param block_bytes Size of the block returned by allocate()
+            \pre The device has been synchronized since the last kernel that accessed the block
+        */
+        void deallocate(void *ptr, size_t block_bytes)
+            {
+            if (ptr == nullptr)
+                return;
+
+            assert(m_stats.bytes_in_use >= block_bytes);
+            m_stats.bytes_in_use -= block_bytes;
+
+            m_free_blocks.insert(std::make_pair(block_bytes, ptr));
+            m_stats.bytes_cached += block_bytes;
+            releaseCache(m_max_cached_bytes);
+            }
+
+        //! Get the statistics of the pool
+        const Statistics& getStatistics() const
+            {
+            return m_stats;
+            }
+
+    private:
+        typedef std::multimap<size_t, void *> free_blocks_type;
+
+        size_t m_max_cached_bytes;      //!< Maximum number of cached bytes
+        float m_cache_reltol;           //!< Relative tolerance for cache hits
+        free_blocks_type m_free_blocks; //!< Free blocks by size
+        Statistics m_stats;             //!< Statistics of the pool
+
+        //! Release the largest cached blocks until no more than \a max_bytes remain
+        void releaseCache(size_t max_bytes)
+            {
+            while (m_stats.bytes_cached > max_bytes && m_free_blocks.size())
+                {
+                free_blocks_type::iterator largest = std::prev(m_free_blocks.end());
+
+                #ifdef __HIP_PLATFORM_HCC__
+                // HIP doesn't yet support hipFree on managed memory
+                hipHostFree(largest->second);
+                #else
+                hipFree(largest->second);
+                #endif
+
+                m_stats.bytes_cached -= largest->first;
+                m_free_blocks.erase(largest);
+                }
+            }
+    };
+
+#endif // ENABLE_HIP
+#endif // __MANAGED_MEMORY_POOL_H__
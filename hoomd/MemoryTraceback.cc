@@ -89,6 +89,24 @@ void MemoryTraceback::outputTraces(std::shared_ptr<Messenger> msg) const
 
     msg->notice(2) << "Total amount of managed memory allocated through Global[Array,Vector]: " << pretty_bytes(nbytes_tot) << std::endl;
     msg->notice(2) << "Actual allocation sizes may be larger by up to the OS page size due to alignment." << std::endl;
+
+    // sum the allocations by tag, tags name the arrays of each class (see TAG_ALLOCATION)
+    std::map<std::string, std::pair<size_t, unsigned int> > tag_totals;
+    for (auto it_trace = m_traces.begin(); it_trace != m_traces.end(); ++it_trace)
+        {
+        const std::string& tag = m_tags[it_trace->first];
+        std::pair<size_t, unsigned int>& total = tag_totals[tag.empty() ? std::string("(untagged)") : tag];
+        total.first += it_trace->first.second;
+        total.second++;
+        }
+
+    msg->notice(2) << "Memory allocated by tag" << std::endl;
+    for (auto it_tag = tag_totals.begin(); it_tag != tag_totals.end(); ++it_tag)
+        {
+        msg->notice(2) << "** " << it_tag->first << ": " << pretty_bytes(it_tag->second.first) << " in "
+                       << it_tag->second.second << " allocation(s)" << std::endl;
+        }
+
     msg->notice(2) << "List of memory allocations and last " << MAX_TRACEBACK-1 << " functions called at time of (re-)allocation" << std::endl;
 
     for (auto it_trace = m_traces.begin(); it_trace != m_traces.end(); ++it_trace)
@@ -32,7 +32,7 @@ class PYBIND11_EXPORT MemoryTraceback
          */
         void unregisterAllocation(const void *ptr, size_t nbytes ) const;
 
-        //! Output the list of pointers along with their stack traces
+        //! Output the total memory by tag and the list of pointers along with their stack traces
         void outputTraces(std::shared_ptr<Messenger> msg) const;
 
         //! Update the name of an allocation
@@ -359,6 +359,9 @@ void Messenger::reopenPythonIfNeeded()
     // and python is initialized
     if (m_python_open && Py_IsInitialized())
         {
+        // messages may come from a run that released the GIL
+        pybind11::gil_scoped_acquire acquire;
+
         // flush and reopen the streams if sys.stdout or sys.stderr change
         pybind11::object new_pystdout = m_sys.attr("stdout");
         pybind11::object new_pystderr = m_sys.attr("stderr");
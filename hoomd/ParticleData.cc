@@ -29,6 +29,13 @@
 #include <stdexcept>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <numeric>
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
 
 using namespace std;
 
@@ -83,6 +90,9 @@ ParticleData::ParticleData(unsigned int N, const BoxDim &global_box, unsigned in
     {
     m_exec_conf->msg->notice(5) << "Constructing ParticleData" << endl;
 
+    // computes produce the potential energy unless System is told otherwise
+    m_flags[pdata_flag::potential_energy] = 1;
+
     // check the input for errors
     if (n_types == 0)
         {
@@ -161,6 +171,9 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
     {
     m_exec_conf->msg->notice(5) << "Constructing ParticleData" << endl;
 
+    // computes produce the potential energy unless System is told otherwise
+    m_flags[pdata_flag::potential_energy] = 1;
+
     #ifdef ENABLE_MPI
     // Set up domain decomposition information
     if (decomposition) setDomainDecomposition(decomposition);
@@ -254,10 +267,15 @@ const BoxDim & ParticleData::getGlobalBox() const
     }
 
 /*! \b ANY time particles are rearranged in memory, this function must be called.
+    \param how How the particles were rearranged
+    \param n_kept For particle_sort::append, the number of particles before the appended ones
     \note The call must be made after calling release()
 */
-void ParticleData::notifyParticleSort()
+void ParticleData::notifyParticleSort(particle_sort::Enum how, unsigned int n_kept)
     {
+    m_last_sort = how;
+    m_sort_n_kept = n_kept;
+
     #ifdef ENABLE_HIP
     if (m_exec_conf->isCUDAEnabled())
         {
@@ -445,8 +463,7 @@ void ParticleData::allocate(unsigned int N)
         }
     #endif
 
-    // allocate alternate particle data arrays (for swapping in-out)
-    allocateAlternateArrays(N);
+    // alternate particle data arrays (for swapping in-out) are allocated on first use, see requireAlternateArrays()
 
     // notify observers
     m_max_particle_num_signal.emit();
@@ -563,6 +580,75 @@ void ParticleData::allocateAlternateArrays(unsigned int N)
     }
 
 
+/*! \param first Index of the first particle to gather
+
+    The returned array has four rows of pitch getPitch(). Rows 0, 1 and 2 hold the x, y and z coordinates and row 3
+    holds the particle types as the bits of a Scalar (__int_as_scalar), for all local and ghost particles.
+
+    The array is a copy of the positions, gathered on the host when this method is called. Callers must request it
+    after the positions (and ghost positions) they need are up to date and must not write to it. Loops that stream
+    over the coordinates on the CPU read contiguous rows instead of skipping over the packed type in each Scalar4.
+    The array is allocated on first use, so simulations that do not request it pay no memory cost.
+
+    Only the particles from \a first on are gathered, the others keep the values of the previous call. Computations
+    that are split around the ghost update pass getN() in the second part, as only the ghost positions have changed
+    since the first part. The gather is divided among the TBB threads.
+*/
+const GlobalArray< Scalar >& ParticleData::getPositionsSoA(unsigned int first)
+    {
+    const unsigned int n = getN() + getNGhosts();
+
+    if (m_pos_soa.isNull())
+        {
+        GlobalArray< Scalar > pos_soa(m_max_nparticles, 4, m_exec_conf);
+        m_pos_soa.swap(pos_soa);
+        TAG_ALLOCATION(m_pos_soa);
+        first = 0;
+        }
+    else if (m_pos_soa.getPitch() < n)
+        {
+        m_pos_soa.resize(m_max_nparticles, 4);
+        first = 0;
+        }
+
+    ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::read);
+    ArrayHandle< Scalar > h_pos_soa(m_pos_soa, access_location::host, access_mode::overwrite);
+    const size_t pitch = m_pos_soa.getPitch();
+    Scalar *h_x = h_pos_soa.data;
+    Scalar *h_y = h_pos_soa.data + pitch;
+    Scalar *h_z = h_pos_soa.data + 2*pitch;
+    Scalar *h_type = h_pos_soa.data + 3*pitch;
+
+    auto gather = [&](unsigned int begin, unsigned int end)
+        {
+        for (unsigned int i = begin; i < end; i++)
+            {
+            const Scalar4 postype = h_pos.data[i];
+            h_x[i] = postype.x;
+            h_y[i] = postype.y;
+            h_z[i] = postype.z;
+            h_type[i] = postype.w;
+            }
+        };
+
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(first, std::max(first, n), 4096),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            gather(r.begin(), r.end());
+            });
+        }
+    else
+    #endif
+        {
+        gather(first, n);
+        }
+
+    return m_pos_soa;
+    }
+
 //! Set global number of particles
 /*! \param nglobal Global number of particles
  */
@@ -573,6 +659,9 @@ void ParticleData::setNGlobal(unsigned int nglobal)
     // Set global particle number
     m_nglobal = nglobal;
 
+    // Autotuners look up their parameters for this system size
+    m_exec_conf->getAutotunerDatabase()->setProblemSize(nglobal);
+
     // we have changed the global particle number, notify subscribers
     m_global_particle_num_signal.emit();
 
@@ -902,11 +991,8 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
                 throw std::runtime_error("Error initializing ParticleData");
                 }
 
-            const Index3D& di = m_decomposition->getDomainIndexer();
             unsigned int n_ranks = m_exec_conf->getNRanks();
 
-            BoxDim global_box = m_global_box;
-
             // loop over particles in snapshot, place them into domains
             for (typename std::vector< vec3<Real> >::const_iterator it=snapshot.pos.begin(); it != snapshot.pos.end(); it++)
                 {
@@ -921,41 +1007,8 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
                 // determine domain the particle is placed into
                 Scalar3 pos = vec_to_scalar3(*it);
                 Scalar3 f = m_global_box.makeFraction(pos);
-                int i= int(f.x * ((Scalar)di.getW()));
-                int j= int(f.y * ((Scalar)di.getH()));
-                int k= int(f.z * ((Scalar)di.getD()));
-
-                // wrap particles that are exactly on a boundary
-                // we only need to wrap in the negative direction, since
-                // processor ids are rounded toward zero
-                char3 flags = make_char3(0,0,0);
-                if (i == (int) di.getW())
-                    {
-                    i = 0;
-                    flags.x = 1;
-                    }
-
-                if (j == (int) di.getH())
-                    {
-                    j = 0;
-                    flags.y = 1;
-                    }
-
-                if (k == (int) di.getD())
-                    {
-                    k = 0;
-                    flags.z = 1;
-                    }
-
                 int3 img = snapshot.image[snap_idx];
-
-                // only wrap if the particles is on one of the boundaries
-                uchar3 periodic = make_uchar3(flags.x,flags.y,flags.z);
-                global_box.setPeriodic(periodic);
-                global_box.wrap(pos, img, flags);
-
-                // place particle using actual domain fractions, not global box fraction
-                unsigned int rank = m_decomposition->placeParticle(m_global_box, pos, h_cart_ranks.data);
+                unsigned int rank = placeSnapshotParticle(pos, img, h_cart_ranks.data);
 
                 if (rank >= n_ranks)
                     {
@@ -1190,6 +1243,314 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
     m_num_types_signal.emit();
     }
 
+#ifdef ENABLE_MPI
+/*! \param pos Position of the particle, wrapped on output if it is exactly on a boundary
+    \param img Image of the particle, updated on output
+    \param cart_ranks Map from cartesian domain index to rank
+
+    \returns The rank of the domain that \a pos is in
+
+    Every rank places particles in the same way, so initializeFromSnapshot() and readers that load each rank's
+    particles independently agree on which rank owns a particle.
+*/
+unsigned int ParticleData::placeSnapshotParticle(Scalar3& pos, int3& img, const unsigned int *cart_ranks)
+    {
+    const Index3D& di = m_decomposition->getDomainIndexer();
+
+    Scalar3 f = m_global_box.makeFraction(pos);
+    int i= int(f.x * ((Scalar)di.getW()));
+    int j= int(f.y * ((Scalar)di.getH()));
+    int k= int(f.z * ((Scalar)di.getD()));
+
+    // wrap particles that are exactly on a boundary
+    // we only need to wrap in the negative direction, since
+    // processor ids are rounded toward zero
+    char3 flags = make_char3(0,0,0);
+    if (i == (int) di.getW())
+        flags.x = 1;
+
+    if (j == (int) di.getH())
+        flags.y = 1;
+
+    if (k == (int) di.getD())
+        flags.z = 1;
+
+    // only wrap if the particles is on one of the boundaries
+    BoxDim global_box = m_global_box;
+    uchar3 periodic = make_uchar3(flags.x,flags.y,flags.z);
+    global_box.setPeriodic(periodic);
+    global_box.wrap(pos, img, flags);
+
+    // place particle using actual domain fractions, not global box fraction
+    return m_decomposition->placeParticle(m_global_box, pos, cart_ranks);
+    }
+
+#endif
+
+//! Initialize the local particles from a snapshot of this rank's particles
+/*! \param snapshot The particles owned by this rank and their global tags
+
+    This method is collective. Each rank passes only its own particles and the union over all ranks must hold the tags
+    0 to snapshot.nglobal - 1 exactly once. Unlike initializeFromSnapshot(), no particle data passes through the root
+    rank. In parallel simulations, every particle must be in the local domain of the rank that passes it, as
+    placeSnapshotParticle() places it. snapshot.offset is ignored.
+ */
+template <class Real>
+void ParticleData::initializeFromDistributedSnapshot(const DistributedSnapshotParticleData<Real>& snapshot)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: initializing from distributed snapshot" << std::endl;
+
+    // remove all ghost particles
+    removeAllGhostParticles();
+
+    if (! snapshot.validate())
+        {
+        m_exec_conf->msg->error() << "init.*: invalid particle data snapshot."
+                                << std::endl << std::endl;
+        throw std::runtime_error("Error initializing particle data.");
+        }
+
+    // check the input for errors
+    if (snapshot.type_mapping.size() == 0)
+        {
+        m_exec_conf->msg->error() << "Number of particle types must be greater than 0." << endl;
+        throw std::runtime_error("Error initializing ParticleData");
+        }
+
+    unsigned int n_local = snapshot.size;
+    unsigned int nglobal = snapshot.nglobal;
+    unsigned int n_sum = n_local;
+    int misplaced = 0;
+    for (unsigned int idx = 0; idx < n_local; idx++)
+        {
+        if (snapshot.tag[idx] >= nglobal)
+            misplaced = 1;
+        }
+
+#ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(), access_location::host,
+                                               access_mode::read);
+        unsigned int my_rank = m_exec_conf->getRank();
+        for (unsigned int idx = 0; idx < n_local; idx++)
+            {
+            Scalar3 pos = vec_to_scalar3(snapshot.pos[idx]);
+            int3 img = snapshot.image[idx];
+            if (placeSnapshotParticle(pos, img, h_cart_ranks.data) != my_rank)
+                misplaced = 1;
+            }
+
+        const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        MPI_Allreduce(MPI_IN_PLACE, &n_sum, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+        MPI_Allreduce(MPI_IN_PLACE, &misplaced, 1, MPI_INT, MPI_LOR, mpi_comm);
+        }
+#endif
+
+    if (n_sum != nglobal || misplaced)
+        {
+        m_exec_conf->msg->error() << "init.*: the distributed snapshot must hold the tags 0 to N_global - 1 once, "
+                                  << "each on the rank whose domain contains the particle." << endl;
+        throw std::runtime_error("Error initializing ParticleData");
+        }
+
+    // clear set of active tags
+    m_tag_set.clear();
+
+    // clear reservoir of recycled tags
+    while (! m_recycled_tags.empty())
+        m_recycled_tags.pop();
+
+    m_type_mapping = snapshot.type_mapping;
+
+    // resize array for reverse-lookup tags
+    m_rtag.resize(nglobal);
+
+        {
+        // reset all reverse lookup tags to NOT_LOCAL flag
+        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::overwrite);
+
+        for (unsigned int tag = 0; tag < nglobal; tag++)
+            h_rtag.data[tag] = NOT_LOCAL;
+        }
+
+    // update list of active tags
+    for (unsigned int tag = 0; tag < nglobal; tag++)
+        {
+        m_tag_set.insert(tag);
+        }
+
+    // Now that active tag list has changed, invalidate the cache
+    m_invalid_cached_tags = true;
+
+    // resize particle data
+    m_nparticles = n_local;
+    resize(m_nparticles);
+
+        {
+        ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_vel(m_vel, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar3 > h_accel(m_accel, access_location::host, access_mode::overwrite);
+        ArrayHandle< int3 > h_image(m_image, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar > h_charge(m_charge, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar > h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_body(m_body, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_orientation(m_orientation, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_angmom(m_angmom, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar3 > h_inertia(m_inertia, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_comm_flag(m_comm_flags, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+
+        for (unsigned int idx = 0; idx < m_nparticles; idx++)
+            {
+            h_pos.data[idx] = make_scalar4(snapshot.pos[idx].x,
+                                           snapshot.pos[idx].y,
+                                           snapshot.pos[idx].z,
+                                           __int_as_scalar(snapshot.type[idx]));
+            h_vel.data[idx] = make_scalar4(snapshot.vel[idx].x,
+                                           snapshot.vel[idx].y,
+                                           snapshot.vel[idx].z,
+                                           snapshot.mass[idx]);
+            h_accel.data[idx] = vec_to_scalar3(snapshot.accel[idx]);
+            h_charge.data[idx] = snapshot.charge[idx];
+            h_diameter.data[idx] = snapshot.diameter[idx];
+            h_image.data[idx] = snapshot.image[idx];
+            h_tag.data[idx] = snapshot.tag[idx];
+            h_rtag.data[snapshot.tag[idx]] = idx;
+            h_body.data[idx] = snapshot.body[idx];
+            h_orientation.data[idx] = quat_to_scalar4(snapshot.orientation[idx]);
+            h_angmom.data[idx] = quat_to_scalar4(snapshot.angmom[idx]);
+            h_inertia.data[idx] = vec_to_scalar3(snapshot.inertia[idx]);
+
+            h_comm_flag.data[idx] = 0; // initialize with zero
+            }
+        }
+
+    // copy over accel_set flag from snapshot
+    m_accel_set = snapshot.is_accel_set;
+
+    // set global number of particles
+    setNGlobal(nglobal);
+
+    // notify listeners about resorting of local particles
+    notifyParticleSort();
+
+    // zero the origin
+    m_origin = make_scalar3(0,0,0);
+    m_o_image = make_int3(0,0,0);
+
+    // notify listeners that number of types has changed
+    m_num_types_signal.emit();
+    }
+
+//! Take a snapshot of the local particles
+/*! \param snapshot The snapshot to write to
+    \param positions_only Fill only the tags, positions and images
+
+    The snapshot is resized to the number of local particles, which it holds in increasing tag order. Positions and
+    images are relative to the origin and wrapped into the global box as in takeSnapshot(). In parallel simulations,
+    this method is collective only for the computation of snapshot.offset.
+
+    With \a positions_only, the other per-particle arrays of the snapshot are left empty, so the snapshot does not
+    validate(). Trajectory writers that stream only coordinates use it to avoid copying the remaining properties.
+*/
+template <class Real>
+void ParticleData::takeDistributedSnapshot(DistributedSnapshotParticleData<Real> &snapshot, bool positions_only)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: taking distributed snapshot" << std::endl;
+
+    ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::read);
+    ArrayHandle< int3 > h_image(m_image, access_location::host, access_mode::read);
+    ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::read);
+
+    // order the local particles by tag
+    std::vector<unsigned int> order(m_nparticles);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&h_tag](unsigned int a, unsigned int b) { return h_tag.data[a] < h_tag.data[b]; });
+
+    if (positions_only)
+        {
+        snapshot.resize(0);
+        snapshot.size = m_nparticles;
+        snapshot.tag.resize(m_nparticles);
+        snapshot.pos.resize(m_nparticles);
+        snapshot.image.resize(m_nparticles);
+        }
+    else
+        {
+        snapshot.resize(m_nparticles);
+        }
+
+    for (unsigned int snap_id = 0; snap_id < m_nparticles; snap_id++)
+        {
+        unsigned int idx = order[snap_id];
+
+        snapshot.tag[snap_id] = h_tag.data[idx];
+
+        // make sure the position stored in the snapshot is within the boundaries
+        Scalar3 pos = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - m_origin;
+        int3 img = h_image.data[idx];
+        img.x -= m_o_image.x;
+        img.y -= m_o_image.y;
+        img.z -= m_o_image.z;
+        m_global_box.wrap(pos, img);
+        snapshot.pos[snap_id] = vec3<Real>(pos);
+        snapshot.image[snap_id] = img;
+        }
+
+    // the remaining properties are only accessed when needed, so that device data is not copied for them
+    if (!positions_only)
+        {
+        ArrayHandle< Scalar4 > h_vel(m_vel, access_location::host, access_mode::read);
+        ArrayHandle< Scalar3 > h_accel(m_accel, access_location::host, access_mode::read);
+        ArrayHandle< Scalar > h_charge(m_charge, access_location::host, access_mode::read);
+        ArrayHandle< Scalar > h_diameter(m_diameter, access_location::host, access_mode::read);
+        ArrayHandle< unsigned int > h_body(m_body, access_location::host, access_mode::read);
+        ArrayHandle< Scalar4 >  h_orientation(m_orientation, access_location::host, access_mode::read);
+        ArrayHandle< Scalar4 >  h_angmom(m_angmom, access_location::host, access_mode::read);
+        ArrayHandle< Scalar3 >  h_inertia(m_inertia, access_location::host, access_mode::read);
+
+        for (unsigned int snap_id = 0; snap_id < m_nparticles; snap_id++)
+            {
+            unsigned int idx = order[snap_id];
+
+            snapshot.vel[snap_id] = vec3<Real>(make_scalar3(h_vel.data[idx].x, h_vel.data[idx].y, h_vel.data[idx].z));
+            snapshot.accel[snap_id] = vec3<Real>(h_accel.data[idx]);
+            snapshot.type[snap_id] = __scalar_as_int(h_pos.data[idx].w);
+            snapshot.mass[snap_id] = Real(h_vel.data[idx].w);
+            snapshot.charge[snap_id] = Real(h_charge.data[idx]);
+            snapshot.diameter[snap_id] = Real(h_diameter.data[idx]);
+            snapshot.body[snap_id] = h_body.data[idx];
+            snapshot.orientation[snap_id] = quat<Real>(h_orientation.data[idx]);
+            snapshot.angmom[snap_id] = quat<Real>(h_angmom.data[idx]);
+            snapshot.inertia[snap_id] = vec3<Real>(h_inertia.data[idx]);
+            }
+        }
+
+    snapshot.type_mapping = m_type_mapping;
+
+    // copy over acceleration set flag (this is a copy in case users take a snapshot before running)
+    snapshot.is_accel_set = m_accel_set;
+
+    snapshot.nglobal = getNGlobal();
+    snapshot.offset = 0;
+
+#ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        unsigned int n_local = m_nparticles;
+        unsigned int offset = 0;
+        MPI_Exscan(&n_local, &offset, 1, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+
+        // the result of MPI_Exscan is undefined on the first rank
+        if (m_exec_conf->getRank() != 0)
+            snapshot.offset = offset;
+        }
+#endif
+    }
+
 //! take a particle data snapshot
 /* \param snapshot The snapshot to write to
    \returns a map to lookup the snapshot index from a particle tag
@@ -1204,6 +1565,12 @@ std::map<unsigned int, unsigned int> ParticleData::takeSnapshot(SnapshotParticle
 
     m_exec_conf->msg->notice(4) << "ParticleData: taking snapshot" << std::endl;
 
+#ifdef ENABLE_HIP
+    // convert single precision snapshots before the copy to the host
+    if (m_exec_conf->isCUDAEnabled() && takeSnapshotOnDevice(snapshot, index))
+        return index;
+#endif
+
     ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::read);
     ArrayHandle< Scalar4 > h_vel(m_vel, access_location::host, access_mode::read);
     ArrayHandle< Scalar3 > h_accel(m_accel, access_location::host, access_mode::read);
@@ -1428,6 +1795,265 @@ std::map<unsigned int, unsigned int> ParticleData::takeSnapshot(SnapshotParticle
     return index;
     }
 
+#ifdef ENABLE_HIP
+/*! \param snapshot The snapshot to write to
+    \param index Output map to lookup the snapshot index from a particle tag
+    \returns true
+
+    The local particles are converted to single precision, wrapped into the global box, and packed into one buffer
+    on the device, so that the copy to the host moves half of the bytes of the double precision arrays and the host
+    only scatters the elements into the snapshot by tag. In parallel simulations, the packed elements are gathered
+    to the root rank.
+*/
+bool ParticleData::takeSnapshotOnDevice(SnapshotParticleData<float>& snapshot,
+                                        std::map<unsigned int, unsigned int>& index)
+    {
+    if (m_snapshot_buffer.isNull() || m_snapshot_buffer.getNumElements() < m_nparticles)
+        {
+        GPUArray<pdata_snapshot_element> snapshot_buffer(std::max(m_max_nparticles, 1u), m_exec_conf);
+        m_snapshot_buffer.swap(snapshot_buffer);
+        }
+
+        {
+        ArrayHandle< Scalar4 > d_pos(m_pos, access_location::device, access_mode::read);
+        ArrayHandle< Scalar4 > d_vel(m_vel, access_location::device, access_mode::read);
+        ArrayHandle< Scalar3 > d_accel(m_accel, access_location::device, access_mode::read);
+        ArrayHandle< Scalar > d_charge(m_charge, access_location::device, access_mode::read);
+        ArrayHandle< Scalar > d_diameter(m_diameter, access_location::device, access_mode::read);
+        ArrayHandle< int3 > d_image(m_image, access_location::device, access_mode::read);
+        ArrayHandle< unsigned int > d_body(m_body, access_location::device, access_mode::read);
+        ArrayHandle< Scalar4 > d_orientation(m_orientation, access_location::device, access_mode::read);
+        ArrayHandle< Scalar4 > d_angmom(m_angmom, access_location::device, access_mode::read);
+        ArrayHandle< Scalar3 > d_inertia(m_inertia, access_location::device, access_mode::read);
+        ArrayHandle< unsigned int > d_tag(m_tag, access_location::device, access_mode::read);
+        ArrayHandle< pdata_snapshot_element > d_out(m_snapshot_buffer, access_location::device, access_mode::overwrite);
+
+        gpu_pdata_pack_snapshot(m_nparticles,
+                                d_pos.data,
+                                d_vel.data,
+                                d_accel.data,
+                                d_charge.data,
+                                d_diameter.data,
+                                d_image.data,
+                                d_body.data,
+                                d_orientation.data,
+                                d_angmom.data,
+                                d_inertia.data,
+                                d_tag.data,
+                                m_global_box,
+                                m_origin,
+                                m_o_image,
+                                d_out.data);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+    ArrayHandle< pdata_snapshot_element > h_elements(m_snapshot_buffer, access_location::host, access_mode::read);
+    const pdata_snapshot_element *elements = h_elements.data;
+    unsigned int n_elements = m_nparticles;
+    bool root = true;
+
+#ifdef ENABLE_MPI
+    std::vector<pdata_snapshot_element> gathered;
+    if (m_decomposition)
+        {
+        const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        unsigned int n_ranks = m_exec_conf->getNRanks();
+        root = m_exec_conf->getRank() == 0;
+
+        // gather the packed elements to the root rank
+        int send_bytes = int(sizeof(pdata_snapshot_element)*m_nparticles);
+        std::vector<int> recv_bytes(n_ranks);
+        MPI_Gather(&send_bytes, 1, MPI_INT, recv_bytes.data(), 1, MPI_INT, 0, mpi_comm);
+
+        std::vector<int> displs(n_ranks, 0);
+        if (root)
+            {
+            for (unsigned int irank = 1; irank < n_ranks; ++irank)
+                displs[irank] = displs[irank-1] + recv_bytes[irank-1];
+            gathered.resize(getNGlobal());
+            }
+
+        MPI_Gatherv(h_elements.data, send_bytes, MPI_BYTE,
+                    gathered.data(), recv_bytes.data(), displs.data(), MPI_BYTE, 0, mpi_comm);
+
+        elements = gathered.data();
+        n_elements = getNGlobal();
+        }
+#endif
+
+    if (root)
+        {
+        // allocate memory in snapshot
+        snapshot.resize(getNGlobal());
+
+        // the snapshot holds the particles in increasing tag order
+        assert(m_tag_set.size() == getNGlobal());
+        unsigned int snap_id = 0;
+        for (auto tag : m_tag_set)
+            index.insert(std::make_pair(tag, snap_id++));
+
+        for (unsigned int i = 0; i < n_elements; i++)
+            {
+            const pdata_snapshot_element& el = elements[i];
+            auto it = index.find(el.tag);
+            if (it == index.end())
+                {
+                m_exec_conf->msg->error() << endl << "Particle " << el.tag << " is not in the tag set." << endl
+                    << endl;
+                throw std::runtime_error("Error gathering ParticleData");
+                }
+            snap_id = it->second;
+
+            snapshot.pos[snap_id] = vec3<float>(el.pos.x, el.pos.y, el.pos.z);
+            snapshot.vel[snap_id] = vec3<float>(el.vel.x, el.vel.y, el.vel.z);
+            snapshot.accel[snap_id] = vec3<float>(el.accel.x, el.accel.y, el.accel.z);
+            snapshot.type[snap_id] = el.type;
+            snapshot.mass[snap_id] = el.mass;
+            snapshot.charge[snap_id] = el.charge;
+            snapshot.diameter[snap_id] = el.diameter;
+            snapshot.image[snap_id] = el.image;
+            snapshot.body[snap_id] = el.body;
+            snapshot.orientation[snap_id] = quat<float>(el.orientation.x,
+                vec3<float>(el.orientation.y, el.orientation.z, el.orientation.w));
+            snapshot.angmom[snap_id] = quat<float>(el.angmom.x, vec3<float>(el.angmom.y, el.angmom.z, el.angmom.w));
+            snapshot.inertia[snap_id] = vec3<float>(el.inertia.x, el.inertia.y, el.inertia.z);
+            }
+        }
+
+    snapshot.type_mapping = m_type_mapping;
+
+    // copy over acceleration set flag (this is a copy in case users take a snapshot before running)
+    snapshot.is_accel_set = m_accel_set;
+
+    return true;
+    }
+#endif
+
+/*! \param checkpoint Checkpoint to copy the local particle data to
+
+    The arrays of the checkpoint are reused when they are large enough.
+*/
+void ParticleData::takeCheckpoint(ParticleDataCheckpoint& checkpoint)
+    {
+    const unsigned int N = m_nparticles;
+    const unsigned int n_rtag = (unsigned int)m_rtag.size();
+
+    // the tags of the ghost particles are kept to mark their reverse lookup tags as not local below
+    reserveArrayElements(checkpoint.pos, N, m_exec_conf);
+    reserveArrayElements(checkpoint.vel, N, m_exec_conf);
+    reserveArrayElements(checkpoint.accel, N, m_exec_conf);
+    reserveArrayElements(checkpoint.charge, N, m_exec_conf);
+    reserveArrayElements(checkpoint.diameter, N, m_exec_conf);
+    reserveArrayElements(checkpoint.image, N, m_exec_conf);
+    reserveArrayElements(checkpoint.tag, N + m_nghosts, m_exec_conf);
+    reserveArrayElements(checkpoint.rtag, n_rtag, m_exec_conf);
+    reserveArrayElements(checkpoint.body, N, m_exec_conf);
+    reserveArrayElements(checkpoint.orientation, N, m_exec_conf);
+    reserveArrayElements(checkpoint.angmom, N, m_exec_conf);
+    reserveArrayElements(checkpoint.inertia, N, m_exec_conf);
+
+    copyArrayElements(checkpoint.pos, m_pos, N, m_exec_conf);
+    copyArrayElements(checkpoint.vel, m_vel, N, m_exec_conf);
+    copyArrayElements(checkpoint.accel, m_accel, N, m_exec_conf);
+    copyArrayElements(checkpoint.charge, m_charge, N, m_exec_conf);
+    copyArrayElements(checkpoint.diameter, m_diameter, N, m_exec_conf);
+    copyArrayElements(checkpoint.image, m_image, N, m_exec_conf);
+    copyArrayElements(checkpoint.tag, m_tag, N + m_nghosts, m_exec_conf);
+    copyArrayElements(checkpoint.rtag, m_rtag, n_rtag, m_exec_conf);
+    copyArrayElements(checkpoint.body, m_body, N, m_exec_conf);
+    copyArrayElements(checkpoint.orientation, m_orientation, N, m_exec_conf);
+    copyArrayElements(checkpoint.angmom, m_angmom, N, m_exec_conf);
+    copyArrayElements(checkpoint.inertia, m_inertia, N, m_exec_conf);
+
+    #ifdef ENABLE_MPI
+    if (m_nghosts > 0)
+        {
+        // ghost particles are not restored
+        #ifdef ENABLE_HIP
+        if (m_exec_conf->isCUDAEnabled())
+            {
+            ArrayHandle<unsigned int> d_tag(checkpoint.tag, access_location::device, access_mode::read);
+            ArrayHandle<unsigned int> d_rtag(checkpoint.rtag, access_location::device, access_mode::readwrite);
+            gpu_pdata_clear_ghost_rtags(m_nghosts, d_tag.data + N, d_rtag.data);
+
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+        else
+        #endif
+            {
+            ArrayHandle<unsigned int> h_tag(checkpoint.tag, access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_rtag(checkpoint.rtag, access_location::host, access_mode::readwrite);
+            for (unsigned int i = 0; i < m_nghosts; i++)
+                h_rtag.data[h_tag.data[N + i]] = NOT_LOCAL;
+            }
+        }
+    #endif
+
+    checkpoint.N = N;
+    checkpoint.nglobal = m_nglobal;
+    checkpoint.n_rtag = n_rtag;
+    checkpoint.global_box = m_global_box;
+    checkpoint.origin = m_origin;
+    checkpoint.o_image = m_o_image;
+    checkpoint.accel_set = m_accel_set;
+    }
+
+/*! \param checkpoint Checkpoint taken by takeCheckpoint()
+
+    The particles are copied back into the existing arrays, which are reallocated only when the number of local
+    particles in the checkpoint exceeds their size. No particles may be added to or removed from the system between
+    taking and restoring the checkpoint. In parallel simulations, this method is collective.
+*/
+void ParticleData::restoreCheckpoint(const ParticleDataCheckpoint& checkpoint)
+    {
+    if (checkpoint.nglobal != m_nglobal || checkpoint.n_rtag != m_rtag.size())
+        {
+        m_exec_conf->msg->error() << "Particles were added or removed since the checkpoint was taken." << endl;
+        throw std::runtime_error("Error restoring particle data");
+        }
+
+    removeAllGhostParticles();
+    resize(checkpoint.N);
+
+    const unsigned int N = m_nparticles;
+    copyArrayElements(m_pos, checkpoint.pos, N, m_exec_conf);
+    copyArrayElements(m_vel, checkpoint.vel, N, m_exec_conf);
+    copyArrayElements(m_accel, checkpoint.accel, N, m_exec_conf);
+    copyArrayElements(m_charge, checkpoint.charge, N, m_exec_conf);
+    copyArrayElements(m_diameter, checkpoint.diameter, N, m_exec_conf);
+    copyArrayElements(m_image, checkpoint.image, N, m_exec_conf);
+    copyArrayElements(m_tag, checkpoint.tag, N, m_exec_conf);
+    copyArrayElements(m_rtag, checkpoint.rtag, checkpoint.n_rtag, m_exec_conf);
+    copyArrayElements(m_body, checkpoint.body, N, m_exec_conf);
+    copyArrayElements(m_orientation, checkpoint.orientation, N, m_exec_conf);
+    copyArrayElements(m_angmom, checkpoint.angmom, N, m_exec_conf);
+    copyArrayElements(m_inertia, checkpoint.inertia, N, m_exec_conf);
+
+    // no particle is marked for communication
+    #ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        ArrayHandle<unsigned int> d_comm_flags(m_comm_flags, access_location::device, access_mode::overwrite);
+        hipMemset(d_comm_flags.data, 0, sizeof(unsigned int)*N);
+        }
+    else
+    #endif
+        {
+        ArrayHandle<unsigned int> h_comm_flags(m_comm_flags, access_location::host, access_mode::overwrite);
+        std::fill(h_comm_flags.data, h_comm_flags.data + N, 0);
+        }
+
+    m_accel_set = checkpoint.accel_set;
+    m_origin = checkpoint.origin;
+    m_o_image = checkpoint.o_image;
+
+    setGlobalBox(checkpoint.global_box);
+
+    notifyParticleSort();
+    }
+
 //! Add ghost particles at the end of the local particle data
 /*! Ghost ptls are appended at the end of the particle data.
   Ghost particles have only incomplete particle information (position, charge, diameter) and
@@ -2511,6 +3137,10 @@ template ParticleData::ParticleData(const SnapshotParticleData<double>& snapshot
                                            std::shared_ptr<DomainDecomposition> decomposition
                                           );
 template void ParticleData::initializeFromSnapshot<double>(const SnapshotParticleData<double> & snapshot, bool ignore_bodies);
+template void ParticleData::initializeFromDistributedSnapshot<double>(
+    const DistributedSnapshotParticleData<double> & snapshot);
+template void ParticleData::takeDistributedSnapshot<double>(DistributedSnapshotParticleData<double> &snapshot,
+                                                             bool positions_only);
 template std::map<unsigned int, unsigned int> ParticleData::takeSnapshot<double>(SnapshotParticleData<double> &snapshot);
 
 
@@ -2520,6 +3150,10 @@ template ParticleData::ParticleData(const SnapshotParticleData<float>& snapshot,
                                            std::shared_ptr<DomainDecomposition> decomposition
                                           );
 template void ParticleData::initializeFromSnapshot<float>(const SnapshotParticleData<float> & snapshot, bool ignore_bodies);
+template void ParticleData::initializeFromDistributedSnapshot<float>(
+    const DistributedSnapshotParticleData<float> & snapshot);
+template void ParticleData::takeDistributedSnapshot<float>(DistributedSnapshotParticleData<float> &snapshot,
+                                                            bool positions_only);
 template std::map<unsigned int, unsigned int> ParticleData::takeSnapshot<float>(SnapshotParticleData<float> &snapshot);
 
 
@@ -2569,10 +3203,17 @@ void export_ParticleData(py::module& m)
     .def("setAngularMomentum", &ParticleData::setAngularMomentum)
     .def("setMomentsOfInertia", &ParticleData::setMomentsOfInertia)
     .def("setPressureFlag", &ParticleData::setPressureFlag)
+    .def("setEnergyFlag", &ParticleData::setEnergyFlag)
     .def("getMaximumTag", &ParticleData::getMaximumTag)
     .def("addParticle", &ParticleData::addParticle)
     .def("removeParticle", &ParticleData::removeParticle)
     .def("getNthTag", &ParticleData::getNthTag)
+    .def("takeDistributedSnapshot_float", &ParticleData::takeDistributedSnapshot<float>,
+         py::arg("snapshot"), py::arg("positions_only")=false)
+    .def("takeDistributedSnapshot_double", &ParticleData::takeDistributedSnapshot<double>,
+         py::arg("snapshot"), py::arg("positions_only")=false)
+    .def("initializeFromDistributedSnapshot_float", &ParticleData::initializeFromDistributedSnapshot<float>)
+    .def("initializeFromDistributedSnapshot_double", &ParticleData::initializeFromDistributedSnapshot<double>)
 #ifdef ENABLE_MPI
     .def("setDomainDecomposition", &ParticleData::setDomainDecomposition)
     .def("getDomainDecomposition", &ParticleData::getDomainDecomposition)
@@ -2663,6 +3304,8 @@ void ParticleData::removeParticles(std::vector<pdata_element>& out, std::vector<
     {
     if (m_prof) m_prof->push("pack");
 
+    requireAlternateArrays();
+
     unsigned int num_remove_ptls = 0;
 
         {
@@ -2820,7 +3463,7 @@ void ParticleData::removeParticles(std::vector<pdata_element>& out, std::vector<
     if (m_prof) m_prof->pop();
 
     // notify subscribers that particle data order has been changed
-    notifyParticleSort();
+    notifyParticleSort(particle_sort::removal);
     }
 
 //! Remove particles from local domain and append new particle data
@@ -2895,7 +3538,7 @@ void ParticleData::addParticles(const std::vector<pdata_element>& in)
     if (m_prof) m_prof->pop();
 
     // notify subscribers that particle data order has been changed
-    notifyParticleSort();
+    notifyParticleSort(particle_sort::append, old_nparticles);
     }
 
 #ifdef ENABLE_HIP
@@ -2908,6 +3551,8 @@ void ParticleData::removeParticlesGPU(GlobalVector<pdata_element>& out, GlobalVe
     {
     if (m_prof) m_prof->push(m_exec_conf, "pack");
 
+    requireAlternateArrays();
+
     // this is the maximum number of elements we can possibly write to out
     unsigned int max_n_out = (unsigned int)out.getNumElements();
     if (comm_flags.getNumElements() < max_n_out)
@@ -3053,7 +3698,7 @@ void ParticleData::removeParticlesGPU(GlobalVector<pdata_element>& out, GlobalVe
     swapTags();
 
     // notify subscribers
-    notifyParticleSort();
+    notifyParticleSort(particle_sort::removal);
 
     if (m_prof) m_prof->pop(m_exec_conf);
     }
@@ -3120,7 +3765,7 @@ void ParticleData::addParticlesGPU(const GlobalVector<pdata_element>& in)
         }
 
     // notify subscribers
-    notifyParticleSort();
+    notifyParticleSort(particle_sort::append, old_nparticles);
 
     if (m_prof) m_prof->pop(m_exec_conf);
     }
@@ -3128,6 +3773,55 @@ void ParticleData::addParticlesGPU(const GlobalVector<pdata_element>& in)
 #endif // ENABLE_HIP
 #endif // ENABLE_MPI
 
+#ifdef ENABLE_HIP
+//! Queue the device to host copy of an array
+template<class T> static void prefetchHostArray(const GlobalArray<T>& array)
+    {
+    ArrayHandleAsync<T> h_array(array, access_location::host, access_mode::read);
+    }
+#endif
+
+/*! \param arrays Arrays to copy
+
+    Without a prefetch, each host ArrayHandle of an analyzer copies its array and waits for the copy to finish before
+    the next one starts. Here, the copies of all selected arrays are queued together with ArrayHandleAsync and waited
+    for once. The arrays remain valid on the device, and the host handles acquired afterwards find the data in place.
+*/
+void ParticleData::prefetchHostArrays(const HostArrays& arrays)
+    {
+    #ifdef ENABLE_HIP
+    if (!m_exec_conf->isCUDAEnabled() || arrays.none())
+        return;
+
+    if (arrays[host_array::position])
+        prefetchHostArray(m_pos);
+    if (arrays[host_array::velocity])
+        prefetchHostArray(m_vel);
+    if (arrays[host_array::acceleration])
+        prefetchHostArray(m_accel);
+    if (arrays[host_array::image])
+        prefetchHostArray(m_image);
+    if (arrays[host_array::tag])
+        prefetchHostArray(m_tag);
+    if (arrays[host_array::charge])
+        prefetchHostArray(m_charge);
+    if (arrays[host_array::diameter])
+        prefetchHostArray(m_diameter);
+    if (arrays[host_array::body])
+        prefetchHostArray(m_body);
+    if (arrays[host_array::orientation])
+        prefetchHostArray(m_orientation);
+    if (arrays[host_array::angular_momentum])
+        prefetchHostArray(m_angmom);
+    if (arrays[host_array::moment_of_inertia])
+        prefetchHostArray(m_inertia);
+
+    hipDeviceSynchronize();
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    #endif
+    }
+
 void ParticleData::setGPUAdvice()
     {
     #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
@@ -3522,19 +4216,20 @@ void SnapshotParticleData<Real>::setTypes(py::list types)
 template <class Real>
 void SnapshotParticleData<Real>::bcast(unsigned int root, MPI_Comm mpi_comm)
     {
-    // broadcast all member quantities
-    ::bcast(pos, root, mpi_comm);
-    ::bcast(vel, root, mpi_comm);
-    ::bcast(accel, root, mpi_comm);
-    ::bcast(type, root, mpi_comm);
-    ::bcast(mass, root, mpi_comm);
-    ::bcast(charge, root, mpi_comm);
-    ::bcast(diameter, root, mpi_comm);
-    ::bcast(image, root, mpi_comm);
-    ::bcast(body, root, mpi_comm);
-    ::bcast(orientation, root, mpi_comm);
-    ::bcast(angmom, root, mpi_comm);
-    ::bcast(inertia, root, mpi_comm);
+    // broadcast the per-particle arrays once per node
+    NodeBroadcast node_bcast(root, mpi_comm);
+    node_bcast.bcast(pos);
+    node_bcast.bcast(vel);
+    node_bcast.bcast(accel);
+    node_bcast.bcast(type);
+    node_bcast.bcast(mass);
+    node_bcast.bcast(charge);
+    node_bcast.bcast(diameter);
+    node_bcast.bcast(image);
+    node_bcast.bcast(body);
+    node_bcast.bcast(orientation);
+    node_bcast.bcast(angmom);
+    node_bcast.bcast(inertia);
 
     ::bcast(size, root, mpi_comm);
     ::bcast(type_mapping, root, mpi_comm);
@@ -3546,6 +4241,19 @@ void SnapshotParticleData<Real>::bcast(unsigned int root, MPI_Comm mpi_comm)
 template struct SnapshotParticleData<float>;
 template struct SnapshotParticleData<double>;
 
+/*! \returns a numpy array that wraps the tag data element.
+    The raw data is referenced by the numpy array, modifications to the numpy array will modify the snapshot
+*/
+template <class Real>
+py::object DistributedSnapshotParticleData<Real>::getTagNP(pybind11::object self)
+    {
+    auto self_cpp = self.cast<DistributedSnapshotParticleData<Real> *>();
+    return pybind11::array(self_cpp->tag.size(), self_cpp->tag.data(), self);
+    }
+
+template struct DistributedSnapshotParticleData<float>;
+template struct DistributedSnapshotParticleData<double>;
+
 void export_SnapshotParticleData(py::module& m)
     {
     py::class_<SnapshotParticleData<float>, std::shared_ptr<SnapshotParticleData<float> > >(m,"SnapshotParticleData_float")
@@ -3586,3 +4294,26 @@ void export_SnapshotParticleData(py::module& m)
     .def_readonly("is_accel_set", &SnapshotParticleData<double>::is_accel_set)
     ;
    }
+
+void export_DistributedSnapshotParticleData(py::module& m)
+    {
+    py::class_<DistributedSnapshotParticleData<float>, SnapshotParticleData<float>,
+               std::shared_ptr<DistributedSnapshotParticleData<float> > >(m,"DistributedSnapshotParticleData_float")
+    .def(py::init<>())
+    .def_property_readonly("tag", &DistributedSnapshotParticleData<float>::getTagNP)
+    .def_property("N", &DistributedSnapshotParticleData<float>::getSize,
+                  &DistributedSnapshotParticleData<float>::resize)
+    .def_readwrite("N_global", &DistributedSnapshotParticleData<float>::nglobal)
+    .def_readonly("offset", &DistributedSnapshotParticleData<float>::offset)
+    ;
+
+    py::class_<DistributedSnapshotParticleData<double>, SnapshotParticleData<double>,
+               std::shared_ptr<DistributedSnapshotParticleData<double> > >(m,"DistributedSnapshotParticleData_double")
+    .def(py::init<>())
+    .def_property_readonly("tag", &DistributedSnapshotParticleData<double>::getTagNP)
+    .def_property("N", &DistributedSnapshotParticleData<double>::getSize,
+                  &DistributedSnapshotParticleData<double>::resize)
+    .def_readwrite("N_global", &DistributedSnapshotParticleData<double>::nglobal)
+    .def_readonly("offset", &DistributedSnapshotParticleData<double>::offset)
+    ;
+    }
@@ -482,4 +482,138 @@ void gpu_pdata_add_particles(const unsigned int old_nparticles,
         d_comm_flags);
     }
 
+__global__ void gpu_pdata_clear_ghost_rtags_kernel(const unsigned int nghosts,
+                    const unsigned int *d_ghost_tag,
+                    unsigned int *d_rtag)
+    {
+    unsigned int idx = blockIdx.x*blockDim.x + threadIdx.x;
+
+    if (idx >= nghosts) return;
+    d_rtag[d_ghost_tag[idx]] = NOT_LOCAL;
+    }
+
+/*! \param nghosts Number of ghost particles
+    \param d_ghost_tag Device array of ghost particle tags
+    \param d_rtag Device array for reverse-lookup table
+ */
+void gpu_pdata_clear_ghost_rtags(const unsigned int nghosts,
+                    const unsigned int *d_ghost_tag,
+                    unsigned int *d_rtag)
+    {
+    assert(d_ghost_tag);
+    assert(d_rtag);
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = nghosts/block_size + 1;
+
+    hipLaunchKernelGGL(gpu_pdata_clear_ghost_rtags_kernel, dim3(n_blocks), dim3(block_size), 0, 0,
+        nghosts,
+        d_ghost_tag,
+        d_rtag);
+    }
+
 #endif // ENABLE_MPI
+
+//! Kernel to convert the local particle data to single precision
+__global__ void gpu_pdata_pack_snapshot_kernel(const unsigned int N,
+                    const Scalar4 *d_pos,
+                    const Scalar4 *d_vel,
+                    const Scalar3 *d_accel,
+                    const Scalar *d_charge,
+                    const Scalar *d_diameter,
+                    const int3 *d_image,
+                    const unsigned int *d_body,
+                    const Scalar4 *d_orientation,
+                    const Scalar4 *d_angmom,
+                    const Scalar3 *d_inertia,
+                    const unsigned int *d_tag,
+                    const BoxDim global_box,
+                    const Scalar3 origin,
+                    const int3 o_image,
+                    pdata_snapshot_element *d_out)
+    {
+    unsigned int idx = blockIdx.x*blockDim.x + threadIdx.x;
+
+    if (idx >= N) return;
+
+    // make sure the position stored in the snapshot is within the boundaries
+    Scalar4 postype = d_pos[idx];
+    Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z) - origin;
+    int3 img = d_image[idx];
+    img.x -= o_image.x;
+    img.y -= o_image.y;
+    img.z -= o_image.z;
+    global_box.wrap(pos, img);
+
+    Scalar4 vel = d_vel[idx];
+    Scalar3 accel = d_accel[idx];
+    Scalar4 orientation = d_orientation[idx];
+    Scalar4 angmom = d_angmom[idx];
+    Scalar3 inertia = d_inertia[idx];
+
+    pdata_snapshot_element el;
+    el.pos = make_float3(float(pos.x), float(pos.y), float(pos.z));
+    el.vel = make_float3(float(vel.x), float(vel.y), float(vel.z));
+    el.accel = make_float3(float(accel.x), float(accel.y), float(accel.z));
+    el.mass = float(vel.w);
+    el.charge = float(d_charge[idx]);
+    el.diameter = float(d_diameter[idx]);
+    el.orientation = make_float4(float(orientation.x), float(orientation.y), float(orientation.z),
+                                 float(orientation.w));
+    el.angmom = make_float4(float(angmom.x), float(angmom.y), float(angmom.z), float(angmom.w));
+    el.inertia = make_float3(float(inertia.x), float(inertia.y), float(inertia.z));
+    el.image = img;
+    el.type = __scalar_as_int(postype.w);
+    el.body = d_body[idx];
+    el.tag = d_tag[idx];
+    d_out[idx] = el;
+    }
+
+/*! \param N Number of local particles
+    \param global_box Global simulation box
+    \param origin Origin of the particle data
+    \param o_image Image of the origin
+    \param d_out Output elements, one per local particle in the order of the local particle data
+
+    The other parameters are the device arrays of the particle data.
+*/
+void gpu_pdata_pack_snapshot(const unsigned int N,
+                    const Scalar4 *d_pos,
+                    const Scalar4 *d_vel,
+                    const Scalar3 *d_accel,
+                    const Scalar *d_charge,
+                    const Scalar *d_diameter,
+                    const int3 *d_image,
+                    const unsigned int *d_body,
+                    const Scalar4 *d_orientation,
+                    const Scalar4 *d_angmom,
+                    const Scalar3 *d_inertia,
+                    const unsigned int *d_tag,
+                    const BoxDim& global_box,
+                    const Scalar3 origin,
+                    const int3 o_image,
+                    pdata_snapshot_element *d_out)
+    {
+    assert(d_out);
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = N/block_size + 1;
+
+    hipLaunchKernelGGL(gpu_pdata_pack_snapshot_kernel, dim3(n_blocks), dim3(block_size), 0, 0,
+        N,
+        d_pos,
+        d_vel,
+        d_accel,
+        d_charge,
+        d_diameter,
+        d_image,
+        d_body,
+        d_orientation,
+        d_angmom,
+        d_inertia,
+        d_tag,
+        global_box,
+        origin,
+        o_image,
+        d_out);
+    }
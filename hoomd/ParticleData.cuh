@@ -112,4 +112,45 @@ void gpu_pdata_add_particles(const unsigned int old_nparticles,
                     unsigned int *d_rtag,
                     const pdata_element *d_in,
                     unsigned int *d_comm_flags);
+
+//! Mark the reverse lookup tags of ghost particles as not local
+void gpu_pdata_clear_ghost_rtags(const unsigned int nghosts,
+                    const unsigned int *d_ghost_tag,
+                    unsigned int *d_rtag);
+
+//! Particle data of one particle converted to single precision for a snapshot
+struct pdata_snapshot_element
+    {
+    float3 pos;                //!< Position relative to the origin, wrapped into the global box
+    float3 vel;                //!< Velocity
+    float3 accel;              //!< Acceleration
+    float mass;                //!< Mass
+    float charge;              //!< Charge
+    float diameter;            //!< Diameter
+    float4 orientation;        //!< Orientation
+    float4 angmom;             //!< Angular momentum
+    float3 inertia;            //!< Moments of inertia
+    int3 image;                //!< Image relative to the origin
+    unsigned int type;         //!< Type id
+    unsigned int body;         //!< Body id
+    unsigned int tag;          //!< Global tag
+    };
+
+//! Convert the local particle data to single precision for a snapshot
+void gpu_pdata_pack_snapshot(const unsigned int N,
+                    const Scalar4 *d_pos,
+                    const Scalar4 *d_vel,
+                    const Scalar3 *d_accel,
+                    const Scalar *d_charge,
+                    const Scalar *d_diameter,
+                    const int3 *d_image,
+                    const unsigned int *d_body,
+                    const Scalar4 *d_orientation,
+                    const Scalar4 *d_angmom,
+                    const Scalar3 *d_inertia,
+                    const unsigned int *d_tag,
+                    const BoxDim& global_box,
+                    const Scalar3 origin,
+                    const int3 o_image,
+                    pdata_snapshot_element *d_out);
 #endif
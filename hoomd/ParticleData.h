@@ -46,6 +46,7 @@
 #include "DomainDecomposition.h"
 
 #include <stdlib.h>
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <string>
@@ -83,13 +84,50 @@ struct pdata_flag
         {
         pressure_tensor=0,          //!< Bit id in PDataFlags for the full virial
         rotational_kinetic_energy,  //!< Bit id in PDataFlags for the rotational kinetic energy
-        external_field_virial       //!< Bit id in PDataFlags for the external virial contribution of volume change
+        external_field_virial,      //!< Bit id in PDataFlags for the external virial contribution of volume change
+        potential_energy            //!< Bit id in PDataFlags for the potential energy
         };
     };
 
 //! flags determines which optional fields in in the particle data arrays are to be computed / are valid
 typedef std::bitset<32> PDataFlags;
 
+//! List of particle data arrays that can be copied to the host ahead of the operations that read them
+struct host_array
+    {
+    //! The enum
+    enum Enum
+        {
+        position=0,         //!< Bit id in HostArrays for the positions and types
+        velocity,           //!< Bit id in HostArrays for the velocities and masses
+        acceleration,       //!< Bit id in HostArrays for the accelerations
+        image,              //!< Bit id in HostArrays for the images
+        tag,                //!< Bit id in HostArrays for the tags
+        charge,             //!< Bit id in HostArrays for the charges
+        diameter,           //!< Bit id in HostArrays for the diameters
+        body,               //!< Bit id in HostArrays for the body ids
+        orientation,        //!< Bit id in HostArrays for the orientations
+        angular_momentum,   //!< Bit id in HostArrays for the angular momenta
+        moment_of_inertia   //!< Bit id in HostArrays for the moments of inertia
+        };
+    };
+
+//! flags determines which particle data arrays are read on the host
+typedef std::bitset<32> HostArrays;
+
+//! Describes how the local particles were rearranged by the last particle sort (see ParticleData::notifyParticleSort())
+struct particle_sort
+    {
+    //! The enum
+    enum Enum
+        {
+        arbitrary=0,    //!< Particles may have been replaced or changed in any way
+        permutation,    //!< The same particles, in a different order
+        removal,        //!< Some particles were removed, the others keep their relative order
+        append          //!< Particles were appended after the first getNParticlesKeptBySort() particles
+        };
+    };
+
 //! Defines a simple structure to deal with complex numbers
 /*! This structure is useful to deal with complex numbers for such situations
     as Fourier transforms. Note that we do not need any to define any operations and the
@@ -248,6 +286,50 @@ struct PYBIND11_EXPORT SnapshotParticleData {
     bool is_accel_set;                         //!< Flag indicating if accel is set
     };
 
+//! Particles owned by one rank, identified by their global tags
+/*! A distributed snapshot holds the local particles of one rank in increasing tag order. It follows the conventions
+    of SnapshotParticleData: positions are relative to the origin and wrapped into the global box. Taking or applying
+    a distributed snapshot does not communicate particle data, unlike the global snapshot gathered on the root rank.
+
+    offset is the number of particles on the lower ranks. Row i of this snapshot is row offset + i of the
+    concatenation of the distributed snapshots of all ranks in rank order.
+
+    \ingroup data_structs
+*/
+template <class Real>
+struct PYBIND11_EXPORT DistributedSnapshotParticleData : public SnapshotParticleData<Real>
+    {
+    //! Empty snapshot
+    DistributedSnapshotParticleData()
+        : SnapshotParticleData<Real>(), nglobal(0), offset(0)
+        {
+        }
+
+    //! Resize the snapshot
+    /*! \param N number of local particles in snapshot
+     */
+    void resize(unsigned int N)
+        {
+        SnapshotParticleData<Real>::resize(N);
+        tag.resize(N);
+        }
+
+    //! Validate the snapshot
+    /*! \returns true if the number of elements is consistent
+     */
+    bool validate() const
+        {
+        return SnapshotParticleData<Real>::validate() && tag.size() == this->size;
+        }
+
+    //! Get tag as a Python object
+    static pybind11::object getTagNP(pybind11::object self);
+
+    std::vector<unsigned int> tag;             //!< Global tag of each particle
+    unsigned int nglobal;                      //!< Number of particles on all ranks
+    unsigned int offset;                       //!< Number of particles on the lower ranks
+    };
+
 //! Structure to store packed particle data
 /* pdata_element is used for compact storage of particle data, mainly for communication.
  */
@@ -269,6 +351,85 @@ struct pdata_element
     Scalar net_virial[6];      //!< net virial
     };
 
+//! Copy the first elements of one array to another on the execution device
+/*! \param dst Destination array, which must hold at least \a n elements
+    \param src Source array
+    \param n Number of elements to copy
+    \param exec_conf Execution configuration
+
+    With CUDA enabled, the elements are copied device to device, so neither array migrates to the host.
+*/
+template<class T, class Dst, class Src>
+inline void copyArrayElements(const GPUArrayBase<T, Dst>& dst,
+                              const GPUArrayBase<T, Src>& src,
+                              unsigned int n,
+                              std::shared_ptr<const ExecutionConfiguration> exec_conf)
+    {
+    if (n == 0)
+        return;
+
+    #ifdef ENABLE_HIP
+    if (exec_conf->isCUDAEnabled())
+        {
+        ArrayHandle<T> d_src(src, access_location::device, access_mode::read);
+        ArrayHandle<T> d_dst(dst, access_location::device, access_mode::overwrite);
+        hipMemcpy(d_dst.data, d_src.data, sizeof(T)*n, hipMemcpyDeviceToDevice);
+        }
+    else
+    #endif
+        {
+        ArrayHandle<T> h_src(src, access_location::host, access_mode::read);
+        ArrayHandle<T> h_dst(dst, access_location::host, access_mode::overwrite);
+        std::copy(h_src.data, h_src.data + n, h_dst.data);
+        }
+    }
+
+//! Grow an array to hold at least \a n elements, discarding its contents
+template<class T>
+inline void reserveArrayElements(GlobalArray<T>& array,
+                                 unsigned int n,
+                                 std::shared_ptr<const ExecutionConfiguration> exec_conf)
+    {
+    if (array.isNull() || array.getNumElements() < n)
+        {
+        GlobalArray<T> new_array(std::max(1u, n), exec_conf);
+        array.swap(new_array);
+        }
+    }
+
+//! Copy of the local particle data that ParticleData restores in place
+/*! ParticleData::takeCheckpoint() copies the per-particle arrays of the local particles, the reverse lookup tags, and
+    the global box into a checkpoint, and ParticleData::restoreCheckpoint() copies them back. The checkpoint grows its
+    arrays only when the number of local particles exceeds their size, so a checkpoint that is taken repeatedly does
+    not reallocate. Neither call reallocates the particle data when the number of local particles is the same, and on
+    the GPU neither moves data to the host.
+
+    Ghost particles are not stored. Their reverse lookup tags are NOT_LOCAL in the checkpoint.
+*/
+struct PYBIND11_EXPORT ParticleDataCheckpoint
+    {
+    GlobalArray<Scalar4> pos;               //!< Positions and types
+    GlobalArray<Scalar4> vel;               //!< Velocities and masses
+    GlobalArray<Scalar3> accel;             //!< Accelerations
+    GlobalArray<Scalar> charge;             //!< Charges
+    GlobalArray<Scalar> diameter;           //!< Diameters
+    GlobalArray<int3> image;                //!< Images
+    GlobalArray<unsigned int> tag;          //!< Tags of the local particles, followed by those of the ghosts
+    GlobalArray<unsigned int> rtag;         //!< Reverse lookup tags
+    GlobalArray<unsigned int> body;         //!< Rigid body ids
+    GlobalArray<Scalar4> orientation;       //!< Orientations
+    GlobalArray<Scalar4> angmom;            //!< Angular momenta
+    GlobalArray<Scalar3> inertia;           //!< Principal moments of inertia
+
+    unsigned int N = 0;                     //!< Number of local particles
+    unsigned int nglobal = 0;               //!< Global number of particles
+    unsigned int n_rtag = 0;                //!< Number of reverse lookup tags
+    BoxDim global_box;                      //!< Global simulation box
+    Scalar3 origin;                         //!< Origin of the box
+    int3 o_image;                           //!< Image of the origin
+    bool accel_set = false;                 //!< Whether the accelerations are valid
+    };
+
 //! Manages all of the data arrays for the particles
 /*! <h1> General </h1>
     ParticleData stores and manages particle coordinates, velocities, accelerations, type,
@@ -301,7 +462,9 @@ struct pdata_element
 
     In order to help other classes deal with particles changing indices, any class that
     changes the order must call notifyParticleSort(). Any class interested in being notified
-    can subscribe to the signal by calling connectParticleSort().
+    can subscribe to the signal by calling connectParticleSort(). Classes that know how the particles were rearranged
+    pass a particle_sort value, which subscribers can read with getLastParticleSort() to update their own index
+    based data incrementally instead of rebuilding it.
 
     Some fields in ParticleData are not computed and assigned by default because they require additional processing
     time. PDataFlags is a bitset that lists which flags (enumerated in pdata_flag) are enable/disabled. Computes should
@@ -315,6 +478,7 @@ struct pdata_element
     These fields are:
      - pdata_flag::pressure_tensor - specify that the full virial tensor is valid
      - pdata_flag::external_field_virial - specify that an external virial contribution is valid
+     - pdata_flag::potential_energy - specify that the per particle potential energy is valid (set by default)
 
     If these flags are not set, these arrays can still be read but their values may be incorrect.
 
@@ -590,6 +754,9 @@ class PYBIND11_EXPORT ParticleData
         //! Return positions and types
         const GlobalArray< Scalar4 >& getPositions() const { return m_pos; }
 
+        //! Return a structure-of-arrays copy of the local and ghost particle positions and types
+        const GlobalArray< Scalar >& getPositionsSoA(unsigned int first=0);
+
         //! Return velocities and masses
         const GlobalArray< Scalar4 >& getVelocities() const { return m_vel; }
 
@@ -633,85 +800,88 @@ class PYBIND11_EXPORT ParticleData
          * m_pdata->swapPositions(); // swap in reordered data at no extra cost
          * notifyParticleSort();     // ensures that ghosts will be restored at next communication step
          * \endcode
+         *
+         * The stand-by arrays are allocated on first access. Simulations that neither migrate particles nor sort them
+         * through these arrays never allocate them, which halves the memory used by the per-particle arrays.
          */
 
         //! Return positions and types (alternate array)
-        const GlobalArray< Scalar4 >& getAltPositions() const { return m_pos_alt; }
+        const GlobalArray< Scalar4 >& getAltPositions() { requireAlternateArrays(); return m_pos_alt; }
 
         //! Swap in positions
         inline void swapPositions() { m_pos.swap(m_pos_alt); }
 
         //! Return velocities and masses (alternate array)
-        const GlobalArray< Scalar4 >& getAltVelocities() const { return m_vel_alt; }
+        const GlobalArray< Scalar4 >& getAltVelocities() { requireAlternateArrays(); return m_vel_alt; }
 
         //! Swap in velocities
         inline void swapVelocities() { m_vel.swap(m_vel_alt); }
 
         //! Return accelerations (alternate array)
-        const GlobalArray< Scalar3 >& getAltAccelerations() const { return m_accel_alt; }
+        const GlobalArray< Scalar3 >& getAltAccelerations() { requireAlternateArrays(); return m_accel_alt; }
 
         //! Swap in accelerations
         inline void swapAccelerations() { m_accel.swap(m_accel_alt); }
 
         //! Return charges (alternate array)
-        const GlobalArray< Scalar >& getAltCharges() const { return m_charge_alt; }
+        const GlobalArray< Scalar >& getAltCharges() { requireAlternateArrays(); return m_charge_alt; }
 
         //! Swap in accelerations
         inline void swapCharges() { m_charge.swap(m_charge_alt); }
 
         //! Return diameters (alternate array)
-        const GlobalArray< Scalar >& getAltDiameters() const { return m_diameter_alt; }
+        const GlobalArray< Scalar >& getAltDiameters() { requireAlternateArrays(); return m_diameter_alt; }
 
         //! Swap in diameters
         inline void swapDiameters() { m_diameter.swap(m_diameter_alt); }
 
         //! Return images (alternate array)
-        const GlobalArray< int3 >& getAltImages() const { return m_image_alt; }
+        const GlobalArray< int3 >& getAltImages() { requireAlternateArrays(); return m_image_alt; }
 
         //! Swap in images
         inline void swapImages() { m_image.swap(m_image_alt); }
 
         //! Return tags (alternate array)
-        const GlobalArray< unsigned int >& getAltTags() const { return m_tag_alt; }
+        const GlobalArray< unsigned int >& getAltTags() { requireAlternateArrays(); return m_tag_alt; }
 
         //! Swap in tags
         inline void swapTags() { m_tag.swap(m_tag_alt); }
 
         //! Return body ids (alternate array)
-        const GlobalArray< unsigned int >& getAltBodies() const { return m_body_alt; }
+        const GlobalArray< unsigned int >& getAltBodies() { requireAlternateArrays(); return m_body_alt; }
 
         //! Swap in bodies
         inline void swapBodies() { m_body.swap(m_body_alt); }
 
         //! Get the net force array (alternate array)
-        const GlobalArray< Scalar4 >& getAltNetForce() const { return m_net_force_alt; }
+        const GlobalArray< Scalar4 >& getAltNetForce() { requireAlternateArrays(); return m_net_force_alt; }
 
         //! Swap in net force
         inline void swapNetForce() { m_net_force.swap(m_net_force_alt); }
 
         //! Get the net virial array (alternate array)
-        const GlobalArray< Scalar >& getAltNetVirial() const { return m_net_virial_alt; }
+        const GlobalArray< Scalar >& getAltNetVirial() { requireAlternateArrays(); return m_net_virial_alt; }
 
         //! Swap in net virial
         inline void swapNetVirial() { m_net_virial.swap(m_net_virial_alt); }
 
         //! Get the net torque array (alternate array)
-        const GlobalArray< Scalar4 >& getAltNetTorqueArray() const { return m_net_torque_alt; }
+        const GlobalArray< Scalar4 >& getAltNetTorqueArray() { requireAlternateArrays(); return m_net_torque_alt; }
 
         //! Swap in net torque
         inline void swapNetTorque() { m_net_torque.swap(m_net_torque_alt); }
 
         //! Get the orientations (alternate array)
-        const GlobalArray< Scalar4 >& getAltOrientationArray() const { return m_orientation_alt; }
+        const GlobalArray< Scalar4 >& getAltOrientationArray() { requireAlternateArrays(); return m_orientation_alt; }
 
         //! Swap in orientations
         inline void swapOrientations() { m_orientation.swap(m_orientation_alt); }
 
         //! Get the angular momenta (alternate array)
-        const GlobalArray< Scalar4 >& getAltAngularMomentumArray() const { return m_angmom_alt; }
+        const GlobalArray< Scalar4 >& getAltAngularMomentumArray() { requireAlternateArrays(); return m_angmom_alt; }
 
         //! Get the moments of inertia array (alternate array)
-        const GlobalArray< Scalar3 >& getAltMomentsOfInertiaArray() const { return m_inertia_alt; }
+        const GlobalArray< Scalar3 >& getAltMomentsOfInertiaArray() { requireAlternateArrays(); return m_inertia_alt; }
 
         //! Swap in angular momenta
         inline void swapAngularMomenta() { m_angmom.swap(m_angmom_alt); }
@@ -734,7 +904,27 @@ class PYBIND11_EXPORT ParticleData
             }
 
         //! Notify listeners that the particles have been rearranged in memory
-        void notifyParticleSort();
+        void notifyParticleSort()
+            {
+            notifyParticleSort(particle_sort::arbitrary);
+            }
+
+        //! Notify listeners that the particles have been rearranged in memory in a known way
+        void notifyParticleSort(particle_sort::Enum how, unsigned int n_kept = 0);
+
+        //! Get how the particles were rearranged by the last particle sort
+        /*! Valid while the particle sort signal is emitted
+        */
+        particle_sort::Enum getLastParticleSort() const
+            {
+            return m_last_sort;
+            }
+
+        //! Get the number of leading particles that kept their index in the last particle sort of type append
+        unsigned int getNParticlesKeptBySort() const
+            {
+            return m_sort_n_kept;
+            }
 
         //! Connects a function to be called every time the box size is changed
         Nano::Signal<void ()>& getBoxChangeSignal()
@@ -966,6 +1156,12 @@ class PYBIND11_EXPORT ParticleData
             m_flags[pdata_flag::pressure_tensor] = 1;
             }
 
+        /// Enable potential energy computations
+        void setEnergyFlag()
+            {
+            m_flags[pdata_flag::potential_energy] = 1;
+            }
+
         //! Set the external contribution to the virial
         void setExternalVirial(unsigned int i, Scalar v)
             {
@@ -995,14 +1191,36 @@ class PYBIND11_EXPORT ParticleData
         //! Remove the given flag
         void removeFlag(pdata_flag::Enum flag) { m_flags[flag] = false; }
 
+        //! Copy particle data arrays to the host ahead of the operations that read them
+        void prefetchHostArrays(const HostArrays& arrays);
+
         //! Initialize from a snapshot
         template <class Real>
         void initializeFromSnapshot(const SnapshotParticleData<Real> & snapshot, bool ignore_bodies=false);
 
+        //! Take a snapshot of the local particles
+        template <class Real>
+        void takeDistributedSnapshot(DistributedSnapshotParticleData<Real> &snapshot, bool positions_only=false);
+
+        //! Initialize the local particles from a snapshot that holds only the particles of this rank
+        template <class Real>
+        void initializeFromDistributedSnapshot(const DistributedSnapshotParticleData<Real> & snapshot);
+
+#ifdef ENABLE_MPI
+        //! Wrap a snapshot particle into the global box and find the rank that owns it
+        unsigned int placeSnapshotParticle(Scalar3& pos, int3& img, const unsigned int *cart_ranks);
+#endif
+
         //! Take a snapshot
         template <class Real>
         std::map<unsigned int, unsigned int> takeSnapshot(SnapshotParticleData<Real> &snapshot);
 
+        //! Copy the local particle data into a checkpoint
+        void takeCheckpoint(ParticleDataCheckpoint& checkpoint);
+
+        //! Restore the local particle data from a checkpoint
+        void restoreCheckpoint(const ParticleDataCheckpoint& checkpoint);
+
         //! Add ghost particles at the end of the local particle data
         void addGhostParticles(const unsigned int nghosts);
 
@@ -1137,6 +1355,8 @@ class PYBIND11_EXPORT ParticleData
         std::vector<std::string> m_type_mapping;    //!< Mapping between particle type indices and names
 
         Nano::Signal<void ()> m_sort_signal;       //!< Signal that is triggered when particles are sorted in memory
+        particle_sort::Enum m_last_sort = particle_sort::arbitrary; //!< How the particles were rearranged last
+        unsigned int m_sort_n_kept = 0;             //!< Particles before the appended ones in the last sort
         Nano::Signal<void ()> m_boxchange_signal;  //!< Signal that is triggered when the box size changes
         Nano::Signal<void ()> m_max_particle_num_signal; //!< Signal that is triggered when the maximum particle number changes
         Nano::Signal<void ()> m_ghost_particles_removed_signal; //!< Signal that is triggered when ghost particles are removed
@@ -1168,6 +1388,7 @@ class PYBIND11_EXPORT ParticleData
         GlobalArray< Scalar4 > m_angmom;               //!< Angular momementum quaternion for each particle
         GlobalArray< Scalar3 > m_inertia;              //!< Principal moments of inertia for each particle
         GlobalArray<unsigned int> m_comm_flags;        //!< Array of communication flags
+        GlobalArray<Scalar> m_pos_soa;                 //!< Positions and types by component (getPositionsSoA())
 
         std::stack<unsigned int> m_recycled_tags;    //!< Global tags of removed particles
         std::set<unsigned int> m_tag_set;            //!< Lookup table for tags by active index
@@ -1217,6 +1438,7 @@ class PYBIND11_EXPORT ParticleData
         #ifdef ENABLE_HIP
         GPUPartition m_gpu_partition;                //!< The partition of the local number of particles across GPUs
         unsigned int m_memory_advice_last_Nmax;      //!< Nmax at which memory hints were last set
+        GPUArray<pdata_snapshot_element> m_snapshot_buffer; //!< Local particles converted for a snapshot
         #endif
 
         //! Helper function to allocate particle data
@@ -1225,6 +1447,13 @@ class PYBIND11_EXPORT ParticleData
         //! Helper function to allocate alternate particle data
         void allocateAlternateArrays(unsigned int N);
 
+        //! Allocate the alternate particle data on first use
+        void requireAlternateArrays()
+            {
+            if (m_pos_alt.isNull())
+                allocateAlternateArrays(m_max_nparticles);
+            }
+
         //! Helper function for amortized array resizing
         void resize(unsigned int new_nparticles);
 
@@ -1243,6 +1472,17 @@ class PYBIND11_EXPORT ParticleData
 
         //! Update the CUDA memory hints
         void setGPUAdvice();
+
+        #ifdef ENABLE_HIP
+        //! Take a single precision snapshot from data converted on the device
+        bool takeSnapshotOnDevice(SnapshotParticleData<float>& snapshot, std::map<unsigned int, unsigned int>& index);
+
+        //! Double precision snapshots are taken on the host
+        bool takeSnapshotOnDevice(SnapshotParticleData<double>&, std::map<unsigned int, unsigned int>&)
+            {
+            return false;
+            }
+        #endif
     };
 
 /// Allow the usage of Particle Data arrays in Python.
@@ -1516,12 +1756,17 @@ void export_LocalParticleData(pybind11::module& m, std::string name)
     .def("getTags", &LocalParticleData<Output>::getTags)
     .def("getRTags", &LocalParticleData<Output>::getRTags)
     .def("getBodies", &LocalParticleData<Output>::getBodies)
+    .def("selectRows", &LocalParticleData<Output>::selectRows)
+    .def("selectAllRows", &LocalParticleData<Output>::selectAllRows)
     .def("enter", &LocalParticleData<Output>::enter)
     .def("exit", &LocalParticleData<Output>::exit)
     ;
     }
 //! Export SnapshotParticleData to python
 void export_SnapshotParticleData(pybind11::module& m);
+
+//! Export DistributedSnapshotParticleData to python
+void export_DistributedSnapshotParticleData(pybind11::module& m);
 #endif
 
 
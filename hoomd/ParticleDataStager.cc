@@ -0,0 +1,241 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ParticleDataStager.cc
+    \brief Defines the ParticleDataStager class
+*/
+
+#include "ParticleDataStager.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace py = pybind11;
+using namespace std;
+
+/*! \param sysdef System definition
+    \param queue_depth Number of frames staged before the oldest one is passed to the callback, 0 passes each frame
+           to the callback in the same call to analyze()
+    \param callback Python callable that takes the time step and a dict of buffers
+*/
+ParticleDataStager::ParticleDataStager(std::shared_ptr<SystemDefinition> sysdef,
+                                       unsigned int queue_depth,
+                                       pybind11::object callback)
+    : Analyzer(sysdef), m_queue_depth(queue_depth), m_callback(callback), m_first(0), m_num_pending(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing ParticleDataStager: " << queue_depth << endl;
+
+    // the slots are never reallocated, so the buffers of a pending frame stay in place
+    m_slots.resize(m_queue_depth + 1);
+    for (auto& slot : m_slots)
+        {
+        slot.N = 0;
+        slot.timestep = 0;
+        }
+
+    #ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        hipStreamCreateWithFlags(&m_stream, hipStreamNonBlocking);
+        hipEventCreateWithFlags(&m_ready_event, hipEventDisableTiming);
+        for (auto& slot : m_slots)
+            hipEventCreateWithFlags(&slot.event, hipEventDisableTiming);
+        }
+    #endif
+    }
+
+ParticleDataStager::~ParticleDataStager()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying ParticleDataStager" << endl;
+
+    #ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        hipStreamSynchronize(m_stream);
+        for (auto& slot : m_slots)
+            hipEventDestroy(slot.event);
+        hipEventDestroy(m_ready_event);
+        hipStreamDestroy(m_stream);
+        }
+    #endif
+    }
+
+/*! \param timestep Current time step of the simulation
+*/
+void ParticleDataStager::analyze(unsigned int timestep)
+    {
+    if (m_prof) m_prof->push("ParticleDataStager");
+
+    Slot& slot = m_slots[(m_first + m_num_pending) % m_slots.size()];
+    stage(slot, timestep);
+    m_num_pending++;
+
+    // there is always a free slot for the next frame
+    while (m_num_pending > m_queue_depth)
+        consume();
+
+    if (m_prof) m_prof->pop();
+    }
+
+void ParticleDataStager::flush()
+    {
+    while (m_num_pending > 0)
+        consume();
+    }
+
+/*! \param slot Slot to copy the data to
+    \param timestep Current time step of the simulation
+*/
+void ParticleDataStager::stage(Slot& slot, unsigned int timestep)
+    {
+    const unsigned int N = m_pdata->getN();
+
+    if (slot.pos.getNumElements() < N || slot.pos.getNumElements() == 0)
+        {
+        // leave room for the number of local particles to fluctuate
+        unsigned int capacity = std::max(1u, (unsigned int)(N * 1.1));
+
+        GlobalArray<Scalar4> pos(capacity, m_exec_conf);
+        slot.pos.swap(pos);
+        TAG_ALLOCATION(slot.pos);
+
+        GlobalArray<Scalar4> vel(capacity, m_exec_conf);
+        slot.vel.swap(vel);
+        TAG_ALLOCATION(slot.vel);
+
+        GlobalArray<int3> image(capacity, m_exec_conf);
+        slot.image.swap(image);
+        TAG_ALLOCATION(slot.image);
+
+        GlobalArray<unsigned int> tag(capacity, m_exec_conf);
+        slot.tag.swap(tag);
+        TAG_ALLOCATION(slot.tag);
+        }
+
+    slot.N = N;
+    slot.timestep = timestep;
+
+    #ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+        ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(), access_location::device, access_mode::read);
+        ArrayHandle<int3> d_image(m_pdata->getImages(), access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
+
+        ArrayHandle<Scalar4> d_slot_pos(slot.pos, access_location::device, access_mode::overwrite);
+        ArrayHandle<Scalar4> d_slot_vel(slot.vel, access_location::device, access_mode::overwrite);
+        ArrayHandle<int3> d_slot_image(slot.image, access_location::device, access_mode::overwrite);
+        ArrayHandle<unsigned int> d_slot_tag(slot.tag, access_location::device, access_mode::overwrite);
+
+        // copy after the kernels that computed the data, and hold back later kernels until the copies are done
+        hipEventRecord(m_ready_event, 0);
+        hipStreamWaitEvent(m_stream, m_ready_event, 0);
+        hipMemcpyAsync(d_slot_pos.data, d_pos.data, sizeof(Scalar4)*N, hipMemcpyDeviceToDevice, m_stream);
+        hipMemcpyAsync(d_slot_vel.data, d_vel.data, sizeof(Scalar4)*N, hipMemcpyDeviceToDevice, m_stream);
+        hipMemcpyAsync(d_slot_image.data, d_image.data, sizeof(int3)*N, hipMemcpyDeviceToDevice, m_stream);
+        hipMemcpyAsync(d_slot_tag.data, d_tag.data, sizeof(unsigned int)*N, hipMemcpyDeviceToDevice, m_stream);
+        hipEventRecord(slot.event, m_stream);
+        hipStreamWaitEvent(0, slot.event, 0);
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+    else
+    #endif
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+        ArrayHandle<Scalar4> h_slot_pos(slot.pos, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_slot_vel(slot.vel, access_location::host, access_mode::overwrite);
+        ArrayHandle<int3> h_slot_image(slot.image, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_slot_tag(slot.tag, access_location::host, access_mode::overwrite);
+
+        std::copy(h_pos.data, h_pos.data + N, h_slot_pos.data);
+        std::copy(h_vel.data, h_vel.data + N, h_slot_vel.data);
+        std::copy(h_image.data, h_image.data + N, h_slot_image.data);
+        std::copy(h_tag.data, h_tag.data + N, h_slot_tag.data);
+        }
+    }
+
+/*! \param slot Slot to expose
+    \param location Location of the data to expose
+
+    The buffers point into the slot, which is not written to again before the callback returns. They use the same
+    layout as the buffers of LocalParticleData.
+*/
+template<class Output>
+pybind11::dict ParticleDataStager::makeBuffers(Slot& slot, const access_location::Enum location)
+    {
+    const ssize_t N = slot.N;
+    ArrayHandle<Scalar4> pos(slot.pos, location, access_mode::read);
+    ArrayHandle<Scalar4> vel(slot.vel, location, access_mode::read);
+    ArrayHandle<int3> image(slot.image, location, access_mode::read);
+    ArrayHandle<unsigned int> tag(slot.tag, location, access_mode::read);
+
+    pybind11::dict buffers;
+    buffers["position"] = Output::make((Scalar*)pos.data,
+                                       std::vector<ssize_t>({N, 3}),
+                                       std::vector<ssize_t>({sizeof(Scalar4), sizeof(Scalar)}),
+                                       true);
+    buffers["typeid"] = Output::make((int*)((char*)pos.data + 3*sizeof(Scalar)),
+                                     std::vector<ssize_t>({N}),
+                                     std::vector<ssize_t>({sizeof(Scalar4)}),
+                                     true);
+    buffers["velocity"] = Output::make((Scalar*)vel.data,
+                                       std::vector<ssize_t>({N, 3}),
+                                       std::vector<ssize_t>({sizeof(Scalar4), sizeof(Scalar)}),
+                                       true);
+    buffers["mass"] = Output::make((Scalar*)((char*)vel.data + 3*sizeof(Scalar)),
+                                   std::vector<ssize_t>({N}),
+                                   std::vector<ssize_t>({sizeof(Scalar4)}),
+                                   true);
+    buffers["image"] = Output::make((int*)image.data,
+                                    std::vector<ssize_t>({N, 3}),
+                                    std::vector<ssize_t>({sizeof(int3), sizeof(int)}),
+                                    true);
+    buffers["tag"] = Output::make(tag.data,
+                                  std::vector<ssize_t>({N}),
+                                  std::vector<ssize_t>({sizeof(unsigned int)}),
+                                  true);
+    return buffers;
+    }
+
+/*! The slot is released before the callback is called, but it is only written to again by a later call to
+    analyze().
+*/
+void ParticleDataStager::consume()
+    {
+    Slot& slot = m_slots[m_first];
+    m_first = (m_first + 1) % (unsigned int)m_slots.size();
+    m_num_pending--;
+
+    pybind11::gil_scoped_acquire acquire;
+    pybind11::dict buffers;
+    #ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        hipEventSynchronize(slot.event);
+        buffers = makeBuffers<HOOMDDeviceBuffer>(slot, access_location::device);
+        }
+    else
+    #endif
+        {
+        buffers = makeBuffers<HOOMDHostBuffer>(slot, access_location::host);
+        }
+
+    m_callback(slot.timestep, buffers);
+    }
+
+void export_ParticleDataStager(py::module& m)
+    {
+    py::class_<ParticleDataStager, Analyzer, std::shared_ptr<ParticleDataStager> >(m, "ParticleDataStager")
+    .def(py::init< std::shared_ptr<SystemDefinition>, unsigned int, pybind11::object >())
+    .def("flush", &ParticleDataStager::flush)
+    .def_property_readonly("queue_depth", &ParticleDataStager::getQueueDepth)
+    .def_property_readonly("num_pending", &ParticleDataStager::getNumPending)
+    ;
+    }
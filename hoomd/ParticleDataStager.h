@@ -0,0 +1,110 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ParticleDataStager.h
+    \brief Declares the ParticleDataStager class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "Analyzer.h"
+#include "GlobalArray.h"
+#include "PythonLocalDataAccess.h"
+
+#include <pybind11/pybind11.h>
+#include <memory>
+#include <vector>
+
+#ifndef __PARTICLE_DATA_STAGER_H__
+#define __PARTICLE_DATA_STAGER_H__
+
+//! Copies the local particle data into staging buffers for in-situ analysis
+/*! Python access to the particle data through LocalDataAccess is limited to a context manager on the simulation
+    thread, and the arrays change as soon as the simulation continues. ParticleDataStager instead copies the positions,
+    velocities, images, and tags of the local particles into one of a fixed number of staging slots each time it
+    triggers, and hands the slot to a Python callback later. The callback receives HOOMDDeviceBuffer objects (GPU
+    execution) or HOOMDHostBuffer objects (CPU execution) that point directly at the staging buffers, so the data
+    is not copied again.
+
+    On the GPU, the copies are issued with hipMemcpyAsync on a separate stream after the preceding kernels complete,
+    and kernels issued afterwards to the default stream wait for the copies, so analyze() does not block the host.
+    The callback for a staged frame runs on a later call to analyze(), after \a queue_depth newer frames have been
+    staged, or in flush() at the end of the run. By then the simulation has continued and the copies are complete.
+    The buffers given to the callback are valid only until it returns.
+
+    In MPI simulations, every rank stages and passes its local particles to the callback.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT ParticleDataStager : public Analyzer
+    {
+    public:
+        //! Constructs the stager
+        ParticleDataStager(std::shared_ptr<SystemDefinition> sysdef,
+                           unsigned int queue_depth,
+                           pybind11::object callback);
+
+        //! Destructor
+        virtual ~ParticleDataStager();
+
+        //! Stage the local particle data and pass completed frames to the callback
+        virtual void analyze(unsigned int timestep);
+
+        //! Pass all staged frames to the callback
+        virtual void flush();
+
+        //! Get the number of frames that may be staged before the oldest is passed to the callback
+        unsigned int getQueueDepth() const
+            {
+            return m_queue_depth;
+            }
+
+        //! Get the number of staged frames not yet passed to the callback
+        unsigned int getNumPending() const
+            {
+            return m_num_pending;
+            }
+
+    private:
+        //! Staged copy of the local particle data
+        struct Slot
+            {
+            GlobalArray<Scalar4> pos;       //!< Positions and types
+            GlobalArray<Scalar4> vel;       //!< Velocities and masses
+            GlobalArray<int3> image;        //!< Images
+            GlobalArray<unsigned int> tag;  //!< Tags
+            unsigned int N;                 //!< Number of staged particles
+            unsigned int timestep;          //!< Time step of the staged frame
+            #ifdef ENABLE_HIP
+            hipEvent_t event;               //!< Recorded when the copies are complete
+            #endif
+            };
+
+        unsigned int m_queue_depth;         //!< Number of frames staged ahead of the callback
+        pybind11::object m_callback;        //!< Python callable taking the time step and a dict of buffers
+        std::vector<Slot> m_slots;          //!< Ring of staging slots, m_queue_depth + 1 of them
+        unsigned int m_first;               //!< Slot of the oldest pending frame
+        unsigned int m_num_pending;         //!< Number of staged frames not yet passed to the callback
+
+        #ifdef ENABLE_HIP
+        hipStream_t m_stream;               //!< Stream for the staging copies
+        hipEvent_t m_ready_event;           //!< Recorded on the default stream before the copies
+        #endif
+
+        //! Copy the local particle data into a slot
+        void stage(Slot& slot, unsigned int timestep);
+
+        //! Pass the oldest pending frame to the callback
+        void consume();
+
+        //! Build the buffers of a slot
+        template<class Output>
+        pybind11::dict makeBuffers(Slot& slot, const access_location::Enum location);
+    };
+
+//! Exports the ParticleDataStager class to python
+void export_ParticleDataStager(pybind11::module& m);
+
+#endif
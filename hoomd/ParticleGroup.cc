@@ -226,6 +226,7 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef,
       m_particles_sorted(true),
       m_reallocated(false),
       m_global_ptl_num_change(false),
+      m_member_tag_map(m_exec_conf),
       m_selector(selector),
       m_update_tags(update_tags),
       m_warning_printed(false)
@@ -264,6 +265,7 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef, const std
       m_particles_sorted(true),
       m_reallocated(false),
       m_global_ptl_num_change(false),
+      m_member_tag_map(m_exec_conf),
       m_update_tags(false),
       m_warning_printed(false)
     {
@@ -312,10 +314,6 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef, const std
     m_is_member.swap(is_member);
     TAG_ALLOCATION(m_is_member);
 
-    GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(), m_pdata->getExecConf());
-    m_is_member_tag.swap(is_member_tag);
-    TAG_ALLOCATION(m_is_member_tag);
-
     // build the reverse lookup table for tags
     buildTagHash();
 
@@ -323,6 +321,10 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef, const std
     m_member_idx.swap(member_idx);
     TAG_ALLOCATION(m_member_idx);
 
+    GlobalArray<unsigned int> member_idx_tag(member_tags.size(), m_pdata->getExecConf());
+    m_member_idx_tag.swap(member_idx_tag);
+    TAG_ALLOCATION(m_member_idx_tag);
+
     #ifdef ENABLE_HIP
     if (m_pdata->getExecConf()->isCUDAEnabled())
         m_gpu_partition = GPUPartition(m_exec_conf->getGPUIds());
@@ -415,6 +417,10 @@ void ParticleGroup::updateMemberTags(bool force_update) const
         GlobalArray<unsigned int> member_idx(member_tags.size(), m_pdata->getExecConf());
         m_member_idx.swap(member_idx);
         TAG_ALLOCATION(m_member_idx);
+
+        GlobalArray<unsigned int> member_idx_tag(member_tags.size(), m_pdata->getExecConf());
+        m_member_idx_tag.swap(member_idx_tag);
+        TAG_ALLOCATION(m_member_idx_tag);
         }
 
     // one byte per particle to indicate membership in the group, initialize with current number of local particles
@@ -422,10 +428,6 @@ void ParticleGroup::updateMemberTags(bool force_update) const
     m_is_member.swap(is_member);
     TAG_ALLOCATION(m_is_member);
 
-    GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(), m_pdata->getExecConf());
-    m_is_member_tag.swap(is_member_tag);
-    TAG_ALLOCATION(m_is_member_tag);
-
     // build the reverse lookup table for tags
     buildTagHash();
 
@@ -437,13 +439,9 @@ void ParticleGroup::reallocate() const
     {
     m_is_member.resize(m_pdata->getMaxN());
 
-    if (m_is_member_tag.getNumElements() != m_pdata->getRTags().size())
+    // the hash set does not depend on the size of the tag space
+    if (!m_use_tag_map && m_is_member_tag.getNumElements() != m_pdata->getRTags().size())
         {
-        // reallocate if necessary
-        GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(), m_exec_conf);
-        m_is_member_tag.swap(is_member_tag);
-        TAG_ALLOCATION(m_is_member_tag);
-
         buildTagHash();
         }
     }
@@ -641,9 +639,38 @@ std::shared_ptr<ParticleGroup> ParticleGroup::groupDifference(std::shared_ptr<Pa
     }
 
 /*! Builds the by-tag-lookup table for group membership
+
+    The dense table has one entry per tag. When the group has few members compared to the largest tag, e.g. a small
+    group in a large system or after many tags were recycled by particle insertion and removal, the member tags are
+    stored in a hash set instead, which needs memory proportional to the number of members.
  */
 void ParticleGroup::buildTagHash() const
     {
+    unsigned int num_tags = (unsigned int)m_pdata->getRTags().size();
+    unsigned int num_member_tags = (unsigned int)m_member_tags.getNumElements();
+
+    // hash lookups are slower, only use them when they save most of the memory
+    m_use_tag_map = TagIndexMap::getMemoryFootprint(num_member_tags)*4 < sizeof(unsigned int)*size_t(num_tags);
+
+    if (m_use_tag_map)
+        {
+        // release the dense table
+        GlobalArray<unsigned int> is_member_tag;
+        m_is_member_tag.swap(is_member_tag);
+
+        ArrayHandle<unsigned int> h_member_tags(m_member_tags, access_location::host, access_mode::read);
+        m_member_tag_map.build(h_member_tags.data, num_member_tags);
+        return;
+        }
+
+    m_member_tag_map.clear();
+    if (m_is_member_tag.getNumElements() != num_tags)
+        {
+        GlobalArray<unsigned int> is_member_tag(num_tags, m_exec_conf);
+        m_is_member_tag.swap(is_member_tag);
+        TAG_ALLOCATION(m_is_member_tag);
+        }
+
     ArrayHandle<unsigned int> h_is_member_tag(m_is_member_tag, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_member_tags(m_member_tags, access_location::host, access_mode::read);
 
@@ -679,18 +706,21 @@ void ParticleGroup::rebuildIndexList() const
         // rebuild the membership flags for the  indices in the group and construct member list
         ArrayHandle<unsigned int> h_is_member(m_is_member, access_location::host, access_mode::readwrite);
         ArrayHandle<unsigned int> h_is_member_tag(m_is_member_tag, access_location::host, access_mode::read);
+        ArrayHandle<uint2> h_tag_map(m_member_tag_map.getTable(), access_location::host, access_mode::read);
         ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
         ArrayHandle<unsigned int> h_member_idx(m_member_idx, access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_member_idx_tag(m_member_idx_tag, access_location::host, access_mode::overwrite);
         unsigned int nparticles = m_pdata->getN();
         unsigned int cur_member = 0;
         for (unsigned int idx = 0; idx < nparticles; idx ++)
             {
             assert(h_tag.data[idx] <= m_pdata->getMaximumTag());
-            unsigned int is_member = h_is_member_tag.data[h_tag.data[idx]];
+            unsigned int is_member = isMemberTag(h_tag.data[idx], h_is_member_tag.data, h_tag_map.data);
             h_is_member.data[idx] =  is_member;
             if (is_member)
                 {
                 h_member_idx.data[cur_member] = idx;
+                h_member_idx_tag.data[cur_member] = h_tag.data[idx];
                 cur_member++;
                 }
             }
@@ -701,6 +731,130 @@ void ParticleGroup::rebuildIndexList() const
 
     // index has been rebuilt
     m_particles_sorted = false;
+    m_particles_remapped = false;
+    m_append_begin = NOT_APPENDED;
+
+    #ifdef ENABLE_HIP
+    if (m_pdata->getExecConf()->isCUDAEnabled())
+        {
+        // Update GPU load balancing info
+        m_gpu_partition.setN(m_num_local_members);
+        }
+    #endif
+    }
+
+/*! Decides whether the index list can be remapped after the sort or has to be rebuilt. Several sorts may happen before
+    the group is accessed again: permutations and removals can follow each other, and appends can follow any of them,
+    but once particles have been appended a later permutation or removal moves them and forces a rebuild.
+
+    On the GPU, only permutations are remapped, since they keep the number of local members and so need no device to
+    host copy of the count.
+*/
+void ParticleGroup::slotParticleSort()
+    {
+    // a rebuild is pending anyway
+    if (m_particles_sorted)
+        return;
+
+    particle_sort::Enum how = m_pdata->getLastParticleSort();
+
+    bool remap_all = how == particle_sort::permutation || how == particle_sort::removal;
+    #ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        remap_all = how == particle_sort::permutation;
+    #endif
+
+    if (remap_all && m_append_begin == NOT_APPENDED)
+        {
+        m_particles_remapped = true;
+        }
+    else if (how == particle_sort::append && !m_exec_conf->isCUDAEnabled())
+        {
+        // later appends come after the particles appended first
+        if (m_append_begin == NOT_APPENDED)
+            m_append_begin = m_pdata->getNParticlesKeptBySort();
+        m_particles_remapped = true;
+        }
+    else
+        {
+        m_particles_sorted = true;
+        m_particles_remapped = false;
+        m_append_begin = NOT_APPENDED;
+        }
+    }
+
+/*! \pre m_member_idx and m_member_idx_tag list the members before the last particle sorts, which only permuted, removed,
+         or appended particles (see slotParticleSort())
+    \post The index list and membership flags are the same as after rebuildIndexList()
+
+    Every member moves to the current index of its tag, members that left the domain are dropped, and only the particles
+    appended since the last update are tested for membership. Sorting the (nearly sorted) indices restores the index
+    order. This touches the members instead of every local particle.
+*/
+void ParticleGroup::remapIndexList() const
+    {
+    m_pdata->getExecConf()->msg->notice(10) << "ParticleGroup: remapping index" << std::endl;
+
+    #ifdef ENABLE_HIP
+    if (m_pdata->getExecConf()->isCUDAEnabled())
+        {
+        remapIndexListGPU();
+        }
+    else
+    #endif
+        {
+        ArrayHandle<unsigned int> h_is_member(m_is_member, access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_is_member_tag(m_is_member_tag, access_location::host, access_mode::read);
+        ArrayHandle<uint2> h_tag_map(m_member_tag_map.getTable(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_member_idx(m_member_idx, access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_member_idx_tag(m_member_idx_tag, access_location::host, access_mode::readwrite);
+        unsigned int nparticles = m_pdata->getN();
+
+        memset(h_is_member.data, 0, sizeof(unsigned int)*nparticles);
+
+        // move the members to their new indices, removed particles have rtag NOT_LOCAL
+        unsigned int cur_member = 0;
+        for (unsigned int i = 0; i < m_num_local_members; i++)
+            {
+            unsigned int idx = h_rtag.data[h_member_idx_tag.data[i]];
+            if (idx < nparticles)
+                {
+                h_member_idx.data[cur_member] = idx;
+                cur_member++;
+                }
+            }
+
+        // test the appended particles
+        if (m_append_begin != NOT_APPENDED)
+            {
+            for (unsigned int idx = m_append_begin; idx < nparticles; idx++)
+                {
+                if (isMemberTag(h_tag.data[idx], h_is_member_tag.data, h_tag_map.data))
+                    {
+                    h_member_idx.data[cur_member] = idx;
+                    cur_member++;
+                    }
+                }
+            }
+
+        assert(cur_member <= m_member_tags.getNumElements());
+        if (!std::is_sorted(h_member_idx.data, h_member_idx.data + cur_member))
+            std::sort(h_member_idx.data, h_member_idx.data + cur_member);
+
+        for (unsigned int i = 0; i < cur_member; i++)
+            {
+            unsigned int idx = h_member_idx.data[i];
+            h_member_idx_tag.data[i] = h_tag.data[idx];
+            h_is_member.data[idx] = 1;
+            }
+
+        m_num_local_members = cur_member;
+        }
+
+    m_particles_remapped = false;
+    m_append_begin = NOT_APPENDED;
 
     #ifdef ENABLE_HIP
     if (m_pdata->getExecConf()->isCUDAEnabled())
@@ -744,6 +898,7 @@ void ParticleGroup::rebuildIndexListGPU() const
     {
     ArrayHandle<unsigned int> d_is_member(m_is_member, access_location::device, access_mode::overwrite);
     ArrayHandle<unsigned int> d_is_member_tag(m_is_member_tag, access_location::device, access_mode::read);
+    ArrayHandle<uint2> d_tag_map(m_member_tag_map.getTable(), access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_member_idx(m_member_idx, access_location::device, access_mode::overwrite);
     ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
 
@@ -754,7 +909,9 @@ void ParticleGroup::rebuildIndexListGPU() const
     if (m_member_tags.getNumElements() > 0)
         {
         gpu_rebuild_index_list(m_pdata->getN(),
-                           d_is_member_tag.data,
+                           m_use_tag_map ? NULL : d_is_member_tag.data,
+                           d_tag_map.data,
+                           m_member_tag_map.getMask(),
                            d_is_member.data,
                            d_tag.data);
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
@@ -768,10 +925,44 @@ void ParticleGroup::rebuildIndexListGPU() const
                            m_pdata->getExecConf()->getCachedAllocator());
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
+
+        // remember the member tags for remapIndexListGPU()
+        ArrayHandle<unsigned int> d_member_idx_tag(m_member_idx_tag, access_location::device, access_mode::overwrite);
+        gpu_gather_member_tags(m_num_local_members,
+                               d_member_idx.data,
+                               d_tag.data,
+                               d_member_idx_tag.data);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
         }
     else
         m_num_local_members = 0;
     }
+
+//! Remap the index list on the GPU after a permutation of the particles
+void ParticleGroup::remapIndexListGPU() const
+    {
+    ArrayHandle<unsigned int> d_is_member(m_is_member, access_location::device, access_mode::readwrite);
+    ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_member_idx(m_member_idx, access_location::device, access_mode::readwrite);
+    ArrayHandle<unsigned int> d_member_idx_tag(m_member_idx_tag, access_location::device, access_mode::readwrite);
+
+    // a permutation keeps the number of local members
+    ScopedAllocation<unsigned int> d_tmp_idx(m_exec_conf->getCachedAllocator(), m_num_local_members);
+    ScopedAllocation<unsigned int> d_tmp_tag(m_exec_conf->getCachedAllocator(), m_num_local_members);
+
+    gpu_remap_index_list(m_pdata->getN(),
+                         m_num_local_members,
+                         d_rtag.data,
+                         d_is_member.data,
+                         d_member_idx.data,
+                         d_member_idx_tag.data,
+                         d_tmp_idx.data,
+                         d_tmp_tag.data,
+                         m_exec_conf->getCachedAllocator());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
 #endif
 
 unsigned int ParticleGroup::intersectionSize(std::shared_ptr<ParticleGroup> other)
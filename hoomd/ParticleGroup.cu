@@ -23,6 +23,8 @@
 __global__ void gpu_rebuild_index_list_kernel(unsigned int N,
                                               unsigned int *d_tag,
                                               unsigned int *d_is_member_tag,
+                                              const uint2 *d_tag_map,
+                                              unsigned int tag_map_mask,
                                               unsigned int *d_is_member)
     {
     unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -31,7 +33,10 @@ __global__ void gpu_rebuild_index_list_kernel(unsigned int N,
 
     unsigned int tag = d_tag[idx];
 
-    d_is_member[idx] = d_is_member_tag[tag];
+    if (d_is_member_tag)
+        d_is_member[idx] = d_is_member_tag[tag];
+    else
+        d_is_member[idx] = tag_index_map_find(d_tag_map, tag_map_mask, tag) != TAG_INDEX_MAP_EMPTY;
     }
 
 __global__ void gpu_scatter_member_indices(unsigned int N,
@@ -49,7 +54,9 @@ __global__ void gpu_scatter_member_indices(unsigned int N,
 
 //! GPU method for rebuilding the index list of a ParticleGroup
 /*! \param N number of local particles
-    \param d_is_member_tag Global lookup table for tag -> group membership
+    \param d_is_member_tag Global lookup table for tag -> group membership, NULL to use \a d_tag_map
+    \param d_tag_map Hash set of the member tags
+    \param tag_map_mask Number of slots of \a d_tag_map minus one
     \param d_is_member Array of membership flags
     \param d_member_idx Array of member indices
     \param d_tag Array of tags
@@ -57,11 +64,13 @@ __global__ void gpu_scatter_member_indices(unsigned int N,
 */
 hipError_t gpu_rebuild_index_list(unsigned int N,
                                    unsigned int *d_is_member_tag,
+                                   const uint2 *d_tag_map,
+                                   unsigned int tag_map_mask,
                                    unsigned int *d_is_member,
                                    unsigned int *d_tag)
     {
     assert(d_is_member);
-    assert(d_is_member_tag);
+    assert(d_is_member_tag || d_tag_map);
     assert(d_tag);
 
     unsigned int block_size = 256;
@@ -71,6 +80,8 @@ hipError_t gpu_rebuild_index_list(unsigned int N,
          N,
          d_tag,
          d_is_member_tag,
+         d_tag_map,
+         tag_map_mask,
          d_is_member);
     return hipSuccess;
     }
@@ -122,3 +133,104 @@ hipError_t gpu_compact_index_list(unsigned int N,
 
     return hipSuccess;
     }
+
+//! GPU kernel to store the tag of every group member
+__global__ void gpu_gather_member_tags_kernel(unsigned int num_local_members,
+                                              const unsigned int *d_member_idx,
+                                              const unsigned int *d_tag,
+                                              unsigned int *d_member_idx_tag)
+    {
+    unsigned int i = blockIdx.x*blockDim.x+threadIdx.x;
+
+    if (i >= num_local_members) return;
+
+    d_member_idx_tag[i] = d_tag[d_member_idx[i]];
+    }
+
+//! GPU kernel to look up the new index of every group member and set its membership flag
+__global__ void gpu_remap_member_indices_kernel(unsigned int num_local_members,
+                                                const unsigned int *d_rtag,
+                                                const unsigned int *d_member_idx_tag,
+                                                unsigned int *d_tmp_idx,
+                                                unsigned int *d_is_member)
+    {
+    unsigned int i = blockIdx.x*blockDim.x+threadIdx.x;
+
+    if (i >= num_local_members) return;
+
+    unsigned int idx = d_rtag[d_member_idx_tag[i]];
+    d_tmp_idx[i] = idx;
+    d_is_member[idx] = 1;
+    }
+
+/*! \param num_local_members Number of members on the local processor
+    \param d_member_idx Array of member indices
+    \param d_tag Array of tags
+    \param d_member_idx_tag Tags of the members (output)
+*/
+hipError_t gpu_gather_member_tags(unsigned int num_local_members,
+                                  const unsigned int *d_member_idx,
+                                  const unsigned int *d_tag,
+                                  unsigned int *d_member_idx_tag)
+    {
+    if (num_local_members == 0)
+        return hipSuccess;
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = num_local_members/block_size + 1;
+
+    hipLaunchKernelGGL(gpu_gather_member_tags_kernel, dim3(n_blocks), dim3(block_size), 0, 0,
+        num_local_members, d_member_idx, d_tag, d_member_idx_tag);
+
+    return hipSuccess;
+    }
+
+/*! \param N number of local particles
+    \param num_local_members Number of members on the local processor, unchanged by the permutation
+    \param d_rtag Reverse lookup table of the particle tags
+    \param d_is_member Array of membership flags (output)
+    \param d_member_idx Array of member indices (output, in index order)
+    \param d_member_idx_tag Tags of the members (input and output, in the order of d_member_idx)
+    \param d_tmp_idx Temporary array of num_local_members elements
+    \param d_tmp_tag Temporary array of num_local_members elements
+    \param alloc Caching allocator for the sort temporaries
+
+    The members are moved to their new indices in one pass, and a radix sort by index restores the index order of
+    d_member_idx. The number of members does not change, so nothing is copied back to the host.
+*/
+hipError_t gpu_remap_index_list(unsigned int N,
+                                unsigned int num_local_members,
+                                const unsigned int *d_rtag,
+                                unsigned int *d_is_member,
+                                unsigned int *d_member_idx,
+                                unsigned int *d_member_idx_tag,
+                                unsigned int *d_tmp_idx,
+                                unsigned int *d_tmp_tag,
+                                CachedAllocator& alloc)
+    {
+    hipMemsetAsync(d_is_member, 0, sizeof(unsigned int)*N);
+
+    if (num_local_members == 0)
+        return hipSuccess;
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = num_local_members/block_size + 1;
+
+    hipLaunchKernelGGL(gpu_remap_member_indices_kernel, dim3(n_blocks), dim3(block_size), 0, 0,
+        num_local_members, d_rtag, d_member_idx_tag, d_tmp_idx, d_is_member);
+
+    // sort the members by index, carrying the tags along
+    void *d_temp_storage = NULL;
+    size_t temp_storage_bytes = 0;
+    hipcub::DeviceRadixSort::SortPairs(d_temp_storage, temp_storage_bytes,
+        d_tmp_idx, d_member_idx, d_member_idx_tag, d_tmp_tag, num_local_members);
+
+    d_temp_storage = alloc.getTemporaryBuffer<char>(temp_storage_bytes);
+    hipcub::DeviceRadixSort::SortPairs(d_temp_storage, temp_storage_bytes,
+        d_tmp_idx, d_member_idx, d_member_idx_tag, d_tmp_tag, num_local_members);
+    alloc.deallocate((char *)d_temp_storage);
+
+    hipMemcpyAsync(d_member_idx_tag, d_tmp_tag, sizeof(unsigned int)*num_local_members, hipMemcpyDeviceToDevice);
+
+    return hipSuccess;
+    }
@@ -4,6 +4,7 @@
 
 // Maintainer: jglaser
 #include "CachedAllocator.h"
+#include "TagIndexMap.h"
 
 /*! \file ParticleGroup.cuh
     \brief Contains GPU kernel code used by ParticleGroup
@@ -14,6 +15,8 @@
 //! GPU method for rebuilding the index list of a ParticleGroup
 hipError_t gpu_rebuild_index_list(unsigned int N,
                                    unsigned int *d_is_member_tag,
+                                   const uint2 *d_tag_map,
+                                   unsigned int tag_map_mask,
                                    unsigned int *d_is_member,
                                    unsigned int *d_tag);
 
@@ -31,4 +34,21 @@ hipError_t gpu_compact_index_list(unsigned int N,
                                    unsigned int &num_local_members,
                                    unsigned int *d_tmp,
                                    CachedAllocator& alloc);
+
+//! GPU method for storing the tags of the group members
+hipError_t gpu_gather_member_tags(unsigned int num_local_members,
+                                  const unsigned int *d_member_idx,
+                                  const unsigned int *d_tag,
+                                  unsigned int *d_member_idx_tag);
+
+//! GPU method for moving the group members to their new indices after a permutation of the particles
+hipError_t gpu_remap_index_list(unsigned int N,
+                                unsigned int num_local_members,
+                                const unsigned int *d_rtag,
+                                unsigned int *d_is_member,
+                                unsigned int *d_member_idx,
+                                unsigned int *d_member_idx_tag,
+                                unsigned int *d_tmp_idx,
+                                unsigned int *d_tmp_tag,
+                                CachedAllocator& alloc);
 #endif
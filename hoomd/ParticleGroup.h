@@ -24,6 +24,7 @@
 #include <pybind11/numpy.h>
 
 #include "GlobalArray.h"
+#include "TagIndexMap.h"
 
 #ifdef ENABLE_HIP
 #include "GPUPartition.cuh"
@@ -130,7 +131,9 @@ class PYBIND11_EXPORT ParticleFilterRigidCenter : public ParticleFilter
     in a sorted tag order. This list can be accessed directly via getMemberTag() to meet the 2nd use case listed above.
     In order to iterate through all particles in the group in a cache-efficient manner, an auxiliary list is stored
     that lists all particle <i>indices</i> that belong to the group. This list must be updated on every particle sort.
-    Thirdly, a dynamic bitset is used to store one bit per particle for efficient O(1) tests if a given particle is in
+    When ParticleData reports that the sort only permuted, removed, or appended particles (see particle_sort), the
+    members are moved to the new index of their tag (kept in a list parallel to the indices) and only appended
+    particles are tested for membership. Other sorts rebuild the list from the tags of all local particles. Thirdly, a dynamic bitset is used to store one bit per particle for efficient O(1) tests if a given particle is in
     the group.
 
     Finally, the common use case on the GPU using groups will include running one thread per particle in the group.
@@ -334,13 +337,18 @@ class PYBIND11_EXPORT ParticleGroup
         // in ParticleGroup in the future by using resize methods on the arrays
         mutable GlobalArray<unsigned int> m_is_member;    //!< One byte per particle, == 1 if index is a local member of the group
         mutable GlobalArray<unsigned int> m_member_idx;    //!< List of all particle indices in the group
+        mutable GlobalArray<unsigned int> m_member_idx_tag; //!< Tags of the particles in m_member_idx
         mutable GlobalArray<unsigned int> m_member_tags;   //!< Lists the tags of the particle members
         mutable unsigned int m_num_local_members;       //!< Number of members on the local processor
         mutable bool m_particles_sorted;                //!< True if particle have been sorted since last rebuild
+        mutable bool m_particles_remapped = false;      //!< True if the index list can be remapped instead of rebuilt
+        mutable unsigned int m_append_begin = NOT_APPENDED; //!< First particle index appended since the last rebuild
         mutable bool m_reallocated;                     //!< True if particle data arrays have been reallocated
         mutable bool m_global_ptl_num_change;           //!< True if the global particle number changed
 
         mutable GlobalArray<unsigned int> m_is_member_tag;  //!< One byte per particle, == 1 if tag is a member of the group
+        mutable TagIndexMap m_member_tag_map;           //!< Hash set of the member tags, replaces m_is_member_tag
+        mutable bool m_use_tag_map = false;             //!< True if membership is looked up in m_member_tag_map
         std::shared_ptr<ParticleFilter> m_selector; //!< The associated particle selector
 
         bool m_update_tags;                             //!< True if tags should be updated when global number of particles changes
@@ -362,6 +370,12 @@ class PYBIND11_EXPORT ParticleGroup
         //! Helper function to rebuild the index lists after the particles have been sorted
         void rebuildIndexList() const;
 
+        //! Helper function to move the members to their new indices after a known rearrangement of the particles
+        void remapIndexList() const;
+
+        //! Value of m_append_begin when no particles were appended
+        static const unsigned int NOT_APPENDED = 0xffffffff;
+
         //! Helper function to rebuild internal arrays
         void checkRebuild() const
             {
@@ -383,6 +397,10 @@ class PYBIND11_EXPORT ParticleGroup
                 rebuildIndexList();
                 m_particles_sorted = false;
                 }
+            else if (m_particles_remapped)
+                {
+                remapIndexList();
+                }
             if (update_gpu_advice)
                 {
                 updateGPUAdvice();
@@ -396,10 +414,7 @@ class PYBIND11_EXPORT ParticleGroup
             }
 
         //! Helper function to be called when the particles are resorted
-        void slotParticleSort()
-            {
-            m_particles_sorted = true;
-            }
+        void slotParticleSort();
 
         //! Update the GPU memory advice
         void updateGPUAdvice() const;
@@ -413,9 +428,21 @@ class PYBIND11_EXPORT ParticleGroup
         //! Helper function to build the 1:1 hash for tag membership
         void buildTagHash() const;
 
+        //! Test if the tag of a particle is a member, with the lookup tables acquired on the host
+        bool isMemberTag(unsigned int tag, const unsigned int *h_is_member_tag, const uint2 *h_tag_map) const
+            {
+            if (m_use_tag_map)
+                return tag_index_map_find(h_tag_map, m_member_tag_map.getMask(), tag) != TAG_INDEX_MAP_EMPTY;
+            else
+                return h_is_member_tag[tag];
+            }
+
 #ifdef ENABLE_HIP
         //! Helper function to rebuild the index lists after the particles have been sorted
         void rebuildIndexListGPU() const;
+
+        //! Helper function to move the members to their new indices after a permutation of the particles
+        void remapIndexListGPU() const;
 #endif
 
     };
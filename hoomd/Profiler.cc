@@ -10,8 +10,10 @@
 
 #include "Profiler.h"
 
+#include <fstream>
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
 
 
 using namespace std;
@@ -69,6 +71,31 @@ int64_t ProfileDataElem::getTotalMemByteCount() const
     return total;
     }
 
+/*! \param timings Dictionary to add the timings to
+    \param path Path of this node, the names of its parents and itself joined by '/'
+
+    Each child adds an entry with its total time in seconds, the number of completed events, the number of bytes
+    copied between the host and the device, and the number of page faults.
+*/
+void ProfileDataElem::getTimings(pybind11::dict& timings, const std::string& path) const
+    {
+    map<string, ProfileDataElem>::const_iterator i;
+    for (i = m_children.begin(); i != m_children.end(); ++i)
+        {
+        std::string child_path = path.empty() ? (*i).first : path + "/" + (*i).first;
+        const ProfileDataElem& child = (*i).second;
+
+        pybind11::dict entry;
+        entry["time"] = double(child.m_elapsed_time)/1e9;
+        entry["calls"] = child.m_call_count;
+        entry["transferred_bytes"] = child.m_transferred_bytes;
+        entry["page_faults"] = child.m_page_faults;
+        timings[child_path.c_str()] = entry;
+
+        child.getTimings(timings, child_path);
+        }
+    }
+
 /*! Recursive output routine to write results from this profile node and all sub nodes printed in
     a tree.
     \param o stream to write output to
@@ -191,7 +218,7 @@ void ProfileDataElem::output_line(std::ostream &o,
 ////////////////////////////////////////////////////////////////////
 // Profiler
 
-Profiler::Profiler(const std::string& name) : m_name(name)
+Profiler::Profiler(const std::string& name) : m_name(name), m_sync(true)
     {
     // push the root onto the top of the stack so that it is the default
     m_stack.push(&m_root);
@@ -223,6 +250,64 @@ void Profiler::output(std::ostream &o)
     m_root.output(o, m_name, 0, m_root.m_elapsed_time, (int)m_name.size());
     }
 
+/*! \returns A dictionary that maps the path of every element to its totals, see ProfileDataElem::getTimings()
+*/
+pybind11::dict Profiler::getTimings() const
+    {
+    pybind11::dict timings;
+    m_root.getTimings(timings, "");
+    return timings;
+    }
+
+//! Escape a string for output in a JSON document
+static std::string escape_json(const std::string& str)
+    {
+    std::ostringstream o;
+    for (char c : str)
+        {
+        if (c == '"' || c == '\\')
+            o << '\\' << c;
+        else if ((unsigned char)c < 0x20)
+            o << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec;
+        else
+            o << c;
+        }
+    return o.str();
+    }
+
+/*! \param filename Name of the file to write
+    \param pid Process id to label the events with (the MPI rank)
+
+    Writes a metadata event that names the process "rank <pid>" and one complete ("X") event per recorded push/pop
+    pair. Times are in microseconds since the profiler was constructed. System constructs the profilers of all ranks
+    right after a barrier, so the times of the ranks line up and their events can be merged into one timeline.
+*/
+void Profiler::writeTrace(const std::string& filename, unsigned int pid) const
+    {
+    std::ofstream f(filename.c_str());
+    if (!f.good())
+        throw runtime_error("Unable to open trace file " + filename);
+
+    f << "{\"traceEvents\": [" << endl;
+    f << setprecision(3) << setiosflags(ios::fixed);
+    f << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << pid << ", \"args\": {\"name\": \"rank " << pid
+      << "\"}}";
+    if (m_events.size() > 0)
+        f << ",";
+    f << endl;
+    for (size_t i = 0; i < m_events.size(); i++)
+        {
+        const ProfileEvent& event = m_events[i];
+        f << "{\"name\": \"" << escape_json(event.name) << "\", \"ph\": \"X\", \"pid\": " << pid
+          << ", \"tid\": 0, \"ts\": " << double(event.start_time - m_root.m_start_time)/1e3
+          << ", \"dur\": " << double(event.duration)/1e3 << "}";
+        if (i + 1 < m_events.size())
+            f << ",";
+        f << endl;
+        }
+    f << "], \"displayTimeUnit\": \"ms\"}" << endl;
+    }
+
 /*! \param o Stream to output to
     \param prof Profiler to print
 */
@@ -247,8 +332,10 @@ string print_profiler(Profiler *prof)
 
 void export_Profiler(py::module& m)
     {
-    py::class_<Profiler>(m,"Profiler")
+    py::class_<Profiler, std::shared_ptr<Profiler> >(m,"Profiler")
     .def(py::init<const std::string&>())
     .def("__str__", &print_profiler)
+    .def("getTimings", &Profiler::getTimings)
+    .def("writeTrace", &Profiler::writeTrace)
     ;
     }
@@ -14,6 +14,7 @@
 
 #include "ExecutionConfiguration.h"
 #include "ClockSource.h"
+#include "HostMemory.h"
 
 #ifdef ENABLE_HIP
 #include <hip/hip_runtime.h>
@@ -23,9 +24,14 @@
 #include <nvToolsExt.h>
 #endif
 
+#if defined(ENABLE_ROCTRACER) && defined(__HIP_PLATFORM_HCC__)
+#include <roctracer/roctx.h>
+#endif
+
 #include <string>
 #include <stack>
 #include <map>
+#include <vector>
 #include <iostream>
 #include <cassert>
 
@@ -63,7 +69,9 @@ class PYBIND11_EXPORT ProfileDataElem
     {
     public:
         //! Constructs an element with zeroed counters
-        ProfileDataElem() : m_start_time(0), m_elapsed_time(0), m_flop_count(0), m_mem_byte_count(0)
+        ProfileDataElem() : m_start_time(0), m_elapsed_time(0), m_flop_count(0), m_mem_byte_count(0),
+            m_call_count(0), m_start_transferred_bytes(0), m_transferred_bytes(0), m_start_page_faults(0),
+            m_page_faults(0)
             #ifdef SCOREP_USER_ENABLE
             , m_scorep_region(SCOREP_USER_INVALID_REGION)
             #endif
@@ -76,6 +84,9 @@ class PYBIND11_EXPORT ProfileDataElem
         //! Returns the total memory byte count of this node + children
         int64_t getTotalMemByteCount() const;
 
+        //! Add the timings of this node and all sub nodes to a dictionary
+        void getTimings(pybind11::dict& timings, const std::string& path) const;
+
         //! Output helper function
         void output(std::ostream &o, const std::string &name, int tab_level, int64_t total_time, int name_width) const;
         //! Another output helper function
@@ -93,6 +104,11 @@ class PYBIND11_EXPORT ProfileDataElem
         int64_t m_elapsed_time; //!< A running total of elapsed running time
         int64_t m_flop_count;   //!< A running total of floating point operations
         int64_t m_mem_byte_count;   //!< A running total of memory bytes transferred
+        int64_t m_call_count;   //!< Number of completed timed events
+        uint64_t m_start_transferred_bytes; //!< Host/device transfer counter at the start of the most recent event
+        uint64_t m_transferred_bytes;   //!< A running total of bytes copied between the host and the device
+        uint64_t m_start_page_faults;   //!< Page fault counter of the process at the start of the most recent event
+        uint64_t m_page_faults;         //!< A running total of page faults of the process
 
         #ifdef SCOREP_USER_ENABLE
         SCOREP_User_RegionHandle m_scorep_region;   //!< ScoreP region identifier
@@ -101,6 +117,14 @@ class PYBIND11_EXPORT ProfileDataElem
 
 
 
+//! A timed event recorded for trace output
+struct ProfileEvent
+    {
+    std::string name;       //!< Name of the profile element
+    int64_t start_time;     //!< Start time (in ns)
+    int64_t duration;       //!< Elapsed time (in ns)
+    };
+
 //! A class for doing coarse-level profiling of code
 /*! Stores and organizes a tree of profiles that can be created with a simple push/pop
     type interface. Any number of root profiles can be created via the default constructor
@@ -115,9 +139,16 @@ class PYBIND11_EXPORT ProfileDataElem
 
     There are versions of push() and pop() that take in a reference to an ExecutionConfiguration.
     These methods automatically synchronize with the asynchronous GPU execution stream in order
-    to provide accurate timing information.
+    to provide accurate timing information. setSync(false) turns the synchronization off, so that the NVTX or roctx
+    ranges show the asynchronous overlap of CPU and GPU work in Nsight Systems or rocprof at little cost. The
+    recorded times then only measure the CPU side of GPU work.
+
+    These profiles can of course be output via normal ostream operators. getTimings() returns the totals by path
+    for logging, and writeTrace() writes every recorded event in the Chrome trace event format, which chrome://tracing
+    and Perfetto display as a timeline. The profiler records at most getMaxEvents() events.
 
-    These profiles can of course be output via normal ostream operators.
+    The ExecutionConfiguration versions of push() and pop() also count the bytes that GPUArray copies between the
+    host and the device and the page faults of the process while the element is on the stack.
     \ingroup utils
     */
 class PYBIND11_EXPORT Profiler
@@ -135,11 +166,38 @@ class PYBIND11_EXPORT Profiler
         //! Pops back up to the next super-category & syncs the GPUs
         void pop(std::shared_ptr<const ExecutionConfiguration> exec_conf, uint64_t flop_count = 0, uint64_t byte_count = 0);
 
+        //! Get the totals of all elements, keyed by path
+        pybind11::dict getTimings() const;
+
+        //! Write the recorded events in the Chrome trace event format
+        void writeTrace(const std::string& filename, unsigned int pid) const;
+
+        //! Set whether the ExecutionConfiguration versions of push() and pop() synchronize the GPUs
+        void setSync(bool sync)
+            {
+            m_sync = sync;
+            }
+
+        //! Get whether the ExecutionConfiguration versions of push() and pop() synchronize the GPUs
+        bool getSync() const
+            {
+            return m_sync;
+            }
+
+        //! Get the maximum number of events recorded for trace output
+        static size_t getMaxEvents()
+            {
+            return 1 << 20;
+            }
+
     private:
         ClockSource m_clk;  //!< Clock to provide timing information
         std::string m_name; //!< The name of this profile
         ProfileDataElem m_root; //!< The root profile element
         std::stack<ProfileDataElem *> m_stack;  //!< A stack of data elements for the push/pop structure
+        std::stack<std::string> m_name_stack;   //!< Names of the elements on m_stack
+        std::vector<ProfileEvent> m_events;     //!< Recorded events for trace output
+        bool m_sync;                            //!< True to synchronize the GPUs in push() and pop()
 
         //! Output helper function
         void output(std::ostream &o);
@@ -163,26 +221,31 @@ PYBIND11_EXPORT std::ostream& operator<<(std::ostream &o, Profiler& prof);
 inline void Profiler::push(std::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string& name)
     {
 #if defined(ENABLE_HIP)
-    // nvtools profiling disables synchronization so that async CPU/GPU overlap can be seen
-    if(exec_conf->isCUDAEnabled())
+    // disabling synchronization lets the nvtools ranges show the async CPU/GPU overlap
+    if(m_sync && exec_conf->isCUDAEnabled())
         {
         exec_conf->multiGPUBarrier();
         hipDeviceSynchronize();
         }
 #endif
     push(name);
+    m_stack.top()->m_start_transferred_bytes = exec_conf->getTransferredBytes();
+    m_stack.top()->m_start_page_faults = hoomd::detail::host_memory_page_faults();
    }
 
 inline void Profiler::pop(std::shared_ptr<const ExecutionConfiguration> exec_conf, uint64_t flop_count, uint64_t byte_count)
     {
 #if defined(ENABLE_HIP)
-    // nvtools profiling disables synchronization so that async CPU/GPU overlap can be seen
-    if(exec_conf->isCUDAEnabled())
+    // disabling synchronization lets the nvtools ranges show the async CPU/GPU overlap
+    if(m_sync && exec_conf->isCUDAEnabled())
         {
         exec_conf->multiGPUBarrier();
         hipDeviceSynchronize();
         }
 #endif
+    ProfileDataElem *cur = m_stack.top();
+    cur->m_transferred_bytes += exec_conf->getTransferredBytes() - cur->m_start_transferred_bytes;
+    cur->m_page_faults += hoomd::detail::host_memory_page_faults() - cur->m_start_page_faults;
     pop(flop_count, byte_count);
     }
 
@@ -195,6 +258,10 @@ inline void Profiler::push(const std::string& name)
     nvtxRangePush(name.c_str());
     #endif
 
+    #if defined(ENABLE_ROCTRACER) && defined(__HIP_PLATFORM_HCC__)
+    roctxRangePush(name.c_str());
+    #endif
+
     // pushing a new record on to the stack involves taking a time sample
     int64_t t = m_clk.getTime();
 
@@ -205,6 +272,7 @@ inline void Profiler::push(const std::string& name)
 
     // and updating the stack
     m_stack.push(&cur->m_children[name]);
+    m_name_stack.push(name);
 
     #ifdef SCOREP_USER_ENABLE
     // log Score-P region
@@ -222,6 +290,10 @@ inline void Profiler::pop(uint64_t flop_count, uint64_t byte_count)
     nvtxRangePop();
     #endif
 
+    #if defined(ENABLE_ROCTRACER) && defined(__HIP_PLATFORM_HCC__)
+    roctxRangePop();
+    #endif
+
     // popping up a level in the profile stack involves taking a time sample
     int64_t t = m_clk.getTime();
 
@@ -235,9 +307,21 @@ inline void Profiler::pop(uint64_t flop_count, uint64_t byte_count)
     // and increasing the flop and mem counters
     cur->m_flop_count += flop_count;
     cur->m_mem_byte_count += byte_count;
+    cur->m_call_count++;
+
+    // record the event for trace output
+    if (m_events.size() < getMaxEvents())
+        {
+        ProfileEvent event;
+        event.name = m_name_stack.top();
+        event.start_time = cur->m_start_time;
+        event.duration = t - cur->m_start_time;
+        m_events.push_back(event);
+        }
 
     // and finally popping the stack so that the next pop will access the correct element
     m_stack.pop();
+    m_name_stack.pop();
     }
 
 #endif
@@ -11,23 +11,40 @@ PythonAnalyzer::PythonAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
 
 void PythonAnalyzer::analyze(unsigned int timestep)
     {
+    pybind11::gil_scoped_acquire acquire;
     m_analyzer.attr("act")(timestep);
     }
 
 void PythonAnalyzer::setAnalyzer(pybind11::object analyzer)
     {
     m_analyzer = analyzer;
+    }
+
+/*! The flags are read from the action each time, because actions that log quantities request the flags of their
+    logger, which may change between runs. System only asks on the steps the analyzer triggers.
+*/
+PDataFlags PythonAnalyzer::getRequestedPDataFlags()
+    {
+    pybind11::gil_scoped_acquire acquire;
     auto flags = PDataFlags();
-    for (auto flag: analyzer.attr("flags"))
+    for (auto flag: m_analyzer.attr("flags"))
         {
         flags.set(flag.cast<size_t>());
         }
-    m_flags = flags;
+    return flags;
     }
 
-PDataFlags PythonAnalyzer::getRequestedPDataFlags()
+/*! Like the flags, the arrays are read from the action each time it triggers.
+*/
+HostArrays PythonAnalyzer::getRequestedHostArrays()
     {
-    return m_flags;
+    pybind11::gil_scoped_acquire acquire;
+    auto arrays = HostArrays();
+    for (auto array: m_analyzer.attr("host_arrays"))
+        {
+        arrays.set(array.cast<size_t>());
+        }
+    return arrays;
     }
 
 void export_PythonAnalyzer(pybind11::module& m)
@@ -12,13 +12,14 @@ class PYBIND11_EXPORT PythonAnalyzer : public Analyzer
 
         PDataFlags getRequestedPDataFlags();
 
+        HostArrays getRequestedHostArrays();
+
         void setAnalyzer(pybind11::object analyzer);
 
         pybind11::object getAnalyzer() {return m_analyzer;}
 
     protected:
         pybind11::object m_analyzer;
-        PDataFlags m_flags;
 };
 
 void export_PythonAnalyzer(pybind11::module& m);
@@ -2,9 +2,12 @@
 #define __PYTHON_LOCAL_DATA_ACCESS_H__
 
 #include "GlobalArray.h"
+#include <cstring>
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 
@@ -170,6 +173,12 @@ enum class GhostDataFlag
  *  This class stores ArrayHandles using a unique pointer to prevent a resource
  *  from being dropped before the object is destroyed. This can be simplified if
  *  a move constructor for ArrayHandle is created.
+ *
+ *  selectRows restricts the standard (non-ghost) buffers to a range of rows.
+ *  When a host buffer is requested from a GPU simulation, only the selected
+ *  rows are copied from the device instead of migrating the whole array to the
+ *  host. These copies are written back to the device on exit, and only if
+ *  their contents changed.
  */
 template <class Output, class Data>
 class LocalDataAccess
@@ -192,9 +201,24 @@ class LocalDataAccess
         void exit()
             {
             clear();
+            writeBackRows();
             m_in_manager = false;
             }
 
+        /// Restrict the standard buffers created next to rows [first, last)
+        void selectRows(unsigned int first, unsigned int last)
+            {
+            m_first_row = first;
+            m_last_row = last;
+            m_rows_selected = true;
+            }
+
+        /// Let the standard buffers created next cover all local rows
+        void selectAllRows()
+            {
+            m_rows_selected = false;
+            }
+
     protected:
         /// Convert Global/GPUArray or vector into an Ouput object for Python
         /** This function is for arrays that are of a size less than or equal to
@@ -238,12 +262,25 @@ class LocalDataAccess
 
             bool read_only = flag != GhostDataFlag::standard;
 
-            updateHandle(handle, get_array_func, read_only);
-
             auto N = m_data.getN();
             auto ghostN = m_data.getNGhosts();
             auto size = N;
-            T* _data = handle.get()->data;
+            T* _data;
+
+            if (flag == GhostDataFlag::standard && m_rows_selected)
+                {
+                if (m_first_row > m_last_row || m_last_row > N)
+                    {
+                    throw std::runtime_error("Row range is out of bounds.");
+                    }
+                _data = getRows(handle, get_array_func);
+                size = m_last_row - m_first_row;
+                }
+            else
+                {
+                updateHandle(handle, get_array_func, read_only);
+                _data = handle.get()->data;
+                }
 
             if (flag == GhostDataFlag::both)
                 {
@@ -337,10 +374,114 @@ class LocalDataAccess
                 }
             }
 
+        /// Host copy of the selected rows of an array
+        struct StagedRowsBase
+            {
+            virtual ~StagedRowsBase() = default;
+
+            /// Copy the rows back to the device if they changed
+            virtual void writeBack() = 0;
+
+            const void* m_array;
+            unsigned int m_first;
+            unsigned int m_last;
+            };
+
+        template<class T, template<class> class U>
+        struct StagedRows : public StagedRowsBase
+            {
+            std::vector<T> m_rows;
+            std::vector<T> m_original;
+            Data* m_data;
+            const U<T>& (Data::*m_get_array_func)() const;
+
+            void writeBack()
+                {
+                #ifdef ENABLE_HIP
+                size_t bytes = sizeof(T) * m_rows.size();
+                if (bytes == 0 || memcmp(m_rows.data(), m_original.data(), bytes) == 0)
+                    {
+                    return;
+                    }
+                ArrayHandle<T> d_array((m_data->*m_get_array_func)(),
+                                       access_location::device,
+                                       access_mode::readwrite);
+                hipMemcpy(d_array.data + this->m_first, m_rows.data(), bytes,
+                          hipMemcpyHostToDevice);
+                #endif
+                }
+            };
+
+        /// Get a pointer to the selected rows of an array
+        /** Copies only the selected rows when the whole array would otherwise
+         *  migrate from the device to the host. Buffers of the same array and
+         *  rows, such as positions and types, share one copy.
+         */
+        template<class T, template<class> class U>
+        T* getRows(std::unique_ptr<ArrayHandle<T> >& handle,
+                   const U<T>& (Data::*get_array_func)() const)
+            {
+            #ifdef ENABLE_HIP
+            if (!handle && Output::device == access_location::host
+                && m_data.getExecConf()->isCUDAEnabled())
+                {
+                const U<T>& array = (m_data.*get_array_func)();
+                for (auto& staged : m_staged_rows)
+                    {
+                    if (staged->m_array == &array && staged->m_first == m_first_row
+                        && staged->m_last == m_last_row)
+                        {
+                        return static_cast<StagedRows<T, U>*>(staged.get())->m_rows.data();
+                        }
+                    }
+
+                std::unique_ptr<StagedRows<T, U> > staged(new StagedRows<T, U>());
+                staged->m_array = &array;
+                staged->m_first = m_first_row;
+                staged->m_last = m_last_row;
+                staged->m_data = &m_data;
+                staged->m_get_array_func = get_array_func;
+                staged->m_rows.resize(m_last_row - m_first_row);
+                if (staged->m_rows.size() > 0)
+                    {
+                    ArrayHandle<T> d_array(array, access_location::device, access_mode::read);
+                    hipMemcpy(staged->m_rows.data(), d_array.data + m_first_row,
+                              sizeof(T) * staged->m_rows.size(), hipMemcpyDeviceToHost);
+                    }
+                staged->m_original = staged->m_rows;
+
+                T* rows = staged->m_rows.data();
+                m_staged_rows.push_back(std::move(staged));
+                return rows;
+                }
+            #endif
+
+            updateHandle(handle, get_array_func, false);
+            return handle.get()->data + m_first_row;
+            }
+
+        /// Write the modified row copies back and release them
+        void writeBackRows()
+            {
+            for (auto& staged : m_staged_rows)
+                {
+                staged->writeBack();
+                }
+            m_staged_rows.clear();
+            }
+
         /// object to access array data from
         Data& m_data;
         /// flag for being inside Python context manager
         bool m_in_manager;
+        /// flag for restricting the standard buffers to the selected rows
+        bool m_rows_selected = false;
+        /// first selected row
+        unsigned int m_first_row = 0;
+        /// one past the last selected row
+        unsigned int m_last_row = 0;
+        /// host copies of selected rows of device arrays
+        std::vector<std::unique_ptr<StagedRowsBase> > m_staged_rows;
     };
 
 void export_HOOMDHostBuffer(pybind11::module &m);
@@ -12,6 +12,7 @@ PythonTuner::PythonTuner(std::shared_ptr<SystemDefinition> sysdef,
 
 void PythonTuner::update(unsigned int timestep)
     {
+    pybind11::gil_scoped_acquire acquire;
     m_tuner.attr("act")(timestep);
     }
 
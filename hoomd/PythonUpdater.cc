@@ -11,6 +11,7 @@ PythonUpdater::PythonUpdater(std::shared_ptr<SystemDefinition> sysdef,
 
 void PythonUpdater::update(unsigned int timestep)
     {
+    pybind11::gil_scoped_acquire acquire;
     m_updater.attr("act")(timestep);
     }
 
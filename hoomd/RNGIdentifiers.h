@@ -30,6 +30,7 @@ struct RNGIdentifier
     static const uint32_t HPMCDepletants = 0x6b71abc8;
     static const uint32_t HPMCDepletantNum = 0x89effeba;
     static const uint32_t HPMCMonoAccept = 0xbfabfabf;
+    static const uint32_t HPMCMonoCheckerboard = 0x3c7e90d1;
     static const uint32_t UpdaterBoxMC= 0xf6a510ab;
     static const uint32_t UpdaterClusters =  0x09365bf5;
     static const uint32_t UpdaterClustersPairwise = 0x50060112;
@@ -57,7 +58,10 @@ struct RNGIdentifier
     static const uint32_t SRDCollisionMethod = 0x7b61fda0;
     static const uint32_t SlitGeometryFiller = 0xdb68c12c;
     static const uint32_t SlitPoreGeometryFiller = 0xc7af9094;
+    static const uint32_t VirtualParticleFiller = 0x3e2c97d5;
     static const uint32_t UpdaterQuickCompress = 0x00981234;
+    static const uint32_t UpdaterReplicaExchange = 0x6c3f29e1;
+    static const uint32_t DistributedRandomInitializer = 0x2d9f6c41;
     static const uint32_t ParticleGroupThermalize = 1;
     };
 
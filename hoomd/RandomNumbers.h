@@ -601,6 +601,142 @@ class PoissonDistribution
           }
     };
 
+#ifndef __HIPCC__
+//! Philox random number generator for several streams at once
+/*! RandomGeneratorBatch evaluates W streams of RandomGenerator that share the seeds, counter2, and counter3 and
+    differ in counter1 (i.e. the particle tag). Each call advances all streams by one step and produces exactly the
+    values that W separate RandomGenerator instances would. The Philox rounds are computed on lanes stored as arrays,
+    so the compiler evaluates them with SIMD instructions.
+
+    Methods that update a block of particles draw the values of step k for all particles with one call, instead of
+    constructing one generator per particle. The convenience methods reproduce bit for bit the values of
+    UniformDistribution and NormalDistribution (with unit sigma and zero mu) drawn from the corresponding stream.
+*/
+template<unsigned int W = 8>
+class RandomGeneratorBatch
+    {
+    public:
+        //! Number of streams
+        static const unsigned int width = W;
+
+        //! Constructor
+        /*! \param seed1 First seed
+            \param seed2 Second seed
+            \param counter1 First counter of each stream (W values, unused streams may hold any value)
+            \param counter2 Second counter
+            \param counter3 Third counter
+        */
+        RandomGeneratorBatch(uint32_t seed1,
+                             uint32_t seed2,
+                             const uint32_t *counter1,
+                             uint32_t counter2=0,
+                             uint32_t counter3=0)
+            : m_step(0)
+            {
+            m_key[0] = seed1;
+            m_key[1] = seed2;
+            m_counter2 = counter2;
+            m_counter3 = counter3;
+            for (unsigned int l = 0; l < W; l++)
+                m_counter1[l] = counter1[l];
+            }
+
+        //! Generate uniformly distributed 32-bit values
+        /*! \param u [out] Element i of the Philox output of each stream
+
+            \post The state of the generator is advanced one step.
+        */
+        inline void operator()(uint32_t (&u)[4][W])
+            {
+            uint32_t x0[W], x1[W], x2[W], x3[W];
+            for (unsigned int l = 0; l < W; l++)
+                {
+                x0[l] = m_step;
+                x1[l] = m_counter3;
+                x2[l] = m_counter2;
+                x3[l] = m_counter1[l];
+                }
+
+            // Philox4x32 with 10 rounds, as in random123
+            uint32_t k0 = m_key[0], k1 = m_key[1];
+            for (unsigned int round = 0; round < 10; round++)
+                {
+                if (round > 0)
+                    {
+                    k0 += 0x9E3779B9;
+                    k1 += 0xBB67AE85;
+                    }
+
+                for (unsigned int l = 0; l < W; l++)
+                    {
+                    uint64_t p0 = uint64_t(0xD2511F53) * x0[l];
+                    uint64_t p1 = uint64_t(0xCD9E8D57) * x2[l];
+                    uint32_t y0 = uint32_t(p1 >> 32) ^ x1[l] ^ k0;
+                    uint32_t y2 = uint32_t(p0 >> 32) ^ x3[l] ^ k1;
+                    x0[l] = y0;
+                    x1[l] = uint32_t(p1);
+                    x2[l] = y2;
+                    x3[l] = uint32_t(p0);
+                    }
+                }
+
+            for (unsigned int l = 0; l < W; l++)
+                {
+                u[0][l] = x0[l];
+                u[1][l] = x1[l];
+                u[2][l] = x2[l];
+                u[3][l] = x3[l];
+                }
+            m_step++;
+            }
+
+        //! Draw one uniform random value in [a,b] for each stream
+        /*! \param a Left end point of the interval
+            \param b Right end point of the interval
+            \param out [out] W values, equal to UniformDistribution<Real>(a, b) drawn from each stream
+        */
+        template<typename Real>
+        inline void uniform(Real a, Real b, Real *out)
+            {
+            uint32_t u[4][W];
+            (*this)(u);
+            const Real interval = b - a;
+            for (unsigned int l = 0; l < W; l++)
+                out[l] = a + interval * r123::u01<Real>(uint64_t(u[0][l]) << 32 | u[1][l]);
+            }
+
+        //! Draw one normally distributed value with unit standard deviation and zero mean for each stream
+        /*! \param out [out] W values, equal to NormalDistribution<Real>() drawn from each stream
+
+            Multiplying the values by sigma reproduces NormalDistribution<Real>(sigma).
+        */
+        template<typename Real>
+        inline void normal(Real *out)
+            {
+            uint32_t u[4][W];
+            (*this)(u);
+            for (unsigned int l = 0; l < W; l++)
+                {
+                uint64_t u0 = uint64_t(u[0][l]) << 32 | u[1][l];
+                uint64_t u1 = uint64_t(u[2][l]) << 32 | u[3][l];
+
+                // from random123/examples/boxmuller.hpp
+                Real x, y;
+                fast::sincospi(r123::uneg11<Real>(u0), x, y);
+                Real r = fast::sqrt(Real(-2.0) * fast::log(r123::u01<Real>(u1))); // u01 is guaranteed to avoid 0.
+                out[l] = x * r;
+                }
+            }
+
+    private:
+        uint32_t m_key[2];          //!< RNG key
+        uint32_t m_counter1[W];     //!< First counter of each stream
+        uint32_t m_counter2;        //!< Second counter
+        uint32_t m_counter3;        //!< Third counter
+        uint32_t m_step;            //!< Position in the streams
+    };
+#endif
+
 } // end namespace hoomd
 #undef DEVICE
 #endif // #define HOOMD_RANDOM_NUMBERS_H_
@@ -0,0 +1,105 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __SFC_ORDER_H__
+#define __SFC_ORDER_H__
+
+/*! \file SFCOrder.h
+    \brief Defines the particle orderings of SFCPackTuner and the bin keys that implement them
+    \details The functions are used on the host by SFCPackTuner and on the device by SFCPackTunerGPU, so that both
+    produce the same order.
+*/
+
+#include "HOOMDMath.h"
+#include "Index1D.h"
+
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+//! Orderings of the particles implemented by SFCPackTuner
+struct sfc_order
+    {
+    //! The enum
+    enum Enum
+        {
+        hilbert=0,  //!< Hilbert curve through the grid in 3D, row major grid order in 2D
+        morton,     //!< Z-order (Morton) curve through the grid
+        cell        //!< Order of the cells in a CellList, x fastest
+        };
+    };
+
+//! Largest grid dimension of the Morton key in 3D (3x10 bits)
+const unsigned int SFC_MORTON_MAX_GRID_3D = 1024;
+
+//! Largest grid dimension of the Morton key in 2D (2x16 bits)
+const unsigned int SFC_MORTON_MAX_GRID_2D = 65536;
+
+//! Find the bin of a particle in a grid
+/*! \param f Fractional coordinates of the particle
+    \param dim Number of bins along each direction
+    \returns The bin, clamped to the grid when the particle is slightly outside
+*/
+HOSTDEVICE inline uint3 sfc_bin(const Scalar3& f, const uint3& dim)
+    {
+    int ib = (int)(f.x * dim.x);
+    int jb = (int)(f.y * dim.y);
+    int kb = (int)(f.z * dim.z);
+
+    // if the particle is slightly outside, move back into grid
+    ib = (ib < 0) ? 0 : ((ib >= (int)dim.x) ? (int)dim.x - 1 : ib);
+    jb = (jb < 0) ? 0 : ((jb >= (int)dim.y) ? (int)dim.y - 1 : jb);
+    kb = (kb < 0) ? 0 : ((kb >= (int)dim.z) ? (int)dim.z - 1 : kb);
+
+    return make_uint3(ib, jb, kb);
+    }
+
+//! Insert two zero bits between each of the lower 10 bits of \a v
+HOSTDEVICE inline unsigned int sfc_spread_bits_3d(unsigned int v)
+    {
+    v &= 0x3ff;
+    v = (v | (v << 16)) & 0x030000ff;
+    v = (v | (v << 8)) & 0x0300f00f;
+    v = (v | (v << 4)) & 0x030c30c3;
+    v = (v | (v << 2)) & 0x09249249;
+    return v;
+    }
+
+//! Insert one zero bit between each of the lower 16 bits of \a v
+HOSTDEVICE inline unsigned int sfc_spread_bits_2d(unsigned int v)
+    {
+    v &= 0xffff;
+    v = (v | (v << 8)) & 0x00ff00ff;
+    v = (v | (v << 4)) & 0x0f0f0f0f;
+    v = (v | (v << 2)) & 0x33333333;
+    v = (v | (v << 1)) & 0x55555555;
+    return v;
+    }
+
+//! Compute the Morton key of a bin
+/*! \param bin Bin in the grid
+    \param twod True in 2D simulations, where the z bin is ignored
+    \returns The bits of the bin indices interleaved, x most significant
+*/
+HOSTDEVICE inline unsigned int sfc_morton_key(const uint3& bin, bool twod)
+    {
+    if (twod)
+        return (sfc_spread_bits_2d(bin.x) << 1) | sfc_spread_bits_2d(bin.y);
+    else
+        return (sfc_spread_bits_3d(bin.x) << 2) | (sfc_spread_bits_3d(bin.y) << 1) | sfc_spread_bits_3d(bin.z);
+    }
+
+//! Count the bits needed to represent all keys up to \a max_key, at least one
+inline unsigned int sfc_key_bits(unsigned int max_key)
+    {
+    unsigned int bits = 1;
+    while (bits < 32 && (max_key >> bits) != 0)
+        bits++;
+    return bits;
+    }
+
+#undef HOSTDEVICE
+#endif // __SFC_ORDER_H__
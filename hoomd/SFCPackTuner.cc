@@ -24,7 +24,8 @@ namespace py = pybind11;
  */
 SFCPackTuner::SFCPackTuner(std::shared_ptr<SystemDefinition> sysdef,
                            std::shared_ptr<Trigger> trigger)
-        : Tuner(sysdef, trigger), m_last_grid(0), m_last_dim(0)
+        : Tuner(sysdef, trigger), m_last_grid(0), m_last_dim(0), m_max_disorder(0.0), m_disorder(0.0),
+          m_order(sfc_order::hilbert)
     {
     m_exec_conf->msg->notice(5) << "Constructing SFCPackTuner" << endl;
 
@@ -92,11 +93,30 @@ void SFCPackTuner::update(unsigned int timestep)
     else
         getSortedOrder3D();
 
-    // apply that sort order to the particles
-    applySortOrder();
+    // leave the particles in place if they are still close to the sorted order
+    bool sort = true;
+    if (m_max_disorder > Scalar(0.0))
+        {
+        const unsigned int N = m_pdata->getN();
+        m_disorder = (N > 1) ? Scalar(countDisorder()) / Scalar(N - 1) : Scalar(0.0);
+        #ifdef ENABLE_MPI
+        if (m_comm)
+            {
+            // sort on all ranks when any rank is too disordered
+            MPI_Allreduce(MPI_IN_PLACE, &m_disorder, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_exec_conf->getMPICommunicator());
+            }
+        #endif
+        sort = (m_disorder >= m_max_disorder);
+        }
 
-    // trigger sort signal (this also forces particle migration)
-    m_pdata->notifyParticleSort();
+    if (sort)
+        {
+        // apply that sort order to the particles
+        applySortOrder();
+
+        // trigger sort signal (this also forces particle migration), the particles were only reordered
+        m_pdata->notifyParticleSort(particle_sort::permutation);
+        }
 
     #ifdef ENABLE_MPI
     if (m_comm)
@@ -109,145 +129,115 @@ void SFCPackTuner::update(unsigned int timestep)
     if (m_prof) m_prof->pop(m_exec_conf);
     }
 
+/*! All per-particle arrays are gathered into the alternate arrays of ParticleData in a single loop over the
+    particles and swapped in.
+*/
 void SFCPackTuner::applySortOrder()
     {
     assert(m_pdata);
     assert(m_sort_order.size() >= m_pdata->getN());
-    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(), access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::readwrite);
-    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
-    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::readwrite);
-    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::readwrite);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::readwrite);
-
-    // construct a temporary holding array for the sorted data
-    Scalar4 *scal4_tmp = new Scalar4[m_pdata->getN()];
-
-    // sort positions and types
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal4_tmp[i] = h_pos.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_pos.data[i] = scal4_tmp[i];
-
-    // sort velocities and mass
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal4_tmp[i] = h_vel.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_vel.data[i] = scal4_tmp[i];
-
-    Scalar3 *scal3_tmp = new Scalar3[m_pdata->getN()];
-    // sort accelerations
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal3_tmp[i] = h_accel.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_accel.data[i] = scal3_tmp[i];
-
-    Scalar *scal_tmp  = new Scalar[m_pdata->getN()];
-    // sort charge
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal_tmp[i] = h_charge.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_charge.data[i] = scal_tmp[i];
-
-    // sort diameter
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal_tmp[i] = h_diameter.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_diameter.data[i] = scal_tmp[i];
-
-    // sort angular momentum
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal4_tmp[i] = h_angmom.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_angmom.data[i] = scal4_tmp[i];
 
-    // sort moment of inertia
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal3_tmp[i] = h_inertia.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
-        h_inertia.data[i] = scal3_tmp[i];
-        }
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_net_virial(m_pdata->getNetVirial(), access_location::host, access_mode::read);
+
+        ArrayHandle<Scalar4> h_pos_alt(m_pdata->getAltPositions(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_vel_alt(m_pdata->getAltVelocities(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_accel_alt(m_pdata->getAltAccelerations(), access_location::host,
+            access_mode::overwrite);
+        ArrayHandle<Scalar> h_charge_alt(m_pdata->getAltCharges(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_diameter_alt(m_pdata->getAltDiameters(), access_location::host, access_mode::overwrite);
+        ArrayHandle<int3> h_image_alt(m_pdata->getAltImages(), access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_body_alt(m_pdata->getAltBodies(), access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag_alt(m_pdata->getAltTags(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_orientation_alt(m_pdata->getAltOrientationArray(), access_location::host,
+            access_mode::overwrite);
+        ArrayHandle<Scalar4> h_angmom_alt(m_pdata->getAltAngularMomentumArray(), access_location::host,
+            access_mode::overwrite);
+        ArrayHandle<Scalar3> h_inertia_alt(m_pdata->getAltMomentsOfInertiaArray(), access_location::host,
+            access_mode::overwrite);
+        ArrayHandle<Scalar4> h_net_force_alt(m_pdata->getAltNetForce(), access_location::host,
+            access_mode::overwrite);
+        ArrayHandle<Scalar4> h_net_torque_alt(m_pdata->getAltNetTorqueArray(), access_location::host,
+            access_mode::overwrite);
+        ArrayHandle<Scalar> h_net_virial_alt(m_pdata->getAltNetVirial(), access_location::host,
+            access_mode::overwrite);
+
+        // the alternate net virial has the same pitch
+        const size_t virial_pitch = m_pdata->getNetVirial().getPitch();
+        assert(m_pdata->getAltNetVirial().getPitch() == virial_pitch);
 
-    // in case anyone access it from frame to frame, sort the net virial
-        {
-        ArrayHandle<Scalar> h_net_virial(m_pdata->getNetVirial(), access_location::host, access_mode::readwrite);
-        size_t virial_pitch = m_pdata->getNetVirial().getPitch();
-
-        for (unsigned int j = 0; j < 6; j++)
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
             {
-            for (unsigned int i = 0; i < m_pdata->getN(); i++)
-                scal_tmp[i] = h_net_virial.data[j*virial_pitch+m_sort_order[i]];
-            for (unsigned int i = 0; i < m_pdata->getN(); i++)
-                h_net_virial.data[j*virial_pitch+i] = scal_tmp[i];
+            const unsigned int old_idx = m_sort_order[i];
+
+            h_pos_alt.data[i] = h_pos.data[old_idx];
+            h_vel_alt.data[i] = h_vel.data[old_idx];
+            h_accel_alt.data[i] = h_accel.data[old_idx];
+            h_charge_alt.data[i] = h_charge.data[old_idx];
+            h_diameter_alt.data[i] = h_diameter.data[old_idx];
+            h_image_alt.data[i] = h_image.data[old_idx];
+            h_body_alt.data[i] = h_body.data[old_idx];
+            h_tag_alt.data[i] = h_tag.data[old_idx];
+            h_orientation_alt.data[i] = h_orientation.data[old_idx];
+            h_angmom_alt.data[i] = h_angmom.data[old_idx];
+            h_inertia_alt.data[i] = h_inertia.data[old_idx];
+            h_net_force_alt.data[i] = h_net_force.data[old_idx];
+            h_net_torque_alt.data[i] = h_net_torque.data[old_idx];
+            for (unsigned int j = 0; j < 6; j++)
+                h_net_virial_alt.data[j*virial_pitch+i] = h_net_virial.data[j*virial_pitch+old_idx];
             }
         }
 
-    // sort net force, net torque, and orientation
-        {
-        ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(), access_location::host, access_mode::readwrite);
-
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            scal4_tmp[i] = h_net_force.data[m_sort_order[i]];
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            h_net_force.data[i] = scal4_tmp[i];
-        }
-
-        {
-        ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(), access_location::host, access_mode::readwrite);
-
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            scal4_tmp[i] = h_net_torque.data[m_sort_order[i]];
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            h_net_torque.data[i] = scal4_tmp[i];
-        }
-
-        {
-        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
-
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            scal4_tmp[i] = h_orientation.data[m_sort_order[i]];
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            h_orientation.data[i] = scal4_tmp[i];
-        }
-
-    // sort image
-    int3 *int3_tmp = new int3[m_pdata->getN()];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        int3_tmp[i] = h_image.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_image.data[i] = int3_tmp[i];
-
-    // sort body
-    unsigned int *uint_tmp = new unsigned int[m_pdata->getN()];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        uint_tmp[i] = h_body.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_body.data[i] = uint_tmp[i];
-
-    // sort global tag
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        uint_tmp[i] = h_tag.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_tag.data[i] = uint_tmp[i];
+    // swap in the sorted data
+    m_pdata->swapPositions();
+    m_pdata->swapVelocities();
+    m_pdata->swapAccelerations();
+    m_pdata->swapCharges();
+    m_pdata->swapDiameters();
+    m_pdata->swapImages();
+    m_pdata->swapBodies();
+    m_pdata->swapTags();
+    m_pdata->swapOrientations();
+    m_pdata->swapAngularMomenta();
+    m_pdata->swapMomentsOfInertia();
+    m_pdata->swapNetForce();
+    m_pdata->swapNetTorque();
+    m_pdata->swapNetVirial();
 
     // rebuild global rtag
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::readwrite);
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
         h_rtag.data[h_tag.data[i]] = i;
         }
+    }
 
-    delete[] scal_tmp;
-    delete[] scal4_tmp;
-    delete[] scal3_tmp;
-    delete[] uint_tmp;
-    delete[] int3_tmp;
-
+/*! \returns Number of particles in the sorted order whose old index is not one more than the old index of the
+             particle before them
+*/
+unsigned int SFCPackTuner::countDisorder()
+    {
+    unsigned int count = 0;
+    for (unsigned int i = 1; i < m_pdata->getN(); i++)
+        {
+        if (m_sort_order[i] != m_sort_order[i-1] + 1)
+            count++;
+        }
+    return count;
     }
 
 //! x walking table for the hilbert curve
@@ -443,135 +433,132 @@ void SFCPackTuner::generateTraversalOrder(int i, int j, int k, int w, int Mx, un
         }
     }
 
-void SFCPackTuner::getSortedOrder2D()
+/*! The traversal order is only regenerated when the grid dimension changed since the last call.
+*/
+void SFCPackTuner::updateTraversalOrder()
     {
-    // start by checking the saneness of some member variables
-    assert(m_pdata);
-    assert(m_sort_order.size() >= m_pdata->getN());
+    if (m_last_grid == m_grid && m_last_dim == 3)
+        return;
 
-    // make even bin dimensions
-    const BoxDim& box = m_pdata->getBox();
+    if (m_grid > 256)
+        {
+        unsigned int mb = m_grid*m_grid*m_grid*4 / 1024 / 1024;
+        m_exec_conf->msg->warning() << "sorter is about to allocate a very large amount of memory (" << mb << "MB)"
+             << " and may crash." << endl;
+        m_exec_conf->msg->warning() << "            Reduce the amount of memory allocated to prevent this by decreasing the " << endl;
+        m_exec_conf->msg->warning() << "            grid dimension (i.e. sorter.set_params(grid=128) ) or by disabling it " << endl;
+        m_exec_conf->msg->warning() << "            ( sorter.disable() ) before beginning the run()." << endl;
+        }
 
-    // put the particles in the bins
-    {
-    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    // generate the traversal order
+    GPUArray<unsigned int> traversal_order(m_grid*m_grid*m_grid,m_exec_conf);
+    m_traversal_order.swap(traversal_order);
 
-    // for each particle
-    for (unsigned int n = 0; n < m_pdata->getN(); n++)
-        {
-        // find the bin each particle belongs in
-        Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
-        Scalar3 f = box.makeFraction(p,make_scalar3(0.0,0.0,0.0));
-        int ib = (unsigned int)(f.x * m_grid) % m_grid;
-        int jb = (unsigned int)(f.y * m_grid) % m_grid;
+    vector< unsigned int > reverse_order(m_grid*m_grid*m_grid);
+    reverse_order.clear();
+
+    // we need to start the hilbert curve with a seed order 0,1,2,3,4,5,6,7
+    unsigned int cell_order[8];
+    for (unsigned int i = 0; i < 8; i++)
+        cell_order[i] = i;
+    generateTraversalOrder(0,0,0, m_grid, m_grid, cell_order, reverse_order);
 
-        // if the particle is slightly outside, move back into grid
-        if (ib < 0) ib = 0;
-        if (ib >= (int)m_grid) ib = m_grid - 1;
+    // access traversal order
+    ArrayHandle<unsigned int> h_traversal_order(m_traversal_order, access_location::host, access_mode::overwrite);
 
-        if (jb < 0) jb = 0;
-        if (jb >= (int)m_grid) jb = m_grid - 1;
+    for (unsigned int i = 0; i < m_grid*m_grid*m_grid; i++)
+        h_traversal_order.data[reverse_order[i]] = i;
 
-        // record its bin
-        unsigned int bin = ib*m_grid + jb;
+    // write the traversal order out to a file for testing/presentations
+    // writeTraversalOrder("hilbert.mol2", reverse_order);
 
-        m_particle_bins[n] = std::pair<unsigned int, unsigned int>(bin, n);
-        }
+    m_last_grid = m_grid;
+    // store the last system dimension computed so we can be mindful if that ever changes
+    m_last_dim = m_sysdef->getNDimensions();
     }
 
-    // sort the tuples
-    sort(m_particle_bins.begin(), m_particle_bins.begin() + m_pdata->getN());
+/*! \param ghost_width (Return value) Width of the ghost layer included in the bins
+    \returns Number of bins along each direction
+*/
+uint3 SFCPackTuner::getBinDimensions(Scalar3& ghost_width)
+    {
+    bool twod = m_sysdef->getNDimensions() == 2;
+    ghost_width = make_scalar3(0.0, 0.0, 0.0);
 
-    // translate the sorted order
-    for (unsigned int j = 0; j < m_pdata->getN(); j++)
+    unsigned int grid = m_grid;
+    if (m_order == sfc_order::morton)
         {
-        m_sort_order[j] = m_particle_bins[j].second;
+        // the bin indices must fit into the interleaved key
+        grid = std::min(grid, twod ? SFC_MORTON_MAX_GRID_2D : SFC_MORTON_MAX_GRID_3D);
+        }
+    else if (m_order == sfc_order::cell && m_cl)
+        {
+        // the cell list computes its dimensions on the first use
+        uint3 dim = m_cl->getDim();
+        if (dim.x*dim.y*dim.z > 0)
+            {
+            ghost_width = m_cl->getGhostWidth();
+            return dim;
+            }
         }
+
+    return make_uint3(grid, grid, twod ? 1 : grid);
     }
 
-void SFCPackTuner::getSortedOrder3D()
+/*! \param dim Number of bins along each direction
+    \returns The largest key of any bin
+*/
+unsigned int SFCPackTuner::getMaxBinKey(const uint3& dim)
+    {
+    bool twod = m_sysdef->getNDimensions() == 2;
+    if (m_order == sfc_order::morton)
+        return sfc_morton_key(make_uint3(dim.x-1, dim.y-1, dim.z-1), twod);
+    else
+        return dim.x*dim.y*dim.z - 1;
+    }
+
+/*! \param twod True in 2D simulations
+*/
+void SFCPackTuner::computeSortedOrder(bool twod)
     {
     // start by checking the saneness of some member variables
     assert(m_pdata);
     assert(m_sort_order.size() >= m_pdata->getN());
+    assert(m_particle_bins.size() >= m_pdata->getN());
 
-    // make even bin dimensions
     const BoxDim& box = m_pdata->getBox();
-
-    // reallocate memory arrays if m_grid changed
-    // also regenerate the traversal order
-    if (m_last_grid != m_grid || m_last_dim != 3)
-        {
-        if (m_grid > 256)
-            {
-            unsigned int mb = m_grid*m_grid*m_grid*4 / 1024 / 1024;
-            m_exec_conf->msg->warning() << "sorter is about to allocate a very large amount of memory (" << mb << "MB)"
-                 << " and may crash." << endl;
-            m_exec_conf->msg->warning() << "            Reduce the amount of memory allocated to prevent this by decreasing the " << endl;
-            m_exec_conf->msg->warning() << "            grid dimension (i.e. sorter.set_params(grid=128) ) or by disabling it " << endl;
-            m_exec_conf->msg->warning() << "            ( sorter.disable() ) before beginning the run()." << endl;
-            }
-
-        // generate the traversal order
-        GPUArray<unsigned int> traversal_order(m_grid*m_grid*m_grid,m_exec_conf);
-        m_traversal_order.swap(traversal_order);
-
-        vector< unsigned int > reverse_order(m_grid*m_grid*m_grid);
-        reverse_order.clear();
-
-        // we need to start the hilbert curve with a seed order 0,1,2,3,4,5,6,7
-        unsigned int cell_order[8];
-        for (unsigned int i = 0; i < 8; i++)
-            cell_order[i] = i;
-        generateTraversalOrder(0,0,0, m_grid, m_grid, cell_order, reverse_order);
-
-        // access traversal order
-        ArrayHandle<unsigned int> h_traversal_order(m_traversal_order, access_location::host, access_mode::overwrite);
-
-        for (unsigned int i = 0; i < m_grid*m_grid*m_grid; i++)
-            h_traversal_order.data[reverse_order[i]] = i;
-
-        // write the traversal order out to a file for testing/presentations
-        // writeTraversalOrder("hilbert.mol2", reverse_order);
-
-        m_last_grid = m_grid;
-        // store the last system dimension computed so we can be mindful if that ever changes
-        m_last_dim = m_sysdef->getNDimensions();
-        }
-
-    // sanity checks
-    assert(m_particle_bins.size() >= m_pdata->getN());
-    assert(m_traversal_order.getNumElements() == m_grid*m_grid*m_grid);
+    Scalar3 ghost_width;
+    uint3 dim = getBinDimensions(ghost_width);
+    Index3D cell_indexer(dim.x, dim.y, dim.z);
 
     // put the particles in the bins
-    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-
-    // access traversal order
-    ArrayHandle<unsigned int> h_traversal_order(m_traversal_order, access_location::host, access_mode::read);
-
-    // for each particle
-    for (unsigned int n = 0; n < m_pdata->getN(); n++)
         {
-        Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
-        Scalar3 f = box.makeFraction(p,make_scalar3(0.0,0.0,0.0));
-        int ib = (unsigned int)(f.x * m_grid) % m_grid;
-        int jb = (unsigned int)(f.y * m_grid) % m_grid;
-        int kb = (unsigned int)(f.z * m_grid) % m_grid;
-
-        // if the particle is slightly outside, move back into grid
-        if (ib < 0) ib = 0;
-        if (ib >= (int)m_grid) ib = m_grid - 1;
-
-        if (jb < 0) jb = 0;
-        if (jb >= (int)m_grid) jb = m_grid - 1;
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
 
-        if (kb < 0) kb = 0;
-        if (kb >= (int)m_grid) kb = m_grid - 1;
+        // access traversal order, only generated for the hilbert curve in 3D
+        ArrayHandle<unsigned int> h_traversal_order(m_traversal_order, access_location::host, access_mode::read);
 
-        // record its bin
-        unsigned int bin = ib*(m_grid*m_grid) + jb * m_grid + kb;
-
-        m_particle_bins[n] = std::pair<unsigned int, unsigned int>(h_traversal_order.data[bin], n);
+        // for each particle
+        for (unsigned int n = 0; n < m_pdata->getN(); n++)
+            {
+            // find the bin each particle belongs in
+            Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
+            Scalar3 f = box.makeFraction(p, ghost_width);
+            uint3 bin = sfc_bin(f, dim);
+
+            unsigned int key;
+            if (m_order == sfc_order::morton)
+                key = sfc_morton_key(bin, twod);
+            else if (m_order == sfc_order::cell)
+                key = cell_indexer(bin.x, bin.y, bin.z);
+            else if (twod)
+                key = bin.x*dim.y + bin.y;
+            else
+                key = h_traversal_order.data[bin.x*(dim.y*dim.z) + bin.y*dim.z + bin.z];
+
+            // record its bin
+            m_particle_bins[n] = std::pair<unsigned int, unsigned int>(key, n);
+            }
         }
 
     // sort the tuples
@@ -584,6 +571,46 @@ void SFCPackTuner::getSortedOrder3D()
         }
     }
 
+void SFCPackTuner::getSortedOrder2D()
+    {
+    computeSortedOrder(true);
+    }
+
+void SFCPackTuner::getSortedOrder3D()
+    {
+    if (m_order == sfc_order::hilbert)
+        updateTraversalOrder();
+
+    computeSortedOrder(false);
+    }
+
+/*! \param order Name of the ordering: "hilbert", "morton", or "cell"
+*/
+void SFCPackTuner::setOrderPython(const std::string& order)
+    {
+    if (order == "hilbert")
+        m_order = sfc_order::hilbert;
+    else if (order == "morton")
+        m_order = sfc_order::morton;
+    else if (order == "cell")
+        m_order = sfc_order::cell;
+    else
+        throw std::domain_error("Unknown sort order " + order);
+    }
+
+std::string SFCPackTuner::getOrderPython()
+    {
+    switch (m_order)
+        {
+        case sfc_order::morton:
+            return "morton";
+        case sfc_order::cell:
+            return "cell";
+        default:
+            return "hilbert";
+        }
+    }
+
 void SFCPackTuner::writeTraversalOrder(const std::string& fname, const vector< unsigned int >& reverse_order)
     {
     m_exec_conf->msg->notice(2) << "sorter: Writing space filling curve traversal order to " << fname << endl;
@@ -621,5 +648,9 @@ void export_SFCPackTuner(py::module& m)
                    std::shared_ptr<Trigger> >())
     .def_property("grid", &SFCPackTuner::getGrid,
                           &SFCPackTuner::setGridPython)
+    .def_property("max_disorder", &SFCPackTuner::getMaxDisorder, &SFCPackTuner::setMaxDisorder)
+    .def_property_readonly("disorder", &SFCPackTuner::getDisorder)
+    .def_property("order", &SFCPackTuner::getOrderPython, &SFCPackTuner::setOrderPython)
+    .def("setCellList", &SFCPackTuner::setCellList)
     ;
     }
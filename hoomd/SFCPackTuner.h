@@ -14,8 +14,12 @@
 
 #include "Tuner.h"
 #include "GPUVector.h"
+#include "CellList.h"
+#include "SFCOrder.h"
 
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <vector>
 #include <utility>
 #include <pybind11/pybind11.h>
@@ -44,6 +48,15 @@
     which those bins appear along a hilbert curve. It is very efficient, even when the box size changes often as the
     grid dimension is kept constant.
 
+    setOrder() selects other orderings of the bins (see sfc_order). The Morton order interleaves the bits of the bin
+    indices and needs no traversal table. The cell order sorts the particles by the cell they occupy in the CellList
+    given to setCellList(), so the particles in each cell are contiguous in memory. Without a cell list, it orders the
+    bins of the grid x fastest.
+
+    With a nonzero maximum disorder (setMaxDisorder()), the sorted order is computed on every trigger, but it is only
+    applied when the fraction of particles that do not directly follow their predecessor in the new order reaches the
+    threshold. Skipping the sort avoids moving the particle data and the forced neighbor list rebuild that follows it.
+
     \ingroup updaters
 */
 class PYBIND11_EXPORT SFCPackTuner : public Tuner
@@ -81,10 +94,64 @@ class PYBIND11_EXPORT SFCPackTuner : public Tuner
             return m_grid;
             }
 
+        //! Set the disorder below which a triggered sort is skipped
+        /*! \param max_disorder Fraction of particles out of order, 0 to sort on every trigger
+        */
+        void setMaxDisorder(Scalar max_disorder)
+            {
+            if (max_disorder < Scalar(0.0) || max_disorder > Scalar(1.0))
+                {
+                throw std::domain_error("max_disorder must be in the range [0,1]");
+                }
+            m_max_disorder = max_disorder;
+            }
+
+        //! Get the disorder below which a triggered sort is skipped
+        Scalar getMaxDisorder()
+            {
+            return m_max_disorder;
+            }
+
+        //! Get the disorder measured at the last triggered sort
+        Scalar getDisorder()
+            {
+            return m_disorder;
+            }
+
+        //! Set the ordering of the bins
+        void setOrder(sfc_order::Enum order)
+            {
+            m_order = order;
+            }
+
+        //! Get the ordering of the bins
+        sfc_order::Enum getOrder()
+            {
+            return m_order;
+            }
+
+        //! Set the ordering of the bins by name
+        void setOrderPython(const std::string& order);
+
+        //! Get the name of the ordering of the bins
+        std::string getOrderPython();
+
+        //! Set the cell list that defines the cell order
+        /*! \param cl Cell list, may be null to order the bins of the grid
+        */
+        void setCellList(std::shared_ptr<CellList> cl)
+            {
+            m_cl = cl;
+            }
+
     protected:
         unsigned int m_grid;        //!< Grid dimension to use
         unsigned int m_last_grid;   //!< The last value of MMax
         unsigned int m_last_dim;    //!< Check the last dimension we ran at
+        Scalar m_max_disorder;      //!< Disorder below which the sort is skipped
+        Scalar m_disorder;          //!< Disorder measured at the last triggered sort
+        sfc_order::Enum m_order;    //!< Ordering of the bins
+        std::shared_ptr<CellList> m_cl; //!< Cell list that defines the cell order (may be null)
         GPUArray< unsigned int > m_traversal_order;      //!< Generated traversal order of bins
 
         //! Helper function that actually performs the sort
@@ -92,9 +159,21 @@ class PYBIND11_EXPORT SFCPackTuner : public Tuner
         //! Helper function that actually performs the sort
         virtual void getSortedOrder3D();
 
+        //! Generate the hilbert curve traversal order of the 3D grid when the grid changed
+        void updateTraversalOrder();
+
+        //! Get the bins of the current ordering
+        uint3 getBinDimensions(Scalar3& ghost_width);
+
+        //! Get the largest key of the current ordering
+        unsigned int getMaxBinKey(const uint3& dim);
+
         //! Apply the sorted order to the particle data
         virtual void applySortOrder();
 
+        //! Count the particles that do not directly follow their predecessor in the sorted order
+        virtual unsigned int countDisorder();
+
         //! Helper function to generate traversal order
         static void generateTraversalOrder(int i, int j, int k, int w, int Mx, unsigned int cell_order[8], std::vector< unsigned int > &traversal_order);
 
@@ -109,6 +188,9 @@ class PYBIND11_EXPORT SFCPackTuner : public Tuner
         std::vector< std::pair<unsigned int, unsigned int> > m_particle_bins;    //!< Binned particles
         std::shared_ptr<Trigger> m_trigger;
 
+        //! Bin the particles and sort them by the key of their bin
+        void computeSortedOrder(bool twod);
+
    };
 
 //! Export the SFCPackTuner class to python
@@ -13,22 +13,30 @@
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
-#include <thrust/sort.h>
+#include <hipcub/hipcub.hpp>
 #include <thrust/execution_policy.h>
 #include <thrust/device_ptr.h>
+#include <thrust/functional.h>
+#include <thrust/inner_product.h>
 #pragma GCC diagnostic pop
 
 #include "SFCPackTunerGPU.cuh"
 
 //! Kernel to bin particles
-template<bool twod>
+/*! \tparam order Ordering of the bins
+
+    Each thread computes the sort key of the bin of one particle and initializes the sorted order to the identity.
+*/
+template<sfc_order::Enum order>
 __global__ void gpu_sfc_bin_particles_kernel(unsigned int N,
     const Scalar4 *d_pos,
     unsigned int *d_particle_bins,
     const unsigned int *d_traversal_order,
-    unsigned int n_grid,
+    const uint3 dim,
+    const Scalar3 ghost_width,
     unsigned int *d_sorted_order,
-    const BoxDim box)
+    const BoxDim box,
+    bool twod)
     {
     unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
 
@@ -38,34 +46,30 @@ __global__ void gpu_sfc_bin_particles_kernel(unsigned int N,
     Scalar4 postype = d_pos[idx];
     Scalar3 p = make_scalar3(postype.x, postype.y, postype.z);
 
-    Scalar3 f = box.makeFraction(p);
-    int ib = (unsigned int)(f.x * n_grid) % n_grid;
-    int jb = (unsigned int)(f.y * n_grid) % n_grid;
-    int kb = (unsigned int)(f.z * n_grid) % n_grid;
-
-    // if the particle is slightly outside, move back into grid
-    if (ib < 0) ib = 0;
-    if (ib >= n_grid) ib = n_grid - 1;
-
-    if (jb < 0) jb = 0;
-    if (jb >= n_grid) jb = n_grid - 1;
-
-    if (kb < 0) kb = 0;
-    if (kb >= n_grid) kb = n_grid - 1;
+    Scalar3 f = box.makeFraction(p, ghost_width);
+    uint3 bin = sfc_bin(f, dim);
 
     // record its bin
-    unsigned int bin;
-    if (twod)
+    unsigned int key;
+    if (order == sfc_order::morton)
+        {
+        key = sfc_morton_key(bin, twod);
+        }
+    else if (order == sfc_order::cell)
+        {
+        Index3D cell_indexer(dim.x, dim.y, dim.z);
+        key = cell_indexer(bin.x, bin.y, bin.z);
+        }
+    else if (twod)
         {
         // do not use Hilbert curve in 2D
-        bin = ib*n_grid + jb;
-        d_particle_bins[idx] = bin;
+        key = bin.x*dim.y + bin.y;
         }
     else
         {
-        bin = ib*(n_grid*n_grid) + jb * n_grid + kb;
-        d_particle_bins[idx] = d_traversal_order[bin];
+        key = d_traversal_order[bin.x*(dim.y*dim.z) + bin.y*dim.z + bin.z];
         }
+    d_particle_bins[idx] = key;
 
     // store index of ptl
     d_sorted_order[idx] = idx;
@@ -74,189 +78,143 @@ __global__ void gpu_sfc_bin_particles_kernel(unsigned int N,
 /*! \param N number of local particles
     \param d_pos Device array of positions
     \param d_particle_bins Device array of particle bins
-    \param d_traversal_order Device array of Hilbert-curve bins
-    \param n_grid Number of grid elements along one edge
+    \param d_traversal_order Device array of Hilbert-curve bins, only read by the hilbert order in 3D
+    \param dim Number of bins along each direction
+    \param ghost_width Width of the ghost layer included in the bins
+    \param order Ordering of the bins
+    \param key_bits Number of significant bits of the bin keys
     \param d_sorted_order Sorted order of particles
     \param box Box dimensions
     \param twod If true, bin particles in two dimensions
+    \param alloc Caching allocator for the sort temporaries
+
+    The particles are sorted by their bin keys with a radix sort over the significant bits only.
     */
 void gpu_generate_sorted_order(unsigned int N,
         const Scalar4 *d_pos,
         unsigned int *d_particle_bins,
-        unsigned int *d_traversal_order,
-        unsigned int n_grid,
+        const unsigned int *d_traversal_order,
+        const uint3& dim,
+        const Scalar3& ghost_width,
+        sfc_order::Enum order,
+        unsigned int key_bits,
         unsigned int *d_sorted_order,
         const BoxDim& box,
         bool twod,
         CachedAllocator& alloc)
     {
+    if (N == 0)
+        return;
+
     // maybe need to autotune, but SFCPackTuner is called infrequently
     unsigned int block_size = 256;
     unsigned int n_blocks = N/block_size + 1;
 
-    if (twod)
-        hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_sfc_bin_particles_kernel<true>), dim3(n_blocks), dim3(block_size), 0, 0, N, d_pos, d_particle_bins, d_traversal_order, n_grid, d_sorted_order, box);
-    else
-        hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_sfc_bin_particles_kernel<false>), dim3(n_blocks), dim3(block_size), 0, 0, N, d_pos, d_particle_bins, d_traversal_order, n_grid, d_sorted_order, box);
+    switch (order)
+        {
+        case sfc_order::morton:
+            hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_sfc_bin_particles_kernel<sfc_order::morton>), dim3(n_blocks),
+                dim3(block_size), 0, 0, N, d_pos, d_particle_bins, d_traversal_order, dim, ghost_width,
+                d_sorted_order, box, twod);
+            break;
+        case sfc_order::cell:
+            hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_sfc_bin_particles_kernel<sfc_order::cell>), dim3(n_blocks),
+                dim3(block_size), 0, 0, N, d_pos, d_particle_bins, d_traversal_order, dim, ghost_width,
+                d_sorted_order, box, twod);
+            break;
+        default:
+            hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_sfc_bin_particles_kernel<sfc_order::hilbert>), dim3(n_blocks),
+                dim3(block_size), 0, 0, N, d_pos, d_particle_bins, d_traversal_order, dim, ghost_width,
+                d_sorted_order, box, twod);
+        }
+
+    // sort particles, the double buffers come from the caching allocator
+    unsigned int *d_keys_alt = alloc.getTemporaryBuffer<unsigned int>(N);
+    unsigned int *d_values_alt = alloc.getTemporaryBuffer<unsigned int>(N);
+    hipcub::DoubleBuffer<unsigned int> d_keys(d_particle_bins, d_keys_alt);
+    hipcub::DoubleBuffer<unsigned int> d_values(d_sorted_order, d_values_alt);
+
+    void *d_temp_storage = NULL;
+    size_t temp_storage_bytes = 0;
+    hipcub::DeviceRadixSort::SortPairs(d_temp_storage, temp_storage_bytes, d_keys, d_values, N, 0, key_bits);
 
-    // Sort particles
-    if (N)
+    d_temp_storage = alloc.getTemporaryBuffer<char>(temp_storage_bytes);
+    hipcub::DeviceRadixSort::SortPairs(d_temp_storage, temp_storage_bytes, d_keys, d_values, N, 0, key_bits);
+    alloc.deallocate((char *)d_temp_storage);
+
+    // the sorted order may end up in the alternate buffer
+    if (d_keys.Current() != d_particle_bins)
+        hipMemcpyAsync(d_particle_bins, d_keys.Current(), sizeof(unsigned int)*N, hipMemcpyDeviceToDevice);
+    if (d_values.Current() != d_sorted_order)
+        hipMemcpyAsync(d_sorted_order, d_values.Current(), sizeof(unsigned int)*N, hipMemcpyDeviceToDevice);
+
+    alloc.deallocate((char *)d_values_alt);
+    alloc.deallocate((char *)d_keys_alt);
+    }
+
+//! Functor that flags a particle whose old index does not follow the old index of its predecessor
+struct gpu_sort_not_successor
+    {
+    __host__ __device__ unsigned int operator()(unsigned int cur, unsigned int prev) const
         {
-        thrust::device_ptr<unsigned int> particle_bins(d_particle_bins);
-        thrust::device_ptr<unsigned int> sorted_order(d_sorted_order);
-        #ifdef __HIP_PLATFORM_HCC__
-        thrust::sort_by_key(thrust::hip::par(alloc),
-        #else
-        thrust::sort_by_key(thrust::cuda::par(alloc),
-        #endif
-            particle_bins,
-            particle_bins+N,
-            sorted_order);
+        return (cur != prev + 1) ? 1 : 0;
         }
+    };
+
+/*! \param N number of local particles
+    \param d_sorted_order Sorted order of particles
+    \param alloc Caching allocator for thrust temporaries
+
+    \returns The number of particles whose old index is not one more than the old index of the particle before them
+*/
+unsigned int gpu_count_sort_disorder(unsigned int N,
+        const unsigned int *d_sorted_order,
+        CachedAllocator& alloc)
+    {
+    if (N < 2)
+        return 0;
+
+    thrust::device_ptr<const unsigned int> sorted_order(d_sorted_order);
+    #ifdef __HIP_PLATFORM_HCC__
+    return thrust::inner_product(thrust::hip::par(alloc),
+    #else
+    return thrust::inner_product(thrust::cuda::par(alloc),
+    #endif
+        sorted_order+1,
+        sorted_order+N,
+        sorted_order,
+        0u,
+        thrust::plus<unsigned int>(),
+        gpu_sort_not_successor());
     }
 
-//! Kernel to apply sorted order
-__global__ void gpu_apply_sorted_order_kernel(
+//! Kernel to point the reverse lookup table at the sorted particles
+__global__ void gpu_sort_update_rtags_kernel(
         unsigned int N,
-        unsigned int n_ghost,
-        const unsigned int *d_sorted_order,
-        const Scalar4 *d_pos,
-        Scalar4 *d_pos_alt,
-        const Scalar4 *d_vel,
-        Scalar4 *d_vel_alt,
-        const Scalar3 *d_accel,
-        Scalar3 *d_accel_alt,
-        const Scalar *d_charge,
-        Scalar *d_charge_alt,
-        const Scalar *d_diameter,
-        Scalar *d_diameter_alt,
-        const int3 *d_image,
-        int3 *d_image_alt,
-        const unsigned int *d_body,
-        unsigned int *d_body_alt,
         const unsigned int *d_tag,
-        unsigned int *d_tag_alt,
-        const Scalar4 *d_orientation,
-        Scalar4 *d_orientation_alt,
-        const Scalar4 *d_angmom,
-        Scalar4 *d_angmom_alt,
-        const Scalar3 *d_inertia,
-        Scalar3 *d_inertia_alt,
-        const Scalar *d_net_virial,
-        Scalar *d_net_virial_alt,
-        size_t virial_pitch,
-        const Scalar4 *d_net_force,
-        Scalar4 *d_net_force_alt,
-        const Scalar4 *d_net_torque,
-        Scalar4 *d_net_torque_alt,
         unsigned int *d_rtag)
     {
     unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
 
-    if (idx >= N+n_ghost) return;
-
-    // apply sorted order only for local ptls
-    unsigned int old_idx = (idx < N ? d_sorted_order[idx] : idx);
-
-    // permute and copy over particle data
-    d_pos_alt[idx] = d_pos[old_idx];
-    d_vel_alt[idx] = d_vel[old_idx];
-    d_accel_alt[idx] = d_accel[old_idx];
-    d_charge_alt[idx] = d_charge[old_idx];
-    d_diameter_alt[idx] = d_diameter[old_idx];
-    d_image_alt[idx] = d_image[old_idx];
-    d_body_alt[idx] = d_body[old_idx];
-    unsigned int tag = d_tag[old_idx];
-    d_tag_alt[idx] = tag;
-    d_orientation_alt[idx] = d_orientation[old_idx];
-    d_angmom_alt[idx] = d_angmom[old_idx];
-    d_inertia_alt[idx] = d_inertia[old_idx];
-    d_net_virial_alt[0*virial_pitch+idx] = d_net_virial[0*virial_pitch+old_idx];
-    d_net_virial_alt[1*virial_pitch+idx] = d_net_virial[1*virial_pitch+old_idx];
-    d_net_virial_alt[2*virial_pitch+idx] = d_net_virial[2*virial_pitch+old_idx];
-    d_net_virial_alt[3*virial_pitch+idx] = d_net_virial[3*virial_pitch+old_idx];
-    d_net_virial_alt[4*virial_pitch+idx] = d_net_virial[4*virial_pitch+old_idx];
-    d_net_virial_alt[5*virial_pitch+idx] = d_net_virial[5*virial_pitch+old_idx];
-    d_net_force_alt[idx] = d_net_force[old_idx];
-    d_net_torque_alt[idx] = d_net_torque[old_idx];
-
-    if (idx < N)
-        {
-        // update rtag to point to particle position in new arrays
-        d_rtag[tag] = idx;
-        }
+    if (idx >= N) return;
+
+    d_rtag[d_tag[idx]] = idx;
     }
 
-void gpu_apply_sorted_order(
+/*! \param N Number of local particles
+    \param d_tag Particle tags, already in the sorted order
+    \param d_rtag Reverse lookup table to update
+*/
+void gpu_sort_update_rtags(
         unsigned int N,
-        unsigned int n_ghost,
-        const unsigned int *d_sorted_order,
-        const Scalar4 *d_pos,
-        Scalar4 *d_pos_alt,
-        const Scalar4 *d_vel,
-        Scalar4 *d_vel_alt,
-        const Scalar3 *d_accel,
-        Scalar3 *d_accel_alt,
-        const Scalar *d_charge,
-        Scalar *d_charge_alt,
-        const Scalar *d_diameter,
-        Scalar *d_diameter_alt,
-        const int3 *d_image,
-        int3 *d_image_alt,
-        const unsigned int *d_body,
-        unsigned int *d_body_alt,
         const unsigned int *d_tag,
-        unsigned int *d_tag_alt,
-        const Scalar4 *d_orientation,
-        Scalar4 *d_orientation_alt,
-        const Scalar4 *d_angmom,
-        Scalar4 *d_angmom_alt,
-        const Scalar3 *d_inertia,
-        Scalar3 *d_inertia_alt,
-        const Scalar *d_net_virial,
-        Scalar *d_net_virial_alt,
-        size_t virial_pitch,
-        const Scalar4 *d_net_force,
-        Scalar4 *d_net_force_alt,
-        const Scalar4 *d_net_torque,
-        Scalar4 *d_net_torque_alt,
-        unsigned int *d_rtag
-        )
+        unsigned int *d_rtag)
     {
+    if (N == 0)
+        return;
+
     unsigned int block_size = 256;
-    unsigned int n_blocks = (N+n_ghost)/block_size + 1;
-
-    hipLaunchKernelGGL(gpu_apply_sorted_order_kernel, dim3(n_blocks), dim3(block_size), 0, 0, N,
-        n_ghost,
-        d_sorted_order,
-        d_pos,
-        d_pos_alt,
-        d_vel,
-        d_vel_alt,
-        d_accel,
-        d_accel_alt,
-        d_charge,
-        d_charge_alt,
-        d_diameter,
-        d_diameter_alt,
-        d_image,
-        d_image_alt,
-        d_body,
-        d_body_alt,
-        d_tag,
-        d_tag_alt,
-        d_orientation,
-        d_orientation_alt,
-        d_angmom,
-        d_angmom_alt,
-        d_inertia,
-        d_inertia_alt,
-        d_net_virial,
-        d_net_virial_alt,
-        virial_pitch,
-        d_net_force,
-        d_net_force_alt,
-        d_net_torque,
-        d_net_torque_alt,
-        d_rtag);
+    unsigned int n_blocks = N/block_size + 1;
+
+    hipLaunchKernelGGL(gpu_sort_update_rtags_kernel, dim3(n_blocks), dim3(block_size), 0, 0, N, d_tag, d_rtag);
     }
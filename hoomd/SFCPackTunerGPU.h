@@ -18,6 +18,7 @@
 #include "SFCPackTuner.h"
 #include "SFCPackTunerGPU.cuh"
 #include "GPUArray.h"
+#include "Autotuner.h"
 
 #include <memory>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
@@ -59,6 +60,11 @@ class PYBIND11_EXPORT SFCPackTunerGPU : public SFCPackTuner
 
         //! Apply the sorted order to the particle data
         virtual void applySortOrder();
+
+        //! Count the out of order particles on the GPU
+        virtual unsigned int countDisorder();
+
+        std::unique_ptr<Autotuner> m_tuner_reorder; //!< Autotuner for the block size of the reorder kernel
     };
 
 //! Export the SFCPackTunerGPU class to python
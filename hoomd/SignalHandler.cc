@@ -16,6 +16,10 @@ using namespace std;
 */
 
 volatile sig_atomic_t g_sigint_recvd = 0;
+volatile sig_atomic_t g_preempt_recvd = 0;
+
+//! Signals that request a checkpoint before the job stops
+static const int preempt_signals[2] = {SIGUSR1, SIGTERM};
 
 //! The actual signal handler
 extern "C" void sigint_handler(int sig)
@@ -28,7 +32,13 @@ extern "C" void sigint_handler(int sig)
     g_sigint_recvd = 1;
     }
 
-ScopedSignalHandler::ScopedSignalHandler()
+extern "C" void preempt_handler(int sig)
+    {
+    g_preempt_recvd = 1;
+    }
+
+ScopedSignalHandler::ScopedSignalHandler(bool preempt)
+    : m_preempt(preempt)
     {
     struct sigaction newact;
     newact.sa_handler = sigint_handler;
@@ -41,6 +51,19 @@ ScopedSignalHandler::ScopedSignalHandler()
         {
         cerr << "Error setting signal handler: " << strerror(errno) << endl;
         }
+
+    if (m_preempt)
+        {
+        newact.sa_handler = preempt_handler;
+        for (unsigned int i = 0; i < 2; i++)
+            {
+            retval = sigaction(preempt_signals[i], &newact, &m_old_preempt_action[i]);
+            if (retval != 0)
+                {
+                cerr << "Error setting signal handler: " << strerror(errno) << endl;
+                }
+            }
+        }
     }
 
 ScopedSignalHandler::~ScopedSignalHandler()
@@ -52,4 +75,16 @@ ScopedSignalHandler::~ScopedSignalHandler()
         {
         cerr << "Error setting signal handler: " << strerror(errno) << endl;
         }
+
+    if (m_preempt)
+        {
+        for (unsigned int i = 0; i < 2; i++)
+            {
+            retval = sigaction(preempt_signals[i], &m_old_preempt_action[i], &dummy_action);
+            if (retval != 0)
+                {
+                cerr << "Error setting signal handler: " << strerror(errno) << endl;
+                }
+            }
+        }
     }
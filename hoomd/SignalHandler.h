@@ -22,22 +22,36 @@
 */
 extern volatile sig_atomic_t g_sigint_recvd;
 
+/*! Set when SIGUSR1 or SIGTERM is received while the preemption handler is installed. System::run resets it at the
+    start of each run.
+*/
+extern volatile sig_atomic_t g_preempt_recvd;
+
 /** Manage the signal handler within a scope
 
     This allows System::run to install the signal handler and have it removed when it returns
     or an exception is thrown.
+
+    With *preempt*, the handler also catches SIGUSR1 and SIGTERM, which batch schedulers send before they stop a job,
+    and sets g_preempt_recvd instead of terminating the process.
 */
 class ScopedSignalHandler
     {
     public:
         /// Install the signal handler
-        ScopedSignalHandler();
+        ScopedSignalHandler(bool preempt=false);
 
         /// Remove the signal handler and restore the previous
         ~ScopedSignalHandler();
     private:
         /// Save the old action
         struct sigaction m_old_action;
+
+        /// True when the preemption signals are handled
+        bool m_preempt;
+
+        /// Save the old actions of SIGUSR1 and SIGTERM
+        struct sigaction m_old_preempt_action[2];
     };
 
 #endif
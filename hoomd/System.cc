@@ -16,6 +16,8 @@
 #endif
 
 // #include <pybind11/pybind11.h>
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 #include <time.h>
 #include <pybind11/cast.h>
@@ -43,12 +45,15 @@ PyObject* walltimeLimitExceptionTypeObj = 0;
 */
 System::System(std::shared_ptr<SystemDefinition> sysdef, unsigned int initial_tstep)
         : m_sysdef(sysdef), m_start_tstep(initial_tstep), m_end_tstep(0), m_cur_tstep(initial_tstep),
-          m_profile(false)
+          m_profile(false), m_profile_sync(true)
     {
     // sanity check
     assert(m_sysdef);
     m_exec_conf = m_sysdef->getParticleData()->getExecConf();
 
+    // the potential energy is always computed unless disabled with setEnergyFlag()
+    m_default_flags[pdata_flag::potential_energy] = 1;
+
     #ifdef ENABLE_MPI
     // the initial time step is defined on the root processor
     if (m_sysdef->getParticleData()->getDomainDecomposition())
@@ -87,13 +92,19 @@ void System::setCommunicator(std::shared_ptr<Communicator> comm)
 
 void System::run(unsigned int nsteps, bool write_at_start)
     {
-    ScopedSignalHandler signal_handler;
+    ScopedSignalHandler signal_handler(m_preempt_checkpoint && m_preempt_signals);
+    g_preempt_recvd = 0;
+    m_preempted = false;
     m_start_tstep = m_cur_tstep;
     m_end_tstep = m_cur_tstep + nsteps;
 
     // initialize the last status time
     m_initial_time = m_clk.getTime();
     setupProfiling();
+    resetStepTimes();
+
+    // simulations that share a device key their autotuner results by their own number of particles
+    m_exec_conf->getAutotunerDatabase()->setProblemSize(m_sysdef->getParticleData()->getNGlobal());
 
     // preset the flags before the run loop so that any analyzers/updaters run on step 0 have the info they need
     // but set the flags before prepRun, as prepRun may remove some flags that it cannot generate on the first step
@@ -112,6 +123,9 @@ void System::run(unsigned int nsteps, bool write_at_start)
         }
     #endif
 
+    // integrator variables restored from a file replace the values set when the operations attached
+    m_sysdef->getIntegratorData()->applyRestored();
+
     // Prepare the run
     if (m_integrator)
         {
@@ -121,6 +135,7 @@ void System::run(unsigned int nsteps, bool write_at_start)
     // execute analyzers on initial step if requested
     if (write_at_start)
         {
+        prefetchHostArrays(m_cur_tstep);
         for (auto &analyzer_trigger_pair: m_analyzers)
             {
             if ((*analyzer_trigger_pair.second)(m_cur_tstep))
@@ -129,50 +144,91 @@ void System::run(unsigned int nsteps, bool write_at_start)
         }
 
     // run the steps
+    updateNextActive();
+    int64_t step_start = m_clk.getTime();
     for (unsigned int count = 0; count < nsteps; count++)
         {
-        for (auto &tuner: m_tuners)
-            {
-            if ((*tuner->getTrigger())(m_cur_tstep))
-                tuner->update(m_cur_tstep);
-            }
+        bool operations_checked = false;
 
-        // execute updaters
-        for (auto &updater_trigger_pair: m_updaters)
+        if (m_cur_tstep >= m_next_update)
             {
-            if ((*updater_trigger_pair.second)(m_cur_tstep))
-                updater_trigger_pair.first->update(m_cur_tstep);
+            operations_checked = true;
+            for (auto &tuner: m_tuners)
+                {
+                if ((*tuner->getTrigger())(m_cur_tstep))
+                    tuner->update(m_cur_tstep);
+                }
+
+            // execute updaters
+            for (auto &updater_trigger_pair: m_updaters)
+                {
+                if ((*updater_trigger_pair.second)(m_cur_tstep))
+                    updater_trigger_pair.first->update(m_cur_tstep);
+                }
             }
+        int64_t step_updated = m_clk.getTime();
 
         // look ahead to the next time step and see which analyzers and updaters will be executed
         // or together all of their requested PDataFlags to determine the flags to set for this time step
-        m_sysdef->getParticleData()->setFlags(determineFlags(m_cur_tstep+1));
+        if (m_cur_tstep+1 >= std::min(m_next_update, m_next_analyze))
+            m_sysdef->getParticleData()->setFlags(determineFlags(m_cur_tstep+1));
+        else
+            m_sysdef->getParticleData()->setFlags(determineBaseFlags());
 
         // execute the integrator
         if (m_integrator)
             m_integrator->update(m_cur_tstep);
+        int64_t step_integrated = m_clk.getTime();
 
         m_cur_tstep++;
 
         // execute analyzers after incrementing the step counter
-        for (auto &analyzer_trigger_pair: m_analyzers)
+        if (m_cur_tstep >= m_next_analyze)
             {
-            if ((*analyzer_trigger_pair.second)(m_cur_tstep))
-                analyzer_trigger_pair.first->analyze(m_cur_tstep);
+            operations_checked = true;
+            prefetchHostArrays(m_cur_tstep);
+            for (auto &analyzer_trigger_pair: m_analyzers)
+                {
+                if ((*analyzer_trigger_pair.second)(m_cur_tstep))
+                    analyzer_trigger_pair.first->analyze(m_cur_tstep);
+                }
             }
 
-        updateTPS();
+        // operations may change the triggers, look ahead again after they run
+        if (operations_checked)
+            updateNextActive();
+
+        int64_t step_end = m_clk.getTime();
+        recordStepTime(step_start, step_updated, step_integrated, step_end);
+        step_start = step_end;
+        updateTPS(step_end);
+
+        if (m_straggler_period && (m_cur_tstep - m_start_tstep) % m_straggler_period == 0)
+            reportStragglers();
+
+        if (m_preempt_checkpoint && checkPreemption(count + 1 == nsteps))
+            {
+            m_exec_conf->msg->notice(2) << "Preempting the run at step " << m_cur_tstep << std::endl;
+            writePreemptionCheckpoint();
+            m_preempted = true;
+            break;
+            }
 
         // quit if Ctrl-C was pressed
         if (g_sigint_recvd)
             {
             g_sigint_recvd = 0;
+            pybind11::gil_scoped_acquire acquire;
             PyErr_SetString(PyExc_KeyboardInterrupt, "");
             throw pybind11::error_already_set();
             return;
             }
         }
 
+    // complete asynchronous output before returning control to the caller
+    for (auto &analyzer_trigger_pair: m_analyzers)
+        analyzer_trigger_pair.first->flush();
+
     #ifdef ENABLE_MPI
     // make sure all ranks return the same TPS after the run completes
     if (m_comm)
@@ -183,19 +239,244 @@ void System::run(unsigned int nsteps, bool write_at_start)
     #endif
     }
 
-void System::updateTPS()
+/*! Other Python threads execute while the steps run. Operations that call into Python (custom actions, callbacks,
+    log writers) acquire the GIL for the duration of the call. The current GPU is a property of the calling thread,
+    so the first active GPU is selected before the run in case this is not the thread that created the System.
+
+    The caller must not access the System, its SystemDefinition, or the operations from other threads until the run
+    returns.
+*/
+void System::runWithoutGIL(unsigned int nsteps, bool write_at_start)
     {
-    m_last_walltime = double(m_clk.getTime() - m_initial_time) / double(1e9);
+    #ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        hipSetDevice(m_exec_conf->getGPUIds()[0]);
+    #endif
+
+    pybind11::gil_scoped_release release;
+    run(nsteps, write_at_start);
+    }
+
+void System::updateTPS(int64_t now)
+    {
+    m_last_walltime = double(now - m_initial_time) / double(1e9);
 
     // calculate average TPS
     m_last_TPS = double(m_cur_tstep - m_start_tstep) / m_last_walltime;
     }
 
+/*! \param checkpoint Writer of the checkpoint, null to disable preemption
+    \param walltime_limit Wall time since construction at which to preempt the run [seconds], 0 for no limit
+    \param signals Set to true to preempt the run when SIGUSR1 or SIGTERM is received
+
+    A preempted run ends after the step on which the condition is met on any rank, writes a checkpoint with
+    \a checkpoint, and completes its output. \a checkpoint should also be among the analyzers, so that it is set up
+    for the run and flushed at the end of the run.
+*/
+void System::setPreemption(std::shared_ptr<Analyzer> checkpoint, double walltime_limit, bool signals)
+    {
+    m_preempt_checkpoint = checkpoint;
+    m_walltime_limit = walltime_limit;
+    m_preempt_signals = signals;
+    }
+
+/*! \param last_step True on the last step of the run
+
+    With domain decomposition, the ranks must stop on the same step. A non-blocking reduction of the flags of all
+    ranks overlaps with the next step, so the run stops one step after the first rank meets the condition.
+
+    \returns True when the run should stop
+*/
+bool System::checkPreemption(bool last_step)
+    {
+    int preempt = g_preempt_recvd
+        || (m_walltime_limit > 0 && double(m_clk.getTime()) / 1e9 >= m_walltime_limit);
+
+    #ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        preempt = 0;
+        if (m_preempt_request != MPI_REQUEST_NULL)
+            {
+            MPI_Wait(&m_preempt_request, MPI_STATUS_IGNORE);
+            preempt = m_preempt_global;
+            }
+
+        if (!preempt && !last_step)
+            {
+            m_preempt_local = g_preempt_recvd
+                || (m_walltime_limit > 0 && double(m_clk.getTime()) / 1e9 >= m_walltime_limit);
+            MPI_Iallreduce(&m_preempt_local, &m_preempt_global, 1, MPI_INT, MPI_MAX,
+                m_exec_conf->getMPICommunicator(), &m_preempt_request);
+            }
+        }
+    #endif
+
+    return preempt;
+    }
+
+void System::writePreemptionCheckpoint()
+    {
+    for (auto &analyzer_trigger_pair: m_analyzers)
+        {
+        if (analyzer_trigger_pair.first == m_preempt_checkpoint && (*analyzer_trigger_pair.second)(m_cur_tstep))
+            return;
+        }
+
+    m_preempt_checkpoint->analyze(m_cur_tstep);
+    }
+
+void System::resetStepTimes()
+    {
+    m_step_time_hist.fill(0);
+    m_num_step_times = 0;
+    m_max_step_time = 0;
+    m_phase_time.fill(0);
+    }
+
+/*! \param start Time at the start of the step
+    \param updated Time after the tuners and updaters
+    \param integrated Time after the integrator
+    \param end Time at the end of the step
+
+    The step time goes into the histogram bin floor(bins_per_decade*log10(t / 1 us)), clamped to the range of the
+    histogram.
+*/
+void System::recordStepTime(int64_t start, int64_t updated, int64_t integrated, int64_t end)
+    {
+    m_phase_time[0] += updated - start;
+    m_phase_time[1] += integrated - updated;
+    m_phase_time[2] += end - integrated;
+
+    double t = double(end - start) / 1e9;
+    m_max_step_time = std::max(m_max_step_time, t);
+
+    int bin = 0;
+    if (t > 1e-6)
+        bin = int(std::floor(step_time_bins_per_decade * std::log10(t * 1e6)));
+    bin = std::min(std::max(bin, 0), int(num_step_time_bins) - 1);
+    m_step_time_hist[bin]++;
+    m_num_step_times++;
+    }
+
+/*! The maximum and the mean over the ranks of the time spent in each phase since the last report are found with
+    two collectives, so all ranks must call this method on the same steps. A notice reports the slowest rank of each
+    phase.
+*/
+void System::reportStragglers()
+    {
+    const char *phase_names[num_step_phases] = {"update", "integrate", "analyze"};
+
+    int rank = 0;
+    int num_ranks = 1;
+    #ifdef ENABLE_MPI
+    rank = m_exec_conf->getRank();
+    num_ranks = m_exec_conf->getNRanks();
+    #endif
+
+    struct
+        {
+        double time;
+        int rank;
+        } max_time[num_step_phases];
+    double sum_time[num_step_phases];
+
+    for (unsigned int phase = 0; phase < num_step_phases; ++phase)
+        {
+        max_time[phase].time = double(m_phase_time[phase]) / 1e9;
+        max_time[phase].rank = rank;
+        sum_time[phase] = max_time[phase].time;
+        }
+
+    #ifdef ENABLE_MPI
+    if (num_ranks > 1)
+        {
+        MPI_Allreduce(MPI_IN_PLACE, max_time, num_step_phases, MPI_DOUBLE_INT, MPI_MAXLOC,
+            m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, sum_time, num_step_phases, MPI_DOUBLE, MPI_SUM,
+            m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    m_exec_conf->msg->notice(2) << "Step " << m_cur_tstep << ", slowest rank per phase:";
+    for (unsigned int phase = 0; phase < num_step_phases; ++phase)
+        {
+        m_straggler_max_time[phase] = max_time[phase].time;
+        m_straggler_rank[phase] = max_time[phase].rank;
+        m_straggler_mean_time[phase] = sum_time[phase] / num_ranks;
+        m_exec_conf->msg->notice(2) << " " << phase_names[phase] << " " << m_straggler_max_time[phase]
+                                    << " s on rank " << m_straggler_rank[phase]
+                                    << " (mean " << m_straggler_mean_time[phase] << " s)";
+        }
+    m_exec_conf->msg->notice(2) << std::endl;
+
+    m_phase_time.fill(0);
+    m_straggler_step = m_cur_tstep;
+    }
+
+/*! The percentiles are read from a histogram with 20 logarithmic bins per decade, which resolves them to about 12%.
+    Each is the geometric center of the bin that holds it. The times are for this rank.
+*/
+pybind11::dict System::getStepTimes() const
+    {
+    const double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+    const char *names[] = {"p50", "p90", "p99", "p99.9"};
+
+    pybind11::dict result;
+    result["steps"] = m_num_step_times;
+    result["max"] = m_max_step_time;
+
+    uint64_t cumulative = 0;
+    unsigned int bin = 0;
+    for (unsigned int i = 0; i < 4; ++i)
+        {
+        if (m_num_step_times == 0)
+            {
+            result[names[i]] = 0.0;
+            continue;
+            }
+
+        // the smallest bin that holds at least the fraction of the steps
+        uint64_t count = uint64_t(std::ceil(quantiles[i] * double(m_num_step_times)));
+        while (cumulative + m_step_time_hist[bin] < count)
+            cumulative += m_step_time_hist[bin++];
+
+        double t = 1e-6 * std::pow(10.0, (double(bin) + 0.5) / step_time_bins_per_decade);
+        result[names[i]] = std::min(t, m_max_step_time);
+        }
+    return result;
+    }
+
+/*! \returns A dict with the keys "step" and one dict per phase with the keys "max_time", "rank", and "mean_time",
+    or None when no report was made.
+*/
+pybind11::object System::getStragglerReport() const
+    {
+    if (m_straggler_step == 0)
+        return pybind11::none();
+
+    const char *phase_names[num_step_phases] = {"update", "integrate", "analyze"};
+
+    pybind11::dict result;
+    result["step"] = m_straggler_step;
+    for (unsigned int phase = 0; phase < num_step_phases; ++phase)
+        {
+        pybind11::dict entry;
+        entry["max_time"] = m_straggler_max_time[phase];
+        entry["rank"] = m_straggler_rank[phase];
+        entry["mean_time"] = m_straggler_mean_time[phase];
+        result[phase_names[phase]] = entry;
+        }
+    return result;
+    }
+
 /*! \param enable Set to true to enable profiling during calls to run()
+    \param sync Set to false to profile without synchronizing the GPUs
 */
-void System::enableProfiler(bool enable)
+void System::enableProfiler(bool enable, bool sync)
     {
     m_profile = enable;
+    m_profile_sync = sync;
     }
 
 /*! \param logger Logger to register computes and updaters with
@@ -248,9 +529,19 @@ void System::setAutotunerParams(bool enabled, unsigned int period)
 void System::setupProfiling()
     {
     if (m_profile)
+        {
+        // start the clocks of all ranks together so that their traces line up
+        #ifdef ENABLE_MPI
+        if (m_exec_conf->getNRanks() > 1)
+            MPI_Barrier(m_exec_conf->getMPICommunicator());
+        #endif
         m_profiler = std::shared_ptr<Profiler>(new Profiler("Simulation"));
+        m_profiler->setSync(m_profile_sync);
+        }
     else
+        {
         m_profiler = std::shared_ptr<Profiler>();
+        }
 
     // set the profiler on everything
     if (m_integrator)
@@ -309,11 +600,52 @@ void System::resetStats()
     The flags needed are determined by peeking to \a tstep and then using bitwise or to combine all of the flags from the
     analyzers and updaters that are to be executed on that step.
 */
-PDataFlags System::determineFlags(unsigned int tstep)
+/*! \returns The flags that the integrator and the defaults request on every step
+*/
+PDataFlags System::determineBaseFlags()
     {
     PDataFlags flags = m_default_flags;
     if (m_integrator)
         flags |= m_integrator->getRequestedPDataFlags();
+    return flags;
+    }
+
+/*! \param tstep Time step on which the analyzers run
+
+    Each analyzer would otherwise copy the arrays it reads one after the other when it acquires them, waiting for
+    every copy. The arrays requested by all analyzers triggered on \a tstep are copied together instead.
+*/
+void System::prefetchHostArrays(unsigned int tstep)
+    {
+    HostArrays arrays;
+    for (auto &analyzer_trigger_pair: m_analyzers)
+        {
+        if ((*analyzer_trigger_pair.second)(tstep))
+            arrays |= analyzer_trigger_pair.first->getRequestedHostArrays();
+        }
+    m_sysdef->getParticleData()->prefetchHostArrays(arrays);
+    }
+
+/*! Sets m_next_update to the first step, starting at the current one, on which a tuner or updater may run and
+    m_next_analyze to the first step after the current one on which an analyzer may run. run() skips the operations
+    of the steps in between without evaluating their triggers.
+*/
+void System::updateNextActive()
+    {
+    m_next_update = Trigger::never();
+    for (auto &tuner: m_tuners)
+        m_next_update = std::min(m_next_update, tuner->getTrigger()->nextActive(m_cur_tstep));
+    for (auto &updater_trigger_pair: m_updaters)
+        m_next_update = std::min(m_next_update, updater_trigger_pair.second->nextActive(m_cur_tstep));
+
+    m_next_analyze = Trigger::never();
+    for (auto &analyzer_trigger_pair: m_analyzers)
+        m_next_analyze = std::min(m_next_analyze, analyzer_trigger_pair.second->nextActive(m_cur_tstep+1));
+    }
+
+PDataFlags System::determineFlags(unsigned int tstep)
+    {
+    PDataFlags flags = determineBaseFlags();
 
     for (auto &analyzer_trigger_pair: m_analyzers)
         {
@@ -353,15 +685,24 @@ void export_System(py::module& m)
 
     .def("registerLogger", &System::registerLogger)
     .def("setAutotunerParams", &System::setAutotunerParams)
-    .def("enableProfiler", &System::enableProfiler)
+    .def("enableProfiler", &System::enableProfiler, py::arg("enable"), py::arg("sync")=true)
+    .def("getProfiler", &System::getProfiler)
     .def("run", &System::run)
+    .def("runWithoutGIL", &System::runWithoutGIL)
 
     .def("getLastTPS", &System::getLastTPS)
     .def("getCurrentTimeStep", &System::getCurrentTimeStep)
     .def("setPressureFlag", &System::setPressureFlag)
     .def("getPressureFlag", &System::getPressureFlag)
+    .def("setEnergyFlag", &System::setEnergyFlag)
+    .def("getEnergyFlag", &System::getEnergyFlag)
     .def_property_readonly("walltime", &System::getCurrentWalltime)
     .def_property_readonly("final_timestep", &System::getEndStep)
+    .def("getStepTimes", &System::getStepTimes)
+    .def("getStragglerReport", &System::getStragglerReport)
+    .def_property("straggler_period", &System::getStragglerPeriod, &System::setStragglerPeriod)
+    .def("setPreemption", &System::setPreemption)
+    .def_property_readonly("preempted", &System::getPreempted)
     .def_property_readonly("analyzers", &System::getAnalyzers)
     .def_property_readonly("updaters", &System::getUpdaters)
     .def_property_readonly("tuners", &System::getTuners)
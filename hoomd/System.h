@@ -15,6 +15,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <array>
 
 #ifndef __SYSTEM_H__
 #define __SYSTEM_H__
@@ -101,8 +102,23 @@ class PYBIND11_EXPORT System
         */
         void run(unsigned int nsteps, bool write_at_start=false);
 
+        //! Runs the simulation with the GIL released
+        /*! @param nsteps Number of steps to advance the simulation
+            @param write_at_start Set to true to evaluate writers before the
+                loop
+        */
+        void runWithoutGIL(unsigned int nsteps, bool write_at_start=false);
+
         //! Configures profiling of runs
-        void enableProfiler(bool enable);
+        void enableProfiler(bool enable, bool sync=true);
+
+        //! Get the profiler of the current or last profiled run
+        /*! \returns The profiler, or a null pointer when the last run was not profiled
+        */
+        std::shared_ptr<Profiler> getProfiler() const
+            {
+            return m_profiler;
+            }
 
         //! Register logger
         void registerLogger(std::shared_ptr<Logger> logger);
@@ -131,6 +147,33 @@ class PYBIND11_EXPORT System
             return m_end_tstep;
             }
 
+        /// Get percentiles of the wall time of the steps in the current or last run
+        pybind11::dict getStepTimes() const;
+
+        /// Set the number of steps between reports of the slowest rank per phase, 0 to disable
+        void setStragglerPeriod(unsigned int period)
+            {
+            m_straggler_period = period;
+            }
+
+        /// Get the number of steps between reports of the slowest rank per phase
+        unsigned int getStragglerPeriod() const
+            {
+            return m_straggler_period;
+            }
+
+        /// Get the last report of the slowest rank per phase
+        pybind11::object getStragglerReport() const;
+
+        /// Set the checkpoint writer and the conditions that end a run early before the job is stopped
+        void setPreemption(std::shared_ptr<Analyzer> checkpoint, double walltime_limit, bool signals);
+
+        /// Test if the last run ended early to write a checkpoint
+        bool getPreempted() const
+            {
+            return m_preempted;
+            }
+
         // -------------- Misc methods
 
         //! Get the system definition
@@ -174,6 +217,18 @@ class PYBIND11_EXPORT System
             return m_default_flags[pdata_flag::pressure_tensor];
             }
 
+        /// Set potential energy computation particle data flag
+        void setEnergyFlag(bool flag)
+            {
+            m_default_flags[pdata_flag::potential_energy] = flag;
+            }
+
+        /// Get the potential energy computation particle data flag
+        bool getEnergyFlag()
+            {
+            return m_default_flags[pdata_flag::potential_energy];
+            }
+
     private:
         std::vector<std::pair<std::shared_ptr<Analyzer>,
                     std::shared_ptr<Trigger> > > m_analyzers; //!< List of analyzers belonging to this System
@@ -199,10 +254,17 @@ class PYBIND11_EXPORT System
         ClockSource m_clk;              //!< A clock counting time from the beginning of the run
 
         bool m_profile;         //!< True if runs should be profiled
+        bool m_profile_sync;    //!< True if the profiler should synchronize the GPUs
 
         /// Particle data flags to always set
         PDataFlags m_default_flags;
 
+        /// First step on which a tuner or updater may run
+        uint64_t m_next_update = 0;
+
+        /// First step on which an analyzer may run
+        uint64_t m_next_analyze = 0;
+
         // --------- Steps in the simulation run implemented in helper functions
         //! Sets up m_profiler and attaches/detaches to/from all computes, updaters, and analyzers
         void setupProfiling();
@@ -213,6 +275,15 @@ class PYBIND11_EXPORT System
         //! Get the flags needed for a particular step
         PDataFlags determineFlags(unsigned int tstep);
 
+        //! Copy the particle data that the analyzers triggered on a step read on the host
+        void prefetchHostArrays(unsigned int tstep);
+
+        //! Get the flags needed on steps without operations
+        PDataFlags determineBaseFlags();
+
+        //! Look ahead to the next steps on which the operations may run
+        void updateNextActive();
+
         /// Record the initial time of the last run
         int64_t m_initial_time=0;
 
@@ -223,7 +294,81 @@ class PYBIND11_EXPORT System
         double m_last_walltime=0;
 
         /// Update the TPS average
-        void updateTPS();
+        void updateTPS(int64_t now);
+
+        /// Number of histogram bins per decade of step time
+        static const unsigned int step_time_bins_per_decade = 20;
+
+        /// Number of histogram bins, covering 1 microsecond to 1000 seconds
+        static const unsigned int num_step_time_bins = 9*step_time_bins_per_decade;
+
+        /// Phases of a step timed for the straggler report: tuners and updaters, integrator, analyzers
+        static const unsigned int num_step_phases = 3;
+
+        /// Histogram of the wall times of the steps in the current run
+        std::array<unsigned int, num_step_time_bins> m_step_time_hist;
+
+        /// Number of steps recorded in the histogram
+        uint64_t m_num_step_times = 0;
+
+        /// Longest step of the current run [seconds]
+        double m_max_step_time = 0;
+
+        /// Number of steps between straggler reports, 0 when disabled
+        unsigned int m_straggler_period = 0;
+
+        /// Time spent in each phase on this rank since the last straggler report [ns]
+        std::array<int64_t, num_step_phases> m_phase_time;
+
+        /// Longest time of each phase over all ranks in the last report [seconds]
+        std::array<double, num_step_phases> m_straggler_max_time;
+
+        /// Mean time of each phase over all ranks in the last report [seconds]
+        std::array<double, num_step_phases> m_straggler_mean_time;
+
+        /// Rank with the longest time of each phase in the last report
+        std::array<int, num_step_phases> m_straggler_rank;
+
+        /// Time step of the last straggler report, 0 when none was made
+        uint64_t m_straggler_step = 0;
+
+        /// Reset the step time statistics at the start of a run
+        void resetStepTimes();
+
+        /// Record the phase times of one step
+        void recordStepTime(int64_t start, int64_t updated, int64_t integrated, int64_t end);
+
+        /// Find the slowest rank of each phase since the last report
+        void reportStragglers();
+
+        /// Writer of the checkpoint when the run is preempted, null when disabled
+        std::shared_ptr<Analyzer> m_preempt_checkpoint;
+
+        /// Wall time since construction at which to preempt the run [seconds], 0 for no limit
+        double m_walltime_limit = 0;
+
+        /// True when SIGUSR1 and SIGTERM preempt the run
+        bool m_preempt_signals = false;
+
+        /// True when the last run was preempted
+        bool m_preempted = false;
+
+        #ifdef ENABLE_MPI
+        /// Request of the reduction of the preemption flags over the ranks
+        MPI_Request m_preempt_request = MPI_REQUEST_NULL;
+
+        /// Preemption flag of this rank, sent by the reduction
+        int m_preempt_local = 0;
+
+        /// Preemption flag of any rank, received by the reduction
+        int m_preempt_global = 0;
+        #endif
+
+        /// Test if the run should stop to write the checkpoint
+        bool checkPreemption(bool last_step);
+
+        /// Write the preemption checkpoint unless its trigger wrote it on this step
+        void writePreemptionCheckpoint();
 
         std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Stored shared ptr to the execution configuration
     };
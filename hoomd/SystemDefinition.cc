@@ -11,6 +11,7 @@
 #include "SystemDefinition.h"
 
 #include "SnapshotSystemData.h"
+#include "ParticleGroup.h"
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
@@ -115,6 +116,50 @@ void SystemDefinition::setNDimensions(unsigned int n_dimensions)
     m_n_dimensions = n_dimensions;
     }
 
+/*! \param filter Filter that selects the particles
+    \returns The group of the particles selected by \a filter
+
+    Groups are cached by the identity of the filter object. When a group for \a filter is still in use, it is returned
+    instead of evaluating the filter again, so all operations on the same filter share one index list.
+*/
+std::shared_ptr<ParticleGroup> SystemDefinition::getGroup(std::shared_ptr<ParticleFilter> filter)
+    {
+    auto it = m_groups.find(filter.get());
+    if (it != m_groups.end())
+        {
+        std::shared_ptr<ParticleGroup> group = it->second.lock();
+        if (group)
+            return group;
+        }
+
+    // drop the entries of groups that are no longer in use
+    for (auto entry = m_groups.begin(); entry != m_groups.end();)
+        {
+        if (entry->second.expired())
+            entry = m_groups.erase(entry);
+        else
+            ++entry;
+        }
+
+    std::shared_ptr<ParticleGroup> group(new ParticleGroup(shared_from_this(), filter));
+    m_groups[filter.get()] = group;
+    return group;
+    }
+
+/*! \returns The groups created by getGroup() that are still in use
+*/
+std::vector< std::shared_ptr<ParticleGroup> > SystemDefinition::getGroups()
+    {
+    std::vector< std::shared_ptr<ParticleGroup> > groups;
+    for (auto entry = m_groups.begin(); entry != m_groups.end(); ++entry)
+        {
+        std::shared_ptr<ParticleGroup> group = entry->second.lock();
+        if (group)
+            groups.push_back(group);
+        }
+    return groups;
+    }
+
 /*! \param particles True if particle data should be saved
  *  \param bonds True if bond data should be saved
  *  \param angles True if angle data should be saved
@@ -167,6 +212,49 @@ void SystemDefinition::initializeFromSnapshot(std::shared_ptr< SnapshotSystemDat
     m_pair_data->initializeFromSnapshot(snapshot->pair_data);
     }
 
+/*! \param checkpoint Checkpoint to copy the state to
+
+    The arrays of a checkpoint that is taken repeatedly are reused.
+*/
+void SystemDefinition::takeCheckpoint(std::shared_ptr<SystemCheckpoint> checkpoint)
+    {
+    checkpoint->dimensions = m_n_dimensions;
+    m_particle_data->takeCheckpoint(checkpoint->particle_data);
+    m_bond_data->takeCheckpoint(checkpoint->bond_data);
+    m_angle_data->takeCheckpoint(checkpoint->angle_data);
+    m_dihedral_data->takeCheckpoint(checkpoint->dihedral_data);
+    m_improper_data->takeCheckpoint(checkpoint->improper_data);
+    m_constraint_data->takeCheckpoint(checkpoint->constraint_data);
+    m_pair_data->takeCheckpoint(checkpoint->pair_data);
+
+    checkpoint->integrator_variables.resize(m_integrator_data->getNumIntegrators());
+    for (unsigned int i = 0; i < m_integrator_data->getNumIntegrators(); i++)
+        checkpoint->integrator_variables[i] = m_integrator_data->getIntegratorVariables(i);
+    }
+
+/*! \param checkpoint Checkpoint taken by takeCheckpoint()
+
+    Particles and bonded groups may not be added or removed between taking and restoring the checkpoint. Integrators
+    that registered after the checkpoint was taken keep their variables. In parallel simulations, this method is
+    collective.
+*/
+void SystemDefinition::restoreCheckpoint(std::shared_ptr<SystemCheckpoint> checkpoint)
+    {
+    m_n_dimensions = checkpoint->dimensions;
+    m_particle_data->restoreCheckpoint(checkpoint->particle_data);
+    m_bond_data->restoreCheckpoint(checkpoint->bond_data);
+    m_angle_data->restoreCheckpoint(checkpoint->angle_data);
+    m_dihedral_data->restoreCheckpoint(checkpoint->dihedral_data);
+    m_improper_data->restoreCheckpoint(checkpoint->improper_data);
+    m_constraint_data->restoreCheckpoint(checkpoint->constraint_data);
+    m_pair_data->restoreCheckpoint(checkpoint->pair_data);
+
+    unsigned int n = std::min((unsigned int)checkpoint->integrator_variables.size(),
+                              m_integrator_data->getNumIntegrators());
+    for (unsigned int i = 0; i < n; i++)
+        m_integrator_data->setIntegratorVariables(i, checkpoint->integrator_variables[i]);
+    }
+
 // instantiate both float and double methods
 template SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<float> > snapshot,
                                                    std::shared_ptr<ExecutionConfiguration> exec_conf,
@@ -200,9 +288,18 @@ void export_SystemDefinition(py::module& m)
     .def("getConstraintData", &SystemDefinition::getConstraintData)
     .def("getIntegratorData", &SystemDefinition::getIntegratorData)
     .def("getPairData", &SystemDefinition::getPairData)
+    .def("getGroup", &SystemDefinition::getGroup)
+    .def("getGroups", &SystemDefinition::getGroups)
     .def("takeSnapshot_float", &SystemDefinition::takeSnapshot<float>)
     .def("takeSnapshot_double", &SystemDefinition::takeSnapshot<double>)
     .def("initializeFromSnapshot", &SystemDefinition::initializeFromSnapshot<float>)
     .def("initializeFromSnapshot", &SystemDefinition::initializeFromSnapshot<double>)
+    .def("takeCheckpoint", &SystemDefinition::takeCheckpoint)
+    .def("restoreCheckpoint", &SystemDefinition::restoreCheckpoint)
+    ;
+
+    py::class_<SystemCheckpoint, std::shared_ptr<SystemCheckpoint> >(m, "SystemCheckpoint")
+    .def(py::init<>())
+    .def_property_readonly("N", [](const SystemCheckpoint& checkpoint) { return checkpoint.particle_data.N; })
     ;
     }
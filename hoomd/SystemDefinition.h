@@ -17,6 +17,8 @@
 #include "BondedGroupData.h"
 
 #include <memory>
+#include <unordered_map>
+#include <vector>
 #include <pybind11/pybind11.h>
 
 
@@ -32,6 +34,31 @@ class Communicator;
 //! Forward declaration of SnapshotSystemData
 template <class Real> struct SnapshotSystemData;
 
+//! Forward declarations for the group cache
+class ParticleGroup;
+class ParticleFilter;
+
+//! Copy of the local system state that SystemDefinition restores in place
+/*! SystemDefinition::takeCheckpoint() copies the particles, bonded groups, and integrator variables into the
+    checkpoint without a gather on the root rank and, on the GPU, without copies to the host.
+    SystemDefinition::restoreCheckpoint() copies them back into the existing arrays. Rare event and ensemble methods
+    use this to reset a simulation to an earlier state many times. The time step is not part of the checkpoint.
+
+    \ingroup data_structs
+*/
+struct PYBIND11_EXPORT SystemCheckpoint
+    {
+    ParticleDataCheckpoint particle_data;                   //!< Particles
+    BondData::Checkpoint bond_data;                         //!< Bonds
+    AngleData::Checkpoint angle_data;                       //!< Angles
+    DihedralData::Checkpoint dihedral_data;                 //!< Dihedrals
+    ImproperData::Checkpoint improper_data;                 //!< Impropers
+    ConstraintData::Checkpoint constraint_data;             //!< Constraints
+    PairData::Checkpoint pair_data;                         //!< Special pairs
+    std::vector<IntegratorVariables> integrator_variables;  //!< Variables of the registered integrators
+    unsigned int dimensions = 0;                            //!< Dimensionality of the system
+    };
+
 //! Container class for all data needed to define the MD system
 /*! SystemDefinition is a big bucket where all of the data defining the MD system goes.
     Everything is stored as a shared pointer for quick and easy access from within C++
@@ -67,9 +94,15 @@ template <class Real> struct SnapshotSystemData;
     Several other default constructors are provided, mainly to provide backward compatibility to unit tests that
     relied on the simple initialization constructors provided by ParticleData.
 
+    <b>Groups</b>
+
+    getGroup() returns the ParticleGroup for a filter, and every caller that passes the same filter object shares one
+    group, with one index list and one GPU buffer. The cache only holds weak references: a group is freed when the
+    last operation that uses it releases it, and getGroup() builds a new one on the next request.
+
     \ingroup data_structs
 */
-class PYBIND11_EXPORT SystemDefinition
+class PYBIND11_EXPORT SystemDefinition : public std::enable_shared_from_this<SystemDefinition>
     {
     public:
         //! Constructs a NULL SystemDefinition
@@ -143,6 +176,12 @@ class PYBIND11_EXPORT SystemDefinition
             return m_pair_data;
             }
 
+        //! Get the shared group of the particles selected by a filter
+        std::shared_ptr<ParticleGroup> getGroup(std::shared_ptr<ParticleFilter> filter);
+
+        //! Get all groups in the cache that are still in use
+        std::vector< std::shared_ptr<ParticleGroup> > getGroups();
+
         //! Return a snapshot of the current system data
         template <class Real>
         std::shared_ptr< SnapshotSystemData<Real> > takeSnapshot();
@@ -151,6 +190,12 @@ class PYBIND11_EXPORT SystemDefinition
         template <class Real>
         void initializeFromSnapshot(std::shared_ptr< SnapshotSystemData<Real> > snapshot);
 
+        //! Copy the local system state into a checkpoint
+        void takeCheckpoint(std::shared_ptr<SystemCheckpoint> checkpoint);
+
+        //! Restore the local system state from a checkpoint
+        void restoreCheckpoint(std::shared_ptr<SystemCheckpoint> checkpoint);
+
     private:
         unsigned int m_n_dimensions;                        //!< Dimensionality of the system
         std::shared_ptr<ParticleData> m_particle_data;    //!< Particle data for the system
@@ -161,6 +206,9 @@ class PYBIND11_EXPORT SystemDefinition
         std::shared_ptr<ConstraintData> m_constraint_data;//!< Improper data for the system
         std::shared_ptr<IntegratorData> m_integrator_data;    //!< Integrator data for the system
         std::shared_ptr<PairData> m_pair_data;            //!< Special pairs data for the system
+
+        //! Groups by filter, not owned
+        std::unordered_map< const ParticleFilter *, std::weak_ptr<ParticleGroup> > m_groups;
     };
 
 //! Exports SystemDefinition to python
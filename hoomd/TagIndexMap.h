@@ -0,0 +1,174 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __TAG_INDEX_MAP_H__
+#define __TAG_INDEX_MAP_H__
+
+/*! \file TagIndexMap.h
+    \brief Defines an open addressing hash map from particle tags to indices
+    \details The lookup tag_index_map_find() can be called on the host and on the device. The map itself is only built
+    on the host.
+*/
+
+#include "HOOMDMath.h"
+
+#ifndef __HIPCC__
+#include "GlobalArray.h"
+#endif
+
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+//! Key of an empty slot, and the value returned for tags that are not in the map
+const unsigned int TAG_INDEX_MAP_EMPTY = 0xffffffff;
+
+//! Hash a tag to a slot
+/*! \param tag Tag to hash
+    \param mask Number of slots minus one, the number of slots is a power of two
+*/
+HOSTDEVICE inline unsigned int tag_index_map_slot(unsigned int tag, unsigned int mask)
+    {
+    // consecutive tags are common, spread them with a multiplicative hash
+    unsigned int h = tag * 0x9e3779b1u;
+    h ^= h >> 16;
+    return h & mask;
+    }
+
+//! Look up a tag
+/*! \param d_table Slots of the map, (tag, value) pairs
+    \param mask Number of slots minus one
+    \param tag Tag to look up
+    \returns The value stored for \a tag, or TAG_INDEX_MAP_EMPTY when \a tag is not in the map
+*/
+HOSTDEVICE inline unsigned int tag_index_map_find(const uint2 *d_table, unsigned int mask, unsigned int tag)
+    {
+    if (d_table == NULL)
+        return TAG_INDEX_MAP_EMPTY;
+
+    // linear probing, the map is at most half full so there always is an empty slot
+    unsigned int slot = tag_index_map_slot(tag, mask);
+    while (true)
+        {
+        uint2 entry = d_table[slot];
+        if (entry.x == tag)
+            return entry.y;
+        if (entry.x == TAG_INDEX_MAP_EMPTY)
+            return TAG_INDEX_MAP_EMPTY;
+        slot = (slot + 1) & mask;
+        }
+    }
+
+#ifndef __HIPCC__
+//! Open addressing hash map from particle tags to indices
+/*! A dense lookup table indexed by tag, such as the reverse tag lookup of ParticleData, needs memory proportional to
+    the largest tag. When only few of the tags are looked up, for example the members of a small group, or when tags
+    are sparse after many particles were inserted and removed, TagIndexMap needs memory proportional to the number of
+    stored tags instead.
+
+    The map is built from a list of tags with build(). It stores (tag, value) pairs in a power of two number of slots,
+    at most half of them occupied, and resolves collisions by linear probing. The slots are kept in a GlobalArray, so
+    kernels look up tags with tag_index_map_find() on the device pointer and getMask().
+
+    \ingroup data_structs
+*/
+class TagIndexMap
+    {
+    public:
+        //! Constructs an empty map
+        TagIndexMap() : m_mask(0), m_size(0) {}
+
+        //! Constructs an empty map
+        /*! \param exec_conf Execution configuration to allocate the slots with
+        */
+        TagIndexMap(std::shared_ptr<const ExecutionConfiguration> exec_conf)
+            : m_exec_conf(exec_conf), m_mask(0), m_size(0)
+            {
+            }
+
+        //! Rebuild the map from a list of tags
+        /*! \param tags Tags to store, each at most once
+            \param n Number of tags
+            \param values Value to store for each tag, or NULL to store the position of the tag in \a tags
+
+            The slots are only reallocated when the number of slots changes.
+        */
+        void build(const unsigned int *tags, unsigned int n, const unsigned int *values = NULL)
+            {
+            // at least twice as many slots as tags
+            unsigned int num_slots = 16;
+            while (num_slots < 2*n)
+                num_slots *= 2;
+
+            if (m_table.getNumElements() != num_slots)
+                {
+                GlobalArray<uint2> table(num_slots, m_exec_conf);
+                m_table.swap(table);
+                TAG_ALLOCATION(m_table);
+                }
+            m_mask = num_slots - 1;
+            m_size = n;
+
+            ArrayHandle<uint2> h_table(m_table, access_location::host, access_mode::overwrite);
+            for (unsigned int slot = 0; slot < num_slots; slot++)
+                h_table.data[slot] = make_uint2(TAG_INDEX_MAP_EMPTY, TAG_INDEX_MAP_EMPTY);
+
+            for (unsigned int i = 0; i < n; i++)
+                {
+                unsigned int tag = tags[i];
+                unsigned int slot = tag_index_map_slot(tag, m_mask);
+                while (h_table.data[slot].x != TAG_INDEX_MAP_EMPTY && h_table.data[slot].x != tag)
+                    slot = (slot + 1) & m_mask;
+                h_table.data[slot] = make_uint2(tag, values ? values[i] : i);
+                }
+            }
+
+        //! Release the slots
+        void clear()
+            {
+            GlobalArray<uint2> table;
+            m_table.swap(table);
+            m_mask = 0;
+            m_size = 0;
+            }
+
+        //! Get the slots for lookups with tag_index_map_find()
+        const GlobalArray<uint2>& getTable() const
+            {
+            return m_table;
+            }
+
+        //! Get the number of slots minus one
+        unsigned int getMask() const
+            {
+            return m_mask;
+            }
+
+        //! Get the number of stored tags
+        unsigned int size() const
+            {
+            return m_size;
+            }
+
+        //! Get the number of bytes needed to store \a n tags
+        static size_t getMemoryFootprint(unsigned int n)
+            {
+            size_t num_slots = 16;
+            while (num_slots < 2*size_t(n))
+                num_slots *= 2;
+            return num_slots*sizeof(uint2);
+            }
+
+    private:
+        std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration
+        GlobalArray<uint2> m_table; //!< (tag, value) pairs, TAG_INDEX_MAP_EMPTY marks empty slots
+        unsigned int m_mask;        //!< Number of slots minus one
+        unsigned int m_size;        //!< Number of stored tags
+    };
+#endif
+
+#undef HOSTDEVICE
+#endif // __TAG_INDEX_MAP_H__
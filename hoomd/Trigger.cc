@@ -11,6 +11,12 @@ bool testTriggerCall(std::shared_ptr<Trigger> t, uint64_t step)
     return (*t)(step);
     }
 
+//* Method to enable unit testing of the trigger lookahead from pytest
+uint64_t testTriggerNextActive(std::shared_ptr<Trigger> t, uint64_t step)
+    {
+    return t->nextActive(step);
+    }
+
 //* Trampoline for classes inherited in python
 class TriggerPy : public Trigger
     {
@@ -121,5 +127,22 @@ void export_Trigger(pybind11::module& m)
              pybind11::arg("triggers"))
         ;
 
+    pybind11::class_<ExpressionTrigger, Trigger,
+                     std::shared_ptr<ExpressionTrigger> >(m, "ExpressionTrigger")
+        .def(pybind11::init<const std::string&>(),
+             pybind11::arg("expression"))
+        .def_property_readonly("expression", &ExpressionTrigger::getExpression)
+        .def(pybind11::pickle(
+            [](const ExpressionTrigger& trigger)
+                {
+                return pybind11::make_tuple(trigger.getExpression());
+                },
+            [](pybind11::tuple params)
+                {
+                return ExpressionTrigger(params[0].cast<std::string>());
+                }))
+        ;
+
     m.def("_test_trigger_call", &testTriggerCall);
+    m.def("_test_trigger_next_active", &testTriggerNextActive);
     }
@@ -4,12 +4,15 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
 #include <pybind11/pybind11.h>
 #include <algorithm>
 #include <memory>
 #include <vector>
 #include <pybind11/iostream.h>
 
+#include "Expression.h"
+
 /** Defines on what time steps operations should be performed
  *
  *  System schedules Analyzer and Updater instances to be executed only on specific time steps.
@@ -47,6 +50,26 @@ class PYBIND11_EXPORT Trigger
 
         virtual bool compute(uint64_t timestep) = 0;
 
+        /** Look ahead to the next time step on which the trigger may be active
+         *
+         *  @param timestep First time step to consider
+         *  @returns A time step s >= *timestep* such that the trigger is not active on any step in [timestep, s),
+         *           or never() when it is not active on any later step
+         *
+         *  System skips the operations of the steps before s without evaluating their triggers. The default
+         *  returns *timestep*, so triggers defined in Python are evaluated on every step.
+        */
+        virtual uint64_t nextActive(uint64_t timestep)
+            {
+            return timestep;
+            }
+
+        /// Value of nextActive() for triggers that are never active again
+        static uint64_t never()
+            {
+            return std::numeric_limits<uint64_t>::max();
+            }
+
     private:
             /// Caches the last time step at which the trigger was computed
             uint64_t m_last_timestep;
@@ -77,6 +100,17 @@ class PYBIND11_EXPORT PeriodicTrigger : public Trigger
             return (timestep - m_phase) % m_period == 0;
             }
 
+        uint64_t nextActive(uint64_t timestep)
+            {
+            uint64_t remainder = (timestep - m_phase) % m_period;
+            uint64_t next = remainder == 0 ? timestep : timestep + (m_period - remainder);
+
+            // before the phase, the difference wraps around and the trigger is also active on the phase
+            if (timestep < m_phase)
+                next = std::min(next, m_phase);
+            return next;
+            }
+
         /// Set the period
         void setPeriod(uint64_t period)
             {
@@ -123,6 +157,11 @@ class PYBIND11_EXPORT BeforeTrigger : public Trigger
         return timestep < m_timestep;
         }
 
+    uint64_t nextActive(uint64_t timestep)
+        {
+        return timestep < m_timestep ? timestep : never();
+        }
+
     /// Get the timestep before which the trigger is active.
     uint64_t getTimestep() const {return m_timestep;} const
 
@@ -148,6 +187,11 @@ class PYBIND11_EXPORT OnTrigger : public Trigger
         return timestep == m_timestep;
         }
 
+    uint64_t nextActive(uint64_t timestep)
+        {
+        return timestep <= m_timestep ? m_timestep : never();
+        }
+
     /// Get the timestep when the trigger is active.
     uint64_t getTimestep() const {return m_timestep;} const
 
@@ -173,6 +217,11 @@ class PYBIND11_EXPORT AfterTrigger : public Trigger
         return timestep > m_timestep;
         }
 
+    uint64_t nextActive(uint64_t timestep)
+        {
+        return timestep > m_timestep ? timestep : m_timestep + 1;
+        }
+
     /// Get the timestep after which the trigger is active.
     uint64_t getTimestep() const {return m_timestep;} const
 
@@ -198,6 +247,12 @@ class PYBIND11_EXPORT NotTrigger : public Trigger
             return !(m_trigger->operator()(timestep));
             }
 
+        /// Active on *timestep* when the negated trigger is not, otherwise check the following step
+        uint64_t nextActive(uint64_t timestep)
+            {
+            return m_trigger->nextActive(timestep) > timestep ? timestep : timestep + 1;
+            }
+
         /// Get the trigger that is negated
         std::shared_ptr<Trigger> getTrigger() const {return m_trigger;}
 
@@ -237,6 +292,15 @@ class PYBIND11_EXPORT AndTrigger : public Trigger
                     });
             }
 
+        /// Not active before all triggers may be active
+        uint64_t nextActive(uint64_t timestep)
+            {
+            uint64_t next = timestep;
+            for (auto t: m_triggers)
+                next = std::max(next, t->nextActive(timestep));
+            return next;
+            }
+
         const std::vector<std::shared_ptr<Trigger> >& getTriggers() const
             {
             return m_triggers;
@@ -276,6 +340,15 @@ class PYBIND11_EXPORT OrTrigger : public Trigger
                     });
             }
 
+        /// Not active before any trigger may be active
+        uint64_t nextActive(uint64_t timestep)
+            {
+            uint64_t next = never();
+            for (auto t: m_triggers)
+                next = std::min(next, t->nextActive(timestep));
+            return next;
+            }
+
         const std::vector<std::shared_ptr<Trigger> >& getTriggers() const
             {
             return m_triggers;
@@ -286,5 +359,29 @@ class PYBIND11_EXPORT OrTrigger : public Trigger
         std::vector<std::shared_ptr<Trigger> > m_triggers;
     };
 
+/** Expression trigger
+ *
+ *  Active on the time steps where a formula of the time step `t`, compiled by Expression, is nonzero.
+*/
+class PYBIND11_EXPORT ExpressionTrigger : public Trigger
+    {
+    public:
+        ExpressionTrigger(const std::string& expression) : Trigger(), m_expression(expression) {}
+
+        bool compute(uint64_t timestep)
+            {
+            return m_expression(double(timestep)) != 0.0;
+            }
+
+        /// Get the formula
+        std::string getExpression() const {return m_expression.getSource();}
+
+        /// Set the formula
+        void setExpression(const std::string& expression) {m_expression = Expression(expression);}
+
+    protected:
+        Expression m_expression;  /// The compiled formula
+    };
+
 /// Export Trigger classes to Python
 void export_Trigger(pybind11::module& m);
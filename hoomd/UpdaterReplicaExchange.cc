@@ -0,0 +1,226 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "UpdaterReplicaExchange.h"
+#include "RandomNumbers.h"
+#include "RNGIdentifiers.h"
+
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+UpdaterReplicaExchange::UpdaterReplicaExchange(std::shared_ptr<SystemDefinition> sysdef,
+                                               pybind11::list values,
+                                               const std::string& parameter,
+                                               Scalar kT,
+                                               std::shared_ptr<VariantConstant> variant,
+                                               unsigned int seed)
+    : Updater(sysdef), m_parameter(parameter), m_kT(1.0), m_variant(variant), m_seed(seed), m_num_exchanges(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing UpdaterReplicaExchange" << endl;
+
+    if (m_parameter != "kT" && m_parameter != "pressure" && m_parameter != "hamiltonian"
+        && m_parameter != "fugacity")
+        {
+        throw std::domain_error("parameter must be kT, pressure, hamiltonian, or fugacity");
+        }
+
+    for (auto value : values)
+        {
+        m_values.push_back(value.cast<Scalar>());
+        if (m_parameter == "kT" && m_values.back() <= 0)
+            throw std::domain_error("kT values must be positive");
+        }
+
+    unsigned int n_partitions = m_exec_conf->getMPIConfig()->getNPartitions();
+    if (m_values.size() != n_partitions)
+        {
+        throw std::runtime_error("The number of values (" + std::to_string(m_values.size())
+                                 + ") must equal the number of partitions (" + std::to_string(n_partitions) + ")");
+        }
+
+    setKT(kT);
+
+    // replica p starts at value p
+    for (unsigned int p = 0; p < n_partitions; p++)
+        m_index.push_back(p);
+
+    resetStats();
+    applyValue(getValue());
+    }
+
+UpdaterReplicaExchange::~UpdaterReplicaExchange()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying UpdaterReplicaExchange" << endl;
+    }
+
+void UpdaterReplicaExchange::setObservableCompute(std::shared_ptr<Compute> compute, const std::string& quantity)
+    {
+    m_compute = compute;
+    m_integrator.reset();
+    m_quantity = quantity;
+    }
+
+void UpdaterReplicaExchange::setObservableIntegrator(std::shared_ptr<Integrator> integrator,
+                                                     const std::string& quantity)
+    {
+    m_integrator = integrator;
+    m_compute.reset();
+    m_quantity = quantity;
+    }
+
+unsigned int UpdaterReplicaExchange::getIndex()
+    {
+    return m_index[m_exec_conf->getMPIConfig()->getPartition()];
+    }
+
+Scalar UpdaterReplicaExchange::getValue()
+    {
+    return m_values[getIndex()];
+    }
+
+pybind11::list UpdaterReplicaExchange::getValues()
+    {
+    pybind11::list result;
+    for (auto value : m_values)
+        result.append(value);
+    return result;
+    }
+
+pybind11::list UpdaterReplicaExchange::getNumAttempted()
+    {
+    pybind11::list result;
+    for (auto n : m_num_attempted)
+        result.append(n);
+    return result;
+    }
+
+pybind11::list UpdaterReplicaExchange::getNumAccepted()
+    {
+    pybind11::list result;
+    for (auto n : m_num_accepted)
+        result.append(n);
+    return result;
+    }
+
+void UpdaterReplicaExchange::resetStats()
+    {
+    size_t n_pairs = m_values.size() > 0 ? m_values.size() - 1 : 0;
+    m_num_attempted.assign(n_pairs, 0);
+    m_num_accepted.assign(n_pairs, 0);
+    }
+
+void UpdaterReplicaExchange::applyValue(Scalar value)
+    {
+    if (m_variant)
+        m_variant->setValue(value);
+    }
+
+/*! The log quantities called here reduce over the ranks in the partition, so every rank of the partition returns
+    the same value.
+*/
+Scalar UpdaterReplicaExchange::computeObservable(unsigned int timestep)
+    {
+    if (m_compute)
+        return m_compute->getLogValue(m_quantity, timestep);
+    else if (m_integrator)
+        return m_integrator->getLogValue(m_quantity, timestep);
+    else if (m_quantity == "" && m_parameter == "pressure")
+        return m_pdata->getGlobalBox().getVolume(m_sysdef->getNDimensions() == 2);
+
+    throw std::runtime_error("UpdaterReplicaExchange: no observable set for the " + m_parameter + " exchange");
+    }
+
+Scalar UpdaterReplicaExchange::coefficient(Scalar value)
+    {
+    if (m_parameter == "kT")
+        return Scalar(1.0) / value;
+    else if (m_parameter == "fugacity")
+        return -value;
+    else
+        return value / m_kT;
+    }
+
+void UpdaterReplicaExchange::update(unsigned int timestep)
+    {
+    unsigned int n_partitions = m_exec_conf->getMPIConfig()->getNPartitions();
+    if (n_partitions < 2)
+        return;
+
+    if (m_prof)
+        m_prof->push("Replica exchange");
+    m_exec_conf->msg->notice(10) << "UpdaterReplicaExchange: " << timestep << endl;
+
+    Scalar x = computeObservable(timestep);
+
+    // gather the observable of each partition from its first rank, all ranks of a partition hold the same value
+    std::vector<Scalar> x_partition(n_partitions, x);
+    #ifdef ENABLE_MPI
+    unsigned int n_ranks_global = m_exec_conf->getMPIConfig()->getNRanksGlobal();
+    unsigned int n_ranks = m_exec_conf->getMPIConfig()->getNRanks();
+    std::vector<Scalar> x_rank(n_ranks_global);
+    MPI_Allgather(&x,
+                  1,
+                  MPI_HOOMD_SCALAR,
+                  x_rank.data(),
+                  1,
+                  MPI_HOOMD_SCALAR,
+                  m_exec_conf->getHOOMDWorldMPICommunicator());
+    for (unsigned int p = 0; p < n_partitions; p++)
+        x_partition[p] = x_rank[p * n_ranks];
+    #endif
+
+    // partition holding each value
+    std::vector<unsigned int> partition(n_partitions);
+    for (unsigned int p = 0; p < n_partitions; p++)
+        partition[m_index[p]] = p;
+
+    // the decisions depend only on data that is identical on all ranks
+    for (unsigned int k = m_num_exchanges % 2; k + 1 < n_partitions; k += 2)
+        {
+        unsigned int p = partition[k];
+        unsigned int q = partition[k + 1];
+        double log_ratio = (coefficient(m_values[k]) - coefficient(m_values[k + 1]))
+                           * (x_partition[p] - x_partition[q]);
+
+        hoomd::RandomGenerator rng(hoomd::RNGIdentifier::UpdaterReplicaExchange, m_seed, timestep, k);
+        m_num_attempted[k]++;
+        if (log_ratio >= 0 || hoomd::detail::generate_canonical<double>(rng) < exp(log_ratio))
+            {
+            m_num_accepted[k]++;
+            std::swap(m_index[p], m_index[q]);
+            }
+        }
+    m_num_exchanges++;
+
+    applyValue(getValue());
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+void export_UpdaterReplicaExchange(pybind11::module& m)
+    {
+    pybind11::class_<UpdaterReplicaExchange, Updater, std::shared_ptr<UpdaterReplicaExchange>>(
+        m, "UpdaterReplicaExchange")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            pybind11::list,
+                            const std::string&,
+                            Scalar,
+                            std::shared_ptr<VariantConstant>,
+                            unsigned int>())
+        .def("setObservableCompute", &UpdaterReplicaExchange::setObservableCompute)
+        .def("setObservableIntegrator", &UpdaterReplicaExchange::setObservableIntegrator)
+        .def("resetStats", &UpdaterReplicaExchange::resetStats)
+        .def_property("kT", &UpdaterReplicaExchange::getKT, &UpdaterReplicaExchange::setKT)
+        .def_property_readonly("index", &UpdaterReplicaExchange::getIndex)
+        .def_property_readonly("value", &UpdaterReplicaExchange::getValue)
+        .def_property_readonly("values", &UpdaterReplicaExchange::getValues)
+        .def_property_readonly("num_attempted", &UpdaterReplicaExchange::getNumAttempted)
+        .def_property_readonly("num_accepted", &UpdaterReplicaExchange::getNumAccepted);
+    }
@@ -0,0 +1,132 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "Compute.h"
+#include "Integrator.h"
+#include "Updater.h"
+#include "Variant.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <pybind11/pybind11.h>
+
+/** Exchange thermodynamic parameters between MPI partitions
+
+    Each partition simulates one replica at one of the parameter values @a values. UpdaterReplicaExchange attempts to
+    swap the values of the replicas at neighboring values k and k+1, alternating between the even and odd pairs on
+    successive calls. The statistical weight of a replica with the observable x at the value v is exp(-c(v) x), where
+    the coefficient c and the observable depend on the parameter:
+
+    - "kT": c = 1/kT, x is the potential energy.
+    - "pressure": c = P/kT, x is the volume.
+    - "hamiltonian": c = v/kT, x is the energy term scaled by v.
+    - "fugacity": c = -z, x is the free volume available to the depletants.
+
+    A swap between replicas p and q is accepted with the probability min(1, exp((c(v_k) - c(v_{k+1})) (x_p - x_q))).
+    The partitions exchange only the scalar observables, and every rank makes the same decisions with a random number
+    stream seeded by the timestep and the pair, so the configurations stay in place and only the values move.
+
+    The value of the replica on this partition is written to @a variant, which operations accept as their kT or
+    pressure parameter. Derived classes override applyValue() to set parameters that are not variants.
+*/
+class PYBIND11_EXPORT UpdaterReplicaExchange : public Updater
+    {
+    public:
+        /** Constructor
+
+            @param sysdef System definition
+            @param values Parameter value of each replica, one per partition
+            @param parameter Name of the exchanged parameter
+            @param kT Temperature of the "pressure" and "hamiltonian" exchanges
+            @param variant Variant set to the value of the replica on this partition
+            @param seed PRNG seed, must be the same on all partitions
+        */
+        UpdaterReplicaExchange(std::shared_ptr<SystemDefinition> sysdef,
+                               pybind11::list values,
+                               const std::string& parameter,
+                               Scalar kT,
+                               std::shared_ptr<VariantConstant> variant,
+                               unsigned int seed);
+
+        /// Destructor
+        virtual ~UpdaterReplicaExchange();
+
+        /** Attempt the exchanges
+
+            @param timestep timestep at which update is being evaluated
+        */
+        virtual void update(unsigned int timestep);
+
+        /// Compute the observable with the log quantity @a quantity of @a compute
+        void setObservableCompute(std::shared_ptr<Compute> compute, const std::string& quantity);
+
+        /// Compute the observable with the log quantity @a quantity of @a integrator
+        void setObservableIntegrator(std::shared_ptr<Integrator> integrator, const std::string& quantity);
+
+        /// Get the index of the value of the replica on this partition
+        unsigned int getIndex();
+
+        /// Get the value of the replica on this partition
+        Scalar getValue();
+
+        /// Get the parameter values
+        pybind11::list getValues();
+
+        /// Get the temperature
+        Scalar getKT()
+            {
+            return m_kT;
+            }
+
+        /// Set the temperature
+        void setKT(Scalar kT)
+            {
+            if (kT <= 0)
+                throw std::domain_error("kT must be positive");
+            m_kT = kT;
+            }
+
+        /// Get the number of attempted swaps between the values k and k+1
+        pybind11::list getNumAttempted();
+
+        /// Get the number of accepted swaps between the values k and k+1
+        pybind11::list getNumAccepted();
+
+        /// Reset the swap counters
+        void resetStats();
+
+    protected:
+        /// Set the parameter of the operations on this partition to @a value
+        virtual void applyValue(Scalar value);
+
+        /// Compute the observable of the replica on this partition
+        Scalar computeObservable(unsigned int timestep);
+
+        /// Coefficient of the observable in the reduced energy at the value @a value
+        Scalar coefficient(Scalar value);
+
+        std::vector<Scalar> m_values;              //!< Parameter value of each replica
+        std::string m_parameter;                   //!< Name of the exchanged parameter
+        Scalar m_kT;                               //!< Temperature of the pressure and hamiltonian exchanges
+        std::shared_ptr<VariantConstant> m_variant; //!< Variant holding the value of this partition
+        unsigned int m_seed;                       //!< PRNG seed
+
+        std::shared_ptr<Compute> m_compute;        //!< Compute providing the observable
+        std::shared_ptr<Integrator> m_integrator;  //!< Integrator providing the observable
+        std::string m_quantity;                    //!< Log quantity of the observable
+
+        std::vector<unsigned int> m_index;         //!< Index of the value of the replica on each partition
+        std::vector<unsigned long long> m_num_attempted; //!< Attempted swaps between values k and k+1
+        std::vector<unsigned long long> m_num_accepted;  //!< Accepted swaps between values k and k+1
+        unsigned long long m_num_exchanges;        //!< Number of calls to update(), selects the even or odd pairs
+    };
+
+/// Export the UpdaterReplicaExchange class to python
+void export_UpdaterReplicaExchange(pybind11::module& m);
@@ -208,6 +208,34 @@ void export_Variant(pybind11::module& m)
                 }))
         ;
 
+    pybind11::class_<VariantExpression, Variant,
+                     std::shared_ptr<VariantExpression> >(m, "VariantExpression")
+        .def(pybind11::init<const std::string&, Scalar, Scalar>(),
+             pybind11::arg("expression"),
+             pybind11::arg("min"),
+             pybind11::arg("max")
+             )
+        .def_property("expression", &VariantExpression::getExpression,
+                      &VariantExpression::setExpression)
+        .def(pybind11::pickle(
+            [](VariantExpression& variant)
+                {
+                return pybind11::make_tuple(
+                    variant.getExpression(),
+                    variant.min(),
+                    variant.max()
+                    );
+                },
+            [](pybind11::tuple params)
+                {
+                return VariantExpression(
+                    params[0].cast<std::string>(),
+                    params[1].cast<Scalar>(),
+                    params[2].cast<Scalar>()
+                    );
+                }))
+        ;
+
     m.def("_test_variant_call", &testVariantCall);
     m.def("_test_variant_min", &testVariantMin);
     m.def("_test_variant_max", &testVariantMax);
@@ -8,6 +8,7 @@
 #include <pybind11/pybind11.h>
 
 #include "HOOMDMath.h"
+#include "Expression.h"
 
 /** Defines quantities that vary with time steps.
 
@@ -582,6 +583,59 @@ class PYBIND11_EXPORT VariantPower : public Variant
         double m_inv_end;
     };
 
+/** Expression variant
+
+    Variant that evaluates a formula of the time step `t`, compiled by Expression. The range of the formula cannot be
+    determined from its source in general, so the caller provides it.
+*/
+class PYBIND11_EXPORT VariantExpression : public Variant
+    {
+    public:
+        /** Construct a VariantExpression.
+
+            @param expression The formula in the time step `t`.
+            @param min The minimum value of the formula.
+            @param max The maximum value of the formula.
+        */
+        VariantExpression(const std::string& expression, Scalar min, Scalar max)
+            : m_expression(expression), m_min(min), m_max(max)
+            {
+            }
+
+        /// Evaluate the formula.
+        Scalar operator()(uint64_t timestep)
+            {
+            return Scalar(m_expression(double(timestep)));
+            }
+
+        /// Set the formula.
+        void setExpression(const std::string& expression)
+            {
+            m_expression = Expression(expression);
+            }
+
+        /// Get the formula.
+        std::string getExpression() const
+            {
+            return m_expression.getSource();
+            }
+
+        /// Returns the given minimum
+        virtual Scalar min() {return m_min;}
+
+        /// Returns the given maximum
+        virtual Scalar max() {return m_max;}
+
+    protected:
+        /// The compiled formula.
+        Expression m_expression;
+
+        /// The minimum value.
+        Scalar m_min;
+
+        /// The maximum value.
+        Scalar m_max;
+    };
 
 /// Export Variant classes to Python
 void export_Variant(pybind11::module& m);
@@ -42,8 +42,8 @@ namespace detail
 //! Computes warp-level reduction using shuffle instructions
 /*!
  * Reduction operations are performed at the warp or sub-warp level using shuffle instructions. The sub-warp is defined as
- * a consecutive group of threads that is (1) smaller than the hardware warp size (32 threads) and (2) a power of 2.
- * For additional details about any operator, refer to the CUB documentation.
+ * a consecutive group of threads that is (1) smaller than the hardware warp size (32 threads on NVIDIA, 64 on AMD)
+ * and (2) a power of 2. For additional details about any operator, refer to the CUB documentation.
  *
  * This class is a thin wrapper around cub::WarpReduce. The CUB scan classes nominally request "temporary" memory,
  * which is shared memory for non-shuffle scans. However, the shuffle-based scan does not use any shared memory,
@@ -167,8 +167,8 @@ class WarpReduce
 //! Computes warp-level scan (prefix sum) using shuffle instructions
 /*!
  * Scan operations are performed at the warp or sub-warp level using shuffle instructions. The sub-warp is defined as
- * a consecutive group of threads that is (1) smaller than the hardware warp size (32 threads) and (2) a power of 2.
- * For additional details about any operator, refer to the CUB documentation.
+ * a consecutive group of threads that is (1) smaller than the hardware warp size (32 threads on NVIDIA, 64 on AMD)
+ * and (2) a power of 2. For additional details about any operator, refer to the CUB documentation.
  *
  * This class is a thin wrapper around hipcub::WarpScan. The CUB scan classes nominally request "temporary" memory,
  * which is shared memory for non-shuffle scans. However, the shuffle-based scan does not use any shared memory,
@@ -10,6 +10,13 @@ simulations using HOOMD.
 import sys
 import os
 
+# Load GPU kernels on first launch instead of when the CUDA context is created,
+# and keep JIT compiled PTX in a cache large enough to hold all of HOOMD's
+# kernels. Both must be set before the first CUDA call. Users may override
+# them in the environment.
+os.environ.setdefault('CUDA_MODULE_LOADING', 'LAZY')
+os.environ.setdefault('CUDA_CACHE_MAXSIZE', str(2**32))
+
 from hoomd import version
 from hoomd import trigger
 from hoomd import variant
@@ -22,18 +29,38 @@ from hoomd import integrate
 from hoomd import communicator
 from hoomd import util
 from hoomd import write
-try:
-    from hoomd import md
-except ImportError:
-    pass
-try:
-    from hoomd import hpmc
-except ImportError:
-    pass
-try:
-    from hoomd import dem
-except ImportError:
-    pass
+
+# Import the component packages the first time they are accessed as attributes
+# so that ``import hoomd`` does not load the large md, hpmc, and dem extension
+# modules that a script does not use.
+_lazy_packages = ('md', 'hpmc', 'dem')
+
+
+def __getattr__(name):
+    """Import component packages on first access."""
+    if name in _lazy_packages:
+        import importlib
+        try:
+            return importlib.import_module('hoomd.' + name)
+        except ImportError as error:
+            raise AttributeError(
+                f"module 'hoomd' has no attribute '{name}'") from error
+    raise AttributeError(f"module 'hoomd' has no attribute '{name}'")
+
+
+def __dir__():
+    """List the attributes of hoomd, including the component packages."""
+    return sorted(set(globals()) | set(_lazy_packages))
+
+
+# Module level __getattr__ requires Python 3.7, import eagerly on older
+# versions.
+if sys.version_info < (3, 7):
+    for _name in _lazy_packages:
+        try:
+            __getattr__(_name)
+        except AttributeError:
+            pass
 # TODO: enable this import after updating MPCD to the new API
 # try:
 #     from hoomd import mpcd
@@ -41,9 +68,9 @@ except ImportError:
 #     pass
 
 from hoomd.simulation import Simulation
-from hoomd.state import State
+from hoomd.state import State, StateCheckpoint
 from hoomd.operations import Operations
-from hoomd.snapshot import Snapshot
+from hoomd.snapshot import Snapshot, DistributedSnapshot
 from hoomd import tune
 from hoomd import logging
 from hoomd import custom
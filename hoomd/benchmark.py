@@ -1,38 +1,407 @@
 # Copyright (c) 2009-2019 The Regents of the University of Michigan
-# This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
 
-# Maintainer: joaander / All Developers are free to add commands for new features
+"""Standard benchmark workloads.
 
-R""" Benchmark utilities
+`hoomd.benchmark` builds a set of canonical workloads at a given number of
+particles, measures their performance, and reports the results in a
+machine readable form that can be compared across builds and releases. Run
+the module as a script to benchmark one or more workloads::
 
-Commands that help in benchmarking HOOMD-blue performance.
+    python3 -m hoomd.benchmark --device gpu --N 4096 32768 \\
+        --output benchmarks.json
+
+    mpirun -n 4 python3 -m hoomd.benchmark --device cpu \\
+        --workloads lj_liquid polymer_melt --N 262144
+
+Each result reports the time steps per second of *repeat* runs, one extra
+profiled run that breaks the time down by operation (see
+`hoomd.Simulation.profile`), and the peak host memory and the GPU memory in
+use. The profiled run is not included in the time steps per second, because
+profiling synchronizes the GPU. With MPI, the times and memory are those of
+rank 0, which writes the output.
+
+The workloads are:
+
+* ``lj_liquid`` - Lennard-Jones liquid at density 0.84 and :math:`kT=1.2`
+  with the NVT integrator.
+* ``polymer_melt`` - Bead-spring melt of chains of 10 beads with harmonic
+  bonds and the WCA potential, with the Langevin integrator.
+* ``hpmc_spheres`` - Hard spheres at packing fraction 0.45.
+* ``hpmc_cubes`` - Hard cubes (`hoomd.hpmc.integrate.ConvexPolyhedron`) at
+  packing fraction 0.5.
+
+Note:
+    PPPM charged systems, rigid bodies, and MPCD solvents are not in the list
+    because ``hoomd.md.charge.pppm``, ``hoomd.md.constrain.rigid``, and
+    `hoomd.mpcd` have not been ported to the version 3 API yet.
 """
 
+import argparse
+import itertools
+import json
+import math
+import resource
+import sys
+import time
+
+import numpy
+
 import hoomd
 
-def series(warmup=100000, repeat=20, steps=10000, limit_hours=None):
-    R""" Perform a series of benchmark runs.
+_SCHEMA_VERSION = 1
+
+
+def _lattice(n, a):
+    """Sites of a simple cubic lattice with n sites per side and spacing a.
+
+    Consecutive sites are nearest neighbors: the rows alternate direction
+    like a snake so that chains can be laid out along the sequence.
+    """
+    sites = []
+    for k in range(n):
+        ys = range(n) if k % 2 == 0 else reversed(range(n))
+        for jj, j in enumerate(ys):
+            xs = range(n) if (k * n + jj) % 2 == 0 else reversed(range(n))
+            for i in xs:
+                sites.append((i, j, k))
+    return (numpy.array(sites, dtype=float) + 0.5 - n / 2) * a
+
+
+def _make_snapshot(device, N, density, types):
+    """Snapshot of N particles on a cubic lattice at the given density."""
+    snapshot = hoomd.Snapshot(device.communicator)
+    n = int(math.ceil(N**(1 / 3)))
+    a = (1 / density)**(1 / 3)
+    if snapshot.exists:
+        L = n * a
+        snapshot.configuration.box = [L, L, L, 0, 0, 0]
+        snapshot.particles.N = N
+        snapshot.particles.types = types
+        snapshot.particles.position[:] = _lattice(n, a)[:N]
+    return snapshot
+
+
+def _thermalize(snapshot, kT, seed):
+    """Draw Maxwell-Boltzmann velocities of unit mass particles."""
+    if snapshot.exists:
+        rng = numpy.random.default_rng(seed)
+        N = snapshot.particles.N
+        velocity = rng.normal(0, math.sqrt(kT), size=(N, 3))
+        velocity -= numpy.mean(velocity, axis=0)
+        snapshot.particles.velocity[:] = velocity
+
+
+def lj_liquid(device, N, seed=1):
+    """Lennard-Jones liquid.
 
     Args:
-        warmup (int): Number of time steps to ```hoomd.run``` to warm up the benchmark
-        repeat (int): Number of times to repeat the benchmark *steps*.
-        steps (int): Number of time steps to ```hoomd.run``` at each benchmark point.
-        limit_hours (float): Limit each individual ```hoomd.run``` length to this time.
+        device (`hoomd.device.Device`): Device to run on.
+        N (int): Number of particles.
+        seed (int): Random number seed.
+
+    Returns:
+        `hoomd.Simulation`: The workload.
+    """
+    import hoomd.md
+
+    snapshot = _make_snapshot(device, N, density=0.84, types=['A'])
+    _thermalize(snapshot, kT=1.2, seed=seed)
+
+    sim = hoomd.Simulation(device)
+    sim.create_state_from_snapshot(snapshot)
+
+    lj = hoomd.md.pair.LJ(hoomd.md.nlist.Cell(buffer=0.4), r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+    nvt = hoomd.md.methods.NVT(filter=hoomd.filter.All(), kT=1.2, tau=0.5)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                    forces=[lj],
+                                                    methods=[nvt])
+    return sim
+
+
+def polymer_melt(device, N, seed=1):
+    """Bead-spring polymer melt.
+
+    Args:
+        device (`hoomd.device.Device`): Device to run on.
+        N (int): Number of particles, rounded down to whole chains.
+        seed (int): Random number seed.
+
+    Returns:
+        `hoomd.Simulation`: The workload.
+    """
+    import hoomd.md
+
+    chain_length = 10
+    N = max(chain_length, N - N % chain_length)
+    snapshot = _make_snapshot(device, N, density=0.85, types=['A'])
+    if snapshot.exists:
+        # the lattice sites are in snake order, neighbors in a chain touch
+        n_chains = N // chain_length
+        first = numpy.arange(n_chains * chain_length).reshape(
+            n_chains, chain_length)
+        snapshot.bonds.N = n_chains * (chain_length - 1)
+        snapshot.bonds.types = ['backbone']
+        snapshot.bonds.group[:] = numpy.stack(
+            (first[:, :-1].ravel(), first[:, 1:].ravel()), axis=1)
+    _thermalize(snapshot, kT=1.0, seed=seed)
+
+    sim = hoomd.Simulation(device)
+    sim.create_state_from_snapshot(snapshot)
+
+    wca = hoomd.md.pair.LJ(hoomd.md.nlist.Cell(buffer=0.4,
+                                               exclusions=('bond',)),
+                           r_cut=2**(1 / 6),
+                           mode='shift')
+    wca.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+    harmonic = hoomd.md.bond.Harmonic()
+    harmonic.params['backbone'] = dict(k=100.0, r0=1.0)
+    langevin = hoomd.md.methods.Langevin(filter=hoomd.filter.All(),
+                                         kT=1.0,
+                                         seed=seed)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                    forces=[wca, harmonic],
+                                                    methods=[langevin])
+    return sim
+
+
+def hpmc_spheres(device, N, seed=1):
+    """Hard spheres.
+
+    Args:
+        device (`hoomd.device.Device`): Device to run on.
+        N (int): Number of particles.
+        seed (int): Random number seed.
+
+    Returns:
+        `hoomd.Simulation`: The workload.
+    """
+    import hoomd.hpmc
+
+    packing_fraction = 0.45
+    snapshot = _make_snapshot(device,
+                              N,
+                              density=6 * packing_fraction / math.pi,
+                              types=['A'])
+
+    sim = hoomd.Simulation(device)
+    sim.create_state_from_snapshot(snapshot)
+
+    mc = hoomd.hpmc.integrate.Sphere(seed=seed, d=0.1)
+    mc.shape['A'] = dict(diameter=1.0)
+    sim.operations.integrator = mc
+    return sim
+
+
+def hpmc_cubes(device, N, seed=1):
+    """Hard cubes.
 
-    :py:meth:`series()` executes *warmup* time steps. After that, it
-    calls ``run(steps)``, *repeat* times and returns a list containing the average TPS for each of those runs.
+    Args:
+        device (`hoomd.device.Device`): Device to run on.
+        N (int): Number of particles.
+        seed (int): Random number seed.
+
+    Returns:
+        `hoomd.Simulation`: The workload.
     """
-    # check if initialization has occurred
-    if not hoomd.init.is_initialized():
-        raise RuntimeError("Cannot tune r_buff before initialization\n");
+    import hoomd.hpmc
+
+    # aligned unit cubes on the lattice do not overlap
+    snapshot = _make_snapshot(device, N, density=0.5, types=['A'])
+
+    sim = hoomd.Simulation(device)
+    sim.create_state_from_snapshot(snapshot)
+
+    mc = hoomd.hpmc.integrate.ConvexPolyhedron(seed=seed, d=0.1, a=0.1)
+    mc.shape['A'] = dict(
+        vertices=list(itertools.product((-0.5, 0.5), repeat=3)))
+    sim.operations.integrator = mc
+    return sim
+
+
+#: dict[str, callable]: Workload factories by name. Each takes a device, the
+#: number of particles, and a random number seed and returns a
+#: `hoomd.Simulation` ready to run.
+workloads = {
+    'lj_liquid': lj_liquid,
+    'polymer_melt': polymer_melt,
+    'hpmc_spheres': hpmc_spheres,
+    'hpmc_cubes': hpmc_cubes,
+}
+
+
+def _memory(device):
+    """Peak host memory of this process and GPU memory in use, in bytes."""
+    max_rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # Linux reports the resident set size in KiB, macOS in bytes
+    if sys.platform != 'darwin':
+        max_rss *= 1024
+
+    gpu_used = None
+    if isinstance(device, hoomd.device.GPU):
+        gpu_used = list(device._cpp_exec_conf.getGPUMemoryUsed())
+
+    return dict(host_max_rss=max_rss, gpu_used=gpu_used)
 
-    tps_list = [];
 
+def series(sim, warmup=100000, repeat=20, steps=10000):
+    """Perform a series of benchmark runs.
+
+    Args:
+        sim (`hoomd.Simulation`): Simulation to benchmark.
+        warmup (int): Number of time steps to run to warm up the benchmark.
+        repeat (int): Number of times to repeat the benchmark *steps*.
+        steps (int): Number of time steps to run at each benchmark point.
+
+    `series` runs *warmup* time steps. After that, it runs *steps* time steps
+    *repeat* times.
+
+    Returns:
+        list[float]: The average time steps per second of each run.
+    """
     if warmup > 0:
-        hoomd.run(warmup);
+        sim.run(warmup)
+
+    tps_list = []
+    for i in range(repeat):
+        sim.run(steps)
+        tps_list.append(sim.tps)
+
+    return tps_list
+
+
+def run(workload, device, N, warmup=1000, repeat=5, steps=1000, seed=1):
+    """Benchmark one workload.
+
+    Args:
+        workload (str): Name of the workload in `workloads`.
+        device (`hoomd.device.Device`): Device to run on.
+        N (int): Number of particles.
+        warmup (int): Number of time steps to run before measuring.
+        repeat (int): Number of measured runs.
+        steps (int): Number of time steps in each measured run.
+        seed (int): Random number seed.
+
+    Returns:
+        dict: The result with the keys:
+
+        * ``'workload'`` - Name of the workload.
+        * ``'N'`` - Number of particles in the simulation.
+        * ``'steps'``, ``'warmup'`` - Time steps of each measured run and of
+          the warm up.
+        * ``'tps'`` - Time steps per second of each measured run.
+        * ``'tps_mean'``, ``'tps_std'`` - Mean and standard deviation of
+          ``'tps'``.
+        * ``'walltime'`` - Wall clock time of the profiled run [seconds].
+        * ``'profile'`` - `hoomd.Simulation.profile` of the profiled run.
+        * ``'memory'`` - ``'host_max_rss'``, the peak resident memory of the
+          process, and ``'gpu_used'``, the memory in use on each active GPU
+          (`None` on the CPU) [bytes].
+    """
+    if workload not in workloads:
+        raise ValueError(f"Unknown workload {workload}, choose from "
+                         f"{sorted(workloads)}.")
+
+    sim = workloads[workload](device, N, seed)
+    tps = series(sim, warmup=warmup, repeat=repeat, steps=steps)
+
+    sim.profiling = True
+    sim.run(steps)
+    sim.profiling = False
+
+    return dict(workload=workload,
+                N=sim.state.N_particles,
+                steps=steps,
+                warmup=warmup,
+                tps=tps,
+                tps_mean=float(numpy.mean(tps)),
+                tps_std=float(numpy.std(tps)),
+                walltime=sim.walltime,
+                profile=sim.profile,
+                memory=_memory(device))
+
+
+def _device_info(device):
+    return dict(type=type(device).__name__,
+                devices=list(device.devices),
+                num_ranks=device.communicator.num_ranks,
+                num_cpu_threads=device.num_cpu_threads)
+
+
+def _build_info():
+    return dict(version=hoomd.version.version,
+                git_branch=hoomd.version.git_branch,
+                git_sha1=hoomd.version.git_sha1,
+                compile_flags=hoomd.version.compile_flags,
+                cxx_compiler=hoomd.version.cxx_compiler,
+                gpu_platform=hoomd.version.gpu_platform,
+                gpu_api_version=hoomd.version.gpu_api_version)
+
+
+def main(args=None):
+    """Run the benchmarks selected on the command line.
+
+    Args:
+        args (list[str]): Command line arguments, `sys.argv` when `None`.
+
+    The results are printed as JSON, or written to the file given with
+    ``--output``. The document has the keys ``'schema_version'``,
+    ``'date'``, ``'hoomd'`` (the build information from `hoomd.version`),
+    ``'device'``, and ``'results'``, a list of the results of `run`.
+    """
+    parser = argparse.ArgumentParser(
+        prog='python3 -m hoomd.benchmark',
+        description='Run the standard HOOMD-blue benchmark workloads.')
+    parser.add_argument('--workloads',
+                        nargs='+',
+                        choices=sorted(workloads),
+                        default=sorted(workloads))
+    parser.add_argument('--N', nargs='+', type=int, default=[4096, 32768])
+    parser.add_argument('--device',
+                        choices=('auto', 'cpu', 'gpu'),
+                        default='auto')
+    parser.add_argument('--warmup', type=int, default=1000)
+    parser.add_argument('--repeat', type=int, default=5)
+    parser.add_argument('--steps', type=int, default=1000)
+    parser.add_argument('--seed', type=int, default=1)
+    parser.add_argument('--output', help='JSON file to write')
+    options = parser.parse_args(args)
+
+    if options.device == 'cpu':
+        device = hoomd.device.CPU()
+    elif options.device == 'gpu':
+        device = hoomd.device.GPU()
+    else:
+        device = hoomd.device.auto_select()
+
+    results = []
+    for workload in options.workloads:
+        for N in options.N:
+            results.append(
+                run(workload,
+                    device,
+                    N,
+                    warmup=options.warmup,
+                    repeat=options.repeat,
+                    steps=options.steps,
+                    seed=options.seed))
+
+    report = dict(schema_version=_SCHEMA_VERSION,
+                  date=time.strftime('%Y-%m-%dT%H:%M:%S%z'),
+                  hoomd=_build_info(),
+                  device=_device_info(device),
+                  results=results)
+
+    if device.communicator.rank == 0:
+        if options.output is None:
+            json.dump(report, sys.stdout, indent=2)
+            print()
+        else:
+            with open(options.output, 'w') as f:
+                json.dump(report, f, indent=2)
 
-    for i in range(0,repeat):
-        hoomd.run(steps, limit_hours=limit_hours);
-        tps_list.append(hoomd.context.current.system.getLastTPS());
 
-    return tps_list;
+if __name__ == '__main__':
+    main()
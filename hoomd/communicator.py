@@ -259,6 +259,28 @@ class Communicator(object):
         mpi_comm: Accepts an mpi4py communicator. Use this argument to perform many independent hoomd simulations
                 where you communicate between those simulations using your own mpi4py code.
         nrank (int): (MPI) Number of ranks to include in a partition
+
+    .. rubric:: Ensembles of small systems
+
+    A single small system (a few thousand particles) cannot fill a modern
+    GPU. To run many independent replicas efficiently, split the MPI ranks
+    into partitions with ``nrank=1`` and launch several ranks per GPU. Each
+    partition runs its own `hoomd.Simulation`, and the `hoomd.device.GPU`
+    device auto-selection assigns local ranks to GPUs round-robin
+    (``local_rank % num_capable_gpus``), so the kernels of the replicas on
+    one GPU overlap. Enable the CUDA Multi-Process Service (MPS) on the node
+    so that kernels from different processes execute concurrently instead of
+    time slicing. Use `partition` to choose per replica parameters and random
+    number seeds.
+
+    Example::
+
+        # mpirun -n 32 python3 script.py on a node with 4 GPUs
+        communicator = hoomd.communicator.Communicator(nrank=1)
+        device = hoomd.device.GPU(communicator=communicator)
+        sim = hoomd.Simulation(device=device)
+        sim.create_state_from_gsd(
+            filename='replica_{}.gsd'.format(communicator.partition))
     """
 
     def __init__(self, mpi_comm=None, nrank=None):
@@ -357,6 +379,22 @@ class Communicator(object):
         else:
             return 0;
 
+    @property
+    def num_partitions(self):
+        """ Get the number of partitions.
+
+        Returns:
+            The number of partitions in the MPI run.
+
+        Note:
+            Always returns 1 in non-mpi builds.
+        """
+
+        if hoomd.version.mpi_enabled:
+            return self.cpp_mpi_conf.getNPartitions()
+        else:
+            return 1
+
     def barrier_all(self):
         """ Perform a MPI barrier synchronization across the whole MPI run.
 
@@ -40,6 +40,24 @@ class Action(metaclass=_AbstractLoggable):
             def act(self, timestep):
                 pass
 
+    On the GPU, actions of a `hoomd.write.CustomWriter` that read particle
+    data on the host can list the arrays they read in the host_arrays
+    attribute. Before the writers triggered on a step run, the listed arrays
+    of all of them are copied to the host together instead of one at a time
+    as each writer accesses them.
+
+    .. code-block:: python
+
+        from hoomd.custom import Action
+
+
+        class ExampleActionWithHostArrays(Action):
+            host_arrays = [Action.HostArrays.POSITION,
+                           Action.HostArrays.VELOCITY]
+
+            def act(self, timestep):
+                pass
+
     For advertising loggable quantities through the wrapping object, the
     decorator `hoomd.logging.log` can be used.
 
@@ -75,6 +93,9 @@ class Action(metaclass=_AbstractLoggable):
         flags (list[hoomd.custom.Action.Flags]): List of flags from the
             `hoomd.custom.Action.Flags`. Used to tell the integrator if
             specific quantities are needed for the action.
+        host_arrays (list[hoomd.custom.Action.HostArrays]): List of particle
+            data arrays from `hoomd.custom.Action.HostArrays` that the action
+            reads on the host.
     """
     class Flags(IntEnum):
         """Flags to indictate the integrator should calcuate certain quantities.
@@ -82,12 +103,42 @@ class Action(metaclass=_AbstractLoggable):
         * PRESSURE_TENSOR = 0
         * ROTATIONAL_KINETIC_ENERGY = 1
         * EXTERNAL_FIELD_VIRIAL = 2
+        * POTENTIAL_ENERGY = 3
         """
         PRESSURE_TENSOR = 0
         ROTATIONAL_KINETIC_ENERGY = 1
         EXTERNAL_FIELD_VIRIAL = 2
+        POTENTIAL_ENERGY = 3
+
+    class HostArrays(IntEnum):
+        """Particle data arrays that an action reads on the host.
+
+        * POSITION = 0
+        * VELOCITY = 1
+        * ACCELERATION = 2
+        * IMAGE = 3
+        * TAG = 4
+        * CHARGE = 5
+        * DIAMETER = 6
+        * BODY = 7
+        * ORIENTATION = 8
+        * ANGULAR_MOMENTUM = 9
+        * MOMENT_OF_INERTIA = 10
+        """
+        POSITION = 0
+        VELOCITY = 1
+        ACCELERATION = 2
+        IMAGE = 3
+        TAG = 4
+        CHARGE = 5
+        DIAMETER = 6
+        BODY = 7
+        ORIENTATION = 8
+        ANGULAR_MOMENTUM = 9
+        MOMENT_OF_INERTIA = 10
 
     flags = []
+    host_arrays = []
     log_quantities = {}
 
     def __init__(self):
@@ -2,6 +2,6 @@ from .array import HOOMDArray, HOOMDGPUArray
 from .local_access import (
     AngleLocalAccessBase, BondLocalAccessBase, ConstraintLocalAccessBase,
     DihedralLocalAccessBase, ImproperLocalAccessBase, PairLocalAccessBase,
-    ParticleLocalAccessBase)
+    ParticleLocalAccessBase, ForceLocalAccessBase)
 from .local_access_cpu import LocalSnapshot
 from .local_access_gpu import LocalSnapshotGPU
@@ -67,6 +67,42 @@ class _LocalAccess(ABC):
                         "Attribute {} is not settable.".format(attr))
                 arr[:] = value
 
+    def rows(self, start, stop):
+        """Access a contiguous range of the local, non-ghost data.
+
+        Args:
+            start (int): The first local index of the range.
+            stop (int): One past the last local index of the range.
+
+        Returns:
+            An object with the same array attributes, holding only the given
+            range. Ghost attributes are not available through it.
+
+        Accessing a range in `hoomd.data.LocalSnapshot` during a GPU simulation
+        copies only that range to the host instead of the whole array. The copy
+        is written back when the context manager exits, and only if it changed.
+        """
+        return _LocalRows(self, start, stop)
+
+    def _get_rows(self, attr, start, stop):
+        key = (attr, start, stop)
+        if key in self._accessed_fields:
+            return self._accessed_fields[key]
+        if attr not in self._fields or attr in self._global_fields:
+            raise AttributeError(
+                "{} object has no row attribute {}".format(type(self), attr))
+
+        self._cpp_obj.selectRows(start, stop)
+        try:
+            buff = getattr(self._cpp_obj, self._fields[attr])(
+                _hoomd.GhostDataFlag.standard)
+        finally:
+            self._cpp_obj.selectAllRows()
+
+        self._accessed_fields[key] = arr = self._array_cls(
+            buff, lambda: self._entered)
+        return arr
+
     def _enter(self):
         self._cpp_obj.enter()
         self._entered = True
@@ -77,6 +113,25 @@ class _LocalAccess(ABC):
         self._accessed_fields = dict()
 
 
+class _LocalRows:
+    """A contiguous range of the local data of a `_LocalAccess` object."""
+    __slots__ = ('_access', '_start', '_stop')
+
+    def __init__(self, access, start, stop):
+        object.__setattr__(self, '_access', access)
+        object.__setattr__(self, '_start', start)
+        object.__setattr__(self, '_stop', stop)
+
+    def __getattr__(self, attr):
+        return self._access._get_rows(attr, self._start, self._stop)
+
+    def __setattr__(self, attr, value):
+        arr = getattr(self, attr)
+        if arr.read_only:
+            raise RuntimeError("Attribute {} is not settable.".format(attr))
+        arr[:] = value
+
+
 class ParticleLocalAccessBase(_LocalAccess):
     """Class for directly accessing HOOMD-blue particle data.
 
@@ -322,6 +377,49 @@ class PairLocalAccessBase(_GroupLocalAccess):
     _cpp_get_data_method_name = "getPairData"
 
 
+class ForceLocalAccessBase(_LocalAccess):
+    """Class for directly accessing the arrays of a `hoomd.md.force.Custom`.
+
+    Attributes:
+        force ((N_particles, 3) `hoomd.data.array` object of ``float``):
+            force on each particle
+        potential_energy ((N_particles,) `hoomd.data.array` object of \
+            ``float``):
+            potential energy of each particle
+        torque ((N_particles, 3) `hoomd.data.array` object of ``float``):
+            torque on each particle
+        virial ((N_particles, 6) `hoomd.data.array` object of ``float``):
+            virial of each particle in the order xx, xy, xz, yy, yz, zz
+
+    The arrays of the regular particles are writable. As for the particle
+    data, the attributes can be prefixed with ``ghost_`` or suffixed with
+    ``_with_ghost`` to read the ghost particle arrays.
+    """
+    @property
+    @abstractmethod
+    def _cpp_cls(self):
+        pass
+
+    _global_fields = dict()
+
+    _fields = {
+        'force': 'getForce',
+        'potential_energy': 'getPotentialEnergy',
+        'torque': 'getTorque',
+        'virial': 'getVirial'}
+
+    def __init__(self, force):
+        super().__init__()
+        self._cpp_obj = self._cpp_cls(force._cpp_obj)
+
+    def __enter__(self):
+        self._enter()
+        return self
+
+    def __exit__(self, type, value, traceback):
+        self._exit()
+
+
 class _LocalSnapshot:
     def __init__(self, state):
         self._state = state
@@ -1,7 +1,8 @@
 from hoomd.data.local_access import (
         ParticleLocalAccessBase, BondLocalAccessBase, AngleLocalAccessBase,
         DihedralLocalAccessBase, ImproperLocalAccessBase,
-        ConstraintLocalAccessBase, PairLocalAccessBase, _LocalSnapshot)
+        ConstraintLocalAccessBase, PairLocalAccessBase, ForceLocalAccessBase,
+        _LocalSnapshot)
 from hoomd.data.array import HOOMDArray
 from hoomd import _hoomd
 
@@ -41,6 +42,11 @@ class PairLocalAccessCPU(PairLocalAccessBase):
     _array_cls = HOOMDArray
 
 
+class ForceLocalAccessCPU(ForceLocalAccessBase):
+    _cpp_cls = _hoomd.LocalForceComputeDataHost
+    _array_cls = HOOMDArray
+
+
 class LocalSnapshot(_LocalSnapshot):
     """Provides context manager access to HOOMD-blue CPU data buffers.
 
@@ -2,7 +2,7 @@ from hoomd import _hoomd
 from hoomd.data.local_access import (
     ParticleLocalAccessBase, BondLocalAccessBase, ConstraintLocalAccessBase,
     DihedralLocalAccessBase, AngleLocalAccessBase, ImproperLocalAccessBase,
-    PairLocalAccessBase, _LocalSnapshot)
+    PairLocalAccessBase, ForceLocalAccessBase, _LocalSnapshot)
 
 from hoomd.data.array import HOOMDGPUArray
 import hoomd
@@ -36,6 +36,10 @@ if hoomd.version.gpu_enabled:
         _cpp_cls = _hoomd.LocalPairDataDevice
         _array_cls = HOOMDGPUArray
 
+    class ForceLocalAccessGPU(ForceLocalAccessBase):
+        _cpp_cls = _hoomd.LocalForceComputeDataDevice
+        _array_cls = HOOMDGPUArray
+
     class LocalSnapshotGPU(_LocalSnapshot):
         def __init__(self, state):
             super().__init__(state)
@@ -71,6 +75,9 @@ else:
     class ParticleLocalAccessGPU(NoGPU):
         pass
 
+    class ForceLocalAccessGPU(NoGPU):
+        pass
+
     class LocalSnapshotGPU(NoGPU, _LocalSnapshot):
         pass
 
@@ -155,7 +155,8 @@ void DEM2DForceComputeGPU<Real, Real2, Real4, Potential>::computeForces(unsigned
         this->m_evaluator,
         this->m_r_cut * this->m_r_cut,
         (unsigned int)this->m_shapes.size(),
-        (unsigned int)particlesPerBlock, (unsigned int)this->maxVertices());
+        (unsigned int)particlesPerBlock, (unsigned int)this->maxVertices(),
+        this->m_exec_conf->isDeterministicReductions());
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
     m_tuner->end();
@@ -17,6 +17,7 @@
 #include "hoomd/TextureTools.h"
 #include "DEMEvaluator.h"
 #include "atomics.cuh"
+#include "hoomd/FixedPointAtomics.cuh"
 #include "WCAPotential.h"
 #include "SWCAPotential.h"
 
@@ -54,6 +55,8 @@
   Each block will calculate the forces for blockDim.y particles.
   Each thread will calculate the force contribution for one vertex being treated as a vertex or an edge.
   The neighborlist is arranged in columns so that reads are fully coalesced when doing this.
+  When \a deterministic is set, the threads of a particle add to fixed point accumulators instead of the floating
+  point ones, so that the sum does not depend on the order of the additions.
 */
 
 template<typename Real, typename Real2, typename Real4, typename Evaluator>
@@ -76,7 +79,8 @@ __global__ void gpu_compute_dem2d_forces_kernel(const Scalar4 *d_pos,
     Evaluator evaluator,
     const Real r_cutsq,
     const unsigned int n_shapes,
-    const unsigned int maxVerts)
+    const unsigned int maxVerts,
+    const bool deterministic)
     {
     HIP_DYNAMIC_SHARED( int, sh)
     // part{ForceTorques, Virials} are the forces and torques
@@ -105,6 +109,12 @@ __global__ void gpu_compute_dem2d_forces_kernel(const Scalar4 *d_pos,
     unsigned int *firstShapeVert((unsigned int*)&sh[shOffset]);
     shOffset += n_shapes;
 
+    // fixed point accumulators for partForceTorques and the three
+    // nonzero partVirials in deterministic mode
+    unsigned long long int *partFixed(NULL);
+    if(deterministic)
+        partFixed = (unsigned long long int*)&sh[(shOffset + 1)/2*2];
+
     // partIdx is the absolute index of the particle this thread is
     // calculating for
     size_t partIdx(blockIdx.x*blockDim.y + threadIdx.y);
@@ -145,6 +155,9 @@ __global__ void gpu_compute_dem2d_forces_kernel(const Scalar4 *d_pos,
         partForceTorques[threadIdx.y] = make_scalar4(0.0f, 0.0f, 0.0f, 0.0f);
         for(size_t i(0); i < 6; ++i)
             partVirials[6*threadIdx.y + i] = 0.0f;
+        if(deterministic)
+            for(size_t i(0); i < 7; ++i)
+                partFixed[7*threadIdx.y + i] = 0;
         }
 
     // zero the calculated force, torque, and virial for this particle
@@ -324,7 +337,18 @@ __global__ void gpu_compute_dem2d_forces_kernel(const Scalar4 *d_pos,
 
     // sum all the intermediate force and torque values for each
     // particle we calculate for in the block
-    if(partIdx < N)
+    if(partIdx < N && deterministic)
+        {
+        unsigned long long int *fixed(partFixed + 7*threadIdx.y);
+        hoomd::detail::atomicAddFixedPoint(fixed + 0, localForceTorque.x);
+        hoomd::detail::atomicAddFixedPoint(fixed + 1, localForceTorque.y);
+        hoomd::detail::atomicAddFixedPoint(fixed + 2, localForceTorque.z);
+        hoomd::detail::atomicAddFixedPoint(fixed + 3, localForceTorque.w);
+        hoomd::detail::atomicAddFixedPoint(fixed + 4, localVirial[0]);
+        hoomd::detail::atomicAddFixedPoint(fixed + 5, localVirial[1]);
+        hoomd::detail::atomicAddFixedPoint(fixed + 6, localVirial[3]);
+        }
+    else if(partIdx < N)
         {
         genAtomicAdd((Real *) &partForceTorques[threadIdx.y].x, (Real) localForceTorque.x);
         genAtomicAdd((Real *) &partForceTorques[threadIdx.y].y, (Real) localForceTorque.y);
@@ -337,6 +361,19 @@ __global__ void gpu_compute_dem2d_forces_kernel(const Scalar4 *d_pos,
 
     __syncthreads();
 
+    // convert the fixed point sums
+    if(deterministic && partIdx < N && threadIdx.z == 0 && threadIdx.x == 0)
+        {
+        const unsigned long long int *fixed(partFixed + 7*threadIdx.y);
+        partForceTorques[threadIdx.y].x = hoomd::detail::fixedPointToScalar(fixed[0]);
+        partForceTorques[threadIdx.y].y = hoomd::detail::fixedPointToScalar(fixed[1]);
+        partForceTorques[threadIdx.y].z = hoomd::detail::fixedPointToScalar(fixed[2]);
+        partForceTorques[threadIdx.y].w = hoomd::detail::fixedPointToScalar(fixed[3]);
+        partVirials[6*threadIdx.y + 0] = hoomd::detail::fixedPointToScalar(fixed[4]);
+        partVirials[6*threadIdx.y + 1] = hoomd::detail::fixedPointToScalar(fixed[5]);
+        partVirials[6*threadIdx.y + 3] = hoomd::detail::fixedPointToScalar(fixed[6]);
+        }
+
     // finally, write the result
     if(partIdx < N && threadIdx.z == 0 && threadIdx.x == 0)
         {
@@ -371,6 +408,7 @@ __global__ void gpu_compute_dem2d_forces_kernel(const Scalar4 *d_pos,
   force is set to 0
   \param particlesPerBlock Block size to execute
   \param maxVerts Maximum number of vertices in any shape
+  \param deterministic Accumulate in fixed point for reproducible results
 
   \returns Any error code resulting from the kernel launch
 
@@ -398,7 +436,8 @@ hipError_t gpu_compute_dem2d_forces(Scalar4* d_force,
     const Real r_cutsq,
     const unsigned int n_shapes,
     const unsigned int particlesPerBlock,
-    const unsigned int maxVerts)
+    const unsigned int maxVerts,
+    const bool deterministic)
     {
 
     // setup the grid to run the kernel
@@ -414,11 +453,14 @@ hipError_t gpu_compute_dem2d_forces(Scalar4* d_force,
     // Calculate the amount of shared memory required
     size_t shmSize(vertexCount*sizeof(Real2) + n_shapes*2*sizeof(unsigned int) +
         particlesPerBlock*(sizeof(Real4) + 6*sizeof(Real)));
+    // 7 fixed point accumulators per particle, aligned to 8 bytes
+    if(deterministic)
+        shmSize += (7*particlesPerBlock + 1)*sizeof(unsigned long long int);
 
     // run the kernel
     hipLaunchKernelGGL((gpu_compute_dem2d_forces_kernel<Real, Real2, Real4, Evaluator>), grid, threads, shmSize, 0, d_pos, d_quat, d_force, d_torque, d_virial, virial_pitch, N, d_vertices,
         d_num_shape_verts, d_diam, d_velocity, vertexCount, box, d_n_neigh,
-        d_nlist, d_head_list, potential, r_cutsq, n_shapes, maxVerts);
+        d_nlist, d_head_list, potential, r_cutsq, n_shapes, maxVerts, deterministic);
 
     return hipSuccess;
     }
@@ -42,7 +42,8 @@ hipError_t gpu_compute_dem2d_forces(
         const Real r_cutsq,
         const unsigned int n_shapes,
         const unsigned int particlesPerBlock,
-        const unsigned int maxVerts);
+        const unsigned int maxVerts,
+        const bool deterministic);
 
 #endif
 
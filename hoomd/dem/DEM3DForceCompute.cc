@@ -46,7 +46,13 @@ DEM3DForceCompute<Real, Real4, Potential>::DEM3DForceCompute(
       m_numTypeEdges(0, this->m_exec_conf), m_numTypeFaces(0, this->m_exec_conf),
       m_vertexConnectivity(0, this->m_exec_conf), m_edges(0, this->m_exec_conf),
       m_faceRcutSq(0, this->m_exec_conf), m_edgeRcutSq(0, this->m_exec_conf),
-      m_verts(0, this->m_exec_conf), m_shapes(), m_facesVec()
+      m_verts(0, this->m_exec_conf), m_typeRadius(0, this->m_exec_conf), m_maxTypeEdges(0),
+      m_contacts(0, this->m_exec_conf), m_contactTag(0, this->m_exec_conf),
+      m_contactTagAlt(0, this->m_exec_conf), m_contactState(0, this->m_exec_conf),
+      m_contactStateAlt(0, this->m_exec_conf), m_contactRange(0, this->m_exec_conf),
+      m_contactRangeAlt(0, this->m_exec_conf), m_contactPos(0, this->m_exec_conf),
+      m_contactOrientation(0, this->m_exec_conf), m_contactWords(0), m_contactBuffer(0),
+      m_contactNlistUpdates(0), m_contactsValid(false), m_shapes(), m_facesVec()
     {
     m_exec_conf->msg->notice(5) << "Constructing DEM3DForceCompute" << endl;
 
@@ -264,6 +270,9 @@ void DEM3DForceCompute<Real, Real4, Potential>::createGeometry()
     if(m_edges.getNumElements() != 2*nEdges)
         m_edges.resize(2*nEdges);
 
+    if(m_typeRadius.getNumElements() != nTypes)
+        m_typeRadius.resize(nTypes);
+
     ArrayHandle<Real4> h_verts(m_verts, access_location::host,
         access_mode::overwrite);
     ArrayHandle<Real> h_faceRcutSq(m_faceRcutSq, access_location::host,
@@ -292,6 +301,8 @@ void DEM3DForceCompute<Real, Real4, Potential>::createGeometry()
         access_mode::overwrite);
     ArrayHandle<unsigned int> h_edges(m_edges, access_location::host,
         access_mode::overwrite);
+    ArrayHandle<Real> h_typeRadius(m_typeRadius, access_location::host,
+        access_mode::overwrite);
 
     // iterate over shapes to build GPU Arrays m_verts,
     // m_firstTypeVert, and m_numTypeVerts
@@ -300,10 +311,13 @@ void DEM3DForceCompute<Real, Real4, Potential>::createGeometry()
         h_firstTypeVert.data[i] = (unsigned int)j;
         h_numTypeVerts.data[i] = (unsigned int)m_shapes[i].size();
 
+        h_typeRadius.data[i] = 0;
+
         for(size_t k(0); k < m_shapes[i].size(); ++j, ++k)
             {
             const vec3<Real> point(m_shapes[i][k]);
             h_verts.data[j] = vec_to_scalar4(point, 0);
+            h_typeRadius.data[i] = max(h_typeRadius.data[i], sqrt(dot(point, point)));
             }
         }
 
@@ -428,6 +442,150 @@ void DEM3DForceCompute<Real, Real4, Potential>::createGeometry()
         size_t faceSize = m_facesVec[shapeIdx].size();
         h_numTypeFaces.data[shapeIdx] = (unsigned int)faceSize;
         }
+
+    m_maxTypeEdges = 0;
+    for(size_t shapeIdx(0); shapeIdx < nTypes; ++shapeIdx)
+        m_maxTypeEdges = max(m_maxTypeEdges, h_numTypeEdges.data[shapeIdx]);
+
+    // the features of the contact list changed
+    m_contactsValid = false;
+    }
+
+/*! The contact list is rebuilt when the neighbor list was updated since the last build, when the number of particles
+  or ghosts changed, or when the shapes changed. Before a rebuild, the neighbor tags, contact states, and neighbor
+  ranges of the current list are kept as the previous list, so that the states of persisting contacts can be carried
+  over.
+
+  
+eturns True if the contact list must be rebuilt
+*/
+template<typename Real, typename Real4, typename Potential>
+bool DEM3DForceCompute<Real, Real4, Potential>::contactsNeedRebuild()
+    {
+    const size_t n_all = m_pdata->getN() + m_pdata->getNGhosts();
+    const size_t n_slots = m_nlist->getNListArray().getNumElements();
+
+    if(m_contactsValid && m_nlist->getNumUpdates() == m_contactNlistUpdates &&
+        m_contactPos.getNumElements() == n_all && m_contactTag.getNumElements() == n_slots)
+        return false;
+
+    m_contactTag.swap(m_contactTagAlt);
+    m_contactState.swap(m_contactStateAlt);
+    m_contactRange.swap(m_contactRangeAlt);
+
+    m_contactWords = (maxContactFeatures() + 31)/32;
+    if(m_contacts.getNumElements() != n_slots*m_contactWords)
+        m_contacts.resize(n_slots*m_contactWords);
+
+    if(m_contactTag.getNumElements() != n_slots)
+        m_contactTag.resize(n_slots);
+
+    if(m_contactState.getNumElements() != n_slots)
+        m_contactState.resize(n_slots);
+
+    const size_t n_tags(m_pdata->getRTags().size());
+    if(m_contactRange.getNumElements() != n_tags)
+        m_contactRange.resize(n_tags);
+
+    if(m_contactPos.getNumElements() != n_all)
+        m_contactPos.resize(n_all);
+
+    if(m_contactOrientation.getNumElements() != n_all)
+        m_contactOrientation.resize(n_all);
+
+    m_contactBuffer = m_nlist->getRBuff();
+    m_contactNlistUpdates = m_nlist->getNumUpdates();
+    m_contactsValid = true;
+    return true;
+    }
+
+/*! Marks the features of each neighbor pair that are within the interaction range plus the buffer of the other
+  particle and records the positions and orientations the list was built with.
+*/
+template<typename Real, typename Real4, typename Potential>
+void DEM3DForceCompute<Real, Real4, Potential>::rebuildContacts()
+    {
+    const unsigned int N(m_pdata->getN());
+    const unsigned int n_all(N + m_pdata->getNGhosts());
+    const unsigned int maxVerts((unsigned int)maxVertices());
+
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+    ArrayHandle<Real4> h_verts(m_verts, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_firstTypeVert(m_firstTypeVert, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_numTypeVerts(m_numTypeVerts, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_firstTypeEdge(m_firstTypeEdge, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_numTypeEdges(m_numTypeEdges, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_edges(m_edges, access_location::host, access_mode::read);
+    ArrayHandle<Real> h_typeRadius(m_typeRadius, access_location::host, access_mode::read);
+
+    ArrayHandle<unsigned int> h_contacts(m_contacts, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_contactTag(m_contactTag, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_contactState(m_contactState, access_location::host, access_mode::overwrite);
+    ArrayHandle<uint2> h_contactRange(m_contactRange, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_contactTagAlt(m_contactTagAlt, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_contactStateAlt(m_contactStateAlt, access_location::host, access_mode::read);
+    ArrayHandle<uint2> h_contactRangeAlt(m_contactRangeAlt, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_contactPos(m_contactPos, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_contactOrientation(m_contactOrientation, access_location::host, access_mode::overwrite);
+
+    memcpy(h_contactPos.data, h_pos.data, sizeof(Scalar4)*n_all);
+    memcpy(h_contactOrientation.data, h_orientation.data, sizeof(Scalar4)*n_all);
+    memset(h_contactRange.data, 0, sizeof(uint2)*m_contactRange.getNumElements());
+
+    const size_t n_old_tags(m_contactRangeAlt.getNumElements());
+    const BoxDim& box = m_pdata->getBox();
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        const vec3<Scalar> pi(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        const quat<Scalar> quati(h_orientation.data[i]);
+        const unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+        const unsigned int tagi = h_tag.data[i];
+
+        const unsigned int myHead = h_head_list.data[i];
+        const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        h_contactRange.data[tagi] = make_uint2(myHead, size);
+
+        uint2 old_range(make_uint2(0, 0));
+        if(tagi < n_old_tags)
+            old_range = h_contactRangeAlt.data[tagi];
+
+        for (unsigned int j = 0; j < size; j++)
+            {
+            const unsigned int k = h_nlist.data[myHead + j];
+            assert(k < n_all);
+
+            const vec3<Scalar> pj(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
+            const quat<Scalar> quatj(h_orientation.data[k]);
+            const unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+            const vec3<Real> dx(vec3<Scalar>(box.minImage(vec_to_scalar3(pj - pi))));
+
+            if (Potential::needsDiameter())
+                m_evaluator.setDiameter(h_diameter.data[i], h_diameter.data[k]);
+            const Real reach(m_evaluator.getRange() + m_contactBuffer);
+
+            const bool any = findContactFeatures(dx, quati, quatj, typei, typej,
+                h_typeRadius.data[typei] + reach, h_typeRadius.data[typej] + reach,
+                h_verts.data, h_firstTypeVert.data, h_numTypeVerts.data,
+                h_firstTypeEdge.data, h_numTypeEdges.data, h_edges.data,
+                maxVerts, m_contactWords, h_contacts.data + (myHead + j)*m_contactWords);
+
+            h_contactTag.data[myHead + j] = h_tag.data[k];
+            if(any)
+                h_contactState.data[myHead + j] = findContactState(old_range, h_contactTagAlt.data,
+                    h_contactStateAlt.data, h_tag.data[k]);
+            else
+                h_contactState.data[myHead + j] = make_scalar4(0, 0, 0, 0);
+            }
+        }
     }
 
 /*!
@@ -576,6 +734,10 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
     // start by updating the neighborlist
     m_nlist->compute(timestep);
 
+    // rebuild the contact list along with the neighbor list
+    if (contactsNeedRebuild())
+        rebuildContacts();
+
     // start the profile for this compute
     if (m_prof) m_prof->push("DEM3D pair");
 
@@ -641,7 +803,14 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
         access_mode::read);
     ArrayHandle<unsigned int> h_edges(m_edges, access_location::host,
         access_mode::read);
+    ArrayHandle<Real> h_typeRadius(m_typeRadius, access_location::host,
+        access_mode::read);
 
+    // contact list handles
+    ArrayHandle<unsigned int> h_contacts(m_contacts, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_contactPos(m_contactPos, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_contactOrientation(m_contactOrientation, access_location::host, access_mode::read);
+    const unsigned int maxVerts((unsigned int)maxVertices());
 
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
@@ -682,6 +851,10 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
         if(Potential::needsVelocity())
             vi = vec3<Scalar>(h_velocity.data[i]);
 
+        // distance that the features of i moved since the contact list was built
+        const Scalar dispi = contactDisplacement(box, h_pos.data[i], h_contactPos.data[i],
+            h_orientation.data[i], h_contactOrientation.data[i], h_typeRadius.data[typei]);
+
         // loop over all of the neighbors of this particle
         const unsigned int myHead = h_head_list.data[i];
         const unsigned int size = (unsigned int)h_n_neigh.data[i];
@@ -734,9 +907,18 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
                 vec3<Real> torqueij, torqueji;
                 Real potentialij(0);
 
+                // evaluate only the features in the contact list, unless the pair moved too far since it was built
+                const unsigned int slot = myHead + j;
+                const bool allFeatures = dispi + contactDisplacement(box, h_pos.data[k], h_contactPos.data[k],
+                    h_orientation.data[k], h_contactOrientation.data[k], h_typeRadius.data[typej]) > m_contactBuffer;
+
                 // iterate over each vertex in particle i
                 for(size_t vertIndex(0); vertIndex < h_numTypeVerts.data[typei]; ++vertIndex)
                     {
+                    if(!allFeatures && !contactFeatureActive(h_contacts.data, slot, m_contactWords,
+                        (unsigned int)vertIndex))
+                        continue;
+
                     const vec3<Real> vertex0(
                         rotate(quati, vec3<Real>(h_verts.data[h_firstTypeVert.data[typei] + vertIndex])));
 
@@ -793,6 +975,10 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
                 // iterate over each vertex in particle j
                 for(size_t vertIndex(0); vertIndex < h_numTypeVerts.data[typej]; ++vertIndex)
                     {
+                    if(!allFeatures && !contactFeatureActive(h_contacts.data, slot, m_contactWords,
+                        maxVerts + (unsigned int)vertIndex))
+                        continue;
+
                     const vec3<Real> vertex0(
                         rotate(quatj, vec3<Real>(h_verts.data[h_firstTypeVert.data[typej] + vertIndex])));
 
@@ -838,6 +1024,10 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
                 // iterate over all pairs of edges
                 for(size_t edgei(0); edgei < h_numTypeEdges.data[typei]; ++edgei)
                     {
+                    if(!allFeatures && !contactFeatureActive(h_contacts.data, slot, m_contactWords,
+                        2*maxVerts + (unsigned int)edgei))
+                        continue;
+
                     vec3<Real> p00(h_verts.data[h_edges.data[2*(edgei + h_firstTypeEdge.data[typei])]]);
                     vec3<Real> p01(h_verts.data[h_edges.data[2*(edgei + h_firstTypeEdge.data[typei]) + 1]]);
                     p00 = rotate(quati, p00);
@@ -10,6 +10,7 @@
 #include <memory>
 
 #include "DEMEvaluator.h"
+#include "DEMContacts.h"
 #include "hoomd/GSDShapeSpecWriter.h"
 
 /*! \file DEM3DForceCompute.h
@@ -57,6 +58,14 @@
   - Vertices (3D points) are stored consecutively for a shape
   - Edges (pairs of vertex indices) are stored consecutively for a shape
 
+  Contacts between faceted grains persist for many steps, so the compute keeps a contact list with one bit per
+  feature (see DEMContacts.h) for each entry of the neighbor list. A feature is in the list when it is within the
+  interaction range plus the neighbor list buffer of the circumscribed sphere of the other particle. The list is
+  rebuilt when the neighbor list is, and the force loops skip the features that are not in it. A pair whose
+  particles have moved by more than the buffer since the list was built, counting rotations, evaluates all of its
+  features until the next rebuild. Each entry also holds a contact state (zero for the current potentials) that is
+  carried over to the new entry of the same pair of tags when the list is rebuilt, for use by friction models.
+
   \ingroup computes
 */
 template<typename Real, typename Real4, typename Potential>
@@ -149,12 +158,39 @@ class DEM3DForceCompute : public ForceCompute
         GPUArray<Real> m_faceRcutSq; //!< face index->rcut*rcut
         GPUArray<Real> m_edgeRcutSq; //!< edge index->rcut*rcut
         GPUArray<Real4> m_verts; //! Vertices for each real index
+        GPUArray<Real> m_typeRadius; //!< type->largest distance of a vertex from the center
+        unsigned int m_maxTypeEdges; //!< Maximum number of edges of any shape
+        GPUArray<unsigned int> m_contacts; //!< Contact bits for each neighbor list entry
+        GPUArray<unsigned int> m_contactTag; //!< Tag of the neighbor for each neighbor list entry
+        GPUArray<unsigned int> m_contactTagAlt; //!< Neighbor tags of the previous contact list
+        GPUArray<Scalar4> m_contactState; //!< Contact state for each neighbor list entry
+        GPUArray<Scalar4> m_contactStateAlt; //!< Contact states of the previous contact list
+        GPUArray<uint2> m_contactRange; //!< tag->first neighbor list entry and number of neighbors
+        GPUArray<uint2> m_contactRangeAlt; //!< Neighbor list ranges of the previous contact list
+        GPUArray<Scalar4> m_contactPos; //!< Particle positions when the contact list was built
+        GPUArray<Scalar4> m_contactOrientation; //!< Particle orientations when the contact list was built
+        unsigned int m_contactWords; //!< Number of words of contact bits per neighbor list entry
+        Scalar m_contactBuffer; //!< Buffer distance of the contact list
+        uint64_t m_contactNlistUpdates; //!< Number of neighbor list updates when the contact list was built
+        bool m_contactsValid; //!< False when the contact list must be rebuilt
         std::vector<std::vector<vec3<Real> > > m_shapes; //!< Vertices for each type
         std::vector<std::vector<std::vector<unsigned int> > > m_facesVec; //!< Faces for each type
 
         //! Re-send the list of vertices and links to the GPU
         void createGeometry();
 
+        //! Number of features per pair in the contact list
+        unsigned int maxContactFeatures() const
+            {
+            return 2*(unsigned int)maxVertices() + m_maxTypeEdges;
+            }
+
+        //! Test if the contact list must be rebuilt, and resize its arrays if so
+        bool contactsNeedRebuild();
+
+        //! Rebuild the contact list on the CPU
+        virtual void rebuildContacts();
+
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
     };
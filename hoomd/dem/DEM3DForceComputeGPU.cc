@@ -108,6 +108,10 @@ void DEM3DForceComputeGPU<Real, Real4, Potential>::computeForces(unsigned int ti
     // start by updating the neighborlist
     this->m_nlist->compute(timestep);
 
+    // rebuild the contact list along with the neighbor list
+    if (this->contactsNeedRebuild())
+        rebuildContacts();
+
     // start the profile
     if (this->m_prof) this->m_prof->push(this->m_exec_conf, "DEM3D pair");
 
@@ -167,6 +171,11 @@ void DEM3DForceComputeGPU<Real, Real4, Potential>::computeForces(unsigned int ti
         access_mode::read);
     ArrayHandle<Real> d_edgeRcutSq(this->m_edgeRcutSq, access_location::device,
         access_mode::read);
+    ArrayHandle<Real> d_typeRadius(this->m_typeRadius, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_contacts(this->m_contacts, access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_contactPos(this->m_contactPos, access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_contactOrientation(this->m_contactOrientation, access_location::device,
+        access_mode::read);
     BoxDim box = this->m_pdata->getBox();
 
     ArrayHandle<Real4> d_force(this->m_force,access_location::device,access_mode::overwrite);
@@ -190,7 +199,10 @@ void DEM3DForceComputeGPU<Real, Real4, Potential>::computeForces(unsigned int ti
         d_head_list.data, this->m_evaluator, this->m_r_cut * this->m_r_cut,
         (unsigned int)particlesPerBlock, d_firstTypeVert.data, d_numTypeVerts.data,
         d_firstTypeEdge.data, d_numTypeEdges.data, d_numTypeFaces.data,
-        d_vertexConnectivity.data, d_edges.data);
+        d_vertexConnectivity.data, d_edges.data, d_contacts.data,
+        this->m_contactWords, d_contactPos.data, d_contactOrientation.data,
+        d_typeRadius.data, this->m_contactBuffer,
+        this->m_exec_conf->isDeterministicReductions());
 
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
@@ -203,6 +215,64 @@ void DEM3DForceComputeGPU<Real, Real4, Potential>::computeForces(unsigned int ti
     if (this->m_prof) this->m_prof->pop(this->m_exec_conf, flops, mem_transfer);
     }
 
+/*! Calls gpu_rebuild_dem3d_contacts to mark the features of each neighbor pair that may interact and to carry over
+  the contact states, then records the positions and orientations the list was built with.
+*/
+template<typename Real, typename Real4, typename Potential>
+void DEM3DForceComputeGPU<Real, Real4, Potential>::rebuildContacts()
+    {
+    const unsigned int N(this->m_pdata->getN());
+    const unsigned int n_all(N + this->m_pdata->getNGhosts());
+
+    ArrayHandle<unsigned int> d_n_neigh(this->m_nlist->getNNeighArray(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_nlist(this->m_nlist->getNListArray(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_head_list(this->m_nlist->getHeadList(), access_location::device, access_mode::read);
+
+    ArrayHandle<Scalar4> d_pos(this->m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_quat(this->m_pdata->getOrientationArray(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar> d_diam(this->m_pdata->getDiameters(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_tag(this->m_pdata->getTags(), access_location::device, access_mode::read);
+
+    ArrayHandle<Real4> d_verts(this->m_verts, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_firstTypeVert(this->m_firstTypeVert, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_numTypeVerts(this->m_numTypeVerts, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_firstTypeEdge(this->m_firstTypeEdge, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_numTypeEdges(this->m_numTypeEdges, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_edges(this->m_edges, access_location::device, access_mode::read);
+    ArrayHandle<Real> d_typeRadius(this->m_typeRadius, access_location::device, access_mode::read);
+
+    ArrayHandle<unsigned int> d_contacts(this->m_contacts, access_location::device, access_mode::overwrite);
+    ArrayHandle<unsigned int> d_contactTag(this->m_contactTag, access_location::device, access_mode::overwrite);
+    ArrayHandle<Scalar4> d_contactState(this->m_contactState, access_location::device, access_mode::overwrite);
+    ArrayHandle<uint2> d_contactRange(this->m_contactRange, access_location::device, access_mode::overwrite);
+    ArrayHandle<unsigned int> d_contactTagAlt(this->m_contactTagAlt, access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_contactStateAlt(this->m_contactStateAlt, access_location::device, access_mode::read);
+    ArrayHandle<uint2> d_contactRangeAlt(this->m_contactRangeAlt, access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_contactPos(this->m_contactPos, access_location::device, access_mode::overwrite);
+    ArrayHandle<Scalar4> d_contactOrientation(this->m_contactOrientation, access_location::device,
+        access_mode::overwrite);
+
+    hipMemcpy(d_contactPos.data, d_pos.data, sizeof(Scalar4)*n_all, hipMemcpyDeviceToDevice);
+    hipMemcpy(d_contactOrientation.data, d_quat.data, sizeof(Scalar4)*n_all, hipMemcpyDeviceToDevice);
+    hipMemset(d_contactRange.data, 0, sizeof(uint2)*this->m_contactRange.getNumElements());
+
+    if (N == 0)
+        return;
+
+    gpu_rebuild_dem3d_contacts<Real, Real4, DEMEvaluator<Real, Real4, Potential> >(
+        d_pos.data, d_quat.data, d_diam.data, d_tag.data, N,
+        this->m_pdata->getBox(), d_n_neigh.data, d_nlist.data, d_head_list.data,
+        this->m_evaluator, this->m_contactBuffer, d_verts.data, d_firstTypeVert.data,
+        d_numTypeVerts.data, d_firstTypeEdge.data, d_numTypeEdges.data, d_edges.data,
+        d_typeRadius.data, (unsigned int)this->maxVertices(), this->m_contactWords,
+        d_contacts.data, d_contactTag.data, d_contactState.data, d_contactRange.data,
+        d_contactTagAlt.data, d_contactStateAlt.data, d_contactRangeAlt.data,
+        (unsigned int)this->m_contactRangeAlt.getNumElements());
+
+    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
 #endif
 
 #ifdef WIN32
@@ -57,6 +57,9 @@ class DEM3DForceComputeGPU: public DEM3DForceCompute<Real, Real4, Potential>
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
+
+        //! Rebuild the contact list on the GPU
+        virtual void rebuildContacts();
     };
 
 #include "DEM3DForceComputeGPU.cc"
@@ -18,6 +18,8 @@
 #include "DEM3DForceGPU.cuh"
 #include "hoomd/HOOMDMath.h"
 #include "atomics.cuh"
+#include "hoomd/FixedPointAtomics.cuh"
+#include "DEMContacts.h"
 #include "WCAPotential.h"
 #include "SWCAPotential.h"
 
@@ -45,6 +47,13 @@
   \param potential Parameters for the given potential (such as sigma for WCA)
   \param r_cutsq Precomputed r_cut*r_cut, where r_cut is the radius beyond which the
   force is set to 0
+  \param d_contacts Contact bits for each neighbor list entry
+  \param contactWords Number of words of contact bits per neighbor list entry
+  \param d_contactPos Particle positions when the contact list was built
+  \param d_contactOrientation Particle orientations when the contact list was built
+  \param d_typeRadius Largest distance of a vertex from the center for each type
+  \param contactBuffer Buffer distance of the contact list
+  \param deterministic Accumulate in fixed point for reproducible results
 
   Enough shared memory to hold vertexCount Scalar2's and unsigned int's
   as well as blockDim.x (1*Scalar4 and 6*Scalars) should be allocated
@@ -54,6 +63,11 @@
   Each block will calculate the forces for blockDim.x particles.
   Each thread will calculate the force contribution for one vertex being treated as a vertex or an edge.
   The neighborlist is arranged in columns so that reads are fully coalesced when doing this.
+  Each thread skips the neighbors for which its feature is not in the contact list, unless the pair moved by more
+  than the buffer since the contact list was built.
+  When \a deterministic is set, the threads of a particle add to fixed point accumulators (13*blockDim.x unsigned long
+  long ints more shared memory) instead of the floating point ones, so that the sum does not depend on the order of the
+  additions.
 */
 template<typename Real, typename Real4, typename Evaluator>
 __global__ void gpu_compute_dem3d_forces_kernel(
@@ -71,7 +85,11 @@ __global__ void gpu_compute_dem3d_forces_kernel(
     const Real r_cutsq, const unsigned int *d_firstTypeVert,
     const unsigned int *d_numTypeVerts, const unsigned int *d_firstTypeEdge,
     const unsigned int *d_numTypeEdges, const unsigned int *d_numTypeFaces,
-    const unsigned int *d_vertexConnectivity, const unsigned int *d_edges)
+    const unsigned int *d_vertexConnectivity, const unsigned int *d_edges,
+    const unsigned int *d_contacts, const unsigned int contactWords,
+    const Scalar4 *d_contactPos, const Scalar4 *d_contactOrientation,
+    const Real *d_typeRadius, const Scalar contactBuffer,
+    const bool deterministic)
     {
     HIP_DYNAMIC_SHARED( int, sh)
 
@@ -126,6 +144,12 @@ __global__ void gpu_compute_dem3d_forces_kernel(
     unsigned int *vertexConnectivity((unsigned int*)&sh[shOffset]);
     shOffset += numVerts;
 
+    // fixed point accumulators for partForces, partTorques, and
+    // partVirials in deterministic mode
+    unsigned long long int *partFixed(NULL);
+    if(deterministic)
+        partFixed = (unsigned long long int*)&sh[(shOffset + 1)/2*2];
+
     // partIdx is the absolute index of the particle this thread is
     // calculating for
     size_t partIdx(blockIdx.x*blockDim.x + threadIdx.x);
@@ -203,6 +227,9 @@ __global__ void gpu_compute_dem3d_forces_kernel(
         partTorques[threadIdx.x] = make_scalar4(0.0f, 0.0f, 0.0f, 0.0f);
         for(size_t i(0); i < 6; ++i)
             partVirials[6*threadIdx.x + i] = 0.0f;
+        if(deterministic)
+            for(size_t i(0); i < 13; ++i)
+                partFixed[13*threadIdx.x + i] = 0;
         }
 
     // Don't calculate results for nonsensical features
@@ -245,6 +272,10 @@ __global__ void gpu_compute_dem3d_forces_kernel(
             vi = vec3<Scalar>(
                 __ldg(d_velocity + partIdx));
 
+        // distance that the features of i moved since the contact list was built
+        const Scalar disp_i(contactDisplacement(box, postype, __ldg(d_contactPos + partIdx),
+            quati, __ldg(d_contactOrientation + partIdx), d_typeRadius[type_i]));
+
         for(unsigned int featureEpoch(0);
             featureEpoch < (maxFeatures + blockDim.y - 1)/blockDim.y; ++featureEpoch)
             {
@@ -274,7 +305,8 @@ __global__ void gpu_compute_dem3d_forces_kernel(
                 // read the current neighbor index (MEM TRANSFER: 4 bytes)
                 // prefetch the next value and set the current one
                 cur_neigh = next_neigh;
-                next_neigh = d_nlist[myHead + neigh_idx + 1];
+                if (neigh_idx + 1 < n_neigh)
+                    next_neigh = d_nlist[myHead + neigh_idx + 1];
 
                 // grab the position and type of the neighbor
                 const Scalar4 neigh_postype(__ldg(d_pos + cur_neigh));
@@ -306,6 +338,13 @@ __global__ void gpu_compute_dem3d_forces_kernel(
                     const quat<Real> neighQuat(
                         neighQuatF.x, vec3<Real>(neighQuatF.y, neighQuatF.z, neighQuatF.w));
 
+                    // skip features that are not in the contact list
+                    const Scalar disp_j(contactDisplacement(box, neigh_postype, __ldg(d_contactPos + cur_neigh),
+                        neighQuatF, __ldg(d_contactOrientation + cur_neigh), d_typeRadius[type_j]));
+                    if(disp_i + disp_j <= contactBuffer &&
+                        !contactFeatureActive(d_contacts, myHead + neigh_idx, contactWords, localFeatureIdx))
+                        continue;
+
                     if (Evaluator::needsVelocity())
                         {
                         Scalar4 vj(__ldg(d_velocity + cur_neigh));
@@ -426,7 +465,22 @@ __global__ void gpu_compute_dem3d_forces_kernel(
 
     // sum all the intermediate force and torque values for each
     // particle we calculate for in the block.
-    if(partIdx < N)
+    if(partIdx < N && deterministic)
+        {
+        unsigned long long int *fixed(partFixed + 13*threadIdx.x);
+        hoomd::detail::atomicAddFixedPoint(fixed + 0, localForce.x);
+        hoomd::detail::atomicAddFixedPoint(fixed + 1, localForce.y);
+        hoomd::detail::atomicAddFixedPoint(fixed + 2, localForce.z);
+        hoomd::detail::atomicAddFixedPoint(fixed + 3, localForce.w);
+
+        hoomd::detail::atomicAddFixedPoint(fixed + 4, localTorque.x);
+        hoomd::detail::atomicAddFixedPoint(fixed + 5, localTorque.y);
+        hoomd::detail::atomicAddFixedPoint(fixed + 6, localTorque.z);
+
+        for(size_t i(0); i < 6; ++i)
+            hoomd::detail::atomicAddFixedPoint(fixed + 7 + i, localVirial[i]);
+        }
+    else if(partIdx < N)
         {
         genAtomicAdd((Real *) &partForces[threadIdx.x].x, (Real) localForce.x);
         genAtomicAdd((Real *) &partForces[threadIdx.x].y, (Real) localForce.y);
@@ -443,6 +497,23 @@ __global__ void gpu_compute_dem3d_forces_kernel(
 
     __syncthreads();
 
+    // convert the fixed point sums
+    if(deterministic && partIdx < N && threadIdx.y == 0)
+        {
+        const unsigned long long int *fixed(partFixed + 13*threadIdx.x);
+        partForces[threadIdx.x] = make_scalar4(hoomd::detail::fixedPointToScalar(fixed[0]),
+            hoomd::detail::fixedPointToScalar(fixed[1]),
+            hoomd::detail::fixedPointToScalar(fixed[2]),
+            hoomd::detail::fixedPointToScalar(fixed[3]));
+        partTorques[threadIdx.x] = make_scalar4(hoomd::detail::fixedPointToScalar(fixed[4]),
+            hoomd::detail::fixedPointToScalar(fixed[5]),
+            hoomd::detail::fixedPointToScalar(fixed[6]),
+            0.0f);
+
+        for(size_t i(0); i < 6; ++i)
+            partVirials[6*threadIdx.x + i] = hoomd::detail::fixedPointToScalar(fixed[7 + i]);
+        }
+
     // finally, write the result.
     if(partIdx < N && threadIdx.y == 0)
         {
@@ -474,6 +545,13 @@ __global__ void gpu_compute_dem3d_forces_kernel(
   force is set to 0
   \param particlesPerBlock Block size to execute
   \param maxVerts Maximum number of vertices in any shape
+  \param d_contacts Contact bits for each neighbor list entry
+  \param contactWords Number of words of contact bits per neighbor list entry
+  \param d_contactPos Particle positions when the contact list was built
+  \param d_contactOrientation Particle orientations when the contact list was built
+  \param d_typeRadius Largest distance of a vertex from the center for each type
+  \param contactBuffer Buffer distance of the contact list
+  \param deterministic Accumulate in fixed point for reproducible results
 
   \returns Any error code resulting from the kernel launch
 
@@ -496,7 +574,10 @@ hipError_t gpu_compute_dem3d_forces(
     const unsigned int *d_firstTypeVert, const unsigned int *d_numTypeVerts,
     const unsigned int *d_firstTypeEdge, const unsigned int *d_numTypeEdges,
     const unsigned int *d_numTypeFaces, const unsigned int *d_vertexConnectivity,
-    const unsigned int *d_edges)
+    const unsigned int *d_edges, const unsigned int *d_contacts,
+    const unsigned int contactWords, const Scalar4 *d_contactPos,
+    const Scalar4 *d_contactOrientation, const Real *d_typeRadius,
+    const Scalar contactBuffer, const bool deterministic)
     {
 
     // setup the grid to run the kernel
@@ -510,11 +591,14 @@ hipError_t gpu_compute_dem3d_forces(
     dim3 threads(particlesPerBlock, numFeatures, 1);
 
     // Calculate the amount of shared memory required
-    const size_t shmSize(2*particlesPerBlock*sizeof(Real4) + 6*particlesPerBlock*sizeof(Real) + // forces, torques, virials per-particle
+    size_t shmSize(2*particlesPerBlock*sizeof(Real4) + 6*particlesPerBlock*sizeof(Real) + // forces, torques, virials per-particle
         2*numFaces*sizeof(unsigned int) + // face->next face, face->first vertex in face
         2*numDegenerateVerts*sizeof(unsigned int) + // vertex->next vertex, vertex->real vertex
         numVerts*sizeof(Real4) + 2*numEdges*sizeof(unsigned int) + // real vertex->point, edge->real index
         5*numTypes*sizeof(unsigned int) + numVerts*sizeof(unsigned int)); // per-type counts and per-vertex connectivity
+    // 13 fixed point accumulators per particle, aligned to 8 bytes
+    if(deterministic)
+        shmSize += (13*particlesPerBlock + 1)*sizeof(unsigned long long int);
 
     // run the kernel
     hipLaunchKernelGGL((gpu_compute_dem3d_forces_kernel<Real, Real4, Evaluator>), dim3(grid), dim3(threads), shmSize, 0, d_pos, d_quat, d_force, d_torque, d_virial, virial_pitch, N,
@@ -524,7 +608,138 @@ hipError_t gpu_compute_dem3d_forces(
         numEdges, numTypes, box, d_n_neigh, d_nlist, d_head_list, evaluator,
         r_cutsq, d_firstTypeVert, d_numTypeVerts, d_firstTypeEdge,
         d_numTypeEdges, d_numTypeFaces, d_vertexConnectivity,
-        d_edges);
+        d_edges, d_contacts, contactWords, d_contactPos,
+        d_contactOrientation, d_typeRadius, contactBuffer, deterministic);
+
+    return hipSuccess;
+    }
+
+//! Kernel for rebuilding the contact list of DEM3DForceComputeGPU
+/*! \param d_pos particle positions on the GPU
+  \param d_quat particle orientations on the GPU
+  \param d_diam particle diameters on the GPU
+  \param d_tag particle tags on the GPU
+  \param N number of particles
+  \param box Box dimensions (in GPU format) to use for periodic boundary conditions
+  \param d_n_neigh Device memory array listing the number of neighbors for each particle
+  \param d_nlist Device memory array containing the neighbor list contents
+  \param d_head_list Device memory array listing the first neighbor list entry of each particle
+  \param evaluator Evaluator of the potential
+  \param contactBuffer Buffer distance of the contact list
+  \param d_vertices Real vertex index->vertex
+  \param d_firstTypeVert Type->first real vertex index
+  \param d_numTypeVerts Type->number of vertices
+  \param d_firstTypeEdge Type->first edge
+  \param d_numTypeEdges Type->number of edges
+  \param d_edges 2*edge->first real vertex, 2*edge+1->second real vertex
+  \param d_typeRadius Largest distance of a vertex from the center for each type
+  \param maxVertices Maximum number of vertices in any shape
+  \param contactWords Number of words of contact bits per neighbor list entry
+  \param d_contacts Output: contact bits for each neighbor list entry
+  \param d_contactTag Output: tag of the neighbor for each neighbor list entry
+  \param d_contactState Output: contact state for each neighbor list entry
+  \param d_contactRange Output: tag->first neighbor list entry and number of neighbors
+  \param d_oldContactTag Neighbor tags of the previous contact list
+  \param d_oldContactState Contact states of the previous contact list
+  \param d_oldContactRange Neighbor list ranges of the previous contact list
+  \param n_old_tags Number of entries in \a d_oldContactRange
+
+  Each thread rebuilds the contact list entries of one particle.
+*/
+template<typename Real, typename Real4, typename Evaluator>
+__global__ void gpu_rebuild_dem3d_contacts_kernel(
+    const Scalar4 *d_pos, const Scalar4 *d_quat, const Scalar *d_diam,
+    const unsigned int *d_tag, const unsigned int N, const BoxDim box,
+    const unsigned int *d_n_neigh, const unsigned int *d_nlist,
+    const unsigned int *d_head_list, Evaluator evaluator, const Scalar contactBuffer,
+    const Real4 *d_vertices, const unsigned int *d_firstTypeVert,
+    const unsigned int *d_numTypeVerts, const unsigned int *d_firstTypeEdge,
+    const unsigned int *d_numTypeEdges, const unsigned int *d_edges,
+    const Real *d_typeRadius, const unsigned int maxVertices,
+    const unsigned int contactWords, unsigned int *d_contacts,
+    unsigned int *d_contactTag, Scalar4 *d_contactState, uint2 *d_contactRange,
+    const unsigned int *d_oldContactTag, const Scalar4 *d_oldContactState,
+    const uint2 *d_oldContactRange, const unsigned int n_old_tags)
+    {
+    const unsigned int idx(blockIdx.x*blockDim.x + threadIdx.x);
+    if(idx >= N)
+        return;
+
+    const Scalar4 postype(__ldg(d_pos + idx));
+    const vec3<Scalar> pos_i(postype.x, postype.y, postype.z);
+    const unsigned int type_i(__scalar_as_int(postype.w));
+    const Scalar4 quati(__ldg(d_quat + idx));
+    const quat<Real> quat_i(quati.x, vec3<Real>(quati.y, quati.z, quati.w));
+    const unsigned int tag_i(__ldg(d_tag + idx));
+
+    Scalar di(0);
+    if (Evaluator::needsDiameter())
+        di = __ldg(d_diam + idx);
+
+    const unsigned int n_neigh(d_n_neigh[idx]);
+    const unsigned int myHead(d_head_list[idx]);
+    d_contactRange[tag_i] = make_uint2(myHead, n_neigh);
+
+    uint2 old_range(make_uint2(0, 0));
+    if(tag_i < n_old_tags)
+        old_range = d_oldContactRange[tag_i];
+
+    for(unsigned int neigh_idx(0); neigh_idx < n_neigh; ++neigh_idx)
+        {
+        const unsigned int cur_neigh(d_nlist[myHead + neigh_idx]);
+
+        const Scalar4 neigh_postype(__ldg(d_pos + cur_neigh));
+        const unsigned int type_j(__scalar_as_int(neigh_postype.w));
+        const vec3<Scalar> neigh_pos(neigh_postype.x, neigh_postype.y, neigh_postype.z);
+        const vec3<Real> rij(vec3<Scalar>(box.minImage(vec_to_scalar3(neigh_pos - pos_i))));
+        const Scalar4 neighQuatF(__ldg(d_quat + cur_neigh));
+        const quat<Real> neighQuat(neighQuatF.x, vec3<Real>(neighQuatF.y, neighQuatF.z, neighQuatF.w));
+
+        if (Evaluator::needsDiameter())
+            evaluator.setDiameter(di, __ldg(d_diam + cur_neigh));
+        const Real reach(evaluator.getRange() + contactBuffer);
+
+        const bool any(findContactFeatures(rij, quat_i, neighQuat, type_i, type_j,
+            d_typeRadius[type_i] + reach, d_typeRadius[type_j] + reach,
+            d_vertices, d_firstTypeVert, d_numTypeVerts, d_firstTypeEdge, d_numTypeEdges, d_edges,
+            maxVertices, contactWords, d_contacts + (myHead + neigh_idx)*contactWords));
+
+        const unsigned int tag_j(__ldg(d_tag + cur_neigh));
+        d_contactTag[myHead + neigh_idx] = tag_j;
+        d_contactState[myHead + neigh_idx] = any ?
+            findContactState(old_range, d_oldContactTag, d_oldContactState, tag_j): make_scalar4(0, 0, 0, 0);
+        }
+    }
+
+/*! \returns Any error code resulting from the kernel launch
+
+  This is just a driver for gpu_rebuild_dem3d_contacts_kernel, see the documentation for it for more information.
+*/
+template<typename Real, typename Real4, typename Evaluator>
+hipError_t gpu_rebuild_dem3d_contacts(
+    const Scalar4 *d_pos, const Scalar4 *d_quat, const Scalar *d_diam,
+    const unsigned int *d_tag, const unsigned int N, const BoxDim& box,
+    const unsigned int *d_n_neigh, const unsigned int *d_nlist,
+    const unsigned int *d_head_list, const Evaluator evaluator, const Scalar contactBuffer,
+    const Real4 *d_vertices, const unsigned int *d_firstTypeVert,
+    const unsigned int *d_numTypeVerts, const unsigned int *d_firstTypeEdge,
+    const unsigned int *d_numTypeEdges, const unsigned int *d_edges,
+    const Real *d_typeRadius, const unsigned int maxVertices,
+    const unsigned int contactWords, unsigned int *d_contacts,
+    unsigned int *d_contactTag, Scalar4 *d_contactState, uint2 *d_contactRange,
+    const unsigned int *d_oldContactTag, const Scalar4 *d_oldContactState,
+    const uint2 *d_oldContactRange, const unsigned int n_old_tags)
+    {
+    const unsigned int block_size(256);
+    dim3 grid(N/block_size + 1, 1, 1);
+    dim3 threads(block_size, 1, 1);
+
+    hipLaunchKernelGGL((gpu_rebuild_dem3d_contacts_kernel<Real, Real4, Evaluator>), dim3(grid), dim3(threads), 0, 0,
+        d_pos, d_quat, d_diam, d_tag, N, box, d_n_neigh, d_nlist, d_head_list, evaluator,
+        contactBuffer, d_vertices, d_firstTypeVert, d_numTypeVerts, d_firstTypeEdge,
+        d_numTypeEdges, d_edges, d_typeRadius, maxVertices, contactWords, d_contacts,
+        d_contactTag, d_contactState, d_contactRange, d_oldContactTag, d_oldContactState,
+        d_oldContactRange, n_old_tags);
 
     return hipSuccess;
     }
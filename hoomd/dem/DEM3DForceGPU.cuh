@@ -56,7 +56,46 @@ hipError_t gpu_compute_dem3d_forces(
     const unsigned int *d_numTypeEdges,
     const unsigned int *d_numTypeFaces,
     const unsigned int *d_vertexConnectivity,
-    const unsigned int *d_edges);
+    const unsigned int *d_edges,
+    const unsigned int *d_contacts,
+    const unsigned int contactWords,
+    const Scalar4 *d_contactPos,
+    const Scalar4 *d_contactOrientation,
+    const Real *d_typeRadius,
+    const Scalar contactBuffer,
+    const bool deterministic);
+
+//! Kernel driver that rebuilds the contact list of DEM3DForceComputeGPU
+template<typename Real,  typename Real4, typename Evaluator>
+hipError_t gpu_rebuild_dem3d_contacts(
+    const Scalar4 *d_pos,
+    const Scalar4 *d_quat,
+    const Scalar *d_diam,
+    const unsigned int *d_tag,
+    const unsigned int N,
+    const BoxDim& box,
+    const unsigned int *d_n_neigh,
+    const unsigned int *d_nlist,
+    const unsigned int *d_head_list,
+    const Evaluator evaluator,
+    const Scalar contactBuffer,
+    const Real4 *d_vertices,
+    const unsigned int *d_firstTypeVert,
+    const unsigned int *d_numTypeVerts,
+    const unsigned int *d_firstTypeEdge,
+    const unsigned int *d_numTypeEdges,
+    const unsigned int *d_edges,
+    const Real *d_typeRadius,
+    const unsigned int maxVertices,
+    const unsigned int contactWords,
+    unsigned int *d_contacts,
+    unsigned int *d_contactTag,
+    Scalar4 *d_contactState,
+    uint2 *d_contactRange,
+    const unsigned int *d_oldContactTag,
+    const Scalar4 *d_oldContactState,
+    const uint2 *d_oldContactRange,
+    const unsigned int n_old_tags);
 
 #endif
 
@@ -0,0 +1,177 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file DEMContacts.h
+  \brief Declares the helper functions for the persistent contact list of DEM3DForceCompute
+*/
+
+#ifndef __DEMCONTACTS_H__
+#define __DEMCONTACTS_H__
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/BoxDim.h"
+#include "VectorMath.h"
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// DEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#undef DEVICE
+#ifdef __HIPCC__
+#define DEVICE __host__ __device__
+#else
+#define DEVICE
+#endif
+
+/*! The contact list stores, for every entry of the neighbor list, one bit for each feature of the pair that may
+  interact. Features are numbered as the threads of the GPU kernel: feature f < maxVertices is vertex f of particle
+  i against the faces, edges, or vertices of j; maxVertices <= f < 2*maxVertices is vertex f - maxVertices of j
+  against the faces or edges of i; and f >= 2*maxVertices is edge f - 2*maxVertices of i against the edges of j.
+*/
+
+//! Upper bound on the distance any point of a particle moved since the contact list was built
+/*! \param box Simulation box
+  \param postype Current position of the particle
+  \param ref_postype Position of the particle when the contact list was built
+  \param orientation Current orientation of the particle
+  \param ref_orientation Orientation of the particle when the contact list was built
+  \param radius Largest distance between the center and a vertex of the particle's shape
+
+  Rotating the orientation from q0 to q1 moves a point at distance r from the center by at most 2 r |q1 - q0|.
+*/
+DEVICE inline Scalar contactDisplacement(const BoxDim& box, const Scalar4& postype, const Scalar4& ref_postype,
+    const Scalar4& orientation, const Scalar4& ref_orientation, const Scalar radius)
+    {
+    const Scalar3 dr(box.minImage(make_scalar3(postype.x - ref_postype.x, postype.y - ref_postype.y,
+        postype.z - ref_postype.z)));
+    const Scalar4 dq(make_scalar4(orientation.x - ref_orientation.x, orientation.y - ref_orientation.y,
+        orientation.z - ref_orientation.z, orientation.w - ref_orientation.w));
+    return sqrt(dot(dr, dr)) + Scalar(2.0)*radius*sqrt(dq.x*dq.x + dq.y*dq.y + dq.z*dq.z + dq.w*dq.w);
+    }
+
+//! Test if a feature of a neighbor pair is in the contact list
+/*! \param contacts Contact bits of all neighbor list entries
+  \param slot Index of the pair in the neighbor list
+  \param contactWords Number of words of contact bits per neighbor list entry
+  \param feature Feature index
+*/
+DEVICE inline bool contactFeatureActive(const unsigned int *contacts, const unsigned int slot,
+    const unsigned int contactWords, const unsigned int feature)
+    {
+    return (contacts[slot*contactWords + feature/32] >> (feature % 32)) & 1;
+    }
+
+//! Distance between a point and an edge
+/*! \param p0 First vertex of the edge
+  \param p1 Second vertex of the edge
+  \param r Point
+*/
+template<typename Real>
+DEVICE inline Real edgePointDistance(const vec3<Real> &p0, const vec3<Real> &p1, const vec3<Real> &r)
+    {
+    const vec3<Real> edge(p1 - p0);
+    const Real lengthsq(dot(edge, edge));
+    Real t(0);
+    if(lengthsq > Real(0))
+        {
+        t = dot(r - p0, edge)/lengthsq;
+        t = t < Real(0) ? Real(0): (t > Real(1) ? Real(1): t);
+        }
+    const vec3<Real> delta(p0 + t*edge - r);
+    return sqrt(dot(delta, delta));
+    }
+
+//! Find the features of a neighbor pair that may interact
+/*! \param rij Vector from the center of particle i to the center of particle j
+  \param quat_i Orientation of particle i
+  \param quat_j Orientation of particle j
+  \param type_i Type of particle i
+  \param type_j Type of particle j
+  \param reach_i Distance from the center of particle i within which features of j may interact with it
+  \param reach_j Distance from the center of particle j within which features of i may interact with it
+  \param vertices Real vertex index->vertex
+  \param firstTypeVert Type->first real vertex index
+  \param numTypeVerts Type->number of vertices
+  \param firstTypeEdge Type->first edge
+  \param numTypeEdges Type->number of edges
+  \param edges 2*edge->first real vertex, 2*edge+1->second real vertex
+  \param maxVertices Maximum number of vertices of any shape
+  \param contactWords Number of words of contact bits per pair
+  \param contacts Output: contactWords words of contact bits for the pair
+
+  Every point of the shape of particle j lies within its circumscribed radius of the center of j, so a feature of i
+  that is further than reach_j = radius_j + interaction range + buffer from the center of j cannot interact with j
+  until the two particles have moved by more than the buffer.
+
+  \returns True if any feature of the pair may interact
+*/
+template<typename Real, typename Real4, typename Quat>
+DEVICE inline bool findContactFeatures(const vec3<Real> &rij, const Quat &quat_i, const Quat &quat_j,
+    const unsigned int type_i, const unsigned int type_j, const Real reach_i, const Real reach_j,
+    const Real4 *vertices, const unsigned int *firstTypeVert, const unsigned int *numTypeVerts,
+    const unsigned int *firstTypeEdge, const unsigned int *numTypeEdges, const unsigned int *edges,
+    const unsigned int maxVertices, const unsigned int contactWords, unsigned int *contacts)
+    {
+    for(unsigned int word(0); word < contactWords; ++word)
+        contacts[word] = 0;
+
+    bool any(false);
+
+    // vertices of i
+    for(unsigned int vertIndex(0); vertIndex < numTypeVerts[type_i]; ++vertIndex)
+        {
+        const vec3<Real> r0(rotate(quat_i, vec3<Real>(vertices[firstTypeVert[type_i] + vertIndex])) - rij);
+        if(dot(r0, r0) < reach_j*reach_j)
+            {
+            contacts[vertIndex/32] |= 1u << (vertIndex % 32);
+            any = true;
+            }
+        }
+
+    // vertices of j
+    for(unsigned int vertIndex(0); vertIndex < numTypeVerts[type_j]; ++vertIndex)
+        {
+        const vec3<Real> r0(rotate(quat_j, vec3<Real>(vertices[firstTypeVert[type_j] + vertIndex])) + rij);
+        if(dot(r0, r0) < reach_i*reach_i)
+            {
+            const unsigned int feature(maxVertices + vertIndex);
+            contacts[feature/32] |= 1u << (feature % 32);
+            any = true;
+            }
+        }
+
+    // edges of i
+    for(unsigned int edgeIndex(0); edgeIndex < numTypeEdges[type_i]; ++edgeIndex)
+        {
+        const unsigned int edge(firstTypeEdge[type_i] + edgeIndex);
+        const vec3<Real> p0(rotate(quat_i, vec3<Real>(vertices[edges[2*edge]])));
+        const vec3<Real> p1(rotate(quat_i, vec3<Real>(vertices[edges[2*edge + 1]])));
+        if(edgePointDistance(p0, p1, rij) < reach_j)
+            {
+            const unsigned int feature(2*maxVertices + edgeIndex);
+            contacts[feature/32] |= 1u << (feature % 32);
+            any = true;
+            }
+        }
+
+    return any;
+    }
+
+//! Find the contact state of a pair in the contact list built before the last neighbor list update
+/*! \param range First neighbor list entry and number of neighbors of particle i in the old contact list
+  \param tags Tag of the neighbor for each entry of the old contact list
+  \param state Contact state for each entry of the old contact list
+  \param tag_j Tag of the neighbor
+
+  \returns The old contact state, or zero if j was not a neighbor of i
+*/
+DEVICE inline Scalar4 findContactState(const uint2 &range, const unsigned int *tags, const Scalar4 *state,
+    const unsigned int tag_j)
+    {
+    for(unsigned int slot(range.x); slot < range.x + range.y; ++slot)
+        {
+        if(tags[slot] == tag_j)
+            return state[slot];
+        }
+    return make_scalar4(0, 0, 0, 0);
+    }
+
+#endif
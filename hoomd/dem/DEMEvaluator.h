@@ -108,6 +108,10 @@ class DEMEvaluator
         DEVICE inline bool withinCutoff(const Real rsq, const Real r_cut_sq)
             {return m_potential.withinCutoff(rsq,r_cut_sq);}
 
+        /*! Distance between two features beyond which they do not interact
+         */
+        DEVICE inline Real getRange() const {return m_potential.getRange();}
+
         DEVICE static bool needsDiameter() {return Potential::needsDiameter();}
 
         DEVICE inline void setDiameter(const Real di,const Real dj)
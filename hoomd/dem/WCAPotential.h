@@ -76,6 +76,9 @@ class WCAPotential
         /*! test if particles are within cutoff of this potential*/
         DEVICE inline bool withinCutoff(const Real rsq, const Real r_cutsq) {return rsq<r_cutsq;}
 
+        /*! Distance between two contact points beyond which the potential is zero */
+        DEVICE inline Real getRange() const {return sqrt(m_rcutsq);}
+
         /*! Test if potential needs the diameter (It doesn't) */
         DEVICE static bool needsDiameter() {return false;}
 
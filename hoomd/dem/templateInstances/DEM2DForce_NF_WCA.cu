@@ -16,4 +16,5 @@ template hipError_t gpu_compute_dem2d_forces<Scalar, Scalar2, Scalar4, WCADEM>(
         const unsigned int *d_n_neigh, const unsigned int *d_nlist,
         const unsigned int *d_head_list, const WCADEM potential, const Scalar r_cutsq,
         const unsigned int n_shapes,
-        const unsigned int particlesPerBlock, const unsigned int maxVerts);
+        const unsigned int particlesPerBlock, const unsigned int maxVerts,
+        const bool deterministic);
@@ -52,6 +52,9 @@ class Device:
         # name of the message file
         self._msg_file = msg_file
 
+        # name of the autotuner database file
+        self._tuning_database = None
+
     @property
     def communicator(self):
         """hoomd.communicator.Communicator: The MPI Communicator [read only]."""
@@ -116,6 +119,56 @@ class Device:
         else:
             self._cpp_exec_conf.setNumThreads(int(num_cpu_threads))
 
+    @property
+    def tuning_database(self):
+        """str: File that keeps the autotuned GPU kernel parameters.
+
+        Autotuners choose the launch parameters of the GPU kernels by timing
+        every valid value, which takes many steps for kernels with large
+        parameter spaces. When `tuning_database` is set, HOOMD reads the file
+        (when it exists), each autotuner starts with its stored parameter
+        instead of sweeping, and `Simulation.run` writes the current results
+        back to the file when it completes. The entries are keyed by the
+        kernel, the GPU model, the power of two range of the number of
+        particles, and the parameter space, so one file can serve many systems
+        and GPUs.
+
+        All MPI ranks read the file and rank 0 writes it. Set
+        `tuning_database` before the first `Simulation.run`. Defaults to
+        `None`.
+        """
+        return self._tuning_database
+
+    @tuning_database.setter
+    def tuning_database(self, filename):
+        database = self._cpp_exec_conf.getAutotunerDatabase()
+        database.clear()
+        self._tuning_database = filename
+        if filename is not None and os.path.exists(filename):
+            database.load(filename)
+
+    @property
+    def tuning_database_frozen(self):
+        """bool: Use `tuning_database` without updating it.
+
+        When `True`, autotuners found in the database use the stored
+        parameter and never scan again, and `Simulation.run` does not write
+        the file. Autotuners that are not in the database tune as usual.
+        Freeze the database for production runs after tuning it in earlier
+        jobs. Defaults to `False`.
+        """
+        return self._cpp_exec_conf.getAutotunerDatabase().getFrozen()
+
+    @tuning_database_frozen.setter
+    def tuning_database_frozen(self, frozen):
+        self._cpp_exec_conf.getAutotunerDatabase().setFrozen(bool(frozen))
+
+    def _save_tuning_database(self):
+        database = self._cpp_exec_conf.getAutotunerDatabase()
+        if (self._tuning_database is not None and not database.getFrozen()
+                and self.communicator.rank == 0):
+            database.save(self._tuning_database)
+
 
 def _create_messenger(mpi_config, notice_level, msg_file, shared_msg_file):
     msg = _hoomd.Messenger(mpi_config)
@@ -193,6 +246,18 @@ class GPU(Device):
     process. Override this auto-selection by providing appropriate device ids on
     each rank.
 
+    .. rubric:: Multiple simulations
+
+    Many simulations of small systems do not fill a GPU. Pass the same `GPU`
+    to several `hoomd.Simulation` objects in one process and advance them with
+    `hoomd.Simulation.run_interleaved`. They share one GPU context, one pool of
+    cached temporary allocations, and the autotuner results of the device.
+    When you instead run one simulation per process, enable the CUDA
+    Multi-Process Service (MPS) so the kernels of different processes execute
+    concurrently, and tune once with `tuning_database` and use it with
+    `tuning_database_frozen` in the other processes. Autotuners that time
+    kernels while other processes share the GPU choose poorly.
+
     .. rubric:: Multiple GPUs
 
     Specify a list of GPUs to ``gpu_ids`` to activate a single-process multi-GPU
@@ -253,6 +318,51 @@ class GPU(Device):
     def gpu_error_checking(self, new_bool):
         self._cpp_exec_conf.setCUDAErrorChecking(new_bool)
 
+    @property
+    def mpi_device_direct(self):
+        """bool: Whether to pass GPU buffers directly to MPI.
+
+        When `True`, the domain decomposition communicator and the MPCD cell
+        property reduction pass device pointers to the MPI library, which must
+        be CUDA-aware. When `False`, they stage the communication buffers in
+        host memory. Defaults to `True`
+        in builds with ``ENABLE_MPI_CUDA`` and `False` otherwise. Setting
+        `True` raises an error in builds without ``ENABLE_MPI_CUDA``.
+
+        Set `mpi_device_direct` before calling `Simulation.run`. Compare
+        `Simulation.communication_times` with both settings to measure the
+        difference.
+        """
+        return self._cpp_exec_conf.isMPIDeviceDirect()
+
+    @mpi_device_direct.setter
+    def mpi_device_direct(self, new_bool):
+        self._cpp_exec_conf.setMPIDeviceDirect(new_bool)
+
+    @property
+    def deterministic(self):
+        """bool: Whether to sum forces on the GPU in a reproducible order.
+
+        Several threads add to the force on the same particle with atomic
+        operations in the three body potentials (``hoomd.md.pair.tersoff``
+        and related), the DEM pair potentials (``hoomd.dem.pair``) and the
+        charge assignment of ``hoomd.md.charge.pppm``. The floating point
+        result depends on the order of the additions, so two identical runs
+        diverge. When `True`, these kernels accumulate in 64-bit fixed point
+        numbers instead, which makes the results bitwise reproducible at a
+        small cost in performance. The fixed point numbers resolve
+        :math:`2^{-32}` and hold sums up to :math:`2^{31}` in magnitude.
+        Defaults to `False`.
+
+        Also set ``deterministic=True`` on the neighbor lists, so that the
+        order of the neighbors does not change between runs.
+        """
+        return self._cpp_exec_conf.isDeterministicReductions()
+
+    @deterministic.setter
+    def deterministic(self, new_bool):
+        self._cpp_exec_conf.setDeterministicReductions(new_bool)
+
     @staticmethod
     def is_available():
         """Test if the GPU device is available.
@@ -344,6 +454,37 @@ class CPU(Device):
         if num_cpu_threads is not None:
             self.num_cpu_threads = num_cpu_threads
 
+    @property
+    def huge_pages(self):
+        """bool: Back large per-particle arrays with transparent huge pages.
+
+        When `True`, arrays of at least 2 MiB allocated afterwards ask the
+        kernel for transparent huge pages, which reduces TLB misses in large
+        systems. Defaults to `False`. The hint has no effect when the
+        operating system does not support transparent huge pages.
+        """
+        return self._cpp_exec_conf.getHostHugePages()
+
+    @huge_pages.setter
+    def huge_pages(self, value):
+        self._cpp_exec_conf.setHostHugePages(bool(value))
+
+    @property
+    def numa_interleave(self):
+        """bool: Interleave large per-particle arrays over the NUMA nodes.
+
+        When `False` (the default), the operating system places each page on
+        the NUMA node of the thread that first touches it. Set to `True` when
+        one MPI rank runs TBB threads on several sockets, so that the pages of
+        arrays of at least 2 MiB allocated afterwards are spread over all
+        nodes and no socket serves all memory accesses.
+        """
+        return self._cpp_exec_conf.getHostNUMAInterleave()
+
+    @numa_interleave.setter
+    def numa_interleave(self, value):
+        self._cpp_exec_conf.setHostNUMAInterleave(bool(value))
+
 
 def auto_select(communicator=None,
                 msg_file=None,
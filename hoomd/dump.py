@@ -302,7 +302,8 @@ class getar(hoomd.analyze._analyzer):
 
         return result;
 
-    def __init__(self, filename, mode='w', static=[], dynamic={}, _register=True):
+    def __init__(self, filename, mode='w', static=[], dynamic={}, _register=True,
+                 async_queue_depth=0):
         """Initialize a getar dumper. Creates or appends an archive at the given file
         location according to the mode and prepares to dump the given
         sets of properties.
@@ -313,6 +314,8 @@ class getar(hoomd.analyze._analyzer):
             static (list): List of static properties to dump immediately
             dynamic (dict): Dictionary of {prop: period} periodic dumps
             _register (bool): If True, register as a hoomd analyzer (internal)
+            async_queue_depth (int): Maximum number of frames waiting to be
+                written by a background thread, 0 to write synchronously
 
         Note that zip32-format archives can not be appended to at the
         moment; for details and solutions, see the libgetar
@@ -327,6 +330,12 @@ class getar(hoomd.analyze._analyzer):
         * 'a': Write, and append if file exists
         * '1': One-shot mode: keep only one frame of data. For details on one-shot mode, see the "One-shot mode" section of :py:class:`getar`.
 
+        When *async_queue_depth* is greater than 0, each frame is copied out
+        of the system and compressed and written into the archive by a
+        background thread while the simulation continues. The run blocks
+        only when *async_queue_depth* frames are already waiting, and all
+        queued frames are written by the end of every run.
+
         Property specifications can be either a property name (as a string) or
         :py:class:`DumpProp` objects if you desire greater control over how the
         property will be dumped.
@@ -371,7 +380,8 @@ class getar(hoomd.analyze._analyzer):
 
         self.cpp_analyzer = _hoomd.GetarDumpWriter(hoomd.context.current.system_definition,
                                                 filename, dumpMode,
-                                                hoomd.context.current.system.getCurrentTimeStep());
+                                                hoomd.context.current.system.getCurrentTimeStep(),
+                                                int(async_queue_depth));
 
         for val in set(self._static):
             prop = self._getStatic(val);
@@ -435,7 +445,8 @@ class getar(hoomd.analyze._analyzer):
         self.cpp_analyzer.writeStr(name, json.dumps(contents), timestep)
 
     @classmethod
-    def simple(cls, filename, period, mode='w', static=[], dynamic=[], high_precision=False):
+    def simple(cls, filename, period, mode='w', static=[], dynamic=[], high_precision=False,
+               async_queue_depth=0):
         """Create a :py:class:`getar` dump object with a simpler interface.
 
         Static properties will be dumped once immediately, and dynamic
@@ -449,6 +460,7 @@ class getar(hoomd.analyze._analyzer):
             static (list): List of static properties to dump immediately
             dynamic (list): List of properties to dump every `period` steps
             high_precision (bool): If True, dump precision properties
+            async_queue_depth (int): Maximum number of frames waiting to be written in the background
 
         Example::
 
@@ -461,7 +473,8 @@ class getar(hoomd.analyze._analyzer):
 
         """
         dynamicDict = {cls.DumpProp(name, highPrecision=high_precision): period for name in dynamic};
-        return cls(filename=filename, mode=mode, static=static, dynamic=dynamicDict);
+        return cls(filename=filename, mode=mode, static=static, dynamic=dynamicDict,
+                   async_queue_depth=async_queue_depth);
 
     @classmethod
     def immediate(cls, filename, static, dynamic):
@@ -497,6 +497,39 @@ int gsd_write_chunk(struct gsd_handle* handle,
                     uint8_t flags,
                     const void* data);
 
+/** Reserve space for a data chunk in the current frame
+
+    @param handle Handle to an open GSD file.
+    @param name Name of the data chunk.
+    @param type type ID that identifies the type of data in the chunk.
+    @param N Number of rows in the data.
+    @param M Number of columns in the data.
+    @param flags set to 0, non-zero values reserved for future use.
+    @param location Set to the byte offset of the reserved space in the file.
+
+    @pre *handle* was opened by gsd_open().
+    @pre *name* is a unique name for data chunks in the given frame.
+
+    @post `N * M * gsd_sizeof_type(type)` bytes at the end of the file are reserved for the chunk and
+    its location is added to the in-memory index. The caller must write the data to *location*
+    (for example, with parallel I/O from several processes) before calling gsd_end_frame().
+
+    @return
+      - GSD_SUCCESS (0) on success. Negative value on failure:
+      - GSD_ERROR_INVALID_ARGUMENT: *handle* is NULL, *location* is NULL, *M* == 0, *type* is
+        invalid, or *flags* != 0.
+      - GSD_ERROR_FILE_MUST_BE_WRITABLE: The file was opened read-only.
+      - GSD_ERROR_NAMELIST_FULL: The file cannot store any additional unique chunk names.
+      - GSD_ERROR_MEMORY_ALLOCATION_FAILED: failed to allocate memory.
+*/
+int gsd_reserve_chunk(struct gsd_handle* handle,
+                      const char* name,
+                      enum gsd_type type,
+                      uint64_t N,
+                      uint32_t M,
+                      uint8_t flags,
+                      int64_t* location);
+
 /** Find a chunk in the GSD file
 
     @param handle Handle to an open GSD file
@@ -151,10 +151,17 @@ class AnalyzerSDF : public Analyzer
         void writeOutput(unsigned int timestep);
 
         //! Zero the histogram counts
-        void zeroHistogram();
+        virtual void zeroHistogram();
 
         //! Add to histogram counts
-        void countHistogram(unsigned int timestep);
+        virtual void countHistogram(unsigned int timestep);
+
+        //! Copy the histogram counts to m_hist before writing them
+        /*! Derived classes that accumulate the histogram elsewhere (e.g. on the GPU) override this method.
+        */
+        virtual void syncHistogram()
+            {
+            }
 
         //! Determine the s bin of a given particle pair
         size_t computeBin(const vec3<Scalar>& r_ij,
@@ -278,6 +285,7 @@ void AnalyzerSDF<Shape>::openOutputFile()
 template < class Shape >
 void AnalyzerSDF<Shape>::writeOutput(unsigned int timestep)
     {
+    syncHistogram();
     std::vector<unsigned int> hist_total(m_hist);
 
     // in MPI, we need to total up all of the histogram bins from all nodes to the root node
@@ -0,0 +1,351 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _ANALYZER_SDF_GPU_CUH_
+#define _ANALYZER_SDF_GPU_CUH_
+
+#include "hip/hip_runtime.h"
+#include "HPMCPrecisionSetup.h"
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/BoxDim.h"
+#include "hoomd/Index1D.h"
+
+#ifdef __HIPCC__
+#include "ComputeFreeVolumeGPU.cuh"
+#endif
+
+/*! \file AnalyzerSDFGPU.cuh
+    \brief Declaration of CUDA kernels drivers for AnalyzerSDFGPU
+*/
+
+namespace hpmc
+{
+
+namespace detail
+{
+
+//! Wraps arguments to gpu_hpmc_sdf
+/*! \ingroup hpmc_data_structs */
+struct hpmc_sdf_args_t
+    {
+    //! Construct a hpmc_sdf_args_t
+    hpmc_sdf_args_t(const Scalar4 *_d_postype,
+                    const Scalar4 *_d_orientation,
+                    const Index3D& _ci,
+                    const unsigned int *_d_excell_idx,
+                    const unsigned int *_d_excell_size,
+                    const Index2D& _excli,
+                    const uint3& _cell_dim,
+                    const unsigned int _N,
+                    const unsigned int _num_types,
+                    const BoxDim& _box,
+                    const Scalar3 _ghost_width,
+                    const Scalar _extra_width,
+                    const Scalar _dl,
+                    const unsigned int _n_bins,
+                    unsigned int *_d_hist,
+                    const unsigned int _block_size,
+                    const unsigned int _group_size,
+                    const hipDeviceProp_t& _devprop)
+                : d_postype(_d_postype),
+                  d_orientation(_d_orientation),
+                  ci(_ci),
+                  d_excell_idx(_d_excell_idx),
+                  d_excell_size(_d_excell_size),
+                  excli(_excli),
+                  cell_dim(_cell_dim),
+                  N(_N),
+                  num_types(_num_types),
+                  box(_box),
+                  ghost_width(_ghost_width),
+                  extra_width(_extra_width),
+                  dl(_dl),
+                  n_bins(_n_bins),
+                  d_hist(_d_hist),
+                  block_size(_block_size),
+                  group_size(_group_size),
+                  devprop(_devprop)
+        {
+        };
+
+    const Scalar4 *d_postype;         //!< postype array
+    const Scalar4 *d_orientation;     //!< orientation array
+    const Index3D& ci;                //!< Cell indexer
+    const unsigned int *d_excell_idx; //!< Expanded cell neighbors
+    const unsigned int *d_excell_size; //!< Size of expanded cell list per cell
+    const Index2D excli;              //!< Expanded cell indexer
+    const uint3& cell_dim;            //!< Cell dimensions
+    const unsigned int N;             //!< Number of local particles
+    const unsigned int num_types;     //!< Number of particle types
+    const BoxDim& box;                //!< Current simulation box
+    const Scalar3 ghost_width;        //!< Width of ghost layer
+    const Scalar extra_width;         //!< Extra search radius so that scaled particles may touch
+    const Scalar dl;                  //!< Histogram bin width
+    const unsigned int n_bins;        //!< Number of histogram bins
+    unsigned int *d_hist;             //!< Histogram counts (accumulated)
+    unsigned int block_size;          //!< Block size to execute
+    unsigned int group_size;          //!< Number of threads per particle
+    const hipDeviceProp_t& devprop;   //!< CUDA device properties
+    };
+
+template< class Shape >
+hipError_t gpu_hpmc_sdf(const hpmc_sdf_args_t &args, const typename Shape::param_type *d_params);
+
+#ifdef __HIPCC__
+
+//! Test overlap of two shapes when their separation is scaled by 1-lambda
+template< class Shape >
+__device__ inline bool sdf_scaled_overlap(const vec3<Scalar>& r_ij,
+                                          const Shape& shape_i,
+                                          const Shape& shape_j,
+                                          Scalar lambda)
+    {
+    unsigned int err_count = 0;
+    vec3<Scalar> r_ij_scaled = r_ij * (Scalar(1.0) - lambda);
+    return check_circumsphere_overlap(r_ij_scaled, shape_i, shape_j)
+        && test_overlap(r_ij_scaled, shape_i, shape_j, err_count);
+    }
+
+//! Determine the s bin of a particle pair
+/*! \returns The bin index, or n_bins when the pair overlaps at lambda=0 or does not overlap at the last bin
+
+    Same binary search as AnalyzerSDF::computeBin().
+*/
+template< class Shape >
+__device__ inline unsigned int sdf_compute_bin(const vec3<Scalar>& r_ij,
+                                               const Shape& shape_i,
+                                               const Shape& shape_j,
+                                               unsigned int n_bins,
+                                               Scalar dl)
+    {
+    unsigned int L = 0;
+    unsigned int R = n_bins;
+
+    if (sdf_scaled_overlap(r_ij, shape_i, shape_j, Scalar(L)*dl))
+        return n_bins;
+
+    if (!sdf_scaled_overlap(r_ij, shape_i, shape_j, Scalar(R)*dl))
+        return n_bins;
+
+    do
+        {
+        unsigned int m = (L+R)/2;
+
+        if (sdf_scaled_overlap(r_ij, shape_i, shape_j, Scalar(m)*dl))
+            R = m;
+        else
+            L = m;
+        } while ((R-L) > 1);
+
+    return L;
+    }
+
+//! Kernel to accumulate the scale distribution function histogram
+/*! \param d_postype Particle positions and types by index
+    \param d_orientation Particle orientation
+    \param ci Cell indexer
+    \param d_excell_idx Expanded cell neighbors
+    \param d_excell_size Size of expanded cell list per cell
+    \param excli Expanded cell indexer
+    \param cell_dim Dimensions of the cell list
+    \param N number of local particles
+    \param num_types Number of particle types
+    \param box Simulation box
+    \param ghost_width Width of ghost layer
+    \param extra_width Extra search radius so that scaled particles may touch
+    \param dl Histogram bin width
+    \param n_bins Number of histogram bins
+    \param d_hist Histogram counts (accumulated)
+    \param d_params Per-type shape parameters
+    \param max_extra_bytes Maximum number of bytes of shared memory available to the shape parameters
+
+    Each group of threads (threadIdx.z) processes one particle i, and the threads in the group (threadIdx.y) split
+    the neighbors of i. The group finds the minimum bin in shared memory and adds one count to it in d_hist.
+*/
+template< class Shape >
+__global__ void gpu_hpmc_sdf_kernel(const Scalar4 *d_postype,
+                                    const Scalar4 *d_orientation,
+                                    const Index3D ci,
+                                    const unsigned int *d_excell_idx,
+                                    const unsigned int *d_excell_size,
+                                    const Index2D excli,
+                                    const uint3 cell_dim,
+                                    const unsigned int N,
+                                    const unsigned int num_types,
+                                    const BoxDim box,
+                                    const Scalar3 ghost_width,
+                                    const Scalar extra_width,
+                                    const Scalar dl,
+                                    const unsigned int n_bins,
+                                    unsigned int *d_hist,
+                                    const typename Shape::param_type *d_params,
+                                    unsigned int max_extra_bytes)
+    {
+    unsigned int group = threadIdx.z;
+    unsigned int offset = threadIdx.y;
+    unsigned int group_size = blockDim.y;
+    bool master = (offset == 0);
+    unsigned int n_groups = blockDim.z;
+
+    unsigned int i = blockIdx.x * n_groups + group;
+
+    // load the per type parameters into shared memory
+    HIP_DYNAMIC_SHARED( char, s_data)
+    typename Shape::param_type *s_params = (typename Shape::param_type *)(&s_data[0]);
+    unsigned int *s_min_bin = (unsigned int *)(s_params + num_types);
+
+    // copy over parameters one int per thread for fast loads
+        {
+        unsigned int tidx = threadIdx.x+blockDim.x*threadIdx.y + blockDim.x*blockDim.y*threadIdx.z;
+        unsigned int block_size = blockDim.x*blockDim.y*blockDim.z;
+        unsigned int param_size = num_types*sizeof(typename Shape::param_type) / sizeof(int);
+
+        for (unsigned int cur_offset = 0; cur_offset < param_size; cur_offset += block_size)
+            {
+            if (cur_offset + tidx < param_size)
+                {
+                ((int *)s_params)[cur_offset + tidx] = ((int *)d_params)[cur_offset + tidx];
+                }
+            }
+        }
+
+    __syncthreads();
+
+    // initialize extra shared mem
+    char *s_extra = (char *)(s_min_bin + n_groups);
+
+    unsigned int available_bytes = max_extra_bytes;
+    for (unsigned int cur_type = 0; cur_type < num_types; ++cur_type)
+        s_params[cur_type].load_shared(s_extra, available_bytes);
+
+    if (master)
+        s_min_bin[group] = n_bins;
+
+    __syncthreads();
+
+    if (i < N)
+        {
+        Scalar4 postype_i = d_postype[i];
+        Shape shape_i(quat<Scalar>(), s_params[__scalar_as_int(postype_i.w)]);
+        if (shape_i.hasOrientation())
+            shape_i.orientation = quat<Scalar>(d_orientation[i]);
+        vec3<Scalar> pos_i(postype_i);
+
+        unsigned int my_cell = compute_cell_idx(vec_to_scalar3(pos_i), box, ghost_width, cell_dim, ci);
+        unsigned int excell_size = d_excell_size[my_cell];
+
+        for (unsigned int k = offset; k < excell_size; k += group_size)
+            {
+            unsigned int j = __ldg(&d_excell_idx[excli(k, my_cell)]);
+            if (j == i)
+                continue;
+
+            Scalar4 postype_j = __ldg(d_postype + j);
+            Shape shape_j(quat<Scalar>(), s_params[__scalar_as_int(postype_j.w)]);
+            if (shape_j.hasOrientation())
+                shape_j.orientation = quat<Scalar>(__ldg(d_orientation + j));
+
+            // put particle j into the coordinate system of particle i
+            vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i;
+            r_ij = vec3<Scalar>(box.minImage(vec_to_scalar3(r_ij)));
+
+            // the same search radius as the AABB query in AnalyzerSDF::countHistogram()
+            OverlapReal R = (shape_i.getCircumsphereDiameter() + shape_j.getCircumsphereDiameter())/OverlapReal(2.0)
+                + OverlapReal(extra_width);
+            if (OverlapReal(dot(r_ij,r_ij)) <= R*R)
+                {
+                unsigned int bin = sdf_compute_bin(r_ij, shape_i, shape_j, n_bins, dl);
+                if (bin < n_bins)
+                    atomicMin(&s_min_bin[group], bin);
+                }
+            }
+        }
+
+    __syncthreads();
+
+    if (master && i < N && s_min_bin[group] < n_bins)
+        atomicAdd(&d_hist[s_min_bin[group]], 1);
+    }
+
+//! Kernel driver for gpu_hpmc_sdf_kernel()
+/*! \param args Bundled arguments
+    \param d_params Per-type shape parameters
+    \returns Error codes generated by any CUDA calls, or hipSuccess when there is no error
+
+    The histogram in args.d_hist is not reset, successive calls accumulate into it.
+
+    \ingroup hpmc_kernels
+*/
+template< class Shape >
+hipError_t gpu_hpmc_sdf(const hpmc_sdf_args_t& args, const typename Shape::param_type *d_params)
+    {
+    assert(args.d_postype);
+    assert(args.d_orientation);
+    assert(args.d_hist);
+    assert(args.group_size >= 1);
+    assert(args.block_size%args.group_size==0);
+
+    // determine the maximum block size and clamp the input block size down
+    static int max_block_size = -1;
+    static hipFuncAttributes attr;
+    if (max_block_size == -1)
+        {
+        hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(gpu_hpmc_sdf_kernel<Shape>));
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    // setup the grid to run the kernel
+    unsigned int n_groups = min(args.block_size, (unsigned int)max_block_size) / args.group_size;
+
+    dim3 threads(1, args.group_size, n_groups);
+    dim3 grid(args.N / n_groups + 1, 1, 1);
+
+    unsigned int shared_bytes = (unsigned int)(args.num_types * sizeof(typename Shape::param_type)
+        + n_groups*sizeof(unsigned int));
+
+    // required for memory coherency of the managed shape parameters
+    hipDeviceSynchronize();
+
+    unsigned int max_extra_bytes = (unsigned int)(args.devprop.sharedMemPerBlock - attr.sharedSizeBytes - shared_bytes);
+
+    // determine dynamically requested shared memory
+    char *ptr = (char *)nullptr;
+    unsigned int available_bytes = max_extra_bytes;
+    for (unsigned int i = 0; i < args.num_types; ++i)
+        {
+        d_params[i].allocate_shared(ptr, available_bytes);
+        }
+    unsigned int extra_bytes = max_extra_bytes - available_bytes;
+
+    shared_bytes += extra_bytes;
+
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_hpmc_sdf_kernel<Shape>), dim3(grid), dim3(threads), shared_bytes, 0,
+                       args.d_postype,
+                       args.d_orientation,
+                       args.ci,
+                       args.d_excell_idx,
+                       args.d_excell_size,
+                       args.excli,
+                       args.cell_dim,
+                       args.N,
+                       args.num_types,
+                       args.box,
+                       args.ghost_width,
+                       args.extra_width,
+                       args.dl,
+                       args.n_bins,
+                       args.d_hist,
+                       d_params,
+                       max_extra_bytes);
+
+    return hipSuccess;
+    }
+
+#endif // __HIPCC__
+
+}; // end namespace detail
+
+} // end namespace hpmc
+
+#endif // _ANALYZER_SDF_GPU_CUH_
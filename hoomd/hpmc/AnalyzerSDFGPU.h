@@ -0,0 +1,324 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _ANALYZER_SDF_GPU_H_
+#define _ANALYZER_SDF_GPU_H_
+
+#ifdef ENABLE_HIP
+
+#include "hoomd/CellList.h"
+#include "hoomd/Autotuner.h"
+
+#include "AnalyzerSDF.h"
+#include "AnalyzerSDFGPU.cuh"
+#include "IntegratorHPMCMonoGPU.cuh"
+
+/*! \file AnalyzerSDFGPU.h
+    \brief Declaration of AnalyzerSDFGPU
+    \note This header cannot be compiled by nvcc
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hpmc
+{
+
+//! SDF analysis on the GPU
+/*! AnalyzerSDFGPU computes the same histogram as AnalyzerSDF without copying particle data to the host. It finds
+    neighbors with a cell list and the expanded cell kernel of IntegratorHPMCMonoGPU, in the same way as
+    ComputeFreeVolumeGPU, and evaluates test_overlap() on the device.
+
+    The histogram is accumulated in device memory over all *navg* samples. It is copied to the host only in
+    writeOutput(), so the samples in between do not synchronize with the host.
+
+    \ingroup hpmc_analyzers
+*/
+template < class Shape >
+class AnalyzerSDFGPU : public AnalyzerSDF<Shape>
+    {
+    public:
+        //! Constructor
+        AnalyzerSDFGPU(std::shared_ptr<SystemDefinition> sysdef,
+                       std::shared_ptr< IntegratorHPMCMono<Shape> > mc,
+                       std::shared_ptr<CellList> cl,
+                       double lmax,
+                       double dl,
+                       unsigned int navg,
+                       const std::string& fname,
+                       bool overwrite);
+
+        //! Destructor
+        virtual ~AnalyzerSDFGPU()
+            {
+            }
+
+        //! Set autotuner parameters
+        /*! \param enable Enable/disable autotuning
+            \param period period (approximate) in time steps when returning occurs
+        */
+        virtual void setAutotunerParams(bool enable, unsigned int period)
+            {
+            m_tuner_sdf->setPeriod(period);
+            m_tuner_sdf->setEnabled(enable);
+
+            m_tuner_excell_block_size->setPeriod(period);
+            m_tuner_excell_block_size->setEnabled(enable);
+            }
+
+    protected:
+        std::shared_ptr<CellList> m_cl;       //!< Cell list
+        uint3 m_last_dim;                     //!< Dimensions of the cell list on the last call to update
+        unsigned int m_last_nmax;             //!< Last cell list NMax value allocated in excell
+
+        GPUArray<unsigned int> m_excell_idx;  //!< Particle indices in expanded cells
+        GPUArray<unsigned int> m_excell_size; //!< Number of particles in each expanded cell
+        Index2D m_excell_list_indexer;        //!< Indexer to access elements of the excell_idx list
+
+        GPUArray<unsigned int> m_hist_device; //!< Histogram counts accumulated on the device
+
+        std::unique_ptr<Autotuner> m_tuner_sdf;                //!< Autotuner for the histogram kernel
+        std::unique_ptr<Autotuner> m_tuner_excell_block_size;  //!< Autotuner for excell block_size
+
+        //! Zero the histogram counts
+        virtual void zeroHistogram();
+
+        //! Add to histogram counts
+        virtual void countHistogram(unsigned int timestep);
+
+        //! Copy the device histogram to m_hist
+        virtual void syncHistogram();
+
+        void initializeExcellMem();
+    };
+
+/*! \param sysdef System definition
+    \param mc The MC integrator
+    \param cl Cell list
+    \param lmax Right hand side of the last histogram bin
+    \param dl Bin size
+    \param navg Number of samples to average before writing to the file
+    \param fname File name to write to
+    \param overwrite Set to true to overwrite instead of append to the file
+*/
+template < class Shape >
+AnalyzerSDFGPU<Shape>::AnalyzerSDFGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                      std::shared_ptr< IntegratorHPMCMono<Shape> > mc,
+                                      std::shared_ptr<CellList> cl,
+                                      double lmax,
+                                      double dl,
+                                      unsigned int navg,
+                                      const std::string& fname,
+                                      bool overwrite)
+    : AnalyzerSDF<Shape>(sysdef, mc, lmax, dl, navg, fname, overwrite), m_cl(cl)
+    {
+    // the cell list only needs positions and types, orientations come from the particle data
+    m_cl->setRadius(1);
+    m_cl->setComputeTDB(false);
+    m_cl->setFlagType();
+    m_cl->setComputeIdx(true);
+
+    // encoded as block_size*100 + group_size
+    std::vector<unsigned int> valid_params;
+    unsigned int warp_size = this->m_exec_conf->dev_prop.warpSize;
+    for (unsigned int block_size = warp_size; block_size <= (unsigned int) this->m_exec_conf->dev_prop.maxThreadsPerBlock;
+        block_size += warp_size)
+        {
+        for (auto s : Autotuner::getTppListPow2(warp_size))
+            {
+            // blockDim.z is limited to 64
+            if ((block_size % s) == 0 && block_size/s <= 64)
+                valid_params.push_back(block_size*100 + s);
+            }
+        }
+    m_tuner_sdf.reset(new Autotuner(valid_params, 5, 1000000, "hpmc_sdf", this->m_exec_conf));
+
+    GPUArray<unsigned int> excell_size(0, this->m_exec_conf);
+    m_excell_size.swap(excell_size);
+
+    GPUArray<unsigned int> excell_idx(0, this->m_exec_conf);
+    m_excell_idx.swap(excell_idx);
+
+    GPUArray<unsigned int> hist_device((unsigned int)this->m_hist.size(), this->m_exec_conf);
+    m_hist_device.swap(hist_device);
+    zeroHistogram();
+
+    // set last dim to a bogus value so that it will re-init on the first call
+    m_last_dim = make_uint3(0xffffffff, 0xffffffff, 0xffffffff);
+    m_last_nmax = 0xffffffff;
+
+    m_tuner_excell_block_size.reset(new Autotuner(warp_size, this->m_exec_conf->dev_prop.maxThreadsPerBlock, warp_size, 5,
+        1000000, "hpmc_sdf_excell_block_size", this->m_exec_conf));
+    }
+
+template < class Shape >
+void AnalyzerSDFGPU<Shape>::zeroHistogram()
+    {
+    ArrayHandle<unsigned int> d_hist(m_hist_device, access_location::device, access_mode::overwrite);
+    hipMemsetAsync(d_hist.data, 0, sizeof(unsigned int)*m_hist_device.getNumElements());
+    }
+
+template < class Shape >
+void AnalyzerSDFGPU<Shape>::syncHistogram()
+    {
+    ArrayHandle<unsigned int> h_hist(m_hist_device, access_location::host, access_mode::read);
+    std::copy(h_hist.data, h_hist.data + m_hist_device.getNumElements(), this->m_hist.begin());
+    }
+
+/*! \param timestep current timestep
+
+    Accumulate the histogram of the current configuration into m_hist_device.
+*/
+template < class Shape >
+void AnalyzerSDFGPU<Shape>::countHistogram(unsigned int timestep)
+    {
+    Scalar max_diam = this->m_mc->getMaxCoreDiameter();
+    Scalar extra_width = this->m_lmax / (1 - this->m_lmax) * max_diam;
+
+    // pairs are considered up to the circumsphere contact distance plus extra_width
+    Scalar nominal_width = max_diam + extra_width;
+    if (m_cl->getNominalWidth() != nominal_width)
+        m_cl->setNominalWidth(nominal_width);
+
+    const BoxDim &box = this->m_pdata->getBox();
+    Scalar3 npd = box.getNearestPlaneDistance();
+
+    if ((box.getPeriodic().x && npd.x <= nominal_width*2) ||
+        (box.getPeriodic().y && npd.y <= nominal_width*2) ||
+        (this->m_sysdef->getNDimensions() == 3 && box.getPeriodic().z && npd.z <= nominal_width*2))
+        {
+        this->m_exec_conf->msg->error() << "Simulation box too small for analyze.sdf() on GPU - increase it so the "
+                                        << "minimum image convention works" << std::endl;
+        throw std::runtime_error("Error computing SDF");
+        }
+
+    // compute cell list
+    m_cl->compute(timestep);
+
+    // if the cell list is a different size than last time, reinitialize expanded cell list
+    uint3 cur_dim = m_cl->getDim();
+    if (m_last_dim.x != cur_dim.x || m_last_dim.y != cur_dim.y || m_last_dim.z != cur_dim.z ||
+        m_last_nmax != m_cl->getNmax())
+        {
+        initializeExcellMem();
+        m_last_dim = cur_dim;
+        m_last_nmax = m_cl->getNmax();
+        }
+
+    // access the cell list data
+    ArrayHandle<unsigned int> d_cell_size(m_cl->getCellSizeArray(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_cell_idx(m_cl->getIndexArray(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_cell_adj(m_cl->getCellAdjArray(), access_location::device, access_mode::read);
+
+    // per-device cell list data
+    const ArrayHandle<unsigned int>& d_cell_size_per_device = m_cl->getPerDevice() ?
+        ArrayHandle<unsigned int>(m_cl->getCellSizeArrayPerDevice(),access_location::device, access_mode::read) :
+        ArrayHandle<unsigned int>(GlobalArray<unsigned int>(), access_location::device, access_mode::read);
+    const ArrayHandle<unsigned int>& d_cell_idx_per_device = m_cl->getPerDevice() ?
+        ArrayHandle<unsigned int>(m_cl->getIndexArrayPerDevice(), access_location::device, access_mode::read) :
+        ArrayHandle<unsigned int>(GlobalArray<unsigned int>(), access_location::device, access_mode::read);
+
+    ArrayHandle< unsigned int > d_excell_idx(m_excell_idx, access_location::device, access_mode::readwrite);
+    ArrayHandle< unsigned int > d_excell_size(m_excell_size, access_location::device, access_mode::readwrite);
+
+    // update the expanded cells
+    m_tuner_excell_block_size->begin();
+    gpu::hpmc_excell(d_excell_idx.data,
+                     d_excell_size.data,
+                     m_excell_list_indexer,
+                     m_cl->getPerDevice() ? d_cell_idx_per_device.data : d_cell_idx.data,
+                     m_cl->getPerDevice() ? d_cell_size_per_device.data : d_cell_size.data,
+                     d_cell_adj.data,
+                     m_cl->getCellIndexer(),
+                     m_cl->getCellListIndexer(),
+                     m_cl->getCellAdjIndexer(),
+                     m_cl->getPerDevice() ? this->m_exec_conf->getNumActiveGPUs() : 1,
+                     m_tuner_excell_block_size->getParam());
+    if (this->m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+    m_tuner_excell_block_size->end();
+
+    // access the particle data
+    ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_orientation(this->m_pdata->getOrientationArray(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_hist(m_hist_device, access_location::device, access_mode::readwrite);
+
+    const std::vector<typename Shape::param_type, managed_allocator<typename Shape::param_type> > & params
+        = this->m_mc->getParams();
+
+    m_tuner_sdf->begin();
+    unsigned int param = m_tuner_sdf->getParam();
+    unsigned int block_size = param / 100;
+    unsigned int group_size = param % 100;
+
+    detail::hpmc_sdf_args_t sdf_args(d_postype.data,
+                                     d_orientation.data,
+                                     m_cl->getCellIndexer(),
+                                     d_excell_idx.data,
+                                     d_excell_size.data,
+                                     m_excell_list_indexer,
+                                     m_cl->getDim(),
+                                     this->m_pdata->getN(),
+                                     this->m_pdata->getNTypes(),
+                                     box,
+                                     m_cl->getGhostWidth(),
+                                     extra_width,
+                                     this->m_dl,
+                                     (unsigned int)this->m_hist.size(),
+                                     d_hist.data,
+                                     block_size,
+                                     group_size,
+                                     this->m_exec_conf->dev_prop);
+
+    detail::gpu_hpmc_sdf<Shape>(sdf_args, params.data());
+
+    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    m_tuner_sdf->end();
+    }
+
+template< class Shape >
+void AnalyzerSDFGPU< Shape >::initializeExcellMem()
+    {
+    this->m_exec_conf->msg->notice(4) << "hpmc resizing expanded cells" << std::endl;
+
+    // get the current cell dimensions
+    unsigned int num_cells = m_cl->getCellIndexer().getNumElements();
+    unsigned int num_adj = m_cl->getCellAdjIndexer().getW();
+    unsigned int num_max = m_cl->getNmax();
+
+    // make the excell dimensions the same, but with room for Nmax*Nadj in each cell
+    m_excell_list_indexer = Index2D(num_max * num_adj, num_cells);
+
+    // reallocate memory
+    m_excell_idx.resize(m_excell_list_indexer.getNumElements());
+    m_excell_size.resize(num_cells);
+    }
+
+//! Export the AnalyzerSDFGPU class to python
+/*! \param name Name of the class in the exported python module
+    \tparam Shape An instantiation of AnalyzerSDFGPU<Shape> will be exported
+*/
+template < class Shape > void export_AnalyzerSDFGPU(pybind11::module& m, const std::string& name)
+    {
+    pybind11::class_< AnalyzerSDFGPU<Shape>, AnalyzerSDF<Shape>, std::shared_ptr< AnalyzerSDFGPU<Shape> > >(m,
+        name.c_str())
+          .def(pybind11::init< std::shared_ptr<SystemDefinition>,
+                               std::shared_ptr< IntegratorHPMCMono<Shape> >,
+                               std::shared_ptr<CellList>,
+                               double,
+                               double,
+                               unsigned int,
+                               const std::string&,
+                               bool>())
+          ;
+    }
+
+} // end namespace hpmc
+
+#endif // ENABLE_HIP
+
+#endif // _ANALYZER_SDF_GPU_H_
@@ -391,7 +391,7 @@ hipError_t gpu_hpmc_free_volume(const hpmc_free_volume_args_t& args, const typen
     assert(args.d_orientation);
     assert(args.d_cell_size);
     assert(args.group_size >= 1);
-    assert(args.group_size <= 32);  // note, really should be warp size of the device
+    assert(args.group_size <= (unsigned int)args.devprop.warpSize);
     assert(args.block_size%(args.stride*args.group_size)==0);
 
     // reset counters
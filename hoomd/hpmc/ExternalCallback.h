@@ -127,6 +127,7 @@ class __attribute__ ((visibility ("hidden"))) ExternalCallback : public External
             double e = 0.0;
             if (!callback.is(pybind11::none()))
                 {
+                pybind11::gil_scoped_acquire acquire;
                 pybind11::object rv = callback(snap);
                 try
                     {
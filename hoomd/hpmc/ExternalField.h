@@ -19,8 +19,59 @@
 #include <pybind11/pybind11.h>
 #endif
 
+#ifdef ENABLE_HIP
+#include <hip/hip_runtime.h>
+#include "hoomd/GPUPartition.cuh"
+#endif
+
 namespace hpmc
 {
+
+namespace detail
+{
+
+#ifdef ENABLE_HIP
+//! Wraps arguments to the kernels that evaluate external fields for trial moves
+struct hpmc_external_args_t
+    {
+    //! Construct a hpmc_external_args_t
+    hpmc_external_args_t(const Scalar4 *_d_postype,
+                const Scalar4 *_d_orientation,
+                const Scalar4 *_d_trial_postype,
+                const Scalar4 *_d_trial_orientation,
+                const unsigned int *_d_trial_move_type,
+                const Scalar *_d_charge,
+                const Scalar *_d_diameter,
+                const BoxDim& _box,
+                float *_d_energy_diff,
+                const GPUPartition& _gpu_partition)
+                : d_postype(_d_postype),
+                  d_orientation(_d_orientation),
+                  d_trial_postype(_d_trial_postype),
+                  d_trial_orientation(_d_trial_orientation),
+                  d_trial_move_type(_d_trial_move_type),
+                  d_charge(_d_charge),
+                  d_diameter(_d_diameter),
+                  box(_box),
+                  d_energy_diff(_d_energy_diff),
+                  gpu_partition(_gpu_partition)
+        { }
+
+    const Scalar4 *d_postype;               //!< postype array
+    const Scalar4 *d_orientation;           //!< orientation array
+    const Scalar4 *d_trial_postype;         //!< New positions (and type) of particles
+    const Scalar4 *d_trial_orientation;     //!< New orientations of particles
+    const unsigned int *d_trial_move_type;  //!< Move type of each particle, 0 for inactive particles
+    const Scalar *d_charge;                 //!< Particle charges
+    const Scalar *d_diameter;               //!< Particle diameters
+    const BoxDim& box;                      //!< Global simulation box
+    float *d_energy_diff;                   //!< Output: energy difference of the trial move of each particle
+    const GPUPartition& gpu_partition;      //!< split particles among GPUs
+    };
+#endif
+
+} // end namespace detail
+
 class ExternalField : public Compute
     {
     public:
@@ -69,6 +120,26 @@ class ExternalFieldMono : public ExternalField
         virtual double energydiff(const unsigned int& index, const vec3<Scalar>& position_old, const Shape& shape_old, const vec3<Scalar>& position_new, const Shape& shape_new){return 0;}
 
         virtual void reset(unsigned int timestep) {}
+
+        #ifdef ENABLE_HIP
+        //! Test if computeEnergyDiffGPU() is implemented
+        /*! IntegratorHPMCMonoGPU adds the energy differences computed on the GPU to the acceptance criterion of the
+            trial moves.
+        */
+        virtual bool hasEnergyDiffGPU()
+            {
+            return false;
+            }
+
+        //! Asynchronously compute the energy differences of all trial moves on the GPU
+        /*! \param args Kernel arguments
+            \param hStream stream to execute on
+        */
+        virtual void computeEnergyDiffGPU(const detail::hpmc_external_args_t& args, hipStream_t hStream)
+            {
+            throw std::runtime_error("ExternalFieldMono (base class) does not support computeEnergyDiffGPU");
+            }
+        #endif
     };
 
 
@@ -13,6 +13,7 @@
 #include "hoomd/HOOMDMPI.h"
 
 #include "ExternalField.h"
+#include "LatticeEnergy.h"
 
 #ifndef __HIPCC__
 #include <pybind11/pybind11.h>
@@ -228,11 +229,21 @@ class ExternalFieldLattice : public ExternalFieldMono<Shape>
             Scalar scaleOld = pow((oldVolume/curVolume), Scalar(1.0/3.0));
             Scalar scaleNew = pow((newVolume/curVolume), Scalar(1.0/3.0));
 
+            // access the tags and references once for all particles
+            ArrayHandle<unsigned int> h_tags(m_pdata->getTags(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar3> h_r0(m_latticePositions.getReferenceArray(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar4> h_q0(m_latticeOrientations.getReferenceArray(), access_location::host, access_mode::read);
+            const Scalar3 *r0 = m_latticePositions.isValid() ? h_r0.data : nullptr;
+            const Scalar4 *q0 = m_latticeOrientations.isValid() ? h_q0.data : nullptr;
+
             double dE = 0.0;
             for(unsigned int i = 0; i < m_pdata->getN(); i++)
                 {
-                Scalar old_E = calcE(i, vec3<Scalar>(*(position_old+i)), quat<Scalar>(*(orientation_old+i)), scaleOld);
-                Scalar new_E = calcE(i, vec3<Scalar>(*(position_new+i)), quat<Scalar>(*(orientation_new+i)), scaleNew);
+                unsigned int tag = h_tags.data[i];
+                Scalar old_E = evalE(tag, vec3<Scalar>(position_old[i]), quat<Scalar>(orientation_old[i]), r0, q0,
+                    scaleOld);
+                Scalar new_E = evalE(tag, vec3<Scalar>(position_new[i]), quat<Scalar>(orientation_new[i]), r0, q0,
+                    scaleNew);
                 dE += new_E - old_E;
                 }
 
@@ -256,11 +267,17 @@ class ExternalFieldLattice : public ExternalFieldMono<Shape>
             // access particle data and system box
             ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
             ArrayHandle<Scalar4> h_orient(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_tags(m_pdata->getTags(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar3> h_r0(m_latticePositions.getReferenceArray(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar4> h_q0(m_latticeOrientations.getReferenceArray(), access_location::host, access_mode::read);
+            const Scalar3 *r0 = m_latticePositions.isValid() ? h_r0.data : nullptr;
+            const Scalar4 *q0 = m_latticeOrientations.isValid() ? h_q0.data : nullptr;
+
             for(unsigned int i = 0; i < m_pdata->getN(); i++)
                 {
                 vec3<Scalar> position(h_postype.data[i]);
                 quat<Scalar> orientation(h_orient.data[i]);
-                m_Energy += calcE(i, position, orientation);
+                m_Energy += evalE(h_tags.data[i], position, orientation, r0, q0);
                 }
 
             #ifdef ENABLE_MPI
@@ -270,23 +287,20 @@ class ExternalFieldLattice : public ExternalFieldMono<Shape>
                 }
             #endif
 
-            Scalar energy_per = m_Energy / Scalar(m_pdata->getNGlobal());
-            m_EnergySum_y    = energy_per - m_EnergySum_c;
-            m_EnergySum_t    = m_EnergySum + m_EnergySum_y;
-            m_EnergySum_c    = (m_EnergySum_t-m_EnergySum) - m_EnergySum_y;
-            m_EnergySum      = m_EnergySum_t;
-
-            Scalar energy_sq_per = energy_per*energy_per;
-            m_EnergySqSum_y    = energy_sq_per - m_EnergySqSum_c;
-            m_EnergySqSum_t    = m_EnergySqSum + m_EnergySqSum_y;
-            m_EnergySqSum_c    = (m_EnergySqSum_t-m_EnergySqSum) - m_EnergySqSum_y;
-            m_EnergySqSum      = m_EnergySqSum_t;
-            m_num_samples++;
+            accumulateEnergy();
             }
 
         double energydiff(const unsigned int& index, const vec3<Scalar>& position_old, const Shape& shape_old, const vec3<Scalar>& position_new, const Shape& shape_new)
             {
-            double old_U = calcE(index, position_old, shape_old), new_U = calcE(index, position_new, shape_new);
+            ArrayHandle<unsigned int> h_tags(m_pdata->getTags(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar3> h_r0(m_latticePositions.getReferenceArray(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar4> h_q0(m_latticeOrientations.getReferenceArray(), access_location::host, access_mode::read);
+            const Scalar3 *r0 = m_latticePositions.isValid() ? h_r0.data : nullptr;
+            const Scalar4 *q0 = m_latticeOrientations.isValid() ? h_q0.data : nullptr;
+
+            unsigned int tag = h_tags.data[index];
+            double old_U = evalE(tag, position_old, shape_old.orientation, r0, q0);
+            double new_U = evalE(tag, position_new, shape_new.orientation, r0, q0);
             return new_U - old_U;
             }
 
@@ -492,62 +506,56 @@ class ExternalFieldLattice : public ExternalFieldMono<Shape>
 
 
     protected:
-
-        // These could be a little redundant. think about this more later.
-        Scalar calcE_trans(const unsigned int& index, const vec3<Scalar>& position, const Scalar& scale = 1.0)
+        //! Add the per particle energy m_Energy/N of the current sample to the running averages
+        void accumulateEnergy()
             {
-            ArrayHandle<unsigned int> h_tags(m_pdata->getTags(), access_location::host, access_mode::read);
-            int3 dummy = make_int3(0,0,0);
-            vec3<Scalar> origin(m_pdata->getOrigin());
-            const BoxDim& box = this->m_pdata->getGlobalBox();
-            vec3<Scalar> r0(m_latticePositions.getReference(h_tags.data[index]));
-            r0 *= scale;
-            Scalar3 t = vec_to_scalar3(position - origin);
-            box.wrap(t, dummy);
-            vec3<Scalar> shifted_pos(t);
-            vec3<Scalar> dr = vec3<Scalar>(box.minImage(vec_to_scalar3(r0 - position + origin)));
-            return m_k*dot(dr,dr);
-            }
+            Scalar energy_per = m_Energy / Scalar(m_pdata->getNGlobal());
+            m_EnergySum_y    = energy_per - m_EnergySum_c;
+            m_EnergySum_t    = m_EnergySum + m_EnergySum_y;
+            m_EnergySum_c    = (m_EnergySum_t-m_EnergySum) - m_EnergySum_y;
+            m_EnergySum      = m_EnergySum_t;
 
-        Scalar calcE_rot(const unsigned int& index, const quat<Scalar>& orientation)
-            {
-            assert(m_symmetry.size());
-            ArrayHandle<unsigned int> h_tags(m_pdata->getTags(), access_location::host, access_mode::read);
-            quat<Scalar> q0(m_latticeOrientations.getReference(h_tags.data[index]));
-            Scalar dqmin = 0.0;
-            for(size_t i = 0; i < m_symmetry.size(); i++)
-                {
-                quat<Scalar> equiv_orientation = orientation*m_symmetry[i];
-                quat<Scalar> dq = q0 - equiv_orientation;
-                dqmin = (i == 0) ? norm2(dq) : fmin(dqmin, norm2(dq));
-                }
-            return m_q*dqmin;
+            Scalar energy_sq_per = energy_per*energy_per;
+            m_EnergySqSum_y    = energy_sq_per - m_EnergySqSum_c;
+            m_EnergySqSum_t    = m_EnergySqSum + m_EnergySqSum_y;
+            m_EnergySqSum_c    = (m_EnergySqSum_t-m_EnergySqSum) - m_EnergySqSum_y;
+            m_EnergySqSum      = m_EnergySqSum_t;
+            m_num_samples++;
             }
-        Scalar calcE_rot(const unsigned int& index, const Shape& shape)
-            {
-            if(!shape.hasOrientation())
-                return Scalar(0.0);
 
-            return calcE_rot(index, shape.orientation);
-            }
-        Scalar calcE(const unsigned int& index, const vec3<Scalar>& position, const quat<Scalar>& orientation, const Scalar& scale = 1.0)
+        //! Evaluate the energy of one particle
+        /*! \param tag Tag of the particle
+            \param position Particle position
+            \param orientation Particle orientation
+            \param r0 Reference positions indexed by tag, or nullptr when there are none
+            \param q0 Reference orientations indexed by tag, or nullptr when there are none
+            \param scale Factor to scale the reference positions by
+
+            Callers acquire the tag and reference arrays once and evaluate many particles with them.
+        */
+        Scalar evalE(unsigned int tag,
+                     const vec3<Scalar>& position,
+                     const quat<Scalar>& orientation,
+                     const Scalar3 *r0,
+                     const Scalar4 *q0,
+                     const Scalar& scale = 1.0)
             {
             Scalar energy = 0.0;
-            if(m_latticePositions.isValid())
+            if(r0)
                 {
-                energy += calcE_trans(index, position, scale);
+                vec3<Scalar> origin(m_pdata->getOrigin());
+                energy += detail::lattice_energy_trans(position, vec3<Scalar>(r0[tag])*scale, origin,
+                    m_pdata->getGlobalBox(), m_k);
                 }
-            if(m_latticeOrientations.isValid())
+            if(q0)
                 {
-                energy += calcE_rot(index, orientation);
+                assert(m_symmetry.size());
+                energy += detail::lattice_energy_rot(orientation, quat<Scalar>(q0[tag]), m_symmetry.data(),
+                    (unsigned int)m_symmetry.size(), m_q);
                 }
             return energy;
             }
-        Scalar calcE(const unsigned int& index, const vec3<Scalar>& position, const Shape& shape, const Scalar& scale = 1.0)
-            {
-            return calcE(index, position, shape.orientation, scale);
-            }
-    private:
+
         LatticeReferenceList<Scalar3>   m_latticePositions;         // positions of the lattice.
         Scalar                          m_k;                        // spring constant
 
@@ -558,6 +566,7 @@ class ExternalFieldLattice : public ExternalFieldMono<Shape>
 
         Scalar                          m_Energy;                   // Store the total energy of the last computed timestep
 
+    private:
         // All of these are on a per particle basis
         Scalar                          m_EnergySum;
         Scalar                          m_EnergySum_y;
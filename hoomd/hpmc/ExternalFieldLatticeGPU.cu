@@ -0,0 +1,256 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ExternalFieldLatticeGPU.cuh"
+#include "LatticeEnergy.h"
+
+#include <hipcub/hipcub.hpp>
+
+/*! \file ExternalFieldLatticeGPU.cu
+    \brief Definition of CUDA kernels for ExternalFieldLatticeGPU
+*/
+
+namespace hpmc
+{
+namespace gpu
+{
+namespace kernel
+{
+
+//! Kernel to evaluate the lattice energy of each particle
+/*! \param d_energy Output per particle energy
+    \param d_postype Particle positions and types
+    \param d_orientation Particle orientations
+    \param d_tag Particle tags
+    \param d_r0 Reference positions indexed by tag, or nullptr when there are none
+    \param d_q0 Reference orientations indexed by tag, or nullptr when there are none
+    \param d_symmetry Quaternions in the symmetry group of the shape
+    \param n_symmetry Number of elements in d_symmetry
+    \param N Number of local particles
+    \param box Global simulation box
+    \param origin Origin of the particle data
+    \param k Translational spring constant
+    \param q Rotational spring constant
+
+    lattice_energy executes one thread per particle.
+*/
+__global__ void lattice_energy(Scalar *d_energy,
+                               const Scalar4 *d_postype,
+                               const Scalar4 *d_orientation,
+                               const unsigned int *d_tag,
+                               const Scalar3 *d_r0,
+                               const Scalar4 *d_q0,
+                               const Scalar4 *d_symmetry,
+                               const unsigned int n_symmetry,
+                               const unsigned int N,
+                               const BoxDim box,
+                               const Scalar3 origin,
+                               const Scalar k,
+                               const Scalar q)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    unsigned int tag = d_tag[idx];
+    Scalar energy = Scalar(0.0);
+
+    if (d_r0)
+        {
+        energy += detail::lattice_energy_trans(vec3<Scalar>(d_postype[idx]),
+                                               vec3<Scalar>(d_r0[tag]),
+                                               vec3<Scalar>(origin),
+                                               box,
+                                               k);
+        }
+
+    if (d_q0)
+        {
+        energy += detail::lattice_energy_rot(quat<Scalar>(d_orientation[idx]),
+                                             quat<Scalar>(d_q0[tag]),
+                                             d_symmetry,
+                                             n_symmetry,
+                                             q);
+        }
+
+    d_energy[idx] = energy;
+    }
+
+//! Kernel to compute the displacement of each particle from its lattice site
+/*! \param d_dr Output per particle displacement
+    \param d_postype Particle positions and types
+    \param d_tag Particle tags
+    \param d_r0 Reference positions indexed by tag
+    \param N Number of local particles
+    \param box Global simulation box
+    \param origin Origin of the particle data
+
+    lattice_drift executes one thread per particle.
+*/
+__global__ void lattice_drift(Scalar3 *d_dr,
+                              const Scalar4 *d_postype,
+                              const unsigned int *d_tag,
+                              const Scalar3 *d_r0,
+                              const unsigned int N,
+                              const BoxDim box,
+                              const Scalar3 origin)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    vec3<Scalar> r_i = vec3<Scalar>(d_postype[idx]) - vec3<Scalar>(origin);
+    int3 tmp_image = make_int3(0, 0, 0);
+    box.wrap(r_i, tmp_image);
+    vec3<Scalar> dr = r_i - vec3<Scalar>(d_r0[d_tag[idx]]);
+
+    d_dr[idx] = box.minImage(vec_to_scalar3(dr));
+    }
+
+//! Sum of two Scalar3 for the device reduction
+struct scalar3_sum
+    {
+    __device__ __forceinline__ Scalar3 operator()(const Scalar3& a, const Scalar3& b) const
+        {
+        return make_scalar3(a.x + b.x, a.y + b.y, a.z + b.z);
+        }
+    };
+
+} // end namespace kernel
+
+/*! \param d_sum Output total energy of the local particles (one element in device memory)
+    \param alloc Allocator for the per particle energies and the reduction temporary storage
+
+    See kernel::lattice_energy() for the other parameters. The total stays in device memory, the caller copies it
+    when it needs the value.
+*/
+void compute_lattice_energy(Scalar *d_sum,
+                            const Scalar4 *d_postype,
+                            const Scalar4 *d_orientation,
+                            const unsigned int *d_tag,
+                            const Scalar3 *d_r0,
+                            const Scalar4 *d_q0,
+                            const Scalar4 *d_symmetry,
+                            const unsigned int n_symmetry,
+                            const unsigned int N,
+                            const BoxDim& box,
+                            const Scalar3 origin,
+                            const Scalar k,
+                            const Scalar q,
+                            const unsigned int block_size,
+                            CachedAllocator& alloc)
+    {
+    assert(d_sum);
+
+    if (N == 0)
+        {
+        hipMemsetAsync(d_sum, 0, sizeof(Scalar));
+        return;
+        }
+
+    // determine the maximum block size and clamp the input block size down
+    static int max_block_size = -1;
+    if (max_block_size == -1)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(kernel::lattice_energy));
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, (unsigned int)max_block_size);
+    dim3 threads(run_block_size, 1, 1);
+    dim3 grid(N / run_block_size + 1, 1, 1);
+
+    Scalar *d_energy = alloc.getTemporaryBuffer<Scalar>(N);
+    assert(d_energy);
+
+    hipLaunchKernelGGL(kernel::lattice_energy, dim3(grid), dim3(threads), 0, 0,
+                       d_energy,
+                       d_postype,
+                       d_orientation,
+                       d_tag,
+                       d_r0,
+                       d_q0,
+                       d_symmetry,
+                       n_symmetry,
+                       N,
+                       box,
+                       origin,
+                       k,
+                       q);
+
+    // sum the per particle energies
+    void *d_temp_storage = NULL;
+    size_t temp_storage_bytes = 0;
+    hipcub::DeviceReduce::Sum(d_temp_storage, temp_storage_bytes, d_energy, d_sum, N);
+    d_temp_storage = alloc.getTemporaryBuffer<char>(temp_storage_bytes);
+    hipcub::DeviceReduce::Sum(d_temp_storage, temp_storage_bytes, d_energy, d_sum, N);
+    alloc.deallocate((char *)d_temp_storage);
+
+    alloc.deallocate((char *)d_energy);
+    }
+
+/*! \param d_sum Output total displacement of the local particles (one element in device memory)
+    \param alloc Allocator for the per particle displacements and the reduction temporary storage
+
+    See kernel::lattice_drift() for the other parameters.
+*/
+void compute_lattice_drift(Scalar3 *d_sum,
+                           const Scalar4 *d_postype,
+                           const unsigned int *d_tag,
+                           const Scalar3 *d_r0,
+                           const unsigned int N,
+                           const BoxDim& box,
+                           const Scalar3 origin,
+                           const unsigned int block_size,
+                           CachedAllocator& alloc)
+    {
+    assert(d_sum);
+
+    if (N == 0)
+        {
+        hipMemsetAsync(d_sum, 0, sizeof(Scalar3));
+        return;
+        }
+
+    // determine the maximum block size and clamp the input block size down
+    static int max_block_size = -1;
+    if (max_block_size == -1)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(kernel::lattice_drift));
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, (unsigned int)max_block_size);
+    dim3 threads(run_block_size, 1, 1);
+    dim3 grid(N / run_block_size + 1, 1, 1);
+
+    Scalar3 *d_dr = alloc.getTemporaryBuffer<Scalar3>(N);
+    assert(d_dr);
+
+    hipLaunchKernelGGL(kernel::lattice_drift, dim3(grid), dim3(threads), 0, 0,
+                       d_dr,
+                       d_postype,
+                       d_tag,
+                       d_r0,
+                       N,
+                       box,
+                       origin);
+
+    // sum the per particle displacements
+    void *d_temp_storage = NULL;
+    size_t temp_storage_bytes = 0;
+    Scalar3 zero = make_scalar3(0, 0, 0);
+    hipcub::DeviceReduce::Reduce(d_temp_storage, temp_storage_bytes, d_dr, d_sum, N, kernel::scalar3_sum(), zero);
+    d_temp_storage = alloc.getTemporaryBuffer<char>(temp_storage_bytes);
+    hipcub::DeviceReduce::Reduce(d_temp_storage, temp_storage_bytes, d_dr, d_sum, N, kernel::scalar3_sum(), zero);
+    alloc.deallocate((char *)d_temp_storage);
+
+    alloc.deallocate((char *)d_dr);
+    }
+
+} // end namespace gpu
+} // end namespace hpmc
@@ -0,0 +1,55 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _EXTERNAL_FIELD_LATTICE_GPU_CUH_
+#define _EXTERNAL_FIELD_LATTICE_GPU_CUH_
+
+#include <hip/hip_runtime.h>
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/BoxDim.h"
+#include "hoomd/CachedAllocator.h"
+
+/*! \file ExternalFieldLatticeGPU.cuh
+    \brief Declaration of CUDA kernels drivers for ExternalFieldLatticeGPU
+*/
+
+namespace hpmc
+{
+
+namespace gpu
+{
+
+//! Driver for kernel::lattice_energy()
+void compute_lattice_energy(Scalar *d_sum,
+                            const Scalar4 *d_postype,
+                            const Scalar4 *d_orientation,
+                            const unsigned int *d_tag,
+                            const Scalar3 *d_r0,
+                            const Scalar4 *d_q0,
+                            const Scalar4 *d_symmetry,
+                            const unsigned int n_symmetry,
+                            const unsigned int N,
+                            const BoxDim& box,
+                            const Scalar3 origin,
+                            const Scalar k,
+                            const Scalar q,
+                            const unsigned int block_size,
+                            CachedAllocator& alloc);
+
+//! Driver for kernel::lattice_drift()
+void compute_lattice_drift(Scalar3 *d_sum,
+                           const Scalar4 *d_postype,
+                           const unsigned int *d_tag,
+                           const Scalar3 *d_r0,
+                           const unsigned int N,
+                           const BoxDim& box,
+                           const Scalar3 origin,
+                           const unsigned int block_size,
+                           CachedAllocator& alloc);
+
+} // end namespace gpu
+
+} // end namespace hpmc
+
+#endif // _EXTERNAL_FIELD_LATTICE_GPU_CUH_
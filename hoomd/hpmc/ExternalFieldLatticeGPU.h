@@ -0,0 +1,158 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _EXTERNAL_FIELD_LATTICE_GPU_H_
+#define _EXTERNAL_FIELD_LATTICE_GPU_H_
+
+#ifdef ENABLE_HIP
+
+#include "hoomd/Autotuner.h"
+
+#include "ExternalFieldLattice.h"
+#include "ExternalFieldLatticeGPU.cuh"
+
+/*! \file ExternalFieldLatticeGPU.h
+    \brief Declaration of ExternalFieldLatticeGPU
+    \note This header cannot be compiled by nvcc
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hpmc
+{
+
+//! Lattice field that evaluates the total energy on the GPU
+/*! ExternalFieldLatticeGPU evaluates the energy of all particles in compute() with one kernel and a device
+    reduction. The reference positions and orientations stay in device memory, only the total energy is copied to
+    the host.
+
+    The per trial energydiff() and calculateDeltaE() remain on the CPU, where the integrator and box updaters call
+    them.
+*/
+template< class Shape >
+class ExternalFieldLatticeGPU : public ExternalFieldLattice<Shape>
+    {
+    public:
+        //! Constructor
+        ExternalFieldLatticeGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                pybind11::list r0,
+                                Scalar k,
+                                pybind11::list q0,
+                                Scalar q,
+                                pybind11::list symRotations)
+            : ExternalFieldLattice<Shape>(sysdef, r0, k, q0, q, symRotations)
+            {
+            GPUArray<Scalar4> symmetry((unsigned int)this->m_symmetry.size(), this->m_exec_conf);
+                {
+                ArrayHandle<Scalar4> h_symmetry(symmetry, access_location::host, access_mode::overwrite);
+                for (unsigned int i = 0; i < this->m_symmetry.size(); i++)
+                    {
+                    const quat<Scalar>& qi = this->m_symmetry[i];
+                    h_symmetry.data[i] = make_scalar4(qi.s, qi.v.x, qi.v.y, qi.v.z);
+                    }
+                }
+            m_symmetry_gpu.swap(symmetry);
+
+            GPUArray<Scalar> sum(1, this->m_exec_conf);
+            m_sum.swap(sum);
+
+            unsigned int warp_size = this->m_exec_conf->dev_prop.warpSize;
+            m_tuner.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000,
+                "hpmc_lattice_energy", this->m_exec_conf));
+            }
+
+        //! Set autotuner parameters
+        /*! \param enable Enable/disable autotuning
+            \param period period (approximate) in time steps when returning occurs
+        */
+        virtual void setAutotunerParams(bool enable, unsigned int period)
+            {
+            m_tuner->setPeriod(period);
+            m_tuner->setEnabled(enable);
+            }
+
+        //! Compute the total energy and update the running averages
+        void compute(unsigned int timestep)
+            {
+            if(!this->shouldCompute(timestep))
+                {
+                return;
+                }
+
+                {
+                ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(), access_location::device,
+                    access_mode::read);
+                ArrayHandle<Scalar4> d_orientation(this->m_pdata->getOrientationArray(), access_location::device,
+                    access_mode::read);
+                ArrayHandle<unsigned int> d_tag(this->m_pdata->getTags(), access_location::device, access_mode::read);
+                ArrayHandle<Scalar3> d_r0(this->m_latticePositions.getReferenceArray(), access_location::device,
+                    access_mode::read);
+                ArrayHandle<Scalar4> d_q0(this->m_latticeOrientations.getReferenceArray(), access_location::device,
+                    access_mode::read);
+                ArrayHandle<Scalar4> d_symmetry(m_symmetry_gpu, access_location::device, access_mode::read);
+                ArrayHandle<Scalar> d_sum(m_sum, access_location::device, access_mode::overwrite);
+
+                m_tuner->begin();
+                gpu::compute_lattice_energy(d_sum.data,
+                                            d_postype.data,
+                                            d_orientation.data,
+                                            d_tag.data,
+                                            this->m_latticePositions.isValid() ? d_r0.data : nullptr,
+                                            this->m_latticeOrientations.isValid() ? d_q0.data : nullptr,
+                                            d_symmetry.data,
+                                            (unsigned int)this->m_symmetry.size(),
+                                            this->m_pdata->getN(),
+                                            this->m_pdata->getGlobalBox(),
+                                            this->m_pdata->getOrigin(),
+                                            this->m_k,
+                                            this->m_q,
+                                            m_tuner->getParam(),
+                                            this->m_exec_conf->getCachedAllocator());
+                if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                    CHECK_CUDA_ERROR();
+                m_tuner->end();
+                }
+
+            ArrayHandle<Scalar> h_sum(m_sum, access_location::host, access_mode::read);
+            this->m_Energy = h_sum.data[0];
+
+            #ifdef ENABLE_MPI
+            if (this->m_pdata->getDomainDecomposition())
+                {
+                MPI_Allreduce(MPI_IN_PLACE, &this->m_Energy, 1, MPI_HOOMD_SCALAR, MPI_SUM,
+                    this->m_exec_conf->getMPICommunicator());
+                }
+            #endif
+
+            this->accumulateEnergy();
+            }
+
+    protected:
+        GPUArray<Scalar4> m_symmetry_gpu;   //!< Symmetry quaternions in device memory
+        GPUArray<Scalar> m_sum;             //!< Total energy of the local particles
+        std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for the energy kernel block size
+    };
+
+//! Export the ExternalFieldLatticeGPU class to python
+/*! \param name Name of the class in the exported python module
+    \tparam Shape An instantiation of ExternalFieldLatticeGPU<Shape> will be exported
+*/
+template<class Shape>
+void export_LatticeFieldGPU(pybind11::module& m, std::string name)
+    {
+    pybind11::class_<ExternalFieldLatticeGPU<Shape>, ExternalFieldLattice<Shape>,
+                     std::shared_ptr< ExternalFieldLatticeGPU<Shape> > >(m, name.c_str())
+    .def(pybind11::init< std::shared_ptr<SystemDefinition>, pybind11::list, Scalar, pybind11::list, Scalar,
+                         pybind11::list>())
+    ;
+    }
+
+} // namespace hpmc
+
+#endif // ENABLE_HIP
+
+#endif // _EXTERNAL_FIELD_LATTICE_GPU_H_
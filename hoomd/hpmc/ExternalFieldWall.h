@@ -9,9 +9,11 @@
 */
 #include "hoomd/Compute.h"
 #include "hoomd/VectorMath.h"
+#include "hoomd/GlobalArray.h"
 
 #include "IntegratorHPMCMono.h"
 #include "ExternalField.h"
+#include "WallData.h"
 
 #include <tuple>
 #include <limits>
@@ -51,6 +53,16 @@ struct SphereWall
         verts->sweep_radius = OverlapReal(verts->diameter * alpha);
         }
 
+    //! Get the parameters needed to confine spheres
+    SphereWallData getData() const
+        {
+        SphereWallData data;
+        data.rsq = rsq;
+        data.origin = origin;
+        data.inside = inside;
+        return data;
+        }
+
     Scalar          rsq;
     bool            inside;
     vec3<Scalar>    origin;
@@ -86,6 +98,17 @@ struct CylinderWall
         verts->sweep_radius = OverlapReal(verts->sweep_radius * alpha);
         }
 
+    //! Get the parameters needed to confine spheres
+    CylinderWallData getData() const
+        {
+        CylinderWallData data;
+        data.rsq = rsq;
+        data.origin = origin;
+        data.orientation = orientation;
+        data.inside = inside;
+        return data;
+        }
+
     Scalar          rsq;
     bool            inside;
     vec3<Scalar>    origin;         // center of cylinder.
@@ -109,6 +132,15 @@ struct PlaneWall
         d *= alpha;
         }
 
+    //! Get the parameters needed to confine spheres
+    PlaneWallData getData() const
+        {
+        PlaneWallData data;
+        data.normal = normal;
+        data.d = d;
+        return data;
+        }
+
     vec3<Scalar>    normal; // unit normal n = (a, b, c)
     vec3<Scalar>    origin; // we could remove this.
     bool            inside; // not used
@@ -125,28 +157,7 @@ DEVICE inline bool test_confined(const WallShape& wall, const ParticleShape& sha
 template < >
 DEVICE inline bool test_confined<SphereWall, ShapeSphere>(const SphereWall& wall, const ShapeSphere& shape, const vec3<Scalar>& position, const vec3<Scalar>& box_origin, const BoxDim& box)
     {
-    Scalar3 t = vec_to_scalar3(position - box_origin);
-    t.x  = t.x - wall.origin.x;
-    t.y  = t.y - wall.origin.y;
-    t.z  = t.z - wall.origin.z;
-    vec3<Scalar> shifted_pos(box.minImage(t));
-
-    Scalar rxyz_sq = shifted_pos.x*shifted_pos.x + shifted_pos.y*shifted_pos.y + shifted_pos.z*shifted_pos.z; // distance from the container origin.
-    Scalar max_dist = sqrt(rxyz_sq) + (shape.getCircumsphereDiameter()/OverlapReal(2.0));
-    if (!wall.inside)
-      {
-      // if we must be outside the wall, subtract particle radius from min_dist
-      max_dist = sqrt(rxyz_sq) - (shape.getCircumsphereDiameter()/Scalar(2.0));
-      // if the particle radius is larger than the distance between the particle
-      // and the container, however, then ALWAYS check verts. this is equivalent
-      // to two particle circumspheres overlapping.
-      if (max_dist < 0)
-        {
-        max_dist = 0;
-        }
-      }
-
-    return wall.inside ? (wall.rsq > max_dist*max_dist) : (wall.rsq < max_dist*max_dist);
+    return test_confined(wall.getData(), shape, position, box_origin, box);
     }
 
 // Spherical Walls and Convex Polyhedra
@@ -277,29 +288,7 @@ DEVICE inline bool test_confined(const SphereWall& wall, const ShapeSpheropolyhe
 template < >
 DEVICE inline bool test_confined<CylinderWall, ShapeSphere>(const CylinderWall& wall, const ShapeSphere& shape, const vec3<Scalar>& position, const vec3<Scalar>& box_origin, const BoxDim& box)
     {
-    Scalar3 t = vec_to_scalar3(position - box_origin);
-    t.x = t.x - wall.origin.x;
-    t.y = t.y - wall.origin.y;
-    t.z = t.z - wall.origin.z;
-    vec3<Scalar> shifted_pos(box.minImage(t));
-
-    vec3<Scalar> dist_vec = cross(shifted_pos, wall.orientation); // find the component of the shifted position that is perpendicular to the normalized orientation vector
-    Scalar max_dist = sqrt(dot(dist_vec, dist_vec));
-    if (wall.inside) {max_dist += (shape.getCircumsphereDiameter()/Scalar(2.0));} // add the circumradius of the particle if the particle must be inside the wall
-    else
-      {
-      // subtract the circumradius of the particle if it must be outside the wall
-      max_dist -= (shape.getCircumsphereDiameter()/Scalar(2.0));
-      // if the particle radius is larger than the distance between the particle
-      // and the container, however, then ALWAYS check verts. this is equivalent
-      // to two particle circumspheres overlapping.
-      if (max_dist < 0)
-        {
-        max_dist = 0;
-        }
-      }
-
-    return wall.inside ? (wall.rsq > max_dist*max_dist) : (wall.rsq < max_dist*max_dist);
+    return test_confined(wall.getData(), shape, position, box_origin, box);
     }
 
 // Cylindrical Walls and Convex Polyhedra
@@ -366,10 +355,7 @@ DEVICE inline bool test_confined(const CylinderWall& wall, const ShapeConvexPoly
 template < >
 DEVICE inline bool test_confined<PlaneWall, ShapeSphere>(const PlaneWall& wall, const ShapeSphere& shape, const vec3<Scalar>& position, const vec3<Scalar>& box_origin, const BoxDim& box)
     {
-    Scalar3 t = vec_to_scalar3(position - box_origin);
-    vec3<Scalar> shifted_pos(box.minImage(t));
-    Scalar max_dist = dot(wall.normal, shifted_pos) + wall.d; // proj onto unit normal. (signed distance)
-    return (max_dist < 0) ? false :  0 < (max_dist - shape.getCircumsphereDiameter()/Scalar(2.0));
+    return test_confined(wall.getData(), shape, position, box_origin, box);
     }
 
 // Plane Walls and Convex Polyhedra
@@ -429,7 +415,8 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
     {
         using Compute::m_pdata;
     public:
-        ExternalFieldWall(std::shared_ptr<SystemDefinition> sysdef, std::shared_ptr<IntegratorHPMCMono<Shape> > mc) : ExternalFieldMono<Shape>(sysdef), m_mc(mc)
+        ExternalFieldWall(std::shared_ptr<SystemDefinition> sysdef, std::shared_ptr<IntegratorHPMCMono<Shape> > mc)
+            : ExternalFieldMono<Shape>(sysdef), m_mc(mc), m_walls_changed(true)
           {
           m_box = m_pdata->getGlobalBox();
           //! scale the container walls every time the box changes
@@ -475,7 +462,7 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
 
         Scalar calculateBoltzmannWeight(unsigned int timestep)
             {
-            unsigned int numOverlaps = countOverlaps(timestep, false);
+            unsigned int numOverlaps = countOverlaps(timestep, true);
             if(numOverlaps > 0)
                 {
                 return Scalar(0.0);
@@ -490,7 +477,7 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
                                         const Scalar4* const orientation_old,
                                         const BoxDim* const box_old)
             {
-            unsigned int numOverlaps = countOverlaps(0, false);
+            unsigned int numOverlaps = countOverlaps(0, true);
             if(numOverlaps > 0)
                 {
                 return INFINITY;
@@ -524,7 +511,7 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
                 {
                 m_Planes[i].scale(alpha);
                 }
-
+            m_walls_changed = true;
 
             m_box = newBox;
             }
@@ -620,6 +607,7 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
             if(index >= m_Spheres.size())
                 throw std::runtime_error("Out of bounds of sphere walls.");
             m_Spheres[index] = wall;
+            m_walls_changed = true;
             }
 
         void SetCylinderWallParameter(size_t index, const CylinderWall& wall)
@@ -627,6 +615,7 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
             if(index >= m_Cylinders.size())
                 throw std::runtime_error("Out of bounds of cylinder walls.");
             m_Cylinders[index] = wall;
+            m_walls_changed = true;
             }
 
         void SetPlaneWallParameter(size_t index, const PlaneWall& wall)
@@ -634,26 +623,31 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
             if(index >= m_Planes.size())
                 throw std::runtime_error("Out of bounds of plane walls.");
             m_Planes[index] = wall;
+            m_walls_changed = true;
             }
 
         void SetSphereWalls(const std::vector<SphereWall>& Spheres)
             {
             m_Spheres = Spheres;
+            m_walls_changed = true;
             }
 
         void SetCylinderWalls(const std::vector<CylinderWall>& Cylinders)
             {
             m_Cylinders = Cylinders;
+            m_walls_changed = true;
             }
 
         void SetPlaneWalls(const std::vector<PlaneWall>& Planes)
             {
             m_Planes = Planes;
+            m_walls_changed = true;
             }
 
         void AddSphereWall(const SphereWall& wall)
             {
             m_Spheres.push_back(wall);
+            m_walls_changed = true;
             size_t wall_ind = m_Spheres.size()-1;
             m_SphereLogQuantities.push_back(getSphWallParamName(wall_ind));
             }
@@ -661,6 +655,7 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
         void AddCylinderWall(const CylinderWall& wall)
             {
             m_Cylinders.push_back(wall);
+            m_walls_changed = true;
             size_t wall_ind = m_Cylinders.size()-1;
             m_CylinderLogQuantities.push_back(getCylWallParamName(wall_ind));
             }
@@ -668,24 +663,28 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
         void AddPlaneWall(const PlaneWall& wall)
             {
             m_Planes.push_back(wall);
+            m_walls_changed = true;
             }
 
         // is this messy ...
         void RemoveSphereWall(size_t index)
             {
             m_Spheres.erase(m_Spheres.begin()+index);
+            m_walls_changed = true;
             m_SphereLogQuantities.erase(m_SphereLogQuantities.begin()+index);
             }
 
         void RemoveCylinderWall(size_t index)
             {
             m_Cylinders.erase(m_Cylinders.begin()+index);
+            m_walls_changed = true;
             m_CylinderLogQuantities.erase(m_CylinderLogQuantities.begin()+index);
             }
 
         void RemovePlaneWall(size_t index)
             {
             m_Planes.erase(m_Planes.begin()+index);
+            m_walls_changed = true;
             }
 
         virtual std::vector< std::string > getProvidedLogQuantities()
@@ -795,6 +794,64 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
             m_box.setTiltFactors(xy,xz,yz);
             }
 
+        //! Get the walls in the form that the GPU kernels read
+        /*! The wall data arrays are rebuilt when the walls changed since the last call, so the host copies of the
+            walls remain the only ones that the setters and UpdaterExternalFieldWall modify.
+        */
+        hpmc_walls_t getWallData()
+            {
+            if (m_walls_changed)
+                {
+                GlobalArray<SphereWallData> spheres(m_Spheres.size(), this->m_exec_conf);
+                m_sphere_data.swap(spheres);
+                GlobalArray<CylinderWallData> cylinders(m_Cylinders.size(), this->m_exec_conf);
+                m_cylinder_data.swap(cylinders);
+                GlobalArray<PlaneWallData> planes(m_Planes.size(), this->m_exec_conf);
+                m_plane_data.swap(planes);
+
+                ArrayHandle<SphereWallData> h_spheres(m_sphere_data, access_location::host, access_mode::overwrite);
+                for (size_t i = 0; i < m_Spheres.size(); i++)
+                    h_spheres.data[i] = m_Spheres[i].getData();
+
+                ArrayHandle<CylinderWallData> h_cylinders(m_cylinder_data, access_location::host,
+                    access_mode::overwrite);
+                for (size_t i = 0; i < m_Cylinders.size(); i++)
+                    h_cylinders.data[i] = m_Cylinders[i].getData();
+
+                ArrayHandle<PlaneWallData> h_planes(m_plane_data, access_location::host, access_mode::overwrite);
+                for (size_t i = 0; i < m_Planes.size(); i++)
+                    h_planes.data[i] = m_Planes[i].getData();
+
+                m_walls_changed = false;
+                }
+
+            hpmc_walls_t walls;
+            walls.num_spheres = (unsigned int)m_Spheres.size();
+            walls.num_cylinders = (unsigned int)m_Cylinders.size();
+            walls.num_planes = (unsigned int)m_Planes.size();
+            walls.origin = vec3<Scalar>(m_pdata->getOrigin());
+            walls.box = m_pdata->getGlobalBox();
+            return walls;
+            }
+
+        //! Get the sphere walls read by the GPU kernels, valid after getWallData()
+        const GlobalArray<SphereWallData>& getSphereWallData() const
+            {
+            return m_sphere_data;
+            }
+
+        //! Get the cylinder walls read by the GPU kernels, valid after getWallData()
+        const GlobalArray<CylinderWallData>& getCylinderWallData() const
+            {
+            return m_cylinder_data;
+            }
+
+        //! Get the plane walls read by the GPU kernels, valid after getWallData()
+        const GlobalArray<PlaneWallData>& getPlaneWallData() const
+            {
+            return m_plane_data;
+            }
+
     protected:
         void set_cylinder_wall_verts(CylinderWall& wall, const Shape& shape)
             {
@@ -835,6 +892,10 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
     private:
         std::shared_ptr<IntegratorHPMCMono<Shape> > m_mc; //!< integrator
         BoxDim                                      m_box; //!< the current box
+        GlobalArray<SphereWallData>                 m_sphere_data;      //!< Sphere walls read by the GPU kernels
+        GlobalArray<CylinderWallData>               m_cylinder_data;    //!< Cylinder walls read by the GPU kernels
+        GlobalArray<PlaneWallData>                  m_plane_data;       //!< Plane walls read by the GPU kernels
+        bool                                        m_walls_changed;    //!< True when the wall data must be rebuilt
     };
 
 
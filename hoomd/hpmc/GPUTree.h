@@ -34,6 +34,22 @@ namespace hpmc
 namespace detail
 {
 
+//! Node of a GPUTree
+/*! The bounding box and the links that a traversal step reads are stored together, so that visiting a node touches
+    one cache line in single precision (two in double precision) instead of one per member array.
+*/
+struct alignas(64) GPUTreeNode
+    {
+    vec3<OverlapReal> center;   //!< Center of the node OBB
+    vec3<OverlapReal> lengths;  //!< Half axes of the node OBB
+    quat<OverlapReal> rotation; //!< Orientation of the node OBB
+    unsigned int mask;          //!< Overlap mask of the node OBB
+    unsigned int is_sphere;     //!< Nonzero when the node OBB is a sphere
+    unsigned int left;          //!< Left child, 0xffffffff for leaf nodes
+    unsigned int escape;        //!< Node to continue with after skipping this subtree
+    unsigned int ancestors;     //!< Number of right-most ancestors
+    };
+
 //! Adapter class to AABTree for query on the GPU
 class GPUTree
     {
@@ -53,14 +69,7 @@ class GPUTree
             // allocate
             m_num_nodes = tree.getNumNodes();
 
-            m_center = ManagedArray<vec3<OverlapReal> >(m_num_nodes, managed);
-            m_lengths = ManagedArray<vec3<OverlapReal> >(m_num_nodes,managed);
-            m_rotation = ManagedArray<quat<OverlapReal> >(m_num_nodes,managed);
-            m_mask = ManagedArray<unsigned int>(m_num_nodes,managed);
-            m_is_sphere = ManagedArray<unsigned int>(m_num_nodes,managed);
-            m_left = ManagedArray<unsigned int>(m_num_nodes, managed);
-            m_escape = ManagedArray<unsigned int>(m_num_nodes, managed);
-            m_ancestors = ManagedArray<unsigned int>(m_num_nodes, managed);
+            m_nodes = ManagedArray<GPUTreeNode>(m_num_nodes, managed, alignof(GPUTreeNode));
             m_leaf_ptr = ManagedArray<unsigned int>(m_num_nodes+1, managed);
 
             unsigned int n = 0;
@@ -69,19 +78,19 @@ class GPUTree
             // load data from OBBTree
             for (unsigned int i = 0; i < tree.getNumNodes(); ++i)
                 {
-                m_left[i] = tree.getNodeLeft(i);
-                m_escape[i] = tree.getEscapeIndex(i);
+                m_nodes[i].left = tree.getNodeLeft(i);
+                m_nodes[i].escape = tree.getEscapeIndex(i);
 
-                m_center[i] = tree.getNodeOBB(i).getPosition();
-                m_rotation[i] = tree.getNodeOBB(i).rotation;
-                m_lengths[i] = tree.getNodeOBB(i).lengths;
-                m_mask[i] = tree.getNodeOBB(i).mask;
-                m_is_sphere[i] = tree.getNodeOBB(i).isSphere();
+                m_nodes[i].center = tree.getNodeOBB(i).getPosition();
+                m_nodes[i].rotation = tree.getNodeOBB(i).rotation;
+                m_nodes[i].lengths = tree.getNodeOBB(i).lengths;
+                m_nodes[i].mask = tree.getNodeOBB(i).mask;
+                m_nodes[i].is_sphere = tree.getNodeOBB(i).isSphere();
 
                 m_leaf_ptr[i] = n;
                 n += tree.getNodeNumParticles(i);
 
-                if (m_left[i] == OBB_INVALID_NODE)
+                if (m_nodes[i].left == OBB_INVALID_NODE)
                     {
                     m_num_leaves++;
                     }
@@ -92,7 +101,7 @@ class GPUTree
             m_num_leaves = 0;
             for (unsigned int i =0; i < tree.getNumNodes(); ++i)
                 {
-                if (m_left[i] == OBB_INVALID_NODE)
+                if (m_nodes[i].left == OBB_INVALID_NODE)
                     {
                     m_leaf_obb_ptr[m_num_leaves++] = i;
                     }
@@ -134,7 +143,7 @@ class GPUTree
                 initializeAncestorCounts(right_idx, tree, ancestors+1);
                 }
 
-            m_ancestors[idx] = ancestors;
+            m_nodes[idx].ancestors = ancestors;
             }
         #endif
 
@@ -167,7 +176,7 @@ class GPUTree
                 }
 
             // escape
-            cur_node = m_escape[cur_node];
+            cur_node = m_nodes[cur_node].escape;
 
             return leaf;
             }
@@ -205,7 +214,7 @@ class GPUTree
                 }
 
             // escape
-            cur_node = m_escape[cur_node];
+            cur_node = m_nodes[cur_node].escape;
 
             return leaf;
             }
@@ -213,7 +222,7 @@ class GPUTree
         //! Test if a given index is a leaf node
         DEVICE inline bool isLeaf(unsigned int idx) const
             {
-            return (m_left[idx] == 0xffffffff);
+            return (m_nodes[idx].left == 0xffffffff);
             }
 
         //! Return the ith leaf node
@@ -252,27 +261,28 @@ class GPUTree
 
         DEVICE inline unsigned int getLeftChild(unsigned int node) const
             {
-            return m_left[node];
+            return m_nodes[node].left;
             }
 
         DEVICE inline unsigned int getEscapeIndex(unsigned int node) const
             {
-            return m_escape[node];
+            return m_nodes[node].escape;
             }
 
         DEVICE inline unsigned int getNumAncestors(unsigned int node) const
             {
-            return m_ancestors[node];
+            return m_nodes[node].ancestors;
             }
 
         DEVICE inline OBB getOBB(unsigned int idx) const
             {
+            const GPUTreeNode& node = m_nodes[idx];
             OBB obb;
-            obb.center = m_center[idx];
-            obb.lengths = m_lengths[idx];
-            obb.rotation = m_rotation[idx];
-            obb.mask = m_mask[idx];
-            obb.is_sphere = m_is_sphere[idx];
+            obb.center = node.center;
+            obb.lengths = node.lengths;
+            obb.rotation = node.rotation;
+            obb.mask = node.mask;
+            obb.is_sphere = node.is_sphere;
             return obb;
             }
 
@@ -280,15 +290,7 @@ class GPUTree
         //! Set CUDA memory hints
         void set_memory_hint() const
             {
-            m_center.set_memory_hint();
-            m_lengths.set_memory_hint();
-            m_rotation.set_memory_hint();
-            m_mask.set_memory_hint();
-            m_is_sphere.set_memory_hint();
-
-            m_left.set_memory_hint();
-            m_escape.set_memory_hint();
-            m_ancestors.set_memory_hint();
+            m_nodes.set_memory_hint();
 
             m_leaf_ptr.set_memory_hint();
             m_leaf_obb_ptr.set_memory_hint();
@@ -302,15 +304,7 @@ class GPUTree
          */
         DEVICE void load_shared(char *& ptr, unsigned int &available_bytes)
             {
-            m_center.load_shared(ptr, available_bytes);
-            m_lengths.load_shared(ptr, available_bytes);
-            m_rotation.load_shared(ptr, available_bytes);
-            m_mask.load_shared(ptr, available_bytes);
-            m_is_sphere.load_shared(ptr, available_bytes);
-
-            m_left.load_shared(ptr, available_bytes);
-            m_escape.load_shared(ptr, available_bytes);
-            m_ancestors.load_shared(ptr, available_bytes);
+            m_nodes.load_shared(ptr, available_bytes);
 
             m_leaf_ptr.load_shared(ptr, available_bytes);
             m_leaf_obb_ptr.load_shared(ptr, available_bytes);
@@ -323,15 +317,7 @@ class GPUTree
          */
         HOSTDEVICE void allocate_shared(char *& ptr, unsigned int &available_bytes) const
             {
-            m_center.allocate_shared(ptr, available_bytes);
-            m_lengths.allocate_shared(ptr, available_bytes);
-            m_rotation.allocate_shared(ptr, available_bytes);
-            m_mask.allocate_shared(ptr, available_bytes);
-            m_is_sphere.allocate_shared(ptr, available_bytes);
-
-            m_left.allocate_shared(ptr, available_bytes);
-            m_escape.allocate_shared(ptr, available_bytes);
-            m_ancestors.allocate_shared(ptr, available_bytes);
+            m_nodes.allocate_shared(ptr, available_bytes);
 
             m_leaf_ptr.allocate_shared(ptr, available_bytes);
             m_leaf_obb_ptr.allocate_shared(ptr, available_bytes);
@@ -345,20 +331,12 @@ class GPUTree
             }
 
     private:
-        ManagedArray<vec3<OverlapReal> > m_center;
-        ManagedArray<vec3<OverlapReal> > m_lengths;
-        ManagedArray<quat<OverlapReal> > m_rotation;
-        ManagedArray<unsigned int> m_mask;
-        ManagedArray<unsigned int> m_is_sphere;
+        ManagedArray<GPUTreeNode> m_nodes;    //!< Bounding boxes and links of the nodes
 
         ManagedArray<unsigned int> m_leaf_ptr; //!< Pointer to leaf node contents
         ManagedArray<unsigned int> m_leaf_obb_ptr; //!< Pointer to leaf node OBBs
         ManagedArray<unsigned int> m_particles;        //!< Stores the leaf nodes' indices
 
-        ManagedArray<unsigned int> m_left;    //!< Left nodes
-        ManagedArray<unsigned int> m_escape;  //!< Escape indices
-        ManagedArray<unsigned int> m_ancestors;  //!< Number of right-most ancestors
-
         unsigned int m_num_nodes;             //!< Number of nodes in the tree
         unsigned int m_num_leaves;            //!< Number of leaf nodes
         unsigned int m_leaf_capacity;         //!< Capacity of OBB leaf nodes
@@ -97,6 +97,44 @@ DEVICE inline hpmc_counters_t operator+(const hpmc_counters_t& a, const hpmc_cou
     return result;
     }
 
+//! Parameters of the move size controller
+/*! \ingroup hpmc_data_structs */
+struct hpmc_move_size_tuner_params_t
+    {
+    Scalar target;                                      //!< Target acceptance ratio
+    Scalar gamma;                                       //!< Added to the acceptance ratio and target to damp changes
+    Scalar max_scale;                                   //!< Largest factor to scale a move size by in one step
+    Scalar tol;                                         //!< Leave move sizes unchanged within this tolerance
+    Scalar min_move;                                    //!< Smallest move size
+    bool tune_d;                                        //!< True to tune the translation move sizes
+    bool tune_a;                                        //!< True to tune the rotation move sizes
+    };
+
+//! Compute the factor to scale a move size by
+/*! \param accept Number of accepted moves since the last tuning step
+    \param reject Number of rejected moves since the last tuning step
+    \param params Controller parameters
+
+    The acceptance ratio decreases with the move size, so the move size is scaled by
+    (ratio + gamma) / (target + gamma), limited to the range [1/max_scale, max_scale]. Returns 1 when no moves were
+    made or the ratio is within the tolerance of the target.
+*/
+DEVICE inline Scalar move_size_scale(unsigned long long int accept,
+                                     unsigned long long int reject,
+                                     const hpmc_move_size_tuner_params_t& params)
+    {
+    unsigned long long int total = accept + reject;
+    if (total == 0)
+        return Scalar(1.0);
+
+    Scalar ratio = Scalar(accept) / Scalar(total);
+    if (fabs(ratio - params.target) <= params.tol)
+        return Scalar(1.0);
+
+    Scalar scale = (ratio + params.gamma) / (params.target + params.gamma);
+    return fmin(fmax(scale, Scalar(1.0) / params.max_scale), params.max_scale);
+    }
+
 //! Storage for NPT acceptance counters
 /*! \ingroup hpmc_data_structs */
 struct hpmc_boxmc_counters_t
@@ -196,11 +234,13 @@ DEVICE inline hpmc_boxmc_counters_t operator-(const hpmc_boxmc_counters_t& a, co
 struct hpmc_implicit_counters_t
     {
     unsigned long long int insert_count;                //!< Count of depletants inserted
+    Scalar insert_count_saved;                          //!< Expected number of insertions avoided by lens bounds
 
     //! Construct a zero set of counters
     DEVICE hpmc_implicit_counters_t()
         {
         insert_count = 0;
+        insert_count_saved = 0;
         }
     };
 
@@ -380,6 +420,7 @@ DEVICE inline hpmc_implicit_counters_t operator-(const hpmc_implicit_counters_t&
     {
     hpmc_implicit_counters_t result;
     result.insert_count = a.insert_count - b.insert_count;
+    result.insert_count_saved = a.insert_count_saved - b.insert_count_saved;
     return result;
     }
 
@@ -388,6 +429,7 @@ DEVICE inline hpmc_implicit_counters_t operator+(const hpmc_implicit_counters_t&
     {
     hpmc_implicit_counters_t result;
     result.insert_count = a.insert_count + b.insert_count;
+    result.insert_count_saved = a.insert_count_saved + b.insert_count_saved;
     return result;
     }
 
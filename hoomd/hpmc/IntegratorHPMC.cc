@@ -20,6 +20,7 @@ namespace hpmc
 IntegratorHPMC::IntegratorHPMC(std::shared_ptr<SystemDefinition> sysdef,
                                unsigned int seed)
     : Integrator(sysdef, 0.005), m_seed(seed),  m_translation_move_probability(32768), m_nselect(4),
+      m_checkerboard(false), m_checkerboard_sweeps(0), m_incremental_overlaps(false),
       m_nominal_width(1.0), m_extra_ghost_width(0), m_external_base(NULL), m_patch_log(false),
       m_past_first_run(false)
       #ifdef ENABLE_MPI
@@ -38,6 +39,9 @@ IntegratorHPMC::IntegratorHPMC(std::shared_ptr<SystemDefinition> sysdef,
     GlobalArray<hpmc_counters_t> counters(1, this->m_exec_conf);
     m_count_total.swap(counters);
 
+    GlobalArray<hpmc_counters_t> count_step_start(1, this->m_exec_conf);
+    m_count_step_start.swap(count_step_start);
+
     GPUVector<Scalar> d(this->m_pdata->getNTypes(), this->m_exec_conf);
     m_d.swap(d);
 
@@ -238,40 +242,69 @@ bool IntegratorHPMC::checkParticleOrientations()
     \returns false if resize results in overlaps
 */
 bool IntegratorHPMC::attemptBoxResize(unsigned int timestep, const BoxDim& new_box)
+    {
+    // move the particles to be inside the new box
+    scaleParticles(m_pdata->getGlobalBox(), new_box);
+
+    m_pdata->setGlobalBox(new_box);
+
+    // we have moved particles, communicate those changes
+    this->communicate(false);
+
+    // check overlaps
+    return !this->countOverlaps(true);
+    }
+
+/*! \param old_box Global box the particles are in
+    \param new_box Global box to scale the particles into
+
+    The particles keep their fractional coordinates. The box itself is not changed.
+*/
+void IntegratorHPMC::scaleParticles(const BoxDim& old_box, const BoxDim& new_box)
     {
     unsigned int N = m_pdata->getN();
 
-    // Get old and new boxes;
-    BoxDim curBox = m_pdata->getGlobalBox();
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
 
-    // Use lexical scope block to make sure ArrayHandles get cleaned up
+    for (unsigned int i = 0; i < N; i++)
         {
-        // Get particle positions
-        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
-
-        // move the particles to be inside the new box
-        for (unsigned int i = 0; i < N; i++)
-            {
-            Scalar3 old_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        Scalar3 old_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
 
-            // obtain scaled coordinates in the old global box
-            Scalar3 f = curBox.makeFraction(old_pos);
+        // obtain scaled coordinates in the old global box
+        Scalar3 f = old_box.makeFraction(old_pos);
 
-            // scale particles
-            Scalar3 scaled_pos = new_box.makeCoordinates(f);
-            h_pos.data[i].x = scaled_pos.x;
-            h_pos.data[i].y = scaled_pos.y;
-            h_pos.data[i].z = scaled_pos.z;
-            }
-        } // end lexical scope
+        // scale particles
+        Scalar3 scaled_pos = new_box.makeCoordinates(f);
+        h_pos.data[i].x = scaled_pos.x;
+        h_pos.data[i].y = scaled_pos.y;
+        h_pos.data[i].z = scaled_pos.z;
+        }
+    }
 
-    m_pdata->setGlobalBox(new_box);
+/*! \param timestep Current time step
 
-    // we have moved particles, communicate those changes
-    this->communicate(false);
+    Save the counters at the start of the step. On the GPU, the copy stays on the device, so that the counters are
+    transferred to the host only when getCounters() is called.
+*/
+void IntegratorHPMC::update(unsigned int timestep)
+    {
+    #ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        ArrayHandle<hpmc_counters_t> d_counters(m_count_total, access_location::device, access_mode::read);
+        ArrayHandle<hpmc_counters_t> d_count_step_start(m_count_step_start, access_location::device,
+            access_mode::overwrite);
+        hipMemcpyAsync(d_count_step_start.data, d_counters.data, sizeof(hpmc_counters_t), hipMemcpyDeviceToDevice);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        return;
+        }
+    #endif
 
-    // check overlaps
-    return !this->countOverlaps(true);
+    ArrayHandle<hpmc_counters_t> h_counters(m_count_total, access_location::host, access_mode::read);
+    ArrayHandle<hpmc_counters_t> h_count_step_start(m_count_step_start, access_location::host,
+        access_mode::overwrite);
+    h_count_step_start.data[0] = h_counters.data[0];
     }
 
 /*! \param mode 0 -> Absolute count, 1 -> relative to the start of the run, 2 -> relative to the last executed step
@@ -291,7 +324,11 @@ hpmc_counters_t IntegratorHPMC::getCounters(unsigned int mode)
     else if (mode == 1)
         result = h_counters.data[0] - m_count_run_start;
     else
-        result = h_counters.data[0] - m_count_step_start;
+        {
+        ArrayHandle<hpmc_counters_t> h_count_step_start(m_count_step_start, access_location::host,
+            access_mode::read);
+        result = h_counters.data[0] - h_count_step_start.data[0];
+        }
 
 #ifdef ENABLE_MPI
     if (m_comm)
@@ -308,6 +345,47 @@ hpmc_counters_t IntegratorHPMC::getCounters(unsigned int mode)
     return result;
     }
 
+/*! \param params Controller parameters
+    \param d_max Largest translation move size by type, 0 for types that are not tuned
+    \param a_max Largest rotation move size by type, 0 for types that are not tuned
+    \param count_last Counters at the previous call (in/out, one element)
+
+    Scale the move sizes of the tuned types by move_size_scale() of the acceptance ratio since the previous call.
+    The translation and rotation acceptance ratios are counted over all types, as in the counters themselves.
+*/
+void IntegratorHPMC::tuneMoveSizes(const hpmc_move_size_tuner_params_t& params,
+                                   const GPUArray<Scalar>& d_max,
+                                   const GPUArray<Scalar>& a_max,
+                                   GPUArray<hpmc_counters_t>& count_last)
+    {
+    hpmc_counters_t counters = getCounters(0);
+
+    ArrayHandle<hpmc_counters_t> h_count_last(count_last, access_location::host, access_mode::readwrite);
+    hpmc_counters_t delta = counters - h_count_last.data[0];
+    h_count_last.data[0] = counters;
+
+    Scalar scale_d = move_size_scale(delta.translate_accept_count, delta.translate_reject_count, params);
+    Scalar scale_a = move_size_scale(delta.rotate_accept_count, delta.rotate_reject_count, params);
+
+        {
+        ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_d_max(d_max, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_a_max(a_max, access_location::host, access_mode::read);
+
+        unsigned int ntypes = std::min(m_pdata->getNTypes(), (unsigned int)d_max.getNumElements());
+        for (unsigned int typ = 0; typ < ntypes; typ++)
+            {
+            if (params.tune_d && h_d_max.data[typ] > Scalar(0.0))
+                h_d.data[typ] = std::max(std::min(h_d.data[typ]*scale_d, h_d_max.data[typ]), params.min_move);
+            if (params.tune_a && h_a_max.data[typ] > Scalar(0.0))
+                h_a.data[typ] = std::max(std::min(h_a.data[typ]*scale_a, h_a_max.data[typ]), params.min_move);
+            }
+        }
+
+    updateCellWidth();
+    }
+
 void export_IntegratorHPMC(py::module& m)
     {
     py::class_<IntegratorHPMC, Integrator, std::shared_ptr< IntegratorHPMC > >(m, "IntegratorHPMC")
@@ -322,6 +400,7 @@ void export_IntegratorHPMC(py::module& m)
         .def("getNSelect", &IntegratorHPMC::getNSelect)
         .def("getMaxCoreDiameter", &IntegratorHPMC::getMaxCoreDiameter)
         .def("countOverlaps", &IntegratorHPMC::countOverlaps)
+        .def("hasOverlaps", &IntegratorHPMC::hasOverlaps)
         .def("checkParticleOrientations", &IntegratorHPMC::checkParticleOrientations)
         .def("getMPS", &IntegratorHPMC::getMPS)
         .def("getCounters", &IntegratorHPMC::getCounters)
@@ -333,6 +412,10 @@ void export_IntegratorHPMC(py::module& m)
         #endif
         .def_property_readonly("seed", &IntegratorHPMC::getSeed)
         .def_property("nselect", &IntegratorHPMC::getNSelect, &IntegratorHPMC::setNSelect)
+        .def_property("checkerboard", &IntegratorHPMC::getCheckerboard, &IntegratorHPMC::setCheckerboard)
+        .def_property_readonly("checkerboard_sweeps", &IntegratorHPMC::getCheckerboardSweeps)
+        .def_property("incremental_overlaps", &IntegratorHPMC::getIncrementalOverlaps,
+                      &IntegratorHPMC::setIncrementalOverlaps)
         .def_property("translation_move_probability", &IntegratorHPMC::getTranslationMoveProbability, &IntegratorHPMC::setTranslationMoveProbability)
         ;
 
@@ -127,6 +127,48 @@ struct hpmc_patch_args_t
 
 } // end namespace detail
 
+//! Batch of j particles that interact with one particle i through a patch energy
+/*! The integrator collects the neighbors of a trial move in structure of array form and evaluates all of their
+    patch energies with one call to PatchEnergy::energyBatch(). r_x, r_y, r_z hold the components of r_ij, and q_s,
+    q_x, q_y, q_z hold the orientation of j. energy is scratch space for implementations that compute the energy of
+    each pair before summing.
+*/
+struct PatchEnergyBatch
+    {
+    std::vector<float> r_x, r_y, r_z;
+    std::vector<unsigned int> type_j;
+    std::vector<float> q_s, q_x, q_y, q_z;
+    std::vector<float> d_j;
+    std::vector<float> charge_j;
+    std::vector<float> energy;
+
+    //! Get the number of pairs in the batch
+    unsigned int size() const
+        {
+        return (unsigned int)r_x.size();
+        }
+
+    //! Remove all pairs, keeping the allocated memory
+    void clear()
+        {
+        r_x.clear(); r_y.clear(); r_z.clear();
+        type_j.clear();
+        q_s.clear(); q_x.clear(); q_y.clear(); q_z.clear();
+        d_j.clear();
+        charge_j.clear();
+        }
+
+    //! Add a pair to the batch
+    void push_back(const vec3<float>& r_ij, unsigned int type, const quat<float>& q, float d, float charge)
+        {
+        r_x.push_back(r_ij.x); r_y.push_back(r_ij.y); r_z.push_back(r_ij.z);
+        type_j.push_back(type);
+        q_s.push_back(q.s); q_x.push_back(q.v.x); q_y.push_back(q.v.y); q_z.push_back(q.v.z);
+        d_j.push_back(d);
+        charge_j.push_back(charge);
+        }
+    };
+
 //! Integrator that implements the HPMC approach
 /*! **Overview** <br>
     IntegratorHPMC is an non-templated base class that implements the basic methods that all HPMC integrators have.
@@ -186,6 +228,36 @@ class PatchEnergy
             return 0;
             }
 
+        //! evaluate the patch energies of a batch of pairs that share particle i
+        /*! \param batch The j particles
+            \param type_i Integer type index of particle i
+            \param q_i Orientation quaternion of particle i
+            \param d_i Diameter of particle i
+            \param charge_i Charge of particle i
+            \returns Sum of the energies in the batch
+
+            The default implementation calls energy() for each pair. Subclasses override it to evaluate the batch in
+            one call.
+        */
+        virtual double energyBatch(PatchEnergyBatch& batch,
+            unsigned int type_i,
+            const quat<float>& q_i,
+            float d_i,
+            float charge_i)
+            {
+            double sum = 0.0;
+            for (unsigned int k = 0; k < batch.size(); k++)
+                {
+                sum += energy(vec3<float>(batch.r_x[k], batch.r_y[k], batch.r_z[k]),
+                              type_i, q_i, d_i, charge_i,
+                              batch.type_j[k],
+                              quat<float>(batch.q_s[k], vec3<float>(batch.q_x[k], batch.q_y[k], batch.q_z[k])),
+                              batch.d_j[k],
+                              batch.charge_j[k]);
+                }
+            return sum;
+            }
+
         #ifdef ENABLE_HIP
         //! Set autotuner parameters
         /*! \param enable Enable/disable autotuning
@@ -217,11 +289,7 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         virtual ~IntegratorHPMC();
 
         //! Take one timestep forward
-        virtual void update(unsigned int timestep)
-            {
-            ArrayHandle<hpmc_counters_t> h_counters(m_count_total, access_location::host, access_mode::read);
-            m_count_step_start = h_counters.data[0];
-            }
+        virtual void update(unsigned int timestep);
 
         //! Change maximum displacement
         /*! \param typ Name of type to set
@@ -310,6 +378,12 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
             return m_a;
             }
 
+        //! Scale the move sizes towards a target acceptance ratio
+        virtual void tuneMoveSizes(const hpmc_move_size_tuner_params_t& params,
+                                   const GPUArray<Scalar>& d_max,
+                                   const GPUArray<Scalar>& a_max,
+                                   GPUArray<hpmc_counters_t>& count_last);
+
         //! Change translation move probability.
         /*! \param translation_move_probability new translation_move_probability to set
         */
@@ -341,10 +415,44 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
             return m_nselect;
             }
 
+        //! Set whether to sweep the trial moves in parallel over the cells of a checkerboard
+        void setCheckerboard(bool checkerboard)
+            {
+            m_checkerboard = checkerboard;
+            }
+
+        //! Get whether to sweep the trial moves in parallel over the cells of a checkerboard
+        bool getCheckerboard()
+            {
+            return m_checkerboard;
+            }
+
+        //! Get the number of sweeps made in parallel over the cells of a checkerboard
+        unsigned long long int getCheckerboardSweeps()
+            {
+            return m_checkerboard_sweeps;
+            }
+
+        //! Set whether countOverlaps() rechecks only the particles that overlapped in the last count
+        virtual void setIncrementalOverlaps(bool incremental_overlaps)
+            {
+            m_incremental_overlaps = incremental_overlaps;
+            }
+
+        //! Get whether countOverlaps() rechecks only the particles that overlapped in the last count
+        bool getIncrementalOverlaps()
+            {
+            return m_incremental_overlaps;
+            }
+
         //! Get performance in moves per second
+        /*! The counters are read here rather than after every step, so that GPU runs do not synchronize with the host
+            on every sweep.
+        */
         virtual double getMPS()
             {
-            return m_mps;
+            hpmc_counters_t run_counters = getCounters(1);
+            return m_mps_time > 0 ? double(run_counters.getNMoves()) / m_mps_time : 0;
             }
 
         //! Reset statistics counters
@@ -371,6 +479,23 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
             return 0;
             }
 
+        //! Test if any pair of particles overlaps
+        /*! Stops at the first overlap found.
+        */
+        bool hasOverlaps()
+            {
+            return countOverlaps(true) != 0;
+            }
+
+        //! Set the fugacity of a depletant type
+        /*! \param type Depletant type
+            \param fugacity Depletant fugacity, 0 for no depletants
+        */
+        virtual void setDepletantFugacity(unsigned int type, Scalar fugacity)
+            {
+            throw std::runtime_error("This integrator does not support depletants");
+            }
+
         //! Get the number of degrees of freedom granted to a given group
         /*! \param group Group over which to count degrees of freedom.
             \return a non-zero dummy value to suppress warnings.
@@ -504,6 +629,9 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         unsigned int m_seed;                        //!< Random number seed
         unsigned int m_translation_move_probability;     //!< Fraction of moves that are translation moves.
         unsigned int m_nselect;                     //!< Number of particles to select for trial moves
+        bool m_checkerboard;                        //!< True to sweep the moves in parallel over checkerboard cells
+        unsigned long long int m_checkerboard_sweeps; //!< Number of sweeps made over checkerboard cells
+        bool m_incremental_overlaps;                //!< True to recount overlaps among previously overlapping particles
 
         GPUVector<Scalar> m_d;                      //!< Maximum move displacement by type
         GPUVector<Scalar> m_a;                      //!< Maximum angular displacement by type
@@ -514,8 +642,8 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         Scalar m_extra_ghost_width;                  //!< extra ghost width to add
         ClockSource m_clock;                           //!< Timer for self-benchmarking
 
-        /// Moves-per-second value last recorded
-        double m_mps = 0;
+        /// Time in seconds from the start of the run to the end of the last step
+        double m_mps_time = 0;
 
         ExternalField* m_external_base; //! This is a cast of the derived class's m_external that can be used in a more general setting.
 
@@ -537,6 +665,9 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
             return Scalar(0.0);
             }
 
+        //! Scale the local particle positions from one global box to another
+        virtual void scaleParticles(const BoxDim& old_box, const BoxDim& new_box);
+
         #ifdef ENABLE_MPI
         //! Return the requested communication flags for ghost particles
         virtual CommFlags getCommFlags(unsigned int)
@@ -548,7 +679,7 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
 
     private:
         hpmc_counters_t m_count_run_start;             //!< Count saved at run() start
-        hpmc_counters_t m_count_step_start;            //!< Count saved at the start of the last step
+        GlobalArray<hpmc_counters_t> m_count_step_start; //!< Count saved at the start of the last step
 
         #ifdef ENABLE_MPI
         bool m_communicator_ghost_width_connected;     //!< True if we have connected to Communicator's ghost layer width signal
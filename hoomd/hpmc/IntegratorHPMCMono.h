@@ -12,8 +12,11 @@
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <numeric>
+#include <algorithm>
 
 #include "hoomd/Integrator.h"
+#include "hoomd/Autotuner.h"
 #include "HPMCPrecisionSetup.h"
 #include "IntegratorHPMC.h"
 #include "Moves.h"
@@ -26,6 +29,7 @@
 #include "ShapeSpheropolyhedron.h"
 
 #ifdef ENABLE_TBB
+#include <atomic>
 #include <thread>
 #include <tbb/blocked_range.h>
 #include <tbb/enumerable_thread_specific.h>
@@ -148,6 +152,18 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Take one timestep forward
         virtual void update(unsigned int timestep);
 
+        #ifdef ENABLE_TBB
+        //! Set autotuner parameters
+        /*! \param enable Enable/disable autotuning
+            \param period period (approximate) in time steps when returning occurs
+        */
+        virtual void setAutotunerParams(bool enable, unsigned int period)
+            {
+            m_tuner_checkerboard_grain->setPeriod(period*this->m_nselect);
+            m_tuner_checkerboard_grain->setEnabled(enable);
+            }
+        #endif
+
         /*
          * Depletant related options
          */
@@ -156,7 +172,13 @@ class IntegratorHPMCMono : public IntegratorHPMC
         void setDepletantFugacityPy(std::string type_name, Scalar fugacity)
             {
             unsigned int id = this->m_pdata->getTypeByName(type_name);
-            m_fugacity[id] = fugacity;
+            setDepletantFugacity(id, fugacity);
+            }
+
+        //! Set the depletant density in the free volume
+        virtual void setDepletantFugacity(unsigned int type, Scalar fugacity)
+            {
+            m_fugacity[type] = fugacity;
             }
 
         //! Returns the depletant fugacity
@@ -396,7 +418,20 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange();
 
-        void invalidateAABBTree(){ m_aabb_tree_invalid = true; }
+        //! Set whether countOverlaps() rechecks only the particles that overlapped in the last count
+        /*! Discards the record of overlapping particles.
+        */
+        virtual void setIncrementalOverlaps(bool incremental_overlaps)
+            {
+            IntegratorHPMC::setIncrementalOverlaps(incremental_overlaps);
+            m_overlap_candidates_valid = false;
+            }
+
+        void invalidateAABBTree()
+            {
+            m_aabb_tree_invalid = true;
+            m_overlap_candidates_valid = false;
+            }
 
         //! Method that is called whenever the GSD file is written if connected to a GSD file.
         int slotWriteGSDState(gsd_handle&, std::string name) const;
@@ -452,6 +487,11 @@ class IntegratorHPMCMono : public IntegratorHPMC
         detail::AABB* m_aabbs;                      //!< list of AABBs, one per particle
         unsigned int m_aabbs_capacity;              //!< Capacity of m_aabbs list
         bool m_aabb_tree_invalid;                   //!< Flag if the aabb tree has been invalidated
+        bool m_aabb_tree_rebuild;                   //!< Flag if the aabb tree needs a rebuild instead of a refit
+
+        std::vector<unsigned int> m_overlap_candidates; //!< Particles that overlapped in the last complete count
+        bool m_overlap_candidates_valid;            //!< True when m_overlap_candidates holds every overlapping particle
+        unsigned int m_overlap_candidates_N;        //!< Number of particles when m_overlap_candidates was filled
 
         Scalar m_extra_image_width;                 //! Extra width to extend the image list
 
@@ -481,6 +521,50 @@ class IntegratorHPMCMono : public IntegratorHPMC
             tbb::enumerable_thread_specific< hoomd::RandomGenerator >& rng_depletants_parallel);
         #endif
 
+        #ifdef ENABLE_TBB
+        uint3 m_checkerboard_dim;                                //!< Number of checkerboard cells along each direction
+        std::vector<unsigned int> m_checkerboard_cell;           //!< Checkerboard cell of each particle
+        std::vector<unsigned int> m_checkerboard_cell_start;     //!< First entry of each cell in the particle list
+        std::vector<unsigned int> m_checkerboard_cell_particles; //!< Particles sorted by cell, in the update order
+        std::unique_ptr<Autotuner> m_tuner_checkerboard_grain;  //!< Autotuner for the cells per TBB task
+
+        //! Choose the checkerboard cells for this time step
+        bool initCheckerboard();
+
+        //! Perform one sweep of trial moves in parallel over the checkerboard cells
+        void sweepCheckerboard(unsigned int timestep, unsigned int i_nselect, const unsigned int *h_overlaps,
+            hpmc_counters_t& counters);
+        #endif
+
+        Index3D m_sphere_cell_idx;                    //!< Indexes the cells of the uniform sphere sweep
+        Index2D m_sphere_cell_list_idx;               //!< Indexes the slots of the cells (slot, cell)
+        Scalar m_sphere_diameter;                     //!< Diameter of the uniform spheres
+        std::vector<unsigned int> m_sphere_cell_size; //!< Number of particles in each cell
+        std::vector<unsigned int> m_sphere_cell_tag;  //!< Particle index in each slot
+        std::vector<Scalar> m_sphere_cell_x;          //!< x coordinate of the wrapped position in each slot
+        std::vector<Scalar> m_sphere_cell_y;          //!< y coordinate of the wrapped position in each slot
+        std::vector<Scalar> m_sphere_cell_z;          //!< z coordinate of the wrapped position in each slot
+        std::vector<unsigned int> m_sphere_cell;      //!< Cell of each particle
+        std::vector<unsigned int> m_sphere_slot;      //!< Slot of each particle in its cell
+
+        //! Test if the uniform sphere sweep applies to this shape and these parameters
+        bool useUniformSphereCells()
+            {
+            return false;
+            }
+
+        //! Build the dense cell list of the uniform sphere sweep
+        bool initUniformSphereCells();
+
+        //! Find the cell of a position and wrap the position into the box
+        uint3 getUniformSphereCell(vec3<Scalar>& r);
+
+        //! Set the slot of a particle in the dense cell list, growing the cells when needed
+        void insertUniformSphere(unsigned int i, unsigned int cell, const vec3<Scalar>& r);
+
+        //! Perform one sweep of trial moves on monodisperse spheres with the dense cell list
+        void sweepUniformSpheres(unsigned int timestep, unsigned int i_nselect, hpmc_counters_t& counters);
+
         //! Set the nominal width appropriate for looped moves
         virtual void updateCellWidth();
 
@@ -496,17 +580,46 @@ class IntegratorHPMCMono : public IntegratorHPMC
             m_image_list_valid = false;
             // changing the box does not necessarily invalidate the AABB tree - however, practically
             // anything that changes the box (i.e. NPT, box_resize) is also moving the particles,
-            // so use it as a sign to rebuild the AABB tree
+            // so use it as a sign to update the AABB tree. Box trials scale the particles affinely, which the
+            // tree follows with a refit, so rejected trials in UpdaterBoxMC do not rebuild it
             m_aabb_tree_invalid = true;
+            m_overlap_candidates_valid = false;
             }
 
         //! callback so that the particle sort signal can invalidate the AABB tree
         virtual void slotSorted()
             {
             m_aabb_tree_invalid = true;
+            m_aabb_tree_rebuild = true;
+            m_overlap_candidates_valid = false;
             }
     };
 
+/*! Hard spheres of one diameter without orientation, that all overlap with each other and have no depletants or
+    pair energy, use the uniform sphere sweep.
+*/
+template <>
+inline bool IntegratorHPMCMono<ShapeSphere>::useUniformSphereCells()
+    {
+    if (m_patch && !m_patch_log)
+        return false;
+
+    for (unsigned int typ = 0; typ < m_pdata->getNTypes(); typ++)
+        {
+        if (m_params[typ].isOriented || m_params[typ].radius != m_params[0].radius || m_fugacity[typ] != 0.0)
+            return false;
+        }
+
+    ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
+    for (unsigned int i = 0; i < m_overlap_idx.getNumElements(); i++)
+        {
+        if (!h_overlaps.data[i])
+            return false;
+        }
+
+    return true;
+    }
+
 template <class Shape>
 IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition> sysdef,
                                                    unsigned int seed)
@@ -517,7 +630,8 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
               m_hasOrientation(true),
               m_extra_image_width(0.0),
               m_quermass(false),
-              m_sweep_radius(0.0)
+              m_sweep_radius(0.0),
+              m_sphere_diameter(0.0)
     {
     // allocate the parameter storage, setting the managed flag
     m_params = std::vector<param_type, managed_allocator<param_type> >(m_pdata->getNTypes(),
@@ -545,6 +659,9 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
     m_aabbs = NULL;
     m_aabbs_capacity = 0;
     m_aabb_tree_invalid = true;
+    m_aabb_tree_rebuild = true;
+    m_overlap_candidates_valid = false;
+    m_overlap_candidates_N = 0;
 
     GlobalArray<hpmc_implicit_counters_t> implicit_count(this->m_pdata->getNTypes(),this->m_exec_conf);
     m_implicit_count.swap(implicit_count);
@@ -560,6 +677,14 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
     m_implicit_count_step_start.resize(this->m_pdata->getNTypes());
 
     m_fugacity.resize(this->m_pdata->getNTypes(),0.0);
+
+    #ifdef ENABLE_TBB
+    std::vector<unsigned int> grain_sizes;
+    for (unsigned int grain_size = 1; grain_size <= 64; grain_size *= 2)
+        grain_sizes.push_back(grain_size);
+    m_tuner_checkerboard_grain.reset(new Autotuner(grain_sizes, 5, 100000, "hpmc_checkerboard_grain",
+        this->m_exec_conf));
+    #endif
     }
 
 /*! \param mode 0 -> Absolute count, 1 -> relative to the start of the run, 2 -> relative to the last executed step
@@ -593,7 +718,10 @@ std::vector<hpmc_implicit_counters_t> IntegratorHPMCMono<Shape>::getImplicitCoun
         {
         // MPI Reduction to total result values on all ranks
         for (unsigned int i = 0; i < this->m_pdata->getNTypes(); ++i)
+            {
             MPI_Allreduce(MPI_IN_PLACE, &result[i].insert_count, 1, MPI_LONG_LONG_INT, MPI_SUM, this->m_exec_conf->getMPICommunicator());
+            MPI_Allreduce(MPI_IN_PLACE, &result[i].insert_count_saved, 1, MPI_HOOMD_SCALAR, MPI_SUM, this->m_exec_conf->getMPICommunicator());
+            }
         }
     #endif
 
@@ -620,6 +748,7 @@ std::vector< std::string > IntegratorHPMCMono<Shape>::getProvidedLogQuantities()
       }
 
     result.push_back("hpmc_insert_count");
+    result.push_back("hpmc_insert_count_saved");
 
     return result;
     }
@@ -677,6 +806,19 @@ Scalar IntegratorHPMCMono<Shape>::getLogValue(const std::string& quantity, unsig
         else
             return Scalar(0.0);
         }
+    else if (quantity == "hpmc_insert_count_saved")
+        {
+        // reduce over all types
+        Scalar total_insert_count_saved = 0;
+        for (unsigned int i = 0; i < this->m_pdata->getNTypes(); ++i)
+            total_insert_count_saved += implicit_counters[i].insert_count_saved;
+
+        // return number of avoided depletant insertions per colloid
+        if (counters.getNMoves() > 0)
+            return total_insert_count_saved/(Scalar)counters.getNMoves();
+        else
+            return Scalar(0.0);
+        }
 
     //nothing found -> pass on to base class
     return IntegratorHPMC::getLogValue(quantity, timestep);
@@ -697,6 +839,7 @@ void IntegratorHPMCMono<Shape>::slotNumTypesChange()
     {
     // re-allocate the parameter storage, setting the managed flag on new members
     m_params.resize(m_pdata->getNTypes(), param_type());
+    m_overlap_candidates_valid = false;
 
     // skip the reallocation if the number of types does not change
     // this keeps old potential coefficients when restoring a snapshot
@@ -776,8 +919,12 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
     m_update_order.resize(m_pdata->getN());
     m_update_order.shuffle(timestep);
 
+    // sweep monodisperse spheres with a dense cell list instead of the AABB tree
+    bool uniform_spheres = !m_checkerboard && useUniformSphereCells() && initUniformSphereCells();
+
     // update the AABB Tree
-    buildAABBTree();
+    if (!uniform_spheres)
+        buildAABBTree();
     // limit m_d entries so that particles cannot possibly wander more than one box image in one time step
     limitMoveDistances();
     // update the image list
@@ -823,9 +970,32 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
     // access interaction matrix
     ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
 
+    // neighbors of the current trial move within the patch cutoff, evaluated in one call after the overlap check
+    PatchEnergyBatch patch_batch;
+
+    #ifdef ENABLE_TBB
+    // sweep the cells of a checkerboard in parallel when the moves can be independent
+    bool checkerboard = m_checkerboard && !has_depletants && initCheckerboard();
+    #endif
+
     // loop over local particles nselect times
     for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
         {
+        #ifdef ENABLE_TBB
+        if (checkerboard)
+            {
+            sweepCheckerboard(timestep, i_nselect, h_overlaps.data, counters);
+            m_checkerboard_sweeps++;
+            continue;
+            }
+        #endif
+
+        if (uniform_spheres)
+            {
+            sweepUniformSpheres(timestep, i_nselect, counters);
+            continue;
+            }
+
         // access particle data and system box
         ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
         ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
@@ -917,8 +1087,9 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
 
             // patch + field interaction deltaU
             double patch_field_energy_diff = 0;
+            patch_batch.clear();
 
-            // check for overlaps with neighboring particle's positions (also calculate the new energy)
+            // check for overlaps with neighboring particle's positions (also collect the new patch neighbors)
             // All image boxes (including the primary)
             const unsigned int n_images = (unsigned int)m_image_list.size();
             for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
@@ -982,18 +1153,13 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                                     overlap = true;
                                     break;
                                     }
-                                else if (m_patch && !m_patch_log && dot(r_ij,r_ij) <= rcut*rcut) // If there is no overlap and m_patch is not NULL, calculate energy
+                                else if (m_patch && !m_patch_log && dot(r_ij,r_ij) <= rcut*rcut) // If there is no overlap and m_patch is not NULL, collect the pair
                                     {
-                                    // deltaU = U_old - U_new: subtract energy of new configuration
-                                    patch_field_energy_diff -= m_patch->energy(r_ij, typ_i,
-                                                               quat<float>(shape_i.orientation),
-                                                               float(h_diameter.data[i]),
-                                                               float(h_charge.data[i]),
-                                                               typ_j,
-                                                               quat<float>(orientation_j),
-                                                               float(h_diameter.data[j]),
-                                                               float(h_charge.data[j])
-                                                               );
+                                    patch_batch.push_back(vec3<float>(r_ij),
+                                                          typ_j,
+                                                          quat<float>(orientation_j),
+                                                          float(h_diameter.data[j]),
+                                                          float(h_charge.data[j]));
                                     }
                                 }
                             }
@@ -1012,9 +1178,17 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                     break;
                 } // end loop over images
 
-            // calculate old patch energy only if m_patch not NULL and no overlaps
+            // calculate new and old patch energy only if m_patch not NULL and no overlaps
             if (m_patch && !m_patch_log && !overlap)
                 {
+                // deltaU = U_old - U_new: subtract energy of new configuration
+                patch_field_energy_diff -= m_patch->energyBatch(patch_batch,
+                                                                typ_i,
+                                                                quat<float>(shape_i.orientation),
+                                                                float(h_diameter.data[i]),
+                                                                float(h_charge.data[i]));
+                patch_batch.clear();
+
                 for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
                     {
                     vec3<Scalar> pos_i_image = pos_old + m_image_list[cur_image];
@@ -1065,17 +1239,12 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
 
                                     Scalar rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
 
-                                    // deltaU = U_old - U_new: add energy of old configuration
                                     if (dot(r_ij,r_ij) <= rcut*rcut)
-                                        patch_field_energy_diff += m_patch->energy(r_ij,
-                                                                   typ_i,
-                                                                   quat<float>(orientation_i),
-                                                                   float(h_diameter.data[i]),
-                                                                   float(h_charge.data[i]),
-                                                                   typ_j,
-                                                                   quat<float>(orientation_j),
-                                                                   float(h_diameter.data[j]),
-                                                                   float(h_charge.data[j]));
+                                        patch_batch.push_back(vec3<float>(r_ij),
+                                                              typ_j,
+                                                              quat<float>(orientation_j),
+                                                              float(h_diameter.data[j]),
+                                                              float(h_charge.data[j]));
                                     }
                                 }
                             }
@@ -1086,6 +1255,13 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                             }
                         }  // end loop over AABB nodes
                     } // end loop over images
+
+                // deltaU = U_old - U_new: add energy of old configuration
+                patch_field_energy_diff += m_patch->energyBatch(patch_batch,
+                                                                typ_i,
+                                                                quat<float>(orientation_i),
+                                                                float(h_diameter.data[i]),
+                                                                float(h_charge.data[i]));
                 } // end if (m_patch)
 
             // Add external energetic contribution
@@ -1194,21 +1370,638 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
     // all particle have been moved, the aabb tree is now invalid
     m_aabb_tree_invalid = true;
 
-    // set current MPS value
-    hpmc_counters_t run_counters = getCounters(1);
-    double cur_time = double(m_clock.getTime()) / Scalar(1e9);
-    m_mps = double(run_counters.getNMoves()) / cur_time;
+    // getMPS() reads the counters when it is called
+    m_mps_time = double(m_clock.getTime()) / Scalar(1e9);
+    }
+
+/*! The uniform sphere sweep replaces the AABB tree query with a dense cell list of the wrapped positions in structure
+    of arrays layout, and the overlap test with a branch free distance check over all particles in the 27 (9 in 2D)
+    neighboring cells. It makes the same trial moves with the same random numbers as the generic sweep, so it samples
+    the same Markov chain.
+
+    \returns true when the cell list was built and the sweep can be used on this time step
+*/
+template <class Shape>
+bool IntegratorHPMCMono<Shape>::initUniformSphereCells()
+    {
+    #ifdef ENABLE_MPI
+    // the ghost particles are not periodic images, keep the generic sweep
+    if (m_comm)
+        return false;
+    #endif
+
+    m_sphere_diameter = Shape(quat<Scalar>(), m_params[0]).getCircumsphereDiameter();
+    if (m_sphere_diameter <= Scalar(0.0))
+        return false;
+
+    // cells at least one diameter wide and no more than about one cell per particle
+    const unsigned int N = m_pdata->getN();
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+    Scalar n_max = std::max(Scalar(3.0), pow(Scalar(N), Scalar(1.0)/Scalar(ndim)));
+
+    Scalar3 npd = m_pdata->getBox().getNearestPlaneDistance();
+    Scalar d = m_sphere_diameter;
+    auto n_cells = [d, n_max](Scalar L)
+        {
+        return (unsigned int)std::min(floor(L / d), n_max);
+        };
+
+    uint3 dim = make_uint3(n_cells(npd.x), n_cells(npd.y), ndim == 3 ? n_cells(npd.z) : 1);
+
+    // with 3 cells along each direction, every pair within one diameter is found in exactly one image
+    if (dim.x < 3 || dim.y < 3 || (ndim == 3 && dim.z < 3))
+        return false;
+
+    m_sphere_cell_idx = Index3D(dim.x, dim.y, dim.z);
+
+    // count the particles in each cell to size the slots
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    m_sphere_cell.resize(N);
+    m_sphere_slot.resize(N);
+    m_sphere_cell_size.assign(m_sphere_cell_idx.getNumElements(), 0);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        vec3<Scalar> r(h_postype.data[i]);
+        uint3 c = getUniformSphereCell(r);
+        m_sphere_cell[i] = m_sphere_cell_idx(c.x, c.y, c.z);
+        m_sphere_cell_size[m_sphere_cell[i]]++;
+        }
+
+    // leave room for particles moving into a cell
+    unsigned int nmax = *std::max_element(m_sphere_cell_size.begin(), m_sphere_cell_size.end()) + 2;
+    m_sphere_cell_list_idx = Index2D(nmax, m_sphere_cell_idx.getNumElements());
+    m_sphere_cell_tag.resize(m_sphere_cell_list_idx.getNumElements());
+    m_sphere_cell_x.resize(m_sphere_cell_list_idx.getNumElements());
+    m_sphere_cell_y.resize(m_sphere_cell_list_idx.getNumElements());
+    m_sphere_cell_z.resize(m_sphere_cell_list_idx.getNumElements());
+
+    m_sphere_cell_size.assign(m_sphere_cell_idx.getNumElements(), 0);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        vec3<Scalar> r(h_postype.data[i]);
+        getUniformSphereCell(r);
+        insertUniformSphere(i, m_sphere_cell[i], r);
+        }
+
+    return true;
+    }
+
+/*! \param r Position, wrapped into the box on return
+    \returns Cell of the position
+*/
+template <class Shape>
+uint3 IntegratorHPMCMono<Shape>::getUniformSphereCell(vec3<Scalar>& r)
+    {
+    const BoxDim& box = m_pdata->getBox();
+    Scalar3 f = box.makeFraction(vec_to_scalar3(r));
+    f.x -= floor(f.x); f.y -= floor(f.y);
+    if (this->m_sysdef->getNDimensions() == 3)
+        f.z -= floor(f.z);
+    r = vec3<Scalar>(box.makeCoordinates(f));
+
+    const uint3 dim = make_uint3(m_sphere_cell_idx.getW(), m_sphere_cell_idx.getH(), m_sphere_cell_idx.getD());
+    return make_uint3(std::min((unsigned int)(f.x*dim.x), dim.x-1),
+                      std::min((unsigned int)(f.y*dim.y), dim.y-1),
+                      dim.z > 1 ? std::min((unsigned int)(f.z*dim.z), dim.z-1) : 0);
+    }
+
+/*! \param i Particle index
+    \param cell Cell to put the particle in
+    \param r Wrapped position of the particle
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::insertUniformSphere(unsigned int i, unsigned int cell, const vec3<Scalar>& r)
+    {
+    unsigned int nmax = m_sphere_cell_list_idx.getW();
+    if (m_sphere_cell_size[cell] == nmax)
+        {
+        // double the slots per cell and move the cells to the new layout
+        unsigned int n_cells = m_sphere_cell_idx.getNumElements();
+        Index2D new_idx(2*nmax, n_cells);
+        std::vector<unsigned int> tag(new_idx.getNumElements());
+        std::vector<Scalar> x(new_idx.getNumElements()), y(new_idx.getNumElements()), z(new_idx.getNumElements());
+        for (unsigned int c = 0; c < n_cells; c++)
+            for (unsigned int k = 0; k < m_sphere_cell_size[c]; k++)
+                {
+                tag[new_idx(k, c)] = m_sphere_cell_tag[m_sphere_cell_list_idx(k, c)];
+                x[new_idx(k, c)] = m_sphere_cell_x[m_sphere_cell_list_idx(k, c)];
+                y[new_idx(k, c)] = m_sphere_cell_y[m_sphere_cell_list_idx(k, c)];
+                z[new_idx(k, c)] = m_sphere_cell_z[m_sphere_cell_list_idx(k, c)];
+                }
+        m_sphere_cell_list_idx = new_idx;
+        m_sphere_cell_tag.swap(tag);
+        m_sphere_cell_x.swap(x);
+        m_sphere_cell_y.swap(y);
+        m_sphere_cell_z.swap(z);
+        }
+
+    unsigned int slot = m_sphere_cell_size[cell]++;
+    unsigned int idx = m_sphere_cell_list_idx(slot, cell);
+    m_sphere_cell_tag[idx] = i;
+    m_sphere_cell_x[idx] = r.x;
+    m_sphere_cell_y[idx] = r.y;
+    m_sphere_cell_z[idx] = r.z;
+    m_sphere_cell[i] = cell;
+    m_sphere_slot[i] = slot;
+    }
+
+/*! \param timestep Current time step
+    \param i_nselect Index of the sweep in this time step
+    \param counters Counters to add the moves of this sweep to
+
+    The neighboring cells across the periodic boundaries hold wrapped positions, so particle i is shifted by the
+    lattice vectors of the crossed boundaries instead of taking the minimum image of each pair.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::sweepUniformSpheres(unsigned int timestep, unsigned int i_nselect,
+    hpmc_counters_t& counters)
+    {
+    const BoxDim& box = m_pdata->getBox();
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+    const uint3 dim = make_uint3(m_sphere_cell_idx.getW(), m_sphere_cell_idx.getH(), m_sphere_cell_idx.getD());
+    const int stencil_z = ndim == 3 ? 1 : 0;
+    const vec3<Scalar> a1(box.getLatticeVector(0)), a2(box.getLatticeVector(1)), a3(box.getLatticeVector(2));
+    const OverlapReal d_sq = OverlapReal(m_sphere_diameter)*OverlapReal(m_sphere_diameter);
+
+    // access particle data
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+
+    //access move sizes
+    ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
+
+    for (unsigned int cur_particle = 0; cur_particle < m_pdata->getN(); cur_particle++)
+        {
+        unsigned int i = m_update_order[cur_particle];
+
+        // read in the current position and orientation
+        Scalar4 postype_i = h_postype.data[i];
+        Scalar4 orientation_i = h_orientation.data[i];
+        vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+
+        // make a trial move for i, drawing the same random numbers as the generic sweep
+        hoomd::RandomGenerator rng_i(hoomd::RNGIdentifier::HPMCMonoTrialMove, m_seed, i,
+            m_exec_conf->getRank()*m_nselect + i_nselect, timestep);
+        int typ_i = __scalar_as_int(postype_i.w);
+        Shape shape_i(quat<Scalar>(orientation_i), m_params[typ_i]);
+        hoomd::UniformIntDistribution(0xffff)(rng_i);
+
+        // skip if no overlap check is required
+        if (h_d.data[typ_i] == 0.0)
+            {
+            if (!shape_i.ignoreStatistics())
+                counters.translate_accept_count++;
+            continue;
+            }
+
+        vec3<Scalar> pos_old = pos_i;
+        move_translate(pos_i, rng_i, h_d.data[typ_i], ndim);
+
+        vec3<Scalar> r_i = pos_i;
+        uint3 c = getUniformSphereCell(r_i);
+
+        unsigned int overlap = 0;
+        for (int dz = -stencil_z; dz <= stencil_z && !overlap; dz++)
+            for (int dy = -1; dy <= 1 && !overlap; dy++)
+                for (int dx = -1; dx <= 1 && !overlap; dx++)
+            {
+            int nx = int(c.x) + dx, ny = int(c.y) + dy, nz = int(c.z) + dz;
+
+            // number of periodic boundaries crossed along each direction
+            int wx = (nx >= int(dim.x)) - (nx < 0);
+            int wy = (ny >= int(dim.y)) - (ny < 0);
+            int wz = (nz >= int(dim.z)) - (nz < 0);
+
+            // image of particle i next to the particles in the neighboring cell
+            vec3<Scalar> r_i_image = r_i - Scalar(wx)*a1 - Scalar(wy)*a2 - Scalar(wz)*a3;
+
+            unsigned int neigh_cell = m_sphere_cell_idx(nx - wx*int(dim.x), ny - wy*int(dim.y), nz - wz*int(dim.z));
+            unsigned int offset = m_sphere_cell_list_idx(0, neigh_cell);
+            unsigned int size = m_sphere_cell_size[neigh_cell];
+            const unsigned int *tag = m_sphere_cell_tag.data() + offset;
+            const Scalar *x = m_sphere_cell_x.data() + offset;
+            const Scalar *y = m_sphere_cell_y.data() + offset;
+            const Scalar *z = m_sphere_cell_z.data() + offset;
+
+            for (unsigned int k = 0; k < size; k++)
+                {
+                OverlapReal rx = OverlapReal(x[k] - r_i_image.x);
+                OverlapReal ry = OverlapReal(y[k] - r_i_image.y);
+                OverlapReal rz = OverlapReal(z[k] - r_i_image.z);
+                overlap |= (unsigned int)(rx*rx + ry*ry + rz*rz < d_sq) & (unsigned int)(tag[k] != i);
+                }
+            counters.overlap_checks += size;
+            }
+
+        // patch + field interaction deltaU
+        double patch_field_energy_diff = 0;
+        if (m_external)
+            {
+            Shape shape_old(quat<Scalar>(orientation_i), m_params[typ_i]);
+            patch_field_energy_diff -= m_external->energydiff(i, pos_old, shape_old, pos_i, shape_i);
+            }
+
+        bool accept = !overlap && hoomd::detail::generate_canonical<double>(rng_i) < slow::exp(patch_field_energy_diff);
+
+        if (accept)
+            {
+            if (!shape_i.ignoreStatistics())
+                counters.translate_accept_count++;
+
+            // update position of particle
+            h_postype.data[i] = make_scalar4(pos_i.x,pos_i.y,pos_i.z,postype_i.w);
+
+            // move the particle in the cell list
+            unsigned int new_cell = m_sphere_cell_idx(c.x, c.y, c.z);
+            unsigned int old_cell = m_sphere_cell[i];
+            if (new_cell == old_cell)
+                {
+                unsigned int idx = m_sphere_cell_list_idx(m_sphere_slot[i], old_cell);
+                m_sphere_cell_x[idx] = r_i.x;
+                m_sphere_cell_y[idx] = r_i.y;
+                m_sphere_cell_z[idx] = r_i.z;
+                }
+            else
+                {
+                // fill the slot with the last particle of the old cell
+                unsigned int idx = m_sphere_cell_list_idx(m_sphere_slot[i], old_cell);
+                unsigned int last = m_sphere_cell_list_idx(--m_sphere_cell_size[old_cell], old_cell);
+                unsigned int j = m_sphere_cell_tag[last];
+                m_sphere_cell_tag[idx] = j;
+                m_sphere_cell_x[idx] = m_sphere_cell_x[last];
+                m_sphere_cell_y[idx] = m_sphere_cell_y[last];
+                m_sphere_cell_z[idx] = m_sphere_cell_z[last];
+                m_sphere_slot[j] = m_sphere_slot[i];
+
+                insertUniformSphere(i, new_cell, r_i);
+                }
+            }
+        else
+            {
+            if (!shape_i.ignoreStatistics())
+                counters.translate_reject_count++;
+            }
+        }
+    }
+
+#ifdef ENABLE_TBB
+/*! \returns true when the checkerboard sweep can be used on this time step
+
+    The cells are at least as wide as the largest interaction range, so that particles in cells that do not touch
+    cannot interact. There is an even number of cells along each direction, so that the cells of one color never touch,
+    also across the periodic boundaries. The sweep needs 4 cells along each direction.
+*/
+template <class Shape>
+bool IntegratorHPMCMono<Shape>::initCheckerboard()
+    {
+    #ifdef ENABLE_MPI
+    // the active region already restricts the moves near the domain boundaries, keep the serial sweep
+    if (m_comm)
+        return false;
+    #endif
+
+    // external fields take array handles (and may call into python) when they evaluate energies, which is not
+    // safe from several threads at once
+    if (m_external)
+        return false;
+
+    Scalar range = getMaxCoreDiameter();
+    if (m_patch && !m_patch_log)
+        {
+        Scalar max_additive_cutoff(0.0);
+        for (unsigned int typ = 0; typ < this->m_pdata->getNTypes(); typ++)
+            max_additive_cutoff = std::max(max_additive_cutoff, (Scalar)m_patch->getAdditiveCutoff(typ));
+        range = std::max(range, (Scalar)m_patch->getRCut() + max_additive_cutoff);
+        }
+
+    if (range <= Scalar(0.0))
+        return false;
+
+    // we need no more than about one cell per particle
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+    Scalar n_max = std::max(Scalar(4.0), pow(Scalar(m_pdata->getN()), Scalar(1.0)/Scalar(ndim)));
+
+    Scalar3 npd = m_pdata->getBox().getNearestPlaneDistance();
+    auto n_cells = [range, n_max](Scalar L)
+        {
+        return (unsigned int)std::min(floor(L / range), n_max) & ~1u;
+        };
+
+    m_checkerboard_dim = make_uint3(n_cells(npd.x), n_cells(npd.y), ndim == 3 ? n_cells(npd.z) : 1);
+    return m_checkerboard_dim.x >= 4 && m_checkerboard_dim.y >= 4 && (ndim == 2 || m_checkerboard_dim.z >= 4);
     }
 
+/*! \param timestep Current time step
+    \param i_nselect Index of the sweep in this time step
+    \param h_overlaps Interaction matrix
+    \param counters Counters to add the moves of this sweep to
+
+    The sweep visits the 2^d colors of the checkerboard in a random order, and the cells of each color in parallel.
+    Within a cell, one thread makes the trial moves of its particles one at a time in the shuffled update order.
+    Moves that leave the cell are rejected, so that a particle only ever interacts with particles in the same cell,
+    which the same thread moves, and with particles in the neighboring cells, which are of a different color and do not
+    move. A random shift of the checkerboard in every sweep lets the particles cross the cell boundaries over many
+    sweeps.
+
+    The neighbors are taken from the cells, not from the AABB tree, because the tree cannot be updated concurrently.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::sweepCheckerboard(unsigned int timestep, unsigned int i_nselect,
+    const unsigned int *h_overlaps, hpmc_counters_t& counters)
+    {
+    const BoxDim& box = m_pdata->getBox();
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+    const uint3 dim = m_checkerboard_dim;
+    const Index3D cell_idx(dim.x, dim.y, dim.z);
+    const unsigned int N = m_pdata->getN();
+
+    // access particle data
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+
+    //access move sizes
+    ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::read);
+
+    // shift the checkerboard randomly
+    hoomd::RandomGenerator rng(hoomd::RNGIdentifier::HPMCMonoCheckerboard, m_seed, i_nselect, timestep);
+    hoomd::UniformDistribution<Scalar> uniform(Scalar(0.0), Scalar(1.0));
+    Scalar3 shift = make_scalar3(0,0,0);
+    shift.x = uniform(rng);
+    shift.y = uniform(rng);
+    if (ndim == 3)
+        shift.z = uniform(rng);
+
+    auto get_cell = [&box, &shift, &dim, ndim](const vec3<Scalar>& r)
+        {
+        Scalar3 f = box.makeFraction(vec_to_scalar3(r));
+        f.x += shift.x; f.y += shift.y; f.z += shift.z;
+        f.x -= floor(f.x); f.y -= floor(f.y); f.z -= floor(f.z);
+        return make_uint3(std::min((unsigned int)(f.x*dim.x), dim.x-1),
+                          std::min((unsigned int)(f.y*dim.y), dim.y-1),
+                          ndim == 3 ? std::min((unsigned int)(f.z*dim.z), dim.z-1) : 0);
+        };
+
+    // sort the particles into the cells, keeping the shuffled update order within each cell
+    m_checkerboard_cell.resize(N);
+    m_checkerboard_cell_start.assign(cell_idx.getNumElements()+1, 0);
+    m_checkerboard_cell_particles.resize(N);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        uint3 c = get_cell(vec3<Scalar>(h_postype.data[i]));
+        m_checkerboard_cell[i] = cell_idx(c.x, c.y, c.z);
+        m_checkerboard_cell_start[m_checkerboard_cell[i]+1]++;
+        }
+    std::partial_sum(m_checkerboard_cell_start.begin(), m_checkerboard_cell_start.end(),
+        m_checkerboard_cell_start.begin());
+
+    std::vector<unsigned int> cell_fill(m_checkerboard_cell_start.begin(), m_checkerboard_cell_start.end()-1);
+    for (unsigned int cur_particle = 0; cur_particle < N; cur_particle++)
+        {
+        unsigned int i = m_update_order[cur_particle];
+        m_checkerboard_cell_particles[cell_fill[m_checkerboard_cell[i]]++] = i;
+        }
+
+    // visit the colors in a random order
+    unsigned int n_colors = ndim == 3 ? 8 : 4;
+    std::vector<unsigned int> colors(n_colors);
+    std::iota(colors.begin(), colors.end(), 0);
+    for (unsigned int k = n_colors-1; k > 0; k--)
+        std::swap(colors[k], colors[hoomd::UniformIntDistribution(k)(rng)]);
+
+    const uint3 half = make_uint3(dim.x/2, dim.y/2, ndim == 3 ? dim.z/2 : 1);
+    const int stencil_z = ndim == 3 ? 1 : 0;
+
+    tbb::enumerable_thread_specific<hpmc_counters_t> thread_counters;
+
+    for (unsigned int color : colors)
+        {
+        const uint3 parity = make_uint3(color & 1, (color >> 1) & 1, (color >> 2) & 1);
+
+        // the grain size does not change the result, the moves of each particle use their own random numbers
+        m_tuner_checkerboard_grain->begin();
+        unsigned int grain_size = m_tuner_checkerboard_grain->getParam();
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, half.x*half.y*half.z, grain_size),
+            [&](const tbb::blocked_range<unsigned int>& r) {
+        hpmc_counters_t& thread_count = thread_counters.local();
+
+        for (unsigned int k = r.begin(); k != r.end(); ++k)
+            {
+            const uint3 c = make_uint3(2*(k % half.x) + parity.x,
+                                       2*((k / half.x) % half.y) + parity.y,
+                                       2*(k / (half.x*half.y)) + parity.z);
+            const unsigned int cur_cell = cell_idx(c.x, c.y, c.z);
+
+            for (unsigned int cur_particle = m_checkerboard_cell_start[cur_cell];
+                 cur_particle < m_checkerboard_cell_start[cur_cell+1]; cur_particle++)
+                {
+                unsigned int i = m_checkerboard_cell_particles[cur_particle];
+
+                // read in the current position and orientation
+                Scalar4 postype_i = h_postype.data[i];
+                Scalar4 orientation_i = h_orientation.data[i];
+                vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+
+                // make a trial move for i
+                hoomd::RandomGenerator rng_i(hoomd::RNGIdentifier::HPMCMonoTrialMove, m_seed, i,
+                    m_exec_conf->getRank()*m_nselect + i_nselect, timestep);
+                int typ_i = __scalar_as_int(postype_i.w);
+                Shape shape_i(quat<Scalar>(orientation_i), m_params[typ_i]);
+                unsigned int move_type_select = hoomd::UniformIntDistribution(0xffff)(rng_i);
+                bool move_type_translate = !shape_i.hasOrientation()
+                    || (move_type_select < m_translation_move_probability);
+
+                Shape shape_old(quat<Scalar>(orientation_i), m_params[typ_i]);
+                vec3<Scalar> pos_old = pos_i;
+
+                if (move_type_translate)
+                    {
+                    // skip if no overlap check is required
+                    if (h_d.data[typ_i] == 0.0)
+                        {
+                        if (!shape_i.ignoreStatistics())
+                            thread_count.translate_accept_count++;
+                        continue;
+                        }
+
+                    move_translate(pos_i, rng_i, h_d.data[typ_i], ndim);
+
+                    // reject moves out of the cell, they could overlap with particles moved by other threads
+                    uint3 c_new = get_cell(pos_i);
+                    if (c_new.x != c.x || c_new.y != c.y || c_new.z != c.z)
+                        {
+                        if (!shape_i.ignoreStatistics())
+                            thread_count.translate_reject_count++;
+                        continue;
+                        }
+                    }
+                else
+                    {
+                    if (h_a.data[typ_i] == 0.0)
+                        {
+                        if (!shape_i.ignoreStatistics())
+                            thread_count.rotate_accept_count++;
+                        continue;
+                        }
+
+                    if (ndim == 2)
+                        move_rotate<2>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+                    else
+                        move_rotate<3>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+                    }
+
+                bool overlap=false;
+                OverlapReal r_cut_patch = 0;
+
+                if (m_patch && !m_patch_log)
+                    {
+                    r_cut_patch = OverlapReal(m_patch->getRCut() + 0.5*m_patch->getAdditiveCutoff(typ_i));
+                    }
+
+                // patch + field interaction deltaU
+                double patch_field_energy_diff = 0;
+
+                // check for overlaps with the particles in this and the neighboring cells (also calculate the
+                // new and old energy)
+                for (int dz = -stencil_z; dz <= stencil_z && !overlap; dz++)
+                    for (int dy = -1; dy <= 1 && !overlap; dy++)
+                        for (int dx = -1; dx <= 1 && !overlap; dx++)
+                    {
+                    unsigned int neigh_cell = cell_idx((c.x + dim.x + dx) % dim.x,
+                                                       (c.y + dim.y + dy) % dim.y,
+                                                       (c.z + dim.z + dz) % dim.z);
+
+                    for (unsigned int cur_neigh = m_checkerboard_cell_start[neigh_cell];
+                         cur_neigh < m_checkerboard_cell_start[neigh_cell+1]; cur_neigh++)
+                        {
+                        unsigned int j = m_checkerboard_cell_particles[cur_neigh];
+                        if (j == i)
+                            continue;
+
+                        Scalar4 postype_j = h_postype.data[j];
+                        Scalar4 orientation_j = h_orientation.data[j];
+
+                        // put particles in coordinate system of particle i, the cells are much smaller than the box
+                        vec3<Scalar> r_ij = vec3<Scalar>(box.minImage(vec_to_scalar3(vec3<Scalar>(postype_j) - pos_i)));
+
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+
+                        thread_count.overlap_checks++;
+                        if (h_overlaps[m_overlap_idx(typ_i, typ_j)]
+                            && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                            && test_overlap(r_ij, shape_i, shape_j, thread_count.overlap_err_count))
+                            {
+                            overlap = true;
+                            break;
+                            }
+
+                        if (m_patch && !m_patch_log)
+                            {
+                            Scalar rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
+
+                            // deltaU = U_old - U_new: subtract energy of new configuration
+                            if (dot(r_ij,r_ij) <= rcut*rcut)
+                                patch_field_energy_diff -= m_patch->energy(r_ij, typ_i,
+                                                           quat<float>(shape_i.orientation),
+                                                           float(h_diameter.data[i]),
+                                                           float(h_charge.data[i]),
+                                                           typ_j,
+                                                           quat<float>(orientation_j),
+                                                           float(h_diameter.data[j]),
+                                                           float(h_charge.data[j]));
+
+                            // add energy of old configuration
+                            vec3<Scalar> r_ij_old = vec3<Scalar>(
+                                box.minImage(vec_to_scalar3(vec3<Scalar>(postype_j) - pos_old)));
+                            if (dot(r_ij_old,r_ij_old) <= rcut*rcut)
+                                patch_field_energy_diff += m_patch->energy(r_ij_old, typ_i,
+                                                           quat<float>(orientation_i),
+                                                           float(h_diameter.data[i]),
+                                                           float(h_charge.data[i]),
+                                                           typ_j,
+                                                           quat<float>(orientation_j),
+                                                           float(h_diameter.data[j]),
+                                                           float(h_charge.data[j]));
+                            }
+                        }
+                    } // end loop over neighboring cells
+
+                // Add external energetic contribution
+                if (m_external && !overlap)
+                    {
+                    patch_field_energy_diff -= m_external->energydiff(i, pos_old, shape_old, pos_i, shape_i);
+                    }
+
+                bool accept = !overlap
+                    && hoomd::detail::generate_canonical<double>(rng_i) < slow::exp(patch_field_energy_diff);
+
+                if (accept)
+                    {
+                    // increment accept counter and assign new position
+                    if (!shape_i.ignoreStatistics())
+                        {
+                        if (move_type_translate)
+                            thread_count.translate_accept_count++;
+                        else
+                            thread_count.rotate_accept_count++;
+                        }
+
+                    h_postype.data[i] = make_scalar4(pos_i.x,pos_i.y,pos_i.z,postype_i.w);
+
+                    if (shape_i.hasOrientation())
+                        {
+                        h_orientation.data[i] = quat_to_scalar4(shape_i.orientation);
+                        }
+                    }
+                else
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        {
+                        // increment reject counter
+                        if (move_type_translate)
+                            thread_count.translate_reject_count++;
+                        else
+                            thread_count.rotate_reject_count++;
+                        }
+                    }
+                } // end loop over particles in the cell
+            } // end loop over cells
+            });
+        m_tuner_checkerboard_grain->end();
+        } // end loop over colors
+
+    // reduce counters
+    for (auto i = thread_counters.begin(); i != thread_counters.end(); ++i)
+        {
+        counters = counters + *i;
+        }
+    }
+#endif
+
 /*! \param timestep current step
     \param early_exit exit at first overlap found if true
     \returns number of overlaps if early_exit=false, 1 if early_exit=true
+
+    With TBB, the particles are split over threads. When early_exit is set, the first thread to find an overlap
+    signals the others to stop, so rejected box trials in UpdaterBoxMC cost little more than the time to the first
+    overlap.
+
+    With incremental overlaps enabled, a count that checks every particle records the particles that overlap.
+    Accepted trial moves never create overlaps, so until something else changes the configuration (the box, the
+    particle order or number, the shape parameters or interaction matrix, or an updater that calls
+    invalidateAABBTree()), the following counts only need to check the recorded particles. Each count that finds
+    all overlaps replaces the record with the smaller set it found. This is not available with domain decomposition.
 */
 template <class Shape>
 unsigned int IntegratorHPMCMono<Shape>::countOverlaps(bool early_exit)
     {
     unsigned int overlap_count = 0;
+    #ifndef ENABLE_TBB
     unsigned int err_count = 0;
+    #endif
 
     // build an up to date AABB tree
     buildAABBTree();
@@ -1225,9 +2018,44 @@ unsigned int IntegratorHPMCMono<Shape>::countOverlaps(bool early_exit)
     // access parameters and interaction matrix
     ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
 
+    // record the overlapping particles for the next count
+    bool track = m_incremental_overlaps;
+    #ifdef ENABLE_MPI
+    if (m_comm)
+        track = false;
+    #endif
+
+    // check only the particles that overlapped before when no other change invalidated the record
+    bool use_candidates = track && m_overlap_candidates_valid && m_overlap_candidates_N == m_pdata->getN();
+    const unsigned int n_check = use_candidates ? (unsigned int)m_overlap_candidates.size() : m_pdata->getN();
+
+    #ifdef ENABLE_TBB
+    tbb::enumerable_thread_specific< std::vector<unsigned int> > thread_overlapping;
+    #else
+    std::vector<unsigned int> overlapping;
+    #endif
+
     // Loop over all particles
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    #ifdef ENABLE_TBB
+    // set when any thread finds an overlap, so that the others can stop early
+    std::atomic<bool> found(false);
+    overlap_count = tbb::parallel_reduce(tbb::blocked_range<unsigned int>(0, n_check),
+        0u,
+        [&](const tbb::blocked_range<unsigned int>& r, unsigned int overlap_count)->unsigned int {
+        unsigned int err_count = 0;
+        std::vector<unsigned int>& overlapping = thread_overlapping.local();
+        for (unsigned int k = r.begin(); k != r.end(); ++k)
+    #else
+    for (unsigned int k = 0; k < n_check; k++)
+    #endif
         {
+        #ifdef ENABLE_TBB
+        if (early_exit && found.load(std::memory_order_relaxed))
+            break;
+        #endif
+
+        unsigned int i = use_candidates ? m_overlap_candidates[k] : k;
+
         // read in the current position and orientation
         Scalar4 postype_i = h_postype.data[i];
         Scalar4 orientation_i = h_orientation.data[i];
@@ -1277,6 +2105,11 @@ unsigned int IntegratorHPMCMono<Shape>::countOverlaps(bool early_exit)
                                 && test_overlap(-r_ij, shape_j, shape_i, err_count))
                                 {
                                 overlap_count++;
+                                if (track)
+                                    {
+                                    overlapping.push_back(i);
+                                    overlapping.push_back(j);
+                                    }
                                 if (early_exit)
                                     {
                                     // exit early from loop over neighbor particles
@@ -1306,9 +2139,35 @@ unsigned int IntegratorHPMCMono<Shape>::countOverlaps(bool early_exit)
 
         if (overlap_count && early_exit)
             {
+            #ifdef ENABLE_TBB
+            found.store(true, std::memory_order_relaxed);
+            #endif
             break;
             }
         } // end loop over particles
+    #ifdef ENABLE_TBB
+    return overlap_count;
+    }, [](unsigned int x, unsigned int y)->unsigned int { return x+y; } );
+
+    if (early_exit && overlap_count > 1)
+        overlap_count = 1;
+    #endif
+
+    // an early exit may have missed overlaps, keep the previous record in that case
+    if (track && (!early_exit || overlap_count == 0))
+        {
+        #ifdef ENABLE_TBB
+        std::vector<unsigned int> overlapping;
+        for (const auto& v : thread_overlapping)
+            overlapping.insert(overlapping.end(), v.begin(), v.end());
+        #endif
+
+        std::sort(overlapping.begin(), overlapping.end());
+        overlapping.erase(std::unique(overlapping.begin(), overlapping.end()), overlapping.end());
+        m_overlap_candidates.swap(overlapping);
+        m_overlap_candidates_valid = true;
+        m_overlap_candidates_N = m_pdata->getN();
+        }
 
     if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
 
@@ -1545,6 +2404,8 @@ void IntegratorHPMCMono<Shape>::setParam(unsigned int typ,  const param_type& pa
         throw std::runtime_error("Error setting parameters in IntegratorHPMCMono");
         }
 
+    m_overlap_candidates_valid = false;
+
     // need to scope this because updateCellWidth will access it
         {
         // update the parameter for this type
@@ -1568,6 +2429,7 @@ void IntegratorHPMCMono<Shape>::setInteractionMatrix(std::pair<std::string, std:
     h_overlaps.data[m_overlap_idx(typj,typi)] = check_overlaps;
 
     m_image_list_valid = false;
+    m_overlap_candidates_valid = false;
     }
 
 template <class Shape>
@@ -1849,10 +2711,13 @@ void IntegratorHPMCMono<Shape>::growAABBList(unsigned int N)
 
     buildAABBTree() relies on the member variable m_aabb_tree_invalid to work correctly. Any time particles
     are moved (and not updated with m_aabb_tree->update()) or the particle list changes order, m_aabb_tree_invalid
-    needs to be set to true. Then buildAABBTree() will know to rebuild the tree from scratch on the next call. Typically
-    this is on the next timestep. But in some cases (i.e. NPT), the tree may need to be rebuilt several times in a
+    needs to be set to true. Then buildAABBTree() will know to update the tree on the next call. Typically
+    this is on the next timestep. But in some cases (i.e. NPT), the tree may need to be updated several times in a
     single step because of box volume moves.
 
+    When the number of particles is unchanged and the particles have not been sorted, the tree is refit in place
+    (see AABBTree::refit()), and rebuilt from scratch only when its cost has grown too much since the last build.
+
     Subclasses that override update() or other methods must be user to set m_aabb_tree_invalid appropriately, or
     erroneous simulations will result.
 
@@ -1890,7 +2755,21 @@ const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
                         m_aabbs[i] = detail::AABB(vec3<Scalar>(h_postype.data[i]), radius);
                         }
                     }
-                m_aabb_tree.buildTree(m_aabbs, n_aabb);
+
+                // refit the tree when it holds the same number of particles, rebuild when its quality degrades
+                bool rebuild = m_aabb_tree_rebuild || n_aabb != m_aabb_tree.getNumParticles();
+                if (!rebuild)
+                    {
+                    m_aabb_tree.refit(m_aabbs, n_aabb);
+                    rebuild = m_aabb_tree.needsRebuild();
+                    }
+
+                if (rebuild)
+                    {
+                    m_exec_conf->msg->notice(8) << "Rebuilding AABB tree" << std::endl;
+                    m_aabb_tree.buildTree(m_aabbs, n_aabb);
+                    m_aabb_tree_rebuild = false;
+                    }
                 }
             }
 
@@ -2470,8 +3349,8 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
                 } // end loop over images
 
             // now, we have a list of intersecting spheres, sample in the union of intersection volumes
-            // we sample from their union by checking if any generated position falls in the intersection
-            // of their AABBs, only accepting it if it was generated from neighbor j_min
+            // we sample from their union by checking if any generated position falls in the sampling
+            // region of another pair, only accepting it if it was generated from neighbor j_min
 
             // world AABB of particle i
             detail::AABB aabb_i_old = aabb_i_local_old;
@@ -2484,23 +3363,16 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
             lower_i.x -= range; lower_i.y -= range; lower_i.z -= range;
             upper_i.x += range; upper_i.y += range; upper_i.z += range;
 
-            // for every pairwise intersection
-            #ifdef ENABLE_TBB
-            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, (unsigned int)intersect_i.size()),
-                [=, &intersect_i, &image_i, &aabbs_i,
-                    &accept, &rng_depletants_parallel,
-                    &thread_counters, &thread_implicit_counters](const tbb::blocked_range<unsigned int>& s) {
-            for (unsigned int k = s.begin(); k != s.end(); ++k)
-            #else
+            // sample in the intersection of the AABBs, clipped to a box around the lens where the circumspheres of
+            // the excluded volumes of i and j intersect. Depletants outside of the lens cannot overlap both particles.
+            std::vector<detail::AABB> regions_i(intersect_i.size());
+            std::vector<Scalar> volumes_i(intersect_i.size(), Scalar(0.0));
+            Scalar R_i = Scalar(0.5)*shape_old.getCircumsphereDiameter() + range;
             for (unsigned int k = 0; k < intersect_i.size(); ++k)
-            #endif
                 {
-                // world AABB of shape j, in image of i
-                detail::AABB aabb_j = aabbs_i[k];
-
                 // extend AABB j by sweep radius
-                vec3<Scalar> lower_j = aabb_j.getLower();
-                vec3<Scalar> upper_j = aabb_j.getUpper();
+                vec3<Scalar> lower_j = aabbs_i[k].getLower();
+                vec3<Scalar> upper_j = aabbs_i[k].getUpper();
                 lower_j.x -= range; lower_j.y -= range; lower_j.z -= range;
                 upper_j.x += range; upper_j.y += range; upper_j.z += range;
 
@@ -2513,15 +3385,66 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
                 intersect_upper.y = std::min(upper_i.y, upper_j.y);
                 intersect_upper.z = std::min(upper_i.z, upper_j.z);
 
-                detail::AABB aabb_intersect(intersect_lower, intersect_upper);
-
                 // intersection AABB volume
-                Scalar V =  (intersect_upper.x-intersect_lower.x)*(intersect_upper.y-intersect_lower.y);
+                Scalar V_aabb = (intersect_upper.x-intersect_lower.x)*(intersect_upper.y-intersect_lower.y);
                 if(ndim == 3)
-                    V *= intersect_upper.z-intersect_lower.z;
+                    V_aabb *= intersect_upper.z-intersect_lower.z;
+
+                unsigned int j = intersect_i[k];
+                Scalar4 postype_j = h_postype[j];
+                Shape shape_j(quat<Scalar>(), this->m_params[__scalar_as_int(postype_j.w)]);
+                Scalar R_j = Scalar(0.5)*shape_j.getCircumsphereDiameter() + range;
+                vec3<Scalar> pos_j = vec3<Scalar>(postype_j) - this->m_image_list[image_i[k]];
+
+                detail::AABB aabb_lens;
+                Scalar V = Scalar(0.0);
+                if (sphereIntersectionAABB(pos_i_old, R_i, pos_j, R_j, aabb_lens))
+                    {
+                    vec3<Scalar> lower_lens = aabb_lens.getLower();
+                    vec3<Scalar> upper_lens = aabb_lens.getUpper();
+                    intersect_lower.x = std::max(intersect_lower.x, lower_lens.x);
+                    intersect_lower.y = std::max(intersect_lower.y, lower_lens.y);
+                    intersect_lower.z = std::max(intersect_lower.z, lower_lens.z);
+                    intersect_upper.x = std::min(intersect_upper.x, upper_lens.x);
+                    intersect_upper.y = std::min(intersect_upper.y, upper_lens.y);
+                    intersect_upper.z = std::min(intersect_upper.z, upper_lens.z);
+
+                    if (intersect_upper.x > intersect_lower.x && intersect_upper.y > intersect_lower.y
+                        && (ndim == 2 || intersect_upper.z > intersect_lower.z))
+                        {
+                        V = (intersect_upper.x-intersect_lower.x)*(intersect_upper.y-intersect_lower.y);
+                        if(ndim == 3)
+                            V *= intersect_upper.z-intersect_lower.z;
+                        }
+                    }
+
+                regions_i[k] = detail::AABB(intersect_lower, intersect_upper);
+                volumes_i[k] = V;
+
+                #ifdef ENABLE_TBB
+                thread_implicit_counters[type].local().insert_count_saved += m_fugacity[type]*(V_aabb - V);
+                #else
+                implicit_counters[type].insert_count_saved += m_fugacity[type]*(V_aabb - V);
+                #endif
+                }
+
+            // for every pairwise intersection
+            #ifdef ENABLE_TBB
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, (unsigned int)intersect_i.size()),
+                [=, &intersect_i, &image_i, &aabbs_i, &regions_i, &volumes_i,
+                    &accept, &rng_depletants_parallel,
+                    &thread_counters, &thread_implicit_counters](const tbb::blocked_range<unsigned int>& s) {
+            for (unsigned int k = s.begin(); k != s.end(); ++k)
+            #else
+            for (unsigned int k = 0; k < intersect_i.size(); ++k)
+            #endif
+                {
+                // no depletant in the lens can overlap both particles
+                if (volumes_i[k] == Scalar(0.0))
+                    continue;
 
                 // chooose the number of depletants in the intersection volume
-                hoomd::PoissonDistribution<Scalar> poisson(m_fugacity[type]*V);
+                hoomd::PoissonDistribution<Scalar> poisson(m_fugacity[type]*volumes_i[k]);
                 #ifdef ENABLE_TBB
                 hoomd::RandomGenerator& my_rng = rng_depletants_parallel.local();
                 #else
@@ -2533,7 +3456,7 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
                 // for every depletant
                 #ifdef ENABLE_TBB
                 tbb::parallel_for(tbb::blocked_range<unsigned int>(0, (unsigned int)n),
-                    [=, &intersect_i, &image_i, &aabbs_i,
+                    [=, &intersect_i, &image_i, &aabbs_i, &regions_i, &volumes_i,
                         &accept, &rng_depletants_parallel,
                         &thread_counters, &thread_implicit_counters](const tbb::blocked_range<unsigned int>& t) {
                 for (unsigned int l = t.begin(); l != t.end(); ++l)
@@ -2553,27 +3476,19 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
                     implicit_counters[type].insert_count++;
                     #endif
 
-                    vec3<Scalar> pos_test = generatePositionInAABB(my_rng, aabb_intersect, ndim);
+                    vec3<Scalar> pos_test = generatePositionInAABB(my_rng, regions_i[k], ndim);
                     Shape shape_test(quat<Scalar>(), this->m_params[type]);
                     if (shape_test.hasOrientation())
                         {
                         shape_test.orientation = generateRandomOrientation(my_rng, ndim);
                         }
 
-                    // check if depletant falls in other intersection volumes
-
-                    // load the depletant's AABB and extend it
-                    detail::AABB aabb_test = shape_test.getAABB(pos_test);
-                    vec3<Scalar> lower_test = aabb_test.getLower();
-                    vec3<Scalar> upper_test = aabb_test.getUpper();
-                    lower_test.x -= m_sweep_radius; lower_test.y -= m_sweep_radius; lower_test.z -= m_sweep_radius;
-                    upper_test.x += m_sweep_radius; upper_test.y += m_sweep_radius; upper_test.z += m_sweep_radius;
-                    aabb_test = detail::AABB(lower_test, upper_test);
-
+                    // check if depletant falls in the sampling region of a preceding intersection, every region
+                    // contains its lens, so each position in the union is sampled exactly once
                     bool active = true;
                     for (unsigned int m = 0; m < k; ++m)
                         {
-                        if (detail::overlap(aabb_test,aabbs_i[m]))
+                        if (volumes_i[m] > Scalar(0.0) && isPositionInAABB(regions_i[m], pos_test, ndim))
                             {
                             active = false;
                             break;
@@ -2808,6 +3723,7 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
                                     else
                                         {
                                         typ_j = typ_i;
+                                        pos_j = pos_i;
                                         }
                                     }
                                 else
@@ -2878,8 +3794,8 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
 
 
             // now, we have a list of intersecting spheres, sample in the union of intersection volumes
-            // we sample from their union by checking if any generated position falls in the intersection
-            // of their AABBs and if so, only accepting it if it was generated from neighbor j_min
+            // we sample from their union by checking if any generated position falls in the sampling
+            // region of another pair and if so, only accepting it if it was generated from neighbor j_min
 
             // world AABB of particle i
             detail::AABB aabb_i = aabb_i_local;
@@ -2892,23 +3808,16 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
             lower_i.x -= range; lower_i.y -= range; lower_i.z -= range;
             upper_i.x += range; upper_i.y += range; upper_i.z += range;
 
-            // for every pairwise intersection
-            #ifdef ENABLE_TBB
-            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, (unsigned int)intersect_i.size()),
-                [=, &intersect_i, &image_i, &aabbs_i,
-                    &accept, &rng_depletants_parallel,
-                    &thread_counters, &thread_implicit_counters](const tbb::blocked_range<unsigned int>& s) {
-            for (unsigned int k = s.begin(); k != s.end(); ++k)
-            #else
+            // sample in the intersection of the AABBs, clipped to a box around the lens where the circumspheres of
+            // the excluded volumes of i and j intersect. Depletants outside of the lens cannot overlap both particles.
+            std::vector<detail::AABB> regions_i(intersect_i.size());
+            std::vector<Scalar> volumes_i(intersect_i.size(), Scalar(0.0));
+            Scalar R_i = Scalar(0.5)*shape_i.getCircumsphereDiameter() + range;
             for (unsigned int k = 0; k < intersect_i.size(); ++k)
-            #endif
                 {
-                // world AABB of shape j, in image of i
-                detail::AABB aabb_j = aabbs_i[k];
-
                 // extend AABB j by sweep radius
-                vec3<Scalar> lower_j = aabb_j.getLower();
-                vec3<Scalar> upper_j = aabb_j.getUpper();
+                vec3<Scalar> lower_j = aabbs_i[k].getLower();
+                vec3<Scalar> upper_j = aabbs_i[k].getUpper();
                 lower_j.x -= range; lower_j.y -= range; lower_j.z -= range;
                 upper_j.x += range; upper_j.y += range; upper_j.z += range;
 
@@ -2921,15 +3830,66 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
                 intersect_upper.y = std::min(upper_i.y, upper_j.y);
                 intersect_upper.z = std::min(upper_i.z, upper_j.z);
 
-                detail::AABB aabb_intersect(intersect_lower, intersect_upper);
-
                 // intersection AABB volume
-                Scalar V =  (intersect_upper.x-intersect_lower.x)*(intersect_upper.y-intersect_lower.y);
+                Scalar V_aabb = (intersect_upper.x-intersect_lower.x)*(intersect_upper.y-intersect_lower.y);
                 if(ndim == 3)
-                    V *= intersect_upper.z-intersect_lower.z;
+                    V_aabb *= intersect_upper.z-intersect_lower.z;
+
+                unsigned int j = intersect_i[k];
+                Scalar4 postype_j = h_postype[j];
+                Shape shape_j(quat<Scalar>(), this->m_params[__scalar_as_int(postype_j.w)]);
+                Scalar R_j = Scalar(0.5)*shape_j.getCircumsphereDiameter() + range;
+                vec3<Scalar> pos_j = ((i == j) ? pos_i : vec3<Scalar>(postype_j)) - this->m_image_list[image_i[k]];
+
+                detail::AABB aabb_lens;
+                Scalar V = Scalar(0.0);
+                if (sphereIntersectionAABB(pos_i, R_i, pos_j, R_j, aabb_lens))
+                    {
+                    vec3<Scalar> lower_lens = aabb_lens.getLower();
+                    vec3<Scalar> upper_lens = aabb_lens.getUpper();
+                    intersect_lower.x = std::max(intersect_lower.x, lower_lens.x);
+                    intersect_lower.y = std::max(intersect_lower.y, lower_lens.y);
+                    intersect_lower.z = std::max(intersect_lower.z, lower_lens.z);
+                    intersect_upper.x = std::min(intersect_upper.x, upper_lens.x);
+                    intersect_upper.y = std::min(intersect_upper.y, upper_lens.y);
+                    intersect_upper.z = std::min(intersect_upper.z, upper_lens.z);
+
+                    if (intersect_upper.x > intersect_lower.x && intersect_upper.y > intersect_lower.y
+                        && (ndim == 2 || intersect_upper.z > intersect_lower.z))
+                        {
+                        V = (intersect_upper.x-intersect_lower.x)*(intersect_upper.y-intersect_lower.y);
+                        if(ndim == 3)
+                            V *= intersect_upper.z-intersect_lower.z;
+                        }
+                    }
+
+                regions_i[k] = detail::AABB(intersect_lower, intersect_upper);
+                volumes_i[k] = V;
+
+                #ifdef ENABLE_TBB
+                thread_implicit_counters[type].local().insert_count_saved += -m_fugacity[type]*(V_aabb - V);
+                #else
+                implicit_counters[type].insert_count_saved += -m_fugacity[type]*(V_aabb - V);
+                #endif
+                }
+
+            // for every pairwise intersection
+            #ifdef ENABLE_TBB
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, (unsigned int)intersect_i.size()),
+                [=, &intersect_i, &image_i, &aabbs_i, &regions_i, &volumes_i,
+                    &accept, &rng_depletants_parallel,
+                    &thread_counters, &thread_implicit_counters](const tbb::blocked_range<unsigned int>& s) {
+            for (unsigned int k = s.begin(); k != s.end(); ++k)
+            #else
+            for (unsigned int k = 0; k < intersect_i.size(); ++k)
+            #endif
+                {
+                // no depletant in the lens can overlap both particles
+                if (volumes_i[k] == Scalar(0.0))
+                    continue;
 
                 // chooose the number of depletants in the intersection volume
-                hoomd::PoissonDistribution<Scalar> poisson(-m_fugacity[type]*V);
+                hoomd::PoissonDistribution<Scalar> poisson(-m_fugacity[type]*volumes_i[k]);
                 #ifdef ENABLE_TBB
                 hoomd::RandomGenerator& my_rng = rng_depletants_parallel.local();
                 #else
@@ -2941,7 +3901,7 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
                 // for every depletant
                 #ifdef ENABLE_TBB
                 tbb::parallel_for(tbb::blocked_range<unsigned int>(0, (unsigned int)n),
-                    [=, &intersect_i, &image_i, &aabbs_i,
+                    [=, &intersect_i, &image_i, &aabbs_i, &regions_i, &volumes_i,
                         &accept, &rng_depletants_parallel,
                         &thread_counters, &thread_implicit_counters](const tbb::blocked_range<unsigned int>& t) {
                 for (unsigned int l = t.begin(); l != t.end(); ++l)
@@ -2961,29 +3921,19 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
                     implicit_counters[type].insert_count++;
                     #endif
 
-                    vec3<Scalar> pos_test = generatePositionInAABB(my_rng, aabb_intersect, ndim);
+                    vec3<Scalar> pos_test = generatePositionInAABB(my_rng, regions_i[k], ndim);
                     Shape shape_test(quat<Scalar>(), this->m_params[type]);
                     if (shape_test.hasOrientation())
                         {
                         shape_test.orientation = generateRandomOrientation(my_rng, ndim);
                         }
 
-                    // check if depletant falls in other intersection volumes (new)
+                    // check if depletant falls in the sampling region of a preceding intersection, every region
+                    // contains its lens, so each position in the union is sampled exactly once
                     bool active = true;
-
-                    // check against any other AABB preceding this
-
-                    // load the depletant's AABB and extend it
-                    detail::AABB aabb_test = shape_test.getAABB(pos_test);
-                    vec3<Scalar> lower_test = aabb_test.getLower();
-                    vec3<Scalar> upper_test = aabb_test.getUpper();
-                    lower_test.x -= m_sweep_radius; lower_test.y -= m_sweep_radius; lower_test.z -= m_sweep_radius;
-                    upper_test.x += m_sweep_radius; upper_test.y += m_sweep_radius; upper_test.z += m_sweep_radius;
-                    aabb_test = detail::AABB(lower_test, upper_test);
-
                     for (unsigned int m = 0; m < k; ++m)
                         {
-                        if (detail::overlap(aabb_test,aabbs_i[m]))
+                        if (volumes_i[m] > Scalar(0.0) && isPositionInAABB(regions_i[m], pos_test, ndim))
                             {
                             active = false;
                             break;
@@ -3258,6 +4208,7 @@ inline void export_hpmc_implicit_counters(pybind11::module& m)
     {
     pybind11::class_< hpmc_implicit_counters_t >(m, "hpmc_implicit_counters_t")
     .def_readwrite("insert_count", &hpmc_implicit_counters_t::insert_count)
+    .def_readwrite("insert_count_saved", &hpmc_implicit_counters_t::insert_count_saved)
     ;
     }
 
@@ -110,6 +110,26 @@ __global__ void hpmc_shift(Scalar4 *d_postype,
     d_image[my_pidx] = image;
     }
 
+//! Kernel to scale the particle positions from one box to another
+__global__ void hpmc_scale_box(Scalar4 *d_postype,
+                               const unsigned int N,
+                               const BoxDim old_box,
+                               const BoxDim new_box)
+    {
+    unsigned int my_pidx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (my_pidx >= N)
+        return;
+
+    Scalar4 postype = d_postype[my_pidx];
+
+    // obtain scaled coordinates in the old global box and map them into the new one
+    Scalar3 f = old_box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+    Scalar3 pos = new_box.makeCoordinates(f);
+
+    d_postype[my_pidx] = make_scalar4(pos.x, pos.y, pos.z, postype.w);
+    }
+
 //!< Kernel to accept/reject
 __global__ void hpmc_accept(const unsigned int *d_update_order_by_ptl,
                  const unsigned int *d_trial_move_type,
@@ -131,6 +151,7 @@ __global__ void hpmc_accept(const unsigned int *d_update_order_by_ptl,
                  const float *d_energy_old,
                  const float *d_energy_new,
                  const unsigned int maxn_patch,
+                 const float *d_energy_external,
                  unsigned int *d_condition,
                  const unsigned int seed,
                  const unsigned int select,
@@ -279,9 +300,15 @@ __global__ void hpmc_accept(const unsigned int *d_update_order_by_ptl,
         {
         float delta_U = s_energy_new[group] - s_energy_old[group];
 
+        // the external field contributes independently of the update order
+        bool energy = patch || d_energy_external;
+        if (d_energy_external)
+            delta_U += d_energy_external[i];
+
         // Metropolis-Hastings
         hoomd::RandomGenerator rng_i(hoomd::RNGIdentifier::HPMCMonoAccept, seed, i, select, timestep);
-        bool accept = !s_reject[group] && (!patch || (hoomd::detail::generate_canonical<double>(rng_i) < slow::exp(-delta_U)));
+        bool accept = !s_reject[group]
+            && (!energy || (hoomd::detail::generate_canonical<double>(rng_i) < slow::exp(-delta_U)));
 
         if ((accept && d_reject[i]) || (!accept && !d_reject[i]))
             {
@@ -294,6 +321,86 @@ __global__ void hpmc_accept(const unsigned int *d_update_order_by_ptl,
         }
     }
 
+//! Kernel to scale the move sizes towards a target acceptance ratio
+/*! \param d_d Translation move sizes by type (in/out)
+    \param d_a Rotation move sizes by type (in/out)
+    \param d_d_max Largest translation move size by type, 0 for types that are not tuned
+    \param d_a_max Largest rotation move size by type, 0 for types that are not tuned
+    \param d_counters Current acceptance counters
+    \param d_count_last Counters at the previous call (in/out)
+    \param ntypes Number of particle types
+    \param params Controller parameters
+
+    Launched with a single block. Each thread handles a strided subset of the types.
+*/
+__global__ void hpmc_tune_move_sizes(Scalar *d_d,
+                                     Scalar *d_a,
+                                     const Scalar *d_d_max,
+                                     const Scalar *d_a_max,
+                                     const hpmc_counters_t *d_counters,
+                                     hpmc_counters_t *d_count_last,
+                                     const unsigned int ntypes,
+                                     const hpmc_move_size_tuner_params_t params)
+    {
+    hpmc_counters_t counters = *d_counters;
+    hpmc_counters_t delta = counters - *d_count_last;
+
+    Scalar scale_d = move_size_scale(delta.translate_accept_count, delta.translate_reject_count, params);
+    Scalar scale_a = move_size_scale(delta.rotate_accept_count, delta.rotate_reject_count, params);
+
+    for (unsigned int typ = threadIdx.x; typ < ntypes; typ += blockDim.x)
+        {
+        if (params.tune_d && d_d_max[typ] > Scalar(0.0))
+            d_d[typ] = fmax(fmin(d_d[typ]*scale_d, d_d_max[typ]), params.min_move);
+        if (params.tune_a && d_a_max[typ] > Scalar(0.0))
+            d_a[typ] = fmax(fmin(d_a[typ]*scale_a, d_a_max[typ]), params.min_move);
+        }
+
+    // all threads have read the previous counters
+    __syncthreads();
+
+    if (threadIdx.x == 0)
+        *d_count_last = counters;
+    }
+
+//! Kernel to add the per-device counters to the totals
+/*! \param ngpu Number of GPUs
+    \param pitch Pitch of the per-device counters
+    \param d_per_device Per-device counters
+    \param d_total Total counters (in/out)
+    \param implicit_pitch Pitch of the per-device depletant counters
+    \param d_implicit_per_device Per-device depletant counters, by type
+    \param d_implicit_total Total depletant counters by type (in/out)
+    \param ntypes Number of particle types
+
+    Launched with a single block, so the counters stay on the device between sweeps.
+*/
+__global__ void hpmc_reduce_counters(const unsigned int ngpu,
+                                     const unsigned int pitch,
+                                     const hpmc_counters_t *d_per_device,
+                                     hpmc_counters_t *d_total,
+                                     const unsigned int implicit_pitch,
+                                     const hpmc_implicit_counters_t *d_implicit_per_device,
+                                     hpmc_implicit_counters_t *d_implicit_total,
+                                     const unsigned int ntypes)
+    {
+    if (threadIdx.x == 0)
+        {
+        hpmc_counters_t total = *d_total;
+        for (unsigned int idev = 0; idev < ngpu; ++idev)
+            total = total + d_per_device[idev*pitch];
+        *d_total = total;
+        }
+
+    for (unsigned int typ = threadIdx.x; typ < ntypes; typ += blockDim.x)
+        {
+        hpmc_implicit_counters_t total = d_implicit_total[typ];
+        for (unsigned int idev = 0; idev < ngpu; ++idev)
+            total = total + d_implicit_per_device[typ + idev*implicit_pitch];
+        d_implicit_total[typ] = total;
+        }
+    }
+
 } // end namespace kernel
 
 //! Driver for kernel::hpmc_excell()
@@ -367,6 +474,70 @@ void hpmc_shift(Scalar4 *d_postype,
     hipDeviceSynchronize();
     }
 
+//! Kernel driver for kernel::hpmc_scale_box()
+void hpmc_scale_box(Scalar4 *d_postype,
+                    const unsigned int N,
+                    const BoxDim& old_box,
+                    const BoxDim& new_box,
+                    const unsigned int block_size)
+    {
+    assert(d_postype);
+
+    dim3 threads(block_size, 1, 1);
+    dim3 grid(N / block_size + 1, 1, 1);
+
+    hipLaunchKernelGGL(kernel::hpmc_scale_box, dim3(grid), dim3(threads), 0, 0, d_postype,
+                                                      N,
+                                                      old_box,
+                                                      new_box);
+    }
+
+
+//! Kernel driver for kernel::hpmc_tune_move_sizes()
+void hpmc_tune_move_sizes(Scalar *d_d,
+                          Scalar *d_a,
+                          const Scalar *d_d_max,
+                          const Scalar *d_a_max,
+                          const hpmc_counters_t *d_counters,
+                          hpmc_counters_t *d_count_last,
+                          const unsigned int ntypes,
+                          const hpmc_move_size_tuner_params_t& params)
+    {
+    assert(d_d);
+    assert(d_a);
+
+    hipLaunchKernelGGL(kernel::hpmc_tune_move_sizes, dim3(1), dim3(32), 0, 0, d_d,
+                                                      d_a,
+                                                      d_d_max,
+                                                      d_a_max,
+                                                      d_counters,
+                                                      d_count_last,
+                                                      ntypes,
+                                                      params);
+    }
+
+//! Kernel driver for kernel::hpmc_reduce_counters()
+void hpmc_reduce_counters(const unsigned int ngpu,
+                          const unsigned int pitch,
+                          const hpmc_counters_t *d_per_device,
+                          hpmc_counters_t *d_total,
+                          const unsigned int implicit_pitch,
+                          const hpmc_implicit_counters_t *d_implicit_per_device,
+                          hpmc_implicit_counters_t *d_implicit_total,
+                          const unsigned int ntypes)
+    {
+    assert(d_per_device);
+    assert(d_total);
+
+    hipLaunchKernelGGL(kernel::hpmc_reduce_counters, dim3(1), dim3(32), 0, 0, ngpu,
+                                                      pitch,
+                                                      d_per_device,
+                                                      d_total,
+                                                      implicit_pitch,
+                                                      d_implicit_per_device,
+                                                      d_implicit_total,
+                                                      ntypes);
+    }
 
 void hpmc_accept(const unsigned int *d_update_order_by_ptl,
                  const unsigned int *d_trial_move_type,
@@ -387,6 +558,7 @@ void hpmc_accept(const unsigned int *d_update_order_by_ptl,
                  const float *d_energy_old,
                  const float *d_energy_new,
                  const unsigned int maxn_patch,
+                 const float *d_energy_external,
                  unsigned int *d_condition,
                  const unsigned int seed,
                  const unsigned int select,
@@ -444,6 +616,7 @@ void hpmc_accept(const unsigned int *d_update_order_by_ptl,
             d_energy_old,
             d_energy_new,
             maxn_patch,
+            d_energy_external,
             d_condition,
             seed,
             select,
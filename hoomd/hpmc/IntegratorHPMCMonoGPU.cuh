@@ -15,6 +15,7 @@
 #include "hoomd/CachedAllocator.h"
 
 #include "hoomd/hpmc/HPMCCounters.h"
+#include "hoomd/hpmc/WallData.h"
 #include "hoomd/jit/Evaluator.cuh"
 
 #include "GPUHelpers.cuh"
@@ -150,6 +151,7 @@ struct hpmc_args_t
     const bool update_shape_param;    //!< True if shape parameters have changed
     const hipDeviceProp_t& devprop;     //!< CUDA device properties
     const GPUPartition& gpu_partition; //!< Multi-GPU partition
+    hpmc_walls_t walls;               //!< Walls that reject trial moves, empty by default
     };
 
 //! Wraps arguments to kernel::hpmc_insert_depletants
@@ -222,6 +224,59 @@ struct hpmc_update_args_t
     const unsigned int block_size;
     };
 
+//! Wraps arguments for hpmc_count_overlaps
+struct hpmc_count_overlaps_args_t
+    {
+    //! Construct an hpmc_count_overlaps_args_t
+    hpmc_count_overlaps_args_t(const Scalar4 *_d_postype,
+        const Scalar4 *_d_orientation,
+        const unsigned int *_d_tag,
+        const unsigned int *_d_excell_idx,
+        const unsigned int *_d_excell_size,
+        const Index2D& _excli,
+        const BoxDim& _box,
+        const Scalar3 _ghost_width,
+        const uint3& _cell_dim,
+        const Index3D& _ci,
+        const unsigned int *_d_check_overlaps,
+        const Index2D& _overlap_idx,
+        unsigned int *_d_overlap_count,
+        const GPUPartition& _gpu_partition,
+        const unsigned int _block_size)
+        : d_postype(_d_postype),
+          d_orientation(_d_orientation),
+          d_tag(_d_tag),
+          d_excell_idx(_d_excell_idx),
+          d_excell_size(_d_excell_size),
+          excli(_excli),
+          box(_box),
+          ghost_width(_ghost_width),
+          cell_dim(_cell_dim),
+          ci(_ci),
+          d_check_overlaps(_d_check_overlaps),
+          overlap_idx(_overlap_idx),
+          d_overlap_count(_d_overlap_count),
+          gpu_partition(_gpu_partition),
+          block_size(_block_size)
+     {}
+
+    const Scalar4 *d_postype;               //!< postype array
+    const Scalar4 *d_orientation;           //!< orientation array
+    const unsigned int *d_tag;              //!< Particle tags
+    const unsigned int *d_excell_idx;       //!< Expanded cell list
+    const unsigned int *d_excell_size;      //!< Size of expanded cells
+    const Index2D& excli;                   //!< Excell indexer
+    const BoxDim& box;                      //!< Current simulation box
+    const Scalar3 ghost_width;              //!< Width of the ghost layer
+    const uint3& cell_dim;                  //!< Cell list dimensions
+    const Index3D& ci;                      //!< Cell list indexer
+    const unsigned int *d_check_overlaps;   //!< Interaction matrix
+    const Index2D& overlap_idx;             //!< Indexer into the interaction matrix
+    unsigned int *d_overlap_count;          //!< Number of overlaps, per device
+    const GPUPartition& gpu_partition;      //!< Split of particles between GPUs
+    const unsigned int block_size;          //!< Block size to execute
+    };
+
 //! Driver for kernel::hpmc_excell()
 void hpmc_excell(unsigned int *d_excell_idx,
                  unsigned int *d_excell_size,
@@ -311,6 +366,17 @@ void hpmc_shift(Scalar4 *d_postype,
                 const Scalar3 shift,
                 const unsigned int block_size);
 
+//! Driver for kernel::hpmc_count_overlaps()
+template< class Shape >
+void hpmc_count_overlaps(const hpmc_count_overlaps_args_t& args, const typename Shape::param_type *params);
+
+//! Kernel driver for kernel::hpmc_scale_box()
+void hpmc_scale_box(Scalar4 *d_postype,
+                    const unsigned int N,
+                    const BoxDim& old_box,
+                    const BoxDim& new_box,
+                    const unsigned int block_size);
+
 void hpmc_accept(const unsigned int *d_update_order_by_ptl,
                  const unsigned int *d_trial_move_type,
                  const unsigned int *d_reject_out_of_cell,
@@ -330,6 +396,7 @@ void hpmc_accept(const unsigned int *d_update_order_by_ptl,
                  const float *d_energy_old,
                  const float *d_energy_new,
                  const unsigned int maxn_patch,
+                 const float *d_energy_external,
                  unsigned int *d_condition,
                  const unsigned int seed,
                  const unsigned int select,
@@ -337,6 +404,26 @@ void hpmc_accept(const unsigned int *d_update_order_by_ptl,
                  const unsigned int block_size,
                  const unsigned int tpp);
 
+//! Kernel driver for kernel::hpmc_tune_move_sizes()
+void hpmc_tune_move_sizes(Scalar *d_d,
+                          Scalar *d_a,
+                          const Scalar *d_d_max,
+                          const Scalar *d_a_max,
+                          const hpmc_counters_t *d_counters,
+                          hpmc_counters_t *d_count_last,
+                          const unsigned int ntypes,
+                          const hpmc_move_size_tuner_params_t& params);
+
+//! Kernel driver for kernel::hpmc_reduce_counters()
+void hpmc_reduce_counters(const unsigned int ngpu,
+                          const unsigned int pitch,
+                          const hpmc_counters_t *d_per_device,
+                          hpmc_counters_t *d_total,
+                          const unsigned int implicit_pitch,
+                          const hpmc_implicit_counters_t *d_implicit_per_device,
+                          hpmc_implicit_counters_t *d_implicit_total,
+                          const unsigned int ntypes);
+
 #ifdef __HIPCC__
 namespace kernel
 {
@@ -363,7 +450,8 @@ __global__ void hpmc_gen_moves(Scalar4 *d_postype,
                            Scalar4 *d_trial_orientation,
                            unsigned int *d_trial_move_type,
                            unsigned int *d_reject_out_of_cell,
-                           const typename Shape::param_type *d_params)
+                           const typename Shape::param_type *d_params,
+                           const hpmc_walls_t walls)
     {
     // load the per type pair parameters into shared memory
     HIP_DYNAMIC_SHARED( char, s_data)
@@ -461,6 +549,10 @@ __global__ void hpmc_gen_moves(Scalar4 *d_postype,
             reject = 1;
         }
 
+    // reject moves that violate the confinement of any wall
+    if (move_active && !reject && !walls.empty() && !test_confined(walls, shape_i, pos_i))
+        reject = 1;
+
     // stash the trial move in global memory
     d_trial_postype[idx] = make_scalar4(pos_i.x, pos_i.y, pos_i.z, __int_as_scalar(typ_i));
     d_trial_orientation[idx] = quat_to_scalar4(shape_i.orientation);
@@ -1388,6 +1480,100 @@ __global__ void hpmc_update_pdata(Scalar4 *d_postype,
         }
     }
 
+//! Kernel to count the overlaps in the current configuration
+/*! Each thread tests one particle against the particles in its expanded cell. Like
+    IntegratorHPMCMono::countOverlaps(), a pair is counted by the particle with the lower tag, so that pairs with
+    a ghost are counted on one rank only.
+*/
+template<class Shape>
+__global__ void hpmc_count_overlaps(const Scalar4 *d_postype,
+                                    const Scalar4 *d_orientation,
+                                    const unsigned int *d_tag,
+                                    const unsigned int *d_excell_idx,
+                                    const unsigned int *d_excell_size,
+                                    const Index2D excli,
+                                    const BoxDim box,
+                                    const Scalar3 ghost_width,
+                                    const uint3 cell_dim,
+                                    const Index3D ci,
+                                    const unsigned int *d_check_overlaps,
+                                    const Index2D overlap_idx,
+                                    const typename Shape::param_type *d_params,
+                                    unsigned int *d_overlap_count,
+                                    const unsigned int nwork,
+                                    const unsigned int offset)
+    {
+    __shared__ unsigned int s_overlap_count;
+
+    if (threadIdx.x == 0)
+        s_overlap_count = 0;
+
+    __syncthreads();
+
+    unsigned int idx = blockIdx.x*blockDim.x + threadIdx.x;
+
+    if (idx < nwork)
+        {
+        idx += offset;
+
+        // load particle i
+        Scalar4 postype_i = d_postype[idx];
+        vec3<Scalar> pos_i(postype_i);
+        unsigned int type_i = __scalar_as_int(postype_i.w);
+        unsigned int tag_i = d_tag[idx];
+        Shape shape_i(quat<Scalar>(), d_params[type_i]);
+        if (shape_i.hasOrientation())
+            shape_i.orientation = quat<Scalar>(d_orientation[idx]);
+
+        unsigned int my_cell = computeParticleCell(vec_to_scalar3(pos_i), box, ghost_width, cell_dim, ci);
+        unsigned int excell_size = d_excell_size[my_cell];
+
+        unsigned int overlap_count = 0;
+        unsigned int err_count = 0;
+        for (unsigned int k = 0; k < excell_size; ++k)
+            {
+            unsigned int j = __ldg(&d_excell_idx[excli(k, my_cell)]);
+            if (j == idx || d_tag[j] < tag_i)
+                continue;
+
+            Scalar4 postype_j = d_postype[j];
+            unsigned int type_j = __scalar_as_int(postype_j.w);
+            if (!d_check_overlaps[overlap_idx(type_i, type_j)])
+                continue;
+
+            Shape shape_j(quat<Scalar>(), d_params[type_j]);
+            if (shape_j.hasOrientation())
+                shape_j.orientation = quat<Scalar>(d_orientation[j]);
+
+            // put particle j into the coordinate system of particle i
+            vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i;
+            r_ij = vec3<Scalar>(box.minImage(vec_to_scalar3(r_ij)));
+
+            if (check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                && test_overlap(r_ij, shape_i, shape_j, err_count)
+                && test_overlap(-r_ij, shape_j, shape_i, err_count))
+                {
+                overlap_count++;
+                }
+            }
+
+        if (overlap_count)
+            atomicAdd(&s_overlap_count, overlap_count);
+        }
+
+    __syncthreads();
+
+    // final tally into global mem
+    if (threadIdx.x == 0 && s_overlap_count)
+        {
+        #if (__CUDA_ARCH__ >= 600)
+        atomicAdd_system(d_overlap_count, s_overlap_count);
+        #else
+        atomicAdd(d_overlap_count, s_overlap_count);
+        #endif
+        }
+    }
+
 } // end namespace kernel
 
 //! Kernel driver for kernel::hpmc_gen_moves
@@ -1445,7 +1631,8 @@ void hpmc_gen_moves(const hpmc_args_t& args, const typename Shape::param_type *p
                                                                      args.d_trial_orientation,
                                                                      args.d_trial_move_type,
                                                                      args.d_reject_out_of_cell,
-                                                                     params
+                                                                     params,
+                                                                     args.walls
                                                                 );
         }
     else
@@ -1494,7 +1681,8 @@ void hpmc_gen_moves(const hpmc_args_t& args, const typename Shape::param_type *p
                                                                      args.d_trial_orientation,
                                                                      args.d_trial_move_type,
                                                                      args.d_reject_out_of_cell,
-                                                                     params
+                                                                     params,
+                                                                     args.walls
                                                                 );
 
         }
@@ -1895,6 +2083,52 @@ void hpmc_update_pdata(const hpmc_update_args_t& args, const typename Shape::par
             params);
         }
     }
+
+//! Driver for kernel::hpmc_count_overlaps()
+/*! The counts of the GPUs are added to args.d_overlap_count[idev], which must be set to zero before.
+*/
+template<class Shape>
+void hpmc_count_overlaps(const hpmc_count_overlaps_args_t& args, const typename Shape::param_type *params)
+    {
+    // determine the maximum block size and clamp the input block size down
+    static int max_block_size = -1;
+    static hipFuncAttributes attr;
+    if (max_block_size == -1)
+        {
+        hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(kernel::hpmc_count_overlaps<Shape>));
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int block_size = min(args.block_size, (unsigned int)max_block_size);
+    for (int idev = args.gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = args.gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+        if (nwork == 0)
+            continue;
+
+        const unsigned int num_blocks = (nwork + block_size - 1)/block_size;
+
+        hipLaunchKernelGGL((kernel::hpmc_count_overlaps<Shape>), dim3(num_blocks), dim3(block_size), 0, 0,
+            args.d_postype,
+            args.d_orientation,
+            args.d_tag,
+            args.d_excell_idx,
+            args.d_excell_size,
+            args.excli,
+            args.box,
+            args.ghost_width,
+            args.cell_dim,
+            args.ci,
+            args.d_check_overlaps,
+            args.overlap_idx,
+            params,
+            args.d_overlap_count + idev,
+            nwork,
+            range.first);
+        }
+    }
 #endif
 
 } // end namespace gpu
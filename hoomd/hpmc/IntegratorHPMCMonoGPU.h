@@ -7,10 +7,12 @@
 
 #include "hoomd/hpmc/IntegratorHPMCMono.h"
 #include "hoomd/hpmc/IntegratorHPMCMonoGPU.cuh"
+#include "hoomd/hpmc/ExternalFieldWall.h"
 #include "IntegratorHPMCMonoGPU.cuh"
 #include "hoomd/Autotuner.h"
 #include "hoomd/GlobalArray.h"
 #include "hoomd/GPUVector.h"
+#include "hoomd/ManagedArena.h"
 #include "hoomd/RandomNumbers.h"
 #include "hoomd/RNGIdentifiers.h"
 
@@ -165,6 +167,9 @@ class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Shape>
 
             m_tuner_accept->setPeriod(period);
             m_tuner_accept->setEnabled(enable);
+
+            m_tuner_count_overlaps->setPeriod(period);
+            m_tuner_count_overlaps->setEnabled(enable);
             }
 
         //! Method called when numbe of particle types changes
@@ -173,6 +178,15 @@ class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Shape>
         //! Take one timestep forward
         virtual void update(unsigned int timestep);
 
+        //! Scale the move sizes towards a target acceptance ratio on the device
+        virtual void tuneMoveSizes(const hpmc_move_size_tuner_params_t& params,
+                                   const GPUArray<Scalar>& d_max,
+                                   const GPUArray<Scalar>& a_max,
+                                   GPUArray<hpmc_counters_t>& count_last);
+
+        //! Count overlaps with the option to exit early at the first detected overlap
+        virtual unsigned int countOverlaps(bool early_exit);
+
     protected:
         std::shared_ptr<CellList> m_cl;                      //!< Cell list
         uint3 m_last_dim;                                    //!< Dimensions of the cell list on the last call to update
@@ -188,6 +202,7 @@ class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Shape>
         std::unique_ptr<Autotuner> m_tuner_excell_block_size;  //!< Autotuner for excell block_size
         std::unique_ptr<Autotuner> m_tuner_accept;           //!< Autotuner for acceptance kernel
         std::unique_ptr<Autotuner> m_tuner_depletants;       //!< Autotuner for inserting depletants
+        std::unique_ptr<Autotuner> m_tuner_count_overlaps;   //!< Autotuner for counting overlaps
 
         GlobalArray<Scalar4> m_trial_postype;                 //!< New positions (and type) of particles
         GlobalArray<Scalar4> m_trial_orientation;             //!< New orientations
@@ -213,9 +228,11 @@ class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Shape>
         GlobalArray<float> m_energy_new;                      //!< Energy contribution per neighbor in new config
         GlobalArray<unsigned int> m_nneigh_patch_new;         //!< Number of neighbors in new config
         GlobalArray<Scalar> m_additive_cutoff;                //!< Per-type additive cutoffs from patch potential
+        GlobalArray<float> m_energy_external;                 //!< External field energy difference of each trial move
 
         GlobalArray<hpmc_counters_t> m_counters;                    //!< Per-device counters
         GlobalArray<hpmc_implicit_counters_t> m_implicit_counters;  //!< Per-device counters for depletants
+        GlobalArray<unsigned int> m_overlap_count;                  //!< Per-device overlap counts
 
         //!< Variables for implicit depletants
         GlobalArray<Scalar> m_lambda;                              //!< Poisson means, per type pair
@@ -234,6 +251,9 @@ class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Shape>
 
         //! Update GPU memory hints
         virtual void updateGPUAdvice();
+
+        //! Scale the local particle positions from one global box to another
+        virtual void scaleParticles(const BoxDim& old_box, const BoxDim& new_box);
     };
 
 template< class Shape >
@@ -260,6 +280,7 @@ IntegratorHPMCMonoGPU< Shape >::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefi
     m_tuner_moves.reset(new Autotuner(dev_prop.warpSize, dev_prop.maxThreadsPerBlock, dev_prop.warpSize, 5, 1000000, "hpmc_moves", this->m_exec_conf));
     m_tuner_update_pdata.reset(new Autotuner(dev_prop.warpSize, dev_prop.maxThreadsPerBlock, dev_prop.warpSize, 5, 1000000, "hpmc_update_pdata", this->m_exec_conf));
     m_tuner_excell_block_size.reset(new Autotuner(dev_prop.warpSize, dev_prop.maxThreadsPerBlock, dev_prop.warpSize, 5, 1000000, "hpmc_excell_block_size", this->m_exec_conf));
+    m_tuner_count_overlaps.reset(new Autotuner(dev_prop.warpSize, dev_prop.maxThreadsPerBlock, dev_prop.warpSize, 5, 100000, "hpmc_count_overlaps", this->m_exec_conf));
 
     // tuning parameters for narrow phase
     std::vector<unsigned int> valid_params;
@@ -277,6 +298,11 @@ IntegratorHPMCMonoGPU< Shape >::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefi
     m_tuner_narrow.reset(new Autotuner(valid_params, 5, 100000, "hpmc_narrow", this->m_exec_conf));
     m_tuner_depletants.reset(new Autotuner(valid_params, 5, 100000, "hpmc_depletants", this->m_exec_conf));
 
+    // prune the large block size and group size spaces early, within two launches per parameter
+    m_tuner_accept->setSearch(Autotuner::search_halving, 2*valid_params.size());
+    m_tuner_narrow->setSearch(Autotuner::search_halving, 2*valid_params.size());
+    m_tuner_depletants->setSearch(Autotuner::search_halving, 2*valid_params.size());
+
     // initialize memory
     GlobalArray<Scalar4>(1,this->m_exec_conf).swap(m_trial_postype);
     TAG_ALLOCATION(m_trial_postype);
@@ -320,6 +346,9 @@ IntegratorHPMCMonoGPU< Shape >::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefi
     GlobalArray<float>(1, this->m_exec_conf).swap(m_energy_new);
     TAG_ALLOCATION(m_energy_new);
 
+    GlobalArray<float>(1, this->m_exec_conf).swap(m_energy_external);
+    TAG_ALLOCATION(m_energy_external);
+
     GlobalArray<unsigned int>(1, this->m_exec_conf).swap(m_overflow);
     TAG_ALLOCATION(m_overflow);
 
@@ -329,6 +358,9 @@ IntegratorHPMCMonoGPU< Shape >::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefi
     GlobalArray<unsigned int>(1, this->m_exec_conf).swap(m_condition);
     TAG_ALLOCATION(m_condition);
 
+    GlobalArray<unsigned int>(this->m_exec_conf->getNumActiveGPUs(), this->m_exec_conf).swap(m_overlap_count);
+    TAG_ALLOCATION(m_overlap_count);
+
     #if defined(__HIP_PLATFORM_NVCC__)
     if (this->m_exec_conf->allConcurrentManagedAccess())
         {
@@ -554,6 +586,7 @@ void IntegratorHPMCMonoGPU< Shape >::update(unsigned int timestep)
             m_trial_postype.resize(this->m_pdata->getMaxN());
             m_trial_orientation.resize(this->m_pdata->getMaxN());
             m_trial_move_type.resize(this->m_pdata->getMaxN());
+            m_energy_external.resize(this->m_pdata->getMaxN());
 
             update_gpu_advice = true;
             }
@@ -639,6 +672,34 @@ void IntegratorHPMCMonoGPU< Shape >::update(unsigned int timestep)
         // depletants
         ArrayHandle<Scalar> d_lambda(m_lambda, access_location::device, access_mode::read);
 
+        // walls confining the particles reject trial moves in the trial move kernel
+        std::shared_ptr< ExternalFieldWall<Shape> > wall_field
+            = std::dynamic_pointer_cast< ExternalFieldWall<Shape> >(this->m_external);
+        hpmc_walls_t walls;
+        if (wall_field)
+            {
+            walls = wall_field->getWallData();
+            if (!walls.empty() && !wallsSupportedOnGPU<Shape>())
+                {
+                this->m_exec_conf->msg->error() << "Walls are not implemented on the GPU for this shape" << std::endl;
+                throw std::runtime_error("Error in IntegratorHPMCMonoGPU");
+                }
+            }
+
+        const ArrayHandle<SphereWallData>& d_sphere_walls = wall_field ?
+            ArrayHandle<SphereWallData>(wall_field->getSphereWallData(), access_location::device, access_mode::read) :
+            ArrayHandle<SphereWallData>(GlobalArray<SphereWallData>(), access_location::device, access_mode::read);
+        const ArrayHandle<CylinderWallData>& d_cylinder_walls = wall_field ?
+            ArrayHandle<CylinderWallData>(wall_field->getCylinderWallData(), access_location::device,
+                access_mode::read) :
+            ArrayHandle<CylinderWallData>(GlobalArray<CylinderWallData>(), access_location::device, access_mode::read);
+        const ArrayHandle<PlaneWallData>& d_plane_walls = wall_field ?
+            ArrayHandle<PlaneWallData>(wall_field->getPlaneWallData(), access_location::device, access_mode::read) :
+            ArrayHandle<PlaneWallData>(GlobalArray<PlaneWallData>(), access_location::device, access_mode::read);
+        walls.d_spheres = d_sphere_walls.data;
+        walls.d_cylinders = d_cylinder_walls.data;
+        walls.d_planes = d_plane_walls.data;
+
         for (unsigned int i = 0; i < this->m_nselect; i++)
             {
                 { // ArrayHandle scope
@@ -708,6 +769,7 @@ void IntegratorHPMCMonoGPU< Shape >::update(unsigned int timestep)
                 // reset acceptance results and move types
                 m_tuner_moves->begin();
                 args.block_size = m_tuner_moves->getParam();
+                args.walls = walls;
                 gpu::hpmc_gen_moves<Shape>(args, params.data());
                 if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
                     CHECK_CUDA_ERROR();
@@ -979,6 +1041,37 @@ void IntegratorHPMCMonoGPU< Shape >::update(unsigned int timestep)
                     } while (reallocate);
                 } // end patch energy
 
+            // external field energies of the trial moves
+            bool external_gpu = this->m_external && this->m_external->hasEnergyDiffGPU();
+            if (external_gpu)
+                {
+                ArrayHandle<Scalar4> d_trial_postype(m_trial_postype, access_location::device, access_mode::read);
+                ArrayHandle<Scalar4> d_trial_orientation(m_trial_orientation, access_location::device, access_mode::read);
+                ArrayHandle<unsigned int> d_trial_move_type(m_trial_move_type, access_location::device, access_mode::read);
+
+                ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(), access_location::device, access_mode::read);
+                ArrayHandle<Scalar4> d_orientation(this->m_pdata->getOrientationArray(), access_location::device, access_mode::read);
+                ArrayHandle<Scalar> d_charge(this->m_pdata->getCharges(), access_location::device, access_mode::read);
+                ArrayHandle<Scalar> d_diameter(this->m_pdata->getDiameters(), access_location::device, access_mode::read);
+
+                ArrayHandle<float> d_energy_external(m_energy_external, access_location::device, access_mode::overwrite);
+
+                detail::hpmc_external_args_t external_args(
+                    d_postype.data,
+                    d_orientation.data,
+                    d_trial_postype.data,
+                    d_trial_orientation.data,
+                    d_trial_move_type.data,
+                    d_charge.data,
+                    d_diameter.data,
+                    this->m_pdata->getGlobalBox(),
+                    d_energy_external.data,
+                    this->m_pdata->getGPUPartition());
+
+                // compute external field energies on default stream
+                this->m_external->computeEnergyDiffGPU(external_args, 0);
+                }
+
             /*
              * make accept/reject decisions
              */
@@ -1005,6 +1098,9 @@ void IntegratorHPMCMonoGPU< Shape >::update(unsigned int timestep)
                     ArrayHandle<float> d_energy_old(m_energy_old, access_location::device, access_mode::read);
                     ArrayHandle<float> d_energy_new(m_energy_new, access_location::device, access_mode::read);
 
+                    // external field
+                    ArrayHandle<float> d_energy_external(m_energy_external, access_location::device, access_mode::read);
+
                     // reset condition flag
                     hipMemsetAsync(d_condition.data, 0, sizeof(unsigned int));
                     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
@@ -1034,6 +1130,7 @@ void IntegratorHPMCMonoGPU< Shape >::update(unsigned int timestep)
                         d_energy_old.data,
                         d_energy_new.data,
                         m_maxn_patch,
+                        external_gpu ? d_energy_external.data : 0,
                         d_condition.data,
                         this->m_seed,
                         this->m_exec_conf->getRank()*this->m_nselect + i,
@@ -1099,23 +1196,24 @@ void IntegratorHPMCMonoGPU< Shape >::update(unsigned int timestep)
 
         if (ngpu > 1)
             {
-            // reduce per-device counters
-            ArrayHandle<hpmc_counters_t> h_count_total(this->m_count_total, access_location::host, access_mode::readwrite);
-            ArrayHandle<hpmc_counters_t> h_counters_per_device(m_counters, access_location::host, access_mode::read);
-
-            for (unsigned int idev = 0; idev < ngpu; ++idev)
-                {
-                *h_count_total.data = *h_count_total.data + h_counters_per_device.data[idev*m_counters.getPitch()];
-                }
-
-            ArrayHandle<hpmc_implicit_counters_t> h_implicit_count_total(this->m_implicit_count, access_location::host, access_mode::readwrite);
-            ArrayHandle<hpmc_implicit_counters_t> h_implicit_counters_per_device(m_implicit_counters, access_location::host, access_mode::read);
-
-            for (unsigned int idev = 0; idev < ngpu; ++idev)
-                {
-                for (unsigned int itype = 0; itype < this->m_pdata->getNTypes(); ++itype)
-                    h_implicit_count_total.data[itype] = h_implicit_count_total.data[itype] + h_implicit_counters_per_device.data[itype+idev*m_implicit_counters.getPitch()];
-                }
+            // reduce the per-device counters on the device, the host reads the totals only when they are logged
+            ArrayHandle<hpmc_counters_t> d_count_total(this->m_count_total, access_location::device, access_mode::readwrite);
+            ArrayHandle<hpmc_counters_t> d_counters_per_device(m_counters, access_location::device, access_mode::read);
+            ArrayHandle<hpmc_implicit_counters_t> d_implicit_count_total(this->m_implicit_count, access_location::device,
+                access_mode::readwrite);
+            ArrayHandle<hpmc_implicit_counters_t> d_implicit_counters_per_device(m_implicit_counters,
+                access_location::device, access_mode::read);
+
+            gpu::hpmc_reduce_counters(ngpu,
+                                      (unsigned int)m_counters.getPitch(),
+                                      d_counters_per_device.data,
+                                      d_count_total.data,
+                                      (unsigned int)m_implicit_counters.getPitch(),
+                                      d_implicit_counters_per_device.data,
+                                      d_implicit_count_total.data,
+                                      this->m_pdata->getNTypes());
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
             }
         }
 
@@ -1158,10 +1256,8 @@ void IntegratorHPMCMonoGPU< Shape >::update(unsigned int timestep)
     // all particle have been moved, the aabb tree is now invalid
     this->m_aabb_tree_invalid = true;
 
-    // set current MPS value
-    hpmc_counters_t run_counters = this->getCounters(1);
-    double cur_time = double(this->m_clock.getTime()) / Scalar(1e9);
-    this->m_mps = double(run_counters.getNMoves()) / cur_time;
+    // getMPS() reads the counters when it is called
+    this->m_mps_time = double(this->m_clock.getTime()) / Scalar(1e9);
     }
 
 template< class Shape >
@@ -1362,6 +1458,182 @@ void IntegratorHPMCMonoGPU< Shape >::slotNumTypesChange()
     IntegratorHPMCMono<Shape>::slotNumTypesChange();
     }
 
+/*! Scales the move sizes in device memory with the same controller as IntegratorHPMC::tuneMoveSizes(), so
+    neither the counters nor the move sizes are copied to the host. With domain decomposition, the counters must be
+    reduced over all ranks and the host implementation is used.
+*/
+template< class Shape >
+void IntegratorHPMCMonoGPU< Shape >::tuneMoveSizes(const hpmc_move_size_tuner_params_t& params,
+                                                   const GPUArray<Scalar>& d_max,
+                                                   const GPUArray<Scalar>& a_max,
+                                                   GPUArray<hpmc_counters_t>& count_last)
+    {
+    #ifdef ENABLE_MPI
+    if (this->m_comm)
+        {
+        IntegratorHPMC::tuneMoveSizes(params, d_max, a_max, count_last);
+        return;
+        }
+    #endif
+
+    ArrayHandle<Scalar> d_d(this->m_d, access_location::device, access_mode::readwrite);
+    ArrayHandle<Scalar> d_a(this->m_a, access_location::device, access_mode::readwrite);
+    ArrayHandle<Scalar> d_d_max(d_max, access_location::device, access_mode::read);
+    ArrayHandle<Scalar> d_a_max(a_max, access_location::device, access_mode::read);
+    ArrayHandle<hpmc_counters_t> d_counters(this->m_count_total, access_location::device, access_mode::read);
+    ArrayHandle<hpmc_counters_t> d_count_last(count_last, access_location::device, access_mode::readwrite);
+
+    gpu::hpmc_tune_move_sizes(d_d.data,
+                              d_a.data,
+                              d_d_max.data,
+                              d_a_max.data,
+                              d_counters.data,
+                              d_count_last.data,
+                              std::min(this->m_pdata->getNTypes(), (unsigned int)d_max.getNumElements()),
+                              params);
+    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+/*! Counts the overlaps on the device with the expanded cell list of the trial moves, so that the particle data is
+    not copied to the host. Every call tests all particles; the record of overlapping particles kept for incremental
+    counts is only used by the host implementation. The host implementation also handles boxes that are too small for
+    the minimum image convention with the cell list.
+*/
+template< class Shape >
+unsigned int IntegratorHPMCMonoGPU< Shape >::countOverlaps(bool early_exit)
+    {
+    BoxDim global_box = this->m_pdata->getGlobalBox();
+    Scalar3 nearest_plane_distance = global_box.getNearestPlaneDistance();
+    if ((global_box.getPeriodic().x && nearest_plane_distance.x <= this->m_nominal_width*2) ||
+        (global_box.getPeriodic().y && nearest_plane_distance.y <= this->m_nominal_width*2) ||
+        (this->m_sysdef->getNDimensions() == 3 && global_box.getPeriodic().z
+            && nearest_plane_distance.z <= this->m_nominal_width*2))
+        {
+        return IntegratorHPMCMono<Shape>::countOverlaps(early_exit);
+        }
+
+    // the particles may have moved since the last sweep in this time step, rebuild the cell list
+    this->m_cl->forceCompute(0);
+
+    if (this->m_prof) this->m_prof->push(this->m_exec_conf, "HPMC count overlaps");
+
+    uint3 cur_dim = this->m_cl->getDim();
+    if (m_last_dim.x != cur_dim.x || m_last_dim.y != cur_dim.y || m_last_dim.z != cur_dim.z
+        || m_last_nmax != this->m_cl->getNmax())
+        {
+        initializeExcellMem();
+
+        m_last_dim = cur_dim;
+        m_last_nmax = this->m_cl->getNmax();
+        }
+
+    unsigned int overlap_count = 0;
+
+        {
+        // access the cell list data
+        ArrayHandle<unsigned int> d_cell_size(this->m_cl->getCellSizeArray(), access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_cell_idx(this->m_cl->getIndexArray(), access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_cell_adj(this->m_cl->getCellAdjArray(), access_location::device, access_mode::read);
+
+        // per-device cell list data
+        const ArrayHandle<unsigned int>& d_cell_size_per_device = m_cl->getPerDevice() ?
+            ArrayHandle<unsigned int>(m_cl->getCellSizeArrayPerDevice(),access_location::device, access_mode::read) :
+            ArrayHandle<unsigned int>(GlobalArray<unsigned int>(), access_location::device, access_mode::read);
+        const ArrayHandle<unsigned int>& d_cell_idx_per_device = m_cl->getPerDevice() ?
+            ArrayHandle<unsigned int>(m_cl->getIndexArrayPerDevice(), access_location::device, access_mode::read) :
+            ArrayHandle<unsigned int>(GlobalArray<unsigned int>(), access_location::device, access_mode::read);
+
+        ArrayHandle< unsigned int > d_excell_idx(m_excell_idx, access_location::device, access_mode::overwrite);
+        ArrayHandle< unsigned int > d_excell_size(m_excell_size, access_location::device, access_mode::overwrite);
+
+        this->m_tuner_excell_block_size->begin();
+        gpu::hpmc_excell(d_excell_idx.data,
+                            d_excell_size.data,
+                            m_excell_list_indexer,
+                            m_cl->getPerDevice() ? d_cell_idx_per_device.data : d_cell_idx.data,
+                            m_cl->getPerDevice() ? d_cell_size_per_device.data : d_cell_size.data,
+                            d_cell_adj.data,
+                            this->m_cl->getCellIndexer(),
+                            this->m_cl->getCellListIndexer(),
+                            this->m_cl->getCellAdjIndexer(),
+                            this->m_exec_conf->getNumActiveGPUs(),
+                            this->m_tuner_excell_block_size->getParam());
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+        this->m_tuner_excell_block_size->end();
+
+        ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(), access_location::device, access_mode::read);
+        ArrayHandle<Scalar4> d_orientation(this->m_pdata->getOrientationArray(), access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_tag(this->m_pdata->getTags(), access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_overlaps(this->m_overlaps, access_location::device, access_mode::read);
+
+        ArrayHandle<unsigned int> d_overlap_count(m_overlap_count, access_location::device, access_mode::overwrite);
+        hipMemset(d_overlap_count.data, 0, sizeof(unsigned int)*m_overlap_count.getNumElements());
+
+        auto & params = this->getParams();
+        BoxDim box = this->m_pdata->getBox();
+        Scalar3 ghost_width = this->m_cl->getGhostWidth();
+        const Index3D& ci = this->m_cl->getCellIndexer();
+
+        this->m_exec_conf->beginMultiGPU();
+        m_tuner_count_overlaps->begin();
+        gpu::hpmc_count_overlaps_args_t args(d_postype.data,
+                                             d_orientation.data,
+                                             d_tag.data,
+                                             d_excell_idx.data,
+                                             d_excell_size.data,
+                                             m_excell_list_indexer,
+                                             box,
+                                             ghost_width,
+                                             cur_dim,
+                                             ci,
+                                             d_overlaps.data,
+                                             this->m_overlap_idx,
+                                             d_overlap_count.data,
+                                             this->m_pdata->getGPUPartition(),
+                                             m_tuner_count_overlaps->getParam());
+        gpu::hpmc_count_overlaps<Shape>(args, params.data());
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+        m_tuner_count_overlaps->end();
+        this->m_exec_conf->endMultiGPU();
+        }
+
+        {
+        ArrayHandle<unsigned int> h_overlap_count(m_overlap_count, access_location::host, access_mode::read);
+        for (unsigned int idev = 0; idev < m_overlap_count.getNumElements(); ++idev)
+            overlap_count += h_overlap_count.data[idev];
+        }
+
+    if (early_exit && overlap_count > 1)
+        overlap_count = 1;
+
+    if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
+
+    #ifdef ENABLE_MPI
+    if (this->m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &overlap_count, 1, MPI_UNSIGNED, MPI_SUM, this->m_exec_conf->getMPICommunicator());
+        if (early_exit && overlap_count > 1)
+            overlap_count = 1;
+        }
+    #endif
+
+    return overlap_count;
+    }
+
+/*! \param old_box Global box the particles are in
+    \param new_box Global box to scale the particles into
+*/
+template< class Shape >
+void IntegratorHPMCMonoGPU< Shape >::scaleParticles(const BoxDim& old_box, const BoxDim& new_box)
+    {
+    ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(), access_location::device, access_mode::readwrite);
+
+    gpu::hpmc_scale_box(d_postype.data, this->m_pdata->getN(), old_box, new_box, 128);
+    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
 template< class Shape >
 void IntegratorHPMCMonoGPU< Shape >::updateCellWidth()
     {
@@ -1387,6 +1659,15 @@ void IntegratorHPMCMonoGPU< Shape >::updateCellWidth()
         CHECK_CUDA_ERROR();
         }
 
+    // the nested arrays are packed in the managed arena, move them to the GPUs now instead of faulting them in
+    // during the first sweep
+    ManagedArena::get().prefetch(this->m_exec_conf->getGPUIds());
+    #ifdef __HIP_PLATFORM_NVCC__
+    for (auto gpu : this->m_exec_conf->getGPUIds())
+        cudaMemPrefetchAsync(this->m_params.data(), this->m_params.size()*sizeof(typename Shape::param_type), gpu);
+    #endif
+    CHECK_CUDA_ERROR();
+
     // reinitialize poisson means array
     ArrayHandle<Scalar> h_lambda(m_lambda, access_location::host, access_mode::overwrite);
     Index2D typpair_idx(this->m_pdata->getNTypes());
@@ -0,0 +1,77 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _LATTICE_ENERGY_H_
+#define _LATTICE_ENERGY_H_
+
+/*! \file LatticeEnergy.h
+    \brief Per particle energy of the lattice field, shared by the CPU and GPU implementations
+*/
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+#include "hoomd/BoxDim.h"
+
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+namespace hpmc
+{
+
+namespace detail
+{
+
+//! Translational energy of a particle bound to its lattice site with a harmonic spring
+/*! \param position Particle position
+    \param r0 Lattice site (already scaled with the box)
+    \param origin Origin of the particle data
+    \param box Global simulation box
+    \param k Spring constant
+*/
+HOSTDEVICE inline Scalar lattice_energy_trans(const vec3<Scalar>& position,
+                                              const vec3<Scalar>& r0,
+                                              const vec3<Scalar>& origin,
+                                              const BoxDim& box,
+                                              Scalar k)
+    {
+    vec3<Scalar> dr = vec3<Scalar>(box.minImage(vec_to_scalar3(r0 - position + origin)));
+    return k*dot(dr,dr);
+    }
+
+//! Rotational energy of a particle bound to its reference orientation with a harmonic spring
+/*! \param orientation Particle orientation
+    \param q0 Reference orientation
+    \param symmetry Quaternions in the symmetry group of the shape (quat<Scalar> or Scalar4)
+    \param n_symmetry Number of elements in \a symmetry
+    \param q Spring constant
+
+    The energy is the minimum over all orientations that are equivalent under the symmetry group.
+*/
+template<class SymmetryType>
+HOSTDEVICE inline Scalar lattice_energy_rot(const quat<Scalar>& orientation,
+                                            const quat<Scalar>& q0,
+                                            const SymmetryType *symmetry,
+                                            unsigned int n_symmetry,
+                                            Scalar q)
+    {
+    Scalar dqmin = 0.0;
+    for (unsigned int i = 0; i < n_symmetry; i++)
+        {
+        quat<Scalar> equiv_orientation = orientation*quat<Scalar>(symmetry[i]);
+        quat<Scalar> dq = q0 - equiv_orientation;
+        dqmin = (i == 0) ? norm2(dq) : fmin(dqmin, norm2(dq));
+        }
+    return q*dqmin;
+    }
+
+} // end namespace detail
+
+} // end namespace hpmc
+
+#undef HOSTDEVICE
+
+#endif // _LATTICE_ENERGY_H_
@@ -248,6 +248,62 @@ DEVICE inline vec3<Scalar> generatePositionInAABB(RNG& rng, const detail::AABB&
     return p;
     }
 
+/* Test if a position lies in an AABB
+ *
+ * \param aabb The AABB
+ * \param p The position
+ * \param ndim Dimensionality of the system, the z component is ignored in 2D
+ */
+DEVICE inline bool isPositionInAABB(const detail::AABB& aabb, const vec3<Scalar>& p, unsigned int ndim)
+    {
+    vec3<Scalar> lower = aabb.getLower();
+    vec3<Scalar> upper = aabb.getUpper();
+
+    return p.x >= lower.x && p.x <= upper.x
+        && p.y >= lower.y && p.y <= upper.y
+        && (ndim == 2 || (p.z >= lower.z && p.z <= upper.z));
+    }
+
+/* Compute an AABB around the intersection of two spheres
+ *
+ * \param r_a Center of sphere a
+ * \param R_a Radius of sphere a
+ * \param r_b Center of sphere b
+ * \param R_b Radius of sphere b
+ * \param aabb The bounding box (output)
+ * \returns false if the spheres do not intersect
+ *
+ * When the plane of the circle where the spheres meet lies between the two centers, the lens shaped intersection
+ * is contained in the sphere with the same center and radius as that circle. Otherwise, it is contained in the
+ * smaller sphere.
+ */
+DEVICE inline bool sphereIntersectionAABB(const vec3<Scalar>& r_a, Scalar R_a, const vec3<Scalar>& r_b, Scalar R_b,
+    detail::AABB& aabb)
+    {
+    vec3<Scalar> r_ab = r_b - r_a;
+    Scalar d = fast::sqrt(dot(r_ab,r_ab));
+
+    if (d > R_a + R_b)
+        return false;
+
+    // distance from the center of a to the plane of the intersection circle
+    Scalar d_a = Scalar(0.0);
+    if (d > fabs(R_a - R_b))
+        d_a = (d*d + R_a*R_a - R_b*R_b)/(Scalar(2.0)*d);
+
+    if (d <= fabs(R_a - R_b) || d_a < Scalar(0.0) || d_a > d)
+        {
+        // one sphere contains the other, or the intersection covers more than half of the smaller sphere
+        aabb = (R_a < R_b) ? detail::AABB(r_a, R_a) : detail::AABB(r_b, R_b);
+        }
+    else
+        {
+        Scalar R = fast::sqrt(R_a*R_a - d_a*d_a);
+        aabb = detail::AABB(r_a + (d_a/d)*r_ab, R);
+        }
+    return true;
+    }
+
 /* Generate a uniformly distributed random position in an OBB
  *
  * \param rng The random number generator
@@ -299,13 +299,15 @@ class SupportFuncConvexPolyhedron
             if (verts.N > 0)
                 {
                 #if !defined(__HIPCC__) && defined(__AVX__) && (defined(SINGLE_PRECISION) || defined(ENABLE_HPMC_MIXED_PRECISION))
-                // process dot products with AVX 8 at a time on the CPU when working with more than
-                // 4 verts
+                // process dot products with AVX 8 at a time on the CPU, and track the index of the maximum in
+                // each of the 8 channels with blends, so that the vertices are read only once
                 __m256 nx_v = _mm256_broadcast_ss(&n.x);
                 __m256 ny_v = _mm256_broadcast_ss(&n.y);
                 __m256 nz_v = _mm256_broadcast_ss(&n.z);
                 __m256 max_dot_v = _mm256_broadcast_ss(&max_dot);
-                float d_s[verts.x.size()] __attribute__((aligned(32)));
+                __m256 max_idx_v = _mm256_setzero_ps();
+                __m256 idx_v = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+                const __m256 stride_v = _mm256_set1_ps(8.0f);
 
                 for (unsigned int i = 0; i < verts.N; i+=8)
                     {
@@ -315,34 +317,28 @@ class SupportFuncConvexPolyhedron
 
                     __m256 d_v = _mm256_add_ps(_mm256_mul_ps(nx_v, x_v), _mm256_add_ps(_mm256_mul_ps(ny_v, y_v), _mm256_mul_ps(nz_v, z_v)));
 
-                    // determine a maximum in each of the 8 channels as we go
-                    max_dot_v = _mm256_max_ps(max_dot_v, d_v);
-
-                    _mm256_store_ps(d_s + i, d_v);
+                    // keep the first maximum in each channel
+                    __m256 gt_v = _mm256_cmp_ps(d_v, max_dot_v, _CMP_GT_OQ);
+                    max_dot_v = _mm256_blendv_ps(max_dot_v, d_v, gt_v);
+                    max_idx_v = _mm256_blendv_ps(max_idx_v, idx_v, gt_v);
+                    idx_v = _mm256_add_ps(idx_v, stride_v);
                     }
 
-                // find the maximum of the 8 channels
-                // http://stackoverflow.com/questions/17638487/minimum-of-4-sp-values-in-m128
-                max_dot_v = _mm256_max_ps(max_dot_v, _mm256_shuffle_ps(max_dot_v, max_dot_v, _MM_SHUFFLE(2, 1, 0, 3)));
-                max_dot_v = _mm256_max_ps(max_dot_v, _mm256_shuffle_ps(max_dot_v, max_dot_v, _MM_SHUFFLE(1, 0, 3, 2)));
-                // shuffles work only within the two 128b segments, so right now we have two separate max values
-                // swap the left and right hand sides and max again to get the final max
-                max_dot_v = _mm256_max_ps(max_dot_v, _mm256_permute2f128_ps(max_dot_v, max_dot_v, 1));
+                // find the maximum of the 8 channels, preferring the lowest index among equal values
+                float max_dot_s[8] __attribute__((aligned(32)));
+                float max_idx_s[8] __attribute__((aligned(32)));
+                _mm256_store_ps(max_dot_s, max_dot_v);
+                _mm256_store_ps(max_idx_s, max_idx_v);
 
-                // loop again and find the max. The reason this is in a 2nd loop is because branch mis-predictions
-                // and the extra max calls kill performance if this is in the first loop
-                // Use BSF to find the first index of the max element
-                // https://software.intel.com/en-us/forums/topic/285956
-                for (unsigned int i = 0; i < verts.N; i+=8)
+                max_dot = max_dot_s[0];
+                max_idx = (unsigned int)max_idx_s[0];
+                for (unsigned int k = 1; k < 8; k++)
                     {
-                    __m256 d_v = _mm256_load_ps(d_s + i);
-
-                    int id = __builtin_ffs(_mm256_movemask_ps(_mm256_cmp_ps(max_dot_v, d_v, 0)));
-
-                    if (id)
+                    unsigned int idx = (unsigned int)max_idx_s[k];
+                    if (max_dot_s[k] > max_dot || (max_dot_s[k] == max_dot && idx < max_idx))
                         {
-                        max_idx = i + id - 1;
-                        break;
+                        max_dot = max_dot_s[k];
+                        max_idx = idx;
                         }
                     }
                 #elif !defined(__HIPCC__) && defined(__SSE__) && (defined(SINGLE_PRECISION) || defined(ENABLE_HPMC_MIXED_PRECISION))
@@ -388,9 +384,51 @@ class SupportFuncConvexPolyhedron
                         break;
                         }
                     }
+                #elif !defined(__HIPCC__) && defined(__AVX__)
+                // in double precision, process dot products with AVX 4 at a time on the CPU in the same way
+                __m256d nx_v = _mm256_broadcast_sd(&n.x);
+                __m256d ny_v = _mm256_broadcast_sd(&n.y);
+                __m256d nz_v = _mm256_broadcast_sd(&n.z);
+                __m256d max_dot_v = _mm256_broadcast_sd(&max_dot);
+                __m256d max_idx_v = _mm256_setzero_pd();
+                __m256d idx_v = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+                const __m256d stride_v = _mm256_set1_pd(4.0);
+
+                for (unsigned int i = 0; i < verts.N; i+=4)
+                    {
+                    __m256d x_v = _mm256_load_pd(verts.x.get() + i);
+                    __m256d y_v = _mm256_load_pd(verts.y.get() + i);
+                    __m256d z_v = _mm256_load_pd(verts.z.get() + i);
+
+                    __m256d d_v = _mm256_add_pd(_mm256_mul_pd(nx_v, x_v), _mm256_add_pd(_mm256_mul_pd(ny_v, y_v), _mm256_mul_pd(nz_v, z_v)));
+
+                    // keep the first maximum in each channel
+                    __m256d gt_v = _mm256_cmp_pd(d_v, max_dot_v, _CMP_GT_OQ);
+                    max_dot_v = _mm256_blendv_pd(max_dot_v, d_v, gt_v);
+                    max_idx_v = _mm256_blendv_pd(max_idx_v, idx_v, gt_v);
+                    idx_v = _mm256_add_pd(idx_v, stride_v);
+                    }
+
+                // find the maximum of the 4 channels, preferring the lowest index among equal values
+                double max_dot_s[4] __attribute__((aligned(32)));
+                double max_idx_s[4] __attribute__((aligned(32)));
+                _mm256_store_pd(max_dot_s, max_dot_v);
+                _mm256_store_pd(max_idx_s, max_idx_v);
+
+                max_dot = max_dot_s[0];
+                max_idx = (unsigned int)max_idx_s[0];
+                for (unsigned int k = 1; k < 4; k++)
+                    {
+                    unsigned int idx = (unsigned int)max_idx_s[k];
+                    if (max_dot_s[k] > max_dot || (max_dot_s[k] == max_dot && idx < max_idx))
+                        {
+                        max_dot = max_dot_s[k];
+                        max_idx = idx;
+                        }
+                    }
                 #else
 
-                // if no AVX or SSE, or running in double precision, fall back on serial computation
+                // if no AVX or SSE, fall back on serial computation
                 // this code path also triggers on the GPU
 
                 OverlapReal max_dot0 = dot(n, vec3<OverlapReal>(verts.x[0], verts.y[0], verts.z[0]));
@@ -115,8 +115,8 @@ struct ShapeEllipsoid
     /// Get the in-sphere radius of the shape
     DEVICE OverlapReal getInsphereRadius() const
         {
-        // not implemented
-        return OverlapReal(0.0);
+        // return the minimum of the 3 axes
+        return detail::min(axes.x, detail::min(axes.y, axes.z));
         }
 
     /** Support function of the shape (in local coordinates), used in getAABB
@@ -449,6 +449,15 @@ DEVICE inline bool test_overlap<ShapeEllipsoid,ShapeEllipsoid>(const vec3<Scalar
        return (dot(dr,dr) <= ab*ab);
        }
 
+    // ellipsoids overlap when their inspheres do, and are disjoint when their circumspheres are
+    OverlapReal rsq = dot(dr,dr);
+    OverlapReal RaRb = a.getInsphereRadius() + b.getInsphereRadius();
+    if (rsq <= RaRb*RaRb)
+        return true;
+    OverlapReal DaDb = a.getCircumsphereDiameter() + b.getCircumsphereDiameter();
+    if (rsq > DaDb*DaDb/OverlapReal(4.0))
+        return false;
+
     OverlapReal Ma[10], Mb[10];
     detail::compute_ellipsoid_matrix(Ma, vec3<OverlapReal>(0,0,0), quat<OverlapReal>(a.orientation), a.axes);
     detail::compute_ellipsoid_matrix(Mb, dr, quat<OverlapReal>(b.orientation), b.axes);
@@ -45,13 +45,13 @@ struct FacetedEllipsoidParams : ShapeParams
           additional_verts(),
           n(),
           offset(),
-          a(1.0), b(1.0), c(1.0), N(0), ignore(1)
+          a(1.0), b(1.0), c(1.0), N(0), ignore(1), insphere_radius(0.0)
         { }
 
     #ifndef __HIPCC__
     /// Construct a faceted ellipsoid with n_facet facets
     FacetedEllipsoidParams(unsigned int n_facet, bool managed )
-        : a(1.0), b(1.0), c(1.0), N(n_facet), ignore(0)
+        : a(1.0), b(1.0), c(1.0), N(n_facet), ignore(0), insphere_radius(0.0)
         {
         n = ManagedArray<vec3<OverlapReal> >(n_facet, managed);
         offset = ManagedArray<OverlapReal> (n_facet, managed);
@@ -275,6 +275,16 @@ struct FacetedEllipsoidParams : ShapeParams
                     }
                 }
             }
+
+        // the sphere inside both the ellipsoid and all half spaces
+        insphere_radius = detail::min(a, detail::min(b, c));
+        for (unsigned int i = 0; i < N; ++i)
+            {
+            OverlapReal n_norm = fast::sqrt(dot(n[i], n[i]));
+            if (n_norm > OverlapReal(0.0))
+                insphere_radius = detail::min(insphere_radius, -offset[i]/n_norm);
+            }
+        insphere_radius = detail::max(insphere_radius, OverlapReal(0.0));
         }
 
     #endif
@@ -309,6 +319,9 @@ struct FacetedEllipsoidParams : ShapeParams
     /// True when move statistics should not be counted
     unsigned int ignore;
 
+    /// Radius of the largest sphere around the center inside the shape, set by initializeVertices()
+    OverlapReal insphere_radius;
+
     DEVICE void load_shared(char *& ptr, unsigned int &available_bytes)
         {
         n.load_shared(ptr,available_bytes);
@@ -517,7 +530,7 @@ struct ShapeFacetedEllipsoid
     /// Get the in-sphere radius of the shape
     DEVICE OverlapReal getInsphereRadius() const
         {
-        return 0.0;
+        return params.insphere_radius;
         }
 
     /// Return the bounding box of the shape in world coordinates
@@ -599,8 +612,18 @@ DEVICE inline bool test_overlap<ShapeFacetedEllipsoid, ShapeFacetedEllipsoid>(co
     unsigned int& err, Scalar sweep_radius_a, Scalar sweep_radius_b)
     {
     vec3<OverlapReal> dr(r_ab);
+    OverlapReal rsq = dot(dr, dr);
+
+    // shapes overlap when their inspheres do, and are disjoint when their circumspheres are
+    OverlapReal RaRb = a.getInsphereRadius() + b.getInsphereRadius() + OverlapReal(sweep_radius_a + sweep_radius_b);
+    if (rsq <= RaRb*RaRb)
+        return true;
 
     OverlapReal DaDb = a.getCircumsphereDiameter() + b.getCircumsphereDiameter();
+    OverlapReal rmax = DaDb/OverlapReal(2.0) + OverlapReal(sweep_radius_a + sweep_radius_b);
+    if (rsq > rmax*rmax)
+        return false;
+
     return detail::xenocollide_3d(detail::SupportFuncFacetedEllipsoid(a.params, OverlapReal(sweep_radius_a)),
                            detail::SupportFuncFacetedEllipsoid(b.params, OverlapReal(sweep_radius_b)),
                            rotate(conj(quat<OverlapReal>(a.orientation)), dr + rotate(quat<OverlapReal>(b.orientation),b.params.origin))-a.params.origin,
@@ -40,6 +40,50 @@
 
 namespace hpmc
 {
+
+/** From Real-time Collision Detection (Christer Ericson)
+    Given ray pq and triangle abc, returns whether segment intersects
+    triangle and if so, also returns the barycentric coordinates (u,v,w)
+    of the intersection point
+    Note: the triangle is assumed to be oriented counter-clockwise when viewed from the direction of p
+*/
+DEVICE inline bool IntersectRayTriangle(const vec3<OverlapReal>& p, const vec3<OverlapReal>& q,
+     const vec3<OverlapReal>& a, const vec3<OverlapReal>& b, const vec3<OverlapReal>& c,
+    OverlapReal &u, OverlapReal &v, OverlapReal &w, OverlapReal &t)
+    {
+    vec3<OverlapReal> ab = b - a;
+    vec3<OverlapReal> ac = c - a;
+    vec3<OverlapReal> qp = p - q;
+    // Compute triangle normal. Can be precalculated or cached if
+    // intersecting multiple segments against the same triangle
+    vec3<OverlapReal> n = cross(ab, ac);
+    // Compute denominator d. If d <= 0, segment is parallel to or points
+    // away from triangle, so exit early
+    float d = dot(qp, n);
+    if (d <= OverlapReal(0.0)) return false;
+    // Compute intersection t value of pq with plane of triangle. A ray
+    // intersects iff 0 <= t. Segment intersects iff 0 <= t <= 1. Delay
+    // dividing by d until intersection has been found to pierce triangle
+    vec3<OverlapReal> ap = p - a;
+    t = dot(ap, n);
+    if (t < OverlapReal(0.0)) return false;
+    // For segment; exclude this code line for a ray test
+    // Compute barycentric coordinate components and test if within bounds
+    vec3<OverlapReal> e = cross(qp, ap);
+    v = dot(ac, e);
+    if (v < OverlapReal(0.0) || v > d) return false;
+    w = -dot(ab, e);
+    if (w < OverlapReal(0.0) || v + w > d) return false;
+    // Segment/ray intersects triangle. Perform delayed division and
+    // compute the last barycentric coordinate component
+    float ood = OverlapReal(1.0) / d;
+    t *= ood;
+    v *= ood;
+    w *= ood;
+    u = OverlapReal(1.0) - v - w;
+    return true;
+    }
+
 namespace detail
 {
 
@@ -56,7 +100,7 @@ struct TriangleMesh : ShapeParams
     {
     DEVICE TriangleMesh()
         : convex_hull_verts(), verts(), face_offs(),
-          face_verts(), face_overlap(), n_faces(0), ignore(0)
+          face_verts(), face_overlap(), n_faces(0), ignore(0), inner_radius(0), outer_radius(FLT_MAX)
         {
         };
 
@@ -68,7 +112,7 @@ struct TriangleMesh : ShapeParams
                  unsigned int n_face_verts_,
                  unsigned int n_hull_verts_,
                  bool managed)
-        : n_verts(n_verts_), n_faces(n_faces_), hull_only(0)
+        : n_verts(n_verts_), n_faces(n_faces_), hull_only(0), inner_radius(0), outer_radius(FLT_MAX)
         {
         convex_hull_verts = PolyhedronVertices(n_hull_verts_, managed);
         verts = ManagedArray<vec3<OverlapReal> >(n_verts, managed);
@@ -224,6 +268,50 @@ struct TriangleMesh : ShapeParams
 
         // set the diameter
         convex_hull_verts.diameter = 2*(sqrt(radius_sq)+sweep_radius);
+
+        computeOriginBounds();
+        }
+
+    /** Precompute the bounds of the containment test around the origin
+
+        Shapes are contained in each other when the origin of one is inside the mesh of the other. In place of
+        shooting a ray through the mesh for every pair, points that are further from #origin than the farthest
+        vertex are outside, and points closer to #origin than the nearest face are on the same side of the mesh as
+        #origin, which is tested once here.
+    */
+    void computeOriginBounds()
+        {
+        outer_radius = OverlapReal(0.0);
+        for (unsigned int i = 0; i < n_verts; i++)
+            {
+            vec3<OverlapReal> r = verts[i] - origin;
+            outer_radius = std::max(outer_radius, OverlapReal(sqrt(dot(r, r))));
+            }
+
+        // cast a ray in a direction unlikely to graze an edge and count the crossed faces
+        vec3<OverlapReal> n(OverlapReal(0.5773), OverlapReal(0.5778), OverlapReal(0.5769));
+        unsigned int n_overlap = 0;
+        OverlapReal min_dist_sq(FLT_MAX);
+        for (unsigned int i = 0; i < n_faces; i++)
+            {
+            unsigned int offs = face_offs[i];
+            if (face_offs[i+1] - offs < 3) continue;
+
+            vec3<OverlapReal> v_a = verts[face_verts[offs]];
+            vec3<OverlapReal> v_b = verts[face_verts[offs + 1]];
+            vec3<OverlapReal> v_c = verts[face_verts[offs + 2]];
+            vec3<OverlapReal> p = closestPointOnTriangle(origin, v_a, v_b, v_c);
+            min_dist_sq = std::min(min_dist_sq, dot(p - origin, p - origin));
+
+            OverlapReal u,v,w,t;
+            if (IntersectRayTriangle(origin, origin + n, v_a, v_b, v_c, u, v, w, t)
+                || IntersectRayTriangle(origin, origin + n, v_c, v_b, v_a, u, v, w, t))
+                {
+                n_overlap++;
+                }
+            }
+
+        inner_radius = (n_overlap % 2) ? OverlapReal(sqrt(min_dist_sq)) : OverlapReal(0.0);
         }
 
     /// Convert parameters to a python dictionary
@@ -308,6 +396,12 @@ struct TriangleMesh : ShapeParams
     /// If 1, only the hull of the shape is considered for overlaps
     unsigned int hull_only;
 
+    /// Radius of the sphere around the origin that is inside the mesh, 0 when the origin is outside
+    OverlapReal inner_radius;
+
+    /// Radius of the sphere around the origin that encloses the mesh
+    OverlapReal outer_radius;
+
     /// Radius of a sweeping sphere
     OverlapReal sweep_radius;
 
@@ -802,49 +896,6 @@ DEVICE inline bool test_narrow_phase_overlap( vec3<OverlapReal> dr,
     return false;
     }
 
-/** From Real-time Collision Detection (Christer Ericson)
-    Given ray pq and triangle abc, returns whether segment intersects
-    triangle and if so, also returns the barycentric coordinates (u,v,w)
-    of the intersection point
-    Note: the triangle is assumed to be oriented counter-clockwise when viewed from the direction of p
-*/
-DEVICE inline bool IntersectRayTriangle(const vec3<OverlapReal>& p, const vec3<OverlapReal>& q,
-     const vec3<OverlapReal>& a, const vec3<OverlapReal>& b, const vec3<OverlapReal>& c,
-    OverlapReal &u, OverlapReal &v, OverlapReal &w, OverlapReal &t)
-    {
-    vec3<OverlapReal> ab = b - a;
-    vec3<OverlapReal> ac = c - a;
-    vec3<OverlapReal> qp = p - q;
-    // Compute triangle normal. Can be precalculated or cached if
-    // intersecting multiple segments against the same triangle
-    vec3<OverlapReal> n = cross(ab, ac);
-    // Compute denominator d. If d <= 0, segment is parallel to or points
-    // away from triangle, so exit early
-    float d = dot(qp, n);
-    if (d <= OverlapReal(0.0)) return false;
-    // Compute intersection t value of pq with plane of triangle. A ray
-    // intersects iff 0 <= t. Segment intersects iff 0 <= t <= 1. Delay
-    // dividing by d until intersection has been found to pierce triangle
-    vec3<OverlapReal> ap = p - a;
-    t = dot(ap, n);
-    if (t < OverlapReal(0.0)) return false;
-    // For segment; exclude this code line for a ray test
-    // Compute barycentric coordinate components and test if within bounds
-    vec3<OverlapReal> e = cross(qp, ap);
-    v = dot(ac, e);
-    if (v < OverlapReal(0.0) || v > d) return false;
-    w = -dot(ab, e);
-    if (w < OverlapReal(0.0) || v + w > d) return false;
-    // Segment/ray intersects triangle. Perform delayed division and
-    // compute the last barycentric coordinate component
-    float ood = OverlapReal(1.0) / d;
-    t *= ood;
-    v *= ood;
-    w *= ood;
-    u = OverlapReal(1.0) - v - w;
-    return true;
-    }
-
 #ifndef __HIPCC__
 //! Traverse the bounding volume test tree recursively
 inline bool BVHCollision(const ShapePolyhedron& a, const ShapePolyhedron &b,
@@ -1031,6 +1082,15 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
             rotate(quat<OverlapReal>(a.orientation),a.data.origin);
         // rotate ray in coordinate system of shape s1
         p = rotate(conj(quat<OverlapReal>(s1.orientation)), p);
+
+        // points near the origin of s1 are classified without casting the ray
+        vec3<OverlapReal> r = p - s1.data.origin;
+        OverlapReal rsq = dot(r, r);
+        if (rsq < s1.data.inner_radius*s1.data.inner_radius)
+            return true;
+        if (rsq > s1.data.outer_radius*s1.data.outer_radius)
+            continue;
+
         n = rotate(conj(quat<OverlapReal>(s1.orientation)), n);
         if (ord != 0)
             {
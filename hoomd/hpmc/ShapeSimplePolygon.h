@@ -242,13 +242,16 @@ DEVICE inline bool test_simple_polygon_overlap(const PolygonVertices& a,
     quat<OverlapReal> ab_r = conj(qb) * qa;
     vec2<OverlapReal> ab_t = rotate(conj(qb), dr);
 
+    // rotations in the plane are 2x2 matrices, cheaper to apply to each vertex than the quaternion
+    rotmat2<OverlapReal> R(ab_r);
+
     // loop through all edges in a. As we loop through them, transform into b's coordinate system and do the checks
     // there
     unsigned int j = a.N-1;
-    vec2<OverlapReal> prev_a = rotate(ab_r, vec2<OverlapReal>(a.x[j], a.y[j])) - ab_t;
+    vec2<OverlapReal> prev_a = R * vec2<OverlapReal>(a.x[j], a.y[j]) - ab_t;
     for (unsigned int i = 0; i < a.N; i++)
         {
-        vec2<OverlapReal> cur_a = rotate(ab_r, vec2<OverlapReal>(a.x[i], a.y[i])) - ab_t;
+        vec2<OverlapReal> cur_a = R * vec2<OverlapReal>(a.x[i], a.y[i]) - ab_t;
 
         // check if this edge in a intersects any edge in b
         unsigned int k = b.N-1;
@@ -273,13 +276,13 @@ DEVICE inline bool test_simple_polygon_overlap(const PolygonVertices& a,
         prev_a = cur_a;
         }
 
-    // switch coordinate systems
-    ab_r = conj(ab_r);
+    // switch coordinate systems, the inverse rotation is the transpose
+    R = transpose(R);
     ab_t = rotate(conj(qa), -dr);
 
-    for (unsigned int i = 0; i < a.N; i++)
+    for (unsigned int i = 0; i < b.N; i++)
         {
-        vec2<OverlapReal> cur = rotate(ab_r, vec2<OverlapReal>(b.x[i], b.y[i])) - ab_t;
+        vec2<OverlapReal> cur = R * vec2<OverlapReal>(b.x[i], b.y[i]) - ab_t;
 
         // check if any vertex from b is in inside a
         if (is_inside(cur, a))
@@ -28,6 +28,11 @@ namespace detail
 /// Maximum number of sphere centers that
 const unsigned int MAX_SPHINX_SPHERE_CENTERS = 8;
 
+DEVICE inline OverlapReal initVolume(bool disjoint,
+                                     OverlapReal r[MAX_SPHINX_SPHERE_CENTERS],
+                                     int n,
+                                     OverlapReal d[MAX_SPHINX_SPHERE_CENTERS*(MAX_SPHINX_SPHERE_CENTERS-1)/2]);
+
 /** Sphinx particle parameters
 
     A Sphinx particle is represented by N spheres each with their own diameter.
@@ -60,6 +65,27 @@ struct SphinxParams : ShapeParams
     /// True when move statistics should not be counted
     unsigned int ignore;
 
+    /// Radius of each sphere, negative for negative spheres
+    OverlapReal r[MAX_SPHINX_SPHERE_CENTERS];
+
+    /// Squared radius of each sphere
+    OverlapReal R[MAX_SPHINX_SPHERE_CENTERS];
+
+    /// Sign of the radius of each sphere
+    int s[MAX_SPHINX_SPHERE_CENTERS];
+
+    /// Squared distance between every pair of spheres
+    OverlapReal D[MAX_SPHINX_SPHERE_CENTERS*(MAX_SPHINX_SPHERE_CENTERS-1)/2];
+
+    /// Distance with sign between every pair of spheres
+    OverlapReal d[MAX_SPHINX_SPHERE_CENTERS*(MAX_SPHINX_SPHERE_CENTERS-1)/2];
+
+    /// True when the shape is a positive sphere minus negative spheres that do not intersect each other
+    unsigned int disjoint;
+
+    /// Volume of the shape
+    OverlapReal volume;
+
     #ifdef ENABLE_HIP
     void set_memory_hint() const
         {
@@ -69,7 +95,7 @@ struct SphinxParams : ShapeParams
 
     #ifndef __HIPCC__
     /// Empty constructor
-    SphinxParams() : circumsphereDiameter(0.0), N(0), ignore(0)
+    SphinxParams() : circumsphereDiameter(0.0), N(0), ignore(0), disjoint(0), volume(0.0)
         {
         for (size_t i = 0; i < MAX_SPHINX_SPHERE_CENTERS; i++)
             {
@@ -119,6 +145,41 @@ struct SphinxParams : ShapeParams
 
         // set the diameter
         circumsphereDiameter = OverlapReal(2.0)*radius;
+
+        precompute();
+        }
+
+    /** Precompute the sphere radii, the distances between the spheres, and the volume
+
+        These depend only on the shape and are shared by every overlap check of particles of this type.
+    */
+    void precompute()
+        {
+        for (unsigned int i = 0; i < N; i++)
+            {
+            r[i] = diameter[i]/OverlapReal(2.0);
+            R[i] = r[i]*r[i];
+            s[i] = (r[i] < 0) ? -1 : 1;
+            }
+        for (unsigned int i = 0; i < N; i++)
+            {
+            for (unsigned int j = 0; j < i; j++)
+                {
+                D[(i-1)*i/2+j] = dot(center[i]-center[j], center[i]-center[j]);
+                d[(i-1)*i/2+j] = OverlapReal(s[i]*s[j])*sqrt(D[(i-1)*i/2+j]);
+                }
+            }
+        bool is_disjoint = ((N > 0) && (s[0] > 0));
+        if (is_disjoint)
+            for (unsigned int i = 1; i < N; i++)
+                {
+                if (s[i] > 0) is_disjoint = false;
+                if (is_disjoint)
+                    for (unsigned int j = 1; j < i; j++)
+                        if (!seq2(1,1,R[i],R[j],D[(i-1)*i/2+j])) is_disjoint = false;
+                }
+        disjoint = is_disjoint;
+        volume = initVolume(is_disjoint, r, N, d);
         }
 
     /// Convert parameters to a python dictionary
@@ -150,14 +211,6 @@ struct SphinxParams : ShapeParams
 
 }; // end namespace detail
 
-namespace detail
-    {
-    DEVICE inline OverlapReal initVolume(bool disjoint,
-                                         OverlapReal r[MAX_SPHINX_SPHERE_CENTERS],
-                                         int n,
-                                         OverlapReal d[MAX_SPHINX_SPHERE_CENTERS*(MAX_SPHINX_SPHERE_CENTERS-1)/2]);
-    }
-
 /** Sphinx shape
 
     Implement the HPMC shape interface for sphinx particles.
@@ -168,37 +221,13 @@ struct ShapeSphinx
     typedef detail::SphinxParams param_type;
 
     /// Construct a shape at a given orientation
+    /** The sphere radii, distances, and volume are precomputed per type in SphinxParams and referenced here
+    */
     DEVICE inline ShapeSphinx(const quat<Scalar>& _orientation, const param_type& _params)
-        : orientation(_orientation), convex(true), spheres(_params)
+        : orientation(_orientation), n(_params.N), convex(true), disjoint(_params.disjoint),
+          r(_params.r), R(_params.R), s(_params.s), u(_params.center), D(_params.D), d(_params.d),
+          radius(_params.circumsphereDiameter/OverlapReal(2.0)), volume(_params.volume), spheres(_params)
         {
-        volume = 0.0;
-        radius = spheres.circumsphereDiameter/OverlapReal(2.0);
-        n = spheres.N;
-        for(unsigned int i = 0; i<n;i++)
-            {
-            r[i] = spheres.diameter[i]/OverlapReal(2.0);
-            R[i] = r[i]*r[i];
-            s[i] = (r[i]<0) ? -1 : 1;
-            u[i] = spheres.center[i];
-            }
-        for(unsigned int i=0; i<n;i++)
-            {
-            for(unsigned int j=0; j<i; j++)
-                {
-                D[(i-1)*i/2+j] = dot(u[i]-u[j],u[i]-u[j]);
-                d[(i-1)*i/2+j] = OverlapReal(s[i]*s[j])*sqrt(D[(i-1)*i/2+j]);
-                }
-            }
-        disjoint = ((n > 0) && (s[0] > 0));
-        if(disjoint)
-            for(unsigned int i = 1; i < n; i++)
-                {
-                 if(s[i] > 0) disjoint = false;
-                 if(disjoint)
-                 for(unsigned int j = 1; j < i; j++)
-                    if(!detail::seq2(1,1,R[i],R[j],D[(i-1)*i/2+j])) disjoint = false;
-                }
-        volume = detail::initVolume(disjoint,r,n,d);
         }
 
     /// Check if the shape may be rotated
@@ -255,24 +284,22 @@ struct ShapeSphinx
     bool disjoint;
 
     /// radius of each sphere
-    OverlapReal r[detail::MAX_SPHINX_SPHERE_CENTERS];
+    const OverlapReal (&r)[detail::MAX_SPHINX_SPHERE_CENTERS];
 
     /// radius^2
-    OverlapReal R[detail::MAX_SPHINX_SPHERE_CENTERS];
+    const OverlapReal (&R)[detail::MAX_SPHINX_SPHERE_CENTERS];
 
     /// sign of radius of each sphere
-    int s[detail::MAX_SPHINX_SPHERE_CENTERS];
+    const int (&s)[detail::MAX_SPHINX_SPHERE_CENTERS];
 
     /// original center of each sphere
-    vec3<OverlapReal> u[detail::MAX_SPHINX_SPHERE_CENTERS];
-
-    //vec3<OverlapReal> v[MAX_SPHINX_SPHERE_CENTERS];
+    const vec3<OverlapReal> (&u)[detail::MAX_SPHINX_SPHERE_CENTERS];
 
     /// distance^2 between every pair of spheres
-    OverlapReal D[detail::MAX_SPHINX_SPHERE_CENTERS*(detail::MAX_SPHINX_SPHERE_CENTERS-1)/2];
+    const OverlapReal (&D)[detail::MAX_SPHINX_SPHERE_CENTERS*(detail::MAX_SPHINX_SPHERE_CENTERS-1)/2];
 
     /// distance with sign bet. every pair of spheres
-    OverlapReal d[detail::MAX_SPHINX_SPHERE_CENTERS*(detail::MAX_SPHINX_SPHERE_CENTERS-1)/2];
+    const OverlapReal (&d)[detail::MAX_SPHINX_SPHERE_CENTERS*(detail::MAX_SPHINX_SPHERE_CENTERS-1)/2];
 
     OverlapReal radius;
 
@@ -319,6 +346,14 @@ DEVICE inline bool test_overlap<ShapeSphinx,ShapeSphinx>(const vec3<Scalar>& r_a
     vec3<OverlapReal> x(0.0,0.0,0.0);
     vec3<OverlapReal> y(r_ab);
 
+    // both shapes lie inside their first sphere when it is positive
+    if ((p.n > 0) && (q.n > 0) && (p.s[0] > 0) && (q.s[0] > 0))
+        {
+        OverlapReal r_sum = p.r[0] + q.r[0];
+        if (detail::norm2(y + qv[0] - x - pv[0]) > r_sum*r_sum)
+            return false;
+        }
+
     if(p.disjoint && q.disjoint)
             {
             if((p.n == 1) && (q.n == 1))
@@ -0,0 +1,160 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "TunerMoveSize.h"
+
+#include <cmath>
+#include <limits>
+
+namespace hpmc
+    {
+TunerMoveSize::TunerMoveSize(std::shared_ptr<SystemDefinition> sysdef,
+                             std::shared_ptr<Trigger> trigger,
+                             std::shared_ptr<IntegratorHPMC> mc,
+                             pybind11::list moves,
+                             pybind11::list types,
+                             Scalar target,
+                             Scalar max_scale,
+                             Scalar gamma,
+                             Scalar tol)
+    : Tuner(sysdef, trigger), m_mc(mc), m_d_max(m_exec_conf), m_a_max(m_exec_conf), m_limits_changed(true)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing TunerMoveSize" << std::endl;
+
+    m_params.tune_d = false;
+    m_params.tune_a = false;
+    for (auto move : moves)
+        {
+        std::string name = move.cast<std::string>();
+        if (name == "d")
+            m_params.tune_d = true;
+        else if (name == "a")
+            m_params.tune_a = true;
+        else
+            throw std::domain_error("moves must be 'a' or 'd'");
+        }
+
+    for (auto type : types)
+        {
+        m_types.push_back(type.cast<std::string>());
+        }
+
+    setTarget(target);
+    setMaxScale(max_scale);
+    setGamma(gamma);
+    setTol(tol);
+    m_params.min_move = Scalar(1e-7);
+
+    unsigned int ntypes = m_pdata->getNTypes();
+    m_max_translation_move.resize(ntypes, std::numeric_limits<Scalar>::infinity());
+    m_max_rotation_move.resize(ntypes, std::numeric_limits<Scalar>::infinity());
+
+    // tune with the acceptance ratio of the moves made after construction
+    GPUArray<hpmc_counters_t>(1, m_exec_conf).swap(m_count_last);
+    ArrayHandle<hpmc_counters_t> h_count_last(m_count_last, access_location::host, access_mode::overwrite);
+    h_count_last.data[0] = m_mc->getCounters(0);
+    }
+
+TunerMoveSize::~TunerMoveSize()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying TunerMoveSize" << std::endl;
+    }
+
+void TunerMoveSize::update(unsigned int timestep)
+    {
+    if (m_prof)
+        m_prof->push("TunerMoveSize");
+    m_exec_conf->msg->notice(10) << "TunerMoveSize: " << timestep << std::endl;
+
+    if (m_limits_changed || m_d_max.size() != m_pdata->getNTypes())
+        updateLimits();
+
+    m_mc->tuneMoveSizes(m_params, m_d_max, m_a_max, m_count_last);
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+void TunerMoveSize::setMaxTranslationMove(std::string type_name, pybind11::object value)
+    {
+    unsigned int typ = m_pdata->getTypeByName(type_name);
+    m_max_translation_move.resize(m_pdata->getNTypes(), std::numeric_limits<Scalar>::infinity());
+    m_max_translation_move[typ] = value.is_none() ? std::numeric_limits<Scalar>::infinity() : value.cast<Scalar>();
+    m_limits_changed = true;
+    }
+
+pybind11::object TunerMoveSize::getMaxTranslationMove(std::string type_name)
+    {
+    unsigned int typ = m_pdata->getTypeByName(type_name);
+    if (typ >= m_max_translation_move.size() || std::isinf(m_max_translation_move[typ]))
+        return pybind11::none();
+    return pybind11::cast(m_max_translation_move[typ]);
+    }
+
+void TunerMoveSize::setMaxRotationMove(std::string type_name, pybind11::object value)
+    {
+    unsigned int typ = m_pdata->getTypeByName(type_name);
+    m_max_rotation_move.resize(m_pdata->getNTypes(), std::numeric_limits<Scalar>::infinity());
+    m_max_rotation_move[typ] = value.is_none() ? std::numeric_limits<Scalar>::infinity() : value.cast<Scalar>();
+    m_limits_changed = true;
+    }
+
+pybind11::object TunerMoveSize::getMaxRotationMove(std::string type_name)
+    {
+    unsigned int typ = m_pdata->getTypeByName(type_name);
+    if (typ >= m_max_rotation_move.size() || std::isinf(m_max_rotation_move[typ]))
+        return pybind11::none();
+    return pybind11::cast(m_max_rotation_move[typ]);
+    }
+
+/*! Types that are not in m_types get a limit of 0, which the controller reads as "do not tune".
+*/
+void TunerMoveSize::updateLimits()
+    {
+    unsigned int ntypes = m_pdata->getNTypes();
+    m_max_translation_move.resize(ntypes, std::numeric_limits<Scalar>::infinity());
+    m_max_rotation_move.resize(ntypes, std::numeric_limits<Scalar>::infinity());
+    m_d_max.resize(ntypes);
+    m_a_max.resize(ntypes);
+
+    ArrayHandle<Scalar> h_d_max(m_d_max, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_a_max(m_a_max, access_location::host, access_mode::overwrite);
+    for (unsigned int typ = 0; typ < ntypes; typ++)
+        {
+        h_d_max.data[typ] = Scalar(0.0);
+        h_a_max.data[typ] = Scalar(0.0);
+        }
+
+    for (const auto& name : m_types)
+        {
+        unsigned int typ = m_pdata->getTypeByName(name);
+        h_d_max.data[typ] = m_max_translation_move[typ];
+        h_a_max.data[typ] = m_max_rotation_move[typ];
+        }
+
+    m_limits_changed = false;
+    }
+
+void export_TunerMoveSize(pybind11::module& m)
+    {
+    pybind11::class_<TunerMoveSize, Tuner, std::shared_ptr<TunerMoveSize>>(m, "TunerMoveSize")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            std::shared_ptr<IntegratorHPMC>,
+                            pybind11::list,
+                            pybind11::list,
+                            Scalar,
+                            Scalar,
+                            Scalar,
+                            Scalar>())
+        .def_property("target", &TunerMoveSize::getTarget, &TunerMoveSize::setTarget)
+        .def_property("max_scale", &TunerMoveSize::getMaxScale, &TunerMoveSize::setMaxScale)
+        .def_property("gamma", &TunerMoveSize::getGamma, &TunerMoveSize::setGamma)
+        .def_property("tol", &TunerMoveSize::getTol, &TunerMoveSize::setTol)
+        .def("setMaxTranslationMove", &TunerMoveSize::setMaxTranslationMove)
+        .def("getMaxTranslationMove", &TunerMoveSize::getMaxTranslationMove)
+        .def("setMaxRotationMove", &TunerMoveSize::setMaxRotationMove)
+        .def("getMaxRotationMove", &TunerMoveSize::getMaxRotationMove);
+    }
+
+    } // end namespace hpmc
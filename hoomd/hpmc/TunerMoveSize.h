@@ -0,0 +1,167 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// inclusion guard
+#pragma once
+
+#include <hoomd/GPUVector.h>
+#include <hoomd/Tuner.h>
+
+#include "IntegratorHPMC.h"
+
+#include <pybind11/pybind11.h>
+
+#include <string>
+#include <vector>
+
+namespace hpmc
+    {
+/** Tune HPMC move sizes to a target acceptance ratio
+
+    TunerMoveSize scales the translation and rotation move sizes of the selected types by the ratio of the
+    acceptance ratio since the previous call and the target (see move_size_scale()). The controller itself runs in
+    IntegratorHPMC::tuneMoveSizes(), which the GPU integrators implement with a kernel that reads the counters and
+    writes the move sizes in device memory.
+*/
+class TunerMoveSize : public Tuner
+    {
+    public:
+    /** Constructor
+
+        @param sysdef System definition
+        @param trigger Select the timesteps on which to tune
+        @param mc HPMC integrator object
+        @param moves Moves to tune: "d" for translation and "a" for rotation
+        @param types Names of the types to tune
+        @param target Target acceptance ratio
+        @param max_scale Largest factor to scale a move size by in one step
+        @param gamma Damping added to the acceptance ratio and target
+        @param tol Leave move sizes unchanged when the acceptance ratio is within tol of the target
+    */
+    TunerMoveSize(std::shared_ptr<SystemDefinition> sysdef,
+                  std::shared_ptr<Trigger> trigger,
+                  std::shared_ptr<IntegratorHPMC> mc,
+                  pybind11::list moves,
+                  pybind11::list types,
+                  Scalar target,
+                  Scalar max_scale,
+                  Scalar gamma,
+                  Scalar tol);
+
+    /// Destructor
+    virtual ~TunerMoveSize();
+
+    /** Take one tuning step
+
+        @param timestep timestep at which update is being evaluated
+    */
+    virtual void update(unsigned int timestep);
+
+    /// Get the target acceptance ratio
+    Scalar getTarget()
+        {
+        return m_params.target;
+        }
+
+    /// Set the target acceptance ratio
+    void setTarget(Scalar target)
+        {
+        if (target <= 0 || target > 1.0)
+            {
+            throw std::domain_error("target must be in the range (0,1]");
+            }
+        m_params.target = target;
+        }
+
+    /// Get the largest scale factor
+    Scalar getMaxScale()
+        {
+        return m_params.max_scale;
+        }
+
+    /// Set the largest scale factor
+    void setMaxScale(Scalar max_scale)
+        {
+        if (max_scale <= 1.0)
+            {
+            throw std::domain_error("max_scale must be greater than 1");
+            }
+        m_params.max_scale = max_scale;
+        }
+
+    /// Get the damping
+    Scalar getGamma()
+        {
+        return m_params.gamma;
+        }
+
+    /// Set the damping
+    void setGamma(Scalar gamma)
+        {
+        if (gamma < 0)
+            {
+            throw std::domain_error("gamma must be non-negative");
+            }
+        m_params.gamma = gamma;
+        }
+
+    /// Get the tolerance
+    Scalar getTol()
+        {
+        return m_params.tol;
+        }
+
+    /// Set the tolerance
+    void setTol(Scalar tol)
+        {
+        m_params.tol = tol;
+        }
+
+    /// Set the largest translation move size of a type, None for no limit
+    void setMaxTranslationMove(std::string type_name, pybind11::object value);
+
+    /// Get the largest translation move size of a type
+    pybind11::object getMaxTranslationMove(std::string type_name);
+
+    /// Set the largest rotation move size of a type, None for no limit
+    void setMaxRotationMove(std::string type_name, pybind11::object value);
+
+    /// Get the largest rotation move size of a type
+    pybind11::object getMaxRotationMove(std::string type_name);
+
+    private:
+    /// HPMC integrator object
+    std::shared_ptr<IntegratorHPMC> m_mc;
+
+    /// Controller parameters
+    hpmc_move_size_tuner_params_t m_params;
+
+    /// Names of the tuned types
+    std::vector<std::string> m_types;
+
+    /// Largest translation move size set by the user, by type
+    std::vector<Scalar> m_max_translation_move;
+
+    /// Largest rotation move size set by the user, by type
+    std::vector<Scalar> m_max_rotation_move;
+
+    /// Largest translation move size passed to the controller, 0 for types that are not tuned
+    GPUVector<Scalar> m_d_max;
+
+    /// Largest rotation move size passed to the controller, 0 for types that are not tuned
+    GPUVector<Scalar> m_a_max;
+
+    /// Counters at the previous tuning step
+    GPUArray<hpmc_counters_t> m_count_last;
+
+    /// True when the limits need to be copied to m_d_max and m_a_max
+    bool m_limits_changed;
+
+    /// Fill m_d_max and m_a_max
+    void updateLimits();
+    };
+
+/// Export the TunerMoveSize class to python
+void export_TunerMoveSize(pybind11::module& m);
+
+    } // end namespace hpmc
@@ -23,63 +23,31 @@
 #include <tbb/concurrent_unordered_set.h>
 #include <tbb/concurrent_vector.h>
 #include <tbb/parallel_for.h>
-#include <tbb/task.h>
-#include <atomic>
 #endif
 
+#include <atomic>
+#include <memory>
+
 namespace hpmc
 {
 
 namespace detail
 {
 
-#ifdef ENABLE_TBB
-//! Wrapper around std::atomic_flag to allow use in a std::vector
-class my_atomic_flag
-    {
-    public:
-        //! Default constructor
-        my_atomic_flag()
-            {
-            f.clear();
-            }
-
-        //! Copy constructor
-        /*! \note this constructor doesn't really copy the value of its argument,
-            it just reset's the flag to zero
-         */
-        my_atomic_flag(const my_atomic_flag& other)
-            {
-            f.clear();
-            }
-
-        //! Assignment operator (non-atomic)
-        /*! \note this assignment operator doesn't really copy the value of its argument,
-            it just reset's the flag to zero
-         */
-        my_atomic_flag& operator =( const my_atomic_flag& other)
-            {
-            f.clear();
-            return *this;
-            }
-
-        //! Sets flag and returns old value
-        bool test_and_set()
-            {
-            return f.test_and_set();
-            }
-
-    private:
-        std::atomic_flag f;
-    };
-#endif
+//! Undirected graph that tracks its connected components
+/*! Graph stores the connected components of the graph in a disjoint set forest (union-find), instead of the edges.
+    addEdge() merges the components of its two vertices and connectedComponents() lists the vertices of each
+    component.
 
-// Graph class represents a undirected graph
-// using adjacency list representation
+    addEdge() is lock free and may be called concurrently from many threads: it links the root of the larger index
+    below the root of the smaller one with a compare and swap, and retries when another thread linked either root in
+    the meantime. find() halves the paths as it goes. As every vertex points to a smaller or equal index, the root of
+    each component is its smallest vertex, independent of the order in which edges are added.
+*/
 class Graph
     {
     public:
-        Graph() {}      //!< Default constructor
+        Graph() : m_V(0) {}      //!< Default constructor
 
         inline Graph(unsigned int V);   // Constructor
 
@@ -94,155 +62,116 @@ class Graph
         #endif
 
     private:
-        #ifndef ENABLE_TBB
-        std::multimap<unsigned int,unsigned int> adj;
-        #else
-        tbb::concurrent_unordered_multimap<unsigned int, unsigned int> adj;
-        #endif
-
-        #ifndef ENABLE_TBB
-        std::vector<unsigned int> visited;
-        #else
-        std::vector<my_atomic_flag> visited;
-        #endif
-
-        #ifndef ENABLE_TBB
-        // A function used by DFS
-        inline void DFSUtil(unsigned int v, std::vector<unsigned int>& visited, std::vector<unsigned int>& cur_cc);
-        #endif
-
-        #ifdef ENABLE_TBB
-        class DFSTask : public tbb::task
-            {
-            public:
-                DFSTask(unsigned int _root, std::vector<my_atomic_flag>& _visited,
-                    tbb::concurrent_vector<unsigned int>& _cc,
-                    const tbb::concurrent_unordered_multimap<unsigned int, unsigned int>& _adj)
-                    : root(_root), visited(_visited), cc(_cc), adj(_adj)
-                    { }
-
-                tbb::task* execute()
-                    {
-                    cc.push_back(root);
-
-                    unsigned int count = 0;
-                    tbb::task_list list;
-
-                    auto begin = adj.equal_range(root).first;
-                    auto end = adj.equal_range(root).second;
-
-                    for (auto it = begin; it != end; ++it)
-                        {
-                        unsigned int neighbor = it->second;
-                        if (!visited[neighbor].test_and_set())
-                            {
-                            if (count++ == 0)
-                                {
-                                root = neighbor; // for task recycling
-                                continue;
-                                }
-                            list.push_back(*new(allocate_child()) DFSTask(neighbor, visited, cc, adj));
-                            }
-                        }
-
-                    if (count)
-                        {
-                        set_ref_count(count);
-                        spawn(list);
-
-                        recycle_as_safe_continuation();
-                        }
-
-                    return NULL;
-                    }
-
-            private:
-                unsigned int root;
-                std::vector<my_atomic_flag> & visited;
-                tbb::concurrent_vector<unsigned int>& cc;
-                const tbb::concurrent_unordered_multimap<unsigned int, unsigned int>& adj;
-            };
-        #endif // ENABLE_TBB
+        std::unique_ptr<std::atomic<unsigned int>[]> m_parent; //!< Parent of each vertex in the forest
+        unsigned int m_V;                                       //!< Number of vertices
+        std::vector<unsigned int> m_root;                       //!< Root of each vertex, set by connectedComponents()
+        std::vector<unsigned int> m_component;                  //!< Component index of each root
 
+        //! Find the root of the component of a vertex
+        inline unsigned int find(unsigned int v);
     };
 
-// Gather connected components in an undirected graph
-#ifdef ENABLE_TBB
-void Graph::connectedComponents(std::vector<tbb::concurrent_vector<unsigned int> >& cc)
-#else
-void Graph::connectedComponents(std::vector<std::vector<unsigned int> >& cc)
-#endif
+Graph::Graph(unsigned int V)
+    : m_V(0)
     {
-    #ifdef ENABLE_TBB
-    for (unsigned int v = 0; v < visited.size(); ++v)
+    resize(V);
+    }
+
+//! Reset the graph to V vertices without edges
+void Graph::resize(unsigned int V)
+    {
+    if (V != m_V)
         {
-        if (! visited[v].test_and_set())
-            {
-            tbb::concurrent_vector<unsigned int> component;
-            DFSTask& a = *new(tbb::task::allocate_root()) DFSTask(v, visited, component, adj);
-            tbb::task::spawn_root_and_wait(a);
-            cc.push_back(component);
-            }
+        m_parent.reset(new std::atomic<unsigned int>[V]);
+        m_V = V;
         }
-    #else
-    std::fill(visited.begin(), visited.end(), 0);
 
-    // Depth first search
-    for (unsigned int v=0; v<visited.size(); v++)
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, V, [&](unsigned int v)
+    #else
+    for (unsigned int v = 0; v < V; ++v)
+    #endif
         {
-        if (visited[v] == false)
-            {
-            std::vector<unsigned int> cur_cc;
-            DFSUtil(v, visited, cur_cc);
-            cc.push_back(cur_cc);
-            }
+        m_parent[v].store(v, std::memory_order_relaxed);
         }
+    #ifdef ENABLE_TBB
+        );
     #endif
     }
 
-#ifndef ENABLE_TBB
-void Graph::DFSUtil(unsigned int v, std::vector<unsigned int>& visited, std::vector<unsigned int>& cur_cc)
+unsigned int Graph::find(unsigned int v)
     {
-    visited[v] = 1;
-    cur_cc.push_back(v);
-
-    // Recur for all the vertices
-    // adjacent to this vertex
-    auto begin = adj.equal_range(v).first;
-    auto end = adj.equal_range(v).second;
-    for(auto i = begin; i != end; ++i)
+    while (true)
         {
-        if(!visited[i->second])
-            DFSUtil(i->second, visited, cur_cc);
+        unsigned int p = m_parent[v].load(std::memory_order_relaxed);
+        if (p == v)
+            return v;
+
+        // path halving, any concurrent change of the parent also points to an ancestor
+        unsigned int gp = m_parent[p].load(std::memory_order_relaxed);
+        m_parent[v].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+        v = gp;
         }
     }
-#endif
-Graph::Graph(unsigned int V)
+
+// method to add an undirected edge
+void Graph::addEdge(unsigned int v, unsigned int w)
     {
-    #ifndef ENABLE_TBB
-    visited.resize(V, 0);
-    #else
-    visited.resize(V);
-    #endif
+    while (true)
+        {
+        v = find(v);
+        w = find(w);
+        if (v == w)
+            return;
+
+        // link the larger root below the smaller one
+        if (v < w)
+            std::swap(v, w);
+        unsigned int expected = v;
+        if (m_parent[v].compare_exchange_strong(expected, w))
+            return;
+        }
     }
 
-void Graph::resize(unsigned int V)
+/*! \param cc List of components to append to
+
+    The components are appended in the order of their smallest vertex, and list their vertices in increasing order.
+*/
+#ifdef ENABLE_TBB
+void Graph::connectedComponents(std::vector<tbb::concurrent_vector<unsigned int> >& cc)
+#else
+void Graph::connectedComponents(std::vector<std::vector<unsigned int> >& cc)
+#endif
     {
-    #ifndef ENABLE_TBB
-    visited.resize(V, 0);
+    m_root.resize(m_V);
+
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, m_V, [&](unsigned int v)
     #else
-    visited.clear();
-    visited.resize(V);
+    for (unsigned int v = 0; v < m_V; ++v)
+    #endif
+        {
+        m_root[v] = find(v);
+        }
+    #ifdef ENABLE_TBB
+        );
     #endif
 
-    adj.clear();
-    }
+    // number the components in the order of their roots
+    m_component.resize(m_V);
+    unsigned int offset = (unsigned int)cc.size();
+    unsigned int n_components = 0;
+    for (unsigned int v = 0; v < m_V; ++v)
+        {
+        if (m_root[v] == v)
+            m_component[v] = offset + n_components++;
+        }
 
-// method to add an undirected edge
-void Graph::addEdge(unsigned int v, unsigned int w)
-    {
-    adj.insert(std::make_pair(v,w));
-    adj.insert(std::make_pair(w,v));
+    cc.resize(offset + n_components);
+    for (unsigned int v = 0; v < m_V; ++v)
+        {
+        cc[m_component[m_root[v]]].push_back(v);
+        }
     }
 } // end namespace detail
 
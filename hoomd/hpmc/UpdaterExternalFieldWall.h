@@ -147,7 +147,10 @@ class __attribute__ ((visibility ("hidden"))) UpdaterExternalFieldWall : public
                 m_CurrPlanes = m_external->GetPlaneWalls();
 
                 // call back to python to update the external field
-                m_py_updater(timestep);
+                    {
+                    pybind11::gil_scoped_acquire acquire;
+                    m_py_updater(timestep);
+                    }
 
                 // the only thing that changed was the external field,
                 // not particle positions or orientations. so all we need to do is
@@ -161,7 +164,8 @@ class __attribute__ ((visibility ("hidden"))) UpdaterExternalFieldWall : public
                     }
                 else
                     {
-                    // restore the current copies of the walls
+                    // restore the current copies of the walls, the setters also flag the copies of the walls on
+                    // the GPU for an update before the next trial moves
                     m_external->SetSphereWalls(m_CurrSpheres);
                     m_external->SetCylinderWalls(m_CurrCylinders);
                     m_external->SetPlaneWalls(m_CurrPlanes);
@@ -48,14 +48,14 @@ void UpdaterQuickCompress::update(unsigned int timestep)
         m_prof->push("UpdaterQuickCompress");
     m_exec_conf->msg->notice(10) << "UpdaterQuickCompress: " << timestep << std::endl;
 
-    // count the number of overlaps in the current configuration
-    auto n_overlaps = m_mc->countOverlaps(false);
+    // test for overlaps in the current configuration
+    bool overlaps = m_mc->hasOverlaps();
     BoxDim current_box = m_pdata->getGlobalBox();
 
     // TODO: This slow. We will implement a general reusable fix later in #705
-    BoxDim target_box = m_target_box.attr("_cpp_obj").cast<BoxDim>();
+    BoxDim target_box = getTargetBoxDim();
 
-    if (n_overlaps == 0 && current_box != target_box)
+    if (!overlaps && current_box != target_box)
         {
         performBoxScale(timestep);
         }
@@ -64,7 +64,7 @@ void UpdaterQuickCompress::update(unsigned int timestep)
         m_prof->pop();
 
     // The compression is complete when we have reached the target box and there are no overlaps.
-    if (n_overlaps == 0 && current_box == target_box)
+    if (!overlaps && current_box == target_box)
         m_is_complete = true;
     else
         m_is_complete = false;
@@ -75,8 +75,21 @@ void UpdaterQuickCompress::performBoxScale(unsigned int timestep)
     auto new_box = getNewBox(timestep);
     auto old_box = m_pdata->getGlobalBox();
 
-    // Make a backup copy of position data
+    // Make a backup copy of position data, on the device when the integrator runs there
     unsigned int N_backup = m_pdata->getN();
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::read);
+        ArrayHandle<Scalar4> d_pos_backup(m_pos_backup,
+                                          access_location::device,
+                                          access_mode::overwrite);
+        hipMemcpy(d_pos_backup.data, d_pos.data, sizeof(Scalar4) * N_backup, hipMemcpyDeviceToDevice);
+        }
+    else
+#endif
         {
         ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
                                    access_location::host,
@@ -93,13 +106,26 @@ void UpdaterQuickCompress::performBoxScale(unsigned int timestep)
     if (n_overlaps > m_max_overlaps_per_particle * m_pdata->getNGlobal())
         {
         // the box move generated too many overlaps, undo the move
-        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::readwrite);
-        ArrayHandle<Scalar4> h_pos_backup(m_pos_backup, access_location::host, access_mode::read);
         unsigned int N = m_pdata->getN();
         assert(N == N_backup);
-        memcpy(h_pos.data, h_pos_backup.data, sizeof(Scalar4) * N);
+#ifdef ENABLE_HIP
+        if (m_exec_conf->isCUDAEnabled())
+            {
+            ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                       access_location::device,
+                                       access_mode::readwrite);
+            ArrayHandle<Scalar4> d_pos_backup(m_pos_backup, access_location::device, access_mode::read);
+            hipMemcpy(d_pos.data, d_pos_backup.data, sizeof(Scalar4) * N, hipMemcpyDeviceToDevice);
+            }
+        else
+#endif
+            {
+            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+            ArrayHandle<Scalar4> h_pos_backup(m_pos_backup, access_location::host, access_mode::read);
+            memcpy(h_pos.data, h_pos_backup.data, sizeof(Scalar4) * N);
+            }
         m_pdata->setGlobalBox(old_box);
 
         // we have moved particles, communicate those changes
@@ -162,7 +188,7 @@ BoxDim UpdaterQuickCompress::getNewBox(unsigned int timestep)
     double scale = uniform(rng);
 
     // TODO: This slow. We will implement a general reusable fix later in #705
-    BoxDim target_box = m_target_box.attr("_cpp_obj").cast<BoxDim>();
+    BoxDim target_box = getTargetBoxDim();
 
     // construct the scaled box
     BoxDim current_box = m_pdata->getGlobalBox();
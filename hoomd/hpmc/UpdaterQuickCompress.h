@@ -127,6 +127,14 @@ class UpdaterQuickCompress : public Updater
     /// The RNG seed
     unsigned int m_seed;
 
+    /// Read the target box from the Python object
+    BoxDim getTargetBoxDim()
+        {
+        // update() may run with the GIL released
+        pybind11::gil_scoped_acquire acquire;
+        return m_target_box.attr("_cpp_obj").cast<BoxDim>();
+        }
+
     /// hold backup copy of particle positions
     GPUArray<Scalar4> m_pos_backup;
 
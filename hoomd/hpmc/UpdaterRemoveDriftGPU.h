@@ -0,0 +1,143 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _REMOVE_DRIFT_UPDATER_GPU_H_
+#define _REMOVE_DRIFT_UPDATER_GPU_H_
+
+#ifdef ENABLE_HIP
+
+#include "hoomd/Autotuner.h"
+
+#include "UpdaterRemoveDrift.h"
+#include "ExternalFieldLatticeGPU.cuh"
+#include "IntegratorHPMCMonoGPU.cuh"
+
+/*! \file UpdaterRemoveDriftGPU.h
+    \brief Declaration of RemoveDriftUpdaterGPU
+    \note This header cannot be compiled by nvcc
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hpmc
+{
+
+//! Removes the drift of the particles from their lattice sites on the GPU
+/*! The displacements from the reference positions are summed with a device reduction, and the particles are
+    shifted back with the kernel of the grid shift. Only the total displacement is copied to the host.
+*/
+template<class Shape>
+class RemoveDriftUpdaterGPU : public RemoveDriftUpdater<Shape>
+    {
+    public:
+        //! Constructor
+        RemoveDriftUpdaterGPU(std::shared_ptr<SystemDefinition> sysdef,
+                              std::shared_ptr<ExternalFieldLattice<Shape> > externalLattice,
+                              std::shared_ptr<IntegratorHPMCMono<Shape> > mc)
+            : RemoveDriftUpdater<Shape>(sysdef, externalLattice, mc)
+            {
+            GPUArray<Scalar3> sum(1, this->m_exec_conf);
+            m_sum.swap(sum);
+
+            unsigned int warp_size = this->m_exec_conf->dev_prop.warpSize;
+            m_tuner.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000,
+                "hpmc_remove_drift", this->m_exec_conf));
+            }
+
+        //! Set autotuner parameters
+        /*! \param enable Enable/disable autotuning
+            \param period period (approximate) in time steps when returning occurs
+        */
+        virtual void setAutotunerParams(bool enable, unsigned int period)
+            {
+            m_tuner->setPeriod(period);
+            m_tuner->setEnabled(enable);
+            }
+
+        //! Take one timestep forward
+        virtual void update(unsigned int timestep)
+            {
+            const BoxDim& box = this->m_pdata->getGlobalBox();
+
+                {
+                ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(), access_location::device,
+                    access_mode::read);
+                ArrayHandle<unsigned int> d_tag(this->m_pdata->getTags(), access_location::device, access_mode::read);
+                ArrayHandle<Scalar3> d_r0(this->m_externalLattice->getReferenceLatticePositions(),
+                    access_location::device, access_mode::read);
+                ArrayHandle<Scalar3> d_sum(m_sum, access_location::device, access_mode::overwrite);
+
+                m_tuner->begin();
+                gpu::compute_lattice_drift(d_sum.data,
+                                           d_postype.data,
+                                           d_tag.data,
+                                           d_r0.data,
+                                           this->m_pdata->getN(),
+                                           box,
+                                           this->m_pdata->getOrigin(),
+                                           m_tuner->getParam(),
+                                           this->m_exec_conf->getCachedAllocator());
+                if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                    CHECK_CUDA_ERROR();
+                m_tuner->end();
+                }
+
+            Scalar3 rshift;
+                {
+                ArrayHandle<Scalar3> h_sum(m_sum, access_location::host, access_mode::read);
+                rshift = h_sum.data[0];
+                }
+
+            #ifdef ENABLE_MPI
+            if (this->m_pdata->getDomainDecomposition())
+                {
+                Scalar r[3] = {rshift.x, rshift.y, rshift.z};
+                MPI_Allreduce(MPI_IN_PLACE, &r[0], 3, MPI_HOOMD_SCALAR, MPI_SUM,
+                    this->m_exec_conf->getMPICommunicator());
+                rshift = make_scalar3(r[0], r[1], r[2]);
+                }
+            #endif
+
+            rshift /= Scalar(this->m_pdata->getNGlobal());
+
+                {
+                ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(), access_location::device,
+                    access_mode::readwrite);
+                ArrayHandle<int3> d_image(this->m_pdata->getImages(), access_location::device, access_mode::readwrite);
+
+                gpu::hpmc_shift(d_postype.data, d_image.data, this->m_pdata->getN(), box, -rshift, 128);
+                if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                    CHECK_CUDA_ERROR();
+                }
+
+            this->m_mc->invalidateAABBTree();
+            // migrate and exchange particles
+            this->m_mc->communicate(true);
+            }
+
+    protected:
+        GPUArray<Scalar3> m_sum;            //!< Total displacement of the local particles
+        std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for the displacement kernel block size
+    };
+
+//! Export the RemoveDriftUpdaterGPU class to python
+template <class Shape>
+void export_RemoveDriftUpdaterGPU(pybind11::module& m, std::string name)
+    {
+    pybind11::class_<RemoveDriftUpdaterGPU<Shape>, RemoveDriftUpdater<Shape>,
+                     std::shared_ptr<RemoveDriftUpdaterGPU<Shape> > >(m, name.c_str())
+    .def(pybind11::init< std::shared_ptr<SystemDefinition>,
+                         std::shared_ptr<ExternalFieldLattice<Shape> >,
+                         std::shared_ptr<IntegratorHPMCMono<Shape> > >())
+    ;
+    }
+
+} // namespace hpmc
+
+#endif // ENABLE_HIP
+
+#endif // _REMOVE_DRIFT_UPDATER_GPU_H_
@@ -0,0 +1,45 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "UpdaterReplicaExchangeFugacity.h"
+
+namespace hpmc
+    {
+UpdaterReplicaExchangeFugacity::UpdaterReplicaExchangeFugacity(std::shared_ptr<SystemDefinition> sysdef,
+                                                               std::shared_ptr<IntegratorHPMC> mc,
+                                                               const std::string& depletant_type,
+                                                               pybind11::list values,
+                                                               unsigned int seed)
+    : UpdaterReplicaExchange(sysdef, values, "fugacity", Scalar(1.0), std::shared_ptr<VariantConstant>(), seed),
+      m_mc(mc), m_depletant_type(m_pdata->getTypeByName(depletant_type))
+    {
+    m_exec_conf->msg->notice(5) << "Constructing UpdaterReplicaExchangeFugacity" << std::endl;
+
+    // the base class constructor runs before m_mc is set
+    applyValue(getValue());
+    }
+
+UpdaterReplicaExchangeFugacity::~UpdaterReplicaExchangeFugacity()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying UpdaterReplicaExchangeFugacity" << std::endl;
+    }
+
+void UpdaterReplicaExchangeFugacity::applyValue(Scalar value)
+    {
+    if (m_mc)
+        m_mc->setDepletantFugacity(m_depletant_type, value);
+    }
+
+void export_UpdaterReplicaExchangeFugacity(pybind11::module& m)
+    {
+    pybind11::class_<UpdaterReplicaExchangeFugacity,
+                     UpdaterReplicaExchange,
+                     std::shared_ptr<UpdaterReplicaExchangeFugacity>>(m, "UpdaterReplicaExchangeFugacity")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<IntegratorHPMC>,
+                            const std::string&,
+                            pybind11::list,
+                            unsigned int>());
+    }
+
+    } // end namespace hpmc
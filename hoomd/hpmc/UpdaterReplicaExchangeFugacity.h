@@ -0,0 +1,54 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// inclusion guard
+#pragma once
+
+#include <hoomd/UpdaterReplicaExchange.h>
+
+#include "IntegratorHPMC.h"
+
+#include <pybind11/pybind11.h>
+
+namespace hpmc
+    {
+/** Exchange depletant fugacities between MPI partitions
+
+    UpdaterReplicaExchangeFugacity exchanges the fugacity of one depletant type (see UpdaterReplicaExchange) and sets
+    it in the HPMC integrator on this partition.
+*/
+class UpdaterReplicaExchangeFugacity : public UpdaterReplicaExchange
+    {
+    public:
+    /** Constructor
+
+        @param sysdef System definition
+        @param mc HPMC integrator object
+        @param depletant_type Name of the depletant type
+        @param values Fugacity of each replica, one per partition
+        @param seed PRNG seed, must be the same on all partitions
+    */
+    UpdaterReplicaExchangeFugacity(std::shared_ptr<SystemDefinition> sysdef,
+                                   std::shared_ptr<IntegratorHPMC> mc,
+                                   const std::string& depletant_type,
+                                   pybind11::list values,
+                                   unsigned int seed);
+
+    /// Destructor
+    virtual ~UpdaterReplicaExchangeFugacity();
+
+    protected:
+    /// Set the depletant fugacity in the integrator
+    virtual void applyValue(Scalar value);
+
+    /// HPMC integrator object
+    std::shared_ptr<IntegratorHPMC> m_mc;
+
+    /// Depletant type
+    unsigned int m_depletant_type;
+    };
+
+/// Export the UpdaterReplicaExchangeFugacity class to python
+void export_UpdaterReplicaExchangeFugacity(pybind11::module& m);
+
+    } // end namespace hpmc
@@ -0,0 +1,215 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+#include "hoomd/BoxDim.h"
+
+#include "ShapeSphere.h"
+
+/*! \file WallData.h
+    \brief Plain wall data that ExternalFieldWall copies to the GPU
+*/
+
+// need to declare these functions with __host__ __device__ qualifiers when building in nvcc
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+namespace hpmc
+{
+
+//! Parameters of a sphere wall
+/*! SphereWall, CylinderWall, and PlaneWall hold the vertices they need to confine polyhedra in host memory.
+    The wall data structs only hold the parameters needed to confine spheres, so they can be stored in a
+    GlobalArray and read by the GPU kernels.
+*/
+struct SphereWallData
+    {
+    Scalar rsq;             //!< Squared radius
+    vec3<Scalar> origin;    //!< Center of the sphere
+    unsigned int inside;    //!< Nonzero if particles are confined inside the sphere
+    };
+
+//! Parameters of a cylinder wall
+struct CylinderWallData
+    {
+    Scalar rsq;                 //!< Squared radius
+    vec3<Scalar> origin;        //!< Center of the cylinder
+    vec3<Scalar> orientation;   //!< Unit vector along the axis of the cylinder
+    unsigned int inside;        //!< Nonzero if particles are confined inside the cylinder
+    };
+
+//! Parameters of a plane wall
+struct PlaneWallData
+    {
+    vec3<Scalar> normal;    //!< Unit normal n, pointing to the side where particles are confined
+    Scalar d;               //!< Offset of the plane n.r + d = 0
+    };
+
+//! Walls to apply in the GPU trial move kernel
+struct hpmc_walls_t
+    {
+    //! Default construct without walls
+    hpmc_walls_t()
+        : d_spheres(0), num_spheres(0), d_cylinders(0), num_cylinders(0), d_planes(0), num_planes(0),
+          origin(0, 0, 0)
+        {
+        }
+
+    const SphereWallData *d_spheres;        //!< Sphere walls
+    unsigned int num_spheres;               //!< Number of sphere walls
+    const CylinderWallData *d_cylinders;    //!< Cylinder walls
+    unsigned int num_cylinders;             //!< Number of cylinder walls
+    const PlaneWallData *d_planes;          //!< Plane walls
+    unsigned int num_planes;                //!< Number of plane walls
+    vec3<Scalar> origin;                    //!< Origin of the global box
+    BoxDim box;                             //!< Global simulation box
+
+    //! Test if there are any walls
+    HOSTDEVICE bool empty() const
+        {
+        return num_spheres == 0 && num_cylinders == 0 && num_planes == 0;
+        }
+    };
+
+//! Test if the walls on the GPU can confine a shape
+/*! Walls are only applied on the GPU to shapes that implement test_confined() for the wall data structs.
+*/
+template<class Shape>
+inline bool wallsSupportedOnGPU()
+    {
+    return false;
+    }
+
+template<>
+inline bool wallsSupportedOnGPU<ShapeSphere>()
+    {
+    return true;
+    }
+
+//! Shapes without a wall data test are not confined
+template<class Shape>
+HOSTDEVICE inline bool test_confined(const SphereWallData& wall, const Shape& shape, const vec3<Scalar>& position,
+    const vec3<Scalar>& box_origin, const BoxDim& box)
+    {
+    return true;
+    }
+
+template<class Shape>
+HOSTDEVICE inline bool test_confined(const CylinderWallData& wall, const Shape& shape, const vec3<Scalar>& position,
+    const vec3<Scalar>& box_origin, const BoxDim& box)
+    {
+    return true;
+    }
+
+template<class Shape>
+HOSTDEVICE inline bool test_confined(const PlaneWallData& wall, const Shape& shape, const vec3<Scalar>& position,
+    const vec3<Scalar>& box_origin, const BoxDim& box)
+    {
+    return true;
+    }
+
+// Spherical Walls and Spheres
+HOSTDEVICE inline bool test_confined(const SphereWallData& wall, const ShapeSphere& shape,
+    const vec3<Scalar>& position, const vec3<Scalar>& box_origin, const BoxDim& box)
+    {
+    Scalar3 t = vec_to_scalar3(position - box_origin);
+    t.x  = t.x - wall.origin.x;
+    t.y  = t.y - wall.origin.y;
+    t.z  = t.z - wall.origin.z;
+    vec3<Scalar> shifted_pos(box.minImage(t));
+
+    Scalar rxyz_sq = shifted_pos.x*shifted_pos.x + shifted_pos.y*shifted_pos.y + shifted_pos.z*shifted_pos.z; // distance from the container origin.
+    Scalar max_dist = sqrt(rxyz_sq) + (shape.getCircumsphereDiameter()/OverlapReal(2.0));
+    if (!wall.inside)
+      {
+      // if we must be outside the wall, subtract particle radius from min_dist
+      max_dist = sqrt(rxyz_sq) - (shape.getCircumsphereDiameter()/Scalar(2.0));
+      // if the particle radius is larger than the distance between the particle
+      // and the container, however, then ALWAYS check verts. this is equivalent
+      // to two particle circumspheres overlapping.
+      if (max_dist < 0)
+        {
+        max_dist = 0;
+        }
+      }
+
+    return wall.inside ? (wall.rsq > max_dist*max_dist) : (wall.rsq < max_dist*max_dist);
+    }
+
+// Cylindrical Walls and Spheres
+HOSTDEVICE inline bool test_confined(const CylinderWallData& wall, const ShapeSphere& shape,
+    const vec3<Scalar>& position, const vec3<Scalar>& box_origin, const BoxDim& box)
+    {
+    Scalar3 t = vec_to_scalar3(position - box_origin);
+    t.x = t.x - wall.origin.x;
+    t.y = t.y - wall.origin.y;
+    t.z = t.z - wall.origin.z;
+    vec3<Scalar> shifted_pos(box.minImage(t));
+
+    vec3<Scalar> dist_vec = cross(shifted_pos, wall.orientation); // find the component of the shifted position that is perpendicular to the normalized orientation vector
+    Scalar max_dist = sqrt(dot(dist_vec, dist_vec));
+    if (wall.inside) {max_dist += (shape.getCircumsphereDiameter()/Scalar(2.0));} // add the circumradius of the particle if the particle must be inside the wall
+    else
+      {
+      // subtract the circumradius of the particle if it must be outside the wall
+      max_dist -= (shape.getCircumsphereDiameter()/Scalar(2.0));
+      // if the particle radius is larger than the distance between the particle
+      // and the container, however, then ALWAYS check verts. this is equivalent
+      // to two particle circumspheres overlapping.
+      if (max_dist < 0)
+        {
+        max_dist = 0;
+        }
+      }
+
+    return wall.inside ? (wall.rsq > max_dist*max_dist) : (wall.rsq < max_dist*max_dist);
+    }
+
+// Plane Walls and Spheres
+HOSTDEVICE inline bool test_confined(const PlaneWallData& wall, const ShapeSphere& shape,
+    const vec3<Scalar>& position, const vec3<Scalar>& box_origin, const BoxDim& box)
+    {
+    Scalar3 t = vec_to_scalar3(position - box_origin);
+    vec3<Scalar> shifted_pos(box.minImage(t));
+    Scalar max_dist = dot(wall.normal, shifted_pos) + wall.d; // proj onto unit normal. (signed distance)
+    return (max_dist < 0) ? false :  0 < (max_dist - shape.getCircumsphereDiameter()/Scalar(2.0));
+    }
+
+//! Test if a particle is confined by all walls
+/*! \param walls Walls to test
+    \param shape Shape of the particle
+    \param position Position of the particle
+    \returns true if the particle satisfies the confinement condition of every wall
+*/
+template<class Shape>
+HOSTDEVICE inline bool test_confined(const hpmc_walls_t& walls, const Shape& shape, const vec3<Scalar>& position)
+    {
+    for (unsigned int i = 0; i < walls.num_spheres; i++)
+        {
+        if (!test_confined(walls.d_spheres[i], shape, position, walls.origin, walls.box))
+            return false;
+        }
+
+    for (unsigned int i = 0; i < walls.num_cylinders; i++)
+        {
+        if (!test_confined(walls.d_cylinders[i], shape, position, walls.origin, walls.box))
+            return false;
+        }
+
+    for (unsigned int i = 0; i < walls.num_planes; i++)
+        {
+        if (!test_confined(walls.d_planes[i], shape, position, walls.origin, walls.box))
+            return false;
+        }
+
+    return true;
+    }
+
+} // end namespace hpmc
@@ -2,6 +2,7 @@
 // This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
 
 #include "ComputeFreeVolumeGPU.cuh"
+#include "AnalyzerSDFGPU.cuh"
 #include "IntegratorHPMCMonoGPU.cuh"
 
 #include "ShapeConvexPolygon.h"
@@ -14,6 +15,8 @@ namespace detail
 //! HPMC kernels for ShapeConvexPolygon
 template hipError_t gpu_hpmc_free_volume<ShapeConvexPolygon>(const hpmc_free_volume_args_t &args,
                                                        const typename ShapeConvexPolygon::param_type *d_params);
+template hipError_t gpu_hpmc_sdf<ShapeConvexPolygon>(const hpmc_sdf_args_t &args,
+                                                     const typename ShapeConvexPolygon::param_type *d_params);
 }
 
 namespace gpu
@@ -26,6 +29,8 @@ template void hpmc_narrow_phase<ShapeConvexPolygon>(const hpmc_args_t& args, con
 template void hpmc_insert_depletants<ShapeConvexPolygon>(const hpmc_args_t& args, const hpmc_implicit_args_t& implicit_args, const ShapeConvexPolygon::param_type *params);
 //! Driver for kernel::hpmc_update_pdata()
 template void hpmc_update_pdata<ShapeConvexPolygon>(const hpmc_update_args_t& args, const ShapeConvexPolygon::param_type *params);
+//! Driver for kernel::hpmc_count_overlaps()
+template void hpmc_count_overlaps<ShapeConvexPolygon>(const hpmc_count_overlaps_args_t& args, const ShapeConvexPolygon::param_type *params);
 }
 
 } // end namespace hpmc
@@ -26,6 +26,8 @@ template void hpmc_narrow_phase<ShapePolyhedron>(const hpmc_args_t& args, const
 template void hpmc_insert_depletants<ShapePolyhedron>(const hpmc_args_t& args, const hpmc_implicit_args_t& implicit_args, const ShapePolyhedron::param_type *params);
 //! Driver for kernel::hpmc_update_pdata()
 template void hpmc_update_pdata<ShapePolyhedron>(const hpmc_update_args_t& args, const ShapePolyhedron::param_type *params);
+//! Driver for kernel::hpmc_count_overlaps()
+template void hpmc_count_overlaps<ShapePolyhedron>(const hpmc_count_overlaps_args_t& args, const ShapePolyhedron::param_type *params);
 }
 
 } // end namespace hpmc
@@ -2,6 +2,7 @@
 // This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
 
 #include "ComputeFreeVolumeGPU.cuh"
+#include "AnalyzerSDFGPU.cuh"
 #include "IntegratorHPMCMonoGPU.cuh"
 
 #include "ShapeSphinx.h"
@@ -15,6 +16,8 @@ namespace detail
 //! HPMC kernels for ShapeSphinx
 template hipError_t gpu_hpmc_free_volume<ShapeSphinx>(const hpmc_free_volume_args_t &args,
                                                        const typename ShapeSphinx::param_type *d_params);
+template hipError_t gpu_hpmc_sdf<ShapeSphinx>(const hpmc_sdf_args_t &args,
+                                              const typename ShapeSphinx::param_type *d_params);
 template hipError_t gpu_hpmc_update<ShapeSphinx>(const hpmc_args_t& args,
                                                   const typename ShapeSphinx::param_type *d_params);
 }
@@ -29,6 +32,8 @@ template void hpmc_narrow_phase<ShapeSphinx>(const hpmc_args_t& args, const Shap
 template void hpmc_insert_depletants<ShapeSphinx>(const hpmc_args_t& args, const hpmc_implicit_args_t& implicit_args, const ShapeSphinx::param_type *params);
 //! Driver for kernel::hpmc_update_pdata()
 template void hpmc_update_pdata<ShapeSphinx>(const hpmc_update_args_t& args, const ShapeSphinx::param_type *params);
+//! Driver for kernel::hpmc_count_overlaps()
+template void hpmc_count_overlaps<ShapeSphinx>(const hpmc_count_overlaps_args_t& args, const ShapeSphinx::param_type *params);
 }
 #endif
 } // end namespace hpmc
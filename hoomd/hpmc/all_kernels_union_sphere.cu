@@ -27,6 +27,8 @@ template void hpmc_narrow_phase<ShapeUnion<ShapeSphere> >(const hpmc_args_t& arg
 template void hpmc_insert_depletants<ShapeUnion<ShapeSphere> >(const hpmc_args_t& args, const hpmc_implicit_args_t& implicit_args, const ShapeUnion<ShapeSphere>::param_type *params);
 //! Driver for kernel::hpmc_update_pdata()
 template void hpmc_update_pdata<ShapeUnion<ShapeSphere> >(const hpmc_update_args_t& args, const ShapeUnion<ShapeSphere> ::param_type *params);
+//! Driver for kernel::hpmc_count_overlaps()
+template void hpmc_count_overlaps<ShapeUnion<ShapeSphere> >(const hpmc_count_overlaps_args_t& args, const ShapeUnion<ShapeSphere> ::param_type *params);
 }
 
 } // end namespace hpmc
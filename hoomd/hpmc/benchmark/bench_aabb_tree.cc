@@ -0,0 +1,81 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file bench_aabb_tree.cc
+    \brief Times the builds and queries of AABBTree
+
+    The workloads use `n` unit cubes placed uniformly at random in a cubic box at a number density of 0.8, as for the
+    particles of an HPMC simulation. The query workload finds the overlaps of every cube with the others.
+*/
+
+#include "hoomd/test/benchmark_config.h"
+
+#include "hoomd/AABBTree.h"
+
+#include <random>
+#include <stdlib.h>
+
+using namespace hpmc;
+using namespace hpmc::detail;
+using namespace hoomd::benchmark;
+
+//! Allocate a list of AABBs with the 32 byte alignment that AABBTree requires
+AABB *allocate_aabbs(unsigned int N)
+    {
+    void *ptr = nullptr;
+    if (posix_memalign(&ptr, 32, N*sizeof(AABB)))
+        throw std::runtime_error("Error allocating AABB memory");
+    return (AABB *)ptr;
+    }
+
+void bench_aabb_tree(Runner& runner)
+    {
+    unsigned int N = runner.getParam("n", 65536);
+
+    Scalar L = pow(Scalar(N) / Scalar(0.8), Scalar(1.0/3.0));
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<Scalar> coordinate(-L/Scalar(2.0), L/Scalar(2.0));
+
+    AABB *aabbs = allocate_aabbs(N);
+    for (unsigned int i = 0; i < N; ++i)
+        {
+        vec3<Scalar> pos(coordinate(engine), coordinate(engine), coordinate(engine));
+        aabbs[i] = AABB(pos - vec3<Scalar>(0.5, 0.5, 0.5), pos + vec3<Scalar>(0.5, 0.5, 0.5));
+        }
+
+    AABBTree tree;
+    AABB *build_aabbs = allocate_aabbs(N);
+
+    runner.run("aabb_tree_build", {{"n", N}}, N, [&]()
+        {
+        // buildTree() reorders its input
+        std::copy(aabbs, aabbs + N, build_aabbs);
+        tree.buildTree(build_aabbs, N);
+        });
+
+    runner.run("aabb_tree_build_morton", {{"n", N}}, N, [&]()
+        {
+        tree.buildTreeMorton(aabbs, N);
+        });
+
+    std::copy(aabbs, aabbs + N, build_aabbs);
+    tree.buildTree(build_aabbs, N);
+
+    std::vector<unsigned int> hits;
+    runner.run("aabb_tree_query", {{"n", N}}, N, [&]()
+        {
+        uint64_t num_hits = 0;
+        for (unsigned int i = 0; i < N; ++i)
+            {
+            hits.clear();
+            tree.query(hits, aabbs[i]);
+            num_hits += hits.size();
+            }
+        sink = sink + num_hits;
+        });
+
+    free(build_aabbs);
+    free(aabbs);
+    }
+
+HOOMD_BENCHMARK_MAIN(bench_aabb_tree)
@@ -0,0 +1,117 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file bench_shape_overlaps.cc
+    \brief Times the overlap checks of the HPMC shapes
+
+    Each workload calls test_overlap() on `pairs` pairs of shapes with random orientations, at random separations up
+    to 1.2 circumsphere diameters. The polyhedra have `vertices` random vertices on the unit sphere.
+*/
+
+#include "hoomd/test/benchmark_config.h"
+
+#include "hoomd/hpmc/ShapeSphere.h"
+#include "hoomd/hpmc/ShapeEllipsoid.h"
+#include "hoomd/hpmc/ShapeConvexPolyhedron.h"
+#include "hoomd/hpmc/ShapeSpheropolyhedron.h"
+
+#include <random>
+
+using namespace hpmc;
+using namespace hpmc::detail;
+using namespace hoomd::benchmark;
+
+//! Relative position and orientations of one pair of shapes
+struct ShapePair
+    {
+    vec3<Scalar> r_ij;  //!< Separation
+    quat<Scalar> o_i;   //!< Orientation of the first shape
+    quat<Scalar> o_j;   //!< Orientation of the second shape
+    };
+
+//! Generate random pairs of shapes
+std::vector<ShapePair> generate_pairs(unsigned int pairs, Scalar diameter)
+    {
+    std::mt19937 engine(42);
+    std::normal_distribution<Scalar> normal;
+    std::uniform_real_distribution<Scalar> distance(0, Scalar(1.2)*diameter);
+
+    auto random_quat = [&]()
+        {
+        quat<Scalar> q(normal(engine), vec3<Scalar>(normal(engine), normal(engine), normal(engine)));
+        return q * (Scalar(1.0)/sqrt(norm2(q)));
+        };
+
+    std::vector<ShapePair> result(pairs);
+    for (auto& pair : result)
+        {
+        vec3<Scalar> direction(normal(engine), normal(engine), normal(engine));
+        pair.r_ij = direction * (distance(engine)/sqrt(dot(direction, direction)));
+        pair.o_i = random_quat();
+        pair.o_j = random_quat();
+        }
+    return result;
+    }
+
+//! Check the overlaps of one shape over a list of pairs
+template<class Shape>
+void bench_shape(Runner& runner,
+                 const std::string& name,
+                 const std::map<std::string, unsigned int>& params,
+                 const typename Shape::param_type& shape_params,
+                 unsigned int pairs)
+    {
+    Shape shape(quat<Scalar>(), shape_params);
+    std::vector<ShapePair> shape_pairs = generate_pairs(pairs, shape.getCircumsphereDiameter());
+
+    runner.run(name, params, pairs, [&]()
+        {
+        unsigned int err_count = 0;
+        unsigned int overlaps = 0;
+        for (auto const& pair : shape_pairs)
+            {
+            Shape a(pair.o_i, shape_params);
+            Shape b(pair.o_j, shape_params);
+            overlaps += test_overlap(pair.r_ij, a, b, err_count);
+            }
+        sink = sink + overlaps;
+        });
+    }
+
+void bench_shape_overlaps(Runner& runner)
+    {
+    unsigned int pairs = runner.getParam("pairs", 1 << 18);
+    unsigned int num_vertices = runner.getParam("vertices", 32);
+
+    SphereParams sphere;
+    sphere.radius = 0.5;
+    sphere.ignore = 0;
+    sphere.isOriented = false;
+    bench_shape<ShapeSphere>(runner, "sphere", {{"pairs", pairs}}, sphere, pairs);
+
+    EllipsoidParams ellipsoid;
+    ellipsoid.x = 1.0;
+    ellipsoid.y = 0.5;
+    ellipsoid.z = 0.25;
+    ellipsoid.ignore = 0;
+    bench_shape<ShapeEllipsoid>(runner, "ellipsoid", {{"pairs", pairs}}, ellipsoid, pairs);
+
+    std::mt19937 engine(7);
+    std::normal_distribution<OverlapReal> normal;
+    std::vector< vec3<OverlapReal> > vlist(num_vertices);
+    for (auto& v : vlist)
+        {
+        v = vec3<OverlapReal>(normal(engine), normal(engine), normal(engine));
+        v = v / sqrt(dot(v, v));
+        }
+
+    PolyhedronVertices polyhedron(vlist, 0, 0);
+    bench_shape<ShapeConvexPolyhedron>(runner, "convex_polyhedron", {{"pairs", pairs}, {"vertices", num_vertices}},
+        polyhedron, pairs);
+
+    PolyhedronVertices spheropolyhedron(vlist, 0.1, 0);
+    bench_shape<ShapeSpheropolyhedron>(runner, "spheropolyhedron", {{"pairs", pairs}, {"vertices", num_vertices}},
+        spheropolyhedron, pairs);
+    }
+
+HOOMD_BENCHMARK_MAIN(bench_shape_overlaps)
@@ -326,6 +326,9 @@ class wall(_external):
     * Convex polyhedron particles: sphere walls, cylinder walls, plane walls
     * Convex spheropolyhedron particles: sphere walls
 
+    On the GPU, walls are supported for sphere particles, where the trial move
+    kernel rejects moves that leave the walls.
+
     Once initialized, the compute provides the following log quantities that can be logged via ``hoomd.analyze.log``:
 
     * **hpmc_wall_volume** : the volume associated with the intersection of implemented walls. This number is only meaningful
@@ -354,18 +357,17 @@ class wall(_external):
         cls = None;
         self.compute_name = "wall-"+str(wall.index)
         wall.index+=1
-        if not hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
-            if isinstance(mc, integrate.sphere):
-                cls = _hpmc.WallSphere;
-            elif isinstance(mc, integrate.convex_polyhedron):
-                cls = _hpmc.WallConvexPolyhedron;
-            elif isinstance(mc, integrate.convex_spheropolyhedron):
-                cls = _hpmc.WallSpheropolyhedron;
-            else:
-                hoomd.context.current.device.cpp_msg.error("compute.wall: Unsupported integrator.\n");
-                raise RuntimeError("Error initializing compute.wall");
+        if isinstance(mc, integrate.sphere):
+            cls = _hpmc.WallSphere;
+        elif hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
+            hoomd.context.current.device.cpp_msg.error("compute.wall: GPU only supports sphere integrators.\n")
+            raise RuntimeError("Error initializing compute.wall");
+        elif isinstance(mc, integrate.convex_polyhedron):
+            cls = _hpmc.WallConvexPolyhedron;
+        elif isinstance(mc, integrate.convex_spheropolyhedron):
+            cls = _hpmc.WallSpheropolyhedron;
         else:
-            hoomd.context.current.device.cpp_msg.error("GPU not supported yet")
+            hoomd.context.current.device.cpp_msg.error("compute.wall: Unsupported integrator.\n");
             raise RuntimeError("Error initializing compute.wall");
 
         self.cpp_compute = cls(hoomd.context.current.system_definition, mc.cpp_integrator);
@@ -921,6 +923,11 @@ class callback(_external):
         callback (`callable`): A python function to evaluate the energy of a configuration
         composite (bool): True if this evaluator is part of a composite external field
 
+    The callback is called with a snapshot of the whole system for every energy
+    evaluation, so the MC loop runs at the speed of python. Fields that are a
+    sum of energies of the individual particles run natively on the CPU and the
+    GPU with :py:class:`hoomd.jit.external.user`.
+
     Example::
 
           def energy(snapshot):
@@ -66,6 +66,46 @@ class HPMCIntegrator(BaseIntegrator):
     TODO: Describe implicit depletants algorithm. No need to write this now,
     as Jens is rewriting the implementation.
 
+    .. rubric:: Parallel trial moves on the CPU
+
+    When `checkerboard` is `True` and HOOMD is built with TBB, each of the
+    `nselect` sweeps divides the box into cells at least as wide as the largest
+    interaction range and makes the trial moves of cells that do not touch in
+    parallel threads, rejecting moves that leave the cell. The checkerboard
+    shifts randomly in every sweep. The integrator falls back to the serial
+    sweep with MPI domain decomposition, with depletants, with external
+    fields, and when the box is narrower than 4 cells along any direction.
+    `checkerboard_sweeps` counts the sweeps that ran in parallel. The
+    trajectory differs from the serial sweep with the same seed.
+
+    .. rubric:: MPI domain decomposition
+
+    With MPI domain decomposition, the ghost particles are exchanged once per
+    time step, not once per sweep. All `nselect` sweeps of a time step keep the
+    ghost particles fixed and reject trial moves of particles within one
+    interaction range of the domain boundaries, which freezes a boundary shell.
+    At the end of the time step, all particles are translated by a random
+    shift of at most half the interaction range along each direction before
+    they are migrated to their new domains. The shift is symmetric, which
+    preserves detailed balance, and moves the frozen shell so that every
+    particle can eventually move. Larger values of `nselect` therefore reduce
+    the number of ghost exchanges per trial move.
+
+    .. rubric:: Incremental overlap counts
+
+    Accepted trial moves never create overlaps. When `incremental_overlaps` is
+    `True`, each complete count of the overlaps records the overlapping
+    particles, and later counts check only those particles until the box, the
+    particle order, the number of particles, the shape parameters, or
+    `interaction_matrix` change. This makes `overlaps` and
+    `hoomd.hpmc.update.QuickCompress` cheap when few particles overlap. The
+    option has no effect with MPI domain decomposition.
+
+    Warning:
+        Assign `incremental_overlaps` again after changing particle positions
+        or orientations through local snapshots. This discards the record,
+        which may otherwise miss new overlaps.
+
     .. rubric:: Writing type_shapes to GSD files.
 
     Use a Logger in combination with a HPMC integrator and a GSD writer to write
@@ -103,6 +143,14 @@ class HPMCIntegrator(BaseIntegrator):
         nselect (int): Number of trial moves to perform per particle per
             timestep.
 
+        checkerboard (bool): When `True`, perform the trial moves on the CPU
+            in parallel over the cells of a checkerboard (**default:**
+            `False`).
+
+        incremental_overlaps (bool): When `True`, count overlaps only among
+            the particles that overlapped in the previous count when possible
+            (**default:** `False`).
+
         seed (int): Random number seed.
 
     .. rubric:: Attributes
@@ -117,7 +165,9 @@ class HPMCIntegrator(BaseIntegrator):
         param_dict = ParameterDict(
             seed=int(seed),
             translation_move_probability=float(translation_move_probability),
-            nselect=int(nselect))
+            nselect=int(nselect),
+            checkerboard=False,
+            incremental_overlaps=False)
         self._param_dict.update(param_dict)
 
         # Set standard typeparameters for hpmc integrators
@@ -243,6 +293,17 @@ class HPMCIntegrator(BaseIntegrator):
         self._cpp_obj.communicate(True)
         return self._cpp_obj.countOverlaps(False)
 
+    @log
+    def checkerboard_sweeps(self):
+        """int: Number of sweeps made in parallel over the checkerboard cells.
+
+        The count starts at 0 when the integrator is attached. Sweeps that fall
+        back to the serial sweep are not counted.
+        """
+        if not self._attached:
+            return None
+        return self._cpp_obj.checkerboard_sweeps
+
     def test_overlap(self,
                      type_i,
                      type_j,
@@ -20,6 +20,8 @@
 #include "UpdaterBoxMC.h"
 #include "UpdaterClusters.h"
 #include "UpdaterQuickCompress.h"
+#include "UpdaterReplicaExchangeFugacity.h"
+#include "TunerMoveSize.h"
 
 #include "GPUTree.h"
 
@@ -61,6 +63,8 @@ PYBIND11_MODULE(_hpmc, m)
 
     export_UpdaterBoxMC(m);
     export_UpdaterQuickCompress(m);
+    export_UpdaterReplicaExchangeFugacity(m);
+    export_TunerMoveSize(m);
     export_external_fields(m);
 
     export_sphere(m);
@@ -24,6 +24,9 @@
 #ifdef ENABLE_HIP
 #include "IntegratorHPMCMonoGPU.h"
 #include "ComputeFreeVolumeGPU.h"
+#include "ExternalFieldLatticeGPU.h"
+#include "UpdaterRemoveDriftGPU.h"
+#include "AnalyzerSDFGPU.h"
 #endif
 
 
@@ -57,6 +60,9 @@ void export_convex_polygon(py::module& m)
     #ifdef ENABLE_HIP
     export_IntegratorHPMCMonoGPU< ShapeConvexPolygon >(m, "IntegratorHPMCMonoConvexPolygonGPU");
     export_ComputeFreeVolumeGPU< ShapeConvexPolygon >(m, "ComputeFreeVolumeConvexPolygonGPU");
+    export_LatticeFieldGPU<ShapeConvexPolygon>(m, "ExternalFieldLatticeConvexPolygonGPU");
+    export_RemoveDriftUpdaterGPU<ShapeConvexPolygon>(m, "RemoveDriftUpdaterConvexPolygonGPU");
+    export_AnalyzerSDFGPU< ShapeConvexPolygon >(m, "AnalyzerSDFConvexPolygonGPU");
     #endif
     }
 
@@ -24,6 +24,9 @@
 #ifdef ENABLE_HIP
 #include "IntegratorHPMCMonoGPU.h"
 #include "ComputeFreeVolumeGPU.h"
+#include "ExternalFieldLatticeGPU.h"
+#include "UpdaterRemoveDriftGPU.h"
+#include "AnalyzerSDFGPU.h"
 #endif
 
 
@@ -58,6 +61,9 @@ void export_convex_polyhedron(py::module& m)
 
     export_IntegratorHPMCMonoGPU< ShapeConvexPolyhedron >(m, "IntegratorHPMCMonoConvexPolyhedronGPU");
     export_ComputeFreeVolumeGPU< ShapeConvexPolyhedron >(m, "ComputeFreeVolumeConvexPolyhedronGPU");
+    export_LatticeFieldGPU<ShapeConvexPolyhedron>(m, "ExternalFieldLatticeConvexPolyhedronGPU");
+    export_RemoveDriftUpdaterGPU<ShapeConvexPolyhedron>(m, "RemoveDriftUpdaterConvexPolyhedronGPU");
+    export_AnalyzerSDFGPU< ShapeConvexPolyhedron >(m, "AnalyzerSDFConvexPolyhedronGPU");
 
     #endif
     }
@@ -24,6 +24,9 @@
 #ifdef ENABLE_HIP
 #include "IntegratorHPMCMonoGPU.h"
 #include "ComputeFreeVolumeGPU.h"
+#include "ExternalFieldLatticeGPU.h"
+#include "UpdaterRemoveDriftGPU.h"
+#include "AnalyzerSDFGPU.h"
 #endif
 
 
@@ -58,6 +61,9 @@ void export_convex_spheropolyhedron(py::module& m)
 
     export_IntegratorHPMCMonoGPU< ShapeSpheropolyhedron >(m, "IntegratorHPMCMonoSpheropolyhedronGPU");
     export_ComputeFreeVolumeGPU< ShapeSpheropolyhedron >(m, "ComputeFreeVolumeSpheropolyhedronGPU");
+    export_LatticeFieldGPU<ShapeSpheropolyhedron>(m, "ExternalFieldLatticeSpheropolyhedronGPU");
+    export_RemoveDriftUpdaterGPU<ShapeSpheropolyhedron>(m, "RemoveDriftUpdaterSpheropolyhedronGPU");
+    export_AnalyzerSDFGPU< ShapeSpheropolyhedron >(m, "AnalyzerSDFSpheropolyhedronGPU");
 
     #endif
     }
@@ -24,6 +24,9 @@
 #ifdef ENABLE_HIP
 #include "IntegratorHPMCMonoGPU.h"
 #include "ComputeFreeVolumeGPU.h"
+#include "ExternalFieldLatticeGPU.h"
+#include "UpdaterRemoveDriftGPU.h"
+#include "AnalyzerSDFGPU.h"
 #endif
 
 namespace py = pybind11;
@@ -54,6 +57,9 @@ void export_ellipsoid(py::module& m)
     #ifdef ENABLE_HIP
     export_IntegratorHPMCMonoGPU< ShapeEllipsoid >(m, "IntegratorHPMCMonoEllipsoidGPU");
     export_ComputeFreeVolumeGPU< ShapeEllipsoid >(m, "ComputeFreeVolumeEllipsoidGPU");
+    export_LatticeFieldGPU<ShapeEllipsoid>(m, "ExternalFieldLatticeEllipsoidGPU");
+    export_RemoveDriftUpdaterGPU<ShapeEllipsoid>(m, "RemoveDriftUpdaterEllipsoidGPU");
+    export_AnalyzerSDFGPU< ShapeEllipsoid >(m, "AnalyzerSDFEllipsoidGPU");
     #endif
     }
 
@@ -23,6 +23,9 @@
 #ifdef ENABLE_HIP
 #include "IntegratorHPMCMonoGPU.h"
 #include "ComputeFreeVolumeGPU.h"
+#include "ExternalFieldLatticeGPU.h"
+#include "UpdaterRemoveDriftGPU.h"
+#include "AnalyzerSDFGPU.h"
 #endif
 
 
@@ -56,6 +59,9 @@ void export_faceted_ellipsoid(py::module& m)
     #ifdef ENABLE_HIP
     export_IntegratorHPMCMonoGPU< ShapeFacetedEllipsoid >(m, "IntegratorHPMCMonoFacetedEllipsoidGPU");
     export_ComputeFreeVolumeGPU< ShapeFacetedEllipsoid >(m, "ComputeFreeVolumeFacetedEllipsoidGPU");
+    export_LatticeFieldGPU<ShapeFacetedEllipsoid>(m, "ExternalFieldLatticeFacetedEllipsoidGPU");
+    export_RemoveDriftUpdaterGPU<ShapeFacetedEllipsoid>(m, "RemoveDriftUpdaterFacetedEllipsoidGPU");
+    export_AnalyzerSDFGPU< ShapeFacetedEllipsoid >(m, "AnalyzerSDFFacetedEllipsoidGPU");
     #endif
     }
 
@@ -24,6 +24,8 @@
 #ifdef ENABLE_HIP
 #include "IntegratorHPMCMonoGPU.h"
 #include "ComputeFreeVolumeGPU.h"
+#include "ExternalFieldLatticeGPU.h"
+#include "UpdaterRemoveDriftGPU.h"
 #endif
 
 namespace py = pybind11;
@@ -54,6 +56,8 @@ void export_polyhedron(py::module& m)
     #ifdef ENABLE_HIP
     export_IntegratorHPMCMonoGPU< ShapePolyhedron >(m, "IntegratorHPMCMonoPolyhedronGPU");
     export_ComputeFreeVolumeGPU< ShapePolyhedron >(m, "ComputeFreeVolumePolyhedronGPU");
+    export_LatticeFieldGPU<ShapePolyhedron>(m, "ExternalFieldLatticePolyhedronGPU");
+    export_RemoveDriftUpdaterGPU<ShapePolyhedron>(m, "RemoveDriftUpdaterPolyhedronGPU");
     #endif
     }
 
@@ -24,6 +24,9 @@
 #ifdef ENABLE_HIP
 #include "IntegratorHPMCMonoGPU.h"
 #include "ComputeFreeVolumeGPU.h"
+#include "ExternalFieldLatticeGPU.h"
+#include "UpdaterRemoveDriftGPU.h"
+#include "AnalyzerSDFGPU.h"
 #endif
 
 
@@ -57,6 +60,9 @@ void export_simple_polygon(py::module& m)
     #ifdef ENABLE_HIP
     export_IntegratorHPMCMonoGPU< ShapeSimplePolygon >(m, "IntegratorHPMCMonoSimplePolygonGPU");
     export_ComputeFreeVolumeGPU< ShapeSimplePolygon >(m, "ComputeFreeVolumeSimplePolygonGPU");
+    export_LatticeFieldGPU<ShapeSimplePolygon>(m, "ExternalFieldLatticeSimplePolygonGPU");
+    export_RemoveDriftUpdaterGPU<ShapeSimplePolygon>(m, "RemoveDriftUpdaterSimplePolygonGPU");
+    export_AnalyzerSDFGPU< ShapeSimplePolygon >(m, "AnalyzerSDFSimplePolygonGPU");
     #endif
     }
 
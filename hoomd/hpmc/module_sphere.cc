@@ -24,6 +24,9 @@
 #ifdef ENABLE_HIP
 #include "IntegratorHPMCMonoGPU.h"
 #include "ComputeFreeVolumeGPU.h"
+#include "ExternalFieldLatticeGPU.h"
+#include "UpdaterRemoveDriftGPU.h"
+#include "AnalyzerSDFGPU.h"
 #endif
 
 namespace py = pybind11;
@@ -54,6 +57,9 @@ void export_sphere(py::module& m)
     #ifdef ENABLE_HIP
     export_IntegratorHPMCMonoGPU< ShapeSphere >(m, "IntegratorHPMCMonoSphereGPU");
     export_ComputeFreeVolumeGPU< ShapeSphere >(m, "ComputeFreeVolumeSphereGPU");
+    export_LatticeFieldGPU<ShapeSphere>(m, "ExternalFieldLatticeSphereGPU");
+    export_RemoveDriftUpdaterGPU<ShapeSphere>(m, "RemoveDriftUpdaterSphereGPU");
+    export_AnalyzerSDFGPU< ShapeSphere >(m, "AnalyzerSDFSphereGPU");
     #endif
     }
 
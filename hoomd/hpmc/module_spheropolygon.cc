@@ -24,6 +24,9 @@
 #ifdef ENABLE_HIP
 #include "IntegratorHPMCMonoGPU.h"
 #include "ComputeFreeVolumeGPU.h"
+#include "ExternalFieldLatticeGPU.h"
+#include "UpdaterRemoveDriftGPU.h"
+#include "AnalyzerSDFGPU.h"
 #endif
 
 namespace py = pybind11;
@@ -54,6 +57,9 @@ void export_spheropolygon(py::module& m)
     #ifdef ENABLE_HIP
     export_IntegratorHPMCMonoGPU< ShapeSpheropolygon >(m, "IntegratorHPMCMonoSpheropolygonGPU");
     export_ComputeFreeVolumeGPU< ShapeSpheropolygon >(m, "ComputeFreeVolumeSpheropolygonGPU");
+    export_LatticeFieldGPU<ShapeSpheropolygon>(m, "ExternalFieldLatticeSpheropolygonGPU");
+    export_RemoveDriftUpdaterGPU<ShapeSpheropolygon>(m, "RemoveDriftUpdaterSpheropolygonGPU");
+    export_AnalyzerSDFGPU< ShapeSpheropolygon >(m, "AnalyzerSDFSpheropolygonGPU");
     #endif
     }
 
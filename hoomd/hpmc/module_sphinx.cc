@@ -24,6 +24,9 @@
 #ifdef ENABLE_HIP
 #include "IntegratorHPMCMonoGPU.h"
 #include "ComputeFreeVolumeGPU.h"
+#include "ExternalFieldLatticeGPU.h"
+#include "UpdaterRemoveDriftGPU.h"
+#include "AnalyzerSDFGPU.h"
 #endif
 
 namespace py = pybind11;
@@ -56,6 +59,9 @@ void export_sphinx(py::module& m)
 
     export_IntegratorHPMCMonoGPU< ShapeSphinx >(m, "IntegratorHPMCMonoSphinxGPU");
     export_ComputeFreeVolumeGPU< ShapeSphinx >(m, "ComputeFreeVolumeSphinxGPU");
+    export_LatticeFieldGPU<ShapeSphinx>(m, "ExternalFieldLatticeSphinxGPU");
+    export_RemoveDriftUpdaterGPU<ShapeSphinx>(m, "RemoveDriftUpdaterSphinxGPU");
+    export_AnalyzerSDFGPU< ShapeSphinx >(m, "AnalyzerSDFSphinxGPU");
 
     #endif
     #endif
@@ -23,6 +23,8 @@
 #ifdef ENABLE_HIP
 #include "IntegratorHPMCMonoGPU.h"
 #include "ComputeFreeVolumeGPU.h"
+#include "ExternalFieldLatticeGPU.h"
+#include "UpdaterRemoveDriftGPU.h"
 #endif
 
 namespace py = pybind11;
@@ -55,6 +57,8 @@ void export_union_sphere(py::module& m)
 
     export_IntegratorHPMCMonoGPU< ShapeUnion<ShapeSphere> >(m, "IntegratorHPMCMonoSphereUnionGPU");
     export_ComputeFreeVolumeGPU< ShapeUnion<ShapeSphere> >(m, "ComputeFreeVolumeSphereUnionGPU");
+    export_LatticeFieldGPU<ShapeUnion<ShapeSphere> >(m, "ExternalFieldLatticeSphereUnionGPU");
+    export_RemoveDriftUpdaterGPU<ShapeUnion<ShapeSphere> >(m, "RemoveDriftUpdaterSphereUnionGPU");
 
     #endif
     }
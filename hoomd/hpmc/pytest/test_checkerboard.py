@@ -0,0 +1,61 @@
+# Copyright (c) 2009-2019 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Test the checkerboard parallel trial move sweep."""
+
+import hoomd
+import pytest
+import numpy
+
+
+def _run_sweeps(simulation_factory, snap, checkerboard, steps):
+    """Run hard spheres and return the integrator and the translate moves."""
+    sim = simulation_factory(snap)
+    mc = hoomd.hpmc.integrate.Sphere(seed=1, d=0.1)
+    mc.shape['A'] = dict(diameter=1.0)
+    mc.checkerboard = checkerboard
+    sim.operations.integrator = mc
+
+    translate_moves = numpy.zeros(2, dtype=numpy.uint64)
+
+    for i in range(steps // 10):
+        sim.run(10)
+        assert mc.overlaps == 0
+        translate_moves += numpy.array(mc.translate_moves, dtype=numpy.uint64)
+
+    return mc, translate_moves
+
+
+@pytest.mark.serial
+@pytest.mark.cpu
+@pytest.mark.skipif(not hoomd.version.tbb_enabled,
+                    reason="The checkerboard sweep needs TBB")
+@pytest.mark.parametrize("dimensions", [2, 3])
+def test_checkerboard(simulation_factory, lattice_snapshot_factory,
+                      dimensions):
+    """Check that the checkerboard sweep runs and matches the serial sweep.
+
+    The checkerboard sweep rejects the moves that leave a cell, so it accepts
+    somewhat fewer moves than the serial sweep, but not many fewer.
+    """
+    snap = lattice_snapshot_factory(dimensions=dimensions, a=1.2, n=10)
+    steps = 200
+
+    mc, moves = _run_sweeps(simulation_factory, snap, True, steps)
+    assert mc.checkerboard
+    assert mc.checkerboard_sweeps == steps * mc.nselect
+    assert moves[0] > 0
+    assert moves[1] > 0
+
+    mc_serial, moves_serial = _run_sweeps(simulation_factory, snap, False,
+                                          steps)
+    assert mc_serial.checkerboard_sweeps == 0
+
+    # both sweeps attempt the same number of moves
+    assert sum(moves) == sum(moves_serial)
+
+    acceptance = moves[0] / sum(moves)
+    acceptance_serial = moves_serial[0] / sum(moves_serial)
+    assert acceptance < acceptance_serial + 0.01
+    assert acceptance > 0.75 * acceptance_serial
@@ -0,0 +1,38 @@
+# Copyright (c) 2009-2019 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Test incremental overlap counting."""
+
+import hoomd
+import pytest
+
+
+@pytest.mark.serial
+@pytest.mark.cpu
+def test_incremental_overlaps(simulation_factory, lattice_snapshot_factory):
+    """Check that incremental counts match full counts as overlaps resolve."""
+    snap = lattice_snapshot_factory(dimensions=3, a=0.95, n=4)
+
+    sim = simulation_factory(snap)
+    mc = hoomd.hpmc.integrate.Sphere(seed=1, d=0.05)
+    mc.shape['A'] = dict(diameter=1.0)
+    mc.incremental_overlaps = True
+    sim.operations.integrator = mc
+    sim.run(0)
+
+    last = mc.overlaps
+    assert last > 0
+
+    for i in range(10):
+        # a complete count records the overlapping particles
+        mc.incremental_overlaps = True
+        assert mc.overlaps == last
+
+        sim.run(10)
+        incremental = mc.overlaps
+        assert incremental <= last
+
+        mc.incremental_overlaps = False
+        assert mc.overlaps == incremental
+        last = incremental
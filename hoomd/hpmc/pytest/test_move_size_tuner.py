@@ -3,7 +3,7 @@ import pytest
 
 from hoomd import hpmc
 from hoomd.hpmc.tune.move_size import (
-    _MoveSizeTuneDefinition, MoveSize)
+    _MoveSizeTuneDefinition, MoveSize, ScaleMoveSize)
 
 
 @pytest.fixture
@@ -203,3 +203,33 @@ class TestMoveSize:
         tolerance = move_size_tuner.solver.tol
         assert abs(acceptance_rate - move_size_tuner.target) <= tolerance
         print(simulation.timestep)
+
+
+class TestScaleMoveSize:
+    def test_attach(self, simulation):
+        tuner = ScaleMoveSize(trigger=10, moves=['d'], target=0.5,
+                              max_translation_move=0.5)
+        simulation.operations.tuners.append(tuner)
+        simulation.operations._schedule()
+        assert tuner._attached
+        assert tuner.target == 0.5
+        assert tuner.max_translation_move['A'] == 0.5
+        assert tuner.moves == ['d']
+
+        tuner.target = 0.4
+        assert tuner.target == 0.4
+        with pytest.raises(AttributeError):
+            tuner.moves = ['a']
+
+    def test_act(self, simulation):
+        # the initial move size is small, so the acceptance rate is high and
+        # the tuner must increase the move size up to its maximum
+        integrator = simulation.operations.integrator
+        d = integrator.d['A']
+        tuner = ScaleMoveSize(trigger=10, moves=['d'], target=0.2,
+                              max_translation_move=0.05)
+        simulation.operations.tuners.append(tuner)
+        simulation.run(200)
+        assert integrator.d['A'] > d
+        assert integrator.d['A'] <= 0.05
+        assert integrator.a['A'] == 0.1
@@ -0,0 +1,37 @@
+# Copyright (c) 2009-2019 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Test the dense cell list sweep of monodisperse spheres."""
+
+import hoomd
+import pytest
+import numpy
+
+
+@pytest.mark.serial
+@pytest.mark.cpu
+@pytest.mark.parametrize("dimensions", [2, 3])
+def test_uniform_spheres(simulation_factory, lattice_snapshot_factory,
+                         dimensions):
+    """Check that the uniform sphere sweep makes the same moves as the tree."""
+    positions = []
+    for diameter_B in [1.0, 0.5]:
+        # an unused type of a different diameter selects the generic sweep
+        snap = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                        dimensions=dimensions, a=1.1, n=8)
+        sim = simulation_factory(snap)
+        mc = hoomd.hpmc.integrate.Sphere(seed=1, d=0.1)
+        mc.shape['A'] = dict(diameter=1.0)
+        mc.shape['B'] = dict(diameter=diameter_B)
+        sim.operations.integrator = mc
+
+        sim.run(100)
+        assert mc.overlaps == 0
+        assert mc.translate_moves[0] > 0
+        assert mc.translate_moves[1] > 0
+
+        snap = sim.state.snapshot
+        positions.append(snap.particles.position)
+
+    numpy.testing.assert_allclose(positions[0], positions[1])
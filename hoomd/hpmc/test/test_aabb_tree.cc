@@ -106,3 +106,119 @@ UP_TEST( bigger )
         UP_ASSERT(in(i, hits));
         }
     }
+
+UP_TEST( morton )
+    {
+    const unsigned int N = 1000;
+    hoomd::RandomGenerator rng(3);
+
+    std::vector< vec3<Scalar> > points(N);
+    AABB aabbs[N];
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] = vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng))
+                                  * Scalar(100);
+        aabbs[i] = AABB(points[i], i);
+        }
+
+    AABBTree tree;
+    tree.buildTreeMorton(aabbs, N);
+
+    // every particle is in exactly one leaf
+    std::vector<unsigned int> count(N, 0);
+    for (unsigned int node = 0; node < tree.getNumNodes(); node++)
+        if (tree.isNodeLeaf(node))
+            for (unsigned int k = 0; k < tree.getNodeNumParticles(node); k++)
+                count[tree.getNodeParticle(node, k)]++;
+    for (unsigned int i = 0; i < N; i++)
+        UP_ASSERT_EQUAL(count[i], 1);
+
+    // queries find exactly the particles a brute force search finds
+    std::vector<unsigned int> hits;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        AABB query(points[i], Scalar(5.0));
+        hits.clear();
+        tree.query(hits, query);
+
+        for (unsigned int j = 0; j < N; j++)
+            {
+            if (overlap(aabbs[j], query))
+                UP_ASSERT(in(j, hits));
+            }
+        }
+
+    // the layout supports refit() like a tree from buildTree()
+    tree.refit(aabbs, N);
+    UP_ASSERT(!tree.needsRebuild());
+    }
+
+UP_TEST( refit )
+    {
+    const unsigned int N = 1000;
+    hoomd::RandomGenerator rng(2);
+
+    std::vector< vec3<Scalar> > points(N);
+    AABB aabbs[N];
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] = vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng))
+                                  * Scalar(100);
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+
+    // buildTree() reorders the AABBs, keep a copy indexed by particle
+    std::vector<AABB> particle_aabbs(aabbs, aabbs + N);
+    AABBTree tree;
+    tree.buildTree(aabbs, N);
+    UP_ASSERT(!tree.needsRebuild());
+
+    // small moves keep the tree quality
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] += vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng)) * Scalar(0.1);
+        particle_aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+    tree.refit(&particle_aabbs[0], N);
+    UP_ASSERT(!tree.needsRebuild());
+
+    // every particle is in exactly one leaf and can be found
+    unsigned int n_particles = 0;
+    for (unsigned int node = 0; node < tree.getNumNodes(); node++)
+        if (tree.isNodeLeaf(node))
+            n_particles += tree.getNodeNumParticles(node);
+    UP_ASSERT_EQUAL(n_particles, N);
+
+    std::vector<unsigned int> hits;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        hits.clear();
+        tree.query(hits, AABB(points[i], Scalar(0.01)));
+        UP_ASSERT(in(i, hits));
+        }
+
+    // relocating all particles degrades the tree
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] = vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                 hoomd::detail::generate_canonical<float>(rng),
+                                 hoomd::detail::generate_canonical<float>(rng))
+                                 * Scalar(100);
+        particle_aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+    tree.refit(&particle_aabbs[0], N);
+    UP_ASSERT(tree.needsRebuild());
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        hits.clear();
+        tree.query(hits, AABB(points[i], Scalar(0.01)));
+        UP_ASSERT(in(i, hits));
+        }
+    }
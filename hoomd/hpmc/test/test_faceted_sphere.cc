@@ -529,3 +529,33 @@ UP_TEST( overlap_special_case )
     UP_ASSERT(test_overlap(r_ab, a,b,err_count));
     UP_ASSERT(test_overlap(-r_ab,a,b,err_count));
     }
+
+UP_TEST( insphere )
+    {
+    quat<Scalar> o(1,vec3<Scalar>(0,0,0));
+
+    // a sphere cut by a plane closer to the center than its radius
+    detail::FacetedEllipsoidParams p(1, false);
+    p.a = p.b = p.c = 0.5;
+    p.n[0] = vec3<OverlapReal>(2,0,0);
+    p.offset[0] = OverlapReal(-0.6);
+    p.ignore = 0;
+    p.verts.N = 0;
+    p.origin = vec3<OverlapReal>(0,0,0);
+    p.initializeVertices();
+
+    ShapeFacetedEllipsoid a(o, p);
+    MY_CHECK_CLOSE(a.getInsphereRadius(), 0.3, tol);
+
+    // overlapping inspheres
+    UP_ASSERT(test_overlap(vec3<Scalar>(0,0.55,0),a,a,err_count));
+    UP_ASSERT(test_overlap(vec3<Scalar>(0.55,0,0),a,a,err_count));
+
+    // disjoint circumspheres
+    UP_ASSERT(!test_overlap(vec3<Scalar>(0,1.05,0),a,a,err_count));
+
+    // a plane through the center
+    p.offset[0] = 0;
+    p.initializeVertices();
+    UP_ASSERT_EQUAL(a.getInsphereRadius(), OverlapReal(0.0));
+    }
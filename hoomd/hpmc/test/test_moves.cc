@@ -135,6 +135,34 @@ UP_TEST( rand_translate_2d )
         }
     }
 
+UP_TEST( sphere_intersection_aabb )
+    {
+    hoomd::RandomGenerator rng(123, 456, 789);
+
+    // disjoint spheres have no intersection
+    AABB aabb;
+    UP_ASSERT(!sphereIntersectionAABB(vec3<Scalar>(0,0,0), 1.0, vec3<Scalar>(2.5,0,0), 1.0, aabb));
+
+    // check that every point in both spheres is in the box, for sphere pairs in all configurations
+    Scalar R_b[] = {0.5, 1.0, 2.0};
+    Scalar d[] = {0.0, 0.25, 1.0, 1.5, 1.9};
+    for (auto R : R_b)
+        for (auto dist : d)
+            {
+            vec3<Scalar> r_a(0.1,0.2,0.3);
+            vec3<Scalar> r_b = r_a + vec3<Scalar>(dist,0,0);
+            UP_ASSERT(sphereIntersectionAABB(r_a, 1.0, r_b, R, aabb));
+
+            for (int i=0; i<1000; i++)
+                {
+                vec3<Scalar> p = generatePositionInSphere(rng, r_a, 1.0);
+                vec3<Scalar> dr = p - r_b;
+                if (dot(dr,dr) <= R*R)
+                    UP_ASSERT(isPositionInAABB(aabb, p, 3));
+                }
+            }
+    }
+
 void test_update_order(const unsigned int max)
     {
     // do a simple check on the update order, just make sure that the first index is evenly distributed between 0 and N-1
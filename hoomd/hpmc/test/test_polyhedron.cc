@@ -464,3 +464,72 @@ UP_TEST( overlap_octahedron_sphere )
     UP_ASSERT(test_overlap(r_ij,a,b,err_count));
     UP_ASSERT(test_overlap(-r_ij,b,a,err_count));
     }
+
+// helper function to fill the mesh of an octahedron with edges of length *edge*
+void build_octahedron(TriangleMesh& data, OverlapReal edge)
+    {
+    const unsigned int faces[24] = {0,4,1, 1,4,2, 2,4,3, 3,4,0, 0,5,1, 1,5,2, 2,5,3, 3,5,0};
+
+    data.sweep_radius=data.convex_hull_verts.sweep_radius=0.0f;
+    data.verts[0] = edge*vec3<OverlapReal>(-0.5,-0.5,0);
+    data.verts[1] = edge*vec3<OverlapReal>(0.5,-0.5,0);
+    data.verts[2] = edge*vec3<OverlapReal>(0.5,0.5,0);
+    data.verts[3] = edge*vec3<OverlapReal>(-0.5,0.5,0);
+    data.verts[4] = edge*vec3<OverlapReal>(0,0,OverlapReal(0.707106781186548));
+    data.verts[5] = edge*vec3<OverlapReal>(0,0,-OverlapReal(0.707106781186548));
+    for (unsigned int i = 0; i < 8; i++)
+        data.face_offs[i] = 3*i;
+    data.face_offs[8] = 24;
+    for (unsigned int i = 0; i < 24; i++)
+        data.face_verts[i] = faces[i];
+    data.ignore = 0;
+    data.origin = vec3<OverlapReal>(0,0,0);
+    set_radius(data);
+    initialize_convex_hull(data);
+    }
+
+UP_TEST( overlap_octahedron_contained )
+    {
+    vec3<Scalar> r_ij;
+    quat<Scalar> o;
+    quat<Scalar> o_rot = quat<Scalar>::fromAxisAngle(vec3<Scalar>(0,0,1), M_PI/8);
+
+    TriangleMesh data_a(6,8,24,6,false);
+    build_octahedron(data_a, 2.0);
+    data_a.computeOriginBounds();
+
+    // the nearest face of an octahedron is at edge/sqrt(6) from the center
+    MY_CHECK_CLOSE(data_a.inner_radius, 2.0/sqrt(6.0), tol);
+    MY_CHECK_CLOSE(data_a.outer_radius, sqrt(2.0), tol);
+
+    TriangleMesh data_b(6,8,24,6,false);
+    build_octahedron(data_b, 0.5);
+    data_b.computeOriginBounds();
+
+    ShapePolyhedron::param_type p_a = data_a;
+    p_a.tree = build_tree(data_a);
+    ShapePolyhedron::param_type p_b = data_b;
+    p_b.tree = build_tree(data_b);
+
+    // the small octahedron is inside the large one, near its center and near its surface
+    ShapePolyhedron a(o, p_a);
+    ShapePolyhedron b(o_rot, p_b);
+
+    r_ij = vec3<Scalar>(0.1,0,0);
+    UP_ASSERT(test_overlap(r_ij,a,b,err_count));
+    UP_ASSERT(test_overlap(-r_ij,b,a,err_count));
+
+    r_ij = vec3<Scalar>(0.65,0.6,0.02);
+    UP_ASSERT(test_overlap(r_ij,a,b,err_count));
+    UP_ASSERT(test_overlap(-r_ij,b,a,err_count));
+
+    // well outside
+    r_ij = vec3<Scalar>(1.7,0,0);
+    UP_ASSERT(!test_overlap(r_ij,a,b,err_count));
+    UP_ASSERT(!test_overlap(-r_ij,b,a,err_count));
+
+    // an origin outside of the mesh disables the test near the origin
+    data_b.origin = vec3<OverlapReal>(0,0,1.0);
+    data_b.computeOriginBounds();
+    UP_ASSERT_EQUAL(data_b.inner_radius, OverlapReal(0.0));
+    }
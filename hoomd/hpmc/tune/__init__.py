@@ -1 +1 @@
-from hoomd.hpmc.tune.move_size import MoveSize
+from hoomd.hpmc.tune.move_size import MoveSize, ScaleMoveSize
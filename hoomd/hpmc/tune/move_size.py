@@ -3,10 +3,13 @@ from hoomd.data.parameterdicts import ParameterDict, TypeParameterDict
 from hoomd.data.typeparam import TypeParameter
 from hoomd.data.typeconverter import (
     OnlyFrom, OnlyType, OnlyIf, to_type_converter)
+from hoomd.operation import Tuner
+from hoomd.trigger import Trigger
 from hoomd.tune import _InternalCustomTuner
 from hoomd.tune.attr_tuner import (
     _TuneDefinition, SolverStep, ScaleSolver, SecantSolver)
 from hoomd.hpmc.integrate import HPMCIntegrator
+from hoomd.hpmc import _hpmc
 
 
 class _MoveSizeTuneDefinition(_TuneDefinition):
@@ -391,3 +394,135 @@ class MoveSize(_InternalCustomTuner):
         solver = SecantSolver(gamma, tol)
         return cls(trigger, moves, target, solver, types, max_translation_move,
                    max_rotation_move)
+
+
+class ScaleMoveSize(Tuner):
+    """Tunes HPMCIntegrator move sizes to a target acceptance rate in C++.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps on which to tune
+            the move sizes.
+        moves (list[str]): A list of types of moves to tune. Available options
+            are 'a' and 'd'.
+        target (float): The acceptance rate for trial moves that is desired. The
+            value should be between 0 and 1.
+        types (list[str]): A list of string particle types to tune the move
+            size for, defaults to None which upon attaching will tune all types
+            in the system currently.
+        max_translation_move (float): The maximum value of a translational move
+            size to attempt, defaults to ``None`` which represents no maximum
+            move size.
+        max_rotation_move (float): The maximum value of a rotational move size
+            to attempt, defaults to ``None`` which represents no maximum move
+            size.
+        max_scale (float): The maximum factor to scale a move size by in one
+            step.
+        gamma (float): Added to the numerator and denominator of the acceptance
+            rate to target ratio. Larger values lead to smaller changes.
+        tol (float): The absolute tolerance to allow between the acceptance
+            rate and the target before the move sizes are changed.
+
+    `ScaleMoveSize` applies the same update as `MoveSize.scale_solver`:
+    each call scales the move sizes by :math:`(a + \\gamma) / (a_t +
+    \\gamma)`, where :math:`a` is the acceptance rate since the previous call
+    and :math:`a_t` is the target. The controller runs inside the HPMC
+    integrator instead of Python. On the GPU, it reads the acceptance counters
+    and updates the move sizes in device memory without a round trip through
+    Python, which makes it suitable for short tuning periods.
+
+    As with `MoveSize`, the acceptance rate is counted over all particle
+    types.
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps on which to tune
+            the move sizes.
+        moves (list[str]): A list of types of moves to tune.
+        target (float): The acceptance rate for trial moves that is desired.
+        types (list[str]): A list of string particle types to tune the move
+            size for.
+        max_translation_move (TypeParameter[``particle type``, `float`]): The
+            maximum value of a translational move size to attempt.
+        max_rotation_move (TypeParameter[``particle type``, `float`]): The
+            maximum value of a rotational move size to attempt.
+        max_scale (float): The maximum factor to scale a move size by in one
+            step.
+        gamma (float): Damping of the correction to the move sizes.
+        tol (float): The absolute tolerance of the acceptance rate.
+
+    Note:
+        `moves` and `types` cannot be changed after attaching.
+
+    Example::
+
+        tuner = hoomd.hpmc.tune.ScaleMoveSize(
+            trigger=hoomd.trigger.Periodic(10), moves=['d'], target=0.2,
+            max_translation_move=0.5)
+        sim.operations.tuners.append(tuner)
+    """
+
+    def __init__(self, trigger, moves, target, types=None,
+                 max_translation_move=None, max_rotation_move=None,
+                 max_scale=2., gamma=1., tol=1e-2):
+        param_dict = ParameterDict(
+            trigger=Trigger,
+            moves=OnlyIf(to_type_converter([OnlyFrom(['a', 'd'])])),
+            types=OnlyIf(to_type_converter([str]), allow_none=True),
+            target=float,
+            max_scale=float,
+            gamma=float,
+            tol=float)
+        self._param_dict.update(param_dict)
+        self.trigger = trigger
+        self.moves = moves
+        self.target = target
+        self.types = types
+        self.max_scale = max_scale
+        self.gamma = gamma
+        self.tol = tol
+
+        t_moves = TypeParameter(
+            'max_translation_move', 'particle_type',
+            TypeParameterDict(OnlyType(float, allow_none=True), len_keys=1))
+        r_moves = TypeParameter(
+            'max_rotation_move', 'particle_type',
+            TypeParameterDict(OnlyType(float, allow_none=True), len_keys=1))
+        self._add_typeparam(t_moves)
+        self._add_typeparam(r_moves)
+        self.max_translation_move.default = max_translation_move
+        self.max_rotation_move.default = max_rotation_move
+
+    def _attach(self):
+        integrator = self._simulation.operations.integrator
+        if not isinstance(integrator, HPMCIntegrator):
+            raise RuntimeError(
+                "ScaleMoveSize can only be used in HPMC simulations.")
+        if not integrator._attached:
+            raise RuntimeError("Integrator is not attached yet.")
+
+        particle_types = self._simulation.state.particle_types
+        types = self.types if self.types is not None else particle_types
+        if not all(t in particle_types for t in types):
+            raise RuntimeError(
+                "Invalid particle type found specified types for tuning.")
+
+        self._cpp_obj = _hpmc.TunerMoveSize(
+            self._simulation.state._cpp_sys_def, self.trigger,
+            integrator._cpp_obj, list(self.moves), list(types), self.target,
+            self.max_scale, self.gamma, self.tol)
+        super()._attach()
+
+    def _getattr_param(self, attr):
+        # moves and types are fixed at construction of the C++ object
+        if attr in ('moves', 'types'):
+            return self._param_dict[attr]
+        return super()._getattr_param(attr)
+
+    def _setattr_param(self, attr, value):
+        if self._attached and attr in ('moves', 'types'):
+            raise AttributeError("{} cannot be set after cpp"
+                                 " initialization".format(attr))
+        super()._setattr_param(attr, value)
+
+    def _update_param_dict(self):
+        for key in ('trigger', 'target', 'max_scale', 'gamma', 'tol'):
+            self._param_dict[key] = getattr(self, key)
@@ -479,38 +479,38 @@ class remove_drift(_updater):
         #initialize base class
         _updater.__init__(self);
         cls = None;
-        if not hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
-            if isinstance(mc, integrate.sphere):
-                cls = _hpmc.RemoveDriftUpdaterSphere;
-            elif isinstance(mc, integrate.convex_polygon):
-                cls = _hpmc.RemoveDriftUpdaterConvexPolygon;
-            elif isinstance(mc, integrate.simple_polygon):
-                cls = _hpmc.RemoveDriftUpdaterSimplePolygon;
-            elif isinstance(mc, integrate.convex_polyhedron):
-                cls = _hpmc.RemoveDriftUpdaterConvexPolyhedron;
-            elif isinstance(mc, integrate.convex_spheropolyhedron):
-                cls = _hpmc.RemoveDriftUpdaterSpheropolyhedron;
-            elif isinstance(mc, integrate.ellipsoid):
-                cls = _hpmc.RemoveDriftUpdaterEllipsoid;
-            elif isinstance(mc, integrate.convex_spheropolygon):
-                cls =_hpmc.RemoveDriftUpdaterSpheropolygon;
-            elif isinstance(mc, integrate.faceted_sphere):
-                cls =_hpmc.RemoveDriftUpdaterFacetedEllipsoid;
-            elif isinstance(mc, integrate.polyhedron):
-                cls =_hpmc.RemoveDriftUpdaterPolyhedron;
-            elif isinstance(mc, integrate.sphinx):
-                cls =_hpmc.RemoveDriftUpdaterSphinx;
-            elif isinstance(mc, integrate.sphere_union):
-                cls = _hpmc.RemoveDriftUpdaterSphereUnion;
-            elif isinstance(mc, integrate.convex_spheropolyhedron_union):
-                cls = _hpmc.RemoveDriftUpdaterConvexPolyhedronUnion;
-            elif isinstance(mc, integrate.faceted_ellipsoid_union):
-                cls = _hpmc.RemoveDriftUpdaterFacetedEllipsoidUnion;
-            else:
-                hoomd.context.current.device.cpp_msg.error("update.remove_drift: Unsupported integrator.\n");
-                raise RuntimeError("Error initializing update.remove_drift");
+        if isinstance(mc, integrate.sphere):
+            cls = _hpmc.RemoveDriftUpdaterSphere;
+        elif isinstance(mc, integrate.convex_polygon):
+            cls = _hpmc.RemoveDriftUpdaterConvexPolygon;
+        elif isinstance(mc, integrate.simple_polygon):
+            cls = _hpmc.RemoveDriftUpdaterSimplePolygon;
+        elif isinstance(mc, integrate.convex_polyhedron):
+            cls = _hpmc.RemoveDriftUpdaterConvexPolyhedron;
+        elif isinstance(mc, integrate.convex_spheropolyhedron):
+            cls = _hpmc.RemoveDriftUpdaterSpheropolyhedron;
+        elif isinstance(mc, integrate.ellipsoid):
+            cls = _hpmc.RemoveDriftUpdaterEllipsoid;
+        elif isinstance(mc, integrate.convex_spheropolygon):
+            cls =_hpmc.RemoveDriftUpdaterSpheropolygon;
+        elif isinstance(mc, integrate.faceted_sphere):
+            cls =_hpmc.RemoveDriftUpdaterFacetedEllipsoid;
+        elif isinstance(mc, integrate.polyhedron):
+            cls =_hpmc.RemoveDriftUpdaterPolyhedron;
+        elif isinstance(mc, integrate.sphinx):
+            cls =_hpmc.RemoveDriftUpdaterSphinx;
+        elif isinstance(mc, integrate.sphere_union):
+            cls = _hpmc.RemoveDriftUpdaterSphereUnion;
+        elif isinstance(mc, integrate.convex_spheropolyhedron_union):
+            cls = _hpmc.RemoveDriftUpdaterConvexPolyhedronUnion;
+        elif isinstance(mc, integrate.faceted_ellipsoid_union):
+            cls = _hpmc.RemoveDriftUpdaterFacetedEllipsoidUnion;
         else:
-            raise RuntimeError("update.remove_drift: Error! GPU not implemented.");
+            hoomd.context.current.device.cpp_msg.error("update.remove_drift: Unsupported integrator.\n");
+            raise RuntimeError("Error initializing update.remove_drift");
+
+        if hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
+            cls = getattr(_hpmc, cls.__name__ + 'GPU');
 
         self.cpp_updater = cls(hoomd.context.current.system_definition, external_lattice.cpp_compute, mc.cpp_integrator);
         self.setupUpdater(period);
@@ -804,3 +804,68 @@ class QuickCompress(Updater):
             return False
 
         return self._cpp_obj.isComplete()
+
+
+class ReplicaExchangeFugacity(hoomd.update.ReplicaExchange):
+    r"""Exchange depletant fugacities between replicas.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps on which to
+            attempt exchanges.
+
+        depletant_type (str): Name of the depletant type.
+
+        values (list[float]): Depletant fugacity of each replica
+            :math:`[\mathrm{volume}^{-1}]`.
+
+        seed (int): Random number seed, the same on all partitions.
+
+        observable (hoomd.operation.Compute): Compute that provides the free
+            volume available to the depletants.
+
+        quantity (str): Name of the free volume log quantity.
+
+    `ReplicaExchangeFugacity` exchanges the fugacity of one depletant type
+    between replicas of the same box volume in the same way that
+    `hoomd.update.ReplicaExchange` exchanges other parameters, with
+    :math:`c_k = -z_k` and the free volume as the observable. It sets the
+    fugacity of the replica in the HPMC integrator on this partition, which
+    overrides ``depletant_fugacity[depletant_type]``.
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps on which to
+            attempt exchanges.
+
+        depletant_type (str): Name of the depletant type.
+
+        values (list[float]): Depletant fugacity of each replica
+            :math:`[\mathrm{volume}^{-1}]`.
+
+        seed (int): Random number seed.
+
+        observable (hoomd.operation.Compute): Compute that provides the free
+            volume.
+
+        quantity (str): Name of the free volume log quantity.
+    """
+
+    _parameters = ['fugacity']
+
+    def __init__(self, trigger, depletant_type, values, seed, observable,
+                 quantity):
+        super().__init__(trigger, 'fugacity', values, seed, observable,
+                         quantity)
+        self._param_dict.update(ParameterDict(depletant_type=str))
+        self.depletant_type = depletant_type
+
+    def _make_cpp_obj(self):
+        integrator = self._simulation.operations.integrator
+        if not isinstance(integrator, integrate.HPMCIntegrator):
+            raise RuntimeError("The integrator must be a HPMC integrator.")
+
+        if not integrator._attached:
+            raise RuntimeError("Integrator is not attached yet.")
+
+        return _hpmc.UpdaterReplicaExchangeFugacity(
+            self._simulation.state._cpp_sys_def, integrator._cpp_obj,
+            self.depletant_type, list(self.values), self.seed)
@@ -20,6 +20,24 @@ class EvalFactory
             float d_j,
             float charge_j);
 
+        //! Evaluate a batch of pairs that share particle i, see PatchEnergyBatch
+        typedef void (*EvalBatchFnPtr)(unsigned int n,
+            const float *r_x,
+            const float *r_y,
+            const float *r_z,
+            unsigned int type_i,
+            const quat<float>& q_i,
+            float d_i,
+            float charge_i,
+            const unsigned int *type_j,
+            const float *q_s,
+            const float *q_x,
+            const float *q_y,
+            const float *q_z,
+            const float *d_j,
+            const float *charge_j,
+            float *energy);
+
         //! Constructor
         EvalFactory(const std::string& llvm_ir);
 
@@ -29,6 +47,12 @@ class EvalFactory
             return m_eval;
             }
 
+        //! Return the batch evaluator, NULL when the module does not define eval_batch
+        EvalBatchFnPtr getEvalBatch()
+            {
+            return m_eval_batch;
+            }
+
         //! Get the error message from initialization
         const std::string& getError()
             {
@@ -62,6 +86,7 @@ class EvalFactory
     private:
         std::unique_ptr<llvm::orc::KaleidoscopeJIT> m_jit; //!< The persistent JIT engine
         EvalFnPtr m_eval;         //!< Function pointer to evaluator
+        EvalBatchFnPtr m_eval_batch; //!< Function pointer to batch evaluator
         float **m_alpha;         // Pointer to alpha array
         float **m_alpha_union;   // Pointer to alpha array for union
         std::string m_error_msg; //!< The error message if initialization fails
@@ -149,6 +149,49 @@ class GPUEvalFactory
             }
         #endif
 
+        //! Return the maximum number of threads per block for a kernel with arbitrary template arguments
+        /* \param idev the logical GPU id
+           \param template_args template arguments of the kernel
+         */
+        unsigned int getKernelMaxThreads(unsigned int idev, const std::vector<std::string>& template_args)
+            {
+            int max_threads = 0;
+
+            #ifdef __HIP_PLATFORM_NVCC__
+            CUresult custatus = cuFuncGetAttribute(&max_threads,
+                CU_FUNC_ATTRIBUTE_MAX_THREADS_PER_BLOCK,
+                m_program[idev].kernel(m_kernel_name).instantiate(template_args));
+            char *error;
+            if (custatus != CUDA_SUCCESS)
+                {
+                cuGetErrorString(custatus, const_cast<const char **>(&error));
+                throw std::runtime_error("cuFuncGetAttribute: "+std::string(error));
+                }
+            #endif
+
+            return max_threads;
+            }
+
+        //! Asynchronously launch a JIT kernel with arbitrary template arguments
+        /*! \param idev logical GPU id to launch on
+            \param grid The grid dimensions
+            \param threads The thread block dimensions
+            \param sharedMemBytes The size of the dynamic shared mem allocation
+            \param hStream stream to execute on
+            \param template_args template arguments of the kernel
+            */
+        #ifdef __HIP_PLATFORM_NVCC__
+        jitify::KernelLauncher configureKernel(unsigned int idev, dim3 grid, dim3 threads, unsigned int sharedMemBytes,
+            cudaStream_t hStream, const std::vector<std::string>& template_args)
+            {
+            cudaSetDevice(m_exec_conf->getGPUIds()[idev]);
+
+            return m_program[idev].kernel(m_kernel_name)
+                .instantiate(template_args)
+                .configure(grid, threads, sharedMemBytes, hStream);
+            }
+        #endif
+
         void setAlphaPtr(float *d_alpha)
             {
             #ifdef __HIP_PLATFORM_NVCC__
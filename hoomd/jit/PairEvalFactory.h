@@ -0,0 +1,43 @@
+#pragma once
+
+// do not include python headers
+#define HOOMD_LLVMJIT_BUILD
+#include "hoomd/HOOMDMath.h"
+
+#include "KaleidoscopeJIT.h"
+
+//! Compiles the LLVM IR of a JIT pair potential, see EvaluatorPairJIT
+class PairEvalFactory
+    {
+    public:
+        //! Same signature as PairJITEvalFnPtr in EvaluatorPairJIT.h
+        typedef void (*PairEvalFnPtr)(Scalar rsq,
+            Scalar d_i,
+            Scalar d_j,
+            Scalar q_i,
+            Scalar q_j,
+            const Scalar *param,
+            Scalar& force_divr,
+            Scalar& pair_eng);
+
+        //! Constructor
+        PairEvalFactory(const std::string& llvm_ir);
+
+        //! Return the evaluator
+        PairEvalFnPtr getEval()
+            {
+            return m_eval;
+            }
+
+        //! Get the error message from initialization
+        const std::string& getError()
+            {
+            return m_error_msg;
+            }
+
+    private:
+        std::unique_ptr<llvm::orc::KaleidoscopeJIT> m_jit; //!< The persistent JIT engine
+        PairEvalFnPtr m_eval;         //!< Function pointer to evaluator
+
+        std::string m_error_msg; //!< The error message if initialization fails
+    };
@@ -26,6 +26,8 @@ PatchEnergyJIT::PatchEnergyJIT(std::shared_ptr<ExecutionConfiguration> exec_conf
         throw std::runtime_error("Error compiling JIT code.");
         }
 
+    m_eval_batch = m_factory->getEvalBatch();
+
     m_factory->setAlphaArray(&m_alpha.front());
     }
 
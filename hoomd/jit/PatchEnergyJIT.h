@@ -77,6 +77,31 @@ class PYBIND11_EXPORT PatchEnergyJIT : public hpmc::PatchEnergy
             return m_eval(r_ij, type_i, q_i, d_i, charge_i, type_j, q_j, d_j, charge_j);
             }
 
+        //! evaluate the patch energies of a batch of pairs with the eval_batch function of the JIT module
+        virtual double energyBatch(hpmc::PatchEnergyBatch& batch,
+            unsigned int type_i,
+            const quat<float>& q_i,
+            float d_i,
+            float charge_i)
+            {
+            if (!m_eval_batch)
+                return hpmc::PatchEnergy::energyBatch(batch, type_i, q_i, d_i, charge_i);
+
+            unsigned int n = batch.size();
+            if (n == 0)
+                return 0.0;
+
+            batch.energy.resize(n);
+            m_eval_batch(n, batch.r_x.data(), batch.r_y.data(), batch.r_z.data(), type_i, q_i, d_i, charge_i,
+                batch.type_j.data(), batch.q_s.data(), batch.q_x.data(), batch.q_y.data(), batch.q_z.data(),
+                batch.d_j.data(), batch.charge_j.data(), batch.energy.data());
+
+            double sum = 0.0;
+            for (unsigned int k = 0; k < n; k++)
+                sum += batch.energy[k];
+            return sum;
+            }
+
         static pybind11::object getAlphaNP(pybind11::object self)
             {
             auto self_cpp = self.cast<PatchEnergyJIT *>();
@@ -90,6 +115,7 @@ class PYBIND11_EXPORT PatchEnergyJIT : public hpmc::PatchEnergy
         Scalar m_r_cut;                             //!< Cutoff radius
         std::shared_ptr<EvalFactory> m_factory;       //!< The factory for the evaluator function
         EvalFactory::EvalFnPtr m_eval;                //!< Pointer to evaluator function inside the JIT module
+        EvalFactory::EvalBatchFnPtr m_eval_batch;     //!< Pointer to batch evaluator, NULL if the module has none
         unsigned int m_alpha_size;                  //!< Size of array
         std::vector<float, managed_allocator<float> > m_alpha; //!< Array containing adjustable parameters
     };
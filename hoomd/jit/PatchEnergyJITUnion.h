@@ -114,6 +114,18 @@ class PatchEnergyJITUnion : public PatchEnergyJIT
             float d_j,
             float charge_j);
 
+        //! evaluate the patch energies of a batch of pairs
+        /*! The union energy traverses the constituent trees of each pair, so evaluate the pairs one at a time.
+        */
+        virtual double energyBatch(hpmc::PatchEnergyBatch& batch,
+            unsigned int type_i,
+            const quat<float>& q_i,
+            float d_i,
+            float charge_i)
+            {
+            return hpmc::PatchEnergy::energyBatch(batch, type_i, q_i, d_i, charge_i);
+            }
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange()
             {
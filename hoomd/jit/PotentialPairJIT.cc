@@ -0,0 +1,15 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "PotentialPairJIT.h"
+
+void export_PotentialPairJIT(pybind11::module &m)
+    {
+    export_PotentialPair< PotentialPair<EvaluatorPairJIT> >(m, "PotentialPairJITBase");
+    pybind11::class_<PotentialPairJIT, PotentialPair<EvaluatorPairJIT>, std::shared_ptr<PotentialPairJIT> >(
+        m, "PotentialPairJIT")
+            .def(pybind11::init< std::shared_ptr<SystemDefinition>,
+                                 std::shared_ptr<NeighborList>,
+                                 const std::string& >())
+            ;
+    }
@@ -0,0 +1,72 @@
+#ifndef _POTENTIAL_PAIR_JIT_H_
+#define _POTENTIAL_PAIR_JIT_H_
+
+#include "hoomd/md/PotentialPair.h"
+#include "hoomd/md/EvaluatorPairJIT.h"
+
+#include "PairEvalFactory.h"
+
+//! Evaluate MD pair forces via runtime generated code
+/*! This class enables custom MD pair potentials without a plugin. The user provides LLVM IR code containing a function
+    'eval' with the signature of PairJITEvalFnPtr. On construction, this class uses the LLVM library to compile that IR
+    down to machine code and stores the function pointer in the parameters of every type pair, where EvaluatorPairJIT
+    calls it.
+
+    Everything else is PotentialPair<EvaluatorPairJIT>: the neighbor list loop, the shift modes, r_on, the energy and
+    virial flags, and the energy between sets.
+*/
+class PYBIND11_EXPORT PotentialPairJIT : public PotentialPair<EvaluatorPairJIT>
+    {
+    public:
+        //! Constructor
+        PotentialPairJIT(std::shared_ptr<SystemDefinition> sysdef,
+                         std::shared_ptr<NeighborList> nlist,
+                         const std::string& llvm_ir)
+            : PotentialPair<EvaluatorPairJIT>(sysdef, nlist)
+            {
+            // build the JIT.
+            m_factory = std::shared_ptr<PairEvalFactory>(new PairEvalFactory(llvm_ir));
+
+            // get the evaluator
+            m_eval = m_factory->getEval();
+
+            if (!m_eval)
+                {
+                m_exec_conf->msg->error() << m_factory->getError() << std::endl;
+                throw std::runtime_error("Error compiling JIT code.");
+                }
+
+            setEvalFn();
+            }
+
+        //! Set the pair parameters for a single type pair
+        virtual void setParams(unsigned int typ1, unsigned int typ2, const param_type& param)
+            {
+            PotentialPair<EvaluatorPairJIT>::setParams(typ1, typ2, param);
+            setEvalFn();
+            }
+
+        //! Set the pair parameters for a single type pair from python
+        virtual void setParamsPython(pybind11::tuple typ, pybind11::dict params)
+            {
+            PotentialPair<EvaluatorPairJIT>::setParamsPython(typ, params);
+            setEvalFn();
+            }
+
+    protected:
+        std::shared_ptr<PairEvalFactory> m_factory;     //!< The factory for the evaluator function
+        PairJITEvalFnPtr m_eval;                        //!< Pointer to evaluator function inside the JIT module
+
+        //! Store the evaluator function in the parameters of all type pairs
+        void setEvalFn()
+            {
+            ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::readwrite);
+            for (unsigned int i = 0; i < m_params.getNumElements(); i++)
+                h_params.data[i].eval_fn = m_eval;
+            }
+    };
+
+//! Exports the PotentialPairJIT class to python
+void export_PotentialPairJIT(pybind11::module &m);
+
+#endif // _POTENTIAL_PAIR_JIT_H_
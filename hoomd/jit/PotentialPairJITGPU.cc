@@ -0,0 +1,142 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifdef ENABLE_HIP
+
+#include "PotentialPairJITGPU.h"
+
+#include <string>
+
+/*! \param timestep Current time step
+
+    Launches gpu_compute_pair_forces_shared_kernel<EvaluatorPairJIT, ...> from the NVRTC program on each GPU, like
+    gpu_compute_pair_forces() does for the built-in potentials.
+*/
+void PotentialPairJITGPU::computeForces(unsigned int timestep)
+    {
+    m_nlist->compute(timestep);
+
+    // start the profile
+    if (m_prof) m_prof->push(m_exec_conf, m_prof_name);
+
+    // The GPU implementation CANNOT handle a half neighborlist, error out now
+    bool third_law = m_nlist->getStorageMode() == NeighborList::half;
+    if (third_law)
+        {
+        m_exec_conf->msg->error() << "PotentialPairJITGPU cannot handle a half neighborlist" << std::endl;
+        throw std::runtime_error("Error computing forces in PotentialPairJITGPU");
+        }
+
+    #ifdef __HIP_PLATFORM_NVCC__
+    // access the neighbor list
+    ArrayHandle<unsigned int> d_n_neigh(m_nlist->getNNeighArray(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_nlist(m_nlist->getNListArray(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_head_list(m_nlist->getHeadList(), access_location::device, access_mode::read);
+    const bool use_delta = m_nlist->getCompressedIndices();
+    ArrayHandle<short> d_nlist_delta(m_nlist->getNListDeltaArray(), access_location::device, access_mode::read);
+
+    // access the particle data
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar> d_diameter(m_pdata->getDiameters(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar> d_charge(m_pdata->getCharges(), access_location::device, access_mode::read);
+
+    BoxDim box = m_pdata->getBox();
+
+    // access parameters
+    ArrayHandle<Scalar> d_ronsq(m_ronsq, access_location::device, access_mode::read);
+    ArrayHandle<Scalar> d_rcutsq(m_rcutsq, access_location::device, access_mode::read);
+    ArrayHandle<param_type> d_params(m_params, access_location::device, access_mode::read);
+
+    ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::readwrite);
+    ArrayHandle<Scalar> d_virial(m_virial, access_location::device, access_mode::readwrite);
+
+    // access flags
+    PDataFlags flags = m_pdata->getFlags();
+
+    m_exec_conf->beginMultiGPU();
+    m_tuner->begin();
+    unsigned int param = m_tuner->getParam();
+    unsigned int block_size = param / 10000;
+    unsigned int tpp = param % 10000;
+
+    // the kernel is instantiated once for every combination of these
+    std::vector<std::string> template_args = {"EvaluatorPairJIT",
+                                              std::to_string((unsigned int)m_shift_mode),
+                                              std::to_string((unsigned int)flags[pdata_flag::pressure_tensor]),
+                                              std::to_string((unsigned int)flags[pdata_flag::potential_energy]),
+                                              std::to_string(tpp)};
+
+    // clamp the block size to the maximum of the kernel, as a multiple of the warp size
+    unsigned int max_block_size = m_gpu_factory.getKernelMaxThreads(0, template_args); // fixme GPU 0
+    max_block_size -= max_block_size % m_exec_conf->dev_prop.warpSize;
+    unsigned int run_block_size = std::min(block_size, max_block_size);
+
+    const unsigned int ntypes = m_pdata->getNTypes();
+    Index2D typpair_idx(ntypes);
+    unsigned int shared_bytes = (unsigned int)((2*sizeof(Scalar) + sizeof(param_type)) * typpair_idx.getNumElements());
+
+    const size_t virial_pitch = m_virial.getPitch();
+    auto& gpu_partition = m_pdata->getGPUPartition();
+    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int N = range.second - range.first;
+        unsigned int offset = range.first;
+
+        dim3 grid(N / (run_block_size/tpp) + 1, 1, 1);
+        dim3 threads(run_block_size, 1, 1);
+
+        auto launcher = m_gpu_factory.configureKernel(idev, grid, threads, shared_bytes, 0, template_args);
+
+        CUresult res = launcher(d_force.data,
+            d_virial.data,
+            virial_pitch,
+            N,
+            d_pos.data,
+            d_diameter.data,
+            d_charge.data,
+            box,
+            d_n_neigh.data,
+            d_nlist.data,
+            use_delta ? d_nlist_delta.data : NULL,
+            d_head_list.data,
+            d_params.data,
+            d_rcutsq.data,
+            d_ronsq.data,
+            ntypes,
+            offset);
+
+        if (res != CUDA_SUCCESS)
+            {
+            char *error;
+            cuGetErrorString(res, const_cast<const char **>(&error));
+            throw std::runtime_error("Error launching NVRTC kernel: "+std::string(error));
+            }
+        }
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner->end();
+
+    m_exec_conf->endMultiGPU();
+    #endif
+
+    if (m_prof) m_prof->pop(m_exec_conf);
+    }
+
+void export_PotentialPairJITGPU(pybind11::module &m)
+    {
+    pybind11::class_<PotentialPairJITGPU, PotentialPairJIT, std::shared_ptr<PotentialPairJITGPU> >(
+        m, "PotentialPairJITGPU")
+            .def(pybind11::init< std::shared_ptr<SystemDefinition>,
+                                 std::shared_ptr<NeighborList>,
+                                 const std::string&,
+                                 const std::string&,
+                                 const std::string&,
+                                 const std::vector<std::string>&,
+                                 const std::string&,
+                                 unsigned int >())
+            ;
+    }
+#endif
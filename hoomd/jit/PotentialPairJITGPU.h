@@ -0,0 +1,86 @@
+#ifndef _POTENTIAL_PAIR_JIT_GPU_H_
+#define _POTENTIAL_PAIR_JIT_GPU_H_
+
+#ifdef ENABLE_HIP
+
+#include "PotentialPairJIT.h"
+#include "GPUEvalFactory.h"
+#include <pybind11/stl.h>
+
+#include <vector>
+
+#include "hoomd/Autotuner.h"
+
+//! Evaluate MD pair forces via runtime generated code, GPU version
+/*! The user code is compiled with NVRTC together with gpu_compute_pair_forces_shared_kernel() (see
+    PotentialPairGPUJIT.inc), so the forces are computed by the same kernel as the built-in pair potentials. The kernel
+    is instantiated for the shift mode, the virial and energy flags, and the threads per particle of each launch.
+
+    The CPU evaluator compiled with LLVM remains in use for the energy between sets.
+*/
+class PYBIND11_EXPORT PotentialPairJITGPU : public PotentialPairJIT
+    {
+    public:
+        //! Constructor
+        PotentialPairJITGPU(std::shared_ptr<SystemDefinition> sysdef,
+                            std::shared_ptr<NeighborList> nlist,
+                            const std::string& llvm_ir,
+                            const std::string& code,
+                            const std::string& kernel_name,
+                            const std::vector<std::string>& options,
+                            const std::string& cuda_devrt_library_path,
+                            unsigned int compute_arch)
+            : PotentialPairJIT(sysdef, nlist, llvm_ir),
+              m_gpu_factory(m_exec_conf, code, kernel_name, options, cuda_devrt_library_path, compute_arch)
+            {
+            // the full block size and threads_per_particle matrix is searched,
+            // encoded as block_size*10000 + threads_per_particle
+            std::vector<unsigned int> valid_params;
+            const unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+            for (unsigned int block_size = warp_size; block_size <= 1024; block_size += warp_size)
+                {
+                for (auto s : Autotuner::getTppListPow2(warp_size))
+                    {
+                    valid_params.push_back(block_size*10000 + s);
+                    }
+                }
+
+            m_tuner.reset(new Autotuner(valid_params, 5, 100000, "pair_jit", m_exec_conf));
+            #ifdef ENABLE_MPI
+            // synchronize autotuner results across ranks
+            m_tuner->setSync(bool(m_pdata->getDomainDecomposition()));
+            #endif
+            }
+
+        //! Set autotuner parameters
+        /*! \param enable Enable/disable autotuning
+            \param period period (approximate) in time steps when returning occurs
+        */
+        virtual void setAutotunerParams(bool enable, unsigned int period)
+            {
+            PotentialPairJIT::setAutotunerParams(enable, period);
+            m_tuner->setPeriod(period);
+            m_tuner->setEnabled(enable);
+            }
+
+    protected:
+        std::unique_ptr<Autotuner> m_tuner;     //!< Autotuner for block size and threads per particle
+
+        //! Actually compute the forces
+        virtual void computeForces(unsigned int timestep);
+
+        //! The GPU kernels compute the forces on all particles at once
+        virtual bool computeInteriorForces(unsigned int timestep)
+            {
+            return false;
+            }
+
+    private:
+        GPUEvalFactory m_gpu_factory;           //!< JIT implementation
+    };
+
+//! Exports the PotentialPairJITGPU class to python
+void export_PotentialPairJITGPU(pybind11::module &m);
+
+#endif
+#endif // _POTENTIAL_PAIR_JIT_GPU_H_
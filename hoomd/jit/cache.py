@@ -0,0 +1,125 @@
+# Copyright (c) 2009-2019 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+""" Cache compiled JIT code on disk.
+
+Compiling C++ code with clang takes seconds each time a job script creates a :py:mod:`hoomd.jit` object.
+:py:mod:`hoomd.jit` stores the LLVM IR that clang produces in a cache directory and reuses it when the same code
+is compiled again with the same compiler, flags, and HOOMD build.
+
+Attributes:
+    directory (str): Directory to store cached LLVM IR in. Defaults to the ``HOOMD_JIT_CACHE_DIR`` environment
+        variable when set, otherwise to ``hoomd/jit`` in ``XDG_CACHE_HOME`` (``~/.cache`` by default). Set to
+        ``None`` or an empty string to disable the cache.
+
+Each entry is a file named by the SHA-256 hash of:
+
+* the C++ source,
+* the clang command line and the output of ``clang --version``,
+* the machine architecture,
+* the HOOMD version, git commit, and compile flags.
+
+Any change to these compiles the code again. Entries are written to a temporary file and renamed into place, so
+MPI ranks and concurrent jobs can share one directory: a reader sees either a complete entry or none. Remove the
+directory to clear the cache.
+
+Example::
+
+    hoomd.jit.cache.directory = '/scratch/user/hoomd-jit-cache'
+
+.. versionadded:: 3.0
+"""
+
+import hashlib
+import os
+import platform
+import subprocess
+import tempfile
+
+import hoomd
+
+
+def _default_directory():
+    if 'HOOMD_JIT_CACHE_DIR' in os.environ:
+        return os.environ['HOOMD_JIT_CACHE_DIR']
+
+    base = os.environ.get('XDG_CACHE_HOME', os.path.join(os.path.expanduser('~'), '.cache'))
+    return os.path.join(base, 'hoomd', 'jit')
+
+
+directory = _default_directory()
+
+# clang --version output, by executable
+_compiler_versions = {}
+
+
+def _compiler_version(clang_exec):
+    if clang_exec not in _compiler_versions:
+        try:
+            output = subprocess.run([clang_exec, '--version'], stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+            _compiler_versions[clang_exec] = output.stdout.decode()
+        except OSError:
+            # let the compile step report the missing compiler
+            _compiler_versions[clang_exec] = ''
+    return _compiler_versions[clang_exec]
+
+
+def _key(cmd, source):
+    h = hashlib.sha256()
+    parts = [source,
+             '\0'.join(cmd),
+             _compiler_version(cmd[0]),
+             platform.machine(),
+             hoomd.version.version,
+             hoomd.version.git_sha1,
+             hoomd.version.compile_flags]
+    for p in parts:
+        h.update(p.encode('utf-8'))
+        h.update(b'\0')
+    return h.hexdigest()
+
+
+def compile_llvm_ir(cmd, source, error_message='Error compiling JIT code'):
+    R""" Compile C++ source to LLVM IR, reusing a cached result when possible.
+
+    Args:
+        cmd (list[str]): clang command line that reads the source from stdin and writes the IR to stdout.
+        source (str): C++ source code.
+        error_message (str): Message of the exception raised when compilation fails.
+
+    Returns:
+        The LLVM IR as a string.
+
+    Raises:
+        RuntimeError: When clang fails to compile the code.
+    """
+    path = None
+    if directory:
+        path = os.path.join(directory, _key(cmd, source) + '.ll')
+        try:
+            with open(path, 'r') as f:
+                return f.read()
+        except OSError:
+            pass
+
+    p = subprocess.Popen(cmd, stdin=subprocess.PIPE, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    output = p.communicate(source.encode('utf-8'))
+    llvm_ir = output[0].decode()
+
+    if p.returncode != 0:
+        raise RuntimeError(error_message + "\nCommand " + ' '.join(cmd) + "\n" + output[1].decode())
+
+    if path is not None:
+        # the cache is an optimization, ignore errors when writing to it
+        tmp = None
+        try:
+            os.makedirs(directory, exist_ok=True)
+            fd, tmp = tempfile.mkstemp(dir=directory, suffix='.tmp')
+            with os.fdopen(fd, 'w') as f:
+                f.write(llvm_ir)
+            os.replace(tmp, path)
+        except OSError:
+            if tmp is not None and os.path.exists(tmp):
+                os.remove(tmp)
+
+    return llvm_ir
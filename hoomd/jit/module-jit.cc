@@ -3,6 +3,7 @@
 
 #include "PatchEnergyJIT.h"
 #include "PatchEnergyJITUnion.h"
+#include "PotentialPairJIT.h"
 
 //#include "hoomd/hpmc/IntegratorHPMC.h"
 //#include "hoomd/hpmc/IntegratorHPMCMono.h"
@@ -26,6 +27,8 @@
 #ifdef ENABLE_HIP
 #include "PatchEnergyJITGPU.h"
 #include "PatchEnergyJITUnionGPU.h"
+#include "ExternalFieldJITGPU.h"
+#include "PotentialPairJITGPU.h"
 #endif
 
 #include <pybind11/pybind11.h>
@@ -42,6 +45,7 @@ PYBIND11_MODULE(_jit, m)
     {
     export_PatchEnergyJIT(m);
     export_PatchEnergyJITUnion(m);
+    export_PotentialPairJIT(m);
 
     export_ExternalFieldJIT<ShapeSphere>(m, "ExternalFieldJITSphere");
     export_ExternalFieldJIT<ShapeConvexPolygon>(m, "ExternalFieldJITConvexPolygon");
@@ -61,5 +65,17 @@ PYBIND11_MODULE(_jit, m)
 
     export_PatchEnergyJITGPU(m);
     export_PatchEnergyJITUnionGPU(m);
+    export_PotentialPairJITGPU(m);
+
+    export_ExternalFieldJITGPU<ShapeSphere>(m, "ExternalFieldJITSphereGPU");
+    export_ExternalFieldJITGPU<ShapeConvexPolygon>(m, "ExternalFieldJITConvexPolygonGPU");
+    export_ExternalFieldJITGPU<ShapePolyhedron>(m, "ExternalFieldJITPolyhedronGPU");
+    export_ExternalFieldJITGPU<ShapeConvexPolyhedron>(m, "ExternalFieldJITConvexPolyhedronGPU");
+    export_ExternalFieldJITGPU<ShapeSpheropolyhedron>(m, "ExternalFieldJITSpheropolyhedronGPU");
+    export_ExternalFieldJITGPU<ShapeSpheropolygon>(m, "ExternalFieldJITSpheropolygonGPU");
+    export_ExternalFieldJITGPU<ShapeSimplePolygon>(m, "ExternalFieldJITSimplePolygonGPU");
+    export_ExternalFieldJITGPU<ShapeEllipsoid>(m, "ExternalFieldJITEllipsoidGPU");
+    export_ExternalFieldJITGPU<ShapeFacetedEllipsoid>(m, "ExternalFieldJITFacetedEllipsoidGPU");
+    export_ExternalFieldJITGPU<ShapeSphinx>(m, "ExternalFieldJITSphinxGPU");
     #endif
     }
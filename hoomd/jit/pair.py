@@ -0,0 +1,206 @@
+# Copyright (c) 2009-2019 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+""" JIT compiled MD pair potentials.
+
+Define an MD pair potential with C++ code that is compiled at run time. The
+forces are computed by the same code as the pair potentials in
+:py:mod:`hoomd.md.pair`, at native speed on the CPU and the GPU.
+"""
+
+import os
+
+import hoomd
+from hoomd.jit import _jit
+from hoomd.jit import cache
+from hoomd.md import _md
+from hoomd.md.pair import Pair
+from hoomd.data.parameterdicts import TypeParameterDict
+from hoomd.data.typeparam import TypeParameter
+
+
+class CPPPotential(Pair):
+    R""" Pair potential defined by C++ code.
+
+    Args:
+        nlist (`hoomd.md.nlist.NList`): Neighbor list
+        code (str): C++ code that computes the force and the energy.
+        r_cut (float): Default cutoff radius (in distance units).
+        r_on (float): Default turn-on radius (in distance units).
+        mode (str): energy shifting/smoothing mode.
+        clang_exec (str): The Clang executable to use.
+
+    The text provided in *code* is the body of a function with the following
+    signature:
+
+    .. code::
+
+        void eval(Scalar rsq,
+                  Scalar d_i,
+                  Scalar d_j,
+                  Scalar q_i,
+                  Scalar q_j,
+                  const Scalar *param,
+                  Scalar& force_divr,
+                  Scalar& pair_eng)
+
+    * *rsq* is the squared distance between the particles, it is always less
+      than :math:`r_{\mathrm{cut}}^2`.
+    * *d_i*, *d_j* are the particle diameters.
+    * *q_i*, *q_j* are the particle charges.
+    * *param* is the list given in `params` for the type pair, padded with
+      zeros to 8 values.
+    * Set *force_divr* to :math:`-\frac{1}{r} \frac{\partial V}{\partial r}`
+      and *pair_eng* to :math:`V(r)`.
+
+    The function is compiled with ``clang`` to LLVM IR for the CPU. On the GPU,
+    it is also compiled with NVRTC into the pair force kernel of
+    :py:mod:`hoomd.md.pair`. The code must therefore compile as both host and
+    device code. The shift modes, *r_on*, and `compute_set_energy` work as for
+    the other pair potentials.
+
+    Attributes:
+        params (`TypeParameter` [\
+          `tuple` [``particle_type``, ``particle_type``],\
+          `dict`]):
+          The parameters of the potential. The dictionary has the following
+          key:
+
+          * ``param`` (`list` [`float`], **required**) - at most 8 values
+            passed to the code as *param*.
+
+    Example::
+
+        nl = hoomd.md.nlist.Cell()
+        lj_code = '''
+            Scalar epsilon = param[0];
+            Scalar sigma = param[1];
+            Scalar r2inv = Scalar(1.0) / rsq;
+            Scalar r6inv = r2inv * r2inv * r2inv;
+            Scalar s6 = sigma * sigma * sigma * sigma * sigma * sigma;
+            Scalar s6r6 = s6 * r6inv;
+            force_divr = 24 * epsilon * r2inv * s6r6 * (2 * s6r6 - 1);
+            pair_eng = 4 * epsilon * s6r6 * (s6r6 - 1);
+            '''
+        lj = hoomd.jit.pair.CPPPotential(nlist=nl, code=lj_code, r_cut=2.5)
+        lj.params[('A', 'A')] = dict(param=[1.0, 1.0])
+    """
+    _cpp_class_name = "PotentialPairJIT"
+
+    def __init__(self, nlist, code, r_cut=None, r_on=0., mode='none',
+                 clang_exec='clang'):
+        super().__init__(nlist, r_cut, r_on, mode)
+        params = TypeParameter('params', 'particle_types',
+                               TypeParameterDict(param=[float], len_keys=2))
+        self._add_typeparam(params)
+        self._code = code
+        self._clang_exec = clang_exec
+
+    def _precision_flags(self):
+        flags = []
+        if 'SINGLE' in hoomd.version.compile_flags:
+            flags.append('-DSINGLE_PRECISION')
+        if 'MD_MIXED' in hoomd.version.compile_flags:
+            flags.append('-DENABLE_MD_MIXED_PRECISION')
+        return flags
+
+    def _compile_user(self):
+        cpp_function = """
+#include "hoomd/HOOMDMath.h"
+
+extern "C"
+{
+
+void eval(Scalar rsq,
+    Scalar d_i,
+    Scalar d_j,
+    Scalar q_i,
+    Scalar q_j,
+    const Scalar *param,
+    Scalar& force_divr,
+    Scalar& pair_eng)
+    {
+"""
+        cpp_function += self._code
+        cpp_function += """
+    }
+}
+"""
+        include_path = os.path.dirname(hoomd.__file__) + '/include'
+        include_path_source = hoomd.version.source_dir
+
+        cmd = [self._clang_exec, '-O3', '--std=c++11',
+               '-DHOOMD_LLVMJIT_BUILD'] + self._precision_flags() + [
+               '-I', include_path, '-I', include_path_source,
+               '-S', '-emit-llvm', '-x', 'c++', '-o', '-', '-']
+        return cache.compile_llvm_ir(cmd, cpp_function,
+                                     "Error compiling the pair potential.")
+
+    def _wrap_gpu_code(self):
+        cpp_function = """
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/md/PotentialPairGPUJIT.inc"
+
+__device__ void eval(Scalar rsq,
+    Scalar d_i,
+    Scalar d_j,
+    Scalar q_i,
+    Scalar q_j,
+    const Scalar *param,
+    Scalar& force_divr,
+    Scalar& pair_eng)
+    {
+"""
+        cpp_function += self._code
+        cpp_function += """
+    }
+"""
+        return cpp_function
+
+    def _attach(self):
+        # create the c++ mirror class
+        if not self._nlist._added:
+            self._nlist._add(self._simulation)
+        else:
+            if self._simulation != self._nlist._simulation:
+                raise RuntimeError("{} object's neighbor list is used in a "
+                                   "different simulation.".format(type(self)))
+        if not self.nlist._attached:
+            self.nlist._attach()
+
+        llvm_ir = self._compile_user()
+        device = self._simulation.device
+        if isinstance(device, hoomd.device.CPU):
+            self.nlist._cpp_obj.setStorageMode(
+                _md.NeighborList.storageMode.half)
+            self._cpp_obj = _jit.PotentialPairJIT(
+                self._simulation.state._cpp_sys_def, self.nlist._cpp_obj,
+                llvm_ir)
+        else:
+            self.nlist._cpp_obj.setStorageMode(
+                _md.NeighborList.storageMode.full)
+
+            include_path_hoomd = os.path.dirname(hoomd.__file__) + '/include'
+            include_path_source = hoomd.version.source_dir
+            include_path_cuda = _jit.__cuda_include_path__
+            options = ["-I" + include_path_hoomd, "-I" + include_path_source,
+                       "-I" + include_path_cuda] + self._precision_flags()
+            cuda_devrt_library_path = _jit.__cuda_devrt_library_path__
+
+            # select maximum supported compute capability out of those we
+            # compile for
+            compute_capability = (
+                device._cpp_exec_conf.getComputeCapability(0) // 10)
+            max_arch = 0
+            for a in _jit.__cuda_compute_archs__.split('_'):
+                if int(a) <= compute_capability:
+                    max_arch = int(a)
+
+            self._cpp_obj = _jit.PotentialPairJITGPU(
+                self._simulation.state._cpp_sys_def, self.nlist._cpp_obj,
+                llvm_ir, self._wrap_gpu_code(),
+                "gpu_compute_pair_forces_shared_kernel", options,
+                cuda_devrt_library_path, max_arch)
+
+        # skip Pair._attach, which constructs the built-in potentials
+        super(Pair, self)._attach()
@@ -3,6 +3,7 @@
 
 from hoomd import _hoomd
 from hoomd.jit import _jit
+from hoomd.jit import cache
 import hoomd
 
 import subprocess
@@ -122,6 +123,10 @@ class user(object):
 
     ``vec3`` and ``quat`` are defined in HOOMDMath.h.
 
+    The file may also define an extern "C" ``eval_batch`` function that evaluates the pairs of one trial move in a
+    single call. The code generated from *code* defines it; see :py:meth:`compile_user` for the signature. Without it,
+    HPMC calls ``eval`` once per pair.
+
     Compile the file with clang: ``clang -O3 --std=c++14 -DHOOMD_LLVMJIT_BUILD -I /path/to/hoomd/include -S -emit-llvm code.cc`` to produce
     the LLVM IR in ``code.ll``.
 
@@ -215,6 +220,39 @@ float eval(const vec3<float>& r_ij,
         cpp_function += code
         cpp_function += """
     }
+
+// evaluate n pairs that share particle i, inlining eval so that clang can vectorize the loop
+void eval_batch(unsigned int n,
+    const float *r_x,
+    const float *r_y,
+    const float *r_z,
+    unsigned int type_i,
+    const quat<float>& q_i,
+    float d_i,
+    float charge_i,
+    const unsigned int *type_j,
+    const float *q_s,
+    const float *q_x,
+    const float *q_y,
+    const float *q_z,
+    const float *d_j,
+    const float *charge_j,
+    float *energy)
+    {
+    #pragma clang loop vectorize(enable) interleave(enable)
+    for (unsigned int k = 0; k < n; k++)
+        {
+        energy[k] = eval(vec3<float>(r_x[k], r_y[k], r_z[k]),
+                         type_i,
+                         q_i,
+                         d_i,
+                         charge_i,
+                         type_j[k],
+                         quat<float>(q_s[k], vec3<float>(q_x[k], q_y[k], q_z[k])),
+                         d_j[k],
+                         charge_j[k]);
+        }
+    }
 }
 """
 
@@ -230,6 +268,8 @@ float eval(const vec3<float>& r_ij,
             cmd = [clang, '-O3', '--std=c++14', '-DHOOMD_LLVMJIT_BUILD', '-I', include_path, '-I', include_path_source, '-S', '-emit-llvm','-x','c++', '-o',fn,'-']
         else:
             cmd = [clang, '-O3', '--std=c++14', '-DHOOMD_LLVMJIT_BUILD', '-I', include_path, '-I', include_path_source, '-S', '-emit-llvm','-x','c++', '-o','-','-']
+            return cache.compile_llvm_ir(cmd, cpp_function, "Error initializing patch energy")
+
         p = subprocess.Popen(cmd,stdin=subprocess.PIPE,stdout=subprocess.PIPE,stderr=subprocess.PIPE)
 
         # pass C++ function to stdin
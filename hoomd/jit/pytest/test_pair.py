@@ -0,0 +1,67 @@
+import hoomd
+import pytest
+import numpy as np
+import shutil
+
+# the JIT package is only built with LLVM, and compiling the code needs clang
+jit = pytest.importorskip("hoomd.jit")
+pytestmark = pytest.mark.skipif(shutil.which('clang') is None,
+                                reason="clang is not available")
+
+lj_code = """
+    Scalar epsilon = param[0];
+    Scalar sigma = param[1];
+    Scalar r2inv = Scalar(1.0) / rsq;
+    Scalar r6inv = r2inv * r2inv * r2inv;
+    Scalar s6 = sigma * sigma * sigma * sigma * sigma * sigma;
+    Scalar s6r6 = s6 * r6inv;
+    force_divr = Scalar(24.0) * epsilon * r2inv * s6r6
+                 * (Scalar(2.0) * s6r6 - Scalar(1.0));
+    pair_eng = Scalar(4.0) * epsilon * s6r6 * (s6r6 - Scalar(1.0));
+"""
+
+
+def _compute(simulation_factory, snapshot, force):
+    sim = simulation_factory(snapshot)
+    integrator = hoomd.md.Integrator(dt=0.005)
+    integrator.forces.append(force)
+    sim.operations.integrator = integrator
+    sim.run(0)
+    return force.forces, force.energies, force.virials
+
+
+@pytest.mark.parametrize("mode", ['none', 'shift'])
+def test_lj(simulation_factory, lattice_snapshot_factory, mode):
+    """Compare the JIT compiled LJ potential with md.pair.LJ."""
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                    n=6,
+                                    a=1.2,
+                                    r=0.05)
+    if snap.exists:
+        snap.particles.typeid[:] = np.arange(snap.particles.N) % 2
+
+    params = {('A', 'A'): (1.0, 1.0),
+              ('A', 'B'): (0.5, 1.1),
+              ('B', 'B'): (1.5, 0.9)}
+
+    lj = hoomd.md.pair.LJ(hoomd.md.nlist.Cell(), r_cut=2.5, mode=mode)
+    for pair, (epsilon, sigma) in params.items():
+        lj.params[pair] = dict(epsilon=epsilon, sigma=sigma)
+    lj_forces, lj_energies, lj_virials = _compute(simulation_factory,
+                                                  snap, lj)
+
+    jit_lj = jit.pair.CPPPotential(hoomd.md.nlist.Cell(), code=lj_code,
+                                   r_cut=2.5, mode=mode)
+    for pair, (epsilon, sigma) in params.items():
+        jit_lj.params[pair] = dict(param=[epsilon, sigma])
+    jit_forces, jit_energies, jit_virials = _compute(simulation_factory,
+                                                     snap, jit_lj)
+
+    if snap.exists:
+        np.testing.assert_allclose(jit_forces, lj_forces,
+                                   rtol=1e-5, atol=1e-6)
+        np.testing.assert_allclose(jit_energies, lj_energies,
+                                   rtol=1e-5, atol=1e-6)
+        np.testing.assert_allclose(jit_virials, lj_virials,
+                                   rtol=1e-5, atol=1e-6)
+        assert np.count_nonzero(jit_energies) > 0
@@ -2,7 +2,7 @@ from copy import deepcopy
 from enum import Flag, auto
 from itertools import count
 from functools import reduce
-from hoomd.util import dict_map, SafeNamespaceDict
+from hoomd.util import dict_map, dict_fold, SafeNamespaceDict
 from collections.abc import Sequence
 
 
@@ -104,9 +104,10 @@ def _loggables(self):
 
 class _LoggableEntry:
     """Stores entries for _Loggable's store of a class's loggable quantities."""
-    def __init__(self, category, default):
+    def __init__(self, category, default, requires=()):
         self.category = category
         self.default = default
+        self.requires = tuple(requires)
 
 
 class _LoggerQuantity:
@@ -118,6 +119,9 @@ class _LoggerQuantity:
         category (str or LoggerCategories, optional): The type of quantity it is.
             Valid values are given in the `hoomd.logging.LoggerCategories`
             documentation.
+        default (bool, optional): Whether the quantity is logged by default.
+        requires (tuple[hoomd.custom.Action.Flags], optional): Flags the
+            simulation must compute on the steps the quantity is logged.
 
     Note:
         For users, this class is meant to be used in conjunction with
@@ -125,7 +129,8 @@ class _LoggerQuantity:
         actions.
     """
 
-    def __init__(self, name, cls, category='scalar', default=True):
+    def __init__(self, name, cls, category='scalar', default=True,
+                 requires=()):
         self.name = name
         self.update_cls(cls)
         if isinstance(category, str):
@@ -136,6 +141,7 @@ class _LoggerQuantity:
             raise ValueError("Flag must be a string convertable into "
                              "LoggerCategories or a LoggerCategories object.")
         self.default = bool(default)
+        self.requires = tuple(requires)
 
     def yield_names(self, user_name=None):
         """Infinitely yield potential namespaces.
@@ -278,7 +284,7 @@ class Loggable(type):
         current_loggables = {}
         for name, entry in cls._meta_export_dict.items():
             current_loggables[name] = _LoggerQuantity(
-                name, new_cls, entry.category, entry.default)
+                name, new_cls, entry.category, entry.default, entry.requires)
             cls._add_loggable_docstring_info(
                 new_cls, name, entry.category, entry.default)
         return current_loggables
@@ -310,7 +316,12 @@ class Loggable(type):
             getattr(new_cls, attr).__doc__ += str_msg.format(' ' * indent)
 
 
-def log(func=None, *, is_property=True, category='scalar', default=True):
+def log(func=None,
+        *,
+        is_property=True,
+        category='scalar',
+        default=True,
+        requires=()):
     """Creates loggable quantities for classes of type Loggable.
 
     For users this should be used with `hoomd.custom.Action` for exposing
@@ -332,6 +343,11 @@ def log(func=None, *, is_property=True, category='scalar', default=True):
             quantities even when logging other quantities of that type. The
             default category allows for these to be pass over by
             `hoomd.logging.Logger` objects by default. Argument keyword only.
+        requires (:obj:`list`, optional): The `hoomd.custom.Action.Flags` the
+            simulation must compute for the quantity, defaults to none.
+            Writers that log the quantity request these flags only on the
+            steps they trigger, such as the pressure tensor for a pressure.
+            Argument keyword only.
 
     Note:
         The namespace (where the loggable object is stored in the
@@ -350,7 +366,7 @@ def log(func=None, *, is_property=True, category='scalar', default=True):
             raise KeyError(
                 "Multiple loggable quantities named {}.".format(name))
         Loggable._meta_export_dict[name] = _LoggableEntry(
-            LoggerCategories[category], default)
+            LoggerCategories[category], default, requires)
         if is_property:
             return property(func)
         else:
@@ -375,14 +391,16 @@ class _LoggerEntry:
         greater security with regards to user specified quantities.
     """
 
-    def __init__(self, obj, attr, category):
+    def __init__(self, obj, attr, category, requires=()):
         self.obj = obj
         self.attr = attr
         self.category = category
+        self.requires = tuple(requires)
 
     @classmethod
     def from_logger_quantity(cls, obj, logger_quantity):
-        return cls(obj, logger_quantity.name, logger_quantity.category)
+        return cls(obj, logger_quantity.name, logger_quantity.category,
+                   logger_quantity.requires)
 
     @classmethod
     def from_tuple(cls, entry):
@@ -539,6 +557,19 @@ class Logger(SafeNamespaceDict):
         """
         return self._only_default
 
+    @property
+    def flags(self):
+        """`list` of `int`: The `hoomd.custom.Action.Flags` the logged
+        quantities require.
+
+        Logging back ends request these flags so that the simulation computes
+        quantities such as the pressure tensor only on the steps they log.
+        """
+        return sorted(
+            dict_fold(self._dict,
+                      lambda entry, flags: flags | set(entry.requires),
+                      set()))
+
     def _filter_quantities(self, quantities):
         for quantity in quantities:
             if self._only_default and not quantity.default:
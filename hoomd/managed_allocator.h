@@ -8,6 +8,7 @@
 
 #ifdef ENABLE_HIP
 #include <hip/hip_runtime.h>
+#include "ManagedArena.h"
 #endif
 
 #include "GlobalArray.h" // for my_align
@@ -78,32 +79,10 @@ class managed_allocator
             #ifdef ENABLE_HIP
             if (use_device)
                 {
+                // small arrays are packed into the slabs of the arena
                 allocation_bytes = n*sizeof(T);
-
-                if (align_size)
-                    allocation_bytes = ((n*sizeof(T))/align_size + 1)*align_size;
-
-                hipError_t error = hipMallocManaged(&result, allocation_bytes, hipMemAttachGlobal);
-                if (error != hipSuccess)
-                    {
-                    std::cerr << hipGetErrorString(error) << std::endl;
-                    throw std::runtime_error("managed_allocator: Error allocating managed memory");
-                    }
-
+                result = ManagedArena::get().allocate(allocation_bytes, align_size);
                 allocation_ptr = result;
-
-                if (align_size)
-                    {
-                    // align to align_size
-                    #ifndef NO_STD_ALIGN
-                    std::align(align_size,n*sizeof(T),result,allocation_bytes);
-                    #else
-                    hoomd::detail::my_align(align_size,n*sizeof(T),result,allocation_bytes);
-                    #endif
-
-                    if (!result)
-                        throw std::runtime_error("managed_allocator: Error aligning managed memory");
-                    }
                 }
             else
             #endif
@@ -198,16 +177,7 @@ class managed_allocator
             #ifdef ENABLE_HIP
             if (use_device)
                 {
-                #ifdef __HIP_PLATFORM_NVCC__
-                hipError_t error = hipFree(allocation_ptr);
-                #elif __HIP_PLATFORM_HCC__
-                hipError_t error = hipHostFree(allocation_ptr);
-                #endif
-                if (error != hipSuccess)
-                    {
-                    std::cerr << hipGetErrorString(error) << std::endl;
-                    throw std::runtime_error("managed_allocator: Error freeing managed memory");
-                    }
+                ManagedArena::get().deallocate(allocation_ptr);
                 }
             else
             #endif
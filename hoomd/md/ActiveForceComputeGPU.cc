@@ -32,7 +32,8 @@ ActiveForceComputeGPU::ActiveForceComputeGPU(std::shared_ptr<SystemDefinition> s
                                         Scalar rx,
                                         Scalar ry,
                                         Scalar rz)
-        : ActiveForceCompute(sysdef, group, seed, rotation_diff, P, rx, ry, rz), m_block_size(256)
+        : ActiveForceCompute(sysdef, group, seed, rotation_diff, P, rx, ry, rz), m_block_size(256),
+          m_member_tag(m_exec_conf), m_member_tag_valid(false)
     {
     if (!m_exec_conf->isCUDAEnabled())
         {
@@ -67,110 +68,94 @@ ActiveForceComputeGPU::ActiveForceComputeGPU(std::shared_ptr<SystemDefinition> s
 
     m_f_activeVec.swap(tmp_f_activeVec);
     m_t_activeVec.swap(tmp_t_activeVec);
+
+    TAG_ALLOCATION(m_member_tag);
+
+    // the group members are reordered when the particles are sorted or the number of particles changes
+    m_pdata->getParticleSortSignal().connect<ActiveForceComputeGPU,
+        &ActiveForceComputeGPU::slotMembersChanged>(this);
+    m_pdata->getGlobalParticleNumberChangeSignal().connect<ActiveForceComputeGPU,
+        &ActiveForceComputeGPU::slotMembersChanged>(this);
     }
 
-/*! This function sets appropriate active forces and torques on all active particles.
-*/
-void ActiveForceComputeGPU::setForces()
+ActiveForceComputeGPU::~ActiveForceComputeGPU()
     {
-    //  array handles
-    ArrayHandle<Scalar4> d_f_actVec(m_f_activeVec, access_location::device, access_mode::read);
-    ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::overwrite);
-
-    ArrayHandle<Scalar4> d_t_actVec(m_t_activeVec, access_location::device, access_mode::read);
-    ArrayHandle<Scalar4> d_torque(m_torque, access_location::device, access_mode::overwrite);
-
-    ArrayHandle<Scalar4> d_pos(m_pdata -> getPositions(), access_location::device, access_mode::read);
-    ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(), access_location::device, access_mode::read);
-    ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(), access_location::device, access_mode::read);
-
-    // sanity check
-    assert(d_force.data != NULL);
-    assert(d_f_actVec.data != NULL);
-    assert(d_t_actVec.data != NULL);
-    assert(d_pos.data != NULL);
-    assert(d_orientation.data != NULL);
-    assert(d_index_array.data != NULL);
-    unsigned int group_size = m_group->getNumMembers();
-    unsigned int N = m_pdata->getN();
-
-    gpu_compute_active_force_set_forces(group_size,
-                                     d_index_array.data,
-                                     d_force.data,
-                                     d_torque.data,
-                                     d_pos.data,
-                                     d_orientation.data,
-                                     d_f_actVec.data,
-                                     d_t_actVec.data,
-                                     m_P,
-                                     m_rx,
-                                     m_ry,
-                                     m_rz,
-                                     N,
-                                     m_block_size);
+    m_pdata->getParticleSortSignal().disconnect<ActiveForceComputeGPU,
+        &ActiveForceComputeGPU::slotMembersChanged>(this);
+    m_pdata->getGlobalParticleNumberChangeSignal().disconnect<ActiveForceComputeGPU,
+        &ActiveForceComputeGPU::slotMembersChanged>(this);
     }
 
-/*! This function applies rotational diffusion to all active particles. The angle between the torque vector and
- * force vector does not change
+/*! The surface constraint, the rotational diffusion, and the forces and torques are applied to each active particle
+    by one thread, in the same order as ActiveForceCompute::computeForces(). The orientation and position of each
+    particle are read once. The tags of the group members, which seed the rotational diffusion, are kept in group
+    order and only read through the index array again after the particles are reordered.
     \param timestep Current timestep
 */
-void ActiveForceComputeGPU::rotationalDiffusion(unsigned int timestep)
+void ActiveForceComputeGPU::computeForces(unsigned int timestep)
     {
-    //  array handles
-    ArrayHandle<Scalar4> d_f_actVec(m_f_activeVec, access_location::device, access_mode::readwrite);
-    ArrayHandle<Scalar4> d_pos(m_pdata -> getPositions(), access_location::device, access_mode::read);
-    ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(), access_location::device, access_mode::readwrite);
-    ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(), access_location::device, access_mode::read);
-    ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
-
-    assert(d_pos.data != NULL);
-
-    bool is2D = (m_sysdef->getNDimensions() == 2);
-    unsigned int group_size = m_group->getNumMembers();
-
-    gpu_compute_active_force_rotational_diffusion(group_size,
-                                                d_tag.data,
-                                                d_index_array.data,
-                                                d_pos.data,
-                                                d_orientation.data,
-                                                d_f_actVec.data,
-                                                m_P,
-                                                m_rx,
-                                                m_ry,
-                                                m_rz,
-                                                is2D,
-                                                m_rotationConst,
-                                                timestep,
-                                                m_seed,
-                                                m_block_size);
-    }
+    if (last_computed == timestep)
+        return;
 
-/*! This function sets an ellipsoid surface constraint for all active particles
-*/
-void ActiveForceComputeGPU::setConstraint()
-    {
-    EvaluatorConstraintEllipsoid Ellipsoid(m_P, m_rx, m_ry, m_rz);
-
-    //  array handles
-    ArrayHandle<Scalar4> d_f_actVec(m_f_activeVec, access_location::device, access_mode::readwrite);
-    ArrayHandle<Scalar4> d_pos(m_pdata -> getPositions(), access_location::device, access_mode::read);
-    ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(), access_location::device, access_mode::readwrite);
-    ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(), access_location::device, access_mode::read);
-
-    assert(d_pos.data != NULL);
-
-    unsigned int group_size = m_group->getNumMembers();
-
-    gpu_compute_active_force_set_constraints(group_size,
-                                             d_index_array.data,
-                                             d_pos.data,
-                                             d_orientation.data,
-                                             d_f_actVec.data,
-                                             m_P,
-                                             m_rx,
-                                             m_ry,
-                                             m_rz,
-                                             m_block_size);
+    if (m_prof) m_prof->push(m_exec_conf, "ActiveForceCompute");
+
+    m_rotationConst = slow::sqrt(2.0 * m_rotationDiff * m_deltaT);
+    last_computed = timestep;
+
+    const unsigned int group_size = m_group->getNumMembers();
+    const bool diffusion = (m_rotationDiff != 0);
+    if (m_member_tag.size() != group_size)
+        {
+        m_member_tag.resize(group_size);
+        m_member_tag_valid = false;
+        }
+
+        {
+        //  array handles
+        ArrayHandle<Scalar4> d_f_actVec(m_f_activeVec, access_location::device, access_mode::read);
+        ArrayHandle<Scalar4> d_t_actVec(m_t_activeVec, access_location::device, access_mode::read);
+        ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::overwrite);
+        ArrayHandle<Scalar4> d_torque(m_torque, access_location::device, access_mode::overwrite);
+
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+        ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
+                                           access_location::device,
+                                           access_mode::readwrite);
+        ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(), access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_member_tag(m_member_tag, access_location::device, access_mode::readwrite);
+
+        gpu_compute_active_force(group_size,
+                                 d_index_array.data,
+                                 d_member_tag.data,
+                                 (diffusion && !m_member_tag_valid) ? d_tag.data : NULL,
+                                 d_force.data,
+                                 d_torque.data,
+                                 d_pos.data,
+                                 d_orientation.data,
+                                 d_f_actVec.data,
+                                 d_t_actVec.data,
+                                 m_P,
+                                 m_rx,
+                                 m_ry,
+                                 m_rz,
+                                 (m_rx != 0),
+                                 diffusion,
+                                 (m_sysdef->getNDimensions() == 2),
+                                 m_rotationConst,
+                                 timestep,
+                                 m_seed,
+                                 m_pdata->getN(),
+                                 m_block_size);
+        if(m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+    // the member tags are only gathered when they are needed for the rotational diffusion
+    if (diffusion)
+        m_member_tag_valid = true;
+
+    if (m_prof) m_prof->pop(m_exec_conf);
     }
 
 void export_ActiveForceComputeGPU(py::module& m)
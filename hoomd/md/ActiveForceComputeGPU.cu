@@ -17,11 +17,14 @@ using namespace hoomd;
     \brief Declares GPU kernel code for calculating active forces forces on the GPU. Used by ActiveForceComputeGPU.
 */
 
-//! Kernel for setting active force vectors on the GPU
+//! Kernel for applying the constraint, the rotational diffusion, and the active forces on the GPU
 /*! \param group_size number of particles
-    \param d_index_array stores list to convert group index to global tag
+    \param d_index_array stores list to convert group index to particle index
+    \param d_member_tag tags of the group members, in group order
+    \param d_tag particle tags, used to fill \a d_member_tag when not NULL
     \param d_force particle force on device
     \param d_torque particle torque on device
+    \param d_pos particle positions on device
     \param d_orientation particle orientation on device
     \param d_f_act particle active force unit vector
     \param d_t_act particle active torque unit vector
@@ -29,63 +32,37 @@ using namespace hoomd;
     \param rx radius of the ellipsoid in x direction
     \param ry radius of the ellipsoid in y direction
     \param rz radius of the ellipsoid in z direction
-    \param orientationLink check if particle orientation is linked to active force vector
-*/
-__global__ void gpu_compute_active_force_set_forces_kernel(const unsigned int group_size,
-                                                    unsigned int *d_index_array,
-                                                    Scalar4 *d_force,
-                                                    Scalar4 *d_torque,
-                                                    const Scalar4 *d_pos,
-                                                    const Scalar4 *d_orientation,
-                                                    const Scalar4 *d_f_act,
-                                                    const Scalar4 *d_t_act,
-                                                    const Scalar3 P,
-                                                    const Scalar rx,
-                                                    const Scalar ry,
-                                                    const Scalar rz,
-                                                    const unsigned int N)
-    {
-    unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
-    if (group_idx >= group_size)
-        return;
-
-    unsigned int idx = d_index_array[group_idx];
-    Scalar4 posidx = __ldg(d_pos + idx);
-    unsigned int type = __scalar_as_int(posidx.w);
-
-    Scalar4 fact = __ldg(d_f_act + type);
-
-    vec3<Scalar> f(fact.w*fact.x, fact.w*fact.y, fact.w*fact.z);
-    quat<Scalar> quati( __ldg(d_orientation + idx));
-    vec3<Scalar> fi = rotate(quati, f);
-    d_force[idx] = vec_to_scalar4(fi, 0);
-
-    Scalar4 tact = __ldg(d_t_act + type);
-
-    vec3<Scalar> t(tact.w*tact.x, tact.w*tact.y, tact.w*tact.z);
-    vec3<Scalar> ti = rotate(quati, t);
-    d_torque[idx] = vec_to_scalar4(ti, 0);
-    }
+    \param constraint check if particles are confined to the ellipsoid
+    \param diffusion check if the rotational diffusion is applied
+    \param is2D check if simulation is 2D or 3D
+    \param rotationConst particle rotational diffusion constant
+    \param timestep current timestep
+    \param seed seed for random number generator
 
-//! Kernel for adjusting active force vectors to align parallel to an ellipsoid surface constraint on the GPU
-/*! \param group_size number of particles
-    \param d_index_array stores list to convert group index to global tag
-    \param d_pos particle positions on device
-    \param d_f_act particle active force unit vector
-    \param P position of the ellipsoid constraint
-    \param rx radius of the ellipsoid in x direction
-    \param ry radius of the ellipsoid in y direction
-    \param rz radius of the ellipsoid in z direction
+    One thread per group member first aligns the active force parallel to the ellipsoid surface, then applies the
+    rotational diffusion, and finally sets the active force and torque from the new orientation, the same way
+    ActiveForceCompute does in three passes over the group.
 */
-__global__ void gpu_compute_active_force_set_constraints_kernel(const unsigned int group_size,
-                                                   unsigned int *d_index_array,
-                                                   const Scalar4 *d_pos,
-                                                   Scalar4 *d_orientation,
-                                                   const Scalar4 *d_f_act,
-                                                   const Scalar3 P,
-                                                   const Scalar rx,
-                                                   const Scalar ry,
-                                                   const Scalar rz)
+__global__ void gpu_compute_active_force_kernel(const unsigned int group_size,
+                                                const unsigned int *d_index_array,
+                                                unsigned int *d_member_tag,
+                                                const unsigned int *d_tag,
+                                                Scalar4 *d_force,
+                                                Scalar4 *d_torque,
+                                                const Scalar4 *d_pos,
+                                                Scalar4 *d_orientation,
+                                                const Scalar4 *d_f_act,
+                                                const Scalar4 *d_t_act,
+                                                const Scalar3 P,
+                                                const Scalar rx,
+                                                const Scalar ry,
+                                                const Scalar rz,
+                                                const bool constraint,
+                                                const bool diffusion,
+                                                const bool is2D,
+                                                const Scalar rotationConst,
+                                                const unsigned int timestep,
+                                                const int seed)
     {
     unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
     if (group_idx >= group_size)
@@ -94,113 +71,83 @@ __global__ void gpu_compute_active_force_set_constraints_kernel(const unsigned i
     unsigned int idx = d_index_array[group_idx];
     Scalar4 posidx = __ldg(d_pos + idx);
     unsigned int type = __scalar_as_int(posidx.w);
-
-    EvaluatorConstraintEllipsoid Ellipsoid(P, rx, ry, rz);
     Scalar3 current_pos = make_scalar3(posidx.x, posidx.y, posidx.z);
 
-    Scalar3 norm_scalar3 = Ellipsoid.evalNormal(current_pos); // the normal vector to which the particles are confined.
-    vec3<Scalar> norm = vec3<Scalar>(norm_scalar3);
-
     Scalar4 fact = __ldg(d_f_act + type);
+    quat<Scalar> quati(d_orientation[idx]);
 
-    vec3<Scalar> f(fact.x, fact.y, fact.z);
-    quat<Scalar> quati( __ldg(d_orientation + idx));
-    vec3<Scalar> fi = rotate(quati, f);
-
+    EvaluatorConstraintEllipsoid Ellipsoid(P, rx, ry, rz);
 
-    Scalar dot_prod = fi.x * norm.x + fi.y * norm.y + fi.z * norm.z;
+    if (constraint)
+        {
+        Scalar3 norm_scalar3 = Ellipsoid.evalNormal(current_pos); // the normal vector to which the particles are confined.
+        vec3<Scalar> norm = vec3<Scalar>(norm_scalar3);
 
-    Scalar dot_perp_prod = slow::sqrt(1-dot_prod*dot_prod);
+        vec3<Scalar> f(fact.x, fact.y, fact.z);
+        vec3<Scalar> fi = rotate(quati, f);
 
-    Scalar phi_half = slow::atan(dot_prod/dot_perp_prod)/2.0;
+        Scalar dot_prod = fi.x * norm.x + fi.y * norm.y + fi.z * norm.z;
 
+        Scalar dot_perp_prod = slow::sqrt(1-dot_prod*dot_prod);
 
-    fi.x -= norm.x * dot_prod;
-    fi.y -= norm.y * dot_prod;
-    fi.z -= norm.z * dot_prod;
+        Scalar phi_half = slow::atan(dot_prod/dot_perp_prod)/2.0;
 
-    Scalar new_norm = 1.0/slow::sqrt(fi.x*fi.x + fi.y*fi.y + fi.z*fi.z);
+        fi.x -= norm.x * dot_prod;
+        fi.y -= norm.y * dot_prod;
+        fi.z -= norm.z * dot_prod;
 
-    fi.x *= new_norm;
-    fi.y *= new_norm;
-    fi.z *= new_norm;
+        Scalar new_norm = 1.0/slow::sqrt(fi.x*fi.x + fi.y*fi.y + fi.z*fi.z);
 
-    vec3<Scalar> rot_vec = cross(norm,fi);
-    rot_vec.x *= slow::sin(phi_half);
-    rot_vec.y *= slow::sin(phi_half);
-    rot_vec.z *= slow::sin(phi_half);
+        fi.x *= new_norm;
+        fi.y *= new_norm;
+        fi.z *= new_norm;
 
-    quat<Scalar> rot_quat(cos(phi_half),rot_vec);
+        vec3<Scalar> rot_vec = cross(norm,fi);
+        rot_vec.x *= slow::sin(phi_half);
+        rot_vec.y *= slow::sin(phi_half);
+        rot_vec.z *= slow::sin(phi_half);
 
-    quati = rot_quat*quati;
+        quat<Scalar> rot_quat(cos(phi_half),rot_vec);
 
-    d_orientation[idx] = quat_to_scalar4(quati);
-    }
-
-//! Kernel for applying rotational diffusion to active force vectors on the GPU
-/*! \param group_size number of particles
-    \param d_index_array stores list to convert group index to global tag
-    \param d_pos particle positions on device
-    \param d_f_act particle active force unit vector
-    \param P position of the ellipsoid constraint
-    \param rx radius of the ellipsoid in x direction
-    \param ry radius of the ellipsoid in y direction
-    \param rz radius of the ellipsoid in z direction
-    \param is2D check if simulation is 2D or 3D
-    \param rotationConst particle rotational diffusion constant
-    \param seed seed for random number generator
-*/
-__global__ void gpu_compute_active_force_rotational_diffusion_kernel(const unsigned int group_size,
-                                                   unsigned int *d_tag,
-                                                   unsigned int *d_index_array,
-                                                   const Scalar4 *d_pos,
-                                                   Scalar4 *d_orientation,
-                                                   const Scalar4 *d_f_act,
-                                                   const Scalar3 P,
-                                                   const Scalar rx,
-                                                   const Scalar ry,
-                                                   const Scalar rz,
-                                                   bool is2D,
-                                                   const Scalar rotationConst,
-                                                   const unsigned int timestep,
-                                                   const int seed)
-    {
-    unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
-    if (group_idx >= group_size)
-        return;
-
-    unsigned int idx = d_index_array[group_idx];
-    Scalar4 posidx = __ldg(d_pos + idx);
-    unsigned int type = __scalar_as_int(posidx.w);
-    unsigned int ptag = d_tag[group_idx];
+        quati = rot_quat*quati;
+        }
 
-    quat<Scalar> quati( __ldg(d_orientation + idx));
+    if (diffusion)
+        {
+        // the tags are gathered through the index array only after the particles are reordered
+        unsigned int ptag;
+        if (d_tag != NULL)
+            {
+            ptag = d_tag[idx];
+            d_member_tag[group_idx] = ptag;
+            }
+        else
+            {
+            ptag = d_member_tag[group_idx];
+            }
 
-    hoomd::RandomGenerator rng(hoomd::RNGIdentifier::ActiveForceCompute, seed, ptag, timestep);
+        hoomd::RandomGenerator rng(hoomd::RNGIdentifier::ActiveForceCompute, seed, ptag, timestep);
 
-    if (is2D) // 2D
-        {
-        Scalar delta_theta; // rotational diffusion angle
-        delta_theta = hoomd::NormalDistribution<Scalar>(rotationConst)(rng);
-        Scalar theta = delta_theta/2.0; // angle on plane defining orientation of active force vector
-        vec3<Scalar> b(0,0,slow::sin(theta));
+        if (is2D) // 2D
+            {
+            Scalar delta_theta; // rotational diffusion angle
+            delta_theta = hoomd::NormalDistribution<Scalar>(rotationConst)(rng);
+            Scalar theta = delta_theta/2.0; // angle on plane defining orientation of active force vector
+            vec3<Scalar> b(0,0,slow::sin(theta));
 
-        quat<Scalar> rot_quat(slow::cos(theta),b);
+            quat<Scalar> rot_quat(slow::cos(theta),b);
 
-        quati = rot_quat*quati;
-        d_orientation[idx] = quat_to_scalar4(quati);
-        // in 2D there is only one meaningful direction for torque
-        }
-    else // 3D: Following Stenhammar, Soft Matter, 2014
-        {
-        if (rx == 0) // if no constraint
+            quati = rot_quat*quati;
+            // in 2D there is only one meaningful direction for torque
+            }
+        else // 3D: Following Stenhammar, Soft Matter, 2014
             {
+            if (rx == 0) // if no constraint
+                {
                 hoomd::SpherePointGenerator<Scalar> unit_vec;
                 vec3<Scalar> rand_vec;
                 unit_vec(rng, rand_vec);
 
-                Scalar4 fact = __ldg(d_f_act + type);
-
                 vec3<Scalar> f(fact.x, fact.y, fact.z);
                 vec3<Scalar> fi = rotate(quati, f);
 
@@ -213,140 +160,97 @@ __global__ void gpu_compute_active_force_rotational_diffusion_kernel(const unsig
                 aux_vec.y *= aux_vec_mag;
                 aux_vec.z *= aux_vec_mag;
 
-
                 Scalar delta_theta = hoomd::NormalDistribution<Scalar>(rotationConst)(rng);
                 Scalar theta = delta_theta/2.0; // angle on plane defining orientation of active force vector
                 quat<Scalar> rot_quat(slow::cos(theta),slow::sin(theta)*aux_vec);
 
                 quati = rot_quat*quati;
-                d_orientation[idx].x = quati.s;
-                d_orientation[idx].y = quati.v.x;
-                d_orientation[idx].z = quati.v.y;
-                d_orientation[idx].w = quati.v.z;
-
-            }
-        else // if constraint
-            {
-            EvaluatorConstraintEllipsoid Ellipsoid(P, rx, ry, rz);
-            Scalar3 current_pos = make_scalar3(posidx.x, posidx.y, posidx.z);
-
-            Scalar3 norm_scalar3 = Ellipsoid.evalNormal(current_pos); // the normal vector to which the particles are confined.
-            vec3<Scalar> norm;
-            norm = vec3<Scalar> (norm_scalar3);
+                }
+            else // if constraint
+                {
+                Scalar3 norm_scalar3 = Ellipsoid.evalNormal(current_pos); // the normal vector to which the particles are confined.
+                vec3<Scalar> norm;
+                norm = vec3<Scalar> (norm_scalar3);
 
-            Scalar delta_theta = hoomd::NormalDistribution<Scalar>(rotationConst)(rng);
-            Scalar theta = delta_theta/2.0; // angle on plane defining orientation of active force vector
-            quat<Scalar> rot_quat(slow::cos(theta),slow::sin(theta)*norm);
+                Scalar delta_theta = hoomd::NormalDistribution<Scalar>(rotationConst)(rng);
+                Scalar theta = delta_theta/2.0; // angle on plane defining orientation of active force vector
+                quat<Scalar> rot_quat(slow::cos(theta),slow::sin(theta)*norm);
 
-            quati = rot_quat*quati;
-            d_orientation[idx] = quat_to_scalar4(quati);
+                quati = rot_quat*quati;
+                }
             }
         }
-    }
 
+    if (constraint || diffusion)
+        {
+        d_orientation[idx] = quat_to_scalar4(quati);
+        }
 
-hipError_t gpu_compute_active_force_set_forces(const unsigned int group_size,
-                                           unsigned int *d_index_array,
-                                           Scalar4 *d_force,
-                                           Scalar4 *d_torque,
-                                           const Scalar4 *d_pos,
-                                           const Scalar4 *d_orientation,
-                                           const Scalar4 *d_f_act,
-                                           const Scalar4 *d_t_act,
-                                           const Scalar3& P,
-                                           const Scalar rx,
-                                           const Scalar ry,
-                                           const Scalar rz,
-                                           const unsigned int N,
-                                           unsigned int block_size)
-    {
-    // setup the grid to run the kernel
-    dim3 grid( group_size / block_size + 1, 1, 1);
-    dim3 threads(block_size, 1, 1);
+    vec3<Scalar> f(fact.w*fact.x, fact.w*fact.y, fact.w*fact.z);
+    vec3<Scalar> fi = rotate(quati, f);
+    d_force[idx] = vec_to_scalar4(fi, 0);
 
-    // run the kernel
-    hipMemset(d_force, 0, sizeof(Scalar4)*N);
-    hipLaunchKernelGGL((gpu_compute_active_force_set_forces_kernel), dim3(grid), dim3(threads), 0, 0,  group_size,
-                                                                    d_index_array,
-                                                                    d_force,
-                                                                    d_torque,
-                                                                    d_pos,
-                                                                    d_orientation,
-                                                                    d_f_act,
-                                                                    d_t_act,
-                                                                    P,
-                                                                    rx,
-                                                                    ry,
-                                                                    rz,
-                                                                    N);
-    return hipSuccess;
+    Scalar4 tact = __ldg(d_t_act + type);
+
+    vec3<Scalar> t(tact.w*tact.x, tact.w*tact.y, tact.w*tact.z);
+    vec3<Scalar> ti = rotate(quati, t);
+    d_torque[idx] = vec_to_scalar4(ti, 0);
     }
 
-hipError_t gpu_compute_active_force_set_constraints(const unsigned int group_size,
-                                                   unsigned int *d_index_array,
-                                                   const Scalar4 *d_pos,
-                                                   Scalar4 *d_orientation,
-                                                   const Scalar4 *d_f_act,
-                                                   const Scalar3& P,
-                                                   const Scalar rx,
-                                                   const Scalar ry,
-                                                   const Scalar rz,
-                                                   unsigned int block_size)
+hipError_t gpu_compute_active_force(const unsigned int group_size,
+                                    const unsigned int *d_index_array,
+                                    unsigned int *d_member_tag,
+                                    const unsigned int *d_tag,
+                                    Scalar4 *d_force,
+                                    Scalar4 *d_torque,
+                                    const Scalar4 *d_pos,
+                                    Scalar4 *d_orientation,
+                                    const Scalar4 *d_f_act,
+                                    const Scalar4 *d_t_act,
+                                    const Scalar3& P,
+                                    const Scalar rx,
+                                    const Scalar ry,
+                                    const Scalar rz,
+                                    const bool constraint,
+                                    const bool diffusion,
+                                    const bool is2D,
+                                    const Scalar rotationConst,
+                                    const unsigned int timestep,
+                                    const int seed,
+                                    const unsigned int N,
+                                    unsigned int block_size)
     {
-    // setup the grid to run the kernel
-    dim3 grid( group_size / block_size + 1, 1, 1);
-    dim3 threads(block_size, 1, 1);
+    // zero forces so we don't leave any forces set for indices that are no longer part of our group
+    hipMemset(d_force, 0, sizeof(Scalar4)*N);
+    hipMemset(d_torque, 0, sizeof(Scalar4)*N);
 
-    // run the kernel
-    hipLaunchKernelGGL((gpu_compute_active_force_set_constraints_kernel), dim3(grid), dim3(threads), 0, 0, group_size,
-                                                                    d_index_array,
-                                                                    d_pos,
-                                                                    d_orientation,
-                                                                    d_f_act,
-                                                                    P,
-                                                                    rx,
-                                                                    ry,
-                                                                    rz);
-    return hipSuccess;
-    }
+    if (group_size == 0)
+        return hipSuccess;
 
-hipError_t gpu_compute_active_force_rotational_diffusion(const unsigned int group_size,
-                                                       unsigned int *d_tag,
-                                                       unsigned int *d_index_array,
-                                                       const Scalar4 *d_pos,
-                                                       Scalar4 *d_orientation,
-                                                       const Scalar4 *d_f_act,
-                                                       const Scalar3& P,
-                                                       const Scalar rx,
-                                                       const Scalar ry,
-                                                       const Scalar rz,
-                                                       bool is2D,
-                                                       const Scalar rotationConst,
-                                                       const unsigned int timestep,
-                                                       const int seed,
-                                                       unsigned int block_size)
-    {
     // setup the grid to run the kernel
     dim3 grid( group_size / block_size + 1, 1, 1);
     dim3 threads(block_size, 1, 1);
 
     // run the kernel
-    hipLaunchKernelGGL((gpu_compute_active_force_rotational_diffusion_kernel), dim3(grid), dim3(threads), 0, 0, group_size,
-                                                                    d_tag,
+    hipLaunchKernelGGL((gpu_compute_active_force_kernel), dim3(grid), dim3(threads), 0, 0, group_size,
                                                                     d_index_array,
+                                                                    d_member_tag,
+                                                                    d_tag,
+                                                                    d_force,
+                                                                    d_torque,
                                                                     d_pos,
                                                                     d_orientation,
                                                                     d_f_act,
+                                                                    d_t_act,
                                                                     P,
                                                                     rx,
                                                                     ry,
                                                                     rz,
+                                                                    constraint,
+                                                                    diffusion,
                                                                     is2D,
                                                                     rotationConst,
                                                                     timestep,
                                                                     seed);
     return hipSuccess;
     }
-
-
-
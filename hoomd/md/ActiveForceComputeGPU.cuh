@@ -15,48 +15,28 @@
 #ifndef __ACTIVE_FORCE_COMPUTE_GPU_CUH__
 #define __ACTIVE_FORCE_COMPUTE_GPU_CUH__
 
-hipError_t gpu_compute_active_force_set_forces(const unsigned int group_size,
-                                           unsigned int *d_index_array,
-                                           Scalar4 *d_force,
-                                           Scalar4 *d_torque,
-                                           const Scalar4 *d_pos,
-                                           const Scalar4 *d_orientation,
-                                           const Scalar4 *d_f_act,
-                                           const Scalar4 *d_t_act,
-                                           const Scalar3& P,
-                                           const Scalar rx,
-                                           const Scalar ry,
-                                           const Scalar rz,
-                                           const unsigned int N,
-                                           unsigned int block_size);
-
-hipError_t gpu_compute_active_force_set_constraints(const unsigned int group_size,
-                                                   unsigned int *d_index_array,
-                                                   const Scalar4 *d_pos,
-                                                   Scalar4 *d_orientation,
-                                                   const Scalar4 *d_f_act,
-                                                   const Scalar3& P,
-                                                   const Scalar rx,
-                                                   const Scalar ry,
-                                                   const Scalar rz,
-                                                   unsigned int block_size);
-
-hipError_t gpu_compute_active_force_rotational_diffusion(const unsigned int group_size,
-                                                       unsigned int *d_tag,
-                                                       unsigned int *d_index_array,
-                                                       const Scalar4 *d_pos,
-                                                       Scalar4 *d_orientation,
-                                                       const Scalar4 *d_f_act,
-                                                       const Scalar3& P,
-                                                       const Scalar rx,
-                                                       const Scalar ry,
-                                                       const Scalar rz,
-                                                       bool is2D,
-                                                       const Scalar rotationDiff,
-                                                       const unsigned int timestep,
-                                                       const int seed,
-                                                       unsigned int block_size);
-
-
+//! Applies the constraint and the rotational diffusion and sets the active forces in one kernel
+hipError_t gpu_compute_active_force(const unsigned int group_size,
+                                    const unsigned int *d_index_array,
+                                    unsigned int *d_member_tag,
+                                    const unsigned int *d_tag,
+                                    Scalar4 *d_force,
+                                    Scalar4 *d_torque,
+                                    const Scalar4 *d_pos,
+                                    Scalar4 *d_orientation,
+                                    const Scalar4 *d_f_act,
+                                    const Scalar4 *d_t_act,
+                                    const Scalar3& P,
+                                    const Scalar rx,
+                                    const Scalar ry,
+                                    const Scalar rz,
+                                    const bool constraint,
+                                    const bool diffusion,
+                                    const bool is2D,
+                                    const Scalar rotationConst,
+                                    const unsigned int timestep,
+                                    const int seed,
+                                    const unsigned int N,
+                                    unsigned int block_size);
 
 #endif
@@ -35,17 +35,24 @@ class PYBIND11_EXPORT ActiveForceComputeGPU : public ActiveForceCompute
                              Scalar ry,
                              Scalar rz);
 
+        //! Destructor
+        virtual ~ActiveForceComputeGPU();
+
     protected:
         unsigned int m_block_size;  //!< block size to execute on the GPU
 
-        //! Set forces for particles
-        virtual void setForces();
+        //! Apply the constraint and rotational diffusion and set the forces in one kernel
+        virtual void computeForces(unsigned int timestep);
 
-        //! Orientational diffusion for spherical particles
-        virtual void rotationalDiffusion(unsigned int timestep);
+    private:
+        GlobalVector<unsigned int> m_member_tag;    //!< Tags of the group members, in group order
+        bool m_member_tag_valid;                    //!< True if m_member_tag matches the current group members
 
-        //! Set constraints if particles confined to a surface
-        virtual void setConstraint();
+        //! Called when the particles are reordered or the group members may have changed
+        void slotMembersChanged()
+            {
+            m_member_tag_valid = false;
+            }
     };
 
 //! Exports the ActiveForceComputeGPU Class to python
@@ -31,6 +31,7 @@
 #include "EvaluatorPairFourier.h"
 #include "EvaluatorPairSLJ.h"
 #include "EvaluatorPairDLVO.h"
+#include "EvaluatorPairSum.h"
 
 //! Compute lj pair forces on the GPU with PairEvaluatorLJ
 hipError_t __attribute__((visibility("default")))
@@ -127,4 +128,14 @@ hipError_t __attribute__((visibility("default")))
 gpu_compute_fourier_forces(const pair_args_t & pair_args,
                            const EvaluatorPairFourier::param_type *d_params);
 
+//! Compute the sum of lj and yukawa pair forces on the GPU in one pass over the neighbor list
+hipError_t __attribute__((visibility("default")))
+gpu_compute_lj_yukawa_forces(const pair_args_t& pair_args,
+                             const EvaluatorPairSum<EvaluatorPairLJ, EvaluatorPairYukawa>::param_type *d_params);
+
+//! Compute the sum of lj and real space ewald pair forces on the GPU in one pass over the neighbor list
+hipError_t __attribute__((visibility("default")))
+gpu_compute_lj_ewald_forces(const pair_args_t& pair_args,
+                            const EvaluatorPairSum<EvaluatorPairLJ, EvaluatorPairEwald>::param_type *d_params);
+
 #endif
@@ -26,6 +26,7 @@
 #include "EvaluatorPairLJ1208.h"
 #include "EvaluatorPairDLVO.h"
 #include "EvaluatorPairFourier.h"
+#include "EvaluatorPairSum.h"
 
 #ifdef ENABLE_HIP
 #include "PotentialPairGPU.h"
@@ -80,6 +81,10 @@ typedef PotentialPair<EvaluatorPairLJ1208> PotentialPairLJ1208;
 typedef PotentialPair<EvaluatorPairDLVO> PotentialPairDLVO;
 //! Pair potential force compute for Fourier potential
 typedef PotentialPair<EvaluatorPairFourier> PotentialPairFourier;
+//! Pair potential force compute for the sum of lj and yukawa forces
+typedef PotentialPair<EvaluatorPairSum<EvaluatorPairLJ, EvaluatorPairYukawa> > PotentialPairLJYukawa;
+//! Pair potential force compute for the sum of lj and real space ewald forces
+typedef PotentialPair<EvaluatorPairSum<EvaluatorPairLJ, EvaluatorPairEwald> > PotentialPairLJEwald;
 
 #ifdef ENABLE_HIP
 //! Pair potential force compute for lj forces on the GPU
@@ -120,6 +125,12 @@ typedef PotentialPairGPU< EvaluatorPairLJ1208, gpu_compute_lj1208_forces > Poten
 typedef PotentialPairGPU< EvaluatorPairDLVO, gpu_compute_dlvo_forces > PotentialPairDLVOGPU;
 //! Pair potential force compute for Fourier forces on the gpu
 typedef PotentialPairGPU<EvaluatorPairFourier, gpu_compute_fourier_forces> PotentialPairFourierGPU;
+//! Pair potential force compute for the sum of lj and yukawa forces on the GPU
+typedef PotentialPairGPU<EvaluatorPairSum<EvaluatorPairLJ, EvaluatorPairYukawa>,
+                         gpu_compute_lj_yukawa_forces> PotentialPairLJYukawaGPU;
+//! Pair potential force compute for the sum of lj and real space ewald forces on the GPU
+typedef PotentialPairGPU<EvaluatorPairSum<EvaluatorPairLJ, EvaluatorPairEwald>,
+                         gpu_compute_lj_ewald_forces> PotentialPairLJEwaldGPU;
 #endif
 
 #endif // __PAIR_POTENTIALS_H__
@@ -52,6 +52,11 @@
 
     \note XPLOR switching is not supported
 
+    Evaluators that only depend on one axis of each particle in the space frame, such as the long axis of a Gay-Berne
+    ellipsoid or the direction of a dipole, return true from needsBodyAxis(). AnisoPotentialPair then rotates
+    getBodyAxis() by the orientation of every local and ghost particle once per step into m_body_axis and hands the
+    result to setBodyAxes(), so the evaluators do not convert the quaternions of both particles for every pair.
+
     <b>Implementation details</b>
 
     rcutsq and the params are stored per particle type pair. It wastes a little bit of space, but benchmarks
@@ -174,6 +179,7 @@ class AnisoPotentialPair : public ForceCompute
         GlobalArray<Scalar> m_rcutsq;                  //!< Cutoff radius squared per type pair
         GlobalArray<param_type> m_params;   //!< Pair parameters per type pair
         GlobalArray<shape_param_type> m_shape_params;   //!< Pair parameters per type pair
+        GlobalArray<Scalar4> m_body_axis;           //!< Body axis of the local and ghost particles in the space frame
         std::string m_prof_name;                    //!< Cached profiler name
         std::string m_log_name;                     //!< Cached log name
 
@@ -186,6 +192,16 @@ class AnisoPotentialPair : public ForceCompute
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
+        //! Grow m_body_axis to hold the local and ghost particles
+        void resizeBodyAxes()
+            {
+            if (m_body_axis.getNumElements() < m_pdata->getN() + m_pdata->getNGhosts())
+                {
+                GlobalArray<Scalar4> body_axis(m_pdata->getMaxN(), m_exec_conf);
+                m_body_axis.swap(body_axis);
+                }
+            }
+
         //! Method to be called when number of types changes
         void slotNumTypesChange()
             {
@@ -498,6 +514,19 @@ void AnisoPotentialPair< aniso_evaluator >::computeForces(unsigned int timestep)
     ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
     ArrayHandle<shape_param_type> h_shape_params(m_shape_params, access_location::host, access_mode::read);
 
+    // rotate the body axis of each particle into the space frame once, instead of for every pair
+    resizeBodyAxes();
+    ArrayHandle<Scalar4> h_body_axis(m_body_axis, access_location::host, access_mode::overwrite);
+    if (aniso_evaluator::needsBodyAxis())
+        {
+        const vec3<Scalar> body_axis = aniso_evaluator::getBodyAxis();
+        for (unsigned int i = 0; i < m_pdata->getN() + m_pdata->getNGhosts(); i++)
+            {
+            vec3<Scalar> a = rotate(quat<Scalar>(h_orientation.data[i]), body_axis);
+            h_body_axis.data[i] = make_scalar4(a.x, a.y, a.z, Scalar(0.0));
+            }
+        }
+
     {
     // need to start from a zero force, energy and virial
     memset(&h_force.data[0] , 0, sizeof(Scalar4)*m_pdata->getN());
@@ -598,6 +627,9 @@ void AnisoPotentialPair< aniso_evaluator >::computeForces(unsigned int timestep)
                 eval.setShape(&h_shape_params.data[typei], &h_shape_params.data[typej]);
             if (aniso_evaluator::needsTags())
                 eval.setTags(h_tag.data[i], h_tag.data[j]);
+            if (aniso_evaluator::needsBodyAxis())
+                eval.setBodyAxes(make_scalar3(h_body_axis.data[i].x, h_body_axis.data[i].y, h_body_axis.data[i].z),
+                                 make_scalar3(h_body_axis.data[j].x, h_body_axis.data[j].y, h_body_axis.data[j].z));
 
             bool evaluated = eval.evaluate(force, pair_eng, energy_shift,torque_i,torque_j);
 
@@ -9,6 +9,7 @@
 #include "hoomd/ParticleData.cuh"
 #include "hoomd/Index1D.h"
 #include "hoomd/TextureTools.h"
+#include "hoomd/VectorMath.h"
 #include "hoomd/GPUPartition.cuh"
 
 #ifdef __HIPCC__
@@ -40,10 +41,12 @@ struct a_pair_args_t
               size_t _virial_pitch,
               const unsigned int _N,
               const unsigned int _n_max,
+              const unsigned int _n_ghost,
               const Scalar4 *_d_pos,
               const Scalar *_d_diameter,
               const Scalar *_d_charge,
               const Scalar4 *_d_orientation,
+              Scalar4 *_d_body_axis,
               const unsigned int *_d_tag,
               const BoxDim& _box,
               const unsigned int *_d_n_neigh,
@@ -65,10 +68,12 @@ struct a_pair_args_t
                   virial_pitch(_virial_pitch),
                   N(_N),
                   n_max(_n_max),
+                  n_ghost(_n_ghost),
                   d_pos(_d_pos),
                   d_diameter(_d_diameter),
                   d_charge(_d_charge),
                   d_orientation(_d_orientation),
+                  d_body_axis(_d_body_axis),
                   d_tag(_d_tag),
                   box(_box),
                   d_n_neigh(_d_n_neigh),
@@ -92,10 +97,12 @@ struct a_pair_args_t
     const size_t virial_pitch; //!< The pitch of the 2D array of virial matrix elements
     const unsigned int N;           //!< number of particles
     const unsigned int n_max;       //!< maximum size of particle data arrays
+    const unsigned int n_ghost;     //!< number of ghost particles
     const Scalar4 *d_pos;           //!< particle positions
     const Scalar *d_diameter;       //!< particle diameters
     const Scalar *d_charge;         //!< particle charges
     const Scalar4 *d_orientation;   //!< particle orientation to compute forces over
+    Scalar4 *d_body_axis;           //!< body axis of the local and ghost particles in the space frame (output)
     const unsigned int *d_tag;      //!< particle tags to compute forces over
     const BoxDim& box;              //!< Simulation box in GPU format
     const unsigned int *d_n_neigh;  //!< Device array listing the number of neighbors on each particle
@@ -114,6 +121,24 @@ struct a_pair_args_t
 
 #ifdef __HIPCC__
 
+//! Kernel for rotating the body axis of each particle into the space frame
+/*! \param d_body_axis Output: evaluator::getBodyAxis() rotated by the orientation of each particle
+    \param d_orientation Particle orientations
+    \param n Number of local and ghost particles
+*/
+template< class evaluator >
+__global__ void gpu_compute_aniso_body_axes_kernel(Scalar4 *d_body_axis,
+                                                   const Scalar4 *d_orientation,
+                                                   const unsigned int n)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= n)
+        return;
+
+    vec3<Scalar> a = rotate(quat<Scalar>(__ldg(d_orientation + idx)), evaluator::getBodyAxis());
+    d_body_axis[idx] = make_scalar4(a.x, a.y, a.z, Scalar(0.0));
+    }
+
 //! Kernel for calculating pair forces
 /*! This kernel is called to calculate the pair forces on all N particles. Actual evaluation of the potentials and
     forces for each pair is handled via the template class \a evaluator.
@@ -127,6 +152,7 @@ struct a_pair_args_t
     \param d_diameter particle diameters
     \param d_charge particle charges
     \param d_orientation Quaternion data on the GPU to calculate forces on
+    \param d_body_axis Body axes in the space frame from gpu_compute_aniso_body_axes_kernel()
     \param d_tag Tag data on the GPU to calculate forces on
     \param box Box dimensions used to implement periodic boundary conditions
     \param d_n_neigh Device memory array listing the number of neighbors for each particle
@@ -163,6 +189,7 @@ __global__ void gpu_compute_pair_aniso_forces_kernel(Scalar4 *d_force,
                                                      const Scalar *d_diameter,
                                                      const Scalar *d_charge,
                                                      const Scalar4 *d_orientation,
+                                                     const Scalar4 *d_body_axis,
                                                      const unsigned int *d_tag,
                                                      const BoxDim box,
                                                      const unsigned int *d_n_neigh,
@@ -256,6 +283,10 @@ __global__ void gpu_compute_pair_aniso_forces_kernel(Scalar4 *d_force,
         Scalar3 posi = make_scalar3(postypei.x, postypei.y, postypei.z);
         Scalar4 quati = __ldg(d_orientation + idx);
 
+        Scalar4 axisi = make_scalar4(Scalar(0), Scalar(0), Scalar(0), Scalar(0));
+        if (evaluator::needsBodyAxis())
+            axisi = __ldg(d_body_axis + idx);
+
         Scalar di = Scalar(0);
         if (evaluator::needsDiameter())
             di = __ldg(d_diameter + idx);
@@ -287,6 +318,10 @@ __global__ void gpu_compute_pair_aniso_forces_kernel(Scalar4 *d_force,
                 Scalar3 posj = make_scalar3(postypej.x, postypej.y, postypej.z);
                 Scalar4 quatj = __ldg(d_orientation + cur_j);
 
+                Scalar4 axisj = make_scalar4(Scalar(0), Scalar(0), Scalar(0), Scalar(0));
+                if (evaluator::needsBodyAxis())
+                    axisj = __ldg(d_body_axis + cur_j);
+
                 Scalar dj = Scalar(0);
                 if (evaluator::needsDiameter())
                     dj = __ldg(d_diameter + cur_j);
@@ -332,6 +367,9 @@ __global__ void gpu_compute_pair_aniso_forces_kernel(Scalar4 *d_force,
                                   &(s_shape_params[__scalar_as_int(postypej.w)]));
                 if (evaluator::needsTags())
                     eval.setTags(__ldg(d_tag + idx), __ldg(d_tag + cur_j));
+                if (evaluator::needsBodyAxis())
+                    eval.setBodyAxes(make_scalar3(axisi.x, axisi.y, axisi.z),
+                                     make_scalar3(axisj.x, axisj.y, axisj.z));
 
                 // call evaluator
                 eval.evaluate(jforce, pair_eng, energy_shift, torquei, torquej);
@@ -492,6 +530,7 @@ struct AnisoPairForceComputeKernel
                                                    pair_args.d_diameter,
                                                    pair_args.d_charge,
                                                    pair_args.d_orientation,
+                                                   pair_args.d_body_axis,
                                                    pair_args.d_tag,
                                                    pair_args.box,
                                                    pair_args.d_n_neigh,
@@ -537,6 +576,19 @@ hipError_t gpu_compute_pair_aniso_forces(const a_pair_args_t& pair_args,
     assert(pair_args.d_rcutsq);
     assert(pair_args.ntypes > 0);
 
+    if (evaluator::needsBodyAxis())
+        {
+        // the force kernels on every GPU read the axes of all neighbors, compute them once on the first GPU
+        pair_args.gpu_partition.getRangeAndSetGPU(0);
+        unsigned int n = pair_args.N + pair_args.n_ghost;
+        unsigned int block_size = 256;
+        hipLaunchKernelGGL((gpu_compute_aniso_body_axes_kernel<evaluator>), dim3(n / block_size + 1),
+                           dim3(block_size), 0, 0, pair_args.d_body_axis, pair_args.d_orientation, n);
+
+        if (pair_args.gpu_partition.getNumActiveGPUs() > 1)
+            hipDeviceSynchronize();
+        }
+
     // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
     for (int idev = pair_args.gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
         {
@@ -143,6 +143,8 @@ void AnisoPotentialPairGPU< evaluator, gpu_cgpf >::computeForces(unsigned int ti
     ArrayHandle<Scalar> d_diameter(this->m_pdata->getDiameters(), access_location::device, access_mode::read);
     ArrayHandle<Scalar> d_charge(this->m_pdata->getCharges(), access_location::device, access_mode::read);
     ArrayHandle<Scalar4> d_orientation(this->m_pdata->getOrientationArray(),access_location::device,access_mode::read);
+    this->resizeBodyAxes();
+    ArrayHandle<Scalar4> d_body_axis(this->m_body_axis, access_location::device, access_mode::overwrite);
     ArrayHandle<unsigned int> d_tag(this->m_pdata->getTags(), access_location::device, access_mode::read);
 
     BoxDim box = this->m_pdata->getBox();
@@ -176,10 +178,12 @@ void AnisoPotentialPairGPU< evaluator, gpu_cgpf >::computeForces(unsigned int ti
                            this->m_virial.getPitch(),
                            this->m_pdata->getN(),
                            this->m_pdata->getMaxN(),
+                           this->m_pdata->getNGhosts(),
                            d_pos.data,
                            d_diameter.data,
                            d_charge.data,
                            d_orientation.data,
+                           d_body_axis.data,
                            d_tag.data,
                            box,
                            d_n_neigh.data,
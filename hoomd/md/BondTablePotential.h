@@ -48,6 +48,9 @@
     Values are interpolated linearly between two points straddling the given r. For a given r, the first point needed, i
     can be calculated via i = floorf((r - rmin) / dr). The fraction between ri and ri+1 can be calculated via
     f = (r - rmin) / dr - float(i). And the linear interpolation can then be performed via V(r) ~= Vi + f * (Vi+1 - Vi)
+
+    When setCubic() is enabled, V is interpolated with the cubic Hermite polynomial through Vi and Vi+1 with the slopes
+    -Fi and -Fi+1, and F is its derivative (see interpolateTable()).
     \ingroup computes
 */
 class PYBIND11_EXPORT BondTablePotential : public ForceCompute
@@ -68,6 +71,20 @@ class PYBIND11_EXPORT BondTablePotential : public ForceCompute
                               Scalar rmin,
                               Scalar rmax);
 
+        //! Set the interpolation scheme
+        /*! \param cubic Set to true for cubic Hermite interpolation, false for linear interpolation
+        */
+        void setCubic(bool cubic)
+            {
+            m_cubic = cubic;
+            }
+
+        //! Test if the tables are interpolated with cubic Hermite polynomials
+        bool getCubic()
+            {
+            return m_cubic;
+            }
+
         //! Returns a list of log quantities this compute calculates
         virtual std::vector< std::string > getProvidedLogQuantities();
 
@@ -94,6 +111,7 @@ class PYBIND11_EXPORT BondTablePotential : public ForceCompute
         GPUArray<Scalar4> m_params;                 //!< Parameters stored for each table
         Index2D m_table_value;                      //!< Index table helper
         std::string m_log_name;                     //!< Cached log name
+        bool m_cubic = false;                       //!< True for cubic Hermite interpolation
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
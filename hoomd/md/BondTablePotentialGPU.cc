@@ -94,6 +94,7 @@ void BondTablePotentialGPU::computeForces(unsigned int timestep)
                              m_table_width,
                              m_table_value,
                              d_flags.data,
+                             m_cubic,
                              m_tuner->getParam());
         }
 
@@ -6,6 +6,7 @@
 // Maintainer: joaander
 
 #include "BondTablePotentialGPU.cuh"
+#include "TableInterpolation.h"
 #include "hoomd/TextureTools.h"
 
 
@@ -30,6 +31,7 @@
     \param d_params Parameters for each table associated with a type pair
     \param table_value index helper function
     \param d_flags Flag allocated on the device for use in checking for bonds that cannot be evaluated
+    \param cubic Set to true for cubic Hermite interpolation of the tables
 
     See BondTablePotential for information on the memory layout.
 */
@@ -46,7 +48,8 @@ __global__ void gpu_compute_bondtable_forces_kernel(Scalar4* d_force,
                                      const Scalar2 *d_tables,
                                      const Scalar4 *d_params,
                                      const Index2D table_value,
-                                     unsigned int *d_flags)
+                                     unsigned int *d_flags,
+                                     const bool cubic)
     {
 
 
@@ -119,18 +122,13 @@ __global__ void gpu_compute_bondtable_forces_kernel(Scalar4* d_force,
 
             Scalar2 VF0 = __ldg(d_tables + table_value(value_i, cur_bond_type));
             Scalar2 VF1 = __ldg(d_tables + table_value(value_i+1, cur_bond_type));
-            // unpack the data
-            Scalar V0 = VF0.x;
-            Scalar V1 = VF1.x;
-            Scalar F0 = VF0.y;
-            Scalar F1 = VF1.y;
 
-            // compute the linear interpolation coefficient
+            // compute the interpolation coefficient
             Scalar f = value_f - Scalar(value_i);
 
             // interpolate to get V and F;
-            Scalar V = V0 + f * (V1 - V0);
-            Scalar F = F0 + f * (F1 - F0);
+            Scalar V, F;
+            interpolateTable(VF0, VF1, f, delta_r, cubic, V, F);
 
             // convert to standard variables used by the other pair computes in HOOMD-blue
             Scalar forcemag_divr = 0.0f;
@@ -182,6 +180,7 @@ __global__ void gpu_compute_bondtable_forces_kernel(Scalar4* d_force,
     \param table_value indexer helper
     \param d_flags flags on the device - a 1 will be written if evaluation
                    of forces failed for any bond
+    \param cubic Set to true for cubic Hermite interpolation of the tables
     \param block_size Block size at which to run the kernel
 
     \note This is just a kernel driver. See gpu_compute_bondtable_forces_kernel for full documentation.
@@ -201,6 +200,7 @@ hipError_t gpu_compute_bondtable_forces(Scalar4* d_force,
                                      const unsigned int table_width,
                                      const Index2D &table_value,
                                      unsigned int *d_flags,
+                                     const bool cubic,
                                      const unsigned int block_size)
     {
     assert(d_params);
@@ -235,7 +235,8 @@ hipError_t gpu_compute_bondtable_forces(Scalar4* d_force,
              d_tables,
              d_params,
              table_value,
-             d_flags);
+             d_flags,
+             cubic);
 
     return hipSuccess;
     }
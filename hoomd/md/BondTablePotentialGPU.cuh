@@ -32,6 +32,7 @@ hipError_t gpu_compute_bondtable_forces(Scalar4* d_force,
                                      const unsigned int table_width,
                                      const Index2D &table_value,
                                      unsigned int *d_flags,
+                                     const bool cubic,
                                      const unsigned int block_size);
 
 #endif
@@ -15,3 +15,5 @@ hipError_t gpu_compute_buckingham_forces(const pair_args_t & args,
                                                      d_params);
     }
 
+template hipError_t gpu_compute_pair_set_energy<EvaluatorPairBuckingham>(const pair_set_energy_args_t& args,
+    const EvaluatorPairBuckingham::param_type *d_params);
@@ -0,0 +1,63 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "CGEnergyMinimizer.h"
+
+#include <algorithm>
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \file CGEnergyMinimizer.cc
+    \brief Contains code for the CGEnergyMinimizer class
+*/
+
+/*! \param sysdef SystemDefinition this method will act on. Must not be NULL.
+    \param max_move largest distance any particle may move in one step
+*/
+CGEnergyMinimizer::CGEnergyMinimizer(std::shared_ptr<SystemDefinition> sysdef, Scalar max_move)
+    :   LineSearchEnergyMinimizer(sysdef, max_move)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CGEnergyMinimizer" << endl;
+
+    // conjugate directions assume a nearly exact line search
+    m_wolfe_c2 = Scalar(0.1);
+    }
+
+CGEnergyMinimizer::~CGEnergyMinimizer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying CGEnergyMinimizer" << endl;
+    }
+
+/*! \param n Number of local group members
+    \param grad Gradient at the current point
+    \param old_grad Gradient at the previous point
+    \param dir Search direction of the previous step on input, new search direction on output
+    \param step Length of the previous step along the previous direction
+*/
+void CGEnergyMinimizer::computeDirection(unsigned int n, const Scalar3 *grad, const Scalar3 *old_grad,
+    Scalar3 *dir, Scalar step)
+    {
+    Scalar gg = dotProduct(n, grad, grad);
+    Scalar g_old_g = dotProduct(n, grad, old_grad);
+    Scalar old_gg = dotProduct(n, old_grad, old_grad);
+
+    Scalar beta(0.0);
+    if (old_gg > Scalar(0.0))
+        beta = std::max(Scalar(0.0), (gg - g_old_g)/old_gg);
+
+    for (unsigned int k = 0; k < n; k++)
+        {
+        dir[k].x = -grad[k].x + beta*dir[k].x;
+        dir[k].y = -grad[k].y + beta*dir[k].y;
+        dir[k].z = -grad[k].z + beta*dir[k].z;
+        }
+    }
+
+void export_CGEnergyMinimizer(py::module& m)
+    {
+    py::class_<CGEnergyMinimizer, LineSearchEnergyMinimizer, std::shared_ptr<CGEnergyMinimizer> >(m,
+        "CGEnergyMinimizer")
+        .def(py::init< std::shared_ptr<SystemDefinition>, Scalar >())
+        ;
+    }
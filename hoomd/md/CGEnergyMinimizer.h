@@ -0,0 +1,47 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "LineSearchEnergyMinimizer.h"
+
+#ifndef __CG_ENERGY_MINIMIZER_H__
+#define __CG_ENERGY_MINIMIZER_H__
+
+/*! \file CGEnergyMinimizer.h
+    \brief Declares the nonlinear conjugate gradient energy minimizer class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+//! Finds the nearest basin in the potential energy landscape with nonlinear conjugate gradients
+/*! \b Overview
+
+    The search direction is d = -g + beta d_prev with the Polak-Ribiere coefficient
+    beta = max(0, g.(g - g_prev)/(g_prev.g_prev)). A negative beta restarts the search along the forces.
+    The line search uses the curvature condition with c2 = 0.1.
+
+    \ingroup updaters
+*/
+class PYBIND11_EXPORT CGEnergyMinimizer : public LineSearchEnergyMinimizer
+    {
+    public:
+        //! Constructs the minimizer and associates it with the system
+        CGEnergyMinimizer(std::shared_ptr<SystemDefinition> sysdef, Scalar max_move);
+        virtual ~CGEnergyMinimizer();
+
+    protected:
+        //! The direction only depends on the previous direction and gradient, which the base class stores
+        virtual void resetDirection() { }
+
+        //! Compute the conjugate direction
+        virtual void computeDirection(unsigned int n, const Scalar3 *grad, const Scalar3 *old_grad, Scalar3 *dir,
+            Scalar step);
+    };
+
+//! Exports the CGEnergyMinimizer class to python
+void export_CGEnergyMinimizer(pybind11::module& m);
+
+#endif // #ifndef __CG_ENERGY_MINIMIZER_H__
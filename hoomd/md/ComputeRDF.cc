@@ -0,0 +1,301 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ComputeRDF.cc
+    \brief Contains code for the ComputeRDF class
+*/
+
+#include "ComputeRDF.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/Communicator.h"
+#endif
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+namespace py = pybind11;
+
+const unsigned int ComputeRDF::ALL_TYPES;
+
+/*! \param sysdef System for which to compute the radial distribution function
+    \param r_max Maximum pair distance
+    \param bins Number of bins between 0 and \a r_max
+    \param type_a Type of the first particle in a pair, ALL_TYPES for any type
+    \param type_b Type of the second particle in a pair, ALL_TYPES for any type
+*/
+ComputeRDF::ComputeRDF(std::shared_ptr<SystemDefinition> sysdef,
+                       Scalar r_max,
+                       unsigned int bins,
+                       unsigned int type_a,
+                       unsigned int type_b)
+    : Compute(sysdef), m_r_max(r_max), m_bins(bins), m_type_a(type_a), m_type_b(type_b),
+      m_num_samples(0), m_norm(0.0), m_comm_ghost_layer_connected(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing ComputeRDF" << endl;
+
+    if (r_max <= Scalar(0.0))
+        {
+        m_exec_conf->msg->error() << "compute.rdf: r_max must be positive" << endl;
+        throw runtime_error("Error initializing ComputeRDF");
+        }
+    if (bins == 0)
+        {
+        m_exec_conf->msg->error() << "compute.rdf: bins must be positive" << endl;
+        throw runtime_error("Error initializing ComputeRDF");
+        }
+    if ((type_a != ALL_TYPES && type_a >= m_pdata->getNTypes())
+        || (type_b != ALL_TYPES && type_b >= m_pdata->getNTypes()))
+        {
+        m_exec_conf->msg->error() << "compute.rdf: invalid particle type" << endl;
+        throw runtime_error("Error initializing ComputeRDF");
+        }
+
+    GlobalArray<unsigned long long> counts(m_bins, m_exec_conf);
+    m_counts.swap(counts);
+    TAG_ALLOCATION(m_counts);
+
+    GlobalArray<unsigned int> num_type(2, m_exec_conf);
+    m_num_type.swap(num_type);
+    TAG_ALLOCATION(m_num_type);
+
+    reset();
+
+    m_cl = std::shared_ptr<CellList>(new CellList(sysdef));
+    configureCellList();
+    }
+
+ComputeRDF::~ComputeRDF()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying ComputeRDF" << endl;
+
+    #ifdef ENABLE_MPI
+    if (m_comm_ghost_layer_connected)
+        m_comm->getGhostLayerWidthRequestSignal().disconnect<ComputeRDF, &ComputeRDF::requestGhostLayerWidth>(this);
+    #endif
+    }
+
+void ComputeRDF::configureCellList()
+    {
+    m_cl->setRadius(1);
+    m_cl->setComputeXYZF(true);
+    m_cl->setComputeTDB(false);
+    m_cl->setFlagIndex();
+    m_cl->setNominalWidth(m_r_max);
+    }
+
+#ifdef ENABLE_MPI
+/*! \param comm Communicator of the simulation
+*/
+void ComputeRDF::setCommunicator(std::shared_ptr<Communicator> comm)
+    {
+    if (!m_comm_ghost_layer_connected)
+        {
+        comm->getGhostLayerWidthRequestSignal().connect<ComputeRDF, &ComputeRDF::requestGhostLayerWidth>(this);
+        m_comm_ghost_layer_connected = true;
+        }
+
+    // the cell list includes the ghost particles in its dimensions
+    m_cl->setCommunicator(comm);
+    Compute::setCommunicator(comm);
+    }
+#endif
+
+/*! Adds one sample per time step, calling compute() again on the same time step does nothing.
+
+    \param timestep Current time step of the simulation
+*/
+void ComputeRDF::compute(unsigned int timestep)
+    {
+    if (!shouldCompute(timestep))
+        return;
+
+    // pairs farther apart than half the box would be counted at their minimum image distance
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    Scalar3 npd = global_box.getNearestPlaneDistance();
+    Scalar min_width = min(npd.x, npd.y);
+    if (m_sysdef->getNDimensions() == 3)
+        min_width = min(min_width, npd.z);
+    if (m_r_max > min_width / Scalar(2.0))
+        {
+        m_exec_conf->msg->error() << "compute.rdf: r_max is larger than half the box width" << endl;
+        throw runtime_error("Error computing the radial distribution function");
+        }
+
+    if (m_prof) m_prof->push(m_exec_conf, "RDF");
+
+    computeHistogram(timestep);
+
+    unsigned int num_type[2];
+        {
+        ArrayHandle<unsigned int> h_num_type(m_num_type, access_location::host, access_mode::read);
+        num_type[0] = h_num_type.data[0];
+        num_type[1] = h_num_type.data[1];
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE, num_type, 2, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    // the ideal gas has N_a (N_b - 1) / V ordered pairs per unit volume when a particle may pair with its own type
+    double n_b = num_type[1];
+    if (m_type_a == m_type_b)
+        n_b -= 1.0;
+    if (n_b > 0.0)
+        m_norm += double(num_type[0]) * n_b / double(global_box.getVolume(m_sysdef->getNDimensions() == 2));
+    m_num_samples++;
+
+    if (m_prof) m_prof->pop(m_exec_conf);
+    }
+
+/*! \param timestep Current time step of the simulation
+*/
+void ComputeRDF::computeHistogram(unsigned int timestep)
+    {
+    m_cl->compute(timestep);
+
+    uint3 dim = m_cl->getDim();
+    Scalar3 ghost_width = m_cl->getGhostWidth();
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    const BoxDim& box = m_pdata->getBox();
+    uchar3 periodic = box.getPeriodic();
+
+    ArrayHandle<unsigned int> h_cell_size(m_cl->getCellSizeArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_cell_xyzf(m_cl->getXYZFArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_adj(m_cl->getCellAdjArray(), access_location::host, access_mode::read);
+    Index3D ci = m_cl->getCellIndexer();
+    Index2D cli = m_cl->getCellListIndexer();
+    Index2D cadji = m_cl->getCellAdjIndexer();
+
+    ArrayHandle<unsigned long long> h_counts(m_counts, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_num_type(m_num_type, access_location::host, access_mode::overwrite);
+    h_num_type.data[0] = 0;
+    h_num_type.data[1] = 0;
+
+    const Scalar r_maxsq = m_r_max * m_r_max;
+    const Scalar bin_scale = Scalar(m_bins) / m_r_max;
+
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        {
+        const Scalar3 pos_i = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
+
+        if (m_type_b == ALL_TYPES || type_i == m_type_b)
+            h_num_type.data[1]++;
+        if (m_type_a != ALL_TYPES && type_i != m_type_a)
+            continue;
+        h_num_type.data[0]++;
+
+        // find the cell of the particle
+        Scalar3 f = box.makeFraction(pos_i, ghost_width);
+        int ib = (unsigned int)(f.x * dim.x);
+        int jb = (unsigned int)(f.y * dim.y);
+        int kb = (unsigned int)(f.z * dim.z);
+
+        // handle the case where the particle is exactly at the box hi
+        if (ib == (int)dim.x && periodic.x)
+            ib = 0;
+        if (jb == (int)dim.y && periodic.y)
+            jb = 0;
+        if (kb == (int)dim.z && periodic.z)
+            kb = 0;
+
+        unsigned int my_cell = ci(ib, jb, kb);
+
+        for (unsigned int cur_adj = 0; cur_adj < cadji.getW(); cur_adj++)
+            {
+            unsigned int neigh_cell = h_cell_adj.data[cadji(cur_adj, my_cell)];
+            unsigned int size = h_cell_size.data[neigh_cell];
+            for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
+                {
+                const Scalar4& cur_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
+                unsigned int j = __scalar_as_int(cur_xyzf.w);
+                if (j == i)
+                    continue;
+                if (m_type_b != ALL_TYPES && __scalar_as_int(h_pos.data[j].w) != (int)m_type_b)
+                    continue;
+
+                Scalar3 dx = pos_i - make_scalar3(cur_xyzf.x, cur_xyzf.y, cur_xyzf.z);
+                dx = box.minImage(dx);
+                Scalar rsq = dot(dx, dx);
+                if (rsq < r_maxsq)
+                    {
+                    unsigned int bin = (unsigned int)(fast::sqrt(rsq) * bin_scale);
+                    h_counts.data[min(bin, m_bins - 1)]++;
+                    }
+                }
+            }
+        }
+    }
+
+/*! \returns g(r) at the bin centers, averaged over the samples
+
+    The histograms of the ranks are reduced here, so every rank must call getRDF().
+*/
+std::vector<Scalar> ComputeRDF::getRDF()
+    {
+    std::vector<unsigned long long> counts(m_bins);
+        {
+        ArrayHandle<unsigned long long> h_counts(m_counts, access_location::host, access_mode::read);
+        std::copy(h_counts.data, h_counts.data + m_bins, counts.begin());
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE, counts.data(), m_bins, MPI_UNSIGNED_LONG_LONG, MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    std::vector<Scalar> rdf(m_bins, Scalar(0.0));
+    if (m_norm == 0.0)
+        return rdf;
+
+    const double dr = double(m_r_max) / double(m_bins);
+    const bool two_d = m_sysdef->getNDimensions() == 2;
+    for (unsigned int bin = 0; bin < m_bins; bin++)
+        {
+        double r1 = bin * dr;
+        double r2 = r1 + dr;
+        double shell = two_d ? M_PI * (r2*r2 - r1*r1) : 4.0 / 3.0 * M_PI * (r2*r2*r2 - r1*r1*r1);
+        rdf[bin] = Scalar(double(counts[bin]) / (m_norm * shell));
+        }
+    return rdf;
+    }
+
+std::vector<Scalar> ComputeRDF::getBinCenters() const
+    {
+    std::vector<Scalar> centers(m_bins);
+    const Scalar dr = m_r_max / Scalar(m_bins);
+    for (unsigned int bin = 0; bin < m_bins; bin++)
+        centers[bin] = (Scalar(bin) + Scalar(0.5)) * dr;
+    return centers;
+    }
+
+void ComputeRDF::reset()
+    {
+    ArrayHandle<unsigned long long> h_counts(m_counts, access_location::host, access_mode::overwrite);
+    std::fill(h_counts.data, h_counts.data + m_bins, 0ull);
+    m_num_samples = 0;
+    m_norm = 0.0;
+    }
+
+void export_ComputeRDF(py::module& m)
+    {
+    py::class_<ComputeRDF, Compute, std::shared_ptr<ComputeRDF> >(m, "ComputeRDF")
+    .def(py::init< std::shared_ptr<SystemDefinition>, Scalar, unsigned int, unsigned int, unsigned int >())
+    .def_property_readonly("rdf", &ComputeRDF::getRDF)
+    .def_property_readonly("bin_centers", &ComputeRDF::getBinCenters)
+    .def_property_readonly("num_samples", &ComputeRDF::getNumSamples)
+    .def_property_readonly("r_max", &ComputeRDF::getRMax)
+    .def_property_readonly("bins", &ComputeRDF::getBins)
+    .def("reset", &ComputeRDF::reset)
+    .def_readonly_static("ALL_TYPES", &ComputeRDF::ALL_TYPES)
+    ;
+    }
@@ -0,0 +1,119 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/Compute.h"
+#include "hoomd/CellList.h"
+#include "hoomd/GlobalArray.h"
+
+#include <memory>
+#include <vector>
+
+/*! \file ComputeRDF.h
+    \brief Declares a class for computing the radial distribution function
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __COMPUTE_RDF_H__
+#define __COMPUTE_RDF_H__
+
+//! Accumulates the radial distribution function of the particles
+/*! Each call to compute() on a new time step adds one sample to a histogram of the distances between pairs of
+    particles closer than \a r_max. A dedicated cell list with cells at least \a r_max wide provides the pairs, so
+    the neighbor list of the pair forces keeps its own cutoff. Pairs are counted from each local particle \a i to
+    all local and ghost particles \a j, so each pair is counted once on the rank of each of its particles and the
+    histograms of the ranks add up to the global histogram without communicating particles. In MPI simulations, the
+    ghost layer is at least \a r_max wide.
+
+    When \a type_a and \a type_b are set, only pairs from a particle of \a type_a to a particle of \a type_b are
+    counted. Otherwise, all pairs are counted.
+
+    The histogram accumulates in m_counts until reset() is called. getRDF() normalizes it by the number of samples,
+    the number of particles, and the density, and reduces it over the ranks only when it is read.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT ComputeRDF : public Compute
+    {
+    public:
+        //! Matches every particle type
+        static const unsigned int ALL_TYPES = 0xffffffff;
+
+        //! Constructs the compute
+        ComputeRDF(std::shared_ptr<SystemDefinition> sysdef,
+                   Scalar r_max,
+                   unsigned int bins,
+                   unsigned int type_a = ALL_TYPES,
+                   unsigned int type_b = ALL_TYPES);
+
+        //! Destructor
+        virtual ~ComputeRDF();
+
+        //! Add a sample to the histogram
+        virtual void compute(unsigned int timestep);
+
+        //! Get the normalized radial distribution function
+        std::vector<Scalar> getRDF();
+
+        //! Get the centers of the bins
+        std::vector<Scalar> getBinCenters() const;
+
+        //! Get the number of samples in the histogram
+        unsigned int getNumSamples() const
+            {
+            return m_num_samples;
+            }
+
+        //! Get the maximum distance
+        Scalar getRMax() const
+            {
+            return m_r_max;
+            }
+
+        //! Get the number of bins
+        unsigned int getBins() const
+            {
+            return m_bins;
+            }
+
+        //! Discard all samples
+        void reset();
+
+        #ifdef ENABLE_MPI
+        //! Set the communicator and request a ghost layer of width r_max
+        virtual void setCommunicator(std::shared_ptr<Communicator> comm);
+        #endif
+
+    protected:
+        std::shared_ptr<CellList> m_cl;            //!< Cell list that provides the pairs
+        Scalar m_r_max;                            //!< Maximum pair distance
+        unsigned int m_bins;                       //!< Number of bins
+        unsigned int m_type_a;                     //!< Type of the first particle in a pair, or ALL_TYPES
+        unsigned int m_type_b;                     //!< Type of the second particle in a pair, or ALL_TYPES
+        GlobalArray<unsigned long long> m_counts;  //!< Accumulated pair counts in each bin on this rank
+        GlobalArray<unsigned int> m_num_type;      //!< Local particles of type_a and type_b in the current sample
+        unsigned int m_num_samples;                //!< Number of samples in the histogram
+        double m_norm;                             //!< Sum of N_a N_b / V over the samples
+        bool m_comm_ghost_layer_connected;         //!< True when the ghost layer request is connected
+
+        //! Configure m_cl to provide the pairs
+        void configureCellList();
+
+        //! Add the pairs of the local particles to m_counts and count the particles in m_num_type
+        virtual void computeHistogram(unsigned int timestep);
+
+        //! Request the ghost layer width
+        Scalar requestGhostLayerWidth(unsigned int type)
+            {
+            return m_r_max;
+            }
+    };
+
+//! Exports the ComputeRDF class to python
+void export_ComputeRDF(pybind11::module& m);
+
+#endif
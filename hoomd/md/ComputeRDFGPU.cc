@@ -0,0 +1,89 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ComputeRDFGPU.cc
+    \brief Contains code for the ComputeRDFGPU class
+*/
+
+#include "ComputeRDFGPU.h"
+#include "ComputeRDFGPU.cuh"
+#include "hoomd/CellListGPU.h"
+
+namespace py = pybind11;
+using namespace std;
+
+/*! \param sysdef System for which to compute the radial distribution function
+    \param r_max Maximum pair distance
+    \param bins Number of bins between 0 and \a r_max
+    \param type_a Type of the first particle in a pair, ALL_TYPES for any type
+    \param type_b Type of the second particle in a pair, ALL_TYPES for any type
+*/
+ComputeRDFGPU::ComputeRDFGPU(std::shared_ptr<SystemDefinition> sysdef,
+                             Scalar r_max,
+                             unsigned int bins,
+                             unsigned int type_a,
+                             unsigned int type_b)
+    : ComputeRDF(sysdef, r_max, bins, type_a, type_b)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error() << "Creating a ComputeRDFGPU with no GPU in the execution configuration" << endl;
+        throw std::runtime_error("Error initializing ComputeRDFGPU");
+        }
+
+    m_block_size = 256;
+
+    m_cl = std::shared_ptr<CellList>(new CellListGPU(sysdef));
+    configureCellList();
+    }
+
+ComputeRDFGPU::~ComputeRDFGPU()
+    {
+    }
+
+/*! \param timestep Current time step of the simulation
+*/
+void ComputeRDFGPU::computeHistogram(unsigned int timestep)
+    {
+    m_cl->compute(timestep);
+
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_cell_size(m_cl->getCellSizeArray(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_cell_xyzf(m_cl->getXYZFArray(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_cell_adj(m_cl->getCellAdjArray(), access_location::device, access_mode::read);
+
+    ArrayHandle<unsigned long long> d_counts(m_counts, access_location::device, access_mode::readwrite);
+    ArrayHandle<unsigned int> d_num_type(m_num_type, access_location::device, access_mode::overwrite);
+
+    // fall back to atomic adds in global memory when the histogram does not fit in shared memory
+    bool shared_histogram = sizeof(unsigned int) * m_bins <= m_exec_conf->dev_prop.sharedMemPerBlock;
+
+    gpu_compute_rdf(d_counts.data,
+                    d_num_type.data,
+                    d_pos.data,
+                    m_pdata->getN(),
+                    d_cell_size.data,
+                    d_cell_xyzf.data,
+                    d_cell_adj.data,
+                    m_cl->getCellIndexer(),
+                    m_cl->getCellListIndexer(),
+                    m_cl->getCellAdjIndexer(),
+                    m_pdata->getBox(),
+                    m_cl->getGhostWidth(),
+                    m_r_max,
+                    m_bins,
+                    m_type_a,
+                    m_type_b,
+                    shared_histogram,
+                    m_block_size);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+void export_ComputeRDFGPU(py::module& m)
+    {
+    py::class_<ComputeRDFGPU, ComputeRDF, std::shared_ptr<ComputeRDFGPU> >(m, "ComputeRDFGPU")
+    .def(py::init< std::shared_ptr<SystemDefinition>, Scalar, unsigned int, unsigned int, unsigned int >())
+    ;
+    }
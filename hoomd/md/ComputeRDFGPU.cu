@@ -0,0 +1,212 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ComputeRDFGPU.cuh"
+
+#include <assert.h>
+
+/*! \file ComputeRDFGPU.cu
+    \brief Defines GPU kernel code for accumulating the radial distribution function. Used by ComputeRDFGPU.
+*/
+
+//! Kernel that adds the pairs of the local particles to the RDF histogram
+/*! \param d_counts Histogram of the pair counts, accumulated over the samples
+    \param d_num_type Number of local particles of type_a and type_b, set to zero before the kernel
+    \param d_pos Particle positions and types, including the ghost particles
+    \param N Number of local particles
+    \param d_cell_size Number of particles in each cell
+    \param d_cell_xyzf Positions and indices of the particles in each cell
+    \param d_cell_adj Adjacent cells of each cell
+    \param ci Cell indexer
+    \param cli Cell list indexer
+    \param cadji Cell adjacency indexer
+    \param box Local box
+    \param ghost_width Width of the ghost layer
+    \param r_max Maximum pair distance
+    \param bins Number of bins
+    \param type_a Type of the first particle in a pair, 0xffffffff for any type
+    \param type_b Type of the second particle in a pair, 0xffffffff for any type
+    \param shared_histogram When true, accumulate the pairs of each block in shared memory before adding them to
+           \a d_counts
+
+    One thread processes each local particle.
+*/
+__global__ void gpu_compute_rdf_kernel(unsigned long long *d_counts,
+                                       unsigned int *d_num_type,
+                                       const Scalar4 *d_pos,
+                                       const unsigned int N,
+                                       const unsigned int *d_cell_size,
+                                       const Scalar4 *d_cell_xyzf,
+                                       const unsigned int *d_cell_adj,
+                                       const Index3D ci,
+                                       const Index2D cli,
+                                       const Index2D cadji,
+                                       const BoxDim box,
+                                       const Scalar3 ghost_width,
+                                       const Scalar r_max,
+                                       const unsigned int bins,
+                                       const unsigned int type_a,
+                                       const unsigned int type_b,
+                                       const bool shared_histogram)
+    {
+    HIP_DYNAMIC_SHARED(unsigned int, s_hist)
+
+    if (shared_histogram)
+        {
+        for (unsigned int bin = threadIdx.x; bin < bins; bin += blockDim.x)
+            s_hist[bin] = 0;
+        __syncthreads();
+        }
+
+    const unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i < N)
+        {
+        const Scalar4 postype_i = d_pos[i];
+        const Scalar3 pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
+        const unsigned int type_i = __scalar_as_int(postype_i.w);
+
+        if (type_b == 0xffffffff || type_i == type_b)
+            atomicAdd(&d_num_type[1], 1);
+
+        if (type_a == 0xffffffff || type_i == type_a)
+            {
+            atomicAdd(&d_num_type[0], 1);
+
+            const uint3 dim = make_uint3(ci.getW(), ci.getH(), ci.getD());
+            const uchar3 periodic = box.getPeriodic();
+
+            // find the cell of the particle
+            Scalar3 f = box.makeFraction(pos_i, ghost_width);
+            int ib = (int)(f.x * dim.x);
+            int jb = (int)(f.y * dim.y);
+            int kb = (int)(f.z * dim.z);
+
+            // handle the case where the particle is exactly at the box hi
+            if (ib == (int)dim.x && periodic.x)
+                ib = 0;
+            if (jb == (int)dim.y && periodic.y)
+                jb = 0;
+            if (kb == (int)dim.z && periodic.z)
+                kb = 0;
+
+            const unsigned int my_cell = ci(ib, jb, kb);
+            const Scalar r_maxsq = r_max * r_max;
+            const Scalar bin_scale = Scalar(bins) / r_max;
+
+            for (unsigned int cur_adj = 0; cur_adj < cadji.getW(); cur_adj++)
+                {
+                const unsigned int neigh_cell = d_cell_adj[cadji(cur_adj, my_cell)];
+                const unsigned int size = d_cell_size[neigh_cell];
+                for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
+                    {
+                    const Scalar4 cur_xyzf = d_cell_xyzf[cli(cur_offset, neigh_cell)];
+                    const unsigned int j = __scalar_as_int(cur_xyzf.w);
+                    if (j == i)
+                        continue;
+                    if (type_b != 0xffffffff && (unsigned int)__scalar_as_int(d_pos[j].w) != type_b)
+                        continue;
+
+                    Scalar3 dx = pos_i - make_scalar3(cur_xyzf.x, cur_xyzf.y, cur_xyzf.z);
+                    dx = box.minImage(dx);
+                    const Scalar rsq = dot(dx, dx);
+                    if (rsq < r_maxsq)
+                        {
+                        unsigned int bin = min((unsigned int)(fast::sqrt(rsq) * bin_scale), bins - 1);
+                        if (shared_histogram)
+                            atomicAdd(&s_hist[bin], 1);
+                        else
+                            atomicAdd(&d_counts[bin], 1ull);
+                        }
+                    }
+                }
+            }
+        }
+
+    if (shared_histogram)
+        {
+        __syncthreads();
+        for (unsigned int bin = threadIdx.x; bin < bins; bin += blockDim.x)
+            {
+            if (s_hist[bin] != 0)
+                atomicAdd(&d_counts[bin], (unsigned long long)s_hist[bin]);
+            }
+        }
+    }
+
+/*! \param d_counts Histogram of the pair counts, accumulated over the samples
+    \param d_num_type Number of local particles of type_a and type_b (output)
+    \param d_pos Particle positions and types, including the ghost particles
+    \param N Number of local particles
+    \param d_cell_size Number of particles in each cell
+    \param d_cell_xyzf Positions and indices of the particles in each cell
+    \param d_cell_adj Adjacent cells of each cell
+    \param ci Cell indexer
+    \param cli Cell list indexer
+    \param cadji Cell adjacency indexer
+    \param box Local box
+    \param ghost_width Width of the ghost layer
+    \param r_max Maximum pair distance
+    \param bins Number of bins
+    \param type_a Type of the first particle in a pair, 0xffffffff for any type
+    \param type_b Type of the second particle in a pair, 0xffffffff for any type
+    \param shared_histogram When true, the kernel needs \a bins unsigned ints of shared memory per block
+    \param block_size Number of threads per block
+*/
+hipError_t gpu_compute_rdf(unsigned long long *d_counts,
+                           unsigned int *d_num_type,
+                           const Scalar4 *d_pos,
+                           const unsigned int N,
+                           const unsigned int *d_cell_size,
+                           const Scalar4 *d_cell_xyzf,
+                           const unsigned int *d_cell_adj,
+                           const Index3D& ci,
+                           const Index2D& cli,
+                           const Index2D& cadji,
+                           const BoxDim& box,
+                           const Scalar3& ghost_width,
+                           const Scalar r_max,
+                           const unsigned int bins,
+                           const unsigned int type_a,
+                           const unsigned int type_b,
+                           const bool shared_histogram,
+                           const unsigned int block_size)
+    {
+    assert(d_counts);
+    assert(d_num_type);
+
+    hipMemsetAsync(d_num_type, 0, sizeof(unsigned int) * 2);
+
+    if (N == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void *)gpu_compute_rdf_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    dim3 grid(N / run_block_size + 1, 1, 1);
+    dim3 threads(run_block_size, 1, 1);
+    size_t shared_bytes = shared_histogram ? sizeof(unsigned int) * bins : 0;
+
+    hipLaunchKernelGGL((gpu_compute_rdf_kernel), dim3(grid), dim3(threads), shared_bytes, 0,
+                       d_counts,
+                       d_num_type,
+                       d_pos,
+                       N,
+                       d_cell_size,
+                       d_cell_xyzf,
+                       d_cell_adj,
+                       ci,
+                       cli,
+                       cadji,
+                       box,
+                       ghost_width,
+                       r_max,
+                       bins,
+                       type_a,
+                       type_b,
+                       shared_histogram);
+
+    return hipSuccess;
+    }
@@ -0,0 +1,37 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _COMPUTE_RDF_GPU_CUH_
+#define _COMPUTE_RDF_GPU_CUH_
+
+#include <hip/hip_runtime.h>
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/Index1D.h"
+#include "hoomd/BoxDim.h"
+
+/*! \file ComputeRDFGPU.cuh
+    \brief Kernel driver function declarations for ComputeRDFGPU
+*/
+
+//! Kernel driver that adds the pairs of the local particles to the RDF histogram
+hipError_t gpu_compute_rdf(unsigned long long *d_counts,
+                           unsigned int *d_num_type,
+                           const Scalar4 *d_pos,
+                           const unsigned int N,
+                           const unsigned int *d_cell_size,
+                           const Scalar4 *d_cell_xyzf,
+                           const unsigned int *d_cell_adj,
+                           const Index3D& ci,
+                           const Index2D& cli,
+                           const Index2D& cadji,
+                           const BoxDim& box,
+                           const Scalar3& ghost_width,
+                           const Scalar r_max,
+                           const unsigned int bins,
+                           const unsigned int type_a,
+                           const unsigned int type_b,
+                           const bool shared_histogram,
+                           const unsigned int block_size);
+
+#endif
@@ -0,0 +1,49 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ComputeRDF.h"
+
+/*! \file ComputeRDFGPU.h
+    \brief Declares a class for computing the radial distribution function on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __COMPUTE_RDF_GPU_H__
+#define __COMPUTE_RDF_GPU_H__
+
+//! Accumulates the radial distribution function of the particles on the GPU
+/*! ComputeRDFGPU is a GPU accelerated implementation of ComputeRDF. Each block accumulates its pairs in a histogram
+    in shared memory and adds it to m_counts, which stays on the device between samples. Only the two particle counts
+    are copied to the host for each sample.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT ComputeRDFGPU : public ComputeRDF
+    {
+    public:
+        //! Constructs the compute
+        ComputeRDFGPU(std::shared_ptr<SystemDefinition> sysdef,
+                      Scalar r_max,
+                      unsigned int bins,
+                      unsigned int type_a = ALL_TYPES,
+                      unsigned int type_b = ALL_TYPES);
+
+        //! Destructor
+        virtual ~ComputeRDFGPU();
+
+    protected:
+        unsigned int m_block_size;   //!< Block size executed
+
+        //! Add the pairs of the local particles to m_counts on the GPU
+        virtual void computeHistogram(unsigned int timestep);
+    };
+
+//! Exports the ComputeRDFGPU class to python
+void export_ComputeRDFGPU(pybind11::module& m);
+
+#endif
@@ -0,0 +1,229 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ComputeStructureFactor.cc
+    \brief Contains code for the ComputeStructureFactor class
+*/
+
+#include "ComputeStructureFactor.h"
+#include "hoomd/VectorMath.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/HOOMDMPI.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \param sysdef System for which to compute the structure factor
+    \param q_max Maximum wave vector magnitude
+    \param bins Number of bins between 0 and \a q_max
+*/
+ComputeStructureFactor::ComputeStructureFactor(std::shared_ptr<SystemDefinition> sysdef,
+                                               Scalar q_max,
+                                               unsigned int bins)
+    : Compute(sysdef), m_q_max(q_max), m_bins(bins), m_num_q(0), m_num_samples(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing ComputeStructureFactor" << endl;
+
+    if (q_max <= Scalar(0.0))
+        {
+        m_exec_conf->msg->error() << "compute.structure_factor: q_max must be positive" << endl;
+        throw runtime_error("Error initializing ComputeStructureFactor");
+        }
+    if (bins == 0)
+        {
+        m_exec_conf->msg->error() << "compute.structure_factor: bins must be positive" << endl;
+        throw runtime_error("Error initializing ComputeStructureFactor");
+        }
+
+    m_bin_sum.resize(m_bins);
+    m_bin_count.resize(m_bins);
+    reset();
+
+    generateWaveVectors();
+    }
+
+ComputeStructureFactor::~ComputeStructureFactor()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying ComputeStructureFactor" << endl;
+    }
+
+/*! Selects the wave vectors q = n1 b1 + n2 b2 + n3 b3 with 0 < |q| <= q_max in the half space with the first nonzero
+    n_i positive, where b_i are the reciprocal lattice vectors of the global box. n3 is 0 in 2D.
+*/
+void ComputeStructureFactor::generateWaveVectors()
+    {
+    m_box = m_pdata->getGlobalBox();
+    const bool two_d = m_sysdef->getNDimensions() == 2;
+
+    vec3<Scalar> a1(m_box.getLatticeVector(0));
+    vec3<Scalar> a2(m_box.getLatticeVector(1));
+    vec3<Scalar> a3(m_box.getLatticeVector(2));
+    Scalar V = dot(a1, cross(a2, a3));
+    vec3<Scalar> b1 = Scalar(2.0 * M_PI) / V * cross(a2, a3);
+    vec3<Scalar> b2 = Scalar(2.0 * M_PI) / V * cross(a3, a1);
+    vec3<Scalar> b3 = Scalar(2.0 * M_PI) / V * cross(a1, a2);
+
+    // |n_i| = |q.a_i| / 2 pi <= q_max |a_i| / 2 pi
+    int n1_max = int(m_q_max * sqrt(dot(a1, a1)) / Scalar(2.0 * M_PI));
+    int n2_max = int(m_q_max * sqrt(dot(a2, a2)) / Scalar(2.0 * M_PI));
+    int n3_max = two_d ? 0 : int(m_q_max * sqrt(dot(a3, a3)) / Scalar(2.0 * M_PI));
+
+    const Scalar q_maxsq = m_q_max * m_q_max;
+    const Scalar dq = m_q_max / Scalar(m_bins);
+    std::vector<Scalar3> q_list;
+    m_q_bin.clear();
+    for (int n1 = 0; n1 <= n1_max; n1++)
+        {
+        for (int n2 = (n1 == 0 ? 0 : -n2_max); n2 <= n2_max; n2++)
+            {
+            for (int n3 = (n1 == 0 && n2 == 0 ? 1 : -n3_max); n3 <= n3_max; n3++)
+                {
+                vec3<Scalar> q = Scalar(n1) * b1 + Scalar(n2) * b2 + Scalar(n3) * b3;
+                Scalar qsq = dot(q, q);
+                if (qsq > q_maxsq || qsq == Scalar(0.0))
+                    continue;
+
+                q_list.push_back(vec_to_scalar3(q));
+                m_q_bin.push_back(min((unsigned int)(sqrt(qsq) / dq), m_bins - 1));
+                }
+            }
+        }
+
+    m_num_q = (unsigned int)q_list.size();
+    if (m_num_q == 0)
+        m_exec_conf->msg->warning() << "compute.structure_factor: no wave vectors with |q| <= q_max" << endl;
+
+    GlobalArray<Scalar3> q(std::max(m_num_q, 1u), m_exec_conf);
+    m_q.swap(q);
+    TAG_ALLOCATION(m_q);
+
+    GlobalArray<Scalar2> sums(std::max(m_num_q, 1u), m_exec_conf);
+    m_sums.swap(sums);
+    TAG_ALLOCATION(m_sums);
+
+    ArrayHandle<Scalar3> h_q(m_q, access_location::host, access_mode::overwrite);
+    std::copy(q_list.begin(), q_list.end(), h_q.data);
+    }
+
+/*! Adds one sample per time step, calling compute() again on the same time step does nothing.
+
+    \param timestep Current time step of the simulation
+*/
+void ComputeStructureFactor::compute(unsigned int timestep)
+    {
+    if (!shouldCompute(timestep))
+        return;
+
+    if (m_pdata->getGlobalBox() != m_box)
+        generateWaveVectors();
+
+    if (m_num_q == 0)
+        return;
+
+    if (m_prof) m_prof->push(m_exec_conf, "S(q)");
+
+    computeSums();
+
+    std::vector<Scalar> sums(2 * m_num_q);
+        {
+        ArrayHandle<Scalar2> h_sums(m_sums, access_location::host, access_mode::read);
+        for (unsigned int k = 0; k < m_num_q; k++)
+            {
+            sums[2*k] = h_sums.data[k].x;
+            sums[2*k+1] = h_sums.data[k].y;
+            }
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE, sums.data(), 2 * m_num_q, MPI_HOOMD_SCALAR, MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    const double N = m_pdata->getNGlobal();
+    for (unsigned int k = 0; k < m_num_q; k++)
+        {
+        double re = sums[2*k];
+        double im = sums[2*k+1];
+        m_bin_sum[m_q_bin[k]] += (re*re + im*im) / N;
+        m_bin_count[m_q_bin[k]]++;
+        }
+    m_num_samples++;
+
+    if (m_prof) m_prof->pop(m_exec_conf);
+    }
+
+void ComputeStructureFactor::computeSums()
+    {
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_q(m_q, access_location::host, access_mode::read);
+    ArrayHandle<Scalar2> h_sums(m_sums, access_location::host, access_mode::overwrite);
+
+    const unsigned int N = m_pdata->getN();
+    for (unsigned int k = 0; k < m_num_q; k++)
+        {
+        const Scalar3 q = h_q.data[k];
+        Scalar re = Scalar(0.0);
+        Scalar im = Scalar(0.0);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            Scalar phase = q.x * h_pos.data[i].x + q.y * h_pos.data[i].y + q.z * h_pos.data[i].z;
+            Scalar s, c;
+            fast::sincos(phase, s, c);
+            re += c;
+            im += s;
+            }
+        h_sums.data[k] = make_scalar2(re, im);
+        }
+    }
+
+/*! \returns S(q) averaged over the wave vectors in each bin and the samples, 0 in bins without wave vectors
+*/
+std::vector<Scalar> ComputeStructureFactor::getStructureFactor() const
+    {
+    std::vector<Scalar> result(m_bins, Scalar(0.0));
+    for (unsigned int bin = 0; bin < m_bins; bin++)
+        {
+        if (m_bin_count[bin] > 0)
+            result[bin] = Scalar(m_bin_sum[bin] / double(m_bin_count[bin]));
+        }
+    return result;
+    }
+
+std::vector<Scalar> ComputeStructureFactor::getBinCenters() const
+    {
+    std::vector<Scalar> centers(m_bins);
+    const Scalar dq = m_q_max / Scalar(m_bins);
+    for (unsigned int bin = 0; bin < m_bins; bin++)
+        centers[bin] = (Scalar(bin) + Scalar(0.5)) * dq;
+    return centers;
+    }
+
+void ComputeStructureFactor::reset()
+    {
+    std::fill(m_bin_sum.begin(), m_bin_sum.end(), 0.0);
+    std::fill(m_bin_count.begin(), m_bin_count.end(), 0);
+    m_num_samples = 0;
+    }
+
+void export_ComputeStructureFactor(py::module& m)
+    {
+    py::class_<ComputeStructureFactor, Compute, std::shared_ptr<ComputeStructureFactor> >(m, "ComputeStructureFactor")
+    .def(py::init< std::shared_ptr<SystemDefinition>, Scalar, unsigned int >())
+    .def_property_readonly("structure_factor", &ComputeStructureFactor::getStructureFactor)
+    .def_property_readonly("bin_centers", &ComputeStructureFactor::getBinCenters)
+    .def_property_readonly("num_samples", &ComputeStructureFactor::getNumSamples)
+    .def_property_readonly("num_wave_vectors", &ComputeStructureFactor::getNumWaveVectors)
+    .def_property_readonly("q_max", &ComputeStructureFactor::getQMax)
+    .def_property_readonly("bins", &ComputeStructureFactor::getBins)
+    .def("reset", &ComputeStructureFactor::reset)
+    ;
+    }
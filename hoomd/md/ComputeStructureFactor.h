@@ -0,0 +1,102 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/Compute.h"
+#include "hoomd/GlobalArray.h"
+
+#include <memory>
+#include <vector>
+
+/*! \file ComputeStructureFactor.h
+    \brief Declares a class for computing the static structure factor
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __COMPUTE_STRUCTURE_FACTOR_H__
+#define __COMPUTE_STRUCTURE_FACTOR_H__
+
+//! Accumulates the static structure factor of the particles
+/*! The structure factor S(q) = |sum_j exp(i q.r_j)|^2 / N is evaluated by direct summation at the wave vectors q of
+    the reciprocal lattice of the global box with 0 < |q| <= \a q_max. Only one of each pair q, -q is evaluated,
+    because S(-q) = S(q). The wave vectors are regenerated when the box changes.
+
+    Each call to compute() on a new time step adds one sample. The values at the wave vectors are averaged in \a bins
+    bins of |q| between 0 and \a q_max. Each rank sums cos(q.r_j) and sin(q.r_j) over its local particles in m_sums,
+    and only these sums are reduced over the ranks. The cost of a sample is proportional to the number of particles
+    times the number of wave vectors, which grows as q_max^3 in 3D.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT ComputeStructureFactor : public Compute
+    {
+    public:
+        //! Constructs the compute
+        ComputeStructureFactor(std::shared_ptr<SystemDefinition> sysdef, Scalar q_max, unsigned int bins);
+
+        //! Destructor
+        virtual ~ComputeStructureFactor();
+
+        //! Add a sample to the structure factor
+        virtual void compute(unsigned int timestep);
+
+        //! Get the structure factor in each bin averaged over the samples
+        std::vector<Scalar> getStructureFactor() const;
+
+        //! Get the centers of the bins
+        std::vector<Scalar> getBinCenters() const;
+
+        //! Get the number of samples
+        unsigned int getNumSamples() const
+            {
+            return m_num_samples;
+            }
+
+        //! Get the number of wave vectors evaluated in each sample
+        unsigned int getNumWaveVectors() const
+            {
+            return m_num_q;
+            }
+
+        //! Get the maximum wave vector magnitude
+        Scalar getQMax() const
+            {
+            return m_q_max;
+            }
+
+        //! Get the number of bins
+        unsigned int getBins() const
+            {
+            return m_bins;
+            }
+
+        //! Discard all samples
+        void reset();
+
+    protected:
+        Scalar m_q_max;                      //!< Maximum wave vector magnitude
+        unsigned int m_bins;                 //!< Number of bins
+        BoxDim m_box;                        //!< Global box of the current wave vectors
+        unsigned int m_num_q;                //!< Number of wave vectors
+        GlobalArray<Scalar3> m_q;            //!< Wave vectors
+        GlobalArray<Scalar2> m_sums;         //!< Sums of cos(q.r) and sin(q.r) over the local particles
+        std::vector<unsigned int> m_q_bin;   //!< Bin of each wave vector
+        std::vector<double> m_bin_sum;       //!< Sum of S(q) in each bin over the samples
+        std::vector<unsigned int> m_bin_count; //!< Number of values in each bin over the samples
+        unsigned int m_num_samples;          //!< Number of samples
+
+        //! Generate the wave vectors of the reciprocal lattice of the global box
+        void generateWaveVectors();
+
+        //! Sum cos(q.r) and sin(q.r) over the local particles at each wave vector
+        virtual void computeSums();
+    };
+
+//! Exports the ComputeStructureFactor class to python
+void export_ComputeStructureFactor(pybind11::module& m);
+
+#endif
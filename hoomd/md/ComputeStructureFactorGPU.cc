@@ -0,0 +1,71 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ComputeStructureFactorGPU.cc
+    \brief Contains code for the ComputeStructureFactorGPU class
+*/
+
+#include "ComputeStructureFactorGPU.h"
+#include "ComputeStructureFactorGPU.cuh"
+
+#include <algorithm>
+
+namespace py = pybind11;
+using namespace std;
+
+/*! \param sysdef System for which to compute the structure factor
+    \param q_max Maximum wave vector magnitude
+    \param bins Number of bins between 0 and \a q_max
+*/
+ComputeStructureFactorGPU::ComputeStructureFactorGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                                     Scalar q_max,
+                                                     unsigned int bins)
+    : ComputeStructureFactor(sysdef, q_max, bins), m_scratch(m_exec_conf)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error() << "Creating a ComputeStructureFactorGPU with no GPU in the execution configuration"
+                                  << endl;
+        throw std::runtime_error("Error initializing ComputeStructureFactorGPU");
+        }
+
+    m_block_size = 256;
+    }
+
+ComputeStructureFactorGPU::~ComputeStructureFactorGPU()
+    {
+    }
+
+void ComputeStructureFactorGPU::computeSums()
+    {
+    // enough blocks to fill the device for a single wave vector, the wave vectors fill it further
+    const unsigned int N = m_pdata->getN();
+    unsigned int n_blocks = std::max(1u, std::min(N / m_block_size + 1, 32u));
+    if (m_scratch.size() < n_blocks * m_num_q)
+        m_scratch.resize(n_blocks * m_num_q);
+
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar3> d_q(m_q, access_location::device, access_mode::read);
+    ArrayHandle<Scalar2> d_sums(m_sums, access_location::device, access_mode::overwrite);
+    ArrayHandle<Scalar2> d_scratch(m_scratch, access_location::device, access_mode::overwrite);
+
+    gpu_compute_structure_factor(d_sums.data,
+                                 d_scratch.data,
+                                 d_pos.data,
+                                 N,
+                                 d_q.data,
+                                 m_num_q,
+                                 n_blocks,
+                                 m_block_size);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+void export_ComputeStructureFactorGPU(py::module& m)
+    {
+    py::class_<ComputeStructureFactorGPU, ComputeStructureFactor, std::shared_ptr<ComputeStructureFactorGPU> >(
+        m, "ComputeStructureFactorGPU")
+    .def(py::init< std::shared_ptr<SystemDefinition>, Scalar, unsigned int >())
+    ;
+    }
@@ -0,0 +1,152 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ComputeStructureFactorGPU.cuh"
+
+#include <assert.h>
+
+/*! \file ComputeStructureFactorGPU.cu
+    \brief Defines GPU kernel code for the sums of the structure factor. Used by ComputeStructureFactorGPU.
+*/
+
+//! Maximum number of wave vectors in the y dimension of a grid
+const unsigned int max_grid_y = 65535;
+
+//! Kernel that sums cos(q.r) and sin(q.r) over the particles of each block
+/*! \param d_scratch Partial sums, n_blocks for each wave vector (output)
+    \param d_pos Particle positions
+    \param N Number of local particles
+    \param d_q Wave vectors
+    \param num_q Number of wave vectors
+
+    blockIdx.y selects the wave vector and the blocks in x loop over the particles with a stride of the grid width.
+    The block size must be a power of two.
+*/
+__global__ void gpu_compute_structure_factor_partial_kernel(Scalar2 *d_scratch,
+                                                            const Scalar4 *d_pos,
+                                                            const unsigned int N,
+                                                            const Scalar3 *d_q,
+                                                            const unsigned int num_q)
+    {
+    HIP_DYNAMIC_SHARED(Scalar2, s_sums)
+
+    for (unsigned int k = blockIdx.y; k < num_q; k += gridDim.y)
+        {
+        const Scalar3 q = d_q[k];
+        Scalar2 sum = make_scalar2(Scalar(0.0), Scalar(0.0));
+        for (unsigned int i = blockIdx.x * blockDim.x + threadIdx.x; i < N; i += blockDim.x * gridDim.x)
+            {
+            const Scalar4 pos = d_pos[i];
+            Scalar s, c;
+            fast::sincos(q.x * pos.x + q.y * pos.y + q.z * pos.z, s, c);
+            sum.x += c;
+            sum.y += s;
+            }
+
+        s_sums[threadIdx.x] = sum;
+        __syncthreads();
+
+        for (unsigned int offs = blockDim.x / 2; offs > 0; offs >>= 1)
+            {
+            if (threadIdx.x < offs)
+                {
+                s_sums[threadIdx.x].x += s_sums[threadIdx.x + offs].x;
+                s_sums[threadIdx.x].y += s_sums[threadIdx.x + offs].y;
+                }
+            __syncthreads();
+            }
+
+        if (threadIdx.x == 0)
+            d_scratch[k * gridDim.x + blockIdx.x] = s_sums[0];
+        __syncthreads();
+        }
+    }
+
+//! Kernel that reduces the partial sums of each wave vector
+/*! \param d_sums Sums for each wave vector (output)
+    \param d_scratch Partial sums, n_blocks for each wave vector
+    \param num_q Number of wave vectors
+    \param n_blocks Number of partial sums for each wave vector
+
+    One block reduces each wave vector. The block size must be a power of two.
+*/
+__global__ void gpu_compute_structure_factor_final_kernel(Scalar2 *d_sums,
+                                                          const Scalar2 *d_scratch,
+                                                          const unsigned int num_q,
+                                                          const unsigned int n_blocks)
+    {
+    HIP_DYNAMIC_SHARED(Scalar2, s_sums)
+
+    for (unsigned int k = blockIdx.x; k < num_q; k += gridDim.x)
+        {
+        Scalar2 sum = make_scalar2(Scalar(0.0), Scalar(0.0));
+        for (unsigned int b = threadIdx.x; b < n_blocks; b += blockDim.x)
+            {
+            Scalar2 partial = d_scratch[k * n_blocks + b];
+            sum.x += partial.x;
+            sum.y += partial.y;
+            }
+
+        s_sums[threadIdx.x] = sum;
+        __syncthreads();
+
+        for (unsigned int offs = blockDim.x / 2; offs > 0; offs >>= 1)
+            {
+            if (threadIdx.x < offs)
+                {
+                s_sums[threadIdx.x].x += s_sums[threadIdx.x + offs].x;
+                s_sums[threadIdx.x].y += s_sums[threadIdx.x + offs].y;
+                }
+            __syncthreads();
+            }
+
+        if (threadIdx.x == 0)
+            d_sums[k] = s_sums[0];
+        __syncthreads();
+        }
+    }
+
+/*! \param d_sums Sums of cos(q.r) and sin(q.r) for each wave vector (output)
+    \param d_scratch Scratch space of n_blocks * num_q elements for the partial sums
+    \param d_pos Particle positions
+    \param N Number of local particles
+    \param d_q Wave vectors
+    \param num_q Number of wave vectors
+    \param n_blocks Number of blocks that sum the particles for each wave vector
+    \param block_size Number of threads per block, a power of two
+*/
+hipError_t gpu_compute_structure_factor(Scalar2 *d_sums,
+                                        Scalar2 *d_scratch,
+                                        const Scalar4 *d_pos,
+                                        const unsigned int N,
+                                        const Scalar3 *d_q,
+                                        const unsigned int num_q,
+                                        const unsigned int n_blocks,
+                                        const unsigned int block_size)
+    {
+    assert(d_sums);
+    assert(d_scratch);
+
+    if (num_q == 0)
+        return hipSuccess;
+
+    dim3 grid(n_blocks, min(num_q, max_grid_y), 1);
+    dim3 threads(block_size, 1, 1);
+    hipLaunchKernelGGL((gpu_compute_structure_factor_partial_kernel), dim3(grid), dim3(threads),
+                       sizeof(Scalar2) * block_size, 0,
+                       d_scratch,
+                       d_pos,
+                       N,
+                       d_q,
+                       num_q);
+
+    dim3 grid_final(min(num_q, max_grid_y), 1, 1);
+    hipLaunchKernelGGL((gpu_compute_structure_factor_final_kernel), dim3(grid_final), dim3(threads),
+                       sizeof(Scalar2) * block_size, 0,
+                       d_sums,
+                       d_scratch,
+                       num_q,
+                       n_blocks);
+
+    return hipSuccess;
+    }
@@ -0,0 +1,25 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _COMPUTE_STRUCTURE_FACTOR_GPU_CUH_
+#define _COMPUTE_STRUCTURE_FACTOR_GPU_CUH_
+
+#include <hip/hip_runtime.h>
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file ComputeStructureFactorGPU.cuh
+    \brief Kernel driver function declarations for ComputeStructureFactorGPU
+*/
+
+//! Kernel driver that sums cos(q.r) and sin(q.r) over the particles at each wave vector
+hipError_t gpu_compute_structure_factor(Scalar2 *d_sums,
+                                        Scalar2 *d_scratch,
+                                        const Scalar4 *d_pos,
+                                        const unsigned int N,
+                                        const Scalar3 *d_q,
+                                        const unsigned int num_q,
+                                        const unsigned int n_blocks,
+                                        const unsigned int block_size);
+
+#endif
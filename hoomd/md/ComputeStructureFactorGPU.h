@@ -0,0 +1,46 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ComputeStructureFactor.h"
+
+/*! \file ComputeStructureFactorGPU.h
+    \brief Declares a class for computing the static structure factor on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __COMPUTE_STRUCTURE_FACTOR_GPU_H__
+#define __COMPUTE_STRUCTURE_FACTOR_GPU_H__
+
+//! Accumulates the static structure factor of the particles on the GPU
+/*! ComputeStructureFactorGPU is a GPU accelerated implementation of ComputeStructureFactor. The first kernel sums
+    cos(q.r) and sin(q.r) over the particles of each block for every wave vector into m_scratch, and the second
+    kernel reduces the partial sums of each wave vector into m_sums. Only m_sums is copied to the host.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT ComputeStructureFactorGPU : public ComputeStructureFactor
+    {
+    public:
+        //! Constructs the compute
+        ComputeStructureFactorGPU(std::shared_ptr<SystemDefinition> sysdef, Scalar q_max, unsigned int bins);
+
+        //! Destructor
+        virtual ~ComputeStructureFactorGPU();
+
+    protected:
+        GlobalVector<Scalar2> m_scratch;  //!< Partial sums of each block for each wave vector
+        unsigned int m_block_size;        //!< Block size executed
+
+        //! Sum cos(q.r) and sin(q.r) over the local particles on the GPU
+        virtual void computeSums();
+    };
+
+//! Exports the ComputeStructureFactorGPU class to python
+void export_ComputeStructureFactorGPU(pybind11::module& m);
+
+#endif
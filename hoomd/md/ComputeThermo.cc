@@ -28,7 +28,8 @@ using namespace std;
 ComputeThermo::ComputeThermo(std::shared_ptr<SystemDefinition> sysdef,
                              std::shared_ptr<ParticleGroup> group,
                              const std::string& suffix)
-    : Compute(sysdef), m_group(group), m_logging_enabled(true)
+    : Compute(sysdef), m_group(group), m_logging_enabled(true), m_hma(false), m_hma_temperature(0),
+      m_hma_harmonic_pressure(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing ComputeThermo" << endl;
 
@@ -77,6 +78,41 @@ ComputeThermo::~ComputeThermo()
     m_exec_conf->msg->notice(5) << "Destroying ComputeThermo" << endl;
     }
 
+/*! \param temperature The temperature that governs sampling of the integrator
+    \param harmonic_pressure The contribution to the pressure from harmonic fluctuations
+
+    The current particle positions are saved as the lattice sites. Call this method on all ranks.
+*/
+void ComputeThermo::enableHMA(Scalar temperature, Scalar harmonic_pressure)
+    {
+    m_hma_temperature = temperature;
+    m_hma_harmonic_pressure = harmonic_pressure;
+
+    BoxDim box = m_pdata->getGlobalBox();
+
+    SnapshotParticleData<Scalar> snapshot;
+    m_pdata->takeSnapshot(snapshot);
+    #ifdef ENABLE_MPI
+    snapshot.bcast(0, m_exec_conf->getMPICommunicator());
+    #endif
+
+    GlobalArray< Scalar3 > lattice_site(snapshot.size, m_exec_conf);
+    m_lattice_site.swap(lattice_site);
+    TAG_ALLOCATION(m_lattice_site);
+
+    ArrayHandle<Scalar3> h_lattice_site(m_lattice_site, access_location::host, access_mode::overwrite);
+    for (unsigned int tag = 0; tag < snapshot.size; tag++)
+        {
+        vec3<Scalar> unwrapped = box.shift(snapshot.pos[tag], snapshot.image[tag]);
+        h_lattice_site.data[tag] = make_scalar3(unwrapped.x, unwrapped.y, unwrapped.z);
+        }
+
+    m_hma = true;
+
+    // the properties are stale until the next compute
+    m_first_compute = true;
+    }
+
 /*! Calls computeProperties if the properties need updating
     \param timestep Current time step of the simulation
 */
@@ -314,6 +350,31 @@ void ComputeThermo::computeProperties()
 
     pe_total += m_pdata->getExternalEnergy();
 
+    // sum of F . (r - r_lattice) for the HMA estimators
+    double hma_fdr = 0.0;
+    if (m_hma)
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_lattice_site(m_lattice_site, access_location::host, access_mode::read);
+        const BoxDim& box = m_pdata->getGlobalBox();
+
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            {
+            unsigned int j = m_group->getMemberIndex(group_idx);
+
+            // ignore rigid body constituent particles in the sum
+            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
+                {
+                Scalar3 pos = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                Scalar3 dr = box.shift(pos, h_image.data[j]) - h_lattice_site.data[h_tag.data[j]];
+                hma_fdr += (double)h_net_force.data[j].x * dr.x
+                         + (double)h_net_force.data[j].y * dr.y
+                         + (double)h_net_force.data[j].z * dr.z;
+                }
+            }
+        }
+
     double W = 0.0;
     double virial_xx = m_pdata->getExternalVirial(0);
     double virial_xy = m_pdata->getExternalVirial(1);
@@ -387,6 +448,7 @@ void ComputeThermo::computeProperties()
     h_properties.data[thermo_index::pressure_yy] = pressure_yy;
     h_properties.data[thermo_index::pressure_yz] = pressure_yz;
     h_properties.data[thermo_index::pressure_zz] = pressure_zz;
+    h_properties.data[thermo_index::hma_force_displacement] = Scalar(hma_fdr);
 
     #ifdef ENABLE_MPI
     // in MPI, reduce extensive quantities only when they're needed
@@ -425,6 +487,9 @@ void export_ComputeThermo(py::module& m)
     .def_property_readonly("translational_kinetic_energy", &ComputeThermo::getTranslationalKineticEnergy)
     .def_property_readonly("rotational_kinetic_energy", &ComputeThermo::getRotationalKineticEnergy)
     .def_property_readonly("potential_energy", &ComputeThermo::getPotentialEnergy)
+    .def_property_readonly("potential_energyHMA", &ComputeThermo::getPotentialEnergyHMA)
+    .def_property_readonly("pressureHMA", &ComputeThermo::getPressureHMA)
     .def("setLoggingEnabled", &ComputeThermo::setLoggingEnabled)
+    .def("enableHMA", &ComputeThermo::enableHMA)
     ;
     }
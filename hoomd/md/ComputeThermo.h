@@ -40,6 +40,10 @@
      - rotational kinetic energy
      - potential energy
 
+    When enableHMA() has been called, the same pass also sums F . (r - r_lattice) over the group, from which the
+    harmonically mapped averages of the potential energy and pressure are computed. This produces the same quantities
+    as ComputeThermoHMA without a second reduction over the forces and virials.
+
     Values available all the time
      - number of degrees of freedom (ndof)
      - number of particles in the group
@@ -257,6 +261,54 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
         return toReturn;
         }
 
+        //! Compute the harmonically mapped averages along with the other properties
+        void enableHMA(Scalar temperature, Scalar harmonic_pressure);
+
+        //! Returns the HMA potential energy last computed by compute()
+        /*! \returns Instantaneous HMA potential energy of the group, or NaN if HMA is not enabled
+        */
+        Scalar getPotentialEnergyHMA()
+            {
+            if (!m_hma)
+                return std::numeric_limits<Scalar>::quiet_NaN();
+
+            #ifdef ENABLE_MPI
+            if (!m_properties_reduced) reduceProperties();
+            #endif
+
+            ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::read);
+            Scalar N = Scalar(m_group->getNumMembersGlobal());
+            return h_properties.data[thermo_index::potential_energy]
+                + Scalar(0.5)*m_sysdef->getNDimensions()*(N - Scalar(1.0))*m_hma_temperature
+                + Scalar(0.5)*h_properties.data[thermo_index::hma_force_displacement];
+            }
+
+        //! Returns the HMA pressure last computed by compute()
+        /*! \returns Instantaneous HMA pressure of the group, or NaN if HMA is not enabled or the flags are not valid
+        */
+        Scalar getPressureHMA()
+            {
+            if (!m_hma || !m_computed_flags[pdata_flag::pressure_tensor])
+                return std::numeric_limits<Scalar>::quiet_NaN();
+
+            #ifdef ENABLE_MPI
+            if (!m_properties_reduced) reduceProperties();
+            #endif
+
+            ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::read);
+            unsigned int D = m_sysdef->getNDimensions();
+            Scalar3 L = m_pdata->getGlobalBox().getL();
+            Scalar volume = (D == 2) ? L.x*L.y : L.x*L.y*L.z;
+            Scalar N = Scalar(m_group->getNumMembersGlobal());
+
+            // the virial part of the conventional pressure
+            Scalar virial_pressure = h_properties.data[thermo_index::pressure]
+                - Scalar(2.0)*h_properties.data[thermo_index::translational_kinetic_energy]/(Scalar(D)*volume);
+            Scalar fV = (m_hma_harmonic_pressure/m_hma_temperature - N/volume)/(Scalar(D)*(N - Scalar(1.0)));
+            return m_hma_harmonic_pressure + virial_pressure
+                + fV*h_properties.data[thermo_index::hma_force_displacement];
+            }
+
         // <--------------- Degree of Freedom Data
 
         double getNDOF()
@@ -315,6 +367,11 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
         /// Store the particle data flags used during the last computation
         PDataFlags m_computed_flags;
 
+        bool m_hma;                         //!< True if the HMA sums are computed
+        Scalar m_hma_temperature;           //!< Temperature that governs sampling, for HMA
+        Scalar m_hma_harmonic_pressure;     //!< Harmonic contribution to the pressure, for HMA
+        GlobalArray<Scalar3> m_lattice_site;    //!< Lattice site of each particle by tag, for HMA
+
         //! Does the actual computation
         virtual void computeProperties();
 
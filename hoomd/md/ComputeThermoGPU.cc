@@ -108,6 +108,17 @@ void ComputeThermoGPU::computeProperties()
     ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
     BoxDim box = m_pdata->getGlobalBox();
 
+    // the HMA sum is computed in the same pass when it is enabled
+    std::unique_ptr< ArrayHandle<Scalar4> > d_pos;
+    std::unique_ptr< ArrayHandle<int3> > d_image;
+    std::unique_ptr< ArrayHandle<Scalar3> > d_lattice_site;
+    if (m_hma)
+        {
+        d_pos.reset(new ArrayHandle<Scalar4>(m_pdata->getPositions(), access_location::device, access_mode::read));
+        d_image.reset(new ArrayHandle<int3>(m_pdata->getImages(), access_location::device, access_mode::read));
+        d_lattice_site.reset(new ArrayHandle<Scalar3>(m_lattice_site, access_location::device, access_mode::read));
+        }
+
     PDataFlags flags = m_pdata->getFlags();
 
     { // scope these array handles so they are released before the additional terms are added
@@ -151,6 +162,9 @@ void ComputeThermoGPU::computeProperties()
     args.external_virial_yz = m_pdata->getExternalVirial(4);
     args.external_virial_zz = m_pdata->getExternalVirial(5);
     args.external_energy = m_pdata->getExternalEnergy();
+    args.d_pos = m_hma ? d_pos->data : NULL;
+    args.d_image = m_hma ? d_image->data : NULL;
+    args.d_lattice_site = m_hma ? d_lattice_site->data : NULL;
 
     // perform the computation on the GPU(s)
     gpu_compute_thermo_partial( d_properties.data,
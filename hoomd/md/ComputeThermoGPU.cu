@@ -21,6 +21,10 @@
     \param d_net_virial Net virial array from ParticleData
     \param virial_pitch pitch of 2D virial array
     \param d_velocity Particle velocity and mass array from ParticleData
+    \param d_pos Particle positions from ParticleData
+    \param d_image Particle images from ParticleData
+    \param d_lattice_site Lattice site of each particle by tag, or NULL to skip the HMA sum
+    \param box Global simulation box
     \param d_body Particle body id
     \param d_tag Particle tag
     \param d_group_members List of group members for which to sum properties
@@ -32,10 +36,11 @@
      - 2*Kinetic energy is summed in .x
      - Potential energy is summed in .y
      - W is summed in .z
+     - F . (r - r_lattice) is summed in .w when d_lattice_site is set
 
     One thread is executed per group member. That thread reads in the values for its member into shared memory
     and then the block performs a reduction in parallel to produce a partial sum output for the block. These
-    partial sums are written to d_scratch[blockIdx.x]. sizeof(Scalar3)*block_size of dynamic shared memory are needed
+    partial sums are written to d_scratch[blockIdx.x]. sizeof(Scalar4)*block_size of dynamic shared memory are needed
     for this kernel to run.
 */
 
@@ -44,6 +49,10 @@ __global__ void gpu_compute_thermo_partial_sums(Scalar4 *d_scratch,
                                                 Scalar *d_net_virial,
                                                 const size_t virial_pitch,
                                                 Scalar4 *d_velocity,
+                                                const Scalar4 *d_pos,
+                                                const int3 *d_image,
+                                                const Scalar3 *d_lattice_site,
+                                                BoxDim box,
                                                 unsigned int *d_body,
                                                 unsigned int *d_tag,
                                                 unsigned int *d_group_members,
@@ -51,15 +60,15 @@ __global__ void gpu_compute_thermo_partial_sums(Scalar4 *d_scratch,
                                                 unsigned int offset,
                                                 unsigned int block_offset)
     {
-    extern __shared__ Scalar3 compute_thermo_sdata[];
+    extern __shared__ Scalar4 compute_thermo_sdata[];
 
     // determine which particle this thread works on
     int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
 
-    Scalar3 my_element; // element of scratch space read in
+    Scalar4 my_element; // element of scratch space read in
 
     // non-participating thread: contribute 0 to the sum
-    my_element = make_scalar3(0, 0, 0);
+    my_element = make_scalar4(0, 0, 0, 0);
 
     if (group_idx < work_size)
         {
@@ -85,6 +94,14 @@ __global__ void gpu_compute_thermo_partial_sums(Scalar4 *d_scratch,
             my_element.x = mass * (vel.x*vel.x + vel.y*vel.y + vel.z*vel.z);
             my_element.y = net_force.w;
             my_element.z = net_isotropic_virial;
+
+            if (d_lattice_site)
+                {
+                Scalar4 postype = d_pos[idx];
+                Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+                Scalar3 dr = box.shift(pos, d_image[idx]) - d_lattice_site[tag];
+                my_element.w = net_force.x*dr.x + net_force.y*dr.y + net_force.z*dr.z;
+                }
             }
         }
 
@@ -100,6 +117,7 @@ __global__ void gpu_compute_thermo_partial_sums(Scalar4 *d_scratch,
             compute_thermo_sdata[threadIdx.x].x += compute_thermo_sdata[threadIdx.x + offs].x;
             compute_thermo_sdata[threadIdx.x].y += compute_thermo_sdata[threadIdx.x + offs].y;
             compute_thermo_sdata[threadIdx.x].z += compute_thermo_sdata[threadIdx.x + offs].z;
+            compute_thermo_sdata[threadIdx.x].w += compute_thermo_sdata[threadIdx.x + offs].w;
             }
         offs >>= 1;
         __syncthreads();
@@ -108,8 +126,7 @@ __global__ void gpu_compute_thermo_partial_sums(Scalar4 *d_scratch,
     // write out our partial sum
     if (threadIdx.x == 0)
         {
-        Scalar3 res = compute_thermo_sdata[0];
-        d_scratch[block_offset + blockIdx.x] = make_scalar4(res.x, res.y, res.z, 0);
+        d_scratch[block_offset + blockIdx.x] = compute_thermo_sdata[0];
         }
     }
 
@@ -307,12 +324,14 @@ __global__ void gpu_compute_rotational_ke_partial_sums(Scalar *d_scratch,
     \param num_partial_sums Number of partial sums in \a d_scratch
     \param external_virial External contribution to virial (1/3 trace)
     \param external_energy External contribution to potential energy
+    \param compute_hma Whether to reduce the HMA sum of F . (r - r_lattice)
 
 
     Only one block is executed. In that block, the partial sums are read in and reduced to final values. From the final
     sums, the thermodynamic properties are computed and written to d_properties.
 
-    sizeof(Scalar4)*block_size bytes of shared memory are needed for this kernel to run.
+    sizeof(Scalar4)*block_size bytes of shared memory are needed for this kernel to run, and another
+    sizeof(Scalar)*block_size bytes when \a compute_hma is set.
 */
 __global__ void gpu_compute_thermo_final_sums(Scalar *d_properties,
                                               Scalar4 *d_scratch,
@@ -323,12 +342,15 @@ __global__ void gpu_compute_thermo_final_sums(Scalar *d_properties,
                                               unsigned int group_size,
                                               unsigned int num_partial_sums,
                                               Scalar external_virial,
-                                              Scalar external_energy
+                                              Scalar external_energy,
+                                              bool compute_hma
                                               )
     {
     extern __shared__ Scalar4 compute_thermo_final_sdata[];
+    Scalar *compute_thermo_final_sdata_hma = (Scalar *)&compute_thermo_final_sdata[blockDim.x];
 
     Scalar4 final_sum = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0),Scalar(0.0));
+    Scalar final_sum_hma = Scalar(0.0);
 
     // sum up the values in the partial sum via a sliding window
     for (int start = 0; start < num_partial_sums; start += blockDim.x)
@@ -340,9 +362,15 @@ __global__ void gpu_compute_thermo_final_sums(Scalar *d_properties,
             Scalar scratch_rot = d_scratch_rot[start + threadIdx.x];
 
             compute_thermo_final_sdata[threadIdx.x] = make_scalar4(scratch.x, scratch.y, scratch.z, scratch_rot);
+            if (compute_hma)
+                compute_thermo_final_sdata_hma[threadIdx.x] = scratch.w;
             }
         else
+            {
             compute_thermo_final_sdata[threadIdx.x] = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
+            if (compute_hma)
+                compute_thermo_final_sdata_hma[threadIdx.x] = Scalar(0.0);
+            }
         __syncthreads();
 
         // reduce the sum in parallel
@@ -355,6 +383,8 @@ __global__ void gpu_compute_thermo_final_sums(Scalar *d_properties,
                 compute_thermo_final_sdata[threadIdx.x].y += compute_thermo_final_sdata[threadIdx.x + offs].y;
                 compute_thermo_final_sdata[threadIdx.x].z += compute_thermo_final_sdata[threadIdx.x + offs].z;
                 compute_thermo_final_sdata[threadIdx.x].w += compute_thermo_final_sdata[threadIdx.x + offs].w;
+                if (compute_hma)
+                    compute_thermo_final_sdata_hma[threadIdx.x] += compute_thermo_final_sdata_hma[threadIdx.x + offs];
                 }
             offs >>= 1;
             __syncthreads();
@@ -366,6 +396,8 @@ __global__ void gpu_compute_thermo_final_sums(Scalar *d_properties,
             final_sum.y += compute_thermo_final_sdata[0].y;
             final_sum.z += compute_thermo_final_sdata[0].z;
             final_sum.w += compute_thermo_final_sdata[0].w;
+            if (compute_hma)
+                final_sum_hma += compute_thermo_final_sdata_hma[0];
             }
         }
 
@@ -403,6 +435,7 @@ __global__ void gpu_compute_thermo_final_sums(Scalar *d_properties,
         d_properties[thermo_index::rotational_kinetic_energy] = Scalar(ke_rot_total);
         d_properties[thermo_index::potential_energy] = Scalar(pe_total);
         d_properties[thermo_index::pressure] = pressure;
+        d_properties[thermo_index::hma_force_displacement] = final_sum_hma;
         }
     }
 
@@ -546,13 +579,17 @@ hipError_t gpu_compute_thermo_partial(Scalar *d_properties,
         dim3 grid(nwork/args.block_size+1, 1, 1);
         dim3 threads(args.block_size, 1, 1);
 
-        unsigned int shared_bytes = (unsigned int)(sizeof(Scalar3)*args.block_size);
+        unsigned int shared_bytes = (unsigned int)(sizeof(Scalar4)*args.block_size);
 
         hipLaunchKernelGGL(gpu_compute_thermo_partial_sums, dim3(grid), dim3(threads), shared_bytes, 0, args.d_scratch,
                                                                         args.d_net_force,
                                                                         args.d_net_virial,
                                                                         args.virial_pitch,
                                                                         d_vel,
+                                                                        args.d_pos,
+                                                                        args.d_image,
+                                                                        args.d_lattice_site,
+                                                                        box,
                                                                         d_body,
                                                                         d_tag,
                                                                         d_group_members,
@@ -649,7 +686,10 @@ hipError_t gpu_compute_thermo_final(Scalar *d_properties,
     dim3 grid = dim3(1, 1, 1);
     dim3 threads = dim3(final_block_size, 1, 1);
 
+    bool compute_hma = args.d_lattice_site != NULL;
     unsigned int shared_bytes = (unsigned int)(sizeof(Scalar4)*final_block_size);
+    if (compute_hma)
+        shared_bytes += (unsigned int)(sizeof(Scalar)*final_block_size);
 
     Scalar external_virial = Scalar(1.0/3.0)*(args.external_virial_xx
                              + args.external_virial_yy
@@ -665,7 +705,8 @@ hipError_t gpu_compute_thermo_final(Scalar *d_properties,
                                                                    group_size,
                                                                    args.n_blocks,
                                                                    external_virial,
-                                                                   args.external_energy);
+                                                                   args.external_energy,
+                                                                   compute_hma);
 
     if (compute_pressure_tensor)
         {
@@ -39,6 +39,9 @@ struct compute_thermo_args
     Scalar external_virial_yz;  //!< yz component of the external virial
     Scalar external_virial_zz;  //!< zz component of the external virial
     Scalar external_energy;     //!< External potential energy
+    Scalar4 *d_pos;             //!< Particle positions, for HMA
+    int3 *d_image;              //!< Particle images, for HMA
+    Scalar3 *d_lattice_site;    //!< Lattice site of each particle by tag, NULL when HMA is not computed
     };
 
 //! Computes the partial sums of thermodynamic properties for ComputeThermo
@@ -0,0 +1,270 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ComputeThermoMulti.cc
+    \brief Contains code for the ComputeThermoMulti class
+*/
+
+#include "ComputeThermoMulti.h"
+#include "hoomd/VectorMath.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/Communicator.h"
+#include "hoomd/HOOMDMPI.h"
+#endif
+
+#include <pybind11/stl.h>
+
+#include <cstring>
+#include <iostream>
+
+namespace py = pybind11;
+using namespace std;
+
+/*! \param sysdef System for which to compute thermodynamic properties
+    \param groups Groups of particles over which properties are calculated
+*/
+ComputeThermoMulti::ComputeThermoMulti(std::shared_ptr<SystemDefinition> sysdef,
+                                       const std::vector< std::shared_ptr<ParticleGroup> >& groups)
+    : Compute(sysdef), m_groups(groups), m_membership_pitch(0), m_membership_dirty(true)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing ComputeThermoMulti" << endl;
+
+    m_num_words = ((unsigned int)m_groups.size() + 31)/32;
+
+    GlobalArray< Scalar > properties(std::max((size_t)1, m_groups.size()*thermo_multi_index::num_quantities),
+                                     m_exec_conf);
+    m_properties.swap(properties);
+    TAG_ALLOCATION(m_properties);
+
+    #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
+    if (m_exec_conf->isCUDAEnabled() && m_exec_conf->allConcurrentManagedAccess())
+        {
+        // store in host memory for faster access from CPU
+        cudaMemAdvise(m_properties.get(), m_properties.getNumElements()*sizeof(Scalar), cudaMemAdviseSetPreferredLocation, cudaCpuDeviceId);
+        CHECK_CUDA_ERROR();
+        }
+    #endif
+
+    m_pdata->getParticleSortSignal().connect<ComputeThermoMulti, &ComputeThermoMulti::slotMembershipChanged>(this);
+    m_pdata->getGlobalParticleNumberChangeSignal().connect<ComputeThermoMulti,
+        &ComputeThermoMulti::slotMembershipChanged>(this);
+
+    m_computed_flags.reset();
+
+    #ifdef ENABLE_MPI
+    m_properties_reduced = true;
+    #endif
+    }
+
+ComputeThermoMulti::~ComputeThermoMulti()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying ComputeThermoMulti" << endl;
+
+    m_pdata->getParticleSortSignal().disconnect<ComputeThermoMulti, &ComputeThermoMulti::slotMembershipChanged>(this);
+    m_pdata->getGlobalParticleNumberChangeSignal().disconnect<ComputeThermoMulti,
+        &ComputeThermoMulti::slotMembershipChanged>(this);
+    }
+
+/*! Calls computeProperties if the properties need updating
+    \param timestep Current time step of the simulation
+*/
+void ComputeThermoMulti::compute(unsigned int timestep)
+    {
+    if (shouldCompute(timestep))
+        {
+        computeProperties();
+        m_computed_flags = m_pdata->getFlags();
+        }
+    }
+
+/*! The mask is reallocated when the maximum number of particles changed, and its bits are set again after the
+    particles have been sorted, migrated, added, or removed.
+*/
+void ComputeThermoMulti::updateMembership()
+    {
+    unsigned int pitch = m_pdata->getMaxN();
+    if (pitch != m_membership_pitch)
+        {
+        GlobalArray<unsigned int> membership(std::max(1u, m_num_words*pitch), m_exec_conf);
+        m_membership.swap(membership);
+        TAG_ALLOCATION(m_membership);
+        m_membership_pitch = pitch;
+        m_membership_dirty = true;
+        }
+
+    if (m_membership_dirty)
+        {
+        setMembership();
+        m_membership_dirty = false;
+        }
+    }
+
+void ComputeThermoMulti::setMembership()
+    {
+    ArrayHandle<unsigned int> h_membership(m_membership, access_location::host, access_mode::overwrite);
+    memset(h_membership.data, 0, sizeof(unsigned int)*m_membership.getNumElements());
+
+    for (unsigned int g = 0; g < m_groups.size(); ++g)
+        {
+        unsigned int *word = h_membership.data + (g/32)*m_membership_pitch;
+        unsigned int bit = 1u << (g % 32);
+
+        ArrayHandle<unsigned int> h_index(m_groups[g]->getIndexArray(), access_location::host, access_mode::read);
+        unsigned int group_size = m_groups[g]->getNumMembers();
+        for (unsigned int group_idx = 0; group_idx < group_size; ++group_idx)
+            word[h_index.data[group_idx]] |= bit;
+        }
+    }
+
+/*! Computes the contribution of each particle once and adds it to the sums of all groups it belongs to.
+*/
+void ComputeThermoMulti::computeProperties()
+    {
+    if (m_prof) m_prof->push("Thermo");
+
+    updateMembership();
+
+    const unsigned int n_quantities = thermo_multi_index::num_quantities;
+    std::vector<double> sums(m_groups.size()*n_quantities, 0.0);
+
+    PDataFlags flags = m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
+    bool compute_rotational_energy = flags[pdata_flag::rotational_kinetic_energy];
+
+    {
+    ArrayHandle<unsigned int> h_membership(m_membership, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_net_virial(m_pdata->getNetVirial(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
+    size_t virial_pitch = m_pdata->getNetVirial().getPitch();
+
+    unsigned int N = m_pdata->getN();
+    for (unsigned int j = 0; j < N; ++j)
+        {
+        // ignore rigid body constituent particles in the sum
+        if (!(h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j]))
+            continue;
+
+        // skip particles that are in none of the groups before computing their contribution
+        bool member = false;
+        for (unsigned int w = 0; w < m_num_words; ++w)
+            member = member || h_membership.data[w*m_membership_pitch + j];
+        if (!member)
+            continue;
+
+        double contribution[n_quantities];
+        double mass = h_vel.data[j].w;
+        double vx = h_vel.data[j].x;
+        double vy = h_vel.data[j].y;
+        double vz = h_vel.data[j].z;
+        contribution[thermo_multi_index::translational_kinetic_energy] = 0.5*mass*(vx*vx + vy*vy + vz*vz);
+        contribution[thermo_multi_index::potential_energy] = h_net_force.data[j].w;
+        contribution[thermo_multi_index::pressure_xx] = mass*vx*vx;
+        contribution[thermo_multi_index::pressure_xy] = mass*vx*vy;
+        contribution[thermo_multi_index::pressure_xz] = mass*vx*vz;
+        contribution[thermo_multi_index::pressure_yy] = mass*vy*vy;
+        contribution[thermo_multi_index::pressure_yz] = mass*vy*vz;
+        contribution[thermo_multi_index::pressure_zz] = mass*vz*vz;
+        if (compute_virial)
+            {
+            for (unsigned int k = 0; k < 6; ++k)
+                contribution[thermo_multi_index::pressure_xx + k] += h_net_virial.data[j + k*virial_pitch];
+            }
+
+        double ke_rot = 0.0;
+        if (compute_rotational_energy)
+            {
+            Scalar3 I = h_inertia.data[j];
+            quat<Scalar> q(h_orientation.data[j]);
+            quat<Scalar> p(h_angmom.data[j]);
+            quat<Scalar> s(Scalar(0.5)*conj(q)*p);
+
+            // only if the moment of inertia along one principal axis is non-zero, that axis carries angular momentum
+            if (I.x >= EPSILON)
+                ke_rot += s.v.x*s.v.x/I.x;
+            if (I.y >= EPSILON)
+                ke_rot += s.v.y*s.v.y/I.y;
+            if (I.z >= EPSILON)
+                ke_rot += s.v.z*s.v.z/I.z;
+            ke_rot *= 0.5;
+            }
+        contribution[thermo_multi_index::rotational_kinetic_energy] = ke_rot;
+
+        // add the contribution to every group with a set bit
+        for (unsigned int w = 0; w < m_num_words; ++w)
+            {
+            unsigned int mask = h_membership.data[w*m_membership_pitch + j];
+            for (unsigned int bit = 0; mask != 0; ++bit, mask >>= 1)
+                {
+                if (!(mask & 1))
+                    continue;
+
+                double *group_sums = &sums[(w*32 + bit)*n_quantities];
+                for (unsigned int k = 0; k < n_quantities; ++k)
+                    group_sums[k] += contribution[k];
+                }
+            }
+        }
+    }
+
+    // fill out the GlobalArray, external terms are added to every group like ComputeThermo does
+    ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::overwrite);
+    for (unsigned int g = 0; g < m_groups.size(); ++g)
+        {
+        double *group_sums = &sums[g*n_quantities];
+        group_sums[thermo_multi_index::potential_energy] += m_pdata->getExternalEnergy();
+        for (unsigned int k = 0; k < 6; ++k)
+            group_sums[thermo_multi_index::pressure_xx + k] += m_pdata->getExternalVirial(k);
+
+        for (unsigned int k = 0; k < n_quantities; ++k)
+            h_properties.data[g*n_quantities + k] = Scalar(group_sums[k]);
+        }
+
+    #ifdef ENABLE_MPI
+    // in MPI, reduce extensive quantities only when they're needed
+    m_properties_reduced = !m_pdata->getDomainDecomposition();
+    #endif // ENABLE_MPI
+
+    if (m_prof) m_prof->pop();
+    }
+
+#ifdef ENABLE_MPI
+void ComputeThermoMulti::reduceProperties()
+    {
+    if (m_properties_reduced) return;
+
+    // reduce properties
+    ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::readwrite);
+    MPI_Allreduce(MPI_IN_PLACE, h_properties.data, (int)m_properties.getNumElements(), MPI_HOOMD_SCALAR,
+            MPI_SUM, m_exec_conf->getMPICommunicator());
+
+    m_properties_reduced = true;
+    }
+#endif
+
+void export_ComputeThermoMulti(py::module& m)
+    {
+    py::class_<ComputeThermoMulti, Compute, std::shared_ptr<ComputeThermoMulti> >(m,"ComputeThermoMulti")
+    .def(py::init< std::shared_ptr<SystemDefinition>, const std::vector< std::shared_ptr<ParticleGroup> >& >())
+    .def("getNumGroups", &ComputeThermoMulti::getNumGroups)
+    .def("getTemperature", &ComputeThermoMulti::getTemperature)
+    .def("getTranslationalTemperature", &ComputeThermoMulti::getTranslationalTemperature)
+    .def("getRotationalTemperature", &ComputeThermoMulti::getRotationalTemperature)
+    .def("getKineticEnergy", &ComputeThermoMulti::getKineticEnergy)
+    .def("getTranslationalKineticEnergy", &ComputeThermoMulti::getTranslationalKineticEnergy)
+    .def("getRotationalKineticEnergy", &ComputeThermoMulti::getRotationalKineticEnergy)
+    .def("getPotentialEnergy", &ComputeThermoMulti::getPotentialEnergy)
+    .def("getPressure", &ComputeThermoMulti::getPressure)
+    .def("getPressureTensor", &ComputeThermoMulti::getPressureTensor)
+    .def("getNDOF", &ComputeThermoMulti::getNDOF)
+    .def("getTranslationalDOF", &ComputeThermoMulti::getTranslationalDOF)
+    .def("getRotationalDOF", &ComputeThermoMulti::getRotationalDOF)
+    .def("getNumParticles", &ComputeThermoMulti::getNumParticles)
+    ;
+    }
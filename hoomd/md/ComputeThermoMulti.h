@@ -0,0 +1,230 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/Compute.h"
+#include "hoomd/GlobalArray.h"
+#include "ComputeThermoTypes.h"
+#include "hoomd/ParticleGroup.h"
+
+#include <memory>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+/*! \file ComputeThermoMulti.h
+    \brief Declares a class for computing thermodynamic quantities of many groups at once
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __COMPUTE_THERMO_MULTI_H__
+#define __COMPUTE_THERMO_MULTI_H__
+
+//! Computes thermodynamic properties of many groups of particles in one pass
+/*! ComputeThermoMulti computes the same quantities as one ComputeThermo per group, without HMA. Instead of reducing
+    over the index list of every group, it reads the particle data once. A bitmask of group membership is kept per
+    particle, with one 32 bit word per 32 groups, and the contribution of each particle is added to the sums of all
+    groups whose bit it has set. On the GPU, each block reduces its particles for one group after another, and skips
+    the groups that none of its particles belong to.
+
+    The membership mask is rebuilt from the index arrays of the groups when the particles are sorted or the global
+    number of particles changes.
+
+    The sums of the groups are stored in a GlobalArray indexed by g*thermo_multi_index::num_quantities + quantity.
+    The getters compute the temperatures and pressures from these sums.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT ComputeThermoMulti : public Compute
+    {
+    public:
+        //! Constructs the compute
+        ComputeThermoMulti(std::shared_ptr<SystemDefinition> sysdef,
+                           const std::vector< std::shared_ptr<ParticleGroup> >& groups);
+
+        //! Destructor
+        virtual ~ComputeThermoMulti();
+
+        //! Compute the properties
+        virtual void compute(unsigned int timestep);
+
+        //! Get the number of groups
+        unsigned int getNumGroups()
+            {
+            return (unsigned int)m_groups.size();
+            }
+
+        //! Returns the temperature of a group last computed by compute()
+        Scalar getTemperature(unsigned int group)
+            {
+            Scalar ndof = getNDOF(group);
+            return Scalar(2.0)/ndof*(getSum(group, thermo_multi_index::translational_kinetic_energy)
+                                     + getSum(group, thermo_multi_index::rotational_kinetic_energy));
+            }
+
+        //! Returns the translational temperature of a group last computed by compute()
+        Scalar getTranslationalTemperature(unsigned int group)
+            {
+            return Scalar(2.0)/getTranslationalDOF(group)
+                *getSum(group, thermo_multi_index::translational_kinetic_energy);
+            }
+
+        //! Returns the rotational temperature of a group last computed by compute()
+        Scalar getRotationalTemperature(unsigned int group)
+            {
+            // return 0.0 if the flags are not valid or we have no rotational DOF
+            if (m_computed_flags[pdata_flag::rotational_kinetic_energy] && getRotationalDOF(group) > 0)
+                {
+                return Scalar(2.0)/getRotationalDOF(group)
+                    *getSum(group, thermo_multi_index::rotational_kinetic_energy);
+                }
+            return 0.0;
+            }
+
+        //! Returns the translational kinetic energy of a group last computed by compute()
+        Scalar getTranslationalKineticEnergy(unsigned int group)
+            {
+            return getSum(group, thermo_multi_index::translational_kinetic_energy);
+            }
+
+        //! Returns the rotational kinetic energy of a group last computed by compute()
+        Scalar getRotationalKineticEnergy(unsigned int group)
+            {
+            return getSum(group, thermo_multi_index::rotational_kinetic_energy);
+            }
+
+        //! Returns the total kinetic energy of a group last computed by compute()
+        Scalar getKineticEnergy(unsigned int group)
+            {
+            return getTranslationalKineticEnergy(group) + getRotationalKineticEnergy(group);
+            }
+
+        //! Returns the potential energy of a group last computed by compute()
+        Scalar getPotentialEnergy(unsigned int group)
+            {
+            return getSum(group, thermo_multi_index::potential_energy);
+            }
+
+        //! Returns the pressure of a group last computed by compute()
+        /*! \returns Instantaneous pressure of the group, or NaN if the flags are not valid
+        */
+        Scalar getPressure(unsigned int group)
+            {
+            if (!m_computed_flags[pdata_flag::pressure_tensor])
+                return std::numeric_limits<Scalar>::quiet_NaN();
+
+            // P = (2 K / D + W) / V is the trace of the pressure tensor over D
+            Scalar trace = getSum(group, thermo_multi_index::pressure_xx)
+                + getSum(group, thermo_multi_index::pressure_yy)
+                + getSum(group, thermo_multi_index::pressure_zz);
+            return trace/(Scalar(m_sysdef->getNDimensions())*getVolume());
+            }
+
+        //! Returns a component of the pressure tensor of a group last computed by compute()
+        /*! \param group Index of the group
+            \param component Index of the component in the order xx, xy, xz, yy, yz, zz
+            \returns The component, or NaN if the flags are not valid
+        */
+        Scalar getPressureTensor(unsigned int group, unsigned int component)
+            {
+            if (!m_computed_flags[pdata_flag::pressure_tensor] || component >= 6)
+                return std::numeric_limits<Scalar>::quiet_NaN();
+
+            return getSum(group, thermo_multi_index::pressure_xx + component)/getVolume();
+            }
+
+        //! Returns the number of degrees of freedom of a group
+        double getNDOF(unsigned int group)
+            {
+            return getGroup(group)->getTranslationalDOF() + getGroup(group)->getRotationalDOF();
+            }
+
+        //! Returns the number of translational degrees of freedom of a group
+        double getTranslationalDOF(unsigned int group)
+            {
+            return getGroup(group)->getTranslationalDOF();
+            }
+
+        //! Returns the number of rotational degrees of freedom of a group
+        double getRotationalDOF(unsigned int group)
+            {
+            return getGroup(group)->getRotationalDOF();
+            }
+
+        //! Returns the number of particles in a group
+        unsigned int getNumParticles(unsigned int group)
+            {
+            return getGroup(group)->getNumMembersGlobal();
+            }
+
+    protected:
+        std::vector< std::shared_ptr<ParticleGroup> > m_groups;    //!< Groups to compute properties for
+        unsigned int m_num_words;                   //!< Number of 32 bit membership words per particle
+        GlobalArray<unsigned int> m_membership;     //!< Membership bits, word w of particle i at w*pitch + i
+        unsigned int m_membership_pitch;            //!< Pitch of the membership array
+        bool m_membership_dirty;                    //!< True when the membership mask must be rebuilt
+        GlobalArray<Scalar> m_properties;           //!< Sums of the groups
+        PDataFlags m_computed_flags;                //!< Particle data flags used during the last computation
+
+        //! Rebuild the membership mask if needed
+        void updateMembership();
+
+        //! Set the membership bits of the groups
+        virtual void setMembership();
+
+        //! Does the actual computation
+        virtual void computeProperties();
+
+        //! Flag the membership mask for a rebuild
+        void slotMembershipChanged()
+            {
+            m_membership_dirty = true;
+            }
+
+        #ifdef ENABLE_MPI
+        bool m_properties_reduced;      //!< True if properties have been reduced across MPI
+
+        //! Reduce properties over MPI
+        void reduceProperties();
+        #endif
+
+    private:
+        //! Get a group, checking the index
+        std::shared_ptr<ParticleGroup> getGroup(unsigned int group)
+            {
+            if (group >= m_groups.size())
+                throw std::out_of_range("ComputeThermoMulti: group index out of range");
+            return m_groups[group];
+            }
+
+        //! Get a sum of a group
+        Scalar getSum(unsigned int group, unsigned int quantity)
+            {
+            getGroup(group);
+
+            #ifdef ENABLE_MPI
+            if (!m_properties_reduced) reduceProperties();
+            #endif
+
+            ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::read);
+            return h_properties.data[group*thermo_multi_index::num_quantities + quantity];
+            }
+
+        //! Get the volume of the global box (the area in 2D)
+        Scalar getVolume()
+            {
+            Scalar3 L = m_pdata->getGlobalBox().getL();
+            return (m_sysdef->getNDimensions() == 2) ? L.x*L.y : L.x*L.y*L.z;
+            }
+    };
+
+//! Exports the ComputeThermoMulti class to python
+#ifndef __HIPCC__
+void export_ComputeThermoMulti(pybind11::module& m);
+#endif
+
+#endif
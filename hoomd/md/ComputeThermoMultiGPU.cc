@@ -0,0 +1,129 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ComputeThermoMultiGPU.cc
+    \brief Contains code for the ComputeThermoMultiGPU class
+*/
+
+#include "ComputeThermoMultiGPU.h"
+#include "ComputeThermoMultiGPU.cuh"
+
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <iostream>
+using namespace std;
+
+/*! \param sysdef System for which to compute thermodynamic properties
+    \param groups Groups of particles over which properties are calculated
+*/
+ComputeThermoMultiGPU::ComputeThermoMultiGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                             const std::vector< std::shared_ptr<ParticleGroup> >& groups)
+    : ComputeThermoMulti(sysdef, groups), m_scratch(m_exec_conf)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error() << "Creating a ComputeThermoMultiGPU with no GPU in the execution configuration"
+                                  << endl;
+        throw std::runtime_error("Error initializing ComputeThermoMultiGPU");
+        }
+
+    m_block_size = 256;
+    }
+
+ComputeThermoMultiGPU::~ComputeThermoMultiGPU()
+    {
+    }
+
+void ComputeThermoMultiGPU::setMembership()
+    {
+    ArrayHandle<unsigned int> d_membership(m_membership, access_location::device, access_mode::overwrite);
+    hipMemset(d_membership.data, 0, sizeof(unsigned int)*m_membership.getNumElements());
+
+    for (unsigned int g = 0; g < m_groups.size(); ++g)
+        {
+        ArrayHandle<unsigned int> d_index(m_groups[g]->getIndexArray(), access_location::device, access_mode::read);
+        gpu_thermo_multi_set_membership(d_membership.data,
+                                        m_membership_pitch,
+                                        d_index.data,
+                                        m_groups[g]->getNumMembers(),
+                                        g,
+                                        m_block_size);
+        }
+
+    if(m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+/*! Computes all thermodynamic properties of all groups in one pass over the particles, on the GPU.
+ */
+void ComputeThermoMultiGPU::computeProperties()
+    {
+    if (m_prof) m_prof->push(m_exec_conf,"Thermo");
+
+    updateMembership();
+
+    unsigned int N = m_pdata->getN();
+    unsigned int num_blocks = N / m_block_size + 1;
+    m_scratch.resize(m_groups.size()*thermo_multi_index::num_quantities*num_blocks);
+
+    PDataFlags flags = m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
+    bool compute_rotational_energy = flags[pdata_flag::rotational_kinetic_energy];
+
+    {
+    ArrayHandle<unsigned int> d_membership(m_membership, access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_body(m_pdata->getBodies(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_net_force(m_pdata->getNetForce(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar> d_net_virial(m_pdata->getNetVirial(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar> d_scratch(m_scratch, access_location::device, access_mode::overwrite);
+    ArrayHandle<Scalar> d_properties(m_properties, access_location::device, access_mode::overwrite);
+
+    compute_thermo_multi_args args;
+    args.d_membership = d_membership.data;
+    args.membership_pitch = m_membership_pitch;
+    args.n_groups = (unsigned int)m_groups.size();
+    args.d_vel = d_vel.data;
+    args.d_body = d_body.data;
+    args.d_tag = d_tag.data;
+    args.d_net_force = d_net_force.data;
+    args.d_net_virial = compute_virial ? d_net_virial.data : NULL;
+    args.virial_pitch = m_pdata->getNetVirial().getPitch();
+    args.d_orientation = compute_rotational_energy ? d_orientation.data : NULL;
+    args.d_angmom = d_angmom.data;
+    args.d_inertia = d_inertia.data;
+    args.N = N;
+    args.d_scratch = d_scratch.data;
+    args.block_size = m_block_size;
+    args.n_blocks = num_blocks;
+    args.external_energy = m_pdata->getExternalEnergy();
+    for (unsigned int k = 0; k < 6; ++k)
+        args.external_virial[k] = m_pdata->getExternalVirial(k);
+
+    gpu_compute_thermo_multi(d_properties.data, args);
+
+    if(m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+    #ifdef ENABLE_MPI
+    // in MPI, reduce extensive quantities only when they're needed
+    m_properties_reduced = !m_pdata->getDomainDecomposition();
+    #endif // ENABLE_MPI
+
+    if (m_prof) m_prof->pop(m_exec_conf);
+    }
+
+void export_ComputeThermoMultiGPU(py::module& m)
+    {
+    py::class_<ComputeThermoMultiGPU, ComputeThermoMulti, std::shared_ptr<ComputeThermoMultiGPU> >(m,
+        "ComputeThermoMultiGPU")
+    .def(py::init< std::shared_ptr<SystemDefinition>, const std::vector< std::shared_ptr<ParticleGroup> >& >())
+    ;
+    }
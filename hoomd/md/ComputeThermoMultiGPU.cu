@@ -0,0 +1,241 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include <hip/hip_runtime.h>
+#include "ComputeThermoMultiGPU.cuh"
+#include "hoomd/VectorMath.h"
+#include "hoomd/HOOMDMath.h"
+
+#include <assert.h>
+
+/*! \file ComputeThermoMultiGPU.cu
+    \brief Defines GPU kernel code for computing thermodynamic properties of many groups. Used by
+    ComputeThermoMultiGPU.
+*/
+
+//! Set the membership bit of one group
+/*! \param d_membership Membership bits
+    \param membership_pitch Pitch of the membership array
+    \param d_group_members Indices of the group members
+    \param group_size Number of local group members
+    \param group Index of the group
+
+    The members of a group are distinct, so the threads of one launch never write the same word.
+*/
+__global__ void gpu_thermo_multi_set_membership_kernel(unsigned int *d_membership,
+                                                       const unsigned int membership_pitch,
+                                                       const unsigned int *d_group_members,
+                                                       const unsigned int group_size,
+                                                       const unsigned int group)
+    {
+    unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (group_idx >= group_size)
+        return;
+
+    unsigned int idx = d_group_members[group_idx];
+    d_membership[(group/32)*membership_pitch + idx] |= 1u << (group % 32);
+    }
+
+//! Perform the partial sums of the thermo properties of all groups
+/*! \param args Arguments, see compute_thermo_multi_args
+
+    One thread is executed per particle. It computes the contribution of its particle once. Then the block reduces
+    the contributions of its members for each group in turn, in dynamic shared memory of
+    num_quantities*sizeof(Scalar)*block_size bytes. Groups that none of the particles of the block belong to are
+    skipped, which is the common case for groups that are contiguous in space, since the particles are sorted.
+    The partial sum of quantity k of group g is written to d_scratch[(g*num_quantities + k)*gridDim.x + blockIdx.x].
+*/
+__global__ void gpu_compute_thermo_multi_partial_sums(const compute_thermo_multi_args args)
+    {
+    const unsigned int n_quantities = thermo_multi_index::num_quantities;
+    HIP_DYNAMIC_SHARED(Scalar, compute_thermo_multi_sdata)
+
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    // non-participating threads contribute 0 to the sums
+    Scalar contribution[n_quantities];
+    for (unsigned int k = 0; k < n_quantities; ++k)
+        contribution[k] = Scalar(0.0);
+
+    bool active = false;
+    if (idx < args.N)
+        {
+        // ignore rigid body constituent particles in the sum
+        unsigned int body = args.d_body[idx];
+        active = body >= MIN_FLOPPY || body == args.d_tag[idx];
+        }
+
+    if (active)
+        {
+        Scalar4 vel = args.d_vel[idx];
+        Scalar mass = vel.w;
+        contribution[thermo_multi_index::translational_kinetic_energy]
+            = Scalar(0.5)*mass*(vel.x*vel.x + vel.y*vel.y + vel.z*vel.z);
+        contribution[thermo_multi_index::potential_energy] = args.d_net_force[idx].w;
+        contribution[thermo_multi_index::pressure_xx] = mass*vel.x*vel.x;
+        contribution[thermo_multi_index::pressure_xy] = mass*vel.x*vel.y;
+        contribution[thermo_multi_index::pressure_xz] = mass*vel.x*vel.z;
+        contribution[thermo_multi_index::pressure_yy] = mass*vel.y*vel.y;
+        contribution[thermo_multi_index::pressure_yz] = mass*vel.y*vel.z;
+        contribution[thermo_multi_index::pressure_zz] = mass*vel.z*vel.z;
+
+        if (args.d_net_virial)
+            {
+            for (unsigned int k = 0; k < 6; ++k)
+                contribution[thermo_multi_index::pressure_xx + k] += args.d_net_virial[k*args.virial_pitch + idx];
+            }
+
+        if (args.d_orientation)
+            {
+            Scalar3 I = args.d_inertia[idx];
+            quat<Scalar> q(args.d_orientation[idx]);
+            quat<Scalar> p(args.d_angmom[idx]);
+            quat<Scalar> s(Scalar(0.5)*conj(q)*p);
+
+            Scalar ke_rot(0.0);
+            if (I.x >= EPSILON)
+                ke_rot += s.v.x*s.v.x/I.x;
+            if (I.y >= EPSILON)
+                ke_rot += s.v.y*s.v.y/I.y;
+            if (I.z >= EPSILON)
+                ke_rot += s.v.z*s.v.z/I.z;
+            contribution[thermo_multi_index::rotational_kinetic_energy] = Scalar(0.5)*ke_rot;
+            }
+        }
+
+    unsigned int n_words = (args.n_groups + 31)/32;
+    for (unsigned int w = 0; w < n_words; ++w)
+        {
+        unsigned int mask = active ? args.d_membership[w*args.membership_pitch + idx] : 0;
+        unsigned int n_bits = min(32u, args.n_groups - 32*w);
+
+        for (unsigned int bit = 0; bit < n_bits; ++bit)
+            {
+            unsigned int group = 32*w + bit;
+            bool member = (mask >> bit) & 1;
+            Scalar *partial_sums = args.d_scratch + group*n_quantities*gridDim.x + blockIdx.x;
+
+            // skip the reduction when no particle of the block is in the group
+            if (!__syncthreads_or(member))
+                {
+                if (threadIdx.x < n_quantities)
+                    partial_sums[threadIdx.x*gridDim.x] = Scalar(0.0);
+                continue;
+                }
+
+            for (unsigned int k = 0; k < n_quantities; ++k)
+                compute_thermo_multi_sdata[k*blockDim.x + threadIdx.x] = member ? contribution[k] : Scalar(0.0);
+            __syncthreads();
+
+            // reduce the sums in parallel
+            int offs = blockDim.x >> 1;
+            while (offs > 0)
+                {
+                if (threadIdx.x < offs)
+                    {
+                    for (unsigned int k = 0; k < n_quantities; ++k)
+                        compute_thermo_multi_sdata[k*blockDim.x + threadIdx.x]
+                            += compute_thermo_multi_sdata[k*blockDim.x + threadIdx.x + offs];
+                    }
+                offs >>= 1;
+                __syncthreads();
+                }
+
+            // write out the partial sums, the shared memory is not overwritten before the next barrier
+            if (threadIdx.x < n_quantities)
+                partial_sums[threadIdx.x*gridDim.x] = compute_thermo_multi_sdata[threadIdx.x*blockDim.x];
+            }
+        }
+    }
+
+//! Complete the sums of the thermo properties of all groups
+/*! \param d_properties Sums of the groups
+    \param args Arguments, see compute_thermo_multi_args
+
+    One block is executed per group and quantity. It sums the n_blocks partial sums and adds the external terms.
+    block_size*sizeof(Scalar) bytes of dynamic shared memory are needed.
+*/
+__global__ void gpu_compute_thermo_multi_final_sums(Scalar *d_properties, const compute_thermo_multi_args args)
+    {
+    HIP_DYNAMIC_SHARED(Scalar, compute_thermo_multi_final_sdata)
+
+    const unsigned int n_quantities = thermo_multi_index::num_quantities;
+    unsigned int sum_idx = blockIdx.x;
+    const Scalar *partial_sums = args.d_scratch + sum_idx*args.n_blocks;
+
+    Scalar sum(0.0);
+    for (unsigned int i = threadIdx.x; i < args.n_blocks; i += blockDim.x)
+        sum += partial_sums[i];
+
+    compute_thermo_multi_final_sdata[threadIdx.x] = sum;
+    __syncthreads();
+
+    int offs = blockDim.x >> 1;
+    while (offs > 0)
+        {
+        if (threadIdx.x < offs)
+            compute_thermo_multi_final_sdata[threadIdx.x] += compute_thermo_multi_final_sdata[threadIdx.x + offs];
+        offs >>= 1;
+        __syncthreads();
+        }
+
+    if (threadIdx.x == 0)
+        {
+        Scalar total = compute_thermo_multi_final_sdata[0];
+
+        // external terms are added to every group like ComputeThermo does
+        unsigned int quantity = sum_idx % n_quantities;
+        if (quantity == thermo_multi_index::potential_energy)
+            total += args.external_energy;
+        else if (quantity >= thermo_multi_index::pressure_xx)
+            total += args.external_virial[quantity - thermo_multi_index::pressure_xx];
+
+        d_properties[sum_idx] = total;
+        }
+    }
+
+/*! \param d_membership Membership bits
+    \param membership_pitch Pitch of the membership array
+    \param d_group_members Indices of the group members
+    \param group_size Number of local group members
+    \param group Index of the group
+    \param block_size Block size to execute
+*/
+hipError_t gpu_thermo_multi_set_membership(unsigned int *d_membership,
+                                           const unsigned int membership_pitch,
+                                           const unsigned int *d_group_members,
+                                           const unsigned int group_size,
+                                           const unsigned int group,
+                                           const unsigned int block_size)
+    {
+    if (group_size == 0)
+        return hipSuccess;
+
+    dim3 grid(group_size / block_size + 1, 1, 1);
+    dim3 threads(block_size, 1, 1);
+    hipLaunchKernelGGL((gpu_thermo_multi_set_membership_kernel), grid, threads, 0, 0,
+        d_membership, membership_pitch, d_group_members, group_size, group);
+
+    return hipSuccess;
+    }
+
+/*! \param d_properties Sums of the groups, num_quantities per group
+    \param args Arguments, see compute_thermo_multi_args
+*/
+hipError_t gpu_compute_thermo_multi(Scalar *d_properties, const compute_thermo_multi_args& args)
+    {
+    assert(args.block_size >= thermo_multi_index::num_quantities);
+    if (args.n_groups == 0)
+        return hipSuccess;
+
+    dim3 grid(args.n_blocks, 1, 1);
+    dim3 threads(args.block_size, 1, 1);
+    unsigned int shared_bytes = thermo_multi_index::num_quantities*sizeof(Scalar)*args.block_size;
+    hipLaunchKernelGGL((gpu_compute_thermo_multi_partial_sums), grid, threads, shared_bytes, 0, args);
+
+    dim3 final_grid(args.n_groups*thermo_multi_index::num_quantities, 1, 1);
+    hipLaunchKernelGGL((gpu_compute_thermo_multi_final_sums), final_grid, threads, sizeof(Scalar)*args.block_size, 0,
+        d_properties, args);
+
+    return hipSuccess;
+    }
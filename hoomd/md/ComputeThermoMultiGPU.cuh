@@ -0,0 +1,49 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _COMPUTE_THERMO_MULTI_GPU_CUH_
+#define _COMPUTE_THERMO_MULTI_GPU_CUH_
+
+#include "hoomd/ParticleData.cuh"
+#include "ComputeThermoTypes.h"
+#include "hoomd/HOOMDMath.h"
+
+/*! \file ComputeThermoMultiGPU.cuh
+    \brief Kernel driver function declarations for ComputeThermoMultiGPU
+    */
+
+//! Holder for arguments to gpu_compute_thermo_multi
+struct compute_thermo_multi_args
+    {
+    const unsigned int *d_membership;   //!< Membership bits, word w of particle i at w*membership_pitch + i
+    unsigned int membership_pitch;      //!< Pitch of the membership array
+    unsigned int n_groups;              //!< Number of groups
+    const Scalar4 *d_vel;               //!< Particle velocities and masses
+    const unsigned int *d_body;         //!< Particle body ids
+    const unsigned int *d_tag;          //!< Particle tags
+    const Scalar4 *d_net_force;         //!< Net force / pe array to sum
+    const Scalar *d_net_virial;         //!< Net virial array to sum, NULL to skip the virial
+    size_t virial_pitch;                //!< Pitch of 2D net_virial array
+    const Scalar4 *d_orientation;       //!< Particle orientations, NULL to skip the rotational kinetic energy
+    const Scalar4 *d_angmom;            //!< Particle angular momenta
+    const Scalar3 *d_inertia;           //!< Particle moments of inertia
+    unsigned int N;                     //!< Number of local particles
+    Scalar *d_scratch;                  //!< n_groups*num_quantities*n_blocks elements of scratch space
+    unsigned int block_size;            //!< Block size to execute on the GPU, a power of two
+    unsigned int n_blocks;              //!< Number of blocks of the partial sums
+    Scalar external_energy;             //!< External potential energy added to every group
+    Scalar external_virial[6];          //!< External virial added to every group
+    };
+
+//! Sets the membership bit of one group
+hipError_t gpu_thermo_multi_set_membership(unsigned int *d_membership,
+                                           const unsigned int membership_pitch,
+                                           const unsigned int *d_group_members,
+                                           const unsigned int group_size,
+                                           const unsigned int group,
+                                           const unsigned int block_size);
+
+//! Computes the sums of thermodynamic properties of all groups for ComputeThermoMulti
+hipError_t gpu_compute_thermo_multi(Scalar *d_properties, const compute_thermo_multi_args& args);
+
+#endif
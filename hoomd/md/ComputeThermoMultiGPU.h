@@ -0,0 +1,46 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ComputeThermoMulti.h"
+
+/*! \file ComputeThermoMultiGPU.h
+    \brief Declares a class for computing thermodynamic quantities of many groups at once on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __COMPUTE_THERMO_MULTI_GPU_H__
+#define __COMPUTE_THERMO_MULTI_GPU_H__
+
+//! Computes thermodynamic properties of many groups of particles in one pass on the GPU
+/*! ComputeThermoMultiGPU is a GPU accelerated implementation of ComputeThermoMulti. The partial sums of all groups
+    are computed by one kernel launch over the local particles, and one more launch reduces them.
+    \ingroup computes
+*/
+class PYBIND11_EXPORT ComputeThermoMultiGPU : public ComputeThermoMulti
+    {
+    public:
+        //! Constructs the compute
+        ComputeThermoMultiGPU(std::shared_ptr<SystemDefinition> sysdef,
+                              const std::vector< std::shared_ptr<ParticleGroup> >& groups);
+        virtual ~ComputeThermoMultiGPU();
+
+    protected:
+        GlobalVector<Scalar> m_scratch;  //!< Scratch space for the partial sums of all groups
+        unsigned int m_block_size;      //!< Block size executed
+
+        //! Set the membership bits of the groups
+        virtual void setMembership();
+
+        //! Does the actual computation
+        virtual void computeProperties();
+    };
+
+//! Exports the ComputeThermoMultiGPU class to python
+void export_ComputeThermoMultiGPU(pybind11::module& m);
+
+#endif
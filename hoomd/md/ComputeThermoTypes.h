@@ -28,10 +28,33 @@ struct thermo_index
         pressure_yy,         //!< Index for the yy component of the pressure tensor in the GPUArray
         pressure_yz,         //!< Index for the yz component of the pressure tensor in the GPUArray
         pressure_zz,         //!< Index for the zz component of the pressure tensor in the GPUArray
+        hma_force_displacement, //!< Sum of F . (r - r_lattice) used by the HMA estimators
         num_quantities       // final element to count number of quantities
         };
     };
 
+//! Enum for indexing the sums of each group computed by ComputeThermoMulti
+/*! The sums of a group g are stored at g*thermo_multi_index::num_quantities. The pressure tensor sums hold the
+    kinetic part and the virial, not yet divided by the volume.
+*/
+struct thermo_multi_index
+    {
+    //! The enum
+    enum Enum
+        {
+        translational_kinetic_energy=0,     //!< Translational kinetic energy
+        rotational_kinetic_energy,          //!< Rotational kinetic energy
+        potential_energy,                   //!< Potential energy
+        pressure_xx,                        //!< xx component of the pressure tensor times the volume
+        pressure_xy,                        //!< xy component of the pressure tensor times the volume
+        pressure_xz,                        //!< xz component of the pressure tensor times the volume
+        pressure_yy,                        //!< yy component of the pressure tensor times the volume
+        pressure_yz,                        //!< yz component of the pressure tensor times the volume
+        pressure_zz,                        //!< zz component of the pressure tensor times the volume
+        num_quantities                      // final element to count number of quantities
+        };
+    };
+
 //! structure for storing the components of the pressure tensor
 struct PressureTensor
     {
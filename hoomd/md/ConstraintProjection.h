@@ -0,0 +1,126 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __CONSTRAINT_PROJECTION_H__
+#define __CONSTRAINT_PROJECTION_H__
+
+#include "hoomd/HOOMDMath.h"
+#include "EvaluatorConstraintEllipsoid.h"
+
+/*! \file ConstraintProjection.h
+    \brief Defines the projection that the integration methods apply to constrain the motion of the particles
+*/
+
+// DEVICE is __device__ when included in nvcc and blank when included into the host compiler
+#undef DEVICE
+#ifdef __HIPCC__
+#define DEVICE __device__
+#else
+#define DEVICE
+#endif
+
+//! Constrains the motion of the particles integrated by a method
+/*! The integration methods apply the projection inline while they update the particles, instead of a separate force
+    compute or updater that reads the particles again. After the position is advanced, projectPosition() moves it back
+    onto the constraint. The velocities and accelerations are projected onto the directions in which the particle
+    can move with projectVector().
+
+    The constraints are those of Enforce2DUpdater (plane), OneDConstraint (line), ConstraintSphere (sphere), and
+    ConstraintEllipsoid (ellipsoid). A sphere is an ellipsoid with equal radii here. The ellipsoid, as in
+    EvaluatorConstraintEllipsoid, needs rx >= rz and ry >= rz.
+*/
+struct ConstraintProjection
+    {
+    //! Kinds of constraints
+    enum Kind
+        {
+        none=0,     //!< The particles are not constrained
+        plane,      //!< The particles move in the xy plane
+        line,       //!< The particles move along the direction v
+        sphere,     //!< The particles move on the sphere of center P and radius v.x
+        ellipsoid   //!< The particles move on the ellipsoid of center P and radii v
+        };
+
+    Kind kind;      //!< Kind of constraint
+    Scalar3 P;      //!< Center of the sphere or ellipsoid
+    Scalar3 v;      //!< Unit direction of the line, or radii of the sphere or ellipsoid
+
+    //! Project a position onto the constraint
+    /*! \param old_pos Position at the start of the step
+        \param pos Position after the unconstrained step
+        \returns Constrained position
+    */
+    DEVICE Scalar3 projectPosition(const Scalar3& old_pos, const Scalar3& pos) const
+        {
+        switch (kind)
+            {
+            case plane:
+                return make_scalar3(pos.x, pos.y, old_pos.z);
+            case line:
+                return old_pos + dot(pos - old_pos, v) * v;
+            case sphere:
+            case ellipsoid:
+                {
+                EvaluatorConstraintEllipsoid constraint(make_scalar3(0,0,0), v.x, v.y, v.z);
+                return P + constraint.evalClosest(pos - P);
+                }
+            default:
+                return pos;
+            }
+        }
+
+    //! Project a velocity or acceleration onto the directions the particle can move in
+    /*! \param pos Constrained position of the particle
+        \param a Vector to project
+        \returns Projected vector
+    */
+    DEVICE Scalar3 projectVector(const Scalar3& pos, const Scalar3& a) const
+        {
+        switch (kind)
+            {
+            case plane:
+                return make_scalar3(a.x, a.y, 0);
+            case line:
+                return dot(a, v) * v;
+            case sphere:
+            case ellipsoid:
+                {
+                const Scalar3 r = pos - P;
+                Scalar3 n = make_scalar3(r.x/(v.x*v.x), r.y/(v.y*v.y), r.z/(v.z*v.z));
+                n = n * fast::rsqrt(dot(n,n));
+                return a - dot(a, n) * n;
+                }
+            default:
+                return a;
+            }
+        }
+
+    //! Test if the projection reads the position of the particle in projectVector()
+    DEVICE bool needsPosition() const
+        {
+        return kind == sphere || kind == ellipsoid;
+        }
+
+    //! Number of translational degrees of freedom removed from each particle
+    /*! \param ndim Number of dimensions of the system
+    */
+    unsigned int getNDOFRemoved(unsigned int ndim) const
+        {
+        switch (kind)
+            {
+            case plane:
+                return ndim == 3 ? 1 : 0;
+            case line:
+                return ndim - 1;
+            case sphere:
+            case ellipsoid:
+                return 1;
+            default:
+                return 0;
+            }
+        }
+    };
+
+#undef DEVICE
+
+#endif // __CONSTRAINT_PROJECTION_H__
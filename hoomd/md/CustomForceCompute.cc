@@ -0,0 +1,72 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "CustomForceCompute.h"
+
+#include <cstring>
+
+namespace py = pybind11;
+
+/*! \file CustomForceCompute.cc
+    \brief Contains code for the CustomForceCompute class
+*/
+
+/*! \param sysdef SystemDefinition containing the ParticleData to compute forces on
+    \param py_force Python object with a set_forces(timestep) method
+    \param aniso True when the Python code sets torques
+*/
+CustomForceCompute::CustomForceCompute(std::shared_ptr<SystemDefinition> sysdef, py::object py_force, bool aniso)
+    : ForceCompute(sysdef), m_py_force(py_force), m_aniso(aniso)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CustomForceCompute" << std::endl;
+    }
+
+CustomForceCompute::~CustomForceCompute()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying CustomForceCompute" << std::endl;
+    }
+
+/*! \param timestep Current time step
+
+    The arrays are zeroed where the Python code is going to access them, on the device in GPU simulations, so
+    set_forces may add its terms without migrating the arrays.
+*/
+void CustomForceCompute::computeForces(unsigned int timestep)
+    {
+    if (m_prof) m_prof->push("CustomForce");
+
+    #ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::overwrite);
+        ArrayHandle<Scalar4> d_torque(m_torque, access_location::device, access_mode::overwrite);
+        ArrayHandle<Scalar> d_virial(m_virial, access_location::device, access_mode::overwrite);
+        hipMemset(d_force.data, 0, sizeof(Scalar4)*m_force.getNumElements());
+        hipMemset(d_torque.data, 0, sizeof(Scalar4)*m_torque.getNumElements());
+        hipMemset(d_virial.data, 0, sizeof(Scalar)*m_virial.getNumElements());
+        }
+    else
+    #endif
+        {
+        ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_torque(m_torque, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+        memset(h_force.data, 0, sizeof(Scalar4)*m_force.getNumElements());
+        memset(h_torque.data, 0, sizeof(Scalar4)*m_torque.getNumElements());
+        memset(h_virial.data, 0, sizeof(Scalar)*m_virial.getNumElements());
+        }
+
+        {
+        pybind11::gil_scoped_acquire acquire;
+        m_py_force.attr("set_forces")(timestep);
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
+void export_CustomForceCompute(py::module& m)
+    {
+    py::class_< CustomForceCompute, ForceCompute, std::shared_ptr<CustomForceCompute> >(m, "CustomForceCompute")
+    .def(py::init< std::shared_ptr<SystemDefinition>, py::object, bool >())
+    ;
+    }
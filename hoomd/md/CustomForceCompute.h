@@ -0,0 +1,55 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/ForceCompute.h"
+
+#include <memory>
+
+/*! \file CustomForceCompute.h
+    \brief Declares a class for forces set from Python
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __CUSTOMFORCECOMPUTE_H__
+#define __CUSTOMFORCECOMPUTE_H__
+
+//! Forces computed by Python code
+/*! computeForces() zeroes the force, torque, and virial arrays and calls the set_forces method of a Python object.
+    The Python code writes the forces directly into the arrays through LocalForceComputeData, on the host or the
+    device, so the forces are not copied between Python and HOOMD.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT CustomForceCompute : public ForceCompute
+    {
+    public:
+        //! Constructs the compute
+        CustomForceCompute(std::shared_ptr<SystemDefinition> sysdef, pybind11::object py_force, bool aniso);
+
+        //! Destructor
+        virtual ~CustomForceCompute();
+
+        //! Returns true if the Python code sets torques
+        virtual bool isAnisotropic()
+            {
+            return m_aniso;
+            }
+
+    protected:
+        //! Actually compute the forces
+        virtual void computeForces(unsigned int timestep);
+
+    private:
+        pybind11::object m_py_force;    //!< Python object whose set_forces method computes the forces
+        bool m_aniso;                   //!< True when the forces include torques
+    };
+
+//! Exports the CustomForceCompute class to python
+void export_CustomForceCompute(pybind11::module& m);
+
+#endif
@@ -14,3 +14,6 @@ hipError_t gpu_compute_dlvo_forces(const pair_args_t & args,
     return gpu_compute_pair_forces<EvaluatorPairDLVO>(args,
                                                      d_params);
     }
+
+template hipError_t gpu_compute_pair_set_energy<EvaluatorPairDLVO>(const pair_set_energy_args_t& args,
+                                                                   const EvaluatorPairDLVO::param_type *d_params);
@@ -23,3 +23,5 @@ hipError_t gpu_compute_dpdljthermo_forces(const pair_args_t& args,
                                                              d_params);
     }
 
+template hipError_t gpu_compute_pair_set_energy<EvaluatorPairDPDLJThermo>(const pair_set_energy_args_t& args,
+    const EvaluatorPairDPDLJThermo::param_type *d_params);
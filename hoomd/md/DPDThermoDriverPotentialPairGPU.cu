@@ -24,4 +24,5 @@ hipError_t gpu_compute_dpdthermo_forces(const pair_args_t& pair_args,
                                                            d_params);
     }
 
-
+template hipError_t gpu_compute_pair_set_energy<EvaluatorPairDPDThermo>(const pair_set_energy_args_t& args,
+    const EvaluatorPairDPDThermo::param_type *d_params);
@@ -103,6 +103,11 @@ class EvaluatorExternalElectricField
             {
             return std::string("e_field");
             }
+
+        //! The field does not depend on the parameters or the box
+        static void updateField(field_type& field, const param_type *params, unsigned int ntypes, const BoxDim& box)
+            {
+            }
         #endif
 
     protected:
@@ -155,6 +155,11 @@ class EvaluatorExternalPeriodic
             {
             return std::string("periodic");
             }
+
+        //! The field does not depend on the parameters or the box
+        static void updateField(field_type& field, const param_type *params, unsigned int ntypes, const BoxDim& box)
+            {
+            }
         #endif
 
     protected:
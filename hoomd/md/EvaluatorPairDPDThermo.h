@@ -269,6 +269,52 @@ class EvaluatorPairDPDThermo
             }
 
         #ifndef __HIPCC__
+        //! Evaluate the force and energy for a batch of pairs
+        /*! \param n Number of pairs in the batch
+            \param rsq Squared distance between the particles of each pair
+            \param rcutsq Squared cutoff radius of each pair
+            \param params Per type pair parameters
+            \param typpair Index into \a params for each pair
+            \param energy_shift Ignored. DPD always goes to 0 at the cutoff.
+            \param force_divr Output array for the computed force divided by r
+            \param pair_eng Output array for the computed pair energy
+            \param evaluated Output array set to true for pairs that are evaluated
+
+            The loop body has no branches so that the host compiler can vectorize it. Each pair gives the same
+            result as evalForceAndEnergy(), which evaluates the conservative force only.
+        */
+        static void evalForceAndEnergyBatch(unsigned int n,
+                                            const Scalar *rsq,
+                                            const Scalar *rcutsq,
+                                            const param_type *params,
+                                            const unsigned int *typpair,
+                                            const bool *energy_shift,
+                                            Scalar *force_divr,
+                                            Scalar *pair_eng,
+                                            bool *evaluated)
+            {
+            for (unsigned int k = 0; k < n; k++)
+                {
+                const Scalar a = params[typpair[k]].A;
+                const bool in_range = rsq[k] < rcutsq[k];
+
+                // substitute a harmless distance for pairs that are not evaluated
+                Scalar rsq_k = in_range ? rsq[k] : Scalar(1.0);
+                Scalar rcutsq_k = in_range ? rcutsq[k] : Scalar(1.0);
+                Scalar rinv = fast::rsqrt(rsq_k);
+                Scalar r = Scalar(1.0) / rinv;
+                Scalar rcutinv = fast::rsqrt(rcutsq_k);
+                Scalar rcut = Scalar(1.0) / rcutinv;
+
+                Scalar f = a*(rinv - rcutinv);
+                Scalar e = a * (rcut - r) - Scalar(1.0/2.0) * a * rcutinv * (rcutsq_k - rsq_k);
+
+                force_divr[k] = in_range ? f : Scalar(0.0);
+                pair_eng[k] = in_range ? e : Scalar(0.0);
+                evaluated[k] = in_range;
+                }
+            }
+
         //! Get the name of this potential
         /*! \returns The potential name. Must be short and all lowercase, as this is the name energies will be logged as
             via analyze.log.
@@ -82,7 +82,7 @@ class EvaluatorPairDipole
             \param _params Per type pair parameters of this potential
         */
         HOSTDEVICE EvaluatorPairDipole(Scalar3& _dr, Scalar4& _quat_i, Scalar4& _quat_j, Scalar _rcutsq, const param_type& _params)
-            :dr(_dr), rcutsq(_rcutsq), quat_i(_quat_i), quat_j(_quat_j), params(_params)
+            :dr(_dr), rcutsq(_rcutsq), quat_i(_quat_i), quat_j(_quat_j), params(_params), have_axes(false)
             {
             }
 
@@ -138,6 +138,31 @@ class EvaluatorPairDipole
             q_j = qj;
             }
 
+        //! The potential uses the dipole direction of the particles in the space frame
+        HOSTDEVICE static bool needsBodyAxis()
+            {
+            return true;
+            }
+
+        //! Get the dipole direction of the particles in the body frame
+        HOSTDEVICE static vec3<Scalar> getBodyAxis()
+            {
+            return vec3<Scalar>(1, 0, 0);
+            }
+
+        //! Accept the optional dipole directions in the space frame
+        /*! \param ai getBodyAxis() rotated by the orientation of particle i
+            \param aj getBodyAxis() rotated by the orientation of particle j
+
+            Without them, evaluate() rotates the dipoles from the quaternions.
+        */
+        HOSTDEVICE void setBodyAxes(const Scalar3& ai, const Scalar3& aj)
+            {
+            axis_i = vec3<Scalar>(ai);
+            axis_j = vec3<Scalar>(aj);
+            have_axes = true;
+            }
+
         //! Evaluate the force and energy
         /*! \param force Output parameter to write the computed force.
             \param pair_eng Output parameter to write the computed pair energy.
@@ -161,8 +186,10 @@ class EvaluatorPairDipole
             Scalar r5inv = r3inv*r2inv;
 
             // convert dipole vector in the body frame of each particle to space frame
-            vec3<Scalar> p_i = rotate(quat<Scalar>(quat_i), vec3<Scalar>(params.mu, 0, 0));
-            vec3<Scalar> p_j = rotate(quat<Scalar>(quat_j), vec3<Scalar>(params.mu, 0, 0));
+            vec3<Scalar> p_i = have_axes ? params.mu*axis_i
+                                         : rotate(quat<Scalar>(quat_i), vec3<Scalar>(params.mu, 0, 0));
+            vec3<Scalar> p_j = have_axes ? params.mu*axis_j
+                                         : rotate(quat<Scalar>(quat_j), vec3<Scalar>(params.mu, 0, 0));
 
             vec3<Scalar> f;
             vec3<Scalar> t_i;
@@ -263,6 +290,9 @@ class EvaluatorPairDipole
         Scalar q_i, q_j;            //!< Stored particle charges
         Scalar4 quat_i,quat_j;      //!< Stored quaternion of ith and jth particle from constructor
         const param_type &params;   //!< The pair potential parameters
+        vec3<Scalar> axis_i;        //!< Dipole direction of particle i in the space frame
+        vec3<Scalar> axis_j;        //!< Dipole direction of particle j in the space frame
+        bool have_axes;             //!< True when setBodyAxes() provided the directions
     };
 
 //! Function to make the dipole parameter type
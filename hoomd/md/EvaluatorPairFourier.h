@@ -162,8 +162,10 @@ class EvaluatorPairFourier
                 Scalar b1 = 0;
                 for (int i=2; i<5; i++)
                     {
-                    a1 = a1 + fast::pow(Scalar(-1),Scalar(i)) * params.a[i-2];
-                    b1 = b1 + i * fast::pow(Scalar(-1),Scalar(i)) * params.b[i-2];
+                    // (-1)^i without pow()
+                    Scalar sign = (i % 2 == 0) ? Scalar(1) : Scalar(-1);
+                    a1 = a1 + sign * params.a[i-2];
+                    b1 = b1 + i * sign * params.b[i-2];
                     }
                 Scalar theta = x;
                 Scalar s;
@@ -90,7 +90,7 @@ class EvaluatorPairGB
                                const Scalar _rcutsq,
                                const param_type& _params)
             : dr(_dr),rcutsq(_rcutsq),qi(_qi),qj(_qj),
-              params(_params)
+              params(_params), have_axes(false)
             {
             }
 
@@ -142,6 +142,31 @@ class EvaluatorPairGB
         */
         HOSTDEVICE void setCharge(Scalar qi, Scalar qj){}
 
+        //! The potential uses the long axis of the particles in the space frame
+        HOSTDEVICE static bool needsBodyAxis()
+            {
+            return true;
+            }
+
+        //! Get the long axis of the particles in the body frame
+        HOSTDEVICE static vec3<Scalar> getBodyAxis()
+            {
+            return vec3<Scalar>(0, 0, 1);
+            }
+
+        //! Accept the optional long axes in the space frame
+        /*! \param ai getBodyAxis() rotated by the orientation of particle i
+            \param aj getBodyAxis() rotated by the orientation of particle j
+
+            Without them, evaluate() rotates the axes from the quaternions.
+        */
+        HOSTDEVICE void setBodyAxes(const Scalar3& ai, const Scalar3& aj)
+            {
+            axis_i = vec3<Scalar>(ai);
+            axis_j = vec3<Scalar>(aj);
+            have_axes = true;
+            }
+
         //! Evaluate the force and energy
         /*! \param force Output parameter to write the computed force.
             \param pair_eng Output parameter to write the computed pair energy.
@@ -157,13 +182,9 @@ class EvaluatorPairGB
             Scalar r = fast::sqrt(rsq);
             vec3<Scalar> unitr = fast::rsqrt(dot(dr,dr))*dr;
 
-            // obtain rotation matrices (space->body)
-            rotmat3<Scalar> rotA(conj(qi));
-            rotmat3<Scalar> rotB(conj(qj));
-
-            // last row of rotation matrix
-            vec3<Scalar> a3 = rotA.row2;
-            vec3<Scalar> b3 = rotB.row2;
+            // last row of the rotation matrices (space->body)
+            vec3<Scalar> a3 = have_axes ? axis_i : rotmat3<Scalar>(conj(qi)).row2;
+            vec3<Scalar> b3 = have_axes ? axis_j : rotmat3<Scalar>(conj(qj)).row2;
 
             Scalar ca = dot(a3,unitr);
             Scalar cb = dot(b3,unitr);
@@ -255,6 +276,9 @@ class EvaluatorPairGB
         quat<Scalar> qi;   //!< Orientation quaternion for particle i
         quat<Scalar> qj;   //!< Orientation quaternion for particle j
         const param_type &params;  //!< The pair potential parameters
+        vec3<Scalar> axis_i;       //!< Long axis of particle i in the space frame
+        vec3<Scalar> axis_j;       //!< Long axis of particle j in the space frame
+        bool have_axes;            //!< True when setBodyAxes() provided the axes
     };
 
 //! Function to make the Gay-Berne parameter type
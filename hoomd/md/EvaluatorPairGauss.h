@@ -12,6 +12,7 @@
 #endif
 
 #include "hoomd/HOOMDMath.h"
+#include "MDPrecisionSetup.h"
 
 /*! \file EvaluatorPairGauss.h
     \brief Defines the pair evaluator class for Gaussian potentials
@@ -150,7 +151,88 @@ class EvaluatorPairGauss
                 return false;
             }
 
+        //! Evaluate the force and energy in reduced precision
+        /*! \param force_divr Output parameter to write the computed force divided by r.
+            \param pair_eng Output parameter to write the computed pair energy
+            \param energy_shift If true, the potential must be shifted so that
+            V(r) is continuous at the cutoff
+
+            Same as evalForceAndEnergy(), but computed in PairReal. GPU pair kernels call this method when built with
+            ENABLE_MD_MIXED_PRECISION.
+
+            \return True if they are evaluated or false if they are not because
+            we are beyond the cutoff
+        */
+        DEVICE bool evalForceAndEnergyMixed(PairReal& force_divr, PairReal& pair_eng, bool energy_shift)
+            {
+            // compute the force divided by r in force_divr
+            if (rsq < rcutsq)
+                {
+                PairReal epsilonr = PairReal(epsilon);
+                PairReal sigma_sq = PairReal(sigma*sigma);
+                PairReal r_over_sigma_sq = PairReal(rsq) / sigma_sq;
+                PairReal exp_val = fast::exp(-PairReal(1.0)/PairReal(2.0) * r_over_sigma_sq);
+
+                force_divr = epsilonr / sigma_sq * exp_val;
+                pair_eng = epsilonr * exp_val;
+
+                if (energy_shift)
+                    {
+                    pair_eng -= epsilonr * fast::exp(-PairReal(1.0)/PairReal(2.0) * PairReal(rcutsq) / sigma_sq);
+                    }
+                return true;
+                }
+            else
+                return false;
+            }
+
         #ifndef __HIPCC__
+        //! Evaluate the force and energy for a batch of pairs
+        /*! \param n Number of pairs in the batch
+            \param rsq Squared distance between the particles of each pair
+            \param rcutsq Squared cutoff radius of each pair
+            \param params Per type pair parameters
+            \param typpair Index into \a params for each pair
+            \param energy_shift Whether to shift the energy of each pair so that V(r) is continuous at the cutoff
+            \param force_divr Output array for the computed force divided by r
+            \param pair_eng Output array for the computed pair energy
+            \param evaluated Output array set to true for pairs that are evaluated
+
+            The loop body has no branches so that the host compiler can vectorize it. Each pair gives the same
+            result as evalForceAndEnergy().
+        */
+        static void evalForceAndEnergyBatch(unsigned int n,
+                                            const Scalar *rsq,
+                                            const Scalar *rcutsq,
+                                            const param_type *params,
+                                            const unsigned int *typpair,
+                                            const bool *energy_shift,
+                                            Scalar *force_divr,
+                                            Scalar *pair_eng,
+                                            bool *evaluated)
+            {
+            for (unsigned int k = 0; k < n; k++)
+                {
+                const Scalar epsilon = params[typpair[k]].epsilon;
+                const Scalar sigma = params[typpair[k]].sigma;
+                const bool in_range = rsq[k] < rcutsq[k];
+
+                // substitute a harmless width for pairs that are not evaluated
+                Scalar sigma_sq = in_range ? sigma*sigma : Scalar(1.0);
+                Scalar r_over_sigma_sq = rsq[k] / sigma_sq;
+                Scalar exp_val = fast::exp(-Scalar(1.0)/Scalar(2.0) * r_over_sigma_sq);
+
+                Scalar f = epsilon / sigma_sq * exp_val;
+                Scalar e = epsilon * exp_val;
+                Scalar e_cut = energy_shift[k] ? epsilon * fast::exp(-Scalar(1.0)/Scalar(2.0) * rcutsq[k] / sigma_sq)
+                                               : Scalar(0.0);
+
+                force_divr[k] = in_range ? f : Scalar(0.0);
+                pair_eng[k] = in_range ? e - e_cut : Scalar(0.0);
+                evaluated[k] = in_range;
+                }
+            }
+
         //! Get the name of this potential
         /*! \returns The potential name. Must be short and all lowercase, as this is the name energies will be logged as
             via analyze.log.
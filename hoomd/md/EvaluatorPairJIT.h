@@ -0,0 +1,217 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __PAIR_EVALUATOR_JIT_H__
+#define __PAIR_EVALUATOR_JIT_H__
+
+#ifndef __HIPCC__
+#include <string>
+#endif
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file EvaluatorPairJIT.h
+    \brief Defines the pair evaluator class for pair potentials given as run time compiled code
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// DEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#ifdef __HIPCC__
+#define DEVICE __device__
+#else
+#define DEVICE
+#endif
+
+//! Number of parameters of a JIT pair potential per type pair
+const unsigned int jit_pair_num_params = 8;
+
+//! Signature of the JIT compiled pair function
+/*! \param rsq Squared distance between the particles
+    \param d_i Diameter of particle i
+    \param d_j Diameter of particle j
+    \param q_i Charge of particle i
+    \param q_j Charge of particle j
+    \param param Parameters of the type pair
+    \param force_divr Output parameter to write the computed force divided by r
+    \param pair_eng Output parameter to write the computed pair energy
+*/
+typedef void (*PairJITEvalFnPtr)(Scalar rsq,
+                                 Scalar d_i,
+                                 Scalar d_j,
+                                 Scalar q_i,
+                                 Scalar q_j,
+                                 const Scalar *param,
+                                 Scalar& force_divr,
+                                 Scalar& pair_eng);
+
+//! Class for evaluating pair potentials that are compiled at run time
+/*! <b>General Overview</b>
+
+    See EvaluatorPairLJ
+
+    <b>JIT specifics</b>
+
+    The user supplies the body of a function `eval` with the signature of PairJITEvalFnPtr that computes V(r) and
+    -(1/r) dV/dr at \a rsq < \a rcutsq. The cutoff test and the energy shift are applied here, and the smoothing by
+    PotentialPair, so all shift modes work as they do for the built-in potentials.
+
+    On the CPU, PotentialPairJIT compiles the function with LLVM and stores the pointer to it in \a param_type. On the
+    GPU, the same code is compiled with NVRTC together with gpu_compute_pair_forces_shared_kernel() and the evaluator
+    calls the device function `eval` directly, declared in PotentialPairGPUJIT.inc. This header therefore can not be
+    compiled by nvcc outside of a JIT module.
+
+    The \a param array holds jit_pair_num_params values per type pair.
+*/
+class EvaluatorPairJIT
+    {
+    public:
+        //! Define the parameter type used by this pair potential evaluator
+        struct param_type
+            {
+            Scalar param[jit_pair_num_params];  //!< User parameters
+            PairJITEvalFnPtr eval_fn;           //!< Function compiled by LLVM, only used on the host
+
+            #ifdef ENABLE_HIP
+            //! set CUDA memory hint
+            void set_memory_hint() const {}
+            #endif
+
+            #ifndef __HIPCC__
+            param_type() : eval_fn(NULL)
+                {
+                for (unsigned int i = 0; i < jit_pair_num_params; i++)
+                    param[i] = 0.0;
+                }
+
+            param_type(pybind11::dict v) : eval_fn(NULL)
+                {
+                pybind11::list py_param(v["param"]);
+                if (pybind11::len(py_param) > jit_pair_num_params)
+                    throw std::runtime_error("JIT pair potentials take at most "
+                                             + std::to_string(jit_pair_num_params) + " parameters.");
+
+                for (unsigned int i = 0; i < jit_pair_num_params; i++)
+                    param[i] = i < pybind11::len(py_param) ? pybind11::cast<Scalar>(py_param[i]) : Scalar(0.0);
+                }
+
+            pybind11::dict asDict()
+                {
+                pybind11::dict v;
+                pybind11::list py_param;
+
+                for (unsigned int i = 0; i < jit_pair_num_params; i++)
+                    py_param.append(param[i]);
+
+                v["param"] = py_param;
+                return v;
+                }
+            #endif
+            }
+            #ifdef SINGLE_PRECISION
+            __attribute__((aligned(8)));
+            #else
+            __attribute__((aligned(16)));
+            #endif
+
+        //! Constructs the pair potential evaluator
+        /*! \param _rsq Squared distance between the particles
+            \param _rcutsq Squared distance at which the potential goes to 0
+            \param _params Per type pair parameters of this potential
+        */
+        DEVICE EvaluatorPairJIT(Scalar _rsq, Scalar _rcutsq, const param_type& _params)
+            : rsq(_rsq), rcutsq(_rcutsq), params(_params), di(0), dj(0), qi(0), qj(0)
+            {
+            }
+
+        //! The user code may use the diameter
+        DEVICE static bool needsDiameter() { return true; }
+        //! Accept the optional diameter values
+        /*! \param _di Diameter of particle i
+            \param _dj Diameter of particle j
+        */
+        DEVICE void setDiameter(Scalar _di, Scalar _dj)
+            {
+            di = _di;
+            dj = _dj;
+            }
+
+        //! The user code may use the charge
+        DEVICE static bool needsCharge() { return true; }
+        //! Accept the optional charge values
+        /*! \param _qi Charge of particle i
+            \param _qj Charge of particle j
+        */
+        DEVICE void setCharge(Scalar _qi, Scalar _qj)
+            {
+            qi = _qi;
+            qj = _qj;
+            }
+
+        //! Evaluate the force and energy
+        /*! \param force_divr Output parameter to write the computed force divided by r.
+            \param pair_eng Output parameter to write the computed pair energy
+            \param energy_shift If true, the potential must be shifted so that V(r) is continuous at the cutoff
+
+            \return True if they are evaluated or false if they are not because we are beyond the cutoff
+        */
+        DEVICE bool evalForceAndEnergy(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+            {
+            if (rsq < rcutsq)
+                {
+                callEval(rsq, force_divr, pair_eng);
+
+                if (energy_shift)
+                    {
+                    Scalar force_divr_cut = Scalar(0.0);
+                    Scalar pair_eng_cut = Scalar(0.0);
+                    callEval(rcutsq, force_divr_cut, pair_eng_cut);
+                    pair_eng -= pair_eng_cut;
+                    }
+                return true;
+                }
+            else
+                return false;
+            }
+
+        #ifndef __HIPCC__
+        //! Get the name of this potential
+        /*! \returns The potential name. Must be short and all lowercase, as this is the name energies will be logged as
+            via analyze.log.
+        */
+        static std::string getName()
+            {
+            return std::string("jit");
+            }
+
+        std::string getShapeSpec() const
+            {
+            throw std::runtime_error("Shape definition not supported for this pair potential.");
+            }
+        #endif
+
+    protected:
+        //! Call the user function at the squared distance \a r_sq
+        DEVICE void callEval(Scalar r_sq, Scalar& force_divr, Scalar& pair_eng)
+            {
+            force_divr = Scalar(0.0);
+            pair_eng = Scalar(0.0);
+            #ifdef __HIP_DEVICE_COMPILE__
+            eval(r_sq, di, dj, qi, qj, params.param, force_divr, pair_eng);
+            #else
+            if (params.eval_fn)
+                params.eval_fn(r_sq, di, dj, qi, qj, params.param, force_divr, pair_eng);
+            #endif
+            }
+
+        Scalar rsq;                 //!< Stored rsq from the constructor
+        Scalar rcutsq;              //!< Stored rcutsq from the constructor
+        const param_type& params;   //!< Parameters of the type pair
+        Scalar di;                  //!< Diameter of particle i
+        Scalar dj;                  //!< Diameter of particle j
+        Scalar qi;                  //!< Charge of particle i
+        Scalar qj;                  //!< Charge of particle j
+    };
+
+#undef DEVICE
+
+#endif // __PAIR_EVALUATOR_JIT_H__
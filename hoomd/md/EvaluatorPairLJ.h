@@ -12,6 +12,7 @@
 #endif
 
 #include "hoomd/HOOMDMath.h"
+#include "MDPrecisionSetup.h"
 
 /*! \file EvaluatorPairLJ.h
     \brief Defines the pair evaluator class for LJ potentials
@@ -206,7 +207,90 @@ class EvaluatorPairLJ
                 return false;
             }
 
+        //! Evaluate the force and energy in reduced precision
+        /*! \param force_divr Output parameter to write the computed force divided by r.
+            \param pair_eng Output parameter to write the computed pair energy
+            \param energy_shift If true, the potential must be shifted so that
+            V(r) is continuous at the cutoff
+
+            Same as evalForceAndEnergy(), but computed in PairReal. GPU pair kernels call this method when built with
+            ENABLE_MD_MIXED_PRECISION.
+
+            \return True if they are evaluated or false if they are not because
+            we are beyond the cutoff
+        */
+        DEVICE bool evalForceAndEnergyMixed(PairReal& force_divr, PairReal& pair_eng, bool energy_shift)
+            {
+            // compute the force divided by r in force_divr
+            if (rsq < rcutsq && lj1 != 0)
+                {
+                PairReal lj1r = PairReal(lj1);
+                PairReal lj2r = PairReal(lj2);
+                PairReal r2inv = PairReal(1.0)/PairReal(rsq);
+                PairReal r6inv = r2inv * r2inv * r2inv;
+                force_divr= r2inv * r6inv * (PairReal(12.0)*lj1r*r6inv - PairReal(6.0)*lj2r);
+
+                pair_eng = r6inv * (lj1r*r6inv - lj2r);
+
+                if (energy_shift)
+                    {
+                    PairReal rcut2inv = PairReal(1.0)/PairReal(rcutsq);
+                    PairReal rcut6inv = rcut2inv * rcut2inv * rcut2inv;
+                    pair_eng -= rcut6inv * (lj1r*rcut6inv - lj2r);
+                    }
+                return true;
+                }
+            else
+                return false;
+            }
+
         #ifndef __HIPCC__
+        //! Evaluate the force and energy for a batch of pairs
+        /*! \param n Number of pairs in the batch
+            \param rsq Squared distance between the particles of each pair
+            \param rcutsq Squared cutoff radius of each pair
+            \param params Per type pair parameters
+            \param typpair Index into \a params for each pair
+            \param energy_shift Whether to shift the energy of each pair so that V(r) is continuous at the cutoff
+            \param force_divr Output array for the computed force divided by r
+            \param pair_eng Output array for the computed pair energy
+            \param evaluated Output array set to true for pairs that are evaluated
+
+            The loop body has no branches so that the host compiler can vectorize it. Each pair gives the same
+            result as evalForceAndEnergy().
+        */
+        static void evalForceAndEnergyBatch(unsigned int n,
+                                            const Scalar *rsq,
+                                            const Scalar *rcutsq,
+                                            const param_type *params,
+                                            const unsigned int *typpair,
+                                            const bool *energy_shift,
+                                            Scalar *force_divr,
+                                            Scalar *pair_eng,
+                                            bool *evaluated)
+            {
+            for (unsigned int k = 0; k < n; k++)
+                {
+                const Scalar lj1 = params[typpair[k]].lj1;
+                const Scalar lj2 = params[typpair[k]].lj2;
+                const bool in_range = rsq[k] < rcutsq[k] && lj1 != 0;
+
+                // substitute a harmless distance for pairs that are not evaluated
+                Scalar r2inv = Scalar(1.0)/(in_range ? rsq[k] : Scalar(1.0));
+                Scalar r6inv = r2inv * r2inv * r2inv;
+                Scalar rcut2inv = Scalar(1.0)/(in_range ? rcutsq[k] : Scalar(1.0));
+                Scalar rcut6inv = rcut2inv * rcut2inv * rcut2inv;
+
+                Scalar f = r2inv * r6inv * (Scalar(12.0)*lj1*r6inv - Scalar(6.0)*lj2);
+                Scalar e = r6inv * (lj1*r6inv - lj2);
+                Scalar e_cut = energy_shift[k] ? rcut6inv * (lj1*rcut6inv - lj2) : Scalar(0.0);
+
+                force_divr[k] = in_range ? f : Scalar(0.0);
+                pair_eng[k] = in_range ? e - e_cut : Scalar(0.0);
+                evaluated[k] = in_range;
+                }
+            }
+
         //! Get the name of this potential
         /*! \returns The potential name. Must be short and all lowercase, as this is the name energies will be logged as
             via analyze.log.
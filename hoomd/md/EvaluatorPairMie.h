@@ -8,6 +8,7 @@
 #define __PAIR_EVALUATOR_MIE_H__
 
 #ifndef __HIPCC__
+#include <cmath>
 #include <string>
 #endif
 
@@ -47,10 +48,16 @@
     - \a mie3 = n
     - \a mie4 = m
 
+    When n and m are integers up to max_int_exponent, as in the common 9-6 or 12-4 forms, the powers of r are computed
+    with multiplications (by squaring) instead of pow(). param_type holds the integer exponents, or 0 when an exponent
+    is not an integer in that range.
 */
 class EvaluatorPairMie
     {
     public:
+        //! Largest exponent that is evaluated with multiplications
+        static const unsigned int max_int_exponent = 64;
+
         //! Define the parameter type used by this pair potential evaluator
         struct param_type
             {
@@ -58,6 +65,8 @@ class EvaluatorPairMie
             Scalar m2;
             Scalar m3;
             Scalar m4;
+            unsigned int n_int;     //!< n as an integer, 0 if pow() is needed
+            unsigned int m_int;     //!< m as an integer, 0 if pow() is needed
 
             #ifdef ENABLE_HIP
             // set CUDA memory hints
@@ -65,7 +74,7 @@ class EvaluatorPairMie
             #endif
 
             #ifndef __HIPCC__
-            param_type() : m1(0), m2(0), m3(0), m4(0) {}
+            param_type() : m1(0), m2(0), m3(0), m4(0), n_int(0), m_int(0) {}
 
             param_type(pybind11::dict v)
                 {
@@ -78,6 +87,8 @@ class EvaluatorPairMie
                 Scalar outFront = (m3/(m3-m4)) * pow(m3/m4, m4/(m3-m4));
                 m1 = outFront * epsilon * pow(sigma, m3);
                 m2 = outFront * epsilon * pow(sigma, m4);
+                n_int = toIntExponent(m3);
+                m_int = toIntExponent(m4);
                 }
 
             pybind11::dict asDict()
@@ -94,6 +105,15 @@ class EvaluatorPairMie
 
                 return v;
                 }
+
+            //! Get the integer value of an exponent, or 0 if it must be evaluated with pow()
+            static unsigned int toIntExponent(Scalar exponent)
+                {
+                if (exponent >= Scalar(1.0) && exponent <= Scalar(max_int_exponent)
+                    && exponent == std::floor(exponent))
+                    return (unsigned int)exponent;
+                return 0;
+                }
             #endif
             }
             __attribute__((aligned(16)));
@@ -106,7 +126,8 @@ class EvaluatorPairMie
             \param _params Per type pair parameters of this potential
         */
         DEVICE EvaluatorPairMie(Scalar _rsq, Scalar _rcutsq,  const param_type& _params)
-            : rsq(_rsq), rcutsq(_rcutsq), mie1(_params.m1), mie2(_params.m2), mie3(_params.m3), mie4(_params.m4)
+            : rsq(_rsq), rcutsq(_rcutsq), mie1(_params.m1), mie2(_params.m2), mie3(_params.m3), mie4(_params.m4),
+              n_int(_params.n_int), m_int(_params.m_int)
             {
             }
 
@@ -141,16 +162,17 @@ class EvaluatorPairMie
             if (rsq < rcutsq && mie1 != 0)
                 {
                 Scalar r2inv = Scalar(1.0)/rsq;
-                Scalar rninv = pow(r2inv,mie3/Scalar(2.0));
-                Scalar rminv = pow(r2inv,mie4/Scalar(2.0));
+                Scalar rninv = powInv(r2inv, mie3, n_int);
+                Scalar rminv = powInv(r2inv, mie4, m_int);
                 force_divr= r2inv * (mie3 * mie1 * rninv - mie4 * mie2 * rminv);
 
                 pair_eng = mie1 * rninv - mie2 * rminv;
 
                 if (energy_shift)
                     {
-                    Scalar rcutninv = Scalar(1.0)/pow(rcutsq,mie3/Scalar(2.0));
-                    Scalar rcutminv = Scalar(1.0)/pow(rcutsq,mie4/Scalar(2.0));
+                    Scalar rcut2inv = Scalar(1.0)/rcutsq;
+                    Scalar rcutninv = powInv(rcut2inv, mie3, n_int);
+                    Scalar rcutminv = powInv(rcut2inv, mie4, m_int);
                     pair_eng -= mie1 * rcutninv - mie2* rcutminv;
                     }
                 return true;
@@ -182,6 +204,40 @@ class EvaluatorPairMie
         Scalar mie2;     //!< mie2 parameter extracted from the params passed to the constructor
         Scalar mie3;     //!< mie3 parameter extracted from the params passed to the constructor
         Scalar mie4;     //!< mie4 parameter extracted from the params passed to the constructor
+        unsigned int n_int; //!< n as an integer, 0 if pow() is needed
+        unsigned int m_int; //!< m as an integer, 0 if pow() is needed
+
+        //! Compute r^-n from r^-2
+        /*! \param r2inv 1/r^2
+            \param n Exponent
+            \param n_int Exponent as an integer, 0 to use pow()
+            \returns 1/r^n
+        */
+        DEVICE static Scalar powInv(Scalar r2inv, Scalar n, unsigned int n_int)
+            {
+            if (n_int == 0)
+                return pow(r2inv, n/Scalar(2.0));
+
+            // even exponents are powers of r^-2, odd ones of r^-1
+            Scalar base = r2inv;
+            unsigned int e = n_int/2;
+            if (n_int & 1)
+                {
+                base = fast::sqrt(r2inv);
+                e = n_int;
+                }
+
+            // exponentiation by squaring
+            Scalar result = Scalar(1.0);
+            while (e)
+                {
+                if (e & 1)
+                    result *= base;
+                base *= base;
+                e >>= 1;
+                }
+            return result;
+            }
     };
 
 
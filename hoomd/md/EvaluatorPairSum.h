@@ -0,0 +1,169 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __PAIR_EVALUATOR_SUM_H__
+#define __PAIR_EVALUATOR_SUM_H__
+
+#ifndef __HIPCC__
+#include <string>
+#include <stdexcept>
+#endif
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file EvaluatorPairSum.h
+    \brief Defines the pair evaluator that sums two other pair evaluators
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// DEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#ifdef __HIPCC__
+#define DEVICE __device__
+#else
+#define DEVICE
+#endif
+
+//! Class for evaluating the sum of two pair potentials
+/*! <b>General Overview</b>
+
+    See EvaluatorPairLJ
+
+    <b>Sum specifics</b>
+
+    EvaluatorPairSum evaluates \f$ V(r) = V_1(r) + V_2(r) \f$ where \a First and \a Second are pair evaluators.
+    PotentialPair and PotentialPairGPU apply it like any other evaluator, so a system that needs both potentials
+    traverses the neighbor list once and writes the force array once per step instead of once per potential. Nest
+    EvaluatorPairSum in \a Second to combine more than two potentials.
+
+    The parameters of both evaluators are stored side by side for each type pair. From python, they are set with a
+    dictionary that holds the parameter dictionary of each component under the component's name, for example
+    `{"lj": {"epsilon": 1.0, "sigma": 1.0}, "yukawa": {"epsilon": 1.0, "kappa": 1.0}}`. Both components share the
+    cutoff radius and energy shift mode of the pair force. A component with all-zero parameters does not contribute.
+*/
+template<class First, class Second>
+class EvaluatorPairSum
+    {
+    public:
+        //! Define the parameter type used by this pair potential evaluator
+        struct param_type
+            {
+            typename First::param_type first;     //!< Parameters of the first potential
+            typename Second::param_type second;   //!< Parameters of the second potential
+
+            #ifdef ENABLE_HIP
+            //set CUDA memory hints
+            void set_memory_hint() const
+                {
+                first.set_memory_hint();
+                second.set_memory_hint();
+                }
+            #endif
+
+            #ifndef __HIPCC__
+            param_type() { }
+
+            param_type(pybind11::dict v)
+                : first(v[First::getName().c_str()].template cast<pybind11::dict>()),
+                  second(v[Second::getName().c_str()].template cast<pybind11::dict>())
+                {
+                }
+
+            // this constructor facilitates unit testing
+            param_type(const typename First::param_type& _first, const typename Second::param_type& _second)
+                : first(_first), second(_second)
+                {
+                }
+
+            pybind11::dict asDict()
+                {
+                pybind11::dict v;
+                v[First::getName().c_str()] = first.asDict();
+                v[Second::getName().c_str()] = second.asDict();
+                return v;
+                }
+            #endif
+            };
+
+        //! Constructs the pair potential evaluator
+        /*! \param _rsq Squared distance between the particles
+            \param _rcutsq Squared distance at which the potential goes to 0
+            \param _params Per type pair parameters of this potential
+        */
+        DEVICE EvaluatorPairSum(Scalar _rsq, Scalar _rcutsq, const param_type& _params)
+            : first(_rsq, _rcutsq, _params.first), second(_rsq, _rcutsq, _params.second)
+            {
+            }
+
+        //! Diameter is needed when either potential uses it
+        DEVICE static bool needsDiameter() { return First::needsDiameter() || Second::needsDiameter(); }
+        //! Accept the optional diameter values
+        /*! \param di Diameter of particle i
+            \param dj Diameter of particle j
+        */
+        DEVICE void setDiameter(Scalar di, Scalar dj)
+            {
+            first.setDiameter(di, dj);
+            second.setDiameter(di, dj);
+            }
+
+        //! Charge is needed when either potential uses it
+        DEVICE static bool needsCharge() { return First::needsCharge() || Second::needsCharge(); }
+        //! Accept the optional charge values
+        /*! \param qi Charge of particle i
+            \param qj Charge of particle j
+        */
+        DEVICE void setCharge(Scalar qi, Scalar qj)
+            {
+            first.setCharge(qi, qj);
+            second.setCharge(qi, qj);
+            }
+
+        //! Evaluate the force and energy
+        /*! \param force_divr Output parameter to write the computed force divided by r.
+            \param pair_eng Output parameter to write the computed pair energy
+            \param energy_shift If true, the potential must be shifted so that V(r) is continuous at the cutoff
+            \note There is no need to check if rsq < rcutsq in this method. Cutoff tests are performed
+                  in PotentialPair.
+
+            \return True if either potential is evaluated
+        */
+        DEVICE bool evalForceAndEnergy(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+            {
+            Scalar force_divr_first = Scalar(0.0);
+            Scalar pair_eng_first = Scalar(0.0);
+            Scalar force_divr_second = Scalar(0.0);
+            Scalar pair_eng_second = Scalar(0.0);
+
+            bool evaluated_first = first.evalForceAndEnergy(force_divr_first, pair_eng_first, energy_shift);
+            bool evaluated_second = second.evalForceAndEnergy(force_divr_second, pair_eng_second, energy_shift);
+
+            if (!evaluated_first && !evaluated_second)
+                return false;
+
+            force_divr = force_divr_first + force_divr_second;
+            pair_eng = pair_eng_first + pair_eng_second;
+            return true;
+            }
+
+        #ifndef __HIPCC__
+        //! Get the name of this potential
+        /*! \returns The potential name. Must be short and all lowercase, as this is the name energies will be logged as
+            via analyze.log.
+        */
+        static std::string getName()
+            {
+            return First::getName() + std::string("_") + Second::getName();
+            }
+
+        std::string getShapeSpec() const
+            {
+            throw std::runtime_error("Shape definition not supported for this pair potential.");
+            }
+        #endif
+
+    protected:
+        First first;    //!< Evaluator of the first potential
+        Second second;  //!< Evaluator of the second potential
+    };
+
+#endif // __PAIR_EVALUATOR_SUM_H__
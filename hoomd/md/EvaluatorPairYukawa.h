@@ -12,6 +12,7 @@
 #endif
 
 #include "hoomd/HOOMDMath.h"
+#include "MDPrecisionSetup.h"
 
 /*! \file EvaluatorPairYukawa.h
     \brief Defines the pair evaluator class for Yukawa potentials
@@ -153,7 +154,97 @@ class EvaluatorPairYukawa
                 return false;
             }
 
+        //! Evaluate the force and energy in reduced precision
+        /*! \param force_divr Output parameter to write the computed force divided by r.
+            \param pair_eng Output parameter to write the computed pair energy
+            \param energy_shift If true, the potential must be shifted so that
+            V(r) is continuous at the cutoff
+
+            Same as evalForceAndEnergy(), but computed in PairReal. GPU pair kernels call this method when built with
+            ENABLE_MD_MIXED_PRECISION.
+
+            \return True if they are evaluated or false if they are not because
+            we are beyond the cutoff
+        */
+        DEVICE bool evalForceAndEnergyMixed(PairReal& force_divr, PairReal& pair_eng, bool energy_shift)
+            {
+            // compute the force divided by r in force_divr
+            if (rsq < rcutsq && epsilon != 0)
+                {
+                PairReal epsilonr = PairReal(epsilon);
+                PairReal kappar = PairReal(kappa);
+                PairReal rinv = fast::rsqrt(PairReal(rsq));
+                PairReal r = PairReal(1.0) / rinv;
+                PairReal r2inv = PairReal(1.0) / PairReal(rsq);
+
+                PairReal exp_val = fast::exp(-kappar * r);
+
+                force_divr = epsilonr * exp_val * r2inv * (rinv + kappar);
+                pair_eng = epsilonr * exp_val * rinv;
+
+                if (energy_shift)
+                    {
+                    PairReal rcutinv = fast::rsqrt(PairReal(rcutsq));
+                    PairReal rcut = PairReal(1.0) / rcutinv;
+                    pair_eng -= epsilonr * fast::exp(-kappar * rcut) * rcutinv;
+                    }
+                return true;
+                }
+            else
+                return false;
+            }
+
         #ifndef __HIPCC__
+        //! Evaluate the force and energy for a batch of pairs
+        /*! \param n Number of pairs in the batch
+            \param rsq Squared distance between the particles of each pair
+            \param rcutsq Squared cutoff radius of each pair
+            \param params Per type pair parameters
+            \param typpair Index into \a params for each pair
+            \param energy_shift Whether to shift the energy of each pair so that V(r) is continuous at the cutoff
+            \param force_divr Output array for the computed force divided by r
+            \param pair_eng Output array for the computed pair energy
+            \param evaluated Output array set to true for pairs that are evaluated
+
+            The loop body has no branches so that the host compiler can vectorize it. Each pair gives the same
+            result as evalForceAndEnergy().
+        */
+        static void evalForceAndEnergyBatch(unsigned int n,
+                                            const Scalar *rsq,
+                                            const Scalar *rcutsq,
+                                            const param_type *params,
+                                            const unsigned int *typpair,
+                                            const bool *energy_shift,
+                                            Scalar *force_divr,
+                                            Scalar *pair_eng,
+                                            bool *evaluated)
+            {
+            for (unsigned int k = 0; k < n; k++)
+                {
+                const Scalar epsilon = params[typpair[k]].epsilon;
+                const Scalar kappa = params[typpair[k]].kappa;
+                const bool in_range = rsq[k] < rcutsq[k] && epsilon != 0;
+
+                // substitute a harmless distance for pairs that are not evaluated
+                Scalar rsq_k = in_range ? rsq[k] : Scalar(1.0);
+                Scalar rinv = fast::rsqrt(rsq_k);
+                Scalar r = Scalar(1.0) / rinv;
+                Scalar r2inv = Scalar(1.0) / rsq_k;
+                Scalar exp_val = fast::exp(-kappa * r);
+
+                Scalar rcutinv = fast::rsqrt(in_range ? rcutsq[k] : Scalar(1.0));
+                Scalar rcut = Scalar(1.0) / rcutinv;
+
+                Scalar f = epsilon * exp_val * r2inv * (rinv + kappa);
+                Scalar e = epsilon * exp_val * rinv;
+                Scalar e_cut = energy_shift[k] ? epsilon * fast::exp(-kappa * rcut) * rcutinv : Scalar(0.0);
+
+                force_divr[k] = in_range ? f : Scalar(0.0);
+                pair_eng[k] = in_range ? e - e_cut : Scalar(0.0);
+                evaluated[k] = in_range;
+                }
+            }
+
         //! Get the name of this potential
         /*! \returns The potential name. Must be short and all lowercase, as this is the name energies will be logged as
             via analyze.log.
@@ -13,6 +13,7 @@
 
 #ifndef __HIPCC__
 #include <string>
+#include <algorithm>
 #endif
 
 #include "hoomd/BoxDim.h"
@@ -32,10 +33,23 @@ const unsigned int MAX_N_SWALLS=20;
 const unsigned int MAX_N_CWALLS=20;
 const unsigned int MAX_N_PWALLS=60;
 
+// the wall grid has WALL_GRID_DIM cells along each box vector, each with one bit per wall
+const unsigned int WALL_GRID_DIM=4;
+const unsigned int WALL_LIST_WORDS=(MAX_N_SWALLS+MAX_N_CWALLS+MAX_N_PWALLS+31)/32;
+
+//! Walls and the walls within the cutoff of each cell of a grid
+/*! Bit k of the wall list of a cell is set for sphere k, bit MAX_N_SWALLS + k for cylinder k, and bit
+    MAX_N_SWALLS + MAX_N_CWALLS + k for plane k. EvaluatorWalls<evaluator>::updateField() builds the lists whenever the
+    walls or the parameters change. Particles outside of the grid evaluate every wall.
+*/
 struct wall_type{
     unsigned int     numSpheres; // these data types come first, since the structs are aligned already
     unsigned int     numCylinders;
     unsigned int     numPlanes;
+    unsigned int     gridValid;  // nonzero when cellWalls is up to date
+    Scalar3          gridLo;     // lower corner of the grid
+    Scalar3          gridInvWidth; // inverse width of the grid cells
+    unsigned int     cellWalls[WALL_GRID_DIM*WALL_GRID_DIM*WALL_GRID_DIM][WALL_LIST_WORDS];
     SphereWall       Spheres[MAX_N_SWALLS];
     CylinderWall     Cylinders[MAX_N_CWALLS];
     PlaneWall        Planes[MAX_N_PWALLS];
@@ -97,6 +111,35 @@ class EvaluatorWalls
             qi = charge;
             }
 
+        //! Get the list of walls that may interact with the particle
+        /*! \returns The wall list of the grid cell of the particle, or 0 when all walls must be evaluated
+        */
+        DEVICE inline const unsigned int *getWallList() const
+            {
+            if (!m_field.gridValid)
+                return 0;
+
+            Scalar fx = (m_pos.x - m_field.gridLo.x) * m_field.gridInvWidth.x;
+            Scalar fy = (m_pos.y - m_field.gridLo.y) * m_field.gridInvWidth.y;
+            Scalar fz = (m_pos.z - m_field.gridLo.z) * m_field.gridInvWidth.z;
+            if (!(fx >= Scalar(0.0) && fx < Scalar(WALL_GRID_DIM)
+                && fy >= Scalar(0.0) && fy < Scalar(WALL_GRID_DIM)
+                && fz >= Scalar(0.0) && fz < Scalar(WALL_GRID_DIM)))
+                return 0;
+
+            unsigned int cell = ((unsigned int)fz*WALL_GRID_DIM + (unsigned int)fy)*WALL_GRID_DIM + (unsigned int)fx;
+            return m_field.cellWalls[cell];
+            }
+
+        //! Test if a wall is in a wall list
+        /*! \param list Wall list, 0 to evaluate all walls
+            \param bit Bit of the wall in the list
+        */
+        DEVICE static inline bool wallListed(const unsigned int *list, unsigned int bit)
+            {
+            return !list || ((list[bit/32] >> (bit%32)) & 1);
+            }
+
         DEVICE inline void callEvaluator(Scalar3& F, Scalar& energy, const vec3<Scalar> drv)
             {
             Scalar3 dr = -vec_to_scalar3(drv);
@@ -182,12 +225,15 @@ class EvaluatorWalls
             vec3<Scalar> position = vec3<Scalar>(m_pos);
             vec3<Scalar> drv;
             bool inside = false; //keeps compiler from complaining
+            const unsigned int *list = getWallList();
             if (m_params.rextrap>0.0) //extrapolated mode
                 {
                 Scalar rextrapsq=m_params.rextrap * m_params.rextrap;
                 Scalar rsq;
                 for (unsigned int k = 0; k < m_field.numSpheres; k++)
                     {
+                    if (!wallListed(list, k))
+                        continue;
                     drv = vecPtToWall(m_field.Spheres[k], position, inside);
                     rsq = dot(drv, drv);
                     if (inside && rsq>=rextrapsq)
@@ -213,6 +259,8 @@ class EvaluatorWalls
                     }
                 for (unsigned int k = 0; k < m_field.numCylinders; k++)
                     {
+                    if (!wallListed(list, MAX_N_SWALLS + k))
+                        continue;
                     drv = vecPtToWall(m_field.Cylinders[k], position, inside);
                     rsq = dot(drv, drv);
                     if (inside && rsq>=rextrapsq)
@@ -240,6 +288,8 @@ class EvaluatorWalls
                     }
                 for (unsigned int k = 0; k < m_field.numPlanes; k++)
                     {
+                    if (!wallListed(list, MAX_N_SWALLS+MAX_N_CWALLS + k))
+                        continue;
                     drv = vecPtToWall(m_field.Planes[k], position, inside);
                     rsq = dot(drv, drv);
                     if (inside && rsq>=rextrapsq)
@@ -268,6 +318,8 @@ class EvaluatorWalls
                 {
                 for (unsigned int k = 0; k < m_field.numSpheres; k++)
                     {
+                    if (!wallListed(list, k))
+                        continue;
                     drv = vecPtToWall(m_field.Spheres[k], position, inside);
                     if (inside)
                         {
@@ -276,6 +328,8 @@ class EvaluatorWalls
                     }
                 for (unsigned int k = 0; k < m_field.numCylinders; k++)
                     {
+                    if (!wallListed(list, MAX_N_SWALLS + k))
+                        continue;
                     drv = vecPtToWall(m_field.Cylinders[k], position, inside);
                     if (inside)
                         {
@@ -284,6 +338,8 @@ class EvaluatorWalls
                     }
                 for (unsigned int k = 0; k < m_field.numPlanes; k++)
                     {
+                    if (!wallListed(list, MAX_N_SWALLS+MAX_N_CWALLS + k))
+                        continue;
                     drv = vecPtToWall(m_field.Planes[k], position, inside);
                     if (inside)
                         {
@@ -310,6 +366,72 @@ class EvaluatorWalls
             {
             return std::string("wall_") + evaluator::getName();
             }
+
+        //! Find the walls within the cutoff of each cell of the wall grid
+        /*! \param field Walls, the wall lists are written here
+            \param params Per-type parameters
+            \param ntypes Number of particle types
+            \param box Global simulation box
+
+            A wall is left out of the list of a cell when the center of the cell is further than the cutoff plus half
+            the cell diagonal from the wall, so no point of the cell is within the cutoff, and, in extrapolated mode,
+            the cell is on the inside of the wall.
+        */
+        static void updateField(field_type& field, const param_type *params, unsigned int ntypes, const BoxDim& box)
+            {
+            Scalar rcut = Scalar(0.0);
+            bool extrap = false;
+            for (unsigned int typ = 0; typ < ntypes; typ++)
+                {
+                rcut = std::max(rcut, std::max(sqrt(params[typ].rcutsq), params[typ].rextrap));
+                if (params[typ].rextrap > Scalar(0.0))
+                    extrap = true;
+                }
+
+            Scalar3 lo = box.getLo();
+            Scalar3 L = box.getL();
+            Scalar3 width = L / Scalar(WALL_GRID_DIM);
+            field.gridLo = lo;
+            field.gridInvWidth = make_scalar3(Scalar(1.0) / width.x, Scalar(1.0) / width.y, Scalar(1.0) / width.z);
+            Scalar half_diagonal = Scalar(0.5) * sqrt(dot(width, width));
+
+            for (unsigned int i = 0; i < WALL_GRID_DIM; i++)
+                for (unsigned int j = 0; j < WALL_GRID_DIM; j++)
+                    for (unsigned int l = 0; l < WALL_GRID_DIM; l++)
+                        {
+                        vec3<Scalar> center(lo.x + (Scalar(l) + Scalar(0.5)) * width.x,
+                                            lo.y + (Scalar(j) + Scalar(0.5)) * width.y,
+                                            lo.z + (Scalar(i) + Scalar(0.5)) * width.z);
+                        unsigned int *list = field.cellWalls[(i*WALL_GRID_DIM + j)*WALL_GRID_DIM + l];
+                        for (unsigned int w = 0; w < WALL_LIST_WORDS; w++)
+                            list[w] = 0;
+
+                        Scalar reach = half_diagonal + rcut;
+                        bool inside = false;
+                        vec3<Scalar> drv;
+                        for (unsigned int k = 0; k < field.numSpheres; k++)
+                            {
+                            drv = vecPtToWall(field.Spheres[k], center, inside);
+                            if (dot(drv, drv) <= reach*reach || (extrap && !inside))
+                                list[k/32] |= 1u << (k%32);
+                            }
+                        for (unsigned int k = 0; k < field.numCylinders; k++)
+                            {
+                            drv = vecPtToWall(field.Cylinders[k], center, inside);
+                            unsigned int bit = MAX_N_SWALLS + k;
+                            if (dot(drv, drv) <= reach*reach || (extrap && !inside))
+                                list[bit/32] |= 1u << (bit%32);
+                            }
+                        for (unsigned int k = 0; k < field.numPlanes; k++)
+                            {
+                            drv = vecPtToWall(field.Planes[k], center, inside);
+                            unsigned int bit = MAX_N_SWALLS + MAX_N_CWALLS + k;
+                            if (dot(drv, drv) <= reach*reach || (extrap && !inside))
+                                list[bit/32] |= 1u << (bit%32);
+                            }
+                        }
+            field.gridValid = 1;
+            }
         #endif
 
     protected:
@@ -13,3 +13,6 @@ hipError_t gpu_compute_ewald_forces(const pair_args_t& pair_args,
     return  gpu_compute_pair_forces<EvaluatorPairEwald>(pair_args,
                                                         d_params);
     }
+
+template hipError_t gpu_compute_pair_set_energy<EvaluatorPairEwald>(const pair_set_energy_args_t& args,
+                                                                    const EvaluatorPairEwald::param_type *d_params);
@@ -42,6 +42,14 @@ class PYBIND11_EXPORT FIREEnergyMinimizer : public IntegratorTwoStep
         //! Return whether or not the minimization has converged
         bool hasConverged() const {return m_converged;}
 
+        //! Request the potential energy, which the minimizer needs on every step
+        virtual PDataFlags getRequestedPDataFlags()
+            {
+            PDataFlags flags = IntegratorTwoStep::getRequestedPDataFlags();
+            flags[pdata_flag::potential_energy] = 1;
+            return flags;
+            }
+
         //! Return the potential energy after the last iteration
         Scalar getEnergy() const
             {
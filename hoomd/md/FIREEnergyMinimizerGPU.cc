@@ -21,7 +21,7 @@ using namespace std;
     \param dt Default step size
 */
 FIREEnergyMinimizerGPU::FIREEnergyMinimizerGPU(std::shared_ptr<SystemDefinition> sysdef, Scalar dt)
-    :   FIREEnergyMinimizer(sysdef, dt)
+    :   FIREEnergyMinimizer(sysdef, dt), m_check_period(1), m_n_since_check(0), m_state_on_device(false)
     {
 
     // only one GPU is supported
@@ -36,6 +36,8 @@ FIREEnergyMinimizerGPU::FIREEnergyMinimizerGPU(std::shared_ptr<SystemDefinition>
     m_sum.swap(sum);
     GPUArray<Scalar> sum3(3, m_exec_conf);
     m_sum3.swap(sum3);
+    GPUArray<fire_state_t> state(1, m_exec_conf);
+    m_state.swap(state);
 
     // initialize the partial sum arrays
     m_block_size = 256; //128;
@@ -68,6 +70,18 @@ void FIREEnergyMinimizerGPU::update(unsigned int timestep)
     if (m_converged)
         return;
 
+    bool device_state = m_check_period > 1;
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        device_state = false;
+    #endif
+
+    if (device_state)
+        {
+        updateOnDevice(timestep);
+        return;
+        }
+
     IntegratorTwoStep::update(timestep);
 
     Scalar Pt(0.0);  //translational power
@@ -381,10 +395,251 @@ void FIREEnergyMinimizerGPU::update(unsigned int timestep)
     m_old_energy = energy;
     }
 
+void FIREEnergyMinimizerGPU::reset()
+    {
+    FIREEnergyMinimizer::reset();
+    m_state_on_device = false;
+    }
+
+void FIREEnergyMinimizerGPU::setCheckPeriod(unsigned int check_period)
+    {
+    if (check_period == 0)
+        {
+        m_exec_conf->msg->error() << "integrate.mode_minimize_fire: check_period must be positive" << endl;
+        throw runtime_error("Error setting parameters for FIREEnergyMinimizer");
+        }
+
+    // continue from the latest state when switching back to the host path
+    if (m_state_on_device)
+        {
+        downloadState();
+        m_state_on_device = false;
+        }
+
+    m_check_period = check_period;
+    }
+
+void FIREEnergyMinimizerGPU::uploadState()
+    {
+    ArrayHandle<fire_state_t> h_state(m_state, access_location::host, access_mode::overwrite);
+    h_state.data->alpha = m_alpha;
+    h_state.data->deltaT = m_deltaT;
+    h_state.data->energy_total = m_energy_total;
+    h_state.data->old_energy = m_old_energy;
+    h_state.data->mix_alpha = m_alpha;
+    h_state.data->factor_t = Scalar(0.0);
+    h_state.data->factor_r = Scalar(0.0);
+    h_state.data->n_since_negative = m_n_since_negative;
+    h_state.data->n_since_start = m_n_since_start;
+    h_state.data->was_reset = m_was_reset;
+    h_state.data->converged = 0;
+    h_state.data->zero = 0;
+
+    m_state_on_device = true;
+    m_n_since_check = 0;
+    }
+
+void FIREEnergyMinimizerGPU::downloadState()
+    {
+    ArrayHandle<fire_state_t> h_state(m_state, access_location::host, access_mode::read);
+    m_alpha = h_state.data->alpha;
+    m_energy_total = h_state.data->energy_total;
+    m_old_energy = h_state.data->old_energy;
+    m_n_since_negative = h_state.data->n_since_negative;
+    m_n_since_start = h_state.data->n_since_start;
+    m_was_reset = h_state.data->was_reset;
+    m_converged = h_state.data->converged;
+    IntegratorTwoStep::setDeltaT(h_state.data->deltaT);
+    }
+
+/*! \param timestep is the iteration number
+
+    Performs the same iteration as update(), but reduces the sums of all methods into separate slots of m_sums and
+    advances the FIRE state machine with gpu_fire_update_state(). The host only synchronizes with the device to read
+    the state every m_check_period steps.
+*/
+void FIREEnergyMinimizerGPU::updateOnDevice(unsigned int timestep)
+    {
+    IntegratorTwoStep::update(timestep);
+
+    if (!m_state_on_device)
+        uploadState();
+
+    unsigned int num_methods = (unsigned int) m_methods.size();
+    if (m_sums.getNumElements() < num_methods*FIRE_NUM_SUMS)
+        {
+        GPUArray<Scalar> sums(num_methods*FIRE_NUM_SUMS, m_exec_conf);
+        m_sums.swap(sums);
+        }
+
+    if (m_prof)
+        m_prof->push(m_exec_conf, "FIRE sums");
+
+    unsigned int total_group_size = 0;
+
+        {
+        ArrayHandle<Scalar> d_sums(m_sums, access_location::device, access_mode::overwrite);
+        ArrayHandle<Scalar> d_partial_sum1(m_partial_sum1, access_location::device, access_mode::overwrite);
+        ArrayHandle<Scalar> d_partial_sum2(m_partial_sum2, access_location::device, access_mode::overwrite);
+        ArrayHandle<Scalar> d_partial_sum3(m_partial_sum3, access_location::device, access_mode::overwrite);
+        ArrayHandle<Scalar4> d_net_force(m_pdata->getNetForce(), access_location::device, access_mode::read);
+        ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(), access_location::device, access_mode::read);
+        ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(), access_location::device, access_mode::read);
+
+        for (unsigned int m = 0; m < num_methods; m++)
+            {
+            std::shared_ptr<ParticleGroup> current_group = m_methods[m]->getGroup();
+
+            unsigned int group_size = current_group->getNumMembers();
+            total_group_size += group_size;
+
+            ArrayHandle< unsigned int > d_index_array(current_group->getIndexArray(), access_location::device, access_mode::read);
+
+            Scalar *d_method_sums = d_sums.data + m*FIRE_NUM_SUMS;
+            unsigned int num_blocks = group_size/m_block_size + 1;
+
+            gpu_fire_compute_sum_pe(d_index_array.data,
+                                    group_size,
+                                    d_net_force.data,
+                                    d_method_sums,
+                                    d_partial_sum1.data,
+                                    m_block_size,
+                                    num_blocks);
+
+            gpu_fire_compute_sum_all(m_pdata->getN(),
+                                     d_vel.data,
+                                     d_accel.data,
+                                     d_index_array.data,
+                                     group_size,
+                                     d_method_sums + 1,
+                                     d_partial_sum1.data,
+                                     d_partial_sum2.data,
+                                     d_partial_sum3.data,
+                                     m_block_size,
+                                     num_blocks);
+
+            if (m_methods[m]->getAnisotropic())
+                {
+                ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(), access_location::device, access_mode::read);
+                ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(), access_location::device, access_mode::read);
+                ArrayHandle<Scalar4> d_net_torque(m_pdata->getNetTorqueArray(), access_location::device, access_mode::read);
+                ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::device, access_mode::read);
+
+                gpu_fire_compute_sum_all_angular(m_pdata->getN(),
+                                         d_orientation.data,
+                                         d_inertia.data,
+                                         d_angmom.data,
+                                         d_net_torque.data,
+                                         d_index_array.data,
+                                         group_size,
+                                         d_method_sums + 4,
+                                         d_partial_sum1.data,
+                                         d_partial_sum2.data,
+                                         d_partial_sum3.data,
+                                         m_block_size,
+                                         num_blocks);
+                }
+            else
+                {
+                hipMemsetAsync(d_method_sums + 4, 0, 3*sizeof(Scalar));
+                }
+
+            if(m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+        }
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+
+    if (m_prof)
+        m_prof->push(m_exec_conf, "FIRE update velocities");
+
+    fire_params_t params;
+    params.ftol = m_ftol;
+    params.wtol = m_wtol;
+    params.etol = m_etol;
+    params.finc = m_finc;
+    params.fdec = m_fdec;
+    params.alpha_start = m_alpha_start;
+    params.falpha = m_falpha;
+    params.deltaT_max = m_deltaT_max;
+    params.nmin = m_nmin;
+    params.run_minsteps = m_run_minsteps;
+
+        {
+        ArrayHandle<fire_state_t> d_state(m_state, access_location::device, access_mode::readwrite);
+        ArrayHandle<Scalar> d_sums(m_sums, access_location::device, access_mode::read);
+
+        gpu_fire_update_state(d_state.data,
+                              d_sums.data,
+                              num_methods,
+                              total_group_size,
+                              m_sysdef->getNDimensions()*total_group_size,
+                              params);
+
+        if(m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+
+        for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
+            {
+            std::shared_ptr<ParticleGroup> current_group = (*method)->getGroup();
+
+            unsigned int group_size = current_group->getNumMembers();
+            ArrayHandle< unsigned int > d_index_array(current_group->getIndexArray(), access_location::device, access_mode::read);
+
+            ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(), access_location::device, access_mode::readwrite);
+            ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(), access_location::device, access_mode::read);
+
+            gpu_fire_update_v_state(d_vel.data,
+                                    d_accel.data,
+                                    d_index_array.data,
+                                    group_size,
+                                    d_state.data);
+
+            if(m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+
+            if ((*method)->getAnisotropic())
+                {
+                ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(), access_location::device, access_mode::read);
+                ArrayHandle<Scalar4> d_net_torque(m_pdata->getNetTorqueArray(), access_location::device, access_mode::read);
+                ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(), access_location::device, access_mode::readwrite);
+                ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::device, access_mode::read);
+
+                gpu_fire_update_angmom_state(d_net_torque.data,
+                                             d_orientation.data,
+                                             d_inertia.data,
+                                             d_angmom.data,
+                                             d_index_array.data,
+                                             group_size,
+                                             d_state.data);
+
+                if(m_exec_conf->isCUDAErrorCheckingEnabled())
+                    CHECK_CUDA_ERROR();
+                }
+            }
+        }
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+
+    // read the state back and check for convergence every m_check_period steps
+    if (++m_n_since_check >= m_check_period)
+        {
+        m_n_since_check = 0;
+        downloadState();
+
+        if (m_converged)
+            m_exec_conf->msg->notice(4) << "FIRE converged by timestep " << timestep << std::endl;
+        }
+    }
 
 void export_FIREEnergyMinimizerGPU(py::module& m)
     {
     py::class_<FIREEnergyMinimizerGPU, FIREEnergyMinimizer, std::shared_ptr<FIREEnergyMinimizerGPU> >(m, "FIREEnergyMinimizerGPU")
         .def(py::init< std::shared_ptr<SystemDefinition>, Scalar >())
+        .def("setCheckPeriod", &FIREEnergyMinimizerGPU::setCheckPeriod)
+        .def("getCheckPeriod", &FIREEnergyMinimizerGPU::getCheckPeriod)
         ;
     }
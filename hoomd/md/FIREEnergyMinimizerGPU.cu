@@ -809,3 +809,255 @@ hipError_t gpu_fire_update_angmom(const Scalar4 *d_net_torque,
 
     return hipSuccess;
     }
+
+//! Kernel that advances the FIRE state machine, called by gpu_fire_update_state()
+/*! \param d_state FIRE state to update
+    \param d_sums FIRE_NUM_SUMS sums for each integration method
+    \param num_methods Number of integration methods
+    \param total_group_size Number of particles in all integration groups
+    \param ndof Number of translational degrees of freedom
+    \param params FIRE parameters
+
+    A single thread performs the same steps as FIREEnergyMinimizerGPU::update() does on the host, so that the host
+    only needs to read the state when it checks for convergence. The convergence flag is latched, and the state
+    machine keeps iterating until the host reads it.
+*/
+__global__ void gpu_fire_update_state_kernel(fire_state_t *d_state,
+                                             const Scalar *d_sums,
+                                             unsigned int num_methods,
+                                             unsigned int total_group_size,
+                                             unsigned int ndof,
+                                             fire_params_t params)
+    {
+    if (blockIdx.x * blockDim.x + threadIdx.x != 0)
+        return;
+
+    Scalar energy(0.0);
+    Scalar Pt(0.0);
+    Scalar vnorm(0.0);
+    Scalar fnorm(0.0);
+    Scalar Pr(0.0);
+    Scalar wnorm(0.0);
+    Scalar tnorm(0.0);
+    for (unsigned int m = 0; m < num_methods; m++)
+        {
+        const Scalar *sums = d_sums + m*FIRE_NUM_SUMS;
+        energy += sums[0];
+        Pt += sums[1];
+        vnorm += sums[2];
+        fnorm += sums[3];
+        Pr += sums[4];
+        wnorm += sums[5];
+        tnorm += sums[6];
+        }
+
+    fire_state_t state = *d_state;
+
+    state.energy_total = energy;
+    energy /= (Scalar) total_group_size;
+
+    if (state.was_reset)
+        {
+        state.was_reset = 0;
+        state.old_energy = energy + Scalar(100000)*params.etol;
+        }
+
+    vnorm = sqrt(vnorm);
+    fnorm = sqrt(fnorm);
+    wnorm = sqrt(wnorm);
+    tnorm = sqrt(tnorm);
+
+    if (fnorm/sqrt(Scalar(ndof)) < params.ftol && wnorm/sqrt(Scalar(ndof)) < params.wtol
+        && fabs(energy-state.old_energy) < params.etol && state.n_since_start >= params.run_minsteps)
+        state.converged = 1;
+
+    state.mix_alpha = state.alpha;
+    state.factor_t = (fabs(fnorm) > EPSILON) ? state.alpha*vnorm/fnorm : Scalar(1.0);
+    state.factor_r = (fabs(tnorm) > EPSILON) ? state.alpha*wnorm/tnorm : Scalar(1.0);
+
+    if (Pt + Pr > Scalar(0.0))
+        {
+        state.zero = 0;
+        state.n_since_negative++;
+        if (state.n_since_negative > params.nmin)
+            {
+            state.deltaT = min(state.deltaT*params.finc, params.deltaT_max);
+            state.alpha *= params.falpha;
+            }
+        }
+    else
+        {
+        state.zero = 1;
+        state.deltaT *= params.fdec;
+        state.alpha = params.alpha_start;
+        state.n_since_negative = 0;
+        }
+
+    state.n_since_start++;
+    state.old_energy = energy;
+
+    *d_state = state;
+    }
+
+/*! \param d_state FIRE state to update
+    \param d_sums FIRE_NUM_SUMS sums for each integration method
+    \param num_methods Number of integration methods
+    \param total_group_size Number of particles in all integration groups
+    \param ndof Number of translational degrees of freedom
+    \param params FIRE parameters
+
+    This function is a driver for gpu_fire_update_state_kernel(), see it for details.
+*/
+hipError_t gpu_fire_update_state(fire_state_t *d_state,
+                                 const Scalar *d_sums,
+                                 unsigned int num_methods,
+                                 unsigned int total_group_size,
+                                 unsigned int ndof,
+                                 const fire_params_t& params)
+    {
+    hipLaunchKernelGGL((gpu_fire_update_state_kernel), dim3(1), dim3(1), 0, 0, d_state,
+                                                  d_sums,
+                                                  num_methods,
+                                                  total_group_size,
+                                                  ndof,
+                                                  params);
+
+    return hipSuccess;
+    }
+
+//! Kernel that mixes or zeroes the velocities as decided by the device state
+/*! \param d_vel array of particle velocities to update
+    \param d_accel array of particle accelerations
+    \param d_group_members Device array listing the indices of the members of the group to integrate
+    \param group_size Number of members in the group
+    \param d_state FIRE state written by gpu_fire_update_state()
+*/
+__global__ void gpu_fire_update_v_state_kernel(Scalar4 *d_vel,
+                                               const Scalar3 *d_accel,
+                                               unsigned int *d_group_members,
+                                               unsigned int group_size,
+                                               const fire_state_t *d_state)
+    {
+    // determine which particle this thread works on (MEM TRANSFER: 4 bytes)
+    int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (group_idx < group_size)
+        {
+        unsigned int idx = d_group_members[group_idx];
+        Scalar4 v = d_vel[idx];
+
+        if (d_state->zero)
+            {
+            v.x = Scalar(0.0);
+            v.y = Scalar(0.0);
+            v.z = Scalar(0.0);
+            }
+        else
+            {
+            Scalar3 a = d_accel[idx];
+            Scalar alpha = d_state->mix_alpha;
+            Scalar factor_t = d_state->factor_t;
+
+            v.x = v.x*(Scalar(1.0)-alpha) + a.x*factor_t;
+            v.y = v.y*(Scalar(1.0)-alpha) + a.y*factor_t;
+            v.z = v.z*(Scalar(1.0)-alpha) + a.z*factor_t;
+            }
+
+        d_vel[idx] = v;
+        }
+    }
+
+/*! \param d_vel array of particle velocities to update
+    \param d_accel array of particle accelerations
+    \param d_group_members Device array listing the indices of the members of the group to integrate
+    \param group_size Number of members in the group
+    \param d_state FIRE state written by gpu_fire_update_state()
+
+    This function is a driver for gpu_fire_update_v_state_kernel(), see it for details.
+*/
+hipError_t gpu_fire_update_v_state(Scalar4 *d_vel,
+                                   const Scalar3 *d_accel,
+                                   unsigned int *d_group_members,
+                                   unsigned int group_size,
+                                   const fire_state_t *d_state)
+    {
+    // setup the grid to run the kernel
+    int block_size = 256;
+    dim3 grid( (group_size/block_size) + 1, 1, 1);
+    dim3 threads(block_size, 1, 1);
+
+    // run the kernel
+    hipLaunchKernelGGL((gpu_fire_update_v_state_kernel), dim3(grid), dim3(threads ), 0, 0, d_vel,
+                                                  d_accel,
+                                                  d_group_members,
+                                                  group_size,
+                                                  d_state);
+
+    return hipSuccess;
+    }
+
+//! Kernel that mixes or zeroes the angular momenta as decided by the device state
+__global__ void gpu_fire_update_angmom_state_kernel(const Scalar4 *d_net_torque,
+                                                    const Scalar4 *d_orientation,
+                                                    const Scalar3 *d_inertia,
+                                                    Scalar4 *d_angmom,
+                                                    unsigned int *d_group_members,
+                                                    unsigned int group_size,
+                                                    const fire_state_t *d_state)
+    {
+    // determine which particle this thread works on (MEM TRANSFER: 4 bytes)
+    int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (group_idx < group_size)
+        {
+        unsigned int idx = d_group_members[group_idx];
+
+        if (d_state->zero)
+            {
+            d_angmom[idx] = make_scalar4(0,0,0,0);
+            return;
+            }
+
+        quat<Scalar> q(d_orientation[idx]);
+        vec3<Scalar> t(d_net_torque[idx]);
+        quat<Scalar> p(d_angmom[idx]);
+        vec3<Scalar> I(d_inertia[idx]);
+
+        // rotate torque into principal frame
+        t = rotate(conj(q),t);
+
+        // ignore torque component along an axis for which the moment of inertia zero
+        if (I.x < EPSILON) t.x = 0;
+        if (I.y < EPSILON) t.y = 0;
+        if (I.z < EPSILON) t.z = 0;
+
+        p = p*Scalar(1.0-d_state->mix_alpha) + Scalar(2.0)*q*t*d_state->factor_r;
+
+        d_angmom[idx] = quat_to_scalar4(p);
+        }
+    }
+
+hipError_t gpu_fire_update_angmom_state(const Scalar4 *d_net_torque,
+                                        const Scalar4 *d_orientation,
+                                        const Scalar3 *d_inertia,
+                                        Scalar4 *d_angmom,
+                                        unsigned int *d_group_members,
+                                        unsigned int group_size,
+                                        const fire_state_t *d_state)
+    {
+    // setup the grid to run the kernel
+    int block_size = 256;
+    dim3 grid( (group_size/block_size) + 1, 1, 1);
+    dim3 threads(block_size, 1, 1);
+
+    // run the kernel
+    hipLaunchKernelGGL((gpu_fire_update_angmom_state_kernel), dim3(grid), dim3(threads ), 0, 0, d_net_torque,
+                                                  d_orientation,
+                                                  d_inertia,
+                                                  d_angmom,
+                                                  d_group_members,
+                                                  group_size,
+                                                  d_state);
+
+    return hipSuccess;
+    }
@@ -14,6 +14,43 @@
     \brief Defines the interface to GPU kernel drivers used by FIREEnergyMinimizerGPU.
 */
 
+//! Number of sums per integration method reduced into the device sums array
+/*! The sums of each method are E, Pt, vsq, fsq, Pr, wsq, and tsq, in this order.
+*/
+const unsigned int FIRE_NUM_SUMS = 7;
+
+//! FIRE parameters needed by gpu_fire_update_state()
+struct fire_params_t
+    {
+    Scalar ftol;                //!< Stopping tolerance based on the total force
+    Scalar wtol;                //!< Stopping tolerance based on the total torque
+    Scalar etol;                //!< Stopping tolerance based on the change in energy
+    Scalar finc;                //!< Fractional increase in the step size
+    Scalar fdec;                //!< Fractional decrease in the step size
+    Scalar alpha_start;         //!< Starting value of alpha
+    Scalar falpha;              //!< Factor to rescale alpha by
+    Scalar deltaT_max;          //!< Maximum step size
+    unsigned int nmin;          //!< Number of successful search directions before alpha and deltaT adapt
+    unsigned int run_minsteps;  //!< Minimum number of search attempts
+    };
+
+//! FIRE state machine kept in device memory between convergence checks
+struct fire_state_t
+    {
+    Scalar alpha;                   //!< Coupling parameter for the next iteration
+    Scalar deltaT;                  //!< Step size for the next iteration
+    Scalar energy_total;            //!< Total energy of all integrator groups in the last iteration
+    Scalar old_energy;              //!< Energy per particle in the last iteration
+    Scalar mix_alpha;               //!< Coupling parameter applied to the velocities in this iteration
+    Scalar factor_t;                //!< Translational mixing factor of this iteration
+    Scalar factor_r;                //!< Rotational mixing factor of this iteration
+    unsigned int n_since_negative;  //!< Number of consecutive successful search directions
+    unsigned int n_since_start;     //!< Number of search attempts
+    unsigned int was_reset;         //!< Nonzero until the first iteration after a reset
+    unsigned int converged;         //!< Nonzero once the convergence criteria have been met
+    unsigned int zero;              //!< Nonzero if the velocities are zeroed in this iteration
+    };
+
 //! Kernel driver for zeroing velocities called by FIREEnergyMinimizerGPU
 hipError_t gpu_fire_zero_v(Scalar4 *d_vel,
                             unsigned int *d_group_members,
@@ -76,4 +113,28 @@ hipError_t gpu_fire_update_angmom(const Scalar4 *d_net_torque,
                               Scalar alpha,
                               Scalar factor_r);
 
+//! Kernel driver for advancing the FIRE state machine on the device
+hipError_t gpu_fire_update_state(fire_state_t *d_state,
+                            const Scalar *d_sums,
+                            unsigned int num_methods,
+                            unsigned int total_group_size,
+                            unsigned int ndof,
+                            const fire_params_t& params);
+
+//! Kernel driver for updating the velocities with the mixing factors in the device state
+hipError_t gpu_fire_update_v_state(Scalar4 *d_vel,
+                            const Scalar3 *d_accel,
+                            unsigned int *d_group_members,
+                            unsigned int group_size,
+                            const fire_state_t *d_state);
+
+//! Kernel driver for updating the angular momenta with the mixing factors in the device state
+hipError_t gpu_fire_update_angmom_state(const Scalar4 *d_net_torque,
+                              const Scalar4 *d_orientation,
+                              const Scalar3 *d_inertia,
+                              Scalar4 *d_angmom,
+                              unsigned int *d_group_members,
+                              unsigned int group_size,
+                              const fire_state_t *d_state);
+
 #endif //__FIRE_ENERGY_MINIMIZER_GPU_CUH__
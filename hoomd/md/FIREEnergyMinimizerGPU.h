@@ -5,6 +5,7 @@
 // Maintainer: askeys
 
 #include "FIREEnergyMinimizer.h"
+#include "FIREEnergyMinimizerGPU.cuh"
 
 #include <memory>
 
@@ -24,6 +25,13 @@
 //! Finds the nearest basin in the potential energy landscape
 /*! \b Overview
 
+    By default, the sums over the power, the force norms, and the energy are copied to the host at every step, where
+    the FIRE parameters are adapted and convergence is checked. With a check period k > 1, a single thread kernel
+    advances the FIRE state machine on the device and the host only reads the state back every k steps. The step size
+    chosen by the device is then applied to the integration methods with a lag of up to k steps, and up to k-1 FIRE
+    iterations run after the convergence criteria are met. hasConverged() and getEnergy() report the state read at the
+    last check. Domain decomposition always uses the host path, which needs the sums of all ranks.
+
     \ingroup updaters
 */
 class PYBIND11_EXPORT FIREEnergyMinimizerGPU : public FIREEnergyMinimizer
@@ -38,6 +46,20 @@ class PYBIND11_EXPORT FIREEnergyMinimizerGPU : public FIREEnergyMinimizer
         //! Iterates forward one step
         virtual void update(unsigned int);
 
+        //! Reset the minimizer to its initial state
+        virtual void reset();
+
+        //! Set the number of steps between convergence checks
+        /*! \param check_period Number of steps between convergence checks, 1 checks every step on the host
+        */
+        void setCheckPeriod(unsigned int check_period);
+
+        //! Get the number of steps between convergence checks
+        unsigned int getCheckPeriod() const
+            {
+            return m_check_period;
+            }
+
     protected:
         unsigned int m_nparticles;              //!< number of particles in the system
         unsigned int m_block_size;              //!< block size for partial sum memory
@@ -46,6 +68,20 @@ class PYBIND11_EXPORT FIREEnergyMinimizerGPU : public FIREEnergyMinimizer
         GPUArray<Scalar> m_partial_sum3;         //!< memory space for partial sum over asq
         GPUArray<Scalar> m_sum;                  //!< memory space for sum over vsq
         GPUArray<Scalar> m_sum3;                 //!< memory space for the sum over P, vsq, asq
+        GPUArray<Scalar> m_sums;                 //!< FIRE_NUM_SUMS sums for each method when checking on the device
+        GPUArray<fire_state_t> m_state;          //!< FIRE state when checking on the device
+        unsigned int m_check_period;             //!< number of steps between convergence checks
+        unsigned int m_n_since_check;            //!< number of steps since the last convergence check
+        bool m_state_on_device;                  //!< true when m_state holds the current FIRE state
+
+        //! Iterate forward one step, keeping the FIRE state on the device
+        void updateOnDevice(unsigned int timestep);
+
+        //! Copy the FIRE state to the device
+        void uploadState();
+
+        //! Read the FIRE state back from the device
+        void downloadState();
 
     private:
 
@@ -19,6 +19,8 @@ namespace py = pybind11;
 */
 ForceComposite::ForceComposite(std::shared_ptr<SystemDefinition> sysdef)
         : MolecularForceCompute(sysdef), m_bodies_changed(false), m_ptls_added_removed(false),
+         m_body_header(m_exec_conf), m_body_constituents(m_exec_conf),
+         m_center_ghosts(false),
          m_global_max_d(0.0),
          m_memory_initialized(false),
          #ifdef ENABLE_MPI
@@ -33,6 +35,9 @@ ForceComposite::ForceComposite(std::shared_ptr<SystemDefinition> sysdef)
 
     // connect to box change signal
     m_pdata->getCompositeParticlesSignal().connect<ForceComposite, &ForceComposite::getMaxBodyDiameter>(this);
+
+    TAG_ALLOCATION(m_body_header);
+    TAG_ALLOCATION(m_body_constituents);
     }
 
 //! Destructor
@@ -44,7 +49,10 @@ ForceComposite::~ForceComposite()
     m_pdata->getCompositeParticlesSignal().disconnect<ForceComposite, &ForceComposite::getMaxBodyDiameter>(this);
     #ifdef ENABLE_MPI
     if (m_comm_ghost_layer_connected)
+        {
         m_comm->getExtraGhostLayerWidthRequestSignal().disconnect<ForceComposite, &ForceComposite::requestExtraGhostLayerWidth>(this);
+        m_comm->getGhostConstituentsRequestSignal().disconnect<ForceComposite, &ForceComposite::addGhostConstituents>(this);
+        }
     #endif
     }
 
@@ -721,13 +729,147 @@ void ForceComposite::validateRigidBodies(bool create)
             }
         #endif
 
+        // list the member tags of every body, the central ptl has the lowest tag and the constituents follow in the
+        // order of the body definition
+        m_body_tag_head.assign(m_n_molecules_global+1, 0);
+        for (unsigned int tag = 0; tag < molecule_tag.size(); ++tag)
+            {
+            if (molecule_tag[tag] != NO_MOLECULE)
+                m_body_tag_head[molecule_tag[tag]+1]++;
+            }
+        for (unsigned int ibody = 0; ibody < m_n_molecules_global; ++ibody)
+            m_body_tag_head[ibody+1] += m_body_tag_head[ibody];
+
+        m_body_tags.resize(m_body_tag_head[m_n_molecules_global]);
+        std::vector<unsigned int> n_body_tags(m_n_molecules_global, 0);
+        for (unsigned int tag = 0; tag < molecule_tag.size(); ++tag)
+            {
+            unsigned int ibody = molecule_tag[tag];
+            if (ibody != NO_MOLECULE)
+                m_body_tags[m_body_tag_head[ibody] + n_body_tags[ibody]++] = tag;
+            }
+
         // reset flags
         m_bodies_changed = false;
         m_ptls_added_removed = false;
         }
     }
 
+void ForceComposite::setCenterGhosts(bool enable)
+    {
+    if (enable && m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error() << "constrain.rigid(): Body center ghosts are not supported on the GPU."
+            << std::endl;
+        throw std::runtime_error("Error setting up ForceComposite");
+        }
+
+    m_center_ghosts = enable;
+
+    #ifdef ENABLE_MPI
+    if (m_comm)
+        m_comm->setBodyCenterGhosts(enable);
+    #endif
+    }
+
 #ifdef ENABLE_MPI
+/*! Called by the Communicator at the end of the ghost exchange in body center ghost mode. The constituents of the
+    local and ghost central particles that were not received are added as ghosts. Their positions, orientations and
+    images are set like in updateCompositeParticles(), and they move with the velocity of the central particle.
+*/
+void ForceComposite::addGhostConstituents()
+    {
+    if (m_prof) m_prof->push("add ghost constituents");
+
+    unsigned int nptl = m_pdata->getN() + m_pdata->getNGhosts();
+
+    // the central ptl index and the position in the body of every missing constituent
+    std::vector<uint2> missing;
+    std::vector<unsigned int> missing_tag;
+
+        {
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_molecule_tag(m_molecule_tag, access_location::host, access_mode::read);
+
+        for (unsigned int idx = 0; idx < nptl; ++idx)
+            {
+            unsigned int tag = h_tag.data[idx];
+            if (h_body.data[idx] != tag) continue;
+
+            unsigned int ibody = h_molecule_tag.data[tag];
+            assert(ibody < m_n_molecules_global);
+            for (unsigned int k = m_body_tag_head[ibody] + 1; k < m_body_tag_head[ibody+1]; ++k)
+                {
+                unsigned int tagj = m_body_tags[k];
+                if (h_rtag.data[tagj] >= nptl)
+                    {
+                    missing.push_back(make_uint2(idx, k - m_body_tag_head[ibody] - 1));
+                    missing_tag.push_back(tagj);
+                    }
+                }
+            }
+        }
+
+    m_pdata->addGhostParticles(missing.size());
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::readwrite);
+
+    // access rigid body definition
+    ArrayHandle<unsigned int> h_body_type(m_body_types, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_body_pos(m_body_pos, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_body_orientation(m_body_orientation, access_location::host, access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+
+    for (unsigned int i = 0; i < missing.size(); ++i)
+        {
+        unsigned int central_idx = missing[i].x;
+        unsigned int jptl = missing[i].y;
+        unsigned int idx = nptl + i;
+
+        Scalar4 postype = h_postype.data[central_idx];
+        unsigned int type = __scalar_as_int(postype.w);
+        quat<Scalar> orientation(h_orientation.data[central_idx]);
+
+        vec3<Scalar> pos = vec3<Scalar>(postype) + rotate(orientation, vec3<Scalar>(h_body_pos.data[m_body_idx(type,jptl)]));
+        quat<Scalar> local_orientation(h_body_orientation.data[m_body_idx(type,jptl)]);
+
+        // wrap into box, allowing rigid bodies to span multiple images
+        int3 imgi = box.getImage(vec_to_scalar3(pos));
+        int3 negimgi = make_int3(-imgi.x,-imgi.y,-imgi.z);
+        pos = global_box.shift(pos, negimgi);
+
+        unsigned int typej = h_body_type.data[m_body_idx(type,jptl)];
+        h_postype.data[idx] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(typej));
+        h_orientation.data[idx] = quat_to_scalar4(orientation*local_orientation);
+        h_image.data[idx] = h_image.data[central_idx] + imgi;
+        h_vel.data[idx] = h_vel.data[central_idx];
+        h_charge.data[idx] = m_body_charge[type][jptl];
+        h_diameter.data[idx] = m_body_diameter[type][jptl];
+        h_body.data[idx] = h_body.data[central_idx];
+
+        h_tag.data[idx] = missing_tag[i];
+        assert(h_rtag.data[missing_tag[i]] == NOT_LOCAL);
+        h_rtag.data[missing_tag[i]] = idx;
+        }
+
+    // rebuild the molecule list with the new ghosts
+    m_dirty = true;
+
+    if (m_prof) m_prof->pop();
+    }
+
 /*! \param timestep Current time step
  */
 CommFlags ForceComposite::getRequestedCommFlags(unsigned int timestep)
@@ -756,21 +898,101 @@ CommFlags ForceComposite::getRequestedCommFlags(unsigned int timestep)
     }
 #endif
 
-//! Compute the forces and torques on the central particle
-void ForceComposite::computeForces(unsigned int timestep)
+/*! The layout lists the bodies in the order of the molecule list. For a body with a present central particle, the
+    header holds the central particle index and the number of constituents, and the constituents follow in the order of
+    the body definition, which is the tag order of the molecule list without the central particle. When the central
+    particle is not present, all members are listed and the central index is NOT_LOCAL.
+*/
+void ForceComposite::initBodyLayout()
     {
-    // access local molecule data
-    // need to move this on top because of scoping issues
-    Index2D molecule_indexer = getMoleculeIndexer();
+    if (m_prof) m_prof->push("init body layout");
+
+    const Index2D& molecule_indexer = getMoleculeIndexer();
     unsigned int nmol = molecule_indexer.getH();
 
+    m_body_constituent_idx = Index2D(molecule_indexer.getW(), nmol);
+    m_body_header.resize(nmol);
+    m_body_constituents.resize(m_body_constituent_idx.getNumElements());
+
     ArrayHandle<unsigned int> h_molecule_length(getMoleculeLengths(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_molecule_list(getMoleculeList(), access_location::host, access_mode::read);
 
-    // access particle data
     ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+    ArrayHandle<uint2> h_body_header(m_body_header, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_body_constituents(m_body_constituents, access_location::host, access_mode::overwrite);
+
+    unsigned int nptl_local = m_pdata->getN() + m_pdata->getNGhosts();
+
+    for (unsigned int ibody = 0; ibody < nmol; ++ibody)
+        {
+        unsigned int len = h_molecule_length.data[ibody];
+        assert(len > 0);
+
+        unsigned int first_idx = h_molecule_list.data[molecule_indexer(0,ibody)];
+        assert(first_idx < nptl_local);
+        unsigned int central_tag = h_body.data[first_idx];
+
+        if (central_tag >= MIN_FLOPPY)
+            {
+            // not a rigid body
+            h_body_header.data[ibody] = make_uint2(NOT_LOCAL, 0);
+            continue;
+            }
+
+        assert(central_tag <= m_pdata->getMaximumTag());
+        unsigned int central_idx = h_rtag.data[central_tag];
+
+        // the central ptl has the lowest tag and comes first in the molecule
+        unsigned int first = 1;
+        if (central_idx >= nptl_local)
+            {
+            central_idx = NOT_LOCAL;
+            first = 0;
+            }
+        assert(central_idx == NOT_LOCAL || central_idx == first_idx);
+
+        h_body_header.data[ibody] = make_uint2(central_idx, len - first);
+        for (unsigned int jptl = first; jptl < len; ++jptl)
+            {
+            h_body_constituents.data[m_body_constituent_idx(jptl - first, ibody)]
+                = h_molecule_list.data[molecule_indexer(jptl, ibody)];
+            }
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
+//! Compute the forces and torques on the central particle
+void ForceComposite::computeForces(unsigned int timestep)
+    {
+    sumConstituentForces();
+
+    #ifdef ENABLE_MPI
+    if (m_center_ghosts && m_comm)
+        {
+        // the ranks that own constituents of a ghost central particle have summed their forces on it
+        PDataFlags flags = m_pdata->getFlags();
+        m_comm->reduceGhostBodyForces(m_force, m_torque, m_virial, flags[pdata_flag::pressure_tensor]);
+        }
+    #endif
+    }
+
+/*! Without body center ghosts, the local central particles collect the forces of all their constituents. In body
+    center ghost mode, every present central particle collects the forces of the local constituents only.
+*/
+void ForceComposite::sumConstituentForces()
+    {
+    // rebuild the body layout if particles have been reordered
+    checkParticlesSorted();
+    unsigned int nbody = m_body_constituent_idx.getH();
+
+    ArrayHandle<uint2> h_body_header(m_body_header, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body_constituents(m_body_constituents, access_location::host, access_mode::read);
+
+    // access particle data
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
 
@@ -788,12 +1010,13 @@ void ForceComposite::computeForces(unsigned int timestep)
     ArrayHandle<Scalar3> h_body_pos(m_body_pos, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_body_len(m_body_len, access_location::host, access_mode::read);
 
-    // reset constraint forces and torques
-    memset(h_force.data,0, sizeof(Scalar4)*m_pdata->getN());
-    memset(h_torque.data,0, sizeof(Scalar4)*m_pdata->getN());
-    memset(h_virial.data,0, sizeof(Scalar)*m_virial.getNumElements());
-
     unsigned int nptl_local = m_pdata->getN() + m_pdata->getNGhosts();
+
+    // reset constraint forces and torques, also on the ghost central particles in body center ghost mode
+    unsigned int n_reset = m_center_ghosts ? nptl_local : m_pdata->getN();
+    memset(h_force.data,0, sizeof(Scalar4)*n_reset);
+    memset(h_torque.data,0, sizeof(Scalar4)*n_reset);
+    memset(h_virial.data,0, sizeof(Scalar)*m_virial.getNumElements());
     size_t net_virial_pitch = m_pdata->getNetVirial().getPitch();
 
     PDataFlags flags = m_pdata->getFlags();
@@ -803,25 +1026,17 @@ void ForceComposite::computeForces(unsigned int timestep)
         compute_virial = true;
         }
 
-    // loop over all molecules, also incomplete ones
-    for (unsigned int ibody = 0; ibody < nmol; ibody++)
-        {
-        unsigned int len = h_molecule_length.data[ibody];
-
-        // get central ptl tag from first ptl in molecule
-        assert(len>0);
-        unsigned int first_idx = h_molecule_list.data[molecule_indexer(0,ibody)];
-
-        assert(first_idx < m_pdata->getN() + m_pdata->getNGhosts());
-        unsigned int central_tag = h_body.data[first_idx];
-
-        assert(central_tag <= m_pdata->getMaximumTag());
-        unsigned int central_idx = h_rtag.data[central_tag];
+    // the sums of the constituents on other ranks are added when reducing the ghost central particles
+    bool sum_local_only = m_center_ghosts;
 
-        if (central_idx >= nptl_local) continue;
+    // loop over all bodies, also incomplete ones
+    for (unsigned int ibody = 0; ibody < nbody; ibody++)
+        {
+        unsigned int central_idx = h_body_header.data[ibody].x;
+        unsigned int n_constituents = h_body_header.data[ibody].y;
 
         // the central ptl must be present
-        assert(central_tag == h_tag.data[first_idx]);
+        if (central_idx >= nptl_local) continue;
 
         // central ptl position and orientation
         Scalar4 postype = h_postype.data[central_idx];
@@ -830,14 +1045,29 @@ void ForceComposite::computeForces(unsigned int timestep)
         // body type
         unsigned int type = __scalar_as_int(postype.w);
 
-        // sum up forces and torques from constituent particles
-        for (unsigned int jptl = 0; jptl < len; ++jptl)
+        // only add forces for local central particles
+        bool local = central_idx < m_pdata->getN();
+
+        // if the central particle is local, the body should be complete
+        if (local && n_constituents != h_body_len.data[type])
             {
-            unsigned int idxj = h_molecule_list.data[molecule_indexer(jptl,ibody)];
-            assert(idxj < m_pdata->getN() + m_pdata->getNGhosts());
+            m_exec_conf->msg->errorAllRanks() << "constrain.rigid(): Composite particle with body tag "
+                                              << h_body.data[central_idx] << " incomplete" << std::endl << std::endl;
+            throw std::runtime_error("Error computing composite particle forces.\n");
+            }
 
-            assert(idxj == central_idx || jptl > 0);
-            if (idxj == central_idx) continue;
+        const unsigned int *constituents = h_body_constituents.data + m_body_constituent_idx(0, ibody);
+
+        // sum up forces and torques from constituent particles
+        vec3<Scalar> force_sum(0.0, 0.0, 0.0);
+        vec3<Scalar> torque_sum(0.0, 0.0, 0.0);
+        Scalar energy_sum(0.0);
+        Scalar virial_sum[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+        for (unsigned int jptl = 0; jptl < n_constituents; ++jptl)
+            {
+            unsigned int idxj = constituents[jptl];
+            assert(idxj < nptl_local);
 
             // force and torque on particle
             Scalar4 net_force = h_net_force.data[idxj];
@@ -849,61 +1079,35 @@ void ForceComposite::computeForces(unsigned int timestep)
             h_net_force.data[idxj] = make_scalar4(0.0,0.0,0.0,0.0);
             h_net_torque.data[idxj] = make_scalar4(0.0,0.0,0.0,0.0);
 
-            // only add forces for local central particles
-            if (central_idx < m_pdata->getN())
+            if (sum_local_only ? idxj < m_pdata->getN() : local)
                 {
-                // if the central particle is local, the molecule should be complete
-                if (len != h_body_len.data[type] + 1)
-                    {
-                    m_exec_conf->msg->errorAllRanks() << "constrain.rigid(): Composite particle with body tag "
-                                                      << central_tag << " incomplete" << std::endl << std::endl;
-                    throw std::runtime_error("Error computing composite particle forces.\n");
-                    }
-
-                // sum up center of mass force
-                h_force.data[central_idx].x += f.x;
-                h_force.data[central_idx].y += f.y;
-                h_force.data[central_idx].z += f.z;
-
-                // sum up energy
-                h_force.data[central_idx].w += net_force.w;
+                // sum up center of mass force and energy
+                force_sum += f;
+                energy_sum += net_force.w;
 
                 // fetch relative position from rigid body definition
-                vec3<Scalar> dr(h_body_pos.data[m_body_idx(type, jptl - 1)]);
+                vec3<Scalar> dr(h_body_pos.data[m_body_idx(type, jptl)]);
 
                 // rotate into space frame
                 vec3<Scalar> dr_space = rotate(orientation, dr);
 
                 // torque = r x f
-                vec3<Scalar> delta_torque(cross(dr_space,f));
-                h_torque.data[central_idx].x += delta_torque.x;
-                h_torque.data[central_idx].y += delta_torque.y;
-                h_torque.data[central_idx].z += delta_torque.z;
+                torque_sum += cross(dr_space,f);
 
                 /* from previous rigid body implementation: Access Torque elements from a single particle. Right now I will am assuming that the particle
                     and rigid body reference frames are the same. Probably have to rotate first.
                  */
-                h_torque.data[central_idx].x += net_torque.x;
-                h_torque.data[central_idx].y += net_torque.y;
-                h_torque.data[central_idx].z += net_torque.z;
+                torque_sum += vec3<Scalar>(net_torque);
 
                 if (compute_virial)
                     {
-                    // sum up virial
-                    Scalar virialxx = h_net_virial.data[0*net_virial_pitch+idxj];
-                    Scalar virialxy = h_net_virial.data[1*net_virial_pitch+idxj];
-                    Scalar virialxz = h_net_virial.data[2*net_virial_pitch+idxj];
-                    Scalar virialyy = h_net_virial.data[3*net_virial_pitch+idxj];
-                    Scalar virialyz = h_net_virial.data[4*net_virial_pitch+idxj];
-                    Scalar virialzz = h_net_virial.data[5*net_virial_pitch+idxj];
-
-                    // subtract intra-body virial prt
-                    h_virial.data[0*m_virial_pitch+central_idx] += virialxx - f.x*dr_space.x;
-                    h_virial.data[1*m_virial_pitch+central_idx] += virialxy - f.x*dr_space.y;
-                    h_virial.data[2*m_virial_pitch+central_idx] += virialxz - f.x*dr_space.z;
-                    h_virial.data[3*m_virial_pitch+central_idx] += virialyy - f.y*dr_space.y;
-                    h_virial.data[4*m_virial_pitch+central_idx] += virialyz - f.y*dr_space.z;
-                    h_virial.data[5*m_virial_pitch+central_idx] += virialzz - f.z*dr_space.z;
+                    // sum up virial, subtracting the intra-body part
+                    virial_sum[0] += h_net_virial.data[0*net_virial_pitch+idxj] - f.x*dr_space.x;
+                    virial_sum[1] += h_net_virial.data[1*net_virial_pitch+idxj] - f.x*dr_space.y;
+                    virial_sum[2] += h_net_virial.data[2*net_virial_pitch+idxj] - f.x*dr_space.z;
+                    virial_sum[3] += h_net_virial.data[3*net_virial_pitch+idxj] - f.y*dr_space.y;
+                    virial_sum[4] += h_net_virial.data[4*net_virial_pitch+idxj] - f.y*dr_space.z;
+                    virial_sum[5] += h_net_virial.data[5*net_virial_pitch+idxj] - f.z*dr_space.z;
                     }
                 }
 
@@ -915,6 +1119,18 @@ void ForceComposite::computeForces(unsigned int timestep)
             h_net_virial.data[4*net_virial_pitch+idxj] = 0.0;
             h_net_virial.data[5*net_virial_pitch+idxj] = 0.0;
             }
+
+        if (local || sum_local_only)
+            {
+            h_force.data[central_idx] = make_scalar4(force_sum.x, force_sum.y, force_sum.z, energy_sum);
+            h_torque.data[central_idx] = make_scalar4(torque_sum.x, torque_sum.y, torque_sum.z, 0.0);
+
+            if (compute_virial)
+                {
+                for (unsigned int i = 0; i < 6; ++i)
+                    h_virial.data[i*m_virial_pitch+central_idx] = virial_sum[i];
+                }
+            }
         }
     }
 
@@ -924,24 +1140,19 @@ void ForceComposite::computeForces(unsigned int timestep)
 
 void ForceComposite::updateCompositeParticles(unsigned int timestep)
     {
-    // access molecule order (this needs to be on top because of ArrayHandle scope)
-    ArrayHandle<unsigned int> h_molecule_order(getMoleculeOrder(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_molecule_len(getMoleculeLengths(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_molecule_idx(getMoleculeIndex(), access_location::host, access_mode::read);
+    // rebuild the body layout if particles have been reordered
+    checkParticlesSorted();
+    unsigned int nbody = m_body_constituent_idx.getH();
+
+    ArrayHandle<uint2> h_body_header(m_body_header, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body_constituents(m_body_constituents, access_location::host, access_mode::read);
 
     // access the particle data arrays
     ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
     ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
     ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
 
-    /*
-    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
-    */
-
     ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
 
     // access body positions and orientations
     ArrayHandle<Scalar3> h_body_pos(m_body_pos, access_location::host, access_mode::read);
@@ -951,36 +1162,34 @@ void ForceComposite::updateCompositeParticles(unsigned int timestep)
     const BoxDim& box = m_pdata->getBox();
     const BoxDim& global_box = m_pdata->getGlobalBox();
 
-    // we need to update both local and ghost particles
-    unsigned int nptl = m_pdata->getN() + m_pdata->getNGhosts();
+    unsigned int N = m_pdata->getN();
 
-    for (unsigned int iptl = 0; iptl < nptl; iptl++)
+    // we need to update both local and ghost particles
+    for (unsigned int ibody = 0; ibody < nbody; ibody++)
         {
-        unsigned int central_tag = h_body.data[iptl];
-
-        if (central_tag >= MIN_FLOPPY)
-            continue;
-
-        // body tag equals tag for central ptl
-        assert(central_tag <= m_pdata->getMaximumTag());
-        unsigned int central_idx = h_rtag.data[central_tag];
-
-        if (central_idx == NOT_LOCAL && iptl >= m_pdata->getN())
-            continue;
+        unsigned int central_idx = h_body_header.data[ibody].x;
+        unsigned int n_constituents = h_body_header.data[ibody].y;
+        const unsigned int *constituents = h_body_constituents.data + m_body_constituent_idx(0, ibody);
 
         if (central_idx == NOT_LOCAL)
             {
-            m_exec_conf->msg->errorAllRanks() << "constrain.rigid(): Missing central particle tag " << central_tag
-                                              << "!" << std::endl << std::endl;
-            throw std::runtime_error("Error updating composite particles.\n");
+            // if the body has local members, this is an error, otherwise we must ignore it
+            for (unsigned int jptl = 0; jptl < n_constituents; ++jptl)
+                {
+                if (constituents[jptl] < N)
+                    {
+                    m_exec_conf->msg->errorAllRanks() << "constrain.rigid(): Missing central particle tag "
+                                                      << h_body.data[constituents[jptl]] << "!" << std::endl
+                                                      << std::endl;
+                    throw std::runtime_error("Error updating composite particles.\n");
+                    }
+                }
+            continue;
             }
 
         // central ptl position and orientation
         assert(central_idx <= m_pdata->getN() + m_pdata->getNGhosts());
 
-        // do not overwrite the central ptl
-        if (iptl == central_idx) continue;
-
         Scalar4 postype = h_postype.data[central_idx];
         vec3<Scalar> pos(postype);
         quat<Scalar> orientation(h_orientation.data[central_idx]);
@@ -988,47 +1197,49 @@ void ForceComposite::updateCompositeParticles(unsigned int timestep)
         // body type
         unsigned int type = __scalar_as_int(postype.w);
 
-        unsigned int body_len = h_body_len.data[type];
-        unsigned int mol_idx = h_molecule_idx.data[iptl];
-        if (body_len != h_molecule_len.data[mol_idx] - 1)
+        if (h_body_len.data[type] != n_constituents)
             {
-            if (iptl < m_pdata->getN())
+            // if the body is incomplete and has local members, this is an error, otherwise we must ignore it
+            for (unsigned int jptl = 0; jptl < n_constituents; ++jptl)
                 {
-                // if the molecule is incomplete and has local members, this is an error
-                m_exec_conf->msg->errorAllRanks() << "constrain.rigid(): Composite particle with body tag "
-                                                  << central_tag << " incomplete" << std::endl << std::endl;
-                throw std::runtime_error("Error while updating constituent particles.\n");
+                if (constituents[jptl] < N)
+                    {
+                    m_exec_conf->msg->errorAllRanks() << "constrain.rigid(): Composite particle with body tag "
+                                                      << h_body.data[central_idx] << " incomplete" << std::endl
+                                                      << std::endl;
+                    throw std::runtime_error("Error while updating constituent particles.\n");
+                    }
                 }
-
-            // otherwise we must ignore it
             continue;
             }
 
         int3 img = h_image.data[central_idx];
 
-        // fetch relative index in body from molecule list
-        assert(h_molecule_order.data[iptl] > 0);
-        unsigned int idx_in_body = h_molecule_order.data[iptl] - 1;
+        for (unsigned int jptl = 0; jptl < n_constituents; ++jptl)
+            {
+            unsigned int iptl = constituents[jptl];
+            assert(iptl != central_idx);
 
-        vec3<Scalar> local_pos(h_body_pos.data[m_body_idx(type,idx_in_body)]);
-        vec3<Scalar> dr_space = rotate(orientation, local_pos);
+            vec3<Scalar> local_pos(h_body_pos.data[m_body_idx(type,jptl)]);
+            vec3<Scalar> dr_space = rotate(orientation, local_pos);
 
-        // update position and orientation
-        vec3<Scalar> updated_pos(pos);
-        quat<Scalar> local_orientation(h_body_orientation.data[m_body_idx(type, idx_in_body)]);
+            // update position and orientation
+            vec3<Scalar> updated_pos(pos);
+            quat<Scalar> local_orientation(h_body_orientation.data[m_body_idx(type, jptl)]);
 
-        updated_pos += dr_space;
-        quat<Scalar> updated_orientation = orientation*local_orientation;
+            updated_pos += dr_space;
+            quat<Scalar> updated_orientation = orientation*local_orientation;
 
-        // this runs before the ForceComputes,
-        // wrap into box, allowing rigid bodies to span multiple images
-        int3 imgi = box.getImage(vec_to_scalar3(updated_pos));
-        int3 negimgi = make_int3(-imgi.x,-imgi.y,-imgi.z);
-        updated_pos = global_box.shift(updated_pos, negimgi);
+            // this runs before the ForceComputes,
+            // wrap into box, allowing rigid bodies to span multiple images
+            int3 imgi = box.getImage(vec_to_scalar3(updated_pos));
+            int3 negimgi = make_int3(-imgi.x,-imgi.y,-imgi.z);
+            updated_pos = global_box.shift(updated_pos, negimgi);
 
-        h_postype.data[iptl] = make_scalar4(updated_pos.x, updated_pos.y, updated_pos.z, h_postype.data[iptl].w);
-        h_orientation.data[iptl] = quat_to_scalar4(updated_orientation);
-        h_image.data[iptl] = img+imgi;
+            h_postype.data[iptl] = make_scalar4(updated_pos.x, updated_pos.y, updated_pos.z, h_postype.data[iptl].w);
+            h_orientation.data[iptl] = quat_to_scalar4(updated_orientation);
+            h_image.data[iptl] = img+imgi;
+            }
         }
     }
 
@@ -1038,5 +1249,6 @@ void export_ForceComposite(py::module& m)
         .def(py::init< std::shared_ptr<SystemDefinition> >())
         .def("setParam", &ForceComposite::setParam)
         .def("validateRigidBodies", &ForceComposite::validateRigidBodies)
+        .def_property("center_ghosts", &ForceComposite::getCenterGhosts, &ForceComposite::setCenterGhosts)
     ;
     }
@@ -17,6 +17,18 @@
 
     The particle data body tag is equal to the tag of central particle, and therefore not-contiguous.
     The molecule/body id can therefore be used to look up the central particle easily.
+
+    Each time the molecule list is rebuilt after particles are reordered, ForceComposite also builds a body-major
+    layout of the local bodies: the index of the central particle and the number of constituents of every body, and
+    the indices of its constituent particles stored contiguously in the order of the body definition. The force sum
+    and the constituent update loop over bodies in this layout and do not look up the central particle or the
+    position of a particle in its body every step.
+
+    With MPI, setCenterGhosts() selects the body center ghost mode of the Communicator on the CPU: only the central
+    particles are sent as non-bonded ghosts, and addGhostConstituents() appends the constituents that are not present
+    on this rank to the ghost particles, at the positions given by the central particle. Every rank then sums the
+    forces of its local constituents onto the central particles, also the ghost ones, and
+    Communicator::reduceGhostBodyForces() adds the sums on the ghost central particles to their owners.
 */
 
 #ifdef __HIPCC__
@@ -73,6 +85,17 @@ class PYBIND11_EXPORT ForceComposite : public MolecularForceCompute
          */
         virtual void validateRigidBodies(bool create=false);
 
+        //! Set the body center ghost mode
+        /*! \param enable If true, communicate only the central particles as ghosts and rebuild the constituents
+         */
+        void setCenterGhosts(bool enable);
+
+        //! Get the body center ghost mode
+        bool getCenterGhosts()
+            {
+            return m_center_ghosts;
+            }
+
     protected:
         bool m_bodies_changed;          //!< True if constituent particles have changed
         bool m_ptls_added_removed;      //!< True if particles have been added or removed
@@ -86,6 +109,14 @@ class PYBIND11_EXPORT ForceComposite : public MolecularForceCompute
         std::vector<std::vector<Scalar> > m_body_diameter;    //!< Constituent ptl diameters
         Index2D m_body_idx;                     //!< Indexer for body parameters
 
+        GlobalVector<uint2> m_body_header;              //!< Central ptl index and number of constituents per body
+        GlobalVector<unsigned int> m_body_constituents; //!< Constituent ptl indices per body in definition order (2D)
+        Index2D m_body_constituent_idx;                 //!< Indexer for the constituent list
+
+        std::vector<unsigned int> m_body_tag_head;      //!< Start of the member tags of every body in m_body_tags
+        std::vector<unsigned int> m_body_tags;          //!< Member tags per body in tag order, central ptl first
+        bool m_center_ghosts;                           //!< True if only central particles are sent as ghosts
+
         std::vector<Scalar> m_d_max;                              //!< Maximum body diameter per constituent particle type
         std::vector<bool> m_d_max_changed;                        //!< True if maximum body diameter changed (per type)
         std::vector<Scalar> m_body_max_diameter;                  //!< List of diameters for all body types
@@ -142,14 +173,38 @@ class PYBIND11_EXPORT ForceComposite : public MolecularForceCompute
                 {
                 // register this class with the communicator
                 m_comm->getExtraGhostLayerWidthRequestSignal().connect<ForceComposite, &ForceComposite::requestExtraGhostLayerWidth>(this);
+                m_comm->getGhostConstituentsRequestSignal().connect<ForceComposite, &ForceComposite::addGhostConstituents>(this);
                 m_comm_ghost_layer_connected = true;
                 }
+
+            if (m_center_ghosts)
+                m_comm->setBodyCenterGhosts(true);
            }
+
+        //! Append the missing constituents of the present central particles to the ghost particles
+        virtual void addGhostConstituents();
         #endif
 
         //! Compute the forces and torques on the central particle
         virtual void computeForces(unsigned int timestep);
 
+        //! Sum the forces and torques of the constituents onto the central particles
+        void sumConstituentForces();
+
+        //! Helper function to check if particles have been sorted and rebuild indices if necessary
+        virtual void checkParticlesSorted()
+            {
+            bool dirty = m_dirty;
+
+            MolecularForceCompute::checkParticlesSorted();
+
+            if (dirty)
+                initBodyLayout();
+            }
+
+        //! Build the body-major constituent layout from the molecule list
+        virtual void initBodyLayout();
+
         //! Helper method to calculate the body diameter
         Scalar getBodyDiameter(unsigned int body_type);
 
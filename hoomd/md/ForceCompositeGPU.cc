@@ -48,6 +48,7 @@ ForceCompositeGPU::ForceCompositeGPU(std::shared_ptr<SystemDefinition> sysdef)
         valid_params_update.push_back(block_size);
 
     m_tuner_update.reset(new Autotuner(valid_params_update, 5, 100000, "update_composite", this->m_exec_conf));
+    m_tuner_layout.reset(new Autotuner(valid_params_update, 5, 100000, "init_body_layout", this->m_exec_conf));
 
     GlobalArray<uint2> flag(1, m_exec_conf);
     std::swap(m_flag, flag);
@@ -261,12 +262,11 @@ void ForceCompositeGPU::updateCompositeParticles(unsigned int timestep)
     if (m_prof)
         m_prof->push(m_exec_conf, "update");
 
-    // access molecule order
-    const GlobalArray<unsigned int>& molecule_length = getMoleculeLengths();
+    // rebuild the body layout if particles have been reordered
+    checkParticlesSorted();
 
-    ArrayHandle<unsigned int> d_molecule_order(getMoleculeOrder(), access_location::device, access_mode::read);
-    ArrayHandle<unsigned int> d_molecule_len(molecule_length, access_location::device, access_mode::read);
-    ArrayHandle<unsigned int> d_molecule_idx(getMoleculeIndex(), access_location::device, access_mode::read);
+    ArrayHandle<uint2> d_body_header(m_body_header, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_body_constituents(m_body_constituents, access_location::device, access_mode::read);
 
     // access the particle data arrays
     ArrayHandle<Scalar4> d_postype(m_pdata->getPositions(), access_location::device, access_mode::readwrite);
@@ -278,9 +278,6 @@ void ForceCompositeGPU::updateCompositeParticles(unsigned int timestep)
     ArrayHandle<Scalar4> d_body_orientation(m_body_orientation, access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_body_len(m_body_len, access_location::device, access_mode::read);
 
-    // lookup table
-    ArrayHandle<unsigned int> d_lookup_center(m_lookup_center, access_location::device, access_mode::read);
-
         {
         ArrayHandle<uint2> d_flag(m_flag, access_location::device, access_mode::overwrite);
 
@@ -290,23 +287,21 @@ void ForceCompositeGPU::updateCompositeParticles(unsigned int timestep)
         unsigned int block_size = m_tuner_update->getParam();
 
         gpu_update_composite(m_pdata->getN(),
-            m_pdata->getNGhosts(),
+            d_body_header.data,
+            d_body_constituents.data,
+            m_body_constituent_idx,
             d_postype.data,
             d_orientation.data,
             m_body_idx,
-            d_lookup_center.data,
             d_body_pos.data,
             d_body_orientation.data,
             d_body_len.data,
-            d_molecule_order.data,
-            d_molecule_len.data,
-            d_molecule_idx.data,
             d_image.data,
             m_pdata->getBox(),
             m_pdata->getGlobalBox(),
             block_size,
             d_flag.data,
-            m_pdata->getGPUPartition());
+            m_body_gpu_partition);
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
@@ -358,34 +353,18 @@ void ForceCompositeGPU::updateCompositeParticles(unsigned int timestep)
 void ForceCompositeGPU::findRigidCenters()
     {
     ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
-    ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(), access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_body(m_pdata->getBodies(), access_location::device, access_mode::read);
 
     m_rigid_center.resize(m_pdata->getN()+m_pdata->getNGhosts());
 
-    size_t old_size = m_lookup_center.getNumElements();
-    m_lookup_center.resize(m_pdata->getN()+m_pdata->getNGhosts());
-
-    #ifdef __HIP_PLATFORM_NVCC__
-    if (m_exec_conf->allConcurrentManagedAccess() && m_lookup_center.getNumElements() != old_size)
-        {
-        // set memory hints
-        cudaMemAdvise(m_lookup_center.get(), sizeof(unsigned int)*m_lookup_center.getNumElements(), cudaMemAdviseSetReadMostly, 0);
-        CHECK_CUDA_ERROR();
-        }
-    #endif
-
     ArrayHandle<unsigned int> d_rigid_center(m_rigid_center, access_location::device, access_mode::overwrite);
-    ArrayHandle<unsigned int> d_lookup_center(m_lookup_center, access_location::device, access_mode::overwrite);
 
     unsigned int n_rigid = 0;
     gpu_find_rigid_centers(d_body.data,
                         d_tag.data,
-                        d_rtag.data,
                         m_pdata->getN(),
                         m_pdata->getNGhosts(),
                         d_rigid_center.data,
-                        d_lookup_center.data,
                         n_rigid);
 
     // distribute rigid body centers over GPUs
@@ -393,6 +372,66 @@ void ForceCompositeGPU::findRigidCenters()
     m_gpu_partition.setN(n_rigid);
     }
 
+void ForceCompositeGPU::initBodyLayout()
+    {
+    if (m_prof) m_prof->push(m_exec_conf, "init body layout");
+
+    const Index2D& molecule_indexer = getMoleculeIndexer();
+    unsigned int nmol = molecule_indexer.getH();
+
+    m_body_constituent_idx = Index2D(molecule_indexer.getW(), nmol);
+
+    size_t old_size = m_body_header.getNumElements();
+    m_body_header.resize(nmol);
+    m_body_constituents.resize(m_body_constituent_idx.getNumElements());
+
+    #ifdef __HIP_PLATFORM_NVCC__
+    if (m_exec_conf->allConcurrentManagedAccess() && m_body_header.getNumElements() != old_size)
+        {
+        // set memory hints
+        cudaMemAdvise(m_body_header.get(), sizeof(uint2)*m_body_header.getNumElements(), cudaMemAdviseSetReadMostly, 0);
+        cudaMemAdvise(m_body_constituents.get(), sizeof(unsigned int)*m_body_constituents.getNumElements(),
+            cudaMemAdviseSetReadMostly, 0);
+        CHECK_CUDA_ERROR();
+        }
+    #endif
+
+        {
+        ArrayHandle<unsigned int> d_molecule_length(getMoleculeLengths(), access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_molecule_list(getMoleculeList(), access_location::device, access_mode::read);
+
+        ArrayHandle<unsigned int> d_body(m_pdata->getBodies(), access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(), access_location::device, access_mode::read);
+
+        ArrayHandle<uint2> d_body_header(m_body_header, access_location::device, access_mode::overwrite);
+        ArrayHandle<unsigned int> d_body_constituents(m_body_constituents, access_location::device,
+            access_mode::overwrite);
+
+        m_tuner_layout->begin();
+        gpu_init_body_layout(nmol,
+            m_pdata->getN() + m_pdata->getNGhosts(),
+            d_molecule_length.data,
+            d_molecule_list.data,
+            molecule_indexer,
+            d_body.data,
+            d_rtag.data,
+            d_body_header.data,
+            d_body_constituents.data,
+            m_body_constituent_idx,
+            m_tuner_layout->getParam());
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_layout->end();
+        }
+
+    // distribute bodies over GPUs
+    m_body_gpu_partition = GPUPartition(m_exec_conf->getGPUIds());
+    m_body_gpu_partition.setN(nmol);
+
+    if (m_prof) m_prof->pop(m_exec_conf);
+    }
+
 void ForceCompositeGPU::lazyInitMem()
     {
     bool initialized = m_memory_initialized;
@@ -405,10 +444,6 @@ void ForceCompositeGPU::lazyInitMem()
         GlobalVector<unsigned int> rigid_center(m_exec_conf);
         m_rigid_center.swap(rigid_center);
         TAG_ALLOCATION(m_rigid_center);
-
-        GlobalVector<unsigned int> lookup_center(m_exec_conf);
-        m_lookup_center.swap(lookup_center);
-        TAG_ALLOCATION(m_lookup_center);
         }
 
     #ifdef __HIP_PLATFORM_NVCC__
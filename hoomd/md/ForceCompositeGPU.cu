@@ -620,67 +620,64 @@ hipError_t gpu_rigid_virial(Scalar* d_virial,
     }
 
 
+//! Update the constituent particles of the rigid bodies, one thread per constituent slot in the body layout
 __global__ void gpu_update_composite_kernel(unsigned int N,
     unsigned int nwork,
     unsigned int offset,
-    unsigned int n_ghost,
-    const unsigned int *d_lookup_center,
+    const uint2 *d_body_header,
+    const unsigned int *d_body_constituents,
+    Index2D constituent_indexer,
     Scalar4 *d_postype,
     Scalar4 *d_orientation,
     Index2D body_indexer,
     const Scalar3 *d_body_pos,
     const Scalar4 *d_body_orientation,
     const unsigned int *d_body_len,
-    const unsigned int *d_molecule_order,
-    const unsigned int *d_molecule_len,
-    const unsigned int *d_molecule_idx,
     int3 *d_image,
     const BoxDim box,
     const BoxDim global_box,
     uint2 *d_flag)
     {
-
     unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
 
-    if (idx >= nwork)
+    unsigned int width = constituent_indexer.getW();
+    if (idx >= nwork*width)
         return;
 
-    idx += offset;
+    unsigned int ibody = idx / width + offset;
+    unsigned int idx_in_body = idx % width;
 
-    unsigned int central_idx = d_lookup_center[idx];
-    if (central_idx == NO_BODY)
+    uint2 header = d_body_header[ibody];
+    if (idx_in_body >= header.y)
         return;
 
-    if (central_idx >= N + n_ghost)
+    unsigned int iptl = d_body_constituents[constituent_indexer(idx_in_body, ibody)];
+    unsigned int central_idx = header.x;
+
+    if (central_idx == NOT_LOCAL)
         {
         // if a molecule with a local member has no central particle, error out
-        if (idx < N)
+        if (iptl < N)
             {
-            atomicMax(&(d_flag->x), idx+1);
+            atomicMax(&(d_flag->x), iptl+1);
             }
 
         // otherwise, ignore
         return;
         }
 
-    // do not overwrite central ptl
-    if (idx == central_idx) return;
-
     Scalar4 postype = d_postype[central_idx];
     vec3<Scalar> pos(postype);
     quat<Scalar> orientation(d_orientation[central_idx]);
 
     unsigned int body_type = __scalar_as_int(postype.w);
 
-    unsigned int body_len = d_body_len[body_type];
-    unsigned int mol_idx = d_molecule_idx[idx];
-
-    if (body_len != d_molecule_len[mol_idx]-1)
+    if (d_body_len[body_type] != header.y)
         {
         // if a molecule with a local member is incomplete, this is an error
-        if (idx < N)
+        if (iptl < N)
             {
-            atomicMax(&(d_flag->y), idx+1);
+            atomicMax(&(d_flag->y), iptl+1);
             }
 
         // otherwise, ignore
@@ -689,8 +686,6 @@ __global__ void gpu_update_composite_kernel(unsigned int N,
 
     int3 img = d_image[central_idx];
 
-    unsigned int idx_in_body = d_molecule_order[idx] - 1;
-
     vec3<Scalar> local_pos(d_body_pos[body_indexer(body_type, idx_in_body)]);
     vec3<Scalar> dr_space = rotate(orientation, local_pos);
 
@@ -706,25 +701,23 @@ __global__ void gpu_update_composite_kernel(unsigned int N,
     int3 negimgi = make_int3(-imgi.x,-imgi.y,-imgi.z);
     updated_pos = global_box.shift(updated_pos, negimgi);
 
-    unsigned int type = __scalar_as_int(d_postype[idx].w);
+    unsigned int type = __scalar_as_int(d_postype[iptl].w);
 
-    d_postype[idx] = make_scalar4(updated_pos.x, updated_pos.y, updated_pos.z, __int_as_scalar(type));
-    d_orientation[idx] = quat_to_scalar4(updated_orientation);
-    d_image[idx] = img+imgi;
+    d_postype[iptl] = make_scalar4(updated_pos.x, updated_pos.y, updated_pos.z, __int_as_scalar(type));
+    d_orientation[iptl] = quat_to_scalar4(updated_orientation);
+    d_image[iptl] = img+imgi;
     }
 
 void gpu_update_composite(unsigned int N,
-    unsigned int n_ghost,
+    const uint2 *d_body_header,
+    const unsigned int *d_body_constituents,
+    Index2D constituent_indexer,
     Scalar4 *d_postype,
     Scalar4 *d_orientation,
     Index2D body_indexer,
-    const unsigned int *d_lookup_center,
     const Scalar3 *d_body_pos,
     const Scalar4 *d_body_orientation,
     const unsigned int *d_body_len,
-    const unsigned int *d_molecule_order,
-    const unsigned int *d_molecule_len,
-    const unsigned int *d_molecule_idx,
     int3 *d_image,
     const BoxDim box,
     const BoxDim global_box,
@@ -753,26 +746,24 @@ void gpu_update_composite(unsigned int N,
         auto range = gpu_partition.getRangeAndSetGPU(idev);
 
         unsigned int nwork = range.second - range.first;
+        unsigned int nthreads = nwork*constituent_indexer.getW();
 
-        // process ghosts in final range
-        if (idev == (int)gpu_partition.getNumActiveGPUs()-1)
-            nwork += n_ghost;
+        if (nthreads == 0)
+            continue;
 
-        unsigned int n_blocks = nwork/run_block_size + 1;
+        unsigned int n_blocks = nthreads/run_block_size + 1;
         hipLaunchKernelGGL((gpu_update_composite_kernel), dim3(n_blocks), dim3(run_block_size), 0, 0, N,
             nwork,
             range.first,
-            n_ghost,
-            d_lookup_center,
+            d_body_header,
+            d_body_constituents,
+            constituent_indexer,
             d_postype,
             d_orientation,
             body_indexer,
             d_body_pos,
             d_body_orientation,
             d_body_len,
-            d_molecule_order,
-            d_molecule_len,
-            d_molecule_idx,
             d_image,
             box,
             global_box,
@@ -780,37 +771,108 @@ void gpu_update_composite(unsigned int N,
         }
     }
 
-struct is_center
+//! Build the body-major constituent layout from the molecule list, one thread per molecule
+__global__ void gpu_init_body_layout_kernel(unsigned int n_mol,
+    unsigned int nptl_local,
+    const unsigned int *d_molecule_len,
+    const unsigned int *d_molecule_list,
+    Index2D molecule_indexer,
+    const unsigned int *d_body,
+    const unsigned int *d_rtag,
+    uint2 *d_body_header,
+    unsigned int *d_body_constituents,
+    Index2D constituent_indexer)
     {
-    __host__ __device__
-    bool operator()(const thrust::tuple<unsigned int, unsigned int>& t)
+    unsigned int ibody = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (ibody >= n_mol)
+        return;
+
+    unsigned int len = d_molecule_len[ibody];
+    unsigned int central_tag = d_body[d_molecule_list[molecule_indexer(0, ibody)]];
+
+    if (central_tag >= MIN_FLOPPY)
         {
-        return t.get<0>() == t.get<1>();
+        // not a rigid body
+        d_body_header[ibody] = make_uint2(NOT_LOCAL, 0);
+        return;
         }
-    };
 
-// create a lookup table ptl idx -> center idx
-struct lookup_op : thrust::unary_function<unsigned int, unsigned int>
+    // the central ptl has the lowest tag and comes first in the molecule
+    unsigned int central_idx = d_rtag[central_tag];
+    unsigned int first = 1;
+    if (central_idx >= nptl_local)
+        {
+        central_idx = NOT_LOCAL;
+        first = 0;
+        }
+
+    d_body_header[ibody] = make_uint2(central_idx, len - first);
+    for (unsigned int k = first; k < len; ++k)
+        {
+        d_body_constituents[constituent_indexer(k - first, ibody)] = d_molecule_list[molecule_indexer(k, ibody)];
+        }
+    }
+
+hipError_t gpu_init_body_layout(unsigned int n_mol,
+    unsigned int nptl_local,
+    const unsigned int *d_molecule_len,
+    const unsigned int *d_molecule_list,
+    Index2D molecule_indexer,
+    const unsigned int *d_body,
+    const unsigned int *d_rtag,
+    uint2 *d_body_header,
+    unsigned int *d_body_constituents,
+    Index2D constituent_indexer,
+    unsigned int block_size)
     {
-    __host__ __device__ lookup_op(const unsigned int *_d_rtag)
-        : d_rtag(_d_rtag) {}
+    if (n_mol == 0)
+        return hipSuccess;
+
+    unsigned int run_block_size = block_size;
 
-    __device__ unsigned int operator()(const unsigned int& body)
+    static unsigned int max_block_size = UINT_MAX;
+    static hipFuncAttributes attr;
+    if (max_block_size == UINT_MAX)
         {
-        return (body < MIN_FLOPPY) ? d_rtag[body] : NO_BODY;
+        hipFuncGetAttributes(&attr, (const void *) gpu_init_body_layout_kernel);
+        max_block_size = attr.maxThreadsPerBlock;
         }
 
-    const unsigned int *d_rtag;
-    };
+    if (max_block_size <= run_block_size)
+        {
+        run_block_size = max_block_size;
+        }
 
+    unsigned int n_blocks = n_mol/run_block_size + 1;
+    hipLaunchKernelGGL((gpu_init_body_layout_kernel), dim3(n_blocks), dim3(run_block_size), 0, 0, n_mol,
+        nptl_local,
+        d_molecule_len,
+        d_molecule_list,
+        molecule_indexer,
+        d_body,
+        d_rtag,
+        d_body_header,
+        d_body_constituents,
+        constituent_indexer);
+
+    return hipSuccess;
+    }
+
+struct is_center
+    {
+    __host__ __device__
+    bool operator()(const thrust::tuple<unsigned int, unsigned int>& t)
+        {
+        return t.get<0>() == t.get<1>();
+        }
+    };
 
 hipError_t gpu_find_rigid_centers(const unsigned int *d_body,
                                 const unsigned int *d_tag,
-                                const unsigned int *d_rtag,
                                 const unsigned int N,
                                 const unsigned int nghost,
                                 unsigned int *d_rigid_center,
-                                unsigned int *d_lookup_center,
                                 unsigned int &n_rigid)
     {
     thrust::device_ptr<const unsigned int> body(d_body);
@@ -827,11 +889,5 @@ hipError_t gpu_find_rigid_centers(const unsigned int *d_body,
 
     n_rigid = (unsigned int)(it - rigid_center);
 
-    thrust::device_ptr<unsigned int> lookup_center(d_lookup_center);
-    thrust::transform(body,
-        body + N + nghost,
-        lookup_center,
-        lookup_op(d_rtag));
-
     return hipSuccess;
     }
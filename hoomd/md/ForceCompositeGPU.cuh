@@ -63,17 +63,15 @@ hipError_t gpu_rigid_virial(Scalar* d_virial,
 
 
 void gpu_update_composite(unsigned int N,
-    unsigned int n_ghost,
+    const uint2 *d_body_header,
+    const unsigned int *d_body_constituents,
+    Index2D constituent_indexer,
     Scalar4 *d_postype,
     Scalar4 *d_orientation,
     Index2D body_indexer,
-    const unsigned int *d_lookup_center,
     const Scalar3 *d_body_pos,
     const Scalar4 *d_body_orientation,
     const unsigned int *d_body_len,
-    const unsigned int *d_molecule_order,
-    const unsigned int *d_molecule_len,
-    const unsigned int *d_molecule_idx,
     int3 *d_image,
     const BoxDim box,
     const BoxDim global_box,
@@ -81,12 +79,21 @@ void gpu_update_composite(unsigned int N,
     uint2 *d_flag,
     const GPUPartition &gpu_partition);
 
+hipError_t gpu_init_body_layout(unsigned int n_mol,
+    unsigned int nptl_local,
+    const unsigned int *d_molecule_len,
+    const unsigned int *d_molecule_list,
+    Index2D molecule_indexer,
+    const unsigned int *d_body,
+    const unsigned int *d_rtag,
+    uint2 *d_body_header,
+    unsigned int *d_body_constituents,
+    Index2D constituent_indexer,
+    unsigned int block_size);
 
 hipError_t gpu_find_rigid_centers(const unsigned int *d_body,
                                 const unsigned int *d_tag,
-                                const unsigned int *d_rtag,
                                 const unsigned int N,
                                 const unsigned int nghost,
                                 unsigned int *d_rigid_center,
-                                unsigned int *d_lookup_center,
                                 unsigned int &n_rigid);
@@ -55,6 +55,9 @@ class PYBIND11_EXPORT ForceCompositeGPU : public ForceComposite
 
             m_tuner_update->setPeriod(period);
             m_tuner_update->setEnabled(enable);
+
+            m_tuner_layout->setPeriod(period);
+            m_tuner_layout->setEnabled(enable);
             }
 
 
@@ -70,25 +73,29 @@ class PYBIND11_EXPORT ForceCompositeGPU : public ForceComposite
             {
             bool dirty = m_dirty;
 
-            MolecularForceCompute::checkParticlesSorted();
+            ForceComposite::checkParticlesSorted();
 
             if (dirty)
                 // identify center particles for use in GPU kernel
                 findRigidCenters();
             }
 
+        //! Build the body-major constituent layout on the GPU
+        virtual void initBodyLayout();
+
         //! Update GPU Mappings
         virtual void lazyInitMem();
 
         std::unique_ptr<Autotuner> m_tuner_force;  //!< Autotuner for block size and threads per particle
         std::unique_ptr<Autotuner> m_tuner_virial; //!< Autotuner for block size and threads per particle
         std::unique_ptr<Autotuner> m_tuner_update; //!< Autotuner for block size of update kernel
+        std::unique_ptr<Autotuner> m_tuner_layout; //!< Autotuner for block size of the body layout kernel
 
         GlobalArray<uint2> m_flag;                 //!< Flag to read out error condition
 
         GPUPartition m_gpu_partition;               //!< Partition of the rigid bodies
         GlobalVector<unsigned int> m_rigid_center;  //!< Contains particle indices of all central particles
-        GlobalVector<unsigned int> m_lookup_center; //!< Lookup particle index -> central particle index
+        GPUPartition m_body_gpu_partition;          //!< Partition of the body layout
     };
 
 //! Exports the ForceCompositeGPU to python
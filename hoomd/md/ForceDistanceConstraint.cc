@@ -20,8 +20,8 @@ ForceDistanceConstraint::ForceDistanceConstraint(std::shared_ptr<SystemDefinitio
         : MolecularForceCompute(sysdef), m_cdata(m_sysdef->getConstraintData()),
           m_cmatrix(m_exec_conf), m_cvec(m_exec_conf), m_lagrange(m_exec_conf),
           m_rel_tol(1e-3), m_constraint_violated(m_exec_conf), m_condition(m_exec_conf),
-          m_sparse_idxlookup(m_exec_conf), m_constraint_reorder(true), m_constraints_added_removed(true),
-          m_d_max(0.0)
+          m_sparse_idxlookup(m_exec_conf), m_iterative(false), m_solver_tol(1e-8), m_max_iterations(100),
+          m_warm_start(false), m_constraint_reorder(true), m_constraints_added_removed(true), m_d_max(0.0)
     {
     m_constraint_violated.resetFlags(0);
 
@@ -311,6 +311,10 @@ void ForceDistanceConstraint::solveConstraints(unsigned int timestep)
     if (m_prof)
         m_prof->push("solve");
 
+    // the previous solution is only a useful starting point for the same constraints
+    if (m_lagrange.size() != n_constraint)
+        m_warm_start = false;
+
     // reallocate array of constraint forces
     m_lagrange.resize(n_constraint);
 
@@ -370,12 +374,57 @@ void ForceDistanceConstraint::solveConstraints(unsigned int timestep)
             }
 
         // Compute the ordering permutation vector from the structural pattern of A
-        m_sparse_solver.analyzePattern(m_sparse);
+        if (m_iterative)
+            m_iterative_solver.analyzePattern(m_sparse);
+        else
+            m_sparse_solver.analyzePattern(m_sparse);
 
         if (m_prof)
             m_prof->pop();
         }
 
+    if (m_iterative)
+        {
+        if (m_prof)
+            m_prof->push("iterate");
+
+        // update the preconditioner
+        m_iterative_solver.setTolerance(m_solver_tol);
+        m_iterative_solver.setMaxIterations(m_max_iterations);
+        m_iterative_solver.factorize(m_sparse);
+
+        ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::read);
+        ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::readwrite);
+        vec_map_t map_vec(h_cvec.data, n_constraint, 1);
+        vec_map_t map_lagrange(h_lagrange.data,n_constraint, 1);
+
+        // start from the previous solution
+        if (m_warm_start)
+            map_lagrange = m_iterative_solver.solveWithGuess(map_vec, map_lagrange);
+        else
+            map_lagrange = m_iterative_solver.solve(map_vec);
+
+        bool converged = m_iterative_solver.info() == Success;
+        m_warm_start = converged;
+
+        if (m_prof)
+            m_prof->pop();
+
+        if (converged)
+            {
+            if (m_prof)
+                m_prof->pop();
+            return;
+            }
+
+        m_exec_conf->msg->notice(2) << "ForceDistanceConstraint: iterative solver did not converge after "
+            << m_iterative_solver.iterations() << " iterations (relative residual " << m_iterative_solver.error()
+            << "). Solving with LU" << std::endl;
+
+        // fall back on the LU decomposition for this step
+        m_sparse_solver.analyzePattern(m_sparse);
+        }
+
 
     if (m_prof)
         m_prof->push("refactor/solve");
@@ -629,5 +678,10 @@ void export_ForceDistanceConstraint(py::module& m)
     py::class_< ForceDistanceConstraint, MolecularForceCompute, std::shared_ptr<ForceDistanceConstraint> >(m, "ForceDistanceConstraint")
         .def(py::init< std::shared_ptr<SystemDefinition> >())
         .def("setRelativeTolerance", &ForceDistanceConstraint::setRelativeTolerance)
+        .def_property("iterative", &ForceDistanceConstraint::getIterative, &ForceDistanceConstraint::setIterative)
+        .def_property("solver_tol", &ForceDistanceConstraint::getSolverTolerance,
+                      &ForceDistanceConstraint::setSolverTolerance)
+        .def_property("max_iterations", &ForceDistanceConstraint::getMaxIterations,
+                      &ForceDistanceConstraint::setMaxIterations)
     ;
     }
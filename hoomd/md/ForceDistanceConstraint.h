@@ -24,12 +24,20 @@
 
 #include <Eigen/Dense>
 #include <Eigen/SparseLU>
+#include <Eigen/IterativeLinearSolvers>
 
 /*! Implements a pairwise distance constraint using the algorithm of
 
     [1] M. Yoneya, H. J. C. Berendsen, and K. Hirasawa, “A Non-Iterative Matrix Method for Constraint Molecular Dynamics Simulations,” Mol. Simul., vol. 13, no. 6, pp. 395–405, 1994.
     [2] M. Yoneya, “A Generalized Non-iterative Matrix Method for Constraint Molecular Dynamics Simulations,” J. Comput. Phys., vol. 172, no. 1, pp. 188–197, Sep. 2001.
 
+    The sparse linear system for the Lagrange multipliers is factorized with a sparse LU decomposition every step,
+    reusing the symbolic analysis as long as the sparsity pattern is unchanged. Alternatively, setIterative() solves it
+    with a Jacobi preconditioned BiCGSTAB iteration (the matrix is not symmetric) that starts from the Lagrange
+    multipliers of the previous step. Since the multipliers change little between steps, the iteration converges in
+    a few sweeps for large, weakly coupled constraint networks, where the LU factorization dominates the cost. When the
+    iteration does not converge, the step falls back to the LU decomposition.
+
     See Integrator for detailed documentation on constraint force implementation.
     \ingroup computes
 */
@@ -54,6 +62,50 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
             m_rel_tol = rel_tol;
             }
 
+        //! Set whether to solve the constraint equation iteratively instead of with a LU decomposition
+        void setIterative(bool iterative)
+            {
+            if (iterative != m_iterative)
+                {
+                m_iterative = iterative;
+
+                // the solver needs its own analysis of the sparsity pattern
+                m_condition.resetFlags(1);
+                }
+            }
+
+        //! Get whether the constraint equation is solved iteratively
+        bool getIterative()
+            {
+            return m_iterative;
+            }
+
+        //! Set the relative residual at which the iterative solver stops
+        void setSolverTolerance(Scalar solver_tol)
+            {
+            if (solver_tol <= Scalar(0.0))
+                throw std::domain_error("The solver tolerance must be positive");
+            m_solver_tol = solver_tol;
+            }
+
+        //! Get the relative residual at which the iterative solver stops
+        Scalar getSolverTolerance()
+            {
+            return m_solver_tol;
+            }
+
+        //! Set the maximum number of iterations of the iterative solver
+        void setMaxIterations(unsigned int max_iterations)
+            {
+            m_max_iterations = max_iterations;
+            }
+
+        //! Get the maximum number of iterations of the iterative solver
+        unsigned int getMaxIterations()
+            {
+            return m_max_iterations;
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
@@ -78,6 +130,13 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
             //!< The persistent state of the sparse matrix solver
         GPUVector<int> m_sparse_idxlookup;          //!< Reverse lookup from column-major to sparse matrix element
 
+        bool m_iterative;                  //!< True if the constraint equation is solved iteratively
+        Scalar m_solver_tol;               //!< Relative residual at which the iterative solver stops
+        unsigned int m_max_iterations;     //!< Maximum number of iterations of the iterative solver
+        bool m_warm_start;                 //!< True if m_lagrange holds the previous solution in the current order
+        Eigen::BiCGSTAB<Eigen::SparseMatrix<double, Eigen::ColMajor>, Eigen::DiagonalPreconditioner<double> >
+            m_iterative_solver;            //!< The persistent state of the iterative solver
+
         bool m_constraint_reorder;         //!< True if groups have changed
         bool m_constraints_added_removed;  //!< True if global constraint topology has changed
 
@@ -102,12 +161,14 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
         virtual void slotConstraintReorder()
             {
             m_constraint_reorder = true;
+            m_warm_start = false;
             }
 
         //! Method called when constraint order changes
         virtual void slotConstraintsAddedRemoved()
             {
             m_constraints_added_removed = true;
+            m_warm_start = false;
             }
 
         //! Returns the requested ghost layer width for all types
@@ -127,7 +127,7 @@ void ForceDistanceConstraintGPU::fillMatrixVector(unsigned int timestep)
         ArrayHandle<double> d_cvec(m_cvec, access_location::device, access_mode::overwrite);
 
         // access GPU constraint table on device
-        const GPUArray<ConstraintData::members_t>& gpu_constraint_list = this->m_cdata->getGPUTable();
+        const GlobalArray<ConstraintData::members_t>& gpu_constraint_list = this->m_cdata->getGPUTable();
         const Index2D& gpu_table_indexer = this->m_cdata->getGPUTableIndexer();
 
         ArrayHandle<ConstraintData::members_t> d_gpu_clist(gpu_constraint_list, access_location::device, access_mode::read);
@@ -185,20 +185,32 @@ void ForceDistanceConstraintGPU::solveConstraints(unsigned int timestep)
     // ==1 if the sparsity pattern of the matrix changes (in particular if connectivity changes)
     unsigned int sparsity_pattern_changed = m_condition.readFlags();
 
-    #ifndef CUSOLVER_AVAILABLE
-    if (!sparsity_pattern_changed)
+    // the iterative solver always runs on the CPU
+    #ifdef CUSOLVER_AVAILABLE
+    bool solve_on_host = m_iterative;
+    #else
+    bool solve_on_host = true;
+    #endif
+
+    if (solve_on_host)
         {
-        // copy new sparse values to host sparse matrix
-        ArrayHandle<double> h_sparse_val(m_sparse_val, access_location::device, access_mode::read);
-        hipMemcpy(m_sparse.valuePtr(), h_sparse_val.data, sizeof(double)*m_sparse.data().size(),hipMemcpyDeviceToHost);
-        }
+        if (!sparsity_pattern_changed)
+            {
+            // copy new sparse values to host sparse matrix
+            ArrayHandle<double> h_sparse_val(m_sparse_val, access_location::device, access_mode::read);
+            hipMemcpy(m_sparse.valuePtr(), h_sparse_val.data, sizeof(double)*m_sparse.data().size(),
+                hipMemcpyDeviceToHost);
+            }
 
-    // solve on CPU
-    ForceDistanceConstraint::solveConstraints(timestep);
+        // solve on CPU
+        ForceDistanceConstraint::solveConstraints(timestep);
 
-    // a sparse matrix should have been constructed, resize values array
-    m_sparse_val.resize(m_sparse.data().size());
-    #else
+        // a sparse matrix should have been constructed, resize values array
+        m_sparse_val.resize(m_sparse.data().size());
+        return;
+        }
+
+    #ifdef CUSOLVER_AVAILABLE
 
     unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
 
@@ -574,7 +586,7 @@ void ForceDistanceConstraintGPU::computeConstraintForces(unsigned int timestep)
     ArrayHandle<Scalar> d_virial(m_virial, access_location::device, access_mode::overwrite);
 
     // access GPU constraint table on device
-    const GPUArray<ConstraintData::members_t>& gpu_constraint_list = this->m_cdata->getGPUTable();
+    const GlobalArray<ConstraintData::members_t>& gpu_constraint_list = this->m_cdata->getGPUTable();
     const Index2D& gpu_table_indexer = this->m_cdata->getGPUTableIndexer();
 
     ArrayHandle<ConstraintData::members_t> d_gpu_clist(gpu_constraint_list, access_location::device, access_mode::read);
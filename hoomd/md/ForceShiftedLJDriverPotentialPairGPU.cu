@@ -15,3 +15,5 @@ hipError_t gpu_compute_force_shifted_lj_forces(const pair_args_t & args,
                                                                 d_params);
     }
 
+template hipError_t gpu_compute_pair_set_energy<EvaluatorPairForceShiftedLJ>(const pair_set_energy_args_t& args,
+    const EvaluatorPairForceShiftedLJ::param_type *d_params);
@@ -12,3 +12,6 @@ hipError_t gpu_compute_fourier_forces(const pair_args_t &  pair_args,
     return gpu_compute_pair_forces<EvaluatorPairFourier>(pair_args,
                                                      d_params);
     }
+
+template hipError_t gpu_compute_pair_set_energy<EvaluatorPairFourier>(const pair_set_energy_args_t& args,
+                                                                      const EvaluatorPairFourier::param_type *d_params);
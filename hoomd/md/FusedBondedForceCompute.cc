@@ -0,0 +1,182 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file FusedBondedForceCompute.cc
+    \brief Contains code for the FusedBondedForceCompute class
+*/
+
+#include "FusedBondedForceCompute.h"
+
+#include <stdexcept>
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+namespace py = pybind11;
+
+using namespace std;
+
+/*! \param sysdef System to compute forces on
+    \param bonds Harmonic bonds to evaluate, may be null
+    \param angles Harmonic angles to evaluate, may be null
+    \param dihedrals Harmonic dihedrals to evaluate, may be null
+*/
+FusedBondedForceCompute::FusedBondedForceCompute(std::shared_ptr<SystemDefinition> sysdef,
+                                                 std::shared_ptr<PotentialBondHarmonic> bonds,
+                                                 std::shared_ptr<HarmonicAngleForceCompute> angles,
+                                                 std::shared_ptr<HarmonicDihedralForceCompute> dihedrals)
+    : ForceCompute(sysdef), m_bonds(bonds), m_angles(angles), m_dihedrals(dihedrals)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing FusedBondedForceCompute" << endl;
+
+    if (!m_bonds && !m_angles && !m_dihedrals)
+        {
+        m_exec_conf->msg->error() << "force.Bonded: at least one of bond, angle, or dihedral must be set" << endl;
+        throw runtime_error("Error initializing FusedBondedForceCompute");
+        }
+    }
+
+FusedBondedForceCompute::~FusedBondedForceCompute()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying FusedBondedForceCompute" << endl;
+    }
+
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step
+*/
+CommFlags FusedBondedForceCompute::getRequestedCommFlags(unsigned int timestep)
+    {
+    CommFlags flags = ForceCompute::getRequestedCommFlags(timestep);
+    if (m_bonds)
+        flags |= m_bonds->getRequestedCommFlags(timestep);
+    if (m_angles)
+        flags |= m_angles->getRequestedCommFlags(timestep);
+    if (m_dihedrals)
+        flags |= m_dihedrals->getRequestedCommFlags(timestep);
+    return flags;
+    }
+#endif
+
+/*! \param timestep Current time step
+
+    The per particle tables of the bonded group data list the groups of each local particle, so each particle sums
+    its own terms and no two particles write to the same output.
+ */
+void FusedBondedForceCompute::computeForces(unsigned int timestep)
+    {
+    if (m_prof) m_prof->push("Fused Bonded");
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+
+    // terms that are not evaluated keep null tables
+    fused_bonded_args_t args;
+    args.d_force = h_force.data;
+    args.d_virial = h_virial.data;
+    args.virial_pitch = m_virial.getPitch();
+    args.d_pos = h_pos.data;
+    args.box = m_pdata->getGlobalBox();
+
+    // empty handles stand in for the terms that are not evaluated, so that all handles live until the loop ran
+    GlobalArray<harmonic_params> no_bond_params;
+    GlobalVector<BondData::members_t> no_bond_table;
+    GlobalVector<AngleData::members_t> no_angle_table;
+    GlobalVector<DihedralData::members_t> no_dihedral_table;
+    GlobalArray<unsigned int> no_list;
+
+    std::shared_ptr<BondData> bond_data = m_sysdef->getBondData();
+    std::shared_ptr<AngleData> angle_data = m_sysdef->getAngleData();
+    std::shared_ptr<DihedralData> dihedral_data = m_sysdef->getDihedralData();
+
+    // the tables are rebuilt when they are first accessed after a change, before the number of groups is read
+    ArrayHandle<BondData::members_t> h_bond_table(m_bonds ? bond_data->getGPUTable() : no_bond_table,
+                                                  access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_bonds(m_bonds ? bond_data->getNGroupsArray() : no_list,
+                                        access_location::host, access_mode::read);
+    ArrayHandle<harmonic_params> h_bond_params(m_bonds ? m_bonds->getParamsArray() : no_bond_params,
+                                               access_location::host, access_mode::read);
+    if (m_bonds)
+        {
+        args.d_bond_table = h_bond_table.data;
+        args.bond_pitch = bond_data->getGPUTableIndexer().getW();
+        args.d_n_bonds = h_n_bonds.data;
+        args.d_bond_params = h_bond_params.data;
+        }
+
+    ArrayHandle<AngleData::members_t> h_angle_table(m_angles ? angle_data->getGPUTable() : no_angle_table,
+                                                    access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_angle_pos(m_angles ? angle_data->getGPUPosTable() : no_list,
+                                          access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_angles(m_angles ? angle_data->getNGroupsArray() : no_list,
+                                         access_location::host, access_mode::read);
+    if (m_angles)
+        {
+        m_angle_params.resize(angle_data->getNTypes());
+        for (unsigned int type = 0; type < angle_data->getNTypes(); ++type)
+            m_angle_params[type] = m_angles->getTypeParams(type);
+
+        args.d_angle_table = h_angle_table.data;
+        args.d_angle_pos = h_angle_pos.data;
+        args.angle_pitch = angle_data->getGPUTableIndexer().getW();
+        args.d_n_angles = h_n_angles.data;
+        args.d_angle_params = m_angle_params.data();
+        }
+
+    ArrayHandle<DihedralData::members_t> h_dihedral_table(m_dihedrals ? dihedral_data->getGPUTable()
+                                                                      : no_dihedral_table,
+                                                          access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_dihedral_pos(m_dihedrals ? dihedral_data->getGPUPosTable() : no_list,
+                                             access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_dihedrals(m_dihedrals ? dihedral_data->getNGroupsArray() : no_list,
+                                            access_location::host, access_mode::read);
+    if (m_dihedrals)
+        {
+        m_dihedral_params.resize(dihedral_data->getNTypes());
+        for (unsigned int type = 0; type < dihedral_data->getNTypes(); ++type)
+            m_dihedral_params[type] = m_dihedrals->getTypeParams(type);
+
+        args.d_dihedral_table = h_dihedral_table.data;
+        args.d_dihedral_pos = h_dihedral_pos.data;
+        args.dihedral_pitch = dihedral_data->getGPUTableIndexer().getW();
+        args.d_n_dihedrals = h_n_dihedrals.data;
+        args.d_dihedral_params = m_dihedral_params.data();
+        }
+
+    const unsigned int N = m_pdata->getN();
+
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                fused_bonded_forces(i, args);
+            });
+        }
+    else
+    #endif
+        {
+        for (unsigned int i = 0; i < N; i++)
+            fused_bonded_forces(i, args);
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
+void export_FusedBondedForceCompute(py::module& m)
+    {
+    py::class_<FusedBondedForceCompute, ForceCompute, std::shared_ptr<FusedBondedForceCompute> >(m,
+                                                                                   "FusedBondedForceCompute")
+    .def(py::init< std::shared_ptr<SystemDefinition>,
+                   std::shared_ptr<PotentialBondHarmonic>,
+                   std::shared_ptr<HarmonicAngleForceCompute>,
+                   std::shared_ptr<HarmonicDihedralForceCompute> >())
+    ;
+    }
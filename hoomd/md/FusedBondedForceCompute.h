@@ -0,0 +1,74 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+#include "hoomd/ForceCompute.h"
+#include "AllBondPotentials.h"
+#include "HarmonicAngleForceCompute.h"
+#include "HarmonicDihedralForceCompute.h"
+#include "FusedBondedForceTerms.h"
+
+#include <memory>
+#include <vector>
+
+/*! \file FusedBondedForceCompute.h
+    \brief Declares a force compute that evaluates harmonic bonds, angles, and dihedrals together
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __FUSEDBONDEDFORCECOMPUTE_H__
+#define __FUSEDBONDEDFORCECOMPUTE_H__
+
+//! Computes harmonic bond, angle, and dihedral forces as one force
+/*! FusedBondedForceCompute takes the bonded force computes that hold the per type parameters and evaluates all of
+    them into a single force and virial array. The integrator then reads one array for all bonded terms instead of one
+    per term. Any of the three may be null. The constituent computes must not be added to the integrator themselves,
+    or their forces would be applied twice.
+
+    Both the CPU and the GPU run over the particles and evaluate all terms of a particle with fused_bonded_forces(),
+    reading the BondData, AngleData, and DihedralData tables by particle. Each particle position is read once and its
+    force and virial are written once. The constituent computes only hold the parameters and are never computed.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT FusedBondedForceCompute : public ForceCompute
+    {
+    public:
+        //! Constructs the compute
+        FusedBondedForceCompute(std::shared_ptr<SystemDefinition> sysdef,
+                                std::shared_ptr<PotentialBondHarmonic> bonds,
+                                std::shared_ptr<HarmonicAngleForceCompute> angles,
+                                std::shared_ptr<HarmonicDihedralForceCompute> dihedrals);
+
+        //! Destructor
+        virtual ~FusedBondedForceCompute();
+
+        #ifdef ENABLE_MPI
+        //! Get ghost particle fields requested by the constituent computes
+        virtual CommFlags getRequestedCommFlags(unsigned int timestep);
+        #endif
+
+    protected:
+        std::shared_ptr<PotentialBondHarmonic> m_bonds;                 //!< Bond parameters, may be null
+        std::shared_ptr<HarmonicAngleForceCompute> m_angles;            //!< Angle parameters, may be null
+        std::shared_ptr<HarmonicDihedralForceCompute> m_dihedrals;      //!< Dihedral parameters, may be null
+
+        //! Actually compute the forces
+        virtual void computeForces(unsigned int timestep);
+
+    private:
+        std::vector<Scalar2> m_angle_params;        //!< Angle parameters (K, t_0) per type
+        std::vector<Scalar4> m_dihedral_params;     //!< Dihedral parameters (K, sign, multiplicity, phi_0) per type
+    };
+
+//! Exports the FusedBondedForceCompute class to python
+void export_FusedBondedForceCompute(pybind11::module& m);
+
+#endif
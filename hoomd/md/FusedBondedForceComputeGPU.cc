@@ -0,0 +1,163 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file FusedBondedForceComputeGPU.cc
+    \brief Defines FusedBondedForceComputeGPU
+*/
+
+#include "FusedBondedForceComputeGPU.h"
+
+namespace py = pybind11;
+
+using namespace std;
+
+/*! \param sysdef System to compute forces on
+    \param bonds Harmonic bonds to evaluate, may be null
+    \param angles Harmonic angles to evaluate, may be null
+    \param dihedrals Harmonic dihedrals to evaluate, may be null
+*/
+FusedBondedForceComputeGPU::FusedBondedForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                                       std::shared_ptr<PotentialBondHarmonic> bonds,
+                                                       std::shared_ptr<HarmonicAngleForceCompute> angles,
+                                                       std::shared_ptr<HarmonicDihedralForceCompute> dihedrals)
+    : FusedBondedForceCompute(sysdef, bonds, angles, dihedrals)
+    {
+    // can't run on the GPU if there aren't any GPUs in the execution configuration
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error() << "Creating a FusedBondedForceComputeGPU with no GPU in the execution configuration"
+                                  << endl;
+        throw std::runtime_error("Error initializing FusedBondedForceComputeGPU");
+        }
+
+    m_angles_gpu = std::dynamic_pointer_cast<HarmonicAngleForceComputeGPU>(m_angles);
+    m_dihedrals_gpu = std::dynamic_pointer_cast<HarmonicDihedralForceComputeGPU>(m_dihedrals);
+    if ((m_angles && !m_angles_gpu) || (m_dihedrals && !m_dihedrals_gpu))
+        {
+        m_exec_conf->msg->error() << "force.Bonded: angle and dihedral forces must be GPU computes" << endl;
+        throw std::runtime_error("Error initializing FusedBondedForceComputeGPU");
+        }
+
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_tuner.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "fused_bonded", this->m_exec_conf));
+    }
+
+FusedBondedForceComputeGPU::~FusedBondedForceComputeGPU()
+    {
+    }
+
+/*! Internal method for computing the forces on the GPU.
+    \post The force data on the GPU is written with the calculated forces
+
+    \param timestep Current time step of the simulation
+
+    Calls gpu_compute_fused_bonded_forces to do the dirty work.
+*/
+void FusedBondedForceComputeGPU::computeForces(unsigned int timestep)
+    {
+    // start the profile
+    if (m_prof) m_prof->push(m_exec_conf, "Fused Bonded");
+
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::overwrite);
+    ArrayHandle<Scalar> d_virial(m_virial, access_location::device, access_mode::overwrite);
+
+    // terms that are not evaluated keep null tables
+    fused_bonded_args_t args;
+    args.d_force = d_force.data;
+    args.d_virial = d_virial.data;
+    args.virial_pitch = m_virial.getPitch();
+    args.d_pos = d_pos.data;
+    args.box = m_pdata->getGlobalBox();
+
+    // empty handles stand in for the terms that are not evaluated, so that all handles live until the kernel ran
+    GlobalArray<harmonic_params> no_bond_params;
+    GlobalArray<Scalar2> no_angle_params;
+    GlobalArray<Scalar4> no_dihedral_params;
+    GlobalVector<BondData::members_t> no_bond_table;
+    GlobalVector<AngleData::members_t> no_angle_table;
+    GlobalVector<DihedralData::members_t> no_dihedral_table;
+    GlobalArray<unsigned int> no_list;
+
+    std::shared_ptr<BondData> bond_data = m_sysdef->getBondData();
+    std::shared_ptr<AngleData> angle_data = m_sysdef->getAngleData();
+    std::shared_ptr<DihedralData> dihedral_data = m_sysdef->getDihedralData();
+
+    // the tables are rebuilt when they are first accessed after a change, before the number of groups is read
+    ArrayHandle<BondData::members_t> d_bond_table(m_bonds ? bond_data->getGPUTable() : no_bond_table,
+                                                  access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_n_bonds(m_bonds ? bond_data->getNGroupsArray() : no_list,
+                                        access_location::device, access_mode::read);
+    ArrayHandle<harmonic_params> d_bond_params(m_bonds ? m_bonds->getParamsArray() : no_bond_params,
+                                               access_location::device, access_mode::read);
+    if (m_bonds)
+        {
+        args.d_bond_table = d_bond_table.data;
+        args.bond_pitch = bond_data->getGPUTableIndexer().getW();
+        args.d_n_bonds = d_n_bonds.data;
+        args.d_bond_params = d_bond_params.data;
+        }
+
+    ArrayHandle<AngleData::members_t> d_angle_table(m_angles ? angle_data->getGPUTable() : no_angle_table,
+                                                    access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_angle_pos(m_angles ? angle_data->getGPUPosTable() : no_list,
+                                          access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_n_angles(m_angles ? angle_data->getNGroupsArray() : no_list,
+                                         access_location::device, access_mode::read);
+    ArrayHandle<Scalar2> d_angle_params(m_angles ? m_angles_gpu->getParamsArray() : no_angle_params,
+                                        access_location::device, access_mode::read);
+    if (m_angles)
+        {
+        args.d_angle_table = d_angle_table.data;
+        args.d_angle_pos = d_angle_pos.data;
+        args.angle_pitch = angle_data->getGPUTableIndexer().getW();
+        args.d_n_angles = d_n_angles.data;
+        args.d_angle_params = d_angle_params.data;
+        }
+
+    ArrayHandle<DihedralData::members_t> d_dihedral_table(m_dihedrals ? dihedral_data->getGPUTable()
+                                                                      : no_dihedral_table,
+                                                          access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_dihedral_pos(m_dihedrals ? dihedral_data->getGPUPosTable() : no_list,
+                                             access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_n_dihedrals(m_dihedrals ? dihedral_data->getNGroupsArray() : no_list,
+                                            access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_dihedral_params(m_dihedrals ? m_dihedrals_gpu->getParamsArray() : no_dihedral_params,
+                                           access_location::device, access_mode::read);
+    if (m_dihedrals)
+        {
+        args.d_dihedral_table = d_dihedral_table.data;
+        args.d_dihedral_pos = d_dihedral_pos.data;
+        args.dihedral_pitch = dihedral_data->getGPUTableIndexer().getW();
+        args.d_n_dihedrals = d_n_dihedrals.data;
+        args.d_dihedral_params = d_dihedral_params.data;
+        }
+
+    m_exec_conf->beginMultiGPU();
+
+    // run the kernel on the GPU
+    m_tuner->begin();
+    gpu_compute_fused_bonded_forces(args, m_tuner->getParam(), m_pdata->getGPUPartition());
+
+    if(m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner->end();
+
+    m_exec_conf->endMultiGPU();
+
+    if (m_prof) m_prof->pop(m_exec_conf);
+    }
+
+void export_FusedBondedForceComputeGPU(py::module& m)
+    {
+    py::class_<FusedBondedForceComputeGPU, FusedBondedForceCompute,
+               std::shared_ptr<FusedBondedForceComputeGPU> >(m, "FusedBondedForceComputeGPU")
+    .def(py::init< std::shared_ptr<SystemDefinition>,
+                   std::shared_ptr<PotentialBondHarmonic>,
+                   std::shared_ptr<HarmonicAngleForceCompute>,
+                   std::shared_ptr<HarmonicDihedralForceCompute> >())
+    ;
+    }
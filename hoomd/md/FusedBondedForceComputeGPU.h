@@ -0,0 +1,68 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+#include "FusedBondedForceCompute.h"
+#include "FusedBondedForceGPU.cuh"
+#include "HarmonicAngleForceComputeGPU.h"
+#include "HarmonicDihedralForceComputeGPU.h"
+#include "hoomd/Autotuner.h"
+
+#include <memory>
+
+/*! \file FusedBondedForceComputeGPU.h
+    \brief Declares the FusedBondedForceComputeGPU class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __FUSEDBONDEDFORCECOMPUTEGPU_H__
+#define __FUSEDBONDEDFORCECOMPUTEGPU_H__
+
+//! Computes harmonic bond, angle, and dihedral forces on the GPU in a single kernel
+/*! The kernel reads the GPU tables of the BondData, AngleData, and DihedralData and the per type parameters of the
+    constituent computes, so the constituents themselves are never computed. The angle and dihedral computes must be
+    the GPU versions, which keep their parameters in device memory.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT FusedBondedForceComputeGPU : public FusedBondedForceCompute
+    {
+    public:
+        //! Constructs the compute
+        FusedBondedForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                   std::shared_ptr<PotentialBondHarmonic> bonds,
+                                   std::shared_ptr<HarmonicAngleForceCompute> angles,
+                                   std::shared_ptr<HarmonicDihedralForceCompute> dihedrals);
+
+        //! Destructor
+        virtual ~FusedBondedForceComputeGPU();
+
+        //! Set autotuner parameters
+        /*! \param enable Enable/disable autotuning
+            \param period period (approximate) in time steps when returning occurs
+        */
+        virtual void setAutotunerParams(bool enable, unsigned int period)
+            {
+            FusedBondedForceCompute::setAutotunerParams(enable, period);
+            m_tuner->setPeriod(period);
+            m_tuner->setEnabled(enable);
+            }
+
+    protected:
+        std::unique_ptr<Autotuner> m_tuner;                                 //!< Autotuner for block size
+        std::shared_ptr<HarmonicAngleForceComputeGPU> m_angles_gpu;         //!< Angle parameters on the GPU
+        std::shared_ptr<HarmonicDihedralForceComputeGPU> m_dihedrals_gpu;  //!< Dihedral parameters on the GPU
+
+        //! Actually compute the forces
+        virtual void computeForces(unsigned int timestep);
+    };
+
+//! Exports the FusedBondedForceComputeGPU class to python
+void export_FusedBondedForceComputeGPU(pybind11::module& m);
+
+#endif
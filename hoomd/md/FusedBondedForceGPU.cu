@@ -0,0 +1,77 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+#include "FusedBondedForceGPU.cuh"
+
+#include <assert.h>
+
+/*! \file FusedBondedForceGPU.cu
+    \brief Defines GPU kernel code for evaluating harmonic bonds, angles, and dihedrals in one pass. Used by
+           FusedBondedForceComputeGPU.
+*/
+
+//! Kernel for calculating harmonic bond, angle, and dihedral forces on the GPU
+/*! \param args Tables, parameters, and output arrays
+    \param N Number of particles this GPU operates on
+    \param offset Index of the first particle this GPU operates on
+
+    Each thread handles one particle with fused_bonded_forces().
+*/
+__global__ void gpu_compute_fused_bonded_forces_kernel(const fused_bonded_args_t args,
+                                                       const unsigned int N,
+                                                       const unsigned int offset)
+    {
+    // start by identifying which particle we are to handle
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    idx += offset;
+
+    fused_bonded_forces(idx, args);
+    }
+
+/*! \param args Tables, parameters, and output arrays
+    \param block_size Block size to use when performing calculations
+    \param gpu_partition The load balancing partition of particles between GPUs
+
+    \returns Any error code resulting from the kernel launch
+    \note Always returns hipSuccess in release builds to avoid the hipDeviceSynchronize()
+*/
+hipError_t gpu_compute_fused_bonded_forces(const fused_bonded_args_t& args,
+                                           int block_size,
+                                           const GPUPartition& gpu_partition)
+    {
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, (const void *)gpu_compute_fused_bonded_forces_kernel);
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
+    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+
+        // setup the grid to run the kernel
+        dim3 grid( nwork / run_block_size + 1, 1, 1);
+        dim3 threads(run_block_size, 1, 1);
+
+        // run the kernel
+        hipLaunchKernelGGL((gpu_compute_fused_bonded_forces_kernel), dim3(grid), dim3(threads), 0, 0,
+            args, nwork, range.first);
+        }
+
+    return hipSuccess;
+    }
@@ -0,0 +1,24 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+#include "hoomd/ParticleData.cuh"
+#include "hoomd/Index1D.h"
+#include "hoomd/GPUPartition.cuh"
+#include "FusedBondedForceTerms.h"
+
+/*! \file FusedBondedForceGPU.cuh
+    \brief Declares the GPU kernel driver that evaluates harmonic bonds, angles, and dihedrals in one pass
+*/
+
+#ifndef __FUSEDBONDEDFORCEGPU_CUH__
+#define __FUSEDBONDEDFORCEGPU_CUH__
+
+//! Kernel driver that computes harmonic bond, angle, and dihedral forces for FusedBondedForceComputeGPU
+hipError_t gpu_compute_fused_bonded_forces(const fused_bonded_args_t& args,
+                                           int block_size,
+                                           const GPUPartition& gpu_partition);
+
+#endif
@@ -0,0 +1,455 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/BoxDim.h"
+#include "EvaluatorBondHarmonic.h"
+
+#ifdef __HIPCC__
+#include "hoomd/BondedGroupData.cuh"
+#include "hoomd/TextureTools.h"
+#else
+#include "hoomd/BondedGroupData.h"
+#endif
+
+/*! \file FusedBondedForceTerms.h
+    \brief Defines the per particle evaluation of harmonic bonds, angles, and dihedrals shared by
+           FusedBondedForceCompute and FusedBondedForceComputeGPU
+*/
+
+#ifndef __FUSEDBONDEDFORCETERMS_H__
+#define __FUSEDBONDEDFORCETERMS_H__
+
+// need to declare these functions with __device__ qualifiers when building in nvcc
+// DEVICE is __device__ when included in nvcc and blank when included into the host compiler
+#ifdef __HIPCC__
+#define DEVICE __device__
+#else
+#define DEVICE
+#endif
+
+//! Wraps the tables, parameters, and output arrays of the fused bonded force evaluation
+/*! The pointers are device pointers in the kernel and host pointers in FusedBondedForceCompute. The tables of a term
+    that is not evaluated stay null, and its number of groups per particle is not read.
+*/
+struct fused_bonded_args_t
+    {
+    Scalar4 *d_force = nullptr;                             //!< Force to write out
+    Scalar *d_virial = nullptr;                             //!< Virial to write out
+    size_t virial_pitch = 0;                                //!< Pitch of 2D array of virial matrix elements
+    const Scalar4 *d_pos = nullptr;                         //!< Particle positions
+    BoxDim box;                                             //!< Simulation box
+
+    const group_storage<2> *d_bond_table = nullptr;         //!< Bonds of each particle
+    unsigned int bond_pitch = 0;                            //!< Pitch of the 2D bond table
+    const unsigned int *d_n_bonds = nullptr;                //!< Number of bonds of each particle
+    const harmonic_params *d_bond_params = nullptr;         //!< Bond parameters per type
+
+    const group_storage<3> *d_angle_table = nullptr;        //!< Angles of each particle
+    const unsigned int *d_angle_pos = nullptr;              //!< Position of the particle in each of its angles
+    unsigned int angle_pitch = 0;                           //!< Pitch of the 2D angle table
+    const unsigned int *d_n_angles = nullptr;               //!< Number of angles of each particle
+    const Scalar2 *d_angle_params = nullptr;                //!< Angle parameters (K, t_0) per type
+
+    const group_storage<4> *d_dihedral_table = nullptr;     //!< Dihedrals of each particle
+    const unsigned int *d_dihedral_pos = nullptr;           //!< Position of the particle in each of its dihedrals
+    unsigned int dihedral_pitch = 0;                        //!< Pitch of the 2D dihedral table
+    const unsigned int *d_n_dihedrals = nullptr;            //!< Number of dihedrals of each particle
+    const Scalar4 *d_dihedral_params = nullptr;             //!< Dihedral parameters (K, sign, multiplicity, phi_0) per type
+    };
+
+//! Load a read only value, through the read only data cache on the GPU
+template<class T>
+DEVICE inline T fused_ldg(const T *ptr)
+    {
+    #ifdef __HIP_DEVICE_COMPILE__
+    return __ldg(ptr);
+    #else
+    return *ptr;
+    #endif
+    }
+
+//! Add the harmonic bond forces of one particle
+/*! \param force Force on the particle to add to
+    \param virial Virial of the particle to add to
+    \param idx Index of the particle
+    \param pos Position of the particle
+    \param args Tables and parameters
+
+    The math is the same as gpu_compute_bond_forces_kernel() with EvaluatorBondHarmonic.
+*/
+DEVICE inline void fused_bond_forces(Scalar4& force,
+                                         Scalar *virial,
+                                         unsigned int idx,
+                                         const Scalar3& pos,
+                                         const fused_bonded_args_t& args)
+    {
+    unsigned int n_bonds = args.d_n_bonds[idx];
+
+    for (unsigned int bond_idx = 0; bond_idx < n_bonds; bond_idx++)
+        {
+        group_storage<2> cur_bond = args.d_bond_table[args.bond_pitch*bond_idx + idx];
+
+        Scalar4 neigh_postype = fused_ldg(args.d_pos + cur_bond.idx[0]);
+        Scalar3 dx = pos - make_scalar3(neigh_postype.x, neigh_postype.y, neigh_postype.z);
+        dx = args.box.minImage(dx);
+
+        Scalar force_divr = Scalar(0.0);
+        Scalar bond_eng = Scalar(0.0);
+        EvaluatorBondHarmonic eval(dot(dx, dx), args.d_bond_params[cur_bond.idx[1]]);
+        eval.evalForceAndEnergy(force_divr, bond_eng);
+
+        // add up the virial (double counting, multiply by 0.5)
+        Scalar force_div2r = force_divr/Scalar(2.0);
+        virial[0] += dx.x * dx.x * force_div2r; // xx
+        virial[1] += dx.x * dx.y * force_div2r; // xy
+        virial[2] += dx.x * dx.z * force_div2r; // xz
+        virial[3] += dx.y * dx.y * force_div2r; // yy
+        virial[4] += dx.y * dx.z * force_div2r; // yz
+        virial[5] += dx.z * dx.z * force_div2r; // zz
+
+        force.x += dx.x * force_divr;
+        force.y += dx.y * force_divr;
+        force.z += dx.z * force_divr;
+        // energy is double counted: multiply by 0.5
+        force.w += bond_eng * Scalar(0.5);
+        }
+    }
+
+//! Add the harmonic angle forces of one particle
+/*! \param force Force on the particle to add to
+    \param virial Virial of the particle to add to
+    \param idx Index of the particle
+    \param idx_pos Position of the particle
+    \param args Tables and parameters
+
+    The math is the same as gpu_compute_harmonic_angle_forces_kernel().
+*/
+DEVICE inline void fused_angle_forces(Scalar4& force,
+                                          Scalar *virial,
+                                          unsigned int idx,
+                                          const Scalar3& idx_pos,
+                                          const fused_bonded_args_t& args)
+    {
+    unsigned int n_angles = args.d_n_angles[idx];
+    Scalar3 a_pos, b_pos, c_pos;
+
+    for (unsigned int angle_idx = 0; angle_idx < n_angles; angle_idx++)
+        {
+        group_storage<3> cur_angle = args.d_angle_table[args.angle_pitch*angle_idx + idx];
+        unsigned int cur_angle_abc = args.d_angle_pos[args.angle_pitch*angle_idx + idx];
+
+        Scalar4 x_postype = fused_ldg(args.d_pos + cur_angle.idx[0]);
+        Scalar3 x_pos = make_scalar3(x_postype.x, x_postype.y, x_postype.z);
+        Scalar4 y_postype = fused_ldg(args.d_pos + cur_angle.idx[1]);
+        Scalar3 y_pos = make_scalar3(y_postype.x, y_postype.y, y_postype.z);
+
+        if (cur_angle_abc == 0)
+            {
+            a_pos = idx_pos;
+            b_pos = x_pos;
+            c_pos = y_pos;
+            }
+        if (cur_angle_abc == 1)
+            {
+            b_pos = idx_pos;
+            a_pos = x_pos;
+            c_pos = y_pos;
+            }
+        if (cur_angle_abc == 2)
+            {
+            c_pos = idx_pos;
+            a_pos = x_pos;
+            b_pos = y_pos;
+            }
+
+        Scalar3 dab = args.box.minImage(a_pos - b_pos);
+        Scalar3 dcb = args.box.minImage(c_pos - b_pos);
+
+        Scalar2 params = fused_ldg(args.d_angle_params + cur_angle.idx[2]);
+        Scalar K = params.x;
+        Scalar t_0 = params.y;
+
+        Scalar rsqab = dot(dab, dab);
+        Scalar rab = fast::sqrt(rsqab);
+        Scalar rsqcb = dot(dcb, dcb);
+        Scalar rcb = fast::sqrt(rsqcb);
+
+        Scalar c_abbc = dot(dab, dcb);
+        c_abbc /= rab*rcb;
+
+        if (c_abbc > Scalar(1.0)) c_abbc = Scalar(1.0);
+        if (c_abbc < -Scalar(1.0)) c_abbc = -Scalar(1.0);
+
+        Scalar s_abbc = fast::sqrt(Scalar(1.0) - c_abbc*c_abbc);
+        if (s_abbc < Scalar(0.001)) s_abbc = Scalar(0.001);
+        s_abbc = Scalar(1.0)/s_abbc;
+
+        Scalar dth = fast::acos(c_abbc) - t_0;
+        Scalar tk = K*dth;
+
+        Scalar a = -Scalar(1.0) * tk * s_abbc;
+        Scalar a11 = a*c_abbc/rsqab;
+        Scalar a12 = -a / (rab*rcb);
+        Scalar a22 = a*c_abbc / rsqcb;
+
+        Scalar3 fab = a11*dab + a12*dcb;
+        Scalar3 fcb = a22*dcb + a12*dab;
+
+        // upper triangular version of virial tensor, 1/3 for each atom in the angle
+        virial[0] += Scalar(1./3.)*(dab.x*fab.x + dcb.x*fcb.x);
+        virial[1] += Scalar(1./3.)*(dab.y*fab.x + dcb.y*fcb.x);
+        virial[2] += Scalar(1./3.)*(dab.z*fab.x + dcb.z*fcb.x);
+        virial[3] += Scalar(1./3.)*(dab.y*fab.y + dcb.y*fcb.y);
+        virial[4] += Scalar(1./3.)*(dab.z*fab.y + dcb.z*fcb.y);
+        virial[5] += Scalar(1./3.)*(dab.z*fab.z + dcb.z*fcb.z);
+
+        Scalar3 f;
+        if (cur_angle_abc == 0)
+            f = fab;
+        else if (cur_angle_abc == 1)
+            f = -(fab + fcb);
+        else
+            f = fcb;
+
+        force.x += f.x;
+        force.y += f.y;
+        force.z += f.z;
+        // compute 1/3 of the energy, 1/3 for each atom in the angle
+        force.w += tk*dth*Scalar(Scalar(1.0)/Scalar(6.0));
+        }
+    }
+
+//! Add the harmonic dihedral forces of one particle
+/*! \param force Force on the particle to add to
+    \param virial Virial of the particle to add to
+    \param idx Index of the particle
+    \param idx_pos Position of the particle
+    \param args Tables and parameters
+
+    The math is the same as gpu_compute_harmonic_dihedral_forces_kernel().
+*/
+DEVICE inline void fused_dihedral_forces(Scalar4& force,
+                                             Scalar *virial,
+                                             unsigned int idx,
+                                             const Scalar3& idx_pos,
+                                             const fused_bonded_args_t& args)
+    {
+    unsigned int n_dihedrals = args.d_n_dihedrals[idx];
+    Scalar3 pos_a, pos_b, pos_c, pos_d;
+
+    for (unsigned int dihedral_idx = 0; dihedral_idx < n_dihedrals; dihedral_idx++)
+        {
+        group_storage<4> cur_dihedral = args.d_dihedral_table[args.dihedral_pitch*dihedral_idx + idx];
+        unsigned int cur_dihedral_abcd = args.d_dihedral_pos[args.dihedral_pitch*dihedral_idx + idx];
+
+        Scalar4 x_postype = fused_ldg(args.d_pos + cur_dihedral.idx[0]);
+        Scalar3 x_pos = make_scalar3(x_postype.x, x_postype.y, x_postype.z);
+        Scalar4 y_postype = fused_ldg(args.d_pos + cur_dihedral.idx[1]);
+        Scalar3 y_pos = make_scalar3(y_postype.x, y_postype.y, y_postype.z);
+        Scalar4 z_postype = fused_ldg(args.d_pos + cur_dihedral.idx[2]);
+        Scalar3 z_pos = make_scalar3(z_postype.x, z_postype.y, z_postype.z);
+
+        if (cur_dihedral_abcd == 0)
+            {
+            pos_a = idx_pos;
+            pos_b = x_pos;
+            pos_c = y_pos;
+            pos_d = z_pos;
+            }
+        if (cur_dihedral_abcd == 1)
+            {
+            pos_b = idx_pos;
+            pos_a = x_pos;
+            pos_c = y_pos;
+            pos_d = z_pos;
+            }
+        if (cur_dihedral_abcd == 2)
+            {
+            pos_c = idx_pos;
+            pos_a = x_pos;
+            pos_b = y_pos;
+            pos_d = z_pos;
+            }
+        if (cur_dihedral_abcd == 3)
+            {
+            pos_d = idx_pos;
+            pos_a = x_pos;
+            pos_b = y_pos;
+            pos_c = z_pos;
+            }
+
+        Scalar3 dab = args.box.minImage(pos_a - pos_b);
+        Scalar3 dcb = args.box.minImage(pos_c - pos_b);
+        Scalar3 ddc = args.box.minImage(pos_d - pos_c);
+        Scalar3 dcbm = args.box.minImage(-dcb);
+
+        Scalar4 params = fused_ldg(args.d_dihedral_params + cur_dihedral.idx[3]);
+        Scalar K = params.x;
+        Scalar sign = params.y;
+        Scalar multi = params.z;
+        Scalar phi_0 = params.w;
+
+        Scalar aax = dab.y*dcbm.z - dab.z*dcbm.y;
+        Scalar aay = dab.z*dcbm.x - dab.x*dcbm.z;
+        Scalar aaz = dab.x*dcbm.y - dab.y*dcbm.x;
+
+        Scalar bbx = ddc.y*dcbm.z - ddc.z*dcbm.y;
+        Scalar bby = ddc.z*dcbm.x - ddc.x*dcbm.z;
+        Scalar bbz = ddc.x*dcbm.y - ddc.y*dcbm.x;
+
+        Scalar raasq = aax*aax + aay*aay + aaz*aaz;
+        Scalar rbbsq = bbx*bbx + bby*bby + bbz*bbz;
+        Scalar rgsq = dcbm.x*dcbm.x + dcbm.y*dcbm.y + dcbm.z*dcbm.z;
+        Scalar rg = fast::sqrt(rgsq);
+
+        Scalar rginv, raa2inv, rbb2inv;
+        rginv = raa2inv = rbb2inv = Scalar(0.0);
+        if (rg > Scalar(0.0)) rginv = Scalar(1.0)/rg;
+        if (raasq > Scalar(0.0)) raa2inv = Scalar(1.0)/raasq;
+        if (rbbsq > Scalar(0.0)) rbb2inv = Scalar(1.0)/rbbsq;
+        Scalar rabinv = fast::sqrt(raa2inv*rbb2inv);
+
+        Scalar c_abcd = (aax*bbx + aay*bby + aaz*bbz)*rabinv;
+        Scalar s_abcd = rg*rabinv*(aax*ddc.x + aay*ddc.y + aaz*ddc.z);
+
+        if (c_abcd > Scalar(1.0)) c_abcd = Scalar(1.0);
+        if (c_abcd < -Scalar(1.0)) c_abcd = -Scalar(1.0);
+
+        Scalar p = Scalar(1.0);
+        Scalar ddfab;
+        Scalar dfab = Scalar(0.0);
+        int m = int(multi + Scalar(0.5));
+
+        for (int jj = 0; jj < m; jj++)
+            {
+            ddfab = p*c_abcd - dfab*s_abcd;
+            dfab = p*s_abcd + dfab*c_abcd;
+            p = ddfab;
+            }
+
+        Scalar sin_phi_0 = fast::sin(phi_0);
+        Scalar cos_phi_0 = fast::cos(phi_0);
+        p = p*cos_phi_0 + dfab*sin_phi_0;
+        p *= sign;
+        dfab = dfab*cos_phi_0 - ddfab*sin_phi_0;
+        dfab *= sign;
+        dfab *= -multi;
+        p += Scalar(1.0);
+
+        if (multi < Scalar(1.0))
+            {
+            p =  Scalar(1.0) + sign;
+            dfab = Scalar(0.0);
+            }
+
+        Scalar fg = dab.x*dcbm.x + dab.y*dcbm.y + dab.z*dcbm.z;
+        Scalar hg = ddc.x*dcbm.x + ddc.y*dcbm.y + ddc.z*dcbm.z;
+
+        Scalar fga = fg*raa2inv*rginv;
+        Scalar hgb = hg*rbb2inv*rginv;
+        Scalar gaa = -raa2inv*rg;
+        Scalar gbb = rbb2inv*rg;
+
+        Scalar dtfx = gaa*aax;
+        Scalar dtfy = gaa*aay;
+        Scalar dtfz = gaa*aaz;
+        Scalar dtgx = fga*aax - hgb*bbx;
+        Scalar dtgy = fga*aay - hgb*bby;
+        Scalar dtgz = fga*aaz - hgb*bbz;
+        Scalar dthx = gbb*bbx;
+        Scalar dthy = gbb*bby;
+        Scalar dthz = gbb*bbz;
+
+        Scalar df = -K * dfab * Scalar(0.500); // the 0.5 term is for 1/2K in the forces
+
+        Scalar sx2 = df*dtgx;
+        Scalar sy2 = df*dtgy;
+        Scalar sz2 = df*dtgz;
+
+        Scalar ffax = df*dtfx;
+        Scalar ffay = df*dtfy;
+        Scalar ffaz = df*dtfz;
+
+        Scalar ffdx = df*dthx;
+        Scalar ffdy = df*dthy;
+        Scalar ffdz = df*dthz;
+
+        Scalar ffcx = -sx2 - ffdx;
+        Scalar ffcy = -sy2 - ffdy;
+        Scalar ffcz = -sz2 - ffdz;
+
+        // upper triangular version of virial tensor, 1/4 for each atom in the dihedral
+        virial[0] += Scalar(1./4.)*(dab.x*ffax + dcb.x*ffcx + (ddc.x+dcb.x)*ffdx);
+        virial[1] += Scalar(1./4.)*(dab.y*ffax + dcb.y*ffcx + (ddc.y+dcb.y)*ffdx);
+        virial[2] += Scalar(1./4.)*(dab.z*ffax + dcb.z*ffcx + (ddc.z+dcb.z)*ffdx);
+        virial[3] += Scalar(1./4.)*(dab.y*ffay + dcb.y*ffcy + (ddc.y+dcb.y)*ffdy);
+        virial[4] += Scalar(1./4.)*(dab.z*ffay + dcb.z*ffcy + (ddc.z+dcb.z)*ffdy);
+        virial[5] += Scalar(1./4.)*(dab.z*ffaz + dcb.z*ffcz + (ddc.z+dcb.z)*ffdz);
+
+        if (cur_dihedral_abcd == 0)
+            {
+            force.x += ffax;
+            force.y += ffay;
+            force.z += ffaz;
+            }
+        if (cur_dihedral_abcd == 1)
+            {
+            force.x += sx2 - ffax;
+            force.y += sy2 - ffay;
+            force.z += sz2 - ffaz;
+            }
+        if (cur_dihedral_abcd == 2)
+            {
+            force.x += ffcx;
+            force.y += ffcy;
+            force.z += ffcz;
+            }
+        if (cur_dihedral_abcd == 3)
+            {
+            force.x += ffdx;
+            force.y += ffdy;
+            force.z += ffdz;
+            }
+
+        // the 1/8th term is (1/2)K * 1/4, 1/4 for each atom in the dihedral
+        force.w += p*K*Scalar(1.0/8.0);
+        }
+    }
+
+//! Evaluate all bonded terms of one particle and write its force and virial
+/*! \param idx Index of the particle
+    \param args Tables, parameters, and output arrays
+
+    The particle position is read once, the bonds, angles, and dihedrals the particle is a member of are summed, and
+    the force and virial are written once. Terms whose tables are null are skipped.
+*/
+DEVICE inline void fused_bonded_forces(unsigned int idx, const fused_bonded_args_t& args)
+    {
+    // read in the position of our particle (MEM TRANSFER: 16 bytes)
+    Scalar4 postype = fused_ldg(args.d_pos + idx);
+    Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+
+    // initialize the force and virial to 0
+    Scalar4 force = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
+    Scalar virial[6];
+    for (unsigned int i = 0; i < 6; i++)
+        virial[i] = Scalar(0.0);
+
+    if (args.d_bond_table)
+        fused_bond_forces(force, virial, idx, pos, args);
+    if (args.d_angle_table)
+        fused_angle_forces(force, virial, idx, pos, args);
+    if (args.d_dihedral_table)
+        fused_dihedral_forces(force, virial, idx, pos, args);
+
+    // now that the force calculation is complete, write out the result (MEM TRANSFER: 20 bytes)
+    args.d_force[idx] = force;
+    for (unsigned int i = 0; i < 6; i++)
+        args.d_virial[i*args.virial_pitch + idx] = virial[i];
+    }
+
+#endif
@@ -15,4 +15,5 @@ hipError_t gpu_compute_gauss_forces(const pair_args_t& pair_args,
                                                        d_params);
     }
 
-
+template hipError_t gpu_compute_pair_set_energy<EvaluatorPairGauss>(const pair_set_energy_args_t& args,
+                                                                    const EvaluatorPairGauss::param_type *d_params);
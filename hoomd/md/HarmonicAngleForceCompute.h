@@ -72,6 +72,12 @@ class PYBIND11_EXPORT HarmonicAngleForceCompute : public ForceCompute
         /// Get the parameters for a type
         pybind11::dict getParams(std::string type);
 
+        //! Get the parameters (K, t_0) of a type
+        Scalar2 getTypeParams(unsigned int type) const
+            {
+            return make_scalar2(m_K[type], m_t_0[type]);
+            }
+
         //! Returns a list of log quantities this compute calculates
         virtual std::vector< std::string > getProvidedLogQuantities();
 
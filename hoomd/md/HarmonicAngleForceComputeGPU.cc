@@ -28,10 +28,24 @@ HarmonicAngleForceComputeGPU::HarmonicAngleForceComputeGPU(std::shared_ptr<Syste
         throw std::runtime_error("Error initializing AngleForceComputeGPU");
         }
 
-    // allocate and zero device memory
-    GPUArray<Scalar2> params(m_angle_data->getNTypes(), m_exec_conf);
+    // allocate device memory
+    GlobalArray<Scalar2> params(m_angle_data->getNTypes(), m_exec_conf);
     m_params.swap(params);
 
+    // GlobalArray does not zero its memory
+        {
+        ArrayHandle<Scalar2> h_params(m_params, access_location::host, access_mode::overwrite);
+        for (unsigned int i = 0; i < m_params.getNumElements(); i++)
+            h_params.data[i] = make_scalar2(0, 0);
+        }
+
+    #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
+    if (m_exec_conf->allConcurrentManagedAccess())
+        {
+        cudaMemAdvise(m_params.get(), m_params.getNumElements()*sizeof(Scalar2), cudaMemAdviseSetReadMostly, 0);
+        }
+    #endif
+
     unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
     m_tuner.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "harmonic_angle", this->m_exec_conf));
     }
@@ -81,6 +95,8 @@ void HarmonicAngleForceComputeGPU::computeForces(unsigned int timestep)
     ArrayHandle<unsigned int> d_gpu_angle_pos_list(m_angle_data->getGPUPosTable(), access_location::device,access_mode::read);
     ArrayHandle<unsigned int> d_gpu_n_angles(m_angle_data->getNGroupsArray(), access_location::device, access_mode::read);
 
+    m_exec_conf->beginMultiGPU();
+
     // run the kernel on the GPU
     m_tuner->begin();
     gpu_compute_harmonic_angle_forces(d_force.data,
@@ -95,12 +111,15 @@ void HarmonicAngleForceComputeGPU::computeForces(unsigned int timestep)
                                       d_gpu_n_angles.data,
                                       d_params.data,
                                       m_angle_data->getNTypes(),
-                                      m_tuner->getParam());
+                                      m_tuner->getParam(),
+                                      m_pdata->getGPUPartition());
 
     if(m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
     m_tuner->end();
 
+    m_exec_conf->endMultiGPU();
+
     if (m_prof) m_prof->pop(m_exec_conf);
     }
 
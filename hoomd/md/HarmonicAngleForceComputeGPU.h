@@ -55,9 +55,15 @@ class PYBIND11_EXPORT HarmonicAngleForceComputeGPU : public HarmonicAngleForceCo
         //! Set the parameters
         virtual void setParams(unsigned int type, Scalar K, Scalar t_0);
 
+        //! Get the per type parameters (K, t_0) stored on the GPU
+        const GlobalArray<Scalar2>& getParamsArray() const
+            {
+            return m_params;
+            }
+
     protected:
         std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
-        GPUArray<Scalar2>  m_params;          //!< Parameters stored on the GPU
+        GlobalArray<Scalar2>  m_params;       //!< Parameters stored on the GPU
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
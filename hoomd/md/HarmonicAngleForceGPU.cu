@@ -21,7 +21,8 @@
 /*! \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
     \param virial_pitch Pitch of 2D virial array
-    \param N number of particles
+    \param N number of particles to compute forces on
+    \param offset Index of the first particle this GPU operates on
     \param d_pos device array of particle positions
     \param d_params Parameters for the angle force
     \param box Box dimensions for periodic boundary condition handling
@@ -33,6 +34,7 @@ extern "C" __global__ void gpu_compute_harmonic_angle_forces_kernel(Scalar4* d_f
                                                                     Scalar* d_virial,
                                                                     const size_t virial_pitch,
                                                                     const unsigned int N,
+                                                                    const unsigned int offset,
                                                                     const Scalar4 *d_pos,
                                                                     const Scalar2 *d_params,
                                                                     BoxDim box,
@@ -47,6 +49,8 @@ extern "C" __global__ void gpu_compute_harmonic_angle_forces_kernel(Scalar4* d_f
     if (idx >= N)
         return;
 
+    idx += offset;
+
     // load in the length of the list for this thread (MEM TRANSFER: 4 bytes)
     int n_angles = n_angles_list[idx];
 
@@ -205,6 +209,7 @@ extern "C" __global__ void gpu_compute_harmonic_angle_forces_kernel(Scalar4* d_f
     \param d_params K and t_0 params packed as Scalar2 variables
     \param n_angle_types Number of angle types in d_params
     \param block_size Block size to use when performing calculations
+    \param gpu_partition The load balancing partition of particles between GPUs
     \param compute_capability Device compute capability (200, 300, 350, ...)
 
     \returns Any error code resulting from the kernel launch
@@ -225,7 +230,8 @@ hipError_t gpu_compute_harmonic_angle_forces(Scalar4* d_force,
                                               const unsigned int *n_angles_list,
                                               Scalar2 *d_params,
                                               unsigned int n_angle_types,
-                                              int block_size)
+                                              int block_size,
+                                              const GPUPartition& gpu_partition)
     {
     assert(d_params);
 
@@ -239,13 +245,21 @@ hipError_t gpu_compute_harmonic_angle_forces(Scalar4* d_force,
 
     unsigned int run_block_size = min(block_size, max_block_size);
 
-    // setup the grid to run the kernel
-    dim3 grid( N / run_block_size + 1, 1, 1);
-    dim3 threads(run_block_size, 1, 1);
+    // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
+    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+
+        // setup the grid to run the kernel
+        dim3 grid( nwork / run_block_size + 1, 1, 1);
+        dim3 threads(run_block_size, 1, 1);
 
-    // run the kernel
-    hipLaunchKernelGGL((gpu_compute_harmonic_angle_forces_kernel), dim3(grid), dim3(threads), 0, 0, d_force, d_virial, virial_pitch, N, d_pos, d_params, box,
-        atable, apos_list, pitch, n_angles_list);
+        // run the kernel
+        hipLaunchKernelGGL((gpu_compute_harmonic_angle_forces_kernel), dim3(grid), dim3(threads), 0, 0, d_force, d_virial,
+            virial_pitch, nwork, range.first, d_pos, d_params, box, atable, apos_list, pitch, n_angles_list);
+        }
 
     return hipSuccess;
     }
@@ -7,6 +7,7 @@
 #include "hoomd/BondedGroupData.cuh"
 #include "hoomd/ParticleData.cuh"
 #include "hoomd/HOOMDMath.h"
+#include "hoomd/GPUPartition.cuh"
 
 /*! \file HarmonicAngleForceGPU.cuh
     \brief Declares GPU kernel code for calculating the harmonic angle forces. Used by HarmonicAngleForceComputeGPU.
@@ -28,6 +29,7 @@ hipError_t gpu_compute_harmonic_angle_forces(Scalar4* d_force,
                                               const unsigned int *n_angles_list,
                                               Scalar2 *d_params,
                                               unsigned int n_angle_types,
-                                              int block_size);
+                                              int block_size,
+                                              const GPUPartition& gpu_partition);
 
 #endif
@@ -74,6 +74,12 @@ class PYBIND11_EXPORT HarmonicDihedralForceCompute : public ForceCompute
         /// Get the parameters for a particular type
         pybind11::dict getParams(std::string type);
 
+        //! Get the parameters (K, sign, multiplicity, phi_0) of a type
+        Scalar4 getTypeParams(unsigned int type) const
+            {
+            return make_scalar4(m_K[type], m_sign[type], m_multi[type], m_phi_0[type]);
+            }
+
         //! Returns a list of log quantities this compute calculates
         virtual std::vector< std::string > getProvidedLogQuantities();
 
@@ -27,10 +27,24 @@ HarmonicDihedralForceComputeGPU::HarmonicDihedralForceComputeGPU(std::shared_ptr
         throw std::runtime_error("Error initializing DihedralForceComputeGPU");
         }
 
-    // allocate and zero device memory
-    GPUArray<Scalar4> params(m_dihedral_data->getNTypes(),m_exec_conf);
+    // allocate device memory
+    GlobalArray<Scalar4> params(m_dihedral_data->getNTypes(),m_exec_conf);
     m_params.swap(params);
 
+    // GlobalArray does not zero its memory
+        {
+        ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::overwrite);
+        for (unsigned int i = 0; i < m_params.getNumElements(); i++)
+            h_params.data[i] = make_scalar4(0, 0, 0, 0);
+        }
+
+    #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
+    if (m_exec_conf->allConcurrentManagedAccess())
+        {
+        cudaMemAdvise(m_params.get(), m_params.getNumElements()*sizeof(Scalar4), cudaMemAdviseSetReadMostly, 0);
+        }
+    #endif
+
     unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
     m_tuner.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "harmonic_dihedral", this->m_exec_conf));
     }
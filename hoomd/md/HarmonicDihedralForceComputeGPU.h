@@ -51,9 +51,15 @@ class PYBIND11_EXPORT HarmonicDihedralForceComputeGPU : public HarmonicDihedralF
         //! Set the parameters
         virtual void setParams(unsigned int type, Scalar K, Scalar sign, Scalar multiplicity, Scalar phi_0);
 
+        //! Get the per type parameters (K, sign, multiplicity, phi_0) stored on the GPU
+        const GlobalArray<Scalar4>& getParamsArray() const
+            {
+            return m_params;
+            }
+
     protected:
         std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
-        GPUArray<Scalar4> m_params;           //!< Parameters stored on the GPU (k,sign,m)
+        GlobalArray<Scalar4> m_params;        //!< Parameters stored on the GPU (k,sign,m)
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
@@ -37,6 +37,14 @@ IntegrationMethodTwoStep::IntegrationMethodTwoStep(std::shared_ptr<SystemDefinit
     assert(m_pdata);
     assert(m_group);
 
+    m_projection.kind = ConstraintProjection::none;
+    m_projection.P = make_scalar3(0,0,0);
+    m_projection.v = make_scalar3(0,0,0);
+
+    #ifdef ENABLE_HIP
+    m_graph_stream = 0;
+    #endif
+
     m_integrator_id = m_sysdef->getIntegratorData()->registerIntegrator();
     }
 
@@ -106,7 +114,116 @@ Scalar IntegrationMethodTwoStep::getTranslationalDOF(std::shared_ptr<ParticleGro
     // get the size of the intersection between query_group and m_group
     unsigned int intersect_size = query_group->intersectionSize(m_group);
 
-    return m_sysdef->getNDimensions() * intersect_size;
+    unsigned int ndim = m_sysdef->getNDimensions();
+    return (ndim - m_projection.getNDOFRemoved(ndim)) * intersect_size;
+    }
+
+/*! \returns None, or a dict with the kind of the constraint and its parameters
+*/
+pybind11::object IntegrationMethodTwoStep::getConstraint()
+    {
+    const Scalar3& P = m_projection.P;
+    const Scalar3& v = m_projection.v;
+    pybind11::dict params;
+    switch (m_projection.kind)
+        {
+        case ConstraintProjection::plane:
+            params["kind"] = "plane";
+            break;
+        case ConstraintProjection::line:
+            params["kind"] = "line";
+            params["vector"] = pybind11::make_tuple(v.x, v.y, v.z);
+            break;
+        case ConstraintProjection::sphere:
+            params["kind"] = "sphere";
+            params["P"] = pybind11::make_tuple(P.x, P.y, P.z);
+            params["r"] = v.x;
+            break;
+        case ConstraintProjection::ellipsoid:
+            params["kind"] = "ellipsoid";
+            params["P"] = pybind11::make_tuple(P.x, P.y, P.z);
+            params["rx"] = v.x;
+            params["ry"] = v.y;
+            params["rz"] = v.z;
+            break;
+        default:
+            return pybind11::none();
+        }
+    return params;
+    }
+
+/*! \param constraint None, or a dict with the kind of the constraint and its parameters
+
+    The kinds are:
+    - plane: the particles move in the xy plane
+    - line: the particles move along \c vector
+    - sphere: the particles move on the sphere of center \c P and radius \c r
+    - ellipsoid: the particles move on the ellipsoid of center \c P and radii \c rx, \c ry, and \c rz
+*/
+void IntegrationMethodTwoStep::setConstraint(pybind11::object constraint)
+    {
+    ConstraintProjection projection;
+    projection.kind = ConstraintProjection::none;
+    projection.P = make_scalar3(0,0,0);
+    projection.v = make_scalar3(0,0,0);
+
+    if (!constraint.is_none())
+        {
+        pybind11::dict params = pybind11::cast<pybind11::dict>(constraint);
+        std::string kind = pybind11::cast<std::string>(params["kind"]);
+        if (kind == "plane")
+            {
+            projection.kind = ConstraintProjection::plane;
+            }
+        else if (kind == "line")
+            {
+            pybind11::tuple vec(params["vector"]);
+            Scalar3 v = make_scalar3(pybind11::cast<Scalar>(vec[0]),
+                                     pybind11::cast<Scalar>(vec[1]),
+                                     pybind11::cast<Scalar>(vec[2]));
+            Scalar len = sqrt(dot(v,v));
+            if (len == Scalar(0.0))
+                {
+                throw std::invalid_argument("The constraint vector must not be zero");
+                }
+            projection.kind = ConstraintProjection::line;
+            projection.v = v / len;
+            }
+        else if (kind == "sphere" || kind == "ellipsoid")
+            {
+            pybind11::tuple P(params["P"]);
+            projection.P = make_scalar3(pybind11::cast<Scalar>(P[0]),
+                                        pybind11::cast<Scalar>(P[1]),
+                                        pybind11::cast<Scalar>(P[2]));
+            if (kind == "sphere")
+                {
+                Scalar r = pybind11::cast<Scalar>(params["r"]);
+                projection.kind = ConstraintProjection::sphere;
+                projection.v = make_scalar3(r, r, r);
+                }
+            else
+                {
+                projection.kind = ConstraintProjection::ellipsoid;
+                projection.v = make_scalar3(pybind11::cast<Scalar>(params["rx"]),
+                                            pybind11::cast<Scalar>(params["ry"]),
+                                            pybind11::cast<Scalar>(params["rz"]));
+                if (projection.v.x < projection.v.z || projection.v.y < projection.v.z)
+                    {
+                    throw std::invalid_argument("The ellipsoid constraint needs rx >= rz and ry >= rz");
+                    }
+                }
+            if (projection.v.z <= Scalar(0.0))
+                {
+                throw std::invalid_argument("The constraint radii must be positive");
+                }
+            }
+        else
+            {
+            throw std::invalid_argument("Unknown constraint kind: " + kind);
+            }
+        }
+
+    m_projection = projection;
     }
 
 Scalar IntegrationMethodTwoStep::getRotationalDOF(std::shared_ptr<ParticleGroup> query_group)
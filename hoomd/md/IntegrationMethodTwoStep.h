@@ -7,8 +7,19 @@
 #include "hoomd/SystemDefinition.h"
 #include "hoomd/ParticleGroup.h"
 #include "hoomd/Profiler.h"
+#include "ConstraintProjection.h"
 
 #include <memory>
+#include <vector>
+
+#ifdef ENABLE_HIP
+#include "hoomd/Integrator.cuh"
+#endif
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
 
 #ifndef __INTEGRATION_METHOD_TWO_STEP_H__
 #define __INTEGRATION_METHOD_TWO_STEP_H__
@@ -173,6 +184,16 @@ class PYBIND11_EXPORT IntegrationMethodTwoStep
         //! Get the number of degrees of freedom granted to a given group
         virtual Scalar getTranslationalDOF(std::shared_ptr<ParticleGroup> query_group);
 
+        //! Get the constraint on the motion of the particles
+        pybind11::object getConstraint();
+
+        //! Set the constraint on the motion of the particles
+        /*! \param constraint None, or a dict with the kind of the constraint and its parameters
+
+            Only the methods that apply m_projection in their integration steps expose the constraint.
+        */
+        void setConstraint(pybind11::object constraint);
+
         //! Get needed pdata flags
         /*! Not all fields in ParticleData are computed by default. When derived classes need one of these optional
             fields, they must return the requested fields in getRequestedPDataFlags().
@@ -230,6 +251,52 @@ class PYBIND11_EXPORT IntegrationMethodTwoStep
             return true;
             }
 
+        //! Test if the integration steps can be captured into a GPU graph
+        /*! Derived classes that return true must launch all of their kernels in m_graph_stream when it is non-zero,
+            must not synchronize with the host while it is set, and must append every value their kernels depend on
+            (other than array pointers, particle counts, and the box) to the key in appendGraphKey(). IntegratorTwoStep
+            captures the integration steps of all methods into a GPU graph when all of them return true.
+        */
+        virtual bool isGraphCapturable()
+            {
+            return false;
+            }
+
+        //! Append the parameters of the captured kernels to the GPU graph key
+        /*! \param key Key to append to
+        */
+        virtual void appendGraphKey(std::vector<char>& key)
+            {
+            }
+
+        #ifdef ENABLE_HIP
+        //! Set the stream to launch kernels in during GPU graph capture
+        /*! \param stream Stream to capture in, or 0 to launch kernels normally
+        */
+        void setGraphStream(hipStream_t stream)
+            {
+            m_graph_stream = stream;
+            }
+
+        //! Test if integrateStepTwo() can sum the net force in its integration kernel
+        /*! Derived classes that return true pass m_fused_net_force to the kernel of integrateStepTwo(). When it is
+            enabled, the kernel sums the net force of the group members instead of reading it. IntegratorTwoStep
+            enables it when this method integrates all particles.
+        */
+        virtual bool canFuseNetForce()
+            {
+            return false;
+            }
+
+        //! Set the net force sum for the next call to integrateStepTwo()
+        /*! \param fused Net force sum, disabled to read the net force
+        */
+        void setFusedNetForce(const gpu_fused_net_force& fused)
+            {
+            m_fused_net_force = fused;
+            }
+        #endif
+
     protected:
         const std::shared_ptr<SystemDefinition> m_sysdef; //!< The system definition this method is associated with
         const std::shared_ptr<ParticleGroup> m_group;     //!< The group of particles this method works on
@@ -239,6 +306,12 @@ class PYBIND11_EXPORT IntegrationMethodTwoStep
         bool m_aniso;                                       //!< True if anisotropic integration is requested
 
         Scalar m_deltaT;                                    //!< The time step
+        ConstraintProjection m_projection;                  //!< Constraint on the motion of the group members
+
+        #ifdef ENABLE_HIP
+        hipStream_t m_graph_stream;                         //!< Stream to capture kernels in (0 when not capturing)
+        gpu_fused_net_force m_fused_net_force;              //!< Net force sum for the step two kernel
+        #endif
 
         //! helper function to get the integrator variables from the particle data
         const IntegratorVariables& getIntegratorVariables()
@@ -258,6 +331,35 @@ class PYBIND11_EXPORT IntegrationMethodTwoStep
         //! Set whether this restart is valid
         void setValidRestart(bool b) { m_valid_restart = b; }
 
+        //! Call a function with the index of every particle in the group
+        /*! \param f Function called once with the particle index of each group member
+
+            In builds with TBB, the members are distributed over the available threads. \a f may then only write to
+            the elements of its own particle.
+        */
+        template<class Function>
+        void forEachMember(const Function& f)
+            {
+            const unsigned int group_size = m_group->getNumMembers();
+            ArrayHandle<unsigned int> h_index(m_group->getIndexArray(), access_location::host, access_mode::read);
+
+            #ifdef ENABLE_TBB
+            if (m_exec_conf->getNumThreads() > 1)
+                {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, group_size),
+                    [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                    for (unsigned int group_idx = r.begin(); group_idx != r.end(); ++group_idx)
+                        f(h_index.data[group_idx]);
+                    });
+                return;
+                }
+            #endif
+
+            for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+                f(h_index.data[group_idx]);
+            }
+
 #ifdef ENABLE_MPI
         std::shared_ptr<Communicator> m_comm;             //!< The communicator to use for MPI
 #endif
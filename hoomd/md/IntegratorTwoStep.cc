@@ -16,7 +16,7 @@ using namespace std;
 
 IntegratorTwoStep::IntegratorTwoStep(std::shared_ptr<SystemDefinition> sysdef, Scalar deltaT)
     : Integrator(sysdef, deltaT), m_prepared(false), m_gave_warning(false),
-    m_aniso_mode(Automatic)
+    m_aniso_mode(Automatic), m_gpu_graphs(false), m_overlap_communication(false), m_fuse_net_force(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing IntegratorTwoStep" << endl;
     }
@@ -100,15 +100,27 @@ void IntegratorTwoStep::update(unsigned int timestep)
     if (m_prof)
         m_prof->push("Integrate");
 
+#ifdef ENABLE_HIP
+    bool use_graphs = useGPUGraphs();
+#endif
+
     // perform the first step of the integration on all groups
     for (auto& method : m_methods)
         {
         // deltaT should probably be passed as an argument, but that would require modifying many
         // files. Work around this by calling setDeltaT every timestep.
         method->setDeltaT(m_deltaT);
-        method->integrateStepOne(timestep);
+#ifdef ENABLE_HIP
+        if (!use_graphs)
+#endif
+            method->integrateStepOne(timestep);
         }
 
+#ifdef ENABLE_HIP
+    if (use_graphs)
+        runGPUGraph(*m_graph_one, timestep, true);
+#endif
+
     if (m_prof)
         m_prof->pop();
 
@@ -120,7 +132,11 @@ void IntegratorTwoStep::update(unsigned int timestep)
         // b) that forces are calculated correctly, if ghost atom positions are updated every time step
 
         // also updates rigid bodies after ghost updating
-        m_comm->communicate(timestep+1);
+        // with overlap, computeNetForce() completes the ghost update after the forces on local particles
+        if (m_overlap_communication && !m_exec_conf->isCUDAEnabled())
+            m_comm->beginCommunicate(timestep+1);
+        else
+            m_comm->communicate(timestep+1);
         }
     else
 #endif
@@ -130,7 +146,13 @@ void IntegratorTwoStep::update(unsigned int timestep)
 
     // compute the net force on all particles
 #ifdef ENABLE_HIP
-    if (m_exec_conf->isCUDAEnabled())
+    // sum the net force in the second half step kernel when possible, decided after particles have migrated
+    bool fuse_net_force = !use_graphs && useFusedNetForce(timestep+1);
+    gpu_fused_net_force fused;
+
+    if (fuse_net_force)
+        computeFusedNetForceGPU(timestep+1, fused);
+    else if (m_exec_conf->isCUDAEnabled())
         computeNetForceGPU(timestep+1);
     else
 #endif
@@ -146,8 +168,21 @@ void IntegratorTwoStep::update(unsigned int timestep)
         m_prof->push("Integrate");
 
     // perform the second step of the integration on all groups
-    for (auto& method : m_methods)
-        method->integrateStepTwo(timestep);
+#ifdef ENABLE_HIP
+    if (use_graphs)
+        runGPUGraph(*m_graph_two, timestep, false);
+    else if (fuse_net_force)
+        {
+        m_methods[0]->setFusedNetForce(fused);
+        m_methods[0]->integrateStepTwo(timestep);
+        m_methods[0]->setFusedNetForce(gpu_fused_net_force());
+        }
+    else
+#endif
+        {
+        for (auto& method : m_methods)
+            method->integrateStepTwo(timestep);
+        }
 
     /* NOTE: For composite particles, it is assumed that positions and orientations are not updated
        in the second step.
@@ -483,6 +518,152 @@ void IntegratorTwoStep::updateRigidBodies(unsigned int timestep)
         (*force_composite)->updateCompositeParticles(timestep);
     }
 
+/*! \param gpu_graphs True to capture the integration steps into GPU graphs
+
+    GPU graphs have no effect on the CPU.
+*/
+void IntegratorTwoStep::setGPUGraphs(bool gpu_graphs)
+    {
+    m_gpu_graphs = gpu_graphs;
+
+#ifdef ENABLE_HIP
+    if (m_gpu_graphs && m_exec_conf->isCUDAEnabled() && !m_graph_one)
+        {
+        m_graph_one.reset(new GPUGraph(m_exec_conf));
+        m_graph_two.reset(new GPUGraph(m_exec_conf));
+        }
+    else if (!m_gpu_graphs)
+        {
+        m_graph_one.reset();
+        m_graph_two.reset();
+        }
+#endif
+    }
+
+#ifdef ENABLE_HIP
+/*! Graphs require a single GPU, a disabled profiler (it synchronizes with the host), and methods that all support
+    capture.
+*/
+bool IntegratorTwoStep::useGPUGraphs()
+    {
+    if (!m_graph_one || m_exec_conf->getNumActiveGPUs() > 1 || m_prof || m_methods.size() == 0)
+        return false;
+
+    for (auto& method : m_methods)
+        {
+        if (!method->isGraphCapturable())
+            return false;
+        }
+
+    return true;
+    }
+
+/*! \param timestep Time step the forces are computed at
+
+    The method must write the net force of every local particle, so it must be the only method and its group must
+    contain all local particles.
+*/
+bool IntegratorTwoStep::useFusedNetForce(unsigned int timestep)
+    {
+    if (!m_fuse_net_force || m_methods.size() != 1 || !m_methods[0]->canFuseNetForce())
+        return false;
+
+    if (m_methods[0]->getGroup()->getNumMembers() != m_pdata->getN())
+        return false;
+
+    return canFuseNetForceGPU(timestep);
+    }
+
+/*! \param graph Graph to capture into or replay
+    \param timestep Current time step
+    \param step_one True to run integrateStepOne() of all methods, false to run integrateStepTwo()
+
+    Device access to all arrays is acquired before capture and before replay so that any pending host to device copy
+    happens outside of the graph, and so that host copies are marked out of date after the graph modifies them.
+*/
+void IntegratorTwoStep::runGPUGraph(GPUGraph& graph, unsigned int timestep, bool step_one)
+    {
+    std::vector<char> key;
+    GPUGraph::appendToKey(key, m_pdata->getN());
+
+    const BoxDim& box = m_pdata->getBox();
+    GPUGraph::appendToKey(key, box.getLo());
+    GPUGraph::appendToKey(key, box.getHi());
+    GPUGraph::appendToKey(key, box.getTiltFactorXY());
+    GPUGraph::appendToKey(key, box.getTiltFactorXZ());
+    GPUGraph::appendToKey(key, box.getTiltFactorYZ());
+
+    bool aniso = false;
+    for (auto& method : m_methods)
+        aniso = aniso || method->getAnisotropic();
+
+        {
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::readwrite);
+        ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(), access_location::device, access_mode::readwrite);
+        ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(), access_location::device, access_mode::readwrite);
+        ArrayHandle<int3> d_image(m_pdata->getImages(), access_location::device, access_mode::readwrite);
+        ArrayHandle<Scalar4> d_net_force(m_pdata->getNetForce(), access_location::device, access_mode::read);
+        GPUGraph::appendToKey(key, d_pos.data);
+        GPUGraph::appendToKey(key, d_vel.data);
+        GPUGraph::appendToKey(key, d_accel.data);
+        GPUGraph::appendToKey(key, d_image.data);
+        GPUGraph::appendToKey(key, d_net_force.data);
+        }
+
+    if (aniso)
+        {
+        ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
+                                           access_location::device,
+                                           access_mode::readwrite);
+        ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(),
+                                      access_location::device,
+                                      access_mode::readwrite);
+        ArrayHandle<Scalar4> d_net_torque(m_pdata->getNetTorqueArray(), access_location::device, access_mode::read);
+        ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                       access_location::device,
+                                       access_mode::read);
+        GPUGraph::appendToKey(key, d_orientation.data);
+        GPUGraph::appendToKey(key, d_angmom.data);
+        GPUGraph::appendToKey(key, d_net_torque.data);
+        GPUGraph::appendToKey(key, d_inertia.data);
+        }
+
+    for (auto& method : m_methods)
+        {
+        std::shared_ptr<ParticleGroup> group = method->getGroup();
+        GPUGraph::appendToKey(key, method.get());
+        GPUGraph::appendToKey(key, group->getNumMembers());
+            {
+            ArrayHandle<unsigned int> d_index_array(group->getIndexArray(),
+                                                    access_location::device,
+                                                    access_mode::read);
+            GPUGraph::appendToKey(key, d_index_array.data);
+            }
+        method->appendGraphKey(key);
+        }
+
+    if (!graph.isValid(key))
+        {
+        m_exec_conf->msg->notice(6) << "IntegratorTwoStep: capturing GPU graph for step " << (step_one ? 1 : 2)
+                                    << endl;
+
+        graph.beginCapture();
+        for (auto& method : m_methods)
+            {
+            method->setGraphStream(graph.getStream());
+            if (step_one)
+                method->integrateStepOne(timestep);
+            else
+                method->integrateStepTwo(timestep);
+            method->setGraphStream(0);
+            }
+        graph.endCapture(key);
+        }
+
+    graph.launch();
+    }
+#endif
+
 /*! \param enable Enable/disable autotuning
     \param period period (approximate) in time steps when returning occurs
 */
@@ -505,6 +686,15 @@ void export_IntegratorTwoStep(py::module& m)
         .def_property("aniso",
                       &IntegratorTwoStep::getAnisotropicMode,
                       &IntegratorTwoStep::setAnisotropicMode)
+        .def_property("gpu_graphs",
+                      &IntegratorTwoStep::getGPUGraphs,
+                      &IntegratorTwoStep::setGPUGraphs)
+        .def_property("overlap_communication",
+                      &IntegratorTwoStep::getOverlapCommunication,
+                      &IntegratorTwoStep::setOverlapCommunication)
+        .def_property("fuse_net_force",
+                      &IntegratorTwoStep::getFuseNetForce,
+                      &IntegratorTwoStep::setFuseNetForce)
 
         ;
     }
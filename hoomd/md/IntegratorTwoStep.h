@@ -6,6 +6,10 @@
 
 #include "ForceComposite.h"
 
+#ifdef ENABLE_HIP
+#include "hoomd/GPUGraph.h"
+#endif
+
 #pragma once
 
 #ifdef __HIPCC__
@@ -31,6 +35,18 @@
     one and two, and which can use the updated particle positions and velocities to update any slaved degrees
     of freedom (rigid bodies).
 
+    When GPU graphs are enabled with setGPUGraphs() and every method reports isGraphCapturable(), the kernels of
+    integration step one (and of step two) of all methods are captured into a GPUGraph once and replayed on later
+    steps with a single launch. The graph key contains the local particle count, the box, the particle data array
+    pointers, the group index arrays, and the parameters each method appends in appendGraphKey(). A new graph is
+    captured when any of them changes, for example after particles migrate or arrays are reallocated. Force
+    computations run outside of the graphs.
+
+    When the fused net force sum is enabled with setFuseNetForce(), a single integration method that integrates all
+    particles and supports it (canFuseNetForce()) sums the forces into the net force in the kernel of its second half
+    step. This saves the separate summation kernel and one pass over the net force when Integrator::canFuseNetForceGPU()
+    allows it. Otherwise, the net force is summed as usual.
+
     \ingroup updaters
 */
 class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
@@ -117,6 +133,39 @@ class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
         /// (Re-)initialize the integration method
         void initializeIntegrationMethods();
 
+        /// Enable or disable capturing the integration steps into GPU graphs
+        void setGPUGraphs(bool gpu_graphs);
+
+        /// Test if GPU graphs are enabled
+        bool getGPUGraphs()
+            {
+            return m_gpu_graphs;
+            }
+
+        /// Enable or disable overlapping the ghost update with the force computation
+        void setOverlapCommunication(bool overlap_communication)
+            {
+            m_overlap_communication = overlap_communication;
+            }
+
+        /// Test if the ghost update overlaps with the force computation
+        bool getOverlapCommunication()
+            {
+            return m_overlap_communication;
+            }
+
+        /// Enable or disable summing the net force in the integration kernel
+        void setFuseNetForce(bool fuse_net_force)
+            {
+            m_fuse_net_force = fuse_net_force;
+            }
+
+        /// Test if the net force is summed in the integration kernel
+        bool getFuseNetForce()
+            {
+            return m_fuse_net_force;
+            }
+
     protected:
         /// Helper method to test if all added methods have valid restart information
         bool isValidRestart();
@@ -128,6 +177,24 @@ class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
         AnisotropicMode m_aniso_mode; //!< Anisotropic mode for this integrator
 
         std::vector< std::shared_ptr<ForceComposite> > m_composite_forces; //!< A list of active composite forces
+
+        bool m_gpu_graphs;            //!< True if the integration steps should be captured into GPU graphs
+        bool m_overlap_communication; //!< True if forces on local particles are computed during the ghost update
+        bool m_fuse_net_force;        //!< True if the net force should be summed in the integration kernel
+
+        #ifdef ENABLE_HIP
+        std::unique_ptr<GPUGraph> m_graph_one;  //!< Graph for integration step one
+        std::unique_ptr<GPUGraph> m_graph_two;  //!< Graph for integration step two
+
+        /// Test if the integration steps in this time step can be captured into GPU graphs
+        bool useGPUGraphs();
+
+        /// Run one integration step of all methods through a GPU graph
+        void runGPUGraph(GPUGraph& graph, unsigned int timestep, bool step_one);
+
+        /// Test if the net force sum in this time step can be performed by the integration kernel
+        bool useFusedNetForce(unsigned int timestep);
+        #endif
     };
 
 /// Exports the IntegratorTwoStep class to python
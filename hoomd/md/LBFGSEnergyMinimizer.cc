@@ -0,0 +1,178 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "LBFGSEnergyMinimizer.h"
+
+#include <algorithm>
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \file LBFGSEnergyMinimizer.cc
+    \brief Contains code for the LBFGSEnergyMinimizer class
+*/
+
+/*! \param sysdef SystemDefinition this method will act on. Must not be NULL.
+    \param max_move largest distance any particle may move in one step
+*/
+LBFGSEnergyMinimizer::LBFGSEnergyMinimizer(std::shared_ptr<SystemDefinition> sysdef, Scalar max_move)
+    :   LineSearchEnergyMinimizer(sysdef, max_move),
+        m_history_size(10),
+        m_num_stored(0),
+        m_newest(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing LBFGSEnergyMinimizer" << endl;
+    resetDirection();
+    }
+
+LBFGSEnergyMinimizer::~LBFGSEnergyMinimizer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying LBFGSEnergyMinimizer" << endl;
+    }
+
+/*! \param history_size is the new number of steps to keep
+*/
+void LBFGSEnergyMinimizer::setHistorySize(unsigned int history_size)
+    {
+    if (history_size == 0)
+        {
+        m_exec_conf->msg->error() << "minimize.lbfgs: the history size should be positive" << endl;
+        throw runtime_error("Error setting parameters for LBFGSEnergyMinimizer");
+        }
+
+    m_history_size = history_size;
+
+    // the search continues with steepest descent, all ranks restart together
+    restart();
+    }
+
+void LBFGSEnergyMinimizer::resetDirection()
+    {
+    m_num_stored = 0;
+    m_newest = 0;
+
+    unsigned int size = m_history_size*std::max(m_n, 1u);
+    if (m_s.getNumElements() != size)
+        {
+        GPUArray<Scalar3> s(size, m_exec_conf);
+        m_s.swap(s);
+        GPUArray<Scalar3> y(size, m_exec_conf);
+        m_y.swap(y);
+        }
+
+    m_rho.resize(m_history_size);
+    m_coeff.resize(m_history_size);
+    }
+
+/*! \param slope g0.d along the new search direction
+*/
+Scalar LBFGSEnergyMinimizer::getInitialStep(Scalar slope)
+    {
+    if (m_num_stored > 0)
+        return Scalar(1.0);
+
+    return LineSearchEnergyMinimizer::getInitialStep(slope);
+    }
+
+/*! \param n Number of local group members
+    \param grad Gradient at the current point
+    \param old_grad Gradient at the previous point
+    \param dir Search direction of the previous step on input, new search direction on output
+    \param step Length of the previous step along the previous direction
+*/
+void LBFGSEnergyMinimizer::computeDirection(unsigned int n, const Scalar3 *grad, const Scalar3 *old_grad,
+    Scalar3 *dir, Scalar step)
+    {
+    ArrayHandle<Scalar3> h_s(m_s, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar3> h_y(m_y, access_location::host, access_mode::readwrite);
+
+    // store the last step in the slot after the newest, which is the oldest when the history is full
+    unsigned int slot = (m_num_stored == 0) ? 0 : (m_newest + 1) % m_history_size;
+    Scalar3 *s = h_s.data + slot*n;
+    Scalar3 *y = h_y.data + slot*n;
+    for (unsigned int k = 0; k < n; k++)
+        {
+        s[k] = make_scalar3(step*dir[k].x, step*dir[k].y, step*dir[k].z);
+        y[k] = make_scalar3(grad[k].x - old_grad[k].x, grad[k].y - old_grad[k].y, grad[k].z - old_grad[k].z);
+        }
+
+    Scalar sy = dotProduct(n, s, y);
+    if (sy > Scalar(0.0))
+        {
+        m_rho[slot] = Scalar(1.0)/sy;
+        m_newest = slot;
+        m_num_stored = std::min(m_num_stored + 1, m_history_size);
+        }
+    else if (m_num_stored == m_history_size)
+        {
+        // the oldest step was overwritten
+        m_num_stored--;
+        }
+
+    // q = g
+    for (unsigned int k = 0; k < n; k++)
+        dir[k] = grad[k];
+
+    if (m_num_stored == 0)
+        {
+        for (unsigned int k = 0; k < n; k++)
+            dir[k] = make_scalar3(-dir[k].x, -dir[k].y, -dir[k].z);
+        return;
+        }
+
+    // first loop, from the newest to the oldest step
+    for (unsigned int i = 0; i < m_num_stored; i++)
+        {
+        unsigned int cur = (m_newest + m_history_size - i) % m_history_size;
+        const Scalar3 *s_i = h_s.data + cur*n;
+        const Scalar3 *y_i = h_y.data + cur*n;
+        Scalar a = m_rho[cur]*dotProduct(n, s_i, dir);
+        m_coeff[cur] = a;
+        for (unsigned int k = 0; k < n; k++)
+            {
+            dir[k].x -= a*y_i[k].x;
+            dir[k].y -= a*y_i[k].y;
+            dir[k].z -= a*y_i[k].z;
+            }
+        }
+
+    // initial inverse Hessian gamma I with gamma = s.y/y.y of the newest step
+    const Scalar3 *y_newest = h_y.data + m_newest*n;
+    Scalar gamma = Scalar(1.0)/(m_rho[m_newest]*dotProduct(n, y_newest, y_newest));
+    for (unsigned int k = 0; k < n; k++)
+        {
+        dir[k].x *= gamma;
+        dir[k].y *= gamma;
+        dir[k].z *= gamma;
+        }
+
+    // second loop, from the oldest to the newest step
+    for (unsigned int i = m_num_stored; i > 0; i--)
+        {
+        unsigned int cur = (m_newest + m_history_size - (i-1)) % m_history_size;
+        const Scalar3 *s_i = h_s.data + cur*n;
+        const Scalar3 *y_i = h_y.data + cur*n;
+        Scalar b = m_rho[cur]*dotProduct(n, y_i, dir);
+        Scalar c = m_coeff[cur] - b;
+        for (unsigned int k = 0; k < n; k++)
+            {
+            dir[k].x += c*s_i[k].x;
+            dir[k].y += c*s_i[k].y;
+            dir[k].z += c*s_i[k].z;
+            }
+        }
+
+    // d = -H g
+    for (unsigned int k = 0; k < n; k++)
+        dir[k] = make_scalar3(-dir[k].x, -dir[k].y, -dir[k].z);
+    }
+
+void export_LBFGSEnergyMinimizer(py::module& m)
+    {
+    py::class_<LBFGSEnergyMinimizer, LineSearchEnergyMinimizer, std::shared_ptr<LBFGSEnergyMinimizer> >(m,
+        "LBFGSEnergyMinimizer")
+        .def(py::init< std::shared_ptr<SystemDefinition>, Scalar >())
+        .def("setHistorySize", &LBFGSEnergyMinimizer::setHistorySize)
+        .def("getHistorySize", &LBFGSEnergyMinimizer::getHistorySize)
+        ;
+    }
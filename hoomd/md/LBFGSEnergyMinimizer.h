@@ -0,0 +1,73 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "LineSearchEnergyMinimizer.h"
+
+#include <vector>
+
+#ifndef __LBFGS_ENERGY_MINIMIZER_H__
+#define __LBFGS_ENERGY_MINIMIZER_H__
+
+/*! \file LBFGSEnergyMinimizer.h
+    \brief Declares the L-BFGS energy minimizer class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+//! Finds the nearest basin in the potential energy landscape with the limited memory BFGS method
+/*! \b Overview
+
+    The minimizer keeps the last m steps s = x - x_prev and gradient changes y = g - g_prev, and computes the search
+    direction d = -H g with the two loop recursion, where H is the inverse Hessian approximation built from the
+    history and scaled by s.y/y.y of the newest pair. Pairs with s.y <= 0 would make H indefinite and are not stored.
+    The first trial step along each direction is the unit step, and the line search uses the curvature condition with
+    c2 = 0.9.
+
+    The history holds 2m vectors of the size of the local group members.
+
+    \ingroup updaters
+*/
+class PYBIND11_EXPORT LBFGSEnergyMinimizer : public LineSearchEnergyMinimizer
+    {
+    public:
+        //! Constructs the minimizer and associates it with the system
+        LBFGSEnergyMinimizer(std::shared_ptr<SystemDefinition> sysdef, Scalar max_move);
+        virtual ~LBFGSEnergyMinimizer();
+
+        //! Set the number of steps kept in the history
+        void setHistorySize(unsigned int history_size);
+
+        //! Get the number of steps kept in the history
+        unsigned int getHistorySize() const
+            {
+            return m_history_size;
+            }
+
+    protected:
+        //! Discard the history
+        virtual void resetDirection();
+
+        //! Compute the quasi-Newton direction
+        virtual void computeDirection(unsigned int n, const Scalar3 *grad, const Scalar3 *old_grad, Scalar3 *dir,
+            Scalar step);
+
+        //! Take the unit step when the history is not empty
+        virtual Scalar getInitialStep(Scalar slope);
+
+        unsigned int m_history_size;        //!< maximum number of steps in the history
+        unsigned int m_num_stored;          //!< number of steps in the history
+        unsigned int m_newest;              //!< history slot of the newest step
+        GPUArray<Scalar3> m_s;              //!< steps, one vector of all local group members per slot
+        GPUArray<Scalar3> m_y;              //!< gradient changes, one vector of all local group members per slot
+        std::vector<Scalar> m_rho;          //!< 1/(s.y) for each slot
+        std::vector<Scalar> m_coeff;        //!< coefficients of the first loop of the recursion
+    };
+
+//! Exports the LBFGSEnergyMinimizer class to python
+void export_LBFGSEnergyMinimizer(pybind11::module& m);
+
+#endif // #ifndef __LBFGS_ENERGY_MINIMIZER_H__
@@ -0,0 +1,19 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file LJEwaldDriverPotentialPairGPU.cu
+    \brief Defines the driver functions for computing all types of pair forces on the GPU
+*/
+
+#include "EvaluatorPairSum.h"
+#include "AllDriverPotentialPairGPU.cuh"
+hipError_t gpu_compute_lj_ewald_forces(const pair_args_t& pair_args,
+                                       const EvaluatorPairSum<EvaluatorPairLJ, EvaluatorPairEwald>::param_type *d_params)
+    {
+    return gpu_compute_pair_forces<EvaluatorPairSum<EvaluatorPairLJ, EvaluatorPairEwald> >(pair_args,
+                                                                                          d_params);
+    }
+
+template hipError_t gpu_compute_pair_set_energy<EvaluatorPairSum<EvaluatorPairLJ, EvaluatorPairEwald> >(
+    const pair_set_energy_args_t& args,
+    const EvaluatorPairSum<EvaluatorPairLJ, EvaluatorPairEwald>::param_type *d_params);
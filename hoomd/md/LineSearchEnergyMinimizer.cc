@@ -0,0 +1,529 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "LineSearchEnergyMinimizer.h"
+
+#include <algorithm>
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \file LineSearchEnergyMinimizer.cc
+    \brief Contains code for the LineSearchEnergyMinimizer class
+*/
+
+//! Fraction of the decrease predicted by the slope that the Armijo condition requires
+const Scalar ARMIJO_C1 = Scalar(1e-4);
+
+//! Number of trial steps before the line search gives up on the strong Wolfe conditions
+const unsigned int MAX_TRIALS = 20;
+
+/*! \param sysdef SystemDefinition this method will act on. Must not be NULL.
+    \param max_move largest distance any particle may move in one step
+
+    \post The method is constructed with the given particle data and a NULL profiler.
+*/
+LineSearchEnergyMinimizer::LineSearchEnergyMinimizer(std::shared_ptr<SystemDefinition> sysdef, Scalar max_move)
+    :   IntegratorTwoStep(sysdef, max_move),
+        m_max_move(max_move),
+        m_ftol(Scalar(1e-1)),
+        m_etol(Scalar(1e-5)),
+        m_run_minsteps(10),
+        m_n_since_start(0),
+        m_energy_total(Scalar(0.0)),
+        m_old_energy(Scalar(0.0)),
+        m_converged(false),
+        m_was_reset(true),
+        m_step(Scalar(0.0)),
+        m_prev_step(Scalar(0.0)),
+        m_slope(Scalar(0.0)),
+        m_prev_slope(Scalar(0.0)),
+        m_energy0(Scalar(0.0)),
+        m_step_max(Scalar(0.0)),
+        m_step_lo(Scalar(0.0)),
+        m_energy_lo(Scalar(0.0)),
+        m_dphi_lo(Scalar(0.0)),
+        m_step_hi(Scalar(0.0)),
+        m_energy_hi(Scalar(0.0)),
+        m_wolfe_c2(Scalar(0.9)),
+        m_n_trials(0),
+        m_have_hi(false),
+        m_accept_next(false),
+        m_in_line_search(false),
+        m_have_step(false),
+        m_steepest_descent(true),
+        m_order_changed(false),
+        m_n(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing LineSearchEnergyMinimizer" << endl;
+
+    // sanity check
+    assert(m_sysdef);
+    assert(m_pdata);
+
+    setMaxMove(max_move);
+
+    m_pdata->getParticleSortSignal().connect<LineSearchEnergyMinimizer,
+        &LineSearchEnergyMinimizer::slotParticleSort>(this);
+    }
+
+LineSearchEnergyMinimizer::~LineSearchEnergyMinimizer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying LineSearchEnergyMinimizer" << endl;
+
+    m_pdata->getParticleSortSignal().disconnect<LineSearchEnergyMinimizer,
+        &LineSearchEnergyMinimizer::slotParticleSort>(this);
+    }
+
+/*! \param max_move is the new maximum move to set
+*/
+void LineSearchEnergyMinimizer::setMaxMove(Scalar max_move)
+    {
+    if (!(max_move > 0.0))
+        {
+        m_exec_conf->msg->error() << "minimize: max_move should be positive" << endl;
+        throw runtime_error("Error setting parameters for LineSearchEnergyMinimizer");
+        }
+    m_max_move = max_move;
+    }
+
+void LineSearchEnergyMinimizer::reset()
+    {
+    m_converged = false;
+    m_n_since_start = 0;
+    m_was_reset = true;
+    m_energy_total = 0.0;
+    restart();
+    }
+
+void LineSearchEnergyMinimizer::restart()
+    {
+    m_in_line_search = false;
+    m_have_step = false;
+    resetDirection();
+    }
+
+/*! \param slope g0.d along the new search direction
+
+    Without a previous step, the first trial is the unit step, limited by the maximum move. Otherwise the trial step
+    is chosen so that the first order change of the energy equals that of the previous accepted step.
+*/
+Scalar LineSearchEnergyMinimizer::getInitialStep(Scalar slope)
+    {
+    if (!m_have_step)
+        return Scalar(1.0);
+
+    return m_prev_step*m_prev_slope/slope;
+    }
+
+/*! \param n number of local group members
+    \param a first vector
+    \param b second vector
+*/
+Scalar LineSearchEnergyMinimizer::dotProduct(unsigned int n, const Scalar3 *a, const Scalar3 *b)
+    {
+    Scalar sum(0.0);
+    for (unsigned int k = 0; k < n; k++)
+        sum += a[k].x*b[k].x + a[k].y*b[k].y + a[k].z*b[k].z;
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        MPI_Allreduce(MPI_IN_PLACE, &sum, 1, MPI_HOOMD_SCALAR, MPI_SUM, m_exec_conf->getMPICommunicator());
+    #endif
+
+    return sum;
+    }
+
+/*! \returns true if the number of local group members changed
+*/
+bool LineSearchEnergyMinimizer::updateMembers()
+    {
+    m_members.clear();
+    for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
+        {
+        std::shared_ptr<ParticleGroup> current_group = (*method)->getGroup();
+        unsigned int group_size = current_group->getNumMembers();
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            m_members.push_back(current_group->getMemberIndex(group_idx));
+        }
+
+    if (m_members.size() != m_n || m_grad.isNull())
+        {
+        m_n = (unsigned int) m_members.size();
+
+        // keep the arrays allocated when a rank has no members
+        unsigned int size = std::max(m_n, 1u);
+        GPUArray<Scalar3> grad(size, m_exec_conf);
+        m_grad.swap(grad);
+        GPUArray<Scalar3> grad0(size, m_exec_conf);
+        m_grad0.swap(grad0);
+        GPUArray<Scalar3> dir(size, m_exec_conf);
+        m_dir.swap(dir);
+        GPUArray<Scalar4> pos0(size, m_exec_conf);
+        m_pos0.swap(pos0);
+        GPUArray<int3> image0(size, m_exec_conf);
+        m_image0.swap(image0);
+        return true;
+        }
+
+    return false;
+    }
+
+void LineSearchEnergyMinimizer::setTrialPositions()
+    {
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_pos0(m_pos0, access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image0(m_image0, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_dir(m_dir, access_location::host, access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+
+    for (unsigned int k = 0; k < m_n; k++)
+        {
+        unsigned int j = m_members[k];
+        Scalar4 pos0 = h_pos0.data[k];
+        Scalar3 d = h_dir.data[k];
+        Scalar3 pos = make_scalar3(pos0.x + m_step*d.x, pos0.y + m_step*d.y, pos0.z + m_step*d.z);
+        int3 image = h_image0.data[k];
+        box.wrap(pos, image);
+
+        h_pos.data[j] = make_scalar4(pos.x, pos.y, pos.z, pos0.w);
+        h_image.data[j] = image;
+        }
+    }
+
+/*! \param timestep is the current timestep
+
+    The forces are computed for timestep+1, as IntegratorTwoStep::update() does after moving the particles.
+*/
+void LineSearchEnergyMinimizer::computeForces(unsigned int timestep)
+    {
+#ifdef ENABLE_MPI
+    if (m_comm)
+        m_comm->communicate(timestep+1);
+    else
+#endif
+        updateRigidBodies(timestep+1);
+
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        computeNetForceGPU(timestep+1);
+    else
+#endif
+        computeNetForce(timestep+1);
+    }
+
+/*! \param energy_total total energy of all group members at the accepted point
+    \param total_n number of group members on all ranks
+    \param timestep is the current timestep
+    \returns true when the minimization has converged
+*/
+bool LineSearchEnergyMinimizer::testConvergence(Scalar energy_total, unsigned int total_n, unsigned int timestep)
+    {
+    Scalar energy = energy_total/Scalar(total_n);
+    m_energy_total = energy_total;
+
+    if (m_was_reset)
+        {
+        m_was_reset = false;
+        m_old_energy = energy + Scalar(100000)*m_etol;
+        }
+
+    Scalar fnorm;
+        {
+        ArrayHandle<Scalar3> h_grad(m_grad, access_location::host, access_mode::read);
+        fnorm = sqrt(dotProduct(m_n, h_grad.data, h_grad.data));
+        }
+
+    unsigned int ndof = m_sysdef->getNDimensions()*total_n;
+    m_exec_conf->msg->notice(10) << "minimize fnorm " << fnorm << " delta_E " << energy-m_old_energy << std::endl;
+
+    if (fnorm/sqrt(Scalar(ndof)) < m_ftol && fabs(energy-m_old_energy) < m_etol && m_n_since_start >= m_run_minsteps)
+        {
+        m_converged = true;
+        m_exec_conf->msg->notice(4) << "minimize converged in timestep " << timestep << std::endl;
+        return true;
+        }
+
+    m_old_energy = energy;
+    m_n_since_start++;
+    return false;
+    }
+
+/*! \param energy_total total energy of all group members at the trial point
+    \returns true when the trial step is accepted, otherwise m_step is set to the next trial step
+
+    Bracketing and zoom phases of the line search that finds a step satisfying the strong Wolfe conditions
+    E <= E0 + c1 a (g0.d) and |g.d| <= c2 |g0.d|, see Nocedal and Wright, Numerical Optimization, algorithms 3.5 and
+    3.6. [m_step_lo, m_step_hi] brackets the step, m_step_lo is the step with the lowest energy that satisfies the
+    first condition.
+*/
+bool LineSearchEnergyMinimizer::advanceLineSearch(Scalar energy_total)
+    {
+    Scalar dphi;
+        {
+        ArrayHandle<Scalar3> h_grad(m_grad, access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_dir(m_dir, access_location::host, access_mode::read);
+        dphi = dotProduct(m_n, h_grad.data, h_dir.data);
+        }
+
+    if (energy_total > m_energy0 + ARMIJO_C1*m_step*m_slope || energy_total >= m_energy_lo)
+        {
+        m_step_hi = m_step;
+        m_energy_hi = energy_total;
+        m_have_hi = true;
+        }
+    else if (fabs(dphi) <= -m_wolfe_c2*m_slope)
+        {
+        return true;
+        }
+    else
+        {
+        if (m_have_hi ? dphi*(m_step_hi - m_step_lo) >= Scalar(0.0) : dphi >= Scalar(0.0))
+            {
+            m_step_hi = m_step_lo;
+            m_energy_hi = m_energy_lo;
+            m_have_hi = true;
+            }
+
+        m_step_lo = m_step;
+        m_energy_lo = energy_total;
+        m_dphi_lo = dphi;
+
+        // the step can not grow beyond the maximum move
+        if (!m_have_hi && m_step >= m_step_max)
+            return true;
+        }
+
+    if (m_have_hi)
+        {
+        // minimum of the parabola through E_lo with slope dphi_lo and E_hi, within the inner 80% of the bracket
+        Scalar w = m_step_hi - m_step_lo;
+        Scalar c = m_energy_hi - m_energy_lo - m_dphi_lo*w;
+        Scalar t = (c > Scalar(0.0)) ? -m_dphi_lo*w/(Scalar(2.0)*c) : Scalar(0.5);
+        t = std::min(std::max(t, Scalar(0.1)), Scalar(0.9));
+        m_step = m_step_lo + t*w;
+        }
+    else
+        {
+        m_step = std::min(Scalar(4.0)*m_step, m_step_max);
+        }
+
+    return false;
+    }
+
+/*! \param timestep is the current timestep
+*/
+void LineSearchEnergyMinimizer::update(unsigned int timestep)
+    {
+    if (m_converged)
+        return;
+
+    if (m_prof)
+        m_prof->push("Minimize");
+
+    // the vectors are indexed by the order of the local group members, all ranks restart together
+    int order_changed = updateMembers() || m_order_changed;
+    m_order_changed = false;
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        MPI_Allreduce(MPI_IN_PLACE, &order_changed, 1, MPI_INT, MPI_LOR, m_exec_conf->getMPICommunicator());
+    #endif
+
+    if (order_changed)
+        restart();
+
+    // energy and gradient at the current point
+    double pe_total = 0.0;
+    unsigned int total_n = m_n;
+
+        {
+        ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_grad(m_grad, access_location::host, access_mode::overwrite);
+
+        for (unsigned int k = 0; k < m_n; k++)
+            {
+            Scalar4 f = h_net_force.data[m_members[k]];
+            pe_total += (double)f.w;
+            h_grad.data[k] = make_scalar3(-f.x, -f.y, -f.z);
+            }
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &pe_total, 1, MPI_DOUBLE, MPI_SUM, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, &total_n, 1, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    if (total_n == 0)
+        {
+        if (m_prof)
+            m_prof->pop();
+        return;
+        }
+
+    Scalar energy_total = Scalar(pe_total);
+
+    if (m_in_line_search)
+        {
+        if (!m_accept_next && !advanceLineSearch(energy_total))
+            {
+            if (m_n_trials < MAX_TRIALS)
+                {
+                m_n_trials++;
+                }
+            else if (m_step_lo > Scalar(0.0))
+                {
+                // give up on the strong Wolfe conditions, go back to the best step that decreased the energy
+                m_step = m_step_lo;
+                m_accept_next = true;
+                }
+            else
+                {
+                // the line search failed, return to the start of the line search
+                if (m_steepest_descent)
+                    {
+                    m_exec_conf->msg->notice(4) << "minimize: no decrease of the energy along the forces in timestep "
+                        << timestep << ", stopping" << std::endl;
+                    m_converged = true;
+                    }
+                else
+                    {
+                    m_exec_conf->msg->notice(6) << "minimize: line search failed, restarting with steepest descent"
+                        << std::endl;
+                    }
+
+                m_step = Scalar(0.0);
+                restart();
+                }
+
+            setTrialPositions();
+            if (m_prof)
+                m_prof->pop();
+            computeForces(timestep);
+            return;
+            }
+
+        // accept the step
+        m_in_line_search = false;
+        m_have_step = true;
+        m_prev_step = m_step;
+        m_prev_slope = m_slope;
+
+        if (testConvergence(energy_total, total_n, timestep))
+            {
+            if (m_prof)
+                m_prof->pop();
+            return;
+            }
+        }
+    else if (m_was_reset)
+        {
+        // the energy has no previous value to compare to, this sets the reference
+        testConvergence(energy_total, total_n, timestep);
+        }
+
+    // compute the new search direction
+    Scalar slope(0.0);
+    Scalar dmaxsq(0.0);
+
+        {
+        ArrayHandle<Scalar3> h_grad(m_grad, access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_grad0(m_grad0, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar3> h_dir(m_dir, access_location::host, access_mode::readwrite);
+
+        if (m_have_step)
+            {
+            computeDirection(m_n, h_grad.data, h_grad0.data, h_dir.data, m_prev_step);
+            slope = dotProduct(m_n, h_grad.data, h_dir.data);
+            }
+
+        m_steepest_descent = !m_have_step || !(slope < Scalar(0.0));
+        if (m_steepest_descent)
+            {
+            // not a descent direction, fall back to steepest descent
+            if (m_have_step)
+                {
+                resetDirection();
+                m_have_step = false;
+                }
+
+            for (unsigned int k = 0; k < m_n; k++)
+                h_dir.data[k] = make_scalar3(-h_grad.data[k].x, -h_grad.data[k].y, -h_grad.data[k].z);
+            slope = -dotProduct(m_n, h_grad.data, h_grad.data);
+            }
+
+        for (unsigned int k = 0; k < m_n; k++)
+            {
+            Scalar3 d = h_dir.data[k];
+            dmaxsq = std::max(dmaxsq, d.x*d.x + d.y*d.y + d.z*d.z);
+            h_grad0.data[k] = h_grad.data[k];
+            }
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        MPI_Allreduce(MPI_IN_PLACE, &dmaxsq, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_exec_conf->getMPICommunicator());
+    #endif
+
+    if (slope == Scalar(0.0))
+        {
+        // all forces vanish
+        m_converged = true;
+        if (m_prof)
+            m_prof->pop();
+        return;
+        }
+
+    m_step_max = m_max_move/sqrt(dmaxsq);
+    Scalar step = std::min(getInitialStep(slope), m_step_max);
+
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_pos0(m_pos0, access_location::host, access_mode::overwrite);
+        ArrayHandle<int3> h_image0(m_image0, access_location::host, access_mode::overwrite);
+
+        for (unsigned int k = 0; k < m_n; k++)
+            {
+            h_pos0.data[k] = h_pos.data[m_members[k]];
+            h_image0.data[k] = h_image.data[m_members[k]];
+            }
+        }
+
+    m_energy0 = energy_total;
+    m_step = step;
+    m_slope = slope;
+    m_step_lo = Scalar(0.0);
+    m_energy_lo = energy_total;
+    m_dphi_lo = slope;
+    m_have_hi = false;
+    m_accept_next = false;
+    m_n_trials = 0;
+    m_in_line_search = true;
+
+    setTrialPositions();
+
+    if (m_prof)
+        m_prof->pop();
+
+    computeForces(timestep);
+    }
+
+void export_LineSearchEnergyMinimizer(py::module& m)
+    {
+    py::class_<LineSearchEnergyMinimizer, IntegratorTwoStep, std::shared_ptr<LineSearchEnergyMinimizer> >(m,
+        "LineSearchEnergyMinimizer")
+        .def("reset", &LineSearchEnergyMinimizer::reset)
+        .def("hasConverged", &LineSearchEnergyMinimizer::hasConverged)
+        .def("getEnergy", &LineSearchEnergyMinimizer::getEnergy)
+        .def("setMaxMove", &LineSearchEnergyMinimizer::setMaxMove)
+        .def("setFtol", &LineSearchEnergyMinimizer::setFtol)
+        .def("setEtol", &LineSearchEnergyMinimizer::setEtol)
+        .def("setMinSteps", &LineSearchEnergyMinimizer::setMinSteps)
+        ;
+    }
@@ -0,0 +1,189 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "IntegratorTwoStep.h"
+
+#include <memory>
+#include <vector>
+
+#ifndef __LINE_SEARCH_ENERGY_MINIMIZER_H__
+#define __LINE_SEARCH_ENERGY_MINIMIZER_H__
+
+/*! \file LineSearchEnergyMinimizer.h
+    \brief Declares the base class of the line search energy minimizers
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+//! Base class for energy minimizers that search along a direction computed from the forces
+/*! \b Overview
+
+    The particles in the groups of the integration methods are minimized, all other particles stay fixed. The
+    integration methods only select the particles: they are not integrated. Each call to update() evaluates the
+    forces once, so that a step of the minimizer costs the same as a step of FIREEnergyMinimizer:
+
+    - At an accepted point, the minimizer checks for convergence, asks the subclass for a search direction d with
+      computeDirection(), and moves the particles to x0 + a d.
+    - At a trial point, the minimizer accepts the step a when it satisfies the strong Wolfe conditions
+      E <= E0 + c1 a (g0.d) and |g.d| <= c2 |g0.d|, where g = -F is the gradient. Otherwise it brackets the step and
+      interpolates the next trial. The forces at the trial point give g.d without extra evaluations.
+
+    The step is limited so that no particle moves by more than the maximum move. Convergence is tested as in
+    FIREEnergyMinimizer, with the norm of the forces instead of the accelerations.
+
+    The vectors are stored in the order of the local group members, so the search restarts with steepest descent
+    whenever the particles are sorted or migrate between domains. Dot products are summed over all
+    ranks. Only the positions are minimized, orientations are not changed.
+
+    \ingroup updaters
+*/
+class PYBIND11_EXPORT LineSearchEnergyMinimizer : public IntegratorTwoStep
+    {
+    public:
+        //! Constructs the minimizer and associates it with the system
+        LineSearchEnergyMinimizer(std::shared_ptr<SystemDefinition> sysdef, Scalar max_move);
+        virtual ~LineSearchEnergyMinimizer();
+
+        //! Reset the minimization
+        virtual void reset();
+
+        //! Perform one force evaluation of the minimization
+        virtual void update(unsigned int timestep);
+
+        //! Return whether or not the minimization has converged
+        bool hasConverged() const {return m_converged;}
+
+        //! Request the potential energy, which the minimizer needs on every step
+        virtual PDataFlags getRequestedPDataFlags()
+            {
+            PDataFlags flags = IntegratorTwoStep::getRequestedPDataFlags();
+            flags[pdata_flag::potential_energy] = 1;
+            return flags;
+            }
+
+        //! Return the potential energy at the last accepted point
+        Scalar getEnergy() const
+            {
+            if (m_was_reset)
+                {
+                m_exec_conf->msg->warning() << "The minimizer has just been initialized. Return energy==0."
+                    << std::endl;
+                return Scalar(0.0);
+                }
+
+            return m_energy_total;
+            }
+
+        //! Set the largest distance any particle may move in one step
+        void setMaxMove(Scalar max_move);
+
+        //! Set the stopping criterion based on the total force on all particles in the system
+        /*! \param ftol is the new force tolerance to set
+        */
+        void setFtol(Scalar ftol) {m_ftol = ftol;}
+
+        //! Set the stopping criterion based on the change in energy between successive iterations
+        /*! \param etol is the new energy tolerance to set
+        */
+        void setEtol(Scalar etol) {m_etol = etol;}
+
+        //! Set the a minimum number of steps before the other stopping criteria will be evaluated
+        /*! \param steps is the minimum number of steps (attempts) that will be made
+        */
+        void setMinSteps(unsigned int steps) {m_run_minsteps = steps;}
+
+    protected:
+        //! Discard the information the direction is built from, so that the next direction is steepest descent
+        virtual void resetDirection() = 0;
+
+        //! Compute the next search direction from the previous step
+        /*! \param n Number of local group members
+            \param grad Gradient at the current point
+            \param old_grad Gradient at the previous point
+            \param dir Search direction of the previous step on input, new search direction on output
+            \param step Length of the previous step along the previous direction
+
+            After a reset or a restart, there is no previous step and the direction is steepest descent -g without
+            calling computeDirection().
+        */
+        virtual void computeDirection(unsigned int n, const Scalar3 *grad, const Scalar3 *old_grad, Scalar3 *dir,
+            Scalar step) = 0;
+
+        //! Initial step along a new search direction
+        virtual Scalar getInitialStep(Scalar slope);
+
+        //! Discard the current line search and start again from the current point with steepest descent
+        void restart();
+
+        //! Dot product of two vectors of the local group members, summed over all ranks
+        Scalar dotProduct(unsigned int n, const Scalar3 *a, const Scalar3 *b);
+
+        Scalar m_max_move;                  //!< largest distance any particle may move in one step
+        Scalar m_ftol;                      //!< stopping tolerance based on total force
+        Scalar m_etol;                      //!< stopping tolerance based on the change in energy
+        unsigned int m_run_minsteps;        //!< a minimum number of iterations the search will use
+        unsigned int m_n_since_start;       //!< number of accepted iterations
+        Scalar m_energy_total;              //!< total energy of all integrator groups at the last accepted point
+        Scalar m_old_energy;                //!< energy per particle at the last accepted point
+        bool m_converged;                   //!< whether the minimization has converged
+        bool m_was_reset;                   //!< whether or not the minimizer was reset
+
+        Scalar m_step;                      //!< step along the current search direction
+        Scalar m_prev_step;                 //!< accepted step along the previous search direction
+        Scalar m_slope;                     //!< g0.d along the current search direction
+        Scalar m_prev_slope;                //!< g0.d along the previous search direction
+        Scalar m_energy0;                   //!< total energy at the start of the line search
+        Scalar m_step_max;                  //!< step that moves the particles by the maximum move
+        Scalar m_step_lo;                   //!< end of the bracket with the lower energy
+        Scalar m_energy_lo;                 //!< total energy at m_step_lo
+        Scalar m_dphi_lo;                   //!< g.d at m_step_lo
+        Scalar m_step_hi;                   //!< other end of the bracket
+        Scalar m_energy_hi;                 //!< total energy at m_step_hi
+        Scalar m_wolfe_c2;                  //!< curvature condition parameter c2, set by the subclass
+        unsigned int m_n_trials;            //!< number of trial steps in this line search
+        bool m_have_hi;                     //!< true once the step is bracketed
+        bool m_accept_next;                 //!< true when the current trial point is accepted without tests
+        bool m_in_line_search;              //!< true when the particles are at a trial point
+        bool m_have_step;                   //!< true when the previous step can be used to build the direction
+        bool m_steepest_descent;            //!< true when the current search direction is -g
+        bool m_order_changed;               //!< true when the local particles were reordered
+
+        unsigned int m_n;                   //!< number of local group members
+        std::vector<unsigned int> m_members;    //!< local indices of the group members
+        GPUArray<Scalar3> m_grad;           //!< gradient at the current point
+        GPUArray<Scalar3> m_grad0;          //!< gradient at the start of the line search
+        GPUArray<Scalar3> m_dir;            //!< search direction
+        GPUArray<Scalar4> m_pos0;           //!< positions at the start of the line search
+        GPUArray<int3> m_image0;            //!< images at the start of the line search
+
+    private:
+        //! Called when the local particles are reordered
+        void slotParticleSort()
+            {
+            m_order_changed = true;
+            }
+
+        //! Collect the local group members and resize the vectors
+        bool updateMembers();
+
+        //! Move the group members to x0 + m_step d
+        void setTrialPositions();
+
+        //! Test the trial point and choose the next trial step
+        bool advanceLineSearch(Scalar energy_total);
+
+        //! Evaluate the forces at the new positions
+        void computeForces(unsigned int timestep);
+
+        //! Test the stopping criteria at an accepted point
+        bool testConvergence(Scalar energy_total, unsigned int total_n, unsigned int timestep);
+    };
+
+//! Exports the LineSearchEnergyMinimizer class to python
+void export_LineSearchEnergyMinimizer(pybind11::module& m);
+
+#endif // #ifndef __LINE_SEARCH_ENERGY_MINIMIZER_H__
@@ -0,0 +1,58 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file MDPrecisionSetup.h
+    \brief Setup for md mixed precision pair force evaluation
+*/
+
+#ifndef __MD_PRECISION_SETUP_H__
+#define __MD_PRECISION_SETUP_H__
+
+#ifdef SINGLE_PRECISION
+
+// in single precision, PairReal is always float
+//! Typedef'd real for use in per pair force evaluations
+typedef float PairReal;
+//! Typedef'd real3 for use in per pair force evaluations
+typedef float3 PairReal3;
+
+#else
+
+// in double precision, mixed mode enables floats for PairReal, otherwise it is double
+// Per particle sums of forces, energies, and virials are always accumulated in Scalar
+#ifdef ENABLE_MD_MIXED_PRECISION
+typedef float PairReal;
+typedef float3 PairReal3;
+
+#else
+typedef double PairReal;
+typedef double3 PairReal3;
+
+#endif
+
+#endif
+
+// need to declare these functions with __host__ __device__ qualifiers when building in nvcc
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+//! Helper function to create PairReal3's
+HOSTDEVICE inline PairReal3 make_pairreal3(PairReal x, PairReal y, PairReal z)
+    {
+    PairReal3 result;
+    result.x = x;
+    result.y = y;
+    result.z = z;
+    return result;
+    }
+
+// undefine HOSTDEVICE so we don't interfere with other headers
+#undef HOSTDEVICE
+
+#endif //__MD_PRECISION_SETUP_H__
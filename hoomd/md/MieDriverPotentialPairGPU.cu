@@ -15,3 +15,5 @@ hipError_t gpu_compute_mie_forces(const pair_args_t & args,
                                                      d_params);
     }
 
+template hipError_t gpu_compute_pair_set_energy<EvaluatorPairMie>(const pair_set_energy_args_t& args,
+                                                                  const EvaluatorPairMie::param_type *d_params);
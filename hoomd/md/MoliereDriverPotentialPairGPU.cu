@@ -15,3 +15,5 @@ hipError_t gpu_compute_moliere_forces(const pair_args_t& pair_args,
                                                          d_params);
     }
 
+template hipError_t gpu_compute_pair_set_energy<EvaluatorPairMoliere>(const pair_set_energy_args_t& args,
+                                                                      const EvaluatorPairMoliere::param_type *d_params);
@@ -26,7 +26,7 @@ MuellerPlatheFlow::MuellerPlatheFlow(std::shared_ptr<SystemDefinition> sysdef,
     ,m_flow_target(flow_target),m_flow_epsilon(1e-2)
     ,m_N_slabs(N_slabs),m_min_slab(min_slab),m_max_slab(max_slab)
     ,m_exchanged_momentum(0),m_has_min_slab(true),m_has_max_slab(true)
-    ,m_needs_orthorhombic_check(true)
+    ,m_needs_orthorhombic_check(true),m_local_exchange(false)
     {
     assert(m_flow_target);
 
@@ -91,9 +91,17 @@ void MuellerPlatheFlow::update(unsigned int timestep)
     //Sign for summed exchanged momentum depends on hierarchy of min and max slab.
     const int sign = this->get_max_slab() > this->get_min_slab() ? 1 : -1;
 
+    //Ranks without a slab do not take part in the swaps of the local exchange.
+    bool swap_on_rank = true;
+#ifdef ENABLE_MPI
+    const bool local_exchange = m_local_exchange && m_pdata->getDomainDecomposition();
+    if( local_exchange )
+        swap_on_rank = (m_slab_swap.rank != MPI_UNDEFINED);
+#endif//ENABLE_MPI
+
     unsigned int counter = 0;
     const unsigned int max_iteration = 100;
-    while( fabs( (*m_flow_target)(timestep) -
+    while( swap_on_rank && fabs( (*m_flow_target)(timestep) -
                  this->summed_exchanged_momentum()/area ) > this->get_flow_epsilon()
            && counter < max_iteration)
         {
@@ -106,7 +114,10 @@ void MuellerPlatheFlow::update(unsigned int timestep)
         search_min_max_velocity();
 
 #ifdef ENABLE_MPI
-        mpi_exchange_velocity();
+        if( local_exchange )
+            mpi_exchange_velocity_local();
+        else
+            mpi_exchange_velocity();
 #endif//ENABLE_MPI
 
         if( m_last_max_vel.x == -INVALID_VEL
@@ -135,6 +146,11 @@ void MuellerPlatheFlow::update(unsigned int timestep)
          <<this->summed_exchanged_momentum()/area<<" could be achieved."<<endl;
         m_exec_conf->msg->warning()<<s.str();
       }
+#ifdef ENABLE_MPI
+    //All ranks of the slabs know the exchanged momentum, share it with the other ranks once per step.
+    if( local_exchange )
+        bcast( m_exchanged_momentum, m_slab_swap.gbl_rank, m_exec_conf->getMPICommunicator() );
+#endif//ENABLE_MPI
     // stringstream s;
     // s<<this->summed_exchanged_momentum()/area<<"\t"<<m_flow_target->getValue(timestep)<<endl;
     // m_exec_conf->msg->collectiveNoticeStr(0,s.str());
@@ -237,6 +253,9 @@ void MuellerPlatheFlow::update_domain_decomposition(void)
 
         const int max_color =  this->has_max_slab() ? 0 : MPI_UNDEFINED;
         init_mpi_swap(&m_max_swap,max_color);
+
+        const int slab_color = (this->has_min_slab() || this->has_max_slab()) ? 0 : MPI_UNDEFINED;
+        init_mpi_swap(&m_slab_swap,slab_color);
         }
 #endif//ENABLE_MPI
     }
@@ -292,7 +311,7 @@ void MuellerPlatheFlow::search_min_max_velocity(void)
                 if( index == this->get_min_slab() && m_last_min_vel.x > vel && this->has_min_slab())
                     {
                     m_last_min_vel.x = vel;
-                    m_last_max_vel.y = mass;
+                    m_last_min_vel.y = mass;
                     m_last_min_vel.z = __int_as_scalar(h_tag.data[j]);
                     }
                 }
@@ -445,6 +464,21 @@ void MuellerPlatheFlow::mpi_exchange_velocity(void)
 #endif//ENABLE_MPI
     }
 
+void MuellerPlatheFlow::mpi_exchange_velocity_local(void)
+    {
+    //Negate the min velocity, so that both slabs are reduced in one call.
+    Scalar_Int tmp[2];
+    tmp[0].s = -m_last_min_vel.x;
+    tmp[0].i = m_slab_swap.rank;
+    tmp[1].s = m_last_max_vel.x;
+    tmp[1].i = m_slab_swap.rank;
+    MPI_Allreduce(MPI_IN_PLACE,tmp,2,MPI_HOOMD_SCALAR_INT,MPI_MAXLOC,m_slab_swap.comm);
+
+    //The owners send the velocity, mass, and tag of their particle to the other ranks of the slabs.
+    MPI_Bcast(&m_last_min_vel,sizeof(Scalar3),MPI_BYTE,tmp[0].i,m_slab_swap.comm);
+    MPI_Bcast(&m_last_max_vel,sizeof(Scalar3),MPI_BYTE,tmp[1].i,m_slab_swap.comm);
+    }
+
 #endif//ENABLE_MPI
 
 void export_MuellerPlatheFlow(py::module& m)
@@ -462,6 +496,8 @@ void export_MuellerPlatheFlow(py::module& m)
         .def("getFlowEpsilon",&MuellerPlatheFlow::get_flow_epsilon)
         .def("setFlowEpsilon",&MuellerPlatheFlow::set_flow_epsilon)
         .def("getSummedExchangedMomentum",&MuellerPlatheFlow::summed_exchanged_momentum)
+        .def("getLocalExchange",&MuellerPlatheFlow::get_local_exchange)
+        .def("setLocalExchange",&MuellerPlatheFlow::set_local_exchange)
         // Functions not needed for python interface users.
         // .def("setMinSlab",&MuellerPlatheFlow::set_min_slab)
         // .def("setMaxSlab",&MuellerPlatheFlow::set_max_slab)
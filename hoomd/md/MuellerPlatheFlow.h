@@ -99,6 +99,13 @@ class PYBIND11_EXPORT MuellerPlatheFlow : public Updater
         void set_flow_epsilon(const Scalar flow_epsilon){m_flow_epsilon=flow_epsilon;}
         //! Trigger checks for orthorhombic checks.
         void force_orthorhombic_box_check(void){m_needs_orthorhombic_check=true;}
+        //! Get whether the swaps are only communicated between the ranks of the min and max slab.
+        bool get_local_exchange(void)const{return m_local_exchange;}
+        //! Set whether the swaps are only communicated between the ranks of the min and max slab.
+        //!
+        //! The ranks of the slabs then carry out all swaps of a step among themselves, and the exchanged
+        //! momentum is broadcast to all ranks once per step instead of after every swap.
+        void set_local_exchange(const bool local_exchange){m_local_exchange=local_exchange;}
     protected:
         //! Swap min and max slab for a reverse flow.
         //! More efficient than separate calls of set_min_slab() and set_max_slab(),
@@ -145,6 +152,7 @@ class PYBIND11_EXPORT MuellerPlatheFlow : public Updater
         bool m_has_min_slab;
         bool m_has_max_slab;
         bool m_needs_orthorhombic_check;
+        bool m_local_exchange; //!< True if the swaps are only communicated between the ranks of the slabs
         //! Verify that the box is orthorhombic.
         //!
         //! Returns if box is orthorhombic, but throws a runtime_error, if the box is not orthorhombic.
@@ -167,9 +175,12 @@ class PYBIND11_EXPORT MuellerPlatheFlow : public Updater
             };
         struct MPI_SWAP m_min_swap;
         struct MPI_SWAP m_max_swap;
+        struct MPI_SWAP m_slab_swap; //!< Ranks that have the min or the max slab
         void init_mpi_swap(struct MPI_SWAP* ms,const int color);
         void bcast_vel_to_all(struct MPI_SWAP*ms,Scalar3*vel,const MPI_Op op);
         void mpi_exchange_velocity(void);
+        //! Exchange the min and max velocity only between the ranks of the slabs
+        void mpi_exchange_velocity_local(void);
 #endif//ENABLE_MPI
     };
 
@@ -9,10 +9,12 @@
 #endif
 
 #include "NeighborList.h"
+#include "NeighborListDelta.h"
 #include "hoomd/BondedGroupData.h"
 
 namespace py = pybind11;
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 
@@ -33,7 +35,8 @@ using namespace std;
 NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_cut, Scalar r_buff)
     : Compute(sysdef), m_typpair_idx(m_pdata->getNTypes()), m_rcut_max_max(_r_cut), m_rcut_min(_r_cut),
       m_r_buff(r_buff), m_d_max(1.0), m_filter_body(false), m_diameter_shift(false), m_storage_mode(half),
-      m_rcut_changed(true), m_updates(0), m_forced_updates(0), m_dangerous_updates(0), m_force_update(true),
+      m_rcut_changed(true), m_updates(0), m_forced_updates(0), m_dangerous_updates(0), m_partial_updates(0),
+      m_force_update(true),
       m_dist_check(true), m_has_been_updated_once(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing Neighborlist" << endl;
@@ -51,9 +54,31 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_c
     m_last_check_result = false;
     m_rebuild_check_delay = 0;
     m_exclusions_set = false;
+    m_exclusions_stale = false;
+    m_max_n_ex = 0;
+    m_build_applies_exclusions = false;
 
     m_need_reallocate_exlist = false;
 
+    // the type segments are only built on request
+    m_type_segments = false;
+    GlobalVector<unsigned int> type_head(m_exec_conf);
+    m_type_head.swap(type_head);
+    TAG_ALLOCATION(m_type_head);
+
+    // the neighbors are only sorted on request
+    m_sort_neighbors = false;
+
+    // the 16-bit deltas are only stored on request
+    m_compressed_indices = false;
+    GlobalVector<short> nlist_delta(m_exec_conf);
+    m_nlist_delta.swap(nlist_delta);
+    TAG_ALLOCATION(m_nlist_delta);
+
+    // partial rebuilds are only performed on request
+    m_partial_rebuild = false;
+    m_partial_candidate = false;
+
     // initialize box length at last update
     m_last_L = m_pdata->getGlobalBox().getNearestPlaneDistance();
     m_last_L_local = m_pdata->getBox().getNearestPlaneDistance();
@@ -160,14 +185,18 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_c
     m_last_pos.swap(last_pos);
     TAG_ALLOCATION(m_last_pos);
 
-    // allocate initial memory allowing 4 exclusions per particle (will grow to match specified exclusions)
+    // allocate the per tag and per index rows of the exclusion lists, the lists grow with the exclusions
 
     // note: this breaks O(N/P) memory scaling
     GlobalVector<unsigned int> n_ex_tag(m_pdata->getRTags().size(), m_exec_conf);
     m_n_ex_tag.swap(n_ex_tag);
     TAG_ALLOCATION(m_n_ex_tag);
 
-    GlobalArray<unsigned int> ex_list_tag(m_pdata->getRTags().size(), 1, m_exec_conf);
+    GlobalVector<unsigned int> ex_head_tag(m_pdata->getRTags().size(), m_exec_conf);
+    m_ex_head_tag.swap(ex_head_tag);
+    TAG_ALLOCATION(m_ex_head_tag);
+
+    GlobalVector<unsigned int> ex_list_tag(m_exec_conf);
     m_ex_list_tag.swap(ex_list_tag);
     TAG_ALLOCATION(m_ex_list_tag);
 
@@ -175,15 +204,23 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_c
     m_n_ex_idx.swap(n_ex_idx);
     TAG_ALLOCATION(m_n_ex_idx);
 
-    GlobalArray<unsigned int> ex_list_idx(m_pdata->getMaxN(), 1, m_exec_conf);
+    GlobalArray<unsigned int> ex_head_idx(m_pdata->getMaxN(), m_exec_conf);
+    m_ex_head_idx.swap(ex_head_idx);
+    TAG_ALLOCATION(m_ex_head_idx);
+
+    GlobalVector<unsigned int> ex_list_idx(m_exec_conf);
     m_ex_list_idx.swap(ex_list_idx);
     TAG_ALLOCATION(m_ex_list_idx);
 
     // reset exclusions
     clearExclusions();
 
-    m_ex_list_indexer = Index2D((unsigned int)m_ex_list_idx.getPitch(), 1);
-    m_ex_list_indexer_tag = Index2D((unsigned int)m_ex_list_tag.getPitch(), 1);
+    // rebuild the exclusions derived from the topology when it changes
+    m_sysdef->getBondData()->getGroupNumChangeSignal().connect<NeighborList, &NeighborList::slotTopologyChange>(this);
+    m_sysdef->getAngleData()->getGroupNumChangeSignal().connect<NeighborList, &NeighborList::slotTopologyChange>(this);
+    m_sysdef->getDihedralData()->getGroupNumChangeSignal().connect<NeighborList, &NeighborList::slotTopologyChange>(this);
+    m_sysdef->getConstraintData()->getGroupNumChangeSignal().connect<NeighborList, &NeighborList::slotTopologyChange>(this);
+    m_sysdef->getPairData()->getGroupNumChangeSignal().connect<NeighborList, &NeighborList::slotTopologyChange>(this);
 
     // connect to particle sort to force rebuild
     m_pdata->getParticleSortSignal().connect<NeighborList, &NeighborList::forceUpdate>(this);
@@ -222,9 +259,7 @@ void NeighborList::reallocate()
         memset(h_n_ex_idx.data+old_n_ex, 0, sizeof(unsigned int)*(m_n_ex_idx.getNumElements()-old_n_ex));
         }
 
-    unsigned int ex_list_height = m_ex_list_indexer.getH();
-    m_ex_list_idx.resize(m_pdata->getMaxN(), ex_list_height );
-    m_ex_list_indexer = Index2D((unsigned int)m_ex_list_idx.getPitch(), ex_list_height);
+    m_ex_head_idx.resize(m_pdata->getMaxN());
 
     // resize the head list and number of neighbors per particle
     m_head_list.resize(m_pdata->getMaxN());
@@ -272,6 +307,7 @@ void NeighborList::reallocateTypes()
         }
 
     m_conditions.resize(m_pdata->getNTypes());
+    m_Nmax_next.clear();
 
     #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
     if (m_exec_conf->isCUDAEnabled() && m_exec_conf->allConcurrentManagedAccess())
@@ -300,12 +336,18 @@ NeighborList::~NeighborList()
         {
         m_comm->getMigrateSignal().disconnect<NeighborList, &NeighborList::peekUpdate>(this);
         m_comm->getCommFlagsRequestSignal().disconnect<NeighborList, &NeighborList::getRequestedCommFlags>(this);
-        m_comm->getGhostLayerWidthRequestSignal().disconnect<NeighborList, &NeighborList::getGhostLayerWidth>(this);
+        m_comm->getGhostLayerPairWidthRequestSignal().disconnect<NeighborList, &NeighborList::getGhostLayerPairWidth>(this);
         }
 #endif
 
     m_pdata->getNumTypesChangeSignal().disconnect<NeighborList, &NeighborList::reallocateTypes>(this);
 
+    m_sysdef->getBondData()->getGroupNumChangeSignal().disconnect<NeighborList, &NeighborList::slotTopologyChange>(this);
+    m_sysdef->getAngleData()->getGroupNumChangeSignal().disconnect<NeighborList, &NeighborList::slotTopologyChange>(this);
+    m_sysdef->getDihedralData()->getGroupNumChangeSignal().disconnect<NeighborList, &NeighborList::slotTopologyChange>(this);
+    m_sysdef->getConstraintData()->getGroupNumChangeSignal().disconnect<NeighborList, &NeighborList::slotTopologyChange>(this);
+    m_sysdef->getPairData()->getGroupNumChangeSignal().disconnect<NeighborList, &NeighborList::slotTopologyChange>(this);
+
     getRCutChangeSignal().disconnect<NeighborList, &NeighborList::slotRCutChange>(this);
     }
 
@@ -326,6 +368,10 @@ void NeighborList::compute(unsigned int timestep)
 
     if (m_prof) m_prof->push("Neighbor");
 
+    // bonded groups were added or removed since the exclusions were set
+    if (m_exclusions_stale)
+        updateExclusionsFromTopology();
+
     // take care of some updates if things have changed since construction
     if (m_force_update)
         {
@@ -342,28 +388,59 @@ void NeighborList::compute(unsigned int timestep)
         // check simulation box size is OK
         checkBoxSize();
 
-        // rebuild the list until there is no overflow
-        bool overflowed = false;
-        do
-            {
-            buildNlist(timestep);
+        // only rebuild the lists around the fast particles when possible
+        bool partial = m_partial_candidate && partialRebuild();
+        m_partial_candidate = false;
 
-            overflowed = checkConditions();
-            // if we overflowed, need to reallocate memory and reset the conditions
-            if (overflowed)
+        if (!partial)
+            {
+            // grow the capacity of the types that came close to overflowing in the last build
+            if (!m_Nmax_next.empty())
                 {
-                // always rebuild the head list after an overflow
+                    {
+                    ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::overwrite);
+                    std::copy(m_Nmax_next.begin(), m_Nmax_next.end(), h_Nmax.data);
+                    }
+                m_Nmax_next.clear();
                 buildHeadList();
+                }
+
+            // rebuild the list until there is no overflow
+            bool overflowed = false;
+            do
+                {
+                buildNlist(timestep);
+
+                overflowed = checkConditions();
+                // if we overflowed, need to reallocate memory unless the build can be completed in the grown list
+                if (overflowed)
+                    {
+                    if (completeOverflowedBuild())
+                        overflowed = false;
+                    else
+                        buildHeadList();
+                    }
 
                 // zero out the conditions for the next build
                 resetConditions();
-                }
-            } while (overflowed);
+                } while (overflowed);
 
-        if (m_exclusions_set)
-            filterNlist();
+            if (m_exclusions_set && !m_build_applies_exclusions)
+                filterNlist();
+            }
+
+        if (m_sort_neighbors)
+            sortNlist();
 
-        setLastUpdatedPos();
+        if (m_type_segments)
+            buildTypeSegments();
+
+        if (m_compressed_indices)
+            buildDeltaList();
+
+        // partialRebuild() only moves the reference positions of the fast particles
+        if (!partial)
+            setLastUpdatedPos();
         m_has_been_updated_once = true;
         }
     if (m_prof) m_prof->pop();
@@ -448,7 +525,7 @@ void NeighborList::updateRList()
             // take the maximum
             for (unsigned int i=0; i < m_pdata->getNTypes(); ++i)
                 {
-                for (unsigned int j=0; i < m_pdata->getNTypes(); ++i)
+                for (unsigned int j=0; j < m_pdata->getNTypes(); ++j)
                     {
                     h_r_cut.data[m_typpair_idx(i,j)] = std::max(
                         h_r_cut.data[m_typpair_idx(i,j)],
@@ -574,49 +651,113 @@ void NeighborList::addExclusion(unsigned int tag1, unsigned int tag2)
 
     m_exclusions_set = true;
 
-    // don't add an exclusion twice
-    if (isExcluded(tag1, tag2))
+    // the pair is merged into the rows of both particles by commitExclusions()
+    m_ex_pending.push_back(std::make_pair(tag1, tag2));
+
+    forceUpdate();
+    }
+
+/*! Adds the staged exclusions to the rows of both particles of each pair. All rows are rebuilt in one pass over the
+    list: the new rows are counted, filled, sorted, and stripped of duplicates, and the list is compacted.
+
+    \post m_ex_pending is empty
+*/
+void NeighborList::commitExclusions()
+    {
+    if (m_ex_pending.empty())
         return;
 
-    // this is clunky, but needed due to the fact that we cannot have an array handle in scope when
-    // calling grow exclusion list
-    bool grow = false;
+    assert(! m_need_reallocate_exlist);
+
+    const unsigned int ntags = (unsigned int)m_n_ex_tag.getNumElements();
+
+    // count the entries of each row
+    std::vector<unsigned int> row_size(ntags);
         {
-        // access arrays
-        ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::read);
+        std::copy(h_n_ex_tag.data, h_n_ex_tag.data + ntags, row_size.begin());
+        }
+    for (auto const& pair : m_ex_pending)
+        {
+        row_size[pair.first]++;
+        row_size[pair.second]++;
+        }
 
-        // grow the list if necessary
-        if (h_n_ex_tag.data[tag1] == m_ex_list_indexer.getH())
-            grow = true;
+    std::vector<unsigned int> row_head(ntags+1, 0);
+    for (unsigned int tag = 0; tag < ntags; ++tag)
+        row_head[tag+1] = row_head[tag] + row_size[tag];
 
-        if (h_n_ex_tag.data[tag2] == m_ex_list_indexer.getH())
-            grow = true;
+    // fill the rows with the current and the staged exclusions
+    std::vector<unsigned int> rows(row_head[ntags]);
+    std::vector<unsigned int> row_end(row_head.begin(), row_head.end()-1);
+        {
+        ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_ex_head_tag(m_ex_head_tag, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_ex_list_tag(m_ex_list_tag, access_location::host, access_mode::read);
+        for (unsigned int tag = 0; tag < ntags; ++tag)
+            {
+            const unsigned int *row = h_ex_list_tag.data + h_ex_head_tag.data[tag];
+            row_end[tag] = std::copy(row, row + h_n_ex_tag.data[tag], rows.begin() + row_head[tag]) - rows.begin();
+            }
         }
+    for (auto const& pair : m_ex_pending)
+        {
+        rows[row_end[pair.first]++] = pair.second;
+        rows[row_end[pair.second]++] = pair.first;
+        }
+    m_ex_pending.clear();
 
-    if (grow)
+    // sort the rows, remove duplicates, and compact the list
+    unsigned int n_total = 0;
+    m_max_n_ex = 0;
         {
-        growExclusionList();
+        ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_ex_head_tag(m_ex_head_tag, access_location::host, access_mode::overwrite);
+        for (unsigned int tag = 0; tag < ntags; ++tag)
+            {
+            auto first = rows.begin() + row_head[tag];
+            std::sort(first, rows.begin() + row_end[tag]);
+            auto last = std::unique(first, rows.begin() + row_end[tag]);
+            auto dest = rows.begin() + n_total;
+            if (dest != first)
+                last = std::copy(first, last, dest);
+            else
+                last = dest + (last - first);
+
+            h_ex_head_tag.data[tag] = n_total;
+            h_n_ex_tag.data[tag] = (unsigned int)(last - dest);
+            n_total += h_n_ex_tag.data[tag];
+            m_max_n_ex = std::max(m_max_n_ex, h_n_ex_tag.data[tag]);
+            }
         }
 
+    // the index list mirrors the rows of the tag list
+    m_ex_list_tag.resize(n_total);
+    m_ex_list_idx.resize(n_total);
         {
-        // access arrays
-        ArrayHandle<unsigned int> h_ex_list_tag(m_ex_list_tag, access_location::host, access_mode::readwrite);
-        ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_ex_list_tag(m_ex_list_tag, access_location::host, access_mode::overwrite);
+        std::copy(rows.begin(), rows.begin() + n_total, h_ex_list_tag.data);
+        }
+    }
 
-        // add tag2 to tag1's exclusion list
-        unsigned int pos1 = h_n_ex_tag.data[tag1];
-        assert(pos1 < m_ex_list_indexer.getH());
-        h_ex_list_tag.data[m_ex_list_indexer_tag(tag1,pos1)] = tag2;
-        h_n_ex_tag.data[tag1]++;
+/*! Clears all exclusions and adds those of the names in m_exclusions again, after bonded groups were added or
+    removed. Exclusions added directly with addExclusion() are only kept when no exclusions are derived from the
+    topology.
+*/
+void NeighborList::updateExclusionsFromTopology()
+    {
+    m_exclusions_stale = false;
 
-        // add tag1 to tag2's exclusion list
-        unsigned int pos2 = h_n_ex_tag.data[tag2];
-        assert(pos2 < m_ex_list_indexer.getH());
-        h_ex_list_tag.data[m_ex_list_indexer_tag(tag2,pos2)] = tag1;
-        h_n_ex_tag.data[tag2]++;
-        }
+    std::set<std::string> exclusions = m_exclusions;
+    exclusions.erase("body");
+    if (exclusions.empty())
+        return;
 
-    forceUpdate();
+    m_exec_conf->msg->notice(6) << "nlist: rebuilding the exclusions after a topology change" << endl;
+
+    clearExclusions();
+    for (auto const& exclusion : exclusions)
+        setSingleExclusion(exclusion);
     }
 
 /*! \post No particles are excluded from the neighbor list
@@ -627,24 +768,23 @@ void NeighborList::clearExclusions()
     if (m_need_reallocate_exlist)
         {
         m_n_ex_tag.resize(m_pdata->getRTags().size());
-
-        // slave the width of the exclusion list to the capacity of the number of exclusions array
-        // in order to amortize reallocation costs
-        if (m_ex_list_tag.getPitch() != m_n_ex_tag.getNumElements())
-            {
-            m_ex_list_tag.resize(m_n_ex_tag.getNumElements(), m_ex_list_tag.getHeight());
-            m_ex_list_indexer_tag = Index2D((unsigned int)m_ex_list_tag.getPitch(),
-                                            (unsigned int)m_ex_list_tag.getHeight());
-            }
+        m_ex_head_tag.resize(m_pdata->getRTags().size());
 
         m_need_reallocate_exlist = false;
         }
 
 
+    m_ex_pending.clear();
+    m_ex_list_tag.resize(0);
+    m_ex_list_idx.resize(0);
+    m_max_n_ex = 0;
+
     ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_ex_head_tag(m_ex_head_tag, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::overwrite);
 
     memset(h_n_ex_tag.data, 0, sizeof(unsigned int)*m_n_ex_tag.getNumElements());
+    memset(h_ex_head_tag.data, 0, sizeof(unsigned int)*m_ex_head_tag.getNumElements());
     memset(h_n_ex_idx.data, 0, sizeof(unsigned int)*m_n_ex_idx.getNumElements());
     m_exclusions_set = false;
 
@@ -654,6 +794,8 @@ void NeighborList::clearExclusions()
 //! Get number of exclusions involving n particles
 unsigned int NeighborList::getNumExclusions(unsigned int size)
     {
+    commitExclusions();
+
     ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::read);
     unsigned int count = 0;
     unsigned int ntags = (unsigned int)m_pdata->getRTags().size();
@@ -746,6 +888,8 @@ void NeighborList::countExclusions()
 
     assert(! m_need_reallocate_exlist);
 
+    commitExclusions();
+
     ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::read);
 
     max_num_excluded = 0;
@@ -976,17 +1120,15 @@ bool NeighborList::isExcluded(unsigned int tag1, unsigned int tag2)
     assert(tag1 <= m_pdata->getMaximumTag());
     assert(tag2 <= m_pdata->getMaximumTag());
 
+    commitExclusions();
+
     ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_head_tag(m_ex_head_tag, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_ex_list_tag(m_ex_list_tag, access_location::host, access_mode::read);
 
-    unsigned int n_ex = h_n_ex_tag.data[tag1];
-    for (unsigned int i = 0; i < n_ex; i++)
-        {
-        if (h_ex_list_tag.data[m_ex_list_indexer_tag(tag1,i)] == tag2)
-            return true;
-        }
-
-    return false;
+    // the rows are sorted
+    const unsigned int *row = h_ex_list_tag.data + h_ex_head_tag.data[tag1];
+    return std::binary_search(row, row + h_n_ex_tag.data[tag1], tag2);
     }
 
 /*! Add topologically derived exclusions for angles
@@ -1173,6 +1315,7 @@ bool NeighborList::distanceCheck(unsigned int timestep)
 
     // temporary storage for the result
     bool result = false;
+    m_fast_particles.clear();
 
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
@@ -1211,10 +1354,25 @@ bool NeighborList::distanceCheck(unsigned int timestep)
         if (dot(dx, dx) >= maxsq)
             {
             result = true;
-            break;
+
+            // partial rebuilds need all of the fast particles
+            if (!m_partial_rebuild)
+                break;
+            m_fast_particles.push_back(i);
             }
         }
 
+    // a partial rebuild is possible when few particles moved too far in an unchanged box
+    if (m_partial_rebuild && result)
+        {
+        m_partial_candidate = lambda.x == Scalar(1.0) && lambda.y == Scalar(1.0) && lambda.z == Scalar(1.0)
+                              && m_fast_particles.size() * partial_rebuild_ratio <= m_pdata->getN();
+        #ifdef ENABLE_MPI
+        if (m_pdata->getDomainDecomposition())
+            m_partial_candidate = false;
+        #endif
+        }
+
     #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
@@ -1285,12 +1443,14 @@ bool NeighborList::needsUpdating(unsigned int timestep)
             {
             // force update is counted only once per time step
             m_force_update = false;
+            m_partial_candidate = false;
             return true;
             }
         return m_last_check_result;
         }
 
     m_last_checked_tstep = timestep;
+    m_partial_candidate = false;
 
     if (!m_force_update && !shouldCheckDistance(timestep))
         {
@@ -1364,7 +1524,7 @@ bool NeighborList::needsUpdating(unsigned int timestep)
 
 void NeighborList::resetStats()
     {
-    m_updates = m_forced_updates = m_dangerous_updates = 0;
+    m_updates = m_forced_updates = m_dangerous_updates = m_partial_updates = 0;
 
     for (unsigned int i = 0; i < m_update_periods.size(); i++)
         m_update_periods[i] = 0;
@@ -1394,6 +1554,8 @@ void NeighborList::updateExListIdx()
     {
     assert(! m_need_reallocate_exlist);
 
+    commitExclusions();
+
     if (m_prof)
         m_prof->push("update-ex");
 
@@ -1402,9 +1564,11 @@ void NeighborList::updateExListIdx()
     ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
     ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_head_tag(m_ex_head_tag, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_ex_list_tag(m_ex_list_tag, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::overwrite);
-    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_ex_head_idx(m_ex_head_idx, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx, access_location::host, access_mode::readwrite);
 
     // translate the number and exclusions from one array to the other
     for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
@@ -1412,18 +1576,20 @@ void NeighborList::updateExListIdx()
         // get the tag for this index
         unsigned int tag = h_tag.data[idx];
 
-        // copy the number of exclusions over
+        // copy the number of exclusions and the row over
         unsigned int n = h_n_ex_tag.data[tag];
+        unsigned int head = h_ex_head_tag.data[tag];
         h_n_ex_idx.data[idx] = n;
+        h_ex_head_idx.data[idx] = head;
 
         // construct the exclusion list
-        for (unsigned int offset = 0; offset < n; offset++)
+        for (unsigned int offset = head; offset < head + n; offset++)
             {
-            unsigned int ex_tag = h_ex_list_tag.data[m_ex_list_indexer_tag(tag,offset)];
+            unsigned int ex_tag = h_ex_list_tag.data[offset];
             unsigned int ex_idx = h_rtag.data[ex_tag];
 
             // store excluded particle idx
-            h_ex_list_idx.data[m_ex_list_indexer(idx, offset)] = ex_idx;
+            h_ex_list_idx.data[offset] = ex_idx;
             }
         }
 
@@ -1441,6 +1607,7 @@ void NeighborList::filterNlist()
     // access data
     ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_head_idx(m_ex_head_idx, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::readwrite);
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
@@ -1451,6 +1618,7 @@ void NeighborList::filterNlist()
         unsigned int myHead = h_head_list.data[idx];
         unsigned int n_neigh = h_n_neigh.data[idx];
         unsigned int n_ex = h_n_ex_idx.data[idx];
+        const unsigned int *ex_list = h_ex_list_idx.data + h_ex_head_idx.data[idx];
         unsigned int new_n_neigh = 0;
 
         // loop over the list, regenerating it as we go
@@ -1462,7 +1630,7 @@ void NeighborList::filterNlist()
             bool excluded = false;
             for (unsigned int cur_ex_idx = 0; cur_ex_idx < n_ex; cur_ex_idx++)
                 {
-                unsigned int cur_ex = h_ex_list_idx.data[m_ex_list_indexer(idx, cur_ex_idx)];
+                unsigned int cur_ex = ex_list[cur_ex_idx];
                 if (cur_ex == cur_neigh)
                     {
                     excluded = true;
@@ -1517,6 +1685,310 @@ void NeighborList::buildHeadList()
     if (m_prof) m_prof->pop();
     }
 
+/*! Sorts the neighbors of each particle by index on the host. GPU neighbor lists override this with a kernel.
+*/
+void NeighborList::sortNlist()
+    {
+    if (m_prof) m_prof->push("sort");
+
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+
+    for (unsigned int i = 0; i < m_pdata->getN(); ++i)
+        {
+        unsigned int *first = h_nlist.data + h_head_list.data[i];
+        std::sort(first, first + h_n_neigh.data[i]);
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! Encodes the neighbors of each particle as 16-bit deltas on the host. GPU neighbor lists override this with a
+    kernel.
+*/
+void NeighborList::buildDeltaList()
+    {
+    if (m_prof) m_prof->push("delta");
+
+    m_nlist_delta.resize(m_nlist.getNumElements());
+
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+    ArrayHandle<short> h_nlist_delta(m_nlist_delta, access_location::host, access_mode::overwrite);
+
+    for (unsigned int i = 0; i < m_pdata->getN(); ++i)
+        {
+        const unsigned int head = h_head_list.data[i];
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; ++k)
+            h_nlist_delta.data[head + k] = encodeNeighborDelta(i, h_nlist.data[head + k]);
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! Reorders the neighbors of each particle by type with a counting sort, which keeps the build order within each
+    type, and records the start of every type segment. The per-particle list is read and written on the host.
+*/
+void NeighborList::buildTypeSegments()
+    {
+    if (m_prof) m_prof->push("type-segments");
+
+    const unsigned int N = m_pdata->getN();
+    const unsigned int ntypes = m_pdata->getNTypes();
+    m_type_head_indexer = Index2D(ntypes + 1, N);
+    m_type_head.resize(m_type_head_indexer.getNumElements());
+
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_type_head(m_type_head, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+
+    std::vector<unsigned int> sorted;
+    for (unsigned int i = 0; i < N; ++i)
+        {
+        const unsigned int head = h_head_list.data[i];
+        const unsigned int n_neigh = h_n_neigh.data[i];
+        unsigned int *type_head = h_type_head.data + m_type_head_indexer(0, i);
+
+        // count the neighbors of each type
+        std::fill(type_head, type_head + ntypes + 1, 0);
+        for (unsigned int k = 0; k < n_neigh; ++k)
+            {
+            const unsigned int j = h_nlist.data[head + k];
+            type_head[__scalar_as_int(h_pos.data[j].w) + 1]++;
+            }
+
+        // turn the counts into the start of each segment
+        for (unsigned int t = 0; t < ntypes; ++t)
+            type_head[t + 1] += type_head[t];
+
+        sorted.resize(n_neigh);
+        for (unsigned int k = 0; k < n_neigh; ++k)
+            {
+            const unsigned int j = h_nlist.data[head + k];
+            const unsigned int t = __scalar_as_int(h_pos.data[j].w);
+            // type_head[t] temporarily points to the next free slot of segment t
+            sorted[type_head[t]++] = j;
+            }
+        std::copy(sorted.begin(), sorted.end(), h_nlist.data + head);
+
+        // the scatter advanced every start to the start of the next segment, shift them back
+        for (unsigned int t = ntypes; t > 0; --t)
+            type_head[t] = type_head[t - 1];
+        type_head[0] = 0;
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! \returns true when the lists around the fast particles were rebuilt
+    \returns false when a list is full, and the caller must perform a full build
+
+    Bins the reference positions (current positions for the fast particles, the last build positions for all others)
+    into cells at least as wide as the largest r_list, shifted by the largest diameter in the system. The list of each
+    fast particle is rebuilt from the 27 neighboring cells, and the fast particle is added to the lists of its slow
+    neighbors that do not hold it yet. Exclusions, body filtering, and diameter shifting are applied to the new entries
+    as they are inserted.
+*/
+bool NeighborList::partialRebuild()
+    {
+    if (m_prof) m_prof->push("partial");
+
+    const unsigned int N = m_pdata->getN();
+    const BoxDim& box = m_pdata->getBox();
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_last_pos(m_last_pos, access_location::host, access_mode::readwrite);
+
+    ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_r_listsq(m_r_listsq, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_head_idx(m_ex_head_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx, access_location::host, access_mode::read);
+
+    ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::readwrite);
+
+    // the fast particles are referenced at their current positions
+    std::vector<unsigned char> fast(N, 0);
+    for (unsigned int p : m_fast_particles)
+        {
+        fast[p] = 1;
+        h_last_pos.data[p] = make_scalar4(h_pos.data[p].x, h_pos.data[p].y, h_pos.data[p].z, Scalar(0.0));
+        }
+
+    // size the cells to the largest distance accepted below, the box is periodic without domain decomposition
+    // the diameter shift uses the actual diameters, which may exceed the maximum diameter set by the user
+    Scalar width = getMaxRCut() + m_r_buff;
+    if (m_diameter_shift)
+        {
+        Scalar d_max = Scalar(0.0);
+        for (unsigned int i = 0; i < N; ++i)
+            d_max = std::max(d_max, h_diameter.data[i]);
+        width += std::max(d_max - Scalar(1.0), Scalar(0.0));
+        }
+    const Scalar3 L = box.getNearestPlaneDistance();
+    uint3 dim = make_uint3(1, 1, 1);
+    if (width > Scalar(0.0))
+        dim = make_uint3(std::max(1, (int)(L.x / width)),
+                         std::max(1, (int)(L.y / width)),
+                         std::max(1, (int)(L.z / width)));
+    if (m_sysdef->getNDimensions() == 2)
+        dim.z = 1;
+    Index3D ci(dim.x, dim.y, dim.z);
+
+    auto wrap = [](int b, unsigned int n)
+        {
+        const int r = b % (int)n;
+        return (unsigned int)(r < 0 ? r + (int)n : r);
+        };
+    auto cell_of = [&](const Scalar4& postype)
+        {
+        const Scalar3 f = box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+        return make_uint3(wrap((int)std::floor(f.x * dim.x), dim.x),
+                          wrap((int)std::floor(f.y * dim.y), dim.y),
+                          wrap((int)std::floor(f.z * dim.z), dim.z));
+        };
+
+    // counting sort of the particles by cell
+    m_partial_cell_head.assign(ci.getNumElements() + 1, 0);
+    m_partial_cell_members.resize(N);
+    std::vector<unsigned int> particle_cell(N);
+    for (unsigned int i = 0; i < N; ++i)
+        {
+        const uint3 c = cell_of(h_last_pos.data[i]);
+        particle_cell[i] = ci(c.x, c.y, c.z);
+        m_partial_cell_head[particle_cell[i] + 1]++;
+        }
+    for (unsigned int c = 0; c < ci.getNumElements(); ++c)
+        m_partial_cell_head[c + 1] += m_partial_cell_head[c];
+    std::vector<unsigned int> next(m_partial_cell_head.begin(), m_partial_cell_head.end() - 1);
+    for (unsigned int i = 0; i < N; ++i)
+        m_partial_cell_members[next[particle_cell[i]]++] = i;
+
+    // visit each cell once when an axis has fewer than 3 cells
+    auto axis_range = [](unsigned int n, int& begin, int& end)
+        {
+        if (n < 3)
+            {
+            begin = 0;
+            end = n - 1;
+            return false;
+            }
+        begin = -1;
+        end = 1;
+        return true;
+        };
+    int x_begin, x_end, y_begin, y_end, z_begin, z_end;
+    const bool x_rel = axis_range(dim.x, x_begin, x_end);
+    const bool y_rel = axis_range(dim.y, y_begin, y_end);
+    const bool z_rel = axis_range(dim.z, z_begin, z_end);
+
+    bool success = true;
+    for (unsigned int p : m_fast_particles)
+        {
+        const Scalar3 pos_p = make_scalar3(h_pos.data[p].x, h_pos.data[p].y, h_pos.data[p].z);
+        const unsigned int type_p = __scalar_as_int(h_pos.data[p].w);
+        const unsigned int body_p = h_body.data[p];
+        const unsigned int head_p = h_head_list.data[p];
+        const unsigned int n_ex = h_n_ex_idx.data[p];
+        const uint3 c_p = cell_of(h_pos.data[p]);
+        unsigned int n_neigh_p = 0;
+
+        for (int dz = z_begin; dz <= z_end && success; ++dz)
+            for (int dy = y_begin; dy <= y_end && success; ++dy)
+                for (int dx = x_begin; dx <= x_end && success; ++dx)
+                    {
+                    const unsigned int c = ci(x_rel ? wrap((int)c_p.x + dx, dim.x) : dx,
+                                              y_rel ? wrap((int)c_p.y + dy, dim.y) : dy,
+                                              z_rel ? wrap((int)c_p.z + dz, dim.z) : dz);
+
+                    for (unsigned int k = m_partial_cell_head[c]; k < m_partial_cell_head[c + 1]; ++k)
+                        {
+                        const unsigned int j = m_partial_cell_members[k];
+                        const unsigned int type_j = __scalar_as_int(h_pos.data[j].w);
+                        const unsigned int typpair = m_typpair_idx(type_p, type_j);
+                        const Scalar r_cut = h_r_cut.data[typpair];
+
+                        bool excluded = (j == p) || (r_cut <= Scalar(0.0));
+                        if (m_filter_body && body_p != NO_BODY)
+                            excluded = excluded || (body_p == h_body.data[j]);
+                        for (unsigned int e = 0; e < n_ex && !excluded; ++e)
+                            excluded = (h_ex_list_idx.data[h_ex_head_idx.data[p] + e] == j);
+                        if (excluded)
+                            continue;
+
+                        Scalar sqshift = Scalar(0.0);
+                        if (m_diameter_shift)
+                            {
+                            const Scalar r_list = r_cut + m_r_buff;
+                            const Scalar delta = (h_diameter.data[p] + h_diameter.data[j]) * Scalar(0.5)
+                                                 - Scalar(1.0);
+                            sqshift = (delta + Scalar(2.0) * r_list) * delta;
+                            }
+
+                        const Scalar4& ref_j = h_last_pos.data[j];
+                        Scalar3 dr = pos_p - make_scalar3(ref_j.x, ref_j.y, ref_j.z);
+                        dr = box.minImage(dr);
+                        if (dot(dr, dr) > h_r_listsq.data[typpair] + sqshift)
+                            continue;
+
+                        // the list of the fast particle is rebuilt from scratch
+                        if (m_storage_mode == full || p < j)
+                            {
+                            if (n_neigh_p >= h_Nmax.data[type_p])
+                                {
+                                success = false;
+                                break;
+                                }
+                            h_nlist.data[head_p + n_neigh_p++] = j;
+                            }
+
+                        // the lists of the other fast particles are rebuilt when their turn comes
+                        if (!fast[j] && (m_storage_mode == full || j < p))
+                            {
+                            const unsigned int head_j = h_head_list.data[j];
+                            const unsigned int n_neigh_j = h_n_neigh.data[j];
+                            const unsigned int *first = h_nlist.data + head_j;
+                            if (std::find(first, first + n_neigh_j, p) != first + n_neigh_j)
+                                continue;
+                            if (n_neigh_j >= h_Nmax.data[type_j])
+                                {
+                                success = false;
+                                break;
+                                }
+                            h_nlist.data[head_j + n_neigh_j] = p;
+                            h_n_neigh.data[j] = n_neigh_j + 1;
+                            }
+                        }
+                    }
+
+        if (!success)
+            break;
+        h_n_neigh.data[p] = n_neigh_p;
+        }
+
+    if (success)
+        {
+        m_partial_updates += 1;
+        }
+    else
+        {
+        // the full build that follows resets all of the reference positions
+        m_exec_conf->msg->notice(6) << "nlist: partial rebuild overflowed, performing a full build" << endl;
+        }
+
+    if (m_prof) m_prof->pop();
+    return success;
+    }
+
 /*!
  * \param size the requested number of elements in the neighbor list
  *
@@ -1547,24 +2019,42 @@ void NeighborList::resizeNlist(size_t size)
  * \returns true if an overflow is detected for any particle type
  * \returns false if all particle types have enough memory for their neighbors
  *
- * The maximum number of neighbors per particle (rounded up to the nearest 4, min of 4) is recomputed when
- * an overflow happens.
+ * The maximum number of neighbors per particle is recomputed with 1/8 headroom above the largest count (rounded up to
+ * the nearest 4) for every type whose count overflowed or came within 1/16 of the capacity. After an overflow, m_Nmax
+ * is updated for all of these types at once. Otherwise, the growth is staged in m_Nmax_next, because the current list
+ * is laid out for the current m_Nmax.
  */
 bool NeighborList::checkConditions()
     {
     bool result = false;
+    bool grow = false;
 
+    const unsigned int ntypes = m_pdata->getNTypes();
     ArrayHandle<unsigned int> h_conditions(m_conditions, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::readwrite);
-    for (unsigned int i=0; i < m_pdata->getNTypes(); ++i)
+    std::vector<unsigned int> Nmax(h_Nmax.data, h_Nmax.data + ntypes);
+    for (unsigned int i=0; i < ntypes; ++i)
         {
-        if (h_conditions.data[i] > h_Nmax.data[i])
+        const unsigned int n = h_conditions.data[i];
+        if (n > h_Nmax.data[i] - h_Nmax.data[i]/16)
             {
-            h_Nmax.data[i] = (h_conditions.data[i] > 4) ? (h_conditions.data[i] + 3) & ~3 : 4;
-            result = true;
+            Nmax[i] = (n + n/8 + 4) & ~3;
+            grow = true;
+            if (n > h_Nmax.data[i])
+                result = true;
             }
         }
 
+    if (result)
+        {
+        std::copy(Nmax.begin(), Nmax.end(), h_Nmax.data);
+        m_Nmax_next.clear();
+        }
+    else if (grow)
+        {
+        m_Nmax_next.swap(Nmax);
+        }
+
     return result;
     }
 
@@ -1574,21 +2064,6 @@ void NeighborList::resetConditions()
     memset(h_conditions.data, 0, sizeof(unsigned int)*m_pdata->getNTypes());
     }
 
-void NeighborList::growExclusionList()
-    {
-    unsigned int new_height = m_ex_list_indexer.getH() + 1;
-
-    m_ex_list_tag.resize(m_pdata->getRTags().size(), new_height);
-    m_ex_list_idx.resize(m_pdata->getMaxN(), new_height);
-
-    // update the indexers
-    m_ex_list_indexer = Index2D((unsigned int)m_ex_list_idx.getPitch(), new_height);
-    m_ex_list_indexer_tag = Index2D((unsigned int)m_ex_list_tag.getPitch(), new_height);
-
-    // we didn't copy data for the new idx list, force an update so it will be correct
-    forceUpdate();
-    }
-
 #ifdef ENABLE_MPI
 //! Set the communicator to use
 void NeighborList::setCommunicator(std::shared_ptr<Communicator> comm)
@@ -1599,7 +2074,7 @@ void NeighborList::setCommunicator(std::shared_ptr<Communicator> comm)
         assert(comm);
         comm->getMigrateSignal().connect<NeighborList, &NeighborList::peekUpdate>(this);
         comm->getCommFlagsRequestSignal().connect<NeighborList, &NeighborList::getRequestedCommFlags>(this);
-        comm->getGhostLayerWidthRequestSignal().connect<NeighborList, &NeighborList::getGhostLayerWidth>(this);
+        comm->getGhostLayerPairWidthRequestSignal().connect<NeighborList, &NeighborList::getGhostLayerPairWidth>(this);
         }
 
     Compute::setCommunicator(comm);
@@ -1692,6 +2167,14 @@ void export_NeighborList(py::module& m)
                       &NeighborList::getDistCheck,
                       &NeighborList::setDistCheck)
         .def("setStorageMode", &NeighborList::setStorageMode)
+        .def_property("sort_neighbors", &NeighborList::getSortNeighbors,
+                      &NeighborList::setSortNeighbors)
+        .def_property("compressed_indices", &NeighborList::getCompressedIndices,
+                      &NeighborList::setCompressedIndices)
+        .def_property("partial_rebuild", &NeighborList::getPartialRebuild,
+                      &NeighborList::setPartialRebuild)
+        .def_property("type_segments", &NeighborList::getTypeSegments,
+                      &NeighborList::setTypeSegments)
         .def_property("exclusions", &NeighborList::getExclusions,
                       &NeighborList::setExclusions)
         .def_property("diameter_shift", &NeighborList::getDiameterShift,
@@ -1706,6 +2189,8 @@ void export_NeighborList(py::module& m)
         .def("estimateNNeigh", &NeighborList::estimateNNeigh)
         .def("getSmallestRebuild", &NeighborList::getSmallestRebuild)
         .def("getNumUpdates", &NeighborList::getNumUpdates)
+        .def("getNumDangerousUpdates", &NeighborList::getNumDangerousUpdates)
+        .def("getNumPartialUpdates", &NeighborList::getNumPartialUpdates)
         .def("getNumExclusions", &NeighborList::getNumExclusions)
         .def("wantExclusions", &NeighborList::wantExclusions)
 #ifdef ENABLE_MPI
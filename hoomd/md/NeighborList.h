@@ -94,22 +94,68 @@
 
     \b Exclusions:
 
-    Exclusions are stored in \a ex_list, a data structure similar in structure to \a nlist, except this time exclusions
-    are stored. User-specified exclusions are stored by tag and translated to indices whenever a particle sort occurs
-    (updateExListIdx()). If any exclusions are set, filterNlist() is called after buildNlist(). filterNlist() loops
-    through the neighbor list and removes any particles that are excluded. This allows an arbitrary number of exclusions
-    to be processed without slowing the performance of the buildNlist() step itself.
+    Exclusions are stored in compressed sparse rows: \a ex_list holds the excluded particles of all particles in one
+    flat array, each particle owns a segment of it that starts at \a ex_head and has \a n_ex entries. Memory grows with
+    the total number of exclusions, not with the number of particles times the largest number of exclusions of any
+    particle. User-specified exclusions are stored by tag and translated to indices whenever a particle sort occurs
+    (updateExListIdx()). The index list mirrors the segments of the tag list, so it can be translated one particle per
+    thread. addExclusion() only stages the pair, the staged pairs are merged into the rows (and duplicates removed) in
+    one pass by commitExclusions(). When bonds, angles, dihedrals, constraints, or special pairs are added or removed,
+    the exclusions derived from them are rebuilt at the next compute(). The binned, stencil, and tree builds test the
+    exclusions of each pair that passes the distance check, so that excluded pairs are never written to the list, and
+    set m_build_applies_exclusions. For other implementations of buildNlist(), filterNlist() is called after the build.
+    It loops through the neighbor list and removes any particles that are excluded.
 
     <b>Overflow handling:</b>
     For easy support of derived GPU classes to implement overflow detection the overflow condition is stored in the
     GlobalArray \a d_conditions.
 
-     - 0: Maximum nlist size (implementations are free to write to this element only in overflow conditions if they
-          choose.)
-     - Further indices may be added to handle other conditions at a later time.
+     - i: Maximum number of neighbors of the particles of type i (implementations are free to write to this element
+          only when the count comes within 1/16 of m_Nmax or overflows it.)
 
     Condition flags are to be set during the buildNlist() call and will be checked by compute() which will then
-    take the appropriate action.
+    take the appropriate action. The capacity of a type is grown to 1/8 above the largest count, so that a slowly
+    compressing system does not overflow on every build. When the largest count comes within 1/16 of the capacity,
+    the growth is staged in m_Nmax_next and applied before the next build, without another build. On an overflow,
+    completeOverflowedBuild() may finish the list in the grown capacity when the build kept the neighbors that did not
+    fit. Otherwise the list is reallocated and built again.
+
+    <b>Type segments:</b>
+    When setTypeSegments() is enabled, compute() sorts the neighbors of every particle by type after each build, and
+    records where the neighbors of each type start:
+
+     - neighbors of particle \a i with type \a t are <code>nlist[head_list[i] + k]</code> for \a k from
+       <code>type_head[type_head_indexer(t, i)]</code> to <code>type_head[type_head_indexer(t+1, i)] - 1</code>
+
+    The list is shared by all consumers and includes every type pair within the largest r_cut + r_buff of any
+    consumer. A consumer that does not interact with some type pairs (r_cut = 0) skips those segments entirely
+    instead of testing and rejecting each of their neighbors. This helps mixtures where potentials cover different
+    subsets of the types, for example large colloids and a small solvent.
+
+    <b>Sorted neighbors:</b>
+    When setSortNeighbors() is enabled, compute() sorts the neighbors of every particle by index after each build.
+    After a spatial sort of the particles, consecutive neighbors are then close in memory, so the pair forces read the
+    neighbor positions with fewer cache lines (CPU) or more coalesced loads (GPU). Type segments sort stably, so the
+    neighbors within each type segment remain sorted by index.
+
+    <b>Compressed indices:</b>
+    When setCompressedIndices() is enabled, compute() also stores every neighbor as a 16-bit delta from the index of
+    its particle after each build (see NeighborListDelta.h). The deltas share the head list of the 32-bit list, so
+    neighbor k of particle i is in slot <code>head_list[i] + k</code> of both. After SFCPackTuner sorts, almost all
+    neighbors are within 32767 indices of their particle. The others (and most ghost particles) are marked with
+    nlist_delta_escape and read from the 32-bit list. Pair potentials that read the deltas load half of the bytes of
+    the list. The 32-bit list is kept for the consumers that read it directly.
+
+    <b>Partial rebuilds:</b>
+    When setPartialRebuild() is enabled, distanceCheck() records every particle that moved more than half of the
+    buffer instead of stopping at the first one. When only a few particles moved that far (at most one in
+    partial_rebuild_ratio) and the box has not changed since the last build, compute() calls partialRebuild() in place
+    of buildNlist(). It rebuilds the lists of the fast particles only, and adds the fast particles to the lists of
+    their slow neighbors. Slow particles keep their reference positions, so the neighbors of a fast particle are found
+    by the distance r_list(i,j) to the reference positions of the slow particles, which guarantees that all pairs
+    within r_cut(i,j) remain in the list until the next build. Entries of pairs that moved apart stay in the list,
+    the pair forces reject them by distance. partialRebuild() falls back to a full build when a list is full. Partial
+    rebuilds are only implemented on the CPU and without domain decomposition.
 
     \ingroup computes
 */
@@ -213,6 +259,66 @@ class PYBIND11_EXPORT NeighborList : public Compute
             forceUpdate();
             }
 
+        //! Enable or disable the type segments
+        /*! \param type_segments Set to true to sort the neighbors of each particle by type
+        */
+        void setTypeSegments(bool type_segments)
+            {
+            m_type_segments = type_segments;
+            forceUpdate();
+            }
+
+        //! Test if the neighbors are sorted into type segments
+        bool getTypeSegments()
+            {
+            return m_type_segments;
+            }
+
+        //! Enable or disable sorting the neighbors by index
+        /*! \param sort_neighbors Set to true to sort the neighbors of each particle by index
+        */
+        void setSortNeighbors(bool sort_neighbors)
+            {
+            m_sort_neighbors = sort_neighbors;
+            forceUpdate();
+            }
+
+        //! Test if the neighbors are sorted by index
+        bool getSortNeighbors()
+            {
+            return m_sort_neighbors;
+            }
+
+        //! Enable or disable the 16-bit relative neighbor indices
+        /*! \param compressed_indices Set to true to also store the list as 16-bit deltas
+        */
+        void setCompressedIndices(bool compressed_indices)
+            {
+            m_compressed_indices = compressed_indices;
+            forceUpdate();
+            }
+
+        //! Test if the list is also stored as 16-bit deltas
+        bool getCompressedIndices()
+            {
+            return m_compressed_indices;
+            }
+
+        //! Enable or disable partial rebuilds
+        /*! \param partial_rebuild Set to true to rebuild only the lists around particles that moved too far
+        */
+        void setPartialRebuild(bool partial_rebuild)
+            {
+            m_partial_rebuild = partial_rebuild;
+            forceUpdate();
+            }
+
+        //! Test if partial rebuilds are enabled
+        bool getPartialRebuild()
+            {
+            return m_partial_rebuild;
+            }
+
         // @}
         //! \name Get properties
         // @{
@@ -293,6 +399,24 @@ class PYBIND11_EXPORT NeighborList : public Compute
             return m_head_list;
             }
 
+        //! Get the start of the type segments of each particle, relative to its head
+        const GlobalVector<unsigned int>& getTypeHeadList()
+            {
+            return m_type_head;
+            }
+
+        //! Get the neighbors as 16-bit deltas, in the same slots as getNListArray()
+        const GlobalVector<short>& getNListDeltaArray()
+            {
+            return m_nlist_delta;
+            }
+
+        //! Get the indexer of the type head list (ntypes+1 elements per particle)
+        const Index2D& getTypeHeadIndexer()
+            {
+            return m_type_head_indexer;
+            }
+
         //! Get the number of exclusions array
         const GlobalArray<unsigned int>& getNExArray()
             {
@@ -300,18 +424,15 @@ class PYBIND11_EXPORT NeighborList : public Compute
             }
 
          //! Get the exclusion list
-         const GlobalArray<unsigned int>& getExListArray()
+         const GlobalVector<unsigned int>& getExListArray()
             {
             return m_ex_list_idx;
             }
 
-        //! Get the neighbor list indexer
-        /*! \note Do not save indexers across calls. Get a new indexer after every call to compute() - they will
-            change.
-        */
-        const Index2D& getExListIndexer()
+        //! Get the start of the exclusions of each particle in the exclusion list
+        const GlobalArray<unsigned int>& getExHeadArray()
             {
-            return m_ex_list_indexer;
+            return m_ex_head_idx;
             }
 
         void setExclusions(pybind11::list exclusions);
@@ -460,6 +581,35 @@ class PYBIND11_EXPORT NeighborList : public Compute
                 }
             }
 
+        //! Return the ghost layer width needed for ghosts of type_i to interact with particles of type_j
+        /*! Communicator takes the maximum over the types present in the neighboring domains, so that the ghost layer
+            of a type sized for a large cutoff with a type that is absent from the neighborhood stays narrow.
+        */
+        virtual Scalar getGhostLayerPairWidth(unsigned int type_i, unsigned int type_j)
+            {
+            if (m_rcut_changed)
+                {
+                updateRList();
+                }
+
+            ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
+            const Scalar rcut_ij = h_r_cut.data[m_typpair_idx(type_i, type_j)];
+
+            if (rcut_ij > Scalar(0.0)) // ensure communication is required
+                {
+                Scalar rmax = rcut_ij + m_r_buff;
+
+                // diameter shifting requires to communicate a larger rlist
+                if (m_diameter_shift)
+                    rmax += m_d_max - Scalar(1.0);
+                return rmax;
+                }
+            else
+                {
+                return Scalar(0.0);
+                }
+            }
+
         // @}
 
         //! Computes the NeighborList if it needs updating
@@ -480,6 +630,18 @@ class PYBIND11_EXPORT NeighborList : public Compute
             return m_updates + m_forced_updates;
             }
 
+        //! Get the number of dangerous builds since the last call to resetStats
+        uint64_t getNumDangerousUpdates()
+            {
+            return m_dangerous_updates;
+            }
+
+        //! Get the number of updates that were partial rebuilds since the last call to resetStats
+        uint64_t getNumPartialUpdates()
+            {
+            return m_partial_updates;
+            }
+
 
 #ifdef ENABLE_MPI
         //! Set the communicator to use
@@ -540,16 +702,37 @@ class PYBIND11_EXPORT NeighborList : public Compute
         GlobalArray<unsigned int> m_head_list;     //!< Indexes for particles to read from the neighbor list
         GlobalArray<unsigned int> m_Nmax;          //!< Holds the maximum number of neighbors for each particle type
         GlobalArray<unsigned int> m_conditions;    //!< Holds the max number of computed particles by type for resizing
+        std::vector<unsigned int> m_Nmax_next;     //!< Grown m_Nmax to apply before the next build, empty if none
 
-        GlobalArray<unsigned int> m_ex_list_tag;  //!< List of excluded particles referenced by tag
-        GlobalArray<unsigned int> m_ex_list_idx;  //!< List of excluded particles referenced by index
+        GlobalVector<unsigned int> m_ex_list_tag; //!< Excluded particles referenced by tag, one sorted row per tag
+        GlobalVector<unsigned int> m_ex_head_tag; //!< Start of the row of each tag in m_ex_list_tag
         GlobalVector<unsigned int> m_n_ex_tag;    //!< Number of exclusions for a given particle tag
+        GlobalVector<unsigned int> m_ex_list_idx; //!< Excluded particles referenced by index, in the rows of the tags
+        GlobalArray<unsigned int> m_ex_head_idx;  //!< Start of the row of each particle index in m_ex_list_idx
         GlobalArray<unsigned int> m_n_ex_idx;     //!< Number of exclusions for a given particle index
-        Index2D m_ex_list_indexer;             //!< Indexer for accessing the exclusion list
-        Index2D m_ex_list_indexer_tag;         //!< Indexer for accessing the by-tag exclusion list
+        unsigned int m_max_n_ex;                  //!< Largest number of exclusions of any particle
+        std::vector< std::pair<unsigned int, unsigned int> > m_ex_pending; //!< Staged exclusions by tag
         bool m_exclusions_set;                 //!< True if any exclusions have been set
+        bool m_exclusions_stale;               //!< True if the exclusions need to be rebuilt from the topology
+        bool m_build_applies_exclusions;       //!< True if buildNlist() leaves out the excluded pairs itself
         bool m_need_reallocate_exlist;         //!< True if global exclusion list needs to be reallocated
 
+        bool m_type_segments;                   //!< True if the neighbors are sorted into type segments
+        GlobalVector<unsigned int> m_type_head; //!< Start of each type segment relative to the head of the particle
+        Index2D m_type_head_indexer;            //!< Indexer for accessing the type head list
+
+        bool m_sort_neighbors;                  //!< True if the neighbors are sorted by index
+
+        bool m_compressed_indices;              //!< True if the list is also stored as 16-bit deltas
+        GlobalVector<short> m_nlist_delta;      //!< Neighbors as deltas from the particle index, in the m_nlist slots
+
+        bool m_partial_rebuild;                     //!< True if partial rebuilds are enabled
+        bool m_partial_candidate;                   //!< True if the last distance check allows a partial rebuild
+        std::vector<unsigned int> m_fast_particles; //!< Particles that moved more than the threshold
+        std::vector<unsigned int> m_partial_cell_head;  //!< Start of each cell in m_partial_cell_members
+        std::vector<unsigned int> m_partial_cell_members; //!< Particle indices sorted by reference position cell
+        static const unsigned int partial_rebuild_ratio = 8; //!< Largest ratio of particles to fast particles
+
         //! Return true if we are supposed to do a distance check in this time step
         bool shouldCheckDistance(unsigned int timestep);
 
@@ -577,6 +760,29 @@ class PYBIND11_EXPORT NeighborList : public Compute
         //! Build the head list to allocated memory
         virtual void buildHeadList();
 
+        //! Complete an overflowed build in the grown capacity
+        /*! \returns true if the list is complete, false if it needs to be built again
+
+            Called after checkConditions() grew m_Nmax and before the head list is rebuilt. The default implementation
+            does not keep the neighbors that did not fit and returns false.
+        */
+        virtual bool completeOverflowedBuild()
+            {
+            return false;
+            }
+
+        //! Sort the neighbors of each particle by type and record the type segments
+        void buildTypeSegments();
+
+        //! Sort the neighbors of each particle by index
+        virtual void sortNlist();
+
+        //! Store the neighbors as 16-bit deltas
+        virtual void buildDeltaList();
+
+        //! Rebuild the lists around the fast particles found by the last distance check
+        bool partialRebuild();
+
         //! Amortized resizing of the neighborlist
         void resizeNlist(size_t size);
 
@@ -615,6 +821,7 @@ class PYBIND11_EXPORT NeighborList : public Compute
         uint64_t m_updates;              //!< Number of times the neighbor list has been updated
         uint64_t m_forced_updates;       //!< Number of times the neighbor list has been forcibly updated
         uint64_t m_dangerous_updates;    //!< Number of dangerous builds counted
+        uint64_t m_partial_updates;      //!< Number of builds that were partial rebuilds
         bool m_force_update;            //!< Flag to handle the forcing of neighborlist updates
         bool m_dist_check;              //!< Set to false to disable distance checks (nlist always built m_rebuild_check_delay steps)
         bool m_has_been_updated_once;   //!< True if the neighbor list has been updated at least once
@@ -641,8 +848,17 @@ class PYBIND11_EXPORT NeighborList : public Compute
         //! Resets the condition status to all zeroes
         virtual void resetConditions();
 
-        //! Grow the exclusions list memory capacity by one row
-        void growExclusionList();
+        //! Merge the staged exclusions into the rows of the by-tag exclusion list
+        void commitExclusions();
+
+        //! Rebuild the exclusions derived from the topology
+        void updateExclusionsFromTopology();
+
+        //! Method to be called when bonded groups are added or removed
+        void slotTopologyChange()
+            {
+            m_exclusions_stale = true;
+            }
 
         //! Method to be called when the global particle number changes
         void slotGlobalParticleNumberChange()
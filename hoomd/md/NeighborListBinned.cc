@@ -14,6 +14,11 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 
 using namespace std;
 namespace py = pybind11;
@@ -37,6 +42,9 @@ NeighborListBinned::NeighborListBinned(std::shared_ptr<SystemDefinition> sysdef,
 
     // cell sizes need update by default
     m_update_cell_size = true;
+
+    // excluded pairs are left out by buildNlist()
+    m_build_applies_exclusions = true;
     }
 
 NeighborListBinned::~NeighborListBinned()
@@ -70,6 +78,11 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
     ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
 
+    // access the exclusions by index
+    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_head_idx(m_ex_head_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx, access_location::host, access_mode::read);
+
     const BoxDim& box = m_pdata->getBox();
 
     // access the rlist data
@@ -99,14 +112,21 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
     // for each local particle
     unsigned int nparticles = m_pdata->getN();
 
-    for (int i = 0; i < (int)nparticles; i++)
+    const bool three_d = m_sysdef->getNDimensions() == 3;
+
+    // every particle only writes its own section of the neighbor list
+    // the box shape resolves the tilt and z terms of the minimum image at compile time
+    auto build_particle = [&](int i, auto shape)
         {
+        typedef decltype(shape) Shape;
         unsigned int cur_n_neigh = 0;
 
         const Scalar3 my_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
         const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
         const unsigned int body_i = h_body.data[i];
         const Scalar diam_i = h_diameter.data[i];
+        const unsigned int n_ex_i = m_exclusions_set ? h_n_ex_idx.data[i] : 0;
+        const unsigned int ex_head_i = h_ex_head_idx.data[i];
 
         const unsigned int Nmax_i = h_Nmax.data[type_i];
         const unsigned int head_idx_i = h_head_list.data[i];
@@ -156,7 +176,7 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
 
                 Scalar3 neigh_pos = make_scalar3(cur_xyzf.x, cur_xyzf.y, cur_xyzf.z);
                 Scalar3 dx = my_pos - neigh_pos;
-                dx = box.minImage(dx);
+                dx = box.minImage<Shape::triclinic, Shape::three_d>(dx);
 
                 Scalar r_list = r_cut + m_r_buff;
                 Scalar sqshift = Scalar(0.0);
@@ -174,15 +194,17 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
                 Scalar r_listsq = h_r_listsq.data[m_typpair_idx(type_i,cur_neigh_type)];
                 if (dr_sq <= (r_listsq + sqshift) && !excluded)
                     {
-                    if (m_storage_mode == full || i < (int)cur_neigh)
+                    // test the exclusions only for the pairs in range
+                    for (unsigned int cur_ex = 0; cur_ex < n_ex_i && !excluded; cur_ex++)
+                        excluded = (h_ex_list_idx.data[ex_head_i + cur_ex] == cur_neigh);
+
+                    if (!excluded && (m_storage_mode == full || i < (int)cur_neigh))
                         {
                         // local neighbor
                         if (cur_n_neigh < Nmax_i)
                             {
                             h_nlist.data[head_idx_i + cur_n_neigh] = cur_neigh;
                             }
-                        else
-                            h_conditions.data[type_i] = max(h_conditions.data[type_i], cur_n_neigh+1);
 
                         cur_n_neigh++;
                         }
@@ -191,6 +213,37 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
             }
 
         h_n_neigh.data[i] = cur_n_neigh;
+        };
+
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        tbb::parallel_for(tbb::blocked_range<int>(0, (int)nparticles),
+            [&](const tbb::blocked_range<int>& r)
+            {
+            dispatchBoxShape(box, three_d, [&](auto shape)
+                {
+                for (int i = r.begin(); i != r.end(); ++i)
+                    build_particle(i, shape);
+                });
+            });
+        }
+    else
+    #endif
+        {
+        dispatchBoxShape(box, three_d, [&](auto shape)
+            {
+            for (int i = 0; i < (int)nparticles; i++)
+                build_particle(i, shape);
+            });
+        }
+
+    // record the particles that did not fit into their section of the list
+    for (unsigned int i = 0; i < nparticles; i++)
+        {
+        const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
+        if (h_n_neigh.data[i] > h_Nmax.data[type_i])
+            h_conditions.data[type_i] = max(h_conditions.data[type_i], h_n_neigh.data[i]);
         }
 
     if (m_prof)
@@ -0,0 +1,217 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: joaander
+
+/*! \file NeighborListBufferTuner.cc
+    \brief Defines the NeighborListBufferTuner class
+*/
+
+
+#include "NeighborListBufferTuner.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/HOOMDMPI.h"
+#endif
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \param sysdef System definition
+    \param trigger Select the time steps on which to take a tuning step
+    \param nlist Neighbor list to tune
+    \param buffer_min Smallest buffer candidate
+    \param buffer_max Largest buffer candidate
+    \param n_buffers Number of buffer candidates
+*/
+NeighborListBufferTuner::NeighborListBufferTuner(std::shared_ptr<SystemDefinition> sysdef,
+                                                 std::shared_ptr<Trigger> trigger,
+                                                 std::shared_ptr<NeighborList> nlist,
+                                                 Scalar buffer_min,
+                                                 Scalar buffer_max,
+                                                 unsigned int n_buffers)
+        : Tuner(sysdef, trigger), m_nlist(nlist), m_buffer_min(buffer_min), m_buffer_max(buffer_max),
+          m_state(STARTUP), m_current(0), m_last_timestep(0), m_last_time(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing NeighborListBufferTuner" << endl;
+
+    if (buffer_min < 0.0 || buffer_max < buffer_min)
+        {
+        m_exec_conf->msg->error() << "tune.NeighborListBuffer: buffer range must satisfy 0 <= min <= max" << endl;
+        throw runtime_error("Error initializing NeighborListBufferTuner");
+        }
+
+    if (n_buffers == 0)
+        {
+        m_exec_conf->msg->error() << "tune.NeighborListBuffer: n_buffers must be positive" << endl;
+        throw runtime_error("Error initializing NeighborListBufferTuner");
+        }
+
+    m_buffers.resize(n_buffers);
+    for (unsigned int i = 0; i < n_buffers; i++)
+        {
+        if (n_buffers == 1)
+            m_buffers[i] = buffer_min;
+        else
+            m_buffers[i] = buffer_min + (buffer_max - buffer_min) * Scalar(i) / Scalar(n_buffers - 1);
+        }
+
+    m_times.resize(n_buffers, 0.0);
+    m_delays.resize(n_buffers, 1);
+    }
+
+NeighborListBufferTuner::~NeighborListBufferTuner()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying NeighborListBufferTuner" << endl;
+    }
+
+/*! \param buffer Buffer width to set
+    \param delay Rebuild check delay to set
+    \param timestep Current time step
+
+    Setting the buffer forces a neighbor list update, which is amortized over the whole sample.
+*/
+void NeighborListBufferTuner::startSample(Scalar buffer, unsigned int delay, unsigned int timestep)
+    {
+    if (buffer != m_nlist->getRBuff())
+        m_nlist->setRBuff(buffer);
+    if (delay != m_nlist->getRebuildCheckDelay())
+        m_nlist->setRebuildCheckDelay(delay);
+
+    m_nlist->resetStats();
+    m_last_timestep = timestep;
+    m_last_time = m_clk.getTime();
+    }
+
+/*! \param time_per_step Time per step on this rank, replaced by the maximum over all ranks
+    \param smallest_rebuild Shortest rebuild period on this rank, replaced by the minimum over all ranks
+    \param n_dangerous Number of dangerous builds on this rank, replaced by the sum over all ranks
+
+    All ranks must make the same choice, so the tuner acts on the slowest rank, the shortest rebuild period,
+    and any dangerous build on any rank.
+*/
+void NeighborListBufferTuner::reduceStats(double& time_per_step, unsigned int& smallest_rebuild,
+                                          uint64_t& n_dangerous)
+    {
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Comm comm = m_exec_conf->getMPICommunicator();
+        MPI_Allreduce(MPI_IN_PLACE, &time_per_step, 1, MPI_DOUBLE, MPI_MAX, comm);
+        MPI_Allreduce(MPI_IN_PLACE, &smallest_rebuild, 1, MPI_UNSIGNED, MPI_MIN, comm);
+        unsigned long long n = n_dangerous;
+        MPI_Allreduce(MPI_IN_PLACE, &n, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
+        n_dangerous = n;
+        }
+#endif
+    }
+
+/*! \param timestep Current time step of the simulation
+*/
+void NeighborListBufferTuner::update(unsigned int timestep)
+    {
+    if (m_state == STARTUP)
+        {
+        m_current = 0;
+        m_state = PROBE;
+        startSample(m_buffers[0], 1, timestep);
+        return;
+        }
+
+    // a sample needs at least one step
+    if (timestep <= m_last_timestep)
+        return;
+
+    double time_per_step = double(m_clk.getTime() - m_last_time) / 1e9 / double(timestep - m_last_timestep);
+    unsigned int smallest_rebuild = m_nlist->getSmallestRebuild();
+    uint64_t n_dangerous = m_nlist->getNumDangerousUpdates();
+    reduceStats(time_per_step, smallest_rebuild, n_dangerous);
+
+    unsigned int delay = m_nlist->getRebuildCheckDelay();
+    if (n_dangerous > 0)
+        {
+        // the check delay is too long for this buffer, shorten it and repeat the sample
+        unsigned int new_delay = std::max(delay / 2, 1u);
+        m_exec_conf->msg->notice(4) << "tune.NeighborListBuffer: " << n_dangerous
+                                    << " dangerous builds, reducing rebuild_check_delay to " << new_delay << endl;
+        if (m_state != IDLE)
+            m_delays[m_current] = new_delay;
+        startSample(m_nlist->getRBuff(), new_delay, timestep);
+        return;
+        }
+
+    if (m_state == PROBE)
+        {
+        m_delays[m_current] = std::max(smallest_rebuild / 2, 1u);
+        m_state = MEASURE;
+        startSample(m_buffers[m_current], m_delays[m_current], timestep);
+        }
+    else if (m_state == MEASURE)
+        {
+        m_times[m_current] = time_per_step;
+        m_exec_conf->msg->notice(5) << "tune.NeighborListBuffer: buffer " << m_buffers[m_current]
+                                    << ", rebuild_check_delay " << m_delays[m_current]
+                                    << ": " << time_per_step << " s/step" << endl;
+
+        m_current++;
+        if (m_current < m_buffers.size())
+            {
+            m_state = PROBE;
+            startSample(m_buffers[m_current], 1, timestep);
+            }
+        else
+            {
+            unsigned int best = (unsigned int)(std::min_element(m_times.begin(), m_times.end()) - m_times.begin());
+            m_exec_conf->msg->notice(4) << "tune.NeighborListBuffer: selected buffer " << m_buffers[best]
+                                        << ", rebuild_check_delay " << m_delays[best] << endl;
+            m_current = best;
+            m_state = IDLE;
+            startSample(m_buffers[best], m_delays[best], timestep);
+            }
+        }
+    else
+        {
+        // IDLE: keep monitoring dangerous builds over the next period
+        startSample(m_nlist->getRBuff(), delay, timestep);
+        }
+    }
+
+pybind11::list NeighborListBufferTuner::getSampledTimes()
+    {
+    pybind11::list result;
+    for (auto t : m_times)
+        result.append(t);
+    return result;
+    }
+
+pybind11::list NeighborListBufferTuner::getSampledBuffers()
+    {
+    pybind11::list result;
+    for (auto b : m_buffers)
+        result.append(b);
+    return result;
+    }
+
+void export_NeighborListBufferTuner(py::module& m)
+    {
+    py::class_<NeighborListBufferTuner, Tuner, std::shared_ptr<NeighborListBufferTuner> >(m,
+                                                                                       "NeighborListBufferTuner")
+    .def(py::init< std::shared_ptr<SystemDefinition>,
+                   std::shared_ptr<Trigger>,
+                   std::shared_ptr<NeighborList>,
+                   Scalar,
+                   Scalar,
+                   unsigned int >())
+    .def("retune", &NeighborListBufferTuner::retune)
+    .def_property_readonly("complete", &NeighborListBufferTuner::isComplete)
+    .def_property_readonly("buffer_min", &NeighborListBufferTuner::getBufferMin)
+    .def_property_readonly("buffer_max", &NeighborListBufferTuner::getBufferMax)
+    .def_property_readonly("n_buffers", &NeighborListBufferTuner::getNBuffers)
+    .def_property_readonly("sampled_times", &NeighborListBufferTuner::getSampledTimes)
+    .def_property_readonly("sampled_buffers", &NeighborListBufferTuner::getSampledBuffers)
+    ;
+    }
@@ -0,0 +1,129 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file NeighborListBufferTuner.h
+    \brief Declares a tuner that adjusts the neighbor list buffer and rebuild check delay
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "hoomd/Tuner.h"
+#include "hoomd/ClockSource.h"
+#include "NeighborList.h"
+
+#include <memory>
+#include <vector>
+#include <pybind11/pybind11.h>
+
+#ifndef __NEIGHBORLISTBUFFERTUNER_H__
+#define __NEIGHBORLISTBUFFERTUNER_H__
+
+//! Tunes the neighbor list buffer width and rebuild check delay during a run
+/*! NeighborListBufferTuner chooses the value of NeighborList::setRBuff() that minimizes the wall clock time per
+    step. Like Autotuner, it samples each candidate value in turn and then sets the fastest one. The candidates are
+    \a n_buffers values spaced evenly in [\a buffer_min, \a buffer_max]. The time between two successive calls to
+    update() is one sample, so the Trigger period sets the number of steps averaged in each sample.
+
+    Each candidate takes two samples. The first runs with a rebuild check delay of 1, which can never produce a
+    dangerous build, and records the shortest period between rebuilds that the neighbor list observed. The second
+    sets the check delay to half of that period and measures the time per step. After the scan completes, the tuner
+    keeps the fastest buffer and the check delay measured with it.
+
+    Dangerous builds are checked on every call. When the neighbor list reports any, the tuner halves the check delay
+    (down to 1), discards the current sample, and repeats it. A check delay of 1 disables the dangerous build
+    condition in NeighborList entirely, so the dangerous build rate reaches zero after at most a few samples.
+
+    Call retune() to scan the candidates again, for example after the system changes state.
+
+    \ingroup tuners
+*/
+class PYBIND11_EXPORT NeighborListBufferTuner : public Tuner
+    {
+    public:
+        //! Constructor
+        NeighborListBufferTuner(std::shared_ptr<SystemDefinition> sysdef,
+                                std::shared_ptr<Trigger> trigger,
+                                std::shared_ptr<NeighborList> nlist,
+                                Scalar buffer_min,
+                                Scalar buffer_max,
+                                unsigned int n_buffers);
+        virtual ~NeighborListBufferTuner();
+
+        //! Take one tuning step
+        virtual void update(unsigned int timestep);
+
+        //! Restart the scan over the buffer candidates
+        void retune()
+            {
+            m_state = STARTUP;
+            }
+
+        //! Test if the scan is complete
+        bool isComplete()
+            {
+            return m_state == IDLE;
+            }
+
+        //! Get the lower bound of the buffer candidates
+        Scalar getBufferMin()
+            {
+            return m_buffer_min;
+            }
+
+        //! Get the upper bound of the buffer candidates
+        Scalar getBufferMax()
+            {
+            return m_buffer_max;
+            }
+
+        //! Get the number of buffer candidates
+        unsigned int getNBuffers()
+            {
+            return (unsigned int)m_buffers.size();
+            }
+
+        //! Get the measured time per step (in seconds) for each buffer candidate
+        pybind11::list getSampledTimes();
+
+        //! Get the buffer candidates
+        pybind11::list getSampledBuffers();
+
+    protected:
+        //! States of the tuning process
+        enum State
+            {
+            STARTUP,    //!< Start a new scan on the next call
+            PROBE,      //!< Measure the shortest rebuild period with a check delay of 1
+            MEASURE,    //!< Measure the time per step with the probed check delay
+            IDLE        //!< Scan complete, monitoring dangerous builds
+            };
+
+        std::shared_ptr<NeighborList> m_nlist;  //!< Neighbor list to tune
+        Scalar m_buffer_min;                    //!< Smallest buffer candidate
+        Scalar m_buffer_max;                    //!< Largest buffer candidate
+        std::vector<Scalar> m_buffers;          //!< Buffer candidates
+        std::vector<double> m_times;            //!< Measured time per step for each candidate
+        std::vector<unsigned int> m_delays;     //!< Check delay used for each candidate
+
+        State m_state;                          //!< Current state
+        unsigned int m_current;                 //!< Index of the candidate currently being sampled
+        unsigned int m_last_timestep;           //!< Time step of the previous call
+        int64_t m_last_time;                    //!< Wall clock time of the previous call
+        ClockSource m_clk;                      //!< Clock used to time the samples
+
+        //! Set the buffer and check delay and start a new sample
+        void startSample(Scalar buffer, unsigned int delay, unsigned int timestep);
+
+        //! Reduce the sample statistics across MPI ranks
+        void reduceStats(double& time_per_step, unsigned int& smallest_rebuild, uint64_t& n_dangerous);
+    };
+
+//! Export the NeighborListBufferTuner to python
+void export_NeighborListBufferTuner(pybind11::module& m);
+
+#endif
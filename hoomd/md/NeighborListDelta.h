@@ -0,0 +1,70 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __NEIGHBOR_LIST_DELTA_H__
+#define __NEIGHBOR_LIST_DELTA_H__
+
+/*! \file NeighborListDelta.h
+    \brief Defines the 16-bit relative encoding of the neighbor list
+    \details Neighbor j of particle i is stored as the delta j - i when it fits in 16 bits, otherwise as
+    nlist_delta_escape, in which case the index is read from the 32-bit list at the same slot. This header is also
+    compiled by NVRTC for the JIT pair potentials, so it includes no other headers.
+*/
+
+// HOSTDEVICE is __host__ __device__ when included in nvcc and inline when included into the host compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__ __forceinline__
+#else
+#define HOSTDEVICE inline
+#endif
+
+//! Delta that marks a neighbor whose index is only stored in the 32-bit list
+const short nlist_delta_escape = -32768;
+
+//! Encode neighbor j of particle i
+HOSTDEVICE short encodeNeighborDelta(unsigned int i, unsigned int j)
+    {
+    const int delta = int(j) - int(i);
+    return (delta > -32768 && delta < 32768) ? short(delta) : nlist_delta_escape;
+    }
+
+//! Decode neighbor k of particle i
+/*! \param i Particle index
+    \param nlist_delta 16-bit list
+    \param nlist 32-bit list, only read for escaped neighbors
+    \param k Slot of the neighbor in both lists
+*/
+HOSTDEVICE unsigned int decodeNeighborDelta(unsigned int i,
+                                            const short *nlist_delta,
+                                            const unsigned int *nlist,
+                                            unsigned int k)
+    {
+    const short delta = nlist_delta[k];
+    return delta != nlist_delta_escape ? i + delta : nlist[k];
+    }
+
+#ifdef __HIPCC__
+//! Load neighbor k of particle i through the read-only cache
+/*! \param i Particle index
+    \param d_nlist_delta 16-bit list, NULL to read \a d_nlist only
+    \param d_nlist 32-bit list
+    \param k Slot of the neighbor in both lists
+*/
+__device__ __forceinline__ unsigned int loadNeighbor(unsigned int i,
+                                                     const short *d_nlist_delta,
+                                                     const unsigned int *d_nlist,
+                                                     unsigned int k)
+    {
+    if (d_nlist_delta)
+        {
+        const short delta = __ldg(d_nlist_delta + k);
+        if (delta != nlist_delta_escape)
+            return i + delta;
+        }
+    return __ldg(d_nlist + k);
+    }
+#endif
+
+#undef HOSTDEVICE
+
+#endif // __NEIGHBOR_LIST_DELTA_H__
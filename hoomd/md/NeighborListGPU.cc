@@ -19,6 +19,7 @@ namespace py = pybind11;
 
 #include "hoomd/CachedAllocator.h"
 
+#include <algorithm>
 #include <iostream>
 using namespace std;
 
@@ -155,6 +156,7 @@ void NeighborListGPU::filterNlist()
     // access data
 
     ArrayHandle<unsigned int> d_n_ex_idx(m_n_ex_idx, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_ex_head_idx(m_ex_head_idx, access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_ex_list_idx(m_ex_list_idx, access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_n_neigh(m_n_neigh, access_location::device, access_mode::readwrite);
     ArrayHandle<unsigned int> d_nlist(m_nlist, access_location::device, access_mode::readwrite);
@@ -166,7 +168,8 @@ void NeighborListGPU::filterNlist()
                      d_head_list.data,
                      d_n_ex_idx.data,
                      d_ex_list_idx.data,
-                     m_ex_list_indexer,
+                     d_ex_head_idx.data,
+                     m_max_n_ex,
                      m_pdata->getN(),
                      m_tuner_filter->getParam());
     if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
@@ -176,12 +179,63 @@ void NeighborListGPU::filterNlist()
         m_prof->pop(m_exec_conf);
     }
 
+void NeighborListGPU::sortNlist()
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "sort");
+
+    ArrayHandle<unsigned int> d_n_neigh(m_n_neigh, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_nlist(m_nlist, access_location::device, access_mode::readwrite);
+    ArrayHandle<unsigned int> d_head_list(m_head_list, access_location::device, access_mode::read);
+
+    m_tuner_sort->begin();
+    gpu_nlist_sort(d_nlist.data,
+                   d_n_neigh.data,
+                   d_head_list.data,
+                   m_pdata->getN(),
+                   m_tuner_sort->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+    m_tuner_sort->end();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+/*! Encodes the neighbors of each particle as 16-bit deltas on the GPU
+*/
+void NeighborListGPU::buildDeltaList()
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "delta");
+
+    m_nlist_delta.resize(m_nlist.getNumElements());
+
+    ArrayHandle<unsigned int> d_n_neigh(m_n_neigh, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_nlist(m_nlist, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_head_list(m_head_list, access_location::device, access_mode::read);
+    ArrayHandle<short> d_nlist_delta(m_nlist_delta, access_location::device, access_mode::overwrite);
+
+    m_tuner_delta->begin();
+    gpu_nlist_encode_delta(d_nlist_delta.data,
+                           d_nlist.data,
+                           d_n_neigh.data,
+                           d_head_list.data,
+                           m_pdata->getN(),
+                           m_tuner_delta->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+    m_tuner_delta->end();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
 
 //! Update the exclusion list on the GPU
 void NeighborListGPU::updateExListIdx()
     {
     assert(! m_need_reallocate_exlist);
 
+    commitExclusions();
+
     if (m_prof)
         m_prof->push(m_exec_conf,"update-ex");
 
@@ -189,18 +243,20 @@ void NeighborListGPU::updateExListIdx()
     ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
 
     ArrayHandle<unsigned int> d_n_ex_tag(m_n_ex_tag, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_ex_head_tag(m_ex_head_tag, access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_ex_list_tag(m_ex_list_tag, access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_n_ex_idx(m_n_ex_idx, access_location::device, access_mode::overwrite);
-    ArrayHandle<unsigned int> d_ex_list_idx(m_ex_list_idx, access_location::device, access_mode::overwrite);
+    ArrayHandle<unsigned int> d_ex_head_idx(m_ex_head_idx, access_location::device, access_mode::overwrite);
+    ArrayHandle<unsigned int> d_ex_list_idx(m_ex_list_idx, access_location::device, access_mode::readwrite);
 
     gpu_update_exclusion_list(d_tag.data,
                               d_rtag.data,
                               d_n_ex_tag.data,
+                              d_ex_head_tag.data,
                               d_ex_list_tag.data,
-                              m_ex_list_indexer_tag,
                               d_n_ex_idx.data,
+                              d_ex_head_idx.data,
                               d_ex_list_idx.data,
-                              m_ex_list_indexer,
                               m_pdata->getN());
     if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
 
@@ -257,6 +313,85 @@ void NeighborListGPU::buildHeadList()
     if (m_prof) m_prof->pop(m_exec_conf);
     }
 
+/*! \returns true if the list was completed in the grown capacity, false if it has to be built again
+
+    The binned and stencil builds keep the neighbors that did not fit in the list in m_spill. After checkConditions()
+    grew m_Nmax, the neighbors that were written are moved to the grown head list and the spilled ones are appended,
+    so the build is not repeated. When m_spill was too small, it is grown for the next overflow (up to 1/8 of the
+    size of the list) and the list is built again.
+*/
+bool NeighborListGPU::completeOverflowedBuild()
+    {
+    if (!m_build_spills || !m_pdata->getN())
+        return false;
+
+    unsigned int n_spill;
+        {
+        ArrayHandle<unsigned int> h_n_spill(m_n_spill, access_location::host, access_mode::read);
+        n_spill = *h_n_spill.data;
+        }
+
+    if (n_spill > m_spill.getNumElements())
+        {
+        size_t spill_size = std::min((size_t)n_spill + n_spill/8, m_nlist.getNumElements()/8);
+        if (spill_size > m_spill.getNumElements())
+            {
+            m_exec_conf->msg->notice(6) << "nlist: Growing the overflow buffer to " << spill_size << " neighbors" << endl;
+            m_spill.resize(spill_size);
+            }
+        return false;
+        }
+
+    if (m_prof) m_prof->push(m_exec_conf, "overflow");
+
+    // end of the list of the last particle in the overflowed build
+    unsigned int old_size;
+        {
+        ArrayHandle<unsigned int> h_req_size_nlist(m_req_size_nlist, access_location::host, access_mode::read);
+        old_size = *h_req_size_nlist.data;
+        }
+
+    // keep the overflowed list aside and let buildHeadList() allocate a new one, without copying the old contents
+    GlobalArray<unsigned int> old_head_list(m_head_list.getNumElements(), m_exec_conf);
+    m_head_list.swap(old_head_list);
+    GlobalArray<unsigned int> old_nlist(1, m_exec_conf);
+    m_nlist.swap(old_nlist);
+
+    buildHeadList();
+
+    const unsigned int N = m_pdata->getN();
+    GlobalArray<unsigned int> n_kept(N, m_exec_conf);
+        {
+        ArrayHandle<unsigned int> d_nlist(m_nlist, access_location::device, access_mode::overwrite);
+        ArrayHandle<unsigned int> d_n_kept(n_kept, access_location::device, access_mode::overwrite);
+        ArrayHandle<unsigned int> d_old_nlist(old_nlist, access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_n_neigh(m_n_neigh, access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_old_head_list(old_head_list, access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_head_list(m_head_list, access_location::device, access_mode::read);
+        ArrayHandle<uint2> d_spill(m_spill, access_location::device, access_mode::read);
+
+        gpu_nlist_complete_overflow(d_nlist.data,
+                                    d_n_kept.data,
+                                    d_old_nlist.data,
+                                    d_n_neigh.data,
+                                    d_old_head_list.data,
+                                    d_head_list.data,
+                                    old_size,
+                                    d_spill.data,
+                                    n_spill,
+                                    N,
+                                    256);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+    m_exec_conf->msg->notice(6) << "nlist: Completed an overflowed build with " << n_spill << " spilled neighbors"
+                                << endl;
+
+    if (m_prof) m_prof->pop(m_exec_conf);
+    return true;
+    }
+
 void export_NeighborListGPU(py::module& m)
     {
     py::class_<NeighborListGPU, NeighborList, std::shared_ptr<NeighborListGPU> >(m, "NeighborListGPU")
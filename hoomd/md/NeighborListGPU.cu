@@ -10,6 +10,7 @@
 */
 
 #include "NeighborListGPU.cuh"
+#include "NeighborListDelta.h"
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
@@ -142,7 +143,7 @@ const unsigned int FILTER_BATCH_SIZE = 4;
     \param nli Indexer for indexing into d_nlist
     \param d_n_ex Number of exclusions for each particle
     \param d_ex_list List of exclusions for each particle
-    \param exli Indexer for indexing into d_ex_list
+    \param d_ex_head Start of the exclusions of each particle in \a d_ex_list
     \param N Number of particles
     \param ex_start Start filtering the nlist from exclusion number \a ex_start
 
@@ -164,7 +165,7 @@ __global__ void gpu_nlist_filter_kernel(unsigned int *d_n_neigh,
                                         const unsigned int *d_head_list,
                                         const unsigned int *d_n_ex,
                                         const unsigned int *d_ex_list,
-                                        const Index2D exli,
+                                        const unsigned int *d_ex_head,
                                         const unsigned int N,
                                         const unsigned int ex_start)
     {
@@ -192,7 +193,7 @@ __global__ void gpu_nlist_filter_kernel(unsigned int *d_n_neigh,
     for (unsigned int cur_ex_idx = 0; cur_ex_idx < FILTER_BATCH_SIZE; cur_ex_idx++)
         {
         if (cur_ex_idx < n_ex_process)
-            l_ex_list[cur_ex_idx] = d_ex_list[exli(idx, cur_ex_idx + ex_start)];
+            l_ex_list[cur_ex_idx] = d_ex_list[d_ex_head[idx] + cur_ex_idx + ex_start];
         else
             l_ex_list[cur_ex_idx] = 0xffffffff;
         }
@@ -230,7 +231,8 @@ hipError_t gpu_nlist_filter(unsigned int *d_n_neigh,
                              const unsigned int *d_head_list,
                              const unsigned int *d_n_ex,
                              const unsigned int *d_ex_list,
-                             const Index2D& exli,
+                             const unsigned int *d_ex_head,
+                             const unsigned int max_n_ex,
                              const unsigned int N,
                              const unsigned int block_size)
     {
@@ -248,7 +250,7 @@ hipError_t gpu_nlist_filter(unsigned int *d_n_neigh,
     int n_blocks = N/run_block_size + 1;
 
     // split the processing of the full exclusion list up into a number of batches
-    unsigned int n_batches = (unsigned int)ceil(double(exli.getH())/double(FILTER_BATCH_SIZE));
+    unsigned int n_batches = (unsigned int)ceil(double(max_n_ex)/double(FILTER_BATCH_SIZE));
     unsigned int ex_start = 0;
     for (unsigned int batch = 0; batch < n_batches; batch++)
         {
@@ -257,7 +259,7 @@ hipError_t gpu_nlist_filter(unsigned int *d_n_neigh,
                                                               d_head_list,
                                                               d_n_ex,
                                                               d_ex_list,
-                                                              exli,
+                                                              d_ex_head,
                                                               N,
                                                               ex_start);
 
@@ -267,15 +269,135 @@ hipError_t gpu_nlist_filter(unsigned int *d_n_neigh,
     return hipSuccess;
     }
 
+/*! \param d_nlist Neighbor list for each particle (read/write)
+    \param d_n_neigh Number of neighbors for each particle
+    \param d_head_list Start of the list of each particle in \a d_nlist
+    \param N Number of particles
+
+    One thread is run for each particle. It sorts the neighbors of the particle by index with an insertion sort in
+    place, which is fast for the short and, after a deterministic cell list build, nearly sorted lists.
+*/
+__global__ void gpu_nlist_sort_kernel(unsigned int *d_nlist,
+                                      const unsigned int *d_n_neigh,
+                                      const unsigned int *d_head_list,
+                                      const unsigned int N)
+    {
+    // compute the particle index this thread operates on
+    const unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+
+    // quit now if this thread is processing past the end of the particle list
+    if (idx >= N)
+        return;
+
+    const unsigned int n_neigh = d_n_neigh[idx];
+    unsigned int *list = d_nlist + d_head_list[idx];
+    for (unsigned int k = 1; k < n_neigh; k++)
+        {
+        const unsigned int cur_neigh = list[k];
+        unsigned int m = k;
+        while (m > 0 && list[m-1] > cur_neigh)
+            {
+            list[m] = list[m-1];
+            m--;
+            }
+        list[m] = cur_neigh;
+        }
+    }
+
+hipError_t gpu_nlist_sort(unsigned int *d_nlist,
+                          const unsigned int *d_n_neigh,
+                          const unsigned int *d_head_list,
+                          const unsigned int N,
+                          const unsigned int block_size)
+    {
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, (const void *)gpu_nlist_sort_kernel);
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    // determine parameters for kernel launch
+    int n_blocks = N/run_block_size + 1;
+
+    hipLaunchKernelGGL((gpu_nlist_sort_kernel), dim3(n_blocks), dim3(run_block_size), 0, 0, d_nlist,
+                                                          d_n_neigh,
+                                                          d_head_list,
+                                                          N);
+
+    return hipSuccess;
+    }
+
+/*! \param d_nlist_delta Neighbors as 16-bit deltas (written)
+    \param d_nlist Neighbor list for each particle
+    \param d_n_neigh Number of neighbors for each particle
+    \param d_head_list Start of the list of each particle in \a d_nlist and \a d_nlist_delta
+    \param N Number of particles
+
+    One thread is run for each particle. It encodes the neighbors of the particle with encodeNeighborDelta().
+*/
+__global__ void gpu_nlist_encode_delta_kernel(short *d_nlist_delta,
+                                              const unsigned int *d_nlist,
+                                              const unsigned int *d_n_neigh,
+                                              const unsigned int *d_head_list,
+                                              const unsigned int N)
+    {
+    // compute the particle index this thread operates on
+    const unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+
+    // quit now if this thread is processing past the end of the particle list
+    if (idx >= N)
+        return;
+
+    const unsigned int n_neigh = d_n_neigh[idx];
+    const unsigned int head = d_head_list[idx];
+    for (unsigned int k = 0; k < n_neigh; k++)
+        {
+        d_nlist_delta[head + k] = encodeNeighborDelta(idx, d_nlist[head + k]);
+        }
+    }
+
+hipError_t gpu_nlist_encode_delta(short *d_nlist_delta,
+                                  const unsigned int *d_nlist,
+                                  const unsigned int *d_n_neigh,
+                                  const unsigned int *d_head_list,
+                                  const unsigned int N,
+                                  const unsigned int block_size)
+    {
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, (const void *)gpu_nlist_encode_delta_kernel);
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    // determine parameters for kernel launch
+    int n_blocks = N/run_block_size + 1;
+
+    hipLaunchKernelGGL((gpu_nlist_encode_delta_kernel), dim3(n_blocks), dim3(run_block_size), 0, 0, d_nlist_delta,
+                                                                  d_nlist,
+                                                                  d_n_neigh,
+                                                                  d_head_list,
+                                                                  N);
+
+    return hipSuccess;
+    }
+
 //! GPU kernel to update the exclusions list
 __global__ void gpu_update_exclusion_list_kernel(const unsigned int *tags,
                                                   const unsigned int *rtags,
                                                   const unsigned int *n_ex_tag,
+                                                  const unsigned int *ex_head_tag,
                                                   const unsigned int *ex_list_tag,
-                                                  const Index2D ex_list_tag_indexer,
                                                   unsigned int *n_ex_idx,
+                                                  unsigned int *ex_head_idx,
                                                   unsigned int *ex_list_idx,
-                                                  const Index2D ex_list_indexer,
                                                   const unsigned int N)
     {
     unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -286,16 +408,18 @@ __global__ void gpu_update_exclusion_list_kernel(const unsigned int *tags,
     unsigned int tag = tags[idx];
 
     unsigned int n = n_ex_tag[tag];
+    unsigned int head = ex_head_tag[tag];
 
-    // copy over number of exclusions
+    // copy over number of exclusions and the row
     n_ex_idx[idx] = n;
+    ex_head_idx[idx] = head;
 
-    for (unsigned int offset = 0; offset < n; offset++)
+    for (unsigned int offset = head; offset < head + n; offset++)
         {
-        unsigned int ex_tag = ex_list_tag[ex_list_tag_indexer(tag, offset)];
+        unsigned int ex_tag = ex_list_tag[offset];
         unsigned int ex_idx = rtags[ex_tag];
 
-        ex_list_idx[ex_list_indexer(idx, offset)] = ex_idx;
+        ex_list_idx[offset] = ex_idx;
         }
     }
 
@@ -304,21 +428,21 @@ __global__ void gpu_update_exclusion_list_kernel(const unsigned int *tags,
 /*! \param d_tag Array of particle tags
     \param d_rtag Array of reverse-lookup tag->idx
     \param d_n_ex_tag List of number of exclusions per tag
-    \param d_ex_list_tag 2D Exclusion list per tag
-    \param ex_list_tag_indexer Indexer for per-tag exclusion list
+    \param d_ex_head_tag Start of the row of each tag in \a d_ex_list_tag
+    \param d_ex_list_tag Exclusion list per tag
     \param d_n_ex_idx List of number of exclusions per idx
-    \param d_ex_list_idx Exclusion list per idx
-    \param ex_list_indexer Indexer for per-idx exclusion list
+    \param d_ex_head_idx Start of the row of each idx in \a d_ex_list_idx
+    \param d_ex_list_idx Exclusion list per idx, in the rows of \a d_ex_list_tag
     \param N number of particles
  */
 hipError_t gpu_update_exclusion_list(const unsigned int *d_tag,
                                 const unsigned int *d_rtag,
                                 const unsigned int *d_n_ex_tag,
+                                const unsigned int *d_ex_head_tag,
                                 const unsigned int *d_ex_list_tag,
-                                const Index2D& ex_list_tag_indexer,
                                 unsigned int *d_n_ex_idx,
+                                unsigned int *d_ex_head_idx,
                                 unsigned int *d_ex_list_idx,
-                                const Index2D& ex_list_indexer,
                                 const unsigned int N)
     {
     unsigned int block_size = 256;
@@ -326,11 +450,11 @@ hipError_t gpu_update_exclusion_list(const unsigned int *d_tag,
     hipLaunchKernelGGL((gpu_update_exclusion_list_kernel), dim3(N/block_size + 1), dim3(block_size), 0, 0, d_tag,
                                                                        d_rtag,
                                                                        d_n_ex_tag,
+                                                                       d_ex_head_tag,
                                                                        d_ex_list_tag,
-                                                                       ex_list_tag_indexer,
                                                                        d_n_ex_idx,
+                                                                       d_ex_head_idx,
                                                                        d_ex_list_idx,
-                                                                       ex_list_indexer,
                                                                        N);
 
     return hipSuccess;
@@ -453,3 +577,133 @@ hipError_t gpu_nlist_build_head_list(unsigned int *d_head_list,
 
     return hipSuccess;
     }
+
+/*!
+ * \param d_nlist Neighbor list laid out for the grown head list (written)
+ * \param d_n_kept Number of neighbors of each particle written so far (written)
+ * \param d_old_nlist Neighbor list of the overflowed build
+ * \param d_n_neigh Number of neighbors of each particle found by the overflowed build
+ * \param d_old_head_list Head list of the overflowed build
+ * \param d_head_list Grown head list
+ * \param old_size Size of the overflowed list (end of the list of the last particle)
+ * \param N the number of particles on this rank
+ *
+ * One thread per particle copies the neighbors that fit in the capacity of the overflowed build.
+ */
+__global__ void gpu_nlist_move_kept_kernel(unsigned int *d_nlist,
+                                           unsigned int *d_n_kept,
+                                           const unsigned int *d_old_nlist,
+                                           const unsigned int *d_n_neigh,
+                                           const unsigned int *d_old_head_list,
+                                           const unsigned int *d_head_list,
+                                           const unsigned int old_size,
+                                           const unsigned int N)
+    {
+    // particle index
+    const unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+
+    // one thread per particle
+    if (idx >= N)
+        return;
+
+    const unsigned int old_head = d_old_head_list[idx];
+    const unsigned int old_end = (idx + 1 < N) ? d_old_head_list[idx+1] : old_size;
+    const unsigned int n_kept = min(d_n_neigh[idx], old_end - old_head);
+
+    const unsigned int head = d_head_list[idx];
+    for (unsigned int k = 0; k < n_kept; ++k)
+        {
+        d_nlist[head + k] = d_old_nlist[old_head + k];
+        }
+    d_n_kept[idx] = n_kept;
+    }
+
+/*!
+ * \param d_nlist Neighbor list laid out for the grown head list
+ * \param d_n_kept Number of neighbors of each particle written so far
+ * \param d_spill Neighbors (particle, neighbor) that did not fit in the overflowed build
+ * \param d_head_list Grown head list
+ * \param n_spill Number of entries in \a d_spill
+ *
+ * One thread per spilled neighbor appends it to the list of its particle. The order of the appended neighbors depends
+ * on the order of the atomic operations.
+ */
+__global__ void gpu_nlist_insert_spill_kernel(unsigned int *d_nlist,
+                                              unsigned int *d_n_kept,
+                                              const uint2 *d_spill,
+                                              const unsigned int *d_head_list,
+                                              const unsigned int n_spill)
+    {
+    const unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+
+    if (idx >= n_spill)
+        return;
+
+    const uint2 spill = d_spill[idx];
+    const unsigned int k = atomicAdd(&d_n_kept[spill.x], 1);
+    d_nlist[d_head_list[spill.x] + k] = spill.y;
+    }
+
+/*!
+ * \param d_nlist Neighbor list laid out for the grown head list (written)
+ * \param d_n_kept Temporary storage for the number of neighbors written, N elements
+ * \param d_old_nlist Neighbor list of the overflowed build
+ * \param d_n_neigh Number of neighbors of each particle found by the overflowed build
+ * \param d_old_head_list Head list of the overflowed build
+ * \param d_head_list Grown head list
+ * \param old_size Size of the overflowed list (end of the list of the last particle)
+ * \param d_spill Neighbors (particle, neighbor) that did not fit in the overflowed build
+ * \param n_spill Number of entries in \a d_spill
+ * \param N the number of particles on this rank
+ * \param block_size Number of threads per block
+ *
+ * \return hipSuccess on completion
+ *
+ * Completes an overflowed build without repeating it: the neighbors that fit are moved to the grown head list, then
+ * the spilled neighbors are appended. The grown capacity must hold all \a d_n_neigh neighbors of each particle.
+ */
+hipError_t gpu_nlist_complete_overflow(unsigned int *d_nlist,
+                                       unsigned int *d_n_kept,
+                                       const unsigned int *d_old_nlist,
+                                       const unsigned int *d_n_neigh,
+                                       const unsigned int *d_old_head_list,
+                                       const unsigned int *d_head_list,
+                                       const unsigned int old_size,
+                                       const uint2 *d_spill,
+                                       const unsigned int n_spill,
+                                       const unsigned int N,
+                                       const unsigned int block_size)
+    {
+    static unsigned int max_block_size_move = UINT_MAX;
+    static unsigned int max_block_size_insert = UINT_MAX;
+    if (max_block_size_move == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, (const void *)gpu_nlist_move_kept_kernel);
+        max_block_size_move = attr.maxThreadsPerBlock;
+        hipFuncGetAttributes(&attr, (const void *)gpu_nlist_insert_spill_kernel);
+        max_block_size_insert = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, max_block_size_move);
+    hipLaunchKernelGGL((gpu_nlist_move_kept_kernel), dim3(N/run_block_size + 1), dim3(run_block_size), 0, 0, d_nlist,
+                                                                                           d_n_kept,
+                                                                                           d_old_nlist,
+                                                                                           d_n_neigh,
+                                                                                           d_old_head_list,
+                                                                                           d_head_list,
+                                                                                           old_size,
+                                                                                           N);
+
+    if (n_spill > 0)
+        {
+        run_block_size = min(block_size, max_block_size_insert);
+        hipLaunchKernelGGL((gpu_nlist_insert_spill_kernel), dim3(n_spill/run_block_size + 1), dim3(run_block_size), 0, 0, d_nlist,
+                                                                                                      d_n_kept,
+                                                                                                      d_spill,
+                                                                                                      d_head_list,
+                                                                                                      n_spill);
+        }
+
+    return hipSuccess;
+    }
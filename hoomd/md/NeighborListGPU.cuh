@@ -38,10 +38,26 @@ hipError_t gpu_nlist_filter(unsigned int *d_n_neigh,
                              const unsigned int *d_head_list,
                              const unsigned int *d_n_ex,
                              const unsigned int *d_ex_list,
-                             const Index2D& exli,
+                             const unsigned int *d_ex_head,
+                             const unsigned int max_n_ex,
                              const unsigned int N,
                              const unsigned int block_size);
 
+//! Kernel driver for gpu_nlist_sort_kernel()
+hipError_t gpu_nlist_sort(unsigned int *d_nlist,
+                          const unsigned int *d_n_neigh,
+                          const unsigned int *d_head_list,
+                          const unsigned int N,
+                          const unsigned int block_size);
+
+//! Kernel driver for gpu_nlist_encode_delta_kernel()
+hipError_t gpu_nlist_encode_delta(short *d_nlist_delta,
+                                  const unsigned int *d_nlist,
+                                  const unsigned int *d_n_neigh,
+                                  const unsigned int *d_head_list,
+                                  const unsigned int N,
+                                  const unsigned int block_size);
+
 //! Kernel driver to build head list on gpu
 hipError_t gpu_nlist_build_head_list(unsigned int *d_head_list,
                                       unsigned int *d_req_size_nlist,
@@ -51,16 +67,28 @@ hipError_t gpu_nlist_build_head_list(unsigned int *d_head_list,
                                       const unsigned int n_types,
                                       const unsigned int block_size);
 
+//! Kernel driver for gpu_nlist_move_kept_kernel() and gpu_nlist_insert_spill_kernel()
+hipError_t gpu_nlist_complete_overflow(unsigned int *d_nlist,
+                                       unsigned int *d_n_kept,
+                                       const unsigned int *d_old_nlist,
+                                       const unsigned int *d_n_neigh,
+                                       const unsigned int *d_old_head_list,
+                                       const unsigned int *d_head_list,
+                                       const unsigned int old_size,
+                                       const uint2 *d_spill,
+                                       const unsigned int n_spill,
+                                       const unsigned int N,
+                                       const unsigned int block_size);
 
 //! GPU function to update the exclusion list on the device
 hipError_t gpu_update_exclusion_list(const unsigned int *d_tag,
                                 const unsigned int *d_rtag,
                                 const unsigned int *d_n_ex_tag,
+                                const unsigned int *d_ex_head_tag,
                                 const unsigned int *d_ex_list_tag,
-                                const Index2D& ex_list_tag_indexer,
                                 unsigned int *d_n_ex_idx,
+                                unsigned int *d_ex_head_idx,
                                 unsigned int *d_ex_list_idx,
-                                const Index2D& ex_list_indexer,
                                 const unsigned int N);
 
 #endif
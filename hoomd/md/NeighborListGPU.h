@@ -73,10 +73,30 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
                 }
             #endif
 
+            // buffer for the neighbors that do not fit in the list, grown after the first overflows
+            GlobalArray<uint2> spill(1,m_exec_conf);
+            std::swap(m_spill, spill);
+            TAG_ALLOCATION(m_spill);
+
+            GlobalArray<unsigned int> n_spill(1,m_exec_conf);
+            std::swap(m_n_spill, n_spill);
+            TAG_ALLOCATION(m_n_spill);
+
+            #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
+            if (m_exec_conf->allConcurrentManagedAccess())
+                {
+                cudaMemAdvise(m_n_spill.get(), m_n_spill.getNumElements()*sizeof(unsigned int), cudaMemAdviseSetPreferredLocation, cudaCpuDeviceId);
+                CHECK_CUDA_ERROR();
+                }
+            #endif
+            m_build_spills = false;
+
             // create cuda event
             unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
             m_tuner_filter.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "nlist_filter", this->m_exec_conf));
             m_tuner_head_list.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "nlist_head_list", this->m_exec_conf));
+            m_tuner_sort.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "nlist_sort", this->m_exec_conf));
+            m_tuner_delta.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "nlist_delta", this->m_exec_conf));
             }
 
         //! Destructor
@@ -95,6 +115,12 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
 
             m_tuner_head_list->setPeriod(period/10);
             m_tuner_head_list->setEnabled(enable);
+
+            m_tuner_sort->setPeriod(period/10);
+            m_tuner_sort->setEnabled(enable);
+
+            m_tuner_delta->setPeriod(period/10);
+            m_tuner_delta->setEnabled(enable);
             }
 
         //! Benchmark the filter kernel
@@ -108,6 +134,23 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
 
         GlobalArray<unsigned int> m_req_size_nlist;    //!< Flag to hold the required size of the neighborlist
 
+        GlobalArray<uint2> m_spill;             //!< Neighbors (particle, neighbor) that did not fit in the last build
+        GlobalArray<unsigned int> m_n_spill;    //!< Number of neighbors that did not fit in the last build
+        bool m_build_spills;                    //!< True if the last build kept the neighbors that did not fit
+
+        //! Reset the spill counter before a build
+        /*! \param spill True if the build keeps the neighbors that do not fit in the list
+        */
+        void resetSpill(bool spill)
+            {
+            m_build_spills = spill;
+            if (spill)
+                {
+                ArrayHandle<unsigned int> h_n_spill(m_n_spill, access_location::host, access_mode::overwrite);
+                *h_n_spill.data = 0;
+                }
+            }
+
         //! Builds the neighbor list
         virtual void buildNlist(unsigned int timestep);
 
@@ -127,6 +170,15 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
         //! Build the head list for neighbor list indexing on the GPU
         virtual void buildHeadList();
 
+        //! Move the kept neighbors to the grown list and insert the spilled ones
+        virtual bool completeOverflowedBuild();
+
+        //! Sort the neighbors of each particle by index on the GPU
+        virtual void sortNlist();
+
+        //! Store the neighbors as 16-bit deltas on the GPU
+        virtual void buildDeltaList();
+
         //! Schedule the distance check kernel
         /*! \param timestep Current time step
          */
@@ -135,6 +187,8 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
     private:
         std::unique_ptr<Autotuner> m_tuner_filter; //!< Autotuner for filter block size
         std::unique_ptr<Autotuner> m_tuner_head_list; //!< Autotuner for the head list block size
+        std::unique_ptr<Autotuner> m_tuner_sort; //!< Autotuner for the sort block size
+        std::unique_ptr<Autotuner> m_tuner_delta; //!< Autotuner for the delta encoding block size
 
         GlobalArray<unsigned int> m_alt_head_list; //!< Alternate array to hold the head list from prefix sum
     };
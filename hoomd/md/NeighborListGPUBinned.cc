@@ -40,31 +40,42 @@ NeighborListGPUBinned::NeighborListGPUBinned(std::shared_ptr<SystemDefinition> s
     m_cl->setComputeTDB(!m_use_index);
     m_cl->setFlagIndex();
 
+    // excluded pairs are left out by the build kernel
+    m_build_applies_exclusions = true;
+
     CHECK_CUDA_ERROR();
 
     // initialize autotuner
-    // the full block size and threads_per_particle matrix is searched,
-    // encoded as block_size*10000 + threads_per_particle
+    // the full cell width, block size and threads_per_particle space is searched,
+    // encoded as cell_width_idx*100000000 + block_size*10000 + threads_per_particle
     std::vector<unsigned int> valid_params;
 
     const unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
-    for (unsigned int block_size = warp_size; block_size <= 1024; block_size += warp_size)
+    for (unsigned int cell_width_idx = 0; cell_width_idx < n_cell_width_factors; cell_width_idx++)
         {
-        unsigned int s=1;
-
-        while (s <= warp_size)
+        for (unsigned int block_size = warp_size; block_size <= 1024; block_size += warp_size)
             {
-            valid_params.push_back(block_size*10000 + s);
-            s = s * 2;
+            unsigned int s=1;
+
+            while (s <= warp_size)
+                {
+                valid_params.push_back(cell_width_idx*100000000 + block_size*10000 + s);
+                s = s * 2;
+                }
             }
         }
 
     m_tuner.reset(new Autotuner(valid_params, 5, 100000, "nlist_binned", this->m_exec_conf));
 
+    // prune the large joint space early, within two launches per parameter
+    m_tuner->setSearch(Autotuner::search_halving, 2*(unsigned int)valid_params.size());
+
     // cell sizes need update by default
     m_update_cell_size = true;
     }
 
+const Scalar NeighborListGPUBinned::cell_width_factors[] = {Scalar(1.0), Scalar(1.25), Scalar(1.5)};
+
 NeighborListGPUBinned::~NeighborListGPUBinned()
     {
     }
@@ -77,14 +88,22 @@ void NeighborListGPUBinned::buildNlist(unsigned int timestep)
         throw std::runtime_error("Error computing neighbor list");
         }
 
+    // the tuned cell width changes the cell list, so the timing includes the cell list build
+    this->m_tuner->begin();
+    unsigned int param = !m_param ? this->m_tuner->getParam() : m_param;
+    unsigned int cell_width_idx = std::min(param / 100000000, n_cell_width_factors - 1);
+    unsigned int block_size = (param % 100000000) / 10000;
+    unsigned int threads_per_particle = param % 10000;
+
     // update the cell list size if needed
-    if (m_update_cell_size)
+    if (m_update_cell_size || cell_width_idx != m_cell_width_idx)
         {
         Scalar rmax = getMaxRCut() + m_r_buff;
         if (m_diameter_shift)
             rmax += m_d_max - Scalar(1.0);
 
-        m_cl->setNominalWidth(rmax);
+        m_cl->setNominalWidth(rmax * cell_width_factors[cell_width_idx]);
+        m_cell_width_idx = cell_width_idx;
         m_update_cell_size = false;
         }
 
@@ -124,6 +143,15 @@ void NeighborListGPUBinned::buildNlist(unsigned int timestep)
     ArrayHandle<Scalar> d_r_cut(m_r_cut, access_location::device, access_mode::read);
     ArrayHandle<Scalar> d_r_listsq(m_r_listsq, access_location::device, access_mode::read);
 
+    ArrayHandle<unsigned int> d_n_ex_idx(m_n_ex_idx, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_ex_head_idx(m_ex_head_idx, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_ex_list_idx(m_ex_list_idx, access_location::device, access_mode::read);
+
+    // keep the neighbors that do not fit, unless the build is deterministic and the neighbors are not sorted after it
+    resetSpill(!m_cl->getSortCellList() || m_sort_neighbors);
+    ArrayHandle<uint2> d_spill(m_spill, access_location::device, access_mode::overwrite);
+    ArrayHandle<unsigned int> d_n_spill(m_n_spill, access_location::device, access_mode::readwrite);
+
     #ifdef __HIP_PLATFORM_NVCC__
     auto& gpu_map = m_exec_conf->getGPUIds();
 
@@ -143,11 +171,6 @@ void NeighborListGPUBinned::buildNlist(unsigned int timestep)
 
     m_exec_conf->beginMultiGPU();
 
-    this->m_tuner->begin();
-    unsigned int param = !m_param ? this->m_tuner->getParam() : m_param;
-    unsigned int block_size = param / 10000;
-    unsigned int threads_per_particle = param % 10000;
-
     gpu_compute_nlist_binned(d_nlist.data,
                              d_n_neigh.data,
                              d_last_pos.data,
@@ -156,6 +179,12 @@ void NeighborListGPUBinned::buildNlist(unsigned int timestep)
                              d_head_list.data,
                              d_pos.data,
                              d_body.data,
+                             m_exclusions_set ? d_n_ex_idx.data : NULL,
+                             d_ex_list_idx.data,
+                             d_ex_head_idx.data,
+                             d_spill.data,
+                             m_build_spills ? d_n_spill.data : NULL,
+                             (unsigned int)m_spill.getNumElements(),
                              d_diameter.data,
                              m_pdata->getN(),
                              m_cl->getPerDevice() ? d_cell_size_per_device.data : d_cell_size.data,
@@ -37,6 +37,12 @@ hipError_t gpu_compute_nlist_binned(unsigned int *d_nlist,
                                      const unsigned int *d_head_list,
                                      const Scalar4 *d_pos,
                                      const unsigned int *d_body,
+                                     const unsigned int *d_n_ex_idx,
+                                     const unsigned int *d_ex_list_idx,
+                                     const unsigned int *d_ex_head_idx,
+                                     uint2 *d_spill,
+                                     unsigned int *d_n_spill,
+                                     const unsigned int max_spill,
                                      const Scalar *d_diameter,
                                      const unsigned int N,
                                      const unsigned int *d_cell_size,
@@ -47,7 +47,9 @@ class PYBIND11_EXPORT NeighborListGPUBinned : public NeighborListGPU
             NeighborListGPU::notifyRCutMatrixChange();
             }
 
-        //! Set the autotuner period
+        //! Set a fixed kernel tuning parameter
+        /*! \param param cell_width_idx*100000000 + block_size*10000 + threads_per_particle, 0 to autotune
+        */
         void setTuningParam(unsigned int param)
             {
             m_param = param;
@@ -85,7 +87,15 @@ class PYBIND11_EXPORT NeighborListGPUBinned : public NeighborListGPU
         /// Track when the cell size needs to be updated
         bool m_update_cell_size = true;
 
-        std::unique_ptr<Autotuner> m_tuner;   //!< Autotuner for block size and threads per particle
+        /// Cell widths searched by the autotuner, in multiples of the largest r_list
+        /*! Wider cells hold more particles, which fills the groups of threads_per_particle threads that scan each
+            cell better at the cost of testing more particles.
+        */
+        static const unsigned int n_cell_width_factors = 3;
+        static const Scalar cell_width_factors[n_cell_width_factors];
+        unsigned int m_cell_width_idx = 0;  //!< Index of the current cell width factor
+
+        std::unique_ptr<Autotuner> m_tuner;   //!< Autotuner for cell width, block size and threads per particle
 
         //! Builds the neighbor list
         virtual void buildNlist(unsigned int timestep);
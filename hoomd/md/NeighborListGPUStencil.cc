@@ -50,6 +50,9 @@ NeighborListGPUStencil::NeighborListGPUStencil(std::shared_ptr<SystemDefinition>
     m_cl->setFlagIndex();
     m_cl->setComputeAdjList(false);
 
+    // excluded pairs are left out by the build kernel
+    m_build_applies_exclusions = true;
+
     CHECK_CUDA_ERROR();
 
     // initialize autotuner
@@ -237,6 +240,15 @@ void NeighborListGPUStencil::buildNlist(unsigned int timestep)
     ArrayHandle<Scalar> d_r_cut(m_r_cut, access_location::device, access_mode::read);
     ArrayHandle<Scalar> d_r_listsq(m_r_listsq, access_location::device, access_mode::read);
 
+    ArrayHandle<unsigned int> d_n_ex_idx(m_n_ex_idx, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_ex_head_idx(m_ex_head_idx, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_ex_list_idx(m_ex_list_idx, access_location::device, access_mode::read);
+
+    // keep the neighbors that do not fit, unless the build is deterministic and the neighbors are not sorted after it
+    resetSpill(!m_cl->getSortCellList() || m_sort_neighbors);
+    ArrayHandle<uint2> d_spill(m_spill, access_location::device, access_mode::overwrite);
+    ArrayHandle<unsigned int> d_n_spill(m_n_spill, access_location::device, access_mode::readwrite);
+
     if ((box.getPeriodic().x && nearest_plane_distance.x <= rmax * 2.0) ||
         (box.getPeriodic().y && nearest_plane_distance.y <= rmax * 2.0) ||
         (this->m_sysdef->getNDimensions() == 3 && box.getPeriodic().z && nearest_plane_distance.z <= rmax * 2.0))
@@ -265,6 +277,12 @@ void NeighborListGPUStencil::buildNlist(unsigned int timestep)
                               d_pid_map.data,
                               d_pos.data,
                               d_body.data,
+                              m_exclusions_set ? d_n_ex_idx.data : NULL,
+                              d_ex_list_idx.data,
+                              d_ex_head_idx.data,
+                              d_spill.data,
+                              m_build_spills ? d_n_spill.data : NULL,
+                              (unsigned int)m_spill.getNumElements(),
                               d_diameter.data,
                               m_pdata->getN(),
                               d_cell_size.data,
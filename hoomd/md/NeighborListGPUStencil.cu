@@ -25,6 +25,12 @@
     \param d_head_list List of indexes to access \a d_nlist
     \param d_pos Particle positions
     \param d_body Particle body indices
+    \param d_n_ex_idx Number of exclusions of each particle, NULL if there are none
+    \param d_ex_list_idx Excluded particles of each particle by index
+    \param d_ex_head_idx Start of the exclusions of each particle in \a d_ex_list_idx
+    \param d_spill Neighbors (particle, neighbor) that do not fit in the list
+    \param d_n_spill Number of neighbors that do not fit in the list, NULL to not keep them
+    \param max_spill Capacity of \a d_spill
     \param d_diameter Particle diameters
     \param N Number of particles
     \param d_cell_size Number of particles in each cell
@@ -53,6 +59,12 @@ __global__ void gpu_compute_nlist_stencil_kernel(unsigned int *d_nlist,
                                                  const unsigned int *d_pid_map,
                                                  const Scalar4 *d_pos,
                                                  const unsigned int *d_body,
+                                                 const unsigned int *d_n_ex_idx,
+                                                 const unsigned int *d_ex_list_idx,
+                                                 const unsigned int *d_ex_head_idx,
+                                                 uint2 *d_spill,
+                                                 unsigned int *d_n_spill,
+                                                 const unsigned int max_spill,
                                                  const Scalar *d_diameter,
                                                  const unsigned int N,
                                                  const unsigned int *d_cell_size,
@@ -115,6 +127,8 @@ __global__ void gpu_compute_nlist_stencil_kernel(unsigned int *d_nlist,
     unsigned int my_body = d_body[my_pidx];
     Scalar my_diam = d_diameter[my_pidx];
     unsigned int my_head = d_head_list[my_pidx];
+    unsigned int my_n_ex = d_n_ex_idx ? d_n_ex_idx[my_pidx] : 0;
+    const unsigned int *my_ex_list = d_ex_list_idx + (my_n_ex ? d_ex_head_idx[my_pidx] : 0);
 
     Scalar3 f = box.makeFraction(my_pos, ghost_width);
 
@@ -243,6 +257,12 @@ __global__ void gpu_compute_nlist_stencil_kernel(unsigned int *d_nlist,
 
                 if (dr_sq <= r_listsq)
                     {
+                    // test the exclusions only for the pairs in range
+                    bool excluded = false;
+                    for (unsigned int cur_ex = 0; cur_ex < my_n_ex && !excluded; ++cur_ex)
+                        excluded = (__ldg(my_ex_list + cur_ex) == cur_neigh);
+                    if (excluded) break;
+
                     neighbor = cur_neigh;
                     has_neighbor = 1;
                     }
@@ -261,9 +281,17 @@ __global__ void gpu_compute_nlist_stencil_kernel(unsigned int *d_nlist,
             unsigned char k(0), n(0);
             hoomd::detail::WarpScan<unsigned char, threads_per_particle>().ExclusiveSum(has_neighbor, k, n);
 
-            // write neighbor if it fits in list
+            // write neighbor if it fits in list, otherwise keep it for after the list has grown
             if (has_neighbor && (nneigh + k) < s_Nmax[my_type])
+                {
                 d_nlist[my_head + nneigh + k] = neighbor;
+                }
+            else if (has_neighbor && d_n_spill)
+                {
+                unsigned int spill_idx = atomicAdd(d_n_spill, 1);
+                if (spill_idx < max_spill)
+                    d_spill[spill_idx] = make_uint2(my_pidx, neighbor);
+                }
 
             // increment total neighbor count
             nneigh += n;
@@ -272,8 +300,8 @@ __global__ void gpu_compute_nlist_stencil_kernel(unsigned int *d_nlist,
 
     if (threadIdx.x % threads_per_particle == 0)
         {
-        // flag if we need to grow the neighbor list
-        if (nneigh >= s_Nmax[my_type])
+        // flag if we need to grow the neighbor list, or will soon
+        if (nneigh > s_Nmax[my_type] - (s_Nmax[my_type] >> 4))
             atomicMax(&d_conditions[my_type], nneigh);
 
         d_n_neigh[my_pidx] = nneigh;
@@ -305,6 +333,12 @@ inline void stencil_launcher(unsigned int *d_nlist,
                              const unsigned int *d_pid_map,
                              const Scalar4 *d_pos,
                              const unsigned int *d_body,
+                             const unsigned int *d_n_ex_idx,
+                             const unsigned int *d_ex_list_idx,
+                             const unsigned int *d_ex_head_idx,
+                             uint2 *d_spill,
+                             unsigned int *d_n_spill,
+                             const unsigned int max_spill,
                              const Scalar *d_diameter,
                              const unsigned int N,
                              const unsigned int *d_cell_size,
@@ -348,6 +382,12 @@ inline void stencil_launcher(unsigned int *d_nlist,
                                                                                              d_pid_map,
                                                                                              d_pos,
                                                                                              d_body,
+                                                                                             d_n_ex_idx,
+                                                                                             d_ex_list_idx,
+                                                                                             d_ex_head_idx,
+                                                                                             d_spill,
+                                                                                             d_n_spill,
+                                                                                             max_spill,
                                                                                              d_diameter,
                                                                                              N,
                                                                                              d_cell_size,
@@ -381,6 +421,12 @@ inline void stencil_launcher(unsigned int *d_nlist,
                                                                                              d_pid_map,
                                                                                              d_pos,
                                                                                              d_body,
+                                                                                             d_n_ex_idx,
+                                                                                             d_ex_list_idx,
+                                                                                             d_ex_head_idx,
+                                                                                             d_spill,
+                                                                                             d_n_spill,
+                                                                                             max_spill,
                                                                                              d_diameter,
                                                                                              N,
                                                                                              d_cell_size,
@@ -414,6 +460,12 @@ inline void stencil_launcher(unsigned int *d_nlist,
                                                                                              d_pid_map,
                                                                                              d_pos,
                                                                                              d_body,
+                                                                                             d_n_ex_idx,
+                                                                                             d_ex_list_idx,
+                                                                                             d_ex_head_idx,
+                                                                                             d_spill,
+                                                                                             d_n_spill,
+                                                                                             max_spill,
                                                                                              d_diameter,
                                                                                              N,
                                                                                              d_cell_size,
@@ -447,6 +499,12 @@ inline void stencil_launcher(unsigned int *d_nlist,
                                                                                              d_pid_map,
                                                                                              d_pos,
                                                                                              d_body,
+                                                                                             d_n_ex_idx,
+                                                                                             d_ex_list_idx,
+                                                                                             d_ex_head_idx,
+                                                                                             d_spill,
+                                                                                             d_n_spill,
+                                                                                             max_spill,
                                                                                              d_diameter,
                                                                                              N,
                                                                                              d_cell_size,
@@ -475,6 +533,12 @@ inline void stencil_launcher(unsigned int *d_nlist,
                                     d_pid_map,
                                     d_pos,
                                     d_body,
+                                    d_n_ex_idx,
+                                    d_ex_list_idx,
+                                    d_ex_head_idx,
+                                    d_spill,
+                                    d_n_spill,
+                                    max_spill,
                                     d_diameter,
                                     N,
                                     d_cell_size,
@@ -508,6 +572,12 @@ inline void stencil_launcher<min_threads_per_particle/2>(unsigned int *d_nlist,
                                                          const unsigned int *d_pid_map,
                                                          const Scalar4 *d_pos,
                                                          const unsigned int *d_body,
+                                                         const unsigned int *d_n_ex_idx,
+                                                         const unsigned int *d_ex_list_idx,
+                                                         const unsigned int *d_ex_head_idx,
+                                                         uint2 *d_spill,
+                                                         unsigned int *d_n_spill,
+                                                         const unsigned int max_spill,
                                                          const Scalar *d_diameter,
                                                          const unsigned int N,
                                                          const unsigned int *d_cell_size,
@@ -538,6 +608,12 @@ hipError_t gpu_compute_nlist_stencil(unsigned int *d_nlist,
                                       const unsigned int *d_pid_map,
                                       const Scalar4 *d_pos,
                                       const unsigned int *d_body,
+                                      const unsigned int *d_n_ex_idx,
+                                      const unsigned int *d_ex_list_idx,
+                                      const unsigned int *d_ex_head_idx,
+                                      uint2 *d_spill,
+                                      unsigned int *d_n_spill,
+                                      const unsigned int max_spill,
                                       const Scalar *d_diameter,
                                       const unsigned int N,
                                       const unsigned int *d_cell_size,
@@ -567,6 +643,12 @@ hipError_t gpu_compute_nlist_stencil(unsigned int *d_nlist,
                                                d_pid_map,
                                                d_pos,
                                                d_body,
+                                               d_n_ex_idx,
+                                               d_ex_list_idx,
+                                               d_ex_head_idx,
+                                               d_spill,
+                                               d_n_spill,
+                                               max_spill,
                                                d_diameter,
                                                N,
                                                d_cell_size,
@@ -40,6 +40,9 @@ NeighborListGPUTree::NeighborListGPUTree(std::shared_ptr<SystemDefinition> sysde
     m_mark_tuner.reset(new Autotuner(warp_size, max_threads, warp_size, 5, 100000, "nlist_tree_mark", m_exec_conf));
     m_count_tuner.reset(new Autotuner(warp_size, max_threads, warp_size, 5, 100000, "nlist_tree_count", m_exec_conf));
     m_copy_tuner.reset(new Autotuner(warp_size, max_threads, warp_size, 5, 100000, "nlist_tree_copy", m_exec_conf));
+
+    // excluded pairs are left out by the traversal
+    m_build_applies_exclusions = true;
     }
 
 /*!
@@ -422,6 +425,9 @@ void NeighborListGPUTree::traverseTree()
     ArrayHandle<Scalar> d_diam(m_pdata->getDiameters(), access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_traverse_order(m_traverse_order, access_location::device, access_mode::read);
     ArrayHandle<Scalar3> d_image_list(m_image_list, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_n_ex_idx(m_n_ex_idx, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_ex_head_idx(m_ex_head_idx, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_ex_list_idx(m_ex_list_idx, access_location::device, access_mode::read);
 
     ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::read);
@@ -482,6 +488,9 @@ void NeighborListGPUTree::traverseTree()
             args.rcut = rcut;
             args.rlist = rlist;
             args.box = box;
+            args.n_ex_idx = (m_exclusions_set) ? d_n_ex_idx.data : NULL;
+            args.ex_list_idx = d_ex_list_idx.data;
+            args.ex_head_idx = d_ex_head_idx.data;
 
             // neighbor list write op for this type
             args.neigh_list = d_nlist.data;
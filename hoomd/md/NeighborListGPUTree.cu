@@ -451,6 +451,10 @@ struct ParticleQueryOp
      * \param Nown_ Number of locally owned particles.
      * \param rcut_ Cutoff radius for the spheres.
      * \param rlist_ Total search radius for the spheres (differs under shifting).
+     * \param box_ Simulation box.
+     * \param n_ex_idx_ Number of exclusions per particle (NULL if there are none).
+     * \param ex_list_idx_ Excluded particles of each particle by index.
+     * \param ex_head_idx_ Start of the exclusions of each particle in \a ex_list_idx_.
      */
     ParticleQueryOp(const Scalar4 *positions_,
                     const unsigned int *bodies_,
@@ -460,9 +464,13 @@ struct ParticleQueryOp
                     unsigned int Nown_,
                     const Scalar rcut_,
                     const Scalar rlist_,
-                    const BoxDim& box_)
+                    const BoxDim& box_,
+                    const unsigned int *n_ex_idx_,
+                    const unsigned int *ex_list_idx_,
+                    const unsigned int *ex_head_idx_)
         : positions(positions_), bodies(bodies_), diams(diams_), map(map_),
-          N(N_), Nown(Nown_), rcut(rcut_), rlist(rlist_), box(box_)
+          N(N_), Nown(Nown_), rcut(rcut_), rlist(rlist_), box(box_),
+          n_ex_idx(n_ex_idx_), ex_list_idx(ex_list_idx_), ex_head_idx(ex_head_idx_)
           {}
 
     //! Data stored per thread for traversal
@@ -476,14 +484,18 @@ struct ParticleQueryOp
         DEVICE ThreadData(Scalar3 position_,
                               int idx_,
                               unsigned int body_,
-                              Scalar diam_)
-            : position(position_), idx(idx_), body(body_), diam(diam_)
+                              Scalar diam_,
+                              unsigned int n_ex_,
+                              unsigned int ex_head_)
+            : position(position_), idx(idx_), body(body_), diam(diam_), n_ex(n_ex_), ex_head(ex_head_)
             {}
 
         Scalar3 position;   //!< Particle position
         int idx;            //!< True particle index
         unsigned int body;  //!< Particle body tag (may be invalid)
         Scalar diam;        //!< Particle diameter (may be invalid)
+        unsigned int n_ex;  //!< Number of exclusions of the particle
+        unsigned int ex_head; //!< Start of the exclusions of the particle
         };
 
     // specify that the traversal Volume is a bounding sphere
@@ -515,8 +527,10 @@ struct ParticleQueryOp
             {
             diam = __ldg(diams + pidx);
             }
+        const unsigned int n_ex = (n_ex_idx != NULL) ? __ldg(n_ex_idx + pidx) : 0;
+        const unsigned int ex_head = (n_ex > 0) ? __ldg(ex_head_idx + pidx) : 0;
 
-        return ThreadData(r, pidx, body, diam);
+        return ThreadData(r, pidx, body, diam, n_ex, ex_head);
         }
 
     //! Return the traversal volume subject to a translation
@@ -556,7 +570,8 @@ struct ParticleQueryOp
      * that the overlap is not with itself. If body filtering is enabled,
      * particles in the same body do not overlap. If diameter shifting is
      * enabled, the cutoff radius is adjusted based on the diameters of the
-     * particles.
+     * particles. Finally, the exclusions of the particle are tested, so that
+     * only the pairs in range pay for the search.
      */
     DEVICE bool refine(const ThreadData& q, const int primitive) const
         {
@@ -589,6 +604,12 @@ struct ParticleQueryOp
             exclude |= drsq > rc2;
             }
 
+        // topological exclusions
+        for (unsigned int cur_ex = 0; cur_ex < q.n_ex && !exclude; ++cur_ex)
+            {
+            exclude = (__ldg(ex_list_idx + q.ex_head + cur_ex) == (unsigned int)primitive);
+            }
+
         return !exclude;
         }
 
@@ -607,6 +628,9 @@ struct ParticleQueryOp
     Scalar rcut;                //!< True cutoff radius + buffer
     Scalar rlist;               //!< Maximum cutoff (may include shifting)
     const BoxDim box;           //!< Box dimensions
+    const unsigned int *n_ex_idx;       //!< Number of exclusions per particle
+    const unsigned int *ex_list_idx;    //!< Excluded particles by index
+    const unsigned int *ex_head_idx;    //!< Start of the exclusions of each particle
     };
 
 
@@ -740,18 +764,19 @@ struct NeighborListOp
      * \param t My output thread data
      *
      * The number of neighbors found for this thread is written. If this value
-     * exceeds the current allocation, this value is atomically maximized for
-     * reallocation. Any values remaining on the stack are written to ensure the
+     * exceeds the current allocation, or comes within 1/16 of it, this value is
+     * atomically maximized for reallocation. Any values remaining on the stack are written to ensure the
      * list is complete.
      */
     DEVICE void finalize(const ThreadData& t) const
         {
         nneigh[t.idx] = t.num_neigh;
-        if (t.num_neigh > max_neigh)
+        if (t.num_neigh > max_neigh - (max_neigh >> 4))
             {
+            // flag overflows, and counts within 1/16 of the allocation so that it grows before the next build
             atomicMax(new_max_neigh, t.num_neigh);
             }
-        else if (t.num_neigh % 4 != 0)
+        if (t.num_neigh <= max_neigh && t.num_neigh % 4 != 0)
             {
             // write partial (leftover) stack, counting is now post-increment so need to shift by 1
             // only need to do this if didn't overflow, since all neighbors were already written due to alignment of max
@@ -930,7 +955,10 @@ void LBVHTraverserWrapper::traverse(TraverserArgs& args,
                                            args.Nown,
                                            args.rcut,
                                            args.rlist,
-                                           args.box);
+                                           args.box,
+                                           args.n_ex_idx,
+                                           args.ex_list_idx,
+                                           args.ex_head_idx);
         trav_->traverse(neighbor::LBVHTraverser::LaunchParameters(block_size,stream), lbvh, query, nlist_op, translate, map);
         }
     else if (args.bodies != NULL && args.diams == NULL)
@@ -943,7 +971,10 @@ void LBVHTraverserWrapper::traverse(TraverserArgs& args,
                                           args.Nown,
                                           args.rcut,
                                           args.rlist,
-                                          args.box);
+                                          args.box,
+                                          args.n_ex_idx,
+                                          args.ex_list_idx,
+                                          args.ex_head_idx);
         trav_->traverse(neighbor::LBVHTraverser::LaunchParameters(block_size,stream), lbvh, query, nlist_op, translate, map);
         }
     else if (args.bodies == NULL && args.diams != NULL)
@@ -956,7 +987,10 @@ void LBVHTraverserWrapper::traverse(TraverserArgs& args,
                                           args.Nown,
                                           args.rcut,
                                           args.rlist,
-                                          args.box);
+                                          args.box,
+                                          args.n_ex_idx,
+                                          args.ex_list_idx,
+                                          args.ex_head_idx);
         trav_->traverse(neighbor::LBVHTraverser::LaunchParameters(block_size,stream), lbvh, query, nlist_op, translate, map);
         }
     else
@@ -969,7 +1003,10 @@ void LBVHTraverserWrapper::traverse(TraverserArgs& args,
                                          args.Nown,
                                          args.rcut,
                                          args.rlist,
-                                         args.box);
+                                         args.box,
+                                         args.n_ex_idx,
+                                         args.ex_list_idx,
+                                         args.ex_head_idx);
         trav_->traverse(neighbor::LBVHTraverser::LaunchParameters(block_size,stream), lbvh, query, nlist_op, translate, map);
         }
     }
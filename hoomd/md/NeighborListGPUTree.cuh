@@ -134,6 +134,9 @@ class LBVHTraverserWrapper
             Scalar rcut;
             Scalar rlist;
             BoxDim box;
+            unsigned int* n_ex_idx;
+            unsigned int* ex_list_idx;
+            unsigned int* ex_head_idx;
 
             // neighbor list
             unsigned int* neigh_list;
@@ -51,6 +51,9 @@ NeighborListStencil::NeighborListStencil(std::shared_ptr<SystemDefinition> sysde
     // cell sizes need update by default
     m_update_cell_size = true;
     m_needs_restencil = true;
+
+    // excluded pairs are left out by buildNlist()
+    m_build_applies_exclusions = true;
     }
 
 NeighborListStencil::~NeighborListStencil()
@@ -114,6 +117,11 @@ void NeighborListStencil::buildNlist(unsigned int timestep)
     ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
 
+    // access the exclusions by index
+    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_head_idx(m_ex_head_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx, access_location::host, access_mode::read);
+
     const BoxDim& box = m_pdata->getBox();
     Scalar3 nearest_plane_distance = box.getNearestPlaneDistance();
 
@@ -173,6 +181,8 @@ void NeighborListStencil::buildNlist(unsigned int timestep)
         const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
         const unsigned int body_i = h_body.data[i];
         const Scalar diam_i = h_diameter.data[i];
+        const unsigned int n_ex_i = m_exclusions_set ? h_n_ex_idx.data[i] : 0;
+        const unsigned int ex_head_i = h_ex_head_idx.data[i];
 
         const unsigned int Nmax_i = h_Nmax.data[type_i];
         const unsigned int head_idx_i = h_head_list.data[i];
@@ -289,6 +299,12 @@ void NeighborListStencil::buildNlist(unsigned int timestep)
 
                 if (dr_sq <= r_listsq)
                     {
+                    // test the exclusions only for the pairs in range
+                    bool excluded = false;
+                    for (unsigned int cur_ex = 0; cur_ex < n_ex_i && !excluded; cur_ex++)
+                        excluded = (h_ex_list_idx.data[ex_head_i + cur_ex] == cur_neigh);
+                    if (excluded) continue;
+
                     if (m_storage_mode == full || i < (int)cur_neigh)
                         {
                         // local neighbor
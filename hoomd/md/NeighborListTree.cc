@@ -17,6 +17,11 @@ namespace py = pybind11;
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 using namespace std;
 using namespace hpmc::detail;
 
@@ -32,6 +37,9 @@ NeighborListTree::NeighborListTree(std::shared_ptr<SystemDefinition> sysdef,
     m_pdata->getBoxChangeSignal().connect<NeighborListTree, &NeighborListTree::slotBoxChanged>(this);
     m_pdata->getMaxParticleNumberChangeSignal().connect<NeighborListTree, &NeighborListTree::slotMaxNumChanged>(this);
     m_pdata->getParticleSortSignal().connect<NeighborListTree, &NeighborListTree::slotRemapParticles>(this);
+
+    // excluded pairs are left out by buildNlist()
+    m_build_applies_exclusions = true;
     }
 
 NeighborListTree::~NeighborListTree()
@@ -189,7 +197,9 @@ void NeighborListTree::updateImageVectors()
     }
 
 /*!
- * \note AABBTree implements its own build routine, so this is a wrapper to call this for multiple tree types.
+ * \note AABBTree implements its own build routine, so this is a wrapper to call this for multiple tree types. The
+ * trees are built as linear BVHs with AABBTree::buildTreeMorton(), which sorts the particles along a Morton curve and
+ * runs in parallel with TBB.
  */
 void NeighborListTree::buildTree()
     {
@@ -245,7 +255,7 @@ void NeighborListTree::buildTree()
         {
         if (m_num_per_type[i] > 0)
             {
-            m_aabb_trees[i].buildTree(&(h_aabbs.data[0]) + m_type_head[i], m_num_per_type[i]);
+            m_aabb_trees[i].buildTreeMorton(&(h_aabbs.data[0]) + m_type_head[i], m_num_per_type[i]);
             }
         }
     if (this->m_prof) this->m_prof->pop();
@@ -255,7 +265,10 @@ void NeighborListTree::buildTree()
  * Each AABBTree is traversed in a stackless fashion. One traversal is performed (per particle)-(per tree)-(per image).
  * The stackless traversal is a variation on left descent, where each node knows how far ahead to advance in the list
  * of nodes if there is no intersection between the current node AABB and the query AABB. Otherwise, the search advances
- * by one to the next node in the list.
+ * by one to the next node in the list. The search is AABBTree::traverse(), which HPMC's queries use as well.
+ *
+ * Every particle writes only its own section of the neighbor list, so particles are processed in parallel with TBB.
+ * Overflows are recorded in a serial pass afterwards.
  */
 void NeighborListTree::traverseTree()
     {
@@ -268,6 +281,11 @@ void NeighborListTree::traverseTree()
 
     ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
 
+    // exclusions by index
+    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_head_idx(m_ex_head_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx, access_location::host, access_mode::read);
+
     // neighborlist data
     ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::read);
@@ -275,8 +293,8 @@ void NeighborListTree::traverseTree()
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
 
-    // Loop over all particles
-    for (unsigned int i=0; i < m_pdata->getN(); ++i)
+    // find the neighbors of particle i
+    auto traverse_particle = [&](unsigned int i)
         {
         // read in the current position and orientation
         const Scalar4 postype_i = h_postype.data[i];
@@ -284,6 +302,8 @@ void NeighborListTree::traverseTree()
         const unsigned int type_i = __scalar_as_int(postype_i.w);
         const unsigned int body_i = h_body.data[i];
         const Scalar diam_i = h_diameter.data[i];
+        const unsigned int n_ex_i = m_exclusions_set ? h_n_ex_idx.data[i] : 0;
+        const unsigned int ex_head_i = h_ex_head_idx.data[i];
 
         const unsigned int Nmax_i = h_Nmax.data[type_i];
         const unsigned int nlist_head_i = h_head_list.data[i];
@@ -311,7 +331,7 @@ void NeighborListTree::traverseTree()
             if (m_diameter_shift)
                 r_list_i += m_d_max - Scalar(1.0);
 
-            AABBTree *cur_aabb_tree = &m_aabb_trees[cur_pair_type];
+            const AABBTree& cur_aabb_tree = m_aabb_trees[cur_pair_type];
 
             for (unsigned int cur_image = 0; cur_image < m_n_images; ++cur_image) // for each image vector
                 {
@@ -320,68 +340,85 @@ void NeighborListTree::traverseTree()
                 AABB aabb = AABB(pos_i_image, r_list_i);
 
                 // stackless traversal of the tree
-                for (unsigned int cur_node_idx = 0; cur_node_idx < cur_aabb_tree->getNumNodes(); ++cur_node_idx)
+                cur_aabb_tree.traverse(aabb, [&](const AABBNode& node)
                     {
-                    if (overlap(cur_aabb_tree->getNodeAABB(cur_node_idx), aabb))
+                    for (unsigned int cur_p = 0; cur_p < node.num_particles; ++cur_p)
                         {
-                        if (cur_aabb_tree->isNodeLeaf(cur_node_idx))
+                        // neighbor j
+                        unsigned int j = node.particle_tags[cur_p];
+
+                        // skip self-interaction always
+                        bool excluded = (i == j);
+
+                        if (m_filter_body && body_i != NO_BODY)
+                            excluded = excluded | (body_i == h_body.data[j]);
+
+                        if (!excluded)
                             {
-                            for (unsigned int cur_p = 0; cur_p < cur_aabb_tree->getNodeNumParticles(cur_node_idx); ++cur_p)
+                            // now we can trim down the actual particles based on diameter
+                            // compute the shift for the cutoff if not excluded
+                            Scalar sqshift = Scalar(0.0);
+                            if (m_diameter_shift)
                                 {
-                                // neighbor j
-                                unsigned int j = cur_aabb_tree->getNodeParticleTag(cur_node_idx, cur_p);
+                                const Scalar delta = (diam_i + h_diameter.data[j]) * Scalar(0.5) - Scalar(1.0);
+                                // r^2 < (r_list + delta)^2
+                                // r^2 < r_listsq + delta^2 + 2*r_list*delta
+                                sqshift = (delta + Scalar(2.0) * r_cut_i) * delta;
+                                }
 
-                                // skip self-interaction always
-                                bool excluded = (i == j);
+                            // compute distance
+                            Scalar4 postype_j = h_postype.data[j];
+                            Scalar3 drij = make_scalar3(postype_j.x,postype_j.y,postype_j.z)
+                                           - vec_to_scalar3(pos_i_image);
+                            Scalar dr_sq = dot(drij,drij);
 
-                                if (m_filter_body && body_i != NO_BODY)
-                                    excluded = excluded | (body_i == h_body.data[j]);
+                            if (dr_sq <= (r_cutsq_i + sqshift))
+                                {
+                                // test the exclusions only for the pairs in range
+                                for (unsigned int cur_ex = 0; cur_ex < n_ex_i && !excluded; ++cur_ex)
+                                    excluded = (h_ex_list_idx.data[ex_head_i + cur_ex] == j);
 
-                                if (!excluded)
+                                if (!excluded && (m_storage_mode == full || i < j))
                                     {
-                                    // now we can trim down the actual particles based on diameter
-                                    // compute the shift for the cutoff if not excluded
-                                    Scalar sqshift = Scalar(0.0);
-                                    if (m_diameter_shift)
-                                        {
-                                        const Scalar delta = (diam_i + h_diameter.data[j]) * Scalar(0.5) - Scalar(1.0);
-                                        // r^2 < (r_list + delta)^2
-                                        // r^2 < r_listsq + delta^2 + 2*r_list*delta
-                                        sqshift = (delta + Scalar(2.0) * r_cut_i) * delta;
-                                        }
-
-                                    // compute distance
-                                    Scalar4 postype_j = h_postype.data[j];
-                                    Scalar3 drij = make_scalar3(postype_j.x,postype_j.y,postype_j.z)
-                                                   - vec_to_scalar3(pos_i_image);
-                                    Scalar dr_sq = dot(drij,drij);
-
-                                    if (dr_sq <= (r_cutsq_i + sqshift))
-                                        {
-                                        if (m_storage_mode == full || i < j)
-                                            {
-                                            if (n_neigh_i < Nmax_i)
-                                                h_nlist.data[nlist_head_i + n_neigh_i] = j;
-                                            else
-                                                h_conditions.data[type_i] = max(h_conditions.data[type_i], n_neigh_i+1);
-
-                                            ++n_neigh_i;
-                                            }
-                                        }
+                                    if (n_neigh_i < Nmax_i)
+                                        h_nlist.data[nlist_head_i + n_neigh_i] = j;
+
+                                    ++n_neigh_i;
                                     }
                                 }
                             }
                         }
-                    else
-                        {
-                        // skip ahead
-                        cur_node_idx += cur_aabb_tree->getNodeSkip(cur_node_idx);
-                        }
-                    } // end stackless search
+                    }); // end stackless search
                 } // end loop over images
             } // end loop over pair types
-            h_n_neigh.data[i] = n_neigh_i;
-        } // end loop over particles
+        h_n_neigh.data[i] = n_neigh_i;
+        };
+
+    // Loop over all particles
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, m_pdata->getN()),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                traverse_particle(i);
+            });
+        }
+    else
+    #endif
+        {
+        for (unsigned int i=0; i < m_pdata->getN(); ++i)
+            traverse_particle(i);
+        }
+
+    // record the particles that did not fit into their section of the list
+    for (unsigned int i=0; i < m_pdata->getN(); ++i)
+        {
+        const unsigned int type_i = __scalar_as_int(h_postype.data[i].w);
+        if (h_n_neigh.data[i] > h_Nmax.data[type_i])
+            h_conditions.data[type_i] = max(h_conditions.data[type_i], h_n_neigh.data[i]);
+        }
 
     if (this->m_prof) this->m_prof->pop();
     }
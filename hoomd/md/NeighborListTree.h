@@ -25,7 +25,8 @@
 /*!
  * A bounding volume hierarchy (BVH) tree is a binary search tree. It is constructed from axis-aligned bounding boxes
  * (AABBs). The AABB for a node in the tree encloses all child AABBs. A leaf AABB holds multiple particles. The tree
- * is constructed in a balanced way using a heuristic to minimize AABB volume. We build one tree per particle type,
+ * is constructed as a linear BVH by sorting the particles along a Morton curve, the same design as the LBVH used by
+ * NeighborListGPUTree. The build and the traversal run in parallel with TBB. We build one tree per particle type,
  * and use point AABBs for the particles. The neighbor list is built by traversing down the tree with an AABB
  * that encloses the pairwise cutoff for the particle. Periodic boundaries are treated by translating the query AABB
  * by all possible image vectors, many of which are trivially rejected for not intersecting the root node.
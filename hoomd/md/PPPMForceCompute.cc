@@ -2,6 +2,8 @@
 // This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
 
 #include "PPPMForceCompute.h"
+#include <algorithm>
+#include <cstdlib>
 #include <map>
 
 namespace py = pybind11;
@@ -43,6 +45,8 @@ PPPMForceCompute::PPPMForceCompute(std::shared_ptr<SystemDefinition> sysdef,
       m_q(0.0),
       m_q2(0.0),
       m_body_energy(0.0),
+      m_slab_correction(false),
+      m_slab_energy(0.0),
       m_ptls_added_removed(false),
       m_kiss_fft_initialized(false),
       m_dfft_initialized(false)
@@ -62,6 +66,10 @@ PPPMForceCompute::PPPMForceCompute(std::shared_ptr<SystemDefinition> sysdef,
     m_order = 0;
     m_alpha = Scalar(0.0);
 
+    #ifdef ENABLE_FFTW
+    m_fftw_initialized = false;
+    #endif
+
     m_pdata->getGlobalParticleNumberChangeSignal().connect<PPPMForceCompute, &PPPMForceCompute::slotGlobalParticleNumberChange>(this);
     }
 
@@ -151,6 +159,9 @@ PPPMForceCompute::~PPPMForceCompute()
         free(m_kiss_ifft);
         kiss_fft_cleanup();
         }
+    #ifdef ENABLE_FFTW
+    destroyFFTW();
+    #endif
     #ifdef ENABLE_MPI
     if (m_dfft_initialized)
         {
@@ -244,7 +255,7 @@ void PPPMForceCompute::compute_rho_coeff()
     }
 
 
-Scalar PPPMForceCompute::rms(Scalar h, Scalar prd, Scalar natoms)
+Scalar PPPMForceCompute::rms(Scalar h, Scalar prd, Scalar natoms, unsigned int order, Scalar kappa, Scalar q2)
     {
     // I don't know where this formula comes from
     int m;
@@ -280,13 +291,39 @@ Scalar PPPMForceCompute::rms(Scalar h, Scalar prd, Scalar natoms)
     acons[7][5] = 1755948832039.0 / 36229939200000.0;
     acons[7][6] = 4887769399.0 / 37838389248.0;
 
-    for (m = 0; m < m_order; m++)
-        sum += acons[m_order][m] * pow(h*m_kappa,Scalar(2.0)*(Scalar)m);
-    Scalar value = m_q2 * pow(h*m_kappa,(Scalar)m_order) *
-        sqrt(m_kappa*prd*sqrt(2.0*M_PI)*sum/natoms) / (prd*prd);
+    for (m = 0; m < (int)order; m++)
+        sum += acons[order][m] * pow(h*kappa,Scalar(2.0)*(Scalar)m);
+    Scalar value = q2 * pow(h*kappa,(Scalar)order) *
+        sqrt(kappa*prd*sqrt(2.0*M_PI)*sum/natoms) / (prd*prd);
     return value;
     }
 
+/*! \param global_dim Global number of mesh points along each direction
+    \param order Interpolation order
+    \param kappa Splitting parameter
+    \param rcut Cutoff of the short-ranged part
+    \param q2 Sum of the squared charges
+    \param kspace_error Output, estimated RMS force error of the mesh part
+    \param real_error Output, estimated RMS force error of the short-ranged part
+
+    NOTE: this is for an orthorhombic box, need to generalize to triclinic
+*/
+void PPPMForceCompute::estimateError(uint3 global_dim, unsigned int order, Scalar kappa, Scalar rcut, Scalar q2,
+                                     Scalar& kspace_error, Scalar& real_error)
+    {
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    Scalar3 L = global_box.getL();
+    Scalar N = (Scalar)m_pdata->getNGlobal();
+    Scalar hx =  L.x/(Scalar)global_dim.x;
+    Scalar hy =  L.y/(Scalar)global_dim.y;
+    Scalar hz =  L.z/(Scalar)global_dim.z;
+    Scalar lprx = rms(hx, L.x, N, order, kappa, q2);
+    Scalar lpry = rms(hy, L.y, N, order, kappa, q2);
+    Scalar lprz = rms(hz, L.z, N, order, kappa, q2);
+    kspace_error = sqrt(lprx*lprx + lpry*lpry + lprz*lprz) / sqrt(3.0);
+    real_error = 2.0*q2*exp(-kappa*kappa*rcut*rcut) / sqrt(N*rcut*L.x*L.y*L.z);
+    }
+
 void PPPMForceCompute::setupCoeffs()
     {
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
@@ -328,19 +365,15 @@ void PPPMForceCompute::setupCoeffs()
         m_exec_conf->msg->warning() << "charge.pppm: system is not neutral and unscreened interactions are calculated, the net charge is " << m_q << std::endl;
         }
 
+    if (m_slab_correction && m_alpha != Scalar(0.0))
+        {
+        m_exec_conf->msg->warning() << "charge.pppm: the slab correction assumes unscreened interactions, "
+            << "it is not exact for alpha = " << m_alpha << std::endl;
+        }
+
     // compute RMS force error
-    // NOTE: this is for an orthorhombic box, need to generalize to triclinic
-    // but I don't know where this formula comes from
-    const BoxDim& global_box = m_pdata->getGlobalBox();
-    Scalar3 L = global_box.getL();
-    Scalar hx =  L.x/(Scalar)m_global_dim.x;
-    Scalar hy =  L.y/(Scalar)m_global_dim.y;
-    Scalar hz =  L.z/(Scalar)m_global_dim.z;
-    Scalar lprx = PPPMForceCompute::rms(hx, L.x, (int)m_pdata->getNGlobal());
-    Scalar lpry = PPPMForceCompute::rms(hy, L.y, (int)m_pdata->getNGlobal());
-    Scalar lprz = PPPMForceCompute::rms(hz, L.z, (int)m_pdata->getNGlobal());
-    Scalar lpr = sqrt(lprx*lprx + lpry*lpry + lprz*lprz) / sqrt(3.0);
-    Scalar spr = 2.0*m_q2*exp(-m_kappa*m_kappa*m_rcut*m_rcut) / sqrt((int)m_pdata->getNGlobal()*m_rcut*L.x*L.y*L.z);
+    Scalar lpr, spr;
+    estimateError(m_global_dim, m_order, m_kappa, m_rcut, m_q2, lpr, spr);
 
     double RMS_error = std::max(lpr,spr);
     if(RMS_error > 0.1) {
@@ -429,6 +462,22 @@ void PPPMForceCompute::initializeFFT()
     {
     bool local_fft = true;
 
+    // release the transforms of the previous parameters, setParams() may be called during a run
+    if (m_kiss_fft_initialized)
+        {
+        free(m_kiss_fft);
+        free(m_kiss_ifft);
+        m_kiss_fft_initialized = false;
+        }
+    #ifdef ENABLE_MPI
+    if (m_dfft_initialized)
+        {
+        dfft_destroy_plan(m_dfft_plan_forward);
+        dfft_destroy_plan(m_dfft_plan_inverse);
+        m_dfft_initialized = false;
+        }
+    #endif
+
     #ifdef ENABLE_MPI
     local_fft = !m_pdata->getDomainDecomposition();
 
@@ -479,6 +528,7 @@ void PPPMForceCompute::initializeFFT()
         }
     #endif // ENABLE_MPI
 
+    #ifndef ENABLE_FFTW
     if (local_fft)
         {
         int dims[3];
@@ -491,6 +541,7 @@ void PPPMForceCompute::initializeFFT()
 
         m_kiss_fft_initialized = true;
         }
+    #endif
 
     // allocate mesh and transformed mesh
 
@@ -520,8 +571,69 @@ void PPPMForceCompute::initializeFFT()
 
     GlobalArray<kiss_fft_cpx> inv_fourier_mesh_z(m_n_cells+m_ghost_offset, m_exec_conf);
     m_inv_fourier_mesh_z.swap(inv_fourier_mesh_z);
+
+    #ifdef ENABLE_FFTW
+    // FFTW plans on the actual arrays, so the meshes must be allocated first
+    if (local_fft)
+        initializeFFTW();
+    #endif
     }
 
+#ifdef ENABLE_FFTW
+void PPPMForceCompute::initializeFFTW()
+    {
+    // initializeFFT() runs again whenever the mesh changes
+    destroyFFTW();
+
+    static bool fftw_threads_initialized = false;
+    if (! fftw_threads_initialized)
+        {
+        if (! fftwf_init_threads())
+            throw std::runtime_error("Error initializing FFTW threads");
+        fftw_threads_initialized = true;
+        }
+
+    // getNumThreads() is 0 without TBB
+    fftwf_plan_with_nthreads(std::max(1, int(m_exec_conf->getNumThreads())));
+
+    // reuse plans measured by a previous run
+    const char *wisdom_file = getenv("HOOMD_FFTW_WISDOM");
+    if (wisdom_file)
+        fftwf_import_wisdom_from_filename(wisdom_file);
+
+    // kiss_fft_cpx and fftwf_complex are both an interleaved pair of floats
+    ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::overwrite);
+    ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh, access_location::host, access_mode::overwrite);
+    ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_x(m_fourier_mesh_G_x, access_location::host, access_mode::overwrite);
+    ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x, access_location::host, access_mode::overwrite);
+
+    // FFTW_MEASURE overwrites the arrays, which are filled later in every step
+    m_fftw_plan_forward = fftwf_plan_dft_3d(m_mesh_points.z, m_mesh_points.y, m_mesh_points.x,
+        (fftwf_complex *)h_mesh.data, (fftwf_complex *)h_fourier_mesh.data, FFTW_FORWARD, FFTW_MEASURE);
+    m_fftw_plan_inverse = fftwf_plan_dft_3d(m_mesh_points.z, m_mesh_points.y, m_mesh_points.x,
+        (fftwf_complex *)h_fourier_mesh_G_x.data, (fftwf_complex *)h_inv_fourier_mesh_x.data, FFTW_BACKWARD,
+        FFTW_MEASURE);
+
+    if (! m_fftw_plan_forward || ! m_fftw_plan_inverse)
+        throw std::runtime_error("Error planning FFTW transforms");
+
+    m_fftw_initialized = true;
+
+    if (wisdom_file && m_exec_conf->isRoot())
+        fftwf_export_wisdom_to_filename(wisdom_file);
+    }
+
+void PPPMForceCompute::destroyFFTW()
+    {
+    if (m_fftw_initialized)
+        {
+        fftwf_destroy_plan(m_fftw_plan_forward);
+        fftwf_destroy_plan(m_fftw_plan_inverse);
+        m_fftw_initialized = false;
+        }
+    }
+#endif
+
 //! CPU implementation of sinc(x)==sin(x)/x
 inline Scalar sinc(Scalar x)
     {
@@ -569,6 +681,9 @@ void PPPMForceCompute::computeInfluenceFunction()
 
     #ifdef ENABLE_MPI
     bool local_fft = m_kiss_fft_initialized;
+    #ifdef ENABLE_FFTW
+    local_fft = m_fftw_initialized;
+    #endif
 
     uint3 pdim=make_uint3(0,0,0);
     uint3 pidx=make_uint3(0,0,0);
@@ -881,6 +996,19 @@ void PPPMForceCompute::updateMeshes()
         if (m_prof) m_prof->pop();
         }
 
+    #ifdef ENABLE_FFTW
+    if (m_fftw_initialized)
+        {
+        if (m_prof) m_prof->push("FFT");
+        // transform the particle mesh locally (forward transform)
+        ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::read);
+        ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh, access_location::host, access_mode::overwrite);
+
+        fftwf_execute_dft(m_fftw_plan_forward, (fftwf_complex *)h_mesh.data, (fftwf_complex *)h_fourier_mesh.data);
+        if (m_prof) m_prof->pop();
+        }
+    #endif
+
     #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
@@ -952,6 +1080,27 @@ void PPPMForceCompute::updateMeshes()
         if (m_prof) m_prof->pop();
         }
 
+    #ifdef ENABLE_FFTW
+    if (m_fftw_initialized)
+        {
+        if (m_prof) m_prof->push("FFT");
+        // do a local inverse transform of the force mesh, reusing the plan on new arrays of the same alignment
+        ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_x(m_fourier_mesh_G_x, access_location::host, access_mode::read);
+        ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_y(m_fourier_mesh_G_y, access_location::host, access_mode::read);
+        ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_z(m_fourier_mesh_G_z, access_location::host, access_mode::read);
+        ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x, access_location::host, access_mode::overwrite);
+        ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_y(m_inv_fourier_mesh_y, access_location::host, access_mode::overwrite);
+        ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z, access_location::host, access_mode::overwrite);
+        fftwf_execute_dft(m_fftw_plan_inverse,
+            (fftwf_complex *)h_fourier_mesh_G_x.data, (fftwf_complex *)h_inv_fourier_mesh_x.data);
+        fftwf_execute_dft(m_fftw_plan_inverse,
+            (fftwf_complex *)h_fourier_mesh_G_y.data, (fftwf_complex *)h_inv_fourier_mesh_y.data);
+        fftwf_execute_dft(m_fftw_plan_inverse,
+            (fftwf_complex *)h_fourier_mesh_G_z.data, (fftwf_complex *)h_inv_fourier_mesh_z.data);
+        if (m_prof) m_prof->pop();
+        }
+    #endif
+
     #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
@@ -1211,6 +1360,10 @@ Scalar PPPMForceCompute::computePE()
     // apply rigid body correction
     sum += m_body_energy;
 
+    // the slab correction is a global quantity, count it once
+    if (m_slab_correction && m_exec_conf->getRank()==0)
+        sum += m_slab_energy;
+
     // store this rank's contribution as external potential energy
     m_external_energy = sum;
 
@@ -1231,6 +1384,18 @@ Scalar PPPMForceCompute::computePE()
     }
 
 void PPPMForceCompute::computeForces(unsigned int timestep)
+    {
+    computeInteriorForces(timestep);
+    computeBoundaryForces(timestep);
+    }
+
+/*! \param timestep The current time step
+    \returns true, the mesh forces are always computed
+
+    The charges of the local particles are assigned to the mesh, and the ghost cells of the mesh are communicated
+    separately, so this part does not need the ghost particles.
+*/
+bool PPPMForceCompute::computeInteriorForces(unsigned int timestep)
     {
     if (m_prof) m_prof->push("PPPM");
 
@@ -1282,10 +1447,14 @@ void PPPMForceCompute::computeForces(unsigned int timestep)
     updateMeshes();
 
     PDataFlags flags = this->m_pdata->getFlags();
-    computePE();
 
     interpolateForces();
 
+    if (m_slab_correction)
+        computeSlabCorrection();
+
+    computePE();
+
     if (flags[pdata_flag::pressure_tensor])
         {
         computeVirial();
@@ -1296,11 +1465,84 @@ void PPPMForceCompute::computeForces(unsigned int timestep)
             m_external_virial[i] = Scalar(0.0);
         }
 
+    if (m_prof) m_prof->pop();
+
+    return true;
+    }
+
+/*! \param timestep The current time step
+*/
+void PPPMForceCompute::computeBoundaryForces(unsigned int timestep)
+    {
     // If there are exclusions, correct for the long-range part of the potential
     if(m_nlist->getExclusionsSet())
         {
+        if (m_prof) m_prof->push("PPPM");
+
         m_nlist->compute(timestep);
         fixExclusions();
+
+        if (m_prof) m_prof->pop();
+        }
+    }
+
+/*! \param dipole_z Global sum of q_i z_i
+    \param q_z2 Global sum of q_i z_i^2
+    \returns The energy of the slab correction
+
+    With the total charge Q and the volume V, the energy is 2 pi / V (M_z^2 - Q sum q_i z_i^2 - Q^2 L_z^2 / 12),
+    which does not depend on the origin of z.
+*/
+Scalar PPPMForceCompute::computeSlabEnergy(Scalar dipole_z, Scalar q_z2)
+    {
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    Scalar V = global_box.getVolume();
+    Scalar Lz = global_box.getL().z;
+
+    return Scalar(2.0*M_PI)/V*(dipole_z*dipole_z - m_q*q_z2 - m_q*m_q*Lz*Lz/Scalar(12.0));
+    }
+
+/*! The force on particle i is -4 pi q_i / V (M_z - Q z_i) along z.
+*/
+void PPPMForceCompute::computeSlabCorrection()
+    {
+    if (m_prof) m_prof->push("slab");
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+
+    Scalar sums[2] = {Scalar(0.0), Scalar(0.0)};
+    unsigned int group_size = m_group->getNumMembers();
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        {
+        unsigned int j = m_group->getMemberIndex(group_idx);
+        Scalar qi = h_charge.data[j];
+        Scalar zi = h_postype.data[j].z;
+
+        sums[0] += qi*zi;
+        sums[1] += qi*zi*zi;
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      sums,
+                      2,
+                      MPI_HOOMD_SCALAR,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    m_slab_energy = computeSlabEnergy(sums[0], sums[1]);
+
+    Scalar prefactor = -Scalar(4.0*M_PI)/m_pdata->getGlobalBox().getVolume();
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::readwrite);
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        {
+        unsigned int j = m_group->getMemberIndex(group_idx);
+        h_force.data[j].z += prefactor*h_charge.data[j]*(sums[0] - m_q*h_postype.data[j].z);
         }
 
     if (m_prof) m_prof->pop();
@@ -1513,7 +1755,7 @@ void PPPMForceCompute::fixExclusions()
     const BoxDim& box = m_pdata->getBox();
     ArrayHandle<unsigned int> d_exlist(m_nlist->getExListArray(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> d_n_ex(m_nlist->getNExArray(), access_location::host, access_mode::read);
-    Index2D nex = m_nlist->getExListIndexer();
+    ArrayHandle<unsigned int> d_ex_head(m_nlist->getExHeadArray(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
@@ -1536,7 +1778,7 @@ void PPPMForceCompute::fixExclusions()
 
         for (unsigned int neigh_idx = 0; neigh_idx < n_neigh; neigh_idx++)
             {
-            cur_j = d_exlist.data[nex(idx, neigh_idx)];
+            cur_j = d_exlist.data[d_ex_head.data[idx] + neigh_idx];
 
             // get the neighbor's position
             Scalar3 posj;
@@ -1671,5 +1913,7 @@ void export_PPPMForceCompute(py::module& m)
         .def("setParams", &PPPMForceCompute::setParams)
         .def("getQSum", &PPPMForceCompute::getQSum)
         .def("getQ2Sum", &PPPMForceCompute::getQ2Sum)
+        .def_property("slab_correction", &PPPMForceCompute::getSlabCorrection,
+                      &PPPMForceCompute::setSlabCorrection)
         ;
     }
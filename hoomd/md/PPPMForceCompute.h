@@ -15,6 +15,10 @@
 
 #include "hoomd/extern/kiss_fftnd.h"
 
+#ifdef ENABLE_FFTW
+#include <fftw3.h>
+#endif
+
 #include <memory>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 
@@ -23,6 +27,13 @@ const Scalar EPS_HOC(1.0e-7);
 const unsigned int PPPM_MAX_ORDER = 7;
 
 /*! Compute the long-ranged part of the particle-particle particle-mesh Ewald sum (PPPM)
+
+    The Ewald sum is periodic in all three directions. For a slab that is periodic in x and y and separated from its
+    images along z by a vacuum gap, setSlabCorrection() enables the correction of Yeh and Berkowitz (J. Chem. Phys.
+    111, 3155, 1999) with the net charge terms of Ballenegger, Arnold, and Cerda (J. Chem. Phys. 131, 094107, 2009).
+    It removes the interaction of the slab with the dipoles of its periodic images along z, so a gap of two to three
+    times the slab thickness is sufficient where the uncorrected sum needs far more vacuum, mesh points, and FFT work
+    to converge. The correction adds to the energy and the z component of the forces, but not to the virial.
  */
 class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
     {
@@ -63,6 +74,55 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         //! Get sum of squares of charges
         Scalar getQ2Sum();
 
+        //! Get the global number of mesh points along each direction
+        uint3 getMeshDimensions()
+            {
+            return m_global_dim;
+            }
+
+        //! Get the interpolation order
+        unsigned int getOrder()
+            {
+            return m_order;
+            }
+
+        //! Get the splitting parameter
+        Scalar getKappa()
+            {
+            return m_kappa;
+            }
+
+        //! Get the cutoff of the short-ranged part
+        Scalar getRCut()
+            {
+            return m_rcut;
+            }
+
+        //! Get the Debye screening parameter
+        Scalar getAlpha()
+            {
+            return m_alpha;
+            }
+
+        //! Enable or disable the slab correction for systems that are not periodic along z
+        void setSlabCorrection(bool slab_correction)
+            {
+            m_slab_correction = slab_correction;
+            }
+
+        //! Get whether the slab correction is enabled
+        bool getSlabCorrection()
+            {
+            return m_slab_correction;
+            }
+
+        //! Estimate the RMS force error of a set of parameters
+        void estimateError(uint3 global_dim, unsigned int order, Scalar kappa, Scalar rcut, Scalar q2,
+                           Scalar& kspace_error, Scalar& real_error);
+
+        //! root mean square error in force calculation
+        Scalar rms(Scalar h, Scalar prd, Scalar natoms, unsigned int order, Scalar kappa, Scalar q2);
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         /*! \param timestep Current time step
@@ -97,6 +157,12 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
          */
         void computeBiasForces(unsigned int timestep);
 
+        //! Compute the mesh forces, which only involve the local particles
+        virtual bool computeInteriorForces(unsigned int timestep);
+
+        //! Correct the forces on excluded pairs, which may involve ghost particles
+        virtual void computeBoundaryForces(unsigned int timestep);
+
         std::shared_ptr<NeighborList> m_nlist; //!< The neighborlist to use for the computation
         std::shared_ptr<ParticleGroup> m_group;//!< Group to compute properties for
 
@@ -130,6 +196,8 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         GlobalArray<Scalar> m_gf_b;            //!< Green function coefficients
 
         Scalar m_body_energy;                      //!< Energy correction due to rigid body exclusions
+        bool m_slab_correction;             //!< True if the slab correction is applied along z
+        Scalar m_slab_energy;               //!< Global energy of the slab correction
         bool m_ptls_added_removed;          //!< True if global particle number changed
 
         //! Helper function to be called when particle number changes
@@ -177,6 +245,12 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         //! Compute rigid body correction
         virtual void computeBodyCorrection();
 
+        //! Add the slab correction to the forces and compute its energy
+        virtual void computeSlabCorrection();
+
+        //! Compute the slab correction energy from the global sums
+        Scalar computeSlabEnergy(Scalar dipole_z, Scalar q_z2);
+
     private:
         kiss_fftnd_cfg m_kiss_fft;         //!< The FFT configuration
         kiss_fftnd_cfg m_kiss_ifft;        //!< Inverse FFT configuration
@@ -190,6 +264,12 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
 
         bool m_kiss_fft_initialized;               //!< True if a local KISS FFT has been set up
 
+        #ifdef ENABLE_FFTW
+        fftwf_plan m_fftw_plan_forward;            //!< FFTW plan for the local forward transform
+        fftwf_plan m_fftw_plan_inverse;            //!< FFTW plan for the local inverse transform
+        bool m_fftw_initialized;                   //!< True if local FFTW plans have been set up
+        #endif
+
         GlobalArray<kiss_fft_cpx> m_mesh;             //!< The particle density mesh
         GlobalArray<kiss_fft_cpx> m_fourier_mesh;     //!< The fourier transformed mesh
         GlobalArray<kiss_fft_cpx> m_fourier_mesh_G_x;   //!< Fourier transformed mesh times the influence function, x-component
@@ -203,15 +283,20 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
 
         bool m_dfft_initialized;                   //! True if host dfft has been initialized
 
+        #ifdef ENABLE_FFTW
+        //! Plan the local FFTW transforms on the allocated meshes
+        void initializeFFTW();
+
+        //! Destroy the local FFTW plans
+        void destroyFFTW();
+        #endif
+
         //! Compute virial on mesh
         void computeVirialMesh();
 
         //! Compute number of ghost cellso
         uint3 computeGhostCellNum();
 
-        //! root mean square error in force calculation
-        Scalar rms(Scalar h, Scalar prd, Scalar natoms);
-
         //! computes coefficients for assigning charges to grid points
         void compute_rho_coeff();
 
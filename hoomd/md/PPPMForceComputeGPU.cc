@@ -18,7 +18,8 @@ PPPMForceComputeGPU::PPPMForceComputeGPU(std::shared_ptr<SystemDefinition> sysde
     : PPPMForceCompute(sysdef,nlist,group),
       m_local_fft(true),
       m_sum(m_exec_conf),
-      m_block_size(256)
+      m_block_size(256),
+      m_slab_sum(m_exec_conf)
     {
     unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
     m_tuner_assign.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "pppm_assign", this->m_exec_conf));
@@ -52,6 +53,25 @@ PPPMForceComputeGPU::~PPPMForceComputeGPU()
 
 void PPPMForceComputeGPU::initializeFFT()
     {
+    // release the transforms of the previous parameters, setParams() may be called during a run
+    if (m_cufft_initialized)
+        {
+        #ifdef __HIP_PLATFORM_HCC__
+        CHECK_HIPFFT_ERROR(hipfftDestroy(m_hipfft_plan));
+        #else
+        CHECK_HIPFFT_ERROR(cufftDestroy(m_hipfft_plan));
+        #endif
+        m_cufft_initialized = false;
+        }
+    #ifdef ENABLE_MPI
+    if (m_cuda_dfft_initialized)
+        {
+        dfft_destroy_plan(m_dfft_plan_forward);
+        dfft_destroy_plan(m_dfft_plan_inverse);
+        m_cuda_dfft_initialized = false;
+        }
+    #endif
+
     #ifdef ENABLE_MPI
     m_local_fft = !m_pdata->getDomainDecomposition();
 
@@ -195,9 +215,19 @@ void PPPMForceComputeGPU::assignParticles()
     {
     if (m_prof) m_prof->push(m_exec_conf, "assign");
 
+    // accumulate the charge density in fixed point for reproducible results
+    bool deterministic = m_exec_conf->isDeterministicReductions();
+    size_t n_fixed = m_mesh.getNumElements()*m_exec_conf->getNumActiveGPUs();
+    if (deterministic && m_mesh_fixed.getNumElements() < n_fixed)
+        {
+        GlobalArray<unsigned long long int> mesh_fixed(n_fixed, m_exec_conf);
+        m_mesh_fixed.swap(mesh_fixed);
+        }
+
     ArrayHandle<Scalar4> d_postype(m_pdata->getPositions(), access_location::device, access_mode::read);
     ArrayHandle<hipfftComplex> d_mesh(m_mesh, access_location::device, access_mode::overwrite);
     ArrayHandle<hipfftComplex> d_mesh_scratch(m_mesh_scratch, access_location::device, access_mode::overwrite);
+    ArrayHandle<unsigned long long int> d_mesh_fixed(m_mesh_fixed, access_location::device, access_mode::overwrite);
     ArrayHandle<Scalar> d_charge(m_pdata->getCharges(), access_location::device, access_mode::read);
 
     // access the group
@@ -221,6 +251,7 @@ void PPPMForceComputeGPU::assignParticles()
                         d_charge.data,
                         d_mesh.data,
                         d_mesh_scratch.data,
+                        deterministic ? d_mesh_fixed.data : NULL,
                         (unsigned int)m_mesh.getNumElements(),
                         m_order,
                         m_pdata->getBox(),
@@ -571,6 +602,10 @@ Scalar PPPMForceComputeGPU::computePE()
     // apply rigid body correction
     sum += m_body_energy;
 
+    // the slab correction is a global quantity, count it once
+    if (m_slab_correction && m_exec_conf->getRank()==0)
+        sum += m_slab_energy;
+
     // store this rank's contribution as external potential energy
     m_external_energy = sum;
 
@@ -648,6 +683,7 @@ void PPPMForceComputeGPU::fixExclusions()
 
     ArrayHandle<unsigned int> d_exlist(m_nlist->getExListArray(), access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_n_ex(m_nlist->getNExArray(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_ex_head(m_nlist->getExHeadArray(), access_location::device, access_mode::read);
     ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::readwrite);
     ArrayHandle<Scalar> d_virial(m_virial, access_location::device, access_mode::readwrite);
     ArrayHandle< unsigned int > d_index_array(m_group->getIndexArray(), access_location::device, access_mode::read);
@@ -659,8 +695,6 @@ void PPPMForceComputeGPU::fixExclusions()
     // reset virial
     hipMemset(d_virial.data, 0, sizeof(Scalar)*m_virial.getNumElements());
 
-    Index2D nex = m_nlist->getExListIndexer();
-
     gpu_fix_exclusions(d_force.data,
                    d_virial.data,
                    m_virial.getPitch(),
@@ -670,7 +704,7 @@ void PPPMForceComputeGPU::fixExclusions()
                    m_pdata->getBox(),
                    d_n_ex.data,
                    d_exlist.data,
-                   nex,
+                   d_ex_head.data,
                    m_kappa,
                    m_alpha,
                    d_index_array.data,
@@ -683,6 +717,71 @@ void PPPMForceComputeGPU::fixExclusions()
     if (m_prof) m_prof->pop(m_exec_conf);
     }
 
+void PPPMForceComputeGPU::computeSlabCorrection()
+    {
+    if (m_prof) m_prof->push(m_exec_conf,"slab");
+
+    unsigned int group_size = m_group->getNumMembers();
+    unsigned int n_blocks = group_size/m_block_size+1;
+    if (m_slab_sum_partial.getNumElements() < n_blocks)
+        {
+        GlobalArray<Scalar2> slab_sum_partial(n_blocks, m_exec_conf);
+        m_slab_sum_partial.swap(slab_sum_partial);
+        }
+
+    ArrayHandle<Scalar4> d_postype(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar> d_charge(m_pdata->getCharges(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(), access_location::device, access_mode::read);
+
+        {
+        ArrayHandle<Scalar2> d_slab_sum_partial(m_slab_sum_partial, access_location::device, access_mode::overwrite);
+
+        gpu_compute_slab_sums(d_slab_sum_partial.data,
+                              m_slab_sum.getDeviceFlags(),
+                              d_postype.data,
+                              d_charge.data,
+                              d_index_array.data,
+                              group_size,
+                              m_block_size);
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+    Scalar2 sums = m_slab_sum.readFlags();
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &sums,
+                      2,
+                      MPI_HOOMD_SCALAR,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    m_slab_energy = computeSlabEnergy(sums.x, sums.y);
+
+    ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::readwrite);
+
+    gpu_apply_slab_correction(d_force.data,
+                              d_postype.data,
+                              d_charge.data,
+                              d_index_array.data,
+                              group_size,
+                              -Scalar(4.0*M_PI)/m_pdata->getGlobalBox().getVolume(),
+                              sums.x,
+                              m_q,
+                              m_block_size);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    if (m_prof) m_prof->pop(m_exec_conf);
+    }
+
 void export_PPPMForceComputeGPU(py::module& m)
     {
     py::class_<PPPMForceComputeGPU, PPPMForceCompute, std::shared_ptr<PPPMForceComputeGPU> >(m, "PPPMForceComputeGPU")
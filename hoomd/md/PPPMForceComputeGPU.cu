@@ -3,6 +3,7 @@
 
 #include "PPPMForceComputeGPU.cuh"
 #include "hoomd/TextureTools.h"
+#include "hoomd/FixedPointAtomics.cuh"
 
 // __scalar2int_rd is __float2int_rd in single, __double2int_rd in double
 #ifdef SINGLE_PRECISION
@@ -123,6 +124,7 @@ __global__ void gpu_assign_particles_kernel(const uint3 mesh_dim,
                                             const Scalar4 *d_postype,
                                             const Scalar *d_charge,
                                             hipfftComplex *d_mesh,
+                                            unsigned long long int *d_mesh_fixed,
                                             Scalar V_cell,
                                             int order,
                                             unsigned int offset,
@@ -275,7 +277,10 @@ __global__ void gpu_assign_particles_kernel(const uint3 mesh_dim,
 
                     // compute fraction of particle density assigned to cell
                     // from particles in this bin
-                    myAtomicAdd(&d_mesh[cell_idx].x, z0*result/V_cell);
+                    if (d_mesh_fixed)
+                        hoomd::detail::atomicAddFixedPoint(d_mesh_fixed + cell_idx, z0*result/V_cell);
+                    else
+                        myAtomicAdd(&d_mesh[cell_idx].x, z0*result/V_cell);
                     }
 
                 ignore_z = false;
@@ -286,6 +291,22 @@ __global__ void gpu_assign_particles_kernel(const uint3 mesh_dim,
         } // end of loop over neighboring bins
     }
 
+//! Convert the fixed point charge density of the deterministic mode
+__global__ void gpu_convert_fixed_mesh_kernel(const unsigned int mesh_elements,
+    const unsigned long long int *d_mesh_fixed,
+    hipfftComplex *d_mesh)
+    {
+    unsigned idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= mesh_elements)
+        return;
+
+    hipfftComplex res;
+    res.x = float(hoomd::detail::fixedPointToScalar(d_mesh_fixed[idx]));
+    res.y = 0;
+    d_mesh[idx] = res;
+    }
+
 __global__ void gpu_reduce_meshes(const unsigned int mesh_elements,
     const hipfftComplex *d_mesh_scratch,
     hipfftComplex *d_mesh,
@@ -317,6 +338,7 @@ void gpu_assign_particles(const uint3 mesh_dim,
                          const Scalar *d_charge,
                          hipfftComplex *d_mesh,
                          hipfftComplex *d_mesh_scratch,
+                         unsigned long long int *d_mesh_fixed,
                          const unsigned int mesh_elements,
                          int order,
                          const BoxDim& box,
@@ -356,6 +378,16 @@ void gpu_assign_particles(const uint3 mesh_dim,
             hipMemsetAsync(d_mesh_scratch + idev*mesh_elements, 0, sizeof(hipfftComplex)*mesh_elements);
             }
 
+        hipfftComplex *d_mesh_idev = ngpu > 1 ? d_mesh_scratch + idev*mesh_elements : d_mesh;
+
+        // in deterministic mode, accumulate the charges of each GPU in fixed point
+        unsigned long long int *d_mesh_fixed_idev = NULL;
+        if (d_mesh_fixed)
+            {
+            d_mesh_fixed_idev = d_mesh_fixed + idev*mesh_elements;
+            hipMemsetAsync(d_mesh_fixed_idev, 0, sizeof(unsigned long long int)*mesh_elements);
+            }
+
         unsigned int nwork = range.second - range.first;
         unsigned int n_blocks = nwork/run_block_size+1;
         unsigned int shared_bytes = (unsigned int)(order*(2*order+1)*sizeof(Scalar));
@@ -367,12 +399,22 @@ void gpu_assign_particles(const uint3 mesh_dim,
               d_index_array,
               d_postype,
               d_charge,
-              ngpu > 1 ? d_mesh_scratch + idev*mesh_elements : d_mesh,
+              d_mesh_idev,
+              d_mesh_fixed_idev,
               V_cell,
               order,
               range.first,
               box,
               d_rho_coeff);
+
+        if (d_mesh_fixed)
+            {
+            hipLaunchKernelGGL((gpu_convert_fixed_mesh_kernel), dim3(mesh_elements/run_block_size + 1),
+                dim3(run_block_size), 0, 0,
+                mesh_elements,
+                d_mesh_fixed_idev,
+                d_mesh_idev);
+            }
         }
     }
 
@@ -1277,7 +1319,7 @@ __global__ void gpu_fix_exclusions_kernel(Scalar4 *d_force,
                                           const BoxDim box,
                                           const unsigned int *d_n_neigh,
                                           const unsigned int *d_nlist,
-                                          const Index2D nli,
+                                          const unsigned int *d_head,
                                           Scalar kappa,
                                           Scalar alpha,
                                           unsigned int *d_group_members,
@@ -1301,7 +1343,8 @@ __global__ void gpu_fix_exclusions_kernel(Scalar4 *d_force,
             virial[i] = Scalar(0.0);
         unsigned int cur_j = 0;
         // prefetch neighbor index
-        unsigned int next_j = d_nlist[nli(idx, 0)];
+        const unsigned int *my_nlist = d_nlist + (n_neigh ? d_head[idx] : 0);
+        unsigned int next_j = n_neigh ? my_nlist[0] : 0;
 
             for (int neigh_idx = 0; neigh_idx < n_neigh; neigh_idx++)
                 {
@@ -1310,7 +1353,7 @@ __global__ void gpu_fix_exclusions_kernel(Scalar4 *d_force,
                     // prefetch the next value and set the current one
                     cur_j = next_j;
                     if (neigh_idx+1 < n_neigh)
-                        next_j = d_nlist[nli(idx, neigh_idx+1)];
+                        next_j = my_nlist[neigh_idx+1];
 
                     // get the neighbor's position (MEM TRANSFER: 16 bytes)
                     Scalar4 postypej = __ldg(d_pos + cur_j);
@@ -1374,7 +1417,7 @@ hipError_t gpu_fix_exclusions(Scalar4 *d_force,
                            const BoxDim& box,
                            const unsigned int *d_n_ex,
                            const unsigned int *d_exlist,
-                           const Index2D nex,
+                           const unsigned int *d_ex_head,
                            Scalar kappa,
                            Scalar alpha,
                            unsigned int *d_group_members,
@@ -1392,10 +1435,180 @@ hipError_t gpu_fix_exclusions(Scalar4 *d_force,
                                                       box,
                                                       d_n_ex,
                                                       d_exlist,
-                                                      nex,
+                                                      d_ex_head,
                                                       kappa,
                                                       alpha,
                                                       d_group_members,
                                                       group_size);
     return hipSuccess;
     }
+
+//! Compute the per block sums of q z and q z^2 over the group
+__global__ void gpu_compute_slab_sums_partial(Scalar2 *d_sum_partial,
+                                              const Scalar4 *d_postype,
+                                              const Scalar *d_charge,
+                                              const unsigned int *d_index_array,
+                                              unsigned int group_size)
+    {
+    HIP_DYNAMIC_SHARED( Scalar2, sdata)
+
+    unsigned int tidx = threadIdx.x;
+    unsigned int group_idx = blockDim.x * blockIdx.x + threadIdx.x;
+
+    Scalar2 mySum = make_scalar2(0.0, 0.0);
+    if (group_idx < group_size)
+        {
+        unsigned int j = d_index_array[group_idx];
+        Scalar qi = d_charge[j];
+        Scalar zi = d_postype[j].z;
+        mySum.x = qi*zi;
+        mySum.y = qi*zi*zi;
+        }
+
+    sdata[tidx] = mySum;
+
+    __syncthreads();
+
+    // reduce the sum
+    int offs = blockDim.x >> 1;
+    while (offs > 0)
+        {
+        if (tidx < offs)
+            {
+            sdata[tidx].x += sdata[tidx + offs].x;
+            sdata[tidx].y += sdata[tidx + offs].y;
+            }
+        offs >>= 1;
+        __syncthreads();
+        }
+
+    // write result to global memory
+    if (tidx == 0)
+        d_sum_partial[blockIdx.x] = sdata[0];
+    }
+
+//! Sum the per block sums of the slab correction
+__global__ void gpu_final_reduce_slab_sums(Scalar2 *d_sum_partial,
+                                           unsigned int nblocks,
+                                           Scalar2 *d_sum)
+    {
+    HIP_DYNAMIC_SHARED( Scalar2, smem)
+
+    if (threadIdx.x == 0)
+        *d_sum = make_scalar2(0.0, 0.0);
+
+    for (int start = 0; start < nblocks; start += blockDim.x)
+        {
+        __syncthreads();
+        if (start + threadIdx.x < nblocks)
+            smem[threadIdx.x] = d_sum_partial[start + threadIdx.x];
+        else
+            smem[threadIdx.x] = make_scalar2(0.0, 0.0);
+
+        __syncthreads();
+
+        // reduce the sum
+        int offs = blockDim.x >> 1;
+        while (offs > 0)
+            {
+            if (threadIdx.x < offs)
+                {
+                smem[threadIdx.x].x += smem[threadIdx.x + offs].x;
+                smem[threadIdx.x].y += smem[threadIdx.x + offs].y;
+                }
+            offs >>= 1;
+            __syncthreads();
+            }
+
+        if (threadIdx.x == 0)
+            {
+            d_sum->x += smem[0].x;
+            d_sum->y += smem[0].y;
+            }
+        }
+    }
+
+/*! \param d_sum_partial Scratch space for the per block sums, at least group_size/block_size+1 elements
+    \param d_sum Sums of q z and q z^2 over the group (output)
+    \param d_postype Particle positions
+    \param d_charge Particle charges
+    \param d_index_array Indices of the group members
+    \param group_size Number of group members
+    \param block_size Number of threads per block, a power of two
+*/
+void gpu_compute_slab_sums(Scalar2 *d_sum_partial,
+                           Scalar2 *d_sum,
+                           const Scalar4 *d_postype,
+                           const Scalar *d_charge,
+                           const unsigned int *d_index_array,
+                           unsigned int group_size,
+                           unsigned int block_size)
+    {
+    unsigned int n_blocks = group_size/block_size + 1;
+    unsigned int shared_size = (unsigned int)(block_size * sizeof(Scalar2));
+
+    hipLaunchKernelGGL((gpu_compute_slab_sums_partial), dim3(n_blocks), dim3(block_size), shared_size, 0,
+                       d_sum_partial,
+                       d_postype,
+                       d_charge,
+                       d_index_array,
+                       group_size);
+
+    const unsigned int final_block_size = 256;
+    shared_size = final_block_size*sizeof(Scalar2);
+    hipLaunchKernelGGL((gpu_final_reduce_slab_sums), dim3(1), dim3(final_block_size), shared_size, 0,
+                       d_sum_partial,
+                       n_blocks,
+                       d_sum);
+    }
+
+//! Add the slab correction -4 pi q_i / V (M_z - Q z_i) to the z component of the force
+__global__ void gpu_apply_slab_correction_kernel(Scalar4 *d_force,
+                                                 const Scalar4 *d_postype,
+                                                 const Scalar *d_charge,
+                                                 const unsigned int *d_index_array,
+                                                 unsigned int group_size,
+                                                 Scalar prefactor,
+                                                 Scalar dipole_z,
+                                                 Scalar q)
+    {
+    unsigned int group_idx = blockDim.x * blockIdx.x + threadIdx.x;
+    if (group_idx >= group_size)
+        return;
+
+    unsigned int j = d_index_array[group_idx];
+    d_force[j].z += prefactor*d_charge[j]*(dipole_z - q*d_postype[j].z);
+    }
+
+/*! \param d_force Forces to add the correction to
+    \param d_postype Particle positions
+    \param d_charge Particle charges
+    \param d_index_array Indices of the group members
+    \param group_size Number of group members
+    \param prefactor -4 pi / V
+    \param dipole_z Global sum of q z
+    \param q Total charge
+    \param block_size Number of threads per block
+*/
+void gpu_apply_slab_correction(Scalar4 *d_force,
+                               const Scalar4 *d_postype,
+                               const Scalar *d_charge,
+                               const unsigned int *d_index_array,
+                               unsigned int group_size,
+                               Scalar prefactor,
+                               Scalar dipole_z,
+                               Scalar q,
+                               unsigned int block_size)
+    {
+    unsigned int n_blocks = group_size/block_size + 1;
+
+    hipLaunchKernelGGL((gpu_apply_slab_correction_kernel), dim3(n_blocks), dim3(block_size), 0, 0,
+                       d_force,
+                       d_postype,
+                       d_charge,
+                       d_index_array,
+                       group_size,
+                       prefactor,
+                       dipole_z,
+                       q);
+    }
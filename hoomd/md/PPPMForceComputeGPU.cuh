@@ -27,6 +27,7 @@ void gpu_assign_particles(const uint3 mesh_dim,
                          const Scalar *d_charge,
                          hipfftComplex *d_mesh,
                          hipfftComplex *d_mesh_scratch,
+                         unsigned long long int *d_mesh_fixed,
                          const unsigned int mesh_elements,
                          int order,
                          const BoxDim& box,
@@ -117,13 +118,31 @@ hipError_t gpu_fix_exclusions(Scalar4 *d_force,
                            const BoxDim& box,
                            const unsigned int *d_n_ex,
                            const unsigned int *d_exlist,
-                           const Index2D nex,
+                           const unsigned int *d_ex_head,
                            Scalar kappa,
                            Scalar alpha,
                            unsigned int *d_group_members,
                            unsigned int group_size,
                            int block_size);
 
+void gpu_compute_slab_sums(Scalar2 *d_sum_partial,
+                           Scalar2 *d_sum,
+                           const Scalar4 *d_postype,
+                           const Scalar *d_charge,
+                           const unsigned int *d_index_array,
+                           unsigned int group_size,
+                           unsigned int block_size);
+
+void gpu_apply_slab_correction(Scalar4 *d_force,
+                               const Scalar4 *d_postype,
+                               const Scalar *d_charge,
+                               const unsigned int *d_index_array,
+                               unsigned int group_size,
+                               Scalar prefactor,
+                               Scalar dipole_z,
+                               Scalar q,
+                               unsigned int block_size);
+
 void gpu_initialize_coeff(
     Scalar *CPU_rho_coeff,
     int order,
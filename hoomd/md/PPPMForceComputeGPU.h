@@ -89,6 +89,9 @@ class PYBIND11_EXPORT PPPMForceComputeGPU : public PPPMForceCompute
         //! Helper function to correct forces on excluded particles
         virtual void fixExclusions();
 
+        //! Add the slab correction to the forces and compute its energy
+        virtual void computeSlabCorrection();
+
         //! Check for HIPFFT errors
         #ifdef __HIP_PLATFORM_HCC__
         inline void handleHIPFFTResult(hipfftResult result, const char *file, unsigned int line) const
@@ -131,6 +134,7 @@ class PYBIND11_EXPORT PPPMForceComputeGPU : public PPPMForceCompute
 
         GlobalArray<hipfftComplex> m_mesh;                 //!< The particle density mesh
         GlobalArray<hipfftComplex> m_mesh_scratch;         //!< The particle density mesh per GPU, staging array
+        GlobalArray<unsigned long long int> m_mesh_fixed;  //!< Fixed point density mesh per GPU in deterministic mode
         GlobalArray<hipfftComplex> m_inv_fourier_mesh_x;     //!< The inverse-fourier transformed force mesh
         GlobalArray<hipfftComplex> m_inv_fourier_mesh_y;     //!< The inverse-fourier transformed force mesh
         GlobalArray<hipfftComplex> m_inv_fourier_mesh_z;     //!< The inverse-fourier transformed force mesh
@@ -140,6 +144,9 @@ class PYBIND11_EXPORT PPPMForceComputeGPU : public PPPMForceCompute
         GlobalArray<Scalar> m_sum_virial_partial;     //!< Partial sums over virial mesh values
         GlobalArray<Scalar> m_sum_virial;             //!< Final sum over virial mesh values
         unsigned int m_block_size;                 //!< Block size for fourier mesh reduction
+
+        GPUFlags<Scalar2> m_slab_sum;              //!< Sums of q z and q z^2 for the slab correction
+        GlobalArray<Scalar2> m_slab_sum_partial;   //!< Partial sums for the slab correction
     };
 
 void export_PPPMForceComputeGPU(pybind11::module& m);
@@ -0,0 +1,343 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: joaander
+
+/*! \file PPPMTuner.cc
+    \brief Defines the PPPMTuner class
+*/
+
+
+#include "PPPMTuner.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/HOOMDMPI.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+namespace py = pybind11;
+
+//! Largest number of mesh points along one direction the tuner considers
+const unsigned int PPPM_TUNER_MAX_MESH = 1024;
+
+/*! \param sysdef System definition
+    \param trigger Select the time steps on which to take a tuning step
+    \param pppm Long-ranged part of the electrostatics to tune
+    \param ewald Short-ranged part of the electrostatics to tune
+    \param target_error Target RMS force error
+    \param r_cut_min Smallest cutoff candidate
+    \param r_cut_max Largest cutoff candidate
+    \param n_r_cut Number of cutoff candidates
+    \param orders Interpolation order candidates
+    \param max_volume_change Relative change of the box volume that starts a new scan
+*/
+PPPMTuner::PPPMTuner(std::shared_ptr<SystemDefinition> sysdef,
+                     std::shared_ptr<Trigger> trigger,
+                     std::shared_ptr<PPPMForceCompute> pppm,
+                     std::shared_ptr<PotentialPairEwald> ewald,
+                     Scalar target_error,
+                     Scalar r_cut_min,
+                     Scalar r_cut_max,
+                     unsigned int n_r_cut,
+                     pybind11::list orders,
+                     Scalar max_volume_change)
+        : Tuner(sysdef, trigger), m_pppm(pppm), m_ewald(ewald), m_target_error(target_error),
+          m_state(STARTUP), m_current(0), m_tuned_volume(0), m_last_timestep(0), m_last_time(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing PPPMTuner" << endl;
+
+    if (!(target_error > 0.0))
+        {
+        m_exec_conf->msg->error() << "tune.PPPM: target_error must be positive" << endl;
+        throw runtime_error("Error initializing PPPMTuner");
+        }
+
+    if (!(r_cut_min > 0.0) || r_cut_max < r_cut_min)
+        {
+        m_exec_conf->msg->error() << "tune.PPPM: cutoff range must satisfy 0 < min <= max" << endl;
+        throw runtime_error("Error initializing PPPMTuner");
+        }
+
+    if (n_r_cut == 0)
+        {
+        m_exec_conf->msg->error() << "tune.PPPM: n_r_cut must be positive" << endl;
+        throw runtime_error("Error initializing PPPMTuner");
+        }
+
+    for (unsigned int i = 0; i < n_r_cut; i++)
+        {
+        if (n_r_cut == 1)
+            m_r_cuts.push_back(r_cut_min);
+        else
+            m_r_cuts.push_back(r_cut_min + (r_cut_max - r_cut_min) * Scalar(i) / Scalar(n_r_cut - 1));
+        }
+
+    for (auto order : orders)
+        {
+        unsigned int o = order.cast<unsigned int>();
+        if (o < 1 || o > PPPM_MAX_ORDER)
+            {
+            m_exec_conf->msg->error() << "tune.PPPM: orders must be between 1 and " << PPPM_MAX_ORDER << endl;
+            throw runtime_error("Error initializing PPPMTuner");
+            }
+        m_orders.push_back(o);
+        }
+
+    if (m_orders.size() == 0)
+        {
+        m_exec_conf->msg->error() << "tune.PPPM: orders must not be empty" << endl;
+        throw runtime_error("Error initializing PPPMTuner");
+        }
+
+    setMaxVolumeChange(max_volume_change);
+    }
+
+PPPMTuner::~PPPMTuner()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying PPPMTuner" << endl;
+    }
+
+/*! \param dim Direction (0, 1, or 2) of the mesh
+    \param order Interpolation order
+    \param kappa Splitting parameter
+    \param q2 Sum of the squared charges
+    \returns The smallest allowed number of mesh points along \a dim, or 0 when none up to PPPM_TUNER_MAX_MESH
+             reaches the target error
+
+    Each direction contributes to the mesh error independently, so the smallest mesh that keeps every direction
+    below the target keeps the combined estimate below it, too.
+*/
+unsigned int PPPMTuner::findMeshSize(unsigned int dim, unsigned int order, Scalar kappa, Scalar q2)
+    {
+    bool decomposed = false;
+    unsigned int n_domains = 1;
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        const Index3D& didx = m_pdata->getDomainDecomposition()->getDomainIndexer();
+        decomposed = true;
+        n_domains = (dim == 0) ? didx.getW() : ((dim == 1) ? didx.getH() : didx.getD());
+        }
+    #endif
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    Scalar3 L = box.getL();
+    Scalar prd = (dim == 0) ? L.x : ((dim == 1) ? L.y : L.z);
+    Scalar N = Scalar(m_pdata->getNGlobal());
+
+    for (unsigned int size = order; size <= PPPM_TUNER_MAX_MESH; size++)
+        {
+        unsigned int m = size;
+        if (decomposed)
+            {
+            // the distributed FFT requires powers of two that divide evenly among the ranks
+            if ((m & (m - 1)) || m % n_domains)
+                continue;
+            }
+        else
+            {
+            // mixed radix sizes keep the FFTs fast
+            while (m % 2 == 0) m /= 2;
+            while (m % 3 == 0) m /= 3;
+            while (m % 5 == 0) m /= 5;
+            if (m != 1)
+                continue;
+            }
+
+        if (m_pppm->rms(prd / Scalar(size), prd, N, order, kappa, q2) <= m_target_error)
+            return size;
+        }
+
+    return 0;
+    }
+
+/*! For each cutoff, the splitting parameter puts the real space error estimate at the target error, but no lower
+    than 1/r_cut. The mesh then follows from the order and the splitting parameter.
+*/
+void PPPMTuner::findCandidates()
+    {
+    m_candidates.clear();
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    m_tuned_volume = box.getVolume();
+    Scalar N = Scalar(m_pdata->getNGlobal());
+    Scalar q2 = m_pppm->getQ2Sum();
+
+    if (!(q2 > 0.0))
+        {
+        m_exec_conf->msg->error() << "tune.PPPM: the particles in the group carry no charge" << endl;
+        throw runtime_error("Error tuning PPPM");
+        }
+
+    for (auto r_cut : m_r_cuts)
+        {
+        Scalar arg = log(Scalar(2.0) * q2 / (m_target_error * sqrt(N * r_cut * m_tuned_volume)));
+        Scalar kappa = sqrt(std::max(arg, Scalar(1.0))) / r_cut;
+
+        for (auto order : m_orders)
+            {
+            uint3 mesh = make_uint3(findMeshSize(0, order, kappa, q2),
+                                    findMeshSize(1, order, kappa, q2),
+                                    findMeshSize(2, order, kappa, q2));
+            if (mesh.x == 0 || mesh.y == 0 || mesh.z == 0)
+                {
+                m_exec_conf->msg->notice(5) << "tune.PPPM: r_cut " << r_cut << ", order " << order
+                                            << " needs more than " << PPPM_TUNER_MAX_MESH << " mesh points" << endl;
+                continue;
+                }
+
+            Candidate candidate;
+            candidate.r_cut = r_cut;
+            candidate.order = order;
+            candidate.mesh = mesh;
+            candidate.kappa = kappa;
+            candidate.time = 0.0;
+            m_candidates.push_back(candidate);
+            }
+        }
+
+    if (m_candidates.size() == 0)
+        {
+        m_exec_conf->msg->error() << "tune.PPPM: no candidate reaches the target error " << m_target_error
+                                  << ", increase r_cut_max or the orders" << endl;
+        throw runtime_error("Error tuning PPPM");
+        }
+    }
+
+/*! \param candidate Parameters to set
+    \param timestep Current time step
+
+    Both the mesh and the short-ranged part take the same splitting parameter and cutoff. The mesh initialization
+    and the neighbor list rebuild after the cutoff changes fall into the next sample.
+*/
+void PPPMTuner::startSample(const Candidate& candidate, unsigned int timestep)
+    {
+    uint3 mesh = m_pppm->getMeshDimensions();
+    if (mesh.x != candidate.mesh.x || mesh.y != candidate.mesh.y || mesh.z != candidate.mesh.z
+        || m_pppm->getOrder() != candidate.order || m_pppm->getKappa() != candidate.kappa
+        || m_pppm->getRCut() != candidate.r_cut)
+        {
+        Scalar alpha = m_pppm->getAlpha();
+        m_pppm->setParams(candidate.mesh.x, candidate.mesh.y, candidate.mesh.z, candidate.order,
+                          candidate.kappa, candidate.r_cut, alpha);
+
+        PotentialPairEwald::param_type param;
+        param.kappa = candidate.kappa;
+        param.alpha = alpha;
+        unsigned int ntypes = m_pdata->getNTypes();
+        for (unsigned int i = 0; i < ntypes; i++)
+            for (unsigned int j = i; j < ntypes; j++)
+                {
+                m_ewald->setParams(i, j, param);
+                m_ewald->setRcut(i, j, candidate.r_cut);
+                }
+        }
+
+    m_last_timestep = timestep;
+    m_last_time = m_clk.getTime();
+    }
+
+/*! \param timestep Current time step of the simulation
+*/
+void PPPMTuner::update(unsigned int timestep)
+    {
+    if (m_state == IDLE)
+        {
+        Scalar volume = m_pdata->getGlobalBox().getVolume();
+        if (fabs(volume / m_tuned_volume - Scalar(1.0)) <= m_max_volume_change)
+            return;
+
+        m_exec_conf->msg->notice(4) << "tune.PPPM: box volume changed from " << m_tuned_volume << " to "
+                                    << volume << ", retuning" << endl;
+        m_state = STARTUP;
+        }
+
+    if (m_state == STARTUP)
+        {
+        findCandidates();
+        m_current = 0;
+        m_state = WARMUP;
+        startSample(m_candidates[0], timestep);
+        return;
+        }
+
+    // a sample needs at least one step
+    if (timestep <= m_last_timestep)
+        return;
+
+    double time_per_step = double(m_clk.getTime() - m_last_time) / 1e9 / double(timestep - m_last_timestep);
+#ifdef ENABLE_MPI
+    // all ranks must make the same choice, so the tuner acts on the slowest rank
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &time_per_step, 1, MPI_DOUBLE, MPI_MAX, m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    if (m_state == WARMUP)
+        {
+        m_state = MEASURE;
+        startSample(m_candidates[m_current], timestep);
+        return;
+        }
+
+    // MEASURE
+    Candidate& current = m_candidates[m_current];
+    current.time = time_per_step;
+    m_exec_conf->msg->notice(5) << "tune.PPPM: r_cut " << current.r_cut << ", order " << current.order
+                                << ", mesh " << current.mesh.x << "x" << current.mesh.y << "x" << current.mesh.z
+                                << ": " << time_per_step << " s/step" << endl;
+
+    m_current++;
+    if (m_current < m_candidates.size())
+        {
+        m_state = WARMUP;
+        startSample(m_candidates[m_current], timestep);
+        }
+    else
+        {
+        auto best = std::min_element(m_candidates.begin(), m_candidates.end(),
+                                     [](const Candidate& a, const Candidate& b) { return a.time < b.time; });
+        m_exec_conf->msg->notice(4) << "tune.PPPM: selected r_cut " << best->r_cut << ", order " << best->order
+                                    << ", mesh " << best->mesh.x << "x" << best->mesh.y << "x" << best->mesh.z
+                                    << ", kappa " << best->kappa << endl;
+        m_current = (unsigned int)(best - m_candidates.begin());
+        m_state = IDLE;
+        startSample(*best, timestep);
+        }
+    }
+
+pybind11::list PPPMTuner::getSampledCandidates()
+    {
+    pybind11::list result;
+    for (const auto& c : m_candidates)
+        result.append(py::make_tuple(c.r_cut, c.order, py::make_tuple(c.mesh.x, c.mesh.y, c.mesh.z), c.kappa,
+                                     c.time));
+    return result;
+    }
+
+void export_PPPMTuner(py::module& m)
+    {
+    py::class_<PPPMTuner, Tuner, std::shared_ptr<PPPMTuner> >(m, "PPPMTuner")
+    .def(py::init< std::shared_ptr<SystemDefinition>,
+                   std::shared_ptr<Trigger>,
+                   std::shared_ptr<PPPMForceCompute>,
+                   std::shared_ptr<PotentialPairEwald>,
+                   Scalar,
+                   Scalar,
+                   Scalar,
+                   unsigned int,
+                   pybind11::list,
+                   Scalar >())
+    .def("retune", &PPPMTuner::retune)
+    .def_property_readonly("complete", &PPPMTuner::isComplete)
+    .def_property_readonly("target_error", &PPPMTuner::getTargetError)
+    .def_property("max_volume_change", &PPPMTuner::getMaxVolumeChange, &PPPMTuner::setMaxVolumeChange)
+    .def_property_readonly("sampled_candidates", &PPPMTuner::getSampledCandidates)
+    ;
+    }
@@ -0,0 +1,152 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file PPPMTuner.h
+    \brief Declares a tuner that chooses the PPPM mesh, order, and cutoff for a target accuracy
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "hoomd/Tuner.h"
+#include "hoomd/ClockSource.h"
+#include "PPPMForceCompute.h"
+#include "AllPairPotentials.h"
+
+#include <memory>
+#include <vector>
+#include <pybind11/pybind11.h>
+
+#ifndef __PPPMTUNER_H__
+#define __PPPMTUNER_H__
+
+//! Chooses the cheapest PPPM parameters that reach a target RMS force error
+/*! PPPMTuner sets the mesh size, the interpolation order, the real space cutoff and the splitting parameter of a
+    PPPMForceCompute and the matching short-ranged PotentialPairEwald. For every cutoff in \a n_r_cut values spaced
+    evenly in [\a r_cut_min, \a r_cut_max] and every order in \a orders, it solves the analytic error estimate of
+    PPPMForceCompute::estimateError() for the splitting parameter that puts the real space error at the target and
+    then for the smallest mesh that puts the mesh error below it. The error estimate therefore balances accuracy, and
+    timing decides between the candidates: the cost of the neighbor list and pair sum grows with the cutoff and the
+    cost of charge assignment and FFTs with the order and mesh size in a way that depends on the hardware.
+
+    Like NeighborListBufferTuner, the tuner samples each candidate in turn and then sets the one with the shortest
+    wall clock time per step. The time between two successive calls to update() is one sample, so the Trigger period
+    sets the number of steps in each sample. Each candidate takes two samples, the first absorbs the mesh
+    initialization and the neighbor list rebuild after the cutoff changes and is discarded.
+
+    The error estimate depends on the box. After the scan, the tuner starts over when the box volume differs from the
+    volume it was tuned at by more than a fraction \a max_volume_change, for example after a BoxResizeUpdater or
+    under NPT. Call retune() to scan the candidates again at any time.
+
+    Meshes are products of powers of 2, 3, and 5. With a domain decomposition, they are powers of two that are
+    multiples of the processor grid, as PPPMForceCompute::setParams() requires.
+
+    \ingroup tuners
+*/
+class PYBIND11_EXPORT PPPMTuner : public Tuner
+    {
+    public:
+        //! Constructor
+        PPPMTuner(std::shared_ptr<SystemDefinition> sysdef,
+                  std::shared_ptr<Trigger> trigger,
+                  std::shared_ptr<PPPMForceCompute> pppm,
+                  std::shared_ptr<PotentialPairEwald> ewald,
+                  Scalar target_error,
+                  Scalar r_cut_min,
+                  Scalar r_cut_max,
+                  unsigned int n_r_cut,
+                  pybind11::list orders,
+                  Scalar max_volume_change);
+        virtual ~PPPMTuner();
+
+        //! Take one tuning step
+        virtual void update(unsigned int timestep);
+
+        //! Restart the scan over the candidates
+        void retune()
+            {
+            m_state = STARTUP;
+            }
+
+        //! Test if the scan is complete
+        bool isComplete()
+            {
+            return m_state == IDLE;
+            }
+
+        //! Get the target RMS force error
+        Scalar getTargetError()
+            {
+            return m_target_error;
+            }
+
+        //! Get the relative volume change that starts a new scan
+        Scalar getMaxVolumeChange()
+            {
+            return m_max_volume_change;
+            }
+
+        //! Set the relative volume change that starts a new scan
+        void setMaxVolumeChange(Scalar max_volume_change)
+            {
+            if (max_volume_change < 0)
+                throw std::domain_error("max_volume_change must be non-negative");
+            m_max_volume_change = max_volume_change;
+            }
+
+        //! Get the sampled candidates as a list of (r_cut, order, (nx, ny, nz), kappa, time per step) tuples
+        pybind11::list getSampledCandidates();
+
+    protected:
+        //! States of the tuning process
+        enum State
+            {
+            STARTUP,    //!< Start a new scan on the next call
+            WARMUP,     //!< Run the first sample of a candidate, which is discarded
+            MEASURE,    //!< Measure the time per step of a candidate
+            IDLE        //!< Scan complete, monitoring the box volume
+            };
+
+        //! A set of PPPM parameters that reaches the target error
+        struct Candidate
+            {
+            Scalar r_cut;           //!< Real space cutoff
+            unsigned int order;     //!< Interpolation order
+            uint3 mesh;             //!< Global number of mesh points
+            Scalar kappa;           //!< Splitting parameter
+            double time;            //!< Measured time per step, 0 when not sampled
+            };
+
+        std::shared_ptr<PPPMForceCompute> m_pppm;       //!< Mesh part to tune
+        std::shared_ptr<PotentialPairEwald> m_ewald;    //!< Short-ranged part to tune
+        Scalar m_target_error;                          //!< Target RMS force error
+        std::vector<Scalar> m_r_cuts;                   //!< Cutoff candidates
+        std::vector<unsigned int> m_orders;             //!< Order candidates
+        Scalar m_max_volume_change;                     //!< Relative volume change that starts a new scan
+        std::vector<Candidate> m_candidates;            //!< Candidates of the current scan
+
+        State m_state;                          //!< Current state
+        unsigned int m_current;                 //!< Index of the candidate currently being sampled
+        Scalar m_tuned_volume;                  //!< Box volume the candidates were computed for
+        unsigned int m_last_timestep;           //!< Time step of the previous call
+        int64_t m_last_time;                    //!< Wall clock time of the previous call
+        ClockSource m_clk;                      //!< Clock used to time the samples
+
+        //! Compute the candidates for the current box and charges
+        void findCandidates();
+
+        //! Find the smallest allowed mesh size along one direction that reaches the target error
+        unsigned int findMeshSize(unsigned int dim, unsigned int order, Scalar kappa, Scalar q2);
+
+        //! Set the parameters of a candidate and start a new sample
+        void startSample(const Candidate& candidate, unsigned int timestep);
+    };
+
+//! Export the PPPMTuner to python
+void export_PPPMTuner(pybind11::module& m);
+
+#endif
@@ -3,7 +3,7 @@
 
 #include <memory>
 #include "hoomd/ForceCompute.h"
-#include "hoomd/GPUArray.h"
+#include "hoomd/GlobalArray.h"
 
 #include <vector>
 
@@ -17,6 +17,12 @@
 
 #include <pybind11/pybind11.h>
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 #ifndef __POTENTIALBOND_H__
 #define __POTENTIALBOND_H__
 
@@ -46,6 +52,12 @@ class PotentialBond : public ForceCompute
         /// Get the parameters
         pybind11::dict getParams(std::string type);
 
+        /// Get the per type parameter array
+        const GlobalArray<param_type>& getParamsArray() const
+            {
+            return m_params;
+            }
+
         //! Returns a list of log quantities this compute calculates
         virtual std::vector< std::string > getProvidedLogQuantities();
 
@@ -61,13 +73,22 @@ class PotentialBond : public ForceCompute
         #endif
 
     protected:
-        GPUArray<param_type> m_params;              //!< Bond parameters per type
+        GlobalArray<param_type> m_params;           //!< Bond parameters per type
         std::shared_ptr<BondData> m_bond_data;    //!< Bond data to use in computing bonds
         std::string m_log_name;                     //!< Cached log name
         std::string m_prof_name;                    //!< Cached profiler name
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
+
+        //! Compute the forces of the bonds between local particles
+        virtual bool computeInteriorForces(unsigned int timestep);
+
+        //! Compute the forces of the bonds with ghost particles
+        virtual void computeBoundaryForces(unsigned int timestep);
+
+        //! Compute the forces of all bonds or of the interior or boundary ones
+        void computeBondForces(unsigned int timestep, bool interior, bool boundary);
     };
 
 /*! \param sysdef System to compute forces on
@@ -87,8 +108,15 @@ PotentialBond< evaluator >::PotentialBond(std::shared_ptr<SystemDefinition> sysd
     m_prof_name = std::string("Bond ") + evaluator::getName();
 
     // allocate the parameters
-    GPUArray<param_type> params(m_bond_data->getNTypes(), m_exec_conf);
+    GlobalArray<param_type> params(m_bond_data->getNTypes(), m_exec_conf);
     m_params.swap(params);
+
+    #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
+    if (m_exec_conf->isCUDAEnabled() && m_exec_conf->allConcurrentManagedAccess())
+        {
+        cudaMemAdvise(m_params.get(), m_params.getNumElements()*sizeof(param_type), cudaMemAdviseSetReadMostly, 0);
+        }
+    #endif
     }
 
 template< class evaluator >
@@ -188,6 +216,36 @@ Scalar PotentialBond< evaluator >::getLogValue(const std::string& quantity, unsi
  */
 template< class evaluator >
 void PotentialBond< evaluator >::computeForces(unsigned int timestep)
+    {
+    computeBondForces(timestep, true, true);
+    }
+
+/*! \param timestep Current time step
+    \returns true, the interior forces are always computed
+ */
+template< class evaluator >
+bool PotentialBond< evaluator >::computeInteriorForces(unsigned int timestep)
+    {
+    computeBondForces(timestep, true, false);
+    return true;
+    }
+
+/*! \param timestep Current time step
+ */
+template< class evaluator >
+void PotentialBond< evaluator >::computeBoundaryForces(unsigned int timestep)
+    {
+    computeBondForces(timestep, false, true);
+    }
+
+/*! \param timestep Current time step
+    \param interior Compute the bonds between two local particles
+    \param boundary Compute the bonds with at least one ghost particle
+
+    The interior pass starts from zero forces, the boundary pass adds to the existing ones.
+ */
+template< class evaluator >
+void PotentialBond< evaluator >::computeBondForces(unsigned int timestep, bool interior, bool boundary)
     {
     if (m_prof) m_prof->push(m_prof_name);
 
@@ -214,19 +272,20 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
     assert(h_charge.data);
 
     // Zero data for force calculation
-    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
-    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+    if (interior)
+        {
+        memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+        memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+        }
 
     // we are using the minimum image of the global box here
     // to ensure that ghosts are always correctly wrapped (even if a bond exceeds half the domain length)
     const BoxDim& box = m_pdata->getGlobalBox();
+    const bool three_d = m_sysdef->getNDimensions() == 3;
 
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor];
-
-    Scalar bond_virial[6];
-    for (unsigned int i = 0; i< 6; i++)
-        bond_virial[i]=Scalar(0.0);
+    bool compute_energy = flags[pdata_flag::potential_energy];
 
     ArrayHandle<typename BondData::members_t> h_bonds(m_bond_data->getMembersArray(), access_location::host, access_mode::read);
     ArrayHandle<typeval_t> h_typeval(m_bond_data->getTypeValArray(), access_location::host, access_mode::read);
@@ -236,8 +295,12 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
     // for each of the bonds
     const unsigned int size = (unsigned int)m_bond_data->getN();
 
-    for (unsigned int i = 0; i < size; i++)
+    // the box shape resolves the tilt and z terms of the minimum image at compile time
+    auto compute_bond = [&](unsigned int i, Scalar4 *force, Scalar *virial, size_t virial_pitch, auto shape)
         {
+        typedef decltype(shape) Shape;
+        Scalar bond_virial[6];
+
         // lookup the tag of each of the particles participating in the bond
         const typename BondData::members_t& bond = h_bonds.data[i];
         assert(bond.tag[0] < m_pdata->getMaximumTag()+1);
@@ -248,6 +311,11 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
         unsigned int idx_a = h_rtag.data[bond.tag[0]];
         unsigned int idx_b = h_rtag.data[bond.tag[1]];
 
+        // bonds with a ghost particle belong to the boundary pass, the ghost positions may still be in flight
+        bool is_interior = idx_a < m_pdata->getN() && idx_b < m_pdata->getN();
+        if (is_interior ? !interior : !boundary)
+            return;
+
         // throw an error if this bond is incomplete
         if (idx_a >= max_local || idx_b >= max_local)
             {
@@ -282,7 +350,7 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
             }
 
         // if the vector crosses the box, pull it back
-        dx = box.minImage(dx);
+        dx = box.minImage<Shape::triclinic, Shape::three_d>(dx);
 
         // calculate r_ab squared
         Scalar rsq = dot(dx,dx);
@@ -318,24 +386,26 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
             // add the force to the particles (only for non-ghost particles)
             if (idx_b < m_pdata->getN())
                 {
-                h_force.data[idx_b].x += force_divr * dx.x;
-                h_force.data[idx_b].y += force_divr * dx.y;
-                h_force.data[idx_b].z += force_divr * dx.z;
-                h_force.data[idx_b].w += bond_eng;
+                force[idx_b].x += force_divr * dx.x;
+                force[idx_b].y += force_divr * dx.y;
+                force[idx_b].z += force_divr * dx.z;
+                if (compute_energy)
+                    force[idx_b].w += bond_eng;
                 if (compute_virial)
                     for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i*m_virial_pitch+idx_b]  += bond_virial[i];
+                        virial[i*virial_pitch+idx_b]  += bond_virial[i];
                 }
 
             if (idx_a < m_pdata->getN())
                 {
-                h_force.data[idx_a].x -= force_divr * dx.x;
-                h_force.data[idx_a].y -= force_divr * dx.y;
-                h_force.data[idx_a].z -= force_divr * dx.z;
-                h_force.data[idx_a].w += bond_eng;
+                force[idx_a].x -= force_divr * dx.x;
+                force[idx_a].y -= force_divr * dx.y;
+                force[idx_a].z -= force_divr * dx.z;
+                if (compute_energy)
+                    force[idx_a].w += bond_eng;
                 if (compute_virial)
                     for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i*m_virial_pitch+idx_a]  += bond_virial[i];
+                        virial[i*virial_pitch+idx_a]  += bond_virial[i];
                 }
             }
         else
@@ -343,6 +413,67 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
             this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond out of bounds" << std::endl << std::endl;
             throw std::runtime_error("Error in bond calculation");
             }
+        };
+
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        // both particles of a bond receive a force, each thread accumulates into its own force and virial arrays
+        // which are summed up at the end
+        const unsigned int N = m_pdata->getN();
+        tbb::enumerable_thread_specific< std::vector<Scalar4> > thread_force(
+            std::vector<Scalar4>(N, make_scalar4(0,0,0,0)));
+        tbb::enumerable_thread_specific< std::vector<Scalar> > thread_virial(
+            std::vector<Scalar>(compute_virial ? 6*N : 0, Scalar(0.0)));
+
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, size),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            std::vector<Scalar4>& force = thread_force.local();
+            std::vector<Scalar>& virial = thread_virial.local();
+            dispatchBoxShape(box, three_d, [&](auto shape)
+                {
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                    compute_bond(i, force.data(), virial.data(), N, shape);
+                });
+            });
+
+        // reduce the per-thread arrays into the output, in parallel over particles
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (auto it_force = thread_force.begin(); it_force != thread_force.end(); ++it_force)
+                {
+                const std::vector<Scalar4>& force = *it_force;
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                    {
+                    h_force.data[i].x += force[i].x;
+                    h_force.data[i].y += force[i].y;
+                    h_force.data[i].z += force[i].z;
+                    h_force.data[i].w += force[i].w;
+                    }
+                }
+
+            if (compute_virial)
+                {
+                for (auto it_virial = thread_virial.begin(); it_virial != thread_virial.end(); ++it_virial)
+                    {
+                    const std::vector<Scalar>& virial = *it_virial;
+                    for (unsigned int l = 0; l < 6; ++l)
+                        for (unsigned int i = r.begin(); i != r.end(); ++i)
+                            h_virial.data[l*m_virial_pitch+i] += virial[l*N+i];
+                    }
+                }
+            });
+        }
+    else
+    #endif
+        {
+        dispatchBoxShape(box, three_d, [&](auto shape)
+            {
+            for (unsigned int i = 0; i < size; i++)
+                compute_bond(i, h_force.data, h_virial.data, m_virial_pitch, shape);
+            });
         }
 
     if (m_prof) m_prof->pop();
@@ -9,6 +9,7 @@
 #include "hoomd/ParticleData.cuh"
 #include "hoomd/Index1D.h"
 #include "hoomd/TextureTools.h"
+#include "hoomd/GPUPartition.cuh"
 
 #include "hoomd/BondedGroupData.cuh"
 
@@ -38,7 +39,10 @@ struct bond_args_t
               const Index2D & _gpu_table_indexer,
               const unsigned int *_d_gpu_n_bonds,
               const unsigned int _n_bond_types,
-              const unsigned int _block_size)
+              const unsigned int _block_size,
+              const unsigned int _compute_virial,
+              const unsigned int _compute_energy,
+              const GPUPartition& _gpu_partition)
                 : d_force(_d_force),
                   d_virial(_d_virial),
                   virial_pitch(_virial_pitch),
@@ -52,7 +56,10 @@ struct bond_args_t
                   gpu_table_indexer(_gpu_table_indexer),
                   d_gpu_n_bonds(_d_gpu_n_bonds),
                   n_bond_types(_n_bond_types),
-                  block_size(_block_size)
+                  block_size(_block_size),
+                  compute_virial(_compute_virial),
+                  compute_energy(_compute_energy),
+                  gpu_partition(_gpu_partition)
         {
         };
 
@@ -70,6 +77,9 @@ struct bond_args_t
     const unsigned int *d_gpu_n_bonds; //!< List of number of bonds stored on the GPU
     const unsigned int n_bond_types;   //!< Number of bond types in the simulation
     const unsigned int block_size;     //!< Block size to execute
+    const unsigned int compute_virial; //!< Flag to indicate if virials should be computed
+    const unsigned int compute_energy; //!< Flag to indicate if the potential energy should be computed
+    const GPUPartition& gpu_partition; //!< The load balancing partition of particles between GPUs
     };
 
 #ifdef __HIPCC__
@@ -81,7 +91,8 @@ struct bond_args_t
     \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
     \param virial_pitch pitch of 2D virial array
-    \param N Number of particles in the system
+    \param N Number of particles to compute forces on
+    \param offset Index of the first particle this GPU operates on
     \param d_pos particle positions on the GPU
     \param d_charge particle charges
     \param d_diameter particle diameters
@@ -96,13 +107,15 @@ struct bond_args_t
 
     Certain options are controlled via template parameters to avoid the performance hit when they are not enabled.
     \tparam evaluator EvaluatorBond class to evaluate V(r) and -delta V(r)/r
-
+    \tparam compute_virial When non-zero, the virial tensor is computed. When zero, the virial tensor is not written.
+    \tparam compute_energy When non-zero, the potential energy is computed. When zero, force.w is written as zero.
 */
-template< class evaluator >
+template< class evaluator, unsigned int compute_virial, unsigned int compute_energy >
 __global__ void gpu_compute_bond_forces_kernel(Scalar4 *d_force,
                                                Scalar *d_virial,
                                                const size_t virial_pitch,
                                                const unsigned int N,
+                                               const unsigned int offset,
                                                const Scalar4 *d_pos,
                                                const Scalar *d_charge,
                                                const Scalar *d_diameter,
@@ -136,6 +149,8 @@ __global__ void gpu_compute_bond_forces_kernel(Scalar4 *d_force,
     if (idx >= N)
         return;
 
+    idx += offset;
+
     // load in the length of the list for this thread (MEM TRANSFER: 4 bytes)
     int n_bonds =n_bonds_list[idx];
 
@@ -213,20 +228,24 @@ __global__ void gpu_compute_bond_forces_kernel(Scalar4 *d_force,
         if (evaluated)
             {
             // add up the virial (double counting, multiply by 0.5)
-            Scalar force_div2r = force_divr/Scalar(2.0);
-            virial[0] += dx.x * dx.x * force_div2r; // xx
-            virial[1] += dx.x * dx.y * force_div2r; // xy
-            virial[2] += dx.x * dx.z * force_div2r; // xz
-            virial[3] += dx.y * dx.y * force_div2r; // yy
-            virial[4] += dx.y * dx.z * force_div2r; // yz
-            virial[5] += dx.z * dx.z * force_div2r; // zz
+            if (compute_virial)
+                {
+                Scalar force_div2r = force_divr/Scalar(2.0);
+                virial[0] += dx.x * dx.x * force_div2r; // xx
+                virial[1] += dx.x * dx.y * force_div2r; // xy
+                virial[2] += dx.x * dx.z * force_div2r; // xz
+                virial[3] += dx.y * dx.y * force_div2r; // yy
+                virial[4] += dx.y * dx.z * force_div2r; // yz
+                virial[5] += dx.z * dx.z * force_div2r; // zz
+                }
 
             // add up the forces
             force.x += dx.x * force_divr;
             force.y += dx.y * force_divr;
             force.z += dx.z * force_divr;
             // energy is double counted: multiply by 0.5
-            force.w += bond_eng * Scalar(0.5);
+            if (compute_energy)
+                force.w += bond_eng * Scalar(0.5);
             }
         else
             {
@@ -238,11 +257,61 @@ __global__ void gpu_compute_bond_forces_kernel(Scalar4 *d_force,
     // now that the force calculation is complete, write out the result (MEM TRANSFER: 20 bytes);
     d_force[idx] = force;
 
-    for (unsigned int i = 0; i < 6 ; i++)
-        d_virial[i*virial_pitch + idx] = virial[i];
+    if (compute_virial)
+        {
+        for (unsigned int i = 0; i < 6 ; i++)
+            d_virial[i*virial_pitch + idx] = virial[i];
+        }
+    }
+
+//! Launch the bond force kernel
+/*! \param bond_args Other arguments to pass onto the kernel
+    \param d_params Parameters for the potential, stored per bond type
+    \param d_flags flags on the device - a 1 will be written if evaluation
+                   of forces failed for any bond
+
+    \tparam compute_virial When non-zero, the virial tensor is computed
+    \tparam compute_energy When non-zero, the potential energy is computed
+*/
+template< class evaluator, unsigned int compute_virial, unsigned int compute_energy >
+void gpu_launch_bond_forces_kernel(const bond_args_t& bond_args,
+                                   const typename evaluator::param_type *d_params,
+                                   unsigned int *d_flags)
+    {
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(
+            &gpu_compute_bond_forces_kernel<evaluator, compute_virial, compute_energy>));
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(bond_args.block_size, max_block_size);
+
+    unsigned int shared_bytes = (unsigned int)(sizeof(typename evaluator::param_type) *
+                                bond_args.n_bond_types);
+
+    // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
+    for (int idev = bond_args.gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = bond_args.gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+
+        // setup the grid to run the kernel
+        dim3 grid( nwork / run_block_size + 1, 1, 1);
+        dim3 threads(run_block_size, 1, 1);
+
+        // run the kernel
+        hipLaunchKernelGGL((gpu_compute_bond_forces_kernel<evaluator, compute_virial, compute_energy>),
+            grid, threads, shared_bytes, 0,
+            bond_args.d_force, bond_args.d_virial, bond_args.virial_pitch, nwork, range.first,
+            bond_args.d_pos, bond_args.d_charge, bond_args.d_diameter, bond_args.box, bond_args.d_gpu_bondlist,
+            bond_args.gpu_table_indexer, bond_args.d_gpu_n_bonds, bond_args.n_bond_types, d_params, d_flags);
+        }
     }
 
-#include <iostream>
 //! Kernel driver that computes lj forces on the GPU for LJForceComputeGPU
 /*! \param bond_args Other arguments to pass onto the kernel
     \param d_params Parameters for the potential, stored per bond type
@@ -262,28 +331,20 @@ hipError_t gpu_compute_bond_forces(const bond_args_t& bond_args,
     // check that block_size is valid
     assert(bond_args.block_size != 0);
 
-    static unsigned int max_block_size = UINT_MAX;
-    if (max_block_size == UINT_MAX)
+    if (bond_args.compute_virial)
         {
-        hipFuncAttributes attr;
-        hipFuncGetAttributes(&attr,reinterpret_cast<const void*>(&gpu_compute_bond_forces_kernel<evaluator>));
-        max_block_size = attr.maxThreadsPerBlock;
+        if (bond_args.compute_energy)
+            gpu_launch_bond_forces_kernel<evaluator, 1, 1>(bond_args, d_params, d_flags);
+        else
+            gpu_launch_bond_forces_kernel<evaluator, 1, 0>(bond_args, d_params, d_flags);
+        }
+    else
+        {
+        if (bond_args.compute_energy)
+            gpu_launch_bond_forces_kernel<evaluator, 0, 1>(bond_args, d_params, d_flags);
+        else
+            gpu_launch_bond_forces_kernel<evaluator, 0, 0>(bond_args, d_params, d_flags);
         }
-
-    unsigned int run_block_size = min(bond_args.block_size, max_block_size);
-
-    // setup the grid to run the kernel
-    dim3 grid( bond_args.N / run_block_size + 1, 1, 1);
-    dim3 threads(run_block_size, 1, 1);
-
-    unsigned int shared_bytes = (unsigned int)(sizeof(typename evaluator::param_type) *
-                                bond_args.n_bond_types);
-
-    // run the kernel
-    hipLaunchKernelGGL(gpu_compute_bond_forces_kernel<evaluator>, grid, threads, shared_bytes, 0,
-        bond_args.d_force, bond_args.d_virial, bond_args.virial_pitch, bond_args.N,
-        bond_args.d_pos, bond_args.d_charge, bond_args.d_diameter, bond_args.box, bond_args.d_gpu_bondlist,
-        bond_args.gpu_table_indexer, bond_args.d_gpu_n_bonds, bond_args.n_bond_types, d_params, d_flags);
 
     return hipSuccess;
     }
@@ -55,10 +55,16 @@ class PotentialBondGPU : public PotentialBond<evaluator>
 
     protected:
         std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
-        GPUArray<unsigned int> m_flags;       //!< Flags set during the kernel execution
+        GlobalArray<unsigned int> m_flags;    //!< Flags set during the kernel execution
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
+
+        //! The GPU kernels compute the forces on all particles at once
+        virtual bool computeInteriorForces(unsigned int timestep)
+            {
+            return false;
+            }
     };
 
 template< class evaluator, hipError_t gpu_cgbf(const bond_args_t& bond_args,
@@ -75,12 +81,8 @@ PotentialBondGPU< evaluator, gpu_cgbf >::PotentialBondGPU(std::shared_ptr<System
         throw std::runtime_error("Error initializing PotentialBondGPU");
         }
 
-    // allocate and zero device memory
-    GPUArray<typename evaluator::param_type> params(this->m_bond_data->getNTypes(), this->m_exec_conf);
-    this->m_params.swap(params);
-
     // allocate flags storage on the GPU
-    GPUArray<unsigned int> flags(1, this->m_exec_conf);
+    GlobalArray<unsigned int> flags(1, this->m_exec_conf);
     m_flags.swap(flags);
 
     // reset flags
@@ -115,8 +117,11 @@ void PotentialBondGPU< evaluator, gpu_cgbf >::computeForces(unsigned int timeste
     ArrayHandle<Scalar4> d_force(this->m_force, access_location::device, access_mode::readwrite);
     ArrayHandle<Scalar> d_virial(this->m_virial, access_location::device, access_mode::readwrite);
 
+    // access flags
+    PDataFlags flags = this->m_pdata->getFlags();
+
         {
-        const GPUArray<typename BondData::members_t>& gpu_bond_list = this->m_bond_data->getGPUTable();
+        const GlobalArray<typename BondData::members_t>& gpu_bond_list = this->m_bond_data->getGPUTable();
         const Index2D& gpu_table_indexer = this->m_bond_data->getGPUTableIndexer();
 
         ArrayHandle<typename BondData::members_t> d_gpu_bondlist(gpu_bond_list, access_location::device, access_mode::read);
@@ -126,6 +131,8 @@ void PotentialBondGPU< evaluator, gpu_cgbf >::computeForces(unsigned int timeste
         // access the flags array for overwriting
         ArrayHandle<unsigned int> d_flags(m_flags, access_location::device, access_mode::readwrite);
 
+        this->m_exec_conf->beginMultiGPU();
+
         this->m_tuner->begin();
         gpu_cgbf(bond_args_t(d_force.data,
                              d_virial.data,
@@ -140,9 +147,14 @@ void PotentialBondGPU< evaluator, gpu_cgbf >::computeForces(unsigned int timeste
                              gpu_table_indexer,
                              d_gpu_n_bonds.data,
                              this->m_bond_data->getNTypes(),
-                             this->m_tuner->getParam()),
+                             this->m_tuner->getParam(),
+                             flags[pdata_flag::pressure_tensor],
+                             flags[pdata_flag::potential_energy],
+                             this->m_pdata->getGPUPartition()),
                  d_params.data,
                  d_flags.data);
+
+        this->m_exec_conf->endMultiGPU();
         }
 
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
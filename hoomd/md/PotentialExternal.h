@@ -53,10 +53,23 @@ class PotentialExternal: public ForceCompute
         GPUArray<param_type>    m_params;        //!< Array of per-type parameters
         std::string             m_log_name;               //!< Cached log name
         GPUArray<field_type>    m_field;
+        bool                    m_field_changed;  //!< True when the field must be updated for new parameters
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
+        //! Let the evaluator update the field after the field or the parameters change
+        void updateField()
+            {
+            if (!m_field_changed)
+                return;
+
+            ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
+            ArrayHandle<field_type> h_field(m_field, access_location::host, access_mode::readwrite);
+            evaluator::updateField(*h_field.data, h_params.data, m_pdata->getNTypes(), m_pdata->getGlobalBox());
+            m_field_changed = false;
+            }
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange()
             {
@@ -69,6 +82,7 @@ class PotentialExternal: public ForceCompute
             // reallocate parameter array
             GPUArray<param_type> params(m_pdata->getNTypes(), m_exec_conf);
             m_params.swap(params);
+            m_field_changed = true;
             }
    };
 
@@ -79,7 +93,7 @@ class PotentialExternal: public ForceCompute
 template<class evaluator>
 PotentialExternal<evaluator>::PotentialExternal(std::shared_ptr<SystemDefinition> sysdef,
                          const std::string& log_suffix)
-    : ForceCompute(sysdef)
+    : ForceCompute(sysdef), m_field_changed(true)
     {
     m_log_name = std::string("external_") + evaluator::getName() + std::string("_energy") + log_suffix;
 
@@ -140,6 +154,8 @@ void PotentialExternal<evaluator>::computeForces(unsigned int timestep)
     if (m_prof) m_prof->push("PotentialExternal");
 
     assert(m_pdata);
+    updateField();
+
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
 
@@ -230,6 +246,7 @@ void PotentialExternal<evaluator>::setParams(unsigned int type, param_type param
 
     ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::readwrite);
     h_params.data[type] = params;
+    m_field_changed = true;
     }
 
 template<class evaluator>
@@ -237,6 +254,7 @@ void PotentialExternal<evaluator>::setField(field_type field)
     {
     ArrayHandle<field_type> h_field(m_field, access_location::host, access_mode::overwrite);
     *(h_field.data) = field;
+    m_field_changed = true;
     }
 
 //! Export this external potential to python
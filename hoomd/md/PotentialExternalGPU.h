@@ -73,6 +73,8 @@ void PotentialExternalGPU<evaluator>::computeForces(unsigned int timestep)
     // start the profile
     if (this->m_prof) this->m_prof->push(this->m_exec_conf, "PotentialExternalGPU");
 
+    this->updateField();
+
     // access the particle data
     ArrayHandle<Scalar4> d_pos(this->m_pdata->getPositions(), access_location::device, access_mode::read);
     ArrayHandle<Scalar> d_diameter(this->m_pdata->getDiameters(), access_location::device, access_mode::read);
@@ -10,6 +10,8 @@
 #include <iostream>
 #include <stdexcept>
 #include <memory>
+#include <type_traits>
+#include <vector>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 
@@ -18,6 +20,7 @@
 #include "hoomd/GlobalArray.h"
 #include "hoomd/ForceCompute.h"
 #include "NeighborList.h"
+#include "NeighborListDelta.h"
 #include "hoomd/GSDShapeSpecWriter.h"
 #include "hoomd/md/EvaluatorPairLJ.h"
 
@@ -29,6 +32,12 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 
 /*! \file PotentialPair.h
     \brief Defines the template class for standard pair potentials
@@ -40,6 +49,193 @@
 #error This header cannot be compiled by nvcc
 #endif
 
+namespace detail
+{
+//! Number of neighbors that PotentialPair gathers and evaluates at once on the CPU
+const unsigned int pair_batch_size = 16;
+
+//! Detect whether an evaluator provides the static method evalForceAndEnergyBatch()
+template<class evaluator, class Enable = void>
+struct has_batch_eval : std::false_type
+    {
+    };
+
+//! Specialization for evaluators that provide evalForceAndEnergyBatch()
+template<class evaluator>
+struct has_batch_eval<evaluator, decltype(void(&evaluator::evalForceAndEnergyBatch))> : std::true_type
+    {
+    };
+
+//! Evaluate a batch of pairs with the batched evaluator interface
+/*! \param n Number of pairs in the batch
+    \param rsq Squared distance of each pair
+    \param rcutsq Squared cutoff radius of each pair
+    \param params Per type pair parameters
+    \param typpair Index into \a params for each pair
+    \param di Diameter of particle i of each pair (unused)
+    \param dj Diameter of particle j of each pair (unused)
+    \param qi Charge of particle i of each pair (unused)
+    \param qj Charge of particle j of each pair (unused)
+    \param energy_shift Whether to shift the energy of each pair
+    \param force_divr Output force divided by r of each pair
+    \param pair_eng Output energy of each pair
+    \param evaluated Output flag of each pair, true when it is evaluated
+*/
+template<class evaluator>
+inline void evalPairBatch(std::true_type,
+                          unsigned int n,
+                          const Scalar *rsq,
+                          const Scalar *rcutsq,
+                          const typename evaluator::param_type *params,
+                          const unsigned int *typpair,
+                          const Scalar *di,
+                          const Scalar *dj,
+                          const Scalar *qi,
+                          const Scalar *qj,
+                          const bool *energy_shift,
+                          Scalar *force_divr,
+                          Scalar *pair_eng,
+                          bool *evaluated)
+    {
+    evaluator::evalForceAndEnergyBatch(n, rsq, rcutsq, params, typpair, energy_shift, force_divr, pair_eng, evaluated);
+    }
+
+//! Evaluate a batch of pairs one at a time for evaluators without a batched interface
+/*! See the batched overload for the description of the parameters.
+*/
+template<class evaluator>
+inline void evalPairBatch(std::false_type,
+                          unsigned int n,
+                          const Scalar *rsq,
+                          const Scalar *rcutsq,
+                          const typename evaluator::param_type *params,
+                          const unsigned int *typpair,
+                          const Scalar *di,
+                          const Scalar *dj,
+                          const Scalar *qi,
+                          const Scalar *qj,
+                          const bool *energy_shift,
+                          Scalar *force_divr,
+                          Scalar *pair_eng,
+                          bool *evaluated)
+    {
+    for (unsigned int k = 0; k < n; k++)
+        {
+        force_divr[k] = Scalar(0.0);
+        pair_eng[k] = Scalar(0.0);
+        evaluator eval(rsq[k], rcutsq[k], params[typpair[k]]);
+        if (evaluator::needsDiameter())
+            eval.setDiameter(di[k], dj[k]);
+        if (evaluator::needsCharge())
+            eval.setCharge(qi[k], qj[k]);
+
+        evaluated[k] = eval.evalForceAndEnergy(force_divr[k], pair_eng[k], energy_shift[k]);
+        }
+    }
+
+//! Apply XPLOR smoothing to a pair force and energy
+/*! \param rsq Squared distance between the particles
+    \param rcutsq Squared cutoff radius
+    \param ronsq Squared radius at which the smoothing starts
+    \param force_divr Force divided by r, modified in place
+    \param pair_eng Pair energy, modified in place
+*/
+inline void applyXPLORSmoothing(Scalar rsq, Scalar rcutsq, Scalar ronsq, Scalar& force_divr, Scalar& pair_eng)
+    {
+    if (rsq >= ronsq && rsq < rcutsq)
+        {
+        // Implement XPLOR smoothing (FLOPS: 16)
+        Scalar old_pair_eng = pair_eng;
+        Scalar old_force_divr = force_divr;
+
+        // calculate 1.0 / (xplor denominator)
+        Scalar xplor_denom_inv =
+            Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+
+        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq *
+                   (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
+        Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+
+        // make modifications to the old pair energy and force
+        pair_eng = old_pair_eng * s;
+        // note: I'm not sure why the minus sign needs to be there: my notes have a +
+        // But this is verified correct via plotting
+        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+        }
+    }
+
+//! Compile time options of the CPU pair force loop
+/*! \tparam _shift_mode Energy shift mode (PotentialPair::energyShiftMode)
+    \tparam _compute_virial Accumulate the virial
+    \tparam _third_law Apply the force to both particles of each pair (half neighbor list)
+    \tparam _compute_energy Accumulate the potential energy
+*/
+template<unsigned int _shift_mode, bool _compute_virial, bool _third_law, bool _compute_energy>
+struct PairComputeMode
+    {
+    static constexpr unsigned int shift_mode = _shift_mode;
+    static constexpr bool compute_virial = _compute_virial;
+    static constexpr bool third_law = _third_law;
+    static constexpr bool compute_energy = _compute_energy;
+    };
+
+//! Call \a f with the PairComputeMode that matches the given runtime options
+/*! The options are resolved one at a time, each level instantiates both values of one option.
+*/
+template<unsigned int shift_mode, bool compute_virial, bool third_law, class Function>
+inline void dispatchPairComputeMode(bool compute_energy, Function&& f)
+    {
+    if (compute_energy)
+        f(PairComputeMode<shift_mode, compute_virial, third_law, true>());
+    else
+        f(PairComputeMode<shift_mode, compute_virial, third_law, false>());
+    }
+
+//! Resolve the third law option
+template<unsigned int shift_mode, bool compute_virial, class Function>
+inline void dispatchPairComputeMode(bool third_law, bool compute_energy, Function&& f)
+    {
+    if (third_law)
+        dispatchPairComputeMode<shift_mode, compute_virial, true>(compute_energy, f);
+    else
+        dispatchPairComputeMode<shift_mode, compute_virial, false>(compute_energy, f);
+    }
+
+//! Resolve the virial option
+template<unsigned int shift_mode, class Function>
+inline void dispatchPairComputeMode(bool compute_virial, bool third_law, bool compute_energy, Function&& f)
+    {
+    if (compute_virial)
+        dispatchPairComputeMode<shift_mode, true>(third_law, compute_energy, f);
+    else
+        dispatchPairComputeMode<shift_mode, false>(third_law, compute_energy, f);
+    }
+
+//! Resolve the shift mode (0: no shift, 1: shift, 2: xplor)
+template<class Function>
+inline void dispatchPairComputeMode(unsigned int shift_mode,
+                                    bool compute_virial,
+                                    bool third_law,
+                                    bool compute_energy,
+                                    Function&& f)
+    {
+    switch (shift_mode)
+        {
+        case 1:
+            dispatchPairComputeMode<1>(compute_virial, third_law, compute_energy, f);
+            break;
+        case 2:
+            dispatchPairComputeMode<2>(compute_virial, third_law, compute_energy, f);
+            break;
+        default:
+            dispatchPairComputeMode<0>(compute_virial, third_law, compute_energy, f);
+            break;
+        }
+    }
+
+} // end namespace detail
+
 //! Template class for computing pair potentials
 /*! <b>Overview:</b>
     PotentialPair computes standard pair potentials (and forces) between all particle pairs in the simulation. It
@@ -83,6 +279,28 @@
     the evaluator. Perhaps in the future we could allow users to change that so multiple pair potentials could be logged
     independently.
 
+    In builds with TBB, computeForces() distributes the particle loop over the available threads. With a full
+    neighbor list, each particle only writes its own force and no reduction is needed. With a half neighbor list,
+    every thread accumulates forces and virials in private arrays that are summed at the end. When only a single
+    thread is active, the serial loop is used so that results are identical to non-TBB builds.
+
+    In MPI simulations, the force computation can be split around the ghost update (see
+    ForceCompute::computeInterior()). computeInteriorForces() processes the particles whose neighbors
+    are all local, and computeBoundaryForces() the ones with ghost neighbors. The split is determined once after each
+    full computation, which happens whenever particles migrate and the neighbor list is rebuilt.
+
+    The neighbors of each particle are processed in batches of detail::pair_batch_size. The pair geometry of the batch
+    is gathered first, then all pairs are evaluated, then the forces are accumulated. Evaluators that provide a static
+    evalForceAndEnergyBatch() method (see EvaluatorPairLJ) evaluate the whole batch with one branch-free loop that the
+    compiler can vectorize. Other evaluators are called once per pair. The separations are computed from the
+    structure-of-arrays copy of the positions (ParticleData::getPositionsSoA()), which is gathered at the start of
+    each computation. computeBoundaryForces() only gathers the ghost positions again.
+
+    The shift mode, the virial and energy flags (pdata_flag::pressure_tensor and pdata_flag::potential_energy), and the
+    neighbor list storage mode are fixed for a whole computation. The CPU loop is instantiated for every combination
+    of them (detail::PairComputeMode) and the matching instance is selected once per call, so that the pair loop has
+    no branches on them. When the energy is not requested, it is not accumulated.
+
     \sa export_PotentialPair()
 */
 template < class evaluator >
@@ -198,6 +416,13 @@ class PotentialPair : public ForceCompute
         Scalar computeEnergyBetweenSetsPythonList(  pybind11::array_t<int, pybind11::array::c_style> tags1,
                                                     pybind11::array_t<int, pybind11::array::c_style> tags2);
 
+        //! Define the two sets of particles that computeSetEnergy() uses
+        void setEnergySets(pybind11::array_t<unsigned int, pybind11::array::c_style | pybind11::array::forcecast> tags1,
+                           pybind11::array_t<unsigned int, pybind11::array::c_style | pybind11::array::forcecast> tags2);
+
+        //! Compute the energy between the two energy sets with the neighbor list
+        virtual Scalar computeSetEnergy(unsigned int timestep);
+
         std::vector<std::string> getTypeShapeMapping(const GlobalArray<param_type> &params) const
             {
             ArrayHandle<param_type> h_params(params, access_location::host, access_mode::read);
@@ -226,9 +451,31 @@ class PotentialPair : public ForceCompute
         /// r_cut (not squared) given to the neighbor list
         std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist;
 
+        std::vector<unsigned int> m_interior_items; //!< Particles with only local neighbors
+        std::vector<unsigned int> m_boundary_items; //!< Particles with ghost neighbors
+        bool m_split_valid = false;                 //!< True when m_interior_items and m_boundary_items are current
+
+        GlobalArray<unsigned int> m_set_membership; //!< Energy sets of each tag (bit 0: set 1, bit 1: set 2)
+        bool m_set_ghost_tags_valid = false;        //!< True when the ghost particles carry their tags
+
+        //! Update the neighbor list and the ghost particle tags for computeSetEnergy()
+        void prepareSetEnergy(unsigned int timestep);
+
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
+        //! Compute the forces on the particles that have only local neighbors
+        virtual bool computeInteriorForces(unsigned int timestep);
+
+        //! Compute the forces on the particles that have ghost neighbors
+        virtual void computeBoundaryForces(unsigned int timestep);
+
+        //! Compute the forces on all particles or on the interior or boundary ones
+        void computePairForces(unsigned int timestep, bool interior, bool boundary);
+
+        //! Sort the particles into m_interior_items and m_boundary_items
+        void splitItems();
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange()
             {
@@ -604,8 +851,76 @@ Scalar PotentialPair< evaluator >::getLogValue(const std::string& quantity, unsi
 template< class evaluator >
 void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     {
-    // start by updating the neighborlist
-    m_nlist->compute(timestep);
+    computePairForces(timestep, true, true);
+    }
+
+/*! \param timestep specifies the current time step of the simulation
+    \returns true, the interior forces are always computed
+*/
+template< class evaluator >
+bool PotentialPair< evaluator >::computeInteriorForces(unsigned int timestep)
+    {
+    computePairForces(timestep, true, false);
+    return true;
+    }
+
+/*! \param timestep specifies the current time step of the simulation
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::computeBoundaryForces(unsigned int timestep)
+    {
+    computePairForces(timestep, false, true);
+    }
+
+/*! Ghost particles have indices >= N, so an item is in the interior when all of its neighbors are below N. The split
+    is only valid until the neighbor list is rebuilt.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::splitItems()
+    {
+    const unsigned int N = m_pdata->getN();
+
+    m_interior_items.clear();
+    m_boundary_items.clear();
+
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        bool interior = true;
+        const unsigned int myHead = h_head_list.data[i];
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+            {
+            if (h_nlist.data[myHead + k] >= N)
+                {
+                interior = false;
+                break;
+                }
+            }
+
+        if (interior)
+            m_interior_items.push_back(i);
+        else
+            m_boundary_items.push_back(i);
+        }
+
+    m_split_valid = true;
+    }
+
+/*! \param timestep specifies the current time step of the simulation
+    \param interior Compute the forces on the particles that have only local neighbors
+    \param boundary Compute the forces on the particles that have ghost neighbors
+
+    The interior pass starts from zero forces, the boundary pass adds to the existing ones.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::computePairForces(unsigned int timestep, bool interior, bool boundary)
+    {
+    // start by updating the neighborlist, it is not rebuilt while a ghost update is in flight
+    if (interior)
+        m_nlist->compute(timestep);
 
     // start the profile for this compute
     if (m_prof) m_prof->push(m_prof_name);
@@ -614,205 +929,420 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
 
+    // type segments let particles skip the neighbor types this potential does not interact with
+    const bool use_type_segments = m_nlist->getTypeSegments();
+    const Index2D& type_head_indexer = m_nlist->getTypeHeadIndexer();
+    const unsigned int ntypes = m_pdata->getNTypes();
+
     // access the neighbor list, particle data, and system box
     ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
 //     Index2D nli = m_nlist->getNListIndexer();
     ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
 
-    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_type_head(m_nlist->getTypeHeadList(), access_location::host, access_mode::read);
+
+    // the 16-bit deltas halve the bytes read from the list when the neighbor list provides them
+    const bool use_delta = m_nlist->getCompressedIndices();
+    ArrayHandle<short> h_nlist_delta(m_nlist->getNListDeltaArray(), access_location::host, access_mode::read);
+
+    // read the positions by component, so that the pair geometry is computed from contiguous rows
+    // the local positions do not change between the interior and the boundary part
+    const GlobalArray<Scalar>& pos_soa = m_pdata->getPositionsSoA(interior ? 0 : m_pdata->getN());
+    ArrayHandle<Scalar> h_pos_soa(pos_soa, access_location::host, access_mode::read);
+    const Scalar *h_x = h_pos_soa.data;
+    const Scalar *h_y = h_pos_soa.data + pos_soa.getPitch();
+    const Scalar *h_z = h_pos_soa.data + 2*pos_soa.getPitch();
+    const Scalar *h_type = h_pos_soa.data + 3*pos_soa.getPitch();
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
 
     //force arrays
-    ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar>  h_virial(m_virial,access_location::host, access_mode::overwrite);
+    access_mode::Enum force_mode = interior ? access_mode::overwrite : access_mode::readwrite;
+    ArrayHandle<Scalar4> h_force(m_force,access_location::host, force_mode);
+    ArrayHandle<Scalar>  h_virial(m_virial,access_location::host, force_mode);
 
 
     const BoxDim& box = m_pdata->getGlobalBox();
+    const bool three_d = m_sysdef->getNDimensions() == 3;
     ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
     ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
 
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor];
+    bool compute_energy = flags[pdata_flag::potential_energy];
 
     // need to start from a zero force, energy and virial
-    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
-    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
-
-    // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
+    if (interior)
         {
-        // access the particle's position and type (MEM TRANSFER: 4 scalars)
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
+        memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+        memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+        }
 
-        // access diameter and charge (if needed)
-        Scalar di = Scalar(0.0);
-        Scalar qi = Scalar(0.0);
-        if (evaluator::needsDiameter())
-            di = h_diameter.data[i];
-        if (evaluator::needsCharge())
-            qi = h_charge.data[i];
+    const unsigned int N = m_pdata->getN();
 
-        // initialize current particle force, potential energy, and virial to 0
-        Scalar3 fi = make_scalar3(0, 0, 0);
-        Scalar pei = 0.0;
-        Scalar virialxxi = 0.0;
-        Scalar virialxyi = 0.0;
-        Scalar virialxzi = 0.0;
-        Scalar virialyyi = 0.0;
-        Scalar virialyzi = 0.0;
-        Scalar virialzzi = 0.0;
-
-        // loop over all of the neighbors of this particle
-        const unsigned int myHead = h_head_list.data[i];
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int k = 0; k < size; k++)
+    // the loop is instantiated for each combination of the shift mode, virial, third law, and energy options, so
+    // that the options are resolved once per call instead of for every pair
+    auto compute_forces = [&](auto mode)
+        {
+        typedef decltype(mode) Mode;
+
+        // evaluate a batch of pairs (i, batch_j[l]) and accumulate the results
+        // the force, energy and virial on particle i are summed into fi, pei and virial_i
+        // the force on particle batch_j[l] is written to the output arrays when using the third law
+        auto compute_batch = [&](unsigned int i,
+                                 unsigned int n_batch,
+                                 const unsigned int *batch_j,
+                                 Scalar3& fi,
+                                 Scalar& pei,
+                                 Scalar *virial_i,
+                                 Scalar4 *force,
+                                 Scalar *virial,
+                                 size_t virial_pitch)
             {
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int j = h_nlist.data[myHead + k];
-            assert(j < m_pdata->getN() + m_pdata->getNGhosts());
-
-            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-            Scalar3 dx = pi - pj;
-
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
-            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
-            assert(typej < m_pdata->getNTypes());
-
-            // access diameter and charge (if needed)
-            Scalar dj = Scalar(0.0);
-            Scalar qj = Scalar(0.0);
-            if (evaluator::needsDiameter())
-                dj = h_diameter.data[j];
-            if (evaluator::needsCharge())
-                qj = h_charge.data[j];
-
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
+            Scalar3 batch_dx[detail::pair_batch_size];
+            Scalar batch_rsq[detail::pair_batch_size];
+            Scalar batch_rcutsq[detail::pair_batch_size];
+            Scalar batch_ronsq[detail::pair_batch_size];
+            Scalar batch_di[detail::pair_batch_size];
+            Scalar batch_dj[detail::pair_batch_size];
+            Scalar batch_qi[detail::pair_batch_size];
+            Scalar batch_qj[detail::pair_batch_size];
+            unsigned int batch_typpair[detail::pair_batch_size];
+            bool batch_energy_shift[detail::pair_batch_size];
+            Scalar batch_force_divr[detail::pair_batch_size];
+            Scalar batch_pair_eng[detail::pair_batch_size];
+            bool batch_evaluated[detail::pair_batch_size];
+
+            Scalar batch_dxx[detail::pair_batch_size];
+            Scalar batch_dxy[detail::pair_batch_size];
+            Scalar batch_dxz[detail::pair_batch_size];
+
+            // the tilt and z terms are resolved once for the batch, 2D systems do not read the z coordinates
+            dispatchBoxShape(box, three_d, [&](auto shape)
+                {
+                typedef decltype(shape) Shape;
 
-            // calculate r_ij squared (FLOPS: 5)
-            Scalar rsq = dot(dx, dx);
+                // gather the separations, this loop has no branches and the compiler may vectorize it
+                // calculate dr_ji (MEM TRANSFER: 6 scalars / FLOPS: 3)
+                for (unsigned int l = 0; l < n_batch; l++)
+                    {
+                    unsigned int j = batch_j[l];
+                    batch_dxx[l] = h_x[i] - h_x[j];
+                    batch_dxy[l] = h_y[i] - h_y[j];
+                    batch_dxz[l] = Shape::three_d ? h_z[i] - h_z[j] : Scalar(0.0);
+                    }
 
-            // get parameters for this type pair
-            unsigned int typpair_idx = m_typpair_idx(typei, typej);
-            param_type param = h_params.data[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
-            Scalar ronsq = Scalar(0.0);
-            if (m_shift_mode == xplor)
-                ronsq = h_ronsq.data[typpair_idx];
+                // apply periodic boundary conditions
+                for (unsigned int l = 0; l < n_batch; l++)
+                    {
+                    Scalar3 dx = box.minImage<Shape::triclinic, Shape::three_d>(
+                        make_scalar3(batch_dxx[l], batch_dxy[l], batch_dxz[l]));
+                    batch_dxx[l] = dx.x;
+                    batch_dxy[l] = dx.y;
+                    batch_dxz[l] = dx.z;
+                    }
+                });
 
-            // design specifies that energies are shifted if
-            // 1) shift mode is set to shift
-            // or 2) shift mode is explor and ron > rcut
-            bool energy_shift = false;
-            if (m_shift_mode == shift)
-                energy_shift = true;
-            else if (m_shift_mode == xplor)
+            // gather the per pair parameters
+            for (unsigned int l = 0; l < n_batch; l++)
                 {
-                if (ronsq > rcutsq)
+                unsigned int j = batch_j[l];
+                assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+                Scalar3 dx = make_scalar3(batch_dxx[l], batch_dxy[l], batch_dxz[l]);
+
+                // access the type of the particles (MEM TRANSFER: 2 scalars)
+                unsigned int typei = __scalar_as_int(h_type[i]);
+                unsigned int typej = __scalar_as_int(h_type[j]);
+                assert(typei < m_pdata->getNTypes());
+                assert(typej < m_pdata->getNTypes());
+
+                // access diameter and charge (if needed)
+                batch_di[l] = Scalar(0.0);
+                batch_dj[l] = Scalar(0.0);
+                batch_qi[l] = Scalar(0.0);
+                batch_qj[l] = Scalar(0.0);
+                if (evaluator::needsDiameter())
+                    {
+                    batch_di[l] = h_diameter.data[i];
+                    batch_dj[l] = h_diameter.data[j];
+                    }
+                if (evaluator::needsCharge())
+                    {
+                    batch_qi[l] = h_charge.data[i];
+                    batch_qj[l] = h_charge.data[j];
+                    }
+
+                batch_dx[l] = dx;
+
+                // calculate r_ij squared (FLOPS: 5)
+                batch_rsq[l] = dot(dx, dx);
+
+                // get parameters for this type pair
+                unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                batch_typpair[l] = typpair_idx;
+                Scalar rcutsq = h_rcutsq.data[typpair_idx];
+                batch_rcutsq[l] = rcutsq;
+                Scalar ronsq = Scalar(0.0);
+                if (Mode::shift_mode == xplor)
+                    ronsq = h_ronsq.data[typpair_idx];
+                batch_ronsq[l] = ronsq;
+
+                // design specifies that energies are shifted if
+                // 1) shift mode is set to shift
+                // or 2) shift mode is explor and ron > rcut
+                bool energy_shift = false;
+                if (Mode::shift_mode == shift)
                     energy_shift = true;
+                else if (Mode::shift_mode == xplor)
+                    {
+                    if (ronsq > rcutsq)
+                        energy_shift = true;
+                    }
+                batch_energy_shift[l] = energy_shift;
                 }
 
             // compute the force and potential energy
-            Scalar force_divr = Scalar(0.0);
-            Scalar pair_eng = Scalar(0.0);
-            evaluator eval(rsq, rcutsq, param);
-            if (evaluator::needsDiameter())
-                eval.setDiameter(di, dj);
-            if (evaluator::needsCharge())
-                eval.setCharge(qi, qj);
-
-            bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
-
-            if (evaluated)
+            detail::evalPairBatch<evaluator>(typename detail::has_batch_eval<evaluator>::type(),
+                                             n_batch,
+                                             batch_rsq,
+                                             batch_rcutsq,
+                                             h_params.data,
+                                             batch_typpair,
+                                             batch_di,
+                                             batch_dj,
+                                             batch_qi,
+                                             batch_qj,
+                                             batch_energy_shift,
+                                             batch_force_divr,
+                                             batch_pair_eng,
+                                             batch_evaluated);
+
+            // scatter
+            for (unsigned int l = 0; l < n_batch; l++)
                 {
-                // modify the potential for xplor shifting
-                if (m_shift_mode == xplor)
-                    {
-                    if (rsq >= ronsq && rsq < rcutsq)
-                        {
-                        // Implement XPLOR smoothing (FLOPS: 16)
-                        Scalar old_pair_eng = pair_eng;
-                        Scalar old_force_divr = force_divr;
-
-                        // calculate 1.0 / (xplor denominator)
-                        Scalar xplor_denom_inv =
-                            Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+                if (!batch_evaluated[l])
+                    continue;
 
-                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
-                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq *
-                                   (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
-                        Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+                unsigned int j = batch_j[l];
+                Scalar3 dx = batch_dx[l];
+                Scalar force_divr = batch_force_divr[l];
+                Scalar pair_eng = batch_pair_eng[l];
 
-                        // make modifications to the old pair energy and force
-                        pair_eng = old_pair_eng * s;
-                        // note: I'm not sure why the minus sign needs to be there: my notes have a +
-                        // But this is verified correct via plotting
-                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
-                        }
-                    }
+                // modify the potential for xplor shifting
+                if (Mode::shift_mode == xplor)
+                    detail::applyXPLORSmoothing(batch_rsq[l], batch_rcutsq[l], batch_ronsq[l], force_divr, pair_eng);
 
                 Scalar force_div2r = force_divr * Scalar(0.5);
                 // add the force, potential energy and virial to the particle i
                 // (FLOPS: 8)
                 fi += dx*force_divr;
-                pei += pair_eng * Scalar(0.5);
-                if (compute_virial)
+                if (Mode::compute_energy)
+                    pei += pair_eng * Scalar(0.5);
+                if (Mode::compute_virial)
                     {
-                    virialxxi += force_div2r*dx.x*dx.x;
-                    virialxyi += force_div2r*dx.x*dx.y;
-                    virialxzi += force_div2r*dx.x*dx.z;
-                    virialyyi += force_div2r*dx.y*dx.y;
-                    virialyzi += force_div2r*dx.y*dx.z;
-                    virialzzi += force_div2r*dx.z*dx.z;
+                    virial_i[0] += force_div2r*dx.x*dx.x;
+                    virial_i[1] += force_div2r*dx.x*dx.y;
+                    virial_i[2] += force_div2r*dx.x*dx.z;
+                    virial_i[3] += force_div2r*dx.y*dx.y;
+                    virial_i[4] += force_div2r*dx.y*dx.z;
+                    virial_i[5] += force_div2r*dx.z*dx.z;
                     }
 
                 // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
                 // only add force to local particles
-                if (third_law && j < m_pdata->getN())
+                if (Mode::third_law && j < N)
                     {
                     unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x*force_divr;
-                    h_force.data[mem_idx].y -= dx.y*force_divr;
-                    h_force.data[mem_idx].z -= dx.z*force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
-                    if (compute_virial)
+                    force[mem_idx].x -= dx.x*force_divr;
+                    force[mem_idx].y -= dx.y*force_divr;
+                    force[mem_idx].z -= dx.z*force_divr;
+                    if (Mode::compute_energy)
+                        force[mem_idx].w += pair_eng * Scalar(0.5);
+                    if (Mode::compute_virial)
                         {
-                        h_virial.data[0*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.x;
-                        h_virial.data[1*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.y;
-                        h_virial.data[2*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.z;
-                        h_virial.data[3*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.y;
-                        h_virial.data[4*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.z;
-                        h_virial.data[5*m_virial_pitch+mem_idx] += force_div2r*dx.z*dx.z;
+                        virial[0*virial_pitch+mem_idx] += force_div2r*dx.x*dx.x;
+                        virial[1*virial_pitch+mem_idx] += force_div2r*dx.x*dx.y;
+                        virial[2*virial_pitch+mem_idx] += force_div2r*dx.x*dx.z;
+                        virial[3*virial_pitch+mem_idx] += force_div2r*dx.y*dx.y;
+                        virial[4*virial_pitch+mem_idx] += force_div2r*dx.y*dx.z;
+                        virial[5*virial_pitch+mem_idx] += force_div2r*dx.z*dx.z;
                         }
                     }
                 }
+            };
+
+        // add the accumulated force, potential energy and virial of particle i to the output arrays
+        auto store_particle = [&](unsigned int i,
+                                  const Scalar3& fi,
+                                  Scalar pei,
+                                  const Scalar *virial_i,
+                                  Scalar4 *force,
+                                  Scalar *virial,
+                                  size_t virial_pitch)
+            {
+            unsigned int mem_idx = i;
+            force[mem_idx].x += fi.x;
+            force[mem_idx].y += fi.y;
+            force[mem_idx].z += fi.z;
+            if (Mode::compute_energy)
+                force[mem_idx].w += pei;
+            if (Mode::compute_virial)
+                {
+                for (unsigned int l = 0; l < 6; l++)
+                    virial[l*virial_pitch+mem_idx] += virial_i[l];
+                }
+            };
+
+        // compute the forces on particle i from its per-particle neighbor list
+        auto compute_particle = [&](unsigned int i, Scalar4 *force, Scalar *virial, size_t virial_pitch)
+            {
+            // initialize current particle force, potential energy, and virial to 0
+            Scalar3 fi = make_scalar3(0, 0, 0);
+            Scalar pei = 0.0;
+            Scalar virial_i[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+            // loop over the neighbors from begin to end in batches: gather the pair geometry, evaluate the whole
+            // batch, then accumulate the results
+            const unsigned int myHead = h_head_list.data[i];
+            unsigned int batch_j[detail::pair_batch_size];
+            auto compute_range = [&](unsigned int begin, unsigned int end)
+                {
+                for (unsigned int k_start = begin; k_start < end; k_start += detail::pair_batch_size)
+                    {
+                    const unsigned int n_batch = std::min(detail::pair_batch_size, end - k_start);
+                    const unsigned int *j = h_nlist.data + myHead + k_start;
+                    if (use_delta)
+                        {
+                        for (unsigned int l = 0; l < n_batch; l++)
+                            batch_j[l] = decodeNeighborDelta(i, h_nlist_delta.data, h_nlist.data, myHead + k_start + l);
+                        j = batch_j;
+                        }
+                    compute_batch(i,
+                                  n_batch,
+                                  j,
+                                  fi,
+                                  pei,
+                                  virial_i,
+                                  force,
+                                  virial,
+                                  virial_pitch);
+                    }
+                };
+
+            if (use_type_segments)
+                {
+                // only visit the segments of the types that interact with particle i
+                const unsigned int typei = __scalar_as_int(h_type[i]);
+                const unsigned int *type_head = h_type_head.data + type_head_indexer(0, i);
+                for (unsigned int typej = 0; typej < ntypes; typej++)
+                    {
+                    if (h_rcutsq.data[m_typpair_idx(typei, typej)] > Scalar(0.0))
+                        compute_range(type_head[typej], type_head[typej+1]);
+                    }
+                }
+            else
+                {
+                compute_range(0, (unsigned int)h_n_neigh.data[i]);
+                }
+
+            // finally, increment the force, potential energy and virial for particle i
+            store_particle(i, fi, pei, virial_i, force, virial, virial_pitch);
+            };
+
+        // a split pass only processes the selected particles
+        const unsigned int *items = nullptr;
+        unsigned int n_items = N;
+        if (interior && boundary)
+            {
+            // the neighbor list may have been rebuilt
+            m_split_valid = false;
+            }
+        else
+            {
+            if (!m_split_valid)
+                splitItems();
+
+            const std::vector<unsigned int>& selected = interior ? m_interior_items : m_boundary_items;
+            items = selected.data();
+            n_items = (unsigned int)selected.size();
             }
 
-        // finally, increment the force, potential energy and virial for particle i
-        unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
-        if (compute_virial)
+        auto compute_item = [&](unsigned int k, Scalar4 *force, Scalar *virial, size_t virial_pitch)
+            {
+            compute_particle(items ? items[k] : k, force, virial, virial_pitch);
+            };
+
+        #ifdef ENABLE_TBB
+        if (m_exec_conf->getNumThreads() > 1 && !Mode::third_law)
             {
-            h_virial.data[0*m_virial_pitch+mem_idx] += virialxxi;
-            h_virial.data[1*m_virial_pitch+mem_idx] += virialxyi;
-            h_virial.data[2*m_virial_pitch+mem_idx] += virialxzi;
-            h_virial.data[3*m_virial_pitch+mem_idx] += virialyyi;
-            h_virial.data[4*m_virial_pitch+mem_idx] += virialyzi;
-            h_virial.data[5*m_virial_pitch+mem_idx] += virialzzi;
+            // with a full neighbor list, every particle only writes to its own output elements and no reduction
+            // is needed
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_items),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                for (unsigned int item = r.begin(); item != r.end(); ++item)
+                    compute_item(item, h_force.data, h_virial.data, m_virial_pitch);
+                });
             }
-        }
+        else if (m_exec_conf->getNumThreads() > 1)
+            {
+            // with a half neighbor list, each thread accumulates into its own force and virial arrays
+            // which are summed up at the end
+            tbb::enumerable_thread_specific< std::vector<Scalar4> > thread_force(
+                std::vector<Scalar4>(N, make_scalar4(0,0,0,0)));
+            tbb::enumerable_thread_specific< std::vector<Scalar> > thread_virial(
+                std::vector<Scalar>(Mode::compute_virial ? 6*N : 0, Scalar(0.0)));
+
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_items),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                std::vector<Scalar4>& force = thread_force.local();
+                std::vector<Scalar>& virial = thread_virial.local();
+                for (unsigned int item = r.begin(); item != r.end(); ++item)
+                    compute_item(item, force.data(), virial.data(), N);
+                });
+
+            // reduce the per-thread arrays into the output, in parallel over particles
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                for (auto it_force = thread_force.begin(); it_force != thread_force.end(); ++it_force)
+                    {
+                    const std::vector<Scalar4>& force = *it_force;
+                    for (unsigned int i = r.begin(); i != r.end(); ++i)
+                        {
+                        h_force.data[i].x += force[i].x;
+                        h_force.data[i].y += force[i].y;
+                        h_force.data[i].z += force[i].z;
+                        h_force.data[i].w += force[i].w;
+                        }
+                    }
+
+                if (Mode::compute_virial)
+                    {
+                    for (auto it_virial = thread_virial.begin(); it_virial != thread_virial.end(); ++it_virial)
+                        {
+                        const std::vector<Scalar>& virial = *it_virial;
+                        for (unsigned int l = 0; l < 6; ++l)
+                            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                h_virial.data[l*m_virial_pitch+i] += virial[l*N+i];
+                        }
+                    }
+                });
+            }
+        else
+        #endif
+            {
+            // for each particle
+            for (unsigned int item = 0; item < n_items; item++)
+                compute_item(item, h_force.data, h_virial.data, m_virial_pitch);
+            }
+        };
+
+    detail::dispatchPairComputeMode(m_shift_mode, compute_virial, third_law, compute_energy, compute_forces);
 
     if (m_prof) m_prof->pop();
     }
@@ -831,6 +1361,13 @@ CommFlags PotentialPair< evaluator >::getRequestedCommFlags(unsigned int timeste
     if (evaluator::needsDiameter())
         flags[comm_flag::diameter] = 1;
 
+    // computeSetEnergy() identifies the ghost particles by tag
+    if (m_set_membership.getNumElements() > 0)
+        {
+        flags[comm_flag::tag] = 1;
+        m_set_ghost_tags_valid = true;
+        }
+
     flags |= ForceCompute::getRequestedCommFlags(timestep);
 
     return flags;
@@ -1024,6 +1561,189 @@ Scalar PotentialPair< evaluator >::computeEnergyBetweenSetsPythonList(  pybind11
     return eng;
     }
 
+/*! \param tags1 Tags of the particles in the first set
+    \param tags2 Tags of the particles in the second set
+
+    The sets are stored by tag, so that they remain valid when the particles are sorted or migrate between ranks.
+*/
+template < class evaluator >
+void PotentialPair< evaluator >::setEnergySets(
+    pybind11::array_t<unsigned int, pybind11::array::c_style | pybind11::array::forcecast> tags1,
+    pybind11::array_t<unsigned int, pybind11::array::c_style | pybind11::array::forcecast> tags2)
+    {
+    if (tags1.ndim() != 1 || tags2.ndim() != 1)
+        throw std::domain_error("The energy sets must be one dimensional arrays of tags");
+
+    const unsigned int n_tags = m_pdata->getMaximumTag() + 1;
+    GlobalArray<unsigned int> set_membership(n_tags, m_exec_conf);
+    m_set_membership.swap(set_membership);
+    TAG_ALLOCATION(m_set_membership);
+
+    ArrayHandle<unsigned int> h_set_membership(m_set_membership, access_location::host, access_mode::overwrite);
+    memset(h_set_membership.data, 0, sizeof(unsigned int)*n_tags);
+
+    auto add_tags = [&](const pybind11::array_t<unsigned int, pybind11::array::c_style | pybind11::array::forcecast>&
+                            tags,
+                        unsigned int bit)
+        {
+        const unsigned int *data = tags.data();
+        for (ssize_t k = 0; k < tags.size(); k++)
+            {
+            if (data[k] >= n_tags)
+                {
+                m_exec_conf->msg->error() << "pair." << evaluator::getName() << ": particle tag " << data[k]
+                                          << " in the energy sets does not exist" << std::endl;
+                throw std::runtime_error("Error setting the energy sets");
+                }
+            h_set_membership.data[data[k]] |= bit;
+            }
+        };
+    add_tags(tags1, 1);
+    add_tags(tags2, 2);
+
+    // the ghosts received so far may not carry their tags
+    m_set_ghost_tags_valid = false;
+    }
+
+/*! \param timestep Current time step
+*/
+template < class evaluator >
+void PotentialPair< evaluator >::prepareSetEnergy(unsigned int timestep)
+    {
+    if (m_set_membership.getNumElements() == 0)
+        throw std::runtime_error("Define the energy sets before computing the energy between them");
+
+    #ifdef ENABLE_MPI
+    if (m_comm && !m_set_ghost_tags_valid)
+        {
+        // the ghosts were last exchanged without tags, exchange them again with tags
+        CommFlags old_flags = m_comm->getFlags();
+        CommFlags new_flags = old_flags;
+        new_flags[comm_flag::tag] = 1;
+        m_comm->setFlags(new_flags);
+
+        m_comm->migrateParticles();
+        m_comm->exchangeGhosts();
+
+        m_comm->setFlags(old_flags);
+
+        // the particles may have been reordered
+        m_nlist->forceUpdate();
+        m_set_ghost_tags_valid = true;
+        }
+    #endif
+
+    m_nlist->compute(timestep);
+    }
+
+/*! \param timestep Current time step
+    \returns The energy between the particles of the set 1 and those of the set 2, summed over all ranks
+
+    The sets are defined with setEnergySets(). Only the pairs within the neighbor list are visited, particles in
+    neither set are skipped without reading their neighbors, and no tags need to be translated through the reverse
+    tag table. Unlike computeEnergyBetweenSets(), the pairs excluded from the neighbor list do not contribute, which
+    matches the forces. When particle i is in both sets, the pairs i-j and j-i both count, as in
+    computeEnergyBetweenSets().
+*/
+template < class evaluator >
+Scalar PotentialPair< evaluator >::computeSetEnergy(unsigned int timestep)
+    {
+    prepareSetEnergy(timestep);
+
+    if (m_prof) m_prof->push(m_prof_name);
+
+    const bool third_law = m_nlist->getStorageMode() == NeighborList::half;
+
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_set_membership(m_set_membership, access_location::host, access_mode::read);
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+    ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
+
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_tags = (unsigned int)m_set_membership.getNumElements();
+    auto get_sets = [&](unsigned int idx)
+        {
+        const unsigned int tag = h_tag.data[idx];
+        return tag < n_tags ? h_set_membership.data[tag] : 0u;
+        };
+
+    Scalar energy(0.0);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        const unsigned int sets_i = get_sets(i);
+        if (!sets_i)
+            continue;
+
+        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+        Scalar di = evaluator::needsDiameter() ? h_diameter.data[i] : Scalar(0.0);
+        Scalar qi = evaluator::needsCharge() ? h_charge.data[i] : Scalar(0.0);
+
+        const unsigned int my_head = h_head_list.data[i];
+        const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        for (unsigned int k = 0; k < size; k++)
+            {
+            unsigned int j = h_nlist.data[my_head + k];
+            const unsigned int sets_j = get_sets(j);
+            const unsigned int count = ((sets_i & 1) && (sets_j & 2)) + ((sets_i & 2) && (sets_j & 1));
+            if (!count)
+                continue;
+
+            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            Scalar3 dx = box.minImage(pi - pj);
+            Scalar rsq = dot(dx, dx);
+
+            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+            unsigned int typpair_idx = m_typpair_idx(typei, typej);
+            Scalar rcutsq = h_rcutsq.data[typpair_idx];
+            Scalar ronsq = Scalar(0.0);
+            if (m_shift_mode == xplor)
+                ronsq = h_ronsq.data[typpair_idx];
+            bool energy_shift = m_shift_mode == shift || (m_shift_mode == xplor && ronsq > rcutsq);
+
+            Scalar force_divr = Scalar(0.0);
+            Scalar pair_eng = Scalar(0.0);
+            evaluator eval(rsq, rcutsq, h_params.data[typpair_idx]);
+            if (evaluator::needsDiameter())
+                eval.setDiameter(di, h_diameter.data[j]);
+            if (evaluator::needsCharge())
+                eval.setCharge(qi, h_charge.data[j]);
+
+            if (!eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift))
+                continue;
+
+            if (m_shift_mode == xplor)
+                detail::applyXPLORSmoothing(rsq, rcutsq, ronsq, force_divr, pair_eng);
+
+            // a full list holds every pair twice, once on each side (on this or another rank), a half list holds
+            // it once, or on both ranks when j is a ghost
+            const Scalar weight = (third_law && j < N) ? Scalar(1.0) : Scalar(0.5);
+            energy += Scalar(count) * weight * pair_eng;
+            }
+        }
+
+    #ifdef ENABLE_MPI
+    if (this->m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &energy, 1, MPI_HOOMD_SCALAR, MPI_SUM, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    if (m_prof) m_prof->pop();
+
+    return energy;
+    }
+
 //! Export this pair potential to python
 /*! \param name Name of the class in the exported python module
     \tparam T Class type to export. \b Must be an instantiated PotentialPair class template.
@@ -1040,6 +1760,8 @@ template < class T > void export_PotentialPair(pybind11::module& m, const std::s
         .def("getROn", &T::getROn)
         .def_property("mode", &T::getShiftMode, &T::setShiftModePython)
         .def("computeEnergyBetweenSets", &T::computeEnergyBetweenSetsPythonList)
+        .def("setEnergySets", &T::setEnergySets)
+        .def("computeSetEnergy", &T::computeSetEnergy)
         .def("slotWriteGSDShapeSpec", &T::slotWriteGSDShapeSpec)
         .def("connectGSDShapeSpec", &T::connectGSDShapeSpec)
     ;
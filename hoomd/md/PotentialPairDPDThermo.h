@@ -81,6 +81,12 @@ class PotentialPairDPDThermo : public PotentialPair<evaluator>
 
         //! Actually compute the forces (overwrites PotentialPair::computeForces())
         virtual void computeForces(unsigned int timestep);
+
+        //! The thermostat forces are computed in a single pass
+        virtual bool computeInteriorForces(unsigned int timestep)
+            {
+            return false;
+            }
     };
 
 /*! \param sysdef System to compute forces on
@@ -11,10 +11,7 @@
 #include "hoomd/Index1D.h"
 
 #include "hoomd/GPUPartition.cuh"
-
-#ifdef __HIPCC__
-#include "hoomd/WarpTools.cuh"
-#endif // __HIPCC__
+#include "MDPrecisionSetup.h"
 
 #include <assert.h>
 #include <type_traits>
@@ -58,6 +55,7 @@ struct pair_args_t
               const unsigned int _block_size,
               const unsigned int _shift_mode,
               const unsigned int _compute_virial,
+              const unsigned int _compute_energy,
               const unsigned int _threads_per_particle,
               const GPUPartition& _gpu_partition)
                 : d_force(_d_force),
@@ -79,6 +77,7 @@ struct pair_args_t
                   block_size(_block_size),
                   shift_mode(_shift_mode),
                   compute_virial(_compute_virial),
+                  compute_energy(_compute_energy),
                   threads_per_particle(_threads_per_particle),
                   gpu_partition(_gpu_partition)
         {
@@ -95,6 +94,7 @@ struct pair_args_t
     const BoxDim& box;         //!< Simulation box in GPU format
     const unsigned int *d_n_neigh;  //!< Device array listing the number of neighbors on each particle
     const unsigned int *d_nlist;    //!< Device array listing the neighbors of each particle
+    const short *d_nlist_delta = nullptr; //!< The neighbors as 16-bit deltas, NULL to read d_nlist
     const unsigned int *d_head_list;//!< Head list indexes for accessing d_nlist
     const Scalar *d_rcutsq;          //!< Device array listing r_cut squared per particle type pair
     const Scalar *d_ronsq;           //!< Device array listing r_on squared per particle type pair
@@ -103,277 +103,81 @@ struct pair_args_t
     const unsigned int block_size;  //!< Block size to execute
     const unsigned int shift_mode;  //!< The potential energy shift mode
     const unsigned int compute_virial;  //!< Flag to indicate if virials should be computed
+    const unsigned int compute_energy;  //!< Flag to indicate if the potential energy should be computed
     const unsigned int threads_per_particle; //!< Number of threads per particle (maximum: 1 warp)
     const GPUPartition& gpu_partition;      //!< The load balancing partition of particles between GPUs
     };
 
-#ifdef __HIPCC__
+//! Block size of the kernel that computes the energy between two sets of particles
+const unsigned int gpu_pair_set_energy_block_size = 256;
 
-//! Kernel for calculating pair forces
-/*! This kernel is called to calculate the pair forces on all N particles. Actual evaluation of the potentials and
-    forces for each pair is handled via the template class \a evaluator.
-
-    \param d_force Device memory to write computed forces
-    \param d_virial Device memory to write computed virials
-    \param virial_pitch pitch of 2D virial array
-    \param N number of particles in system
-    \param d_pos particle positions
-    \param d_diameter particle diameters
-    \param d_charge particle charges
-    \param box Box dimensions used to implement periodic boundary conditions
-    \param d_n_neigh Device memory array listing the number of neighbors for each particle
-    \param d_nlist Device memory array containing the neighbor list contents
-    \param d_head_list Indexes for reading \a d_nlist
-    \param d_params Parameters for the potential, stored per type pair
-    \param d_rcutsq rcut squared, stored per type pair
-    \param d_ronsq ron squared, stored per type pair
-    \param ntypes Number of types in the simulation
-    \param offset Offset of first particle
-
-    \a d_params, \a d_rcutsq, and \a d_ronsq must be indexed with an Index2DUpperTriangular(typei, typej) to access the
-    unique value for that type pair. These values are all cached into shared memory for quick access, so a dynamic
-    amount of shared memory must be allocated for this kernel launch. The amount is
-    (2*sizeof(Scalar) + sizeof(typename evaluator::param_type)) * typpair_idx.getNumElements()
-
-    Certain options are controlled via template parameters to avoid the performance hit when they are not enabled.
-    \tparam evaluator EvaluatorPair class to evaluate V(r) and -delta V(r)/r
-    \tparam shift_mode 0: No energy shifting is done. 1: V(r) is shifted to be 0 at rcut. 2: XPLOR switching is enabled
-                       (See PotentialPair for a discussion on what that entails)
-    \tparam compute_virial When non-zero, the virial tensor is computed. When zero, the virial tensor is not computed.
-    \tparam tpp Number of threads to use per particle, must be power of 2 and smaller than warp size
-
-    <b>Implementation details</b>
-    Each block will calculate the forces on a block of particles.
-    Each group of \a tpp threads will calculate the total force on one particle.
-    The neighborlist is arranged in columns so that reads are fully coalesced when doing this.
-*/
-template< class evaluator, unsigned int shift_mode, unsigned int compute_virial, int tpp>
-__global__ void gpu_compute_pair_forces_shared_kernel(Scalar4 *d_force,
-                                               Scalar *d_virial,
-                                               const size_t virial_pitch,
-                                               const unsigned int N,
-                                               const Scalar4 *d_pos,
-                                               const Scalar *d_diameter,
-                                               const Scalar *d_charge,
-                                               const BoxDim box,
-                                               const unsigned int *d_n_neigh,
-                                               const unsigned int *d_nlist,
-                                               const unsigned int *d_head_list,
-                                               const typename evaluator::param_type *d_params,
-                                               const Scalar *d_rcutsq,
-                                               const Scalar *d_ronsq,
-                                               const unsigned int ntypes,
-                                               const unsigned int offset)
+//! Wraps arguments to gpu_compute_pair_set_energy
+struct pair_set_energy_args_t
     {
-    Index2D typpair_idx(ntypes);
-    const unsigned int num_typ_parameters = typpair_idx.getNumElements();
-
-    // shared arrays for per type pair parameters
-    HIP_DYNAMIC_SHARED( char, s_data)
-    typename evaluator::param_type *s_params =
-        (typename evaluator::param_type *)(&s_data[0]);
-    Scalar *s_rcutsq = (Scalar *)(&s_data[num_typ_parameters*sizeof(typename evaluator::param_type)]);
-    Scalar *s_ronsq = (Scalar *)(&s_data[num_typ_parameters*(sizeof(typename evaluator::param_type) + sizeof(Scalar))]);
-
-    // load in the per type pair parameters
-    for (unsigned int cur_offset = 0; cur_offset < num_typ_parameters; cur_offset += blockDim.x)
-        {
-        if (cur_offset + threadIdx.x < num_typ_parameters)
-            {
-            s_rcutsq[cur_offset + threadIdx.x] = d_rcutsq[cur_offset + threadIdx.x];
-            s_params[cur_offset + threadIdx.x] = d_params[cur_offset + threadIdx.x];
-            if (shift_mode == 2)
-                s_ronsq[cur_offset + threadIdx.x] = d_ronsq[cur_offset + threadIdx.x];
-            }
-        }
-    __syncthreads();
-
-    // start by identifying which particle we are to handle
-    unsigned int idx = blockIdx.x * (blockDim.x/tpp) + threadIdx.x/tpp;
-    bool active = true;
-    if (idx >= N)
-        {
-        // need to mask this thread, but still participate in warp-level reduction
-        active = false;
-        }
-
-    // add offset to get actual particle index
-    idx += offset;
-
-    // initialize the force to 0
-    Scalar4 force = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
-    Scalar virialxx = Scalar(0.0);
-    Scalar virialxy = Scalar(0.0);
-    Scalar virialxz = Scalar(0.0);
-    Scalar virialyy = Scalar(0.0);
-    Scalar virialyz = Scalar(0.0);
-    Scalar virialzz = Scalar(0.0);
-
-    if (active)
+    //! Construct a pair_set_energy_args_t
+    pair_set_energy_args_t(Scalar *_d_partial_energy,
+                           const unsigned int _N,
+                           const Scalar4 *_d_pos,
+                           const unsigned int *_d_tag,
+                           const Scalar *_d_diameter,
+                           const Scalar *_d_charge,
+                           const unsigned int *_d_set_membership,
+                           const unsigned int _n_tags,
+                           const BoxDim& _box,
+                           const unsigned int *_d_n_neigh,
+                           const unsigned int *_d_nlist,
+                           const unsigned int *_d_head_list,
+                           const Scalar *_d_rcutsq,
+                           const Scalar *_d_ronsq,
+                           const unsigned int _ntypes,
+                           const unsigned int _shift_mode)
+                : d_partial_energy(_d_partial_energy),
+                  N(_N),
+                  d_pos(_d_pos),
+                  d_tag(_d_tag),
+                  d_diameter(_d_diameter),
+                  d_charge(_d_charge),
+                  d_set_membership(_d_set_membership),
+                  n_tags(_n_tags),
+                  box(_box),
+                  d_n_neigh(_d_n_neigh),
+                  d_nlist(_d_nlist),
+                  d_head_list(_d_head_list),
+                  d_rcutsq(_d_rcutsq),
+                  d_ronsq(_d_ronsq),
+                  ntypes(_ntypes),
+                  shift_mode(_shift_mode)
         {
-        // load in the length of the neighbor list
-        unsigned int n_neigh = d_n_neigh[idx];
-
-        // read in the position of our particle.
-        Scalar4 postypei = __ldg(d_pos + idx);
-        Scalar3 posi = make_scalar3(postypei.x, postypei.y, postypei.z);
-
-        Scalar di = Scalar(0);
-        if (evaluator::needsDiameter())
-            di = __ldg(d_diameter + idx);
-
-        Scalar qi = Scalar(0);
-        if (evaluator::needsCharge())
-            qi = __ldg(d_charge + idx);
-
-        unsigned int my_head = d_head_list[idx];
-        unsigned int cur_j = 0;
-
-        unsigned int next_j(0);
-        next_j = threadIdx.x%tpp < n_neigh ? __ldg(d_nlist + my_head + threadIdx.x%tpp) : 0;
+        };
 
-        // loop over neighbors
-        for (int neigh_idx = threadIdx.x%tpp; neigh_idx < n_neigh; neigh_idx+=tpp)
-            {
-                {
-                // read the current neighbor index
-                cur_j = next_j;
-                if (neigh_idx+tpp < n_neigh)
-                    {
-                    next_j = __ldg(d_nlist + my_head + neigh_idx+tpp);
-                    }
-                // get the neighbor's position
-                Scalar4 postypej = __ldg(d_pos + cur_j);
-                Scalar3 posj = make_scalar3(postypej.x, postypej.y, postypej.z);
-
-                Scalar dj = Scalar(0.0);
-                if (evaluator::needsDiameter())
-                    dj = __ldg(d_diameter + cur_j);
-
-                Scalar qj = Scalar(0.0);
-                if (evaluator::needsCharge())
-                    qj = __ldg(d_charge + cur_j);
-
-                // calculate dr (with periodic boundary conditions)
-                Scalar3 dx = posi - posj;
-
-                // apply periodic boundary conditions
-                dx = box.minImage(dx);
-
-                // calculate r squared
-                Scalar rsq = dot(dx, dx);
-
-                // access the per type pair parameters
-                unsigned int typpair = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(postypej.w));
-                Scalar rcutsq = s_rcutsq[typpair];
-                typename evaluator::param_type param = s_params[typpair];
-                Scalar ronsq = Scalar(0.0);
-                if (shift_mode == 2)
-                    ronsq = s_ronsq[typpair];
-
-                // design specifies that energies are shifted if
-                // 1) shift mode is set to shift
-                // or 2) shift mode is explor and ron > rcut
-                bool energy_shift = false;
-                if (shift_mode == 1)
-                    energy_shift = true;
-                else if (shift_mode == 2)
-                    {
-                    if (ronsq > rcutsq)
-                        energy_shift = true;
-                    }
-
-                // evaluate the potential
-                Scalar force_divr = Scalar(0.0);
-                Scalar pair_eng = Scalar(0.0);
-
-                evaluator eval(rsq, rcutsq, param);
-                if (evaluator::needsDiameter())
-                    eval.setDiameter(di, dj);
-                if (evaluator::needsCharge())
-                    eval.setCharge(qi, qj);
-
-                eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
-
-                if (shift_mode == 2)
-                    {
-                    if (rsq >= ronsq && rsq < rcutsq)
-                        {
-                        // Implement XPLOR smoothing
-                        Scalar old_pair_eng = pair_eng;
-                        Scalar old_force_divr = force_divr;
-
-                        // calculate 1.0 / (xplor denominator)
-                        Scalar xplor_denom_inv =
-                            Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
-
-                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
-                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq *
-                                   (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
-                        Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
-
-                        // make modifications to the old pair energy and force
-                        pair_eng = old_pair_eng * s;
-                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
-                        }
-                    }
-                // calculate the virial
-                if (compute_virial)
-                    {
-                    Scalar force_div2r = Scalar(0.5) * force_divr;
-                    virialxx +=  dx.x * dx.x * force_div2r;
-                    virialxy +=  dx.x * dx.y * force_div2r;
-                    virialxz +=  dx.x * dx.z * force_div2r;
-                    virialyy +=  dx.y * dx.y * force_div2r;
-                    virialyz +=  dx.y * dx.z * force_div2r;
-                    virialzz +=  dx.z * dx.z * force_div2r;
-                    }
-
-                // add up the force vector components
-                force.x += dx.x * force_divr;
-                force.y += dx.y * force_divr;
-                force.z += dx.z * force_divr;
-
-                force.w += pair_eng;
-                }
-            }
+    Scalar *d_partial_energy;               //!< Energy summed by each block (output)
+    const unsigned int N;                   //!< Number of local particles
+    const Scalar4 *d_pos;                   //!< Particle positions
+    const unsigned int *d_tag;              //!< Particle tags
+    const Scalar *d_diameter;               //!< Particle diameters
+    const Scalar *d_charge;                 //!< Particle charges
+    const unsigned int *d_set_membership;   //!< Energy sets of each tag (bit 0: set 1, bit 1: set 2)
+    const unsigned int n_tags;              //!< Number of elements in d_set_membership
+    const BoxDim& box;                      //!< Simulation box
+    const unsigned int *d_n_neigh;          //!< Number of neighbors of each particle
+    const unsigned int *d_nlist;            //!< Neighbor list
+    const unsigned int *d_head_list;        //!< Head list indexes for accessing d_nlist
+    const Scalar *d_rcutsq;                 //!< r_cut squared per type pair
+    const Scalar *d_ronsq;                  //!< r_on squared per type pair
+    const unsigned int ntypes;              //!< Number of particle types
+    const unsigned int shift_mode;          //!< The potential energy shift mode
+    };
 
-        // potential energy per particle must be halved
-        force.w *= Scalar(0.5);
-        }
+//! Compute the energy between two sets of particles on the GPU
+/*! The definition is instantiated in the driver .cu file of each evaluator.
+*/
+template< class evaluator >
+hipError_t gpu_compute_pair_set_energy(const pair_set_energy_args_t& args,
+                                       const typename evaluator::param_type *d_params);
 
-    // reduce force over threads in cta
-    hoomd::detail::WarpReduce<Scalar, tpp> reducer;
-    force.x = reducer.Sum(force.x);
-    force.y = reducer.Sum(force.y);
-    force.z = reducer.Sum(force.z);
-    force.w = reducer.Sum(force.w);
+#ifdef __HIPCC__
 
-    // now that the force calculation is complete, write out the result
-    if (active && threadIdx.x % tpp == 0)
-        d_force[idx] = force;
-
-    if (compute_virial)
-        {
-        virialxx = reducer.Sum(virialxx);
-        virialxy = reducer.Sum(virialxy);
-        virialxz = reducer.Sum(virialxz);
-        virialyy = reducer.Sum(virialyy);
-        virialyz = reducer.Sum(virialyz);
-        virialzz = reducer.Sum(virialzz);
-
-        // if we are the first thread in the cta, write out virial to global mem
-        if (active && threadIdx.x %tpp == 0)
-            {
-            d_virial[0*virial_pitch+idx] = virialxx;
-            d_virial[1*virial_pitch+idx] = virialxy;
-            d_virial[2*virial_pitch+idx] = virialxz;
-            d_virial[3*virial_pitch+idx] = virialyy;
-            d_virial[4*virial_pitch+idx] = virialyz;
-            d_virial[5*virial_pitch+idx] = virialzz;
-            }
-        }
-    }
+#include "PotentialPairGPUKernel.cuh"
 
 template<typename T>
 int get_max_block_size(T func)
@@ -392,12 +196,13 @@ int get_max_block_size(T func)
  * \tparam shift_mode 0: No energy shifting is done. 1: V(r) is shifted to be 0 at rcut. 2: XPLOR switching is enabled
  *                       (See PotentialPair for a discussion on what that entails)
  * \tparam compute_virial When non-zero, the virial tensor is computed. When zero, the virial tensor is not computed.
+ * \tparam compute_energy When non-zero, the potential energy is computed.
  * \tparam tpp Number of threads to use per particle, must be power of 2 and smaller than warp size
  *
  * Partial function template specialization is not allowed in C++, so instead we have to wrap this with a struct that
  * we are allowed to partially specialize.
  */
-template<class evaluator, unsigned int shift_mode, unsigned int compute_virial, int tpp>
+template<class evaluator, unsigned int shift_mode, unsigned int compute_virial, unsigned int compute_energy, int tpp>
 struct PairForceComputeKernel
     {
     //! Launcher for the pair force kernel
@@ -425,26 +230,31 @@ struct PairForceComputeKernel
 
             static unsigned int max_block_size = UINT_MAX;
             if (max_block_size == UINT_MAX)
-                max_block_size = get_max_block_size(gpu_compute_pair_forces_shared_kernel<evaluator, shift_mode, compute_virial, tpp>);
+                max_block_size = get_max_block_size(
+                    gpu_compute_pair_forces_shared_kernel<evaluator, shift_mode, compute_virial, compute_energy, tpp>);
 
             block_size = block_size < max_block_size ? block_size : max_block_size;
             dim3 grid(N / (block_size/tpp) + 1, 1, 1);
 
-            hipLaunchKernelGGL((gpu_compute_pair_forces_shared_kernel<evaluator, shift_mode, compute_virial, tpp>), dim3(grid), dim3(block_size), shared_bytes, 0, pair_args.d_force, pair_args.d_virial,
+            hipLaunchKernelGGL((gpu_compute_pair_forces_shared_kernel<evaluator, shift_mode, compute_virial,
+                                                                      compute_energy, tpp>),
+              dim3(grid), dim3(block_size), shared_bytes, 0, pair_args.d_force, pair_args.d_virial,
               pair_args.virial_pitch, N, pair_args.d_pos, pair_args.d_diameter,
-              pair_args.d_charge, pair_args.box, pair_args.d_n_neigh, pair_args.d_nlist,
+              pair_args.d_charge, pair_args.box, pair_args.d_n_neigh, pair_args.d_nlist, pair_args.d_nlist_delta,
               pair_args.d_head_list, d_params, pair_args.d_rcutsq, pair_args.d_ronsq, pair_args.ntypes, offset);
             }
         else
             {
-            PairForceComputeKernel<evaluator, shift_mode, compute_virial, tpp/2>::launch(pair_args, range, d_params);
+            PairForceComputeKernel<evaluator, shift_mode, compute_virial, compute_energy, tpp/2>::launch(pair_args,
+                                                                                                        range,
+                                                                                                        d_params);
             }
         }
     };
 
 //! Template specialization to do nothing for the tpp = 0 case
-template<class evaluator, unsigned int shift_mode, unsigned int compute_virial>
-struct PairForceComputeKernel<evaluator, shift_mode, compute_virial, 0>
+template<class evaluator, unsigned int shift_mode, unsigned int compute_virial, unsigned int compute_energy>
+struct PairForceComputeKernel<evaluator, shift_mode, compute_virial, compute_energy, 0>
     {
     static void launch(const pair_args_t& pair_args, std::pair<unsigned int, unsigned int> range, const typename evaluator::param_type *d_params)
         {
@@ -452,6 +262,39 @@ struct PairForceComputeKernel<evaluator, shift_mode, compute_virial, 0>
         }
     };
 
+//! Launch the pair force kernel for the shift mode in \a pair_args
+/*!
+ * \tparam evaluator EvaluatorPair class to evaluate V(r) and -delta V(r)/r
+ * \tparam compute_virial When non-zero, the virial tensor is computed
+ * \tparam compute_energy When non-zero, the potential energy is computed
+ * \param pair_args Other arguments to pass onto the kernel
+ * \param range Range of particle indices this GPU operates on
+ * \param d_params Parameters for the potential, stored per type pair
+ */
+template<class evaluator, unsigned int compute_virial, unsigned int compute_energy>
+void launchPairForceComputeKernel(const pair_args_t& pair_args,
+                                  std::pair<unsigned int, unsigned int> range,
+                                  const typename evaluator::param_type *d_params)
+    {
+    switch (pair_args.shift_mode)
+        {
+        case 0:
+            PairForceComputeKernel<evaluator, 0, compute_virial, compute_energy, gpu_pair_force_max_tpp>::launch(
+                pair_args, range, d_params);
+            break;
+        case 1:
+            PairForceComputeKernel<evaluator, 1, compute_virial, compute_energy, gpu_pair_force_max_tpp>::launch(
+                pair_args, range, d_params);
+            break;
+        case 2:
+            PairForceComputeKernel<evaluator, 2, compute_virial, compute_energy, gpu_pair_force_max_tpp>::launch(
+                pair_args, range, d_params);
+            break;
+        default:
+            break;
+        }
+    }
+
 //! Kernel driver that computes lj forces on the GPU for LJForceComputeGPU
 /*! \param pair_args Other arguments to pass onto the kernel
     \param d_params Parameters for the potential, stored per type pair
@@ -475,52 +318,142 @@ hipError_t gpu_compute_pair_forces(const pair_args_t& pair_args,
         // Launch kernel
         if (pair_args.compute_virial)
             {
-            switch (pair_args.shift_mode)
-                {
-                case 0:
-                    {
-                    PairForceComputeKernel<evaluator, 0, 1, gpu_pair_force_max_tpp>::launch(pair_args, range, d_params);
-                    break;
-                    }
-                case 1:
-                    {
-                    PairForceComputeKernel<evaluator, 1, 1, gpu_pair_force_max_tpp>::launch(pair_args, range, d_params);
-                    break;
-                    }
-                case 2:
-                    {
-                    PairForceComputeKernel<evaluator, 2, 1, gpu_pair_force_max_tpp>::launch(pair_args, range, d_params);
-                    break;
-                    }
-                default:
-                    break;
-                }
+            if (pair_args.compute_energy)
+                launchPairForceComputeKernel<evaluator, 1, 1>(pair_args, range, d_params);
+            else
+                launchPairForceComputeKernel<evaluator, 1, 0>(pair_args, range, d_params);
             }
         else
             {
-            switch (pair_args.shift_mode)
+            if (pair_args.compute_energy)
+                launchPairForceComputeKernel<evaluator, 0, 1>(pair_args, range, d_params);
+            else
+                launchPairForceComputeKernel<evaluator, 0, 0>(pair_args, range, d_params);
+            }
+        }
+
+    return hipSuccess;
+    }
+
+//! Kernel that computes the energy between two sets of particles
+/*! One thread handles one particle i, and visits its neighbors only when i is in one of the sets. The full neighbor
+    list holds every pair once on each side, so each thread adds half of the energy of its pairs between the two sets.
+    The energy of the block is written to d_partial_energy[blockIdx.x].
+
+    See pair_set_energy_args_t for the description of the parameters.
+*/
+template< class evaluator >
+__global__ void gpu_compute_pair_set_energy_kernel(Scalar *d_partial_energy,
+                                                   const unsigned int N,
+                                                   const Scalar4 *d_pos,
+                                                   const unsigned int *d_tag,
+                                                   const Scalar *d_diameter,
+                                                   const Scalar *d_charge,
+                                                   const unsigned int *d_set_membership,
+                                                   const unsigned int n_tags,
+                                                   const BoxDim box,
+                                                   const unsigned int *d_n_neigh,
+                                                   const unsigned int *d_nlist,
+                                                   const unsigned int *d_head_list,
+                                                   const typename evaluator::param_type *d_params,
+                                                   const Scalar *d_rcutsq,
+                                                   const Scalar *d_ronsq,
+                                                   const unsigned int ntypes,
+                                                   const unsigned int shift_mode)
+    {
+    __shared__ Scalar s_energy[gpu_pair_set_energy_block_size];
+
+    Index2D typpair_idx(ntypes);
+    unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+
+    Scalar energy(0.0);
+    unsigned int tag_i = i < N ? d_tag[i] : n_tags;
+    unsigned int sets_i = tag_i < n_tags ? d_set_membership[tag_i] : 0;
+    if (sets_i)
+        {
+        Scalar4 postypei = __ldg(d_pos + i);
+        Scalar3 posi = make_scalar3(postypei.x, postypei.y, postypei.z);
+        Scalar di = evaluator::needsDiameter() ? __ldg(d_diameter + i) : Scalar(0.0);
+        Scalar qi = evaluator::needsCharge() ? __ldg(d_charge + i) : Scalar(0.0);
+
+        const unsigned int my_head = d_head_list[i];
+        const unsigned int n_neigh = d_n_neigh[i];
+        for (unsigned int k = 0; k < n_neigh; k++)
+            {
+            unsigned int j = __ldg(d_nlist + my_head + k);
+            unsigned int tag_j = __ldg(d_tag + j);
+            unsigned int sets_j = tag_j < n_tags ? d_set_membership[tag_j] : 0;
+            unsigned int count = ((sets_i & 1) && (sets_j & 2)) + ((sets_i & 2) && (sets_j & 1));
+            if (!count)
+                continue;
+
+            Scalar4 postypej = __ldg(d_pos + j);
+            Scalar3 dx = box.minImage(posi - make_scalar3(postypej.x, postypej.y, postypej.z));
+            Scalar rsq = dot(dx, dx);
+
+            unsigned int typpair = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(postypej.w));
+            Scalar rcutsq = d_rcutsq[typpair];
+            Scalar ronsq = shift_mode == 2 ? d_ronsq[typpair] : Scalar(0.0);
+            bool energy_shift = shift_mode == 1 || (shift_mode == 2 && ronsq > rcutsq);
+
+            Scalar force_divr = Scalar(0.0);
+            Scalar pair_eng = Scalar(0.0);
+            evaluator eval(rsq, rcutsq, d_params[typpair]);
+            if (evaluator::needsDiameter())
+                eval.setDiameter(di, __ldg(d_diameter + j));
+            if (evaluator::needsCharge())
+                eval.setCharge(qi, __ldg(d_charge + j));
+
+            if (!eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift))
+                continue;
+
+            // XPLOR smoothing of the energy
+            if (shift_mode == 2 && rsq >= ronsq && rsq < rcutsq)
                 {
-                case 0:
-                    {
-                    PairForceComputeKernel<evaluator, 0, 0, gpu_pair_force_max_tpp>::launch(pair_args, range, d_params);
-                    break;
-                    }
-                case 1:
-                    {
-                    PairForceComputeKernel<evaluator, 1, 0, gpu_pair_force_max_tpp>::launch(pair_args, range, d_params);
-                    break;
-                    }
-                case 2:
-                    {
-                    PairForceComputeKernel<evaluator, 2, 0, gpu_pair_force_max_tpp>::launch(pair_args, range, d_params);
-                    break;
-                    }
-                default:
-                    break;
+                Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+                pair_eng *= rsq_minus_r_cut_sq * rsq_minus_r_cut_sq *
+                            (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) /
+                            ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
                 }
+
+            energy += Scalar(0.5) * Scalar(count) * pair_eng;
             }
         }
 
+    // sum the energy of the block
+    s_energy[threadIdx.x] = energy;
+    __syncthreads();
+    for (unsigned int offset = blockDim.x / 2; offset > 0; offset >>= 1)
+        {
+        if (threadIdx.x < offset)
+            s_energy[threadIdx.x] += s_energy[threadIdx.x + offset];
+        __syncthreads();
+        }
+
+    if (threadIdx.x == 0)
+        d_partial_energy[blockIdx.x] = s_energy[0];
+    }
+
+/*! \param args Other arguments to pass onto the kernel
+    \param d_params Parameters for the potential, stored per type pair
+
+    The caller sums the (N / gpu_pair_set_energy_block_size + 1) elements of args.d_partial_energy.
+*/
+template< class evaluator >
+hipError_t gpu_compute_pair_set_energy(const pair_set_energy_args_t& args,
+                                       const typename evaluator::param_type *d_params)
+    {
+    assert(d_params);
+    assert(args.ntypes > 0);
+
+    dim3 grid(args.N / gpu_pair_set_energy_block_size + 1, 1, 1);
+    dim3 threads(gpu_pair_set_energy_block_size, 1, 1);
+
+    hipLaunchKernelGGL((gpu_compute_pair_set_energy_kernel<evaluator>), grid, threads, 0, 0,
+                       args.d_partial_energy, args.N, args.d_pos, args.d_tag, args.d_diameter, args.d_charge,
+                       args.d_set_membership, args.n_tags, args.box, args.d_n_neigh, args.d_nlist,
+                       args.d_head_list, d_params, args.d_rcutsq, args.d_ronsq, args.ntypes, args.shift_mode);
+
     return hipSuccess;
     }
 #endif
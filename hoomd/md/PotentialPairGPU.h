@@ -78,13 +78,23 @@ class PotentialPairGPU : public PotentialPair<evaluator>
             m_tuner->setEnabled(enable);
             }
 
+        //! Compute the energy between the two energy sets on the GPU
+        virtual Scalar computeSetEnergy(unsigned int timestep);
+
     protected:
         std::unique_ptr<Autotuner> m_tuner;   //!< Autotuner for block size and threads per particle
         unsigned int m_param;                       //!< Kernel tuning parameter
+        GlobalArray<Scalar> m_set_energy_partial;   //!< Energy between the sets summed by each block
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
+        //! The GPU kernels compute the forces on all particles at once
+        virtual bool computeInteriorForces(unsigned int timestep)
+            {
+            return false;
+            }
+
     };
 
 template< class evaluator, hipError_t gpu_cgpf(const pair_args_t& pair_args,
@@ -143,6 +153,8 @@ void PotentialPairGPU< evaluator, gpu_cgpf >::computeForces(unsigned int timeste
     ArrayHandle<unsigned int> d_n_neigh(this->m_nlist->getNNeighArray(), access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_nlist(this->m_nlist->getNListArray(), access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_head_list(this->m_nlist->getHeadList(), access_location::device, access_mode::read);
+    const bool use_delta = this->m_nlist->getCompressedIndices();
+    ArrayHandle<short> d_nlist_delta(this->m_nlist->getNListDeltaArray(), access_location::device, access_mode::read);
 
     // access the particle data
     ArrayHandle<Scalar4> d_pos(this->m_pdata->getPositions(), access_location::device, access_mode::read);
@@ -169,28 +181,34 @@ void PotentialPairGPU< evaluator, gpu_cgpf >::computeForces(unsigned int timeste
     unsigned int block_size = param / 10000;
     unsigned int threads_per_particle = param % 10000;
 
-    gpu_cgpf(pair_args_t(d_force.data,
-                         d_virial.data,
-                         this->m_virial.getPitch(),
-                         this->m_pdata->getN(),
-                         this->m_pdata->getMaxN(),
-                         d_pos.data,
-                         d_diameter.data,
-                         d_charge.data,
-                         box,
-                         d_n_neigh.data,
-                         d_nlist.data,
-                         d_head_list.data,
-                         d_rcutsq.data,
-                         d_ronsq.data,
-                         this->m_nlist->getNListArray().getPitch(),
-                         this->m_pdata->getNTypes(),
-                         block_size,
-                         this->m_shift_mode,
-                         flags[pdata_flag::pressure_tensor],
-                         threads_per_particle,
-                         this->m_pdata->getGPUPartition()),
-             d_params.data);
+    pair_args_t pair_args(d_force.data,
+                          d_virial.data,
+                          this->m_virial.getPitch(),
+                          this->m_pdata->getN(),
+                          this->m_pdata->getMaxN(),
+                          d_pos.data,
+                          d_diameter.data,
+                          d_charge.data,
+                          box,
+                          d_n_neigh.data,
+                          d_nlist.data,
+                          d_head_list.data,
+                          d_rcutsq.data,
+                          d_ronsq.data,
+                          this->m_nlist->getNListArray().getPitch(),
+                          this->m_pdata->getNTypes(),
+                          block_size,
+                          this->m_shift_mode,
+                          flags[pdata_flag::pressure_tensor],
+                          flags[pdata_flag::potential_energy],
+                          threads_per_particle,
+                          this->m_pdata->getGPUPartition());
+
+    // read the 16-bit deltas instead of the 32-bit list when the neighbor list provides them
+    if (use_delta)
+        pair_args.d_nlist_delta = d_nlist_delta.data;
+
+    gpu_cgpf(pair_args, d_params.data);
 
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
@@ -201,6 +219,91 @@ void PotentialPairGPU< evaluator, gpu_cgpf >::computeForces(unsigned int timeste
     if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
     }
 
+/*! \param timestep Current time step
+    \returns The energy between the particles of the set 1 and those of the set 2, summed over all ranks
+
+    See PotentialPair::computeSetEnergy(). The blocks of the kernel sum the energy of their particles and only these
+    partial sums are copied to the host.
+*/
+template< class evaluator, hipError_t gpu_cgpf(const pair_args_t& pair_args,
+                                                const typename evaluator::param_type *d_params)>
+Scalar PotentialPairGPU< evaluator, gpu_cgpf >::computeSetEnergy(unsigned int timestep)
+    {
+    this->prepareSetEnergy(timestep);
+
+    if (this->m_prof) this->m_prof->push(this->m_exec_conf, this->m_prof_name);
+
+    const unsigned int N = this->m_pdata->getN();
+    const unsigned int n_blocks = N / gpu_pair_set_energy_block_size + 1;
+    if (m_set_energy_partial.getNumElements() < n_blocks)
+        {
+        GlobalArray<Scalar> set_energy_partial(n_blocks, this->m_exec_conf);
+        m_set_energy_partial.swap(set_energy_partial);
+        TAG_ALLOCATION(m_set_energy_partial);
+        }
+
+        {
+        ArrayHandle<unsigned int> d_n_neigh(this->m_nlist->getNNeighArray(), access_location::device,
+                                            access_mode::read);
+        ArrayHandle<unsigned int> d_nlist(this->m_nlist->getNListArray(), access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_head_list(this->m_nlist->getHeadList(), access_location::device,
+                                              access_mode::read);
+
+        ArrayHandle<Scalar4> d_pos(this->m_pdata->getPositions(), access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_tag(this->m_pdata->getTags(), access_location::device, access_mode::read);
+        ArrayHandle<Scalar> d_diameter(this->m_pdata->getDiameters(), access_location::device, access_mode::read);
+        ArrayHandle<Scalar> d_charge(this->m_pdata->getCharges(), access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_set_membership(this->m_set_membership, access_location::device,
+                                                   access_mode::read);
+
+        ArrayHandle<Scalar> d_ronsq(this->m_ronsq, access_location::device, access_mode::read);
+        ArrayHandle<Scalar> d_rcutsq(this->m_rcutsq, access_location::device, access_mode::read);
+        ArrayHandle<typename evaluator::param_type> d_params(this->m_params, access_location::device,
+                                                             access_mode::read);
+
+        ArrayHandle<Scalar> d_set_energy_partial(m_set_energy_partial, access_location::device,
+                                                 access_mode::overwrite);
+
+        gpu_compute_pair_set_energy<evaluator>(pair_set_energy_args_t(d_set_energy_partial.data,
+                                                                      N,
+                                                                      d_pos.data,
+                                                                      d_tag.data,
+                                                                      d_diameter.data,
+                                                                      d_charge.data,
+                                                                      d_set_membership.data,
+                                                                      (unsigned int)this->m_set_membership
+                                                                          .getNumElements(),
+                                                                      this->m_pdata->getGlobalBox(),
+                                                                      d_n_neigh.data,
+                                                                      d_nlist.data,
+                                                                      d_head_list.data,
+                                                                      d_rcutsq.data,
+                                                                      d_ronsq.data,
+                                                                      this->m_pdata->getNTypes(),
+                                                                      this->m_shift_mode),
+                                               d_params.data);
+
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+    ArrayHandle<Scalar> h_set_energy_partial(m_set_energy_partial, access_location::host, access_mode::read);
+    Scalar energy(0.0);
+    for (unsigned int b = 0; b < n_blocks; b++)
+        energy += h_set_energy_partial.data[b];
+
+    #ifdef ENABLE_MPI
+    if (this->m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &energy, 1, MPI_HOOMD_SCALAR, MPI_SUM, this->m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
+
+    return energy;
+    }
+
 //! Export this pair potential to python
 /*! \param name Name of the class in the exported python module
     \tparam T Class type to export. \b Must be an instantiated PotentialPairGPU class template.
@@ -0,0 +1,348 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __POTENTIAL_PAIR_GPU_KERNEL_CUH__
+#define __POTENTIAL_PAIR_GPU_KERNEL_CUH__
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/TextureTools.h"
+#include "hoomd/BoxDim.h"
+#include "hoomd/Index1D.h"
+#include "hoomd/WarpTools.cuh"
+#include "MDPrecisionSetup.h"
+#include "NeighborListDelta.h"
+
+#include <type_traits>
+
+/*! \file PotentialPairGPUKernel.cuh
+    \brief Defines the templated GPU kernel that computes the pair forces
+
+    The kernel is kept apart from the host side drivers in PotentialPairGPU.cuh, so that JIT compiled evaluators can
+    instantiate it with NVRTC (see PotentialPairGPUJIT.inc).
+*/
+
+namespace detail
+{
+
+//! Detect evaluators that implement evalForceAndEnergyMixed()
+template<class evaluator, class enable = void>
+struct has_mixed_eval : std::false_type { };
+
+//! Specialization for evaluators that implement evalForceAndEnergyMixed()
+template<class evaluator>
+struct has_mixed_eval<evaluator, decltype(void(&evaluator::evalForceAndEnergyMixed))> : std::true_type { };
+
+//! Evaluate one pair in PairReal precision
+template<class evaluator>
+__device__ inline void evalPairMixed(std::true_type, evaluator& eval, Scalar& force_divr, Scalar& pair_eng,
+                                     bool energy_shift)
+    {
+    PairReal force_divr_mixed = PairReal(0.0);
+    PairReal pair_eng_mixed = PairReal(0.0);
+    eval.evalForceAndEnergyMixed(force_divr_mixed, pair_eng_mixed, energy_shift);
+    force_divr = force_divr_mixed;
+    pair_eng = pair_eng_mixed;
+    }
+
+//! Evaluate one pair in Scalar precision for evaluators without a reduced precision implementation
+template<class evaluator>
+__device__ inline void evalPairMixed(std::false_type, evaluator& eval, Scalar& force_divr, Scalar& pair_eng,
+                                     bool energy_shift)
+    {
+    eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+    }
+
+} // end namespace detail
+
+//! Kernel for calculating pair forces
+/*! This kernel is called to calculate the pair forces on all N particles. Actual evaluation of the potentials and
+    forces for each pair is handled via the template class \a evaluator.
+
+    \param d_force Device memory to write computed forces
+    \param d_virial Device memory to write computed virials
+    \param virial_pitch pitch of 2D virial array
+    \param N number of particles in system
+    \param d_pos particle positions
+    \param d_diameter particle diameters
+    \param d_charge particle charges
+    \param box Box dimensions used to implement periodic boundary conditions
+    \param d_n_neigh Device memory array listing the number of neighbors for each particle
+    \param d_nlist Device memory array containing the neighbor list contents
+    \param d_nlist_delta The neighbor list as 16-bit deltas (read instead of \a d_nlist when not NULL)
+    \param d_head_list Indexes for reading \a d_nlist
+    \param d_params Parameters for the potential, stored per type pair
+    \param d_rcutsq rcut squared, stored per type pair
+    \param d_ronsq ron squared, stored per type pair
+    \param ntypes Number of types in the simulation
+    \param offset Offset of first particle
+
+    \a d_params, \a d_rcutsq, and \a d_ronsq must be indexed with an Index2DUpperTriangular(typei, typej) to access the
+    unique value for that type pair. These values are all cached into shared memory for quick access, so a dynamic
+    amount of shared memory must be allocated for this kernel launch. The amount is
+    (2*sizeof(Scalar) + sizeof(typename evaluator::param_type)) * typpair_idx.getNumElements()
+
+    Certain options are controlled via template parameters to avoid the performance hit when they are not enabled.
+    \tparam evaluator EvaluatorPair class to evaluate V(r) and -delta V(r)/r
+    \tparam shift_mode 0: No energy shifting is done. 1: V(r) is shifted to be 0 at rcut. 2: XPLOR switching is enabled
+                       (See PotentialPair for a discussion on what that entails)
+    \tparam compute_virial When non-zero, the virial tensor is computed. When zero, the virial tensor is not computed.
+    \tparam compute_energy When non-zero, the potential energy is accumulated. When zero, force.w is written as zero.
+    \tparam tpp Number of threads to use per particle, must be power of 2 and smaller than warp size
+
+    <b>Implementation details</b>
+    Each block will calculate the forces on a block of particles.
+    Each group of \a tpp threads will calculate the total force on one particle.
+    The neighborlist is arranged in columns so that reads are fully coalesced when doing this.
+
+    <b>Mixed precision</b>
+    Per pair quantities (the separation vector after the minimum image convention, rsq, the force and virial
+    contributions, and the potential itself for evaluators that implement evalForceAndEnergyMixed()) are computed in
+    PairReal. The per particle sums are always accumulated in Scalar. In builds with ENABLE_MD_MIXED_PRECISION,
+    PairReal is float, which avoids most double precision arithmetic on GPUs with low FP64 throughput. Otherwise
+    PairReal is Scalar and the kernel computes the same result as a full precision implementation.
+*/
+template< class evaluator, unsigned int shift_mode, unsigned int compute_virial, unsigned int compute_energy, int tpp>
+__global__ void gpu_compute_pair_forces_shared_kernel(Scalar4 *d_force,
+                                               Scalar *d_virial,
+                                               const size_t virial_pitch,
+                                               const unsigned int N,
+                                               const Scalar4 *d_pos,
+                                               const Scalar *d_diameter,
+                                               const Scalar *d_charge,
+                                               const BoxDim box,
+                                               const unsigned int *d_n_neigh,
+                                               const unsigned int *d_nlist,
+                                               const short *d_nlist_delta,
+                                               const unsigned int *d_head_list,
+                                               const typename evaluator::param_type *d_params,
+                                               const Scalar *d_rcutsq,
+                                               const Scalar *d_ronsq,
+                                               const unsigned int ntypes,
+                                               const unsigned int offset)
+    {
+    Index2D typpair_idx(ntypes);
+    const unsigned int num_typ_parameters = typpair_idx.getNumElements();
+
+    // shared arrays for per type pair parameters
+    HIP_DYNAMIC_SHARED( char, s_data)
+    typename evaluator::param_type *s_params =
+        (typename evaluator::param_type *)(&s_data[0]);
+    Scalar *s_rcutsq = (Scalar *)(&s_data[num_typ_parameters*sizeof(typename evaluator::param_type)]);
+    Scalar *s_ronsq = (Scalar *)(&s_data[num_typ_parameters*(sizeof(typename evaluator::param_type) + sizeof(Scalar))]);
+
+    // load in the per type pair parameters
+    for (unsigned int cur_offset = 0; cur_offset < num_typ_parameters; cur_offset += blockDim.x)
+        {
+        if (cur_offset + threadIdx.x < num_typ_parameters)
+            {
+            s_rcutsq[cur_offset + threadIdx.x] = d_rcutsq[cur_offset + threadIdx.x];
+            s_params[cur_offset + threadIdx.x] = d_params[cur_offset + threadIdx.x];
+            if (shift_mode == 2)
+                s_ronsq[cur_offset + threadIdx.x] = d_ronsq[cur_offset + threadIdx.x];
+            }
+        }
+    __syncthreads();
+
+    // start by identifying which particle we are to handle
+    unsigned int idx = blockIdx.x * (blockDim.x/tpp) + threadIdx.x/tpp;
+    bool active = true;
+    if (idx >= N)
+        {
+        // need to mask this thread, but still participate in warp-level reduction
+        active = false;
+        }
+
+    // add offset to get actual particle index
+    idx += offset;
+
+    // initialize the force to 0
+    Scalar4 force = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
+    Scalar virialxx = Scalar(0.0);
+    Scalar virialxy = Scalar(0.0);
+    Scalar virialxz = Scalar(0.0);
+    Scalar virialyy = Scalar(0.0);
+    Scalar virialyz = Scalar(0.0);
+    Scalar virialzz = Scalar(0.0);
+
+    if (active)
+        {
+        // load in the length of the neighbor list
+        unsigned int n_neigh = d_n_neigh[idx];
+
+        // read in the position of our particle.
+        Scalar4 postypei = __ldg(d_pos + idx);
+        Scalar3 posi = make_scalar3(postypei.x, postypei.y, postypei.z);
+
+        Scalar di = Scalar(0);
+        if (evaluator::needsDiameter())
+            di = __ldg(d_diameter + idx);
+
+        Scalar qi = Scalar(0);
+        if (evaluator::needsCharge())
+            qi = __ldg(d_charge + idx);
+
+        unsigned int my_head = d_head_list[idx];
+        unsigned int cur_j = 0;
+
+        unsigned int next_j(0);
+        next_j = threadIdx.x%tpp < n_neigh ? loadNeighbor(idx, d_nlist_delta, d_nlist, my_head + threadIdx.x%tpp) : 0;
+
+        // loop over neighbors
+        for (int neigh_idx = threadIdx.x%tpp; neigh_idx < n_neigh; neigh_idx+=tpp)
+            {
+                {
+                // read the current neighbor index
+                cur_j = next_j;
+                if (neigh_idx+tpp < n_neigh)
+                    {
+                    next_j = loadNeighbor(idx, d_nlist_delta, d_nlist, my_head + neigh_idx+tpp);
+                    }
+                // get the neighbor's position
+                Scalar4 postypej = __ldg(d_pos + cur_j);
+                Scalar3 posj = make_scalar3(postypej.x, postypej.y, postypej.z);
+
+                Scalar dj = Scalar(0.0);
+                if (evaluator::needsDiameter())
+                    dj = __ldg(d_diameter + cur_j);
+
+                Scalar qj = Scalar(0.0);
+                if (evaluator::needsCharge())
+                    qj = __ldg(d_charge + cur_j);
+
+                // calculate dr (with periodic boundary conditions)
+                Scalar3 dx = posi - posj;
+
+                // apply periodic boundary conditions
+                dx = box.minImage(dx);
+
+                // the difference of nearby positions is small, so per pair quantities may be reduced in precision
+                PairReal3 dxr = make_pairreal3(PairReal(dx.x), PairReal(dx.y), PairReal(dx.z));
+
+                // calculate r squared
+                #ifdef ENABLE_MD_MIXED_PRECISION
+                Scalar rsq = dxr.x * dxr.x + dxr.y * dxr.y + dxr.z * dxr.z;
+                #else
+                Scalar rsq = dot(dx, dx);
+                #endif
+
+                // access the per type pair parameters
+                unsigned int typpair = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(postypej.w));
+                Scalar rcutsq = s_rcutsq[typpair];
+                typename evaluator::param_type param = s_params[typpair];
+                Scalar ronsq = Scalar(0.0);
+                if (shift_mode == 2)
+                    ronsq = s_ronsq[typpair];
+
+                // design specifies that energies are shifted if
+                // 1) shift mode is set to shift
+                // or 2) shift mode is explor and ron > rcut
+                bool energy_shift = false;
+                if (shift_mode == 1)
+                    energy_shift = true;
+                else if (shift_mode == 2)
+                    {
+                    if (ronsq > rcutsq)
+                        energy_shift = true;
+                    }
+
+                // evaluate the potential
+                Scalar force_divr = Scalar(0.0);
+                Scalar pair_eng = Scalar(0.0);
+
+                evaluator eval(rsq, rcutsq, param);
+                if (evaluator::needsDiameter())
+                    eval.setDiameter(di, dj);
+                if (evaluator::needsCharge())
+                    eval.setCharge(qi, qj);
+
+                #ifdef ENABLE_MD_MIXED_PRECISION
+                detail::evalPairMixed(detail::has_mixed_eval<evaluator>(), eval, force_divr, pair_eng, energy_shift);
+                #else
+                eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+                #endif
+
+                if (shift_mode == 2)
+                    {
+                    if (rsq >= ronsq && rsq < rcutsq)
+                        {
+                        // Implement XPLOR smoothing
+                        Scalar old_pair_eng = pair_eng;
+                        Scalar old_force_divr = force_divr;
+
+                        // calculate 1.0 / (xplor denominator)
+                        Scalar xplor_denom_inv =
+                            Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+
+                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq *
+                                   (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
+                        Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+
+                        // make modifications to the old pair energy and force
+                        pair_eng = old_pair_eng * s;
+                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+                        }
+                    }
+                // calculate the virial
+                PairReal force_divr_r = PairReal(force_divr);
+                if (compute_virial)
+                    {
+                    PairReal force_div2r = PairReal(0.5) * force_divr_r;
+                    virialxx +=  dxr.x * dxr.x * force_div2r;
+                    virialxy +=  dxr.x * dxr.y * force_div2r;
+                    virialxz +=  dxr.x * dxr.z * force_div2r;
+                    virialyy +=  dxr.y * dxr.y * force_div2r;
+                    virialyz +=  dxr.y * dxr.z * force_div2r;
+                    virialzz +=  dxr.z * dxr.z * force_div2r;
+                    }
+
+                // add up the force vector components
+                force.x += dxr.x * force_divr_r;
+                force.y += dxr.y * force_divr_r;
+                force.z += dxr.z * force_divr_r;
+
+                if (compute_energy)
+                    force.w += pair_eng;
+                }
+            }
+
+        // potential energy per particle must be halved
+        if (compute_energy)
+            force.w *= Scalar(0.5);
+        }
+
+    // reduce force over threads in cta
+    hoomd::detail::WarpReduce<Scalar, tpp> reducer;
+    force.x = reducer.Sum(force.x);
+    force.y = reducer.Sum(force.y);
+    force.z = reducer.Sum(force.z);
+    if (compute_energy)
+        force.w = reducer.Sum(force.w);
+
+    // now that the force calculation is complete, write out the result
+    if (active && threadIdx.x % tpp == 0)
+        d_force[idx] = force;
+
+    if (compute_virial)
+        {
+        virialxx = reducer.Sum(virialxx);
+        virialxy = reducer.Sum(virialxy);
+        virialxz = reducer.Sum(virialxz);
+        virialyy = reducer.Sum(virialyy);
+        virialyz = reducer.Sum(virialyz);
+        virialzz = reducer.Sum(virialzz);
+
+        // if we are the first thread in the cta, write out virial to global mem
+        if (active && threadIdx.x %tpp == 0)
+            {
+            d_virial[0*virial_pitch+idx] = virialxx;
+            d_virial[1*virial_pitch+idx] = virialxy;
+            d_virial[2*virial_pitch+idx] = virialxz;
+            d_virial[3*virial_pitch+idx] = virialyy;
+            d_virial[4*virial_pitch+idx] = virialyz;
+            d_virial[5*virial_pitch+idx] = virialzz;
+            }
+        }
+    }
+
+#endif // __POTENTIAL_PAIR_GPU_KERNEL_CUH__
@@ -3,7 +3,7 @@
 
 #include <memory>
 #include "hoomd/ForceCompute.h"
-#include "hoomd/GPUArray.h"
+#include "hoomd/GlobalArray.h"
 
 #include <vector>
 
@@ -70,7 +70,7 @@ class PotentialSpecialPair : public ForceCompute
         #endif
 
     protected:
-        GPUArray<param_type> m_params;              //!< SpecialPair parameters per type
+        GlobalArray<param_type> m_params;           //!< SpecialPair parameters per type
         std::shared_ptr<PairData> m_pair_data;    //!< Data to use in computing particle pairs
         std::string m_log_name;                     //!< Cached log name
         std::string m_prof_name;                    //!< Cached profiler name
@@ -96,8 +96,15 @@ PotentialSpecialPair< evaluator >::PotentialSpecialPair(std::shared_ptr<SystemDe
     m_prof_name = std::string("Special pair ") + evaluator::getName();
 
     // allocate the parameters
-    GPUArray<param_type> params(m_pair_data->getNTypes(), m_exec_conf);
+    GlobalArray<param_type> params(m_pair_data->getNTypes(), m_exec_conf);
     m_params.swap(params);
+
+    #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
+    if (m_exec_conf->isCUDAEnabled() && m_exec_conf->allConcurrentManagedAccess())
+        {
+        cudaMemAdvise(m_params.get(), m_params.getNumElements()*sizeof(param_type), cudaMemAdviseSetReadMostly, 0);
+        }
+    #endif
     }
 
 template< class evaluator >
@@ -262,6 +269,7 @@ void PotentialSpecialPair< evaluator >::computeForces(unsigned int timestep)
 
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor];
+    bool compute_energy = flags[pdata_flag::potential_energy];
 
     Scalar bond_virial[6];
     for (unsigned int i = 0; i< 6; i++)
@@ -362,7 +370,8 @@ void PotentialSpecialPair< evaluator >::computeForces(unsigned int timestep)
                 h_force.data[idx_b].x += force_divr * dx.x;
                 h_force.data[idx_b].y += force_divr * dx.y;
                 h_force.data[idx_b].z += force_divr * dx.z;
-                h_force.data[idx_b].w += bond_eng;
+                if (compute_energy)
+                    h_force.data[idx_b].w += bond_eng;
                 if (compute_virial)
                     for (unsigned int i = 0; i < 6; i++)
                         h_virial.data[i*m_virial_pitch+idx_b]  += bond_virial[i];
@@ -373,7 +382,8 @@ void PotentialSpecialPair< evaluator >::computeForces(unsigned int timestep)
                 h_force.data[idx_a].x -= force_divr * dx.x;
                 h_force.data[idx_a].y -= force_divr * dx.y;
                 h_force.data[idx_a].z -= force_divr * dx.z;
-                h_force.data[idx_a].w += bond_eng;
+                if (compute_energy)
+                    h_force.data[idx_a].w += bond_eng;
                 if (compute_virial)
                     for (unsigned int i = 0; i < 6; i++)
                         h_virial.data[i*m_virial_pitch+idx_a]  += bond_virial[i];
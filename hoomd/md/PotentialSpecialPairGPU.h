@@ -56,7 +56,7 @@ class PotentialSpecialPairGPU : public PotentialSpecialPair<evaluator>
 
     protected:
         std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
-        GPUArray<unsigned int> m_flags;       //!< Flags set during the kernel execution
+        GlobalArray<unsigned int> m_flags;    //!< Flags set during the kernel execution
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
@@ -76,12 +76,8 @@ PotentialSpecialPairGPU< evaluator, gpu_cgbf >::PotentialSpecialPairGPU(std::sha
         throw std::runtime_error("Error initializing PotentialSpecialPairGPU");
         }
 
-     // allocate and zero device memory
-    GPUArray<typename evaluator::param_type> params(this->m_pair_data->getNTypes(), this->m_exec_conf);
-    this->m_params.swap(params);
-
      // allocate flags storage on the GPU
-    GPUArray<unsigned int> flags(1, this->m_exec_conf);
+    GlobalArray<unsigned int> flags(1, this->m_exec_conf);
     m_flags.swap(flags);
 
     // reset flags
@@ -116,8 +112,11 @@ void PotentialSpecialPairGPU< evaluator, gpu_cgbf >::computeForces(unsigned int
     ArrayHandle<Scalar4> d_force(this->m_force, access_location::device, access_mode::readwrite);
     ArrayHandle<Scalar> d_virial(this->m_virial, access_location::device, access_mode::readwrite);
 
+    // access flags
+    PDataFlags flags = this->m_pdata->getFlags();
+
         {
-        const GPUArray<typename PairData::members_t>& gpu_bond_list = this->m_pair_data->getGPUTable();
+        const GlobalArray<typename PairData::members_t>& gpu_bond_list = this->m_pair_data->getGPUTable();
         const Index2D& gpu_table_indexer = this->m_pair_data->getGPUTableIndexer();
 
         ArrayHandle<typename PairData::members_t> d_gpu_bondlist(gpu_bond_list, access_location::device, access_mode::read);
@@ -127,6 +126,8 @@ void PotentialSpecialPairGPU< evaluator, gpu_cgbf >::computeForces(unsigned int
         // access the flags array for overwriting
         ArrayHandle<unsigned int> d_flags(m_flags, access_location::device, access_mode::readwrite);
 
+        this->m_exec_conf->beginMultiGPU();
+
         this->m_tuner->begin();
         gpu_cgbf(bond_args_t(d_force.data,
                              d_virial.data,
@@ -141,9 +142,14 @@ void PotentialSpecialPairGPU< evaluator, gpu_cgbf >::computeForces(unsigned int
                              gpu_table_indexer,
                              d_gpu_n_bonds.data,
                              this->m_pair_data->getNTypes(),
-                             this->m_tuner->getParam()),
+                             this->m_tuner->getParam(),
+                             flags[pdata_flag::pressure_tensor],
+                             flags[pdata_flag::potential_energy],
+                             this->m_pdata->getGPUPartition()),
                  d_params.data,
                  d_flags.data);
+
+        this->m_exec_conf->endMultiGPU();
         }
 
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
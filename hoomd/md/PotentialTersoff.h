@@ -9,6 +9,7 @@
 #include <stdexcept>
 #include <memory>
 #include <fstream>
+#include <vector>
 
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
@@ -16,6 +17,12 @@
 #include "hoomd/ForceCompute.h"
 #include "NeighborList.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 
 /*! \file PotentialTersoff.h
     \brief Defines the template class for standard three-body potentials
@@ -552,8 +559,15 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
 
         unsigned int ntypes = m_pdata->getNTypes();
 
-        // for each particle
-        for (int i = 0; i < (int)m_pdata->getN(); i++)
+        const unsigned int N = m_pdata->getN();
+        const unsigned int n_all = N + m_pdata->getNGhosts();
+
+        // compute the forces on particle i, and its contributions to the forces on its neighbors
+        auto compute_particle = [&](unsigned int i,
+                                    Scalar4 *force,
+                                    Scalar *virial,
+                                    size_t virial_pitch,
+                                    std::vector<Scalar4>& neigh_dx)
             {
             // access the particle's position and type (MEM TRANSFER: 4 scalars)
             Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
@@ -583,6 +597,19 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
 
             // all neighbors of this particle
             const unsigned int size = (unsigned int)h_n_neigh.data[i];
+
+            // stage the separation vector and type of every neighbor once, the j, chi and ik loops below reuse
+            // them instead of recomputing the minimum image size*size times
+            neigh_dx.resize(size);
+            for (unsigned int k = 0; k < size; k++)
+                {
+                unsigned int kk = h_nlist.data[head_i + k];
+                assert(kk < m_pdata->getN() + m_pdata->getNGhosts());
+                Scalar3 posk = make_scalar3(h_pos.data[kk].x, h_pos.data[kk].y, h_pos.data[kk].z);
+                Scalar3 dxik = box.minImage(posi - posk);
+                neigh_dx[k] = make_scalar4(dxik.x, dxik.y, dxik.z, h_pos.data[kk].w);
+                }
+            
             if (evaluator::hasPerParticleEnergy())
                 {
                 for (unsigned int j = 0; j < size; j++)
@@ -591,16 +618,12 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
                     unsigned int jj = h_nlist.data[head_i + j];
                     assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
 
-                    // access the position and type of particle j
-                    Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
-                    unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
+                    // access the type of particle j
+                    unsigned int typej = __scalar_as_int(neigh_dx[j].w);
                     assert(typej < m_pdata->getNTypes());
 
-                    // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                    Scalar3 dxij = posi - posj;
-
-                    // apply periodic boundary conditions
-                    dxij = box.minImage(dxij);
+                    // access the staged dr_ij
+                    Scalar3 dxij = make_scalar3(neigh_dx[j].x, neigh_dx[j].y, neigh_dx[j].z);
 
                     // compute rij_sq (FLOPS: 5)
                     Scalar rij_sq = dot(dxij, dxij);
@@ -635,20 +658,16 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
                 unsigned int jj = h_nlist.data[head_i + j];
                 assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
 
-                // access the position and type of particle j
-                Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
-                unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
+                // access the type of particle j
+                unsigned int typej = __scalar_as_int(neigh_dx[j].w);
                 assert(typej < m_pdata->getNTypes());
 
                 // initialize the current force and potential energy of particle j to 0
                 Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
                 Scalar pej = 0.0;
 
-                // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                Scalar3 dxij = posi - posj;
-
-                // apply periodic boundary conditions
-                dxij = box.minImage(dxij);
+                // access the staged dr_ij
+                Scalar3 dxij = make_scalar3(neigh_dx[j].x, neigh_dx[j].y, neigh_dx[j].z);
 
                 // compute rij_sq (FLOPS: 5)
                 Scalar rij_sq = dot(dxij, dxij);
@@ -679,13 +698,9 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
                         {
                         for (unsigned int k = 0; k < size; k++)
                             {
-                            // access the index of neighbor k
+                            // access the index and type of neighbor k
                             unsigned int kk = h_nlist.data[head_i + k];
-                            assert(kk < m_pdata->getN());
-
-                            // access the position and type of neighbor k
-                            Scalar3 posk = make_scalar3(h_pos.data[kk].x, h_pos.data[kk].y, h_pos.data[kk].z);
-                            unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
+                            unsigned int typek = __scalar_as_int(neigh_dx[k].w);
                             assert(typek < m_pdata->getNTypes());
 
                             // access the type pair parameters for i and k
@@ -697,11 +712,8 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
 
                             if (kk != jj && temp_evaluated)
                                 {
-                                // compute drik
-                                Scalar3 dxik = posi - posk;
-
-                                // apply periodic boundary conditions
-                                dxik = box.minImage(dxik);
+                                // access the staged dr_ik
+                                Scalar3 dxik = make_scalar3(neigh_dx[k].x, neigh_dx[k].y, neigh_dx[k].z);
 
                                 // compute rik_sq
                                 Scalar rik_sq = dot(dxik, dxik);
@@ -764,13 +776,9 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
                         // evaluate the force from the ik interactions
                         for (unsigned int k = 0; k < size; k++)
                             {
-                            // access the index of neighbor k
+                            // access the index and type of neighbor k
                             unsigned int kk = h_nlist.data[head_i + k];
-                            assert(kk < m_pdata->getN());
-
-                            // access the position and type of neighbor k
-                            Scalar3 posk = make_scalar3(h_pos.data[kk].x, h_pos.data[kk].y, h_pos.data[kk].z);
-                            unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
+                            unsigned int typek = __scalar_as_int(neigh_dx[k].w);
                             assert(typek < m_pdata->getNTypes());
 
                             // access the type pair parameters for i and k
@@ -785,11 +793,8 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
                                 // create variable for the force on k
                                 Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
 
-                                // compute dr_ik
-                                Scalar3 dxik = posi - posk;
-
-                                // apply periodic boundary conditions
-                                dxik = box.minImage(dxik);
+                                // access the staged dr_ik
+                                Scalar3 dxik = make_scalar3(neigh_dx[k].x, neigh_dx[k].y, neigh_dx[k].z);
 
                                 // compute rik_sq
                                 Scalar rik_sq = dot(dxik, dxik);
@@ -853,20 +858,20 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
 
                                 // increment the force for particle k
                                 unsigned int mem_idx = kk;
-                                h_force.data[mem_idx].x += fk.x;
-                                h_force.data[mem_idx].y += fk.y;
-                                h_force.data[mem_idx].z += fk.z;
+                                force[mem_idx].x += fk.x;
+                                force[mem_idx].y += fk.y;
+                                force[mem_idx].z += fk.z;
 
                                 if (compute_virial)
                                     {
                                     Scalar force_div2r_ij = Scalar(0.5)*force_divr_ij.z;
                                     Scalar force_div2r_ik = Scalar(0.5)*force_divr_ik.z;
-                                    h_virial.data[0*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.x + force_div2r_ik*dxik.x*dxik.x;
-                                    h_virial.data[1*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.y + force_div2r_ik*dxik.x*dxik.y;
-                                    h_virial.data[2*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.z + force_div2r_ik*dxik.x*dxik.z;
-                                    h_virial.data[3*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.y*dxij.y + force_div2r_ik*dxik.y*dxik.y;
-                                    h_virial.data[4*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.y*dxij.z + force_div2r_ik*dxik.y*dxik.z;
-                                    h_virial.data[5*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.z*dxij.z + force_div2r_ik*dxik.z*dxik.z;
+                                    virial[0*virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.x + force_div2r_ik*dxik.x*dxik.x;
+                                    virial[1*virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.y + force_div2r_ik*dxik.x*dxik.y;
+                                    virial[2*virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.z + force_div2r_ik*dxik.x*dxik.z;
+                                    virial[3*virial_pitch+mem_idx] += force_div2r_ij*dxij.y*dxij.y + force_div2r_ik*dxik.y*dxik.y;
+                                    virial[4*virial_pitch+mem_idx] += force_div2r_ij*dxij.y*dxij.z + force_div2r_ik*dxik.y*dxik.z;
+                                    virial[5*virial_pitch+mem_idx] += force_div2r_ij*dxij.z*dxij.z + force_div2r_ik*dxik.z*dxik.z;
                                     }
                                 }
                             }
@@ -874,37 +879,95 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
                     }
                 // increment the force and potential energy for particle j
                 unsigned int mem_idx = jj;
-                h_force.data[mem_idx].x += fj.x;
-                h_force.data[mem_idx].y += fj.y;
-                h_force.data[mem_idx].z += fj.z;
-                h_force.data[mem_idx].w += pej;
+                force[mem_idx].x += fj.x;
+                force[mem_idx].y += fj.y;
+                force[mem_idx].z += fj.z;
+                force[mem_idx].w += pej;
 
                 if (compute_virial)
                     {
-                    h_virial.data[0*m_virial_pitch+mem_idx] += virialj_xx;
-                    h_virial.data[1*m_virial_pitch+mem_idx] += virialj_xy;
-                    h_virial.data[2*m_virial_pitch+mem_idx] += virialj_xz;
-                    h_virial.data[3*m_virial_pitch+mem_idx] += virialj_yy;
-                    h_virial.data[4*m_virial_pitch+mem_idx] += virialj_yz;
-                    h_virial.data[5*m_virial_pitch+mem_idx] += virialj_zz;
+                    virial[0*virial_pitch+mem_idx] += virialj_xx;
+                    virial[1*virial_pitch+mem_idx] += virialj_xy;
+                    virial[2*virial_pitch+mem_idx] += virialj_xz;
+                    virial[3*virial_pitch+mem_idx] += virialj_yy;
+                    virial[4*virial_pitch+mem_idx] += virialj_yz;
+                    virial[5*virial_pitch+mem_idx] += virialj_zz;
                     }
                 }
             // finally, increment the force and potential energy for particle i
             unsigned int mem_idx = i;
-            h_force.data[mem_idx].x += fi.x;
-            h_force.data[mem_idx].y += fi.y;
-            h_force.data[mem_idx].z += fi.z;
-            h_force.data[mem_idx].w += pei;
+            force[mem_idx].x += fi.x;
+            force[mem_idx].y += fi.y;
+            force[mem_idx].z += fi.z;
+            force[mem_idx].w += pei;
 
             if (compute_virial)
                 {
-                h_virial.data[0*m_virial_pitch+mem_idx] += viriali_xx;
-                h_virial.data[1*m_virial_pitch+mem_idx] += viriali_xy;
-                h_virial.data[2*m_virial_pitch+mem_idx] += viriali_xz;
-                h_virial.data[3*m_virial_pitch+mem_idx] += viriali_yy;
-                h_virial.data[4*m_virial_pitch+mem_idx] += viriali_yz;
-                h_virial.data[5*m_virial_pitch+mem_idx] += viriali_zz;
+                virial[0*virial_pitch+mem_idx] += viriali_xx;
+                virial[1*virial_pitch+mem_idx] += viriali_xy;
+                virial[2*virial_pitch+mem_idx] += viriali_xz;
+                virial[3*virial_pitch+mem_idx] += viriali_yy;
+                virial[4*virial_pitch+mem_idx] += viriali_yz;
+                virial[5*virial_pitch+mem_idx] += viriali_zz;
                 }
+            };
+
+        #ifdef ENABLE_TBB
+        if (m_exec_conf->getNumThreads() > 1)
+            {
+            // the forces on j and k are scattered to other particles, so each thread accumulates into its own
+            // force and virial arrays which are summed up at the end
+            tbb::enumerable_thread_specific< std::vector<Scalar4> > thread_force(
+                std::vector<Scalar4>(n_all, make_scalar4(0,0,0,0)));
+            tbb::enumerable_thread_specific< std::vector<Scalar> > thread_virial(
+                std::vector<Scalar>(compute_virial ? 6*n_all : 0, Scalar(0.0)));
+            tbb::enumerable_thread_specific< std::vector<Scalar4> > thread_neigh_dx;
+
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                std::vector<Scalar4>& force = thread_force.local();
+                std::vector<Scalar>& virial = thread_virial.local();
+                std::vector<Scalar4>& neigh_dx = thread_neigh_dx.local();
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                    compute_particle(i, force.data(), virial.data(), n_all, neigh_dx);
+                });
+
+            // reduce the per-thread arrays into the output, in parallel over particles
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_all),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                for (auto it_force = thread_force.begin(); it_force != thread_force.end(); ++it_force)
+                    {
+                    const std::vector<Scalar4>& force = *it_force;
+                    for (unsigned int i = r.begin(); i != r.end(); ++i)
+                        {
+                        h_force.data[i].x += force[i].x;
+                        h_force.data[i].y += force[i].y;
+                        h_force.data[i].z += force[i].z;
+                        h_force.data[i].w += force[i].w;
+                        }
+                    }
+
+                if (compute_virial)
+                    {
+                    for (auto it_virial = thread_virial.begin(); it_virial != thread_virial.end(); ++it_virial)
+                        {
+                        const std::vector<Scalar>& virial = *it_virial;
+                        for (unsigned int l = 0; l < 6; ++l)
+                            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                h_virial.data[l*m_virial_pitch+i] += virial[l*n_all+i];
+                        }
+                    }
+                });
+            }
+        else
+        #endif
+            {
+            // for each particle
+            std::vector<Scalar4> neigh_dx;
+            for (unsigned int i = 0; i < N; i++)
+                compute_particle(i, h_force.data, h_virial.data, m_virial_pitch, neigh_dx);
             }
         }
 
@@ -7,6 +7,7 @@
 #include "hoomd/TextureTools.h"
 #include "hoomd/ParticleData.cuh"
 #include "hoomd/Index1D.h"
+#include "hoomd/FixedPointAtomics.cuh"
 #ifdef __HIPCC__
 #include "hoomd/WarpTools.cuh"
 #endif // __HIPCC__
@@ -27,6 +28,9 @@ const int gpu_tersoff_max_tpp = 32;
 const int gpu_tersoff_max_tpp = 64;
 #endif
 
+//! Maximum number of neighbors per particle staged in shared memory
+const unsigned int gpu_tersoff_max_tile = 32;
+
 //! Wraps arguments to gpu_cgpf
 struct tersoff_args_t
     {
@@ -48,7 +52,8 @@ struct tersoff_args_t
                    const unsigned int _ntypes,
                    const unsigned int _block_size,
                    const unsigned int _tpp,
-                   const hipDeviceProp_t& _devprop)
+                   const hipDeviceProp_t& _devprop,
+                   unsigned long long int *_d_force_fixed)
                    : d_force(_d_force),
                      N(_N),
                      Nghosts(_Nghosts),
@@ -66,7 +71,8 @@ struct tersoff_args_t
                      ntypes(_ntypes),
                      block_size(_block_size),
                      tpp(_tpp),
-                     devprop(_devprop)
+                     devprop(_devprop),
+                     d_force_fixed(_d_force_fixed)
         {
         };
 
@@ -88,6 +94,7 @@ struct tersoff_args_t
     const unsigned int block_size;  //!< Block size to execute
     const unsigned int tpp;         //!< Threads per particle
     const hipDeviceProp_t& devprop;   //!< CUDA device properties
+    unsigned long long int *d_force_fixed; //!< Fixed point force and virial accumulators, NULL if not deterministic
     };
 
 
@@ -147,6 +154,62 @@ inline __device__ float myAtomicAdd(float* address, float val)
     }
 #endif
 
+//! Add to a component of the force or the virial of a particle
+/*! \param address Address of the component in the force or virial array
+    \param d_force_fixed Fixed point accumulators, NULL when the result need not be deterministic
+    \param fixed_idx Index of the component in \a d_force_fixed
+    \param val Value to add
+*/
+inline __device__ void tersoffAtomicAdd(Scalar *address,
+                                        unsigned long long int *d_force_fixed,
+                                        unsigned int fixed_idx,
+                                        Scalar val)
+    {
+    if (d_force_fixed)
+        hoomd::detail::atomicAddFixedPoint(d_force_fixed + fixed_idx, val);
+    else
+        myAtomicAdd(address, val);
+    }
+
+//! Load a neighbor k of particle i
+/*! \param neigh_idx Index of k in the neighbor list of i
+    \param k Output: the particle index of k
+    \param s_tile_dx Staged separation vectors and types of the neighbors of i
+    \param s_tile_idx Staged particle indices of the neighbors of i
+    \param tile_size Number of neighbors staged in the tile
+    \param d_nlist Neighbor list
+    \param head_idx Index of the first neighbor of i in \a d_nlist
+    \param d_pos Particle positions
+    \param posi Position of i
+    \param box Simulation box
+
+    \returns dr_ik in x, y, and z and the type of k in w
+
+    Neighbors past the end of the tile are read from global memory.
+*/
+__device__ inline Scalar4 gpu_tersoff_load_neighbor(const unsigned int neigh_idx,
+                                                    unsigned int& k,
+                                                    const Scalar4 *s_tile_dx,
+                                                    const unsigned int *s_tile_idx,
+                                                    const unsigned int tile_size,
+                                                    const unsigned int *d_nlist,
+                                                    const unsigned int head_idx,
+                                                    const Scalar4 *d_pos,
+                                                    const Scalar3& posi,
+                                                    const BoxDim& box)
+    {
+    if (neigh_idx < tile_size)
+        {
+        k = s_tile_idx[neigh_idx];
+        return s_tile_dx[neigh_idx];
+        }
+
+    k = __ldg(d_nlist + head_idx + neigh_idx);
+    Scalar4 postypek = __ldg(d_pos + k);
+    Scalar3 dxik = box.minImage(posi - make_scalar3(postypek.x, postypek.y, postypek.z));
+    return make_scalar4(dxik.x, dxik.y, dxik.z, postypek.w);
+    }
+
 //! Kernel for calculating the Tersoff forces
 /*! This kernel is called to calculate the forces on all N particles. Actual evaluation of the potentials and
     forces for each pair is handled via the template class \a evaluator.
@@ -162,12 +225,24 @@ inline __device__ float myAtomicAdd(float* address, float val)
     \param d_rcutsq rcut squared, stored per type pair
     \param d_ronsq ron squared, stored per type pair
     \param ntypes Number of types in the simulation
+    \param tile_size Number of neighbors per particle to stage in shared memory
+    \param d_force_fixed Fixed point accumulators of the forces and virials, NULL when not deterministic
+    \param n_fixed Number of particles in \a d_force_fixed (local and ghost)
 
     \a d_params, \a d_rcutsq, and \a d_ronsq must be indexed with an Index2DUpperTriangular(typei, typej) to access the
     unique value for that type pair. These values are all cached into shared memory for quick access, so a dynamic
     amount of shared memory must be allocated for this kernel launch. The amount is
     (2*sizeof(Scalar) + sizeof(typename evaluator::param_type)) * typpair_idx.getNumElements()
 
+    For the Tersoff and SquareDensity potentials, the chi and ik loops visit every neighbor k once per neighbor j.
+    The threads of each particle therefore stage dr_ik, the type, and the index of its first \a tile_size neighbors
+    in shared memory once, after the per type pair parameters and aligned to sizeof(Scalar4), which takes another
+    (blockDim.x/tpp) * tile_size * (sizeof(Scalar4) + sizeof(unsigned int)) bytes.
+
+    Several threads add to the force on the same particle j or k. When \a d_force_fixed is set, they add to the
+    component c of particle idx at d_force_fixed[c*n_fixed + idx] (force x, y, z, energy, then the six virial
+    components) instead of \a d_force and \a d_virial, so that the sums do not depend on the order of the additions.
+
     Certain options are controlled via template parameters to avoid the performance hit when they are not enabled.
     \tparam evaluator EvaluatorPair class to evaluate V(r) and -delta V(r)/r
 
@@ -189,7 +264,10 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4 *d_force,
                                                   const typename evaluator::param_type *d_params,
                                                   const Scalar *d_rcutsq,
                                                   const Scalar *d_ronsq,
-                                                  const unsigned int ntypes)
+                                                  const unsigned int ntypes,
+                                                  const unsigned int tile_size,
+                                                  unsigned long long int *d_force_fixed,
+                                                  const unsigned int n_fixed)
     {
     Index2D typpair_idx(ntypes);
     const unsigned int num_typ_parameters = typpair_idx.getNumElements();
@@ -202,6 +280,14 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4 *d_force,
 
     Scalar *s_phi_ab = s_rcutsq + num_typ_parameters;
 
+    // tiles of staged neighbors, one per particle
+    const size_t tile_offset = (num_typ_parameters*(sizeof(typename evaluator::param_type) + sizeof(Scalar))
+                                + ntypes*blockDim.x*sizeof(Scalar) + sizeof(Scalar4) - 1)
+                                / sizeof(Scalar4) * sizeof(Scalar4);
+    Scalar4 *s_tile_dx = (Scalar4 *)(&s_data[tile_offset]) + (threadIdx.x/tpp)*tile_size;
+    unsigned int *s_tile_idx = (unsigned int *)((Scalar4 *)(&s_data[tile_offset]) + (blockDim.x/tpp)*tile_size)
+                               + (threadIdx.x/tpp)*tile_size;
+
     // load in the per type pair parameters
     for (unsigned int cur_offset = 0; cur_offset < num_typ_parameters; cur_offset += blockDim.x)
         {
@@ -223,6 +309,21 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4 *d_force,
     // start by identifying which particle we are to handle
     unsigned int idx = blockIdx.x * (blockDim.x/tpp) + threadIdx.x/tpp;
 
+    // the threads of each particle stage its neighbors, all threads must reach the barrier before exiting
+    if (!evaluator::flag_for_RevCross && idx < N)
+        {
+        Scalar4 postype = __ldg(d_pos + idx);
+        Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+        const unsigned int head = d_head_list[idx];
+        const unsigned int n_staged = min(d_n_neigh[idx], tile_size);
+        for (unsigned int neigh_idx = threadIdx.x%tpp; neigh_idx < n_staged; neigh_idx += tpp)
+            {
+            s_tile_dx[neigh_idx] = gpu_tersoff_load_neighbor(neigh_idx, s_tile_idx[neigh_idx], s_tile_dx, s_tile_idx,
+                                                             0, d_nlist, head, d_pos, pos, box);
+            }
+        }
+    __syncthreads();
+
     if (idx >= N)
         return;
 
@@ -392,9 +493,9 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4 *d_force,
                                 forcek.y -= force_divr_ik * dxik.y;
                                 forcek.z -= force_divr_ik * dxik.z;
 
-                                myAtomicAdd(&d_force[cur_k].x, forcek.x);
-                                myAtomicAdd(&d_force[cur_k].y, forcek.y);
-                                myAtomicAdd(&d_force[cur_k].z, forcek.z);
+                                tersoffAtomicAdd(&d_force[cur_k].x, d_force_fixed, 0*n_fixed + cur_k, forcek.x);
+                                tersoffAtomicAdd(&d_force[cur_k].y, d_force_fixed, 1*n_fixed + cur_k, forcek.y);
+                                tersoffAtomicAdd(&d_force[cur_k].z, d_force_fixed, 2*n_fixed + cur_k, forcek.z);
 
         	        	       //evaluate the virial contribute of this 3 body interaction
         	        	       if (compute_virial)
@@ -415,27 +516,27 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4 *d_force,
 
                 // potential energy of j must be halved
                 // write out the result for particle j
-                myAtomicAdd(&d_force[cur_j].x, forcej.x);
-                myAtomicAdd(&d_force[cur_j].y, forcej.y);
-                myAtomicAdd(&d_force[cur_j].z, forcej.z);
-                myAtomicAdd(&d_force[cur_j].w, forcej.w);
+                tersoffAtomicAdd(&d_force[cur_j].x, d_force_fixed, 0*n_fixed + cur_j, forcej.x);
+                tersoffAtomicAdd(&d_force[cur_j].y, d_force_fixed, 1*n_fixed + cur_j, forcej.y);
+                tersoffAtomicAdd(&d_force[cur_j].z, d_force_fixed, 2*n_fixed + cur_j, forcej.z);
+                tersoffAtomicAdd(&d_force[cur_j].w, d_force_fixed, 3*n_fixed + cur_j, forcej.w);
                 }
             }
         // potential energy per particle must be halved
         // now that the force calculation is complete, write out the result (MEM TRANSFER: 20 bytes)
-        myAtomicAdd(&d_force[idx].x, forcei.x);
-        myAtomicAdd(&d_force[idx].y, forcei.y);
-        myAtomicAdd(&d_force[idx].z, forcei.z);
-        myAtomicAdd(&d_force[idx].w, forcei.w);
+        tersoffAtomicAdd(&d_force[idx].x, d_force_fixed, 0*n_fixed + idx, forcei.x);
+        tersoffAtomicAdd(&d_force[idx].y, d_force_fixed, 1*n_fixed + idx, forcei.y);
+        tersoffAtomicAdd(&d_force[idx].z, d_force_fixed, 2*n_fixed + idx, forcei.z);
+        tersoffAtomicAdd(&d_force[idx].w, d_force_fixed, 3*n_fixed + idx, forcei.w);
 
         if (compute_virial)
             {
-            myAtomicAdd(&d_virial[0*virial_pitch+idx], viriali_xx);
-            myAtomicAdd(&d_virial[1*virial_pitch+idx], viriali_xy);
-            myAtomicAdd(&d_virial[2*virial_pitch+idx], viriali_xz);
-            myAtomicAdd(&d_virial[3*virial_pitch+idx], viriali_yy);
-            myAtomicAdd(&d_virial[4*virial_pitch+idx], viriali_yz);
-            myAtomicAdd(&d_virial[5*virial_pitch+idx], viriali_zz);
+            tersoffAtomicAdd(&d_virial[0*virial_pitch+idx], d_force_fixed, 4*n_fixed + idx, viriali_xx);
+            tersoffAtomicAdd(&d_virial[1*virial_pitch+idx], d_force_fixed, 5*n_fixed + idx, viriali_xy);
+            tersoffAtomicAdd(&d_virial[2*virial_pitch+idx], d_force_fixed, 6*n_fixed + idx, viriali_xz);
+            tersoffAtomicAdd(&d_virial[3*virial_pitch+idx], d_force_fixed, 7*n_fixed + idx, viriali_yy);
+            tersoffAtomicAdd(&d_virial[4*virial_pitch+idx], d_force_fixed, 8*n_fixed + idx, viriali_yz);
+            tersoffAtomicAdd(&d_virial[5*virial_pitch+idx], d_force_fixed, 9*n_fixed + idx, viriali_zz);
             }
 
 
@@ -577,22 +678,16 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4 *d_force,
                     {
                     // compute chi
                     unsigned int cur_k = 0;
-                    unsigned int next_k(0);
-                    next_k = __ldg(d_nlist + head_idx);
 
                     // loop over neighbors one by one
                     for (int neigh_idy = 0; neigh_idy < n_neigh; neigh_idy++)
                         {
-                        // read the current index of k and prefetch the next one
-                        cur_k = next_k;
-                        next_k = __ldg(d_nlist + head_idx + neigh_idy+1);
-
-                        // get the position of neighbor k
-                        Scalar4 postypek = __ldg(d_pos + cur_k);
-                        Scalar3 posk = make_scalar3(postypek.x, postypek.y, postypek.z);
+                        // read k and dr_ik from the tile, or from global memory past its end
+                        Scalar4 dxik_typek = gpu_tersoff_load_neighbor(neigh_idy, cur_k, s_tile_dx, s_tile_idx,
+                                                                       tile_size, d_nlist, head_idx, d_pos, posi, box);
 
                         // get the type pair parameters for i and k
-                        typpair = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(postypek.w));
+                        typpair = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(dxik_typek.w));
                         Scalar temp_rcutsq = s_rcutsq[typpair];
                         typename evaluator::param_type temp_param = s_params[typpair];
 
@@ -602,10 +697,7 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4 *d_force,
                         if (cur_k != cur_j && temp_evaluated)
                             {
                             // compute rik
-                            Scalar3 dxik = posi - posk;
-
-                            // apply the periodic boundary conditions
-                            dxik = box.minImage(dxik);
+                            Scalar3 dxik = make_scalar3(dxik_typek.x, dxik_typek.y, dxik_typek.z);
 
                             // compute rik_sq
                             Scalar rik_sq = dot(dxik, dxik);
@@ -675,22 +767,16 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4 *d_force,
                     {
                     // now evaluate the force from the ik interactions
                     unsigned int cur_k = 0;
-                    unsigned int next_k(0);
-                    next_k = __ldg(d_nlist + head_idx);
 
                     // loop over neighbors one by one
                     for (int neigh_idy = 0; neigh_idy < n_neigh; neigh_idy++)
                         {
-                        // read the current neighbor index and prefetch the next one
-                        cur_k = next_k;
-                        next_k = __ldg(d_nlist + head_idx + neigh_idy+1);
-
-                        // get the position of neighbor k
-                        Scalar4 postypek = __ldg(d_pos + cur_k);
-                        Scalar3 posk = make_scalar3(postypek.x, postypek.y, postypek.z);
+                        // read k and dr_ik from the tile, or from global memory past its end
+                        Scalar4 dxik_typek = gpu_tersoff_load_neighbor(neigh_idy, cur_k, s_tile_dx, s_tile_idx,
+                                                                       tile_size, d_nlist, head_idx, d_pos, posi, box);
 
                         // get the type pair parameters for i and k
-                        typpair = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(postypek.w));
+                        typpair = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(dxik_typek.w));
                         Scalar temp_rcutsq = s_rcutsq[typpair];
                         typename evaluator::param_type temp_param = s_params[typpair];
 
@@ -702,10 +788,7 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4 *d_force,
                             Scalar4 forcek = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
 
                             // compute rik
-                            Scalar3 dxik = posi - posk;
-
-                            // apply the periodic boundary conditions
-                            dxik = box.minImage(dxik);
+                            Scalar3 dxik = make_scalar3(dxik_typek.x, dxik_typek.y, dxik_typek.z);
 
                             // compute rik_sq
                             Scalar rik_sq = dot(dxik, dxik);
@@ -767,20 +850,26 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4 *d_force,
                                 forcek.y += force_divr_ij.z * dxij.y + force_divr_ik.z * dxik.y;
                                 forcek.z += force_divr_ij.z * dxij.z + force_divr_ik.z * dxik.z;
 
-                                myAtomicAdd(&d_force[cur_k].x, forcek.x);
-                                myAtomicAdd(&d_force[cur_k].y, forcek.y);
-                                myAtomicAdd(&d_force[cur_k].z, forcek.z);
+                                tersoffAtomicAdd(&d_force[cur_k].x, d_force_fixed, 0*n_fixed + cur_k, forcek.x);
+                                tersoffAtomicAdd(&d_force[cur_k].y, d_force_fixed, 1*n_fixed + cur_k, forcek.y);
+                                tersoffAtomicAdd(&d_force[cur_k].z, d_force_fixed, 2*n_fixed + cur_k, forcek.z);
 
                                 if (compute_virial)
                                     {
                                     Scalar force_div2r_ij = Scalar(0.5)*force_divr_ij.z;
                                     Scalar force_div2r_ik = Scalar(0.5)*force_divr_ik.z;
-                                    myAtomicAdd(&d_virial[0*virial_pitch+cur_k],force_div2r_ij*dxij.x*dxij.x + force_div2r_ik*dxik.x*dxik.x);
-                                    myAtomicAdd(&d_virial[1*virial_pitch+cur_k],force_div2r_ij*dxij.x*dxij.y + force_div2r_ik*dxik.x*dxik.y);
-                                    myAtomicAdd(&d_virial[2*virial_pitch+cur_k],force_div2r_ij*dxij.x*dxij.z + force_div2r_ik*dxik.x*dxik.z);
-                                    myAtomicAdd(&d_virial[3*virial_pitch+cur_k],force_div2r_ij*dxij.y*dxij.y + force_div2r_ik*dxik.y*dxik.y);
-                                    myAtomicAdd(&d_virial[4*virial_pitch+cur_k],force_div2r_ij*dxij.y*dxij.z + force_div2r_ik*dxik.y*dxik.z);
-                                    myAtomicAdd(&d_virial[5*virial_pitch+cur_k],force_div2r_ij*dxij.z*dxij.z + force_div2r_ik*dxik.z*dxik.z);
+                                    tersoffAtomicAdd(&d_virial[0*virial_pitch+cur_k], d_force_fixed, 4*n_fixed + cur_k,
+                                                     force_div2r_ij*dxij.x*dxij.x + force_div2r_ik*dxik.x*dxik.x);
+                                    tersoffAtomicAdd(&d_virial[1*virial_pitch+cur_k], d_force_fixed, 5*n_fixed + cur_k,
+                                                     force_div2r_ij*dxij.x*dxij.y + force_div2r_ik*dxik.x*dxik.y);
+                                    tersoffAtomicAdd(&d_virial[2*virial_pitch+cur_k], d_force_fixed, 6*n_fixed + cur_k,
+                                                     force_div2r_ij*dxij.x*dxij.z + force_div2r_ik*dxik.x*dxik.z);
+                                    tersoffAtomicAdd(&d_virial[3*virial_pitch+cur_k], d_force_fixed, 7*n_fixed + cur_k,
+                                                     force_div2r_ij*dxij.y*dxij.y + force_div2r_ik*dxik.y*dxik.y);
+                                    tersoffAtomicAdd(&d_virial[4*virial_pitch+cur_k], d_force_fixed, 8*n_fixed + cur_k,
+                                                     force_div2r_ij*dxij.y*dxij.z + force_div2r_ik*dxik.y*dxik.z);
+                                    tersoffAtomicAdd(&d_virial[5*virial_pitch+cur_k], d_force_fixed, 9*n_fixed + cur_k,
+                                                     force_div2r_ij*dxij.z*dxij.z + force_div2r_ik*dxik.z*dxik.z);
                                     }
                                 }
                             }
@@ -788,36 +877,36 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4 *d_force,
                     }
 
                 // write out the result for particle j
-                myAtomicAdd(&d_force[cur_j].x, forcej.x);
-                myAtomicAdd(&d_force[cur_j].y, forcej.y);
-                myAtomicAdd(&d_force[cur_j].z, forcej.z);
-                myAtomicAdd(&d_force[cur_j].w, forcej.w);
+                tersoffAtomicAdd(&d_force[cur_j].x, d_force_fixed, 0*n_fixed + cur_j, forcej.x);
+                tersoffAtomicAdd(&d_force[cur_j].y, d_force_fixed, 1*n_fixed + cur_j, forcej.y);
+                tersoffAtomicAdd(&d_force[cur_j].z, d_force_fixed, 2*n_fixed + cur_j, forcej.z);
+                tersoffAtomicAdd(&d_force[cur_j].w, d_force_fixed, 3*n_fixed + cur_j, forcej.w);
 
                 if (compute_virial)
                     {
-                    myAtomicAdd(&d_virial[0*virial_pitch+cur_j], virialj_xx);
-                    myAtomicAdd(&d_virial[1*virial_pitch+cur_j], virialj_xy);
-                    myAtomicAdd(&d_virial[2*virial_pitch+cur_j], virialj_xz);
-                    myAtomicAdd(&d_virial[3*virial_pitch+cur_j], virialj_yy);
-                    myAtomicAdd(&d_virial[4*virial_pitch+cur_j], virialj_yz);
-                    myAtomicAdd(&d_virial[5*virial_pitch+cur_j], virialj_zz);
+                    tersoffAtomicAdd(&d_virial[0*virial_pitch+cur_j], d_force_fixed, 4*n_fixed + cur_j, virialj_xx);
+                    tersoffAtomicAdd(&d_virial[1*virial_pitch+cur_j], d_force_fixed, 5*n_fixed + cur_j, virialj_xy);
+                    tersoffAtomicAdd(&d_virial[2*virial_pitch+cur_j], d_force_fixed, 6*n_fixed + cur_j, virialj_xz);
+                    tersoffAtomicAdd(&d_virial[3*virial_pitch+cur_j], d_force_fixed, 7*n_fixed + cur_j, virialj_yy);
+                    tersoffAtomicAdd(&d_virial[4*virial_pitch+cur_j], d_force_fixed, 8*n_fixed + cur_j, virialj_yz);
+                    tersoffAtomicAdd(&d_virial[5*virial_pitch+cur_j], d_force_fixed, 9*n_fixed + cur_j, virialj_zz);
                     }
                 }
             }
         // now that the force calculation is complete, write out the result (MEM TRANSFER: 20 bytes)
-        myAtomicAdd(&d_force[idx].x, forcei.x);
-        myAtomicAdd(&d_force[idx].y, forcei.y);
-        myAtomicAdd(&d_force[idx].z, forcei.z);
-        myAtomicAdd(&d_force[idx].w, forcei.w);
+        tersoffAtomicAdd(&d_force[idx].x, d_force_fixed, 0*n_fixed + idx, forcei.x);
+        tersoffAtomicAdd(&d_force[idx].y, d_force_fixed, 1*n_fixed + idx, forcei.y);
+        tersoffAtomicAdd(&d_force[idx].z, d_force_fixed, 2*n_fixed + idx, forcei.z);
+        tersoffAtomicAdd(&d_force[idx].w, d_force_fixed, 3*n_fixed + idx, forcei.w);
 
         if (compute_virial)
             {
-            myAtomicAdd(&d_virial[0*virial_pitch+idx], viriali_xx);
-            myAtomicAdd(&d_virial[1*virial_pitch+idx], viriali_xy);
-            myAtomicAdd(&d_virial[2*virial_pitch+idx], viriali_xz);
-            myAtomicAdd(&d_virial[3*virial_pitch+idx], viriali_yy);
-            myAtomicAdd(&d_virial[4*virial_pitch+idx], viriali_yz);
-            myAtomicAdd(&d_virial[5*virial_pitch+idx], viriali_zz);
+            tersoffAtomicAdd(&d_virial[0*virial_pitch+idx], d_force_fixed, 4*n_fixed + idx, viriali_xx);
+            tersoffAtomicAdd(&d_virial[1*virial_pitch+idx], d_force_fixed, 5*n_fixed + idx, viriali_xy);
+            tersoffAtomicAdd(&d_virial[2*virial_pitch+idx], d_force_fixed, 6*n_fixed + idx, viriali_xz);
+            tersoffAtomicAdd(&d_virial[3*virial_pitch+idx], d_force_fixed, 7*n_fixed + idx, viriali_yy);
+            tersoffAtomicAdd(&d_virial[4*virial_pitch+idx], d_force_fixed, 8*n_fixed + idx, viriali_yz);
+            tersoffAtomicAdd(&d_virial[5*virial_pitch+idx], d_force_fixed, 9*n_fixed + idx, viriali_zz);
             }
 	}
     }
@@ -850,6 +939,34 @@ __global__ void gpu_zero_forces_kernel(Scalar4 *d_force,
     d_virial[5*virial_pitch+idx] = Scalar(0.0);
     }
 
+//! Kernel for converting the fixed point forces and virial of the deterministic mode
+/*! \param d_force Device memory to write forces to
+    \param d_virial Device memory to write the virial to
+    \param virial_pitch Pitch of \a d_virial
+    \param d_force_fixed Fixed point accumulators, see gpu_compute_triplet_forces_kernel()
+    \param N Number of particles in \a d_force_fixed
+*/
+__global__ void gpu_convert_fixed_forces_kernel(Scalar4 *d_force,
+                                                Scalar *d_virial,
+                                                size_t virial_pitch,
+                                                const unsigned long long int *d_force_fixed,
+                                                const unsigned int N)
+    {
+    // identify the particle we are supposed to handle
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    d_force[idx] = make_scalar4(hoomd::detail::fixedPointToScalar(d_force_fixed[0*N+idx]),
+                                hoomd::detail::fixedPointToScalar(d_force_fixed[1*N+idx]),
+                                hoomd::detail::fixedPointToScalar(d_force_fixed[2*N+idx]),
+                                hoomd::detail::fixedPointToScalar(d_force_fixed[3*N+idx]));
+
+    for (unsigned int i = 0; i < 6; ++i)
+        d_virial[i*virial_pitch+idx] = hoomd::detail::fixedPointToScalar(d_force_fixed[(4+i)*N+idx]);
+    }
+
 template<typename T>
 void get_max_block_size(T func, const tersoff_args_t& pair_args, unsigned int& max_block_size, unsigned int& kernel_shared_bytes)
     {
@@ -904,11 +1021,29 @@ struct TersoffComputeKernel
                                * typpair_idx.getNumElements() + pair_args.ntypes*run_block_size*sizeof(Scalar));
                 }
 
+            // stage up to gpu_tersoff_max_tile neighbors per particle in the remaining shared memory
+            unsigned int tile_size = 0;
+            if (!evaluator::flag_for_RevCross)
+                {
+                size_t tile_offset = (shared_bytes + sizeof(Scalar4) - 1) / sizeof(Scalar4) * sizeof(Scalar4);
+                size_t tile_entry_bytes = (run_block_size/pair_args.tpp) * (sizeof(Scalar4) + sizeof(unsigned int));
+                size_t max_bytes = pair_args.devprop.sharedMemPerBlock - kernel_shared_bytes;
+                if (tile_offset < max_bytes)
+                    tile_size = (unsigned int)min((size_t)gpu_tersoff_max_tile, (max_bytes - tile_offset - 1)
+                                                  / tile_entry_bytes);
+                if (tile_size > 0)
+                    shared_bytes = (unsigned int)(tile_offset + tile_size*tile_entry_bytes);
+                }
+
             // zero the forces
-            hipLaunchKernelGGL((gpu_zero_forces_kernel), dim3((pair_args.N + pair_args.Nghosts)/run_block_size + 1), dim3(run_block_size), 0, 0, pair_args.d_force,
-                                                    pair_args.d_virial,
-                                                    pair_args.virial_pitch,
-                                                    pair_args.N + pair_args.Nghosts);
+            const unsigned int n_fixed = pair_args.N + pair_args.Nghosts;
+            if (pair_args.d_force_fixed)
+                hipMemsetAsync(pair_args.d_force_fixed, 0, sizeof(unsigned long long int)*10*n_fixed);
+            else
+                hipLaunchKernelGGL((gpu_zero_forces_kernel), dim3((pair_args.N + pair_args.Nghosts)/run_block_size + 1), dim3(run_block_size), 0, 0, pair_args.d_force,
+                                                        pair_args.d_virial,
+                                                        pair_args.virial_pitch,
+                                                        pair_args.N + pair_args.Nghosts);
 
             // setup the grid to run the kernel
             dim3 grid( pair_args.N / (run_block_size/pair_args.tpp) + 1, 1, 1);
@@ -926,7 +1061,18 @@ struct TersoffComputeKernel
                                                 d_params,
                                                 pair_args.d_rcutsq,
                                                 pair_args.d_ronsq,
-                                                pair_args.ntypes);
+                                                pair_args.ntypes,
+                                                tile_size,
+                                                pair_args.d_force_fixed,
+                                                n_fixed);
+
+            if (pair_args.d_force_fixed)
+                hipLaunchKernelGGL((gpu_convert_fixed_forces_kernel), dim3(n_fixed/run_block_size + 1), dim3(run_block_size), 0, 0,
+                                   pair_args.d_force,
+                                   pair_args.d_virial,
+                                   pair_args.virial_pitch,
+                                   pair_args.d_force_fixed,
+                                   n_fixed);
             }
         else
             {
@@ -57,6 +57,7 @@ class PotentialTersoffGPU : public PotentialTersoff<evaluator>
 
     protected:
         std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
+        GlobalArray<unsigned long long int> m_force_fixed; //!< Fixed point forces and virials in deterministic mode
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
@@ -147,6 +148,16 @@ void PotentialTersoffGPU< evaluator, gpu_cgpf >::computeForces(unsigned int time
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor];
 
+    // accumulate the 4 force and 6 virial components in fixed point for reproducible results
+    bool deterministic = this->m_exec_conf->isDeterministicReductions();
+    size_t n_fixed = 10*(size_t)(this->m_pdata->getN() + this->m_pdata->getNGhosts());
+    if (deterministic && m_force_fixed.getNumElements() < n_fixed)
+        {
+        GlobalArray<unsigned long long int> force_fixed(n_fixed, this->m_exec_conf);
+        m_force_fixed.swap(force_fixed);
+        }
+    ArrayHandle<unsigned long long int> d_force_fixed(m_force_fixed, access_location::device, access_mode::overwrite);
+
     this->m_tuner->begin();
     unsigned int param =  this->m_tuner->getParam();
     unsigned int block_size = param / 10000;
@@ -169,7 +180,8 @@ void PotentialTersoffGPU< evaluator, gpu_cgpf >::computeForces(unsigned int time
                             this->m_pdata->getNTypes(),
                             block_size,
                             threads_per_particle,
-                            this->m_exec_conf->dev_prop),
+                            this->m_exec_conf->dev_prop,
+                            deterministic ? d_force_fixed.data : NULL),
                             d_params.data);
 
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
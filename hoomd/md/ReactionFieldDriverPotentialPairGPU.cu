@@ -14,3 +14,5 @@ hipError_t gpu_compute_reaction_field_forces(const pair_args_t & args,
                                                      d_params);
     }
 
+template hipError_t gpu_compute_pair_set_energy<EvaluatorPairReactionField>(const pair_set_energy_args_t& args,
+    const EvaluatorPairReactionField::param_type *d_params);
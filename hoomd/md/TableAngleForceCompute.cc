@@ -5,6 +5,7 @@
 // Maintainer: phillicl
 
 #include "TableAngleForceCompute.h"
+#include "TableInterpolation.h"
 
 namespace py = pybind11;
 
@@ -250,18 +251,13 @@ void TableAngleForceCompute::computeForces(unsigned int timestep)
         unsigned int value_i = (unsigned int)(slow::floor(value_f));
         Scalar2 VT0 = h_tables.data[m_table_value(value_i, angle_type)];
         Scalar2 VT1 = h_tables.data[m_table_value(value_i+1, angle_type)];
-        // unpack the data
-        Scalar V0 = VT0.x;
-        Scalar V1 = VT1.x;
-        Scalar T0 = VT0.y;
-        Scalar T1 = VT1.y;
 
-        // compute the linear interpolation coefficient
+        // compute the interpolation coefficient
         Scalar f = value_f - Scalar(value_i);
 
         // interpolate to get V and T;
-        Scalar V = V0 + f * (V1 - V0);
-        Scalar T = T0 + f * (T1 - T0);
+        Scalar V, T;
+        interpolateTable(VT0, VT1, f, delta_th, m_cubic, V, T);
 
         Scalar a =  T*s_abbc;
         Scalar a11 = a*c_abbc/rsqab;
@@ -333,5 +329,6 @@ void export_TableAngleForceCompute(py::module& m)
     py::class_<TableAngleForceCompute, ForceCompute, std::shared_ptr<TableAngleForceCompute> >(m, "TableAngleForceCompute")
     .def(py::init< std::shared_ptr<SystemDefinition>, unsigned int, const std::string& >())
     .def("setTable", &TableAngleForceCompute::setTable)
+    .def_property("cubic", &TableAngleForceCompute::getCubic, &TableAngleForceCompute::setCubic)
     ;
     }
@@ -49,6 +49,9 @@
     Values are interpolated linearly between two points straddling the given r. For a given r, the first point needed, i
     can be calculated via i = floorf((r - thmin) / dr). The fraction between ri and ri+1 can be calculated via
     f = (r - thmin) / dr - Scalar(i). And the linear interpolation can then be performed via V(r) ~= Vi + f * (Vi+1 - Vi)
+
+    When setCubic() is enabled, V is interpolated with the cubic Hermite polynomial through Vi and Vi+1 with the slopes
+    -Ti and -Ti+1, and T is its derivative (see interpolateTable()).
     \ingroup computes
 */
 class PYBIND11_EXPORT TableAngleForceCompute : public ForceCompute
@@ -68,6 +71,20 @@ class PYBIND11_EXPORT TableAngleForceCompute : public ForceCompute
                               const std::vector<Scalar> &T
                               );
 
+        //! Set the interpolation scheme
+        /*! \param cubic Set to true for cubic Hermite interpolation, false for linear interpolation
+        */
+        void setCubic(bool cubic)
+            {
+            m_cubic = cubic;
+            }
+
+        //! Test if the tables are interpolated with cubic Hermite polynomials
+        bool getCubic()
+            {
+            return m_cubic;
+            }
+
         //! Returns a list of log quantities this compute calculates
         virtual std::vector< std::string > getProvidedLogQuantities();
 
@@ -94,6 +111,7 @@ class PYBIND11_EXPORT TableAngleForceCompute : public ForceCompute
         GPUArray<Scalar2> m_tables;                  //!< Stored V and T tables
         Index2D m_table_value;                      //!< Index table helper
         std::string m_log_name;                     //!< Cached log name
+        bool m_cubic = false;                       //!< True for cubic Hermite interpolation
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
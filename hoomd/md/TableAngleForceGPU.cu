@@ -6,6 +6,7 @@
 // Maintainer: phillicl
 
 #include "TableAngleForceGPU.cuh"
+#include "TableInterpolation.h"
 #include "hoomd/TextureTools.h"
 
 #include <assert.h>
@@ -33,6 +34,7 @@
     \param d_tables Tables of the potential and force
     \param table_value index helper function
     \param delta_th angle delta of the table
+    \param cubic Set to true for cubic Hermite interpolation of the tables
 
     See TableAngleForceCompute for information on the memory layout.
 */
@@ -48,7 +50,8 @@ __global__ void gpu_compute_table_angle_forces_kernel(Scalar4* d_force,
                                      const unsigned int *n_angles_list,
                                      const Scalar2 *d_tables,
                                      const Index2D table_value,
-                                     const Scalar delta_th)
+                                     const Scalar delta_th,
+                                     const bool cubic)
     {
 
 
@@ -148,18 +151,13 @@ __global__ void gpu_compute_table_angle_forces_kernel(Scalar4* d_force,
         unsigned int value_i = value_f;
         Scalar2 VT0 = __ldg(d_tables + table_value(value_i, cur_angle_type));
         Scalar2 VT1 = __ldg(d_tables + table_value(value_i+1, cur_angle_type));
-        // unpack the data
-        Scalar V0 = VT0.x;
-        Scalar V1 = VT1.x;
-        Scalar T0 = VT0.y;
-        Scalar T1 = VT1.y;
 
-        // compute the linear interpolation coefficient
+        // compute the interpolation coefficient
         Scalar f = value_f - Scalar(value_i);
 
         // interpolate to get V and T;
-        Scalar V = V0 + f * (V1 - V0);
-        Scalar T = T0 + f * (T1 - T0);
+        Scalar V, T;
+        interpolateTable(VT0, VT1, f, delta_th, cubic, V, T);
 
 
         Scalar a = T * s_abbc;
@@ -232,6 +230,7 @@ __global__ void gpu_compute_table_angle_forces_kernel(Scalar4* d_force,
     \param d_tables Tables of the potential and force
     \param table_width Number of points in each table
     \param table_value indexer helper
+    \param cubic Set to true for cubic Hermite interpolation of the tables
     \param block_size Block size at which to run the kernel
     \param compute_capability Compute capability of the device (200, 300, 350, ...)
 
@@ -250,6 +249,7 @@ hipError_t gpu_compute_table_angle_forces(Scalar4* d_force,
                                      const Scalar2 *d_tables,
                                      const unsigned int table_width,
                                      const Index2D &table_value,
+                                     const bool cubic,
                                      const unsigned int block_size)
     {
     assert(d_tables);
@@ -286,7 +286,8 @@ hipError_t gpu_compute_table_angle_forces(Scalar4* d_force,
              n_angles_list,
              d_tables,
              table_value,
-             delta_th);
+             delta_th,
+             cubic);
 
     return hipSuccess;
     }
@@ -5,6 +5,7 @@
 // Maintainer: phillicl
 
 #include "TableDihedralForceCompute.h"
+#include "TableInterpolation.h"
 #include "hoomd/VectorMath.h"
 
 namespace py = pybind11;
@@ -281,18 +282,13 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
         unsigned int value_i = (unsigned int)value_f;
         Scalar2 VT0 = h_tables.data[m_table_value(value_i, dihedral_type)];
         Scalar2 VT1 = h_tables.data[m_table_value(value_i+1, dihedral_type)];
-        // unpack the data
-        Scalar V0 = VT0.x;
-        Scalar V1 = VT1.x;
-        Scalar T0 = VT0.y;
-        Scalar T1 = VT1.y;
 
-        // compute the linear interpolation coefficient
+        // compute the interpolation coefficient
         Scalar f = value_f - Scalar(value_i);
 
         // interpolate to get V and T;
-        Scalar V = V0 + f * (V1 - V0);
-        Scalar T = T0 + f * (T1 - T0);
+        Scalar V, T;
+        interpolateTable(VT0, VT1, f, delta_phi, m_cubic, V, T);
 
         // from Blondel and Karplus 1995
         vec3<Scalar> A = cross(vec3<Scalar>(dab),vec3<Scalar>(dcbm));
@@ -359,6 +355,7 @@ void export_TableDihedralForceCompute(py::module& m)
     py::class_<TableDihedralForceCompute, ForceCompute, std::shared_ptr<TableDihedralForceCompute> >(m, "TableDihedralForceCompute")
     .def(py::init< std::shared_ptr<SystemDefinition>, unsigned int, const std::string& >())
     .def("setTable", &TableDihedralForceCompute::setTable)
+    .def_property("cubic", &TableDihedralForceCompute::getCubic, &TableDihedralForceCompute::setCubic)
     .def("getEntry", &TableDihedralForceCompute::getEntry)
     ;
     }
@@ -84,6 +84,7 @@ void TableDihedralForceComputeGPU::computeForces(unsigned int timestep)
                              d_tables.data,
                              m_table_width,
                              m_table_value,
+                             m_cubic,
                              m_tuner->getParam());
         }
 
@@ -6,6 +6,7 @@
 // Maintainer: phillicl
 
 #include "TableDihedralForceGPU.cuh"
+#include "TableInterpolation.h"
 #include "hoomd/TextureTools.h"
 
 #include "hoomd/VectorMath.h"
@@ -34,6 +35,7 @@
     \param d_tables Tables of the potential and force
     \param table_value index helper function
     \param delta_phi dihedral delta of the table
+    \param cubic Set to true for cubic Hermite interpolation of the tables
 
     See TableDihedralForceCompute for information on the memory layout.
 */
@@ -49,7 +51,8 @@ __global__ void gpu_compute_table_dihedral_forces_kernel(Scalar4* d_force,
                                      const unsigned int *n_dihedrals_list,
                                      const Scalar2 *d_tables,
                                      const Index2D table_value,
-                                     const Scalar delta_phi)
+                                     const Scalar delta_phi,
+                                     const bool cubic)
     {
 
 
@@ -201,18 +204,13 @@ __global__ void gpu_compute_table_dihedral_forces_kernel(Scalar4* d_force,
         unsigned int value_i = value_f;
         Scalar2 VT0 = __ldg(d_tables + table_value(value_i, cur_dihedral_type));
         Scalar2 VT1 = __ldg(d_tables + table_value(value_i+1, cur_dihedral_type));
-        // unpack the data
-        Scalar V0 = VT0.x;
-        Scalar V1 = VT1.x;
-        Scalar T0 = VT0.y;
-        Scalar T1 = VT1.y;
 
-        // compute the linear interpolation coefficient
+        // compute the interpolation coefficient
         Scalar f = value_f - Scalar(value_i);
 
         // interpolate to get V and T;
-        Scalar V = V0 + f * (V1 - V0);
-        Scalar T = T0 + f * (T1 - T0);
+        Scalar V, T;
+        interpolateTable(VT0, VT1, f, delta_phi, cubic, V, T);
 
         // from Blondel and Karplus 1995
         vec3<Scalar> A = cross(vec3<Scalar>(dab),vec3<Scalar>(dcbm));
@@ -293,6 +291,7 @@ __global__ void gpu_compute_table_dihedral_forces_kernel(Scalar4* d_force,
     \param d_tables Tables of the potential and force
     \param table_width Number of points in each table
     \param table_value indexer helper
+    \param cubic Set to true for cubic Hermite interpolation of the tables
     \param block_size Block size at which to run the kernel
     \param compute_capability Compute capability of the device (200, 300, 350, ...)
 
@@ -311,6 +310,7 @@ hipError_t gpu_compute_table_dihedral_forces(Scalar4* d_force,
                                      const Scalar2 *d_tables,
                                      const unsigned int table_width,
                                      const Index2D &table_value,
+                                     const bool cubic,
                                      const unsigned int block_size)
     {
     assert(d_tables);
@@ -347,7 +347,8 @@ hipError_t gpu_compute_table_dihedral_forces(Scalar4* d_force,
              n_dihedrals_list,
              d_tables,
              table_value,
-             delta_phi);
+             delta_phi,
+             cubic);
 
     return hipSuccess;
     }
@@ -30,6 +30,7 @@ hipError_t gpu_compute_table_dihedral_forces(Scalar4* d_force,
                                      const Scalar2 *d_tables,
                                      const unsigned int table_width,
                                      const Index2D &table_value,
+                                     const bool cubic,
                                      const unsigned int block_size);
 
 #endif
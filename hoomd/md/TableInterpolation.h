@@ -0,0 +1,70 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __TABLE_INTERPOLATION_H__
+#define __TABLE_INTERPOLATION_H__
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file TableInterpolation.h
+    \brief Defines the interpolation of the tabulated potentials
+*/
+
+// need to declare these functions with __host__ __device__ qualifiers when building in nvcc
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+//! Interpolate a table of V(x) and F(x) = -dV/dx between two grid points
+/*! \param VF0 V and F at the grid point below x
+    \param VF1 V and F at the grid point above x
+    \param f Position of x between the grid points, as a fraction of the grid spacing
+    \param delta Grid spacing
+    \param cubic Set to true for cubic Hermite interpolation, false for linear interpolation
+    \param V Output: the interpolated V
+    \param F Output: the interpolated F
+
+    Linear interpolation interpolates V and F independently, with errors of order delta^2. Cubic Hermite interpolation
+    uses the cubic polynomial through V0 and V1 with the slopes -F0 and -F1, and returns F = -dV/dx of that same
+    polynomial. Its errors are of order delta^4 in V and delta^3 in F, so a table with about 10 times fewer points
+    reaches the accuracy of linear interpolation, and F is exactly the derivative of V, which conserves energy. Both
+    schemes read the same table values.
+*/
+HOSTDEVICE inline void interpolateTable(const Scalar2& VF0,
+                                        const Scalar2& VF1,
+                                        Scalar f,
+                                        Scalar delta,
+                                        bool cubic,
+                                        Scalar& V,
+                                        Scalar& F)
+    {
+    if (!cubic)
+        {
+        V = VF0.x + f * (VF1.x - VF0.x);
+        F = VF0.y + f * (VF1.y - VF0.y);
+        return;
+        }
+
+    // Hermite basis functions and their derivatives with respect to f
+    const Scalar f2 = f * f;
+    const Scalar f3 = f2 * f;
+    const Scalar h00 = Scalar(2.0) * f3 - Scalar(3.0) * f2 + Scalar(1.0);
+    const Scalar h10 = f3 - Scalar(2.0) * f2 + f;
+    const Scalar h01 = Scalar(3.0) * f2 - Scalar(2.0) * f3;
+    const Scalar h11 = f3 - f2;
+    const Scalar dh00 = Scalar(6.0) * (f2 - f);
+    const Scalar dh10 = Scalar(3.0) * f2 - Scalar(4.0) * f + Scalar(1.0);
+    const Scalar dh11 = Scalar(3.0) * f2 - Scalar(2.0) * f;
+
+    // the slopes dV/dx are -F
+    V = h00 * VF0.x + h01 * VF1.x - delta * (h10 * VF0.y + h11 * VF1.y);
+    F = dh00 * (VF1.x - VF0.x) / delta + dh10 * VF0.y + dh11 * VF1.y;
+    }
+
+// undefine HOSTDEVICE so we don't interfere with other headers
+#undef HOSTDEVICE
+
+#endif // __TABLE_INTERPOLATION_H__
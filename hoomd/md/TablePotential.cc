@@ -4,6 +4,7 @@
 
 // Maintainer: joaander
 #include "TablePotential.h"
+#include "TableInterpolation.h"
 
 namespace py = pybind11;
 
@@ -373,18 +374,13 @@ void TablePotential::computeForces(unsigned int timestep)
                 unsigned int value_i = (unsigned int)floor(value_f);
                 Scalar2 VF0 = h_tables.data[table_value(value_i, cur_table_index)];
                 Scalar2 VF1 = h_tables.data[table_value(value_i+1, cur_table_index)];
-                // unpack the data
-                Scalar V0 = VF0.x;
-                Scalar V1 = VF1.x;
-                Scalar F0 = VF0.y;
-                Scalar F1 = VF1.y;
 
-                // compute the linear interpolation coefficient
+                // compute the interpolation coefficient
                 Scalar f = value_f - Scalar(value_i);
 
                 // interpolate to get V and F;
-                Scalar V = V0 + f * (V1 - V0);
-                Scalar F = F0 + f * (F1 - F0);
+                Scalar V, F;
+                interpolateTable(VF0, VF1, f, delta_r, m_cubic, V, F);
 
                 // convert to standard variables used by the other pair computes in HOOMD-blue
                 Scalar forcemag_divr = Scalar(0.0);
@@ -447,5 +443,6 @@ void export_TablePotential(py::module& m)
     py::class_<TablePotential, ForceCompute, std::shared_ptr<TablePotential> >(m, "TablePotential")
     .def(py::init< std::shared_ptr<SystemDefinition>, std::shared_ptr<NeighborList>, unsigned int, const std::string& >())
     .def("setTable", &TablePotential::setTable)
+    .def_property("cubic", &TablePotential::getCubic, &TablePotential::setCubic)
     ;
     }
@@ -56,6 +56,10 @@
     Values are interpolated linearly between two points straddling the given r. For a given r, the first point needed, i
     can be calculated via i = floorf((r - rmin) / dr). The fraction between ri and ri+1 can be calculated via
     f = (r - rmin) / dr - Scalar(i). And the linear interpolation can then be performed via V(r) ~= Vi + f * (Vi+1 - Vi)
+
+    When setCubic() is enabled, V is interpolated with the cubic Hermite polynomial through Vi and Vi+1 with the slopes
+    -Fi and -Fi+1, and F is its derivative (see interpolateTable()). This reaches the accuracy of linear interpolation
+    with much smaller tables.
     \ingroup computes
 */
 class PYBIND11_EXPORT TablePotential : public ForceCompute
@@ -78,6 +82,20 @@ class PYBIND11_EXPORT TablePotential : public ForceCompute
                               Scalar rmin,
                               Scalar rmax);
 
+        //! Set the interpolation scheme
+        /*! \param cubic Set to true for cubic Hermite interpolation, false for linear interpolation
+        */
+        void setCubic(bool cubic)
+            {
+            m_cubic = cubic;
+            }
+
+        //! Test if the tables are interpolated with cubic Hermite polynomials
+        bool getCubic()
+            {
+            return m_cubic;
+            }
+
         //! Returns a list of log quantities this compute calculates
         virtual std::vector< std::string > getProvidedLogQuantities();
 
@@ -100,6 +118,7 @@ class PYBIND11_EXPORT TablePotential : public ForceCompute
         GlobalArray<Scalar2> m_tables;                  //!< Stored V and F tables
         GlobalArray<Scalar4> m_params;                 //!< Parameters stored for each table
         std::string m_log_name;                     //!< Cached log name
+        bool m_cubic = false;                       //!< True for cubic Hermite interpolation
 
         /// Indexer into the tables
         Index2DUpperTriangular m_type_pair_idx;
@@ -97,6 +97,8 @@ void TablePotentialGPU::computeForces(unsigned int timestep)
                              m_ntypes,
                              m_table_width,
                              m_tuner->getParam(),
+                             m_cubic,
+                             m_exec_conf->dev_prop.sharedMemPerBlock,
                              m_pdata->getGPUPartition());
 
     if(m_exec_conf->isCUDAErrorCheckingEnabled())
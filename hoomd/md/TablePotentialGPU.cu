@@ -6,6 +6,7 @@
 // Maintainer: joaander
 
 #include "TablePotentialGPU.cuh"
+#include "TableInterpolation.h"
 #include "hoomd/TextureTools.h"
 
 #include "hoomd/Index1D.h"
@@ -30,13 +31,15 @@
     \param d_params Parameters for each table associated with a type pair
     \param ntypes Number of particle types in the system
     \param table_width Number of points in each table
+    \param cubic Set to true for cubic Hermite interpolation
     \param offset Offset in number of particles for this kernel
 
     See TablePotential for information on the memory layout.
 
-    \tparam use_gmem_nlist When non-zero, the neighbor list is read out of global memory. When zero, textures or __ldg
-                           is used depending on architecture.
+    \tparam smem_tables When true, each block copies the tables to shared memory after the parameters and reads them
+                        from there. When false, the tables are read from global memory with __ldg.
 */
+template<bool smem_tables>
 __global__ void gpu_compute_table_forces_kernel(Scalar4* d_force,
                                                 Scalar* d_virial,
                                                 const size_t virial_pitch,
@@ -50,6 +53,7 @@ __global__ void gpu_compute_table_forces_kernel(Scalar4* d_force,
                                                 const Scalar4 *d_params,
                                                 const unsigned int ntypes,
                                                 const unsigned int table_width,
+                                                const bool cubic,
                                                 const unsigned int offset
                                                 )
     {
@@ -64,6 +68,18 @@ __global__ void gpu_compute_table_forces_kernel(Scalar4* d_force,
         if (cur_offset + threadIdx.x < table_index.getNumElements())
             s_params[cur_offset + threadIdx.x] = d_params[cur_offset + threadIdx.x];
         }
+
+    // the tables follow the parameters in shared memory
+    Scalar2 *s_tables = (Scalar2 *)(s_params + table_index.getNumElements());
+    if (smem_tables)
+        {
+        const unsigned int n_values = table_value.getNumElements() * table_index.getNumElements();
+        for (unsigned int cur_offset = 0; cur_offset < n_values; cur_offset += blockDim.x)
+            {
+            if (cur_offset + threadIdx.x < n_values)
+                s_tables[cur_offset + threadIdx.x] = __ldg(d_tables + cur_offset + threadIdx.x);
+            }
+        }
     __syncthreads();
 
     // start by identifying which particle we are to handle
@@ -134,21 +150,24 @@ __global__ void gpu_compute_table_forces_kernel(Scalar4* d_force,
 
             // compute index into the table and read in values
             unsigned int value_i = floor(value_f);
-            Scalar2 VF0 = __ldg(d_tables + table_value(value_i, cur_table_index));
-            Scalar2 VF1 = __ldg(d_tables + table_value(value_i+1, cur_table_index));
-
-            // unpack the data
-            Scalar V0 = VF0.x;
-            Scalar V1 = VF1.x;
-            Scalar F0 = VF0.y;
-            Scalar F1 = VF1.y;
-
-            // compute the linear interpolation coefficient
+            Scalar2 VF0, VF1;
+            if (smem_tables)
+                {
+                VF0 = s_tables[table_value(value_i, cur_table_index)];
+                VF1 = s_tables[table_value(value_i+1, cur_table_index)];
+                }
+            else
+                {
+                VF0 = __ldg(d_tables + table_value(value_i, cur_table_index));
+                VF1 = __ldg(d_tables + table_value(value_i+1, cur_table_index));
+                }
+
+            // compute the interpolation coefficient
             Scalar f = value_f - Scalar(value_i);
 
             // interpolate to get V and F;
-            Scalar V = V0 + f * (V1 - V0);
-            Scalar F = F0 + f * (F1 - F0);
+            Scalar V, F;
+            interpolateTable(VF0, VF1, f, delta_r, cubic, V, F);
 
             // convert to standard variables used by the other pair computes in HOOMD-blue
             Scalar forcemag_divr = Scalar(0.0);
@@ -200,6 +219,10 @@ __global__ void gpu_compute_table_forces_kernel(Scalar4* d_force,
     \param ntypes Number of particle types in the system
     \param table_width Number of points in each table
     \param block_size Block size at which to run the kernel
+    \param cubic Set to true for cubic Hermite interpolation
+    \param max_shared_bytes Shared memory available per block
+
+    The tables are staged in shared memory when they fit next to the parameters in \a max_shared_bytes.
 
     \note This is just a kernel driver. See gpu_compute_table_forces_kernel for full documentation.
 */
@@ -219,6 +242,8 @@ hipError_t gpu_compute_table_forces(Scalar4* d_force,
                                      const unsigned int ntypes,
                                      const unsigned int table_width,
                                      const unsigned int block_size,
+                                     const bool cubic,
+                                     const size_t max_shared_bytes,
                                      const GPUPartition& gpu_partition)
     {
     assert(d_params);
@@ -229,6 +254,11 @@ hipError_t gpu_compute_table_forces(Scalar4* d_force,
     // index calculation helper
     Index2DUpperTriangular table_index(ntypes);
 
+    // stage the tables in shared memory when they fit
+    const size_t params_bytes = sizeof(Scalar4)*table_index.getNumElements();
+    const size_t tables_bytes = sizeof(Scalar2)*table_width*table_index.getNumElements();
+    const bool smem_tables = params_bytes + tables_bytes <= max_shared_bytes;
+
     // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
     for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
         {
@@ -238,33 +268,34 @@ hipError_t gpu_compute_table_forces(Scalar4* d_force,
         if (max_block_size == UINT_MAX)
             {
             hipFuncAttributes attr;
-            hipFuncGetAttributes(&attr, reinterpret_cast<const void *>(gpu_compute_table_forces_kernel));
+            hipFuncGetAttributes(&attr, reinterpret_cast<const void *>(gpu_compute_table_forces_kernel<false>));
             max_block_size = attr.maxThreadsPerBlock;
+            hipFuncGetAttributes(&attr, reinterpret_cast<const void *>(gpu_compute_table_forces_kernel<true>));
+            max_block_size = min(max_block_size, (unsigned int)attr.maxThreadsPerBlock);
             }
 
         unsigned int run_block_size = min(block_size, max_block_size);
 
-        // index calculation helper
-        Index2DUpperTriangular table_index(ntypes);
-
         // setup the grid to run the kernel
         dim3 grid( (range.second-range.first) / run_block_size + 1, 1, 1);
         dim3 threads(run_block_size, 1, 1);
 
-        hipLaunchKernelGGL((gpu_compute_table_forces_kernel), dim3(grid), dim3(threads), sizeof(Scalar4)*table_index.getNumElements() , 0, d_force,
-                                                                                                           d_virial,
-                                                                                                           virial_pitch,
-                                                                                                           range.second-range.first,
-                                                                                                           d_pos,
-                                                                                                           box,
-                                                                                                           d_n_neigh,
-                                                                                                           d_nlist,
-                                                                                                           d_head_list,
-                                                                                                           d_tables,
-                                                                                                           d_params,
-                                                                                                           ntypes,
-                                                                                                           table_width,
-                                                                                                           range.first);
+        if (smem_tables)
+            {
+            hipLaunchKernelGGL((gpu_compute_table_forces_kernel<true>), dim3(grid), dim3(threads),
+                               params_bytes + tables_bytes, 0,
+                               d_force, d_virial, virial_pitch, range.second-range.first, d_pos, box,
+                               d_n_neigh, d_nlist, d_head_list, d_tables, d_params, ntypes, table_width,
+                               cubic, range.first);
+            }
+        else
+            {
+            hipLaunchKernelGGL((gpu_compute_table_forces_kernel<false>), dim3(grid), dim3(threads),
+                               params_bytes, 0,
+                               d_force, d_virial, virial_pitch, range.second-range.first, d_pos, box,
+                               d_n_neigh, d_nlist, d_head_list, d_tables, d_params, ntypes, table_width,
+                               cubic, range.first);
+            }
         }
     return hipSuccess;
     }
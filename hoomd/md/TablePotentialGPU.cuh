@@ -33,6 +33,8 @@ hipError_t gpu_compute_table_forces(Scalar4* d_force,
                                      const unsigned int ntypes,
                                      const unsigned int table_width,
                                      const unsigned int block_size,
+                                     const bool cubic,
+                                     const size_t max_shared_bytes,
                                      const GPUPartition& gpu_partition);
 
 #endif
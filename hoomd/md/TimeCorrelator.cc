@@ -0,0 +1,359 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file TimeCorrelator.cc
+    \brief Contains code for the TimeCorrelator class
+*/
+
+#include "TimeCorrelator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \param sysdef System definition
+    \param group Group of the correlated particles
+    \param thermo Pressure tensor of the group, used only by the stress quantity
+    \param quantity Correlated quantity
+    \param period Time steps between samples, only used to report the lags
+    \param num_points Number of values per level
+    \param num_levels Number of levels
+    \param averaging Number of values of a level averaged into one value of the next, must divide \a num_points
+*/
+TimeCorrelator::TimeCorrelator(std::shared_ptr<SystemDefinition> sysdef,
+                               std::shared_ptr<ParticleGroup> group,
+                               std::shared_ptr<ComputeThermo> thermo,
+                               Quantity quantity,
+                               unsigned int period,
+                               unsigned int num_points,
+                               unsigned int num_levels,
+                               unsigned int averaging)
+    : Analyzer(sysdef), m_group(group), m_thermo(thermo), m_quantity(quantity), m_period(period),
+      m_num_points(num_points), m_num_levels(num_levels), m_averaging(averaging), m_num_samples(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing TimeCorrelator" << endl;
+
+    if (m_num_levels == 0 || m_averaging < 2 || m_num_points < m_averaging || m_num_points % m_averaging != 0)
+        {
+        m_exec_conf->msg->error() << "TimeCorrelator: num_levels must be positive and averaging at least 2 and a "
+                                  << "divisor of num_points" << endl;
+        throw runtime_error("Error initializing TimeCorrelator");
+        }
+
+    if (double(m_num_points) * pow(double(m_averaging), double(m_num_levels - 1)) * double(m_period)
+        >= double(0xffffffff))
+        {
+        m_exec_conf->msg->error() << "TimeCorrelator: the longest lag exceeds the range of time steps" << endl;
+        throw runtime_error("Error initializing TimeCorrelator");
+        }
+
+    if (m_quantity == stress)
+        {
+        if (!m_thermo)
+            {
+            m_exec_conf->msg->error() << "TimeCorrelator: the stress quantity needs a ComputeThermo" << endl;
+            throw runtime_error("Error initializing TimeCorrelator");
+            }
+        m_num_items = 1;
+        }
+    else
+        {
+        #ifdef ENABLE_MPI
+        if (m_pdata->getDomainDecomposition())
+            {
+            m_exec_conf->msg->error() << "TimeCorrelator: per-particle quantities are not available with domain "
+                                      << "decomposition" << endl;
+            throw runtime_error("Error initializing TimeCorrelator");
+            }
+        #endif
+        m_num_items = m_group->getNumMembersGlobal();
+        }
+
+    const unsigned int n = std::max(m_num_items, 1u);
+
+    GlobalArray<unsigned int> item_tags(n, m_exec_conf);
+    m_item_tags.swap(item_tags);
+    TAG_ALLOCATION(m_item_tags);
+
+    if (m_quantity != stress)
+        {
+        ArrayHandle<unsigned int> h_item_tags(m_item_tags, access_location::host, access_mode::overwrite);
+        for (unsigned int k = 0; k < m_num_items; k++)
+            h_item_tags.data[k] = m_group->getMemberTag(k);
+        }
+
+    GlobalArray<Scalar3> values(n, m_exec_conf);
+    m_values.swap(values);
+    TAG_ALLOCATION(m_values);
+
+    GlobalArray<Scalar3> shift(m_num_levels * m_num_points * n, m_exec_conf);
+    m_shift.swap(shift);
+    TAG_ALLOCATION(m_shift);
+
+    GlobalArray<Scalar3> accum(m_num_levels * n, m_exec_conf);
+    m_accum.swap(accum);
+    TAG_ALLOCATION(m_accum);
+
+    GlobalArray<Scalar> lag_sums(m_num_points, m_exec_conf);
+    m_lag_sums.swap(lag_sums);
+    TAG_ALLOCATION(m_lag_sums);
+
+    m_head.resize(m_num_levels);
+    m_count.resize(m_num_levels);
+    m_num_accum.resize(m_num_levels);
+    m_corr.resize(m_num_levels * m_num_points);
+    m_num_corr.resize(m_num_levels * m_num_points);
+    reset();
+    }
+
+TimeCorrelator::~TimeCorrelator()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying TimeCorrelator" << endl;
+    }
+
+PDataFlags TimeCorrelator::getRequestedPDataFlags()
+    {
+    PDataFlags flags(0);
+    if (m_quantity == stress)
+        flags[pdata_flag::pressure_tensor] = 1;
+    return flags;
+    }
+
+/*! \param timestep Current time step of the simulation
+*/
+void TimeCorrelator::analyze(unsigned int timestep)
+    {
+    if (m_num_items == 0)
+        return;
+
+    if (m_prof) m_prof->push(m_exec_conf, "TimeCorrelator");
+
+    if (m_quantity == stress)
+        {
+        m_thermo->compute(timestep);
+        loadStress();
+        }
+    else
+        {
+        loadValues();
+        }
+
+    push(0);
+    m_num_samples++;
+
+    if (m_prof) m_prof->pop(m_exec_conf);
+    }
+
+/*! \param level Level to add m_values to
+
+    Adding the \a averaging th value to the accumulator of a level passes the average on to the next level.
+*/
+void TimeCorrelator::push(unsigned int level)
+    {
+    m_head[level] = (m_head[level] + 1) % m_num_points;
+    storeValues(level, m_head[level]);
+    m_count[level] = std::min(m_count[level] + 1, m_num_points);
+
+    // the shorter lags of the higher levels are already covered by the lower levels
+    const unsigned int first_lag = level == 0 ? 0 : m_num_points / m_averaging;
+    if (m_count[level] > first_lag)
+        {
+        const unsigned int num_lags = m_count[level] - first_lag;
+        correlate(level, first_lag, num_lags);
+
+        ArrayHandle<Scalar> h_lag_sums(m_lag_sums, access_location::host, access_mode::read);
+        for (unsigned int k = 0; k < num_lags; k++)
+            {
+            m_corr[level * m_num_points + first_lag + k] += h_lag_sums.data[k];
+            m_num_corr[level * m_num_points + first_lag + k]++;
+            }
+        }
+
+    if (level + 1 < m_num_levels)
+        {
+        m_num_accum[level]++;
+        if (m_num_accum[level] == m_averaging)
+            {
+            m_num_accum[level] = 0;
+            average(level);
+            push(level + 1);
+            }
+        }
+    }
+
+void TimeCorrelator::loadValues()
+    {
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_item_tags(m_item_tags, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_values(m_values, access_location::host, access_mode::overwrite);
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    for (unsigned int k = 0; k < m_num_items; k++)
+        {
+        unsigned int idx = h_rtag.data[h_item_tags.data[k]];
+        if (m_quantity == msd)
+            {
+            Scalar3 pos = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z);
+            h_values.data[k] = box.shift(pos, h_image.data[idx]);
+            }
+        else
+            {
+            h_values.data[k] = make_scalar3(h_vel.data[idx].x, h_vel.data[idx].y, h_vel.data[idx].z);
+            }
+        }
+    }
+
+void TimeCorrelator::loadStress()
+    {
+    PressureTensor p = m_thermo->getPressureTensor();
+    ArrayHandle<Scalar3> h_values(m_values, access_location::host, access_mode::overwrite);
+    h_values.data[0] = make_scalar3(p.xy, p.xz, p.yz);
+    }
+
+/*! \param level Level to store the values in
+    \param slot Slot of the level to store the values in
+*/
+void TimeCorrelator::storeValues(unsigned int level, unsigned int slot)
+    {
+    ArrayHandle<Scalar3> h_values(m_values, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_shift(m_shift, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar3> h_accum(m_accum, access_location::host, access_mode::readwrite);
+
+    Scalar3 *shift = h_shift.data + (level * m_num_points + slot) * m_num_items;
+    Scalar3 *accum = h_accum.data + level * m_num_items;
+    for (unsigned int k = 0; k < m_num_items; k++)
+        {
+        shift[k] = h_values.data[k];
+        accum[k] += h_values.data[k];
+        }
+    }
+
+/*! \param level Level to correlate
+    \param first_lag First lag to correlate
+    \param num_lags Number of lags to correlate, writes m_lag_sums[0] to m_lag_sums[num_lags-1]
+*/
+void TimeCorrelator::correlate(unsigned int level, unsigned int first_lag, unsigned int num_lags)
+    {
+    ArrayHandle<Scalar3> h_shift(m_shift, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_lag_sums(m_lag_sums, access_location::host, access_mode::overwrite);
+
+    const Scalar3 *newest = h_shift.data + (level * m_num_points + m_head[level]) * m_num_items;
+    for (unsigned int k = 0; k < num_lags; k++)
+        {
+        unsigned int slot = (m_head[level] + m_num_points - first_lag - k) % m_num_points;
+        const Scalar3 *older = h_shift.data + (level * m_num_points + slot) * m_num_items;
+
+        Scalar sum = Scalar(0.0);
+        for (unsigned int i = 0; i < m_num_items; i++)
+            {
+            if (m_quantity == msd)
+                {
+                Scalar3 d = newest[i] - older[i];
+                sum += dot(d, d);
+                }
+            else
+                {
+                sum += dot(newest[i], older[i]);
+                }
+            }
+        h_lag_sums.data[k] = sum;
+        }
+    }
+
+/*! \param level Level of the accumulator to average
+*/
+void TimeCorrelator::average(unsigned int level)
+    {
+    ArrayHandle<Scalar3> h_accum(m_accum, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar3> h_values(m_values, access_location::host, access_mode::overwrite);
+
+    Scalar3 *accum = h_accum.data + level * m_num_items;
+    const Scalar scale = Scalar(1.0) / Scalar(m_averaging);
+    for (unsigned int k = 0; k < m_num_items; k++)
+        {
+        h_values.data[k] = accum[k] * scale;
+        accum[k] = make_scalar3(0, 0, 0);
+        }
+    }
+
+/*! \returns The lag of each correlation value in time steps
+*/
+std::vector<unsigned int> TimeCorrelator::getLags() const
+    {
+    std::vector<unsigned int> lags;
+    unsigned int scale = m_period;
+    for (unsigned int level = 0; level < m_num_levels; level++)
+        {
+        for (unsigned int j = (level == 0 ? 0 : m_num_points / m_averaging); j < m_num_points; j++)
+            lags.push_back(j * scale);
+        scale *= m_averaging;
+        }
+    return lags;
+    }
+
+/*! \returns The correlation averaged over the items and pairs at each lag of getLags()
+*/
+std::vector<Scalar> TimeCorrelator::getCorrelation() const
+    {
+    std::vector<Scalar> correlation;
+    const double norm = m_quantity == stress ? 3.0 : double(m_num_items);
+    for (unsigned int level = 0; level < m_num_levels; level++)
+        {
+        for (unsigned int j = (level == 0 ? 0 : m_num_points / m_averaging); j < m_num_points; j++)
+            {
+            unsigned int i = level * m_num_points + j;
+            correlation.push_back(m_num_corr[i] > 0 ? Scalar(m_corr[i] / (double(m_num_corr[i]) * norm))
+                                                    : Scalar(0.0));
+            }
+        }
+    return correlation;
+    }
+
+void TimeCorrelator::reset()
+    {
+    std::fill(m_head.begin(), m_head.end(), m_num_points - 1);
+    std::fill(m_count.begin(), m_count.end(), 0);
+    std::fill(m_num_accum.begin(), m_num_accum.end(), 0);
+    std::fill(m_corr.begin(), m_corr.end(), 0.0);
+    std::fill(m_num_corr.begin(), m_num_corr.end(), 0);
+    m_num_samples = 0;
+
+    ArrayHandle<Scalar3> h_accum(m_accum, access_location::host, access_mode::overwrite);
+    std::fill(h_accum.data, h_accum.data + m_accum.getNumElements(), make_scalar3(0, 0, 0));
+    }
+
+void export_TimeCorrelator(py::module& m)
+    {
+    py::class_<TimeCorrelator, Analyzer, std::shared_ptr<TimeCorrelator> > correlator(m, "TimeCorrelator");
+    correlator
+    .def(py::init< std::shared_ptr<SystemDefinition>,
+                   std::shared_ptr<ParticleGroup>,
+                   std::shared_ptr<ComputeThermo>,
+                   TimeCorrelator::Quantity,
+                   unsigned int,
+                   unsigned int,
+                   unsigned int,
+                   unsigned int >())
+    .def_property_readonly("lags", &TimeCorrelator::getLags)
+    .def_property_readonly("correlation", &TimeCorrelator::getCorrelation)
+    .def_property_readonly("num_samples", &TimeCorrelator::getNumSamples)
+    .def_property_readonly("period", &TimeCorrelator::getPeriod)
+    .def_property_readonly("num_points", &TimeCorrelator::getNumPoints)
+    .def_property_readonly("num_levels", &TimeCorrelator::getNumLevels)
+    .def_property_readonly("averaging", &TimeCorrelator::getAveraging)
+    .def("reset", &TimeCorrelator::reset)
+    ;
+
+    py::enum_<TimeCorrelator::Quantity>(correlator, "Quantity")
+    .value("msd", TimeCorrelator::Quantity::msd)
+    .value("velocity", TimeCorrelator::Quantity::velocity)
+    .value("stress", TimeCorrelator::Quantity::stress)
+    .export_values()
+    ;
+    }
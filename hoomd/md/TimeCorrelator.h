@@ -0,0 +1,161 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ComputeThermo.h"
+#include "hoomd/Analyzer.h"
+#include "hoomd/GlobalArray.h"
+#include "hoomd/ParticleGroup.h"
+
+#include <memory>
+#include <vector>
+
+/*! \file TimeCorrelator.h
+    \brief Declares a class for accumulating time correlation functions
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __TIME_CORRELATOR_H__
+#define __TIME_CORRELATOR_H__
+
+//! Accumulates time correlation functions on the fly with the multiple-tau scheme
+/*! Each call to analyze() adds one sample of a vector valued quantity for every item: the unwrapped position or the
+    velocity of each particle in the group, or the off-diagonal components (xy, xz, yz) of the pressure tensor of the
+    group for the single item of the stress quantity.
+
+    The samples pass through \a num_levels levels of \a num_points values each. Level 0 holds the most recent samples,
+    and each \a averaging consecutive values of level l are averaged into one value of level l+1. On each new value of
+    a level, the correlation between the new value and every older value of that level is added to the lag of the
+    pair, so lag j of level l spans j * averaging^l samples. Level 0 covers the lags 0 to num_points-1 and the higher
+    levels cover the lags num_points/averaging to num_points-1. The memory grows with the logarithm of the longest
+    lag.
+
+    The correlation is |a - b|^2 (summed over the components) for the mean squared displacement, a.b for the velocity
+    autocorrelation, and a.b / 3 for the stress, which averages the three off-diagonal components. The correlations
+    are averaged over the items and the number of pairs that contribute to each lag.
+
+    Histories are indexed by the tags of the group members, so sorting the particles does not mix them up. The
+    per-particle quantities require that all members stay on the same rank, and are not available with domain
+    decomposition.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT TimeCorrelator : public Analyzer
+    {
+    public:
+        //! Correlated quantities
+        enum Quantity
+            {
+            msd = 0,    //!< Mean squared displacement of the unwrapped positions
+            velocity,   //!< Velocity autocorrelation
+            stress      //!< Autocorrelation of the off-diagonal pressure tensor components
+            };
+
+        //! Constructs the correlator
+        TimeCorrelator(std::shared_ptr<SystemDefinition> sysdef,
+                       std::shared_ptr<ParticleGroup> group,
+                       std::shared_ptr<ComputeThermo> thermo,
+                       Quantity quantity,
+                       unsigned int period,
+                       unsigned int num_points,
+                       unsigned int num_levels,
+                       unsigned int averaging);
+
+        //! Destructor
+        virtual ~TimeCorrelator();
+
+        //! Add a sample
+        virtual void analyze(unsigned int timestep);
+
+        //! The stress quantity needs the pressure tensor
+        virtual PDataFlags getRequestedPDataFlags();
+
+        //! Get the lags in time steps
+        std::vector<unsigned int> getLags() const;
+
+        //! Get the correlation at each lag, 0 for lags without pairs
+        std::vector<Scalar> getCorrelation() const;
+
+        //! Get the number of samples
+        unsigned int getNumSamples() const
+            {
+            return m_num_samples;
+            }
+
+        //! Get the number of time steps between samples
+        unsigned int getPeriod() const
+            {
+            return m_period;
+            }
+
+        //! Get the number of values per level
+        unsigned int getNumPoints() const
+            {
+            return m_num_points;
+            }
+
+        //! Get the number of levels
+        unsigned int getNumLevels() const
+            {
+            return m_num_levels;
+            }
+
+        //! Get the number of values of a level averaged into the next
+        unsigned int getAveraging() const
+            {
+            return m_averaging;
+            }
+
+        //! Discard all samples
+        void reset();
+
+    protected:
+        std::shared_ptr<ParticleGroup> m_group;  //!< Group of the correlated particles
+        std::shared_ptr<ComputeThermo> m_thermo; //!< Pressure tensor of the group for the stress quantity
+        Quantity m_quantity;                     //!< Correlated quantity
+        unsigned int m_period;                   //!< Time steps between samples
+        unsigned int m_num_points;               //!< Number of values per level
+        unsigned int m_num_levels;               //!< Number of levels
+        unsigned int m_averaging;                //!< Number of values of a level averaged into the next
+        unsigned int m_num_items;                //!< Number of correlated vectors per sample
+
+        GlobalArray<unsigned int> m_item_tags;   //!< Tag of the particle of each item
+        GlobalArray<Scalar3> m_values;           //!< Value of each item that is added to a level
+        GlobalArray<Scalar3> m_shift;            //!< Values of each level, (level * num_points + slot) * num_items
+        GlobalArray<Scalar3> m_accum;            //!< Sum of the values of each level toward the next average
+        GlobalArray<Scalar> m_lag_sums;          //!< Correlation summed over the items for each lag of a level
+
+        std::vector<unsigned int> m_head;        //!< Slot of the newest value of each level
+        std::vector<unsigned int> m_count;       //!< Number of values in each level, at most num_points
+        std::vector<unsigned int> m_num_accum;   //!< Number of values added to the accumulator of each level
+        std::vector<double> m_corr;              //!< Sum of the correlations of each level and lag
+        std::vector<unsigned long long> m_num_corr; //!< Number of pairs of each level and lag
+        unsigned int m_num_samples;              //!< Number of samples
+
+        //! Add the values in m_values to a level
+        void push(unsigned int level);
+
+        //! Write the sampled values of the items to m_values
+        virtual void loadValues();
+
+        //! Copy m_values into a slot of a level and add them to the accumulator of the level
+        virtual void storeValues(unsigned int level, unsigned int slot);
+
+        //! Sum the correlation of the newest value of a level with older ones into m_lag_sums
+        virtual void correlate(unsigned int level, unsigned int first_lag, unsigned int num_lags);
+
+        //! Write the average of the accumulator of a level to m_values and clear the accumulator
+        virtual void average(unsigned int level);
+
+        //! Write the stress item to m_values
+        void loadStress();
+    };
+
+//! Exports the TimeCorrelator class to python
+void export_TimeCorrelator(pybind11::module& m);
+
+#endif
@@ -0,0 +1,152 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file TimeCorrelatorGPU.cc
+    \brief Contains code for the TimeCorrelatorGPU class
+*/
+
+#include "TimeCorrelatorGPU.h"
+#include "TimeCorrelatorGPU.cuh"
+
+#include <algorithm>
+
+namespace py = pybind11;
+using namespace std;
+
+/*! \param sysdef System definition
+    \param group Group of the correlated particles
+    \param thermo Pressure tensor of the group, used only by the stress quantity
+    \param quantity Correlated quantity
+    \param period Time steps between samples, only used to report the lags
+    \param num_points Number of values per level
+    \param num_levels Number of levels
+    \param averaging Number of values of a level averaged into one value of the next, must divide \a num_points
+*/
+TimeCorrelatorGPU::TimeCorrelatorGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                     std::shared_ptr<ParticleGroup> group,
+                                     std::shared_ptr<ComputeThermo> thermo,
+                                     Quantity quantity,
+                                     unsigned int period,
+                                     unsigned int num_points,
+                                     unsigned int num_levels,
+                                     unsigned int averaging)
+    : TimeCorrelator(sysdef, group, thermo, quantity, period, num_points, num_levels, averaging),
+      m_scratch(m_exec_conf)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error() << "Creating a TimeCorrelatorGPU with no GPU in the execution configuration"
+                                  << endl;
+        throw std::runtime_error("Error initializing TimeCorrelatorGPU");
+        }
+
+    m_block_size = 256;
+    }
+
+TimeCorrelatorGPU::~TimeCorrelatorGPU()
+    {
+    }
+
+void TimeCorrelatorGPU::loadValues()
+    {
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<int3> d_image(m_pdata->getImages(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_item_tags(m_item_tags, access_location::device, access_mode::read);
+    ArrayHandle<Scalar3> d_values(m_values, access_location::device, access_mode::overwrite);
+
+    gpu_time_correlator_load(d_values.data,
+                             d_item_tags.data,
+                             d_rtag.data,
+                             d_pos.data,
+                             d_image.data,
+                             d_vel.data,
+                             m_pdata->getGlobalBox(),
+                             m_num_items,
+                             m_quantity == msd,
+                             m_block_size);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+/*! \param level Level to store the values in
+    \param slot Slot of the level to store the values in
+*/
+void TimeCorrelatorGPU::storeValues(unsigned int level, unsigned int slot)
+    {
+    ArrayHandle<Scalar3> d_values(m_values, access_location::device, access_mode::read);
+    ArrayHandle<Scalar3> d_shift(m_shift, access_location::device, access_mode::readwrite);
+    ArrayHandle<Scalar3> d_accum(m_accum, access_location::device, access_mode::readwrite);
+
+    gpu_time_correlator_store(d_shift.data + (level * m_num_points + slot) * m_num_items,
+                              d_accum.data + level * m_num_items,
+                              d_values.data,
+                              m_num_items,
+                              m_block_size);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+/*! \param level Level to correlate
+    \param first_lag First lag to correlate
+    \param num_lags Number of lags to correlate, writes m_lag_sums[0] to m_lag_sums[num_lags-1]
+*/
+void TimeCorrelatorGPU::correlate(unsigned int level, unsigned int first_lag, unsigned int num_lags)
+    {
+    unsigned int n_blocks = std::max(1u, std::min(m_num_items / m_block_size + 1, 32u));
+    if (m_scratch.size() < n_blocks * m_num_points)
+        m_scratch.resize(n_blocks * m_num_points);
+
+    ArrayHandle<Scalar3> d_shift(m_shift, access_location::device, access_mode::read);
+    ArrayHandle<Scalar> d_lag_sums(m_lag_sums, access_location::device, access_mode::overwrite);
+    ArrayHandle<Scalar> d_scratch(m_scratch, access_location::device, access_mode::overwrite);
+
+    gpu_time_correlator_correlate(d_lag_sums.data,
+                                  d_scratch.data,
+                                  d_shift.data + level * m_num_points * m_num_items,
+                                  m_head[level],
+                                  first_lag,
+                                  num_lags,
+                                  m_num_points,
+                                  m_num_items,
+                                  m_quantity == msd,
+                                  n_blocks,
+                                  m_block_size);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+/*! \param level Level of the accumulator to average
+*/
+void TimeCorrelatorGPU::average(unsigned int level)
+    {
+    ArrayHandle<Scalar3> d_accum(m_accum, access_location::device, access_mode::readwrite);
+    ArrayHandle<Scalar3> d_values(m_values, access_location::device, access_mode::overwrite);
+
+    gpu_time_correlator_average(d_values.data,
+                                d_accum.data + level * m_num_items,
+                                Scalar(1.0) / Scalar(m_averaging),
+                                m_num_items,
+                                m_block_size);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+void export_TimeCorrelatorGPU(py::module& m)
+    {
+    py::class_<TimeCorrelatorGPU, TimeCorrelator, std::shared_ptr<TimeCorrelatorGPU> >(m, "TimeCorrelatorGPU")
+    .def(py::init< std::shared_ptr<SystemDefinition>,
+                   std::shared_ptr<ParticleGroup>,
+                   std::shared_ptr<ComputeThermo>,
+                   TimeCorrelator::Quantity,
+                   unsigned int,
+                   unsigned int,
+                   unsigned int,
+                   unsigned int >())
+    ;
+    }
@@ -0,0 +1,289 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "TimeCorrelatorGPU.cuh"
+
+#include <assert.h>
+
+/*! \file TimeCorrelatorGPU.cu
+    \brief Defines GPU kernel code for the multiple-tau correlator. Used by TimeCorrelatorGPU.
+*/
+
+//! Kernel that writes the unwrapped positions or the velocities of the items
+/*! \param d_values Value of each item (output)
+    \param d_item_tags Tag of the particle of each item
+    \param d_rtag Index of each tag
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param d_vel Particle velocities
+    \param box Global box
+    \param num_items Number of items
+    \param positions Load the unwrapped positions when true, the velocities when false
+*/
+__global__ void gpu_time_correlator_load_kernel(Scalar3 *d_values,
+                                                const unsigned int *d_item_tags,
+                                                const unsigned int *d_rtag,
+                                                const Scalar4 *d_pos,
+                                                const int3 *d_image,
+                                                const Scalar4 *d_vel,
+                                                const BoxDim box,
+                                                const unsigned int num_items,
+                                                const bool positions)
+    {
+    const unsigned int k = blockIdx.x * blockDim.x + threadIdx.x;
+    if (k >= num_items)
+        return;
+
+    const unsigned int idx = d_rtag[d_item_tags[k]];
+    if (positions)
+        {
+        const Scalar4 pos = d_pos[idx];
+        d_values[k] = box.shift(make_scalar3(pos.x, pos.y, pos.z), d_image[idx]);
+        }
+    else
+        {
+        const Scalar4 vel = d_vel[idx];
+        d_values[k] = make_scalar3(vel.x, vel.y, vel.z);
+        }
+    }
+
+//! Kernel that stores the values in a slot and adds them to the accumulator
+/*! \param d_shift Slot of the level (output)
+    \param d_accum Accumulator of the level
+    \param d_values Value of each item
+    \param num_items Number of items
+*/
+__global__ void gpu_time_correlator_store_kernel(Scalar3 *d_shift,
+                                                 Scalar3 *d_accum,
+                                                 const Scalar3 *d_values,
+                                                 const unsigned int num_items)
+    {
+    const unsigned int k = blockIdx.x * blockDim.x + threadIdx.x;
+    if (k >= num_items)
+        return;
+
+    const Scalar3 value = d_values[k];
+    d_shift[k] = value;
+    d_accum[k] += value;
+    }
+
+//! Kernel that sums the correlation of the items for each lag in blocks
+/*! \param d_scratch Partial sums, n_blocks for each lag (output)
+    \param d_shift Values of the level
+    \param head Slot of the newest value
+    \param first_lag First lag to correlate
+    \param num_points Number of slots of the level
+    \param num_items Number of items
+    \param displacement Correlate |a-b|^2 when true, a.b when false
+
+    blockIdx.y selects the lag, the blocks in x loop over the items with a stride of the grid width. The block size
+    must be a power of two.
+*/
+__global__ void gpu_time_correlator_partial_kernel(Scalar *d_scratch,
+                                                   const Scalar3 *d_shift,
+                                                   const unsigned int head,
+                                                   const unsigned int first_lag,
+                                                   const unsigned int num_points,
+                                                   const unsigned int num_items,
+                                                   const bool displacement)
+    {
+    HIP_DYNAMIC_SHARED(Scalar, s_sums)
+
+    const unsigned int slot = (head + num_points - first_lag - blockIdx.y) % num_points;
+    const Scalar3 *newest = d_shift + head * num_items;
+    const Scalar3 *older = d_shift + slot * num_items;
+
+    Scalar sum = Scalar(0.0);
+    for (unsigned int k = blockIdx.x * blockDim.x + threadIdx.x; k < num_items; k += blockDim.x * gridDim.x)
+        {
+        const Scalar3 a = newest[k];
+        const Scalar3 b = older[k];
+        if (displacement)
+            {
+            const Scalar3 d = a - b;
+            sum += dot(d, d);
+            }
+        else
+            {
+            sum += dot(a, b);
+            }
+        }
+
+    s_sums[threadIdx.x] = sum;
+    __syncthreads();
+
+    for (unsigned int offs = blockDim.x / 2; offs > 0; offs >>= 1)
+        {
+        if (threadIdx.x < offs)
+            s_sums[threadIdx.x] += s_sums[threadIdx.x + offs];
+        __syncthreads();
+        }
+
+    if (threadIdx.x == 0)
+        d_scratch[blockIdx.y * gridDim.x + blockIdx.x] = s_sums[0];
+    }
+
+//! Kernel that reduces the partial sums of each lag
+/*! \param d_lag_sums Sum for each lag (output)
+    \param d_scratch Partial sums, n_blocks for each lag
+    \param n_blocks Number of partial sums for each lag
+
+    One block reduces each lag. The block size must be a power of two.
+*/
+__global__ void gpu_time_correlator_final_kernel(Scalar *d_lag_sums,
+                                                 const Scalar *d_scratch,
+                                                 const unsigned int n_blocks)
+    {
+    HIP_DYNAMIC_SHARED(Scalar, s_sums)
+
+    Scalar sum = Scalar(0.0);
+    for (unsigned int b = threadIdx.x; b < n_blocks; b += blockDim.x)
+        sum += d_scratch[blockIdx.x * n_blocks + b];
+
+    s_sums[threadIdx.x] = sum;
+    __syncthreads();
+
+    for (unsigned int offs = blockDim.x / 2; offs > 0; offs >>= 1)
+        {
+        if (threadIdx.x < offs)
+            s_sums[threadIdx.x] += s_sums[threadIdx.x + offs];
+        __syncthreads();
+        }
+
+    if (threadIdx.x == 0)
+        d_lag_sums[blockIdx.x] = s_sums[0];
+    }
+
+//! Kernel that writes the average of the accumulator to the values and clears it
+/*! \param d_values Value of each item (output)
+    \param d_accum Accumulator of the level
+    \param scale Inverse of the number of accumulated values
+    \param num_items Number of items
+*/
+__global__ void gpu_time_correlator_average_kernel(Scalar3 *d_values,
+                                                   Scalar3 *d_accum,
+                                                   const Scalar scale,
+                                                   const unsigned int num_items)
+    {
+    const unsigned int k = blockIdx.x * blockDim.x + threadIdx.x;
+    if (k >= num_items)
+        return;
+
+    d_values[k] = d_accum[k] * scale;
+    d_accum[k] = make_scalar3(0, 0, 0);
+    }
+
+/*! \param d_values Value of each item (output)
+    \param d_item_tags Tag of the particle of each item
+    \param d_rtag Index of each tag
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param d_vel Particle velocities
+    \param box Global box
+    \param num_items Number of items
+    \param positions Load the unwrapped positions when true, the velocities when false
+    \param block_size Number of threads per block
+*/
+hipError_t gpu_time_correlator_load(Scalar3 *d_values,
+                                    const unsigned int *d_item_tags,
+                                    const unsigned int *d_rtag,
+                                    const Scalar4 *d_pos,
+                                    const int3 *d_image,
+                                    const Scalar4 *d_vel,
+                                    const BoxDim& box,
+                                    const unsigned int num_items,
+                                    const bool positions,
+                                    const unsigned int block_size)
+    {
+    assert(d_values);
+
+    dim3 grid(num_items / block_size + 1, 1, 1);
+    dim3 threads(block_size, 1, 1);
+    hipLaunchKernelGGL((gpu_time_correlator_load_kernel), dim3(grid), dim3(threads), 0, 0,
+                       d_values, d_item_tags, d_rtag, d_pos, d_image, d_vel, box, num_items, positions);
+
+    return hipSuccess;
+    }
+
+/*! \param d_shift Slot of the level (output)
+    \param d_accum Accumulator of the level
+    \param d_values Value of each item
+    \param num_items Number of items
+    \param block_size Number of threads per block
+*/
+hipError_t gpu_time_correlator_store(Scalar3 *d_shift,
+                                     Scalar3 *d_accum,
+                                     const Scalar3 *d_values,
+                                     const unsigned int num_items,
+                                     const unsigned int block_size)
+    {
+    dim3 grid(num_items / block_size + 1, 1, 1);
+    dim3 threads(block_size, 1, 1);
+    hipLaunchKernelGGL((gpu_time_correlator_store_kernel), dim3(grid), dim3(threads), 0, 0,
+                       d_shift, d_accum, d_values, num_items);
+
+    return hipSuccess;
+    }
+
+/*! \param d_lag_sums Sum for each lag (output)
+    \param d_scratch Scratch space of n_blocks * num_lags elements for the partial sums
+    \param d_shift Values of the level
+    \param head Slot of the newest value
+    \param first_lag First lag to correlate
+    \param num_lags Number of lags to correlate
+    \param num_points Number of slots of the level
+    \param num_items Number of items
+    \param displacement Correlate |a-b|^2 when true, a.b when false
+    \param n_blocks Number of blocks that sum the items for each lag
+    \param block_size Number of threads per block, a power of two
+*/
+hipError_t gpu_time_correlator_correlate(Scalar *d_lag_sums,
+                                         Scalar *d_scratch,
+                                         const Scalar3 *d_shift,
+                                         const unsigned int head,
+                                         const unsigned int first_lag,
+                                         const unsigned int num_lags,
+                                         const unsigned int num_points,
+                                         const unsigned int num_items,
+                                         const bool displacement,
+                                         const unsigned int n_blocks,
+                                         const unsigned int block_size)
+    {
+    assert(d_lag_sums);
+    assert(d_scratch);
+
+    if (num_lags == 0)
+        return hipSuccess;
+
+    dim3 grid(n_blocks, num_lags, 1);
+    dim3 threads(block_size, 1, 1);
+    hipLaunchKernelGGL((gpu_time_correlator_partial_kernel), dim3(grid), dim3(threads),
+                       sizeof(Scalar) * block_size, 0,
+                       d_scratch, d_shift, head, first_lag, num_points, num_items, displacement);
+
+    hipLaunchKernelGGL((gpu_time_correlator_final_kernel), dim3(num_lags), dim3(threads),
+                       sizeof(Scalar) * block_size, 0,
+                       d_lag_sums, d_scratch, n_blocks);
+
+    return hipSuccess;
+    }
+
+/*! \param d_values Value of each item (output)
+    \param d_accum Accumulator of the level
+    \param scale Inverse of the number of accumulated values
+    \param num_items Number of items
+    \param block_size Number of threads per block
+*/
+hipError_t gpu_time_correlator_average(Scalar3 *d_values,
+                                       Scalar3 *d_accum,
+                                       const Scalar scale,
+                                       const unsigned int num_items,
+                                       const unsigned int block_size)
+    {
+    dim3 grid(num_items / block_size + 1, 1, 1);
+    dim3 threads(block_size, 1, 1);
+    hipLaunchKernelGGL((gpu_time_correlator_average_kernel), dim3(grid), dim3(threads), 0, 0,
+                       d_values, d_accum, scale, num_items);
+
+    return hipSuccess;
+    }
@@ -0,0 +1,55 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _TIME_CORRELATOR_GPU_CUH_
+#define _TIME_CORRELATOR_GPU_CUH_
+
+#include <hip/hip_runtime.h>
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/BoxDim.h"
+
+/*! \file TimeCorrelatorGPU.cuh
+    \brief Kernel driver function declarations for TimeCorrelatorGPU
+*/
+
+//! Kernel driver that writes the unwrapped positions or the velocities of the items
+hipError_t gpu_time_correlator_load(Scalar3 *d_values,
+                                    const unsigned int *d_item_tags,
+                                    const unsigned int *d_rtag,
+                                    const Scalar4 *d_pos,
+                                    const int3 *d_image,
+                                    const Scalar4 *d_vel,
+                                    const BoxDim& box,
+                                    const unsigned int num_items,
+                                    const bool positions,
+                                    const unsigned int block_size);
+
+//! Kernel driver that stores the values in a slot and adds them to the accumulator
+hipError_t gpu_time_correlator_store(Scalar3 *d_shift,
+                                     Scalar3 *d_accum,
+                                     const Scalar3 *d_values,
+                                     const unsigned int num_items,
+                                     const unsigned int block_size);
+
+//! Kernel driver that sums the correlation of the newest value of a level with older values
+hipError_t gpu_time_correlator_correlate(Scalar *d_lag_sums,
+                                         Scalar *d_scratch,
+                                         const Scalar3 *d_shift,
+                                         const unsigned int head,
+                                         const unsigned int first_lag,
+                                         const unsigned int num_lags,
+                                         const unsigned int num_points,
+                                         const unsigned int num_items,
+                                         const bool displacement,
+                                         const unsigned int n_blocks,
+                                         const unsigned int block_size);
+
+//! Kernel driver that writes the average of the accumulator to the values and clears it
+hipError_t gpu_time_correlator_average(Scalar3 *d_values,
+                                       Scalar3 *d_accum,
+                                       const Scalar scale,
+                                       const unsigned int num_items,
+                                       const unsigned int block_size);
+
+#endif
@@ -0,0 +1,62 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "TimeCorrelator.h"
+
+/*! \file TimeCorrelatorGPU.h
+    \brief Declares a class for accumulating time correlation functions on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __TIME_CORRELATOR_GPU_H__
+#define __TIME_CORRELATOR_GPU_H__
+
+//! Accumulates time correlation functions on the fly with the multiple-tau scheme on the GPU
+/*! TimeCorrelatorGPU is a GPU accelerated implementation of TimeCorrelator. The values, levels, and accumulators of
+    the items stay on the device. Each new value of a level is correlated with the older values in a block reduction
+    over the items, and only the sums for each lag are copied to the host.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT TimeCorrelatorGPU : public TimeCorrelator
+    {
+    public:
+        //! Constructs the correlator
+        TimeCorrelatorGPU(std::shared_ptr<SystemDefinition> sysdef,
+                          std::shared_ptr<ParticleGroup> group,
+                          std::shared_ptr<ComputeThermo> thermo,
+                          Quantity quantity,
+                          unsigned int period,
+                          unsigned int num_points,
+                          unsigned int num_levels,
+                          unsigned int averaging);
+
+        //! Destructor
+        virtual ~TimeCorrelatorGPU();
+
+    protected:
+        GlobalVector<Scalar> m_scratch;  //!< Partial sums of each block for each lag
+        unsigned int m_block_size;       //!< Block size executed
+
+        //! Write the sampled values of the items to m_values on the GPU
+        virtual void loadValues();
+
+        //! Copy m_values into a slot of a level and add them to the accumulator of the level on the GPU
+        virtual void storeValues(unsigned int level, unsigned int slot);
+
+        //! Sum the correlation of the newest value of a level with older ones into m_lag_sums on the GPU
+        virtual void correlate(unsigned int level, unsigned int first_lag, unsigned int num_lags);
+
+        //! Write the average of the accumulator of a level to m_values and clear the accumulator on the GPU
+        virtual void average(unsigned int level);
+    };
+
+//! Exports the TimeCorrelatorGPU class to python
+void export_TimeCorrelatorGPU(pybind11::module& m);
+
+#endif
@@ -8,6 +8,8 @@
 
 #include "hoomd/RandomNumbers.h"
 #include "hoomd/RNGIdentifiers.h"
+
+#include <algorithm>
 using namespace hoomd;
 
 #ifdef ENABLE_MPI
@@ -45,6 +47,19 @@ TwoStepBD::~TwoStepBD()
     Atomic, Polymeric and Colloidal Systems", chapter 6.
 */
 void TwoStepBD::integrateStepOne(unsigned int timestep)
+    {
+    // in 2D, the z components of the particles are never touched
+    if (m_sysdef->getNDimensions() == 2)
+        integrateStepOneDim<2>(timestep);
+    else
+        integrateStepOneDim<3>(timestep);
+    }
+
+/*! \tparam D Dimensionality of the system
+    \param timestep Current time step
+*/
+template<unsigned int D>
+void TwoStepBD::integrateStepOneDim(unsigned int timestep)
     {
     unsigned int group_size = m_group->getNumMembers();
 
@@ -54,7 +69,6 @@ void TwoStepBD::integrateStepOne(unsigned int timestep)
 
     // grab some initial variables
     const Scalar currentTemp = (*m_T)(timestep);
-    const unsigned int D = m_sysdef->getNDimensions();
 
     const GlobalArray< Scalar4 >& net_force = m_pdata->getNetForce();
     ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
@@ -75,127 +89,158 @@ void TwoStepBD::integrateStepOne(unsigned int timestep)
 
     const BoxDim& box = m_pdata->getBox();
 
+    // draw the random numbers of a block of particles at once
+    const unsigned int block_width = RandomGeneratorBatch<>::width;
+    unsigned int member_idx[block_width];
+    uint32_t ptag[block_width];
+    Scalar rx[block_width], ry[block_width], rz[block_width];
+    Scalar normal_vx[block_width], normal_vy[block_width], normal_vz[block_width];
+    Scalar normal_tx[block_width], normal_ty[block_width], normal_tz[block_width];
+    Scalar normal_px[block_width], normal_py[block_width], normal_pz[block_width];
+
     // perform the first half step
     // r(t+deltaT) = r(t) + (Fc(t) + Fr)*deltaT/gamma
     // v(t+deltaT) = random distribution consistent with T
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    for (unsigned int block_start = 0; block_start < group_size; block_start += block_width)
         {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-        unsigned int ptag = h_tag.data[j];
+        unsigned int n_block = std::min(block_width, group_size - block_start);
+        for (unsigned int l = 0; l < block_width; l++)
+            {
+            member_idx[l] = l < n_block ? m_group->getMemberIndex(block_start + l) : 0;
+            ptag[l] = l < n_block ? h_tag.data[member_idx[l]] : 0;
+            }
 
-        // Initialize the RNG
-        RandomGenerator rng(RNGIdentifier::TwoStepBD, m_seed, ptag, timestep);
+        // Initialize the RNG streams of the particles in the block
+        RandomGeneratorBatch<> rng(RNGIdentifier::TwoStepBD, m_seed, ptag, timestep);
 
         // compute the random force
-        UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
-        Scalar rx = uniform(rng);
-        Scalar ry = uniform(rng);
-        Scalar rz = uniform(rng);
-
-        Scalar gamma;
-        if (m_use_alpha)
-            gamma = m_alpha*h_diameter.data[j];
-        else
-            {
-            unsigned int type = __scalar_as_int(h_pos.data[j].w);
-            gamma = h_gamma.data[type];
-            }
+        rng.uniform(Scalar(-1), Scalar(1), rx);
+        rng.uniform(Scalar(-1), Scalar(1), ry);
+        rng.uniform(Scalar(-1), Scalar(1), rz);
 
-        // compute the bd force (the extra factor of 3 is because <rx^2> is 1/3 in the uniform -1,1 distribution
-        // it is not the dimensionality of the system
-        Scalar coeff = fast::sqrt(Scalar(3.0)*Scalar(2.0)*gamma*currentTemp/m_deltaT);
-        if (m_noiseless_t)
-            coeff = Scalar(0.0);
-        Scalar Fr_x = rx*coeff;
-        Scalar Fr_y = ry*coeff;
-        Scalar Fr_z = rz*coeff;
-
-        if (D < 3)
-            Fr_z = Scalar(0.0);
-
-        // update position
-        h_pos.data[j].x += (h_net_force.data[j].x + Fr_x) * m_deltaT / gamma;
-        h_pos.data[j].y += (h_net_force.data[j].y + Fr_y) * m_deltaT / gamma;
-        h_pos.data[j].z += (h_net_force.data[j].z + Fr_z) * m_deltaT / gamma;
-
-        // particles may have been moved slightly outside the box by the above steps, wrap them back into place
-        box.wrap(h_pos.data[j], h_image.data[j]);
-
-        // draw a new random velocity for particle j
-        Scalar mass =  h_vel.data[j].w;
-        Scalar sigma = fast::sqrt(currentTemp/mass);
-        NormalDistribution<Scalar> normal(sigma);
-        h_vel.data[j].x = normal(rng);
-        h_vel.data[j].y = normal(rng);
+        // the random velocities, torques, and angular momenta follow in the same streams
+        rng.normal(normal_vx);
+        rng.normal(normal_vy);
         if (D > 2)
-            h_vel.data[j].z = normal(rng);
-        else
-            h_vel.data[j].z = 0;
-
-        // rotational random force and orientation quaternion updates
+            rng.normal(normal_vz);
         if (m_aniso)
             {
-            unsigned int type_r = __scalar_as_int(h_pos.data[j].w);
-            Scalar3 gamma_r = h_gamma_r.data[type_r];
-            if (gamma_r.x > 0 || gamma_r.y > 0 || gamma_r.z > 0)
+            rng.normal(normal_tx);
+            rng.normal(normal_ty);
+            rng.normal(normal_tz);
+            rng.normal(normal_px);
+            rng.normal(normal_py);
+            rng.normal(normal_pz);
+            }
+
+        for (unsigned int l = 0; l < n_block; l++)
+            {
+            unsigned int j = member_idx[l];
+
+            Scalar gamma;
+            if (m_use_alpha)
+                gamma = m_alpha*h_diameter.data[j];
+            else
                 {
-                vec3<Scalar> p_vec;
-                quat<Scalar> q(h_orientation.data[j]);
-                vec3<Scalar> t(h_torque.data[j]);
-                vec3<Scalar> I(h_inertia.data[j]);
-
-                bool x_zero, y_zero, z_zero;
-                x_zero = (I.x < EPSILON); y_zero = (I.y < EPSILON); z_zero = (I.z < EPSILON);
-
-                Scalar3 sigma_r = make_scalar3(fast::sqrt(Scalar(2.0)*gamma_r.x*currentTemp/m_deltaT),
-                                               fast::sqrt(Scalar(2.0)*gamma_r.y*currentTemp/m_deltaT),
-                                               fast::sqrt(Scalar(2.0)*gamma_r.z*currentTemp/m_deltaT));
-                if (m_noiseless_r)
-                    sigma_r = make_scalar3(0,0,0);
-
-                // original Gaussian random torque
-                // Gaussian random distribution is preferred in terms of preserving the exact math
-                vec3<Scalar> bf_torque;
-                bf_torque.x = NormalDistribution<Scalar>(sigma_r.x)(rng);
-                bf_torque.y = NormalDistribution<Scalar>(sigma_r.y)(rng);
-                bf_torque.z = NormalDistribution<Scalar>(sigma_r.z)(rng);
-
-                if (x_zero) bf_torque.x = 0;
-                if (y_zero) bf_torque.y = 0;
-                if (z_zero) bf_torque.z = 0;
-
-                // use the damping by gamma_r and rotate back to lab frame
-                // Notes For the Future: take special care when have anisotropic gamma_r
-                // if aniso gamma_r, first rotate the torque into particle frame and divide the different gamma_r
-                // and then rotate the "angular velocity" back to lab frame and integrate
-                bf_torque = rotate(q, bf_torque);
-                if (D < 3)
+                unsigned int type = __scalar_as_int(h_pos.data[j].w);
+                gamma = h_gamma.data[type];
+                }
+
+            // compute the bd force (the extra factor of 3 is because <rx^2> is 1/3 in the uniform -1,1 distribution
+            // it is not the dimensionality of the system
+            Scalar coeff = fast::sqrt(Scalar(3.0)*Scalar(2.0)*gamma*currentTemp/m_deltaT);
+            if (m_noiseless_t)
+                coeff = Scalar(0.0);
+            Scalar Fr_x = rx[l]*coeff;
+            Scalar Fr_y = ry[l]*coeff;
+
+            // update position
+            h_pos.data[j].x += (h_net_force.data[j].x + Fr_x) * m_deltaT / gamma;
+            h_pos.data[j].y += (h_net_force.data[j].y + Fr_y) * m_deltaT / gamma;
+            if (D == 3)
+                {
+                Scalar Fr_z = rz[l]*coeff;
+                h_pos.data[j].z += (h_net_force.data[j].z + Fr_z) * m_deltaT / gamma;
+                }
+
+            // particles may have been moved slightly outside the box by the above steps, wrap them back into place
+            box.wrap(h_pos.data[j], h_image.data[j]);
+
+            // draw a new random velocity for particle j
+            Scalar mass =  h_vel.data[j].w;
+            Scalar sigma = fast::sqrt(currentTemp/mass);
+            h_vel.data[j].x = normal_vx[l]*sigma;
+            h_vel.data[j].y = normal_vy[l]*sigma;
+            if (D > 2)
+                h_vel.data[j].z = normal_vz[l]*sigma;
+            else
+                h_vel.data[j].z = 0;
+
+            // rotational random force and orientation quaternion updates
+            if (m_aniso)
+                {
+                unsigned int type_r = __scalar_as_int(h_pos.data[j].w);
+                Scalar3 gamma_r = h_gamma_r.data[type_r];
+                if (gamma_r.x > 0 || gamma_r.y > 0 || gamma_r.z > 0)
                     {
-                    bf_torque.x = 0;
-                    bf_torque.y = 0;
-                    t.x = 0;
-                    t.y = 0;
+                    vec3<Scalar> p_vec;
+                    quat<Scalar> q(h_orientation.data[j]);
+                    vec3<Scalar> t(h_torque.data[j]);
+                    vec3<Scalar> I(h_inertia.data[j]);
+
+                    bool x_zero, y_zero, z_zero;
+                    x_zero = (I.x < EPSILON); y_zero = (I.y < EPSILON); z_zero = (I.z < EPSILON);
+
+                    Scalar3 sigma_r = make_scalar3(fast::sqrt(Scalar(2.0)*gamma_r.x*currentTemp/m_deltaT),
+                                                   fast::sqrt(Scalar(2.0)*gamma_r.y*currentTemp/m_deltaT),
+                                                   fast::sqrt(Scalar(2.0)*gamma_r.z*currentTemp/m_deltaT));
+                    if (m_noiseless_r)
+                        sigma_r = make_scalar3(0,0,0);
+
+                    // original Gaussian random torque
+                    // Gaussian random distribution is preferred in terms of preserving the exact math
+                    vec3<Scalar> bf_torque;
+                    bf_torque.x = normal_tx[l]*sigma_r.x;
+                    bf_torque.y = normal_ty[l]*sigma_r.y;
+                    bf_torque.z = normal_tz[l]*sigma_r.z;
+
+                    if (x_zero) bf_torque.x = 0;
+                    if (y_zero) bf_torque.y = 0;
+                    if (z_zero) bf_torque.z = 0;
+
+                    // use the damping by gamma_r and rotate back to lab frame
+                    // Notes For the Future: take special care when have anisotropic gamma_r
+                    // if aniso gamma_r, first rotate the torque into particle frame and divide the different gamma_r
+                    // and then rotate the "angular velocity" back to lab frame and integrate
+                    bf_torque = rotate(q, bf_torque);
+                    if (D < 3)
+                        {
+                        bf_torque.x = 0;
+                        bf_torque.y = 0;
+                        t.x = 0;
+                        t.y = 0;
+                        }
+
+                    // do the integration for quaternion
+                    q += Scalar(0.5) * m_deltaT * ((t + bf_torque) / vec3<Scalar>(gamma_r)) * q ;
+                    q = q * (Scalar(1.0) / slow::sqrt(norm2(q)));
+                    h_orientation.data[j] = quat_to_scalar4(q);
+
+                    // draw a new random ang_mom for particle j in body frame
+                    p_vec.x = normal_px[l]*fast::sqrt(currentTemp * I.x);
+                    p_vec.y = normal_py[l]*fast::sqrt(currentTemp * I.y);
+                    p_vec.z = normal_pz[l]*fast::sqrt(currentTemp * I.z);
+                    if (x_zero) p_vec.x = 0;
+                    if (y_zero) p_vec.y = 0;
+                    if (z_zero) p_vec.z = 0;
+
+                    // !! Note this isn't well-behaving in 2D,
+                    // !! because may have effective non-zero ang_mom in x,y
+
+                    // store ang_mom quaternion
+                    quat<Scalar> p = Scalar(2.0) * q * p_vec;
+                    h_angmom.data[j] = quat_to_scalar4(p);
                     }
-
-                // do the integration for quaternion
-                q += Scalar(0.5) * m_deltaT * ((t + bf_torque) / vec3<Scalar>(gamma_r)) * q ;
-                q = q * (Scalar(1.0) / slow::sqrt(norm2(q)));
-                h_orientation.data[j] = quat_to_scalar4(q);
-
-                // draw a new random ang_mom for particle j in body frame
-                p_vec.x = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.x))(rng);
-                p_vec.y = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.y))(rng);
-                p_vec.z = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.z))(rng);
-                if (x_zero) p_vec.x = 0;
-                if (y_zero) p_vec.y = 0;
-                if (z_zero) p_vec.z = 0;
-
-                // !! Note this isn't well-behaving in 2D,
-                // !! because may have effective non-zero ang_mom in x,y
-
-                // store ang_mom quaternion
-                quat<Scalar> p = Scalar(2.0) * q * p_vec;
-                h_angmom.data[j] = quat_to_scalar4(p);
                 }
             }
         }
@@ -36,6 +36,11 @@ class PYBIND11_EXPORT TwoStepBD : public TwoStepLangevinBase
     protected:
         bool m_noiseless_t;
         bool m_noiseless_r;
+
+    private:
+        /// Performs the first step of the integration in D dimensions
+        template<unsigned int D>
+        void integrateStepOneDim(unsigned int timestep);
     };
 
 //! Exports the TwoStepLangevin class to python
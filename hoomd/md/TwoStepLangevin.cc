@@ -6,6 +6,8 @@
 #include "hoomd/RNGIdentifiers.h"
 #include "hoomd/VectorMath.h"
 
+#include <algorithm>
+
 #ifdef ENABLE_MPI
 #include "hoomd/HOOMDMPI.h"
 #endif
@@ -62,6 +64,19 @@ Scalar TwoStepLangevin::getLogValue(const std::string& quantity, unsigned int ti
           method.
 */
 void TwoStepLangevin::integrateStepOne(unsigned int timestep)
+    {
+    // in 2D, the z components of the particles are never touched
+    if (m_sysdef->getNDimensions() == 2)
+        integrateStepOneDim<2>(timestep);
+    else
+        integrateStepOneDim<3>(timestep);
+    }
+
+/*! \tparam D Dimensionality of the system
+    \param timestep Current time step
+*/
+template<unsigned int D>
+void TwoStepLangevin::integrateStepOneDim(unsigned int timestep)
     {
     unsigned int group_size = m_group->getNumMembers();
 
@@ -85,19 +100,47 @@ void TwoStepLangevin::integrateStepOne(unsigned int timestep)
         {
         unsigned int j = m_group->getMemberIndex(group_idx);
 
+        const Scalar3 old_pos = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+        if (m_projection.kind != ConstraintProjection::none)
+            {
+            // the accelerations may have been computed without the constraint before the first step
+            h_accel.data[j] = m_projection.projectVector(old_pos, h_accel.data[j]);
+            }
+
         Scalar dx = h_vel.data[j].x*m_deltaT + Scalar(1.0/2.0)*h_accel.data[j].x*m_deltaT*m_deltaT;
         Scalar dy = h_vel.data[j].y*m_deltaT + Scalar(1.0/2.0)*h_accel.data[j].y*m_deltaT*m_deltaT;
-        Scalar dz = h_vel.data[j].z*m_deltaT + Scalar(1.0/2.0)*h_accel.data[j].z*m_deltaT*m_deltaT;
 
         h_pos.data[j].x += dx;
         h_pos.data[j].y += dy;
-        h_pos.data[j].z += dz;
-        // particles may have been moved slightly outside the box by the above steps, wrap them back into place
-        box.wrap(h_pos.data[j], h_image.data[j]);
 
         h_vel.data[j].x += Scalar(1.0/2.0)*h_accel.data[j].x*m_deltaT;
         h_vel.data[j].y += Scalar(1.0/2.0)*h_accel.data[j].y*m_deltaT;
-        h_vel.data[j].z += Scalar(1.0/2.0)*h_accel.data[j].z*m_deltaT;
+
+        if (D == 3)
+            {
+            Scalar dz = h_vel.data[j].z*m_deltaT + Scalar(1.0/2.0)*h_accel.data[j].z*m_deltaT*m_deltaT;
+            h_pos.data[j].z += dz;
+            h_vel.data[j].z += Scalar(1.0/2.0)*h_accel.data[j].z*m_deltaT;
+            }
+
+        // move the particle back onto the constraint and remove the velocity normal to it
+        if (m_projection.kind != ConstraintProjection::none)
+            {
+            Scalar3 pos = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            pos = m_projection.projectPosition(old_pos, pos);
+            h_pos.data[j].x = pos.x;
+            h_pos.data[j].y = pos.y;
+            h_pos.data[j].z = pos.z;
+
+            Scalar3 vel = make_scalar3(h_vel.data[j].x, h_vel.data[j].y, h_vel.data[j].z);
+            vel = m_projection.projectVector(pos, vel);
+            h_vel.data[j].x = vel.x;
+            h_vel.data[j].y = vel.y;
+            h_vel.data[j].z = vel.z;
+            }
+
+        // particles may have been moved slightly outside the box by the above steps, wrap them back into place
+        box.wrap(h_pos.data[j], h_image.data[j]);
         }
 
     if (m_aniso)
@@ -215,6 +258,19 @@ void TwoStepLangevin::integrateStepOne(unsigned int timestep)
     \post particle velocities are moved forward to timestep+1
 */
 void TwoStepLangevin::integrateStepTwo(unsigned int timestep)
+    {
+    // in 2D, the z components of the particles are never touched
+    if (m_sysdef->getNDimensions() == 2)
+        integrateStepTwoDim<2>(timestep);
+    else
+        integrateStepTwoDim<3>(timestep);
+    }
+
+/*! \tparam D Dimensionality of the system
+    \param timestep Current time step
+*/
+template<unsigned int D>
+void TwoStepLangevin::integrateStepTwoDim(unsigned int timestep)
     {
     unsigned int group_size = m_group->getNumMembers();
 
@@ -240,113 +296,161 @@ void TwoStepLangevin::integrateStepTwo(unsigned int timestep)
 
     // grab some initial variables
     const Scalar currentTemp = (*m_T)(timestep);
-    const unsigned int D = m_sysdef->getNDimensions();
 
     // energy transferred over this time step
     Scalar bd_energy_transfer = 0;
 
     // a(t+deltaT) gets modified with the bd forces
     // v(t+deltaT) = v(t+deltaT/2) + 1/2 * a(t+deltaT)*deltaT
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    // draw the random numbers of a block of particles at once
+    const unsigned int block_width = RandomGeneratorBatch<>::width;
+    unsigned int member_idx[block_width];
+    uint32_t ptag[block_width];
+    Scalar rx[block_width], ry[block_width], rz[block_width];
+    Scalar normal_x[block_width], normal_y[block_width], normal_z[block_width];
+
+    // a(t+deltaT) gets modified with the bd forces
+    // v(t+deltaT) = v(t+deltaT/2) + 1/2 * a(t+deltaT)*deltaT
+    for (unsigned int block_start = 0; block_start < group_size; block_start += block_width)
         {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-        unsigned int ptag = h_tag.data[j];
+        unsigned int n_block = std::min(block_width, group_size - block_start);
+        for (unsigned int l = 0; l < block_width; l++)
+            {
+            member_idx[l] = l < n_block ? m_group->getMemberIndex(block_start + l) : 0;
+            ptag[l] = l < n_block ? h_tag.data[member_idx[l]] : 0;
+            }
 
-        // Initialize the RNG
-        RandomGenerator rng(RNGIdentifier::TwoStepLangevin, m_seed, ptag, timestep);
+        // Initialize the RNG streams of the particles in the block
+        RandomGeneratorBatch<> rng(RNGIdentifier::TwoStepLangevin, m_seed, ptag, timestep);
 
         // first, calculate the BD forces
         // Generate three random numbers
-        hoomd::UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
-        Scalar rx = uniform(rng);
-        Scalar ry = uniform(rng);
-        Scalar rz = uniform(rng);
-
-        Scalar gamma;
-        if (m_use_alpha)
-            gamma = m_alpha*h_diameter.data[j];
-        else
+        rng.uniform(Scalar(-1), Scalar(1), rx);
+        rng.uniform(Scalar(-1), Scalar(1), ry);
+        rng.uniform(Scalar(-1), Scalar(1), rz);
+
+        // the random torques follow in the same streams
+        if (m_aniso)
             {
-            unsigned int type = __scalar_as_int(h_pos.data[j].w);
-            gamma = h_gamma.data[type];
+            rng.normal(normal_x);
+            rng.normal(normal_y);
+            rng.normal(normal_z);
             }
 
-        // compute the bd force
-        Scalar coeff = fast::sqrt(Scalar(6.0) *gamma*currentTemp/m_deltaT);
-        if (m_noiseless_t)
-            coeff = Scalar(0.0);
-        Scalar bd_fx = rx*coeff - gamma*h_vel.data[j].x;
-        Scalar bd_fy = ry*coeff - gamma*h_vel.data[j].y;
-        Scalar bd_fz = rz*coeff - gamma*h_vel.data[j].z;
-
-        if (D < 3)
-            bd_fz = Scalar(0.0);
+        for (unsigned int l = 0; l < n_block; l++)
+            {
+            unsigned int j = member_idx[l];
 
-        // then, calculate acceleration from the net force
-        Scalar minv = Scalar(1.0) / h_vel.data[j].w;
-        h_accel.data[j].x = (h_net_force.data[j].x + bd_fx)*minv;
-        h_accel.data[j].y = (h_net_force.data[j].y + bd_fy)*minv;
-        h_accel.data[j].z = (h_net_force.data[j].z + bd_fz)*minv;
+            Scalar gamma;
+            if (m_use_alpha)
+                gamma = m_alpha*h_diameter.data[j];
+            else
+                {
+                unsigned int type = __scalar_as_int(h_pos.data[j].w);
+                gamma = h_gamma.data[type];
+                }
 
-        // then, update the velocity
-        h_vel.data[j].x += Scalar(1.0/2.0)*h_accel.data[j].x*m_deltaT;
-        h_vel.data[j].y += Scalar(1.0/2.0)*h_accel.data[j].y*m_deltaT;
-        h_vel.data[j].z += Scalar(1.0/2.0)*h_accel.data[j].z*m_deltaT;
+            // compute the bd force
+            Scalar coeff = fast::sqrt(Scalar(6.0) *gamma*currentTemp/m_deltaT);
+            if (m_noiseless_t)
+                coeff = Scalar(0.0);
+            Scalar bd_fx = rx[l]*coeff - gamma*h_vel.data[j].x;
+            Scalar bd_fy = ry[l]*coeff - gamma*h_vel.data[j].y;
+            Scalar bd_fz = Scalar(0.0);
+            if (D == 3)
+                bd_fz = rz[l]*coeff - gamma*h_vel.data[j].z;
+
+            // then, calculate acceleration from the net force
+            Scalar minv = Scalar(1.0) / h_vel.data[j].w;
+            h_accel.data[j].x = (h_net_force.data[j].x + bd_fx)*minv;
+            h_accel.data[j].y = (h_net_force.data[j].y + bd_fy)*minv;
+            if (D == 3)
+                h_accel.data[j].z = (h_net_force.data[j].z + bd_fz)*minv;
+
+            // remove the acceleration normal to the constraint
+            Scalar3 pos = make_scalar3(0,0,0);
+            if (m_projection.kind != ConstraintProjection::none)
+                {
+                if (m_projection.needsPosition())
+                    pos = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                h_accel.data[j] = m_projection.projectVector(pos, h_accel.data[j]);
+                }
 
-        // tally the energy transfer from the bd thermal reservoir to the particles
-        if (m_tally) bd_energy_transfer += bd_fx * h_vel.data[j].x + bd_fy * h_vel.data[j].y + bd_fz * h_vel.data[j].z;
+            // then, update the velocity
+            h_vel.data[j].x += Scalar(1.0/2.0)*h_accel.data[j].x*m_deltaT;
+            h_vel.data[j].y += Scalar(1.0/2.0)*h_accel.data[j].y*m_deltaT;
+            if (D == 3)
+                h_vel.data[j].z += Scalar(1.0/2.0)*h_accel.data[j].z*m_deltaT;
 
-        // rotational updates
-        if (m_aniso)
-            {
-            unsigned int type_r = __scalar_as_int(h_pos.data[j].w);
-            Scalar3 gamma_r = h_gamma_r.data[type_r];
-            // get body frame ang_mom
-            quat<Scalar> p(h_angmom.data[j]);
-            quat<Scalar> q(h_orientation.data[j]);
-            vec3<Scalar> t(h_net_torque.data[j]);
-            vec3<Scalar> I(h_inertia.data[j]);
+            if (m_projection.kind != ConstraintProjection::none)
+                {
+                Scalar3 vel = make_scalar3(h_vel.data[j].x, h_vel.data[j].y, h_vel.data[j].z);
+                vel = m_projection.projectVector(pos, vel);
+                h_vel.data[j].x = vel.x;
+                h_vel.data[j].y = vel.y;
+                h_vel.data[j].z = vel.z;
+                }
 
-            // s is the pure imaginary quaternion with im. part equal to true angular velocity
-            vec3<Scalar> s;
-            s = (Scalar(1./2.) * conj(q) * p).v;
+            // tally the energy transfer from the bd thermal reservoir to the particles
+            if (m_tally)
+                {
+                bd_energy_transfer += bd_fx * h_vel.data[j].x + bd_fy * h_vel.data[j].y;
+                if (D == 3)
+                    bd_energy_transfer += bd_fz * h_vel.data[j].z;
+                }
 
-            if (gamma_r.x > 0 || gamma_r.y > 0 || gamma_r.z > 0)
+            // rotational updates
+            if (m_aniso)
                 {
-                // first calculate in the body frame random and damping torque imposed by the dynamics
-                vec3<Scalar> bf_torque;
-
-                // original Gaussian random torque
-                Scalar3 sigma_r = make_scalar3(fast::sqrt(Scalar(2.0)*gamma_r.x*currentTemp/m_deltaT),
-                                               fast::sqrt(Scalar(2.0)*gamma_r.y*currentTemp/m_deltaT),
-                                               fast::sqrt(Scalar(2.0)*gamma_r.z*currentTemp/m_deltaT));
-                if (m_noiseless_r) sigma_r = make_scalar3(0.0,0.0,0.0);
-
-                Scalar rand_x = hoomd::NormalDistribution<Scalar>(sigma_r.x)(rng);
-                Scalar rand_y = hoomd::NormalDistribution<Scalar>(sigma_r.y)(rng);
-                Scalar rand_z = hoomd::NormalDistribution<Scalar>(sigma_r.z)(rng);
-
-                // check for degenerate moment of inertia
-                bool x_zero, y_zero, z_zero;
-                x_zero = (I.x < EPSILON); y_zero = (I.y < EPSILON); z_zero = (I.z < EPSILON);
-
-                bf_torque.x = rand_x - gamma_r.x * (s.x / I.x);
-                bf_torque.y = rand_y - gamma_r.y * (s.y / I.y);
-                bf_torque.z = rand_z - gamma_r.z * (s.z / I.z);
-
-                // ignore torque component along an axis for which the moment of inertia zero
-                if (x_zero) bf_torque.x = 0;
-                if (y_zero) bf_torque.y = 0;
-                if (z_zero) bf_torque.z = 0;
-
-                // change to lab frame and update the net torque
-                bf_torque = rotate(q, bf_torque);
-                h_net_torque.data[j].x += bf_torque.x;
-                h_net_torque.data[j].y += bf_torque.y;
-                h_net_torque.data[j].z += bf_torque.z;
-
-                if (D < 3) h_net_torque.data[j].x = 0;
-                if (D < 3) h_net_torque.data[j].y = 0;
+                unsigned int type_r = __scalar_as_int(h_pos.data[j].w);
+                Scalar3 gamma_r = h_gamma_r.data[type_r];
+                // get body frame ang_mom
+                quat<Scalar> p(h_angmom.data[j]);
+                quat<Scalar> q(h_orientation.data[j]);
+                vec3<Scalar> t(h_net_torque.data[j]);
+                vec3<Scalar> I(h_inertia.data[j]);
+
+                // s is the pure imaginary quaternion with im. part equal to true angular velocity
+                vec3<Scalar> s;
+                s = (Scalar(1./2.) * conj(q) * p).v;
+
+                if (gamma_r.x > 0 || gamma_r.y > 0 || gamma_r.z > 0)
+                    {
+                    // first calculate in the body frame random and damping torque imposed by the dynamics
+                    vec3<Scalar> bf_torque;
+
+                    // original Gaussian random torque
+                    Scalar3 sigma_r = make_scalar3(fast::sqrt(Scalar(2.0)*gamma_r.x*currentTemp/m_deltaT),
+                                                   fast::sqrt(Scalar(2.0)*gamma_r.y*currentTemp/m_deltaT),
+                                                   fast::sqrt(Scalar(2.0)*gamma_r.z*currentTemp/m_deltaT));
+                    if (m_noiseless_r) sigma_r = make_scalar3(0.0,0.0,0.0);
+
+                    Scalar rand_x = normal_x[l]*sigma_r.x;
+                    Scalar rand_y = normal_y[l]*sigma_r.y;
+                    Scalar rand_z = normal_z[l]*sigma_r.z;
+
+                    // check for degenerate moment of inertia
+                    bool x_zero, y_zero, z_zero;
+                    x_zero = (I.x < EPSILON); y_zero = (I.y < EPSILON); z_zero = (I.z < EPSILON);
+
+                    bf_torque.x = rand_x - gamma_r.x * (s.x / I.x);
+                    bf_torque.y = rand_y - gamma_r.y * (s.y / I.y);
+                    bf_torque.z = rand_z - gamma_r.z * (s.z / I.z);
+
+                    // ignore torque component along an axis for which the moment of inertia zero
+                    if (x_zero) bf_torque.x = 0;
+                    if (y_zero) bf_torque.y = 0;
+                    if (z_zero) bf_torque.z = 0;
+
+                    // change to lab frame and update the net torque
+                    bf_torque = rotate(q, bf_torque);
+                    h_net_torque.data[j].x += bf_torque.x;
+                    h_net_torque.data[j].y += bf_torque.y;
+                    h_net_torque.data[j].z += bf_torque.z;
+
+                    if (D < 3) h_net_torque.data[j].x = 0;
+                    if (D < 3) h_net_torque.data[j].y = 0;
+                    }
                 }
             }
         }
@@ -412,5 +516,7 @@ void export_TwoStepLangevin(py::module& m)
         .def_property("tally_reservoir_energy", &TwoStepLangevin::getTallyReservoirEnergy,
                                                 &TwoStepLangevin::setTallyReservoirEnergy)
         .def_property_readonly("reservoir_energy", &TwoStepLangevin::getReservoirEnergy)
+        .def_property("constraint", &TwoStepLangevin::getConstraint,
+                                    &TwoStepLangevin::setConstraint)
         ;
     }
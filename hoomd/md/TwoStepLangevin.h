@@ -82,6 +82,15 @@ class PYBIND11_EXPORT TwoStepLangevin : public TwoStepLangevinBase
 
         /// If set true, there will be no rotational noise (random torque)
         bool m_noiseless_r;
+
+    private:
+        /// Performs the first step of the integration in D dimensions
+        template<unsigned int D>
+        void integrateStepOneDim(unsigned int timestep);
+
+        /// Performs the second step of the integration in D dimensions
+        template<unsigned int D>
+        void integrateStepTwoDim(unsigned int timestep);
     };
 
 //! Exports the TwoStepLangevin class to python
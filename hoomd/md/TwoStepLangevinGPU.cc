@@ -80,6 +80,7 @@ void TwoStepLangevinGPU::integrateStepOne(unsigned int timestep)
                      false,
                      0,
                      false,
+                     m_projection,
                      m_tuner_one->getParam());
 
     if(m_exec_conf->isCUDAErrorCheckingEnabled())
@@ -134,7 +135,9 @@ void TwoStepLangevinGPU::integrateStepTwo(unsigned int timestep)
     // get the dimensionality of the system
     const unsigned int D = m_sysdef->getNDimensions();
 
-    ArrayHandle<Scalar4> d_net_force(net_force, access_location::device, access_mode::read);
+    // the net force is summed in the kernel when the integrator has fused it into this step
+    ArrayHandle<Scalar4> d_net_force(net_force, access_location::device,
+        m_fused_net_force.enabled ? access_mode::readwrite : access_mode::read);
     ArrayHandle<Scalar> d_gamma(m_gamma, access_location::device, access_mode::read);
     ArrayHandle<Scalar3> d_gamma_r(m_gamma_r, access_location::device, access_mode::read);
     ArrayHandle< unsigned int > d_index_array(m_group->getIndexArray(), access_location::device, access_mode::read);
@@ -167,6 +170,7 @@ void TwoStepLangevinGPU::integrateStepTwo(unsigned int timestep)
         args.noiseless_t = m_noiseless_t;
         args.noiseless_r = m_noiseless_r;
         args.tally = m_tally;
+        args.projection = m_projection;
 
         gpu_langevin_step_two(d_pos.data,
                               d_vel.data,
@@ -178,7 +182,8 @@ void TwoStepLangevinGPU::integrateStepTwo(unsigned int timestep)
                               d_net_force.data,
                               args,
                               m_deltaT,
-                              D);
+                              D,
+                              m_fused_net_force);
 
         if(m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
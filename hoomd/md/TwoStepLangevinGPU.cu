@@ -37,6 +37,8 @@ using namespace hoomd;
     \param D Dimensionality of the system
     \param tally Boolean indicating whether energy tally is performed or not
     \param d_partial_sum_bdenergy Placeholder for the partial sum
+    \param projection Constraint to project the particle motion onto
+    \param fused When enabled, sum the net force of each particle instead of reading it
 
     This kernel is implemented in a very similar manner to gpu_nve_step_two_kernel(), see it for design details.
 
@@ -63,7 +65,9 @@ __global__ void gpu_langevin_step_two_kernel(const Scalar4 *d_pos,
                                  Scalar deltaT,
                                  unsigned int D,
                                  bool tally,
-                                 Scalar *d_partial_sum_bdenergy)
+                                 Scalar *d_partial_sum_bdenergy,
+                                 const ConstraintProjection projection,
+                                 const gpu_fused_net_force fused)
     {
     HIP_DYNAMIC_SHARED( char, s_data)
     Scalar *s_gammas = (Scalar *)s_data;
@@ -130,7 +134,7 @@ __global__ void gpu_langevin_step_two_kernel(const Scalar4 *d_pos,
             bd_force.z = randomz*coeff - gamma*vel.z;
 
         // read in the net force and calculate the acceleration MEM TRANSFER: 16 bytes
-        Scalar4 net_force = d_net_force[idx];
+        Scalar4 net_force = fused.enabled ? gpu_fused_net_force_sum(fused, d_net_force, idx) : d_net_force[idx];
         Scalar3 accel = make_scalar3(net_force.x,net_force.y,net_force.z);
         // MEM TRANSFER: 4 bytes   FLOPS: 3
         Scalar mass = vel.w;
@@ -139,12 +143,32 @@ __global__ void gpu_langevin_step_two_kernel(const Scalar4 *d_pos,
         accel.y = (accel.y + bd_force.y) * minv;
         accel.z = (accel.z + bd_force.z) * minv;
 
+        // remove the acceleration normal to the constraint
+        Scalar3 pos = make_scalar3(Scalar(0.0), Scalar(0.0), Scalar(0.0));
+        if (projection.kind != ConstraintProjection::none)
+            {
+            if (projection.needsPosition())
+                {
+                const Scalar4 postype = d_pos[idx];
+                pos = make_scalar3(postype.x, postype.y, postype.z);
+                }
+            accel = projection.projectVector(pos, accel);
+            }
+
         // v(t+deltaT) = v(t+deltaT/2) + 1/2 * a(t+deltaT)*deltaT
         // update the velocity (FLOPS: 6)
         vel.x += (Scalar(1.0)/Scalar(2.0)) * accel.x * deltaT;
         vel.y += (Scalar(1.0)/Scalar(2.0)) * accel.y * deltaT;
         vel.z += (Scalar(1.0)/Scalar(2.0)) * accel.z * deltaT;
 
+        if (projection.kind != ConstraintProjection::none)
+            {
+            const Scalar3 v = projection.projectVector(pos, make_scalar3(vel.x, vel.y, vel.z));
+            vel.x = v.x;
+            vel.y = v.y;
+            vel.z = v.z;
+            }
+
         // tally the energy transfer from the bd thermal reservoir to the particles (FLOPS: 6)
         bd_energy_transfer =  bd_force.x *vel.x +  bd_force.y * vel.y +  bd_force.z * vel.z;
 
@@ -437,6 +461,7 @@ hipError_t gpu_langevin_angular_step_two(const Scalar4 *d_pos,
     \param langevin_args Collected arguments for gpu_langevin_step_two_kernel() and gpu_langevin_angular_step_two()
     \param deltaT Amount of real time to step forward in one time step
     \param D Dimensionality of the system
+    \param fused Net force sum to perform in the kernel
 
     This is just a driver for gpu_langevin_step_two_kernel(), see it for details.
 */
@@ -450,7 +475,8 @@ hipError_t gpu_langevin_step_two(const Scalar4 *d_pos,
                                   Scalar4 *d_net_force,
                                   const langevin_step_two_args& langevin_args,
                                   Scalar deltaT,
-                                  unsigned int D)
+                                  unsigned int D,
+                                  const gpu_fused_net_force& fused)
     {
 
     // setup the grid to run the kernel
@@ -480,7 +506,9 @@ hipError_t gpu_langevin_step_two(const Scalar4 *d_pos,
                                  deltaT,
                                  D,
                                  langevin_args.tally,
-                                 langevin_args.d_partial_sum_bdenergy);
+                                 langevin_args.d_partial_sum_bdenergy,
+                                 langevin_args.projection,
+                                 fused);
 
     // run the summation kernel
     if (langevin_args.tally)
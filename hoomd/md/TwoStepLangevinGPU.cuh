@@ -11,6 +11,8 @@
 #include <hip/hip_runtime.h>
 #include "hoomd/ParticleData.cuh"
 #include "hoomd/HOOMDMath.h"
+#include "hoomd/Integrator.cuh"
+#include "ConstraintProjection.h"
 
 #ifndef __TWO_STEP_LANGEVIN_GPU_CUH__
 #define __TWO_STEP_LANGEVIN_GPU_CUH__
@@ -32,6 +34,7 @@ struct langevin_step_two_args
     bool noiseless_t;         //!<  If set true, there will be no translational noise (random force)
     bool noiseless_r;         //!<  If set true, there will be no rotational noise (random torque)
     bool tally;               //!< Set to true is bd thermal reservoir energy tally is to be performed
+    ConstraintProjection projection; //!< Constraint to project the particle motion onto
     };
 
 //! Kernel driver for the second part of the Langevin update called by TwoStepLangevinGPU
@@ -45,7 +48,8 @@ hipError_t gpu_langevin_step_two(const Scalar4 *d_pos,
                                   Scalar4 *d_net_force,
                                   const langevin_step_two_args& langevin_args,
                                   Scalar deltaT,
-                                  unsigned int D);
+                                  unsigned int D,
+                                  const gpu_fused_net_force& fused = gpu_fused_net_force());
 
 //! Kernel driver for the second part of the angular Langevin update (NO_SQUISH) by TwoStepLangevinGPU
 hipError_t gpu_langevin_angular_step_two(const Scalar4 *d_pos,
@@ -46,6 +46,12 @@ class PYBIND11_EXPORT TwoStepLangevinGPU : public TwoStepLangevin
             m_tuner_angular_one->setEnabled(enable);
             }
 
+        //! Test if the net force can be summed in the second step kernel
+        virtual bool canFuseNetForce()
+            {
+            return true;
+            }
+
     protected:
         unsigned int m_block_size;               //!< block size for partial sum memory
         unsigned int m_num_blocks;               //!< number of memory blocks reserved for partial sum memory
@@ -57,7 +57,10 @@ TwoStepNPTMTK::TwoStepNPTMTK(std::shared_ptr<SystemDefinition> sysdef,
                             m_S(S),
                             m_nph(nph),
                             m_rescale_all(false),
-                            m_gamma(0.0)
+                            m_gamma(0.0),
+                            m_barostat_period(1),
+                            m_last_timestep(0),
+                            m_integrated(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing TwoStepNPTMTK" << endl;
 
@@ -501,6 +504,9 @@ void TwoStepNPTMTK::integrateStepTwo(unsigned int timestep)
     // advance barostat (nuxx, nuyy, nuzz) half a time step
     advanceBarostat(timestep+1);
 
+    m_last_timestep = timestep;
+    m_integrated = true;
+
     // done profiling
     if (m_prof)
         m_prof->pop();
@@ -719,9 +725,30 @@ std::vector<bool> TwoStepNPTMTK::getFlags()
     return result;
     }
 
+/*! \param period Number of steps between the barostat updates
+
+    The barostat is updated on the steps that are a multiple of \a period, with kicks of \a period time steps. The
+    box and the particles are propagated with the constant barostat momenta in between, as in a multiple time step
+    integrator with the pressure as the slow force, so that the virial is only needed on the updating steps.
+*/
+void TwoStepNPTMTK::setBarostatPeriod(unsigned int period)
+    {
+    if (period == 0)
+        {
+        m_exec_conf->msg->error() << "integrate.npt: barostat_period must be positive." << std::endl;
+        throw std::runtime_error("Error setting the barostat period");
+        }
+    m_barostat_period = period;
+    }
+
 //! Helper function to advance the barostat parameters
 void TwoStepNPTMTK::advanceBarostat(unsigned int timestep)
     {
+    // the barostat is only advanced every m_barostat_period steps, by the time of all steps in between
+    if (timestep % m_barostat_period != 0)
+        return;
+    const Scalar deltaT = m_deltaT*Scalar(m_barostat_period);
+
     // compute thermodynamic properties at full time step
     m_thermo_full_step->compute(timestep);
 
@@ -743,7 +770,7 @@ void TwoStepNPTMTK::advanceBarostat(unsigned int timestep)
     unsigned int d = m_sysdef->getNDimensions();
     Scalar W = (Scalar)(m_ndof+d)/(Scalar)d*(*m_T)(timestep)*m_tauS*m_tauS;
     Scalar mtk_term = Scalar(2.0)*m_thermo_full_step->getTranslationalKineticEnergy();
-    mtk_term *= Scalar(1.0/2.0)*m_deltaT/(Scalar)m_ndof/W;
+    mtk_term *= Scalar(1.0/2.0)*deltaT/(Scalar)m_ndof/W;
 
     couplingMode couple = getRelevantCouplings();
 
@@ -796,37 +823,37 @@ void TwoStepNPTMTK::advanceBarostat(unsigned int timestep)
 
     if (m_flags & baro_x)
         {
-        nuxx += Scalar(1.0/2.0)*m_deltaT*m_V/W*(P_diag.x - (*m_S[0])(timestep)) + mtk_term;
+        nuxx += Scalar(1.0/2.0)*deltaT*m_V/W*(P_diag.x - (*m_S[0])(timestep)) + mtk_term;
         nuxx -= m_gamma*nuxx;
         }
 
     if (m_flags & baro_xy)
         {
-        nuxy += Scalar(1.0/2.0)*m_deltaT*m_V/W*(P.xy - (*m_S[5])(timestep));
+        nuxy += Scalar(1.0/2.0)*deltaT*m_V/W*(P.xy - (*m_S[5])(timestep));
         nuxy -= m_gamma*nuxy;
         }
 
     if (m_flags & baro_xz)
         {
-        nuxz += Scalar(1.0/2.0)*m_deltaT*m_V/W*(P.xz- (*m_S[4])(timestep));
+        nuxz += Scalar(1.0/2.0)*deltaT*m_V/W*(P.xz- (*m_S[4])(timestep));
         nuxz -= m_gamma*nuxz;
         }
 
     if (m_flags & baro_y)
         {
-        nuyy += Scalar(1.0/2.0)*m_deltaT*m_V/W*(P_diag.y - (*m_S[1])(timestep)) + mtk_term;
+        nuyy += Scalar(1.0/2.0)*deltaT*m_V/W*(P_diag.y - (*m_S[1])(timestep)) + mtk_term;
         nuyy -= m_gamma*nuyy;
         }
 
     if (m_flags & baro_yz)
         {
-        nuyz += Scalar(1.0/2.0)*m_deltaT*m_V/W*(P.yz- (*m_S[3])(timestep));
+        nuyz += Scalar(1.0/2.0)*deltaT*m_V/W*(P.yz- (*m_S[3])(timestep));
         nuyz -= m_gamma*nuyz;
         }
 
     if (m_flags & baro_z)
         {
-        nuzz += Scalar(1.0/2.0)*m_deltaT*m_V/W*(P_diag.z - (*m_S[2])(timestep)) + mtk_term;
+        nuzz += Scalar(1.0/2.0)*deltaT*m_V/W*(P_diag.z - (*m_S[2])(timestep)) + mtk_term;
         nuzz -= m_gamma*nuzz;
         }
 
@@ -1214,6 +1241,7 @@ void export_TwoStepNPTMTK(py::module& m)
         .def_property("box_dof", &TwoStepNPTMTK::getFlags, &TwoStepNPTMTK::setFlags)
         .def_property("rescale_all", &TwoStepNPTMTK::getRescaleAll, &TwoStepNPTMTK::setRescaleAll)
         .def_property("gamma", &TwoStepNPTMTK::getGamma, &TwoStepNPTMTK::setGamma)
+        .def_property("barostat_period", &TwoStepNPTMTK::getBarostatPeriod, &TwoStepNPTMTK::setBarostatPeriod)
         .def("thermalizeThermostatAndBarostatDOF", &TwoStepNPTMTK::thermalizeThermostatAndBarostatDOF)
         .def_property("translational_thermostat_dof",
                       &TwoStepNPTMTK::getTranslationalThermostatDOF,
@@ -123,6 +123,9 @@ class PYBIND11_EXPORT TwoStepNPTMTK : public IntegrationMethodTwoStep
             {
             m_gamma = gamma;
             }
+
+        //! Set the number of steps between the barostat updates
+        void setBarostatPeriod(unsigned int period);
         //! declaration for setting the parameter couple
         void setCouple(const std::string& value);
 
@@ -165,6 +168,12 @@ class PYBIND11_EXPORT TwoStepNPTMTK : public IntegrationMethodTwoStep
             return m_gamma;
             }
 
+        //! Get the number of steps between the barostat updates
+        unsigned int getBarostatPeriod()
+            {
+            return m_barostat_period;
+            }
+
         // declaration get function of couple
         std::string getCouple();
 
@@ -181,17 +190,23 @@ class PYBIND11_EXPORT TwoStepNPTMTK : public IntegrationMethodTwoStep
 
 
         //! Get needed pdata flags
-        /*! TwoStepNPTMTK needs the pressure, so the pressure_tensor flag is set
+        /*! TwoStepNPTMTK needs the pressure, so the pressure_tensor flag is set. When the barostat is only updated
+            every few steps, the flag is only set when the forces are computed for a step that updates the barostat.
+            The forces computed next are those of two steps after the last integrated one, or of an unknown step
+            before the first.
         */
         virtual PDataFlags getRequestedPDataFlags()
             {
             PDataFlags flags;
-            flags[pdata_flag::pressure_tensor] = 1;
+            if (m_barostat_period == 1 || !m_integrated || (m_last_timestep + 2) % m_barostat_period == 0)
+                {
+                flags[pdata_flag::pressure_tensor] = 1;
+                flags[pdata_flag::external_field_virial]=1;
+                }
             if (m_aniso)
                 {
                 flags[pdata_flag::rotational_kinetic_energy] = 1;
                 }
-            flags[pdata_flag::external_field_virial]=1;
             return flags;
             }
 
@@ -254,6 +269,10 @@ class PYBIND11_EXPORT TwoStepNPTMTK : public IntegrationMethodTwoStep
 
         Scalar m_gamma;                 //!< Optional damping factor for box degrees of freedom
 
+        unsigned int m_barostat_period; //!< Number of steps between the barostat updates
+        unsigned int m_last_timestep;   //!< Last step integrated by integrateStepTwo()
+        bool m_integrated;              //!< True once integrateStepTwo() has been called
+
         std::vector<std::string> m_log_names; //!< Name of the barostat and thermostat quantities that we log
 
         //! Helper function to advance the barostat parameters
@@ -367,6 +367,9 @@ void TwoStepNPTMTKGPU::integrateStepTwo(unsigned int timestep)
     // advance barostat (nuxx, nuyy, nuzz) half a time step
     advanceBarostat(timestep+1);
 
+    m_last_timestep = timestep;
+    m_integrated = true;
+
     // done profiling
     if (m_prof)
         m_prof->pop();
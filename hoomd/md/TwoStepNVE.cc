@@ -105,8 +105,19 @@ void TwoStepNVE::setZeroForce(pybind11::object zero_force)
 */
 void TwoStepNVE::integrateStepOne(unsigned int timestep)
     {
-    unsigned int group_size = m_group->getNumMembers();
+    // in 2D, the z components of the particles are never touched
+    if (m_sysdef->getNDimensions() == 2)
+        integrateStepOneDim<2>(timestep);
+    else
+        integrateStepOneDim<3>(timestep);
+    }
 
+/*! \tparam D Dimensionality of the system
+    \param timestep Current time step
+*/
+template<unsigned int D>
+void TwoStepNVE::integrateStepOneDim(unsigned int timestep)
+    {
     // profile this step
     if (m_prof)
         m_prof->push("NVE step 1");
@@ -118,15 +129,23 @@ void TwoStepNVE::integrateStepOne(unsigned int timestep)
     // perform the first half step of velocity verlet
     // r(t+deltaT) = r(t) + v(t)*deltaT + (1/2)a(t)*deltaT^2
     // v(t+deltaT/2) = v(t) + (1/2)a*deltaT
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    forEachMember([&](unsigned int j)
         {
-        unsigned int j = m_group->getMemberIndex(group_idx);
         if (m_zero_force)
             h_accel.data[j].x = h_accel.data[j].y = h_accel.data[j].z = 0.0;
 
+        const Scalar3 old_pos = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+        if (m_projection.kind != ConstraintProjection::none)
+            {
+            // the accelerations may have been computed without the constraint before the first step
+            h_accel.data[j] = m_projection.projectVector(old_pos, h_accel.data[j]);
+            }
+
         Scalar dx = h_vel.data[j].x*m_deltaT + Scalar(1.0/2.0)*h_accel.data[j].x*m_deltaT*m_deltaT;
         Scalar dy = h_vel.data[j].y*m_deltaT + Scalar(1.0/2.0)*h_accel.data[j].y*m_deltaT*m_deltaT;
-        Scalar dz = h_vel.data[j].z*m_deltaT + Scalar(1.0/2.0)*h_accel.data[j].z*m_deltaT*m_deltaT;
+        Scalar dz = Scalar(0.0);
+        if (D == 3)
+            dz = h_vel.data[j].z*m_deltaT + Scalar(1.0/2.0)*h_accel.data[j].z*m_deltaT*m_deltaT;
 
         // limit the movement of the particles
         if (m_limit)
@@ -142,23 +161,42 @@ void TwoStepNVE::integrateStepOne(unsigned int timestep)
 
         h_pos.data[j].x += dx;
         h_pos.data[j].y += dy;
-        h_pos.data[j].z += dz;
 
         h_vel.data[j].x += Scalar(1.0/2.0)*h_accel.data[j].x*m_deltaT;
         h_vel.data[j].y += Scalar(1.0/2.0)*h_accel.data[j].y*m_deltaT;
-        h_vel.data[j].z += Scalar(1.0/2.0)*h_accel.data[j].z*m_deltaT;
-        }
+
+        if (D == 3)
+            {
+            h_pos.data[j].z += dz;
+            h_vel.data[j].z += Scalar(1.0/2.0)*h_accel.data[j].z*m_deltaT;
+            }
+
+        // move the particle back onto the constraint and remove the velocity normal to it
+        if (m_projection.kind != ConstraintProjection::none)
+            {
+            Scalar3 pos = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            pos = m_projection.projectPosition(old_pos, pos);
+            h_pos.data[j].x = pos.x;
+            h_pos.data[j].y = pos.y;
+            h_pos.data[j].z = pos.z;
+
+            Scalar3 vel = make_scalar3(h_vel.data[j].x, h_vel.data[j].y, h_vel.data[j].z);
+            vel = m_projection.projectVector(pos, vel);
+            h_vel.data[j].x = vel.x;
+            h_vel.data[j].y = vel.y;
+            h_vel.data[j].z = vel.z;
+            }
+        });
 
     // particles may have been moved slightly outside the box by the above steps, wrap them back into place
     const BoxDim& box = m_pdata->getBox();
 
     ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
 
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    forEachMember([&](unsigned int j)
         {
-        unsigned int j = m_group->getMemberIndex(group_idx);
         box.wrap(h_pos.data[j], h_image.data[j]);
-        }
+        });
 
     // Integration of angular degrees of freedom using symplectic and
     // time-reversal symmetric integration scheme of Miller et al.
@@ -169,10 +207,8 @@ void TwoStepNVE::integrateStepOne(unsigned int timestep)
         ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(), access_location::host, access_mode::read);
         ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
 
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        forEachMember([&](unsigned int j)
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-
             quat<Scalar> q(h_orientation.data[j]);
             quat<Scalar> p(h_angmom.data[j]);
             vec3<Scalar> t(h_net_torque.data[j]);
@@ -265,7 +301,7 @@ void TwoStepNVE::integrateStepOne(unsigned int timestep)
 
             h_orientation.data[j] = quat_to_scalar4(q);
             h_angmom.data[j] = quat_to_scalar4(p);
-            }
+            });
         }
 
     // done profiling
@@ -278,8 +314,19 @@ void TwoStepNVE::integrateStepOne(unsigned int timestep)
 */
 void TwoStepNVE::integrateStepTwo(unsigned int timestep)
     {
-    unsigned int group_size = m_group->getNumMembers();
+    // in 2D, the z components of the particles are never touched
+    if (m_sysdef->getNDimensions() == 2)
+        integrateStepTwoDim<2>(timestep);
+    else
+        integrateStepTwoDim<3>(timestep);
+    }
 
+/*! \tparam D Dimensionality of the system
+    \param timestep Current time step
+*/
+template<unsigned int D>
+void TwoStepNVE::integrateStepTwoDim(unsigned int timestep)
+    {
     const GlobalArray< Scalar4 >& net_force = m_pdata->getNetForce();
 
     // profile this step
@@ -290,12 +337,11 @@ void TwoStepNVE::integrateStepTwo(unsigned int timestep)
     ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(), access_location::host, access_mode::readwrite);
 
     ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
 
     // v(t+deltaT) = v(t+deltaT/2) + 1/2 * a(t+deltaT)*deltaT
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    forEachMember([&](unsigned int j)
         {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-
         if (m_zero_force)
             {
             h_accel.data[j].x = h_accel.data[j].y = h_accel.data[j].z = 0.0;
@@ -306,26 +352,48 @@ void TwoStepNVE::integrateStepTwo(unsigned int timestep)
             Scalar minv = Scalar(1.0) / h_vel.data[j].w;
             h_accel.data[j].x = h_net_force.data[j].x*minv;
             h_accel.data[j].y = h_net_force.data[j].y*minv;
-            h_accel.data[j].z = h_net_force.data[j].z*minv;
+            if (D == 3)
+                h_accel.data[j].z = h_net_force.data[j].z*minv;
+            }
+
+        // remove the acceleration normal to the constraint
+        Scalar3 pos = make_scalar3(0,0,0);
+        if (m_projection.kind != ConstraintProjection::none)
+            {
+            if (m_projection.needsPosition())
+                pos = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            h_accel.data[j] = m_projection.projectVector(pos, h_accel.data[j]);
             }
 
         // then, update the velocity
         h_vel.data[j].x += Scalar(1.0/2.0)*h_accel.data[j].x*m_deltaT;
         h_vel.data[j].y += Scalar(1.0/2.0)*h_accel.data[j].y*m_deltaT;
-        h_vel.data[j].z += Scalar(1.0/2.0)*h_accel.data[j].z*m_deltaT;
+        if (D == 3)
+            h_vel.data[j].z += Scalar(1.0/2.0)*h_accel.data[j].z*m_deltaT;
+
+        if (m_projection.kind != ConstraintProjection::none)
+            {
+            Scalar3 vel = make_scalar3(h_vel.data[j].x, h_vel.data[j].y, h_vel.data[j].z);
+            vel = m_projection.projectVector(pos, vel);
+            h_vel.data[j].x = vel.x;
+            h_vel.data[j].y = vel.y;
+            h_vel.data[j].z = vel.z;
+            }
 
         // limit the movement of the particles
         if (m_limit)
             {
-            Scalar vel = sqrt(h_vel.data[j].x*h_vel.data[j].x+h_vel.data[j].y*h_vel.data[j].y+h_vel.data[j].z*h_vel.data[j].z);
+            Scalar vz = (D == 3) ? h_vel.data[j].z : Scalar(0.0);
+            Scalar vel = sqrt(h_vel.data[j].x*h_vel.data[j].x+h_vel.data[j].y*h_vel.data[j].y+vz*vz);
             if ( (vel*m_deltaT) > m_limit_val)
                 {
                 h_vel.data[j].x = h_vel.data[j].x / vel * m_limit_val / m_deltaT;
                 h_vel.data[j].y = h_vel.data[j].y / vel * m_limit_val / m_deltaT;
-                h_vel.data[j].z = h_vel.data[j].z / vel * m_limit_val / m_deltaT;
+                if (D == 3)
+                    h_vel.data[j].z = h_vel.data[j].z / vel * m_limit_val / m_deltaT;
                 }
             }
-        }
+        });
 
     if (m_aniso)
         {
@@ -335,10 +403,8 @@ void TwoStepNVE::integrateStepTwo(unsigned int timestep)
         ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(), access_location::host, access_mode::read);
         ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
 
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        forEachMember([&](unsigned int j)
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-
             quat<Scalar> q(h_orientation.data[j]);
             quat<Scalar> p(h_angmom.data[j]);
             vec3<Scalar> t(h_net_torque.data[j]);
@@ -360,7 +426,7 @@ void TwoStepNVE::integrateStepTwo(unsigned int timestep)
             p += m_deltaT*q*t;
 
             h_angmom.data[j] = quat_to_scalar4(p);
-            }
+            });
         }
 
     // done profiling
@@ -378,5 +444,7 @@ void export_TwoStepNVE(py::module& m)
                                &TwoStepNVE::setLimit)
         .def_property("zero_force", &TwoStepNVE::getZeroForce,
                                    &TwoStepNVE::setZeroForce)
+        .def_property("constraint", &TwoStepNVE::getConstraint,
+                                    &TwoStepNVE::setConstraint)
         ;
     }
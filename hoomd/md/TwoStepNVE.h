@@ -59,6 +59,15 @@ class PYBIND11_EXPORT TwoStepNVE : public IntegrationMethodTwoStep
         bool m_limit;       //!< True if we should limit the distance a particle moves in one step
         Scalar m_limit_val; //!< The maximum distance a particle is to move in one step
         bool m_zero_force;  //!< True if the integration step should ignore computed forces
+
+    private:
+        //! Performs the first step of the integration in D dimensions
+        template<unsigned int D>
+        void integrateStepOneDim(unsigned int timestep);
+
+        //! Performs the second step of the integration in D dimensions
+        template<unsigned int D>
+        void integrateStepTwoDim(unsigned int timestep);
     };
 
 //! Exports the TwoStepNVE class to python
@@ -63,7 +63,8 @@ void TwoStepNVEGPU::integrateStepOne(unsigned int timestep)
 
     // perform the update on the GPU
     m_exec_conf->beginMultiGPU();
-    m_tuner_one->begin();
+    if (!m_graph_stream)
+        m_tuner_one->begin();
     gpu_nve_step_one(d_pos.data,
                      d_vel.data,
                      d_accel.data,
@@ -75,12 +76,15 @@ void TwoStepNVEGPU::integrateStepOne(unsigned int timestep)
                      m_limit,
                      m_limit_val,
                      m_zero_force,
-                     m_tuner_one->getParam());
+                     m_projection,
+                     m_tuner_one->getParam(),
+                     m_graph_stream);
 
-    if(m_exec_conf->isCUDAErrorCheckingEnabled())
+    if (m_exec_conf->isCUDAErrorCheckingEnabled() && !m_graph_stream)
         CHECK_CUDA_ERROR();
 
-    m_tuner_one->end();
+    if (!m_graph_stream)
+        m_tuner_one->end();
     m_exec_conf->endMultiGPU();
 
     if (m_aniso)
@@ -92,7 +96,8 @@ void TwoStepNVEGPU::integrateStepOne(unsigned int timestep)
         ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::device, access_mode::read);
 
         m_exec_conf->beginMultiGPU();
-        m_tuner_angular_one->begin();
+        if (!m_graph_stream)
+            m_tuner_angular_one->begin();
 
         gpu_nve_angular_step_one(d_orientation.data,
                                  d_angmom.data,
@@ -102,12 +107,14 @@ void TwoStepNVEGPU::integrateStepOne(unsigned int timestep)
                                  m_group->getGPUPartition(),
                                  m_deltaT,
                                  1.0,
-                                 m_tuner_angular_one->getParam());
+                                 m_tuner_angular_one->getParam(),
+                                 m_graph_stream);
 
-        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        if (m_exec_conf->isCUDAErrorCheckingEnabled() && !m_graph_stream)
             CHECK_CUDA_ERROR();
 
-        m_tuner_angular_one->end();
+        if (!m_graph_stream)
+            m_tuner_angular_one->end();
         m_exec_conf->endMultiGPU();
         }
 
@@ -129,16 +136,21 @@ void TwoStepNVEGPU::integrateStepTwo(unsigned int timestep)
 
     ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(), access_location::device, access_mode::readwrite);
     ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(), access_location::device, access_mode::readwrite);
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
 
-    ArrayHandle<Scalar4> d_net_force(net_force, access_location::device, access_mode::read);
+    // the net force is summed in the kernel when the integrator has fused it into this step
+    ArrayHandle<Scalar4> d_net_force(net_force, access_location::device,
+        m_fused_net_force.enabled ? access_mode::readwrite : access_mode::read);
     ArrayHandle< unsigned int > d_index_array(m_group->getIndexArray(), access_location::device, access_mode::read);
 
     // perform the update on the GPU
     m_exec_conf->beginMultiGPU();
-    m_tuner_two->begin();
+    if (!m_graph_stream)
+        m_tuner_two->begin();
 
     gpu_nve_step_two(d_vel.data,
                      d_accel.data,
+                     d_pos.data,
                      d_index_array.data,
                      m_group->getGPUPartition(),
                      d_net_force.data,
@@ -146,12 +158,16 @@ void TwoStepNVEGPU::integrateStepTwo(unsigned int timestep)
                      m_limit,
                      m_limit_val,
                      m_zero_force,
-                     m_tuner_two->getParam());
+                     m_projection,
+                     m_tuner_two->getParam(),
+                     m_graph_stream,
+                     m_fused_net_force);
 
-    if(m_exec_conf->isCUDAErrorCheckingEnabled())
+    if (m_exec_conf->isCUDAErrorCheckingEnabled() && !m_graph_stream)
         CHECK_CUDA_ERROR();
 
-    m_tuner_two->end();
+    if (!m_graph_stream)
+        m_tuner_two->end();
     m_exec_conf->endMultiGPU();
 
     if (m_aniso)
@@ -163,7 +179,8 @@ void TwoStepNVEGPU::integrateStepTwo(unsigned int timestep)
         ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::device, access_mode::read);
 
         m_exec_conf->beginMultiGPU();
-        m_tuner_angular_two->begin();
+        if (!m_graph_stream)
+            m_tuner_angular_two->begin();
 
         gpu_nve_angular_step_two(d_orientation.data,
                                  d_angmom.data,
@@ -173,12 +190,14 @@ void TwoStepNVEGPU::integrateStepTwo(unsigned int timestep)
                                  m_group->getGPUPartition(),
                                  m_deltaT,
                                  1.0,
-                                 m_tuner_angular_two->getParam());
+                                 m_tuner_angular_two->getParam(),
+                                 m_graph_stream);
 
-        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        if (m_exec_conf->isCUDAErrorCheckingEnabled() && !m_graph_stream)
             CHECK_CUDA_ERROR();
 
-        m_tuner_angular_two->end();
+        if (!m_graph_stream)
+            m_tuner_angular_two->end();
         m_exec_conf->endMultiGPU();
         }
 
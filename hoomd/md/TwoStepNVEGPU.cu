@@ -27,6 +27,7 @@
         a distance further than \a limit_val in one step.
     \param limit_val Length to limit particle distance movement to
     \param zero_force Set to true to always assign an acceleration of 0 to all particles in the group
+    \param projection Constraint to project the particle motion onto
 
     This kernel must be executed with a 1D grid of any block size such that the number of threads is greater than or
     equal to the number of members in the group. The kernel's implementation simply reads one particle in each thread
@@ -49,7 +50,8 @@ void gpu_nve_step_one_kernel(Scalar4 *d_pos,
                              Scalar deltaT,
                              bool limit,
                              Scalar limit_val,
-                             bool zero_force)
+                             bool zero_force,
+                             const ConstraintProjection projection)
     {
     // determine which particle this thread works on (MEM TRANSFER: 4 bytes)
     int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -75,6 +77,11 @@ void gpu_nve_step_one_kernel(Scalar4 *d_pos,
         if (!zero_force)
             accel = d_accel[idx];
 
+        // the accelerations may have been computed without the constraint before the first step
+        const Scalar3 old_pos = pos;
+        if (projection.kind != ConstraintProjection::none)
+            accel = projection.projectVector(old_pos, accel);
+
         // update the position (FLOPS: 15)
         Scalar3 dx = vel * deltaT + (Scalar(1.0)/Scalar(2.0)) * accel * deltaT * deltaT;
 
@@ -92,6 +99,13 @@ void gpu_nve_step_one_kernel(Scalar4 *d_pos,
         // update the velocity (FLOPS: 9)
         vel += (Scalar(1.0)/Scalar(2.0)) * accel * deltaT;
 
+        // move the particle back onto the constraint and remove the velocity normal to it
+        if (projection.kind != ConstraintProjection::none)
+            {
+            pos = projection.projectPosition(old_pos, pos);
+            vel = projection.projectVector(pos, vel);
+            }
+
         // read in the particle's image (MEM TRANSFER: 16 bytes)
         int3 image = d_image[idx];
 
@@ -117,8 +131,10 @@ void gpu_nve_step_one_kernel(Scalar4 *d_pos,
         a distance further than \a limit_val in one step.
     \param limit_val Length to limit particle distance movement to
     \param zero_force Set to true to always assign an acceleration of 0 to all particles in the group
+    \param projection Constraint to project the particle motion onto
 
     See gpu_nve_step_one_kernel() for full documentation, this function is just a driver.
+    \param stream Stream to launch the kernel in
 */
 hipError_t gpu_nve_step_one(Scalar4 *d_pos,
                              Scalar4 *d_vel,
@@ -131,7 +147,9 @@ hipError_t gpu_nve_step_one(Scalar4 *d_pos,
                              bool limit,
                              Scalar limit_val,
                              bool zero_force,
-                             unsigned int block_size)
+                             const ConstraintProjection& projection,
+                             unsigned int block_size,
+                             hipStream_t stream)
     {
     static unsigned int max_block_size = UINT_MAX;
     if (max_block_size == UINT_MAX)
@@ -155,7 +173,7 @@ hipError_t gpu_nve_step_one(Scalar4 *d_pos,
         dim3 threads(run_block_size, 1, 1);
 
         // run the kernel
-        hipLaunchKernelGGL((gpu_nve_step_one_kernel), dim3(grid), dim3(threads ), 0, 0, d_pos, d_vel, d_accel, d_image, d_group_members, nwork, range.first, box, deltaT, limit, limit_val, zero_force);
+        hipLaunchKernelGGL((gpu_nve_step_one_kernel), dim3(grid), dim3(threads ), 0, stream, d_pos, d_vel, d_accel, d_image, d_group_members, nwork, range.first, box, deltaT, limit, limit_val, zero_force, projection);
         }
 
     return hipSuccess;
@@ -292,6 +310,7 @@ __global__ void gpu_nve_angular_step_one_kernel(Scalar4 *d_orientation,
     \param d_group_members Device array listing the indices of the members of the group to integrate
     \param group_size Number of members in the group
     \param deltaT timestep
+    \param stream Stream to launch the kernel in
 */
 hipError_t gpu_nve_angular_step_one(Scalar4 *d_orientation,
                              Scalar4 *d_angmom,
@@ -301,7 +320,8 @@ hipError_t gpu_nve_angular_step_one(Scalar4 *d_orientation,
                              const GPUPartition& gpu_partition,
                              Scalar deltaT,
                              Scalar scale,
-                             const unsigned int block_size)
+                             const unsigned int block_size,
+                             hipStream_t stream)
     {
     static unsigned int max_block_size = UINT_MAX;
     if (max_block_size == UINT_MAX)
@@ -325,7 +345,7 @@ hipError_t gpu_nve_angular_step_one(Scalar4 *d_orientation,
         dim3 threads(run_block_size, 1, 1);
 
         // run the kernel
-        hipLaunchKernelGGL((gpu_nve_angular_step_one_kernel), dim3(grid), dim3(threads ), 0, 0, d_orientation, d_angmom, d_inertia, d_net_torque, d_group_members, nwork, range.first, deltaT, scale);
+        hipLaunchKernelGGL((gpu_nve_angular_step_one_kernel), dim3(grid), dim3(threads ), 0, stream, d_orientation, d_angmom, d_inertia, d_net_torque, d_group_members, nwork, range.first, deltaT, scale);
         }
 
     return hipSuccess;
@@ -335,6 +355,7 @@ hipError_t gpu_nve_angular_step_one(Scalar4 *d_orientation,
 //! Takes the second half-step forward in the velocity-verlet NVE integration on a group of particles
 /*! \param d_vel array of particle velocities
     \param d_accel array of particle accelerations
+    \param d_pos array of particle positions
     \param d_group_members Device array listing the indices of the members of the group to integrate
     \param group_size Number of members in the group
     \param d_net_force Net force on each particle
@@ -343,6 +364,8 @@ hipError_t gpu_nve_angular_step_one(Scalar4 *d_orientation,
         a distance further than \a limit_val in one step.
     \param limit_val Length to limit particle distance movement to
     \param zero_force Set to true to always assign an acceleration of 0 to all particles in the group
+    \param projection Constraint to project the particle motion onto
+    \param fused When enabled, sum the net force of each particle instead of reading it
 
     This kernel is implemented in a very similar manner to gpu_nve_step_one_kernel(), see it for design details.
 */
@@ -350,6 +373,7 @@ extern "C" __global__
 void gpu_nve_step_two_kernel(
                             Scalar4 *d_vel,
                             Scalar3 *d_accel,
+                            const Scalar4 *d_pos,
                             unsigned int *d_group_members,
                             const unsigned int nwork,
                             const unsigned int offset,
@@ -357,7 +381,9 @@ void gpu_nve_step_two_kernel(
                             Scalar deltaT,
                             bool limit,
                             Scalar limit_val,
-                            bool zero_force)
+                            bool zero_force,
+                            const ConstraintProjection projection,
+                            const gpu_fused_net_force fused)
     {
     // determine which particle this thread works on (MEM TRANSFER: 4 bytes)
     int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -373,9 +399,15 @@ void gpu_nve_step_two_kernel(
         // read the current particle velocity (MEM TRANSFER: 16 bytes)
         Scalar4 vel = d_vel[idx];
 
+        // sum up the net force if it has not been summed yet, it is needed even when the force is zeroed
+        Scalar4 net_force;
+        if (fused.enabled)
+            net_force = gpu_fused_net_force_sum(fused, d_net_force, idx);
+
         if (!zero_force)
             {
-            Scalar4 net_force = d_net_force[idx];
+            if (!fused.enabled)
+                net_force = d_net_force[idx];
             accel = make_scalar3(net_force.x, net_force.y, net_force.z);
             // MEM TRANSFER: 4 bytes   FLOPS: 3
             Scalar mass = vel.w;
@@ -384,6 +416,18 @@ void gpu_nve_step_two_kernel(
             accel.z /= mass;
             }
 
+        // remove the acceleration normal to the constraint
+        Scalar3 pos = make_scalar3(Scalar(0.0), Scalar(0.0), Scalar(0.0));
+        if (projection.kind != ConstraintProjection::none)
+            {
+            if (projection.needsPosition())
+                {
+                const Scalar4 postype = d_pos[idx];
+                pos = make_scalar3(postype.x, postype.y, postype.z);
+                }
+            accel = projection.projectVector(pos, accel);
+            }
+
         // v(t+deltaT) = v(t+deltaT/2) + 1/2 * a(t+deltaT)*deltaT
 
         // update the velocity (FLOPS: 6)
@@ -391,6 +435,14 @@ void gpu_nve_step_two_kernel(
         vel.y += (Scalar(1.0)/Scalar(2.0)) * accel.y * deltaT;
         vel.z += (Scalar(1.0)/Scalar(2.0)) * accel.z * deltaT;
 
+        if (projection.kind != ConstraintProjection::none)
+            {
+            const Scalar3 v = projection.projectVector(pos, make_scalar3(vel.x, vel.y, vel.z));
+            vel.x = v.x;
+            vel.y = v.y;
+            vel.z = v.z;
+            }
+
         if (limit)
             {
             Scalar vel_len = sqrtf(vel.x*vel.x + vel.y*vel.y + vel.z*vel.z);
@@ -411,6 +463,7 @@ void gpu_nve_step_two_kernel(
 
 /*! \param d_vel array of particle velocities
     \param d_accel array of particle accelerations
+    \param d_pos array of particle positions
     \param d_group_members Device array listing the indices of the members of the group to integrate
     \param group_size Number of members in the group
     \param d_net_force Net force on each particle
@@ -419,11 +472,15 @@ void gpu_nve_step_two_kernel(
         a distance further than \a limit_val in one step.
     \param limit_val Length to limit particle distance movement to
     \param zero_force Set to true to always assign an acceleration of 0 to all particles in the group
+    \param projection Constraint to project the particle motion onto
 
     This is just a driver for gpu_nve_step_two_kernel(), see it for details.
+    \param stream Stream to launch the kernel in
+    \param fused Net force sum to perform in the kernel
 */
 hipError_t gpu_nve_step_two(Scalar4 *d_vel,
                              Scalar3 *d_accel,
+                             const Scalar4 *d_pos,
                              unsigned int *d_group_members,
                              const GPUPartition& gpu_partition,
                              Scalar4 *d_net_force,
@@ -431,7 +488,10 @@ hipError_t gpu_nve_step_two(Scalar4 *d_vel,
                              bool limit,
                              Scalar limit_val,
                              bool zero_force,
-                             unsigned int block_size)
+                             const ConstraintProjection& projection,
+                             unsigned int block_size,
+                             hipStream_t stream,
+                             const gpu_fused_net_force& fused)
     {
     static unsigned int max_block_size = UINT_MAX;
     if (max_block_size == UINT_MAX)
@@ -455,8 +515,9 @@ hipError_t gpu_nve_step_two(Scalar4 *d_vel,
         dim3 threads(run_block_size, 1, 1);
 
         // run the kernel
-        hipLaunchKernelGGL((gpu_nve_step_two_kernel), dim3(grid), dim3(threads ), 0, 0, d_vel,
+        hipLaunchKernelGGL((gpu_nve_step_two_kernel), dim3(grid), dim3(threads ), 0, stream, d_vel,
                                                      d_accel,
+                                                     d_pos,
                                                      d_group_members,
                                                      nwork,
                                                      range.first,
@@ -464,7 +525,9 @@ hipError_t gpu_nve_step_two(Scalar4 *d_vel,
                                                      deltaT,
                                                      limit,
                                                      limit_val,
-                                                     zero_force);
+                                                     zero_force,
+                                                     projection,
+                                                     fused);
         }
     return hipSuccess;
     }
@@ -531,6 +594,7 @@ __global__ void gpu_nve_angular_step_two_kernel(const Scalar4 *d_orientation,
     \param d_group_members Device array listing the indices of the members of the group to integrate
     \param group_size Number of members in the group
     \param deltaT timestep
+    \param stream Stream to launch the kernel in
 */
 hipError_t gpu_nve_angular_step_two(const Scalar4 *d_orientation,
                              Scalar4 *d_angmom,
@@ -540,7 +604,8 @@ hipError_t gpu_nve_angular_step_two(const Scalar4 *d_orientation,
                              const GPUPartition& gpu_partition,
                              Scalar deltaT,
                              Scalar scale,
-                             const unsigned int block_size)
+                             const unsigned int block_size,
+                             hipStream_t stream)
     {
     static unsigned int max_block_size = UINT_MAX;
     if (max_block_size == UINT_MAX)
@@ -564,7 +629,7 @@ hipError_t gpu_nve_angular_step_two(const Scalar4 *d_orientation,
         dim3 threads(run_block_size, 1, 1);
 
         // run the kernel
-        hipLaunchKernelGGL((gpu_nve_angular_step_two_kernel), dim3(grid), dim3(threads ), 0, 0, d_orientation, d_angmom, d_inertia, d_net_torque, d_group_members, nwork, range.first, deltaT, scale);
+        hipLaunchKernelGGL((gpu_nve_angular_step_two_kernel), dim3(grid), dim3(threads ), 0, stream, d_orientation, d_angmom, d_inertia, d_net_torque, d_group_members, nwork, range.first, deltaT, scale);
         }
 
     return hipSuccess;
@@ -11,6 +11,8 @@
 #include "hoomd/ParticleData.cuh"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/GPUPartition.cuh"
+#include "hoomd/Integrator.cuh"
+#include "ConstraintProjection.h"
 
 #ifndef __TWO_STEP_NVE_GPU_CUH__
 #define __TWO_STEP_NVE_GPU_CUH__
@@ -27,11 +29,14 @@ hipError_t gpu_nve_step_one(Scalar4 *d_pos,
                              bool limit,
                              Scalar limit_val,
                              bool zero_force,
-                             unsigned int block_size);
+                             const ConstraintProjection& projection,
+                             unsigned int block_size,
+                             hipStream_t stream = 0);
 
 //! Kernel driver for the second part of the NVE update called by TwoStepNVEGPU
 hipError_t gpu_nve_step_two(Scalar4 *d_vel,
                              Scalar3 *d_accel,
+                             const Scalar4 *d_pos,
                              unsigned int *d_group_members,
                              const GPUPartition& gpu_partition,
                              Scalar4 *d_net_force,
@@ -39,7 +44,10 @@ hipError_t gpu_nve_step_two(Scalar4 *d_vel,
                              bool limit,
                              Scalar limit_val,
                              bool zero_force,
-                             unsigned int block_size);
+                             const ConstraintProjection& projection,
+                             unsigned int block_size,
+                             hipStream_t stream = 0,
+                             const gpu_fused_net_force& fused = gpu_fused_net_force());
 
 //! Kernel driver for the first part of the angular NVE update (NO_SQUISH) by TwoStepNVEPU
 hipError_t gpu_nve_angular_step_one(Scalar4 *d_orientation,
@@ -50,7 +58,8 @@ hipError_t gpu_nve_angular_step_one(Scalar4 *d_orientation,
                              const GPUPartition& gpu_partition,
                              Scalar deltaT,
                              Scalar scale,
-                             const unsigned int block_size);
+                             const unsigned int block_size,
+                             hipStream_t stream = 0);
 
 //! Kernel driver for the second part of the angular NVE update (NO_SQUISH) by TwoStepNVEPU
 hipError_t gpu_nve_angular_step_two(const Scalar4 *d_orientation,
@@ -61,6 +70,7 @@ hipError_t gpu_nve_angular_step_two(const Scalar4 *d_orientation,
                              const GPUPartition &gpu_partition,
                              Scalar deltaT,
                              Scalar scale,
-                             const unsigned int block_size);
+                             const unsigned int block_size,
+                             hipStream_t stream = 0);
 
 #endif //__TWO_STEP_NVE_GPU_CUH__
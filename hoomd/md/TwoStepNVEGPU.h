@@ -20,6 +20,7 @@
 #include <pybind11/pybind11.h>
 
 #include "hoomd/Autotuner.h"
+#include "hoomd/GPUGraph.h"
 
 //! Integrates part of the system forward in two steps in the NVE ensemble on the GPU
 /*! Implements velocity-verlet NVE integration through the IntegrationMethodTwoStep interface, runs on the GPU
@@ -56,6 +57,38 @@ class PYBIND11_EXPORT TwoStepNVEGPU : public TwoStepNVE
             m_tuner_angular_two->setEnabled(enable);
             }
 
+        //! Test if the integration steps can be captured into a GPU graph
+        /*! The autotuners must finish their initial scan first, captured steps do not call the autotuners.
+        */
+        virtual bool isGraphCapturable()
+            {
+            return m_tuner_one->isComplete() && m_tuner_two->isComplete()
+                   && (!m_aniso || (m_tuner_angular_one->isComplete() && m_tuner_angular_two->isComplete()));
+            }
+
+        //! Test if the net force can be summed in the second step kernel
+        virtual bool canFuseNetForce()
+            {
+            return true;
+            }
+
+        //! Append the parameters of the captured kernels to the GPU graph key
+        virtual void appendGraphKey(std::vector<char>& key)
+            {
+            GPUGraph::appendToKey(key, m_deltaT);
+            GPUGraph::appendToKey(key, m_limit);
+            GPUGraph::appendToKey(key, m_limit_val);
+            GPUGraph::appendToKey(key, m_zero_force);
+            GPUGraph::appendToKey(key, m_projection.kind);
+            GPUGraph::appendToKey(key, m_projection.P);
+            GPUGraph::appendToKey(key, m_projection.v);
+            GPUGraph::appendToKey(key, m_aniso);
+            GPUGraph::appendToKey(key, m_tuner_one->getParam());
+            GPUGraph::appendToKey(key, m_tuner_two->getParam());
+            GPUGraph::appendToKey(key, m_tuner_angular_one->getParam());
+            GPUGraph::appendToKey(key, m_tuner_angular_two->getParam());
+            }
+
     private:
         std::unique_ptr<Autotuner> m_tuner_one; //!< Autotuner for block size (step one kernel)
         std::unique_ptr<Autotuner> m_tuner_two; //!< Autotuner for block size (step two kernel)
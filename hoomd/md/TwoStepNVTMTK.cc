@@ -78,6 +78,7 @@ Scalar TwoStepNVTMTK::getLogValue(const std::string& quantity, unsigned int time
     if (quantity == m_log_name)
         {
         my_quantity_flag = true;
+        syncThermostatVariables();
         Scalar g = m_group->getTranslationalDOF();
         IntegratorVariables v = getIntegratorVariables();
         Scalar& xi = v.variable[0];
@@ -444,6 +445,7 @@ void TwoStepNVTMTK::thermalizeThermostatDOF(unsigned int seed, unsigned int time
     {
     m_exec_conf->msg->notice(6) << "TwoStepNVTMTK randomizing thermostat DOF" << std::endl;
 
+    syncThermostatVariables();
     IntegratorVariables v = getIntegratorVariables();
     Scalar& xi = v.variable[0];
 
@@ -488,10 +490,12 @@ void TwoStepNVTMTK::thermalizeThermostatDOF(unsigned int seed, unsigned int time
         }
 
     setIntegratorVariables(v);
+    thermostatVariablesChanged();
     }
 
 pybind11::tuple TwoStepNVTMTK::getTranslationalThermostatDOF()
     {
+    syncThermostatVariables();
     pybind11::list result;
     IntegratorVariables v = getIntegratorVariables();
 
@@ -511,6 +515,7 @@ void TwoStepNVTMTK::setTranslationalThermostatDOF(pybind11::tuple v)
         throw std::length_error("translational_thermostat_dof must have length 2");
         }
 
+    syncThermostatVariables();
     IntegratorVariables vars = getIntegratorVariables();
 
     Scalar& xi = vars.variable[0];
@@ -520,10 +525,12 @@ void TwoStepNVTMTK::setTranslationalThermostatDOF(pybind11::tuple v)
     eta = pybind11::cast<Scalar>(v[1]);
 
     setIntegratorVariables(vars);
+    thermostatVariablesChanged();
     }
 
 pybind11::tuple TwoStepNVTMTK::getRotationalThermostatDOF()
     {
+    syncThermostatVariables();
     pybind11::list result;
     IntegratorVariables v = getIntegratorVariables();
 
@@ -543,6 +550,7 @@ void TwoStepNVTMTK::setRotationalThermostatDOF(pybind11::tuple v)
         throw std::length_error("rotational_thermostat_dof must have length 2");
         }
 
+    syncThermostatVariables();
     IntegratorVariables vars = getIntegratorVariables();
 
     Scalar& xi_rot = vars.variable[2];
@@ -552,6 +560,7 @@ void TwoStepNVTMTK::setRotationalThermostatDOF(pybind11::tuple v)
     eta_rot = pybind11::cast<Scalar>(v[1]);
 
     setIntegratorVariables(vars);
+    thermostatVariablesChanged();
     }
 
 void export_TwoStepNVTMTK(py::module& m)
@@ -79,10 +79,12 @@ class PYBIND11_EXPORT TwoStepNVTMTK : public IntegrationMethodTwoStep
         //! Set the value of xi (for unit tests)
         void setXi(Scalar new_xi)
             {
+            syncThermostatVariables();
             IntegratorVariables v = getIntegratorVariables();
             Scalar& xi = v.variable[0];
             xi = new_xi;
             setIntegratorVariables(v);
+            thermostatVariablesChanged();
             }
 
         //! Returns a list of log quantities this integrator calculates
@@ -119,6 +121,7 @@ class PYBIND11_EXPORT TwoStepNVTMTK : public IntegrationMethodTwoStep
             v.variable[2] = Scalar(0.0);
             v.variable[3] = Scalar(0.0);
             setIntegratorVariables(v);
+            thermostatVariablesChanged();
             }
 
         /// Randomize the thermostat variables
@@ -150,6 +153,15 @@ class PYBIND11_EXPORT TwoStepNVTMTK : public IntegrationMethodTwoStep
          * \param broadcast True if we should broadcast the integrator variables via MPI
          */
         void advanceThermostat(unsigned int timestep, bool broadcast=true);
+
+        //! Bring the integrator variables on the host up to date
+        /*! Derived classes that advance the thermostat in device memory copy it to the integrator variables here.
+            Everything that reads the integrator variables outside of the integration steps calls this first.
+        */
+        virtual void syncThermostatVariables() {}
+
+        //! Notify derived classes that the integrator variables have been set on the host
+        virtual void thermostatVariablesChanged() {}
     };
 
 //! Exports the TwoStepNVTMTK class to python
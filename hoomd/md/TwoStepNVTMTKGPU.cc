@@ -36,7 +36,8 @@ TwoStepNVTMTKGPU::TwoStepNVTMTKGPU(std::shared_ptr<SystemDefinition> sysdef,
                              Scalar tau,
                              std::shared_ptr<Variant> T,
                              const std::string& suffix)
-    : TwoStepNVTMTK(sysdef, group, thermo, tau, T, suffix)
+    : TwoStepNVTMTK(sysdef, group, thermo, tau, T, suffix), m_host_thermostat_valid(true),
+      m_device_thermostat_valid(false)
     {
     // only one GPU is supported
     if (!m_exec_conf->isCUDAEnabled())
@@ -55,6 +56,41 @@ TwoStepNVTMTKGPU::TwoStepNVTMTKGPU(std::shared_ptr<SystemDefinition> sysdef,
     m_tuner_two.reset(new Autotuner(valid_params, 5, 100000, "nvt_mtk_step_two", this->m_exec_conf));
     m_tuner_angular_one.reset(new Autotuner(valid_params, 5, 100000, "nvt_mtk_angular_one", this->m_exec_conf));
     m_tuner_angular_two.reset(new Autotuner(valid_params, 5, 100000, "nvt_mtk_angular_two", this->m_exec_conf));
+
+    GlobalArray<Scalar> thermostat(nvt_mtk_thermostat_index::num_quantities, m_exec_conf);
+    m_thermostat.swap(thermostat);
+    TAG_ALLOCATION(m_thermostat);
+    }
+
+/*! The rotational thermostat and the reduction of the kinetic energy across ranks are done on the host.
+*/
+bool TwoStepNVTMTKGPU::useDeviceThermostat()
+    {
+    if (m_aniso)
+        return false;
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        return false;
+    #endif
+
+    return true;
+    }
+
+void TwoStepNVTMTKGPU::syncThermostatVariables()
+    {
+    if (m_host_thermostat_valid)
+        return;
+
+    ArrayHandle<Scalar> h_thermostat(m_thermostat, access_location::host, access_mode::read);
+
+    IntegratorVariables v = getIntegratorVariables();
+    v.variable[0] = h_thermostat.data[nvt_mtk_thermostat_index::xi];
+    v.variable[1] = h_thermostat.data[nvt_mtk_thermostat_index::eta];
+    setIntegratorVariables(v);
+
+    m_exp_thermo_fac = h_thermostat.data[nvt_mtk_thermostat_index::exp_thermo_fac];
+    m_host_thermostat_valid = true;
     }
 
 /*! \param timestep Current time step
@@ -76,6 +112,22 @@ void TwoStepNVTMTKGPU::integrateStepOne(unsigned int timestep)
         m_prof->push(m_exec_conf, "NVT MTK step 1");
         }
 
+    bool device_thermostat = useDeviceThermostat();
+    if (device_thermostat && !m_device_thermostat_valid)
+        {
+        // the integrator variables have been set on the host
+        IntegratorVariables v = getIntegratorVariables();
+        ArrayHandle<Scalar> h_thermostat(m_thermostat, access_location::host, access_mode::overwrite);
+        h_thermostat.data[nvt_mtk_thermostat_index::xi] = v.variable[0];
+        h_thermostat.data[nvt_mtk_thermostat_index::eta] = v.variable[1];
+        h_thermostat.data[nvt_mtk_thermostat_index::exp_thermo_fac] = m_exp_thermo_fac;
+        m_device_thermostat_valid = true;
+        }
+    else if (!device_thermostat)
+        {
+        syncThermostatVariables();
+        }
+
         {
         // access all the needed data
         ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::readwrite);
@@ -85,6 +137,7 @@ void TwoStepNVTMTKGPU::integrateStepOne(unsigned int timestep)
 
         BoxDim box = m_pdata->getBox();
         ArrayHandle< unsigned int > d_index_array(m_group->getIndexArray(), access_location::device, access_mode::read);
+        ArrayHandle<Scalar> d_thermostat(m_thermostat, access_location::device, access_mode::read);
 
         m_exec_conf->beginMultiGPU();
 
@@ -100,7 +153,8 @@ void TwoStepNVTMTKGPU::integrateStepOne(unsigned int timestep)
                          m_tuner_one->getParam(),
                          m_exp_thermo_fac,
                          m_deltaT,
-                         m_group->getGPUPartition());
+                         m_group->getGPUPartition(),
+                         device_thermostat ? d_thermostat.data : NULL);
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
@@ -141,7 +195,31 @@ void TwoStepNVTMTKGPU::integrateStepOne(unsigned int timestep)
         }
 
     // advance thermostat
-    advanceThermostat(timestep, false);
+    if (device_thermostat)
+        {
+        // the host reads the thermostat variables only when they are needed, see syncThermostatVariables()
+        m_thermo->compute(timestep+1);
+
+        ArrayHandle<Scalar> d_properties(m_thermo->getProperties(), access_location::device, access_mode::read);
+        ArrayHandle<Scalar> d_thermostat(m_thermostat, access_location::device, access_mode::readwrite);
+
+        gpu_nvt_mtk_advance_thermostat(d_thermostat.data,
+                                       d_properties.data,
+                                       m_group->getTranslationalDOF(),
+                                       (*m_T)(timestep),
+                                       m_tau,
+                                       m_deltaT);
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+
+        m_host_thermostat_valid = false;
+        }
+    else
+        {
+        advanceThermostat(timestep, false);
+        m_device_thermostat_valid = false;
+        }
 
     // done profiling
     if (m_prof)
@@ -167,6 +245,7 @@ void TwoStepNVTMTKGPU::integrateStepTwo(unsigned int timestep)
         ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(), access_location::device, access_mode::readwrite);
         ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(), access_location::device, access_mode::readwrite);
         ArrayHandle<Scalar4> d_net_force(net_force, access_location::device, access_mode::read);
+        ArrayHandle<Scalar> d_thermostat(m_thermostat, access_location::device, access_mode::read);
 
         m_exec_conf->beginMultiGPU();
 
@@ -180,7 +259,8 @@ void TwoStepNVTMTKGPU::integrateStepTwo(unsigned int timestep)
                          m_tuner_two->getParam(),
                          m_deltaT,
                          m_exp_thermo_fac,
-                         m_group->getGPUPartition());
+                         m_group->getGPUPartition(),
+                         useDeviceThermostat() ? d_thermostat.data : NULL);
 
         if(m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
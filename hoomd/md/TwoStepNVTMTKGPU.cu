@@ -6,6 +6,7 @@
 // Maintainer: jglaser
 
 #include "TwoStepNVTMTKGPU.cuh"
+#include "ComputeThermoTypes.h"
 
 #include <assert.h>
 
@@ -24,6 +25,7 @@
     \param exp_fac Velocity rescaling factor from thermostat
     \param deltaT Amount of real time to step forward in one time step
     \param offset The offset of this GPU into the list of particles
+    \param d_thermostat Thermostat variables in device memory, read the rescaling factor from here when not NULL
 
     Take the first half step forward in the NVT integration.
 
@@ -39,7 +41,8 @@ void gpu_nvt_mtk_step_one_kernel(Scalar4 *d_pos,
                              BoxDim box,
                              Scalar exp_fac,
                              Scalar deltaT,
-                             unsigned int offset)
+                             unsigned int offset,
+                             const Scalar *d_thermostat)
     {
     // determine which particle this thread works on
     int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -48,6 +51,9 @@ void gpu_nvt_mtk_step_one_kernel(Scalar4 *d_pos,
         {
         unsigned int idx = d_group_members[group_idx + offset];
 
+        if (d_thermostat)
+            exp_fac = d_thermostat[nvt_mtk_thermostat_index::exp_thermo_fac];
+
         // update positions to the next timestep and update velocities to the next half step
         Scalar4 postype = d_pos[idx];
         Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
@@ -87,6 +93,8 @@ void gpu_nvt_mtk_step_one_kernel(Scalar4 *d_pos,
     \param block_size Size of the block to run
     \param exp_fac Thermostat rescaling factor
     \param deltaT Amount of real time to step forward in one time step
+    \param gpu_partition Load balancing info for multi-GPU execution
+    \param d_thermostat Thermostat variables in device memory, overrides \a exp_fac when not NULL
 */
 hipError_t gpu_nvt_mtk_step_one(Scalar4 *d_pos,
                              Scalar4 *d_vel,
@@ -98,7 +106,8 @@ hipError_t gpu_nvt_mtk_step_one(Scalar4 *d_pos,
                              unsigned int block_size,
                              Scalar exp_fac,
                              Scalar deltaT,
-                             const GPUPartition& gpu_partition)
+                             const GPUPartition& gpu_partition,
+                             const Scalar *d_thermostat)
     {
     static unsigned int max_block_size = UINT_MAX;
     if (max_block_size == UINT_MAX)
@@ -131,7 +140,8 @@ hipError_t gpu_nvt_mtk_step_one(Scalar4 *d_pos,
                              box,
                              exp_fac,
                              deltaT,
-                             range.first);
+                             range.first,
+                             d_thermostat);
         }
 
     return hipSuccess;
@@ -144,7 +154,9 @@ hipError_t gpu_nvt_mtk_step_one(Scalar4 *d_pos,
     \param work_size Number of members in the group for this GPU
     \param d_net_force Net force on each particle
     \param deltaT Amount of real time to step forward in one time step
+    \param exp_v_fac_thermo Exponential velocity scaling factor
     \param offset The offset of this GPU into the list of particles
+    \param d_thermostat Thermostat variables in device memory, read the scaling factor from here when not NULL
 */
 extern "C" __global__
 void gpu_nvt_mtk_step_two_kernel(Scalar4 *d_vel,
@@ -154,7 +166,8 @@ void gpu_nvt_mtk_step_two_kernel(Scalar4 *d_vel,
                              Scalar4 *d_net_force,
                              Scalar deltaT,
                              Scalar exp_v_fac_thermo,
-                             unsigned int offset)
+                             unsigned int offset,
+                             const Scalar *d_thermostat)
     {
     // determine which particle this thread works on
     int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -163,6 +176,9 @@ void gpu_nvt_mtk_step_two_kernel(Scalar4 *d_vel,
         {
         unsigned int idx = d_group_members[group_idx+offset];
 
+        if (d_thermostat)
+            exp_v_fac_thermo = d_thermostat[nvt_mtk_thermostat_index::exp_thermo_fac];
+
         // read in the net force and calculate the acceleration
         Scalar4 net_force = d_net_force[idx];
         Scalar3 accel = make_scalar3(net_force.x,net_force.y,net_force.z);
@@ -195,6 +211,8 @@ void gpu_nvt_mtk_step_two_kernel(Scalar4 *d_vel,
     \param block_size Size of the block to execute on the device
     \param deltaT Amount of real time to step forward in one time step
     \param exp_v_fac_thermo Exponential velocity scaling factor
+    \param gpu_partition Load balancing info for multi-GPU execution
+    \param d_thermostat Thermostat variables in device memory, overrides \a exp_v_fac_thermo when not NULL
 */
 hipError_t gpu_nvt_mtk_step_two(Scalar4 *d_vel,
                              Scalar3 *d_accel,
@@ -204,7 +222,8 @@ hipError_t gpu_nvt_mtk_step_two(Scalar4 *d_vel,
                              unsigned int block_size,
                              Scalar deltaT,
                              Scalar exp_v_fac_thermo,
-                             const GPUPartition& gpu_partition)
+                             const GPUPartition& gpu_partition,
+                             const Scalar *d_thermostat)
     {
     static unsigned int max_block_size = UINT_MAX;
     if (max_block_size == UINT_MAX)
@@ -228,10 +247,71 @@ hipError_t gpu_nvt_mtk_step_two(Scalar4 *d_vel,
         dim3 threads(run_block_size, 1, 1);
 
         // run the kernel
-        hipLaunchKernelGGL((gpu_nvt_mtk_step_two_kernel), dim3(grid), dim3(threads ), 0, 0, d_vel, d_accel, d_group_members, nwork, d_net_force, deltaT, exp_v_fac_thermo, range.first);
+        hipLaunchKernelGGL((gpu_nvt_mtk_step_two_kernel), dim3(grid), dim3(threads ), 0, 0, d_vel, d_accel, d_group_members, nwork, d_net_force, deltaT, exp_v_fac_thermo, range.first, d_thermostat);
         }
 
     return hipSuccess;
     }
 
+//! Advances the translational thermostat variables by one time step
+/*! \param d_thermostat Thermostat variables, indexed by nvt_mtk_thermostat_index
+    \param d_properties Thermodynamic properties computed by ComputeThermoGPU
+    \param ndof Number of translational degrees of freedom
+    \param T Temperature set point
+    \param tau Thermostat time constant
+    \param deltaT Amount of real time to step forward in one time step
+
+    This is the same update as TwoStepNVTMTK::advanceThermostat(), run by a single thread so that the kinetic energy
+    does not have to be copied to the host.
+*/
+__global__ void gpu_nvt_mtk_advance_thermostat_kernel(Scalar *d_thermostat,
+                                                      const Scalar *d_properties,
+                                                      Scalar ndof,
+                                                      Scalar T,
+                                                      Scalar tau,
+                                                      Scalar deltaT)
+    {
+    if (blockIdx.x * blockDim.x + threadIdx.x != 0)
+        return;
+
+    Scalar xi = d_thermostat[nvt_mtk_thermostat_index::xi];
+    Scalar eta = d_thermostat[nvt_mtk_thermostat_index::eta];
+
+    Scalar curr_T_trans = Scalar(2.0)/ndof*d_properties[thermo_index::translational_kinetic_energy];
+
+    // update the state variables Xi and eta
+    Scalar xi_prime = xi + Scalar(1.0/2.0)*deltaT/tau/tau*(curr_T_trans/T - Scalar(1.0));
+    xi = xi_prime + Scalar(1.0/2.0)*deltaT/tau/tau*(curr_T_trans/T - Scalar(1.0));
+    eta += xi_prime*deltaT;
+
+    d_thermostat[nvt_mtk_thermostat_index::xi] = xi;
+    d_thermostat[nvt_mtk_thermostat_index::eta] = eta;
+    d_thermostat[nvt_mtk_thermostat_index::exp_thermo_fac] = exp(-Scalar(1.0/2.0)*xi*deltaT);
+    }
+
+/*! \param d_thermostat Thermostat variables, indexed by nvt_mtk_thermostat_index
+    \param d_properties Thermodynamic properties computed by ComputeThermoGPU
+    \param ndof Number of translational degrees of freedom
+    \param T Temperature set point
+    \param tau Thermostat time constant
+    \param deltaT Amount of real time to step forward in one time step
+*/
+hipError_t gpu_nvt_mtk_advance_thermostat(Scalar *d_thermostat,
+                                          const Scalar *d_properties,
+                                          Scalar ndof,
+                                          Scalar T,
+                                          Scalar tau,
+                                          Scalar deltaT)
+    {
+    hipLaunchKernelGGL((gpu_nvt_mtk_advance_thermostat_kernel), dim3(1), dim3(1), 0, 0,
+                       d_thermostat,
+                       d_properties,
+                       ndof,
+                       T,
+                       tau,
+                       deltaT);
+
+    return hipSuccess;
+    }
+
 // vim:syntax=cpp
@@ -15,6 +15,19 @@
 #ifndef __TWO_STEP_NVT_MTK_GPU_CUH__
 #define __TWO_STEP_NVT_MTK_GPU_CUH__
 
+//! Enum for indexing the thermostat variables kept in device memory by TwoStepNVTMTKGPU
+struct nvt_mtk_thermostat_index
+    {
+    //! The enum
+    enum Enum
+        {
+        xi=0,               //!< Translational thermostat velocity
+        eta,                //!< Translational thermostat position
+        exp_thermo_fac,     //!< Velocity rescaling factor exp(-xi*deltaT/2)
+        num_quantities      // final element to count number of quantities
+        };
+    };
+
 //! Kernel driver for the first part of the NVT update called by TwoStepNVTGPU
 hipError_t gpu_nvt_mtk_step_one(Scalar4 *d_pos,
                              Scalar4 *d_vel,
@@ -26,7 +39,8 @@ hipError_t gpu_nvt_mtk_step_one(Scalar4 *d_pos,
                              unsigned int block_size,
                              Scalar exp_fac,
                              Scalar deltaT,
-                             const GPUPartition& gpu_partition
+                             const GPUPartition& gpu_partition,
+                             const Scalar *d_thermostat = NULL
                              );
 
 //! Kernel driver for the second part of the NVT update called by NVTUpdaterGPU
@@ -38,6 +52,15 @@ hipError_t gpu_nvt_mtk_step_two(Scalar4 *d_vel,
                              unsigned int block_size,
                              Scalar deltaT,
                              Scalar exp_v_fac_thermo,
-                             const GPUPartition& gpu_partition);
+                             const GPUPartition& gpu_partition,
+                             const Scalar *d_thermostat = NULL);
+
+//! Kernel driver to advance the thermostat variables in device memory called by TwoStepNVTMTKGPU
+hipError_t gpu_nvt_mtk_advance_thermostat(Scalar *d_thermostat,
+                                          const Scalar *d_properties,
+                                          Scalar ndof,
+                                          Scalar T,
+                                          Scalar tau,
+                                          Scalar deltaT);
 
 #endif //__TWO_STEP_NVT_MTK_GPU_CUH__
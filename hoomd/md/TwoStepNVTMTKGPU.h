@@ -28,6 +28,11 @@
     pass reduction on the sum of m*v^2 and stores the partial reductions. A second kernel is then launched to reduce
     those to a final \a sum2K, which is a scalar but stored in a GPUArray for convenience.
 
+    Without rotational degrees of freedom and without a domain decomposition, the thermostat variables are advanced
+    in device memory from the kinetic energy that ComputeThermoGPU leaves there, and the step kernels read the
+    rescaling factor from device memory. The integrator variables on the host are only updated when something reads
+    them, such as a logger or the thermostat_dof properties, so the steps do not wait for the device.
+
     \ingroup updaters
 */
 class PYBIND11_EXPORT TwoStepNVTMTKGPU : public TwoStepNVTMTK
@@ -66,10 +71,26 @@ class PYBIND11_EXPORT TwoStepNVTMTKGPU : public TwoStepNVTMTK
             }
 
     protected:
+        GlobalArray<Scalar> m_thermostat;   //!< Thermostat variables in device memory, see nvt_mtk_thermostat_index
+        bool m_host_thermostat_valid;       //!< True when the integrator variables match m_thermostat
+        bool m_device_thermostat_valid;     //!< True when m_thermostat matches the integrator variables
+
         std::unique_ptr<Autotuner> m_tuner_one; //!< Autotuner for block size (step one kernel)
         std::unique_ptr<Autotuner> m_tuner_two; //!< Autotuner for block size (step two kernel)
         std::unique_ptr<Autotuner> m_tuner_angular_one; //!< Autotuner_angular for block size (angular step one kernel)
         std::unique_ptr<Autotuner> m_tuner_angular_two; //!< Autotuner_angular for block size (angular step two kernel)
+
+        //! Test if the thermostat can be advanced in device memory
+        bool useDeviceThermostat();
+
+        //! Copy the thermostat variables from device memory to the integrator variables
+        virtual void syncThermostatVariables();
+
+        //! Mark the thermostat variables in device memory out of date
+        virtual void thermostatVariablesChanged()
+            {
+            m_device_thermostat_valid = false;
+            }
     };
 
 //! Exports the TwoStepNVTMTKGPU class to python
@@ -14,4 +14,5 @@ hipError_t gpu_compute_yukawa_forces(const pair_args_t& pair_args,
                                                         d_params);
     }
 
-
+template hipError_t gpu_compute_pair_set_energy<EvaluatorPairYukawa>(const pair_set_energy_args_t& args,
+                                                                     const EvaluatorPairYukawa::param_type *d_params);
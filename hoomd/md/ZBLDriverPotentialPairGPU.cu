@@ -14,3 +14,5 @@ hipError_t gpu_compute_zbl_forces(const pair_args_t& pair_args,
                                                      d_params);
     }
 
+template hipError_t gpu_compute_pair_set_energy<EvaluatorPairZBL>(const pair_set_energy_args_t& args,
+                                                                  const EvaluatorPairZBL::param_type *d_params);
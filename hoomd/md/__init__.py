@@ -22,4 +22,5 @@ from hoomd.md import pair
 from hoomd.md import update
 from hoomd.md import wall
 from hoomd.md import special_pair
+from hoomd.md import tune
 from hoomd.md import methods
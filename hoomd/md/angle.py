@@ -133,6 +133,7 @@ class table(force._force):
 
         width (int): Number of points to use to interpolate V and F (see documentation above)
         name (str): Name of the force instance
+        interpolation (str): ``'linear'`` or ``'cubic'`` interpolation between grid points
 
     :py:class:`table` specifies that a tabulated angle potential should be added to every bonded triple of particles
     in the simulation.
@@ -147,7 +148,8 @@ class table(force._force):
     where :math:`\theta` is the angle from A-B to B-C in the triple.
 
     :math:`T_{\mathrm{user}}(\theta)` and :math:`V_{\mathrm{user}}(\theta)` are evaluated on *width* grid points
-    between :math:`0` and :math:`\pi`. Values are interpolated linearly between grid points.
+    between :math:`0` and :math:`\pi`. Values are interpolated linearly between grid points,
+    or with cubic Hermite polynomials when *interpolation* is ``'cubic'``.
     For correctness, you must specify: :math:`T = -\frac{\partial V}{\partial \theta}`
 
     Parameters:
@@ -183,7 +185,10 @@ class table(force._force):
         btable.set_from_file('polymer', 'angle.dat')
 
     """
-    def __init__(self, width, name=None):
+    def __init__(self, width, name=None, interpolation='linear'):
+
+        if interpolation not in ('linear', 'cubic'):
+            raise ValueError("interpolation must be 'linear' or 'cubic'")
 
         # initialize the base class
         force._force.__init__(self, name);
@@ -195,6 +200,8 @@ class table(force._force):
         else:
             self.cpp_force = _md.TableAngleForceComputeGPU(hoomd.context.current.system_definition, int(width), self.name);
 
+        self.cpp_force.cubic = interpolation == 'cubic'
+
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
 
         # setup the coefficient matrix
@@ -0,0 +1,89 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file bench_neighborlist.cc
+    \brief Times full builds of the neighbor lists
+
+    Each workload builds the neighbor list of `n` particles placed uniformly at random in a cubic box at a number
+    density of 0.8, with r_cut = 3.0 and r_buff = 0.4. Set `gpu=1` to time the GPU neighbor lists.
+*/
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/md/NeighborListBinned.h"
+#include "hoomd/md/NeighborListTree.h"
+#ifdef ENABLE_HIP
+#include "hoomd/md/NeighborListGPUBinned.h"
+#include "hoomd/md/NeighborListGPUTree.h"
+#endif
+
+#include "hoomd/test/benchmark_config.h"
+
+#include <memory>
+#include <random>
+
+using namespace hoomd::benchmark;
+
+//! Build one neighbor list repeatedly
+template<class NL>
+void bench_nlist(Runner& runner, const std::string& name, std::shared_ptr<SystemDefinition> sysdef)
+    {
+    auto exec_conf = sysdef->getParticleData()->getExecConf();
+    std::shared_ptr<NeighborList> nlist(new NL(sysdef, 3.0, 0.4));
+    auto r_cut = std::make_shared<GlobalArray<Scalar>>(nlist->getTypePairIndexer().getNumElements(), exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut(*r_cut, access_location::host, access_mode::overwrite);
+        h_r_cut.data[0] = 3.0;
+        }
+    nlist->addRCutMatrix(r_cut);
+
+    unsigned int N = sysdef->getParticleData()->getN();
+    unsigned int timestep = 0;
+    runner.run(name, {{"n", N}}, N, [&]()
+        {
+        nlist->forceUpdate();
+        nlist->compute(timestep++);
+        #ifdef ENABLE_HIP
+        if (exec_conf->isCUDAEnabled())
+            hipDeviceSynchronize();
+        #endif
+        });
+    }
+
+void bench_neighborlist(Runner& runner)
+    {
+    unsigned int N = runner.getParam("n", 16000);
+    bool gpu = runner.getParam("gpu", 0);
+
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(
+        gpu ? ExecutionConfiguration::GPU : ExecutionConfiguration::CPU));
+
+    Scalar L = pow(Scalar(N) / Scalar(0.8), Scalar(1.0/3.0));
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N, BoxDim(L), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+        {
+        std::mt19937 engine(42);
+        std::uniform_real_distribution<Scalar> coordinate(-L/Scalar(2.0), L/Scalar(2.0));
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        for (unsigned int i = 0; i < N; ++i)
+            h_pos.data[i] = make_scalar4(coordinate(engine), coordinate(engine), coordinate(engine), 0);
+        pdata->notifyParticleSort();
+        }
+
+    if (!gpu)
+        {
+        bench_nlist<NeighborListBinned>(runner, "nlist_binned", sysdef);
+        bench_nlist<NeighborListTree>(runner, "nlist_tree", sysdef);
+        }
+    #ifdef ENABLE_HIP
+    else
+        {
+        bench_nlist<NeighborListGPUBinned>(runner, "nlist_gpu_binned", sysdef);
+        bench_nlist<NeighborListGPUTree>(runner, "nlist_gpu_tree", sysdef);
+        }
+    #endif
+    }
+
+HOOMD_BENCHMARK_MAIN(bench_neighborlist)
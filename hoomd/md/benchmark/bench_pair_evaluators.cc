@@ -0,0 +1,65 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file bench_pair_evaluators.cc
+    \brief Times the pair potential evaluators on the host
+
+    Each workload evaluates the force and energy of `pairs` random pair distances between 0.8 and the cutoff 3.0,
+    with the energy shift, as PotentialPair does for every pair in the neighbor list.
+*/
+
+#include "hoomd/test/benchmark_config.h"
+
+#include "hoomd/md/EvaluatorPairLJ.h"
+#include "hoomd/md/EvaluatorPairGauss.h"
+#include "hoomd/md/EvaluatorPairYukawa.h"
+#include "hoomd/md/EvaluatorPairMorse.h"
+
+#include <random>
+
+using namespace hoomd::benchmark;
+
+//! Evaluate one evaluator over a list of squared distances
+template<class Evaluator>
+void bench_evaluator(Runner& runner,
+                     const std::string& name,
+                     const typename Evaluator::param_type& params,
+                     const std::vector<Scalar>& rsq)
+    {
+    const Scalar rcutsq = Scalar(3.0*3.0);
+
+    runner.run(name, {{"pairs", (unsigned int)rsq.size()}}, rsq.size(), [&]()
+        {
+        Scalar sum = 0;
+        for (auto r : rsq)
+            {
+            Evaluator eval(r, rcutsq, params);
+            Scalar force_divr = 0;
+            Scalar pair_eng = 0;
+            eval.evalForceAndEnergy(force_divr, pair_eng, true);
+            sum += force_divr + pair_eng;
+            }
+        sink = sink + sum;
+        });
+    }
+
+void bench_pair_evaluators(Runner& runner)
+    {
+    unsigned int pairs = runner.getParam("pairs", 1 << 20);
+
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<Scalar> distance(Scalar(0.8), Scalar(3.0));
+    std::vector<Scalar> rsq(pairs);
+    for (auto& r : rsq)
+        {
+        Scalar d = distance(engine);
+        r = d*d;
+        }
+
+    bench_evaluator<EvaluatorPairLJ>(runner, "pair_lj", EvaluatorPairLJ::param_type(1.0, 1.0), rsq);
+    bench_evaluator<EvaluatorPairGauss>(runner, "pair_gauss", EvaluatorPairGauss::param_type(1.0, 1.0), rsq);
+    bench_evaluator<EvaluatorPairYukawa>(runner, "pair_yukawa", EvaluatorPairYukawa::param_type(1.0, 1.0), rsq);
+    bench_evaluator<EvaluatorPairMorse>(runner, "pair_morse", EvaluatorPairMorse::param_type(1.0, 5.0, 1.0), rsq);
+    }
+
+HOOMD_BENCHMARK_MAIN(bench_pair_evaluators)
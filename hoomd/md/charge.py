@@ -110,7 +110,7 @@ class pppm(force._force):
         force._force.enable(self);
         self.ewald.enable();
 
-    def set_params(self, Nx, Ny, Nz, order, rcut, alpha = 0.0):
+    def set_params(self, Nx, Ny, Nz, order, rcut, alpha = 0.0, slab = False):
         """ Sets PPPM parameters.
 
         Args:
@@ -121,10 +121,13 @@ class pppm(force._force):
             rcut  (float): Cutoff for the short-ranged part of the electrostatics calculation
             alpha (float, **optional**): Debye screening parameter (in units 1/distance)
                 .. versionadded:: 2.1
+            slab (bool, **optional**): Apply the slab correction for systems that are periodic in x and y only.
+                Leave a vacuum gap of two to three times the slab thickness along z.
 
         Examples::
 
             pppm.set_params(Nx=64, Ny=64, Nz=64, order=6, rcut=2.0)
+            pppm.set_params(Nx=64, Ny=64, Nz=128, order=6, rcut=2.0, slab=True)
 
         Note that the Fourier transforms are much faster for number of grid points of the form 2^N.
         """
@@ -191,6 +194,7 @@ class pppm(force._force):
 
         # set the parameters for the appropriate type
         self.cpp_force.setParams(Nx, Ny, Nz, order, kappa, rcut, alpha);
+        self.cpp_force.slab_correction = slab;
 
     def update_coeffs(self):
         if not self.params_set:
@@ -7,8 +7,10 @@
 
 from hoomd import _hoomd
 from hoomd.md import _md
-from hoomd.operation import Compute
+from hoomd.operation import Compute, Writer
 from hoomd.logging import log
+from hoomd.custom import Action
+from hoomd.data.parameterdicts import ParameterDict
 import hoomd
 
 
@@ -49,7 +51,7 @@ class ThermodynamicQuantities(_Thermo):
         self._cpp_obj = thermo_cls(self._simulation.state._cpp_sys_def, group, "")
         super()._attach()
 
-    @log
+    @log(requires=[Action.Flags.ROTATIONAL_KINETIC_ENERGY])
     def kinetic_temperature(self):
         """:math:`kT_k`, instantaneous thermal energy of the group (in energy
         units).
@@ -66,7 +68,7 @@ class ThermodynamicQuantities(_Thermo):
         else:
             return None
 
-    @log
+    @log(requires=[Action.Flags.PRESSURE_TENSOR])
     def pressure(self):
         """:math:`P`, instantaneous pressure of the group (in pressure units).
 
@@ -97,7 +99,8 @@ class ThermodynamicQuantities(_Thermo):
         else:
             return None
 
-    @log(category='sequence')
+    @log(category='sequence',
+         requires=[Action.Flags.PRESSURE_TENSOR])
     def pressure_tensor(self):
         """(:math:`P_{xx}`, :math:`P_{xy}`, :math:`P_{xz}`, :math:`P_{yy}`,
         :math:`P_{yz}`, :math:`P_{zz}`).
@@ -120,7 +123,7 @@ class ThermodynamicQuantities(_Thermo):
         else:
             return None
 
-    @log
+    @log(requires=[Action.Flags.ROTATIONAL_KINETIC_ENERGY])
     def kinetic_energy(self):
         """:math:`K`, total kinetic energy of all particles in the group (in
         energy units).
@@ -153,7 +156,7 @@ class ThermodynamicQuantities(_Thermo):
         else:
             return None
 
-    @log
+    @log(requires=[Action.Flags.ROTATIONAL_KINETIC_ENERGY])
     def rotational_kinetic_energy(self):
         """:math:`K_{\\mathrm{rot}}`, rotational kinetic energy of all particles
         in the group (in energy units).
@@ -175,7 +178,7 @@ class ThermodynamicQuantities(_Thermo):
         else:
             return None
 
-    @log
+    @log(requires=[Action.Flags.POTENTIAL_ENERGY])
     def potential_energy(self):
         """:math:`U`, potential energy that the group contributes to the entire
         system (in energy units).
@@ -282,6 +285,531 @@ class ThermodynamicQuantities(_Thermo):
             return None
 
 
+class ThermodynamicQuantitiesHMA(ThermodynamicQuantities):
+    """Compute thermodynamic properties and harmonically mapped averages.
+
+    Args:
+        filter (``hoomd.filter``): Particle filter to compute thermodynamic
+            properties for.
+        kT (float): Temperature that governs the sampling of the integrator
+            (in energy units).
+        harmonic_pressure (float): Harmonic contribution to the pressure (in
+            pressure units). When omitted, the HMA pressure is similar in
+            precision to the conventional pressure.
+
+    :py:class:`ThermodynamicQuantitiesHMA` provides all quantities of
+    :py:class:`ThermodynamicQuantities` and the HMA (harmonically mapped
+    averaging) potential energy and pressure, which are more precise for
+    atomic crystals in NVT simulations. The HMA estimators are summed in the
+    same pass over the particles as the other quantities, so logging both
+    costs no more than logging :py:class:`ThermodynamicQuantities` alone.
+
+    The lattice sites are the particle positions when the compute is attached
+    to the simulation. Diffusion (vacancy hopping, etc.) prevents HMA from
+    providing improvement.
+
+    Examples::
+
+        thermo = compute.ThermodynamicQuantitiesHMA(filter=hoomd.filter.All(),
+                                                    kT=1.0)
+    """
+
+    def __init__(self, filter, kT, harmonic_pressure=0):
+        super().__init__(filter)
+        self._kT = kT
+        self._harmonic_pressure = harmonic_pressure
+
+    def _attach(self):
+        super()._attach()
+        self._cpp_obj.enableHMA(self._kT, self._harmonic_pressure)
+
+    @log(requires=[Action.Flags.POTENTIAL_ENERGY])
+    def potential_energyHMA(self):
+        """:math:`U_{\\mathrm{HMA}}`, HMA potential energy of the group (in
+        energy units).
+
+        Calculated as:
+
+        .. math::
+
+            U_{\\mathrm{HMA}} = U + \\frac{D}{2} (N - 1) kT + \\frac{1}{2}
+            \\sum_{i \\in \\mathrm{filter}} \\vec{F}_i \\cdot
+            (\\vec{r}_i - \\vec{r}_{\\mathrm{lattice}, i})
+        """
+        if self._attached:
+            self._cpp_obj.compute(self._simulation.timestep)
+            return self._cpp_obj.potential_energyHMA
+        else:
+            return None
+
+    @log(requires=[Action.Flags.PRESSURE_TENSOR])
+    def pressureHMA(self):
+        """:math:`P_{\\mathrm{HMA}}`, HMA pressure of the group (in pressure
+        units).
+
+        Calculated as:
+
+        .. math::
+
+            P_{\\mathrm{HMA}} = P_{\\mathrm{harm}} + \\frac{W}{D V} +
+            \\frac{P_{\\mathrm{harm}} / kT - N / V}{D (N - 1)}
+            \\sum_{i \\in \\mathrm{filter}} \\vec{F}_i \\cdot
+            (\\vec{r}_i - \\vec{r}_{\\mathrm{lattice}, i})
+        """
+        if self._attached:
+            self._cpp_obj.compute(self._simulation.timestep)
+            return self._cpp_obj.pressureHMA
+        else:
+            return None
+
+
+class GroupThermodynamicQuantities(Compute):
+    """Compute thermodynamic properties of many groups of particles at once.
+
+    Args:
+        filters (list[``hoomd.filter``]): Particle filters to compute
+            thermodynamic properties for.
+
+    :py:class:`GroupThermodynamicQuantities` computes the quantities of
+    :py:class:`ThermodynamicQuantities` for every filter in *filters*, such as
+    per type temperatures or per region kinetic energies. Instead of one
+    reduction per group, a single pass over the particles adds the
+    contribution of each particle to all groups it is a member of, using a per
+    particle membership bitmask. This is much faster than separate
+    :py:class:`ThermodynamicQuantities` objects when logging tens of groups,
+    especially on the GPU.
+
+    All quantities are (*N_filters*,) sequences in the order of *filters*,
+    and are computed with the same equations as in
+    :py:class:`ThermodynamicQuantities`.
+
+    Examples::
+
+        filters = [hoomd.filter.Type([t]) for t in ['A', 'B', 'C']]
+        thermo = hoomd.md.compute.GroupThermodynamicQuantities(filters)
+    """
+
+    def __init__(self, filters):
+        self._filters = list(filters)
+
+    def _attach(self):
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            thermo_cls = _md.ComputeThermoMulti
+        else:
+            thermo_cls = _md.ComputeThermoMultiGPU
+        groups = [self._simulation.state._get_group(filter_)
+                  for filter_ in self._filters]
+        self._cpp_obj = thermo_cls(self._simulation.state._cpp_sys_def, groups)
+        super()._attach()
+
+    def _per_group(self, method):
+        if self._attached:
+            self._cpp_obj.compute(self._simulation.timestep)
+            getter = getattr(self._cpp_obj, method)
+            return [getter(g) for g in range(self._cpp_obj.getNumGroups())]
+        else:
+            return None
+
+    @property
+    def filters(self):
+        """list[``hoomd.filter``]: Particle filters of the groups."""
+        return self._filters
+
+    @log(category='sequence',
+         requires=[Action.Flags.ROTATIONAL_KINETIC_ENERGY])
+    def kinetic_temperature(self):
+        """:math:`kT_k` of each group (in energy units)."""
+        return self._per_group('getTemperature')
+
+    @log(category='sequence', requires=[Action.Flags.PRESSURE_TENSOR])
+    def pressure(self):
+        """:math:`P` of each group (in pressure units)."""
+        return self._per_group('getPressure')
+
+    @log(category='sequence', requires=[Action.Flags.PRESSURE_TENSOR])
+    def pressure_tensor(self):
+        """(:math:`P_{xx}`, :math:`P_{xy}`, :math:`P_{xz}`, :math:`P_{yy}`,
+        :math:`P_{yz}`, :math:`P_{zz}`) of each group (in pressure units)."""
+        if self._attached:
+            self._cpp_obj.compute(self._simulation.timestep)
+            return [[self._cpp_obj.getPressureTensor(g, i) for i in range(6)]
+                    for g in range(self._cpp_obj.getNumGroups())]
+        else:
+            return None
+
+    @log(category='sequence',
+         requires=[Action.Flags.ROTATIONAL_KINETIC_ENERGY])
+    def kinetic_energy(self):
+        """:math:`K` of each group (in energy units)."""
+        return self._per_group('getKineticEnergy')
+
+    @log(category='sequence')
+    def translational_kinetic_energy(self):
+        """:math:`K_{\\mathrm{trans}}` of each group (in energy units)."""
+        return self._per_group('getTranslationalKineticEnergy')
+
+    @log(category='sequence',
+         requires=[Action.Flags.ROTATIONAL_KINETIC_ENERGY])
+    def rotational_kinetic_energy(self):
+        """:math:`K_{\\mathrm{rot}}` of each group (in energy units)."""
+        return self._per_group('getRotationalKineticEnergy')
+
+    @log(category='sequence', requires=[Action.Flags.POTENTIAL_ENERGY])
+    def potential_energy(self):
+        """:math:`U` that each group contributes (in energy units)."""
+        return self._per_group('getPotentialEnergy')
+
+    @log(category='sequence')
+    def degrees_of_freedom(self):
+        """:math:`N_{\\mathrm{dof}}` of each group."""
+        return self._per_group('getNDOF')
+
+    @log(category='sequence')
+    def num_particles(self):
+        """:math:`N` of each group."""
+        if self._attached:
+            return [self._cpp_obj.getNumParticles(g)
+                    for g in range(self._cpp_obj.getNumGroups())]
+        else:
+            return None
+
+
+class RDF(Compute):
+    """Compute the radial distribution function.
+
+    Args:
+        r_max (float): Maximum pair distance (in distance units).
+        bins (int): Number of bins between 0 and *r_max*.
+        types (tuple[str, str]): Types of the first and second particle in a
+            pair. Defaults to `None`, which counts all pairs.
+
+    `RDF` accumulates a histogram of the distances between pairs of particles
+    closer than *r_max* each time one of its loggable quantities is read on
+    a new timestep, for example by a `hoomd.logging.Logger` that a writer
+    triggers every few thousand steps. `rdf` returns the average over all
+    samples since the compute was attached or `reset` was called:
+
+    .. math::
+
+        g(r) = \\frac{\\langle n(r) \\rangle}
+        {N_a (N_b - \\delta_{ab}) / V \\cdot \\Delta V(r)}
+
+    where :math:`n(r)` is the number of ordered pairs in the bin at :math:`r`,
+    :math:`\\Delta V(r)` is the volume (area in 2D) of the spherical shell
+    of the bin, :math:`N_a` and :math:`N_b` are the numbers of particles of
+    the two types, and :math:`\\delta_{ab}` is 1 when both types are the
+    same.
+
+    `RDF` finds the pairs with its own cell list, so *r_max* does not change
+    the neighbor list of the pair forces. On the GPU, the histogram stays in
+    device memory between samples. In MPI simulations, `RDF` widens the ghost
+    layer to *r_max*. Pairs near the domain boundaries may be missed when the
+    particles move farther than the neighbor list buffer between particle
+    migrations and *r_max* exceeds the largest pair force cutoff. *r_max*
+    must not exceed half the width of the box.
+
+    Examples::
+
+        rdf = hoomd.md.compute.RDF(r_max=4.0, bins=200)
+        sim.operations.computes.append(rdf)
+        logger.add(rdf, quantities=['rdf'])
+
+    Attributes:
+        r_max (float): Maximum pair distance (in distance units).
+        bins (int): Number of bins between 0 and *r_max*.
+    """
+
+    def __init__(self, r_max, bins, types=None):
+        self._param_dict.update(ParameterDict(r_max=float, bins=int))
+        self.r_max = r_max
+        self.bins = bins
+        self._types = None if types is None else tuple(types)
+
+    def _attach(self):
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            rdf_cls = _md.ComputeRDF
+        else:
+            rdf_cls = _md.ComputeRDFGPU
+        if self._types is None:
+            type_a = type_b = _md.ComputeRDF.ALL_TYPES
+        else:
+            particle_types = self._simulation.state.particle_types
+            type_a = particle_types.index(self._types[0])
+            type_b = particle_types.index(self._types[1])
+        self._cpp_obj = rdf_cls(self._simulation.state._cpp_sys_def,
+                                self.r_max, self.bins, type_a, type_b)
+        super()._attach()
+
+    @property
+    def types(self):
+        """tuple[str, str]: Types of the first and second particle in a pair.
+
+        `None` counts all pairs. Read only.
+        """
+        return self._types
+
+    @log(category='sequence')
+    def rdf(self):
+        """list[float]: :math:`g(r)` at the `bin_centers`, averaged over the
+        samples."""
+        if self._attached:
+            self._cpp_obj.compute(self._simulation.timestep)
+            return self._cpp_obj.rdf
+        else:
+            return None
+
+    @log(category='sequence')
+    def bin_centers(self):
+        """list[float]: Distances at the centers of the bins (in distance
+        units)."""
+        if self._attached:
+            return self._cpp_obj.bin_centers
+        else:
+            return None
+
+    @log
+    def num_samples(self):
+        """int: Number of samples in `rdf`."""
+        if self._attached:
+            return self._cpp_obj.num_samples
+        else:
+            return None
+
+    def reset(self):
+        """Discard all samples."""
+        if self._attached:
+            self._cpp_obj.reset()
+
+
+class StructureFactor(Compute):
+    """Compute the static structure factor.
+
+    Args:
+        q_max (float): Maximum wave vector magnitude (in inverse distance
+            units).
+        bins (int): Number of bins between 0 and *q_max*.
+
+    `StructureFactor` evaluates
+
+    .. math::
+
+        S(\\vec{q}) = \\frac{1}{N} \\left| \\sum_{j=1}^{N}
+        e^{i \\vec{q} \\cdot \\vec{r}_j} \\right|^2
+
+    by direct summation at the wave vectors :math:`\\vec{q}` of the
+    reciprocal lattice of the box with :math:`0 < |\\vec{q}| \\le q_{max}`
+    each time one of its loggable quantities is read on a new timestep.
+    `structure_factor` returns the average over the wave vectors in each bin
+    of :math:`|\\vec{q}|` and over all samples since the compute was
+    attached or `reset` was called. Bins without wave vectors are 0.
+
+    The cost of each sample is proportional to the number of particles times
+    `num_wave_vectors`, which grows as :math:`q_{max}^3` in 3D. In MPI
+    simulations, only the sums at each wave vector are communicated.
+
+    Examples::
+
+        sq = hoomd.md.compute.StructureFactor(q_max=10.0, bins=100)
+        sim.operations.computes.append(sq)
+        logger.add(sq, quantities=['structure_factor'])
+
+    Attributes:
+        q_max (float): Maximum wave vector magnitude (in inverse distance
+            units).
+        bins (int): Number of bins between 0 and *q_max*.
+    """
+
+    def __init__(self, q_max, bins):
+        self._param_dict.update(ParameterDict(q_max=float, bins=int))
+        self.q_max = q_max
+        self.bins = bins
+
+    def _attach(self):
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            sq_cls = _md.ComputeStructureFactor
+        else:
+            sq_cls = _md.ComputeStructureFactorGPU
+        self._cpp_obj = sq_cls(self._simulation.state._cpp_sys_def,
+                               self.q_max, self.bins)
+        super()._attach()
+
+    @log(category='sequence')
+    def structure_factor(self):
+        """list[float]: :math:`S(q)` at the `bin_centers`, averaged over the
+        samples."""
+        if self._attached:
+            self._cpp_obj.compute(self._simulation.timestep)
+            return self._cpp_obj.structure_factor
+        else:
+            return None
+
+    @log(category='sequence')
+    def bin_centers(self):
+        """list[float]: Wave vector magnitudes at the centers of the bins (in
+        inverse distance units)."""
+        if self._attached:
+            return self._cpp_obj.bin_centers
+        else:
+            return None
+
+    @log
+    def num_samples(self):
+        """int: Number of samples in `structure_factor`."""
+        if self._attached:
+            return self._cpp_obj.num_samples
+        else:
+            return None
+
+    @property
+    def num_wave_vectors(self):
+        """int: Number of wave vectors evaluated in each sample.
+
+        `None` when not attached. Read only.
+        """
+        if self._attached:
+            return self._cpp_obj.num_wave_vectors
+        else:
+            return None
+
+    def reset(self):
+        """Discard all samples."""
+        if self._attached:
+            self._cpp_obj.reset()
+
+
+class TimeCorrelation(Writer):
+    """Accumulate time correlation functions on the fly.
+
+    Args:
+        quantity (str): Quantity to correlate: ``'msd'``, ``'velocity'``, or
+            ``'stress'``.
+        filter (``hoomd.filter``): Particles to correlate.
+        period (int): Number of timesteps between samples. Defaults to 1.
+        num_points (int): Number of lags in each level. Defaults to 16.
+        num_levels (int): Number of levels. Defaults to 10.
+        averaging (int): Number of values of a level averaged into one value
+            of the next level. Must divide *num_points*. Defaults to 2.
+
+    `TimeCorrelation` samples *quantity* every *period* timesteps and
+    correlates it with the multiple-tau scheme, which covers lags from 0 to
+    ``num_points * averaging**(num_levels - 1) * period`` timesteps without
+    storing a trajectory. Level 0 stores the last *num_points* samples, and
+    each level stores averages of *averaging* values of the level below, so
+    longer lags have coarser resolution. *correlation* is averaged over all
+    pairs of samples at each lag since the operation was attached or `reset`
+    was called:
+
+    * ``'msd'``: mean squared displacement of the unwrapped positions,
+      :math:`\\langle |\\vec{r}_i(t) - \\vec{r}_i(0)|^2 \\rangle` (in
+      distance units squared).
+    * ``'velocity'``: velocity autocorrelation,
+      :math:`\\langle \\vec{v}_i(t) \\cdot \\vec{v}_i(0) \\rangle` (in
+      velocity units squared).
+    * ``'stress'``: autocorrelation of the off-diagonal components of the
+      pressure tensor of the group, averaged over :math:`xy`, :math:`xz`,
+      and :math:`yz` (in pressure units squared). The shear viscosity is
+      :math:`\\eta = \\frac{V}{kT} \\int_0^\\infty C(t) dt`.
+
+    On the GPU, the stored values of all levels stay in device memory and
+    only the sums at each lag are copied to the host. The per-particle
+    quantities store ``num_levels * (num_points + 1)`` vectors per particle
+    and are not available with MPI domain decomposition.
+
+    Add `TimeCorrelation` to the writers of the simulation, it does not write
+    files.
+
+    Examples::
+
+        msd = hoomd.md.compute.TimeCorrelation(quantity='msd',
+                                               filter=hoomd.filter.All(),
+                                               period=10)
+        sim.operations.writers.append(msd)
+        logger.add(msd, quantities=['lags', 'correlation'])
+
+    Attributes:
+        trigger (hoomd.trigger.Periodic): Select the timesteps to sample.
+    """
+
+    def __init__(self,
+                 quantity,
+                 filter,
+                 period=1,
+                 num_points=16,
+                 num_levels=10,
+                 averaging=2):
+        if quantity not in ('msd', 'velocity', 'stress'):
+            raise ValueError("quantity must be 'msd', 'velocity', or "
+                             "'stress'")
+        super().__init__(hoomd.trigger.Periodic(int(period)))
+        self._param_dict.update(
+            ParameterDict(period=int(period),
+                          num_points=int(num_points),
+                          num_levels=int(num_levels),
+                          averaging=int(averaging)))
+        self._quantity = quantity
+        self._filter = filter
+
+    def _attach(self):
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            correlator_cls = _md.TimeCorrelator
+            thermo_cls = _md.ComputeThermo
+        else:
+            correlator_cls = _md.TimeCorrelatorGPU
+            thermo_cls = _md.ComputeThermoGPU
+        sys_def = self._simulation.state._cpp_sys_def
+        group = self._simulation.state._get_group(self._filter)
+        thermo = None
+        if self._quantity == 'stress':
+            thermo = thermo_cls(sys_def, group, "")
+        self._cpp_obj = correlator_cls(
+            sys_def, group, thermo,
+            getattr(_md.TimeCorrelator.Quantity, self._quantity),
+            self.period, self.num_points, self.num_levels, self.averaging)
+        super()._attach()
+
+    @property
+    def quantity(self):
+        """str: Quantity to correlate. Read only."""
+        return self._quantity
+
+    @property
+    def filter(self):
+        """``hoomd.filter``: Particles to correlate. Read only."""
+        return self._filter
+
+    @log(category='sequence')
+    def lags(self):
+        """list[int]: Lag of each value of `correlation` (in timesteps)."""
+        if self._attached:
+            return self._cpp_obj.lags
+        else:
+            return None
+
+    @log(category='sequence')
+    def correlation(self):
+        """list[float]: Correlation at each of the `lags`.
+
+        Lags without pairs of samples are 0.
+        """
+        if self._attached:
+            return self._cpp_obj.correlation
+        else:
+            return None
+
+    @log
+    def num_samples(self):
+        """int: Number of samples."""
+        if self._attached:
+            return self._cpp_obj.num_samples
+        else:
+            return None
+
+    def reset(self):
+        """Discard all samples."""
+        if self._attached:
+            self._cpp_obj.reset()
+
+
 class thermoHMA(Compute):
     R""" Compute HMA thermodynamic properties of a group of particles.
 
@@ -219,19 +219,35 @@ class distance(ConstraintForce):
 
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name)
 
-    def set_params(self,rel_tol=None):
+    def set_params(self,rel_tol=None,iterative=None,solver_tol=None,max_iterations=None):
         R""" Set parameters for constraint computation.
 
         Args:
             rel_tol (float): The relative tolerance with which constraint violations are detected (**optional**).
+            iterative (bool): When True, solve for the constraint forces with an iterative solver that starts from
+                the solution of the previous step instead of with a sparse LU decomposition (**optional**).
+            solver_tol (float): Relative residual at which the iterative solver stops (**optional**).
+            max_iterations (int): Maximum number of iterations of the iterative solver (**optional**).
+
+        The iterative solver is a Jacobi preconditioned BiCGSTAB method. Use it for systems with many weakly coupled
+        constraints, such as rigid water or long constrained polymers, where the LU decomposition of the constraint
+        matrix dominates the cost of the step. When the iteration does not reach *solver_tol* within
+        *max_iterations*, the step is solved with the LU decomposition instead.
 
         Example::
 
             dist = constrain.distance()
             dist.set_params(rel_tol=0.0001)
+            dist.set_params(iterative=True, solver_tol=1e-10)
         """
         if rel_tol is not None:
             self.cpp_force.setRelativeTolerance(float(rel_tol))
+        if iterative is not None:
+            self.cpp_force.iterative = bool(iterative)
+        if solver_tol is not None:
+            self.cpp_force.solver_tol = float(solver_tol)
+        if max_iterations is not None:
+            self.cpp_force.max_iterations = int(max_iterations)
 
 class rigid(ConstraintForce):
     R""" Constrain particles in rigid bodies.
@@ -425,6 +441,29 @@ class rigid(ConstraintForce):
         """
         self.cpp_force.validateRigidBodies(False)
 
+    def set_params(self, center_ghosts=None):
+        R""" Set parameters for the rigid body constraint.
+
+        Args:
+            center_ghosts (bool): When True, send only the central particles of the rigid bodies as ghost particles
+                with MPI, and rebuild their constituent particles on the receiving rank (**optional**).
+
+        By default, every constituent particle within the ghost layer plus the body radius of a domain boundary is
+        sent as a ghost particle, and its position is updated every step. With *center_ghosts*, the ghost layer of
+        the central particle covers its constituents, and only the central particles are exchanged and updated.
+        Each rank sums the forces on its own constituent particles, and the sums on ghost central particles are
+        sent back to the rank that owns them. This reduces the communication for large bodies with many
+        constituents. Constituent particles of bonded groups are still sent as ghosts. *center_ghosts* is not
+        supported on the GPU.
+
+        Example::
+
+            rigid = constrain.rigid()
+            rigid.set_params(center_ghosts=True)
+        """
+        if center_ghosts is not None:
+            self.cpp_force.center_ghosts = bool(center_ghosts)
+
     ## \internal
     # \brief updates force coefficients
     def update_coeffs(self):
@@ -53,7 +53,7 @@ class Dihedral(Force):
         else:
             cpp_class = getattr(_md, self._cpp_class_name + "GPU")
 
-        self._cpp_obj = cpp_class(sim.state._cpp_sys_def)
+        self._cpp_obj = cpp_class(self._simulation.state._cpp_sys_def)
         super()._attach()
 
 
@@ -116,11 +116,13 @@ class table(force._force):
     Args:
         width (int): Number of points to use to interpolate V and T (see documentation above)
         name (str): Name of the force instance
+        interpolation (str): ``'linear'`` or ``'cubic'`` interpolation between grid points
 
     :py:class:`table` specifies that a tabulated dihedral force should be applied to every define dihedral.
 
     :math:`T_{\mathrm{user}}(\theta)` and :math:`V_{\mathrm{user}}(\theta)` are evaluated on *width* grid points between
-    :math:`-\pi` and :math:`\pi`. Values are interpolated linearly between grid points.
+    :math:`-\pi` and :math:`\pi`. Values are interpolated linearly between grid points,
+    or with cubic Hermite polynomials when *interpolation* is ``'cubic'``.
     For correctness, you must specify the derivative of the potential with respect to the dihedral angle,
     defined by: :math:`T = -\frac{\partial V}{\partial \theta}`.
 
@@ -154,7 +156,10 @@ class table(force._force):
         dtable.set_from_file('polymer', 'dihedral.dat')
 
     """
-    def __init__(self, width, name=None):
+    def __init__(self, width, name=None, interpolation='linear'):
+
+        if interpolation not in ('linear', 'cubic'):
+            raise ValueError("interpolation must be 'linear' or 'cubic'")
 
         # initialize the base class
         force._force.__init__(self, name);
@@ -166,6 +171,8 @@ class table(force._force):
         else:
             self.cpp_force = _md.TableDihedralForceComputeGPU(hoomd.context.current.system_definition, int(width), self.name);
 
+        self.cpp_force.cubic = interpolation == 'cubic'
+
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
 
         # setup the coefficient matrix
@@ -13,10 +13,13 @@ from hoomd import _hoomd
 from hoomd.md import _md
 from hoomd.operation import _HOOMDBaseObject
 from hoomd.logging import log
+from hoomd.custom import Action
 from hoomd.data.typeparam import TypeParameter
 from hoomd.data.typeconverter import OnlyType
 from hoomd.data.parameterdicts import ParameterDict, TypeParameterDict
 from hoomd.filter import ParticleFilter
+from hoomd.data.local_access_cpu import ForceLocalAccessCPU
+from hoomd.data.local_access_gpu import ForceLocalAccessGPU
 from hoomd.md.constrain import ConstraintForce
 
 
@@ -44,12 +47,46 @@ class Force(_HOOMDBaseObject):
         Users should not instantiate this class directly.
 
     Initializes some loggable quantities.
+
+    .. rubric:: Multiple time step integration
+
+    Set `respa_period` to *k* to evaluate the force only on time steps that
+    are multiples of *k*. On those steps, the integrator applies *k* times the
+    force, so the two half step kicks around the step apply the impulse of the
+    force over the whole period (r-RESPA in impulse form). Use this for slowly
+    varying forces, such as long range electrostatics, and keep the period of
+    the stiff forces at 1. Start runs on a multiple of *k*.
+
+    Note:
+        The energy and virial of the force enter the integrator's totals only
+        on the time steps it is evaluated. Log thermodynamic quantities, and
+        couple barostats, on multiples of *k*.
+
+    Attributes:
+        respa_period (int): Number of time steps between evaluations of the
+            force by the integrator (default: 1).
     '''
 
+    _respa_period = 1
+
     def _attach(self):
         super()._attach()
+        self._cpp_obj.respa_period = self._respa_period
+
+    @property
+    def respa_period(self):
+        return self._respa_period
+
+    @respa_period.setter
+    def respa_period(self, value):
+        value = int(value)
+        if value < 1:
+            raise ValueError("respa_period must be a positive integer")
+        self._respa_period = value
+        if self._attached:
+            self._cpp_obj.respa_period = value
 
-    @log
+    @log(requires=[Action.Flags.POTENTIAL_ENERGY])
     def energy(self):
         """float: Sum of the energy of the whole system."""
         if self._attached:
@@ -58,7 +95,7 @@ class Force(_HOOMDBaseObject):
         else:
             return None
 
-    @log(category='particle')
+    @log(category='particle', requires=[Action.Flags.POTENTIAL_ENERGY])
     def energies(self):
         """(*N_particles*, ) `numpy.ndarray` of ``numpy.float64``: The energies for all particles."""
         if self._attached:
@@ -85,7 +122,7 @@ class Force(_HOOMDBaseObject):
         else:
             return None
 
-    @log(category='particle')
+    @log(category='particle', requires=[Action.Flags.PRESSURE_TENSOR])
     def virials(self):
         """(*N_particles*, ) `numpy.ndarray` of ``numpy.float64``: The virial for all particles."""
         if self._attached:
@@ -95,6 +132,96 @@ class Force(_HOOMDBaseObject):
             return None
 
 
+class Custom(Force):
+    """Custom forces implemented in Python.
+
+    Args:
+        aniso (bool): Set to `True` when the force sets torques.
+
+    Subclass `Custom` and implement `set_forces` to compute a force in
+    Python code, such as a force term written with NumPy, CuPy, or JAX. The
+    integrator calls `set_forces` on the time steps it needs the force, after
+    the force, torque, and virial arrays are set to zero. Write the force into
+    these arrays through `cpu_local_force_arrays` or `gpu_local_force_arrays`.
+    The buffers are views of the arrays of the force, so nothing is copied
+    between HOOMD-blue and Python. In GPU simulations, `gpu_local_force_arrays`
+    exposes the device arrays through the ``__cuda_array_interface__`` and
+    Python GPU code writes to them without a transfer to the host.
+
+    The arrays are MPI rank local and ordered like the local particle data in
+    `hoomd.State.cpu_local_snapshot` and `hoomd.State.gpu_local_snapshot`.
+
+    Example::
+
+        class Harmonic(hoomd.md.force.Custom):
+            def __init__(self, k):
+                super().__init__()
+                self.k = k
+
+            def set_forces(self, timestep):
+                state = self._simulation.state
+                with state.cpu_local_snapshot as snap, \\
+                        self.cpu_local_force_arrays as arrays:
+                    position = snap.particles.position
+                    arrays.force[:] = -self.k * position
+                    arrays.potential_energy[:] = \\
+                        0.5 * self.k * numpy.sum(position**2, axis=1)
+
+    Note:
+        Use the local snapshot and force arrays of the same device in
+        `set_forces`, the CPU arrays migrate the data to the host in GPU
+        simulations.
+    """
+
+    def __init__(self, aniso=False):
+        self._aniso = bool(aniso)
+
+    def _attach(self):
+        self._cpp_obj = _md.CustomForceCompute(
+            self._simulation.state._cpp_sys_def, self, self._aniso)
+        super()._attach()
+
+    def set_forces(self, timestep):
+        """Set the forces in the local force arrays.
+
+        Args:
+            timestep (int): The current time step.
+
+        Subclasses must implement this method.
+        """
+        raise NotImplementedError
+
+    @property
+    def cpu_local_force_arrays(self):
+        """hoomd.data.ForceLocalAccessBase: Expose the force arrays on the CPU.
+
+        Provides access to the force, potential energy, torque, and virial
+        arrays of this force within a context manager (i.e. ``with
+        self.cpu_local_force_arrays as arrays:``). The data is MPI rank local.
+        """
+        if not self._attached:
+            raise RuntimeError(
+                "Cannot access the force arrays before the force is attached.")
+        return ForceLocalAccessCPU(self)
+
+    @property
+    def gpu_local_force_arrays(self):
+        """hoomd.data.ForceLocalAccessBase: Expose the force arrays on the GPU.
+
+        Provides access to the force, potential energy, torque, and virial
+        arrays of this force within a context manager (i.e. ``with
+        self.gpu_local_force_arrays as arrays:``) in GPU simulations. The
+        arrays implement the ``__cuda_array_interface__``.
+        """
+        if not self._attached:
+            raise RuntimeError(
+                "Cannot access the force arrays before the force is attached.")
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            raise RuntimeError(
+                "Cannot access the GPU force arrays in a CPU simulation.")
+        return ForceLocalAccessGPU(self)
+
+
 class constant(Force):
     R""" Constant force.
 
@@ -331,6 +458,98 @@ class Active(Force):
         super()._attach()
 
 
+class Bonded(Force):
+    R""" Harmonic bond, angle, and dihedral forces evaluated together.
+
+    Args:
+        bond (`hoomd.md.bond.Harmonic`): Bond force, or None.
+        angle (`hoomd.md.angle.Harmonic`): Angle force, or None.
+        dihedral (`hoomd.md.dihedral.Harmonic`): Dihedral force, or None.
+
+    :py:class:`Bonded` applies the sum of the given bonded forces as a single
+    force. One pass over the particles evaluates all bonds, angles, and
+    dihedrals of each particle, on the CPU and in one kernel on the GPU. Each
+    position is read and each force is written once for all terms, and the
+    integrator sums one force array instead of three.
+
+    The parameters come from the given forces. Set them there, before or after
+    adding :py:class:`Bonded` to the integrator. Do not add the given forces to
+    the integrator themselves, or their forces are applied twice.
+
+    Examples::
+
+        harmonic_bond = hoomd.md.bond.Harmonic()
+        harmonic_bond.params['A-A'] = dict(k=3.0, r0=1.0)
+        harmonic_angle = hoomd.md.angle.Harmonic()
+        harmonic_angle.params['A-A-A'] = dict(k=3.0, t0=0.7851)
+        bonded = hoomd.md.force.Bonded(bond=harmonic_bond,
+                                       angle=harmonic_angle)
+        integrator.forces.append(bonded)
+    """
+
+    def __init__(self, bond=None, angle=None, dihedral=None):
+        if bond is None and angle is None and dihedral is None:
+            raise ValueError("At least one of bond, angle, or dihedral must "
+                             "be given.")
+        if bond is not None and not isinstance(bond, hoomd.md.bond.Harmonic):
+            raise TypeError("bond must be a hoomd.md.bond.Harmonic force.")
+        if angle is not None and not isinstance(angle,
+                                                hoomd.md.angle.Harmonic):
+            raise TypeError("angle must be a hoomd.md.angle.Harmonic force.")
+        if dihedral is not None and not isinstance(
+                dihedral, hoomd.md.dihedral.Harmonic):
+            raise TypeError(
+                "dihedral must be a hoomd.md.dihedral.Harmonic force.")
+        self._bond = bond
+        self._angle = angle
+        self._dihedral = dihedral
+
+    def _attach(self):
+        for child in self._children:
+            if not child._added:
+                child._add(self._simulation)
+            elif self._simulation != child._simulation:
+                raise RuntimeError("{} object's constituent forces are used "
+                                   "in a different simulation.".format(
+                                       type(self)))
+            if not child._attached:
+                child._attach()
+
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            my_class = _md.FusedBondedForceCompute
+        else:
+            my_class = _md.FusedBondedForceComputeGPU
+
+        def cpp_obj(force):
+            return None if force is None else force._cpp_obj
+
+        self._cpp_obj = my_class(self._simulation.state._cpp_sys_def,
+                                 cpp_obj(self._bond), cpp_obj(self._angle),
+                                 cpp_obj(self._dihedral))
+
+        super()._attach()
+
+    @property
+    def bond(self):
+        """`hoomd.md.bond.Harmonic`: Bond force, or None."""
+        return self._bond
+
+    @property
+    def angle(self):
+        """`hoomd.md.angle.Harmonic`: Angle force, or None."""
+        return self._angle
+
+    @property
+    def dihedral(self):
+        """`hoomd.md.dihedral.Harmonic`: Dihedral force, or None."""
+        return self._dihedral
+
+    @property
+    def _children(self):
+        return [force for force in (self._bond, self._angle, self._dihedral)
+                if force is not None]
+
+
 class dipole(Force):
     R""" Treat particles as dipoles in an electric field.
 
@@ -117,6 +117,16 @@ class Integrator(_DynamicIntegrator):
             constraint forces applied to the particles in the system.
             The default value of ``None`` initializes an empty list.
 
+        gpu_graphs (bool): Capture the kernels of the integration methods into
+            GPU graphs to reduce the kernel launch overhead, default `False`.
+
+        overlap_communication (bool): Compute the forces on particles away
+            from the domain boundaries while the ghost particles are
+            updated, default `False`.
+
+        fuse_net_force (bool): Sum the net force in the kernel of the second
+            half step of the integration method, default `False`.
+
 
     The following classes can be used as elements in `methods`
 
@@ -168,15 +178,70 @@ class Integrator(_DynamicIntegrator):
 
         constraints (List[hoomd.md.constrain.ConstraintForce]): List of
             constraint forces applied to the particles in the system.
+
+        gpu_graphs (bool): Capture the kernels of the integration methods into
+            GPU graphs.
+
+        overlap_communication (bool): Compute the forces on particles away
+            from the domain boundaries while the ghost particles are
+            updated.
+
+        fuse_net_force (bool): Sum the net force in the kernel of the second
+            half step of the integration method.
+
+    .. rubric:: GPU graphs
+
+    When `gpu_graphs` is `True` on a single GPU, `Integrator` captures the
+    kernels that the integration methods launch in each half step into a GPU
+    graph and replays the graph with a single launch on later steps. It
+    captures a new graph when the number of local particles, the box, the
+    method parameters, or the memory layout changes. Only
+    `hoomd.md.methods.NVE` supports capture, other methods and forces launch
+    their kernels normally. `gpu_graphs` has no effect on the CPU.
+
+    .. rubric:: Fused net force
+
+    When `fuse_net_force` is `True` on the GPU, the kernel of the second half
+    step sums the forces, torques, and virials of all forces into the net
+    force while it updates the velocities, instead of in a separate kernel.
+    This saves one pass over the net force arrays each step. It applies only
+    when a single `hoomd.md.methods.NVE` or `hoomd.md.methods.Langevin`
+    method integrates all particles, there are no constraints, at most 6
+    forces are active in the step, `gpu_graphs` is not capturing the step,
+    and no force needs the net force of ghost particles. Otherwise
+    `Integrator` sums the net force normally.
+
+    .. rubric:: Overlapping communication
+
+    In MPI simulations on the CPU, `overlap_communication` hides the latency
+    of the ghost particle update on the steps where particles do not migrate.
+    `Integrator` starts the update, computes the forces that only involve
+    local particles, completes the update, and then computes the forces that
+    involve ghost particles. `hoomd.md.pair` potentials, `hoomd.md.bond`
+    potentials, and the mesh part of ``hoomd.md.charge.pppm`` split their
+    work in this way, other forces are computed after the update. The
+    results are the same up to floating point round-off.
+    `overlap_communication` has no effect on the GPU, in simulations with
+    rigid bodies, or without MPI.
+
+    .. rubric:: Multiple time steps
+
+    `Integrator` evaluates a force with ``respa_period`` *k* greater than 1
+    (see `hoomd.md.force.Force`) only on every *k*-th step and applies it as
+    an impulse, with `dt` the time step of the other forces.
     """
 
     def __init__(self, dt, aniso='auto', forces=None, constraints=None,
-                 methods=None):
+                 methods=None, gpu_graphs=False, overlap_communication=False,
+                 fuse_net_force=False):
 
         super().__init__(forces, constraints, methods)
 
         self._param_dict = ParameterDict(
             dt=float(dt),
+            gpu_graphs=bool(gpu_graphs),
+            overlap_communication=bool(overlap_communication),
+            fuse_net_force=bool(fuse_net_force),
             aniso=OnlyFrom(['true', 'false', 'auto'],
                            preprocess=_preprocess_aniso),
             _defaults=dict(aniso="auto")
@@ -198,6 +198,9 @@ class NPT(_Method):
         gamma (`float`): Dimensionless damping factor for the box degrees of
             freedom, Default to 0.
 
+        barostat_period (`int`): Number of time steps between the updates of
+            the barostat momenta, Default to 1.
+
     `NPT` performs constant pressure, constant temperature simulations, allowing
     for a fully deformable simulation box.
 
@@ -279,6 +282,14 @@ class NPT(_Method):
     Access these quantities using `translational_thermostat_dof`,
     `rotational_thermostat_dof`, and `barostat_dof`.
 
+    When `barostat_period` is larger than 1, the barostat momenta are updated
+    every `barostat_period` steps with kicks over all of the steps in between,
+    as in a multiple time step integrator with the pressure as the slow force.
+    The box and the particles are still rescaled every step. The forces only
+    compute the virial on the steps that update the barostat, which reduces
+    their cost on the other steps. `barostat_period` should be small compared
+    to `tauS` divided by the time step.
+
     Note:
         Coupling constant for barostat `tauS` should be set within appropriate
         range for pressure and volume to fluctuate in reasonable rate and
@@ -332,6 +343,9 @@ class NPT(_Method):
         gamma (float): Dimensionless damping factor for the box degrees of
             freedom.
 
+        barostat_period (int): Number of time steps between the updates of
+            the barostat momenta.
+
         translational_thermostat_dof (tuple[float, float]): Additional degrees
             of freedom for the translational thermostat (:math:`\xi`,
             :math:`\eta`)
@@ -345,7 +359,7 @@ class NPT(_Method):
             :math:`\nu_{xy}`, :math:`\nu_{xz}`, :math:`\nu_{yy}`,
             :math:`\nu_{yz}`, :math:`\nu_{zz}`)
     """
-    def __init__(self, filter, kT, tau, S, tauS, couple, box_dof=[True,True,True,False,False,False], rescale_all=False, gamma=0.0):
+    def __init__(self, filter, kT, tau, S, tauS, couple, box_dof=[True,True,True,False,False,False], rescale_all=False, gamma=0.0, barostat_period=1):
 
 
         # store metadata
@@ -359,6 +373,7 @@ class NPT(_Method):
             box_dof=(bool,)*6,
             rescale_all=bool(rescale_all),
             gamma=float(gamma),
+            barostat_period=int(barostat_period),
             translational_thermostat_dof=(float, float),
             rotational_thermostat_dof=(float, float),
             barostat_dof=(float, float, float, float, float, float)
@@ -529,6 +544,9 @@ class NVE(_Method):
         limit (None or `float`): Enforce that no particle moves more than a
             distance of a limit in a single time step. Defaults to None
 
+        constraint (None or `dict`): Constrain the motion of the particles
+            to a plane, line, sphere, or ellipsoid. Defaults to None.
+
     `NVE` performs constant volume, constant energy simulations using
     the standard Velocity-Verlet method. For poor initial conditions that
     include overlapping atoms, a limit can be specified to the movement a
@@ -536,6 +554,29 @@ class NVE(_Method):
     steps with the limit set, the system should be in a safe state to continue
     with unconstrained integration.
 
+    .. rubric:: Constraints
+
+    Set ``constraint`` to move the particles only on a surface or along a
+    line. After each step, the particles are moved back onto the constraint
+    and the components of their velocities and accelerations normal to it are
+    removed. The constraint is one of:
+
+    * ``dict(kind='plane')``: The particles move in the xy plane, as in
+      `hoomd.md.update.enforce2d`.
+    * ``dict(kind='line', vector=(x, y, z))``: The particles move along the
+      direction ``vector``, as in `hoomd.md.constrain.oneD`.
+    * ``dict(kind='sphere', P=(x, y, z), r=r)``: The particles move on the
+      sphere of center ``P`` and radius ``r``, as in
+      `hoomd.md.constrain.sphere`.
+    * ``dict(kind='ellipsoid', P=(x, y, z), rx=rx, ry=ry, rz=rz)``: The
+      particles move on the ellipsoid of center ``P`` and radii ``rx``,
+      ``ry``, and ``rz``, as in `hoomd.md.update.constraint_ellipsoid`. The
+      radii must satisfy ``rx >= rz`` and ``ry >= rz``.
+
+    The constrained directions are removed from the degrees of freedom of the
+    particles. Particles on a sphere or ellipsoid are moved back to the
+    closest point of the surface.
+
     .. todo::
         Update when zero momentum updater is added.
 
@@ -552,17 +593,22 @@ class NVE(_Method):
         limit (None or float): Enforce that no particle moves more than a
             distance of a limit in a single time step. Defaults to None
 
+        constraint (None or dict): Constrain the motion of the particles
+            to a plane, line, sphere, or ellipsoid.
+
     """
 
-    def __init__(self, filter, limit=None):
+    def __init__(self, filter, limit=None, constraint=None):
 
         # store metadata
         param_dict = ParameterDict(
             filter=ParticleFilter,
             limit=OnlyType(float, allow_none=True),
             zero_force=OnlyType(bool, allow_none=False),
+            constraint=OnlyType(dict, allow_none=True),
         )
-        param_dict.update(dict(filter=filter, limit=limit, zero_force=False))
+        param_dict.update(dict(filter=filter, limit=limit, zero_force=False,
+                               constraint=constraint))
 
         # set defaults
         self._param_dict.update(param_dict)
@@ -604,6 +650,9 @@ class Langevin(_Method):
             ``langevin_reservoir_energy_groupname`` to the logged quantities.
             Defaults to False.
 
+        constraint (None or `dict`): Constrain the motion of the particles
+            to a plane, line, sphere, or ellipsoid. Defaults to None.
+
     .. rubric:: Translational degrees of freedom
 
     `Langevin` integrates particles forward in time according to the
@@ -662,6 +711,10 @@ class Langevin(_Method):
        torque to assign them directly, with independent values for each
        particle type in the system.
 
+    Set ``constraint`` to move the particles only on a surface or along a
+    line, with the same constraints as `NVE`. The drag and random forces are
+    projected along with the other forces.
+
     Warning:
         When restarting a simulation, the energy of the reservoir will be reset
         to zero.
@@ -704,10 +757,13 @@ class Langevin(_Method):
             parameter is a tuple of three float. The type of each element of
             tuple is either positive float or zero.
 
+        constraint (None or dict): Constrain the motion of the particles
+            to a plane, line, sphere, or ellipsoid.
+
     """
 
     def __init__(self, filter, kT, seed, alpha=None,
-                 tally_reservoir_energy=False):
+                 tally_reservoir_energy=False, constraint=None):
 
         # store metadata
         param_dict = ParameterDict(
@@ -716,8 +772,10 @@ class Langevin(_Method):
             seed=int(seed),
             alpha=OnlyType(float, allow_none=True),
             tally_reservoir_energy=bool(tally_reservoir_energy),
+            constraint=OnlyType(dict, allow_none=True),
         )
-        param_dict.update(dict(kT=kT, alpha=alpha, filter=filter))
+        param_dict.update(dict(kT=kT, alpha=alpha, filter=filter,
+                               constraint=constraint))
         # set defaults
         self._param_dict.update(param_dict)
 
@@ -5,6 +5,7 @@
 // Maintainer: joaander All developers are free to add the calls needed to export their modules
 
 #include "ActiveForceCompute.h"
+#include "CustomForceCompute.h"
 #include "AllAnisoPairPotentials.h"
 #include "AllBondPotentials.h"
 #include "AllExternalPotentials.h"
@@ -13,7 +14,10 @@
 #include "AllSpecialPairPotentials.h"
 #include "AnisoPotentialPair.h"
 #include "BondTablePotential.h"
+#include "ComputeRDF.h"
+#include "ComputeStructureFactor.h"
 #include "ComputeThermo.h"
+#include "ComputeThermoMulti.h"
 #include "ComputeThermoHMA.h"
 #include "ConstExternalFieldDipoleForceCompute.h"
 #include "ConstraintEllipsoid.h"
@@ -24,8 +28,12 @@
 #include "EvaluatorSquareDensity.h"
 #include "EvaluatorRevCross.h"
 #include "FIREEnergyMinimizer.h"
+#include "LineSearchEnergyMinimizer.h"
+#include "LBFGSEnergyMinimizer.h"
+#include "CGEnergyMinimizer.h"
 #include "ForceComposite.h"
 #include "ForceDistanceConstraint.h"
+#include "FusedBondedForceCompute.h"
 #include "HarmonicAngleForceCompute.h"
 #include "CosineSqAngleForceCompute.h"
 #include "HarmonicDihedralForceCompute.h"
@@ -35,6 +43,7 @@
 #include "MolecularForceCompute.h"
 #include "NeighborListBinned.h"
 #include "NeighborList.h"
+#include "NeighborListBufferTuner.h"
 #include "NeighborListStencil.h"
 #include "NeighborListTree.h"
 #include "OPLSDihedralForceCompute.h"
@@ -44,11 +53,13 @@
 #include "PotentialPair.h"
 #include "PotentialTersoff.h"
 #include "PPPMForceCompute.h"
+#include "PPPMTuner.h"
 #include "QuaternionMath.h"
 #include "TableAngleForceCompute.h"
 #include "TableDihedralForceCompute.h"
 #include "TablePotential.h"
 #include "TempRescaleUpdater.h"
+#include "TimeCorrelator.h"
 #include "TwoStepBD.h"
 #include "TwoStepBerendsen.h"
 #include "TwoStepLangevinBase.h"
@@ -65,8 +76,11 @@
 #include "ActiveForceComputeGPU.h"
 #include "AnisoPotentialPairGPU.h"
 #include "BondTablePotentialGPU.h"
+#include "ComputeRDFGPU.h"
+#include "ComputeStructureFactorGPU.h"
 #include "ComputeThermoGPU.h"
 #include "ComputeThermoHMAGPU.h"
+#include "ComputeThermoMultiGPU.h"
 #include "ConstraintEllipsoidGPU.h"
 #include "ConstraintSphereGPU.h"
 #include "OneDConstraintGPU.h"
@@ -74,6 +88,7 @@
 #include "FIREEnergyMinimizerGPU.h"
 #include "ForceCompositeGPU.h"
 #include "ForceDistanceConstraintGPU.h"
+#include "FusedBondedForceComputeGPU.h"
 #include "HarmonicAngleForceComputeGPU.h"
 #include "CosineSqAngleForceComputeGPU.h"
 #include "HarmonicDihedralForceComputeGPU.h"
@@ -92,6 +107,7 @@
 #include "TableAngleForceComputeGPU.h"
 #include "TableDihedralForceComputeGPU.h"
 #include "TablePotentialGPU.h"
+#include "TimeCorrelatorGPU.h"
 #include "TwoStepBDGPU.h"
 #include "TwoStepBerendsenGPU.h"
 #include "TwoStepLangevinGPU.h"
@@ -225,9 +241,14 @@ void export_PotentialExternalWall(py::module& m, const std::string& name)
 PYBIND11_MODULE(_md, m)
     {
     export_ActiveForceCompute(m);
+    export_CustomForceCompute(m);
     export_ConstExternalFieldDipoleForceCompute(m);
+    export_ComputeRDF(m);
+    export_ComputeStructureFactor(m);
     export_ComputeThermo(m);
+    export_ComputeThermoMulti(m);
     export_ComputeThermoHMA(m);
+    export_TimeCorrelator(m);
     export_HarmonicAngleForceCompute(m);
     export_CosineSqAngleForceCompute(m);
     export_TableAngleForceCompute(m);
@@ -255,6 +276,8 @@ PYBIND11_MODULE(_md, m)
     export_PotentialPair<PotentialPairReactionField>(m, "PotentialPairReactionField");
     export_PotentialPair<PotentialPairDLVO>(m, "PotentialPairDLVO");
     export_PotentialPair<PotentialPairFourier>(m, "PotentialPairFourier");
+    export_PotentialPair<PotentialPairLJYukawa>(m, "PotentialPairLJYukawa");
+    export_PotentialPair<PotentialPairLJEwald>(m, "PotentialPairLJEwald");
     export_tersoff_params(m);
     export_revcross_params(m);
     export_pair_params(m);
@@ -270,6 +293,7 @@ PYBIND11_MODULE(_md, m)
     export_PotentialSpecialPair<PotentialSpecialPairCoulomb>(m, "PotentialSpecialPairCoulomb");
     export_NeighborList(m);
     export_NeighborListBinned(m);
+    export_NeighborListBufferTuner(m);
     export_NeighborListStencil(m);
     export_NeighborListTree(m);
     export_ConstraintSphere(m);
@@ -277,7 +301,9 @@ PYBIND11_MODULE(_md, m)
     export_MolecularForceCompute(m);
     export_ForceDistanceConstraint(m);
     export_ForceComposite(m);
+    export_FusedBondedForceCompute(m);
     export_PPPMForceCompute(m);
+    export_PPPMTuner(m);
     py::class_< wall_type, std::shared_ptr<wall_type> >(m, "wall_type")
         .def(py::init<>());
     m.def("make_wall_field_params", &make_wall_field_params);
@@ -306,6 +332,8 @@ PYBIND11_MODULE(_md, m)
     export_PotentialPairGPU<PotentialPairReactionFieldGPU, PotentialPairReactionField>(m, "PotentialPairReactionFieldGPU");
     export_PotentialPairGPU<PotentialPairDLVOGPU, PotentialPairDLVO>(m, "PotentialPairDLVOGPU");
     export_PotentialPairGPU<PotentialPairFourierGPU, PotentialPairFourier>(m, "PotentialPairFourierGPU");
+    export_PotentialPairGPU<PotentialPairLJYukawaGPU, PotentialPairLJYukawa>(m, "PotentialPairLJYukawaGPU");
+    export_PotentialPairGPU<PotentialPairLJEwaldGPU, PotentialPairLJEwald>(m, "PotentialPairLJEwaldGPU");
     export_PotentialPairGPU<PotentialPairEwaldGPU, PotentialPairEwald>(m, "PotentialPairEwaldGPU");
     export_PotentialPairGPU<PotentialPairMorseGPU, PotentialPairMorse>(m, "PotentialPairMorseGPU");
     export_PotentialPairGPU<PotentialPairDPDGPU, PotentialPairDPD>(m, "PotentialPairDPDGPU");
@@ -337,9 +365,14 @@ PYBIND11_MODULE(_md, m)
     export_ConstraintSphereGPU(m);
     export_OneDConstraintGPU(m);
     export_ForceDistanceConstraintGPU(m);
+    export_FusedBondedForceComputeGPU(m);
     // export_ConstExternalFieldDipoleForceComputeGPU(m);
+    export_ComputeRDFGPU(m);
+    export_ComputeStructureFactorGPU(m);
     export_ComputeThermoGPU(m);
     export_ComputeThermoHMAGPU(m);
+    export_ComputeThermoMultiGPU(m);
+    export_TimeCorrelatorGPU(m);
     export_PPPMForceComputeGPU(m);
     export_ActiveForceComputeGPU(m);
     export_PotentialExternalGPU<PotentialExternalPeriodicGPU, PotentialExternalPeriodic>(m, "PotentialExternalPeriodicGPU");
@@ -368,6 +401,9 @@ PYBIND11_MODULE(_md, m)
     export_Enforce2DUpdater(m);
     export_ConstraintEllipsoid(m);
     export_FIREEnergyMinimizer(m);
+    export_LineSearchEnergyMinimizer(m);
+    export_LBFGSEnergyMinimizer(m);
+    export_CGEnergyMinimizer(m);
     export_MuellerPlatheFlow(m);
 
 #ifdef ENABLE_HIP
@@ -47,7 +47,8 @@ class NList(_HOOMDBaseObject):
     moved `rebuild_check_delay` time steps after the last build and performs a
     rebuild when any particle has moved a distance ``buffer/2``. When
     `check_dist` is `False`, `NList` always rebuilds after
-    `rebuild_check_delay` time steps.
+    `rebuild_check_delay` time steps. Use `hoomd.md.tune.NeighborListBuffer` to
+    choose `buffer` and `rebuild_check_delay` automatically during a run.
 
     .. rubric:: Exclusions
 
@@ -69,6 +70,43 @@ class NList(_HOOMDBaseObject):
     * ``1-4``: Exclude particles *i* and *m* whenever there are bonds (i,j),
       (j,k), and (k,m).
 
+    .. rubric:: Type segments
+
+    Set `type_segments` to `True` to sort the neighbors of each particle by
+    type after every build. CPU pair potentials then skip the neighbors of
+    the types they do not interact with (``r_cut = 0``) as a whole instead of
+    testing each one. This helps when pair potentials sharing the neighbor
+    list only cover some of the type pairs, such as a colloid potential and a
+    solvent potential.
+
+    .. rubric:: Sorted neighbors
+
+    Set `sort_neighbors` to `True` to sort the neighbors of each particle by
+    index after every build. When the particles are spatially sorted, pair
+    potentials then read the positions of consecutive neighbors from nearby
+    memory, which can speed up the force computation more than the sort
+    costs.
+
+    .. rubric:: Compressed indices
+
+    Set `compressed_indices` to `True` to also store every neighbor as a
+    16-bit offset from the index of its particle. After the particles are
+    spatially sorted, nearly all neighbors fit in 16 bits, and the few others
+    are read from the full list. Pair potentials then read half as many bytes
+    from the neighbor list, which helps systems with long cutoffs where the
+    neighbor list is the largest array. The full list is kept for the other
+    forces, so the neighbor list uses more memory.
+
+    .. rubric:: Partial rebuilds
+
+    Set `partial_rebuild` to `True` to rebuild only the neighbors of the
+    particles that moved more than half of the buffer, instead of the whole
+    list. This helps systems where a few fast particles, such as those in a
+    hot region next to a glassy one, trigger most of the builds. Whenever more
+    than one in 8 particles moved too far, the box changed, or the list of a
+    particle is full, the neighbor list performs a full build instead. Partial
+    rebuilds are only implemented on the CPU without domain decomposition.
+
     .. rubric:: Diameter shifting
 
     Set `diameter_shift` to `True` when using `hoomd.md.pair.SLJ` or
@@ -81,16 +119,25 @@ class NList(_HOOMDBaseObject):
     Attributes:
         buffer (float): Buffer width.
         check_dist (bool): Flag to enable / disable distance checking.
+        compressed_indices (bool): Flag to enable / disable the 16-bit neighbor
+            indices.
         diameter_shift (bool): Flag to enable / disable diameter shifting.
         exclusions (tuple[str]): Excludes pairs from the neighbor list, which
             excludes them from the pair potential calculation.
         max_diameter (float): The maximum diameter a particle will achieve.
+        partial_rebuild (bool): Flag to enable / disable partial rebuilds.
         rebuild_check_delay (int): How often to attempt to rebuild the neighbor
             list.
+        sort_neighbors (bool): Flag to enable / disable sorting the neighbors
+            by index.
+        type_segments (bool): Flag to enable / disable sorting the neighbors
+            by type.
     """
 
     def __init__(self, buffer, exclusions, rebuild_check_delay,
-                 diameter_shift, check_dist, max_diameter):
+                 diameter_shift, check_dist, max_diameter,
+                 type_segments=False, partial_rebuild=False,
+                 sort_neighbors=False, compressed_indices=False):
 
         validate_exclusions = OnlyFrom(
             ['bond', 'angle', 'constraint', 'dihedral', 'special_pair',
@@ -103,6 +150,10 @@ class NList(_HOOMDBaseObject):
                                check_dist=bool(check_dist),
                                diameter_shift=bool(diameter_shift),
                                max_diameter=float(max_diameter),
+                               type_segments=bool(type_segments),
+                               partial_rebuild=bool(partial_rebuild),
+                               sort_neighbors=bool(sort_neighbors),
+                               compressed_indices=bool(compressed_indices),
                                _defaults={'exclusions': exclusions}
                                )
         self._param_dict.update(params)
@@ -119,8 +170,6 @@ class NList(_HOOMDBaseObject):
         else:
             return self._cpp_obj.getSmallestRebuild()
 
-    # TODO need to add tuning Updater for NList
-
 
 ## \internal
 # \brief %nlist r_cut matrix
@@ -138,12 +187,19 @@ class Cell(NList):
         check_dist (bool): Flag to enable / disable distance checking.
         deterministic (bool): When `True`, sort neighbors to help provide
             deterministic simulation runs.
+        compressed_indices (bool): Flag to enable / disable the 16-bit neighbor
+            indices.
         diameter_shift (bool): Flag to enable / disable diameter shifting.
         exclusions (tuple[str]): Excludes pairs from the neighbor list, which
             excludes them from the pair potential calculation.
         max_diameter (float): The maximum diameter a particle will achieve.
+        partial_rebuild (bool): Flag to enable / disable partial rebuilds.
         rebuild_check_delay (int): How often to attempt to rebuild the neighbor
             list.
+        sort_neighbors (bool): Flag to enable / disable sorting the neighbors
+            by index.
+        type_segments (bool): Flag to enable / disable sorting the neighbors
+            by type.
 
     `Cell` finds neighboring particles using a fixed width cell list, allowing
     for *O(kN)* construction of the neighbor list where *k* is the number of
@@ -164,10 +220,14 @@ class Cell(NList):
 
     def __init__(self, buffer=0.4, exclusions=('bond',), rebuild_check_delay=1,
                  diameter_shift=False, check_dist=True, max_diameter=1.0,
-                 deterministic=False):
+                 deterministic=False, type_segments=False,
+                 partial_rebuild=False, sort_neighbors=False,
+                 compressed_indices=False):
 
         super().__init__(buffer, exclusions, rebuild_check_delay,
-                         diameter_shift, check_dist, max_diameter)
+                         diameter_shift, check_dist, max_diameter,
+                         type_segments, partial_rebuild, sort_neighbors,
+                         compressed_indices)
 
         self._param_dict.update(
             ParameterDict(deterministic=bool(deterministic)))
@@ -171,6 +171,44 @@ class Pair(force.Force):
         # above and raise an error if they occur.
         return self._cpp_obj.computeEnergyBetweenSets(tags1, tags2)
 
+    def define_energy_sets(self, tags1, tags2):
+        R""" Define two sets of particles for `compute_set_energy`.
+
+        Args:
+            tags1 (``ndarray<int32>``): a numpy array of particle tags in the
+                first set
+            tags2 (``ndarray<int32>``): a numpy array of particle tags in the
+                second set
+
+        The sets are stored by tag, so they are kept when the particles are
+        sorted or migrate between ranks and need only be defined once. A
+        particle may be in both sets.
+
+        Examples::
+
+            mypair.define_energy_sets(tags1=numpy.arange(0, N, 2),
+                                      tags2=numpy.arange(1, N, 2))
+        """
+        self._cpp_obj.setEnergySets(tags1, tags2)
+
+    def compute_set_energy(self):
+        R""" Compute the energy between the sets given to
+        `define_energy_sets`.
+
+        .. math::
+
+            U = \sum_{i \in \mathrm{tags1}, j \in \mathrm{tags2}} V_{ij}(r)
+
+        Unlike `compute_energy`, the pairs are found with the neighbor list
+        and the energy is computed on the device the simulation runs on. The
+        pairs excluded from the neighbor list do not contribute, as in the
+        forces.
+
+        Returns:
+            float: The energy between the two sets.
+        """
+        return self._cpp_obj.computeSetEnergy(self._simulation.timestep)
+
     def _return_type_shapes(self):
         type_shapes = self.cpp_force.getTypeShapesPy()
         ret = [ json.loads(json_string) for json_string in type_shapes ]
@@ -468,6 +506,66 @@ class Yukawa(Pair):
                                                  len_keys=2))
         self._add_typeparam(params)
 
+class LJYukawa(Pair):
+    """Sum of the Lennard-Jones and Yukawa pair potentials.
+
+    Args:
+        nlist (:py:mod:`hoomd.md.nlist.NList`): Neighbor list
+        r_cut (float): Default cutoff radius (in distance units).
+        r_on (float): Default turn-on radius (in distance units).
+        mode (str): Energy shifting mode.
+
+    `LJYukawa` computes the same forces as `LJ` and `Yukawa` together, in a
+    single pass over the neighbor list. Each simulation step reads the
+    neighbor list and writes the force array once instead of once per
+    potential.
+
+    .. math::
+        :nowrap:
+
+        \\begin{eqnarray*}
+        V(r) = & V_{\\mathrm{LJ}}(r) + V_{\\mathrm{yukawa}}(r)
+               & r < r_{\\mathrm{cut}} \\\\
+             = & 0 & r \\ge r_{\\mathrm{cut}} \\\\
+        \\end{eqnarray*}
+
+    See `LJ` and `Yukawa` for the two components. Both components share the
+    cutoff radius, turn-on radius, and energy shifting mode. See `Pair` for
+    details on how forces are calculated and the available energy shifting
+    and smoothing modes. Use `params` dictionary to set potential
+    coefficients. The coefficients must be set per unique pair of particle
+    types.
+
+    Attributes:
+        params (`TypeParameter` [\\
+          `tuple` [``particle_type``, ``particle_type``],\\
+          `dict`]):
+          The potential parameters. The dictionary has the following keys:
+
+          * ``lj`` (`dict`, **required**) - the `LJ` parameters ``epsilon``
+            and ``sigma``
+
+          * ``yukawa`` (`dict`, **required**) - the `Yukawa` parameters
+            ``epsilon`` and ``kappa``
+
+    Example::
+
+        nl = nlist.Cell()
+        lj_yukawa = pair.LJYukawa(nl, r_cut=3.0)
+        lj_yukawa.params[('A', 'A')] = dict(
+            lj=dict(epsilon=1.0, sigma=1.0),
+            yukawa=dict(epsilon=0.5, kappa=1.0))
+    """
+    _cpp_class_name = "PotentialPairLJYukawa"
+    def __init__(self, nlist, r_cut=None, r_on=0., mode='none'):
+        super().__init__(nlist, r_cut, r_on, mode)
+        params = TypeParameter('params', 'particle_types',
+                               TypeParameterDict(
+                                   lj=dict(epsilon=float, sigma=float),
+                                   yukawa=dict(epsilon=float, kappa=float),
+                                   len_keys=2))
+        self._add_typeparam(params)
+
 class Ewald(Pair):
     """Ewald pair potential.
 
@@ -513,6 +611,11 @@ class Ewald(Pair):
           * ``alpha`` (`float`, **required**) - Debye screening length
             :math:`\\alpha` (in units of 1/distance)
 
+          * ``fast_erfc`` (`bool`, **optional**) - approximate
+            :math:`\\mathrm{erfc}` with a rational function when
+            :math:`\\alpha = 0` (*default*: ``False``). The absolute error
+            of the approximation is below :math:`1.5 \\cdot 10^{-7}`.
+
     Example::
 
         nl = nlist.Cell()
@@ -525,7 +628,69 @@ class Ewald(Pair):
         super().__init__(nlist, r_cut, r_on, mode)
         params = TypeParameter('params', 'particle_types',
                                TypeParameterDict(kappa=float, alpha=0.0,
-                                             len_keys=2))
+                                                 fast_erfc=False,
+                                                 len_keys=2))
+        self._add_typeparam(params)
+
+
+class LJEwald(Pair):
+    """Sum of the Lennard-Jones and Ewald real space pair potentials.
+
+    Args:
+        nlist (:py:mod:`hoomd.md.nlist.NList`): Neighbor list
+        r_cut (float): Default cutoff radius (in distance units).
+        r_on (float): Default turn-on radius (in distance units).
+        mode (str): Energy shifting mode.
+
+    `LJEwald` computes the same forces as `LJ` and `Ewald` together, in a
+    single pass over the neighbor list. Use it in place of separate `LJ` and
+    `Ewald` forces next to a long range PPPM force.
+
+    .. math::
+        :nowrap:
+
+        \\begin{eqnarray*}
+        V(r) = & V_{\\mathrm{LJ}}(r) + V_{\\mathrm{ewald}}(r)
+               & r < r_{\\mathrm{cut}} \\\\
+             = & 0 & r \\ge r_{\\mathrm{cut}} \\\\
+        \\end{eqnarray*}
+
+    See `LJ` and `Ewald` for the two components. Both components share the
+    cutoff radius, turn-on radius, and energy shifting mode. See `Pair` for
+    details on how forces are calculated and the available energy shifting
+    and smoothing modes. Use `params` dictionary to set potential
+    coefficients. The coefficients must be set per unique pair of particle
+    types.
+
+    Attributes:
+        params (`TypeParameter` [\\
+          `tuple` [``particle_type``, ``particle_type``],\\
+          `dict`]):
+          The potential parameters. The dictionary has the following keys:
+
+          * ``lj`` (`dict`, **required**) - the `LJ` parameters ``epsilon``
+            and ``sigma``
+
+          * ``ewald`` (`dict`, **required**) - the `Ewald` parameters
+            ``kappa``, ``alpha``, and ``fast_erfc``
+
+    Example::
+
+        nl = nlist.Cell()
+        lj_ewald = pair.LJEwald(nl, r_cut=3.0)
+        lj_ewald.params[('A', 'A')] = dict(
+            lj=dict(epsilon=1.0, sigma=1.0),
+            ewald=dict(kappa=1.0, alpha=0.0))
+    """
+    _cpp_class_name = "PotentialPairLJEwald"
+    def __init__(self, nlist, r_cut=None, r_on=0., mode='none'):
+        super().__init__(nlist, r_cut, r_on, mode)
+        params = TypeParameter('params', 'particle_types',
+                               TypeParameterDict(
+                                   lj=dict(epsilon=float, sigma=float),
+                                   ewald=dict(kappa=float, alpha=0.0,
+                                              fast_erfc=False),
+                                   len_keys=2))
         self._add_typeparam(params)
 
 
@@ -541,6 +706,7 @@ class table(force._force):
         width (int): Number of points to use to interpolate V and F.
         nlist (:py:mod:`hoomd.md.nlist.NList`): Neighbor list (default of None automatically creates a global cell-list based neighbor list)
         name (str): Name of the force instance
+        interpolation (str): ``'linear'`` or ``'cubic'`` interpolation between grid points
 
     :py:class:`table` specifies that a tabulated pair potential should be applied between every
     non-excluded particle pair in the simulation.
@@ -570,7 +736,8 @@ class table(force._force):
     where :math:`\vec{r}` is the vector pointing from one particle to the other in the pair.
 
     :math:`F_{\mathrm{user}}(r)` and :math:`V_{\mathrm{user}}(r)` are evaluated on *width* grid points between
-    :math:`r_{\mathrm{min}}` and :math:`r_{\mathrm{max}}`. Values are interpolated linearly between grid points.
+    :math:`r_{\mathrm{min}}` and :math:`r_{\mathrm{max}}`. Values are interpolated linearly between grid points,
+    or with cubic Hermite polynomials when *interpolation* is ``'cubic'``.
     For correctness, you must specify the force defined by: :math:`F = -\frac{\partial V}{\partial r}`.
 
     The following coefficients must be set per unique pair of particle types:
@@ -614,7 +781,10 @@ class table(force._force):
         not diverge near r=0, then a setting of *rmin=0* is valid.
 
     """
-    def __init__(self, width, nlist, name=None):
+    def __init__(self, width, nlist, name=None, interpolation='linear'):
+
+        if interpolation not in ('linear', 'cubic'):
+            raise ValueError("interpolation must be 'linear' or 'cubic'")
 
         # initialize the base class
         force._force.__init__(self, name);
@@ -633,6 +803,8 @@ class table(force._force):
             self.nlist.cpp_nlist.setStorageMode(_md.NeighborList.storageMode.full);
             self.cpp_force = _md.TablePotentialGPU(hoomd.context.current.system_definition, self.nlist.cpp_nlist, int(width), self.name);
 
+        self.cpp_force.cubic = interpolation == 'cubic'
+
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
 
         # stash the width for later use
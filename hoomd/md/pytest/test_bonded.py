@@ -0,0 +1,122 @@
+import hoomd
+import pytest
+import numpy as np
+import itertools
+
+
+def _chain_snapshot(device, n_chains=6, length=8):
+    """Make a snapshot of perturbed zigzag chains with all bonded terms.
+
+    Each chain has bonds, angles, and dihedrals along its backbone. The group
+    types alternate, so that both types of each term are used.
+    """
+    s = hoomd.Snapshot(device.communicator)
+
+    if s.exists:
+        s.configuration.box = [20, 20, 20, 0, 0, 0]
+        s.particles.N = n_chains * length
+        s.particles.types = ['A']
+
+        pos = []
+        for c, i in itertools.product(range(n_chains), range(length)):
+            pos.append([-4 + 0.9 * i, -6 + 2.5 * c + 0.5 * (i % 2),
+                        0.4 * ((i // 2) % 2)])
+        pos = np.array(pos)
+        pos += np.random.uniform(-0.1, 0.1, size=pos.shape)
+        s.particles.position[:] = pos
+
+        bonds, angles, dihedrals = [], [], []
+        for c in range(n_chains):
+            first = c * length
+            bonds += [[first + i, first + i + 1] for i in range(length - 1)]
+            angles += [[first + i, first + i + 1, first + i + 2]
+                       for i in range(length - 2)]
+            dihedrals += [[first + i + j for j in range(4)]
+                          for i in range(length - 3)]
+
+        s.bonds.N = len(bonds)
+        s.bonds.types = ['a', 'b']
+        s.bonds.group[:] = bonds
+        s.bonds.typeid[:] = np.arange(len(bonds)) % 2
+
+        s.angles.N = len(angles)
+        s.angles.types = ['a', 'b']
+        s.angles.group[:] = angles
+        s.angles.typeid[:] = np.arange(len(angles)) % 2
+
+        s.dihedrals.N = len(dihedrals)
+        s.dihedrals.types = ['a', 'b']
+        s.dihedrals.group[:] = dihedrals
+        s.dihedrals.typeid[:] = np.arange(len(dihedrals)) % 2
+
+    return s
+
+
+def _make_forces(use_bond, use_angle, use_dihedral):
+    """Make the harmonic forces with distinct parameters for each type."""
+    bond = angle = dihedral = None
+    if use_bond:
+        bond = hoomd.md.bond.Harmonic()
+        bond.params['a'] = dict(k=30.0, r0=1.0)
+        bond.params['b'] = dict(k=20.0, r0=1.2)
+    if use_angle:
+        angle = hoomd.md.angle.Harmonic()
+        angle.params['a'] = dict(k=10.0, t0=2.0)
+        angle.params['b'] = dict(k=5.0, t0=2.4)
+    if use_dihedral:
+        dihedral = hoomd.md.dihedral.Harmonic()
+        dihedral.params['a'] = dict(k=4.0, d=1, n=3, phi0=0)
+        dihedral.params['b'] = dict(k=2.0, d=-1, n=2, phi0=0.5)
+    return bond, angle, dihedral
+
+
+@pytest.mark.parametrize("use_bond,use_angle,use_dihedral",
+                         [(True, False, False), (False, True, False),
+                          (False, False, True), (True, True, True)])
+def test_bonded_matches_separate_forces(simulation_factory, device, use_bond,
+                                        use_angle, use_dihedral):
+    """Bonded gives the sum of the forces, energies, and virials of its terms.
+    """
+    snap = _chain_snapshot(device)
+
+    # the separate forces, each added to the integrator
+    separate = [
+        force for force in _make_forces(use_bond, use_angle, use_dihedral)
+        if force is not None
+    ]
+    sim = simulation_factory(snap)
+    sim.always_compute_pressure = True
+    integrator = hoomd.md.Integrator(dt=0.005)
+    integrator.forces.extend(separate)
+    sim.operations.integrator = integrator
+    sim.operations._schedule()
+
+    forces = [force.forces for force in separate]
+    energies = [force.energies for force in separate]
+    virials = [force.virials for force in separate]
+
+    # the same terms in one force
+    bonded = hoomd.md.force.Bonded(
+        *_make_forces(use_bond, use_angle, use_dihedral))
+    sim = simulation_factory(snap)
+    sim.always_compute_pressure = True
+    integrator = hoomd.md.Integrator(dt=0.005)
+    integrator.forces.append(bonded)
+    sim.operations.integrator = integrator
+    sim.operations._schedule()
+
+    if forces[0] is not None:
+        np.testing.assert_allclose(bonded.forces, sum(forces), rtol=1e-5,
+                                   atol=1e-8)
+        np.testing.assert_allclose(bonded.energies, sum(energies), rtol=1e-5,
+                                   atol=1e-8)
+        np.testing.assert_allclose(bonded.virials, sum(virials), rtol=1e-5,
+                                   atol=1e-8)
+        assert np.any(np.abs(bonded.forces) > 1e-3)
+
+
+def test_bonded_needs_a_term():
+    with pytest.raises(ValueError):
+        hoomd.md.force.Bonded()
+    with pytest.raises(TypeError):
+        hoomd.md.force.Bonded(bond=hoomd.md.angle.Harmonic())
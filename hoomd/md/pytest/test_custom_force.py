@@ -0,0 +1,35 @@
+import hoomd
+import numpy
+import numpy.testing as npt
+
+
+class ConstantForce(hoomd.md.force.Custom):
+    def set_forces(self, timestep):
+        with self.cpu_local_force_arrays as arrays:
+            arrays.force[:] = (1, -2, 3)
+            arrays.potential_energy[:] = 0.5
+            arrays.virial[:, 0] = 2
+
+
+def test_custom_force(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory(dimensions=3, d=2))
+    integrator = hoomd.md.Integrator(0.005)
+    integrator.methods.append(hoomd.md.methods.NVE(hoomd.filter.All()))
+    custom = ConstantForce()
+    integrator.forces.append(custom)
+    sim.operations.integrator = integrator
+    sim.operations._schedule()
+
+    forces = custom.forces
+    energies = custom.energies
+    if sim.device.communicator.rank == 0:
+        npt.assert_allclose(forces, [[1, -2, 3], [1, -2, 3]])
+        npt.assert_allclose(energies, [0.5, 0.5])
+        npt.assert_allclose(numpy.sum(energies), custom.energy)
+
+    sim.run(10)
+    snap = sim.state.snapshot
+    if snap.exists:
+        npt.assert_allclose(snap.particles.velocity[0],
+                            snap.particles.velocity[1])
+        assert snap.particles.velocity[0][0] > 0
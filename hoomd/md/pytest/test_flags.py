@@ -42,3 +42,38 @@ def test_per_particle_virial(simulation_factory, lattice_snapshot_factory):
 
 
 # TODO: test compute thermo once it is implemented
+
+
+def test_per_particle_energy(simulation_factory, lattice_snapshot_factory):
+    cell = hoomd.md.nlist.Cell()
+    lj = hoomd.md.pair.LJ(nlist=cell)
+    lj.params[('A', 'A')] = dict(sigma=1.0, epsilon=1.0)
+    lj.r_cut[('A', 'A')] = 2.5
+
+    a = 2**(1.0 / 6.0)
+    sim = simulation_factory(lattice_snapshot_factory(n=20, a=a, r=a * 0.01))
+
+    assert sim.always_compute_energy == True
+
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005)
+    sim.operations.integrator.forces.append(lj)
+    sim.operations.integrator.methods.append(
+        hoomd.md.methods.NVE(filter=hoomd.filter.All()))
+
+    # energies are not accumulated on steps that do not need them
+    sim.run(0)
+    sim.always_compute_energy = False
+    sim.run(1)
+    assert sim.always_compute_energy == False
+
+    energies = lj.energies
+    if sim.device.communicator.rank == 0:
+        assert numpy.sum(energies * energies) == 0.0
+
+    # energies should be non-zero after setting flags
+    sim.always_compute_energy = True
+    sim.run(1)
+
+    energies = lj.energies
+    if sim.device.communicator.rank == 0:
+        assert numpy.sum(energies * energies) > 0.0
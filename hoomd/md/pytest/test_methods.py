@@ -165,6 +165,7 @@ def test_npt_attributes():
     assert npt.couple == 'xyz'
     assert not npt.rescale_all
     assert npt.gamma == 0.0
+    assert npt.barostat_period == 1
 
     type_A = hoomd.filter.Type(['A'])
     npt.filter = type_A
@@ -203,6 +204,9 @@ def test_npt_attributes():
     npt.gamma = 2.0
     assert npt.gamma == 2.0
 
+    npt.barostat_period = 5
+    assert npt.barostat_period == 5
+
     assert npt.translational_thermostat_dof == (0.0, 0.0)
     npt.translational_thermostat_dof = (0.125, 0.5)
     assert npt.translational_thermostat_dof == (0.125, 0.5)
@@ -285,6 +289,9 @@ def test_npt_attributes_attached_3d(simulation_factory,
     npt.gamma = 2.0
     assert npt.gamma == 2.0
 
+    npt.barostat_period = 5
+    assert npt.barostat_period == 5
+
     assert npt.translational_thermostat_dof == (0.0, 0.0)
     npt.translational_thermostat_dof = (0.125, 0.5)
     assert npt.translational_thermostat_dof == (0.125, 0.5)
@@ -433,6 +440,111 @@ def test_nve_attributes_attached(simulation_factory,
     assert nve.filter is all_
 
 
+def test_nve_constraint(simulation_factory, two_particle_snapshot_factory):
+    """Test that the NVE constraint keeps the particles in the plane."""
+    snap = two_particle_snapshot_factory()
+    if snap.exists:
+        snap.particles.velocity[:] = [[1, 0, 1], [0, 1, -1]]
+    sim = simulation_factory(snap)
+    nve = hoomd.md.methods.NVE(filter=hoomd.filter.All(),
+                               constraint=dict(kind='plane'))
+    sim.operations.integrator = hoomd.md.Integrator(0.005, methods=[nve])
+    sim.run(10)
+    assert nve.constraint['kind'] == 'plane'
+
+    snapshot = sim.state.snapshot
+    if snapshot.exists:
+        numpy.testing.assert_allclose(snapshot.particles.position[:, 2], 0.1)
+        numpy.testing.assert_allclose(snapshot.particles.velocity[:, 2], 0)
+
+    nve.constraint = None
+    assert nve.constraint is None
+
+
+def test_nve_gpu_graphs(simulation_factory, lattice_snapshot_factory):
+    """Test that GPU graphs do not change the NVE trajectory."""
+    snap = lattice_snapshot_factory(n=5, a=1.2, r=0.1)
+    positions = []
+    for gpu_graphs in [False, True]:
+        sim = simulation_factory(snap)
+        lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(), r_cut=2.5)
+        lj.params[('A', 'A')] = {'sigma': 1, 'epsilon': 1}
+        nve = hoomd.md.methods.NVE(filter=hoomd.filter.All())
+        integrator = hoomd.md.Integrator(0.005, methods=[nve], forces=[lj],
+                                         gpu_graphs=gpu_graphs)
+        sim.operations.integrator = integrator
+        sim.run(0)
+        assert integrator.gpu_graphs == gpu_graphs
+
+        sim.run(50)
+        snapshot = sim.state.snapshot
+        if snapshot.exists:
+            positions.append(snapshot.particles.position)
+
+    if len(positions) > 0:
+        numpy.testing.assert_allclose(positions[0], positions[1])
+
+
+def test_nve_overlap_communication(simulation_factory,
+                                   lattice_snapshot_factory):
+    """Test that overlapping communication does not change the trajectory."""
+    snap = lattice_snapshot_factory(n=6, a=1.2, r=0.1)
+    positions = []
+    for overlap_communication in [False, True]:
+        sim = simulation_factory(snap)
+        lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(), r_cut=2.5)
+        lj.params[('A', 'A')] = {'sigma': 1, 'epsilon': 1}
+        nve = hoomd.md.methods.NVE(filter=hoomd.filter.All())
+        integrator = hoomd.md.Integrator(
+            0.005,
+            methods=[nve],
+            forces=[lj],
+            overlap_communication=overlap_communication)
+        sim.operations.integrator = integrator
+        sim.run(0)
+        assert integrator.overlap_communication == overlap_communication
+
+        sim.run(50)
+        snapshot = sim.state.snapshot
+        if snapshot.exists:
+            positions.append(snapshot.particles.position)
+
+    if len(positions) > 0:
+        numpy.testing.assert_allclose(positions[0], positions[1], rtol=1e-5)
+
+
+def test_nve_respa(simulation_factory, lattice_snapshot_factory):
+    """Test that a slow force applied as an impulse stays near the trajectory."""
+    snap = lattice_snapshot_factory(n=5, a=1.2, r=0.1)
+    positions = []
+    for respa_period in [1, 2]:
+        sim = simulation_factory(snap)
+        nlist = hoomd.md.nlist.Cell()
+        lj_fast = hoomd.md.pair.LJ(nlist=nlist, r_cut=2.5)
+        lj_fast.params[('A', 'A')] = {'sigma': 1, 'epsilon': 0.9}
+        lj_slow = hoomd.md.pair.LJ(nlist=nlist, r_cut=2.5)
+        lj_slow.params[('A', 'A')] = {'sigma': 1, 'epsilon': 0.1}
+        lj_slow.respa_period = respa_period
+        nve = hoomd.md.methods.NVE(filter=hoomd.filter.All())
+        integrator = hoomd.md.Integrator(0.002, methods=[nve],
+                                         forces=[lj_fast, lj_slow])
+        sim.operations.integrator = integrator
+        sim.run(0)
+        assert lj_slow.respa_period == respa_period
+        assert lj_slow._cpp_obj.respa_period == respa_period
+
+        sim.run(50)
+        snapshot = sim.state.snapshot
+        if snapshot.exists:
+            positions.append(snapshot.particles.position)
+
+    with pytest.raises(ValueError):
+        lj_slow.respa_period = 0
+
+    if len(positions) > 0:
+        numpy.testing.assert_allclose(positions[0], positions[1], atol=1e-3)
+
+
 def test_nvt_attributes():
     """Test attributes of the NVT integrator before attaching."""
     all_ = hoomd.filter.All()
@@ -0,0 +1,56 @@
+import hoomd
+import pytest
+
+
+def _make_simulation(simulation_factory, lattice_snapshot_factory, nlist):
+    sim = simulation_factory(lattice_snapshot_factory(n=6, a=1.2, r=0.05))
+    lj = hoomd.md.pair.LJ(nlist=nlist, r_cut=2.5)
+    lj.params[('A', 'A')] = {'sigma': 1, 'epsilon': 1}
+    integrator = hoomd.md.Integrator(dt=0.005)
+    integrator.forces.append(lj)
+    integrator.methods.append(
+        hoomd.md.methods.Langevin(hoomd.filter.All(), kT=1.5, seed=3))
+    sim.operations.integrator = integrator
+    return sim
+
+
+def test_attach_detach(simulation_factory, lattice_snapshot_factory):
+    cell = hoomd.md.nlist.Cell()
+    tuner = hoomd.md.tune.NeighborListBuffer(nlist=cell, trigger=10,
+                                             buffer_range=(0.2, 0.6),
+                                             n_buffers=3)
+    assert not tuner.tuned
+    assert tuner.sampled_times is None
+
+    sim = _make_simulation(simulation_factory, lattice_snapshot_factory, cell)
+    sim.operations.tuners.append(tuner)
+    sim.operations._schedule()
+    assert tuner.buffer_range == (0.2, 0.6)
+    assert tuner.n_buffers == 3
+    with pytest.raises(AttributeError):
+        tuner.n_buffers = 4
+
+    sim.operations.tuners.remove(tuner)
+    assert tuner.n_buffers == 3
+
+
+def test_tune(simulation_factory, lattice_snapshot_factory):
+    cell = hoomd.md.nlist.Cell()
+    tuner = hoomd.md.tune.NeighborListBuffer(nlist=cell, trigger=20,
+                                             buffer_range=(0.2, 0.6),
+                                             n_buffers=3)
+    sim = _make_simulation(simulation_factory, lattice_snapshot_factory, cell)
+    sim.operations.tuners.append(tuner)
+
+    # one startup call and two samples per buffer width
+    sim.run(20 * (2 * 3 + 1) + 1)
+    assert tuner.tuned
+    times = tuner.sampled_times
+    assert len(times) == 3
+    assert all(t > 0 for t in times)
+    assert min(abs(cell.buffer - b) for b in [0.2, 0.4, 0.6]) < 1e-6
+    assert cell.rebuild_check_delay >= 1
+
+    tuner.retune()
+    sim.run(20)
+    assert not tuner.tuned
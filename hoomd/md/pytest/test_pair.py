@@ -2,6 +2,7 @@ import hoomd
 import pytest
 import numpy as np
 import itertools
+import math
 from copy import deepcopy
 import json
 from pathlib import Path
@@ -73,6 +74,140 @@ def test_mode(simulation_factory, two_particle_snapshot_factory, mode):
     sim.run(1)
 
 
+def test_type_segments(simulation_factory, lattice_snapshot_factory):
+    """Skipping type segments gives the same result as the particle list."""
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'], n=7, a=1.2,
+                                    r=0.1)
+    if snap.exists:
+        snap.particles.typeid[::2] = 1
+    forces = []
+    energies = []
+    for type_segments in [False, True]:
+        cell = hoomd.md.nlist.Cell(type_segments=type_segments)
+        lj = hoomd.md.pair.LJ(nlist=cell, r_cut=2.5)
+        lj.params[(['A', 'B'], ['A', 'B'])] = {'sigma': 1, 'epsilon': 0.5}
+        lj.r_cut[('A', 'B')] = 0.0
+        gauss = hoomd.md.pair.Gauss(nlist=cell, r_cut=3.0)
+        gauss.params[(['A', 'B'], ['A', 'B'])] = {'sigma': 1, 'epsilon': 0.5}
+        sim = simulation_factory(snap)
+        integrator = hoomd.md.Integrator(dt=0.005)
+        integrator.forces.extend([lj, gauss])
+        sim.operations.integrator = integrator
+        sim.operations._schedule()
+        forces.append(lj.forces)
+        energies.append(lj.energies)
+
+    if forces[0] is not None:
+        np.testing.assert_allclose(forces[0], forces[1], rtol=1e-6,
+                                   atol=1e-8)
+        np.testing.assert_allclose(energies[0], energies[1], rtol=1e-6,
+                                   atol=1e-8)
+
+
+def test_sort_neighbors(simulation_factory, lattice_snapshot_factory):
+    """Sorting the neighbors by index does not change the forces."""
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'], n=7, a=1.2,
+                                    r=0.1)
+    if snap.exists:
+        snap.particles.typeid[::2] = 1
+    forces = []
+    for sort_neighbors in [False, True]:
+        cell = hoomd.md.nlist.Cell(sort_neighbors=sort_neighbors,
+                                   type_segments=True)
+        lj = hoomd.md.pair.LJ(nlist=cell, r_cut=2.5)
+        lj.params[(['A', 'B'], ['A', 'B'])] = {'sigma': 1, 'epsilon': 0.5}
+        sim = simulation_factory(snap)
+        integrator = hoomd.md.Integrator(dt=0.005)
+        integrator.forces.append(lj)
+        sim.operations.integrator = integrator
+        sim.operations._schedule()
+        forces.append(lj.forces)
+
+    if forces[0] is not None:
+        np.testing.assert_allclose(forces[0], forces[1], rtol=1e-6,
+                                   atol=1e-8)
+
+
+def test_compressed_indices(simulation_factory, lattice_snapshot_factory):
+    """The 16-bit neighbor indices do not change the forces."""
+    snap = lattice_snapshot_factory(n=7, a=1.2, r=0.1)
+    forces = []
+    for compressed_indices in [False, True]:
+        cell = hoomd.md.nlist.Cell(compressed_indices=compressed_indices)
+        lj = hoomd.md.pair.LJ(nlist=cell, r_cut=2.5)
+        lj.params[('A', 'A')] = {'sigma': 1, 'epsilon': 0.5}
+        sim = simulation_factory(snap)
+        integrator = hoomd.md.Integrator(dt=0.005)
+        integrator.forces.append(lj)
+        sim.operations.integrator = integrator
+        sim.operations._schedule()
+        forces.append(lj.forces)
+
+    if forces[0] is not None:
+        np.testing.assert_allclose(forces[0], forces[1], rtol=1e-6,
+                                   atol=1e-8)
+
+
+def test_partial_rebuild(simulation_factory, lattice_snapshot_factory):
+    """Partial rebuilds around a fast particle give the full build result."""
+    snap = lattice_snapshot_factory(n=7, a=1.2, r=0.1)
+    if snap.exists:
+        snap.particles.velocity[0] = [4, 2, 1]
+    forces = []
+    positions = []
+    for partial_rebuild in [False, True]:
+        cell = hoomd.md.nlist.Cell(buffer=0.2, partial_rebuild=partial_rebuild)
+        gauss = hoomd.md.pair.Gauss(nlist=cell, r_cut=1.5)
+        gauss.params[('A', 'A')] = {'sigma': 0.5, 'epsilon': 0.1}
+        sim = simulation_factory(snap)
+        integrator = hoomd.md.Integrator(dt=0.005)
+        integrator.forces.append(gauss)
+        integrator.methods.append(hoomd.md.methods.NVE(hoomd.filter.All()))
+        sim.operations.integrator = integrator
+        sim.run(200)
+        forces.append(gauss.forces)
+        snap_final = sim.state.snapshot
+        if snap_final.exists:
+            positions.append(snap_final.particles.position)
+
+    if (partial_rebuild and isinstance(sim.device, hoomd.device.CPU)
+            and sim.device.communicator.num_ranks == 1):
+        assert cell._cpp_obj.getNumPartialUpdates() > 0
+
+    if forces[0] is not None:
+        np.testing.assert_allclose(forces[0], forces[1], rtol=1e-5,
+                                   atol=1e-8)
+    if len(positions) == 2:
+        np.testing.assert_allclose(positions[0], positions[1], rtol=1e-5,
+                                   atol=1e-8)
+
+
+def test_set_energy(simulation_factory, lattice_snapshot_factory):
+    """The neighbor list set energy matches the energy between the tags."""
+    snap = lattice_snapshot_factory(n=5, a=1.2, r=0.1)
+    N = 5**3
+    tags1 = np.arange(0, N, 2, dtype=np.int32)
+    tags2 = np.arange(1, N, 2, dtype=np.int32)
+    cell = hoomd.md.nlist.Cell()
+    lj = hoomd.md.pair.LJ(nlist=cell, r_cut=2.5)
+    lj.params[('A', 'A')] = {'sigma': 1, 'epsilon': 0.5}
+    sim = simulation_factory(snap)
+    integrator = hoomd.md.Integrator(dt=0.005)
+    integrator.forces.append(lj)
+    sim.operations.integrator = integrator
+    sim.run(0)
+
+    lj.define_energy_sets(tags1, tags2)
+    energy = lj.compute_energy(tags1, tags2)
+    assert lj.compute_set_energy() == pytest.approx(energy, rel=1e-5)
+
+    # the sets are kept by tag after the particles move
+    integrator.methods.append(hoomd.md.methods.NVE(hoomd.filter.All()))
+    sim.run(20)
+    energy = lj.compute_energy(tags1, tags2)
+    assert lj.compute_set_energy() == pytest.approx(energy, rel=1e-5)
+
+
 def test_ron(simulation_factory, two_particle_snapshot_factory):
     lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(), mode='xplor', r_cut=2.5)
     lj.params[('A', 'A')] = {'sigma': 1, 'epsilon': 0.5}
@@ -299,7 +434,8 @@ def _valid_params(particle_types=['A', 'B']):
                                         {}))
 
     ewald_arg_dict = {"alpha": [0.025, 0.05, 0.075],
-                      "kappa": [0.5, 1.0, 1.5]}
+                      "kappa": [0.5, 1.0, 1.5],
+                      "fast_erfc": [False, True, False]}
     ewald_valid_param_dicts = _make_valid_param_dicts(ewald_arg_dict)
     valid_params_list.append(paramtuple(hoomd.md.pair.Ewald,
                                         dict(zip(combos,
@@ -671,6 +807,133 @@ def test_force_energy_relationship(simulation_factory,
                                        sim_forces[1],
                                        rtol=1e-06)
 
+@pytest.mark.parametrize("mode", ['none', 'shifted', 'xplor'])
+def test_lj_yukawa_sum(simulation_factory, two_particle_snapshot_factory,
+                       mode):
+    lj_params = {'sigma': 1.0, 'epsilon': 0.5}
+    yukawa_params = {'epsilon': 0.25, 'kappa': 1.5}
+
+    def compute(forces):
+        sim = simulation_factory(two_particle_snapshot_factory(d=1.2))
+        integrator = hoomd.md.Integrator(dt=0.005)
+        integrator.forces.extend(forces)
+        sim.operations.integrator = integrator
+        sim.run(0)
+        if forces[0].forces is None:
+            return None, None
+        return (sum(force.forces for force in forces),
+                sum(force.energies for force in forces))
+
+    nlist = hoomd.md.nlist.Cell()
+    lj = hoomd.md.pair.LJ(nlist, r_cut=2.5, r_on=2.0, mode=mode)
+    lj.params[('A', 'A')] = lj_params
+    yukawa = hoomd.md.pair.Yukawa(nlist, r_cut=2.5, r_on=2.0, mode=mode)
+    yukawa.params[('A', 'A')] = yukawa_params
+    separate_forces, separate_energies = compute([lj, yukawa])
+
+    lj_yukawa = hoomd.md.pair.LJYukawa(hoomd.md.nlist.Cell(), r_cut=2.5,
+                                       r_on=2.0, mode=mode)
+    lj_yukawa.params[('A', 'A')] = dict(lj=lj_params, yukawa=yukawa_params)
+    fused_forces, fused_energies = compute([lj_yukawa])
+
+    params = lj_yukawa.params[('A', 'A')]
+    np.testing.assert_allclose(params['lj']['sigma'], lj_params['sigma'])
+    np.testing.assert_allclose(params['yukawa']['kappa'],
+                               yukawa_params['kappa'])
+
+    if fused_forces is not None:
+        np.testing.assert_allclose(fused_forces, separate_forces, rtol=1e-6)
+        np.testing.assert_allclose(fused_energies, separate_energies,
+                                   rtol=1e-6)
+
+
+def test_lj_ewald_sum(simulation_factory, two_particle_snapshot_factory):
+    lj_params = {'sigma': 1.0, 'epsilon': 0.5}
+    ewald_params = {'kappa': 1.3, 'alpha': 0.0}
+    r = 1.2
+
+    def compute(forces):
+        snap = two_particle_snapshot_factory(d=r)
+        if snap.exists:
+            snap.particles.charge[:] = [1.0, -1.0]
+        sim = simulation_factory(snap)
+        integrator = hoomd.md.Integrator(dt=0.005)
+        integrator.forces.extend(forces)
+        sim.operations.integrator = integrator
+        sim.run(0)
+        if forces[0].forces is None:
+            return None, None
+        return (sum(force.forces for force in forces),
+                sum(force.energies for force in forces))
+
+    nlist = hoomd.md.nlist.Cell()
+    lj = hoomd.md.pair.LJ(nlist, r_cut=2.5)
+    lj.params[('A', 'A')] = lj_params
+    ewald = hoomd.md.pair.Ewald(nlist, r_cut=2.5)
+    ewald.params[('A', 'A')] = ewald_params
+    separate_forces, separate_energies = compute([lj, ewald])
+
+    lj_ewald = hoomd.md.pair.LJEwald(hoomd.md.nlist.Cell(), r_cut=2.5)
+    lj_ewald.params[('A', 'A')] = dict(lj=lj_params, ewald=ewald_params)
+    fused_forces, fused_energies = compute([lj_ewald])
+
+    if fused_forces is not None:
+        np.testing.assert_allclose(fused_forces, separate_forces, rtol=1e-6)
+        np.testing.assert_allclose(fused_energies, separate_energies,
+                                   rtol=1e-6)
+
+        lj_energy = 4 * 0.5 * ((1.0 / r)**12 - (1.0 / r)**6)
+        ewald_energy = -math.erfc(1.3 * r) / r
+        np.testing.assert_allclose(np.sum(fused_energies),
+                                   lj_energy + ewald_energy,
+                                   rtol=1e-6)
+
+
+@pytest.mark.parametrize("fast_erfc", [False, True])
+def test_ewald_energy_force_consistency(simulation_factory,
+                                        two_particle_snapshot_factory,
+                                        fast_erfc):
+    kappa = 1.3
+    h = 1e-3
+
+    def compute(r):
+        snap = two_particle_snapshot_factory(d=r)
+        if snap.exists:
+            snap.particles.charge[:] = [1.0, -1.0]
+        sim = simulation_factory(snap)
+        ewald = hoomd.md.pair.Ewald(hoomd.md.nlist.Cell(), r_cut=3.0)
+        ewald.params[('A', 'A')] = dict(kappa=kappa, alpha=0.0,
+                                        fast_erfc=fast_erfc)
+        integrator = hoomd.md.Integrator(dt=0.005)
+        integrator.forces.append(ewald)
+        sim.operations.integrator = integrator
+        sim.run(0)
+        energies = ewald.energies
+        forces = ewald.forces
+        if energies is None:
+            return None, None
+        # the second particle is at +r/2 along x
+        return np.sum(energies), forces[1][0]
+
+    for r in [0.5, 1.0, 1.5, 2.5]:
+        energy, force = compute(r)
+        energy_plus, _ = compute(r + h)
+        energy_minus, _ = compute(r - h)
+
+        if energy is not None:
+            # the approximation of erfc is accurate to 1.5e-7
+            np.testing.assert_allclose(energy,
+                                       -math.erfc(kappa * r) / r,
+                                       rtol=1e-5,
+                                       atol=2e-7 / r)
+
+            # F = -dU/dr, also for the approximated erfc
+            np.testing.assert_allclose(force,
+                                       -(energy_plus - energy_minus) / (2 * h),
+                                       rtol=1e-3,
+                                       atol=1e-6)
+
+
 FandEtuple = namedtuple('FandEtuple',
                         ['pair_potential',
                          'pair_potential_params',
@@ -0,0 +1,54 @@
+import hoomd
+import numpy as np
+import math
+
+
+def test_rdf_two_particles(simulation_factory, two_particle_snapshot_factory):
+    rdf = hoomd.md.compute.RDF(r_max=2.5, bins=5)
+    assert rdf.rdf is None
+
+    sim = simulation_factory(two_particle_snapshot_factory(d=1.2, L=20))
+    sim.operations.add(rdf)
+    sim.operations._schedule()
+
+    # the pair is counted once from each particle
+    volume = 20**3
+    shell = 4 / 3 * math.pi * (1.5**3 - 1.0**3)
+    expected = np.zeros(5)
+    expected[2] = volume / shell
+    np.testing.assert_allclose(rdf.rdf, expected, rtol=1e-5)
+    np.testing.assert_allclose(rdf.bin_centers, [0.25, 0.75, 1.25, 1.75, 2.25])
+    assert rdf.num_samples == 1
+
+    # reading again on the same timestep does not add a sample
+    rdf.rdf
+    assert rdf.num_samples == 1
+
+    rdf.reset()
+    assert rdf.num_samples == 0
+
+
+def test_rdf_types(simulation_factory, two_particle_snapshot_factory):
+    rdf = hoomd.md.compute.RDF(r_max=2.5, bins=5, types=('A', 'B'))
+    sim = simulation_factory(
+        two_particle_snapshot_factory(particle_types=['A', 'B'], d=1.2))
+    sim.operations.add(rdf)
+    sim.operations._schedule()
+
+    # both particles are type A
+    np.testing.assert_allclose(rdf.rdf, np.zeros(5))
+
+
+def test_structure_factor_lattice(simulation_factory,
+                                  lattice_snapshot_factory):
+    sq = hoomd.md.compute.StructureFactor(q_max=5.0, bins=10)
+    assert sq.structure_factor is None
+
+    sim = simulation_factory(lattice_snapshot_factory(a=1, n=7))
+    sim.operations.add(sq)
+    sim.operations._schedule()
+
+    # the lattice sums vanish at all wave vectors below the first Bragg peak
+    assert sq.num_wave_vectors > 0
+    np.testing.assert_allclose(sq.structure_factor, np.zeros(10), atol=1e-3)
+    assert sq.num_samples == 1
@@ -111,6 +111,36 @@ def test_basic_system_2d(simulation_factory, lattice_snapshot_factory):
                               (8.0/2.0**2, 0., 0., 0., 0., 0.))
 
 
+def test_group_thermo_2d(simulation_factory, lattice_snapshot_factory):
+    filters = [hoomd.filter.Type(['A']), hoomd.filter.Type(['B']),
+               hoomd.filter.All()]
+    thermos = [hoomd.md.compute.ThermodynamicQuantities(f) for f in filters]
+    group_thermo = hoomd.md.compute.GroupThermodynamicQuantities(filters)
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'], dimensions=2, n=2)
+    if snap.exists:
+        snap.particles.velocity[:] = [[-1, 0, 0], [2, 0, 0]]*2
+        snap.particles.typeid[:] = [0, 1, 0, 1]
+    sim = simulation_factory(snap)
+    sim.always_compute_pressure = True
+    for thermo in thermos:
+        sim.operations.add(thermo)
+    sim.operations.add(group_thermo)
+
+    integrator = hoomd.md.Integrator(dt=0.0001)
+    integrator.methods.append(hoomd.md.methods.NVT(filters[0], tau=1, kT=1))
+    integrator.methods.append(hoomd.md.methods.Langevin(filters[1], kT=1, seed=3, alpha=0.00001))
+    sim.operations.integrator = integrator
+
+    sim.run(1)
+
+    for qty in ['kinetic_temperature', 'pressure', 'pressure_tensor', 'kinetic_energy',
+                'translational_kinetic_energy', 'rotational_kinetic_energy',
+                'potential_energy', 'degrees_of_freedom', 'num_particles']:
+        np.testing.assert_allclose(getattr(group_thermo, qty),
+                                   [getattr(thermo, qty) for thermo in thermos],
+                                   rtol=1e-5, atol=1e-7)
+
+
 def test_system_rotational_dof(simulation_factory, device):
 
     snap = hoomd.Snapshot(device.communicator)
@@ -141,3 +171,30 @@ def test_system_rotational_dof(simulation_factory, device):
                               2./3*thermo.translational_kinetic_energy/10.0**3,
                               (0., 0., 0., 2./10**3, 0., 0.))
 
+
+
+def test_hma_system_3d(simulation_factory, two_particle_snapshot_factory):
+    filt = hoomd.filter.All()
+    thermo = hoomd.md.compute.ThermodynamicQuantitiesHMA(filt, kT=2.0, harmonic_pressure=0.5)
+    assert thermo.potential_energyHMA is None
+    assert thermo.pressureHMA is None
+
+    snap = two_particle_snapshot_factory()
+    if snap.exists:
+        snap.particles.velocity[:] = [[-2, 0, 0], [2, 0, 0]]
+    sim = simulation_factory(snap)
+    sim.always_compute_pressure = True
+    sim.operations.add(thermo)
+
+    integrator = hoomd.md.Integrator(dt=0.0001)
+    integrator.methods.append(hoomd.md.methods.NVT(filt, tau=1, kT=2.0))
+    sim.operations.integrator = integrator
+
+    sim.run(1)
+
+    # without forces, the HMA estimators reduce to their harmonic values
+    _assert_thermo_properties(thermo, 2, 0, 3, 0.0, 0.0, 4.0, 4.0,
+                              2.0/3*thermo.kinetic_energy/20**3,
+                              [8.0/20.0**3, 0., 0., 0., 0., 0.])
+    np.testing.assert_allclose(thermo.potential_energyHMA, 1.5*2.0, rtol=1e-5)
+    np.testing.assert_allclose(thermo.pressureHMA, 0.5, rtol=1e-5)
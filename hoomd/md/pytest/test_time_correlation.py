@@ -0,0 +1,64 @@
+import hoomd
+import numpy as np
+import pytest
+
+
+def _ballistic_simulation(simulation_factory, two_particle_snapshot_factory):
+    snap = two_particle_snapshot_factory()
+    if snap.exists:
+        snap.particles.velocity[:] = [[1, 0, 0], [0, 0.5, 0]]
+    sim = simulation_factory(snap)
+    nve = hoomd.md.methods.NVE(filter=hoomd.filter.All())
+    sim.operations.integrator = hoomd.md.Integrator(0.01, methods=[nve])
+    return sim
+
+
+@pytest.mark.parametrize("quantity", ['msd', 'velocity'])
+def test_ballistic(simulation_factory, two_particle_snapshot_factory,
+                   quantity):
+    sim = _ballistic_simulation(simulation_factory,
+                                two_particle_snapshot_factory)
+    if sim.device.communicator.num_ranks > 1:
+        pytest.skip("per-particle correlations need a single rank")
+
+    corr = hoomd.md.compute.TimeCorrelation(quantity=quantity,
+                                            filter=hoomd.filter.All(),
+                                            num_points=4,
+                                            num_levels=3,
+                                            averaging=2)
+    assert corr.lags is None
+    sim.operations.writers.append(corr)
+    sim.run(40)
+
+    lags = np.array(corr.lags)
+    np.testing.assert_array_equal(lags, [0, 1, 2, 3, 4, 6, 8, 12])
+    assert corr.num_samples == 40
+
+    # the mean squared velocity is (1 + 0.25) / 2, and averaged positions of
+    # a straight line remain on the line
+    if quantity == 'msd':
+        expected = 0.625 * (lags * 0.01)**2
+    else:
+        expected = np.full(len(lags), 0.625)
+    np.testing.assert_allclose(corr.correlation, expected, rtol=1e-4,
+                               atol=1e-7)
+
+    corr.reset()
+    assert corr.num_samples == 0
+    np.testing.assert_allclose(corr.correlation, np.zeros(len(lags)))
+
+
+def test_stress(simulation_factory, two_particle_snapshot_factory):
+    sim = _ballistic_simulation(simulation_factory,
+                                two_particle_snapshot_factory)
+    corr = hoomd.md.compute.TimeCorrelation(quantity='stress',
+                                            filter=hoomd.filter.All(),
+                                            num_points=4,
+                                            num_levels=2,
+                                            averaging=2)
+    sim.operations.writers.append(corr)
+    sim.run(10)
+
+    # the kinetic off-diagonal pressure tensor components vanish for
+    # velocities along the axes
+    np.testing.assert_allclose(corr.correlation, np.zeros(6), atol=1e-7)
@@ -224,6 +224,68 @@ void bond_force_type_test(bondforce_creator bf_creator, std::shared_ptr<Executio
 
 
 
+//! Computes the bond energy and the force on particle 1 along x with the particles a distance r apart
+void bond_force_evaluate(std::shared_ptr<BondTablePotential> fc,
+                         std::shared_ptr<ParticleData> pdata,
+                         Scalar r,
+                         unsigned int timestep,
+                         Scalar& U,
+                         Scalar& F)
+    {
+    pdata->setPosition(1, make_scalar3(r, 0.0, 0.0));
+    fc->compute(timestep);
+
+    ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+    U = h_force.data[0].w + h_force.data[1].w;
+    F = h_force.data[1].x;
+    }
+
+//! checks the cubic Hermite interpolation against an analytic potential
+void bond_force_cubic_test(bondforce_creator bf_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(2, BoxDim(1000.0), 1, 1, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setPosition(0, make_scalar3(0.0, 0.0, 0.0));
+    pdata->setPosition(1, make_scalar3(1.5, 0.0, 0.0));
+    sysdef->getBondData()->addBondedGroup(Bond(0, 0, 1));
+
+    unsigned int width = 21;
+    std::shared_ptr<BondTablePotential> fc = bf_creator(sysdef, width);
+    fc->setCubic(true);
+
+    // tabulate V(r) = cos(2r) + r and F = -dV/dr on a coarse grid
+    Scalar rmin = 1.0;
+    Scalar rmax = 3.0;
+    vector<Scalar> V, F;
+    for (unsigned int i = 0; i < width; i++)
+        {
+        Scalar r = rmin + (rmax - rmin) * Scalar(i) / Scalar(width - 1);
+        V.push_back(cos(Scalar(2.0) * r) + r);
+        F.push_back(Scalar(2.0) * sin(Scalar(2.0) * r) - Scalar(1.0));
+        }
+    fc->setTable(0, V, F, rmin, rmax);
+
+    // points between the grid points, and one on a grid point so that the difference spans two intervals
+    Scalar r_test[] = {1.137, 1.55, 2.0, 2.213, 2.871};
+    Scalar dr = 0.005;
+    unsigned int timestep = 0;
+    for (unsigned int k = 0; k < 5; k++)
+        {
+        Scalar r = r_test[k];
+        Scalar U, Fr, U_plus, U_minus, F_unused;
+        bond_force_evaluate(fc, pdata, r, timestep++, U, Fr);
+        bond_force_evaluate(fc, pdata, r + dr, timestep++, U_plus, F_unused);
+        bond_force_evaluate(fc, pdata, r - dr, timestep++, U_minus, F_unused);
+
+        // the interpolation errors are of order delta^4 in V and delta^3 in F, linear interpolation misses both
+        MY_CHECK_SMALL(U - (cos(Scalar(2.0) * r) + r), 1e-5);
+        MY_CHECK_SMALL(Fr - (Scalar(2.0) * sin(Scalar(2.0) * r) - Scalar(1.0)), 1.5e-4);
+
+        // the force is the derivative of the interpolated energy
+        MY_CHECK_SMALL(Fr + (U_plus - U_minus) / (Scalar(2.0) * dr), 2e-4);
+        }
+    }
+
 //! BondTablePotential creator for bond_force_basic_tests()
 std::shared_ptr<BondTablePotential> base_class_bf_creator(std::shared_ptr<SystemDefinition> sysdef, unsigned int width)
     {
@@ -252,6 +314,13 @@ UP_TEST( BondTablePotential_type )
     bond_force_type_test(bf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for cubic interpolation on the CPU
+UP_TEST( BondTablePotential_cubic )
+    {
+    bondforce_creator bf_creator = bind(base_class_bf_creator, _1, _2);
+    bond_force_cubic_test(bf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 
 #ifdef ENABLE_HIP
 //! test case for bond forces on the GPU
@@ -268,4 +337,11 @@ UP_TEST( BondTablePotentialGPU_type )
     bond_force_type_test(bf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
 
+//! test case for cubic interpolation on the GPU
+UP_TEST( BondTablePotentialGPU_cubic )
+    {
+    bondforce_creator bf_creator = bind(gpu_bf_creator, _1, _2);
+    bond_force_cubic_test(bf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+
 #endif
@@ -19,7 +19,11 @@ HOOMD_UP_MAIN()
 #include "hoomd/ConstForceCompute.h"
 #include "hoomd/md/TwoStepNVE.h"
 #include "hoomd/md/IntegratorTwoStep.h"
+#include "hoomd/md/ForceComposite.h"
+#include "hoomd/md/NeighborListTree.h"
+#include "hoomd/md/AllPairPotentials.h"
 #include "hoomd/filter/ParticleFilterAll.h"
+#include "hoomd/filter/ParticleFilterType.h"
 
 #ifdef ENABLE_HIP
 #include "hoomd/CommunicatorGPU.h"
@@ -3443,6 +3447,214 @@ void test_communicator_ghosts_per_type(communicator_creator comm_creator, std::s
         }
     }
 
+//! Number of rigid bodies along each direction of the lattice
+const unsigned int n_body_lattice = 8;
+
+//! Set up a lattice of tetrahedral rigid bodies with LJ interactions between the constituents
+/*! \param comm_creator Communicator factory
+    \param exec_conf Execution configuration
+    \param center_ghosts True to communicate only the central particles as ghosts
+    \param sysdef Output: the system
+    \param rigid Output: the rigid body constraint
+
+    The lattice is offset from the domain boundaries so that some bodies straddle the boundaries between the ranks and
+    the periodic boundaries.
+*/
+std::shared_ptr<IntegratorTwoStep> build_rigid_body_system(communicator_creator comm_creator,
+                                                           std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                                           bool center_ghosts,
+                                                           std::shared_ptr<SystemDefinition>& sysdef,
+                                                           std::shared_ptr<ForceComposite>& rigid)
+    {
+    unsigned int n = n_body_lattice*n_body_lattice*n_body_lattice;
+    BoxDim box(20.0);
+
+    sysdef = std::shared_ptr<SystemDefinition>(new SystemDefinition(n,           // number of particles
+                                                                    box,         // box dimensions
+                                                                    2,           // number of particle types
+                                                                    0,           // number of bond types
+                                                                    0,           // number of angle types
+                                                                    0,           // number of dihedral types
+                                                                    0,           // number of improper types
+                                                                    exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    // the central particles, with random orientations and velocities
+    SnapshotParticleData<Scalar> snap(n);
+    snap.type_mapping.push_back("A");
+    snap.type_mapping.push_back("B");
+
+    srand(12345);
+    Scalar3 lo = box.getLo();
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        unsigned int ix = i % n_body_lattice;
+        unsigned int iy = (i / n_body_lattice) % n_body_lattice;
+        unsigned int iz = i / (n_body_lattice*n_body_lattice);
+        snap.pos[i] = vec3<Scalar>(lo.x + 2.5*ix + 0.3, lo.y + 2.5*iy + 0.3, lo.z + 2.5*iz + 0.3);
+        snap.vel[i] = vec3<Scalar>(0.2*((Scalar)rand()/(Scalar)RAND_MAX - 0.5),
+                                   0.2*((Scalar)rand()/(Scalar)RAND_MAX - 0.5),
+                                   0.2*((Scalar)rand()/(Scalar)RAND_MAX - 0.5));
+        vec3<Scalar> axis((Scalar)rand()/(Scalar)RAND_MAX - 0.5,
+                          (Scalar)rand()/(Scalar)RAND_MAX - 0.5,
+                          (Scalar)rand()/(Scalar)RAND_MAX - 0.5);
+        snap.orientation[i] = quat<Scalar>::fromAxisAngle(axis/sqrt(dot(axis,axis)), (Scalar)rand()/(Scalar)RAND_MAX*3.0);
+        snap.inertia[i] = vec3<Scalar>(1.0, 1.0, 1.0);
+        }
+
+    std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, box.getL(), 2, 2, 2));
+    std::shared_ptr<Communicator> comm = comm_creator(sysdef, decomposition);
+    pdata->setDomainDecomposition(decomposition);
+    pdata->initializeFromSnapshot(snap);
+
+    // four constituents of type B at the corners of a tetrahedron
+    rigid = std::shared_ptr<ForceComposite>(new ForceComposite(sysdef));
+    std::vector<unsigned int> types(4, 1);
+    std::vector<Scalar3> pos;
+    pos.push_back(make_scalar3(0.35, 0.35, 0.35));
+    pos.push_back(make_scalar3(0.35, -0.35, -0.35));
+    pos.push_back(make_scalar3(-0.35, 0.35, -0.35));
+    pos.push_back(make_scalar3(-0.35, -0.35, 0.35));
+    std::vector<Scalar4> orientation(4, make_scalar4(1.0, 0.0, 0.0, 0.0));
+    std::vector<Scalar> charge(4, 0.0);
+    std::vector<Scalar> diameter(4, 1.0);
+    rigid->setParam(0, types, pos, orientation, charge, diameter);
+    rigid->validateRigidBodies(true);
+    UP_ASSERT_EQUAL(pdata->getNGlobal(), 5*n);
+
+    std::shared_ptr<NeighborList> nlist(new NeighborListTree(sysdef, Scalar(2.0), Scalar(0.4)));
+    nlist->setFilterBody(true);
+
+    std::shared_ptr<PotentialPairLJ> lj(new PotentialPairLJ(sysdef, nlist));
+    lj->setParams(1, 1, EvaluatorPairLJ::param_type(Scalar(1.0), Scalar(1.0)));
+    lj->setRcut(0, 0, Scalar(0.0));
+    lj->setRcut(0, 1, Scalar(0.0));
+    lj->setRcut(1, 1, Scalar(2.0));
+
+    // integrate the central particles
+    std::unordered_set<std::string> center_types;
+    center_types.insert("A");
+    std::shared_ptr<ParticleFilter> selector_center(new ParticleFilterType(center_types));
+    std::shared_ptr<ParticleGroup> group_center(new ParticleGroup(sysdef, selector_center));
+    std::shared_ptr<TwoStepNVE> two_step_nve(new TwoStepNVE(sysdef, group_center));
+
+    std::shared_ptr<IntegratorTwoStep> nve_up(new IntegratorTwoStep(sysdef, Scalar(0.002)));
+    nve_up->addIntegrationMethod(two_step_nve);
+    nve_up->addForceCompute(lj);
+    nve_up->addForceConstraint(rigid);
+    nve_up->addForceComposite(rigid);
+
+    nlist->setCommunicator(comm);
+    lj->setCommunicator(comm);
+    std::static_pointer_cast<Compute>(rigid)->setCommunicator(comm);
+    nve_up->setCommunicator(comm);
+
+    // set the mode after connecting to the communicator, which passes it on
+    rigid->setCenterGhosts(center_ghosts);
+    UP_ASSERT_EQUAL(comm->getBodyCenterGhosts(), center_ghosts);
+
+    nve_up->prepRun(0);
+    return nve_up;
+    }
+
+//! Compare rigid bodies with body center ghosts to rigid bodies with constituent ghosts
+void test_communicator_body_center_ghosts(communicator_creator comm_creator,
+                                          std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(exec_conf->getHOOMDWorldMPICommunicator(), &size);
+    UP_ASSERT_EQUAL(size,8);
+
+    std::shared_ptr<SystemDefinition> sysdef_1, sysdef_2;
+    std::shared_ptr<ForceComposite> rigid_1, rigid_2;
+    std::shared_ptr<IntegratorTwoStep> nve_up_1 = build_rigid_body_system(comm_creator, exec_conf, false, sysdef_1, rigid_1);
+    std::shared_ptr<IntegratorTwoStep> nve_up_2 = build_rigid_body_system(comm_creator, exec_conf, true, sysdef_2, rigid_2);
+
+    std::shared_ptr<ParticleData> pdata_1 = sysdef_1->getParticleData();
+    std::shared_ptr<ParticleData> pdata_2 = sysdef_2->getParticleData();
+    unsigned int n_global = pdata_1->getNGlobal();
+
+    unsigned int n_straddling = 0;
+    for (unsigned int step = 0; step < 200; ++step)
+        {
+        nve_up_1->update(step);
+        nve_up_2->update(step);
+
+        // the ownership of the particles is the same
+        UP_ASSERT_EQUAL(pdata_1->getN(), pdata_2->getN());
+
+        ArrayHandle<unsigned int> h_rtag_1(pdata_1->getRTags(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_pos_1(pdata_1->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation_1(pdata_1->getOrientationArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body_1(pdata_1->getBodies(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_force_1(rigid_1->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_torque_1(rigid_1->getTorqueArray(), access_location::host, access_mode::read);
+
+        ArrayHandle<unsigned int> h_rtag_2(pdata_2->getRTags(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_pos_2(pdata_2->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation_2(pdata_2->getOrientationArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body_2(pdata_2->getBodies(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_force_2(rigid_2->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_torque_2(rigid_2->getTorqueArray(), access_location::host, access_mode::read);
+
+        unsigned int nptl_1 = pdata_1->getN() + pdata_1->getNGhosts();
+        unsigned int nptl_2 = pdata_2->getN() + pdata_2->getNGhosts();
+
+        for (unsigned int tag = 0; tag < n_global; ++tag)
+            {
+            unsigned int idx_1 = h_rtag_1.data[tag];
+            unsigned int idx_2 = h_rtag_2.data[tag];
+
+            // a local particle is local in both systems
+            UP_ASSERT((idx_1 < pdata_1->getN()) == (idx_2 < pdata_2->getN()));
+
+            // every rank with a central particle has all its constituents in body center ghost mode
+            if (idx_2 < nptl_2 && h_body_2.data[idx_2] == tag)
+                {
+                for (unsigned int j = 0; j < 4; ++j)
+                    UP_ASSERT(h_rtag_2.data[n_global/5 + 4*tag + j] < nptl_2);
+                }
+
+            // the rebuilt constituents are at the positions of the communicated ones
+            if (idx_1 < nptl_1 && idx_2 < nptl_2)
+                {
+                MY_CHECK_SMALL(h_pos_1.data[idx_1].x - h_pos_2.data[idx_2].x, tol_small);
+                MY_CHECK_SMALL(h_pos_1.data[idx_1].y - h_pos_2.data[idx_2].y, tol_small);
+                MY_CHECK_SMALL(h_pos_1.data[idx_1].z - h_pos_2.data[idx_2].z, tol_small);
+                MY_CHECK_SMALL(h_orientation_1.data[idx_1].x - h_orientation_2.data[idx_2].x, tol_small);
+                MY_CHECK_SMALL(h_orientation_1.data[idx_1].w - h_orientation_2.data[idx_2].w, tol_small);
+                }
+
+            if (idx_1 >= pdata_1->getN() || h_body_1.data[idx_1] != tag)
+                continue;
+
+            // the reduced forces and torques on the local central particles are the same
+            MY_CHECK_SMALL(h_force_1.data[idx_1].x - h_force_2.data[idx_2].x, tol_small);
+            MY_CHECK_SMALL(h_force_1.data[idx_1].y - h_force_2.data[idx_2].y, tol_small);
+            MY_CHECK_SMALL(h_force_1.data[idx_1].z - h_force_2.data[idx_2].z, tol_small);
+            MY_CHECK_SMALL(h_force_1.data[idx_1].w - h_force_2.data[idx_2].w, tol_small);
+            MY_CHECK_SMALL(h_torque_1.data[idx_1].x - h_torque_2.data[idx_2].x, tol_small);
+            MY_CHECK_SMALL(h_torque_1.data[idx_1].y - h_torque_2.data[idx_2].y, tol_small);
+            MY_CHECK_SMALL(h_torque_1.data[idx_1].z - h_torque_2.data[idx_2].z, tol_small);
+
+            // count the bodies with a constituent on another rank
+            for (unsigned int j = 0; j < 4; ++j)
+                {
+                if (h_rtag_1.data[n_global/5 + 4*tag + j] >= pdata_1->getN())
+                    {
+                    n_straddling++;
+                    break;
+                    }
+                }
+            }
+        }
+
+    // some forces were reduced from other ranks
+    MPI_Allreduce(MPI_IN_PLACE, &n_straddling, 1, MPI_UNSIGNED, MPI_SUM, exec_conf->getMPICommunicator());
+    UP_ASSERT(n_straddling > 0);
+    }
+
 //! Communicator creator for unit tests
 std::shared_ptr<Communicator> base_class_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
                                                          std::shared_ptr<DomainDecomposition> decomposition)
@@ -3666,6 +3878,15 @@ UP_TEST( communicator_ghost_layer_per_type_test)
     test_communicator_ghosts_per_type(communicator_creator_base, exec_conf_cpu,BoxDim(2.0));
     }
 
+UP_TEST( communicator_body_center_ghosts_test)
+    {
+    if (!exec_conf_cpu)
+        exec_conf_cpu = std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    communicator_creator communicator_creator_base = bind(base_class_communicator_creator, _1, _2);
+    test_communicator_body_center_ghosts(communicator_creator_base, exec_conf_cpu);
+    }
+
 UP_SUITE_END();
 
 #ifdef ENABLE_HIP
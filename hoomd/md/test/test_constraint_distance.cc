@@ -0,0 +1,255 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <iostream>
+
+#include <functional>
+#include <memory>
+
+#include "hoomd/md/IntegratorTwoStep.h"
+#include "hoomd/md/TwoStepLangevin.h"
+#include "hoomd/md/ForceDistanceConstraint.h"
+#ifdef ENABLE_HIP
+#include "hoomd/md/ForceDistanceConstraintGPU.h"
+#endif
+#include "hoomd/filter/ParticleFilterAll.h"
+
+#include <math.h>
+
+using namespace std;
+using namespace std::placeholders;
+
+/*! \file test_constraint_distance.cc
+    \brief Implements unit tests for ForceDistanceConstraint and descendants
+    \ingroup unit_tests
+*/
+
+#include "hoomd/test/upp11_config.h"
+HOOMD_UP_MAIN();
+
+//! Typedef'd class factory
+typedef std::function<std::shared_ptr<ForceDistanceConstraint> (std::shared_ptr<SystemDefinition> sysdef)>
+    fdc_creator_t;
+
+//! Number of particles in the test system
+const unsigned int n_constraint_test_particles = 11;
+
+//! Build two bent chains of four particles and a triangle, all constrained to unit distances
+/*! The chains couple neighboring constraints through the shared particles, so the constraint matrix is not
+    diagonal. Use a huge box so boundary conditions don't come into play.
+*/
+std::shared_ptr<SystemDefinition> build_constraint_system(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(n_constraint_test_particles,
+        BoxDim(1000.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::readwrite);
+
+    // first chain in the xy plane
+    h_pos.data[0] = make_scalar4(0.0, 0.0, 0.0, __int_as_scalar(0));
+    h_pos.data[1] = make_scalar4(1.0, 0.0, 0.0, __int_as_scalar(0));
+    h_pos.data[2] = make_scalar4(1.5, sqrt(0.75), 0.0, __int_as_scalar(0));
+    h_pos.data[3] = make_scalar4(2.5, sqrt(0.75), 0.0, __int_as_scalar(0));
+
+    // second chain bent out of plane
+    h_pos.data[4] = make_scalar4(0.0, 5.0, 0.0, __int_as_scalar(0));
+    h_pos.data[5] = make_scalar4(0.0, 5.0, 1.0, __int_as_scalar(0));
+    h_pos.data[6] = make_scalar4(0.6, 5.0, 1.8, __int_as_scalar(0));
+    h_pos.data[7] = make_scalar4(0.6, 6.0, 1.8, __int_as_scalar(0));
+
+    // equilateral triangle
+    h_pos.data[8] = make_scalar4(-5.0, 0.0, 0.0, __int_as_scalar(0));
+    h_pos.data[9] = make_scalar4(-4.0, 0.0, 0.0, __int_as_scalar(0));
+    h_pos.data[10] = make_scalar4(-4.5, 0.0, sqrt(0.75), __int_as_scalar(0));
+
+    // give every particle a different velocity so that all constraints carry a force
+    for (unsigned int i = 0; i < n_constraint_test_particles; ++i)
+        {
+        h_vel.data[i] = make_scalar4(0.3*cos(Scalar(i)), 0.2*sin(Scalar(2*i)), -0.25*cos(Scalar(3*i+1)),
+            Scalar(1.0 + 0.1*i));
+        }
+    }
+
+    std::shared_ptr<ConstraintData> cdata = sysdef->getConstraintData();
+    cdata->addBondedGroup(Constraint(1.0, 0, 1));
+    cdata->addBondedGroup(Constraint(1.0, 1, 2));
+    cdata->addBondedGroup(Constraint(1.0, 2, 3));
+    cdata->addBondedGroup(Constraint(1.0, 4, 5));
+    cdata->addBondedGroup(Constraint(1.0, 5, 6));
+    cdata->addBondedGroup(Constraint(1.0, 6, 7));
+    cdata->addBondedGroup(Constraint(1.0, 8, 9));
+    cdata->addBondedGroup(Constraint(1.0, 9, 10));
+    cdata->addBondedGroup(Constraint(1.0, 10, 8));
+
+    return sysdef;
+    }
+
+//! Check that every constraint distance in the system is within tolerance of its target
+void check_constraint_distances(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    std::shared_ptr<ConstraintData> cdata = sysdef->getConstraintData();
+    const BoxDim& box = pdata->getBox();
+
+    for (unsigned int n = 0; n < cdata->getN(); ++n)
+        {
+        const ConstraintData::members_t constraint = cdata->getMembersByIndex(n);
+        Scalar d = cdata->getValueByIndex(n);
+
+        vec3<Scalar> rn = box.minImage(vec3<Scalar>(pdata->getPosition(constraint.tag[0]))
+            - vec3<Scalar>(pdata->getPosition(constraint.tag[1])));
+        MY_CHECK_CLOSE(sqrt(dot(rn,rn)), d, tol);
+        }
+    }
+
+//! Compare the constraint forces from the LU and the iterative solver on the same configuration
+void constraint_distance_solver_test(fdc_creator_t fdc_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef = build_constraint_system(exec_conf);
+
+    std::shared_ptr<ForceDistanceConstraint> fdc_lu = fdc_creator(sysdef);
+    std::shared_ptr<ForceDistanceConstraint> fdc_iter = fdc_creator(sysdef);
+    fdc_iter->setIterative(true);
+    UP_ASSERT(!fdc_lu->getIterative());
+    UP_ASSERT(fdc_iter->getIterative());
+
+    fdc_lu->setDeltaT(Scalar(0.005));
+    fdc_iter->setDeltaT(Scalar(0.005));
+
+    // solve twice, so that the iterative solver also starts from its previous solution
+    for (unsigned int timestep = 0; timestep < 2; ++timestep)
+        {
+        fdc_lu->compute(timestep);
+        fdc_iter->compute(timestep);
+
+        ArrayHandle<Scalar4> h_force_lu(fdc_lu->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_force_iter(fdc_iter->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial_lu(fdc_lu->getVirialArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial_iter(fdc_iter->getVirialArray(), access_location::host, access_mode::read);
+        unsigned int pitch_lu = fdc_lu->getVirialArray().getPitch();
+        unsigned int pitch_iter = fdc_iter->getVirialArray().getPitch();
+
+        Scalar3 f_total = make_scalar3(0.0, 0.0, 0.0);
+        for (unsigned int i = 0; i < n_constraint_test_particles; ++i)
+            {
+            MY_CHECK_SMALL(h_force_lu.data[i].x - h_force_iter.data[i].x, tol_small);
+            MY_CHECK_SMALL(h_force_lu.data[i].y - h_force_iter.data[i].y, tol_small);
+            MY_CHECK_SMALL(h_force_lu.data[i].z - h_force_iter.data[i].z, tol_small);
+
+            for (unsigned int j = 0; j < 6; ++j)
+                MY_CHECK_SMALL(h_virial_lu.data[j*pitch_lu+i] - h_virial_iter.data[j*pitch_iter+i], tol_small);
+
+            f_total.x += h_force_lu.data[i].x;
+            f_total.y += h_force_lu.data[i].y;
+            f_total.z += h_force_lu.data[i].z;
+            }
+
+        // constraint forces are internal, but they do not vanish
+        MY_CHECK_SMALL(f_total.x, tol_small);
+        MY_CHECK_SMALL(f_total.y, tol_small);
+        MY_CHECK_SMALL(f_total.z, tol_small);
+        UP_ASSERT(fabs(h_force_lu.data[0].x) + fabs(h_force_lu.data[0].y) + fabs(h_force_lu.data[0].z) > tol_small);
+        }
+    }
+
+//! Run a Langevin simulation with either solver and verify that the constraints stay satisfied
+void constraint_distance_integrate_test(fdc_creator_t fdc_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    Scalar deltaT = Scalar(0.005);
+    Scalar Temp = Scalar(1.0);
+    std::shared_ptr<VariantConstant> T_variant(new VariantConstant(Temp));
+    std::shared_ptr<ParticleFilter> selector_all(new ParticleFilterAll());
+
+    // integrate identical systems with the same random number seed, one for each solver
+    std::shared_ptr<SystemDefinition> sysdef_lu = build_constraint_system(exec_conf);
+    std::shared_ptr<ParticleGroup> group_all_lu(new ParticleGroup(sysdef_lu, selector_all));
+    std::shared_ptr<TwoStepLangevin> two_step_lu(new TwoStepLangevin(sysdef_lu, group_all_lu, T_variant, 123));
+    std::shared_ptr<IntegratorTwoStep> integrator_lu(new IntegratorTwoStep(sysdef_lu, deltaT));
+    integrator_lu->addIntegrationMethod(two_step_lu);
+    std::shared_ptr<ForceDistanceConstraint> fdc_lu = fdc_creator(sysdef_lu);
+    integrator_lu->addForceConstraint(fdc_lu);
+    integrator_lu->prepRun(0);
+
+    std::shared_ptr<SystemDefinition> sysdef_iter = build_constraint_system(exec_conf);
+    std::shared_ptr<ParticleGroup> group_all_iter(new ParticleGroup(sysdef_iter, selector_all));
+    std::shared_ptr<TwoStepLangevin> two_step_iter(new TwoStepLangevin(sysdef_iter, group_all_iter, T_variant, 123));
+    std::shared_ptr<IntegratorTwoStep> integrator_iter(new IntegratorTwoStep(sysdef_iter, deltaT));
+    integrator_iter->addIntegrationMethod(two_step_iter);
+    std::shared_ptr<ForceDistanceConstraint> fdc_iter = fdc_creator(sysdef_iter);
+    fdc_iter->setIterative(true);
+    integrator_iter->addForceConstraint(fdc_iter);
+    integrator_iter->prepRun(0);
+
+    std::shared_ptr<ParticleData> pdata_lu = sysdef_lu->getParticleData();
+    std::shared_ptr<ParticleData> pdata_iter = sysdef_iter->getParticleData();
+
+    for (unsigned int i = 0; i < 1000; i++)
+        {
+        integrator_lu->update(i);
+        integrator_iter->update(i);
+
+        check_constraint_distances(sysdef_lu);
+        check_constraint_distances(sysdef_iter);
+        }
+
+    // both solvers follow the same trajectory
+    for (unsigned int j = 0; j < n_constraint_test_particles; j++)
+        {
+        Scalar3 pos_lu = pdata_lu->getPosition(j);
+        Scalar3 pos_iter = pdata_iter->getPosition(j);
+        MY_CHECK_SMALL(pos_lu.x - pos_iter.x, tol_small);
+        MY_CHECK_SMALL(pos_lu.y - pos_iter.y, tol_small);
+        MY_CHECK_SMALL(pos_lu.z - pos_iter.z, tol_small);
+        }
+    }
+
+//! ForceDistanceConstraint factory for the unit tests
+std::shared_ptr<ForceDistanceConstraint> base_class_fdc_creator(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    return std::shared_ptr<ForceDistanceConstraint>(new ForceDistanceConstraint(sysdef));
+    }
+
+#ifdef ENABLE_HIP
+//! ForceDistanceConstraintGPU factory for the unit tests
+std::shared_ptr<ForceDistanceConstraint> gpu_fdc_creator(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    return std::shared_ptr<ForceDistanceConstraint>(new ForceDistanceConstraintGPU(sysdef));
+    }
+#endif
+
+//! Compare the solvers in the base class
+UP_TEST( ForceDistanceConstraint_solver )
+    {
+    fdc_creator_t fdc_creator = bind(base_class_fdc_creator, _1);
+    constraint_distance_solver_test(fdc_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! Integrate with both solvers in the base class
+UP_TEST( ForceDistanceConstraint_integrate )
+    {
+    fdc_creator_t fdc_creator = bind(base_class_fdc_creator, _1);
+    constraint_distance_integrate_test(fdc_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+#ifdef ENABLE_HIP
+//! Compare the solvers in the GPU class
+UP_TEST( ForceDistanceConstraintGPU_solver )
+    {
+    fdc_creator_t fdc_creator = bind(gpu_fdc_creator, _1);
+    constraint_distance_solver_test(fdc_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+
+//! Integrate with both solvers in the GPU class
+UP_TEST( ForceDistanceConstraintGPU_integrate )
+    {
+    fdc_creator_t fdc_creator = bind(gpu_fdc_creator, _1);
+    constraint_distance_integrate_test(fdc_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+#endif
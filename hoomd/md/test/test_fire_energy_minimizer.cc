@@ -10,6 +10,8 @@
 #include <functional>
 
 #include "hoomd/md/FIREEnergyMinimizer.h"
+#include "hoomd/md/LBFGSEnergyMinimizer.h"
+#include "hoomd/md/CGEnergyMinimizer.h"
 
 #ifdef ENABLE_HIP
 #include "hoomd/md/FIREEnergyMinimizerGPU.h"
@@ -34,6 +36,8 @@ HOOMD_UP_MAIN();
 //! Typedef'd FIREEnergyMinimizer class factory
 typedef std::function<std::shared_ptr<FIREEnergyMinimizer> (std::shared_ptr<SystemDefinition> sysdef, Scalar dT)> fire_creator;
 typedef std::function<std::shared_ptr<TwoStepNVE> (std::shared_ptr<SystemDefinition> sysdef, std::shared_ptr<ParticleGroup> group)> nve_creator;
+//! Typedef'd LineSearchEnergyMinimizer class factory
+typedef std::function<std::shared_ptr<LineSearchEnergyMinimizer> (std::shared_ptr<SystemDefinition> sysdef, Scalar max_move)> line_search_creator;
 
 //! FIREEnergyMinimizer creator
 std::shared_ptr<FIREEnergyMinimizer> base_class_fire_creator(std::shared_ptr<SystemDefinition> sysdef, Scalar dt)
@@ -41,6 +45,18 @@ std::shared_ptr<FIREEnergyMinimizer> base_class_fire_creator(std::shared_ptr<Sys
     return std::shared_ptr<FIREEnergyMinimizer>(new FIREEnergyMinimizer(sysdef, dt));
     }
 
+//! LBFGSEnergyMinimizer creator
+std::shared_ptr<LineSearchEnergyMinimizer> lbfgs_creator(std::shared_ptr<SystemDefinition> sysdef, Scalar max_move)
+    {
+    return std::shared_ptr<LineSearchEnergyMinimizer>(new LBFGSEnergyMinimizer(sysdef, max_move));
+    }
+
+//! CGEnergyMinimizer creator
+std::shared_ptr<LineSearchEnergyMinimizer> cg_creator(std::shared_ptr<SystemDefinition> sysdef, Scalar max_move)
+    {
+    return std::shared_ptr<LineSearchEnergyMinimizer>(new CGEnergyMinimizer(sysdef, max_move));
+    }
+
 //! TwoStepNVE factory for the unit tests
 std::shared_ptr<TwoStepNVE> base_class_nve_creator(std::shared_ptr<SystemDefinition> sysdef, std::shared_ptr<ParticleGroup> group)
     {
@@ -59,6 +75,14 @@ std::shared_ptr<FIREEnergyMinimizer> gpu_fire_creator(std::shared_ptr<SystemDefi
     {
     return std::shared_ptr<FIREEnergyMinimizer>(new FIREEnergyMinimizerGPU(sysdef, dt));
     }
+
+//! FIREEnergyMinimizerGPU creator that keeps the FIRE state on the device
+std::shared_ptr<FIREEnergyMinimizer> gpu_fire_check_period_creator(std::shared_ptr<SystemDefinition> sysdef, Scalar dt)
+    {
+    std::shared_ptr<FIREEnergyMinimizerGPU> fire(new FIREEnergyMinimizerGPU(sysdef, dt));
+    fire->setCheckPeriod(10);
+    return fire;
+    }
 #endif
 
 
@@ -509,6 +533,98 @@ void fire_twoparticle_test(fire_creator fire_creator1, nve_creator nve_creator1,
 
     }
 
+//! Minimizes the small system with a line search minimizer
+void line_search_smallsystem_test(line_search_creator creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 260;
+    Scalar rho(Scalar(1.2));
+    Scalar L = Scalar(pow((double)(N/rho), 1.0/3.0));
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N, BoxDim(L, L, L), 2, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    for (unsigned int i=0; i<N; i++)
+        {
+        Scalar3 pos = make_scalar3(x_blj[i*3 + 0],x_blj[i*3 + 1],x_blj[i*3 + 2]);
+        pdata->setPosition(i,pos);
+        if (i<(unsigned int)N*0.8)
+            pdata->setType(i,0);
+        else
+            pdata->setType(i,1);
+        }
+
+    std::shared_ptr<ParticleFilter> selector_all(new ParticleFilterAll());
+    std::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+
+    std::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(2.5), Scalar(0.3)));
+    std::shared_ptr<PotentialPairLJ> fc(new PotentialPairLJ(sysdef, nlist));
+    fc->setParams(0,0,EvaluatorPairLJ::param_type(Scalar(1.0),Scalar(1.0)));
+    fc->setRcut(0,0,2.5);
+    fc->setParams(0,1,EvaluatorPairLJ::param_type(Scalar(0.8),Scalar(1.5)));
+    fc->setRcut(0,1,2.5);
+    fc->setParams(1,1,EvaluatorPairLJ::param_type(Scalar(0.88),Scalar(0.5)));
+    fc->setRcut(1,1,2.5);
+    fc->setShiftMode(PotentialPairLJ::shift);
+
+    std::shared_ptr<TwoStepNVE> nve(new TwoStepNVE(sysdef, group_all));
+    std::shared_ptr<LineSearchEnergyMinimizer> minimizer = creator(sysdef, Scalar(0.1));
+    minimizer->addIntegrationMethod(nve);
+    minimizer->setFtol(Scalar(1e-3));
+    minimizer->setEtol(Scalar(1e-7));
+    minimizer->addForceCompute(fc);
+    minimizer->prepRun(0);
+
+    int max_step = 5000;
+    for (int i = 1; i<=max_step; i++)
+        {
+        minimizer->update(i);
+        if (minimizer->hasConverged())
+            break;
+        }
+
+    // the tight force tolerance relaxes the system further than the FIRE test above
+    UP_ASSERT(minimizer->hasConverged());
+    MY_CHECK_CLOSE(minimizer->getEnergy()/Scalar(N), -7.783, (0.01/7.783)*100);
+    }
+
+//! Moves a single particle to the minimum of the LJ potential of a fixed particle
+void line_search_twoparticle_test(line_search_creator creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 2;
+    Scalar L = Scalar(20);
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N, BoxDim(L, L, L), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    pdata->setPosition(0,make_scalar3(0.0,0.0,0.0));
+    pdata->setPosition(1,make_scalar3(2.0,0.0,0.0));
+
+    std::shared_ptr<ParticleFilter> selector_one(new ParticleFilterTags(std::vector<unsigned int>({1})));
+    std::shared_ptr<ParticleGroup> group_one(new ParticleGroup(sysdef, selector_one));
+
+    std::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(3.0), Scalar(0.3)));
+    std::shared_ptr<PotentialPairLJ> fc(new PotentialPairLJ(sysdef, nlist));
+    fc->setParams(0,0,EvaluatorPairLJ::param_type(Scalar(1.0),Scalar(1.0)));
+    fc->setRcut(0,0,3.0);
+
+    std::shared_ptr<TwoStepNVE> nve(new TwoStepNVE(sysdef, group_one));
+    std::shared_ptr<LineSearchEnergyMinimizer> minimizer = creator(sysdef, Scalar(0.1));
+    minimizer->addIntegrationMethod(nve);
+    minimizer->addForceCompute(fc);
+    minimizer->setFtol(Scalar(1e-5));
+    minimizer->setEtol(Scalar(1e-10));
+    minimizer->prepRun(0);
+
+    for (int i = 1; i<=1000; i++)
+        {
+        minimizer->update(i);
+        if (minimizer->hasConverged())
+            break;
+        }
+
+    UP_ASSERT(minimizer->hasConverged());
+    MY_CHECK_CLOSE(pdata->getPosition(1).x, pow(2.0, 1.0/6.0), tol_small);
+    MY_CHECK_SMALL(pdata->getPosition(0).x, tol_small);
+    }
+
 //! Sees if a single particle's trajectory is being calculated correctly
 UP_TEST( FIREEnergyMinimizer_twoparticle_test )
     {
@@ -521,6 +637,30 @@ UP_TEST( FIREEnergyMinimizer_smallsystem_test )
     fire_smallsystem_test(base_class_fire_creator, base_class_nve_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! Moves a single particle to the LJ minimum with L-BFGS
+UP_TEST( LBFGSEnergyMinimizer_twoparticle_test )
+    {
+    line_search_twoparticle_test(lbfgs_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! Checks the energy of the minimum LBFGSEnergyMinimizer finds in the small system
+UP_TEST( LBFGSEnergyMinimizer_smallsystem_test )
+    {
+    line_search_smallsystem_test(lbfgs_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! Moves a single particle to the LJ minimum with conjugate gradients
+UP_TEST( CGEnergyMinimizer_twoparticle_test )
+    {
+    line_search_twoparticle_test(cg_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! Checks the energy of the minimum CGEnergyMinimizer finds in the small system
+UP_TEST( CGEnergyMinimizer_smallsystem_test )
+    {
+    line_search_smallsystem_test(cg_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_HIP
 //! Sees if a single particle's trajectory is being calculated correctly
 UP_TEST( FIREEnergyMinimizerGPU_twoparticle_test )
@@ -533,4 +673,10 @@ UP_TEST( FIREEnergyMinimizerGPU_smallsystem_test )
     {
     fire_smallsystem_test(gpu_fire_creator, gpu_nve_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
+
+//! Checks that FIREEnergyMinimizerGPU reaches the same minimum with the FIRE state on the device
+UP_TEST( FIREEnergyMinimizerGPU_check_period_test )
+    {
+    fire_smallsystem_test(gpu_fire_check_period_creator, gpu_nve_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
 #endif
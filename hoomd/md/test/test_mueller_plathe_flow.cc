@@ -0,0 +1,204 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+#ifdef ENABLE_MPI
+
+// this has to be included after naming the test module
+#include "hoomd/test/upp11_config.h"
+HOOMD_UP_MAIN()
+
+#include "hoomd/System.h"
+#include "hoomd/HOOMDMPI.h"
+
+#include <memory>
+#include <functional>
+
+#include "hoomd/md/MuellerPlatheFlow.h"
+#ifdef ENABLE_HIP
+#include "hoomd/md/MuellerPlatheFlowGPU.h"
+#endif
+#include "hoomd/filter/ParticleFilterAll.h"
+
+using namespace std;
+using namespace std::placeholders;
+
+/*! \file test_mueller_plathe_flow.cc
+    \brief Implements unit tests for the exchange modes of MuellerPlatheFlow
+    \ingroup unit_tests
+*/
+
+//! Typedef'd class factory
+typedef std::function<std::shared_ptr<MuellerPlatheFlow> (std::shared_ptr<SystemDefinition> sysdef,
+                                                          std::shared_ptr<ParticleGroup> group,
+                                                          std::shared_ptr<Variant> flow_target)> mpf_creator_t;
+
+//! Number of slabs along z, one layer of particles per slab
+const unsigned int n_flow_slabs = 20;
+//! Number of particles in each slab
+const unsigned int n_flow_per_slab = 16;
+
+//! Build a 2x1x4 decomposed system of 20 layers of 4x4 particles along z
+/*! Layer k sits in the middle of slab k. The min slab 0 and the max slab 10 are on the domains 0 and 2 along z,
+    so the ranks of the domains 1 and 3 have no slab. Every particle has a different momentum along x.
+*/
+std::shared_ptr<SystemDefinition> build_flow_system(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(n_flow_slabs*n_flow_per_slab,
+                                                                  BoxDim(10.0),  // box dimensions
+                                                                  1,             // number of particle types
+                                                                  0,             // number of bond types
+                                                                  0,             // number of angle types
+                                                                  0,             // number of dihedral types
+                                                                  0,             // number of improper types
+                                                                  exec_conf));
+    std::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::readwrite);
+
+        for (unsigned int i = 0; i < pdata->getN(); ++i)
+            {
+            unsigned int k = i / n_flow_per_slab;
+            unsigned int j = i % n_flow_per_slab;
+            h_pos.data[i] = make_scalar4(-3.75 + 2.5*(j%4), -3.75 + 2.5*(j/4), -4.75 + 0.5*k, __int_as_scalar(0));
+            h_vel.data[i] = make_scalar4(0.1*sin(2.4*i), 0.1*cos(1.7*i), 0.1*sin(0.9*i+0.3), 1.0 + 0.5*(i%3));
+            }
+        }
+
+    SnapshotParticleData<Scalar> snap(n_flow_slabs*n_flow_per_slab);
+    pdata->takeSnapshot(snap);
+
+    std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, pdata->getBox().getL(),2,1,4));
+    pdata->setDomainDecomposition(decomposition);
+    pdata->initializeFromSnapshot(snap);
+
+    return sysdef;
+    }
+
+//! Sum the momentum along x of the particles in one slab
+Scalar slab_momentum(std::shared_ptr<ParticleData> pdata, unsigned int slab)
+    {
+    Scalar p = 0;
+    for (unsigned int i = slab*n_flow_per_slab; i < (slab+1)*n_flow_per_slab; ++i)
+        p += pdata->getMass(i)*pdata->getVelocity(i).x;
+    return p;
+    }
+
+//! Compare the local exchange with the default exchange and check the momentum accounting of both
+void mueller_plathe_local_exchange_test(mpf_creator_t mpf_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = n_flow_slabs*n_flow_per_slab;
+    const Scalar area = 100.0;
+
+    // ramp the target flow, so that each step takes a few swaps
+    std::shared_ptr<Variant> flow_target(new VariantRamp(0.0, 0.012, 0, 3));
+    std::shared_ptr<ParticleFilter> selector_all(new ParticleFilterAll());
+
+    std::shared_ptr<SystemDefinition> sysdef_global = build_flow_system(exec_conf);
+    std::shared_ptr<ParticleData> pdata_global = sysdef_global->getParticleData();
+    std::shared_ptr<ParticleGroup> group_global(new ParticleGroup(sysdef_global, selector_all));
+    std::shared_ptr<MuellerPlatheFlow> mpf_global = mpf_creator(sysdef_global, group_global, flow_target);
+    mpf_global->set_flow_epsilon(2.5e-3);
+
+    std::shared_ptr<SystemDefinition> sysdef_local = build_flow_system(exec_conf);
+    std::shared_ptr<ParticleData> pdata_local = sysdef_local->getParticleData();
+    std::shared_ptr<ParticleGroup> group_local(new ParticleGroup(sysdef_local, selector_all));
+    std::shared_ptr<MuellerPlatheFlow> mpf_local = mpf_creator(sysdef_local, group_local, flow_target);
+    mpf_local->set_flow_epsilon(2.5e-3);
+    mpf_local->set_local_exchange(true);
+    UP_ASSERT(!mpf_global->get_local_exchange());
+    UP_ASSERT(mpf_local->get_local_exchange());
+
+    // the ranks of half of the domains have neither slab
+    unsigned int n_ranks_with_slab = (mpf_local->has_min_slab() || mpf_local->has_max_slab()) ? 1 : 0;
+    MPI_Allreduce(MPI_IN_PLACE, &n_ranks_with_slab, 1, MPI_UNSIGNED, MPI_SUM, exec_conf->getMPICommunicator());
+    UP_ASSERT_EQUAL(n_ranks_with_slab, exec_conf->getNRanks()/2);
+
+    Scalar p_total = 0;
+    for (unsigned int i = 0; i < N; ++i)
+        p_total += pdata_local->getMass(i)*pdata_local->getVelocity(i).x;
+
+    Scalar exchanged_old = 0;
+    for (unsigned int timestep = 0; timestep < 5; ++timestep)
+        {
+        Scalar p_min_old = slab_momentum(pdata_local, 0);
+        Scalar p_max_old = slab_momentum(pdata_local, 10);
+
+        mpf_global->update(timestep);
+        mpf_local->update(timestep);
+
+        // every rank agrees on the exchanged momentum, also those without a slab
+        Scalar exchanged = mpf_local->summed_exchanged_momentum();
+        Scalar exchanged_root = exchanged;
+        bcast(exchanged_root, 0, exec_conf->getMPICommunicator());
+        MY_CHECK_SMALL(exchanged - exchanged_root, tol_small);
+        MY_CHECK_SMALL(exchanged - mpf_global->summed_exchanged_momentum(), tol_small);
+
+        // the target is reachable with this velocity distribution
+        MY_CHECK_SMALL(exchanged/area - (*flow_target)(timestep), Scalar(2.5e-3));
+
+        // the momentum taken from the max slab arrives in the min slab and is counted once
+        Scalar delta = exchanged - exchanged_old;
+        MY_CHECK_SMALL(slab_momentum(pdata_local, 0) - p_min_old - delta, tol_small);
+        MY_CHECK_SMALL(slab_momentum(pdata_local, 10) - p_max_old + delta, tol_small);
+        if (timestep > 0 && timestep < 4)
+            UP_ASSERT(delta > 0);
+        exchanged_old = exchanged;
+
+        // both modes swap the same particles
+        Scalar p_total_new = 0;
+        for (unsigned int i = 0; i < N; ++i)
+            {
+            Scalar3 v_global = pdata_global->getVelocity(i);
+            Scalar3 v_local = pdata_local->getVelocity(i);
+            MY_CHECK_SMALL(v_global.x - v_local.x, tol_small);
+            MY_CHECK_SMALL(v_global.y - v_local.y, tol_small);
+            MY_CHECK_SMALL(v_global.z - v_local.z, tol_small);
+
+            p_total_new += pdata_local->getMass(i)*v_local.x;
+            }
+        MY_CHECK_SMALL(p_total_new - p_total, tol_small);
+        }
+    }
+
+//! MuellerPlatheFlow factory for the unit tests
+std::shared_ptr<MuellerPlatheFlow> base_class_mpf_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                          std::shared_ptr<ParticleGroup> group,
+                                                          std::shared_ptr<Variant> flow_target)
+    {
+    return std::shared_ptr<MuellerPlatheFlow>(new MuellerPlatheFlow(sysdef, group, flow_target,
+        flow_enum::Z, flow_enum::X, n_flow_slabs, 0, 10));
+    }
+
+#ifdef ENABLE_HIP
+//! MuellerPlatheFlowGPU factory for the unit tests
+std::shared_ptr<MuellerPlatheFlow> gpu_mpf_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                   std::shared_ptr<ParticleGroup> group,
+                                                   std::shared_ptr<Variant> flow_target)
+    {
+    return std::shared_ptr<MuellerPlatheFlow>(new MuellerPlatheFlowGPU(sysdef, group, flow_target,
+        flow_enum::Z, flow_enum::X, n_flow_slabs, 0, 10));
+    }
+#endif
+
+//! Local exchange test for the base class
+UP_TEST( MuellerPlatheFlow_local_exchange )
+    {
+    mpf_creator_t mpf_creator = bind(base_class_mpf_creator, _1, _2, _3);
+    mueller_plathe_local_exchange_test(mpf_creator,
+        std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+#ifdef ENABLE_HIP
+//! Local exchange test for the GPU class
+UP_TEST( MuellerPlatheFlowGPU_local_exchange )
+    {
+    mpf_creator_t mpf_creator = bind(gpu_mpf_creator, _1, _2, _3);
+    mueller_plathe_local_exchange_test(mpf_creator,
+        std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+#endif
+
+#endif //ENABLE_MPI
@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include <algorithm>
+#include <set>
 
 #include <memory>
 
@@ -1431,6 +1432,437 @@ void neighborlist_2d_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
         }
     }
 
+//! Build a perturbed simple cubic lattice of 1000 particles with diameters between 0.9 and 1.1
+std::shared_ptr<SystemDefinition> build_partial_rebuild_system(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int n = 10;
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(n*n*n, BoxDim(Scalar(n)), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_diameter(pdata->getDiameters(), access_location::host, access_mode::readwrite);
+
+        for (unsigned int i = 0; i < pdata->getN(); ++i)
+            {
+            unsigned int ix = i % n;
+            unsigned int iy = (i / n) % n;
+            unsigned int iz = i / (n*n);
+            h_pos.data[i] = make_scalar4(-0.5*n + ix + 0.5 + 0.05*sin(1.1*i),
+                                         -0.5*n + iy + 0.5 + 0.05*sin(2.3*i+1.0),
+                                         -0.5*n + iz + 0.5 + 0.05*sin(0.7*i+2.0),
+                                         __int_as_scalar(0));
+            h_diameter.data[i] = 0.9 + 0.02*((i*7) % 11);
+            }
+        }
+    pdata->notifyParticleSort();
+
+    return sysdef;
+    }
+
+//! Test if the distance of i and j is within the (shifted) cutoff
+bool partial_rebuild_in_range(std::shared_ptr<ParticleData> pdata, bool diameter_shift, Scalar r_cut,
+                              unsigned int i, unsigned int j)
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(pdata->getDiameters(), access_location::host, access_mode::read);
+
+    Scalar3 dx = make_scalar3(h_pos.data[i].x - h_pos.data[j].x,
+                              h_pos.data[i].y - h_pos.data[j].y,
+                              h_pos.data[i].z - h_pos.data[j].z);
+    dx = pdata->getBox().minImage(dx);
+
+    Scalar r = r_cut;
+    if (diameter_shift)
+        r += (h_diameter.data[i] + h_diameter.data[j])/Scalar(2.0) - Scalar(1.0);
+    return dot(dx, dx) <= r*r;
+    }
+
+//! Move the fast particles by more than half of the buffer and all other particles by less
+void partial_rebuild_move(std::shared_ptr<ParticleData> pdata, const std::vector<unsigned int>& fast_particles,
+                          unsigned int step)
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<int3> h_image(pdata->getImages(), access_location::host, access_mode::readwrite);
+    const BoxDim& box = pdata->getBox();
+
+    for (unsigned int i = 0; i < pdata->getN(); ++i)
+        {
+        Scalar3 dx = make_scalar3(0.04*sin(Scalar(i+step)), 0.04*cos(Scalar(2*i+step)), 0.03);
+        if (std::find(fast_particles.begin(), fast_particles.end(), i) != fast_particles.end())
+            dx = make_scalar3(0.5, -0.3*step, 0.2);
+
+        Scalar3 pos = make_scalar3(h_pos.data[i].x + dx.x, h_pos.data[i].y + dx.y, h_pos.data[i].z + dx.z);
+        box.wrap(pos, h_image.data[i]);
+        h_pos.data[i].x = pos.x; h_pos.data[i].y = pos.y; h_pos.data[i].z = pos.z;
+        }
+    }
+
+//! Tests that the partial rebuild of the lists around fast particles agrees with a full rebuild
+/*! Both lists are built at step 0. The next two steps move a dozen particles far and all others a little, so that
+    the list with partial rebuilds only rebuilds around the fast particles. Within the (diameter shifted) cutoff,
+    each particle must then have exactly the neighbors of the full rebuild. Entries beyond the cutoff may differ,
+    but no list may hold an excluded pair or a duplicate.
+*/
+template <class NL>
+void neighborlist_partial_rebuild_tests(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                        NeighborList::storageMode mode, bool diameter_shift)
+    {
+    std::shared_ptr<SystemDefinition> sysdef = build_partial_rebuild_system(exec_conf);
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    const Scalar r_cut_value = 1.1;
+
+    std::shared_ptr<NeighborList> nlist_partial(new NL(sysdef, r_cut_value, 0.4));
+    std::shared_ptr<NeighborList> nlist_full(new NL(sysdef, r_cut_value, 0.4));
+    auto r_cut = std::make_shared<GlobalArray<Scalar>>(nlist_partial->getTypePairIndexer().getNumElements(),
+                                               exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut(*r_cut, access_location::host, access_mode::overwrite);
+        h_r_cut.data[0] = r_cut_value;
+        }
+    nlist_partial->addRCutMatrix(r_cut);
+    nlist_full->addRCutMatrix(r_cut);
+
+    nlist_partial->setStorageMode(mode);
+    nlist_full->setStorageMode(mode);
+    if (diameter_shift)
+        {
+        nlist_partial->setDiameterShift(true);
+        nlist_partial->setMaximumDiameter(1.1);
+        nlist_full->setDiameterShift(true);
+        nlist_full->setMaximumDiameter(1.1);
+        }
+
+    // exclude neighbors along x that the lattice places within the cutoff
+    for (unsigned int i = 0; i < pdata->getN()-1; i += 2)
+        {
+        nlist_partial->addExclusion(i, i+1);
+        nlist_full->addExclusion(i, i+1);
+        }
+
+    nlist_partial->setPartialRebuild(true);
+    UP_ASSERT(nlist_partial->getPartialRebuild());
+    UP_ASSERT(!nlist_full->getPartialRebuild());
+
+    nlist_partial->compute(0);
+    nlist_full->compute(0);
+
+    for (unsigned int step = 1; step <= 2; ++step)
+        {
+        // fast particles spaced far apart on the lattice, their neighbors along x in the second step
+        std::vector<unsigned int> fast_particles;
+        for (unsigned int ix = 0; ix < 10; ix += 4)
+            for (unsigned int iy = 1; iy < 10; iy += 4)
+                for (unsigned int iz = 2; iz < 10; iz += 4)
+                    fast_particles.push_back(ix + step - 1 + 10*(iy + 10*iz));
+
+        partial_rebuild_move(pdata, fast_particles, step);
+
+        nlist_partial->compute(step);
+        nlist_full->compute(step);
+
+        // the partial path ran on the list that allows it, the other list was built from scratch
+        UP_ASSERT(nlist_partial->getNumPartialUpdates() == step);
+        UP_ASSERT(nlist_full->getNumPartialUpdates() == 0);
+
+            {
+            ArrayHandle<unsigned int> h_n_neigh_p(nlist_partial->getNNeighArray(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_nlist_p(nlist_partial->getNListArray(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_head_list_p(nlist_partial->getHeadList(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_n_neigh_f(nlist_full->getNNeighArray(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_nlist_f(nlist_full->getNListArray(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_head_list_f(nlist_full->getHeadList(), access_location::host, access_mode::read);
+
+            for (unsigned int i = 0; i < pdata->getN(); ++i)
+                {
+                std::vector<unsigned int> all_p(h_nlist_p.data + h_head_list_p.data[i],
+                                                h_nlist_p.data + h_head_list_p.data[i] + h_n_neigh_p.data[i]);
+                std::sort(all_p.begin(), all_p.end());
+                UP_ASSERT(std::adjacent_find(all_p.begin(), all_p.end()) == all_p.end());
+
+                std::vector<unsigned int> in_range_p, in_range_f;
+                for (unsigned int j : all_p)
+                    {
+                    UP_ASSERT(!(i % 2 == 0 && j == i+1) && !(j % 2 == 0 && i == j+1));
+                    if (mode == NeighborList::half)
+                        UP_ASSERT(i < j);
+                    if (partial_rebuild_in_range(pdata, diameter_shift, r_cut_value, i, j))
+                        in_range_p.push_back(j);
+                    }
+                for (unsigned int k = 0; k < h_n_neigh_f.data[i]; ++k)
+                    {
+                    unsigned int j = h_nlist_f.data[h_head_list_f.data[i] + k];
+                    if (partial_rebuild_in_range(pdata, diameter_shift, r_cut_value, i, j))
+                        in_range_f.push_back(j);
+                    }
+                std::sort(in_range_f.begin(), in_range_f.end());
+
+                UP_ASSERT_EQUAL(in_range_p.size(), in_range_f.size());
+                UP_ASSERT(in_range_p == in_range_f);
+                }
+            }
+        }
+    }
+
+//! Neighbor list that leaves the exclusions to filterNlist() after the build, as before they were applied in the build
+template <class NL>
+class NeighborListPostFilter : public NL
+    {
+    public:
+        //! Construct the neighbor list and disable the exclusions in the build
+        NeighborListPostFilter(std::shared_ptr<SystemDefinition> sysdef, Scalar r_cut, Scalar r_buff)
+            : NL(sysdef, r_cut, r_buff)
+            {
+            this->m_build_applies_exclusions = false;
+            }
+    };
+
+//! Build an 8x8x8 lattice of chains along x that are bonded, with angles and dihedrals, and constrained along z
+/*! The rows with even y carry the angles and dihedrals of their chain. The particles at x = 3 are constrained to
+    their neighbors along z. All excluded pairs are within 3 lattice spacings.
+*/
+std::shared_ptr<SystemDefinition> build_topology_system(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int n = 8;
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(n*n*n, BoxDim(Scalar(n)), 1, 1, 1, 1, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+
+        for (unsigned int i = 0; i < pdata->getN(); ++i)
+            {
+            unsigned int ix = i % n;
+            unsigned int iy = (i / n) % n;
+            unsigned int iz = i / (n*n);
+            h_pos.data[i] = make_scalar4(-0.5*n + ix + 0.5 + 0.02*sin(1.3*i),
+                                         -0.5*n + iy + 0.5 + 0.02*sin(2.1*i+1.0),
+                                         -0.5*n + iz + 0.5 + 0.02*sin(0.9*i+2.0),
+                                         __int_as_scalar(0));
+            }
+        }
+    pdata->notifyParticleSort();
+
+    for (unsigned int i = 0; i < pdata->getN(); ++i)
+        {
+        unsigned int ix = i % n;
+        unsigned int iy = (i / n) % n;
+        unsigned int iz = i / (n*n);
+        if (ix < n-1)
+            sysdef->getBondData()->addBondedGroup(Bond(0, i, i+1));
+        if (iy % 2 == 0 && ix < n-2)
+            sysdef->getAngleData()->addBondedGroup(Angle(0, i, i+1, i+2));
+        if (iy % 2 == 0 && ix < n-3)
+            sysdef->getDihedralData()->addBondedGroup(Dihedral(0, i, i+1, i+2, i+3));
+        if (ix == 3 && iz < n-1)
+            sysdef->getConstraintData()->addBondedGroup(Constraint(1.0, i, i+n*n));
+        }
+
+    return sysdef;
+    }
+
+//! Test if the distance of i and j is below r
+bool topology_in_range(std::shared_ptr<ParticleData> pdata, Scalar r, unsigned int i, unsigned int j)
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+
+    Scalar3 dx = make_scalar3(h_pos.data[i].x - h_pos.data[j].x,
+                              h_pos.data[i].y - h_pos.data[j].y,
+                              h_pos.data[i].z - h_pos.data[j].z);
+    dx = pdata->getBox().minImage(dx);
+    return dot(dx, dx) < r*r;
+    }
+
+//! Tests that the exclusions applied in the build leave the same lists as the filter after the build
+/*! Both lists exclude the bonds, angles, dihedrals and constraints of build_topology_system(). Each particle must
+    have the same neighbors in both lists, no excluded neighbor, and every other particle within the cutoff.
+*/
+template <class NL>
+void neighborlist_topology_exclusion_tests(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                           NeighborList::storageMode mode)
+    {
+    std::shared_ptr<SystemDefinition> sysdef = build_topology_system(exec_conf);
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    const Scalar r_cut_value = 3.1;
+
+    std::shared_ptr<NeighborList> nlist_build(new NL(sysdef, r_cut_value, 0.4));
+    std::shared_ptr<NeighborList> nlist_filter(new NeighborListPostFilter<NL>(sysdef, r_cut_value, 0.4));
+    auto r_cut = std::make_shared<GlobalArray<Scalar>>(nlist_build->getTypePairIndexer().getNumElements(),
+                                               exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut(*r_cut, access_location::host, access_mode::overwrite);
+        h_r_cut.data[0] = r_cut_value;
+        }
+    nlist_build->addRCutMatrix(r_cut);
+    nlist_filter->addRCutMatrix(r_cut);
+
+    nlist_build->setStorageMode(mode);
+    nlist_filter->setStorageMode(mode);
+
+    const std::string exclusions[] = {"bond", "angle", "dihedral", "constraint"};
+    for (auto const& exclusion : exclusions)
+        {
+        nlist_build->setSingleExclusion(exclusion);
+        nlist_filter->setSingleExclusion(exclusion);
+        }
+
+    nlist_build->compute(0);
+    nlist_filter->compute(0);
+
+    ArrayHandle<unsigned int> h_n_neigh_b(nlist_build->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist_b(nlist_build->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list_b(nlist_build->getHeadList(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh_f(nlist_filter->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist_f(nlist_filter->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list_f(nlist_filter->getHeadList(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+
+    for (unsigned int i = 0; i < pdata->getN(); ++i)
+        {
+        std::vector<unsigned int> list_b(h_nlist_b.data + h_head_list_b.data[i],
+                                         h_nlist_b.data + h_head_list_b.data[i] + h_n_neigh_b.data[i]);
+        std::vector<unsigned int> list_f(h_nlist_f.data + h_head_list_f.data[i],
+                                         h_nlist_f.data + h_head_list_f.data[i] + h_n_neigh_f.data[i]);
+        std::sort(list_b.begin(), list_b.end());
+        std::sort(list_f.begin(), list_f.end());
+        UP_ASSERT_EQUAL(list_b.size(), list_f.size());
+        UP_ASSERT(list_b == list_f);
+
+        for (unsigned int j : list_b)
+            UP_ASSERT(!nlist_build->isExcluded(h_tag.data[i], h_tag.data[j]));
+
+        for (unsigned int j = 0; j < pdata->getN(); ++j)
+            {
+            if (j == i || (mode == NeighborList::half && j < i))
+                continue;
+            if (topology_in_range(pdata, r_cut_value, i, j) && !nlist_build->isExcluded(h_tag.data[i], h_tag.data[j]))
+                UP_ASSERT(std::binary_search(list_b.begin(), list_b.end(), j));
+            }
+        }
+    }
+
+//! Collect the excluded tags of each tag from the bonds, angle ends, dihedral ends and constraints
+std::vector< std::set<unsigned int> > topology_exclusions(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    std::vector< std::set<unsigned int> > excluded(sysdef->getParticleData()->getNGlobal());
+
+    BondData::Snapshot bonds;
+    sysdef->getBondData()->takeSnapshot(bonds);
+    for (auto const& bond : bonds.groups)
+        {
+        excluded[bond.tag[0]].insert(bond.tag[1]);
+        excluded[bond.tag[1]].insert(bond.tag[0]);
+        }
+
+    AngleData::Snapshot angles;
+    sysdef->getAngleData()->takeSnapshot(angles);
+    for (auto const& angle : angles.groups)
+        {
+        excluded[angle.tag[0]].insert(angle.tag[2]);
+        excluded[angle.tag[2]].insert(angle.tag[0]);
+        }
+
+    DihedralData::Snapshot dihedrals;
+    sysdef->getDihedralData()->takeSnapshot(dihedrals);
+    for (auto const& dihedral : dihedrals.groups)
+        {
+        excluded[dihedral.tag[0]].insert(dihedral.tag[3]);
+        excluded[dihedral.tag[3]].insert(dihedral.tag[0]);
+        }
+
+    ConstraintData::Snapshot constraints;
+    sysdef->getConstraintData()->takeSnapshot(constraints);
+    for (auto const& constraint : constraints.groups)
+        {
+        excluded[constraint.tag[0]].insert(constraint.tag[1]);
+        excluded[constraint.tag[1]].insert(constraint.tag[0]);
+        }
+
+    return excluded;
+    }
+
+//! Check the exclusion rows by tag and by index against the topology and the neighbors of particle 0
+void check_exclusion_rows(std::shared_ptr<SystemDefinition> sysdef, std::shared_ptr<NeighborList> nlist,
+                          unsigned int neighbor, bool neighbor_excluded)
+    {
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    std::vector< std::set<unsigned int> > excluded = topology_exclusions(sysdef);
+
+    // the rows by tag hold exactly the excluded pairs
+    for (unsigned int a = 0; a < pdata->getNGlobal(); ++a)
+        for (unsigned int b = 0; b < pdata->getNGlobal(); ++b)
+            UP_ASSERT_EQUAL(nlist->isExcluded(a, b), excluded[a].count(b) == 1);
+
+    ArrayHandle<unsigned int> h_n_ex(nlist->getNExArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_head(nlist->getExHeadArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list(nlist->getExListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+
+    // the rows by index mirror the rows of the tags
+    unsigned int max_n_ex = 0;
+    for (unsigned int i = 0; i < pdata->getN(); ++i)
+        {
+        std::set<unsigned int> row;
+        for (unsigned int k = 0; k < h_n_ex.data[i]; ++k)
+            row.insert(h_tag.data[h_ex_list.data[h_ex_head.data[i] + k]]);
+        UP_ASSERT_EQUAL(row.size(), h_n_ex.data[i]);
+        UP_ASSERT(row == excluded[h_tag.data[i]]);
+        max_n_ex = std::max(max_n_ex, h_n_ex.data[i]);
+        }
+
+    // no row is padded to the longest row
+    unsigned int n_ex_total = 0;
+    for (unsigned int i = 0; i < pdata->getN(); ++i)
+        n_ex_total += h_n_ex.data[i];
+    UP_ASSERT(n_ex_total < max_n_ex*pdata->getN());
+    UP_ASSERT(nlist->getExListArray().size() == n_ex_total);
+
+    ArrayHandle<unsigned int> h_n_neigh(nlist->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(nlist->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(nlist->getHeadList(), access_location::host, access_mode::read);
+    const unsigned int *first = h_nlist.data + h_head_list.data[0];
+    bool listed = std::find(first, first + h_n_neigh.data[0], neighbor) != first + h_n_neigh.data[0];
+    UP_ASSERT_EQUAL(listed, !neighbor_excluded);
+    }
+
+//! Tests the exclusion rows built from the topology, and that they follow changes of the topology
+/*! After the exclusions of build_topology_system() are set, each row must hold exactly the excluded partners of its
+    particle. A new bond between particle 0 and the particle diagonal to it must remove that particle from the list
+    of 0 at the next compute(), and removing the first dihedral must put particle 3 back into it.
+*/
+template <class NL>
+void neighborlist_exclusion_rows_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef = build_topology_system(exec_conf);
+    const Scalar r_cut_value = 3.1;
+
+    std::shared_ptr<NeighborList> nlist(new NL(sysdef, r_cut_value, 0.4));
+    auto r_cut = std::make_shared<GlobalArray<Scalar>>(nlist->getTypePairIndexer().getNumElements(), exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut(*r_cut, access_location::host, access_mode::overwrite);
+        h_r_cut.data[0] = r_cut_value;
+        }
+    nlist->addRCutMatrix(r_cut);
+    nlist->setStorageMode(NeighborList::full);
+
+    const std::string exclusions[] = {"bond", "angle", "dihedral", "constraint"};
+    for (auto const& exclusion : exclusions)
+        nlist->setSingleExclusion(exclusion);
+
+    nlist->compute(0);
+    check_exclusion_rows(sysdef, nlist, 9, false);
+    check_exclusion_rows(sysdef, nlist, 3, true);
+
+    sysdef->getBondData()->addBondedGroup(Bond(0, 0, 9));
+    nlist->compute(1);
+    check_exclusion_rows(sysdef, nlist, 9, true);
+
+    // the first dihedral is 0-1-2-3
+    sysdef->getDihedralData()->removeBondedGroup(0);
+    nlist->compute(2);
+    check_exclusion_rows(sysdef, nlist, 3, false);
+    }
+
 ///////////////
 // BINNED CPU
 ///////////////
@@ -1484,6 +1916,29 @@ UP_TEST( NeighborListBinned_2d )
     {
     neighborlist_2d_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! partial rebuild test case for binned class
+UP_TEST( NeighborListBinned_partial_rebuild )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    neighborlist_partial_rebuild_tests<NeighborListBinned>(exec_conf, NeighborList::half, false);
+    neighborlist_partial_rebuild_tests<NeighborListBinned>(exec_conf, NeighborList::full, false);
+    neighborlist_partial_rebuild_tests<NeighborListBinned>(exec_conf, NeighborList::half, true);
+    neighborlist_partial_rebuild_tests<NeighborListBinned>(exec_conf, NeighborList::full, true);
+    }
+
+//! topology exclusion test case for binned class
+UP_TEST( NeighborListBinned_topology_exclusion )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    neighborlist_topology_exclusion_tests<NeighborListBinned>(exec_conf, NeighborList::half);
+    neighborlist_topology_exclusion_tests<NeighborListBinned>(exec_conf, NeighborList::full);
+    }
+
+//! exclusion rows test case for binned class
+UP_TEST( NeighborListBinned_exclusion_rows )
+    {
+    neighborlist_exclusion_rows_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 
 ////////////////////
 // STENCIL CPU
@@ -1539,6 +1994,29 @@ UP_TEST( NeighborListStencil_2d )
     {
     neighborlist_2d_tests<NeighborListStencil>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! partial rebuild test case for stencil class
+UP_TEST( NeighborListStencil_partial_rebuild )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    neighborlist_partial_rebuild_tests<NeighborListStencil>(exec_conf, NeighborList::half, false);
+    neighborlist_partial_rebuild_tests<NeighborListStencil>(exec_conf, NeighborList::full, false);
+    neighborlist_partial_rebuild_tests<NeighborListStencil>(exec_conf, NeighborList::half, true);
+    neighborlist_partial_rebuild_tests<NeighborListStencil>(exec_conf, NeighborList::full, true);
+    }
+
+//! topology exclusion test case for stencil class
+UP_TEST( NeighborListStencil_topology_exclusion )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    neighborlist_topology_exclusion_tests<NeighborListStencil>(exec_conf, NeighborList::half);
+    neighborlist_topology_exclusion_tests<NeighborListStencil>(exec_conf, NeighborList::full);
+    }
+
+//! exclusion rows test case for stencil class
+UP_TEST( NeighborListStencil_exclusion_rows )
+    {
+    neighborlist_exclusion_rows_tests<NeighborListStencil>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 //! comparison test case for stencil class
 UP_TEST( NeighborListStencil_comparison )
     {
@@ -1598,6 +2076,29 @@ UP_TEST( NeighborListTree_2d )
     {
     neighborlist_2d_tests<NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! partial rebuild test case for tree class
+UP_TEST( NeighborListTree_partial_rebuild )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    neighborlist_partial_rebuild_tests<NeighborListTree>(exec_conf, NeighborList::half, false);
+    neighborlist_partial_rebuild_tests<NeighborListTree>(exec_conf, NeighborList::full, false);
+    neighborlist_partial_rebuild_tests<NeighborListTree>(exec_conf, NeighborList::half, true);
+    neighborlist_partial_rebuild_tests<NeighborListTree>(exec_conf, NeighborList::full, true);
+    }
+
+//! topology exclusion test case for tree class
+UP_TEST( NeighborListTree_topology_exclusion )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    neighborlist_topology_exclusion_tests<NeighborListTree>(exec_conf, NeighborList::half);
+    neighborlist_topology_exclusion_tests<NeighborListTree>(exec_conf, NeighborList::full);
+    }
+
+//! exclusion rows test case for tree class
+UP_TEST( NeighborListTree_exclusion_rows )
+    {
+    neighborlist_exclusion_rows_tests<NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 //! comparison test case for tree class
 UP_TEST( NeighborListTree_comparison )
     {
@@ -1665,6 +2166,20 @@ UP_TEST( NeighborListGPUBinned_comparison )
     neighborlist_comparison_test<NeighborListBinned, NeighborListGPUBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
 
+//! topology exclusion test case for GPUBinned class
+UP_TEST( NeighborListGPUBinned_topology_exclusion )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::GPU));
+    neighborlist_topology_exclusion_tests<NeighborListGPUBinned>(exec_conf, NeighborList::half);
+    neighborlist_topology_exclusion_tests<NeighborListGPUBinned>(exec_conf, NeighborList::full);
+    }
+
+//! exclusion rows test case for GPUBinned class
+UP_TEST( NeighborListGPUBinned_exclusion_rows )
+    {
+    neighborlist_exclusion_rows_tests<NeighborListGPUBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+
 ///////////////
 // STENCIL GPU
 ///////////////
@@ -1730,6 +2245,20 @@ UP_TEST( NeighborListGPUStencil_binned_comparison )
     neighborlist_comparison_test<NeighborListGPUBinned, NeighborListGPUStencil>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
 
+//! topology exclusion test case for GPUStencil class
+UP_TEST( NeighborListGPUStencil_topology_exclusion )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::GPU));
+    neighborlist_topology_exclusion_tests<NeighborListGPUStencil>(exec_conf, NeighborList::half);
+    neighborlist_topology_exclusion_tests<NeighborListGPUStencil>(exec_conf, NeighborList::full);
+    }
+
+//! exclusion rows test case for GPUStencil class
+UP_TEST( NeighborListGPUStencil_exclusion_rows )
+    {
+    neighborlist_exclusion_rows_tests<NeighborListGPUStencil>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+
 ///////////////
 // TREE GPU
 ///////////////
@@ -1805,4 +2334,18 @@ UP_TEST( NeighborListGPUTree_binned_comparison )
     std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::GPU));
     neighborlist_comparison_test<NeighborListGPUBinned, NeighborListGPUTree>(exec_conf);
     }
+
+//! topology exclusion test case for GPUTree class
+UP_TEST( NeighborListGPUTree_topology_exclusion )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::GPU));
+    neighborlist_topology_exclusion_tests<NeighborListGPUTree>(exec_conf, NeighborList::half);
+    neighborlist_topology_exclusion_tests<NeighborListGPUTree>(exec_conf, NeighborList::full);
+    }
+
+//! exclusion rows test case for GPUTree class
+UP_TEST( NeighborListGPUTree_exclusion_rows )
+    {
+    neighborlist_exclusion_rows_tests<NeighborListGPUTree>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
 #endif
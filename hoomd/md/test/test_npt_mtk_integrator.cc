@@ -106,6 +106,7 @@ void npt_mtk_updater_test(twostep_npt_mtk_creator npt_mtk_creator, std::shared_p
 
     // enable the energy computation
     PDataFlags flags;
+    flags[pdata_flag::potential_energy] = 1;
     flags[pdata_flag::pressure_tensor] = 1;
     pdata->setFlags(flags);
 
@@ -384,6 +385,7 @@ void nph_integration_test(twostep_npt_mtk_creator nph_creator, std::shared_ptr<E
 
     // enable the energy computation
     PDataFlags flags;
+    flags[pdata_flag::potential_energy] = 1;
     flags[pdata_flag::pressure_tensor] = 1;
     pdata->setFlags(flags);
 
@@ -543,6 +545,7 @@ void npt_mtk_updater_aniso(twostep_npt_mtk_creator npt_mtk_creator, std::shared_
 
     // enable the energy computation
     PDataFlags flags;
+    flags[pdata_flag::potential_energy] = 1;
     flags[pdata_flag::pressure_tensor] = 1;
     flags[pdata_flag::rotational_kinetic_energy] = 1;
     pdata->setFlags(flags);
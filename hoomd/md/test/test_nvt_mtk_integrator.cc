@@ -221,6 +221,7 @@ void test_nvt_mtk_integrator_aniso(std::shared_ptr<ExecutionConfiguration> exec_
     nvt_1->prepRun(0);
 
     PDataFlags flags;
+    flags[pdata_flag::potential_energy] = 1;
     flags[pdata_flag::rotational_kinetic_energy] = 1;
     pdata_1->setFlags(flags);
 
@@ -17,9 +17,14 @@
 #endif
 
 #include "hoomd/md/NeighborListTree.h"
+#include "hoomd/md/PPPMTuner.h"
 #include "hoomd/Initializers.h"
 #include "hoomd/filter/ParticleFilterTags.h"
 
+#include <pybind11/pybind11.h>
+#include <pybind11/embed.h>
+namespace py = pybind11;
+
 #include <math.h>
 
 using namespace std;
@@ -200,6 +205,121 @@ void pppm_force_particle_test_triclinic(pppmforce_creator pppm_creator, std::sha
     }
 
 
+//! Test that the slab correction adds the analytic dipole term
+void pppm_force_slab_test(pppmforce_creator pppm_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // a neutral pair with a dipole along z in a box with a vacuum gap along z
+    std::shared_ptr<SystemDefinition> sysdef_2(new SystemDefinition(2, BoxDim(6.0, 6.0, 18.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata_2 = sysdef_2->getParticleData();
+    pdata_2->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<NeighborListTree> nlist_2(new NeighborListTree(sysdef_2, Scalar(1.0), Scalar(1.0)));
+    std::shared_ptr<ParticleFilter> selector_all(new ParticleFilterTags(std::vector<unsigned int>({0, 1})));
+    std::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef_2, selector_all));
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_charge(pdata_2->getCharges(), access_location::host, access_mode::readwrite);
+
+    h_pos.data[0].x = h_pos.data[0].y = 0.5;
+    h_pos.data[0].z = 1.0;
+    h_charge.data[0] = 1.0;
+    h_pos.data[1].x = h_pos.data[1].y = -0.5;
+    h_pos.data[1].z = -1.0;
+    h_charge.data[1] = -1.0;
+    }
+
+    std::shared_ptr<PPPMForceCompute> fc_2 = pppm_creator(sysdef_2, nlist_2, group_all);
+    fc_2->setParams(16, 16, 48, 5, 1.0, 1.0);
+
+    fc_2->compute(0);
+    Scalar energy = fc_2->getExternalEnergy();
+    Scalar fz0, fz1;
+        {
+        ArrayHandle<Scalar4> h_force(fc_2->getForceArray(), access_location::host, access_mode::read);
+        fz0 = h_force.data[0].z;
+        fz1 = h_force.data[1].z;
+        }
+
+    fc_2->setSlabCorrection(true);
+    fc_2->compute(1);
+
+    Scalar V = 6.0*6.0*18.0;
+    Scalar dipole = 2.0;
+    MY_CHECK_CLOSE(fc_2->getExternalEnergy() - energy, 2.0*M_PI/V*dipole*dipole, tol_small);
+
+    ArrayHandle<Scalar4> h_force(fc_2->getForceArray(), access_location::host, access_mode::read);
+    MY_CHECK_CLOSE(h_force.data[0].z - fz0, -4.0*M_PI/V*dipole, tol_small);
+    MY_CHECK_CLOSE(h_force.data[1].z - fz1, 4.0*M_PI/V*dipole, tol_small);
+    }
+
+//! Test that the PPPMTuner settles on parameters that reach the target error
+void pppm_tuner_test(pppmforce_creator pppm_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // 4x4x4 lattice of alternating charges
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(64, BoxDim(8.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::vector<unsigned int> tags(64);
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_charge(pdata->getCharges(), access_location::host, access_mode::readwrite);
+
+    for (unsigned int i = 0; i < 64; i++)
+        {
+        unsigned int x = i % 4, y = (i / 4) % 4, z = i / 16;
+        h_pos.data[i].x = -3.0 + 2.0*x + 0.1*y;
+        h_pos.data[i].y = -3.0 + 2.0*y + 0.1*z;
+        h_pos.data[i].z = -3.0 + 2.0*z + 0.1*x;
+        h_charge.data[i] = ((x + y + z) % 2) ? 1.0 : -1.0;
+        tags[i] = i;
+        }
+    }
+
+    std::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(3.0), Scalar(0.4)));
+    std::shared_ptr<ParticleFilter> selector_all(new ParticleFilterTags(tags));
+    std::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+
+    std::shared_ptr<PPPMForceCompute> pppm = pppm_creator(sysdef, nlist, group_all);
+    std::shared_ptr<PotentialPairEwald> ewald(new PotentialPairEwald(sysdef, nlist));
+
+    // necessary to create python objects
+    py::scoped_interpreter guard{};
+    py::list orders;
+    orders.append(3);
+    orders.append(5);
+
+    Scalar target_error = 1e-3;
+    std::shared_ptr<PPPMTuner> tuner(new PPPMTuner(sysdef, std::shared_ptr<Trigger>(new PeriodicTrigger(1)), pppm,
+                                                   ewald, target_error, 2.0, 3.0, 2, orders, 0.1));
+
+    unsigned int timestep = 0;
+    while (!tuner->isComplete() && timestep < 20)
+        {
+        tuner->update(timestep);
+        pppm->compute(timestep);
+        ewald->compute(timestep);
+        timestep++;
+        }
+    UP_ASSERT(tuner->isComplete());
+    UP_ASSERT_EQUAL(py::len(tuner->getSampledCandidates()), 4);
+
+    // the mesh and the short-ranged part agree and reach the target
+    Scalar kspace_error, real_error;
+    pppm->estimateError(pppm->getMeshDimensions(), pppm->getOrder(), pppm->getKappa(), pppm->getRCut(),
+                        pppm->getQ2Sum(), kspace_error, real_error);
+    UP_ASSERT(kspace_error <= target_error);
+    MY_CHECK_CLOSE(real_error, target_error, tol);
+    MY_CHECK_CLOSE(ewald->getRCut(py::make_tuple("A", "A")), pppm->getRCut(), tol_small);
+
+    // a large box change starts a new scan
+    pdata->setGlobalBox(BoxDim(9.0));
+    tuner->update(timestep);
+    UP_ASSERT(!tuner->isComplete());
+    }
+
+
 //! PPPMForceCompute creator for unit tests
 std::shared_ptr<PPPMForceCompute> base_class_pppm_creator(std::shared_ptr<SystemDefinition> sysdef,
                                                      std::shared_ptr<NeighborList> nlist,
@@ -234,6 +354,20 @@ UP_TEST( PPPMForceCompute_triclinic )
     pppm_force_particle_test_triclinic(pppm_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for the slab correction on CPU
+UP_TEST( PPPMForceCompute_slab )
+    {
+    pppmforce_creator pppm_creator = bind(base_class_pppm_creator, _1, _2, _3);
+    pppm_force_slab_test(pppm_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for the accuracy tuner on CPU
+UP_TEST( PPPMTuner_basic )
+    {
+    pppmforce_creator pppm_creator = bind(base_class_pppm_creator, _1, _2, _3);
+    pppm_tuner_test(pppm_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 
 #ifdef ENABLE_HIP
 //! test case for bond forces on the GPU
@@ -249,4 +383,10 @@ UP_TEST( PPPMForceComputeGPU_triclinic )
     pppm_force_particle_test_triclinic(pppm_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
 
+UP_TEST( PPPMForceComputeGPU_slab )
+    {
+    pppmforce_creator pppm_creator = bind(gpu_pppm_creator, _1, _2, _3);
+    pppm_force_slab_test(pppm_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+
 #endif
@@ -179,6 +179,75 @@ void angle_force_basic_tests(angleforce_creator tf_creator, std::shared_ptr<Exec
 
     }
 
+//! Computes the angle energy and the force on particle 0, the first particle of the angle
+void angle_force_evaluate(std::shared_ptr<TableAngleForceCompute> fc,
+                          std::shared_ptr<ParticleData> pdata,
+                          const Scalar3& pos_a,
+                          unsigned int timestep,
+                          Scalar& U,
+                          Scalar3& force_a)
+    {
+    pdata->setPosition(0, pos_a);
+    fc->compute(timestep);
+
+    ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+    U = h_force.data[0].w + h_force.data[1].w + h_force.data[2].w;
+    force_a = make_scalar3(h_force.data[0].x, h_force.data[0].y, h_force.data[0].z);
+    }
+
+//! Checks the cubic Hermite interpolation against an analytic potential
+void angle_force_cubic_tests(angleforce_creator tf_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // the angle 0-1-2 with its vertex at the origin and unit arms, so that theta is the polar angle of particle 0
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(3, BoxDim(10.0), 1, 0, 1, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setPosition(0, make_scalar3(0.0, 1.0, 0.0));
+    pdata->setPosition(1, make_scalar3(0.0, 0.0, 0.0));
+    pdata->setPosition(2, make_scalar3(1.0, 0.0, 0.0));
+    sysdef->getAngleData()->addBondedGroup(Angle(0, 0, 1, 2));
+
+    unsigned int width = 31;
+    std::shared_ptr<TableAngleForceCompute> fc = tf_creator(sysdef, width);
+    fc->setCubic(true);
+
+    // tabulate V(theta) = cos(2 theta) + theta and T = -dV/dtheta on a coarse grid
+    std::vector<Scalar> V, T;
+    for (unsigned int i = 0; i < width; ++i)
+        {
+        Scalar theta = (Scalar)i/(Scalar)(width-1)*Scalar(M_PI);
+        V.push_back(cos(Scalar(2.0)*theta) + theta);
+        T.push_back(Scalar(2.0)*sin(Scalar(2.0)*theta) - Scalar(1.0));
+        }
+    fc->setTable(0, V, T);
+
+    // angles between the grid points, and one on a grid point so that the difference spans two intervals
+    Scalar theta_test[] = {0.7, Scalar(M_PI/3.0), 1.3, 2.2};
+    Scalar ds = 0.005;
+    unsigned int timestep = 0;
+    for (unsigned int k = 0; k < 4; k++)
+        {
+        Scalar theta = theta_test[k];
+        Scalar3 pos_a = make_scalar3(cos(theta), sin(theta), 0.0);
+
+        // moving particle 0 along e_theta by ds changes the angle by ds
+        Scalar3 e_theta = make_scalar3(-sin(theta), cos(theta), 0.0);
+
+        Scalar U, U_plus, U_minus;
+        Scalar3 force_a, force_unused;
+        angle_force_evaluate(fc, pdata, pos_a, timestep++, U, force_a);
+        angle_force_evaluate(fc, pdata, pos_a + ds*e_theta, timestep++, U_plus, force_unused);
+        angle_force_evaluate(fc, pdata, pos_a - ds*e_theta, timestep++, U_minus, force_unused);
+        Scalar F = dot(force_a, e_theta);
+
+        // the interpolation errors are of order delta^4 in V and delta^3 in T, linear interpolation misses both
+        MY_CHECK_SMALL(U - (cos(Scalar(2.0)*theta) + theta), 1e-5);
+        MY_CHECK_SMALL(F - (Scalar(2.0)*sin(Scalar(2.0)*theta) - Scalar(1.0)), 1.5e-4);
+
+        // the force is the derivative of the interpolated energy
+        MY_CHECK_SMALL(F + (U_plus - U_minus) / (Scalar(2.0)*ds), 2e-4);
+        }
+    }
+
 #if 0
 //! Compares the output of two TableAngleForceComputes
 void angle_force_comparison_tests(angleforce_creator tf_creator1,
@@ -278,6 +347,13 @@ UP_TEST( TableAngleForceCompute_basic )
     angle_force_basic_tests(tf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for cubic interpolation on the CPU
+UP_TEST( TableAngleForceCompute_cubic )
+    {
+    angleforce_creator tf_creator = bind(base_class_tf_creator, _1,_2);
+    angle_force_cubic_tests(tf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_HIP
 //! test case for angle forces on the GPU
 UP_TEST( TableAngleForceComputeGPU_basic )
@@ -286,6 +362,13 @@ UP_TEST( TableAngleForceComputeGPU_basic )
     angleforce_creator tf_creator = bind(gpu_tf_creator, _1,_2);
     angle_force_basic_tests(tf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
+
+//! test case for cubic interpolation on the GPU
+UP_TEST( TableAngleForceComputeGPU_cubic )
+    {
+    angleforce_creator tf_creator = bind(gpu_tf_creator, _1,_2);
+    angle_force_cubic_tests(tf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
 #if 0
 //! test case for comparing bond GPU and CPU BondForceComputes
 UP_TEST( TableAngleForceComputeGPU_compare )
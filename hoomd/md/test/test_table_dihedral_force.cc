@@ -297,6 +297,77 @@ void dihedral_force_basic_tests(dihedralforce_creator tf_creator, std::shared_pt
 
     }
 
+//! Computes the dihedral energy and the force on particle 3, the last particle of the dihedral
+void dihedral_force_evaluate(std::shared_ptr<TableDihedralForceCompute> fc,
+                             std::shared_ptr<ParticleData> pdata,
+                             const Scalar3& pos_d,
+                             unsigned int timestep,
+                             Scalar& U,
+                             Scalar3& force_d)
+    {
+    pdata->setPosition(3, pos_d);
+    fc->compute(timestep);
+
+    ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+    U = h_force.data[0].w + h_force.data[1].w + h_force.data[2].w + h_force.data[3].w;
+    force_d = make_scalar3(h_force.data[3].x, h_force.data[3].y, h_force.data[3].z);
+    }
+
+//! Checks the cubic Hermite interpolation against an analytic potential
+void dihedral_force_cubic_tests(dihedralforce_creator tf_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // the dihedral 0-1-2-3 around the x axis with unit arms, so that phi is the polar angle of particle 3 in the yz
+    // plane
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(4, BoxDim(10.0), 1, 0, 0, 1, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setPosition(0, make_scalar3(0.0, 1.0, 0.0));
+    pdata->setPosition(1, make_scalar3(0.0, 0.0, 0.0));
+    pdata->setPosition(2, make_scalar3(1.0, 0.0, 0.0));
+    pdata->setPosition(3, make_scalar3(1.0, 0.0, 1.0));
+    sysdef->getDihedralData()->addBondedGroup(Dihedral(0, 0, 1, 2, 3));
+
+    unsigned int width = 61;
+    std::shared_ptr<TableDihedralForceCompute> fc = tf_creator(sysdef, width);
+    fc->setCubic(true);
+
+    // tabulate V(phi) = cos(phi) + cos(2 phi)/2 and T = -dV/dphi on a coarse grid
+    std::vector<Scalar> V, T;
+    for (unsigned int i = 0; i < width; ++i)
+        {
+        Scalar phi = -M_PI+(Scalar)i/(Scalar)(width-1)*Scalar(2*M_PI);
+        V.push_back(cos(phi) + Scalar(0.5)*cos(Scalar(2.0)*phi));
+        T.push_back(sin(phi) + sin(Scalar(2.0)*phi));
+        }
+    fc->setTable(0, V, T);
+
+    // angles between the grid points, and one on a grid point so that the difference spans two intervals
+    Scalar phi_test[] = {-1.7, 0.4, Scalar(M_PI/3.0), 1.1, 2.5};
+    Scalar ds = 0.005;
+    unsigned int timestep = 0;
+    for (unsigned int k = 0; k < 5; k++)
+        {
+        Scalar phi = phi_test[k];
+        Scalar3 pos_d = make_scalar3(1.0, cos(phi), sin(phi));
+
+        // moving particle 3 along e_phi by ds changes the dihedral angle by ds
+        Scalar3 e_phi = make_scalar3(0.0, -sin(phi), cos(phi));
+
+        Scalar U, U_plus, U_minus;
+        Scalar3 force_d, force_unused;
+        dihedral_force_evaluate(fc, pdata, pos_d, timestep++, U, force_d);
+        dihedral_force_evaluate(fc, pdata, pos_d + ds*e_phi, timestep++, U_plus, force_unused);
+        dihedral_force_evaluate(fc, pdata, pos_d - ds*e_phi, timestep++, U_minus, force_unused);
+        Scalar F = dot(force_d, e_phi);
+
+        // the interpolation errors are of order delta^4 in V and delta^3 in T, linear interpolation misses both
+        MY_CHECK_SMALL(U - (cos(phi) + Scalar(0.5)*cos(Scalar(2.0)*phi)), 1e-5);
+        MY_CHECK_SMALL(F - (sin(phi) + sin(Scalar(2.0)*phi)), 1.5e-4);
+
+        // the force is the derivative of the interpolated energy
+        MY_CHECK_SMALL(F + (U_plus - U_minus) / (Scalar(2.0)*ds), 2e-4);
+        }
+    }
+
 #if 0
 //! Compares the output of two TableDihedralForceComputes
 void dihedral_force_comparison_tests(dihedralforce_creator tf_creator1,
@@ -396,6 +467,13 @@ UP_TEST( TableDihedralForceCompute_basic )
     dihedral_force_basic_tests(tf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for cubic interpolation on the CPU
+UP_TEST( TableDihedralForceCompute_cubic )
+    {
+    dihedralforce_creator tf_creator = bind(base_class_tf_creator, _1,_2);
+    dihedral_force_cubic_tests(tf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_HIP
 //! test case for dihedral forces on the GPU
 UP_TEST( TableDihedralForceComputeGPU_basic )
@@ -404,6 +482,13 @@ UP_TEST( TableDihedralForceComputeGPU_basic )
     dihedralforce_creator tf_creator = bind(gpu_tf_creator, _1,_2);
     dihedral_force_basic_tests(tf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
+
+//! test case for cubic interpolation on the GPU
+UP_TEST( TableDihedralForceComputeGPU_cubic )
+    {
+    dihedralforce_creator tf_creator = bind(gpu_tf_creator, _1,_2);
+    dihedral_force_cubic_tests(tf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
 #if 0
 //! test case for comparing bond GPU and CPU BondForceComputes
 UP_TEST( TableDihedralForceComputeGPU_compare )
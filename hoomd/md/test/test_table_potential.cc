@@ -304,6 +304,68 @@ void table_potential_type_test(table_potential_creator table_creator, std::share
     }
     }
 
+//! Computes the pair energy and the force on particle 1 along x with the particles a distance r apart
+void table_potential_evaluate(std::shared_ptr<TablePotential> fc,
+                              std::shared_ptr<ParticleData> pdata,
+                              Scalar r,
+                              unsigned int timestep,
+                              Scalar& U,
+                              Scalar& F)
+    {
+    pdata->setPosition(1, make_scalar3(r, 0.0, 0.0));
+    fc->compute(timestep);
+
+    ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+    U = h_force.data[0].w + h_force.data[1].w;
+    F = h_force.data[1].x;
+    }
+
+//! checks the cubic Hermite interpolation against an analytic potential
+void table_potential_cubic_test(table_potential_creator table_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(2, BoxDim(1000.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setPosition(0, make_scalar3(0.0, 0.0, 0.0));
+    pdata->setPosition(1, make_scalar3(1.5, 0.0, 0.0));
+
+    std::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(3.0), Scalar(0.8)));
+    unsigned int width = 21;
+    std::shared_ptr<TablePotential> fc = table_creator(sysdef, nlist, width);
+    fc->setCubic(true);
+
+    // tabulate V(r) = cos(2r) + r and F = -dV/dr on a coarse grid
+    Scalar rmin = 1.0;
+    Scalar rmax = 3.0;
+    vector<Scalar> V, F;
+    for (unsigned int i = 0; i < width; i++)
+        {
+        Scalar r = rmin + (rmax - rmin) * Scalar(i) / Scalar(width - 1);
+        V.push_back(cos(Scalar(2.0) * r) + r);
+        F.push_back(Scalar(2.0) * sin(Scalar(2.0) * r) - Scalar(1.0));
+        }
+    fc->setTable(0, 0, V, F, rmin, rmax);
+
+    // points between the grid points, and one on a grid point so that the difference spans two intervals
+    Scalar r_test[] = {1.137, 1.55, 2.0, 2.213, 2.871};
+    Scalar dr = 0.005;
+    unsigned int timestep = 0;
+    for (unsigned int k = 0; k < 5; k++)
+        {
+        Scalar r = r_test[k];
+        Scalar U, Fr, U_plus, U_minus, F_unused;
+        table_potential_evaluate(fc, pdata, r, timestep++, U, Fr);
+        table_potential_evaluate(fc, pdata, r + dr, timestep++, U_plus, F_unused);
+        table_potential_evaluate(fc, pdata, r - dr, timestep++, U_minus, F_unused);
+
+        // the interpolation errors are of order delta^4 in V and delta^3 in F, linear interpolation misses both
+        MY_CHECK_SMALL(U - (cos(Scalar(2.0) * r) + r), 1e-5);
+        MY_CHECK_SMALL(Fr - (Scalar(2.0) * sin(Scalar(2.0) * r) - Scalar(1.0)), 1.5e-4);
+
+        // the force is the derivative of the interpolated energy
+        MY_CHECK_SMALL(Fr + (U_plus - U_minus) / (Scalar(2.0) * dr), 2e-4);
+        }
+    }
+
 //! TablePotential creator for unit tests
 std::shared_ptr<TablePotential> base_class_table_creator(std::shared_ptr<SystemDefinition> sysdef,
                                                     std::shared_ptr<NeighborList> nlist,
@@ -339,6 +401,13 @@ UP_TEST( TablePotential_type )
     table_potential_type_test(table_creator_base, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for cubic interpolation on CPU
+UP_TEST( TablePotential_cubic )
+    {
+    table_potential_creator table_creator_base = bind(base_class_table_creator, _1, _2, _3);
+    table_potential_cubic_test(table_creator_base, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_HIP
 //! test case for basic test on GPU
 UP_TEST( TablePotentialGPU_basic )
@@ -353,4 +422,11 @@ UP_TEST( TablePotentialGPU_type )
     table_potential_creator table_creator_gpu = bind(gpu_table_creator, _1, _2, _3);
     table_potential_type_test(table_creator_gpu, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
+
+//! test case for cubic interpolation on GPU
+UP_TEST( TablePotentialGPU_cubic )
+    {
+    table_potential_creator table_creator_gpu = bind(gpu_table_creator, _1, _2, _3);
+    table_potential_cubic_test(table_creator_gpu, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
 #endif
@@ -13,6 +13,8 @@ HOOMD_UP_MAIN();
 
 
 #include "hoomd/md/WallData.h"
+#include "hoomd/md/EvaluatorWalls.h"
+#include "hoomd/md/EvaluatorPairLJ.h"
 
 #include <memory>
 #include <cstdlib>
@@ -275,3 +277,64 @@ UP_TEST( plane_wall_math )
     MY_CHECK_SMALL(vx.z, tol_small);
     MY_CHECK_SMALL(dx, tol_small);
     }
+
+//! Check that the wall grid gives the same forces and energies as evaluating every wall
+UP_TEST( wall_grid )
+    {
+    typedef EvaluatorWalls<EvaluatorPairLJ> evaluator;
+
+    wall_type field;
+    field.numSpheres = 2;
+    field.numCylinders = 2;
+    field.numPlanes = 6;
+    field.Spheres[0] = SphereWall(8.0, make_scalar3(0.0,0.0,0.0), true);
+    field.Spheres[1] = SphereWall(2.0, make_scalar3(3.0,1.0,0.0), false);
+    field.Cylinders[0] = CylinderWall(7.0, make_scalar3(0.0,0.0,0.0), make_scalar3(0.0,0.0,1.0), true);
+    field.Cylinders[1] = CylinderWall(1.5, make_scalar3(-3.0,-2.0,0.0), make_scalar3(1.0,1.0,0.0), false);
+    for (unsigned int i = 0; i < 6; i++)
+        field.Planes[i] = PlaneWall(make_scalar3(-9.0+3.0*i,0.0,0.0), make_scalar3(i%2 ? 1.0 : -1.0,0.1*i,0.0), true);
+    BoxDim box(20.0);
+
+    for (unsigned int extrap = 0; extrap < 2; extrap++)
+        {
+        evaluator::param_type params;
+        params.params.lj1 = 4.0;
+        params.params.lj2 = 4.0;
+        params.rcutsq = 2.5*2.5;
+        params.rextrap = extrap ? 0.5 : 0.0;
+
+        wall_type all_walls = field;
+        all_walls.gridValid = 0;
+        wall_type grid_walls = field;
+        evaluator::updateField(grid_walls, &params, 1, box);
+
+        // at least one cell must leave out a wall
+        unsigned int num_listed = 0;
+        for (unsigned int cell = 0; cell < WALL_GRID_DIM*WALL_GRID_DIM*WALL_GRID_DIM; cell++)
+            for (unsigned int w = 0; w < WALL_LIST_WORDS; w++)
+                for (unsigned int bit = 0; bit < 32; bit++)
+                    num_listed += (grid_walls.cellWalls[cell][w] >> bit) & 1;
+        UP_ASSERT(num_listed < WALL_GRID_DIM*WALL_GRID_DIM*WALL_GRID_DIM*10);
+
+        // compare on a lattice of points that extends past the grid
+        for (int i = -11; i <= 11; i++)
+            for (int j = -11; j <= 11; j++)
+                for (int k = -11; k <= 11; k++)
+                    {
+                    Scalar3 x = make_scalar3(i*1.01, j*0.99, k*1.03);
+                    Scalar3 F_all, F_grid;
+                    Scalar energy_all, energy_grid;
+                    Scalar virial[6];
+
+                    evaluator eval_all(x, box, params, all_walls);
+                    eval_all.evalForceEnergyAndVirial(F_all, energy_all, virial);
+                    evaluator eval_grid(x, box, params, grid_walls);
+                    eval_grid.evalForceEnergyAndVirial(F_grid, energy_grid, virial);
+
+                    UP_ASSERT_EQUAL(energy_grid, energy_all);
+                    UP_ASSERT_EQUAL(F_grid.x, F_all.x);
+                    UP_ASSERT_EQUAL(F_grid.y, F_all.y);
+                    UP_ASSERT_EQUAL(F_grid.z, F_all.z);
+                    }
+        }
+    }
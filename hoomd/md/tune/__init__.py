@@ -0,0 +1 @@
+from hoomd.md.tune.nlist_buffer import NeighborListBuffer
@@ -0,0 +1,125 @@
+"""Define the NeighborListBuffer tuner."""
+
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyType
+from hoomd.operation import Tuner
+from hoomd.trigger import Trigger
+from hoomd.logging import log
+from hoomd.md import _md
+from hoomd.md.nlist import NList
+
+
+class NeighborListBuffer(Tuner):
+    r"""Tune the neighbor list buffer to minimize the time per step.
+
+    Args:
+        nlist (hoomd.md.nlist.NList): Neighbor list to tune.
+
+        trigger (hoomd.trigger.Trigger): Select the timesteps on which to
+            perform a tuning step. Defaults to a
+            `hoomd.trigger.Periodic(1000)` trigger.
+
+        buffer_range (tuple[float, float]): Smallest and largest buffer
+            widths to sample.
+
+        n_buffers (int): Number of buffer widths to sample.
+
+    `NeighborListBuffer` scans `n_buffers` values of `NList.buffer` evenly
+    spaced in `buffer_range` and sets the one with the shortest wall clock
+    time per step. The time steps between two successive calls set the
+    length of one sample. Each buffer width takes two samples: the first
+    finds the shortest period between rebuilds with
+    ``rebuild_check_delay=1``, and the second times the run with
+    `NList.rebuild_check_delay` set to half of that period.
+
+    `NeighborListBuffer` checks for dangerous builds on every call. When any
+    occur, it halves `NList.rebuild_check_delay` and repeats the sample, so
+    dangerous builds stop after at most a few samples. After the scan, it
+    keeps monitoring dangerous builds in the same way.
+
+    Use a trigger period long enough for the neighbor list to rebuild several
+    times in one sample. Call `retune` to scan the buffer widths again after
+    the system changes state.
+
+    Note:
+        `NeighborListBuffer` overrides the `NList.buffer` and
+        `NList.rebuild_check_delay` values set by the user.
+
+    Examples::
+
+        nlist = hoomd.md.nlist.Cell()
+        tuner = hoomd.md.tune.NeighborListBuffer(nlist=nlist,
+                                                 buffer_range=(0.1, 0.8))
+        sim.operations.tuners.append(tuner)
+
+    Attributes:
+        nlist (hoomd.md.nlist.NList): Neighbor list to tune.
+
+        trigger (hoomd.trigger.Trigger): Select the timesteps on which to
+            perform a tuning step.
+
+        buffer_range (tuple[float, float]): Smallest and largest buffer
+            widths to sample.
+
+        n_buffers (int): Number of buffer widths to sample.
+    """
+
+    def __init__(self, nlist, trigger=1000, buffer_range=(0.1, 1.0),
+                 n_buffers=10):
+        self._param_dict = ParameterDict(
+            nlist=OnlyType(NList),
+            trigger=Trigger,
+            buffer_range=(float, float),
+            n_buffers=int)
+        self.nlist = nlist
+        self.trigger = trigger
+        self.buffer_range = buffer_range
+        self.n_buffers = n_buffers
+
+    def _attach(self):
+        if not self.nlist._attached:
+            raise RuntimeError("The neighbor list must be used by a force in "
+                               "the integrator to be tuned.")
+        self._cpp_obj = _md.NeighborListBufferTuner(
+            self._simulation.state._cpp_sys_def, self.trigger,
+            self.nlist._cpp_obj, self.buffer_range[0], self.buffer_range[1],
+            self.n_buffers)
+        super()._attach()
+
+    def _getattr_param(self, attr):
+        # the remaining parameters are fixed at construction of the C++ object
+        if attr == 'trigger' and self._attached:
+            return self._cpp_obj.trigger
+        return self._param_dict[attr]
+
+    def _setattr_param(self, attr, value):
+        if self._attached and attr != 'trigger':
+            raise AttributeError("{} cannot be set after cpp"
+                                 " initialization".format(attr))
+        super()._setattr_param(attr, value)
+
+    def _update_param_dict(self):
+        # _param_dict already holds the current values
+        pass
+
+    def retune(self):
+        """Scan the buffer widths again, starting on the next call."""
+        if self._attached:
+            self._cpp_obj.retune()
+
+    @log
+    def tuned(self):
+        """bool: `True` when the scan is complete."""
+        if not self._attached:
+            return False
+        return self._cpp_obj.complete
+
+    @log(category='sequence')
+    def sampled_times(self):
+        """list[float]: Time per step in seconds for each sampled buffer width.
+
+        Entries that have not been sampled yet are 0.
+        """
+        if not self._attached:
+            return None
+        return self._cpp_obj.sampled_times
@@ -303,6 +303,20 @@ class mueller_plathe_flow(_updater):
         """
         return self.cpp_updater.setFlowEpsilon(float(epsilon))
 
+    def set_local_exchange(self,local_exchange):
+        R""" Set whether the swaps are only communicated between the MPI ranks of the min and max slab.
+
+           Args:
+           local_exchange (bool): If True, the ranks of the slabs carry out all swaps of a step among themselves,
+             and the exchanged momentum is broadcast to all ranks once per step instead of after every swap.
+
+        .. note:
+            Ghost copies of the swapped particles on ranks without a slab keep their old velocity until the ghosts
+            are next updated.
+
+        """
+        return self.cpp_updater.setLocalExchange(bool(local_exchange))
+
     def get_summed_exchanged_momentum(self):
         R"""Returned the summed up exchanged velocity of the full simulation."""
         return self.cpp_updater.getSummedExchangedMomentum()
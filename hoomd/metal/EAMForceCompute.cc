@@ -6,6 +6,10 @@
 
 #include "EAMForceCompute.h"
 
+#ifdef ENABLE_MPI
+#include "hoomd/Communicator.h"
+#endif
+
 #include <vector>
 
 using namespace std;
@@ -36,6 +40,10 @@ EAMForceCompute::EAMForceCompute(std::shared_ptr<SystemDefinition> sysdef, char
     m_ntypes = m_pdata->getNTypes();
     assert(m_ntypes > 0);
 
+    // derivative of the embedding function of the local and ghost particles
+    GlobalArray<Scalar> dFdP(m_pdata->getMaxN(), m_exec_conf);
+    m_dFdP.swap(dFdP);
+
     // connect to the ParticleData to receive notifications when the number of particle types changes
     m_pdata->getNumTypesChangeSignal().connect<EAMForceCompute, &EAMForceCompute::slotNumTypesChange>(this);
     }
@@ -374,15 +382,16 @@ void EAMForceCompute::computeForces(unsigned int timestep)
     // sum up the number of forces calculated
     int64_t n_calc = 0;
 
-    // parameters for each particle
-    vector<Scalar> atomElectronDensity;
-    atomElectronDensity.resize(m_pdata->getN());
-    vector<Scalar> atomDerivativeEmbeddingFunction;
-    atomDerivativeEmbeddingFunction.resize(m_pdata->getN());
-    vector<Scalar> atomEmbeddingFunction;
-    atomEmbeddingFunction.resize(m_pdata->getN());
+    // neighbors may be ghosts, and the half neighbor list adds density to them
+    const unsigned int n_all = m_pdata->getN() + m_pdata->getNGhosts();
+
+    // electron density of each particle
+    vector<Scalar> atomElectronDensity(n_all, Scalar(0.0));
     unsigned int ntypes = m_pdata->getNTypes();
 
+    if (m_dFdP.getNumElements() < n_all)
+        m_dFdP.resize(m_pdata->getMaxN());
+
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
         // access the particle's position and type
@@ -404,7 +413,7 @@ void EAMForceCompute::computeForces(unsigned int timestep)
             // access the index of this neighbor
             unsigned int k = h_nlist.data[head_i + j];
             // sanity check
-            assert(k < m_pdata->getN());
+            assert(k < n_all);
 
             // calculate dr
             Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
@@ -447,26 +456,36 @@ void EAMForceCompute::computeForces(unsigned int timestep)
             }
         }
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        // calculate position rho for F(rho)
-        position = atomElectronDensity[i] * rdrho;
-        int_position = (unsigned int) position;
-        int_position = min(int_position, nrho - 1);
-        remainder = position - int_position;
-
-        idxs = int_position + typei * nrho;
-        v = h_F.data[idxs];
-        dv = h_dF.data[idxs];
-        // compute dF / dP
-        atomDerivativeEmbeddingFunction[i] = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-        // compute embedded energy F(P), sum up each particle
-        h_force.data[i].w += v.w + v.z * remainder + v.y * remainder * remainder
-                + v.x * remainder * remainder * remainder;
+        ArrayHandle<Scalar> h_dFdP(m_dFdP, access_location::host, access_mode::overwrite);
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            {
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            // calculate position rho for F(rho)
+            position = atomElectronDensity[i] * rdrho;
+            int_position = (unsigned int) position;
+            int_position = min(int_position, nrho - 1);
+            remainder = position - int_position;
 
+            idxs = int_position + typei * nrho;
+            v = h_F.data[idxs];
+            dv = h_dF.data[idxs];
+            // compute dF / dP
+            h_dFdP.data[i] = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+            // compute embedded energy F(P), sum up each particle
+            h_force.data[i].w += v.w + v.z * remainder + v.y * remainder * remainder
+                    + v.x * remainder * remainder * remainder;
+            }
         }
 
+    #ifdef ENABLE_MPI
+    // the forces need dF / dP of the ghost neighbors, which only their owning rank knows
+    if (m_comm)
+        m_comm->updateGhostField(m_dFdP);
+    #endif
+
+    ArrayHandle<Scalar> h_dFdP(m_dFdP, access_location::host, access_mode::read);
+
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
         // access the particle's position and type
@@ -495,7 +514,7 @@ void EAMForceCompute::computeForces(unsigned int timestep)
             // access the index of this neighbor
             unsigned int k = h_nlist.data[head_i + j];
             // sanity check
-            assert(k < m_pdata->getN());
+            assert(k < n_all);
 
             // calculate \Delta r
             Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
@@ -545,8 +564,8 @@ void EAMForceCompute::computeForces(unsigned int timestep)
             dv = h_drho.data[idxs];
             Scalar derivativeRhoJ = dv.z + dv.y * remainder + dv.x * remainder * remainder;
             // fullDerivativePhi = dF/dP * drho / dr for j + dF/dP * drho / dr for j + phi
-            Scalar fullDerivativePhi = atomDerivativeEmbeddingFunction[i] * derivativeRhoJ
-                    + atomDerivativeEmbeddingFunction[k] * derivativeRhoI + derivativePhi;
+            Scalar fullDerivativePhi = h_dFdP.data[i] * derivativeRhoJ
+                    + h_dFdP.data[k] * derivativeRhoI + derivativePhi;
             // compute forces
             Scalar pairForce = -fullDerivativePhi * inverseR;
             viriali[0] += dx.x * dx.x * pairForce;
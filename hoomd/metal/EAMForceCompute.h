@@ -91,7 +91,7 @@ protected:
     GPUArray<Scalar4> m_dF;                //!< derivative embedded function and its coefficients
     GPUArray<Scalar4> m_drho;              //!< derivative electron density and its coefficients
     GPUArray<Scalar4> m_drphi;             //!< derivative pair wise function and its coefficients
-    GPUArray<Scalar> m_dFdP;               //!< derivative F / derivative P
+    GlobalArray<Scalar> m_dFdP;            //!< derivative F / derivative P of the local and ghost particles
 
     //! Actually compute the forces
     virtual void computeForces(unsigned int timestep);
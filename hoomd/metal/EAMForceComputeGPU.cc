@@ -11,6 +11,10 @@
 #include "EAMForceComputeGPU.h"
 #include <hip/hip_runtime.h>
 
+#ifdef ENABLE_MPI
+#include "hoomd/Communicator.h"
+#endif
+
 #include <stdexcept>
 
 #include <pybind11/pybind11.h>
@@ -36,6 +40,8 @@ EAMForceComputeGPU::EAMForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef,
     unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
     unsigned int max_threads = m_exec_conf->dev_prop.maxThreadsPerBlock;
     m_tuner.reset(new Autotuner(warp_size, max_threads, warp_size, 5, 100000, "pair_eam", this->m_exec_conf));
+    m_tuner_density.reset(new Autotuner(warp_size, max_threads, warp_size, 5, 100000, "pair_eam_density",
+        this->m_exec_conf));
 
     // allocate the coefficients data on the GPU
     loadFile(filename, type_of_file);
@@ -75,6 +81,9 @@ void EAMForceComputeGPU::computeForces(unsigned int timestep)
         throw runtime_error("Error computing forces in EAMForceComputeGPU");
         }
 
+    if (m_dFdP.getNumElements() < m_pdata->getN() + m_pdata->getNGhosts())
+        m_dFdP.resize(m_pdata->getMaxN());
+
     // access the neighbor list, which just selects the neighborlist into the device's memory, copying
     // it there if needed
     ArrayHandle<unsigned int> d_n_neigh(this->m_nlist->getNNeighArray(), access_location::device, access_mode::read);
@@ -97,10 +106,28 @@ void EAMForceComputeGPU::computeForces(unsigned int timestep)
     ArrayHandle<Scalar4> d_drphi(m_drphi, access_location::device, access_mode::read);
     ArrayHandle<EAMTexInterData> d_eam_data(m_eam_data, access_location::device, access_mode::read);
 
-    // Derivative Embedding Function for each atom
-    GPUArray<Scalar> t_dFdP(m_pdata->getN(), m_exec_conf);
-    m_dFdP.swap(t_dFdP);
-    ArrayHandle<Scalar> d_dFdP(m_dFdP, access_location::device, access_mode::overwrite);
+    // Compute the embedding energy and its derivative for each local particle
+        {
+        ArrayHandle<Scalar> d_dFdP(m_dFdP, access_location::device, access_mode::overwrite);
+
+        m_tuner_density->begin();
+        gpu_compute_eam_tex_inter_density(d_force.data, d_virial.data, m_virial.getPitch(), m_pdata->getN(),
+                d_pos.data, box, d_n_neigh.data, d_nlist.data, d_head_list.data,
+                this->m_nlist->getNListArray().getPitch(), d_eam_data.data, d_dFdP.data, d_F.data, d_rho.data,
+                d_rphi.data, d_dF.data, d_drho.data, d_drphi.data, m_tuner_density->getParam());
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_density->end();
+        }
+
+    #ifdef ENABLE_MPI
+    // the forces need dF / dP of the ghost neighbors, which only their owning rank knows
+    if (m_comm)
+        m_comm->updateGhostField(m_dFdP);
+    #endif
+
+    ArrayHandle<Scalar> d_dFdP(m_dFdP, access_location::device, access_mode::read);
 
     // Compute energy and forces in GPU
     m_tuner->begin();
@@ -24,6 +24,11 @@
 
 //! Computes EAM forces on each particle using the GPU
 /*! Calculates the same forces as EAMForceCompute, but on the GPU by using texture memory(CUDAArray).
+
+ The first kernel computes the electron density, the embedding energy, and dF / dP of each local particle. dF / dP
+ of the ghost particles is then copied from their owning ranks with Communicator::updateGhostField(), and the
+ second kernel computes the forces. Each thread handles one particle of a full neighbor list and writes only its
+ own force, so the kernels need no atomic operations.
  */
 class EAMForceComputeGPU: public EAMForceCompute
     {
@@ -43,11 +48,14 @@ public:
         EAMForceCompute::setAutotunerParams(enable, period);
         m_tuner->setPeriod(period);
         m_tuner->setEnabled(enable);
+        m_tuner_density->setPeriod(period);
+        m_tuner_density->setEnabled(enable);
         }
 
 protected:
     GlobalArray<EAMTexInterData> m_eam_data;    //!< EAM parameters to be communicated
-    std::unique_ptr<Autotuner> m_tuner;         //!< autotuner for block size
+    std::unique_ptr<Autotuner> m_tuner;         //!< autotuner for block size of the force kernel
+    std::unique_ptr<Autotuner> m_tuner_density; //!< autotuner for block size of the density kernel
     //! Actually compute the forces
     virtual void computeForces(unsigned int timestep);
     };
@@ -13,7 +13,7 @@
  \brief Defines GPU kernel code for calculating the EAM forces. Used by EAMForceComputeGPU.
  */
 
-//! Kernel for computing EAM forces on the GPU
+//! Kernel for computing the EAM embedding energy and its derivative on the GPU
 __global__ void gpu_kernel_1(Scalar4 *d_force, Scalar *d_virial, const size_t virial_pitch, const unsigned int N,
         const Scalar4 *d_pos, BoxDim box, const unsigned int *d_n_neigh, const unsigned int *d_nlist,
         const unsigned int *d_head_list, const Scalar4 *d_F, const Scalar4 *d_rho, const Scalar4 *d_rphi,
@@ -62,7 +62,8 @@ __global__ void gpu_kernel_1(Scalar4 *d_force, Scalar *d_virial, const size_t vi
     // prefetch neighbor index
     int cur_neigh = 0;
     int next_neigh(0);
-    next_neigh = __ldg(d_nlist + head_idx);
+    if (n_neigh > 0)
+        next_neigh = __ldg(d_nlist + head_idx);
 
     int typei = __scalar_as_int(postype.w);
 
@@ -80,7 +81,8 @@ __global__ void gpu_kernel_1(Scalar4 *d_force, Scalar *d_virial, const size_t vi
         // read the current neighbor index
         // prefetch the next value and set the current one
         cur_neigh = next_neigh;
-        next_neigh = __ldg(d_nlist + head_idx + neigh_idx + 1);
+        if (neigh_idx + 1 < n_neigh)
+            next_neigh = __ldg(d_nlist + head_idx + neigh_idx + 1);
 
         // get the neighbor's position
         Scalar4 neigh_postype = __ldg(d_pos + cur_neigh);
@@ -174,7 +176,8 @@ __global__ void gpu_kernel_2(Scalar4 *d_force, Scalar *d_virial, const size_t vi
     // prefetch neighbor index
     int cur_neigh = 0;
     int next_neigh(0);
-    next_neigh = __ldg(d_nlist + head_idx);
+    if (n_neigh > 0)
+        next_neigh = __ldg(d_nlist + head_idx);
 
     //Scalar4 force = force_data.force[idx];
     Scalar4 force = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
@@ -197,7 +200,8 @@ __global__ void gpu_kernel_2(Scalar4 *d_force, Scalar *d_virial, const size_t vi
     for (int neigh_idx = 0; neigh_idx < n_neigh; neigh_idx++)
         {
         cur_neigh = next_neigh;
-        next_neigh = __ldg(d_nlist + head_idx + neigh_idx + 1);
+        if (neigh_idx + 1 < n_neigh)
+            next_neigh = __ldg(d_nlist + head_idx + neigh_idx + 1);
 
         // get the neighbor's position
         Scalar4 neigh_postype = __ldg(d_pos + cur_neigh);
@@ -280,41 +284,58 @@ __global__ void gpu_kernel_2(Scalar4 *d_force, Scalar *d_virial, const size_t vi
 
     }
 
-//! compute forces on GPU
-hipError_t gpu_compute_eam_tex_inter_forces(Scalar4 *d_force, Scalar *d_virial, const size_t virial_pitch,
+//! compute the embedding energy and dF / dP on GPU
+hipError_t gpu_compute_eam_tex_inter_density(Scalar4 *d_force, Scalar *d_virial, const size_t virial_pitch,
         const unsigned int N, const Scalar4 *d_pos, const BoxDim &box, const unsigned int *d_n_neigh,
         const unsigned int *d_nlist, const unsigned int *d_head_list, const size_t size_nlist,
         const EAMTexInterData *d_eam_data, Scalar *d_dFdP, const Scalar4 *d_F, const Scalar4 *d_rho,
         const Scalar4 *d_rphi, const Scalar4 *d_dF, const Scalar4 *d_drho, const Scalar4 *d_drphi,
         const unsigned int block_size)
     {
-    static unsigned int max_block_size_1 = UINT_MAX;
-    static unsigned int max_block_size_2 = UINT_MAX;
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(gpu_kernel_1));
+        max_block_size = attr.maxThreadsPerBlock;
+        }
 
-    hipFuncAttributes attr1;
-    hipFuncGetAttributes(&attr1, reinterpret_cast<const void*>(gpu_kernel_1));
+    unsigned int run_block_size = min(block_size, max_block_size);
 
-    hipFuncAttributes attr2;
-    hipFuncGetAttributes(&attr2, reinterpret_cast<const void*>(gpu_kernel_2));
+    // setup the grid to run the kernel
+    dim3 grid((int) ceil((double) N / (double) run_block_size), 1, 1);
+    dim3 threads(run_block_size, 1, 1);
 
-    max_block_size_1 = attr1.maxThreadsPerBlock;
-    max_block_size_2 = attr2.maxThreadsPerBlock;
+    hipLaunchKernelGGL(gpu_kernel_1, dim3(grid), dim3(threads), 0, 0, d_force, d_virial, virial_pitch, N, d_pos, box,
+            d_n_neigh, d_nlist, d_head_list, d_F, d_rho, d_rphi, d_dF, d_drho, d_drphi, d_dFdP, d_eam_data);
 
-    unsigned int run_block_size_1 = min(block_size, max_block_size_1);
-    unsigned int run_block_size_2 = min(block_size, max_block_size_2);
+    return hipSuccess;
+    }
 
-    // setup the grid to run the kernel
+//! compute forces on GPU
+hipError_t gpu_compute_eam_tex_inter_forces(Scalar4 *d_force, Scalar *d_virial, const size_t virial_pitch,
+        const unsigned int N, const Scalar4 *d_pos, const BoxDim &box, const unsigned int *d_n_neigh,
+        const unsigned int *d_nlist, const unsigned int *d_head_list, const size_t size_nlist,
+        const EAMTexInterData *d_eam_data, Scalar *d_dFdP, const Scalar4 *d_F, const Scalar4 *d_rho,
+        const Scalar4 *d_rphi, const Scalar4 *d_dF, const Scalar4 *d_drho, const Scalar4 *d_drphi,
+        const unsigned int block_size)
+    {
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(gpu_kernel_2));
+        max_block_size = attr.maxThreadsPerBlock;
+        }
 
-    dim3 grid_1((int) ceil((double) N / (double) run_block_size_1), 1, 1);
-    dim3 threads_1(run_block_size_1, 1, 1);
+    unsigned int run_block_size = min(block_size, max_block_size);
 
-    dim3 grid_2((int) ceil((double) N / (double) run_block_size_2), 1, 1);
-    dim3 threads_2(run_block_size_2, 1, 1);
+    // setup the grid to run the kernel
+    dim3 grid((int) ceil((double) N / (double) run_block_size), 1, 1);
+    dim3 threads(run_block_size, 1, 1);
 
-    hipLaunchKernelGGL(gpu_kernel_1, dim3(grid_1), dim3(threads_1), 0, 0, d_force, d_virial, virial_pitch, N, d_pos, box, d_n_neigh, d_nlist,
-            d_head_list, d_F, d_rho, d_rphi, d_dF, d_drho, d_drphi, d_dFdP, d_eam_data);
-    hipLaunchKernelGGL(gpu_kernel_2, dim3(grid_2), dim3(threads_2), 0, 0, d_force, d_virial, virial_pitch, N, d_pos, box, d_n_neigh, d_nlist,
-            d_head_list, d_F, d_rho, d_rphi, d_dF, d_drho, d_drphi, d_dFdP, d_eam_data);
+    hipLaunchKernelGGL(gpu_kernel_2, dim3(grid), dim3(threads), 0, 0, d_force, d_virial, virial_pitch, N, d_pos, box,
+            d_n_neigh, d_nlist, d_head_list, d_F, d_rho, d_rphi, d_dF, d_drho, d_drphi, d_dFdP, d_eam_data);
 
     return hipSuccess;
     }
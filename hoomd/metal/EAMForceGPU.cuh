@@ -29,7 +29,18 @@ struct EAMTexInterData
     Scalar r_cutsq;         //!< r_cut^2
     };
 
+//! Kernel driver that computes the EAM embedding energy and dF / dP of the local particles for EAMForceComputeGPU
+hipError_t gpu_compute_eam_tex_inter_density(Scalar4* d_force, Scalar* d_virial, const size_t virial_pitch,
+        const unsigned int N, const Scalar4 *d_pos, const BoxDim& box, const unsigned int *d_n_neigh,
+        const unsigned int *d_nlist, const unsigned int *d_head_list, const size_t size_nlist,
+        const EAMTexInterData *d_eam_data, Scalar *d_dFdP, const Scalar4 *d_F, const Scalar4 *d_rho,
+        const Scalar4 *d_rphi, const Scalar4 *d_dF, const Scalar4 *d_drho, const Scalar4 *d_drphi,
+        const unsigned int block_size);
+
 //! Kernel driver that computes EAM forces on the GPU for EAMForceComputeGPU
+/*! d_force must hold the embedding energies from gpu_compute_eam_tex_inter_density() and d_dFdP the values of the
+    local and the ghost particles.
+*/
 hipError_t gpu_compute_eam_tex_inter_forces(Scalar4* d_force, Scalar* d_virial, const size_t virial_pitch,
         const unsigned int N, const Scalar4 *d_pos, const BoxDim& box, const unsigned int *d_n_neigh,
         const unsigned int *d_nlist, const unsigned int *d_head_list, const size_t size_nlist,
@@ -9,3 +9,4 @@
 
 
 from hoomd.minimize.fire import FIRE
+from hoomd.minimize.line_search import LBFGS, CG
@@ -0,0 +1,141 @@
+# coding: utf-8
+
+# Copyright (c) 2009-2019 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+# Maintainer: joaander / All Developers are free to add commands for new
+# features
+
+
+from hoomd.md import _md
+import hoomd
+from hoomd.integrate import _integrator
+
+
+class _line_search(_integrator):
+    R""" Common base class of the line search energy minimizers.
+
+    Args:
+        max_move (float): Largest distance any particle may move in one step (in distance units).
+        ftol (float): force convergence criteria (in units of force)
+        Etol (float): energy convergence criteria (in energy units)
+        min_steps (int): A minimum number of iterations before convergence criteria are considered
+
+    Each step evaluates the forces once, at a trial point along the search direction. A line search along the
+    direction takes one or more steps and ends at a point that satisfies the strong Wolfe conditions.
+    Convergence is determined as in :py:class:`FIRE`, with the norm of the forces
+
+    .. math::
+
+        \frac{\sqrt{\sum |F|^2}}{\sqrt{N_{dof}}} <ftol \;\; and \;\ \Delta \frac{\sum |E|}{N} < Etol
+
+    The particles in the groups of the integration methods are minimized, with all other particles kept frozen. The
+    integration methods only select the particles, they are not integrated. Only positions are minimized.
+    """
+    def __init__(self, cpp_class, max_move, ftol, Etol, min_steps):
+
+        # initialize base class
+        _integrator.__init__(self)
+
+        # initialize the reflected c++ class
+        self.cpp_integrator = cpp_class(hoomd.context.current.system_definition, max_move)
+
+        self.supports_methods = True
+
+        hoomd.context.current.system.setIntegrator(self.cpp_integrator)
+
+        self.max_move = max_move
+        self.metadata_fields = ['max_move']
+
+        self.cpp_integrator.setFtol(ftol)
+        self.ftol = ftol
+        self.metadata_fields.append('ftol')
+
+        self.cpp_integrator.setEtol(Etol)
+        self.Etol = Etol
+        self.metadata_fields.append('Etol')
+
+        self.cpp_integrator.setMinSteps(min_steps)
+        self.min_steps = min_steps
+        self.metadata_fields.append('min_steps')
+
+    def get_energy(self):
+        R""" Returns the energy at the last accepted point of the minimizer
+        """
+        self.check_initialization()
+        return self.cpp_integrator.getEnergy()
+
+    def has_converged(self):
+        R""" Test if the energy minimizer has converged.
+
+        Returns:
+            True when the minimizer has converged. Otherwise, return False.
+        """
+        self.check_initialization()
+        return self.cpp_integrator.hasConverged()
+
+    def reset(self):
+        R""" Reset the minimizer to its initial state.
+        """
+        self.check_initialization()
+        return self.cpp_integrator.reset()
+
+
+class LBFGS(_line_search):
+    R""" Energy Minimizer (L-BFGS).
+
+    Args:
+        max_move (float): Largest distance any particle may move in one step (in distance units).
+        history (int): Number of previous steps used to approximate the inverse Hessian
+        ftol (float): force convergence criteria (in units of force)
+        Etol (float): energy convergence criteria (in energy units)
+        min_steps (int): A minimum number of iterations before convergence criteria are considered
+
+    :py:class:`LBFGS` minimizes the energy with the limited memory Broyden-Fletcher-Goldfarb-Shanno method
+    (`Nocedal, Math. Comp., 1980 <https://doi.org/10.1090/S0025-5718-1980-0572855-7>`_). The search direction
+    applies an approximation of the inverse Hessian, built from the changes in position and force of the last
+    *history* steps, to the forces. Near a minimum, it converges to tight force tolerances in far fewer force
+    evaluations than :py:class:`FIRE`.
+
+    The line search methods restart from the forces whenever the particles are sorted in memory or move between
+    domains. The search directions are computed on the CPU.
+
+    Examples::
+
+        lbfgs=minimize.LBFGS(max_move=0.1, ftol=1e-6, Etol=1e-10)
+        nve=integrate.nve(group=group.all())
+        while not(lbfgs.has_converged()):
+           run(100)
+
+    """
+    def __init__(self, max_move, history=10, ftol=1e-1, Etol=1e-5, min_steps=10):
+        _line_search.__init__(self, _md.LBFGSEnergyMinimizer, max_move, ftol, Etol, min_steps)
+
+        self.cpp_integrator.setHistorySize(history)
+        self.history = history
+        self.metadata_fields.append('history')
+
+
+class CG(_line_search):
+    R""" Energy Minimizer (nonlinear conjugate gradient).
+
+    Args:
+        max_move (float): Largest distance any particle may move in one step (in distance units).
+        ftol (float): force convergence criteria (in units of force)
+        Etol (float): energy convergence criteria (in energy units)
+        min_steps (int): A minimum number of iterations before convergence criteria are considered
+
+    :py:class:`CG` minimizes the energy with the Polak-Ribiere nonlinear conjugate gradient method. Each search
+    direction mixes the forces with the previous direction, and the line search is close to exact.
+
+    Examples::
+
+        cg=minimize.CG(max_move=0.1, ftol=1e-6, Etol=1e-10)
+        nve=integrate.nve(group=group.all())
+        while not(cg.has_converged()):
+           run(100)
+
+    """
+    def __init__(self, max_move, ftol=1e-1, Etol=1e-5, min_steps=10):
+        _line_search.__init__(self, _md.CGEnergyMinimizer, max_move, ftol, Etol, min_steps)
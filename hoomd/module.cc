@@ -5,6 +5,7 @@
 // Maintainer: joaander All developers are free to add the calls needed to export their modules
 #include "HOOMDMath.h"
 #include "ExecutionConfiguration.h"
+#include "AutotunerDatabase.h"
 #include "ClockSource.h"
 #include "Profiler.h"
 #include "ParticleData.h"
@@ -26,6 +27,8 @@
 #include "DCDDumpWriter.h"
 #include "GetarDumpWriter.h"
 #include "GSDDumpWriter.h"
+#include "LogBuffer.h"
+#include "ParticleDataStager.h"
 #include "Logger.h"
 #include "LogPlainTXT.h"
 #include "LogMatrix.h"
@@ -36,6 +39,7 @@
 #include "Integrator.h"
 #include "SFCPackTuner.h"
 #include "BoxResizeUpdater.h"
+#include "UpdaterReplicaExchange.h"
 #include "System.h"
 #include "Trigger.h"
 #include "Tuner.h"
@@ -50,6 +54,7 @@
 // include GPU classes
 #ifdef ENABLE_HIP
 #include <hip/hip_runtime.h>
+#include "BoxResizeUpdaterGPU.h"
 #include "CellListGPU.h"
 #include "SFCPackTunerGPU.h"
 #endif
@@ -106,11 +111,13 @@ int initialize_mpi()
     #endif
 
     // initialize MPI if it has not been initialized by another program
+    // Simulation.run_async calls MPI from a worker thread, one thread at a time
     int external_init = 0;
     MPI_Initialized(&external_init);
     if (!external_init)
         {
-        MPI_Init(0, (char ***) NULL);
+        int provided;
+        MPI_Init_thread(0, (char ***) NULL, MPI_THREAD_SERIALIZED, &provided);
         }
 
     return external_init;
@@ -132,6 +139,18 @@ void finalize_mpi()
     }
 #endif
 
+//! Check whether threads other than the main thread may call MPI, one at a time
+bool mpi_threads_serialized()
+    {
+    #ifdef ENABLE_MPI
+    int provided;
+    MPI_Query_thread(&provided);
+    return provided >= MPI_THREAD_SERIALIZED;
+    #else
+    return true;
+    #endif
+    }
+
 //! Abort MPI runs
 void abort_mpi(std::shared_ptr<MPIConfiguration> mpi_conf, int errorcode)
     {
@@ -179,6 +198,7 @@ PYBIND11_MODULE(_hoomd, m)
     m.def("abort_mpi", abort_mpi);
     m.def("mpi_barrier_world", mpi_barrier_world);
     m.def("mpi_bcast_str", mpi_bcast_str);
+    m.def("mpi_threads_serialized", mpi_threads_serialized);
 
     pybind11::class_<BuildInfo>(m, "BuildInfo")
         .def_static("getVersion", BuildInfo::getVersion)
@@ -216,11 +236,17 @@ PYBIND11_MODULE(_hoomd, m)
     export_BoxDim(m);
     export_ParticleData(m);
     export_SnapshotParticleData(m);
+    export_DistributedSnapshotParticleData(m);
     export_LocalParticleData<HOOMDHostBuffer>(m, "LocalParticleDataHost");
     #if ENABLE_HIP
     export_LocalParticleData<HOOMDDeviceBuffer>(m, "LocalParticleDataDevice");
     #endif
+    export_LocalForceComputeData<HOOMDHostBuffer>(m, "LocalForceComputeDataHost");
+    #if ENABLE_HIP
+    export_LocalForceComputeData<HOOMDDeviceBuffer>(m, "LocalForceComputeDataDevice");
+    #endif
     export_MPIConfiguration(m);
+    export_AutotunerDatabase(m);
     export_ExecutionConfiguration(m);
     export_SystemDefinition(m);
     export_SnapshotSystemData(m);
@@ -258,6 +284,7 @@ PYBIND11_MODULE(_hoomd, m)
     // initializers
     export_GSDReader(m);
     getardump::export_GetarInitializer(m);
+    export_DistributedInitializers(m);
 
     // computes
     export_Compute(m);
@@ -279,6 +306,8 @@ PYBIND11_MODULE(_hoomd, m)
     getardump::export_GetarDumpWriter(m);
     export_GSDDumpWriter(m);
     export_Logger(m);
+    export_LogBuffer(m);
+    export_ParticleDataStager(m);
     export_LogPlainTXT(m);
     export_LogMatrix(m);
     export_LogHDF5(m);
@@ -289,6 +318,10 @@ PYBIND11_MODULE(_hoomd, m)
     export_PythonUpdater(m);
     export_Integrator(m);
     export_BoxResizeUpdater(m);
+#ifdef ENABLE_HIP
+    export_BoxResizeUpdaterGPU(m);
+#endif
+    export_UpdaterReplicaExchange(m);
 
     // tuners
     export_Tuner(m);
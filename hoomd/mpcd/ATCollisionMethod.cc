@@ -9,8 +9,6 @@
  */
 
 #include "ATCollisionMethod.h"
-#include "hoomd/RandomNumbers.h"
-#include "hoomd/RNGIdentifiers.h"
 
 mpcd::ATCollisionMethod::ATCollisionMethod(std::shared_ptr<mpcd::SystemData> sysdata,
                                            unsigned int cur_timestep,
@@ -24,16 +22,12 @@ mpcd::ATCollisionMethod::ATCollisionMethod(std::shared_ptr<mpcd::SystemData> sys
       m_thermo(thermo), m_rand_thermo(rand_thermo), m_T(T)
     {
     m_exec_conf->msg->notice(5) << "Constructing MPCD AT collision method" << std::endl;
-
-    m_thermo->getCallbackSignal().connect<mpcd::ATCollisionMethod, &mpcd::ATCollisionMethod::drawVelocities>(this);
     }
 
 
 mpcd::ATCollisionMethod::~ATCollisionMethod()
     {
     m_exec_conf->msg->notice(5) << "Destroying MPCD AT collision method" << std::endl;
-
-    m_thermo->getCallbackSignal().disconnect<mpcd::ATCollisionMethod, &mpcd::ATCollisionMethod::drawVelocities>(this);
     }
 
 /*!
@@ -45,99 +39,41 @@ void mpcd::ATCollisionMethod::rule(unsigned int timestep)
 
     if (m_prof) m_prof->push("MPCD collide");
     // compute the cell average of the random velocities
-    m_pdata->swapVelocities(); m_mpcd_pdata->swapVelocities();
+    const mpcd::detail::ATRandomVelocity rand_vel(m_seed, timestep, (*m_T)(timestep));
+    m_rand_thermo->setRandomVelocities(rand_vel);
     m_rand_thermo->compute(timestep);
-    m_pdata->swapVelocities(); m_mpcd_pdata->swapVelocities();
 
     if (m_prof) m_prof->push(m_exec_conf, "apply");
     // apply random velocities
-    applyVelocities();
+    applyVelocities(timestep, rand_vel);
     if (m_prof) m_prof->pop(m_exec_conf);
 
     if (m_prof) m_prof->pop();
     }
 
 /*!
- * \param timestep Current timestep.
+ * \param timestep Current timestep
+ * \param rand_vel Random velocities of the particles
  */
-void mpcd::ATCollisionMethod::drawVelocities(unsigned int timestep)
+void mpcd::ATCollisionMethod::applyVelocities(unsigned int timestep, const mpcd::detail::ATRandomVelocity& rand_vel)
     {
     // mpcd particle data
+    ArrayHandle<MPCDReal4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
     ArrayHandle<unsigned int> h_tag(m_mpcd_pdata->getTags(), access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_alt_vel(m_mpcd_pdata->getAltVelocities(), access_location::host, access_mode::overwrite);
+    const Scalar mpcd_mass = m_mpcd_pdata->getMass();
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
     unsigned int N_tot = N_mpcd;
 
     // embedded particle data
     std::unique_ptr< ArrayHandle<unsigned int> > h_embed_idx;
     std::unique_ptr< ArrayHandle<Scalar4> > h_vel_embed;
-    std::unique_ptr< ArrayHandle<Scalar4> > h_alt_vel_embed;
     std::unique_ptr< ArrayHandle<unsigned int> > h_tag_embed;
-    if (m_embed_group)
-        {
-        h_embed_idx.reset(new ArrayHandle<unsigned int>(m_embed_group->getIndexArray(), access_location::host, access_mode::read));
-        h_vel_embed.reset(new ArrayHandle<Scalar4>(m_pdata->getVelocities(), access_location::host, access_mode::read));
-        h_alt_vel_embed.reset(new ArrayHandle<Scalar4>(m_pdata->getAltVelocities(), access_location::host, access_mode::overwrite));
-        h_tag_embed.reset(new ArrayHandle<unsigned int>(m_pdata->getTags(), access_location::host, access_mode::read));
-        N_tot += m_embed_group->getNumMembers();
-        }
-
-    // random velocities are drawn for each particle and stored into the "alternate" arrays
-    const Scalar T = (*m_T)(timestep);
-    for (unsigned int idx=0; idx < N_tot; ++idx)
-        {
-        unsigned int pidx;
-        unsigned int tag; Scalar mass;
-        if (idx < N_mpcd)
-            {
-            pidx = idx;
-            mass = m_mpcd_pdata->getMass();
-            tag = h_tag.data[idx];
-            }
-        else
-            {
-            pidx = h_embed_idx->data[idx-N_mpcd];
-            mass = h_vel_embed->data[pidx].w;
-            tag = h_tag_embed->data[pidx];
-            }
-
-        // draw random velocities from normal distribution
-        hoomd::RandomGenerator rng(hoomd::RNGIdentifier::ATCollisionMethod, m_seed, tag, timestep);
-        hoomd::NormalDistribution<Scalar> gen(fast::sqrt(T/mass), 0.0);
-        Scalar3 vel;
-        gen(vel.x, vel.y, rng);
-        vel.z = gen(rng);
-
-        // save out velocities
-        if (idx < N_mpcd)
-            {
-            h_alt_vel.data[pidx] = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
-            }
-        else
-            {
-            h_alt_vel_embed->data[pidx] = make_scalar4(vel.x, vel.y, vel.z, mass);
-            }
-        }
-    }
-
-void mpcd::ATCollisionMethod::applyVelocities()
-    {
-    // mpcd particle data
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar4> h_vel_alt(m_mpcd_pdata->getAltVelocities(), access_location::host, access_mode::read);
-    const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
-    unsigned int N_tot = N_mpcd;
-
-    // embedded particle data
-    std::unique_ptr< ArrayHandle<unsigned int> > h_embed_idx;
-    std::unique_ptr< ArrayHandle<Scalar4> > h_vel_embed;
-    std::unique_ptr< ArrayHandle<Scalar4> > h_vel_alt_embed;
     std::unique_ptr< ArrayHandle<unsigned int> > h_embed_cell_ids;
     if (m_embed_group)
         {
         h_embed_idx.reset(new ArrayHandle<unsigned int>(m_embed_group->getIndexArray(), access_location::host, access_mode::read));
         h_vel_embed.reset(new ArrayHandle<Scalar4>(m_pdata->getVelocities(), access_location::host, access_mode::readwrite));
-        h_vel_alt_embed.reset(new ArrayHandle<Scalar4>(m_pdata->getAltVelocities(), access_location::host, access_mode::read));
+        h_tag_embed.reset(new ArrayHandle<unsigned int>(m_pdata->getTags(), access_location::host, access_mode::read));
         h_embed_cell_ids.reset(new ArrayHandle<unsigned int>(m_cl->getEmbeddedGroupCellIds(), access_location::host, access_mode::read));
         N_tot += m_embed_group->getNumMembers();
         }
@@ -148,19 +84,21 @@ void mpcd::ATCollisionMethod::applyVelocities()
     for (unsigned int idx=0; idx < N_tot; ++idx)
         {
         unsigned int cell, pidx;
-        Scalar4 vel_rand;
+        Scalar3 vel_rand; Scalar mass;
         if (idx < N_mpcd)
             {
             pidx = idx;
-            const Scalar4 vel_cell = h_vel.data[idx];
-            cell = __scalar_as_int(vel_cell.w);
-            vel_rand = h_vel_alt.data[idx];
+            const MPCDReal4 vel_cell = h_vel.data[idx];
+            cell = __mpcdreal_as_int(vel_cell.w);
+            mass = mpcd_mass;
+            vel_rand = rand_vel(h_tag.data[pidx], mass);
             }
         else
             {
             pidx = h_embed_idx->data[idx-N_mpcd];
             cell = h_embed_cell_ids->data[idx-N_mpcd];
-            vel_rand = h_vel_alt_embed->data[pidx];
+            mass = h_vel_embed->data[pidx].w;
+            vel_rand = rand_vel(h_tag_embed->data[pidx], mass);
             }
 
         // load cell data
@@ -174,11 +112,11 @@ void mpcd::ATCollisionMethod::applyVelocities()
 
         if (idx < N_mpcd)
             {
-            h_vel.data[pidx] = make_scalar4(vnew.x, vnew.y, vnew.z, __int_as_scalar(cell));
+            h_vel.data[pidx] = make_mpcdreal4(vnew.x, vnew.y, vnew.z, __int_as_mpcdreal(cell));
             }
         else
             {
-            h_vel_embed->data[pidx] = make_scalar4(vnew.x, vnew.y, vnew.z, vel_rand.w);
+            h_vel_embed->data[pidx] = make_scalar4(vnew.x, vnew.y, vnew.z, mass);
             }
         }
     }
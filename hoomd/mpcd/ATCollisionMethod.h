@@ -15,6 +15,7 @@
 #error This header cannot be compiled by nvcc
 #endif
 
+#include "ATCollisionMethodUtilities.h"
 #include "CollisionMethod.h"
 #include "CellThermoCompute.h"
 
@@ -24,6 +25,11 @@ namespace mpcd
 {
 
 //! Implements the Anderson thermostat collision rule for MPCD.
+/*!
+ * Each particle is given a random velocity, and the average random velocity of its cell is replaced by the average
+ * velocity of the cell. The random velocities are never stored: they are regenerated from the particle tags when
+ * the random cell velocities are summed and again when they are applied (see mpcd::detail::ATRandomVelocity).
+ */
 class PYBIND11_EXPORT ATCollisionMethod : public mpcd::CollisionMethod
     {
     public:
@@ -40,6 +46,18 @@ class PYBIND11_EXPORT ATCollisionMethod : public mpcd::CollisionMethod
         //! Destructor
         virtual ~ATCollisionMethod();
 
+        //! Set the virtual particle fillers of the boundaries
+        /*!
+         * \param fillers Virtual particle fillers
+         *
+         * The random velocities of the virtual particles do not carry the velocity of the boundary.
+         */
+        virtual void setFillers(const std::vector<std::shared_ptr<mpcd::VirtualParticleFiller>>& fillers)
+            {
+            m_thermo->setFillers(fillers);
+            m_rand_thermo->setFillers(fillers, true);
+            }
+
         //! Set the temperature and enable the thermostat
         void setTemperature(std::shared_ptr<::Variant> T)
             {
@@ -54,11 +72,8 @@ class PYBIND11_EXPORT ATCollisionMethod : public mpcd::CollisionMethod
         //! Implementation of the collision rule
         virtual void rule(unsigned int timestep);
 
-        //! Draw velocities for particles in each cell
-        virtual void drawVelocities(unsigned int timestep);
-
         //! Apply the random velocities to particles in each cell
-        virtual void applyVelocities();
+        virtual void applyVelocities(unsigned int timestep, const mpcd::detail::ATRandomVelocity& rand_vel);
     };
 
 namespace detail
@@ -21,72 +21,22 @@ mpcd::ATCollisionMethodGPU::ATCollisionMethodGPU(std::shared_ptr<mpcd::SystemDat
                                                  std::shared_ptr<::Variant> T)
     : mpcd::ATCollisionMethod(sysdata,cur_timestep,period,phase,seed,thermo,rand_thermo,T)
     {
-    m_tuner_draw.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_at_draw", m_exec_conf));
-    m_tuner_apply.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_at_apply", m_exec_conf));
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_tuner_apply.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_at_apply", m_exec_conf));
     }
 
-void mpcd::ATCollisionMethodGPU::drawVelocities(unsigned int timestep)
+/*!
+ * \param timestep Current timestep
+ * \param rand_vel Random velocities of the particles
+ *
+ * The embedded particles are updated in the staging buffer of the cell list, which is written back once afterwards.
+ */
+void mpcd::ATCollisionMethodGPU::applyVelocities(unsigned int timestep,
+                                                 const mpcd::detail::ATRandomVelocity& rand_vel)
     {
     // mpcd particle data
+    ArrayHandle<MPCDReal4> d_vel(m_mpcd_pdata->getVelocities(), access_location::device, access_mode::readwrite);
     ArrayHandle<unsigned int> d_tag(m_mpcd_pdata->getTags(), access_location::device, access_mode::read);
-    ArrayHandle<Scalar4> d_alt_vel(m_mpcd_pdata->getAltVelocities(), access_location::device, access_mode::overwrite);
-    const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
-    unsigned int N_tot = N_mpcd;
-
-    // random velocities are drawn for each particle and stored into the "alternate" arrays
-    const Scalar T = (*m_T)(timestep);
-
-    if (m_embed_group)
-        {
-        ArrayHandle<unsigned int> d_embed_idx(m_embed_group->getIndexArray(), access_location::device, access_mode::read);
-        ArrayHandle<Scalar4> d_vel_embed(m_pdata->getVelocities(), access_location::device, access_mode::read);
-        ArrayHandle<Scalar4> d_alt_vel_embed(m_pdata->getAltVelocities(), access_location::device, access_mode::overwrite);
-        ArrayHandle<unsigned int> d_tag_embed(m_pdata->getTags(), access_location::device, access_mode::read);
-        N_tot += m_embed_group->getNumMembers();
-
-        m_tuner_draw->begin();
-        mpcd::gpu::at_draw_velocity(d_alt_vel.data,
-                                    d_alt_vel_embed.data,
-                                    d_tag.data,
-                                    m_mpcd_pdata->getMass(),
-                                    d_embed_idx.data,
-                                    d_vel_embed.data,
-                                    d_tag_embed.data,
-                                    timestep,
-                                    m_seed,
-                                    T,
-                                    N_mpcd,
-                                    N_tot,
-                                    m_tuner_draw->getParam());
-        if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
-        m_tuner_draw->end();
-        }
-    else
-        {
-        m_tuner_draw->begin();
-        mpcd::gpu::at_draw_velocity(d_alt_vel.data,
-                                    NULL,
-                                    d_tag.data,
-                                    m_mpcd_pdata->getMass(),
-                                    NULL,
-                                    NULL,
-                                    NULL,
-                                    timestep,
-                                    m_seed,
-                                    T,
-                                    N_mpcd,
-                                    N_tot,
-                                    m_tuner_draw->getParam());
-        if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
-        m_tuner_draw->end();
-        }
-    }
-
-void mpcd::ATCollisionMethodGPU::applyVelocities()
-    {
-    // mpcd particle data
-    ArrayHandle<Scalar4> d_vel(m_mpcd_pdata->getVelocities(), access_location::device, access_mode::readwrite);
-    ArrayHandle<Scalar4> d_vel_alt(m_mpcd_pdata->getAltVelocities(), access_location::device, access_mode::read);
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
     unsigned int N_tot = N_mpcd;
 
@@ -96,38 +46,47 @@ void mpcd::ATCollisionMethodGPU::applyVelocities()
 
     if (m_embed_group)
         {
-        ArrayHandle<unsigned int> d_embed_idx(m_embed_group->getIndexArray(), access_location::device, access_mode::read);
-        ArrayHandle<Scalar4> d_vel_embed(m_pdata->getVelocities(), access_location::device, access_mode::readwrite);
-        ArrayHandle<Scalar4> d_vel_alt_embed(m_pdata->getAltVelocities(), access_location::device, access_mode::read);
-        ArrayHandle<unsigned int> d_embed_cell_ids(m_cl->getEmbeddedGroupCellIds(), access_location::device, access_mode::read);
-        N_tot += m_embed_group->getNumMembers();
+        m_cl->stageEmbeddedParticles(timestep);
+            {
+            ArrayHandle<Scalar4> d_vel_embed(m_cl->getEmbeddedVelocities(),
+                                             access_location::device,
+                                             access_mode::readwrite);
+            ArrayHandle<unsigned int> d_tag_embed(m_cl->getEmbeddedTags(), access_location::device, access_mode::read);
+            ArrayHandle<unsigned int> d_embed_cell_ids(m_cl->getEmbeddedGroupCellIds(),
+                                                       access_location::device,
+                                                       access_mode::read);
+            N_tot += m_embed_group->getNumMembers();
 
-        m_tuner_apply->begin();
-        mpcd::gpu::at_apply_velocity(d_vel.data,
-                                     d_vel_embed.data,
-                                     d_vel_alt.data,
-                                     d_embed_idx.data,
-                                     d_vel_alt_embed.data,
-                                     d_embed_cell_ids.data,
-                                     d_cell_vel.data,
-                                     d_rand_vel.data,
-                                     N_mpcd,
-                                     N_tot,
-                                     m_tuner_apply->getParam());
-        if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
-        m_tuner_apply->end();
+            m_tuner_apply->begin();
+            mpcd::gpu::at_apply_velocity(d_vel.data,
+                                         d_vel_embed.data,
+                                         d_tag.data,
+                                         m_mpcd_pdata->getMass(),
+                                         d_tag_embed.data,
+                                         d_embed_cell_ids.data,
+                                         d_cell_vel.data,
+                                         d_rand_vel.data,
+                                         rand_vel,
+                                         N_mpcd,
+                                         N_tot,
+                                         m_tuner_apply->getParam());
+            if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+            m_tuner_apply->end();
+            }
+        m_cl->unstageEmbeddedParticles();
         }
     else
         {
         m_tuner_apply->begin();
         mpcd::gpu::at_apply_velocity(d_vel.data,
                                      NULL,
-                                     d_vel_alt.data,
-                                     NULL,
+                                     d_tag.data,
+                                     m_mpcd_pdata->getMass(),
                                      NULL,
                                      NULL,
                                      d_cell_vel.data,
                                      d_rand_vel.data,
+                                     rand_vel,
                                      N_mpcd,
                                      N_tot,
                                      m_tuner_apply->getParam());
@@ -10,8 +10,6 @@
 
 #include "ATCollisionMethodGPU.cuh"
 #include "ParticleDataUtilities.h"
-#include "hoomd/RandomNumbers.h"
-#include "hoomd/RNGIdentifiers.h"
 
 namespace mpcd
 {
@@ -19,65 +17,15 @@ namespace gpu
 {
 namespace kernel
 {
-__global__ void at_draw_velocity(Scalar4 *d_alt_vel,
-                                 Scalar4 *d_alt_vel_embed,
-                                 const unsigned int *d_tag,
-                                 const Scalar mpcd_mass,
-                                 const unsigned int *d_embed_idx,
-                                 const Scalar4 *d_vel_embed,
-                                 const unsigned int *d_tag_embed,
-                                 const unsigned int timestep,
-                                 const unsigned int seed,
-                                 const Scalar T,
-                                 const unsigned int N_mpcd,
-                                 const unsigned int N_tot)
-    {
-    // one thread per particle
-    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
-    if (idx >= N_tot)
-        return;
-
-    unsigned int pidx;
-    unsigned int tag; Scalar mass;
-    if (idx < N_mpcd)
-        {
-        pidx = idx;
-        mass = mpcd_mass;
-        tag = d_tag[idx];
-        }
-    else
-        {
-        pidx = d_embed_idx[idx-N_mpcd];
-        mass = d_vel_embed[pidx].w;
-        tag = d_tag_embed[pidx];
-        }
-
-    // draw random velocities from normal distribution
-    hoomd::RandomGenerator rng(hoomd::RNGIdentifier::ATCollisionMethod, seed, tag, timestep);
-    hoomd::NormalDistribution<Scalar> gen(fast::sqrt(T/mass), 0.0);
-    Scalar3 vel;
-    gen(vel.x, vel.y, rng);
-    vel.z = gen(rng);
-
-    // save out velocities
-    if (idx < N_mpcd)
-        {
-        d_alt_vel[pidx] = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
-        }
-    else
-        {
-        d_alt_vel_embed[pidx] = make_scalar4(vel.x, vel.y, vel.z, mass);
-        }
-    }
-
-__global__ void at_apply_velocity(Scalar4 *d_vel,
+__global__ void at_apply_velocity(MPCDReal4 *d_vel,
                                   Scalar4 *d_vel_embed,
-                                  const Scalar4 *d_vel_alt,
-                                  const unsigned int *d_embed_idx,
-                                  const Scalar4 *d_vel_alt_embed,
+                                  const unsigned int *d_tag,
+                                  const Scalar mpcd_mass,
+                                  const unsigned int *d_tag_embed,
                                   const unsigned int *d_embed_cell_ids,
                                   const double4 *d_cell_vel,
                                   const double4 *d_rand_vel,
+                                  const mpcd::detail::ATRandomVelocity rand_vel,
                                   const unsigned int N_mpcd,
                                   const unsigned int N_tot)
     {
@@ -87,19 +35,22 @@ __global__ void at_apply_velocity(Scalar4 *d_vel,
         return;
 
     unsigned int cell, pidx;
-    Scalar4 vel_rand;
+    Scalar3 vel_rand; Scalar mass;
     if (idx < N_mpcd)
         {
         pidx = idx;
-        const Scalar4 vel_cell = d_vel[idx];
-        cell = __scalar_as_int(vel_cell.w);
-        vel_rand = d_vel_alt[idx];
+        const MPCDReal4 vel_cell = d_vel[idx];
+        cell = __mpcdreal_as_int(vel_cell.w);
+        mass = mpcd_mass;
+        vel_rand = rand_vel(d_tag[pidx], mass);
         }
     else
         {
-        pidx = d_embed_idx[idx-N_mpcd];
-        cell = d_embed_cell_ids[idx-N_mpcd];
-        vel_rand = d_vel_alt_embed[pidx];
+        // the embedded particles are staged in the order of the group members
+        pidx = idx-N_mpcd;
+        cell = d_embed_cell_ids[pidx];
+        mass = d_vel_embed[pidx].w;
+        vel_rand = rand_vel(d_tag_embed[pidx], mass);
         }
 
     // load cell data
@@ -113,65 +64,25 @@ __global__ void at_apply_velocity(Scalar4 *d_vel,
 
     if (idx < N_mpcd)
         {
-        d_vel[pidx] = make_scalar4(vnew.x, vnew.y, vnew.z, __int_as_scalar(cell));
+        d_vel[pidx] = make_mpcdreal4(vnew.x, vnew.y, vnew.z, __int_as_mpcdreal(cell));
         }
     else
         {
-        d_vel_embed[pidx] = make_scalar4(vnew.x, vnew.y, vnew.z, vel_rand.w);
+        d_vel_embed[pidx] = make_scalar4(vnew.x, vnew.y, vnew.z, mass);
         }
     }
 
 } // end namespace kernel
 
-cudaError_t at_draw_velocity(Scalar4 *d_alt_vel,
-                             Scalar4 *d_alt_vel_embed,
-                             const unsigned int *d_tag,
-                             const Scalar mpcd_mass,
-                             const unsigned int *d_embed_idx,
-                             const Scalar4 *d_vel_embed,
-                             const unsigned int *d_tag_embed,
-                             const unsigned int timestep,
-                             const unsigned int seed,
-                             const Scalar T,
-                             const unsigned int N_mpcd,
-                             const unsigned int N_tot,
-                             const unsigned int block_size)
-    {
-    static unsigned int max_block_size = UINT_MAX;
-    if (max_block_size == UINT_MAX)
-        {
-        cudaFuncAttributes attr;
-        cudaFuncGetAttributes(&attr, (const void*)mpcd::gpu::kernel::at_draw_velocity);
-        max_block_size = attr.maxThreadsPerBlock;
-        }
-
-    unsigned int run_block_size = min(block_size, max_block_size);
-
-    dim3 grid(N_tot / run_block_size + 1);
-    mpcd::gpu::kernel::at_draw_velocity<<<grid, run_block_size>>>(d_alt_vel,
-                                                                  d_alt_vel_embed,
-                                                                  d_tag,
-                                                                  mpcd_mass,
-                                                                  d_embed_idx,
-                                                                  d_vel_embed,
-                                                                  d_tag_embed,
-                                                                  timestep,
-                                                                  seed,
-                                                                  T,
-                                                                  N_mpcd,
-                                                                  N_tot);
-
-    return cudaSuccess;
-    }
-
-cudaError_t at_apply_velocity(Scalar4 *d_vel,
+cudaError_t at_apply_velocity(MPCDReal4 *d_vel,
                               Scalar4 *d_vel_embed,
-                              const Scalar4 *d_vel_alt,
-                              const unsigned int *d_embed_idx,
-                              const Scalar4 *d_vel_alt_embed,
+                              const unsigned int *d_tag,
+                              const Scalar mpcd_mass,
+                              const unsigned int *d_tag_embed,
                               const unsigned int *d_embed_cell_ids,
                               const double4 *d_cell_vel,
                               const double4 *d_rand_vel,
+                              const mpcd::detail::ATRandomVelocity& rand_vel,
                               const unsigned int N_mpcd,
                               const unsigned int N_tot,
                               const unsigned int block_size)
@@ -189,12 +100,13 @@ cudaError_t at_apply_velocity(Scalar4 *d_vel,
     dim3 grid(N_tot / run_block_size + 1);
     mpcd::gpu::kernel::at_apply_velocity<<<grid, run_block_size>>>(d_vel,
                                                                    d_vel_embed,
-                                                                   d_vel_alt,
-                                                                   d_embed_idx,
-                                                                   d_vel_alt_embed,
+                                                                   d_tag,
+                                                                   mpcd_mass,
+                                                                   d_tag_embed,
                                                                    d_embed_cell_ids,
                                                                    d_cell_vel,
                                                                    d_rand_vel,
+                                                                   rand_vel,
                                                                    N_mpcd,
                                                                    N_tot);
 
@@ -13,6 +13,8 @@
 
 #include <cuda_runtime.h>
 
+#include "ATCollisionMethodUtilities.h"
+#include "ParticleDataUtilities.h"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
 
@@ -21,30 +23,16 @@ namespace mpcd
 namespace gpu
 {
 
-//! Draw particle velocities for the Andersen thermostat from Gaussian distribution
-cudaError_t at_draw_velocity(Scalar4 *d_alt_vel,
-                             Scalar4 *d_alt_vel_embed,
-                             const unsigned int *d_tag,
-                             const Scalar mpcd_mass,
-                             const unsigned int *d_embed_idx,
-                             const Scalar4 *d_vel_embed,
-                             const unsigned int *d_tag_embed,
-                             const unsigned int timestep,
-                             const unsigned int seed,
-                             const Scalar T,
-                             const unsigned int N_mpcd,
-                             const unsigned int N_tot,
-                             const unsigned int block_size);
-
 //! Apply velocities for the Andersen thermostat
-cudaError_t at_apply_velocity(Scalar4 *d_vel,
+cudaError_t at_apply_velocity(MPCDReal4 *d_vel,
                               Scalar4 *d_vel_embed,
-                              const Scalar4 *d_vel_alt,
-                              const unsigned int *d_embed_idx,
-                              const Scalar4 *d_vel_alt_embed,
+                              const unsigned int *d_tag,
+                              const Scalar mpcd_mass,
+                              const unsigned int *d_tag_embed,
                               const unsigned int *d_embed_cell_ids,
                               const double4 *d_cell_vel,
                               const double4 *d_rand_vel,
+                              const mpcd::detail::ATRandomVelocity& rand_vel,
                               const unsigned int N_mpcd,
                               const unsigned int N_tot,
                               const unsigned int block_size);
@@ -43,19 +43,14 @@ class PYBIND11_EXPORT ATCollisionMethodGPU : public mpcd::ATCollisionMethod
             {
             mpcd::ATCollisionMethod::setAutotunerParams(enable, period);
 
-            m_tuner_draw->setPeriod(period); m_tuner_draw->setEnabled(enable);
             m_tuner_apply->setPeriod(period); m_tuner_apply->setEnabled(enable);
             }
 
     protected:
-        //! Draw velocities for particles in each cell on the GPU
-        virtual void drawVelocities(unsigned int timestep);
-
         //! Apply the random velocities to particles in each cell on the GPU
-        virtual void applyVelocities();
+        virtual void applyVelocities(unsigned int timestep, const mpcd::detail::ATRandomVelocity& rand_vel);
 
     private:
-        std::unique_ptr<Autotuner> m_tuner_draw;    //!< Tuner for drawing random velocities
         std::unique_ptr<Autotuner> m_tuner_apply;   //!< Tuner for applying random velocities
     };
 
@@ -0,0 +1,80 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: mphoward
+
+#ifndef MPCD_AT_COLLISION_METHOD_UTILITIES_H_
+#define MPCD_AT_COLLISION_METHOD_UTILITIES_H_
+
+/*!
+ * \file mpcd/ATCollisionMethodUtilities.h
+ * \brief Utilities for drawing the random velocities of the Andersen thermostat on the CPU and GPU
+ */
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/RandomNumbers.h"
+#include "hoomd/RNGIdentifiers.h"
+
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+namespace mpcd
+{
+namespace detail
+{
+
+//! Random velocities of the Andersen thermostat collision
+/*!
+ * The random velocity of a particle is drawn from a counter-based generator seeded by the particle tag and
+ * the timestep, so the same velocity can be regenerated wherever it is needed instead of being stored.
+ */
+class ATRandomVelocity
+    {
+    public:
+        //! Default constructor
+        HOSTDEVICE ATRandomVelocity()
+            : m_seed(0), m_timestep(0), m_T(0)
+            { }
+
+        //! Constructor
+        /*!
+         * \param seed Seed of the collision method
+         * \param timestep Timestep of the collision
+         * \param T Temperature of the thermostat
+         */
+        HOSTDEVICE ATRandomVelocity(unsigned int seed, unsigned int timestep, Scalar T)
+            : m_seed(seed), m_timestep(timestep), m_T(T)
+            { }
+
+        //! Draw the random velocity of a particle
+        /*!
+         * \param tag Particle tag
+         * \param mass Particle mass
+         * \returns Velocity drawn from the Maxwell-Boltzmann distribution at the thermostat temperature
+         */
+        HOSTDEVICE Scalar3 operator()(unsigned int tag, Scalar mass) const
+            {
+            hoomd::RandomGenerator rng(hoomd::RNGIdentifier::ATCollisionMethod, m_seed, tag, m_timestep);
+            hoomd::NormalDistribution<Scalar> gen(fast::sqrt(m_T/mass), 0.0);
+            Scalar3 vel;
+            gen(vel.x, vel.y, rng);
+            vel.z = gen(rng);
+            return vel;
+            }
+
+    private:
+        unsigned int m_seed;        //!< Seed of the collision method
+        unsigned int m_timestep;    //!< Timestep of the collision
+        Scalar m_T;                 //!< Temperature of the thermostat
+    };
+
+} // end namespace detail
+} // end namespace mpcd
+
+#undef HOSTDEVICE
+
+#endif // MPCD_AT_COLLISION_METHOD_UTILITIES_H_
@@ -25,6 +25,10 @@ template cudaError_t nve_bounce_step_one<mpcd::detail::SlitGeometry>
 template cudaError_t nve_bounce_step_one<mpcd::detail::SlitPoreGeometry>
     (const bounce_args_t& args, const mpcd::detail::SlitPoreGeometry& geom);
 
+//! Template instantiation of signed distance field geometry streaming
+template cudaError_t nve_bounce_step_one<mpcd::detail::SDFGeometry>
+    (const bounce_args_t& args, const mpcd::detail::SDFGeometry& geom);
+
 namespace kernel
 {
 //! Kernel for applying second step of velocity Verlet algorithm with bounce back
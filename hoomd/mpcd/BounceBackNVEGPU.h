@@ -35,8 +35,9 @@ class PYBIND11_EXPORT BounceBackNVEGPU : public BounceBackNVE<Geometry>
                          std::shared_ptr<const Geometry> geom)
             : BounceBackNVE<Geometry>(sysdef, group, geom)
             {
-            m_tuner_1.reset(new Autotuner(32, 1024, 32, 5, 100000, "nve_bounce_1", this->m_exec_conf));
-            m_tuner_2.reset(new Autotuner(32, 1024, 32, 5, 100000, "nve_bounce_2", this->m_exec_conf));
+            unsigned int warp_size = this->m_exec_conf->dev_prop.warpSize;
+            m_tuner_1.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "nve_bounce_1", this->m_exec_conf));
+            m_tuner_2.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "nve_bounce_2", this->m_exec_conf));
             }
 
         //! Performs the first step of the integration
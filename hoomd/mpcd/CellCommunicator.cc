@@ -29,6 +29,7 @@ mpcd::CellCommunicator::CellCommunicator(std::shared_ptr<SystemDefinition> sysde
       m_decomposition(m_pdata->getDomainDecomposition()),
       m_cl(cl),
       m_communicating(false),
+      m_device_direct(false),
       m_send_buf(m_exec_conf),
       m_recv_buf(m_exec_conf),
       m_needs_init(true)
@@ -37,8 +38,11 @@ mpcd::CellCommunicator::CellCommunicator(std::shared_ptr<SystemDefinition> sysde
     #ifdef ENABLE_HIP
     if (m_exec_conf->isCUDAEnabled())
         {
-        m_tuner_pack.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_cell_comm_pack_" + std::to_string(m_id), m_exec_conf));
-        m_tuner_unpack.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_cell_comm_unpack_" + std::to_string(m_id), m_exec_conf));
+        unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+        m_tuner_pack.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000,
+            "mpcd_cell_comm_pack_" + std::to_string(m_id), m_exec_conf));
+        m_tuner_unpack.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000,
+            "mpcd_cell_comm_unpack_" + std::to_string(m_id), m_exec_conf));
         }
     #endif // ENABLE_HIP
 
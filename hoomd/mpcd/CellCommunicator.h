@@ -70,6 +70,19 @@ class PYBIND11_EXPORT CellCommunicator
         template<typename T, class PackOpT>
         void finalize(const GPUArray<T>& props, const PackOpT op);
 
+        //! Progress the outstanding communication
+        /*!
+         * Many MPI libraries only move nonblocking messages forward inside MPI calls. Calling this
+         * periodically while other work proceeds lets the reduction complete in the background
+         * instead of in finalize(). It is safe to call when no communication is occurring.
+         */
+        void progress()
+            {
+            if (!m_communicating || m_reqs.empty()) return;
+            int done(0);
+            MPI_Testall((unsigned int)m_reqs.size(), m_reqs.data(), &done, MPI_STATUSES_IGNORE);
+            }
+
         //! Get the number of unique cells with communication
         unsigned int getNCells()
             {
@@ -126,6 +139,7 @@ class PYBIND11_EXPORT CellCommunicator
         std::shared_ptr<mpcd::CellList> m_cl;   //!< MPCD cell list
 
         bool m_communicating;   //!< Flag if communication is occurring
+        bool m_device_direct;   //!< Flag if the buffers in flight are device memory
         GPUVector<unsigned char> m_send_buf;    //!< Send buffer
         GPUVector<unsigned char> m_recv_buf;    //!< Receive buffer
         GPUArray<unsigned int> m_send_idx;      //!< Indexes of cells in send buffer
@@ -224,26 +238,18 @@ void mpcd::CellCommunicator::begin(const GPUArray<T>& props, const PackOpT op)
 
     // make the MPI calls
         {
-        // determine whether to use CPU or GPU CUDA buffers
-        access_location::Enum mpi_loc;
-        #ifdef ENABLE_MPI_CUDA
-        if (m_exec_conf->isCUDAEnabled())
-            {
-            mpi_loc = access_location::device;
-            }
-        else
-        #endif // ENABLE_MPI_CUDA
-            {
-            mpi_loc = access_location::host;
-            }
+        // pass device buffers directly to a CUDA-aware MPI, or stage them on the host
+        m_device_direct = m_exec_conf->isCUDAEnabled() && m_exec_conf->isMPIDeviceDirect();
+        const access_location::Enum mpi_loc = (m_device_direct) ? access_location::device : access_location::host;
 
         ArrayHandle<unsigned char> h_send_buf(m_send_buf, mpi_loc, access_mode::read);
         ArrayHandle<unsigned char> h_recv_buf(m_recv_buf, mpi_loc, access_mode::overwrite);
         typename PackOpT::element* send_buf = reinterpret_cast<typename PackOpT::element*>(h_send_buf.data);
         typename PackOpT::element* recv_buf = reinterpret_cast<typename PackOpT::element*>(h_recv_buf.data);
-        #ifdef ENABLE_MPI_CUDA
-        if (mpi_loc == access_location::device) cudaDeviceSynchronize();
-        #endif // ENABLE_MPI_CUDA
+        #ifdef ENABLE_HIP
+        // the pack kernel must finish before the MPI library reads the device buffer
+        if (m_device_direct) cudaDeviceSynchronize();
+        #endif // ENABLE_HIP
 
         m_reqs.resize(2*m_neighbors.size());
         for (unsigned int idx=0; idx < m_neighbors.size(); ++idx)
@@ -276,10 +282,10 @@ void mpcd::CellCommunicator::finalize(const GPUArray<T>& props, const PackOpT op
 
     // finish all MPI requests
     MPI_Waitall((unsigned int)m_reqs.size(), m_reqs.data(), MPI_STATUSES_IGNORE);
-    #ifdef ENABLE_MPI_CUDA
+    #ifdef ENABLE_HIP
     // MPI calls can execute in multiple streams, so force a synchronization before we move on
-    if (m_exec_conf->isCUDAEnabled()) cudaDeviceSynchronize();
-    #endif // ENABLE_MPI_CUDA
+    if (m_device_direct) cudaDeviceSynchronize();
+    #endif // ENABLE_HIP
 
     // unpack the buffer
     #ifdef ENABLE_HIP
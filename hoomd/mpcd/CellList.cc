@@ -19,8 +19,9 @@ mpcd::CellList::CellList(std::shared_ptr<SystemDefinition> sysdef,
                          std::shared_ptr<mpcd::ParticleData> mpcd_pdata)
         : Compute(sysdef), m_mpcd_pdata(mpcd_pdata),
           m_cell_size(1.0), m_cell_np_max(4), m_cell_np(m_exec_conf), m_cell_list(m_exec_conf),
-          m_embed_cell_ids(m_exec_conf), m_conditions(m_exec_conf), m_needs_compute_dim(true),
-          m_particles_sorted(false), m_virtual_change(false)
+          m_embed_cell_ids(m_exec_conf), m_embed_vel(m_exec_conf), m_embed_tag(m_exec_conf),
+          m_conditions(m_exec_conf), m_needs_compute_dim(true), m_particles_sorted(false),
+          m_embed_order_changed(true), m_embed_staged(false), m_embed_stage_timestep(0), m_virtual_change(false)
     {
     assert(m_mpcd_pdata);
     m_exec_conf->msg->notice(5) << "Constructing MPCD CellList" << std::endl;
@@ -60,6 +61,12 @@ void mpcd::CellList::compute(unsigned int timestep)
     {
     if (m_prof) m_prof->push(m_exec_conf, "MPCD cell list");
 
+    // the cached cells are stale if the particles moved since the cell list was built
+    if (!m_mpcd_pdata->checkCellCache())
+        {
+        m_force_compute = true;
+        }
+
     if (m_virtual_change)
         {
         m_virtual_change = false;
@@ -124,6 +131,169 @@ void mpcd::CellList::compute(unsigned int timestep)
     if (m_prof) m_prof->pop(m_exec_conf);
     }
 
+/*!
+ * \returns Binner that bins particles into the local cells as buildCellList() does
+ */
+mpcd::detail::CellBinner mpcd::CellList::getBinner()
+    {
+    // total effective number of cells in the global box, optionally padded by
+    // extra cells in MPI simulations
+    uint3 n_global_cells = m_global_cell_dim;
+    #ifdef ENABLE_MPI
+    if (isCommunicating(mpcd::detail::face::east)) n_global_cells.x += 2*m_num_extra;
+    if (isCommunicating(mpcd::detail::face::north)) n_global_cells.y += 2*m_num_extra;
+    if (isCommunicating(mpcd::detail::face::up)) n_global_cells.z += 2*m_num_extra;
+    #endif // ENABLE_MPI
+
+    return mpcd::detail::CellBinner(m_pdata->getBox().getPeriodic(),
+                                    m_origin_idx,
+                                    m_grid_shift,
+                                    m_pdata->getGlobalBox().getLo(),
+                                    n_global_cells,
+                                    m_cell_size,
+                                    m_cell_indexer);
+    }
+
+/*!
+ * \returns True if the caller should fill the cell list
+ *
+ * The cell list can be filled outside of compute() when it only holds MPCD particles and its dimensions are
+ * up to date. In this case, the cell counters and condition flags are zeroed. The caller must then bin every
+ * MPCD particle with getBinner(), record it in the cell list and in the cached cell of its velocity as
+ * buildCellList() does, and call finishFusedBuild().
+ */
+bool mpcd::CellList::startFusedBuild()
+    {
+    if (!canFuseBuild())
+        return false;
+
+    ArrayHandle<unsigned int> h_cell_np(m_cell_np, access_location::host, access_mode::overwrite);
+    memset(h_cell_np.data, 0, sizeof(unsigned int) * m_cell_indexer.getNumElements());
+    resetConditions();
+
+    return true;
+    }
+
+/*!
+ * \param timestep Timestep the cell list is built for
+ * \returns True if the cell list is valid
+ *
+ * If the cell list overflowed, it is resized and built again by the next call to compute().
+ * Otherwise, the cell list is marked as computed at \a timestep.
+ */
+bool mpcd::CellList::finishFusedBuild(unsigned int timestep)
+    {
+    if (checkConditions())
+        {
+        reallocate();
+        resetConditions();
+        m_force_compute = true;
+        return false;
+        }
+
+    // the cell list is ready unless something changes before timestep
+    m_virtual_change = false;
+    m_particles_sorted = false;
+    m_force_compute = false;
+    m_last_computed = timestep;
+    m_mpcd_pdata->validateCellCache();
+
+    return true;
+    }
+
+/*!
+ * \param timestep Current timestep
+ *
+ * The velocities and masses of the embedded particles are copied into getEmbeddedVelocities() in the order of the
+ * group members, which is the order the embedded particles have in the cell list. The velocities are only gathered
+ * once per \a timestep, so that the collision methods and their thermo computes share the same copy. The tags are
+ * only gathered again when the particle data was sorted, particles migrated, or the group changed since the last
+ * staging.
+ *
+ * The cell list should be computed before the embedded particles are staged, since building it may migrate the
+ * embedded particles.
+ */
+void mpcd::CellList::stageEmbeddedParticles(unsigned int timestep)
+    {
+    if (!m_embed_group) return;
+
+    const unsigned int N = m_embed_group->getNumMembers();
+    bool tags = m_embed_order_changed;
+    if (m_embed_vel.size() != N)
+        {
+        m_embed_vel.resize(N);
+        m_embed_tag.resize(N);
+        tags = true;
+        }
+    else if (!tags && m_embed_staged && m_embed_stage_timestep == timestep)
+        {
+        return;
+        }
+
+    if (m_prof) m_prof->push(m_exec_conf, "MPCD embed stage");
+    gatherEmbeddedParticles(tags);
+    if (m_prof) m_prof->pop(m_exec_conf);
+
+    m_embed_order_changed = false;
+    m_embed_staged = true;
+    m_embed_stage_timestep = timestep;
+    }
+
+/*!
+ * The staged velocities remain valid, so the embedded particles are not gathered again at the same timestep.
+ */
+void mpcd::CellList::unstageEmbeddedParticles()
+    {
+    if (!m_embed_group || !m_embed_staged) return;
+
+    // the particles cannot be reordered while they are staged
+    assert(!m_embed_order_changed);
+    assert(m_embed_vel.size() == m_embed_group->getNumMembers());
+
+    if (m_prof) m_prof->push(m_exec_conf, "MPCD embed unstage");
+    scatterEmbeddedVelocities();
+    if (m_prof) m_prof->pop(m_exec_conf);
+    }
+
+/*!
+ * \param tags If true, the tags are also gathered
+ */
+void mpcd::CellList::gatherEmbeddedParticles(bool tags)
+    {
+    ArrayHandle<Scalar4> h_embed_vel(m_embed_vel, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_member_idx(m_embed_group->getIndexArray(), access_location::host, access_mode::read);
+    const unsigned int N = m_embed_group->getNumMembers();
+
+    for (unsigned int i=0; i < N; ++i)
+        {
+        h_embed_vel.data[i] = h_vel.data[h_member_idx.data[i]];
+        }
+
+    if (tags)
+        {
+        ArrayHandle<unsigned int> h_embed_tag(m_embed_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+        for (unsigned int i=0; i < N; ++i)
+            {
+            h_embed_tag.data[i] = h_tag.data[h_member_idx.data[i]];
+            }
+        }
+    }
+
+void mpcd::CellList::scatterEmbeddedVelocities()
+    {
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_embed_vel(m_embed_vel, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_member_idx(m_embed_group->getIndexArray(), access_location::host, access_mode::read);
+    const unsigned int N = m_embed_group->getNumMembers();
+
+    for (unsigned int i=0; i < N; ++i)
+        {
+        h_vel.data[h_member_idx.data[i]] = h_embed_vel.data[i];
+        }
+    }
+
 void mpcd::CellList::reallocate()
     {
     m_exec_conf->msg->notice(6) << "Allocating MPCD cell list, " << m_cell_np_max
@@ -496,9 +666,6 @@ bool mpcd::CellList::isCommunicating(mpcd::detail::face dir)
  */
 void mpcd::CellList::buildCellList()
     {
-    const BoxDim& box = m_pdata->getBox();
-    const uchar3 periodic = box.getPeriodic();
-
     ArrayHandle<unsigned int> h_cell_list(m_cell_list, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_cell_np(m_cell_np, access_location::host, access_mode::overwrite);
     // zero the cell counter
@@ -506,8 +673,8 @@ void mpcd::CellList::buildCellList()
 
     uint3 conditions = make_uint3(0,0,0);
 
-    ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+    ArrayHandle<MPCDReal4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<MPCDReal4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
     unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
     unsigned int N_tot = N_mpcd;
 
@@ -523,82 +690,35 @@ void mpcd::CellList::buildCellList()
         N_tot += m_embed_group->getNumMembers();
         }
 
-    // total effective number of cells in the global box, optionally padded by
-    // extra cells in MPI simulations
-    uint3 n_global_cells = m_global_cell_dim;
-    #ifdef ENABLE_MPI
-    if (isCommunicating(mpcd::detail::face::east)) n_global_cells.x += 2*m_num_extra;
-    if (isCommunicating(mpcd::detail::face::north)) n_global_cells.y += 2*m_num_extra;
-    if (isCommunicating(mpcd::detail::face::up)) n_global_cells.z += 2*m_num_extra;
-    #endif // ENABLE_MPI
-
-    const Scalar3 global_lo = m_pdata->getGlobalBox().getLo();
+    const mpcd::detail::CellBinner binner = getBinner();
 
     for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
         {
-        Scalar4 postype_i;
+        Scalar3 pos_i;
         if (cur_p < N_mpcd)
             {
-            postype_i = h_pos.data[cur_p];
+            const MPCDReal4 postype_i = h_pos.data[cur_p];
+            pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
             }
         else
             {
-            postype_i = h_pos_embed->data[h_embed_member_idx->data[cur_p - N_mpcd]];
+            const Scalar4 postype_i = h_pos_embed->data[h_embed_member_idx->data[cur_p - N_mpcd]];
+            pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
             }
-        Scalar3 pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
 
-        if (std::isnan(pos_i.x) || std::isnan(pos_i.y) || std::isnan(pos_i.z))
+        unsigned int bin_idx;
+        const mpcd::detail::bin_status status = binner.bin(pos_i, bin_idx);
+        if (status == mpcd::detail::bin_status::invalid)
             {
             conditions.y = cur_p + 1;
             continue;
             }
-
-        // bin particle assuming orthorhombic box (already validated)
-        const Scalar3 delta = (pos_i - m_grid_shift) - global_lo;
-        int3 global_bin = make_int3((int)std::floor(delta.x / m_cell_size),
-                                    (int)std::floor(delta.y / m_cell_size),
-                                    (int)std::floor(delta.z / m_cell_size));
-
-        // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
-        // this is done using periodic from the "local" box, since this will be periodic
-        // only when there is one rank along the dimension
-        if (periodic.x)
-            {
-            if (global_bin.x == (int)n_global_cells.x)
-                global_bin.x = 0;
-            else if (global_bin.x == -1)
-                global_bin.x = n_global_cells.x - 1;
-            }
-        if (periodic.y)
-            {
-            if (global_bin.y == (int)n_global_cells.y)
-                global_bin.y = 0;
-            else if (global_bin.y == -1)
-                global_bin.y = n_global_cells.y - 1;
-            }
-        if (periodic.z)
-            {
-            if (global_bin.z == (int)n_global_cells.z)
-                global_bin.z = 0;
-            else if (global_bin.z == -1)
-                global_bin.z = n_global_cells.z - 1;
-            }
-
-        // compute the local cell
-        int3 bin = make_int3(global_bin.x - m_origin_idx.x,
-                             global_bin.y - m_origin_idx.y,
-                             global_bin.z - m_origin_idx.z);
-
-        // validate and make sure no particles blew out of the box
-        if ((bin.x < 0 || bin.x >= (int)m_cell_dim.x) ||
-            (bin.y < 0 || bin.y >= (int)m_cell_dim.y) ||
-            (bin.z < 0 || bin.z >= (int)m_cell_dim.z))
+        else if (status == mpcd::detail::bin_status::outside)
             {
             conditions.z = cur_p + 1;
             continue;
             }
 
-        unsigned int bin_idx = m_cell_indexer(bin.x, bin.y, bin.z);
         unsigned int offset = h_cell_np.data[bin_idx];
         if (offset < m_cell_np_max)
             {
@@ -613,7 +733,7 @@ void mpcd::CellList::buildCellList()
         // stash the current particle bin into the velocity array
         if (cur_p < N_mpcd)
             {
-            h_vel.data[cur_p].w = __int_as_scalar(bin_idx);
+            h_vel.data[cur_p].w = __int_as_mpcdreal(bin_idx);
             }
         else
             {
@@ -742,11 +862,12 @@ bool mpcd::CellList::checkConditions()
     if (conditions.z)
         {
         unsigned int n = conditions.z - 1;
-        Scalar4 pos_empty_i;
+        Scalar3 pos;
         if (n < m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual())
             {
-            ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::read);
-            pos_empty_i = h_pos.data[n];
+            ArrayHandle<MPCDReal4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::read);
+            const MPCDReal4 pos_empty_i = h_pos.data[n];
+            pos = make_scalar3(pos_empty_i.x, pos_empty_i.y, pos_empty_i.z);
             if (n < m_mpcd_pdata->getN())
                 m_exec_conf->msg->errorAllRanks() << "MPCD particle is no longer in the simulation box"<<std::endl;
             else
@@ -756,11 +877,11 @@ bool mpcd::CellList::checkConditions()
             {
             ArrayHandle<Scalar4> h_pos_embed(m_pdata->getPositions(), access_location::host, access_mode::read);
             ArrayHandle<unsigned int> h_embed_member_idx(m_embed_group->getIndexArray(), access_location::host, access_mode::read);
-            pos_empty_i = h_pos_embed.data[h_embed_member_idx.data[n - (m_mpcd_pdata->getN()+m_mpcd_pdata->getNVirtual())]];
+            const Scalar4 pos_empty_i = h_pos_embed.data[h_embed_member_idx.data[n - (m_mpcd_pdata->getN()+m_mpcd_pdata->getNVirtual())]];
+            pos = make_scalar3(pos_empty_i.x, pos_empty_i.y, pos_empty_i.z);
             m_exec_conf->msg->errorAllRanks() << "Embedded particle is no longer in the simulation box"<<std::endl;
             }
 
-        Scalar3 pos = make_scalar3(pos_empty_i.x, pos_empty_i.y, pos_empty_i.z);
         m_exec_conf->msg->errorAllRanks() << "Cartesian coordinates: "<<std::endl
                                           << "x: "<<pos.x<<" y: "<<pos.y<<" z: "<<pos.z<<std::endl
                                           << "Grid shift: " << std::endl
@@ -16,6 +16,7 @@
 #endif
 
 #include "ParticleData.h"
+#include "CellListUtilities.h"
 #include "CommunicatorUtilities.h"
 
 #include "hoomd/Compute.h"
@@ -213,12 +214,16 @@ class PYBIND11_EXPORT CellList : public Compute
         void setEmbeddedGroup(std::shared_ptr<ParticleGroup> embed_group)
             {
             m_embed_group = embed_group;
+            m_force_compute = true;
+            m_embed_order_changed = true;
             }
 
         //! Removes all embedded particles from collision coupling
         void removeEmbeddedGroup()
             {
             m_embed_group = std::shared_ptr<ParticleGroup>();
+            m_force_compute = true;
+            m_embed_order_changed = true;
             }
 
         //! Gets the cell id array for the embedded particles
@@ -227,6 +232,44 @@ class PYBIND11_EXPORT CellList : public Compute
             return m_embed_cell_ids;
             }
 
+        //! Stage the embedded particles in the order of the group members
+        void stageEmbeddedParticles(unsigned int timestep);
+
+        //! Write the staged velocities of the embedded particles back to the particle data
+        void unstageEmbeddedParticles();
+
+        //! Get the staged velocities and masses of the embedded particles
+        /*!
+         * The velocities are in the same order as the embedded particles in the cell list, so they can be read
+         * and written without indexing through the group. They are only valid after stageEmbeddedParticles(), and
+         * changes must be written back with unstageEmbeddedParticles().
+         */
+        GPUVector<Scalar4>& getEmbeddedVelocities()
+            {
+            return m_embed_vel;
+            }
+
+        //! Get the staged tags of the embedded particles
+        const GPUVector<unsigned int>& getEmbeddedTags() const
+            {
+            return m_embed_tag;
+            }
+
+        //! Get the binner for the current dimensions and grid shift
+        mpcd::detail::CellBinner getBinner();
+
+        //! Prepare to fill the cell list with the MPCD particles outside of compute()
+        virtual bool startFusedBuild();
+
+        //! Finish filling the cell list outside of compute()
+        bool finishFusedBuild(unsigned int timestep);
+
+        //! Get the flags for conditions that fail building the cell list
+        GPUFlags<uint3>& getConditionFlags()
+            {
+            return m_conditions;
+            }
+
         //! Get the signal for dimensions changing
         /*!
          * \returns A signal that subscribers can attach to be notified that the
@@ -257,6 +300,8 @@ class PYBIND11_EXPORT CellList : public Compute
         GPUVector<unsigned int> m_cell_np;          //!< Number of particles per cell
         GPUVector<unsigned int> m_cell_list;        //!< Cell list of particles
         GPUVector<unsigned int> m_embed_cell_ids;   //!< Cell ids of the embedded particles
+        GPUVector<Scalar4> m_embed_vel;             //!< Staged velocities of the embedded particles
+        GPUVector<unsigned int> m_embed_tag;        //!< Staged tags of the embedded particles
         GPUFlags<uint3> m_conditions;               //!< Detect conditions that might fail building cell list
 
         int3 m_origin_idx;                  //!< Origin as a global index
@@ -270,6 +315,15 @@ class PYBIND11_EXPORT CellList : public Compute
         virtual bool needsEmbedMigrate(unsigned int timestep);
         #endif // ENABLE_MPI
 
+        //! Check if the cell list can be filled outside of compute()
+        /*!
+         * \returns True if the cell list only holds MPCD particles and its dimensions are up to date
+         */
+        bool canFuseBuild() const
+            {
+            return !(m_first_compute || m_needs_compute_dim || m_embed_group || m_mpcd_pdata->getNVirtual() > 0);
+            }
+
         //! Check the condition flags
         bool checkConditions();
 
@@ -279,6 +333,12 @@ class PYBIND11_EXPORT CellList : public Compute
         //! Builds the cell list and handles cell list memory
         virtual void buildCellList();
 
+        //! Copy the velocities, and optionally the tags, of the embedded particles into the staging buffers
+        virtual void gatherEmbeddedParticles(bool tags);
+
+        //! Copy the staged velocities of the embedded particles back to the particle data
+        virtual void scatterEmbeddedVelocities();
+
         //! Callback to sort cell list when particle data is sorted
         virtual void sort(unsigned int timestep,
                           const GPUArray<unsigned int>& order,
@@ -300,10 +360,14 @@ class PYBIND11_EXPORT CellList : public Compute
             }
 
         bool m_particles_sorted;    //!< True if any embedded particles have been sorted
+        bool m_embed_order_changed; //!< True if the embedded particles were reordered since they were staged
+        bool m_embed_staged;        //!< True if the embedded particles have been staged
+        unsigned int m_embed_stage_timestep;    //!< Timestep the embedded particles were last staged
         //! Slot for particle sorting
         void slotSorted()
             {
             m_particles_sorted = true;
+            m_embed_order_changed = true;
             }
 
         bool m_virtual_change;  //!< True if the number of virtual particles has changed
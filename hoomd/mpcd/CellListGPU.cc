@@ -15,11 +15,15 @@ mpcd::CellListGPU::CellListGPU(std::shared_ptr<SystemDefinition> sysdef,
                                std::shared_ptr<mpcd::ParticleData> mpcd_pdata)
         : mpcd::CellList(sysdef, mpcd_pdata)
     {
-    m_tuner_cell.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_cell", m_exec_conf));
-    m_tuner_sort.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_cell_sort", m_exec_conf));
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_tuner_cell.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_cell", m_exec_conf));
+    m_tuner_sort.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_cell_sort", m_exec_conf));
+    m_tuner_gather.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_cell_embed_gather", m_exec_conf));
+    m_tuner_scatter.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_cell_embed_scatter", m_exec_conf));
 
     #ifdef ENABLE_MPI
-    m_tuner_embed_migrate.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_cell_embed_migrate", m_exec_conf));
+    m_tuner_embed_migrate.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000,
+        "mpcd_cell_embed_migrate", m_exec_conf));
 
     GPUFlags<unsigned int> migrate_flag(m_exec_conf);
     m_migrate_flag.swap(migrate_flag);
@@ -34,20 +38,13 @@ void mpcd::CellListGPU::buildCellList()
     {
     ArrayHandle<unsigned int> d_cell_list(m_cell_list, access_location::device, access_mode::overwrite);
     ArrayHandle<unsigned int> d_cell_np(m_cell_np, access_location::device, access_mode::overwrite);
-    ArrayHandle<Scalar4> d_pos(m_mpcd_pdata->getPositions(), access_location::device, access_mode::read);
-    ArrayHandle<Scalar4> d_vel(m_mpcd_pdata->getVelocities(), access_location::device, access_mode::readwrite);
+    ArrayHandle<MPCDReal4> d_pos(m_mpcd_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<MPCDReal4> d_vel(m_mpcd_pdata->getVelocities(), access_location::device, access_mode::readwrite);
 
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
     unsigned int N_tot = N_mpcd;
 
-    // total effective number of cells in the global box, optionally padded by
-    // extra cells in MPI simulations
-    uint3 n_global_cells = m_global_cell_dim;
-    #ifdef ENABLE_MPI
-    if (isCommunicating(mpcd::detail::face::east)) n_global_cells.x += 2*m_num_extra;
-    if (isCommunicating(mpcd::detail::face::north)) n_global_cells.y += 2*m_num_extra;
-    if (isCommunicating(mpcd::detail::face::up)) n_global_cells.z += 2*m_num_extra;
-    #endif // ENABLE_MPI
+    const mpcd::detail::CellBinner binner = getBinner();
 
     if (m_embed_group)
         {
@@ -65,12 +62,7 @@ void mpcd::CellListGPU::buildCellList()
                                      d_pos.data,
                                      d_pos_embed.data,
                                      d_embed_member_idx.data,
-                                     m_pdata->getBox().getPeriodic(),
-                                     m_origin_idx,
-                                     m_grid_shift,
-                                     m_pdata->getGlobalBox().getLo(),
-                                     n_global_cells,
-                                     m_cell_size,
+                                     binner,
                                      m_cell_np_max,
                                      m_cell_indexer,
                                      m_cell_list_indexer,
@@ -91,12 +83,7 @@ void mpcd::CellListGPU::buildCellList()
                                      d_pos.data,
                                      NULL,
                                      NULL,
-                                     m_pdata->getBox().getPeriodic(),
-                                     m_origin_idx,
-                                     m_grid_shift,
-                                     m_pdata->getGlobalBox().getLo(),
-                                     n_global_cells,
-                                     m_cell_size,
+                                     binner,
                                      m_cell_np_max,
                                      m_cell_indexer,
                                      m_cell_list_indexer,
@@ -108,6 +95,24 @@ void mpcd::CellListGPU::buildCellList()
         }
     }
 
+/*!
+ * \returns True if the caller should fill the cell list
+ *
+ * The cell counters are zeroed on the GPU so that the caller can fill the cell list from a kernel.
+ */
+bool mpcd::CellListGPU::startFusedBuild()
+    {
+    if (!canFuseBuild())
+        return false;
+
+    ArrayHandle<unsigned int> d_cell_np(m_cell_np, access_location::device, access_mode::overwrite);
+    cudaMemset(d_cell_np.data, 0, sizeof(unsigned int) * m_cell_indexer.getNumElements());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+    resetConditions();
+
+    return true;
+    }
+
 /*!
  * \param timestep Timestep that the sorting occurred
  * \param order Mapping of sorted particle indexes onto old particle indexes
@@ -143,6 +148,51 @@ void mpcd::CellListGPU::sort(unsigned int timestep,
     m_tuner_sort->end();
     }
 
+/*!
+ * \param tags If true, the tags are also gathered
+ */
+void mpcd::CellListGPU::gatherEmbeddedParticles(bool tags)
+    {
+    ArrayHandle<Scalar4> d_embed_vel(m_embed_vel, access_location::device, access_mode::overwrite);
+    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_embed_member_idx(m_embed_group->getIndexArray(), access_location::device, access_mode::read);
+
+    std::unique_ptr< ArrayHandle<unsigned int> > d_embed_tag;
+    std::unique_ptr< ArrayHandle<unsigned int> > d_tag;
+    if (tags)
+        {
+        d_embed_tag.reset(new ArrayHandle<unsigned int>(m_embed_tag, access_location::device, access_mode::overwrite));
+        d_tag.reset(new ArrayHandle<unsigned int>(m_pdata->getTags(), access_location::device, access_mode::read));
+        }
+
+    m_tuner_gather->begin();
+    mpcd::gpu::cell_gather_embed(d_embed_vel.data,
+                                 (tags) ? d_embed_tag->data : NULL,
+                                 d_vel.data,
+                                 (tags) ? d_tag->data : NULL,
+                                 d_embed_member_idx.data,
+                                 m_embed_group->getNumMembers(),
+                                 m_tuner_gather->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+    m_tuner_gather->end();
+    }
+
+void mpcd::CellListGPU::scatterEmbeddedVelocities()
+    {
+    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(), access_location::device, access_mode::readwrite);
+    ArrayHandle<Scalar4> d_embed_vel(m_embed_vel, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_embed_member_idx(m_embed_group->getIndexArray(), access_location::device, access_mode::read);
+
+    m_tuner_scatter->begin();
+    mpcd::gpu::cell_scatter_embed(d_vel.data,
+                                  d_embed_vel.data,
+                                  d_embed_member_idx.data,
+                                  m_embed_group->getNumMembers(),
+                                  m_tuner_scatter->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+    m_tuner_scatter->end();
+    }
+
 #ifdef ENABLE_MPI
 bool mpcd::CellListGPU::needsEmbedMigrate(unsigned int timestep)
     {
@@ -26,20 +26,14 @@ namespace kernel
  * \param d_pos MPCD particle positions
  * \param d_pos_embed Particle positions
  * \param d_embed_member_idx Indexes of embedded particles in \a d_pos_embed
- * \param periodic Flags if local simulation is periodic
- * \param origin_idx Global origin index for the local box
- * \param grid_shift Random grid shift vector
- * \param global_lo Lower bound of global orthorhombic simulation box
- * \param n_global_cell Global dimensions of the cell list, including padding
- * \param cell_size Cell width
+ * \param binner Binner for the local cells
  * \param cell_np_max Maximum number of particles per cell
- * \param cell_indexer 3D indexer for cell id
  * \param cell_list_indexer 2D indexer for particle position in cell
  * \param N_mpcd Number of MPCD particles
  * \param N_tot Total number of particle (MPCD + embedded)
  *
  * \b Implementation
- * One thread is launched per particle. The particle is floored into a bin subject to a random grid shift.
+ * One thread is launched per particle. The particle is binned by \a binner subject to a random grid shift.
  * The number of particles in that bin is atomically incremented. If the addition of the particle will not overflow
  * the allocated memory, the particle is written into that bin. Otherwise, a flag is set to resize the cell list
  * and recompute. The MPCD particle's cell id is stashed into the velocity array.
@@ -47,19 +41,13 @@ namespace kernel
 __global__ void compute_cell_list(unsigned int *d_cell_np,
                                   unsigned int *d_cell_list,
                                   uint3 *d_conditions,
-                                  Scalar4 *d_vel,
+                                  MPCDReal4 *d_vel,
                                   unsigned int *d_embed_cell_ids,
-                                  const Scalar4 *d_pos,
+                                  const MPCDReal4 *d_pos,
                                   const Scalar4 *d_pos_embed,
                                   const unsigned int *d_embed_member_idx,
-                                  const uchar3 periodic,
-                                  const int3 origin_idx,
-                                  const Scalar3 grid_shift,
-                                  const Scalar3 global_lo,
-                                  const uint3 n_global_cell,
-                                  const Scalar cell_size,
+                                  const mpcd::detail::CellBinner binner,
                                   const unsigned int cell_np_max,
-                                  const Index3D cell_indexer,
                                   const Index2D cell_list_indexer,
                                   const unsigned int N_mpcd,
                                   const unsigned int N_tot)
@@ -69,69 +57,31 @@ __global__ void compute_cell_list(unsigned int *d_cell_np,
     if (idx >= N_tot)
         return;
 
-    Scalar4 postype_i;
+    Scalar3 pos_i;
     if (idx < N_mpcd)
         {
-        postype_i = d_pos[idx];
+        const MPCDReal4 postype_i = d_pos[idx];
+        pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
         }
     else
         {
-        postype_i = d_pos_embed[d_embed_member_idx[idx - N_mpcd]];
+        const Scalar4 postype_i = d_pos_embed[d_embed_member_idx[idx - N_mpcd]];
+        pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
         }
-    const Scalar3 pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
 
-    if (isnan(pos_i.x) || isnan(pos_i.y) || isnan(pos_i.z))
+    unsigned int bin_idx;
+    const mpcd::detail::bin_status status = binner.bin(pos_i, bin_idx);
+    if (status == mpcd::detail::bin_status::invalid)
         {
         (*d_conditions).y = idx + 1;
         return;
         }
-
-    // bin particle with grid shift assuming orthorhombic box (already validated)
-    const Scalar3 delta = (pos_i - grid_shift) - global_lo;
-    int3 global_bin = make_int3(std::floor(delta.x / cell_size),
-                                std::floor(delta.y / cell_size),
-                                std::floor(delta.z / cell_size));
-
-    // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
-    // this is done using periodic from the "local" box, since this will be periodic
-    // only when there is one rank along the dimension
-    if (periodic.x)
-        {
-        if (global_bin.x == (int)n_global_cell.x)
-            global_bin.x = 0;
-        else if (global_bin.x == -1)
-            global_bin.x = n_global_cell.x - 1;
-        }
-    if (periodic.y)
-        {
-        if (global_bin.y == (int)n_global_cell.y)
-            global_bin.y = 0;
-        else if (global_bin.y == -1)
-            global_bin.y = n_global_cell.y - 1;
-        }
-    if (periodic.z)
-        {
-        if (global_bin.z == (int)n_global_cell.z)
-            global_bin.z = 0;
-        else if (global_bin.z == -1)
-            global_bin.z = n_global_cell.z - 1;
-        }
-
-    // compute the local cell
-    int3 bin = make_int3(global_bin.x - origin_idx.x,
-                         global_bin.y - origin_idx.y,
-                         global_bin.z - origin_idx.z);
-
-    // validate and make sure no particles blew out of the box
-    if ((bin.x < 0 || bin.x >= (int)cell_indexer.getW()) ||
-        (bin.y < 0 || bin.y >= (int)cell_indexer.getH()) ||
-        (bin.z < 0 || bin.z >= (int)cell_indexer.getD()))
+    else if (status == mpcd::detail::bin_status::outside)
         {
         (*d_conditions).z = idx + 1;
         return;
         }
 
-    const unsigned int bin_idx = cell_indexer(bin.x, bin.y, bin.z);
     const unsigned int offset = atomicInc(&d_cell_np[bin_idx], 0xffffffff);
     if (offset < cell_np_max)
         {
@@ -146,7 +96,7 @@ __global__ void compute_cell_list(unsigned int *d_cell_np,
     // stash the current particle bin into the velocity array
     if (idx < N_mpcd)
         {
-        d_vel[idx].w = __int_as_scalar(bin_idx);
+        d_vel[idx].w = __int_as_mpcdreal(bin_idx);
         }
     else
         {
@@ -225,6 +175,58 @@ __global__ void cell_apply_sort(unsigned int *d_cell_list,
             }
         }
     }
+
+/*!
+ * \param d_embed_vel Staged velocities of the embedded particles (output)
+ * \param d_embed_tag Staged tags of the embedded particles (output), or NULL to skip the tags
+ * \param d_vel Particle velocities
+ * \param d_tag Particle tags
+ * \param d_embed_member_idx Indexes of the embedded particles in the particle data
+ * \param N Number of embedded particles
+ *
+ * \b Implementation
+ * Using one thread per embedded particle, the velocity (and tag) is copied into the staging buffer in the order of
+ * the group members.
+ */
+__global__ void cell_gather_embed(Scalar4 *d_embed_vel,
+                                  unsigned int *d_embed_tag,
+                                  const Scalar4 *d_vel,
+                                  const unsigned int *d_tag,
+                                  const unsigned int *d_embed_member_idx,
+                                  const unsigned int N)
+    {
+    // one thread per embedded particle
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    const unsigned int pidx = d_embed_member_idx[idx];
+    d_embed_vel[idx] = d_vel[pidx];
+    if (d_embed_tag)
+        d_embed_tag[idx] = d_tag[pidx];
+    }
+
+/*!
+ * \param d_vel Particle velocities (output)
+ * \param d_embed_vel Staged velocities of the embedded particles
+ * \param d_embed_member_idx Indexes of the embedded particles in the particle data
+ * \param N Number of embedded particles
+ *
+ * \b Implementation
+ * Using one thread per embedded particle, the staged velocity is copied back to the particle data.
+ */
+__global__ void cell_scatter_embed(Scalar4 *d_vel,
+                                   const Scalar4 *d_embed_vel,
+                                   const unsigned int *d_embed_member_idx,
+                                   const unsigned int N)
+    {
+    // one thread per embedded particle
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    d_vel[d_embed_member_idx[idx]] = d_embed_vel[idx];
+    }
 } // end namespace kernel
 } // end namespace gpu
 } // end namespace mpcd
@@ -238,12 +240,7 @@ __global__ void cell_apply_sort(unsigned int *d_cell_list,
  * \param d_pos MPCD particle positions
  * \param d_pos_embed Particle positions
  * \param d_embed_member_idx Indexes of embedded particles in \a d_pos_embed
- * \param periodic Flags if local simulation is periodic
- * \param origin_idx Global origin index for the local box
- * \param grid_shift Random grid shift vector
- * \param global_lo Lower bound of global orthorhombic simulation box
- * \param n_global_cell Global dimensions of the cell list, including padding
- * \param cell_size Cell width
+ * \param binner Binner for the local cells
  * \param cell_np_max Maximum number of particles per cell
  * \param cell_indexer 3D indexer for cell id
  * \param cell_list_indexer 2D indexer for particle position in cell
@@ -256,17 +253,12 @@ __global__ void cell_apply_sort(unsigned int *d_cell_list,
 cudaError_t mpcd::gpu::compute_cell_list(unsigned int *d_cell_np,
                                          unsigned int *d_cell_list,
                                          uint3 *d_conditions,
-                                         Scalar4 *d_vel,
+                                         MPCDReal4 *d_vel,
                                          unsigned int *d_embed_cell_ids,
-                                         const Scalar4 *d_pos,
+                                         const MPCDReal4 *d_pos,
                                          const Scalar4 *d_pos_embed,
                                          const unsigned int *d_embed_member_idx,
-                                         const uchar3& periodic,
-                                         const int3& origin_idx,
-                                         const Scalar3& grid_shift,
-                                         const Scalar3& global_lo,
-                                         const uint3& n_global_cell,
-                                         const Scalar cell_size,
+                                         const mpcd::detail::CellBinner& binner,
                                          const unsigned int cell_np_max,
                                          const Index3D& cell_indexer,
                                          const Index2D& cell_list_indexer,
@@ -297,14 +289,8 @@ cudaError_t mpcd::gpu::compute_cell_list(unsigned int *d_cell_np,
                                                                    d_pos,
                                                                    d_pos_embed,
                                                                    d_embed_member_idx,
-                                                                   periodic,
-                                                                   origin_idx,
-                                                                   grid_shift,
-                                                                   global_lo,
-                                                                   n_global_cell,
-                                                                   cell_size,
+                                                                   binner,
                                                                    cell_np_max,
-                                                                   cell_indexer,
                                                                    cell_list_indexer,
                                                                    N_mpcd,
                                                                    N_tot);
@@ -381,3 +367,83 @@ cudaError_t mpcd::gpu::cell_apply_sort(unsigned int *d_cell_list,
 
     return cudaSuccess;
     }
+
+/*!
+ * \param d_embed_vel Staged velocities of the embedded particles (output)
+ * \param d_embed_tag Staged tags of the embedded particles (output), or NULL to skip the tags
+ * \param d_vel Particle velocities
+ * \param d_tag Particle tags
+ * \param d_embed_member_idx Indexes of the embedded particles in the particle data
+ * \param N Number of embedded particles
+ * \param block_size Number of threads per block
+ *
+ * \returns cudaSuccess on completion
+ *
+ * \sa mpcd::gpu::kernel::cell_gather_embed
+ */
+cudaError_t mpcd::gpu::cell_gather_embed(Scalar4 *d_embed_vel,
+                                         unsigned int *d_embed_tag,
+                                         const Scalar4 *d_vel,
+                                         const unsigned int *d_tag,
+                                         const unsigned int *d_embed_member_idx,
+                                         const unsigned int N,
+                                         const unsigned int block_size)
+    {
+    if (N == 0) return cudaSuccess;
+
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        cudaFuncAttributes attr;
+        cudaFuncGetAttributes(&attr, (const void*)mpcd::gpu::kernel::cell_gather_embed);
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    dim3 grid(N / run_block_size + 1);
+    mpcd::gpu::kernel::cell_gather_embed<<<grid, run_block_size>>>(d_embed_vel,
+                                                                   d_embed_tag,
+                                                                   d_vel,
+                                                                   d_tag,
+                                                                   d_embed_member_idx,
+                                                                   N);
+
+    return cudaSuccess;
+    }
+
+/*!
+ * \param d_vel Particle velocities (output)
+ * \param d_embed_vel Staged velocities of the embedded particles
+ * \param d_embed_member_idx Indexes of the embedded particles in the particle data
+ * \param N Number of embedded particles
+ * \param block_size Number of threads per block
+ *
+ * \returns cudaSuccess on completion
+ *
+ * \sa mpcd::gpu::kernel::cell_scatter_embed
+ */
+cudaError_t mpcd::gpu::cell_scatter_embed(Scalar4 *d_vel,
+                                          const Scalar4 *d_embed_vel,
+                                          const unsigned int *d_embed_member_idx,
+                                          const unsigned int N,
+                                          const unsigned int block_size)
+    {
+    if (N == 0) return cudaSuccess;
+
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        cudaFuncAttributes attr;
+        cudaFuncGetAttributes(&attr, (const void*)mpcd::gpu::kernel::cell_scatter_embed);
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    dim3 grid(N / run_block_size + 1);
+    mpcd::gpu::kernel::cell_scatter_embed<<<grid, run_block_size>>>(d_vel,
+                                                                    d_embed_vel,
+                                                                    d_embed_member_idx,
+                                                                    N);
+
+    return cudaSuccess;
+    }
@@ -13,6 +13,8 @@
 
 #include <cuda_runtime.h>
 
+#include "CellListUtilities.h"
+#include "ParticleDataUtilities.h"
 #include "hoomd/BoxDim.h"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
@@ -26,17 +28,12 @@ namespace gpu
 cudaError_t compute_cell_list(unsigned int *d_cell_np,
                               unsigned int *d_cell_list,
                               uint3 *d_conditions,
-                              Scalar4 *d_vel,
+                              MPCDReal4 *d_vel,
                               unsigned int *d_embed_cell_ids,
-                              const Scalar4 *d_pos,
+                              const MPCDReal4 *d_pos,
                               const Scalar4 *d_pos_embed,
                               const unsigned int *d_embed_member_idx,
-                              const uchar3& periodic,
-                              const int3& origin_idx,
-                              const Scalar3& grid_shift,
-                              const Scalar3& global_lo,
-                              const uint3& n_global_cell,
-                              const Scalar cell_size,
+                              const mpcd::detail::CellBinner& binner,
                               const unsigned int cell_np_max,
                               const Index3D& cell_indexer,
                               const Index2D& cell_list_indexer,
@@ -61,6 +58,22 @@ cudaError_t cell_apply_sort(unsigned int *d_cell_list,
                             const unsigned int N_mpcd,
                             const unsigned int block_size);
 
+//! Kernel driver to stage the embedded particles in the order of the group members
+cudaError_t cell_gather_embed(Scalar4 *d_embed_vel,
+                              unsigned int *d_embed_tag,
+                              const Scalar4 *d_vel,
+                              const unsigned int *d_tag,
+                              const unsigned int *d_embed_member_idx,
+                              const unsigned int N,
+                              const unsigned int block_size);
+
+//! Kernel driver to write the staged velocities back to the embedded particles
+cudaError_t cell_scatter_embed(Scalar4 *d_vel,
+                               const Scalar4 *d_embed_vel,
+                               const unsigned int *d_embed_member_idx,
+                               const unsigned int N,
+                               const unsigned int block_size);
+
 } // end namespace gpu
 } // end namespace mpcd
 
@@ -42,11 +42,16 @@ class PYBIND11_EXPORT CellListGPU : public mpcd::CellList
 
             m_tuner_cell->setPeriod(period); m_tuner_cell->setEnabled(enable);
             m_tuner_sort->setPeriod(period); m_tuner_sort->setEnabled(enable);
+            m_tuner_gather->setPeriod(period); m_tuner_gather->setEnabled(enable);
+            m_tuner_scatter->setPeriod(period); m_tuner_scatter->setEnabled(enable);
             #ifdef ENABLE_MPI
             m_tuner_embed_migrate->setPeriod(period); m_tuner_embed_migrate->setEnabled(enable);
             #endif // ENABLE_MPI
             }
 
+        //! Prepare to fill the cell list with the MPCD particles outside of compute() on the GPU
+        virtual bool startFusedBuild();
+
     protected:
         //! Compute the cell list of particles on the GPU
         virtual void buildCellList();
@@ -56,6 +61,12 @@ class PYBIND11_EXPORT CellListGPU : public mpcd::CellList
                           const GPUArray<unsigned int>& order,
                           const GPUArray<unsigned int>& rorder);
 
+        //! Copy the embedded particles into the staging buffers on the GPU
+        virtual void gatherEmbeddedParticles(bool tags);
+
+        //! Copy the staged velocities of the embedded particles back to the particle data on the GPU
+        virtual void scatterEmbeddedVelocities();
+
         #ifdef ENABLE_MPI
         //! Determine if embedded particles require migration on the gpu
         virtual bool needsEmbedMigrate(unsigned int timestep);
@@ -65,6 +76,8 @@ class PYBIND11_EXPORT CellListGPU : public mpcd::CellList
     private:
         std::unique_ptr<Autotuner> m_tuner_cell;    //!< Autotuner for the cell list calculation
         std::unique_ptr<Autotuner> m_tuner_sort;    //!< Autotuner for sorting the cell list
+        std::unique_ptr<Autotuner> m_tuner_gather;  //!< Autotuner for staging the embedded particles
+        std::unique_ptr<Autotuner> m_tuner_scatter; //!< Autotuner for unstaging the embedded particles
         #ifdef ENABLE_MPI
         std::unique_ptr<Autotuner> m_tuner_embed_migrate;   //!< Autotuner for checking embedded migration
         #endif // ENABLE_MPI
@@ -0,0 +1,163 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: mphoward
+
+#ifndef MPCD_CELL_LIST_UTILITIES_H_
+#define MPCD_CELL_LIST_UTILITIES_H_
+
+/*!
+ * \file mpcd/CellListUtilities.h
+ * \brief Utilities for binning particles into the MPCD cell list on the CPU and GPU
+ */
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/Index1D.h"
+
+#ifndef __HIPCC__
+#include <cmath>
+#endif
+
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+namespace mpcd
+{
+namespace detail
+{
+
+//! Result of binning a particle
+enum struct bin_status : unsigned char
+    {
+    ok=0,       //!< Particle was binned
+    invalid,    //!< Particle position is NaN
+    outside     //!< Particle lies outside the cells of this rank
+    };
+
+//! Bins particles into the local cells of the MPCD cell list
+/*!
+ * The binner holds the geometry of the cell list, so that the particles can be binned outside of
+ * mpcd::CellList (e.g., while they are streamed) exactly as the cell list would bin them.
+ */
+class CellBinner
+    {
+    public:
+        //! Default constructor
+        HOSTDEVICE CellBinner()
+            : m_periodic(make_uchar3(0,0,0)), m_origin_idx(make_int3(0,0,0)), m_grid_shift(make_scalar3(0,0,0)),
+              m_global_lo(make_scalar3(0,0,0)), m_n_global_cell(make_uint3(0,0,0)), m_cell_size(0)
+            { }
+
+        //! Constructor
+        /*!
+         * \param periodic Flags if local simulation is periodic
+         * \param origin_idx Global origin index for the local box
+         * \param grid_shift Random grid shift vector
+         * \param global_lo Lower bound of global orthorhombic simulation box
+         * \param n_global_cell Global dimensions of the cell list, including padding
+         * \param cell_size Cell width
+         * \param cell_indexer 3D indexer for cell id
+         */
+        HOSTDEVICE CellBinner(const uchar3& periodic,
+                              const int3& origin_idx,
+                              const Scalar3& grid_shift,
+                              const Scalar3& global_lo,
+                              const uint3& n_global_cell,
+                              const Scalar cell_size,
+                              const Index3D& cell_indexer)
+            : m_periodic(periodic), m_origin_idx(origin_idx), m_grid_shift(grid_shift), m_global_lo(global_lo),
+              m_n_global_cell(n_global_cell), m_cell_size(cell_size), m_cell_indexer(cell_indexer)
+            { }
+
+        //! Bin a particle
+        /*!
+         * \param pos Particle position
+         * \param bin_idx Local cell index of the particle (output)
+         * \returns bin_status::ok if \a bin_idx was set
+         *
+         * The particle is floored into a bin subject to the grid shift, assuming an orthorhombic box.
+         */
+        HOSTDEVICE bin_status bin(const Scalar3& pos, unsigned int& bin_idx) const
+            {
+            if (is_nan(pos.x) || is_nan(pos.y) || is_nan(pos.z))
+                {
+                return bin_status::invalid;
+                }
+
+            const Scalar3 delta = (pos - m_grid_shift) - m_global_lo;
+            int3 global_bin = make_int3((int)floor(delta.x / m_cell_size),
+                                        (int)floor(delta.y / m_cell_size),
+                                        (int)floor(delta.z / m_cell_size));
+
+            // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
+            // this is done using periodic from the "local" box, since this will be periodic
+            // only when there is one rank along the dimension
+            if (m_periodic.x)
+                {
+                if (global_bin.x == (int)m_n_global_cell.x)
+                    global_bin.x = 0;
+                else if (global_bin.x == -1)
+                    global_bin.x = m_n_global_cell.x - 1;
+                }
+            if (m_periodic.y)
+                {
+                if (global_bin.y == (int)m_n_global_cell.y)
+                    global_bin.y = 0;
+                else if (global_bin.y == -1)
+                    global_bin.y = m_n_global_cell.y - 1;
+                }
+            if (m_periodic.z)
+                {
+                if (global_bin.z == (int)m_n_global_cell.z)
+                    global_bin.z = 0;
+                else if (global_bin.z == -1)
+                    global_bin.z = m_n_global_cell.z - 1;
+                }
+
+            // compute the local cell
+            const int3 local_bin = make_int3(global_bin.x - m_origin_idx.x,
+                                             global_bin.y - m_origin_idx.y,
+                                             global_bin.z - m_origin_idx.z);
+
+            // validate and make sure no particles blew out of the box
+            if ((local_bin.x < 0 || local_bin.x >= (int)m_cell_indexer.getW()) ||
+                (local_bin.y < 0 || local_bin.y >= (int)m_cell_indexer.getH()) ||
+                (local_bin.z < 0 || local_bin.z >= (int)m_cell_indexer.getD()))
+                {
+                return bin_status::outside;
+                }
+
+            bin_idx = m_cell_indexer(local_bin.x, local_bin.y, local_bin.z);
+            return bin_status::ok;
+            }
+
+    private:
+        //! Check if a coordinate is NaN
+        HOSTDEVICE static bool is_nan(const Scalar x)
+            {
+            #ifdef __HIP_DEVICE_COMPILE__
+            return isnan(x);
+            #else
+            return std::isnan(x);
+            #endif
+            }
+
+        uchar3 m_periodic;          //!< Flags if local simulation is periodic
+        int3 m_origin_idx;          //!< Global origin index for the local box
+        Scalar3 m_grid_shift;       //!< Random grid shift vector
+        Scalar3 m_global_lo;        //!< Lower bound of global orthorhombic simulation box
+        uint3 m_n_global_cell;      //!< Global dimensions of the cell list, including padding
+        Scalar m_cell_size;         //!< Cell width
+        Index3D m_cell_indexer;     //!< 3D indexer for cell id
+    };
+
+} // end namespace detail
+} // end namespace mpcd
+
+#undef HOSTDEVICE
+
+#endif // MPCD_CELL_LIST_UTILITIES_H_
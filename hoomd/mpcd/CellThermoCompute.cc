@@ -21,7 +21,8 @@ mpcd::CellThermoCompute::CellThermoCompute(std::shared_ptr<mpcd::SystemData> sys
           m_mpcd_pdata(sysdata->getParticleData()),
           m_cl(sysdata->getCellList()),
           m_needs_net_reduce(true), m_cell_vel(m_exec_conf), m_cell_energy(m_exec_conf),
-          m_ncells_alloc(0)
+          m_ncells_alloc(0), m_fill_thermal_only(false), m_fill_vel(m_exec_conf), m_fill_energy(m_exec_conf),
+          m_use_rand_vel(false)
     {
     assert(m_mpcd_pdata);
     assert(m_cl);
@@ -77,8 +78,46 @@ void mpcd::CellThermoCompute::compute(unsigned int timestep)
     if (m_prof) m_prof->pop(m_exec_conf);
     }
 
+/*!
+ * \param timestep Current timestep
+ *
+ * The cell list and thermo flags are updated and the cell properties are sized for the current cells, but nothing
+ * is computed. The caller must fill getCellVelocities() (and getCellEnergies() if the energy flag is set) for every
+ * cell, then call finishFusedCompute(). This should only be called when canFuseCompute() is true.
+ */
+void mpcd::CellThermoCompute::beginFusedCompute(unsigned int timestep)
+    {
+    shouldCompute(timestep);
+    m_last_computed = timestep;
+
+    m_cl->compute(timestep);
+    updateFlags();
+
+    const unsigned int ncells = m_cl->getNCells();
+    if (ncells != m_ncells_alloc)
+        {
+        reallocate(ncells);
+        }
+    }
+
+/*!
+ * \param timestep Current timestep
+ *
+ * Callbacks are emitted once the cell properties are filled, as they are in compute().
+ */
+void mpcd::CellThermoCompute::finishFusedCompute(unsigned int timestep)
+    {
+    if (!m_callbacks.empty())
+        m_callbacks.emit(timestep);
+    m_needs_net_reduce = true;
+    }
+
 void mpcd::CellThermoCompute::computeCellProperties(unsigned int timestep)
     {
+    // the virtual particles are needed by both the outer and inner cells
+    if (!m_fillers.empty())
+        computeFillProperties(timestep);
+
     /*
      * In MPI simulations, begin by calculating the velocities and energies of
      * cells that lie along the boundaries. These values will then be communicated
@@ -100,6 +139,9 @@ void mpcd::CellThermoCompute::computeCellProperties(unsigned int timestep)
      * on the inner cells. In non-MPI simulations, only this part happens.
      */
     calcInnerCellProperties();
+    #ifdef ENABLE_MPI
+    progressOuterCellProperties();
+    #endif // ENABLE_MPI
 
     /*
      * Execute any additional callbacks that can be overlapped with outer communication.
@@ -145,17 +187,28 @@ struct CellPropertySum
      * \param embed_vel_ Embedded particle velocities
      * \param embed_idx_ Embedded particle indexes
      * \param N_mpcd_ Number of MPCD particles
+     * \param fill_vel_ Momentum and mass of virtual particles per cell (NULL if not filling)
+     * \param fill_energy_ Kinetic energy and number of virtual particles per cell
+     * \param tag_ MPCD particle tags
+     * \param embed_tag_ Embedded particle tags
+     * \param rand_vel_ Random velocities summed instead of the particle velocities (NULL to use \a vel_)
      */
     CellPropertySum(const unsigned int *cell_list_,
                     const unsigned int *cell_np_,
                     const Index2D& cli_,
-                    const Scalar4 *vel_,
+                    const MPCDReal4 *vel_,
                     const Scalar mass_,
                     const Scalar4 *embed_vel_,
                     const unsigned int *embed_idx_,
-                    const unsigned int N_mpcd_)
+                    const unsigned int N_mpcd_,
+                    const double4 *fill_vel_,
+                    const double2 *fill_energy_,
+                    const unsigned int *tag_,
+                    const unsigned int *embed_tag_,
+                    const mpcd::detail::ATRandomVelocity *rand_vel_)
         : cell_list(cell_list_), cell_np(cell_np_), cli(cli_), vel(vel_), mass(mass_),
-          embed_vel(embed_vel_), embed_idx(embed_idx_), N_mpcd(N_mpcd_)
+          embed_vel(embed_vel_), embed_idx(embed_idx_), N_mpcd(N_mpcd_),
+          fill_vel(fill_vel_), fill_energy(fill_energy_), tag(tag_), embed_tag(embed_tag_), rand_vel(rand_vel_)
         {}
 
     //! Computes the total momentum, kinetic energy, and number of particles in a cell
@@ -180,15 +233,32 @@ struct CellPropertySum
             double mass_i;
             if (cur_p < N_mpcd)
                 {
-                Scalar4 vel_cell = vel[cur_p];
-                vel_i = make_double3(vel_cell.x, vel_cell.y, vel_cell.z);
                 mass_i = mass;
+                if (rand_vel)
+                    {
+                    const Scalar3 vel_rand = (*rand_vel)(tag[cur_p], mass_i);
+                    vel_i = make_double3(vel_rand.x, vel_rand.y, vel_rand.z);
+                    }
+                else
+                    {
+                    MPCDReal4 vel_cell = vel[cur_p];
+                    vel_i = make_double3(vel_cell.x, vel_cell.y, vel_cell.z);
+                    }
                 }
             else
                 {
-                Scalar4 vel_m = embed_vel[embed_idx[cur_p - N_mpcd]];
-                vel_i = make_double3(vel_m.x, vel_m.y, vel_m.z);
+                const unsigned int pidx = embed_idx[cur_p - N_mpcd];
+                Scalar4 vel_m = embed_vel[pidx];
                 mass_i = vel_m.w;
+                if (rand_vel)
+                    {
+                    const Scalar3 vel_rand = (*rand_vel)(embed_tag[pidx], mass_i);
+                    vel_i = make_double3(vel_rand.x, vel_rand.y, vel_rand.z);
+                    }
+                else
+                    {
+                    vel_i = make_double3(vel_m.x, vel_m.y, vel_m.z);
+                    }
                 }
 
             // add momentum
@@ -201,17 +271,38 @@ struct CellPropertySum
             if (energy)
                 ke += 0.5 * mass_i * (vel_i.x * vel_i.x + vel_i.y * vel_i.y + vel_i.z * vel_i.z);
             }
+
+        // add the virtual particles filled into the cell
+        if (fill_vel)
+            {
+            const double4 fill_vel_cell = fill_vel[cell];
+            momentum.x += fill_vel_cell.x;
+            momentum.y += fill_vel_cell.y;
+            momentum.z += fill_vel_cell.z;
+            momentum.w += fill_vel_cell.w;
+            if (energy)
+                {
+                const double2 fill_energy_cell = fill_energy[cell];
+                ke += fill_energy_cell.x;
+                np += (unsigned int)fill_energy_cell.y;
+                }
+            }
     }
 
     const unsigned int *cell_list;  //!< Cell list
     const unsigned int *cell_np;    //!< Number of particles per cell
     const Index2D cli;              //!< Cell list indexer
 
-    const Scalar4 *vel;             //!< MPCD particle velocities
+    const MPCDReal4 *vel;           //!< MPCD particle velocities
     const Scalar mass;              //!< MPCD particle mass
     const Scalar4 *embed_vel;       //!< Embedded particle velocities
     const unsigned int *embed_idx;  //!< Embedded particle indexes
     const unsigned int N_mpcd;      //!< Number of MPCD particles
+    const double4 *fill_vel;        //!< Momentum and mass of virtual particles per cell
+    const double2 *fill_energy;     //!< Kinetic energy and number of virtual particles per cell
+    const unsigned int *tag;        //!< MPCD particle tags
+    const unsigned int *embed_tag;  //!< Embedded particle tags
+    const mpcd::detail::ATRandomVelocity *rand_vel; //!< Random velocities summed instead of the velocities
     };
 } // end namespace detail
 } // end namespace mpcd
@@ -225,7 +316,7 @@ void mpcd::CellThermoCompute::beginOuterCellProperties()
     const Index2D& cli = m_cl->getCellListIndexer();
 
     // MPCD particle data
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<MPCDReal4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::read);
     const Scalar mpcd_mass = m_mpcd_pdata->getMass();
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
 
@@ -238,6 +329,25 @@ void mpcd::CellThermoCompute::beginOuterCellProperties()
         h_embed_member_idx.reset(new ArrayHandle<unsigned int>(m_cl->getEmbeddedGroup()->getIndexArray(), access_location::host, access_mode::read));
         }
 
+    // Tags to regenerate the random velocities
+    std::unique_ptr< ArrayHandle<unsigned int> > h_tag;
+    std::unique_ptr< ArrayHandle<unsigned int> > h_embed_tag;
+    if (m_use_rand_vel)
+        {
+        h_tag.reset(new ArrayHandle<unsigned int>(m_mpcd_pdata->getTags(), access_location::host, access_mode::read));
+        if (m_cl->getEmbeddedGroup())
+            h_embed_tag.reset(new ArrayHandle<unsigned int>(m_pdata->getTags(), access_location::host, access_mode::read));
+        }
+
+    // Virtual particles filled into the cells
+    std::unique_ptr< ArrayHandle<double4> > h_fill_vel;
+    std::unique_ptr< ArrayHandle<double2> > h_fill_energy;
+    if (!m_fillers.empty())
+        {
+        h_fill_vel.reset(new ArrayHandle<double4>(m_fill_vel, access_location::host, access_mode::read));
+        h_fill_energy.reset(new ArrayHandle<double2>(m_fill_energy, access_location::host, access_mode::read));
+        }
+
     // Cell properties
     ArrayHandle<double4> h_cell_vel(m_cell_vel, access_location::host, access_mode::overwrite);
     ArrayHandle<double3> h_cell_energy(m_cell_energy, access_location::host, access_mode::overwrite);
@@ -249,7 +359,12 @@ void mpcd::CellThermoCompute::beginOuterCellProperties()
                                          mpcd_mass,
                                          (m_cl->getEmbeddedGroup()) ? h_embed_vel->data : NULL,
                                          (m_cl->getEmbeddedGroup()) ? h_embed_member_idx->data : NULL,
-                                         N_mpcd);
+                                         N_mpcd,
+                                         (h_fill_vel) ? h_fill_vel->data : NULL,
+                                         (h_fill_energy) ? h_fill_energy->data : NULL,
+                                         (h_tag) ? h_tag->data : NULL,
+                                         (h_embed_tag) ? h_embed_tag->data : NULL,
+                                         (m_use_rand_vel) ? &m_rand_vel : NULL);
 
     // Loop over all outer cells and compute total momentum, mass, energy
     const bool need_energy = m_flags[mpcd::detail::thermo_options::energy];
@@ -319,7 +434,7 @@ void mpcd::CellThermoCompute::calcInnerCellProperties()
     // MPCD particle data
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
     const Scalar mpcd_mass = m_mpcd_pdata->getMass();
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<MPCDReal4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::read);
 
     // Embedded particle data
     std::unique_ptr< ArrayHandle<Scalar4> > h_embed_vel;
@@ -330,6 +445,25 @@ void mpcd::CellThermoCompute::calcInnerCellProperties()
         h_embed_member_idx.reset(new ArrayHandle<unsigned int>(m_cl->getEmbeddedGroup()->getIndexArray(), access_location::host, access_mode::read));
         }
 
+    // Tags to regenerate the random velocities
+    std::unique_ptr< ArrayHandle<unsigned int> > h_tag;
+    std::unique_ptr< ArrayHandle<unsigned int> > h_embed_tag;
+    if (m_use_rand_vel)
+        {
+        h_tag.reset(new ArrayHandle<unsigned int>(m_mpcd_pdata->getTags(), access_location::host, access_mode::read));
+        if (m_cl->getEmbeddedGroup())
+            h_embed_tag.reset(new ArrayHandle<unsigned int>(m_pdata->getTags(), access_location::host, access_mode::read));
+        }
+
+    // Virtual particles filled into the cells
+    std::unique_ptr< ArrayHandle<double4> > h_fill_vel;
+    std::unique_ptr< ArrayHandle<double2> > h_fill_energy;
+    if (!m_fillers.empty())
+        {
+        h_fill_vel.reset(new ArrayHandle<double4>(m_fill_vel, access_location::host, access_mode::read));
+        h_fill_energy.reset(new ArrayHandle<double2>(m_fill_energy, access_location::host, access_mode::read));
+        }
+
     // Cell properties
     ArrayHandle<double4> h_cell_vel(m_cell_vel, access_location::host, access_mode::readwrite);
     ArrayHandle<double3> h_cell_energy(m_cell_energy, access_location::host, access_mode::readwrite);
@@ -340,7 +474,12 @@ void mpcd::CellThermoCompute::calcInnerCellProperties()
                                          mpcd_mass,
                                          (m_cl->getEmbeddedGroup()) ? h_embed_vel->data : NULL,
                                          (m_cl->getEmbeddedGroup()) ? h_embed_member_idx->data : NULL,
-                                         N_mpcd);
+                                         N_mpcd,
+                                         (h_fill_vel) ? h_fill_vel->data : NULL,
+                                         (h_fill_energy) ? h_fill_energy->data : NULL,
+                                         (h_tag) ? h_tag->data : NULL,
+                                         (h_embed_tag) ? h_embed_tag->data : NULL,
+                                         (m_use_rand_vel) ? &m_rand_vel : NULL);
 
     // determine which cells are inner
     uint3 lo, hi;
@@ -367,6 +506,11 @@ void mpcd::CellThermoCompute::calcInnerCellProperties()
     const bool need_energy = m_flags[mpcd::detail::thermo_options::energy];
     for (unsigned int k=lo.z; k < hi.z; ++k)
         {
+        // let MPI move the outer cell reductions forward once per plane of cells
+        #ifdef ENABLE_MPI
+        progressOuterCellProperties();
+        #endif // ENABLE_MPI
+
         for (unsigned int j=lo.y; j < hi.y; ++j)
             {
             for (unsigned int i=lo.x; i < hi.x; ++i)
@@ -402,6 +546,27 @@ void mpcd::CellThermoCompute::calcInnerCellProperties()
         } // k
     }
 
+/*!
+ * \param timestep Current timestep
+ *
+ * The properties of the virtual particles are summed over all fillers, so that a cell may be filled by more than one
+ * of them.
+ */
+void mpcd::CellThermoCompute::computeFillProperties(unsigned int timestep)
+    {
+        {
+        ArrayHandle<double4> h_fill_vel(m_fill_vel, access_location::host, access_mode::overwrite);
+        ArrayHandle<double2> h_fill_energy(m_fill_energy, access_location::host, access_mode::overwrite);
+        memset(h_fill_vel.data, 0, sizeof(double4)*m_fill_vel.size());
+        memset(h_fill_energy.data, 0, sizeof(double2)*m_fill_energy.size());
+        }
+
+    for (auto filler = m_fillers.begin(); filler != m_fillers.end(); ++filler)
+        {
+        (*filler)->fillCells(m_fill_vel, m_fill_energy, timestep, m_fill_thermal_only);
+        }
+    }
+
 void mpcd::CellThermoCompute::computeNetProperties()
     {
     if (m_prof) m_prof->push("MPCD thermo");
@@ -513,6 +678,8 @@ void mpcd::CellThermoCompute::reallocate(unsigned int ncells)
     // Grow arrays to match the size if necessary
     m_cell_vel.resize(ncells);
     m_cell_energy.resize(ncells);
+    m_fill_vel.resize(ncells);
+    m_fill_energy.resize(ncells);
 
     m_ncells_alloc = ncells;
     }
@@ -15,9 +15,11 @@
 #error This header cannot be compiled by nvcc
 #endif
 
+#include "ATCollisionMethodUtilities.h"
 #include "CellThermoTypes.h"
 #include "CellList.h"
 #include "SystemData.h"
+#include "VirtualParticleFiller.h"
 #ifdef ENABLE_MPI
 #include "CellCommunicator.h"
 #endif // ENABLE_MPI
@@ -139,6 +141,69 @@ class PYBIND11_EXPORT CellThermoCompute : public Compute
             return m_callbacks;
             }
 
+        //! Get the requested thermo flags from the last call to compute
+        const mpcd::detail::ThermoFlags& getFlags() const
+            {
+            return m_flags;
+            }
+
+        //! Check if the cell properties can be computed by a collision method
+        /*!
+         * \param timestep Current timestep
+         * \returns True if the cell properties need to be computed at \a timestep and do not require communication
+         *
+         * Collision methods can compute the cell properties in the same kernel that applies the collision, which
+         * saves a sweep through the particle data. Outer cells in MPI simulations are summed across ranks before
+         * they can be used, so the collision methods must fall back to compute() in that case. The virtual particles
+         * of the fillers are also only added by compute().
+         */
+        bool canFuseCompute(unsigned int timestep) const
+            {
+            if (!m_fillers.empty())
+                return false;
+            #ifdef ENABLE_MPI
+            if (m_use_mpi)
+                return false;
+            #endif // ENABLE_MPI
+            return peekCompute(timestep);
+            }
+
+        //! Prepare the cell properties to be computed by a collision method
+        void beginFusedCompute(unsigned int timestep);
+
+        //! Finish the cell properties computed by a collision method
+        void finishFusedCompute(unsigned int timestep);
+
+        //! Set the virtual particle fillers
+        /*!
+         * \param fillers Virtual particle fillers
+         * \param thermal_only If true, the virtual particles do not carry the mean velocity of their boundary
+         *
+         * The virtual particles of the fillers are added to the properties of the cells they fill without being
+         * inserted into the particle data. Collision methods that compute the properties of random velocities
+         * should set \a thermal_only.
+         */
+        void setFillers(const std::vector<std::shared_ptr<mpcd::VirtualParticleFiller>>& fillers,
+                        bool thermal_only = false)
+            {
+            m_fillers = fillers;
+            m_fill_thermal_only = thermal_only;
+            m_force_compute = true;
+            }
+
+        //! Sum the random velocities of the Andersen thermostat instead of the particle velocities
+        /*!
+         * \param rand_vel Random velocities of the particles
+         *
+         * The random velocity of each particle is regenerated from its tag while the cells are summed, so that the
+         * velocities do not need to be drawn into a separate array first. This should be set before each compute().
+         */
+        void setRandomVelocities(const mpcd::detail::ATRandomVelocity& rand_vel)
+            {
+            m_use_rand_vel = true;
+            m_rand_vel = rand_vel;
+            }
+
     protected:
         //! Compute the cell properties
         void computeCellProperties(unsigned int timestep);
@@ -149,11 +214,23 @@ class PYBIND11_EXPORT CellThermoCompute : public Compute
 
         //! Finish the calculation of outer cell properties
         virtual void finishOuterCellProperties();
+
+        //! Progress the communication of the outer cell properties
+        void progressOuterCellProperties()
+            {
+            if (!m_use_mpi) return;
+            m_vel_comm->progress();
+            if (m_flags[mpcd::detail::thermo_options::energy])
+                m_energy_comm->progress();
+            }
         #endif // ENABLE_MPI
 
         //! Calculate the inner cell properties
         virtual void calcInnerCellProperties();
 
+        //! Compute the properties of the virtual particles filled into the cells
+        virtual void computeFillProperties(unsigned int timestep);
+
         //! Compute the net properties from the cell properties
         virtual void computeNetProperties();
 
@@ -172,6 +249,14 @@ class PYBIND11_EXPORT CellThermoCompute : public Compute
         GPUVector<double3> m_cell_energy;   //!< Kinetic energy, unscaled temperature, dof in each cell
         unsigned int m_ncells_alloc;        //!< Number of cells allocated for
 
+        std::vector<std::shared_ptr<mpcd::VirtualParticleFiller>> m_fillers;    //!< Virtual particle fillers
+        bool m_fill_thermal_only;           //!< If true, virtual particles have no mean velocity
+        GPUVector<double4> m_fill_vel;      //!< Momentum and mass of the virtual particles in each cell
+        GPUVector<double2> m_fill_energy;   //!< Kinetic energy and number of virtual particles in each cell
+
+        bool m_use_rand_vel;                        //!< If true, sum the random velocities instead of the velocities
+        mpcd::detail::ATRandomVelocity m_rand_vel;  //!< Random velocities of the particles
+
         Nano::Signal<mpcd::detail::ThermoFlags ()> m_flag_signal; //!< Signal for requested flags
         mpcd::detail::ThermoFlags m_flags;  //!< Requested thermo flags
         //! Updates the requested optional flags
@@ -30,9 +30,10 @@ mpcd::CellThermoComputeGPU::CellThermoComputeGPU(std::shared_ptr<mpcd::SystemDat
         }
 
     m_begin_tuner.reset(new Autotuner(valid_params, 5, 100000, "mpcd_cell_thermo_begin", m_exec_conf));
-    m_end_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_cell_thermo_end", m_exec_conf));
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_end_tuner.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_cell_thermo_end", m_exec_conf));
     m_inner_tuner.reset(new Autotuner(valid_params, 5, 100000, "mpcd_cell_thermo_inner", m_exec_conf));
-    m_stage_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_cell_thermo_stage", m_exec_conf));
+    m_stage_tuner.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_cell_thermo_stage", m_exec_conf));
     }
 
 mpcd::CellThermoComputeGPU::~CellThermoComputeGPU()
@@ -49,13 +50,37 @@ void mpcd::CellThermoComputeGPU::beginOuterCellProperties()
     ArrayHandle<unsigned int> d_cell_np(m_cl->getCellSizeArray(), access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_cell_list(m_cl->getCellList(), access_location::device, access_mode::read);
 
-    ArrayHandle<Scalar4> d_vel(m_mpcd_pdata->getVelocities(), access_location::device, access_mode::read);
+    ArrayHandle<MPCDReal4> d_vel(m_mpcd_pdata->getVelocities(), access_location::device, access_mode::read);
+
+    // the embedded particles are read from the staging buffers of the cell list
+    if (m_cl->getEmbeddedGroup())
+        m_cl->stageEmbeddedParticles(m_last_computed);
+
+    // Tags to regenerate the random velocities
+    std::unique_ptr< ArrayHandle<unsigned int> > d_tag;
+    std::unique_ptr< ArrayHandle<unsigned int> > d_embed_tag;
+    if (m_use_rand_vel)
+        {
+        d_tag.reset(new ArrayHandle<unsigned int>(m_mpcd_pdata->getTags(), access_location::device, access_mode::read));
+        if (m_cl->getEmbeddedGroup())
+            d_embed_tag.reset(new ArrayHandle<unsigned int>(m_cl->getEmbeddedTags(),
+                                                            access_location::device,
+                                                            access_mode::read));
+        }
+
+    // Virtual particles filled into the cells
+    std::unique_ptr< ArrayHandle<double4> > d_fill_vel;
+    std::unique_ptr< ArrayHandle<double2> > d_fill_energy;
+    if (!m_fillers.empty())
+        {
+        d_fill_vel.reset(new ArrayHandle<double4>(m_fill_vel, access_location::device, access_mode::read));
+        d_fill_energy.reset(new ArrayHandle<double2>(m_fill_energy, access_location::device, access_mode::read));
+        }
 
     if (m_cl->getEmbeddedGroup())
         {
         // Embedded particle data
-        ArrayHandle<Scalar4> d_embed_vel(m_pdata->getVelocities(), access_location::device, access_mode::read);
-        ArrayHandle<unsigned int> d_embed_cell(m_cl->getEmbeddedGroup()->getIndexArray(), access_location::device, access_mode::read);
+        ArrayHandle<Scalar4> d_embed_vel(m_cl->getEmbeddedVelocities(), access_location::device, access_mode::read);
 
         mpcd::detail::thermo_args_t args(d_cell_vel.data,
                                          d_cell_energy.data,
@@ -66,8 +91,12 @@ void mpcd::CellThermoComputeGPU::beginOuterCellProperties()
                                          m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual(),
                                          m_mpcd_pdata->getMass(),
                                          d_embed_vel.data,
-                                         d_embed_cell.data,
-                                         m_flags[mpcd::detail::thermo_options::energy]);
+                                         (d_fill_vel) ? d_fill_vel->data : NULL,
+                                         (d_fill_energy) ? d_fill_energy->data : NULL,
+                                         m_flags[mpcd::detail::thermo_options::energy],
+                                         (d_tag) ? d_tag->data : NULL,
+                                         (d_embed_tag) ? d_embed_tag->data : NULL,
+                                         m_rand_vel);
 
         m_begin_tuner->begin();
         const unsigned int param = m_begin_tuner->getParam();
@@ -92,8 +121,12 @@ void mpcd::CellThermoComputeGPU::beginOuterCellProperties()
                                          m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual(),
                                          m_mpcd_pdata->getMass(),
                                          NULL,
-                                         NULL,
-                                         m_flags[mpcd::detail::thermo_options::energy]);
+                                         (d_fill_vel) ? d_fill_vel->data : NULL,
+                                         (d_fill_energy) ? d_fill_energy->data : NULL,
+                                         m_flags[mpcd::detail::thermo_options::energy],
+                                         (d_tag) ? d_tag->data : NULL,
+                                         (d_embed_tag) ? d_embed_tag->data : NULL,
+                                         m_rand_vel);
 
         m_begin_tuner->begin();
         const unsigned int param = m_begin_tuner->getParam();
@@ -135,7 +168,32 @@ void mpcd::CellThermoComputeGPU::calcInnerCellProperties()
     ArrayHandle<unsigned int> d_cell_np(m_cl->getCellSizeArray(), access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_cell_list(m_cl->getCellList(), access_location::device, access_mode::read);
 
-    ArrayHandle<Scalar4> d_vel(m_mpcd_pdata->getVelocities(), access_location::device, access_mode::read);
+    ArrayHandle<MPCDReal4> d_vel(m_mpcd_pdata->getVelocities(), access_location::device, access_mode::read);
+
+    // the embedded particles are read from the staging buffers of the cell list
+    if (m_cl->getEmbeddedGroup())
+        m_cl->stageEmbeddedParticles(m_last_computed);
+
+    // Tags to regenerate the random velocities
+    std::unique_ptr< ArrayHandle<unsigned int> > d_tag;
+    std::unique_ptr< ArrayHandle<unsigned int> > d_embed_tag;
+    if (m_use_rand_vel)
+        {
+        d_tag.reset(new ArrayHandle<unsigned int>(m_mpcd_pdata->getTags(), access_location::device, access_mode::read));
+        if (m_cl->getEmbeddedGroup())
+            d_embed_tag.reset(new ArrayHandle<unsigned int>(m_cl->getEmbeddedTags(),
+                                                            access_location::device,
+                                                            access_mode::read));
+        }
+
+    // Virtual particles filled into the cells
+    std::unique_ptr< ArrayHandle<double4> > d_fill_vel;
+    std::unique_ptr< ArrayHandle<double2> > d_fill_energy;
+    if (!m_fillers.empty())
+        {
+        d_fill_vel.reset(new ArrayHandle<double4>(m_fill_vel, access_location::device, access_mode::read));
+        d_fill_energy.reset(new ArrayHandle<double2>(m_fill_energy, access_location::device, access_mode::read));
+        }
 
     /*
      * Determine the inner cell indexer and offset. The inner indexer is the cube containing
@@ -166,8 +224,7 @@ void mpcd::CellThermoComputeGPU::calcInnerCellProperties()
     if (m_cl->getEmbeddedGroup())
         {
         // Embedded particle data
-        ArrayHandle<Scalar4> d_embed_vel(m_pdata->getVelocities(), access_location::device, access_mode::read);
-        ArrayHandle<unsigned int> d_embed_cell(m_cl->getEmbeddedGroup()->getIndexArray(), access_location::device, access_mode::read);
+        ArrayHandle<Scalar4> d_embed_vel(m_cl->getEmbeddedVelocities(), access_location::device, access_mode::read);
 
         mpcd::detail::thermo_args_t args(d_cell_vel.data,
                                          d_cell_energy.data,
@@ -178,8 +235,12 @@ void mpcd::CellThermoComputeGPU::calcInnerCellProperties()
                                          m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual(),
                                          m_mpcd_pdata->getMass(),
                                          d_embed_vel.data,
-                                         d_embed_cell.data,
-                                         m_flags[mpcd::detail::thermo_options::energy]);
+                                         (d_fill_vel) ? d_fill_vel->data : NULL,
+                                         (d_fill_energy) ? d_fill_energy->data : NULL,
+                                         m_flags[mpcd::detail::thermo_options::energy],
+                                         (d_tag) ? d_tag->data : NULL,
+                                         (d_embed_tag) ? d_embed_tag->data : NULL,
+                                         m_rand_vel);
 
         m_inner_tuner->begin();
         const unsigned int param = m_inner_tuner->getParam();
@@ -206,8 +267,12 @@ void mpcd::CellThermoComputeGPU::calcInnerCellProperties()
                                          m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual(),
                                          m_mpcd_pdata->getMass(),
                                          NULL,
-                                         NULL,
-                                         m_flags[mpcd::detail::thermo_options::energy]);
+                                         (d_fill_vel) ? d_fill_vel->data : NULL,
+                                         (d_fill_energy) ? d_fill_energy->data : NULL,
+                                         m_flags[mpcd::detail::thermo_options::energy],
+                                         (d_tag) ? d_tag->data : NULL,
+                                         (d_embed_tag) ? d_embed_tag->data : NULL,
+                                         m_rand_vel);
 
         m_inner_tuner->begin();
         const unsigned int param = m_inner_tuner->getParam();
@@ -225,6 +290,24 @@ void mpcd::CellThermoComputeGPU::calcInnerCellProperties()
         }
     }
 
+/*!
+ * \param timestep Current timestep
+ */
+void mpcd::CellThermoComputeGPU::computeFillProperties(unsigned int timestep)
+    {
+        {
+        ArrayHandle<double4> d_fill_vel(m_fill_vel, access_location::device, access_mode::overwrite);
+        ArrayHandle<double2> d_fill_energy(m_fill_energy, access_location::device, access_mode::overwrite);
+        cudaMemset(d_fill_vel.data, 0, sizeof(double4)*m_fill_vel.size());
+        cudaMemset(d_fill_energy.data, 0, sizeof(double2)*m_fill_energy.size());
+        }
+
+    for (auto filler = m_fillers.begin(); filler != m_fillers.end(); ++filler)
+        {
+        (*filler)->fillCells(m_fill_vel, m_fill_energy, timestep, m_fill_thermal_only);
+        }
+    }
+
 void mpcd::CellThermoComputeGPU::computeNetProperties()
     {
     if (m_prof) m_prof->push(m_exec_conf, "MPCD thermo");
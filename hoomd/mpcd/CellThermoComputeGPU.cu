@@ -34,8 +34,12 @@ namespace kernel
  * \param d_vel MPCD particle velocities
  * \param N_mpcd Number of MPCD particles
  * \param mpcd_mass Mass of MPCD particle
- * \param d_embed_vel Embedded particle velocity
- * \param d_embed_idx Embedded particle indexes
+ * \param d_embed_vel Staged embedded particle velocities
+ * \param d_fill_vel Momentum and mass of virtual particles filled into each cell (NULL if not filling)
+ * \param d_fill_energy Kinetic energy and number of virtual particles filled into each cell
+ * \param d_tag MPCD particle tags to regenerate random velocities (NULL to use \a d_vel)
+ * \param d_embed_tag Staged embedded particle tags
+ * \param rand_vel Random velocities summed instead of the particle velocities
  * \param num_cells Number of cells to compute for
  *
  * \tparam need_energy If true, compute the cell-level energy properties
@@ -54,11 +58,15 @@ __global__ void begin_cell_thermo(double4 *d_cell_vel,
                                   const unsigned int *d_cell_np,
                                   const unsigned int *d_cell_list,
                                   const Index2D cli,
-                                  const Scalar4 *d_vel,
+                                  const MPCDReal4 *d_vel,
                                   const unsigned int N_mpcd,
                                   const Scalar mpcd_mass,
                                   const Scalar4 *d_embed_vel,
-                                  const unsigned int *d_embed_idx,
+                                  const double4 *d_fill_vel,
+                                  const double2 *d_fill_energy,
+                                  const unsigned int *d_tag,
+                                  const unsigned int *d_embed_tag,
+                                  const mpcd::detail::ATRandomVelocity rand_vel,
                                   const unsigned int num_cells)
     {
     // tpp threads per cell
@@ -79,15 +87,32 @@ __global__ void begin_cell_thermo(double4 *d_cell_vel,
         double mass_i;
         if (cur_p < N_mpcd)
             {
-            Scalar4 vel_cell = d_vel[cur_p];
-            vel_i = make_double3(vel_cell.x, vel_cell.y, vel_cell.z);
             mass_i = mpcd_mass;
+            if (d_tag != NULL)
+                {
+                const Scalar3 vel_rand = rand_vel(d_tag[cur_p], mass_i);
+                vel_i = make_double3(vel_rand.x, vel_rand.y, vel_rand.z);
+                }
+            else
+                {
+                MPCDReal4 vel_cell = d_vel[cur_p];
+                vel_i = make_double3(vel_cell.x, vel_cell.y, vel_cell.z);
+                }
             }
         else
             {
-            Scalar4 vel_m = d_embed_vel[d_embed_idx[cur_p - N_mpcd]];
-            vel_i = make_double3(vel_m.x, vel_m.y, vel_m.z);
+            const unsigned int embed_p = cur_p - N_mpcd;
+            Scalar4 vel_m = d_embed_vel[embed_p];
             mass_i = vel_m.w;
+            if (d_tag != NULL)
+                {
+                const Scalar3 vel_rand = rand_vel(d_embed_tag[embed_p], mass_i);
+                vel_i = make_double3(vel_rand.x, vel_rand.y, vel_rand.z);
+                }
+            else
+                {
+                vel_i = make_double3(vel_m.x, vel_m.y, vel_m.z);
+                }
             }
 
         // add momentum
@@ -116,9 +141,26 @@ __global__ void begin_cell_thermo(double4 *d_cell_vel,
     // 0-th lane in each warp writes the result
     if (idx % tpp == 0)
         {
+        // add the virtual particles filled into the cell
+        unsigned int np_cell = np;
+        if (d_fill_vel != NULL)
+            {
+            const double4 fill_vel = d_fill_vel[cell_id];
+            momentum.x += fill_vel.x;
+            momentum.y += fill_vel.y;
+            momentum.z += fill_vel.z;
+            momentum.w += fill_vel.w;
+            if (need_energy)
+                {
+                const double2 fill_energy = d_fill_energy[cell_id];
+                ke += fill_energy.x;
+                np_cell += (unsigned int)fill_energy.y;
+                }
+            }
+
         d_cell_vel[cell_id] = make_double4(momentum.x, momentum.y, momentum.z, momentum.w);
         if (need_energy)
-            d_cell_energy[cell_id] = make_double3(ke, 0.0, __int_as_double(np));
+            d_cell_energy[cell_id] = make_double3(ke, 0.0, __int_as_double(np_cell));
         }
     }
 
@@ -191,8 +233,12 @@ __global__ void end_cell_thermo(double4 *d_cell_vel,
  * \param d_vel MPCD particle velocities
  * \param N_mpcd Number of MPCD particles
  * \param mpcd_mass Mass of MPCD particle
- * \param d_embed_vel Embedded particle velocity
- * \param d_embed_idx Embedded particle indexes
+ * \param d_embed_vel Staged embedded particle velocities
+ * \param d_fill_vel Momentum and mass of virtual particles filled into each cell (NULL if not filling)
+ * \param d_fill_energy Kinetic energy and number of virtual particles filled into each cell
+ * \param d_tag MPCD particle tags to regenerate random velocities (NULL to use \a d_vel)
+ * \param d_embed_tag Staged embedded particle tags
+ * \param rand_vel Random velocities summed instead of the particle velocities
  * \param n_dimensions System dimensionality
  *
  * \tparam need_energy If true, compute the cell-level energy properties.
@@ -216,11 +262,15 @@ __global__ void inner_cell_thermo(double4 *d_cell_vel,
                                   const unsigned int *d_cell_np,
                                   const unsigned int *d_cell_list,
                                   const Index2D cli,
-                                  const Scalar4 *d_vel,
+                                  const MPCDReal4 *d_vel,
                                   const unsigned int N_mpcd,
                                   const Scalar mpcd_mass,
                                   const Scalar4 *d_embed_vel,
-                                  const unsigned int *d_embed_idx,
+                                  const double4 *d_fill_vel,
+                                  const double2 *d_fill_energy,
+                                  const unsigned int *d_tag,
+                                  const unsigned int *d_embed_tag,
+                                  const mpcd::detail::ATRandomVelocity rand_vel,
                                   const unsigned int n_dimensions)
     {
     // tpp threads per cell
@@ -247,15 +297,32 @@ __global__ void inner_cell_thermo(double4 *d_cell_vel,
         double mass_i;
         if (cur_p < N_mpcd)
             {
-            Scalar4 vel_cell = d_vel[cur_p];
-            vel_i = make_double3(vel_cell.x, vel_cell.y, vel_cell.z);
             mass_i = mpcd_mass;
+            if (d_tag != NULL)
+                {
+                const Scalar3 vel_rand = rand_vel(d_tag[cur_p], mass_i);
+                vel_i = make_double3(vel_rand.x, vel_rand.y, vel_rand.z);
+                }
+            else
+                {
+                MPCDReal4 vel_cell = d_vel[cur_p];
+                vel_i = make_double3(vel_cell.x, vel_cell.y, vel_cell.z);
+                }
             }
         else
             {
-            Scalar4 vel_m = d_embed_vel[d_embed_idx[cur_p - N_mpcd]];
-            vel_i = make_double3(vel_m.x, vel_m.y, vel_m.z);
+            const unsigned int embed_p = cur_p - N_mpcd;
+            Scalar4 vel_m = d_embed_vel[embed_p];
             mass_i = vel_m.w;
+            if (d_tag != NULL)
+                {
+                const Scalar3 vel_rand = rand_vel(d_embed_tag[embed_p], mass_i);
+                vel_i = make_double3(vel_rand.x, vel_rand.y, vel_rand.z);
+                }
+            else
+                {
+                vel_i = make_double3(vel_m.x, vel_m.y, vel_m.z);
+                }
             }
 
         // add momentum
@@ -284,6 +351,23 @@ __global__ void inner_cell_thermo(double4 *d_cell_vel,
     // 0-th lane in each warp writes the result
     if (idx % tpp == 0)
         {
+        // add the virtual particles filled into the cell
+        unsigned int np_cell = np;
+        if (d_fill_vel != NULL)
+            {
+            const double4 fill_vel = d_fill_vel[cell_id];
+            momentum.x += fill_vel.x;
+            momentum.y += fill_vel.y;
+            momentum.z += fill_vel.z;
+            momentum.w += fill_vel.w;
+            if (need_energy)
+                {
+                const double2 fill_energy = d_fill_energy[cell_id];
+                ke += fill_energy.x;
+                np_cell += (unsigned int)fill_energy.y;
+                }
+            }
+
         const double mass = momentum.w;
         double3 vel_cm = make_double3(0.0,0.0,0.0);
         if (mass > 0.)
@@ -297,12 +381,12 @@ __global__ void inner_cell_thermo(double4 *d_cell_vel,
         if (need_energy)
             {
             double temp(0.0);
-            if (np > 1)
+            if (np_cell > 1)
                 {
                 const double ke_cm = 0.5 * mass * (vel_cm.x*vel_cm.x + vel_cm.y*vel_cm.y + vel_cm.z*vel_cm.z);
-                temp = 2. * (ke - ke_cm) / (n_dimensions * (np-1));
+                temp = 2. * (ke - ke_cm) / (n_dimensions * (np_cell-1));
                 }
-            d_cell_energy[cell_id] = make_double3(ke, temp, __int_as_double(np));
+            d_cell_energy[cell_id] = make_double3(ke, temp, __int_as_double(np_cell));
             }
         }
     }
@@ -422,7 +506,11 @@ inline void launch_begin_cell_thermo(const mpcd::detail::thermo_args_t& args,
                                                                                          args.N_mpcd,
                                                                                          args.mass,
                                                                                          args.embed_vel,
-                                                                                         args.embed_idx,
+                                                                                         args.fill_vel,
+                                                                                         args.fill_energy,
+                                                                                         args.tag,
+                                                                                         args.embed_tag,
+                                                                                         args.rand_vel,
                                                                                          num_cells);
             }
         else
@@ -447,7 +535,11 @@ inline void launch_begin_cell_thermo(const mpcd::detail::thermo_args_t& args,
                                                                                           args.N_mpcd,
                                                                                           args.mass,
                                                                                           args.embed_vel,
-                                                                                          args.embed_idx,
+                                                                                          args.fill_vel,
+                                                                                          args.fill_energy,
+                                                                                          args.tag,
+                                                                                          args.embed_tag,
+                                                                                          args.rand_vel,
                                                                                           num_cells);
             }
         }
@@ -613,7 +705,11 @@ inline void launch_inner_cell_thermo(const mpcd::detail::thermo_args_t& args,
                                                                                          args.N_mpcd,
                                                                                          args.mass,
                                                                                          args.embed_vel,
-                                                                                         args.embed_idx,
+                                                                                         args.fill_vel,
+                                                                                         args.fill_energy,
+                                                                                         args.tag,
+                                                                                         args.embed_tag,
+                                                                                         args.rand_vel,
                                                                                          n_dimensions);
             }
         else
@@ -640,7 +736,11 @@ inline void launch_inner_cell_thermo(const mpcd::detail::thermo_args_t& args,
                                                                                           args.N_mpcd,
                                                                                           args.mass,
                                                                                           args.embed_vel,
-                                                                                          args.embed_idx,
+                                                                                          args.fill_vel,
+                                                                                          args.fill_energy,
+                                                                                          args.tag,
+                                                                                          args.embed_tag,
+                                                                                          args.rand_vel,
                                                                                           n_dimensions);
             }
         }
@@ -11,6 +11,8 @@
 #ifndef MPCD_CELL_THERMO_COMPUTE_GPU_CUH_
 #define MPCD_CELL_THERMO_COMPUTE_GPU_CUH_
 
+#include "ATCollisionMethodUtilities.h"
+#include "ParticleDataUtilities.h"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/BoxDim.h"
 #include "hoomd/Index1D.h"
@@ -58,15 +60,20 @@ struct thermo_args_t
                   const unsigned int *cell_np_,
                   const unsigned int *cell_list_,
                   const Index2D& cli_,
-                  const Scalar4 *vel_,
+                  const MPCDReal4 *vel_,
                   const unsigned int N_mpcd_,
                   const Scalar mass_,
                   const Scalar4 *embed_vel_,
-                  const unsigned int *embed_idx_,
-                  bool need_energy_)
+                  const double4 *fill_vel_,
+                  const double2 *fill_energy_,
+                  bool need_energy_,
+                  const unsigned int *tag_,
+                  const unsigned int *embed_tag_,
+                  const mpcd::detail::ATRandomVelocity& rand_vel_)
         : cell_vel(cell_vel_), cell_energy(cell_energy_), cell_np(cell_np_), cell_list(cell_list_),
-          cli(cli_), vel(vel_), N_mpcd(N_mpcd_), mass(mass_), embed_vel(embed_vel_), embed_idx(embed_idx_),
-          need_energy(need_energy_)
+          cli(cli_), vel(vel_), N_mpcd(N_mpcd_), mass(mass_), embed_vel(embed_vel_),
+          fill_vel(fill_vel_), fill_energy(fill_energy_), need_energy(need_energy_),
+          tag(tag_), embed_tag(embed_tag_), rand_vel(rand_vel_)
         { }
 
     double4 *cell_vel;              //!< Cell velocities (output)
@@ -75,12 +82,16 @@ struct thermo_args_t
     const unsigned int *cell_np;    //!< Number of particles per cell
     const unsigned int *cell_list;  //!< MPCD cell list
     const Index2D cli;              //!< MPCD cell list indexer
-    const Scalar4 *vel;             //!< MPCD particle velocities
+    const MPCDReal4 *vel;           //!< MPCD particle velocities
     const unsigned int N_mpcd;      //!< Number of MPCD particles
     const Scalar mass;              //!< MPCD particle mass
-    const Scalar4 *embed_vel;       //!< Embedded particle velocities
-    const unsigned int *embed_idx;  //!< Embedded particle indexes
+    const Scalar4 *embed_vel;       //!< Staged embedded particle velocities, in the order of the group members
+    const double4 *fill_vel;        //!< Momentum and mass of virtual particles per cell (NULL if not filling)
+    const double2 *fill_energy;     //!< Kinetic energy and number of virtual particles per cell
     const bool need_energy;         //!< Flag if energy calculations are required
+    const unsigned int *tag;        //!< MPCD particle tags (NULL to sum the particle velocities)
+    const unsigned int *embed_tag;  //!< Staged embedded particle tags
+    const mpcd::detail::ATRandomVelocity rand_vel;  //!< Random velocities summed when \a tag is set
     };
 #undef HOSTDEVICE
 }
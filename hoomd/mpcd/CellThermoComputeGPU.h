@@ -70,6 +70,9 @@ class PYBIND11_EXPORT CellThermoComputeGPU : public mpcd::CellThermoCompute
         //! Calculate the inner cell properties on the GPU
         virtual void calcInnerCellProperties();
 
+        //! Compute the properties of the virtual particles filled into the cells on the GPU
+        virtual void computeFillProperties(unsigned int timestep);
+
         //! Compute the net properties from the cell properties
         virtual void computeNetProperties();
 
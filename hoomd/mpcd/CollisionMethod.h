@@ -16,6 +16,7 @@
 #endif
 
 #include "SystemData.h"
+#include "VirtualParticleFiller.h"
 #include <pybind11/pybind11.h>
 
 namespace mpcd
@@ -84,6 +85,14 @@ class PYBIND11_EXPORT CollisionMethod
         //! Set the period of the collision method
         void setPeriod(unsigned int cur_timestep, unsigned int period);
 
+        //! Set the virtual particle fillers of the boundaries
+        /*!
+         * \param fillers Virtual particle fillers
+         *
+         * Derived classes should override this to add the virtual particles to the cell properties they use.
+         */
+        virtual void setFillers(const std::vector<std::shared_ptr<mpcd::VirtualParticleFiller>>& fillers) { }
+
     protected:
         std::shared_ptr<mpcd::SystemData> m_mpcd_sys;                   //!< MPCD system data
         std::shared_ptr<SystemDefinition> m_sysdef;                     //!< HOOMD system definition
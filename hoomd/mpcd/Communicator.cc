@@ -65,7 +65,11 @@ mpcd::Communicator::Communicator(std::shared_ptr<mpcd::SystemData> system_data)
     // create new data type for the pdata_element
     const int nitems = 4;
     int blocklengths[nitems] = {4,4,1,1};
+    #if defined(ENABLE_MPCD_MIXED_PRECISION) && !defined(SINGLE_PRECISION)
+    MPI_Datatype types[nitems] = {MPI_FLOAT, MPI_FLOAT, MPI_UNSIGNED, MPI_UNSIGNED};
+    #else
     MPI_Datatype types[nitems] = {MPI_HOOMD_SCALAR, MPI_HOOMD_SCALAR, MPI_UNSIGNED, MPI_UNSIGNED};
+    #endif
     MPI_Aint offsets[nitems];
     offsets[0] = offsetof(mpcd::detail::pdata_element, pos);
     offsets[1] = offsetof(mpcd::detail::pdata_element, vel);
@@ -394,10 +398,12 @@ void mpcd::Communicator::migrateParticles(unsigned int timestep)
         for (unsigned int idx = 0; idx < n_recv; ++idx)
             {
             mpcd::detail::pdata_element& p = h_recvbuf.data[idx];
-            Scalar4& postype = p.pos;
+            MPCDReal4& postype = p.pos;
+            Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
             int3 image = make_int3(0,0,0);
 
-            wrap_box.wrap(postype,image);
+            wrap_box.wrap(pos,image);
+            postype.x = pos.x; postype.y = pos.y; postype.z = pos.z;
             }
         }
 
@@ -419,7 +425,7 @@ void mpcd::Communicator::setCommFlags(const BoxDim& box)
     if (m_prof) m_prof->push("comm flags");
     // mark all particles which have left the box for sending
     unsigned int N = m_mpcd_pdata->getN();
-    ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<MPCDReal4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_comm_flag(m_mpcd_pdata->getCommFlags(), access_location::host, access_mode::overwrite);
 
     // since box is orthorhombic, just use branching to compute comm flags
@@ -427,7 +433,7 @@ void mpcd::Communicator::setCommFlags(const BoxDim& box)
     const Scalar3 hi = box.getHi();
     for (unsigned int idx = 0; idx < N; ++idx)
         {
-        const Scalar4& postype = h_pos.data[idx];
+        const MPCDReal4& postype = h_pos.data[idx];
         const Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
 
         unsigned int flags = 0;
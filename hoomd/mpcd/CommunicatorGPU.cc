@@ -40,7 +40,8 @@ mpcd::CommunicatorGPU::CommunicatorGPU(std::shared_ptr<mpcd::SystemData> system_
     m_num_send.swap(num_send);
 
     // autotuners
-    m_flags_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_comm_flags", m_exec_conf));
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_flags_tuner.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_comm_flags", m_exec_conf));
     }
 
 mpcd::CommunicatorGPU::~CommunicatorGPU()
@@ -338,7 +339,7 @@ void mpcd::CommunicatorGPU::setCommFlags(const BoxDim& box)
     if (m_prof) m_prof->push(m_exec_conf, "comm flags");
 
     ArrayHandle<unsigned int> d_comm_flag(m_mpcd_pdata->getCommFlags(), access_location::device, access_mode::overwrite);
-    ArrayHandle<Scalar4> d_pos(m_mpcd_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<MPCDReal4> d_pos(m_mpcd_pdata->getPositions(), access_location::device, access_mode::read);
 
     m_flags_tuner->begin();
     mpcd::gpu::stage_particles(d_comm_flag.data,
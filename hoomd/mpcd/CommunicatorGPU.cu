@@ -44,14 +44,14 @@ namespace kernel
  * Checks for particles being out of bounds, and aggregates send flags.
  */
 __global__ void stage_particles(unsigned int *d_comm_flag,
-                                const Scalar4 *d_pos,
+                                const MPCDReal4 *d_pos,
                                 unsigned int N,
                                 const BoxDim box)
     {
     const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
     if (idx >= N) return;
 
-    const Scalar4 postype = d_pos[idx];
+    const MPCDReal4 postype = d_pos[idx];
     const Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
     const Scalar3 lo = box.getLo();
     const Scalar3 hi = box.getHi();
@@ -157,7 +157,7 @@ struct get_migrate_key : public thrust::unary_function<const unsigned int, unsig
  * \returns Accumulated communication flags of all particles
  */
 cudaError_t mpcd::gpu::stage_particles(unsigned int *d_comm_flag,
-                                        const Scalar4 *d_pos,
+                                        const MPCDReal4 *d_pos,
                                         const unsigned int N,
                                         const BoxDim& box,
                                         const unsigned int block_size)
@@ -277,8 +277,10 @@ struct wrap_particle_op : public thrust::unary_function<const mpcd::detail::pdat
     __device__ mpcd::detail::pdata_element operator()(const mpcd::detail::pdata_element p)
         {
         mpcd::detail::pdata_element ret = p;
+        Scalar3 pos = make_scalar3(ret.pos.x, ret.pos.y, ret.pos.z);
         int3 image = make_int3(0,0,0);
-        box.wrap(ret.pos, image);
+        box.wrap(pos, image);
+        ret.pos.x = pos.x; ret.pos.y = pos.y; ret.pos.z = pos.z;
         return ret;
         }
      };
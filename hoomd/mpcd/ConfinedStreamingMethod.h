@@ -63,6 +63,9 @@ class PYBIND11_EXPORT ConfinedStreamingMethod : public mpcd::StreamingMethod
         //! Implementation of the streaming rule
         virtual void stream(unsigned int timestep);
 
+        //! Stream the particles and bin them into the cell list
+        virtual bool streamAndBin(unsigned int timestep, unsigned int bin_timestep);
+
         //! Get the streaming geometry
         std::shared_ptr<const Geometry> getGeometry() const
             {
@@ -80,6 +83,9 @@ class PYBIND11_EXPORT ConfinedStreamingMethod : public mpcd::StreamingMethod
         std::shared_ptr<const Geometry> m_geom; //!< Streaming geometry
         bool m_validate_geom;   //!< If true, run a validation check on the geometry
 
+        //! Stream the particles, optionally binning them into the cell list
+        virtual void streamParticles(bool bin);
+
         //! Validate the system with the streaming geometry
         void validate();
 
@@ -95,6 +101,38 @@ void ConfinedStreamingMethod<Geometry>::stream(unsigned int timestep)
     {
     if (!shouldStream(timestep)) return;
 
+    streamParticles(false);
+    }
+
+/*!
+ * \param timestep Current time to stream
+ * \param bin_timestep Timestep the cell list is binned for
+ * \returns True if the cell list was built for \a bin_timestep
+ *
+ * The particles are binned into the cell list with its current grid shift right after they are streamed, which
+ * saves reading the particles again in mpcd::CellList::compute(). The caller must set the grid shift for
+ * \a bin_timestep first, and nothing may move or reorder the particles before the cell list is used. The cell list
+ * decides if it can be filled this way (see mpcd::CellList::startFusedBuild()). Otherwise, the particles are only
+ * streamed.
+ */
+template<class Geometry>
+bool ConfinedStreamingMethod<Geometry>::streamAndBin(unsigned int timestep, unsigned int bin_timestep)
+    {
+    if (!shouldStream(timestep)) return false;
+
+    auto cl = m_mpcd_sys->getCellList();
+    const bool bin = cl->startFusedBuild();
+    streamParticles(bin);
+
+    return (bin && cl->finishFusedBuild(bin_timestep));
+    }
+
+/*!
+ * \param bin If true, bin the particles into the cell list after they are streamed
+ */
+template<class Geometry>
+void ConfinedStreamingMethod<Geometry>::streamParticles(bool bin)
+    {
     if (m_validate_geom)
         {
         validate();
@@ -105,20 +143,35 @@ void ConfinedStreamingMethod<Geometry>::stream(unsigned int timestep)
 
     const BoxDim& box = m_mpcd_sys->getCellList()->getCoverageBox();
 
-    ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+    ArrayHandle<MPCDReal4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<MPCDReal4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
     const Scalar mass = m_mpcd_pdata->getMass();
 
     // acquire polymorphic pointer to the external field
     const mpcd::ExternalField* field = (m_field) ? m_field->get(access_location::host) : nullptr;
 
+    // the cell list counters were zeroed by startFusedBuild
+    std::shared_ptr<mpcd::CellList> cl = m_mpcd_sys->getCellList();
+    std::unique_ptr< ArrayHandle<unsigned int> > h_cell_np;
+    std::unique_ptr< ArrayHandle<unsigned int> > h_cell_list;
+    mpcd::detail::CellBinner binner;
+    const unsigned int cell_np_max = cl->getNmax();
+    const Index2D& cell_list_indexer = cl->getCellListIndexer();
+    uint3 conditions = make_uint3(0,0,0);
+    if (bin)
+        {
+        h_cell_np.reset(new ArrayHandle<unsigned int>(cl->getCellSizeArray(), access_location::host, access_mode::readwrite));
+        h_cell_list.reset(new ArrayHandle<unsigned int>(cl->getCellList(), access_location::host, access_mode::overwrite));
+        binner = cl->getBinner();
+        }
+
     for (unsigned int cur_p = 0; cur_p < m_mpcd_pdata->getN(); ++cur_p)
         {
-        const Scalar4 postype = h_pos.data[cur_p];
+        const MPCDReal4 postype = h_pos.data[cur_p];
         Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
-        const unsigned int type = __scalar_as_int(postype.w);
+        const unsigned int type = __mpcdreal_as_int(postype.w);
 
-        const Scalar4 vel_cell = h_vel.data[cur_p];
+        const MPCDReal4 vel_cell = h_vel.data[cur_p];
         Scalar3 vel = make_scalar3(vel_cell.x, vel_cell.y, vel_cell.z);
         // estimate next velocity based on current acceleration
         if (field)
@@ -145,11 +198,44 @@ void ConfinedStreamingMethod<Geometry>::stream(unsigned int timestep)
         int3 image = make_int3(0,0,0);
         box.wrap(pos, image);
 
-        h_pos.data[cur_p] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(type));
-        h_vel.data[cur_p] = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
+        // bin the particle into the cell list
+        unsigned int bin_idx = mpcd::detail::NO_CELL;
+        if (bin)
+            {
+            const mpcd::detail::bin_status status = binner.bin(pos, bin_idx);
+            if (status == mpcd::detail::bin_status::ok)
+                {
+                const unsigned int offset = h_cell_np->data[bin_idx]++;
+                if (offset < cell_np_max)
+                    {
+                    h_cell_list->data[cell_list_indexer(offset, bin_idx)] = cur_p;
+                    }
+                else
+                    {
+                    // overflow
+                    conditions.x = std::max(conditions.x, offset+1);
+                    }
+                }
+            else
+                {
+                if (status == mpcd::detail::bin_status::invalid)
+                    conditions.y = cur_p + 1;
+                else
+                    conditions.z = cur_p + 1;
+                bin_idx = mpcd::detail::NO_CELL;
+                }
+            }
+
+        h_pos.data[cur_p] = make_mpcdreal4(pos.x, pos.y, pos.z, __int_as_mpcdreal(type));
+        h_vel.data[cur_p] = make_mpcdreal4(vel.x, vel.y, vel.z, __int_as_mpcdreal(bin_idx));
+        }
+
+    if (bin)
+        {
+        cl->getConditionFlags().resetFlags(conditions);
         }
 
-    // particles have moved, so the cell cache is no longer valid
+    // particles have moved, so the cell cache is no longer valid until the cell list is finished
     m_mpcd_pdata->invalidateCellCache();
     if (m_prof) m_prof->pop();
     }
@@ -183,12 +269,12 @@ void ConfinedStreamingMethod<Geometry>::validate()
 template<class Geometry>
 bool ConfinedStreamingMethod<Geometry>::validateParticles()
     {
-    ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<MPCDReal4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_tag(m_mpcd_pdata->getTags(), access_location::host, access_mode::read);
 
     for (unsigned int idx = 0; idx < m_mpcd_pdata->getN(); ++idx)
         {
-        const Scalar4 postype = h_pos.data[idx];
+        const MPCDReal4 postype = h_pos.data[idx];
         const Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
         if (m_geom->isOutside(pos))
             {
@@ -28,17 +28,21 @@ namespace gpu
 template cudaError_t
 __attribute__((visibility("default")))
 confined_stream<mpcd::detail::BulkGeometry>
-    (const stream_args_t& args, const mpcd::detail::BulkGeometry& geom);
+    (const stream_args_t& args, const mpcd::detail::BulkGeometry& geom, const cell_bin_args_t& bin_args);
 
 //! Template instantiation of slit geometry streaming
 template cudaError_t
 __attribute__((visibility("default")))
 confined_stream<mpcd::detail::SlitGeometry>
-    (const stream_args_t& args, const mpcd::detail::SlitGeometry& geom);
+    (const stream_args_t& args, const mpcd::detail::SlitGeometry& geom, const cell_bin_args_t& bin_args);
 
 //! Template instantiation of slit geometry streaming
 template cudaError_t confined_stream<mpcd::detail::SlitPoreGeometry>
-    (const stream_args_t& args, const mpcd::detail::SlitPoreGeometry& geom);
+    (const stream_args_t& args, const mpcd::detail::SlitPoreGeometry& geom, const cell_bin_args_t& bin_args);
+
+//! Template instantiation of signed distance field geometry streaming
+template cudaError_t confined_stream<mpcd::detail::SDFGeometry>
+    (const stream_args_t& args, const mpcd::detail::SDFGeometry& geom, const cell_bin_args_t& bin_args);
 
 } // end namespace gpu
 } // end namespace mpcd
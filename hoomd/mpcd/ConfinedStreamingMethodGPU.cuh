@@ -11,6 +11,7 @@
  * \brief Declaration of CUDA kernels for mpcd::ConfinedStreamingMethodGPU
  */
 
+#include "CellListUtilities.h"
 #include "ExternalField.h"
 #include "ParticleDataUtilities.h"
 #include "hoomd/BoxDim.h"
@@ -25,8 +26,8 @@ namespace gpu
 struct stream_args_t
     {
     //! Constructor
-    stream_args_t(Scalar4 *_d_pos,
-                  Scalar4 *_d_vel,
+    stream_args_t(MPCDReal4 *_d_pos,
+                  MPCDReal4 *_d_vel,
                   const Scalar _mass,
                   const mpcd::ExternalField* _field,
                   const BoxDim& _box,
@@ -36,8 +37,8 @@ struct stream_args_t
         : d_pos(_d_pos), d_vel(_d_vel), mass(_mass), field(_field), box(_box), dt(_dt), N(_N), block_size(_block_size)
         { }
 
-    Scalar4 *d_pos;                     //!< Particle positions
-    Scalar4 *d_vel;                     //!< Particle velocities
+    MPCDReal4 *d_pos;                   //!< Particle positions
+    MPCDReal4 *d_vel;                   //!< Particle velocities
     const Scalar mass;                  //!< Particle mass
     const mpcd::ExternalField* field;   //!< Applied external field on particles
     const BoxDim& box;                  //!< Simulation box
@@ -46,9 +47,41 @@ struct stream_args_t
     const unsigned int block_size;      //!< Number of threads per block
     };
 
+//! Arguments to bin particles into the cell list while they are streamed
+/*!
+ * The default arguments do not bin the particles.
+ */
+struct cell_bin_args_t
+    {
+    //! Default constructor
+    cell_bin_args_t()
+        : d_cell_np(NULL), d_cell_list(NULL), d_conditions(NULL), cell_np_max(0)
+        { }
+
+    //! Constructor
+    cell_bin_args_t(unsigned int *_d_cell_np,
+                    unsigned int *_d_cell_list,
+                    uint3 *_d_conditions,
+                    const mpcd::detail::CellBinner& _binner,
+                    const unsigned int _cell_np_max,
+                    const Index2D& _cell_list_indexer)
+        : d_cell_np(_d_cell_np), d_cell_list(_d_cell_list), d_conditions(_d_conditions), binner(_binner),
+          cell_np_max(_cell_np_max), cell_list_indexer(_cell_list_indexer)
+        { }
+
+    unsigned int *d_cell_np;                //!< Number of particles per cell (zeroed)
+    unsigned int *d_cell_list;              //!< Cell list
+    uint3 *d_conditions;                    //!< Conditions flags for error reporting
+    mpcd::detail::CellBinner binner;        //!< Binner for the local cells
+    unsigned int cell_np_max;               //!< Maximum number of particles per cell
+    Index2D cell_list_indexer;              //!< 2D indexer for particle position in cell
+    };
+
 //! Kernel driver to stream particles ballistically
 template<class Geometry>
-cudaError_t confined_stream(const stream_args_t& args, const Geometry& geom);
+cudaError_t confined_stream(const stream_args_t& args,
+                            const Geometry& geom,
+                            const cell_bin_args_t& bin_args = cell_bin_args_t());
 
 #ifdef __HIPCC__
 namespace kernel
@@ -64,6 +97,12 @@ namespace kernel
  * \param field Applied external field
  * \param N Number of particles
  * \param geom Confined geometry
+ * \param d_cell_np Number of particles per cell, or NULL to skip binning
+ * \param d_cell_list Cell list
+ * \param d_conditions Conditions flags for error reporting
+ * \param binner Binner for the local cells
+ * \param cell_np_max Maximum number of particles per cell
+ * \param cell_list_indexer 2D indexer for particle position in cell
  *
  * \tparam Geometry type of the confined geometry \a geom
  *
@@ -78,27 +117,35 @@ namespace kernel
  * Particles crossing a periodic global boundary are wrapped back into the simulation box.
  * Particles are appropriately reflected from the boundaries defined by \a geom during the
  * position update step. The particle positions and velocities are updated accordingly.
+ *
+ * If \a d_cell_np is set, the particles are then binned into the cell list as in mpcd::gpu::compute_cell_list.
  */
 template<class Geometry>
-__global__ void confined_stream(Scalar4 *d_pos,
-                                Scalar4 *d_vel,
+__global__ void confined_stream(MPCDReal4 *d_pos,
+                                MPCDReal4 *d_vel,
                                 const Scalar mass,
                                 const mpcd::ExternalField* field,
                                 const BoxDim box,
                                 const Scalar dt,
                                 const unsigned int N,
-                                const Geometry geom)
+                                const Geometry geom,
+                                unsigned int *d_cell_np,
+                                unsigned int *d_cell_list,
+                                uint3 *d_conditions,
+                                const mpcd::detail::CellBinner binner,
+                                const unsigned int cell_np_max,
+                                const Index2D cell_list_indexer)
     {
     // one thread per particle
     unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
     if (idx >= N)
         return;
 
-    const Scalar4 postype = d_pos[idx];
+    const MPCDReal4 postype = d_pos[idx];
     Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
-    const unsigned int type = __scalar_as_int(postype.w);
+    const unsigned int type = __mpcdreal_as_int(postype.w);
 
-    const Scalar4 vel_cell = d_vel[idx];
+    const MPCDReal4 vel_cell = d_vel[idx];
     Scalar3 vel = make_scalar3(vel_cell.x, vel_cell.y, vel_cell.z);
     // estimate next velocity based on current acceleration
     if (field)
@@ -125,8 +172,36 @@ __global__ void confined_stream(Scalar4 *d_pos,
     int3 image = make_int3(0,0,0);
     box.wrap(pos, image);
 
-    d_pos[idx] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(type));
-    d_vel[idx] = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
+    // bin the particle into the cell list
+    unsigned int bin_idx = mpcd::detail::NO_CELL;
+    if (d_cell_np)
+        {
+        const mpcd::detail::bin_status status = binner.bin(pos, bin_idx);
+        if (status == mpcd::detail::bin_status::ok)
+            {
+            const unsigned int offset = atomicInc(&d_cell_np[bin_idx], 0xffffffff);
+            if (offset < cell_np_max)
+                {
+                d_cell_list[cell_list_indexer(offset, bin_idx)] = idx;
+                }
+            else
+                {
+                // overflow
+                atomicMax(&(*d_conditions).x, offset+1);
+                }
+            }
+        else
+            {
+            if (status == mpcd::detail::bin_status::invalid)
+                (*d_conditions).y = idx + 1;
+            else
+                (*d_conditions).z = idx + 1;
+            bin_idx = mpcd::detail::NO_CELL;
+            }
+        }
+
+    d_pos[idx] = make_mpcdreal4(pos.x, pos.y, pos.z, __int_as_mpcdreal(type));
+    d_vel[idx] = make_mpcdreal4(vel.x, vel.y, vel.z, __int_as_mpcdreal(bin_idx));
     }
 
 } // end namespace kernel
@@ -134,13 +209,14 @@ __global__ void confined_stream(Scalar4 *d_pos,
 /*!
  * \param args Common arguments for a streaming kernel
  * \param geom Confined geometry
+ * \param bin_args Arguments to bin the particles into the cell list
  *
  * \tparam Geometry type of the confined geometry \a geom
  *
  * \sa mpcd::gpu::kernel::confined_stream
  */
 template<class Geometry>
-cudaError_t confined_stream(const stream_args_t& args, const Geometry& geom)
+cudaError_t confined_stream(const stream_args_t& args, const Geometry& geom, const cell_bin_args_t& bin_args)
     {
     static unsigned int max_block_size = UINT_MAX;
     if (max_block_size == UINT_MAX)
@@ -152,7 +228,20 @@ cudaError_t confined_stream(const stream_args_t& args, const Geometry& geom)
 
     unsigned int run_block_size = min(args.block_size, max_block_size);
     dim3 grid(args.N / run_block_size + 1);
-    mpcd::gpu::kernel::confined_stream<Geometry><<<grid, run_block_size>>>(args.d_pos, args.d_vel, args.mass, args.field, args.box, args.dt, args.N, geom);
+    mpcd::gpu::kernel::confined_stream<Geometry><<<grid, run_block_size>>>(args.d_pos,
+                                                                           args.d_vel,
+                                                                           args.mass,
+                                                                           args.field,
+                                                                           args.box,
+                                                                           args.dt,
+                                                                           args.N,
+                                                                           geom,
+                                                                           bin_args.d_cell_np,
+                                                                           bin_args.d_cell_list,
+                                                                           bin_args.d_conditions,
+                                                                           bin_args.binner,
+                                                                           bin_args.cell_np_max,
+                                                                           bin_args.cell_list_indexer);
 
     return cudaSuccess;
     }
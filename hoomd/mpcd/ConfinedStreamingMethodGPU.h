@@ -46,12 +46,10 @@ class PYBIND11_EXPORT ConfinedStreamingMethodGPU : public mpcd::ConfinedStreamin
                                    std::shared_ptr<const Geometry> geom)
             : mpcd::ConfinedStreamingMethod<Geometry>(sysdata, cur_timestep, period, phase, geom)
             {
-            m_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_stream", this->m_exec_conf));
+            unsigned int warp_size = this->m_exec_conf->dev_prop.warpSize;
+            m_tuner.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_stream", this->m_exec_conf));
             }
 
-        //! Implementation of the streaming rule
-        virtual void stream(unsigned int timestep);
-
         //! Set autotuner parameters
         /*!
          * \param enable Enable/disable autotuning
@@ -67,16 +65,17 @@ class PYBIND11_EXPORT ConfinedStreamingMethodGPU : public mpcd::ConfinedStreamin
 
     protected:
         std::unique_ptr<Autotuner> m_tuner;
+
+        //! Stream the particles on the GPU, optionally binning them into the cell list
+        virtual void streamParticles(bool bin);
     };
 
 /*!
- * \param timestep Current time to stream
+ * \param bin If true, bin the particles into the cell list after they are streamed
  */
 template<class Geometry>
-void ConfinedStreamingMethodGPU<Geometry>::stream(unsigned int timestep)
+void ConfinedStreamingMethodGPU<Geometry>::streamParticles(bool bin)
     {
-    if (!this->shouldStream(timestep)) return;
-
     // the validation step currently proceeds on the cpu because it is done infrequently.
     // if it becomes a performance concern, it can be ported to the gpu
     if (this->m_validate_geom)
@@ -86,8 +85,8 @@ void ConfinedStreamingMethodGPU<Geometry>::stream(unsigned int timestep)
         }
 
     if (this->m_prof) this->m_prof->push(this->m_exec_conf, "MPCD stream");
-    ArrayHandle<Scalar4> d_pos(this->m_mpcd_pdata->getPositions(), access_location::device, access_mode::readwrite);
-    ArrayHandle<Scalar4> d_vel(this->m_mpcd_pdata->getVelocities(), access_location::device, access_mode::readwrite);
+    ArrayHandle<MPCDReal4> d_pos(this->m_mpcd_pdata->getPositions(), access_location::device, access_mode::readwrite);
+    ArrayHandle<MPCDReal4> d_vel(this->m_mpcd_pdata->getVelocities(), access_location::device, access_mode::readwrite);
     mpcd::gpu::stream_args_t args(d_pos.data,
                                   d_vel.data,
                                   this->m_mpcd_pdata->getMass(),
@@ -97,12 +96,33 @@ void ConfinedStreamingMethodGPU<Geometry>::stream(unsigned int timestep)
                                   this->m_mpcd_pdata->getN(),
                                   m_tuner->getParam());
 
-    m_tuner->begin();
-    mpcd::gpu::confined_stream<Geometry>(args, *(this->m_geom));
-    if (this->m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
-    m_tuner->end();
+    if (bin)
+        {
+        // the cell list counters were zeroed by startFusedBuild
+        std::shared_ptr<mpcd::CellList> cl = this->m_mpcd_sys->getCellList();
+        ArrayHandle<unsigned int> d_cell_np(cl->getCellSizeArray(), access_location::device, access_mode::readwrite);
+        ArrayHandle<unsigned int> d_cell_list(cl->getCellList(), access_location::device, access_mode::overwrite);
+        mpcd::gpu::cell_bin_args_t bin_args(d_cell_np.data,
+                                            d_cell_list.data,
+                                            cl->getConditionFlags().getDeviceFlags(),
+                                            cl->getBinner(),
+                                            cl->getNmax(),
+                                            cl->getCellListIndexer());
+
+        m_tuner->begin();
+        mpcd::gpu::confined_stream<Geometry>(args, *(this->m_geom), bin_args);
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+        m_tuner->end();
+        }
+    else
+        {
+        m_tuner->begin();
+        mpcd::gpu::confined_stream<Geometry>(args, *(this->m_geom));
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+        m_tuner->end();
+        }
 
-    // particles have moved, so the cell cache is no longer valid
+    // particles have moved, so the cell cache is no longer valid until the cell list is finished
     this->m_mpcd_pdata->invalidateCellCache();
     if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
     }
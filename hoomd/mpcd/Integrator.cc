@@ -19,7 +19,7 @@
  * \param deltaT Fundamental integration timestep
  */
 mpcd::Integrator::Integrator(std::shared_ptr<mpcd::SystemData> sysdata, Scalar deltaT)
-    : IntegratorTwoStep(sysdata->getSystemDefinition(), deltaT), m_mpcd_sys(sysdata)
+    : IntegratorTwoStep(sysdata->getSystemDefinition(), deltaT), m_mpcd_sys(sysdata), m_fuse_cell_list(false)
     {
     assert(m_mpcd_sys);
     m_exec_conf->msg->notice(5) << "Constructing MPCD Integrator" << std::endl;
@@ -81,15 +81,6 @@ void mpcd::Integrator::update(unsigned int timestep)
         m_mpcd_comm->communicate(timestep);
     #endif // ENABLE_MPI
 
-    // fill in any virtual particles
-    if (checkCollide(timestep) && !m_fillers.empty())
-        {
-        for (auto filler = m_fillers.begin(); filler != m_fillers.end(); ++filler)
-            {
-            (*filler)->fill(timestep);
-            }
-        }
-
     // optionally sort
     if (m_sorter)
         m_sorter->update(timestep);
@@ -119,7 +110,10 @@ void mpcd::Integrator::update(unsigned int timestep)
     // execute the MPCD streaming step now that MD particles are communicated onto their final domains
     if (m_stream)
         {
-        m_stream->stream(timestep);
+        if (m_fuse_cell_list)
+            streamAndBin(timestep);
+        else
+            m_stream->stream(timestep);
         }
 
     // compute the net force on the MD particles
@@ -137,6 +131,41 @@ void mpcd::Integrator::update(unsigned int timestep)
     if (m_prof) m_prof->pop();
     }
 
+/*!
+ * \param timestep Current time step of the simulation
+ *
+ * The streaming step moves the MPCD particles to their positions for the next \a m_period steps. If a collision
+ * occurs at one of these steps, the particles are binned into the cell list for that collision while they
+ * are streamed, so that the cell list does not need to read the particles again. The grid shift for the collision is
+ * deterministic, so it can be drawn now. The particles migrate between ranks before each collision,
+ * so the streaming step is not fused when there is an MPCD communicator.
+ */
+void mpcd::Integrator::streamAndBin(unsigned int timestep)
+    {
+    bool fuse = (m_collide && m_stream->peekStream(timestep));
+    #ifdef ENABLE_MPI
+    if (m_mpcd_comm)
+        fuse = false;
+    #endif // ENABLE_MPI
+
+    if (fuse)
+        {
+        // find the collision the streamed positions will be used for
+        const unsigned int period = m_stream->getPeriod();
+        for (unsigned int t = timestep+1; t <= timestep+period; ++t)
+            {
+            if (m_collide->peekCollide(t))
+                {
+                m_collide->drawGridShift(t);
+                m_stream->streamAndBin(timestep, t);
+                return;
+                }
+            }
+        }
+
+    m_stream->stream(timestep);
+    }
+
 /*!
  * \param deltaT new deltaT to set
  * \post \a deltaT is also set on all contained integration methods
@@ -203,6 +232,10 @@ void mpcd::Integrator::addFiller(std::shared_ptr<mpcd::VirtualParticleFiller> fi
         }
 
     m_fillers.push_back(filler);
+
+    // the virtual particles are added to the cells by the collision method
+    if (m_collide)
+        m_collide->setFillers(m_fillers);
     }
 
 /*!
@@ -221,6 +254,8 @@ void mpcd::detail::export_Integrator(pybind11::module& m)
         .def("removeSorter", &mpcd::Integrator::removeSorter)
         .def("addFiller", &mpcd::Integrator::addFiller)
         .def("removeAllFillers", &mpcd::Integrator::removeAllFillers)
+        .def("setFuseCellList", &mpcd::Integrator::setFuseCellList)
+        .def("getFuseCellList", &mpcd::Integrator::getFuseCellList)
         #ifdef ENABLE_MPI
         .def("setMPCDCommunicator", &mpcd::Integrator::setMPCDCommunicator)
         #endif // ENABLE_MPI
@@ -82,6 +82,7 @@ class PYBIND11_EXPORT Integrator : public ::IntegratorTwoStep
         void setCollisionMethod(std::shared_ptr<mpcd::CollisionMethod> collide)
             {
             m_collide = collide;
+            m_collide->setFillers(m_fillers);
             }
 
         //! Remove the collision method
@@ -90,6 +91,8 @@ class PYBIND11_EXPORT Integrator : public ::IntegratorTwoStep
          */
         void removeCollisionMethod()
             {
+            if (m_collide)
+                m_collide->setFillers(std::vector<std::shared_ptr<mpcd::VirtualParticleFiller>>());
             m_collide.reset();
             }
 
@@ -142,6 +145,21 @@ class PYBIND11_EXPORT Integrator : public ::IntegratorTwoStep
             m_sorter.reset();
             }
 
+        //! Set whether the MPCD particles are binned into the cell list while they are streamed
+        /*!
+         * \param fuse If true, the cell list for the next collision is built by the streaming step when possible
+         */
+        void setFuseCellList(bool fuse)
+            {
+            m_fuse_cell_list = fuse;
+            }
+
+        //! Get whether the MPCD particles are binned into the cell list while they are streamed
+        bool getFuseCellList() const
+            {
+            return m_fuse_cell_list;
+            }
+
         //! Add a virtual particle filling method
         void addFiller(std::shared_ptr<mpcd::VirtualParticleFiller> filler);
 
@@ -149,6 +167,8 @@ class PYBIND11_EXPORT Integrator : public ::IntegratorTwoStep
         void removeAllFillers()
             {
             m_fillers.clear();
+            if (m_collide)
+                m_collide->setFillers(m_fillers);
             }
 
     protected:
@@ -162,7 +182,12 @@ class PYBIND11_EXPORT Integrator : public ::IntegratorTwoStep
         #endif // ENABLE_MPI
 
         std::vector<std::shared_ptr<mpcd::VirtualParticleFiller>> m_fillers; //!< MPCD virtual particle fillers
+        bool m_fuse_cell_list;  //!< If true, bin the MPCD particles into the cell list while they are streamed
+
     private:
+        //! Stream the MPCD particles, binning them for the next collision if possible
+        void streamAndBin(unsigned int timestep);
+
         //! Check if a collision will occur at the current timestep
         bool checkCollide(unsigned int timestep)
             {
@@ -44,8 +44,8 @@ namespace kernel
  * a list of particles to keep and remove.
  */
 __global__ void remove_particles(mpcd::detail::pdata_element *d_out,
-                                 Scalar4 *d_pos,
-                                 Scalar4 *d_vel,
+                                 MPCDReal4 *d_pos,
+                                 MPCDReal4 *d_vel,
                                  unsigned int *d_tag,
                                  unsigned int *d_comm_flags,
                                  const unsigned int *d_remove_ids,
@@ -186,8 +186,8 @@ cudaError_t mpcd::gpu::partition_particles(void *d_tmp,
  * \sa mpcd::gpu::kernel::remove_particles
  */
 cudaError_t mpcd::gpu::remove_particles(mpcd::detail::pdata_element *d_out,
-                                        Scalar4 *d_pos,
-                                        Scalar4 *d_vel,
+                                        MPCDReal4 *d_pos,
+                                        MPCDReal4 *d_vel,
                                         unsigned int *d_tag,
                                         unsigned int *d_comm_flags,
                                         unsigned int *d_remove_ids,
@@ -239,8 +239,8 @@ namespace kernel
  */
 __global__ void add_particles(unsigned int old_nparticles,
                               unsigned int num_add_ptls,
-                              Scalar4 *d_pos,
-                              Scalar4 *d_vel,
+                              MPCDReal4 *d_pos,
+                              MPCDReal4 *d_vel,
                               unsigned int *d_tag,
                               unsigned int *d_comm_flags,
                               const mpcd::detail::pdata_element *d_in,
@@ -278,8 +278,8 @@ __global__ void add_particles(unsigned int old_nparticles,
  */
 void mpcd::gpu::add_particles(unsigned int old_nparticles,
                               unsigned int num_add_ptls,
-                              Scalar4 *d_pos,
-                              Scalar4 *d_vel,
+                              MPCDReal4 *d_pos,
+                              MPCDReal4 *d_vel,
                               unsigned int *d_tag,
                               unsigned int *d_comm_flags,
                               const mpcd::detail::pdata_element *d_in,
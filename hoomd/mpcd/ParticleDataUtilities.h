@@ -19,6 +19,75 @@
  */
 
 #include "hoomd/HOOMDMath.h"
+
+#if defined(ENABLE_MPCD_MIXED_PRECISION) && !defined(SINGLE_PRECISION)
+//! Floating point type used to store the MPCD particle positions and velocities
+typedef float MPCDReal;
+//! Vector type used to store the MPCD particle positions and velocities
+typedef float4 MPCDReal4;
+#else
+typedef Scalar MPCDReal;
+typedef Scalar4 MPCDReal4;
+#endif
+
+// need to declare these functions with __host__ __device__ qualifiers when building in nvcc
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+//! Make an MPCDReal4
+/*!
+ * The MPCD particle data is only stored in MPCDReal. All arithmetic on it should be done in Scalar,
+ * so values are converted when they are loaded and narrowed again when they are stored.
+ */
+HOSTDEVICE inline MPCDReal4 make_mpcdreal4(MPCDReal x, MPCDReal y, MPCDReal z, MPCDReal w)
+    {
+    MPCDReal4 retval;
+    retval.x = x;
+    retval.y = y;
+    retval.z = z;
+    retval.w = w;
+    return retval;
+    }
+
+//! Stuff an integer inside an MPCDReal
+/*!
+ * Use this instead of __int_as_scalar() for the type and cell index of the MPCD particles,
+ * which are not Scalar when ENABLE_MPCD_MIXED_PRECISION is set.
+ */
+HOSTDEVICE inline MPCDReal __int_as_mpcdreal(int a)
+    {
+    union
+        {
+        int a; MPCDReal b;
+        } u;
+
+    // make sure it is not uninitialized
+    u.b = MPCDReal(0.0);
+    u.a = a;
+
+    return u.b;
+    }
+
+//! Extract an integer from an MPCDReal stuffed by __int_as_mpcdreal()
+HOSTDEVICE inline int __mpcdreal_as_int(MPCDReal b)
+    {
+    union
+        {
+        int a; MPCDReal b;
+        } u;
+
+    u.b = b;
+
+    return u.a;
+    }
+
+// undefine HOSTDEVICE so we don't interfere with other headers
+#undef HOSTDEVICE
+
 namespace mpcd
 {
 namespace detail
@@ -36,8 +105,8 @@ const unsigned int NO_CELL = 0xffffffff;
  */
 struct pdata_element
     {
-    Scalar4 pos;            //!< Position
-    Scalar4 vel;            //!< Velocity
+    MPCDReal4 pos;          //!< Position
+    MPCDReal4 vel;          //!< Velocity
     unsigned int tag;       //!< Global tag
     unsigned int comm_flag; //!< Communication flag
     };
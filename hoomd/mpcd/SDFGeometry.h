@@ -0,0 +1,337 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: mphoward
+
+/*!
+ * \file mpcd/SDFGeometry.h
+ * \brief Definition of the MPCD geometry defined by a signed distance field
+ */
+
+#ifndef MPCD_SDF_GEOMETRY_H_
+#define MPCD_SDF_GEOMETRY_H_
+
+#include "BoundaryCondition.h"
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/BoxDim.h"
+#include "hoomd/Index1D.h"
+
+#ifndef __HIPCC__
+#include "hoomd/ExecutionConfiguration.h"
+#include "hoomd/ManagedArray.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#endif // __HIPCC__
+
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__ inline
+#else
+#define HOSTDEVICE inline __attribute__((always_inline))
+#endif // __HIPCC__
+
+namespace mpcd
+{
+namespace detail
+{
+
+//! Geometry defined by a signed distance field
+/*!
+ * The surface of the geometry is the zero level set of a signed distance field \f$\phi\f$ that is sampled
+ * on a regular grid spanning the periodic simulation box. The fluid is where \f$\phi \le 0\f$, and the
+ * walls are where \f$\phi > 0\f$. Grid point (i,j,k) lies at lo + (i,j,k)*h, where h = L/n is the grid
+ * spacing, and the field is trilinearly interpolated between the grid points. This makes it possible to
+ * confine the fluid in arbitrary (e.g., porous) geometries without writing a new geometry class.
+ *
+ * A collision is detected when a particle ends a streaming step inside a wall. The time the particle
+ * crossed the surface is found by a false position (Illinois) search along the straight path of the step,
+ * with a fixed number of iterations so that all threads of a warp do the same work on the GPU. The particle
+ * is placed on the fluid side of the bracket, and its velocity is reflected using the normal given by the
+ * gradient of the interpolated field. The walls are stationary.
+ *
+ * The grid is allocated in managed memory, so the same pointer is valid on the host and the device and the
+ * geometry can be copied to the GPU kernels by value. Construct the geometry with create(), which ties the
+ * lifetime of the grid to the returned pointer. Copies of the geometry do not own the grid.
+ */
+class __attribute__((visibility("default"))) SDFGeometry
+    {
+    public:
+        //! Constructor
+        /*!
+         * \param sdf Signed distance at the grid points, with x the fastest index
+         * \param indexer Indexer of the grid points
+         * \param box Global simulation box spanned by the grid
+         * \param bc Boundary condition at the wall (slip or no-slip)
+         *
+         * The geometry does not take ownership of \a sdf, which must be accessible on the host and device.
+         */
+        HOSTDEVICE SDFGeometry(const Scalar *sdf, const Index3D& indexer, const BoxDim& box, boundary bc)
+            : m_sdf(sdf), m_indexer(indexer), m_lo(box.getLo()), m_L(box.getL()),
+              m_inv_h(make_scalar3(Scalar(indexer.getW())/box.getL().x,
+                                   Scalar(indexer.getH())/box.getL().y,
+                                   Scalar(indexer.getD())/box.getL().z)),
+              m_bc(bc)
+            { }
+
+        //! Detect collision between the particle and the boundary
+        /*!
+         * \param pos Proposed particle position
+         * \param vel Proposed particle velocity
+         * \param dt Integration time remaining (inout).
+         *
+         * \returns True if a collision occurred, and false otherwise
+         *
+         * \post The particle position \a pos is moved to the point of reflection, the velocity \a vel is updated
+         *       according to the appropriate bounce back rule, and the integration time \a dt is decreased to the
+         *       amount of time remaining.
+         *
+         * The passed value of \a dt must be the time taken to arrive at pos. The returned value of \a dt will be
+         * less than this time.
+         */
+        HOSTDEVICE bool detectCollision(Scalar3& pos, Scalar3& vel, Scalar& dt) const
+            {
+            Scalar phi_hi = evaluate(pos);
+            if (phi_hi <= Scalar(0))
+                {
+                dt = Scalar(0);
+                return false;
+                }
+
+            // bracket the crossing by the time since the start of the step, t_lo in the fluid and t_hi in the wall
+            const Scalar3 start = pos - dt*vel;
+            Scalar t_lo(0), t_hi(dt);
+            Scalar phi_lo = evaluate(start);
+            if (phi_lo <= Scalar(0))
+                {
+                // false position search, halving the value at an end that is kept twice in a row (Illinois)
+                int side = 0;
+                for (unsigned int i=0; i < search_iterations; ++i)
+                    {
+                    const Scalar t = t_lo + (t_hi - t_lo) * phi_lo / (phi_lo - phi_hi);
+                    const Scalar phi = evaluate(start + t*vel);
+                    if (phi > Scalar(0))
+                        {
+                        t_hi = t;
+                        phi_hi = phi;
+                        if (side == 1) phi_lo *= Scalar(0.5);
+                        side = 1;
+                        }
+                    else
+                        {
+                        t_lo = t;
+                        phi_lo = phi;
+                        if (side == -1) phi_hi *= Scalar(0.5);
+                        side = -1;
+                        }
+                    }
+                }
+
+            // move the particle back to the fluid side of the surface
+            pos = start + t_lo*vel;
+            dt -= t_lo;
+
+            // reverse the particle if the surface normal is undefined or the particle made no progress,
+            // so that it returns along the path it came from
+            Scalar3 n = gradient(pos);
+            const Scalar nsq = dot(n,n);
+            if (m_bc == boundary::no_slip || nsq == Scalar(0) || t_lo == Scalar(0))
+                {
+                vel = -vel;
+                }
+            else
+                {
+                // slip reflects only the normal component
+                vel -= (Scalar(2) * dot(n,vel) / nsq) * n;
+                }
+
+            return true;
+            }
+
+        //! Check if a particle is out of bounds
+        /*!
+         * \param pos Current particle position
+         * \returns True if particle is out of bounds, and false otherwise
+         */
+        HOSTDEVICE bool isOutside(const Scalar3& pos) const
+            {
+            return (evaluate(pos) > Scalar(0));
+            }
+
+        //! Validate that the simulation box is the one spanned by the grid
+        /*!
+         * \param box Global simulation box
+         * \param cell_size Size of MPCD cell
+         *
+         * The walls are periodic with the grid, so no padding is needed, but the box must not change.
+         */
+        HOSTDEVICE bool validateBox(const BoxDim& box, Scalar cell_size) const
+            {
+            const Scalar3 lo = box.getLo();
+            const Scalar3 L = box.getL();
+            const Scalar tol = Scalar(1e-6);
+
+            return (fabs(L.x-m_L.x) <= tol*m_L.x && fabs(L.y-m_L.y) <= tol*m_L.y && fabs(L.z-m_L.z) <= tol*m_L.z &&
+                    fabs(lo.x-m_lo.x) <= tol*m_L.x && fabs(lo.y-m_lo.y) <= tol*m_L.y && fabs(lo.z-m_lo.z) <= tol*m_L.z);
+            }
+
+        //! Interpolate the signed distance
+        /*!
+         * \param pos Position to evaluate at, which may lie outside the periodic box
+         * \returns Trilinear interpolation of the signed distance at \a pos
+         */
+        HOSTDEVICE Scalar evaluate(const Scalar3& pos) const
+            {
+            uint3 i0, i1;
+            Scalar3 w;
+            locate(pos, i0, i1, w);
+
+            const Scalar c00 = (1-w.x)*m_sdf[m_indexer(i0.x,i0.y,i0.z)] + w.x*m_sdf[m_indexer(i1.x,i0.y,i0.z)];
+            const Scalar c10 = (1-w.x)*m_sdf[m_indexer(i0.x,i1.y,i0.z)] + w.x*m_sdf[m_indexer(i1.x,i1.y,i0.z)];
+            const Scalar c01 = (1-w.x)*m_sdf[m_indexer(i0.x,i0.y,i1.z)] + w.x*m_sdf[m_indexer(i1.x,i0.y,i1.z)];
+            const Scalar c11 = (1-w.x)*m_sdf[m_indexer(i0.x,i1.y,i1.z)] + w.x*m_sdf[m_indexer(i1.x,i1.y,i1.z)];
+
+            return (1-w.z)*((1-w.y)*c00 + w.y*c10) + w.z*((1-w.y)*c01 + w.y*c11);
+            }
+
+        //! Gradient of the interpolated signed distance
+        /*!
+         * \param pos Position to evaluate at, which may lie outside the periodic box
+         * \returns Gradient of the trilinear interpolant at \a pos, pointing into the walls
+         */
+        HOSTDEVICE Scalar3 gradient(const Scalar3& pos) const
+            {
+            uint3 i0, i1;
+            Scalar3 w;
+            locate(pos, i0, i1, w);
+
+            const Scalar f000 = m_sdf[m_indexer(i0.x,i0.y,i0.z)];
+            const Scalar f100 = m_sdf[m_indexer(i1.x,i0.y,i0.z)];
+            const Scalar f010 = m_sdf[m_indexer(i0.x,i1.y,i0.z)];
+            const Scalar f110 = m_sdf[m_indexer(i1.x,i1.y,i0.z)];
+            const Scalar f001 = m_sdf[m_indexer(i0.x,i0.y,i1.z)];
+            const Scalar f101 = m_sdf[m_indexer(i1.x,i0.y,i1.z)];
+            const Scalar f011 = m_sdf[m_indexer(i0.x,i1.y,i1.z)];
+            const Scalar f111 = m_sdf[m_indexer(i1.x,i1.y,i1.z)];
+
+            Scalar3 grad;
+            grad.x = (1-w.y)*(1-w.z)*(f100-f000) + w.y*(1-w.z)*(f110-f010)
+                    + (1-w.y)*w.z*(f101-f001) + w.y*w.z*(f111-f011);
+            grad.y = (1-w.x)*(1-w.z)*(f010-f000) + w.x*(1-w.z)*(f110-f100)
+                    + (1-w.x)*w.z*(f011-f001) + w.x*w.z*(f111-f101);
+            grad.z = (1-w.x)*(1-w.y)*(f001-f000) + w.x*(1-w.y)*(f101-f100)
+                    + (1-w.x)*w.y*(f011-f010) + w.x*w.y*(f111-f110);
+
+            return make_scalar3(grad.x*m_inv_h.x, grad.y*m_inv_h.y, grad.z*m_inv_h.z);
+            }
+
+        //! Get the grid indexer
+        /*!
+         * \returns Indexer of the grid points
+         */
+        HOSTDEVICE Index3D getIndexer() const
+            {
+            return m_indexer;
+            }
+
+        //! Get the wall boundary condition
+        /*!
+         * \returns Boundary condition at wall
+         */
+        HOSTDEVICE boundary getBoundaryCondition() const
+            {
+            return m_bc;
+            }
+
+        #ifndef __HIPCC__
+        //! Get the unique name of this geometry
+        static std::string getName()
+            {
+            return std::string("SDF");
+            }
+
+        //! Create a geometry that owns a copy of the signed distance field
+        /*!
+         * \param exec_conf Execution configuration
+         * \param sdf Signed distance at the grid points, with x the fastest index
+         * \param nx Number of grid points in x
+         * \param ny Number of grid points in y
+         * \param nz Number of grid points in z
+         * \param box Global simulation box spanned by the grid
+         * \param bc Boundary condition at the wall (slip or no-slip)
+         *
+         * \returns A geometry that frees the grid when the last reference to it is released
+         */
+        static std::shared_ptr<SDFGeometry> create(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                                                   const std::vector<Scalar>& sdf,
+                                                   unsigned int nx,
+                                                   unsigned int ny,
+                                                   unsigned int nz,
+                                                   const BoxDim& box,
+                                                   boundary bc)
+            {
+            const Index3D indexer(nx, ny, nz);
+            if (nx < 2 || ny < 2 || nz < 2 || sdf.size() != indexer.getNumElements())
+                {
+                exec_conf->msg->error() << "mpcd: signed distance field must have " << nx << "x" << ny << "x" << nz
+                                        << " points, with at least 2 in each direction" << std::endl;
+                throw std::runtime_error("Invalid signed distance field grid");
+                }
+
+            auto grid = std::make_shared< ManagedArray<Scalar> >(indexer.getNumElements(), exec_conf->isCUDAEnabled());
+            std::copy(sdf.begin(), sdf.end(), grid->get());
+            #ifdef ENABLE_HIP
+            grid->set_memory_hint();
+            #endif
+
+            return std::shared_ptr<SDFGeometry>(new SDFGeometry(grid->get(), indexer, box, bc),
+                                                [grid](SDFGeometry *geom) { delete geom; });
+            }
+        #endif // __HIPCC__
+
+    private:
+        const Scalar *const m_sdf;  //!< Signed distance at grid points
+        const Index3D m_indexer;    //!< Indexer of the grid points
+        const Scalar3 m_lo;         //!< Lower corner of the box
+        const Scalar3 m_L;          //!< Box lengths
+        const Scalar3 m_inv_h;      //!< Inverse grid spacing
+        const boundary m_bc;        //!< Boundary condition
+
+        //! Number of iterations of the search for the surface
+        static const unsigned int search_iterations = 8;
+
+        //! Find the grid cell containing a position
+        /*!
+         * \param pos Position, which may lie outside the periodic box
+         * \param i0 Lower grid point of the cell (output)
+         * \param i1 Upper grid point of the cell, wrapped through the periodic boundary (output)
+         * \param w Fractional position within the cell (output)
+         */
+        HOSTDEVICE void locate(const Scalar3& pos, uint3& i0, uint3& i1, Scalar3& w) const
+            {
+            const Scalar3 f = make_scalar3((pos.x-m_lo.x)*m_inv_h.x,
+                                           (pos.y-m_lo.y)*m_inv_h.y,
+                                           (pos.z-m_lo.z)*m_inv_h.z);
+            const Scalar3 fl = make_scalar3(floor(f.x), floor(f.y), floor(f.z));
+            w = f - fl;
+
+            const int3 n = make_int3(m_indexer.getW(), m_indexer.getH(), m_indexer.getD());
+            int3 i = make_int3(((int)fl.x) % n.x, ((int)fl.y) % n.y, ((int)fl.z) % n.z);
+            if (i.x < 0) i.x += n.x;
+            if (i.y < 0) i.y += n.y;
+            if (i.z < 0) i.z += n.z;
+
+            i0 = make_uint3(i.x, i.y, i.z);
+            i1 = make_uint3((i.x+1 == n.x) ? 0 : i.x+1, (i.y+1 == n.y) ? 0 : i.y+1, (i.z+1 == n.z) ? 0 : i.z+1);
+            }
+    };
+
+} // end namespace detail
+} // end namespace mpcd
+
+#undef HOSTDEVICE
+
+#endif // MPCD_SDF_GEOMETRY_H_
@@ -37,6 +37,15 @@ class PYBIND11_EXPORT SRDCollisionMethod : public mpcd::CollisionMethod
         //! Destructor
         virtual ~SRDCollisionMethod();
 
+        //! Set the virtual particle fillers of the boundaries
+        /*!
+         * \param fillers Virtual particle fillers
+         */
+        virtual void setFillers(const std::vector<std::shared_ptr<mpcd::VirtualParticleFiller>>& fillers)
+            {
+            m_thermo->setFillers(fillers);
+            }
+
         //! Get the MPCD rotation angle
         double getRotationAngle() const
             {
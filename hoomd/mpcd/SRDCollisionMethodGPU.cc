@@ -19,8 +19,115 @@ mpcd::SRDCollisionMethodGPU::SRDCollisionMethodGPU(std::shared_ptr<mpcd::SystemD
                                              std::shared_ptr<mpcd::CellThermoCompute> thermo)
     : mpcd::SRDCollisionMethod(sysdata,cur_timestep,period,phase,seed,thermo)
     {
-    m_tuner_rotvec.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_srd_vec", m_exec_conf));
-    m_tuner_rotate.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_srd_rotate", m_exec_conf));
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_tuner_rotvec.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_srd_vec", m_exec_conf));
+    m_tuner_rotate.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_srd_rotate", m_exec_conf));
+
+    // the fused kernel is tuned over block size and threads per cell, like the cell thermo kernels
+    std::vector<unsigned int> valid_params;
+    for (unsigned int block_size = 32; block_size <= 1024; block_size += 32)
+        {
+        for (auto s : Autotuner::getTppListPow2(m_exec_conf->dev_prop.warpSize))
+            {
+            valid_params.push_back(block_size * 10000 + s);
+            }
+        }
+    m_tuner_fused.reset(new Autotuner(valid_params, 5, 100000, "mpcd_srd_fused", m_exec_conf));
+    }
+
+/*!
+ * \param timestep Current timestep
+ *
+ * When the cell properties have not been computed yet at \a timestep and do not need to be communicated,
+ * the cell thermo, rotation vectors, and rotation are all done by one kernel that sweeps the cell list once.
+ * Otherwise, the separate kernels of mpcd::SRDCollisionMethod::rule are used.
+ */
+void mpcd::SRDCollisionMethodGPU::rule(unsigned int timestep)
+    {
+    if (!m_thermo->canFuseCompute(timestep))
+        {
+        mpcd::SRDCollisionMethod::rule(timestep);
+        return;
+        }
+
+    m_thermo->beginFusedCompute(timestep);
+
+    if (m_prof) m_prof->push(m_exec_conf, "MPCD collide");
+    // resize the rotation vectors and rescale factors
+    m_rotvec.resize(m_cl->getNCells());
+    if (m_T)
+        {
+        m_factors.resize(m_cl->getNCells());
+        }
+
+    fusedCollide(timestep);
+    m_cl->unstageEmbeddedParticles();
+    if (m_prof) m_prof->pop(m_exec_conf);
+
+    m_thermo->finishFusedCompute(timestep);
+    }
+
+void mpcd::SRDCollisionMethodGPU::fusedCollide(unsigned int timestep)
+    {
+    // the embedded particles are collided in their staging buffer
+    if (m_cl->getEmbeddedGroup())
+        m_cl->stageEmbeddedParticles(timestep);
+
+    ArrayHandle<MPCDReal4> d_vel(m_mpcd_pdata->getVelocities(), access_location::device, access_mode::readwrite);
+    ArrayHandle<double4> d_cell_vel(m_thermo->getCellVelocities(), access_location::device, access_mode::overwrite);
+    ArrayHandle<double3> d_cell_energy(m_thermo->getCellEnergies(), access_location::device, access_mode::overwrite);
+    ArrayHandle<double3> d_rotvec(m_rotvec, access_location::device, access_mode::overwrite);
+
+    ArrayHandle<unsigned int> d_cell_np(m_cl->getCellSizeArray(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_cell_list(m_cl->getCellList(), access_location::device, access_mode::read);
+
+    // load scale factors if required
+    std::unique_ptr< ArrayHandle<double> > d_factors;
+    if (m_T)
+        {
+        d_factors.reset(new ArrayHandle<double>(m_factors, access_location::device, access_mode::overwrite));
+        }
+
+    // the cell list refers to embedded particles through its own group
+    std::unique_ptr< ArrayHandle<Scalar4> > d_embed_vel;
+    if (m_cl->getEmbeddedGroup())
+        {
+        d_embed_vel.reset(new ArrayHandle<Scalar4>(m_cl->getEmbeddedVelocities(),
+                                                   access_location::device,
+                                                   access_mode::readwrite));
+        }
+
+    mpcd::detail::srd_fused_args_t args(d_vel.data,
+                                        (d_embed_vel) ? d_embed_vel->data : NULL,
+                                        d_cell_vel.data,
+                                        d_cell_energy.data,
+                                        d_rotvec.data,
+                                        (m_T) ? d_factors->data : NULL,
+                                        d_cell_np.data,
+                                        d_cell_list.data,
+                                        m_cl->getCellListIndexer(),
+                                        m_cl->getCellIndexer(),
+                                        m_cl->getOriginIndex(),
+                                        m_cl->getGlobalDim(),
+                                        m_cl->getGlobalCellIndexer(),
+                                        m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual(),
+                                        m_mpcd_pdata->getMass(),
+                                        m_thermo->getFlags()[mpcd::detail::thermo_options::energy]);
+
+    m_tuner_fused->begin();
+    const unsigned int param = m_tuner_fused->getParam();
+    const unsigned int block_size = param / 10000;
+    const unsigned int tpp = param % 10000;
+    mpcd::gpu::srd_fused_collide(args,
+                                 timestep,
+                                 m_seed,
+                                 (m_T) ? (*m_T)(timestep) : 1.0,
+                                 m_angle,
+                                 m_sysdef->getNDimensions(),
+                                 block_size,
+                                 tpp);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+    m_tuner_fused->end();
     }
 
 void mpcd::SRDCollisionMethodGPU::drawRotationVectors(unsigned int timestep)
@@ -71,7 +178,7 @@ void mpcd::SRDCollisionMethodGPU::drawRotationVectors(unsigned int timestep)
 void mpcd::SRDCollisionMethodGPU::rotate(unsigned int timestep)
     {
     // acquire MPCD particle data
-    ArrayHandle<Scalar4> d_vel(m_mpcd_pdata->getVelocities(), access_location::device, access_mode::readwrite);
+    ArrayHandle<MPCDReal4> d_vel(m_mpcd_pdata->getVelocities(), access_location::device, access_mode::readwrite);
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
     unsigned int N_tot = N_mpcd;
 
@@ -88,32 +195,38 @@ void mpcd::SRDCollisionMethodGPU::rotate(unsigned int timestep)
 
     if (m_embed_group)
         {
-        ArrayHandle<unsigned int> d_embed_group(m_embed_group->getIndexArray(), access_location::device, access_mode::read);
-        ArrayHandle<Scalar4> d_vel_embed(m_pdata->getVelocities(), access_location::device, access_mode::readwrite);
-        ArrayHandle<unsigned int> d_embed_cell_ids(m_cl->getEmbeddedGroupCellIds(), access_location::device, access_mode::read);
+        // the embedded particles are rotated in their staging buffer, and written back once afterwards
+        m_cl->stageEmbeddedParticles(timestep);
+            {
+            ArrayHandle<Scalar4> d_vel_embed(m_cl->getEmbeddedVelocities(),
+                                             access_location::device,
+                                             access_mode::readwrite);
+            ArrayHandle<unsigned int> d_embed_cell_ids(m_cl->getEmbeddedGroupCellIds(),
+                                                       access_location::device,
+                                                       access_mode::read);
 
-        N_tot += m_embed_group->getNumMembers();
+            N_tot += m_embed_group->getNumMembers();
 
-        m_tuner_rotate->begin();
-        mpcd::gpu::srd_rotate(d_vel.data,
-                              d_vel_embed.data,
-                              d_embed_group.data,
-                              d_embed_cell_ids.data,
-                              d_cell_vel.data,
-                              d_rotvec.data,
-                              m_angle,
-                              (m_T) ? d_factors->data : NULL,
-                              N_mpcd,
-                              N_tot,
-                              m_tuner_rotate->getParam());
-        if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
-        m_tuner_rotate->end();
+            m_tuner_rotate->begin();
+            mpcd::gpu::srd_rotate(d_vel.data,
+                                  d_vel_embed.data,
+                                  d_embed_cell_ids.data,
+                                  d_cell_vel.data,
+                                  d_rotvec.data,
+                                  m_angle,
+                                  (m_T) ? d_factors->data : NULL,
+                                  N_mpcd,
+                                  N_tot,
+                                  m_tuner_rotate->getParam());
+            if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+            m_tuner_rotate->end();
+            }
+        m_cl->unstageEmbeddedParticles();
         }
     else
         {
         m_tuner_rotate->begin();
         mpcd::gpu::srd_rotate(d_vel.data,
-                              NULL,
                               NULL,
                               NULL,
                               d_cell_vel.data,
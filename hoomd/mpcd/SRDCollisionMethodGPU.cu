@@ -11,6 +11,7 @@
 #include "SRDCollisionMethodGPU.cuh"
 #include "hoomd/RandomNumbers.h"
 #include "hoomd/RNGIdentifiers.h"
+#include "hoomd/WarpTools.cuh"
 
 namespace mpcd
 {
@@ -87,9 +88,8 @@ __global__ void srd_draw_vectors(double3 *d_rotvec,
         d_factors[idx] = factor;
         }
     }
-__global__ void srd_rotate(Scalar4 *d_vel,
+__global__ void srd_rotate(MPCDReal4 *d_vel,
                            Scalar4 *d_vel_embed,
-                           const unsigned int *d_embed_group,
                            const unsigned int *d_embed_cell_ids,
                            const double4 *d_cell_vel,
                            const double3 *d_rotvec,
@@ -109,18 +109,19 @@ __global__ void srd_rotate(Scalar4 *d_vel,
     double3 vel;
     unsigned int cell;
     // these properties are needed for the embedded particles only
-    unsigned int idx(0); double mass(0);
+    unsigned int embed_p(0); double mass(0);
     if (tid < N_mpcd)
         {
-        const Scalar4 vel_cell = d_vel[tid];
+        const MPCDReal4 vel_cell = d_vel[tid];
         vel = make_double3(vel_cell.x, vel_cell.y, vel_cell.z);
-        cell = __scalar_as_int(vel_cell.w);
+        cell = __mpcdreal_as_int(vel_cell.w);
         }
     else
         {
-        idx = d_embed_group[tid - N_mpcd];
+        // the embedded particles are staged in the order of the group members
+        embed_p = tid - N_mpcd;
 
-        const Scalar4 vel_mass = d_vel_embed[idx];
+        const Scalar4 vel_mass = d_vel_embed[embed_p];
         vel = make_double3(vel_mass.x, vel_mass.y, vel_mass.z);
         mass = vel_mass.w;
         cell = d_embed_cell_ids[tid - N_mpcd];
@@ -163,11 +164,218 @@ __global__ void srd_rotate(Scalar4 *d_vel,
     // set the new velocity
     if (tid < N_mpcd)
         {
-        d_vel[tid] = make_scalar4(new_vel.x, new_vel.y, new_vel.z, __int_as_scalar(cell));
+        d_vel[tid] = make_mpcdreal4(new_vel.x, new_vel.y, new_vel.z, __int_as_mpcdreal(cell));
         }
     else
         {
-        d_vel_embed[idx] = make_scalar4(new_vel.x, new_vel.y, new_vel.z, mass);
+        d_vel_embed[embed_p] = make_scalar4(new_vel.x, new_vel.y, new_vel.z, mass);
+        }
+    }
+//! Computes the cell properties and applies the SRD collision in one pass over the cell list
+/*!
+ * \param args Common arguments to the fused kernel
+ * \param timestep Current timestep
+ * \param seed Seed for the collision
+ * \param T_set Thermostat temperature
+ * \param cos_a Cosine of the rotation angle
+ * \param one_minus_cos_a One minus the cosine of the rotation angle
+ * \param sin_a Sine of the rotation angle
+ * \param n_dimensions System dimensionality
+ * \param Ncell Number of cells
+ *
+ * \tparam need_energy If true, compute the cell-level energy properties
+ * \tparam use_thermostat If true, draw and apply the thermostat scale factors
+ * \tparam tpp Number of threads to use per cell
+ *
+ * \b Implementation details:
+ * Using \a tpp threads per cell, the cell momentum, mass, and kinetic energy are accumulated
+ * exactly as in mpcd::gpu::kernel::inner_cell_thermo, but the sums are made available to every
+ * thread in the cell with a shuffle-based scan. The first thread writes the cell properties so that
+ * they remain available from the mpcd::CellThermoCompute. Every thread then draws the same rotation
+ * vector and scale factor as mpcd::gpu::kernel::srd_draw_vectors (the generator is seeded by the
+ * global cell index, so the draws are identical) and rotates the velocities of the particles it
+ * summed. The cell properties and rotation vectors are never read back from global memory.
+ */
+template<bool need_energy, bool use_thermostat, unsigned int tpp>
+__global__ void srd_fused_collide(const mpcd::detail::srd_fused_args_t args,
+                                  const unsigned int timestep,
+                                  const unsigned int seed,
+                                  const Scalar T_set,
+                                  const double cos_a,
+                                  const double one_minus_cos_a,
+                                  const double sin_a,
+                                  const unsigned int n_dimensions,
+                                  const unsigned int Ncell)
+    {
+    // tpp threads per cell
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= tpp * Ncell)
+        return;
+
+    const unsigned int cell_id = idx / tpp;
+    const unsigned int np = args.cell_np[cell_id];
+    double4 momentum = make_double4(0.0, 0.0, 0.0, 0.0);
+    double ke(0.0);
+
+    for (unsigned int offset = (idx % tpp); offset < np; offset += tpp)
+        {
+        // Load particle data
+        const unsigned int cur_p = args.cell_list[args.cli(offset, cell_id)];
+        double3 vel_i;
+        double mass_i;
+        if (cur_p < args.N_mpcd)
+            {
+            MPCDReal4 vel_cell = args.vel[cur_p];
+            vel_i = make_double3(vel_cell.x, vel_cell.y, vel_cell.z);
+            mass_i = args.mass;
+            }
+        else
+            {
+            Scalar4 vel_m = args.embed_vel[cur_p - args.N_mpcd];
+            vel_i = make_double3(vel_m.x, vel_m.y, vel_m.z);
+            mass_i = vel_m.w;
+            }
+
+        // add momentum
+        momentum.x += mass_i * vel_i.x;
+        momentum.y += mass_i * vel_i.y;
+        momentum.z += mass_i * vel_i.z;
+        momentum.w += mass_i;
+
+        // also compute ke of the particle
+        if (need_energy)
+            ke += 0.5 * mass_i * (vel_i.x * vel_i.x + vel_i.y * vel_i.y + vel_i.z * vel_i.z);
+        }
+
+    // every lane in the logical warp needs the sums, so scan and keep the aggregate
+    if (tpp > 1)
+        {
+        hoomd::detail::WarpScan<double, tpp> scanner;
+        double tmp;
+        scanner.InclusiveSum(momentum.x, tmp, momentum.x);
+        scanner.InclusiveSum(momentum.y, tmp, momentum.y);
+        scanner.InclusiveSum(momentum.z, tmp, momentum.z);
+        scanner.InclusiveSum(momentum.w, tmp, momentum.w);
+        if (need_energy)
+            scanner.InclusiveSum(ke, tmp, ke);
+        }
+
+    // average the cell properties
+    const double mass = momentum.w;
+    double3 vel_cm = make_double3(0.0,0.0,0.0);
+    if (mass > 0.)
+        {
+        vel_cm.x = momentum.x / mass;
+        vel_cm.y = momentum.y / mass;
+        vel_cm.z = momentum.z / mass;
+        }
+    double temp(0.0);
+    if (need_energy && np > 1)
+        {
+        const double ke_cm = 0.5 * mass * (vel_cm.x*vel_cm.x + vel_cm.y*vel_cm.y + vel_cm.z*vel_cm.z);
+        temp = 2. * (ke - ke_cm) / (n_dimensions * (np-1));
+        }
+
+    // shift local cell by local origin, and wrap through global boundaries
+    const uint3 cell = args.ci.getTriple(cell_id);
+    int3 global_cell = make_int3(args.origin.x + (int)cell.x,
+                                 args.origin.y + (int)cell.y,
+                                 args.origin.z + (int)cell.z);
+    if (global_cell.x >= (int)args.global_dim.x) global_cell.x -= args.global_dim.x;
+    else if (global_cell.x < 0) global_cell.x += args.global_dim.x;
+
+    if (global_cell.y >= (int)args.global_dim.y) global_cell.y -= args.global_dim.y;
+    else if (global_cell.y < 0) global_cell.y += args.global_dim.y;
+
+    if (global_cell.z >= (int)args.global_dim.z) global_cell.z -= args.global_dim.z;
+    else if (global_cell.z < 0) global_cell.z += args.global_dim.z;
+
+    const unsigned int global_idx = args.global_ci(global_cell.x, global_cell.y, global_cell.z);
+
+    // draw the rotation vector and scale factor with the same stream as srd_draw_vectors
+    hoomd::RandomGenerator rng(hoomd::RNGIdentifier::SRDCollisionMethod, seed, global_idx, timestep);
+    double3 rot_vec;
+    hoomd::SpherePointGenerator<double> sphgen;
+    sphgen(rng, rot_vec);
+
+    double factor = 1.0;
+    if (use_thermostat && np > 1)
+        {
+        const double alpha = n_dimensions*(np-1)/(double)2.;
+        hoomd::GammaDistribution<double> gamma_gen(alpha,T_set);
+        const double rand_ke = gamma_gen(rng);
+        const double cur_ke = alpha * temp;
+        factor = (cur_ke > 0.) ? fast::sqrt(rand_ke/cur_ke) : 1.;
+        }
+
+    // 0-th lane in each warp writes the cell properties
+    if (idx % tpp == 0)
+        {
+        args.cell_vel[cell_id] = make_double4(vel_cm.x, vel_cm.y, vel_cm.z, mass);
+        if (need_energy)
+            args.cell_energy[cell_id] = make_double3(ke, temp, __int_as_double(np));
+        args.rotvec[cell_id] = rot_vec;
+        if (use_thermostat)
+            args.factors[cell_id] = factor;
+        }
+
+    // rotate the particles summed by this thread
+    for (unsigned int offset = (idx % tpp); offset < np; offset += tpp)
+        {
+        const unsigned int cur_p = args.cell_list[args.cli(offset, cell_id)];
+        double3 vel;
+        // these properties are needed for the embedded particles only
+        unsigned int embed_p(0); Scalar mass_p(0);
+        if (cur_p < args.N_mpcd)
+            {
+            const MPCDReal4 vel_cell = args.vel[cur_p];
+            vel = make_double3(vel_cell.x, vel_cell.y, vel_cell.z);
+            }
+        else
+            {
+            embed_p = cur_p - args.N_mpcd;
+            const Scalar4 vel_mass = args.embed_vel[embed_p];
+            vel = make_double3(vel_mass.x, vel_mass.y, vel_mass.z);
+            mass_p = vel_mass.w;
+            }
+
+        // subtract average velocity
+        vel.x -= vel_cm.x;
+        vel.y -= vel_cm.y;
+        vel.z -= vel_cm.z;
+
+        // perform the rotation in double precision
+        double3 new_vel;
+        new_vel.x = (cos_a + rot_vec.x*rot_vec.x*one_minus_cos_a) * vel.x;
+        new_vel.x += (rot_vec.x*rot_vec.y*one_minus_cos_a - sin_a*rot_vec.z) * vel.y;
+        new_vel.x += (rot_vec.x*rot_vec.z*one_minus_cos_a + sin_a*rot_vec.y) * vel.z;
+
+        new_vel.y = (cos_a + rot_vec.y*rot_vec.y*one_minus_cos_a) * vel.y;
+        new_vel.y += (rot_vec.x*rot_vec.y*one_minus_cos_a + sin_a*rot_vec.z) * vel.x;
+        new_vel.y += (rot_vec.y*rot_vec.z*one_minus_cos_a - sin_a*rot_vec.x) * vel.z;
+
+        new_vel.z = (cos_a + rot_vec.z*rot_vec.z*one_minus_cos_a) * vel.z;
+        new_vel.z += (rot_vec.x*rot_vec.z*one_minus_cos_a - sin_a*rot_vec.y) * vel.x;
+        new_vel.z += (rot_vec.y*rot_vec.z*one_minus_cos_a + sin_a*rot_vec.x) * vel.y;
+
+        if (use_thermostat)
+            {
+            new_vel.x *= factor; new_vel.y *= factor; new_vel.z *= factor;
+            }
+
+        new_vel.x += vel_cm.x;
+        new_vel.y += vel_cm.y;
+        new_vel.z += vel_cm.z;
+
+        // set the new velocity, keeping the cell id or mass in w
+        if (cur_p < args.N_mpcd)
+            {
+            args.vel[cur_p] = make_mpcdreal4(new_vel.x, new_vel.y, new_vel.z, __int_as_mpcdreal(cell_id));
+            }
+        else
+            {
+            args.embed_vel[embed_p] = make_scalar4(new_vel.x, new_vel.y, new_vel.z, mass_p);
+            }
         }
     }
 } // end namespace kernel
@@ -244,9 +452,8 @@ cudaError_t srd_draw_vectors(double3 *d_rotvec,
     return cudaSuccess;
     }
 
-cudaError_t srd_rotate(Scalar4 *d_vel,
+cudaError_t srd_rotate(MPCDReal4 *d_vel,
                        Scalar4 *d_vel_embed,
-                       const unsigned int *d_embed_group,
                        const unsigned int *d_embed_cell_ids,
                        const double4 *d_cell_vel,
                        const double3 *d_rotvec,
@@ -273,7 +480,6 @@ cudaError_t srd_rotate(Scalar4 *d_vel,
     dim3 grid(N_tot / run_block_size + 1);
     mpcd::gpu::kernel::srd_rotate<<<grid, run_block_size>>>(d_vel,
                                                             d_vel_embed,
-                                                            d_embed_group,
                                                             d_embed_cell_ids,
                                                             d_cell_vel,
                                                             d_rotvec,
@@ -287,5 +493,158 @@ cudaError_t srd_rotate(Scalar4 *d_vel,
     return cudaSuccess;
     }
 
+//! Launches the fused SRD collision kernel for one set of template parameters
+/*!
+ * \tparam need_energy If true, compute the cell-level energy properties
+ * \tparam use_thermostat If true, draw and apply the thermostat scale factors
+ * \tparam tpp Number of threads to use per cell
+ */
+template<bool need_energy, bool use_thermostat, unsigned int tpp>
+inline void launch_srd_fused_collide_kernel(const mpcd::detail::srd_fused_args_t& args,
+                                            const unsigned int timestep,
+                                            const unsigned int seed,
+                                            const Scalar T_set,
+                                            const double cos_a,
+                                            const double one_minus_cos_a,
+                                            const double sin_a,
+                                            const unsigned int n_dimensions,
+                                            const unsigned int block_size)
+    {
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        cudaFuncAttributes attr;
+        cudaFuncGetAttributes(&attr,
+                              (const void*)mpcd::gpu::kernel::srd_fused_collide<need_energy,use_thermostat,tpp>);
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    const unsigned int Ncell = args.ci.getNumElements();
+    unsigned int run_block_size = min(block_size, max_block_size);
+    dim3 grid(tpp*Ncell / run_block_size + 1);
+    mpcd::gpu::kernel::srd_fused_collide<need_energy,use_thermostat,tpp><<<grid, run_block_size>>>(args,
+                                                                                                 timestep,
+                                                                                                 seed,
+                                                                                                 T_set,
+                                                                                                 cos_a,
+                                                                                                 one_minus_cos_a,
+                                                                                                 sin_a,
+                                                                                                 n_dimensions,
+                                                                                                 Ncell);
+    }
+
+//! Templated launcher for multiple threads-per-cell fused SRD collision kernel
+/*
+ * \tparam cur_tpp Number of threads-per-cell for this template instantiation
+ *
+ * Launchers are recursively instantiated at compile-time in order to match the
+ * correct number of threads at runtime, as in mpcd::gpu::launch_inner_cell_thermo.
+ */
+template<unsigned int cur_tpp>
+inline void launch_srd_fused_collide(const mpcd::detail::srd_fused_args_t& args,
+                                     const unsigned int timestep,
+                                     const unsigned int seed,
+                                     const Scalar T_set,
+                                     const double cos_a,
+                                     const double one_minus_cos_a,
+                                     const double sin_a,
+                                     const unsigned int n_dimensions,
+                                     const unsigned int block_size,
+                                     const unsigned int tpp)
+    {
+    if (cur_tpp == tpp)
+        {
+        // the thermostat always requires the energy
+        if (args.factors != NULL)
+            {
+            launch_srd_fused_collide_kernel<true,true,cur_tpp>(args, timestep, seed, T_set,
+                                                               cos_a, one_minus_cos_a, sin_a,
+                                                               n_dimensions, block_size);
+            }
+        else if (args.need_energy)
+            {
+            launch_srd_fused_collide_kernel<true,false,cur_tpp>(args, timestep, seed, T_set,
+                                                                cos_a, one_minus_cos_a, sin_a,
+                                                                n_dimensions, block_size);
+            }
+        else
+            {
+            launch_srd_fused_collide_kernel<false,false,cur_tpp>(args, timestep, seed, T_set,
+                                                                 cos_a, one_minus_cos_a, sin_a,
+                                                                 n_dimensions, block_size);
+            }
+        }
+    else
+        {
+        launch_srd_fused_collide<cur_tpp/2>(args,
+                                            timestep,
+                                            seed,
+                                            T_set,
+                                            cos_a,
+                                            one_minus_cos_a,
+                                            sin_a,
+                                            n_dimensions,
+                                            block_size,
+                                            tpp);
+        }
+    }
+//! Template specialization to break recursion
+template<>
+inline void launch_srd_fused_collide<0>(const mpcd::detail::srd_fused_args_t& args,
+                                        const unsigned int timestep,
+                                        const unsigned int seed,
+                                        const Scalar T_set,
+                                        const double cos_a,
+                                        const double one_minus_cos_a,
+                                        const double sin_a,
+                                        const unsigned int n_dimensions,
+                                        const unsigned int block_size,
+                                        const unsigned int tpp)
+    { }
+
+/*!
+ * \param args Common arguments to the fused kernel
+ * \param timestep Current timestep
+ * \param seed Seed for the collision
+ * \param T_set Thermostat temperature, ignored if \a args has no factors
+ * \param angle Rotation angle
+ * \param n_dimensions System dimensionality
+ * \param block_size Number of threads per block
+ * \param tpp Number of threads per cell
+ *
+ * \returns cudaSuccess on completion
+ *
+ * \sa mpcd::gpu::launch_srd_fused_collide
+ * \sa mpcd::gpu::kernel::srd_fused_collide
+ */
+cudaError_t srd_fused_collide(const mpcd::detail::srd_fused_args_t& args,
+                              const unsigned int timestep,
+                              const unsigned int seed,
+                              const Scalar T_set,
+                              const double angle,
+                              const unsigned int n_dimensions,
+                              const unsigned int block_size,
+                              const unsigned int tpp)
+    {
+    if (args.ci.getNumElements() == 0) return cudaSuccess;
+
+    // precompute angles for rotation
+    const double cos_a = slow::cos(angle);
+    const double one_minus_cos_a = 1.0 - cos_a;
+    const double sin_a = slow::sin(angle);
+
+    launch_srd_fused_collide<32>(args,
+                                 timestep,
+                                 seed,
+                                 T_set,
+                                 cos_a,
+                                 one_minus_cos_a,
+                                 sin_a,
+                                 n_dimensions,
+                                 block_size,
+                                 tpp);
+    return cudaSuccess;
+    }
+
 } // end namespace gpu
 } // end namespace mpcd
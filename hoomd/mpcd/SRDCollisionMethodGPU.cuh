@@ -13,11 +13,59 @@
 
 #include <cuda_runtime.h>
 
+#include "ParticleDataUtilities.h"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
 
 namespace mpcd
 {
+namespace detail
+{
+//! Convenience struct for the parameters of the fused SRD collision kernel
+struct srd_fused_args_t
+    {
+    srd_fused_args_t(MPCDReal4 *vel_,
+                     Scalar4 *embed_vel_,
+                     double4 *cell_vel_,
+                     double3 *cell_energy_,
+                     double3 *rotvec_,
+                     double *factors_,
+                     const unsigned int *cell_np_,
+                     const unsigned int *cell_list_,
+                     const Index2D& cli_,
+                     const Index3D& ci_,
+                     const int3 origin_,
+                     const uint3 global_dim_,
+                     const Index3D& global_ci_,
+                     const unsigned int N_mpcd_,
+                     const Scalar mass_,
+                     const bool need_energy_)
+        : vel(vel_), embed_vel(embed_vel_), cell_vel(cell_vel_), cell_energy(cell_energy_),
+          rotvec(rotvec_), factors(factors_), cell_np(cell_np_), cell_list(cell_list_), cli(cli_), ci(ci_),
+          origin(origin_), global_dim(global_dim_), global_ci(global_ci_), N_mpcd(N_mpcd_), mass(mass_),
+          need_energy(need_energy_)
+        { }
+
+    MPCDReal4 *vel;                 //!< MPCD particle velocities (input/output)
+    Scalar4 *embed_vel;             //!< Staged embedded particle velocities (input/output)
+    double4 *cell_vel;              //!< Cell velocities (output)
+    double3 *cell_energy;           //!< Cell energies (output)
+    double3 *rotvec;                //!< Cell rotation vectors (output)
+    double *factors;                //!< Cell thermostat factors (output), NULL without a thermostat
+
+    const unsigned int *cell_np;    //!< Number of particles per cell
+    const unsigned int *cell_list;  //!< MPCD cell list
+    const Index2D cli;              //!< MPCD cell list indexer
+    const Index3D ci;               //!< Cell indexer
+    const int3 origin;              //!< Origin of the local cells in the global cells
+    const uint3 global_dim;         //!< Global cell dimensions
+    const Index3D global_ci;        //!< Global cell indexer
+    const unsigned int N_mpcd;      //!< Number of MPCD particles
+    const Scalar mass;              //!< MPCD particle mass
+    const bool need_energy;         //!< Flag if energy calculations are required
+    };
+} // end namespace detail
+
 namespace gpu
 {
 
@@ -34,9 +82,8 @@ cudaError_t srd_draw_vectors(double3 *d_rotvec,
                              const unsigned int n_dimensions,
                              const unsigned int block_size);
 
-cudaError_t srd_rotate(Scalar4 *d_vel,
+cudaError_t srd_rotate(MPCDReal4 *d_vel,
                        Scalar4 *d_vel_embed,
-                       const unsigned int *d_embed_group,
                        const unsigned int *d_embed_cell_ids,
                        const double4 *d_cell_vel,
                        const double3 *d_rotvec,
@@ -46,6 +93,15 @@ cudaError_t srd_rotate(Scalar4 *d_vel,
                        const unsigned int N_tot,
                        const unsigned int block_size);
 
+cudaError_t srd_fused_collide(const mpcd::detail::srd_fused_args_t& args,
+                              const unsigned int timestep,
+                              const unsigned int seed,
+                              const Scalar T_set,
+                              const double angle,
+                              const unsigned int n_dimensions,
+                              const unsigned int block_size,
+                              const unsigned int tpp);
+
 } // end namespace gpu
 } // end namespace mpcd
 
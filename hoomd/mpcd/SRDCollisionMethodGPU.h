@@ -43,9 +43,16 @@ class PYBIND11_EXPORT SRDCollisionMethodGPU : public mpcd::SRDCollisionMethod
 
             m_tuner_rotvec->setPeriod(period); m_tuner_rotvec->setEnabled(enable);
             m_tuner_rotate->setPeriod(period); m_tuner_rotate->setEnabled(enable);
+            m_tuner_fused->setPeriod(period); m_tuner_fused->setEnabled(enable);
             }
 
     protected:
+        //! Implementation of the collision rule
+        virtual void rule(unsigned int timestep);
+
+        //! Compute the cell properties and apply the collision in one kernel
+        void fusedCollide(unsigned int timestep);
+
         //! Randomly draw cell rotation vectors
         virtual void drawRotationVectors(unsigned int timestep);
 
@@ -55,6 +62,7 @@ class PYBIND11_EXPORT SRDCollisionMethodGPU : public mpcd::SRDCollisionMethod
     private:
         std::unique_ptr<Autotuner> m_tuner_rotvec;  //!< Tuner for drawing rotation vectors
         std::unique_ptr<Autotuner> m_tuner_rotate;  //!< Tuner for rotating velocities
+        std::unique_ptr<Autotuner> m_tuner_fused;   //!< Tuner for the fused thermo and rotation kernel
     };
 
 namespace detail
@@ -21,6 +21,10 @@ mpcd::SlitGeometryFiller::SlitGeometryFiller(std::shared_ptr<mpcd::SystemData> s
     : mpcd::VirtualParticleFiller(sysdata, density, type, T, seed), m_geom(geom)
     {
     m_exec_conf->msg->notice(5) << "Constructing MPCD SlitGeometryFiller" << std::endl;
+
+    // one box above and below the slit
+    GPUArray<mpcd::detail::VirtualFillBox> fill_boxes(2, m_exec_conf);
+    m_fill_boxes.swap(fill_boxes);
     }
 
 mpcd::SlitGeometryFiller::~SlitGeometryFiller()
@@ -70,6 +74,29 @@ void mpcd::SlitGeometryFiller::computeNumFill()
 
     // total number of fill particles
     m_N_fill = m_N_hi + m_N_lo;
+
+    // boxes for filling the cells, clamped to the local domain and moving with the walls
+    ArrayHandle<mpcd::detail::VirtualFillBox> h_fill_boxes(m_fill_boxes, access_location::host, access_mode::overwrite);
+    m_num_fill_boxes = 0;
+    const Scalar3 lo = box.getLo();
+    const Scalar3 hi = box.getHi();
+    const Scalar U = m_geom->getVelocity();
+    if (m_N_lo > 0)
+        {
+        mpcd::detail::VirtualFillBox fill_box;
+        fill_box.lo = make_scalar3(lo.x, lo.y, std::max(m_z_min, lo.z));
+        fill_box.hi = make_scalar3(hi.x, hi.y, std::min(-H, hi.z));
+        fill_box.vel = make_scalar3(-U, 0, 0);
+        h_fill_boxes.data[m_num_fill_boxes++] = fill_box;
+        }
+    if (m_N_hi > 0)
+        {
+        mpcd::detail::VirtualFillBox fill_box;
+        fill_box.lo = make_scalar3(lo.x, lo.y, std::max(H, lo.z));
+        fill_box.hi = make_scalar3(hi.x, hi.y, std::min(m_z_max, hi.z));
+        fill_box.vel = make_scalar3(U, 0, 0);
+        h_fill_boxes.data[m_num_fill_boxes++] = fill_box;
+        }
     }
 
 /*!
@@ -77,8 +104,8 @@ void mpcd::SlitGeometryFiller::computeNumFill()
  */
 void mpcd::SlitGeometryFiller::drawParticles(unsigned int timestep)
     {
-    ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+    ArrayHandle<MPCDReal4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<MPCDReal4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
     ArrayHandle<unsigned int> h_tag(m_mpcd_pdata->getTags(), access_location::host, access_mode::readwrite);
 
     const BoxDim& box = m_pdata->getBox();
@@ -104,20 +131,20 @@ void mpcd::SlitGeometryFiller::drawParticles(unsigned int timestep)
             }
 
         const unsigned int pidx = first_idx + i;
-        h_pos.data[pidx] = make_scalar4(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
-                                        hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
-                                        hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
-                                        __int_as_scalar(m_type));
+        h_pos.data[pidx] = make_mpcdreal4(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
+                                          hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
+                                          hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
+                                          __int_as_mpcdreal(m_type));
 
         hoomd::NormalDistribution<Scalar> gen(vel_factor, 0.0);
         Scalar3 vel;
         gen(vel.x, vel.y, rng);
         vel.z = gen(rng);
         // TODO: should these be given zero net-momentum contribution (relative to the frame of reference?)
-        h_vel.data[pidx] = make_scalar4(vel.x + sign * m_geom->getVelocity(),
-                                        vel.y,
-                                        vel.z,
-                                        __int_as_scalar(mpcd::detail::NO_CELL));
+        h_vel.data[pidx] = make_mpcdreal4(vel.x + sign * m_geom->getVelocity(),
+                                          vel.y,
+                                          vel.z,
+                                          __int_as_mpcdreal(mpcd::detail::NO_CELL));
         h_tag.data[pidx] = tag;
         }
     }
@@ -16,6 +16,7 @@
 #include "SlitGeometry.h"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/BoxDim.h"
+#include "ParticleDataUtilities.h"
 
 namespace mpcd
 {
@@ -23,8 +24,8 @@ namespace gpu
 {
 
 //! Draw virtual particles in the SlitGeometry
-cudaError_t slit_draw_particles(Scalar4 *d_pos,
-                                Scalar4 *d_vel,
+cudaError_t slit_draw_particles(MPCDReal4 *d_pos,
+                                MPCDReal4 *d_vel,
                                 unsigned int *d_tag,
                                 const mpcd::detail::SlitGeometry& geom,
                                 const Scalar z_min,
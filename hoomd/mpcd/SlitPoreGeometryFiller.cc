@@ -25,6 +25,9 @@ mpcd::SlitPoreGeometryFiller::SlitPoreGeometryFiller(std::shared_ptr<mpcd::Syste
     {
     m_exec_conf->msg->notice(5) << "Constructing MPCD SlitPoreGeometryFiller" << std::endl;
 
+    GPUArray<mpcd::detail::VirtualFillBox> fill_boxes(MAX_BOXES, m_exec_conf);
+    m_fill_boxes.swap(fill_boxes);
+
     setGeometry(geom);
 
     // unphysical values in cache to always force recompute
@@ -98,6 +101,7 @@ void mpcd::SlitPoreGeometryFiller::computeNumFill()
     // find all boxes that overlap the domain
     ArrayHandle<Scalar4> h_boxes(m_boxes, access_location::host, access_mode::overwrite);
     ArrayHandle<uint2> h_ranges(m_ranges, access_location::host, access_mode::overwrite);
+    ArrayHandle<mpcd::detail::VirtualFillBox> h_fill_boxes(m_fill_boxes, access_location::host, access_mode::overwrite);
     m_num_boxes = 0;
     m_N_fill = 0;
     for (unsigned int i=0; i < MAX_BOXES; ++i)
@@ -122,6 +126,13 @@ void mpcd::SlitPoreGeometryFiller::computeNumFill()
                 {
                 h_boxes.data[m_num_boxes] = clampbox;
                 h_ranges.data[m_num_boxes] = make_uint2(m_N_fill, m_N_fill + N_box);
+
+                // the same box, infinite in y, is used to fill the cells
+                mpcd::detail::VirtualFillBox fill_box;
+                fill_box.lo = make_scalar3(clampbox.x, lo.y, clampbox.z);
+                fill_box.hi = make_scalar3(clampbox.y, hi.y, clampbox.w);
+                fill_box.vel = make_scalar3(0, 0, 0);
+                h_fill_boxes.data[m_num_boxes] = fill_box;
                 ++m_num_boxes;
 
                 m_N_fill += N_box;
@@ -129,6 +140,8 @@ void mpcd::SlitPoreGeometryFiller::computeNumFill()
             }
         }
 
+    m_num_fill_boxes = m_num_boxes;
+
     // size is now updated, cache the cell dimensions used
     m_needs_recompute = false;
     m_recompute_cache = make_scalar3(cell_size, max_shift, m_density);
@@ -142,8 +155,8 @@ void mpcd::SlitPoreGeometryFiller::drawParticles(unsigned int timestep)
     // quit early if not filling to ensure we don't access any memory that hasn't been set
     if (m_N_fill == 0) return;
 
-    ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+    ArrayHandle<MPCDReal4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<MPCDReal4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
     ArrayHandle<unsigned int> h_tag(m_mpcd_pdata->getTags(), access_location::host, access_mode::readwrite);
     const Scalar vel_factor = fast::sqrt((*m_T)(timestep) / m_mpcd_pdata->getMass());
 
@@ -178,20 +191,20 @@ void mpcd::SlitPoreGeometryFiller::drawParticles(unsigned int timestep)
             }
 
         const unsigned int pidx = first_idx + i;
-        h_pos.data[pidx] = make_scalar4(hoomd::UniformDistribution<Scalar>(lo.x,hi.x)(rng),
-                                        hoomd::UniformDistribution<Scalar>(lo.y,hi.y)(rng),
-                                        hoomd::UniformDistribution<Scalar>(lo.z,hi.z)(rng),
-                                        __int_as_scalar(m_type));
+        h_pos.data[pidx] = make_mpcdreal4(hoomd::UniformDistribution<Scalar>(lo.x,hi.x)(rng),
+                                          hoomd::UniformDistribution<Scalar>(lo.y,hi.y)(rng),
+                                          hoomd::UniformDistribution<Scalar>(lo.z,hi.z)(rng),
+                                          __int_as_mpcdreal(m_type));
 
         hoomd::NormalDistribution<Scalar> gen(vel_factor, 0.0);
         Scalar3 vel;
         gen(vel.x, vel.y, rng);
         vel.z = gen(rng);
         // TODO: should these be given zero net-momentum contribution (relative to the frame of reference?)
-        h_vel.data[pidx] = make_scalar4(vel.x,
-                                        vel.y,
-                                        vel.z,
-                                        __int_as_scalar(mpcd::detail::NO_CELL));
+        h_vel.data[pidx] = make_mpcdreal4(vel.x,
+                                          vel.y,
+                                          vel.z,
+                                          __int_as_mpcdreal(mpcd::detail::NO_CELL));
         h_tag.data[pidx] = tag;
         }
     }
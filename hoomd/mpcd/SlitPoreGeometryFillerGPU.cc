@@ -10,6 +10,7 @@
 
 #include "SlitPoreGeometryFillerGPU.h"
 #include "SlitPoreGeometryFillerGPU.cuh"
+#include "VirtualParticleFillerGPU.cuh"
 
 mpcd::SlitPoreGeometryFillerGPU::SlitPoreGeometryFillerGPU(std::shared_ptr<mpcd::SystemData> sysdata,
                                                    Scalar density,
@@ -19,7 +20,10 @@ mpcd::SlitPoreGeometryFillerGPU::SlitPoreGeometryFillerGPU(std::shared_ptr<mpcd:
                                                    std::shared_ptr<const mpcd::detail::SlitPoreGeometry> geom)
     : mpcd::SlitPoreGeometryFiller(sysdata, density, type, T, seed, geom)
     {
-    m_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_slit_filler", m_exec_conf));
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_tuner.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_slit_filler", m_exec_conf));
+    m_cell_tuner.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_slit_pore_filler_cells",
+                                     m_exec_conf));
     }
 
 /*!
@@ -27,8 +31,8 @@ mpcd::SlitPoreGeometryFillerGPU::SlitPoreGeometryFillerGPU(std::shared_ptr<mpcd:
  */
 void mpcd::SlitPoreGeometryFillerGPU::drawParticles(unsigned int timestep)
     {
-    ArrayHandle<Scalar4> d_pos(m_mpcd_pdata->getPositions(), access_location::device, access_mode::readwrite);
-    ArrayHandle<Scalar4> d_vel(m_mpcd_pdata->getVelocities(), access_location::device, access_mode::readwrite);
+    ArrayHandle<MPCDReal4> d_pos(m_mpcd_pdata->getPositions(), access_location::device, access_mode::readwrite);
+    ArrayHandle<MPCDReal4> d_vel(m_mpcd_pdata->getVelocities(), access_location::device, access_mode::readwrite);
     ArrayHandle<unsigned int> d_tag(m_mpcd_pdata->getTags(), access_location::device, access_mode::readwrite);
 
     // boxes for filling
@@ -58,6 +62,51 @@ void mpcd::SlitPoreGeometryFillerGPU::drawParticles(unsigned int timestep)
     m_tuner->end();
     }
 
+/*!
+ * \param cell_vel Momentum and mass of the virtual particles in each cell (output)
+ * \param cell_energy Kinetic energy and number of the virtual particles in each cell (output)
+ * \param timestep Current timestep
+ * \param thermal_only If true, the virtual particles do not carry the mean velocity of their fill box
+ */
+void mpcd::SlitPoreGeometryFillerGPU::drawCells(GPUArray<double4>& cell_vel,
+                                                GPUArray<double2>& cell_energy,
+                                                unsigned int timestep,
+                                                bool thermal_only)
+    {
+    ArrayHandle<double4> d_cell_vel(cell_vel, access_location::device, access_mode::readwrite);
+    ArrayHandle<double2> d_cell_energy(cell_energy, access_location::device, access_mode::readwrite);
+    ArrayHandle<mpcd::detail::VirtualFillBox> d_boxes(m_fill_boxes, access_location::device, access_mode::read);
+
+    // lower corner of the first local cell
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const Scalar cell_size = m_cl->getCellSize();
+    const int3 origin = m_cl->getOriginIndex();
+    const Scalar3 first_lo = global_box.getLo() + m_cl->getGridShift()
+                           + cell_size * make_scalar3(origin.x, origin.y, origin.z);
+
+    m_cell_tuner->begin();
+    mpcd::gpu::fill_virtual_cells(d_cell_vel.data,
+                                  d_cell_energy.data,
+                                  m_cl->getCellIndexer(),
+                                  first_lo,
+                                  cell_size,
+                                  global_box.getL(),
+                                  m_pdata->getBox().getPeriodic(),
+                                  d_boxes.data,
+                                  m_num_fill_boxes,
+                                  m_density,
+                                  m_mpcd_pdata->getMass(),
+                                  (*m_T)(timestep),
+                                  m_sysdef->getNDimensions(),
+                                  timestep,
+                                  m_seed,
+                                  (m_exec_conf->getRank() << 1) | thermal_only,
+                                  thermal_only,
+                                  m_cell_tuner->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+    m_cell_tuner->end();
+    }
+
 /*!
  * \param m Python module to export to
  */
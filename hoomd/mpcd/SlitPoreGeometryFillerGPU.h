@@ -44,14 +44,22 @@ class PYBIND11_EXPORT SlitPoreGeometryFillerGPU : public mpcd::SlitPoreGeometryF
             mpcd::SlitPoreGeometryFiller::setAutotunerParams(enable, period);
 
             m_tuner->setEnabled(enable); m_tuner->setPeriod(period);
+            m_cell_tuner->setEnabled(enable); m_cell_tuner->setPeriod(period);
             }
 
     protected:
         //! Draw particles within the fill volume on the GPU
         virtual void drawParticles(unsigned int timestep);
 
+        //! Draw the contributions of the virtual particles to the cell properties on the GPU
+        virtual void drawCells(GPUArray<double4>& cell_vel,
+                               GPUArray<double2>& cell_energy,
+                               unsigned int timestep,
+                               bool thermal_only);
+
     private:
         std::unique_ptr<::Autotuner> m_tuner;   //!< Autotuner for drawing particles
+        std::unique_ptr<::Autotuner> m_cell_tuner;  //!< Autotuner for filling cells
     };
 
 namespace detail
@@ -24,7 +24,9 @@ mpcd::Sorter::Sorter(std::shared_ptr<mpcd::SystemData> sysdata,
       m_cl(m_mpcd_sys->getCellList()),
       m_order(m_exec_conf),
       m_rorder(m_exec_conf),
-      m_period(period)
+      m_period(period),
+      m_max_disorder(0.0),
+      m_disorder(0.0)
     {
     assert(m_mpcd_sys);
     m_exec_conf->msg->notice(5) << "Constructing MPCD Sorter" << std::endl;
@@ -54,6 +56,19 @@ void mpcd::Sorter::update(unsigned int timestep)
 
     // generate and apply the sorted order
     computeOrder(timestep);
+
+    // leave the particles in place if they are still close to the sorted order
+    if (m_max_disorder > Scalar(0.0))
+        {
+        const unsigned int N = m_mpcd_pdata->getN();
+        m_disorder = (N > 1) ? Scalar(countDisorder()) / Scalar(N - 1) : Scalar(0.0);
+        if (m_disorder < m_max_disorder)
+            {
+            if (m_prof) m_prof->pop(m_exec_conf);
+            return;
+            }
+        }
+
     applyOrder();
 
     // trigger the sort signal for ParticleData callbacks using the current sortings
@@ -117,12 +132,12 @@ void mpcd::Sorter::applyOrder() const
         {
         ArrayHandle<unsigned int> h_order(m_order, access_location::host, access_mode::read);
 
-        ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::read);
-        ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<MPCDReal4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<MPCDReal4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::read);
         ArrayHandle<unsigned int> h_tag(m_mpcd_pdata->getTags(), access_location::host, access_mode::read);
 
-        ArrayHandle<Scalar4> h_pos_alt(m_mpcd_pdata->getAltPositions(), access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar4> h_vel_alt(m_mpcd_pdata->getAltVelocities(), access_location::host, access_mode::overwrite);
+        ArrayHandle<MPCDReal4> h_pos_alt(m_mpcd_pdata->getAltPositions(), access_location::host, access_mode::overwrite);
+        ArrayHandle<MPCDReal4> h_vel_alt(m_mpcd_pdata->getAltVelocities(), access_location::host, access_mode::overwrite);
         ArrayHandle<unsigned int> h_tag_alt(m_mpcd_pdata->getAltTags(), access_location::host, access_mode::overwrite);
 
         for (unsigned int idx=0; idx < m_mpcd_pdata->getN(); ++idx)
@@ -150,6 +165,25 @@ void mpcd::Sorter::applyOrder() const
     m_mpcd_pdata->swapTags();
     }
 
+/*!
+ * \returns Number of particles in the computed order whose old index is not one more than the
+ *          old index of the particle before them.
+ *
+ * The count is zero when the computed order is the identity, i.e., the particles are already sorted.
+ */
+unsigned int mpcd::Sorter::countDisorder() const
+    {
+    ArrayHandle<unsigned int> h_order(m_order, access_location::host, access_mode::read);
+
+    unsigned int count = 0;
+    for (unsigned int idx=1; idx < m_mpcd_pdata->getN(); ++idx)
+        {
+        if (h_order.data[idx] != h_order.data[idx-1] + 1)
+            ++count;
+        }
+    return count;
+    }
+
 bool mpcd::Sorter::peekSort(unsigned int timestep) const
     {
     if (timestep < m_next_timestep)
@@ -178,5 +212,8 @@ void mpcd::detail::export_Sorter(pybind11::module& m)
     py::class_<mpcd::Sorter, std::shared_ptr<mpcd::Sorter> >(m, "Sorter")
         .def(py::init<std::shared_ptr<mpcd::SystemData>, unsigned int, unsigned int>())
         .def("setPeriod", &mpcd::Sorter::setPeriod)
+        .def("setMaxDisorder", &mpcd::Sorter::setMaxDisorder)
+        .def("getMaxDisorder", &mpcd::Sorter::getMaxDisorder)
+        .def("getDisorder", &mpcd::Sorter::getDisorder)
         ;
     }
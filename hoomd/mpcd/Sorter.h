@@ -31,6 +31,11 @@ namespace mpcd
  * must set the map from old particle index to new particle index, and the
  * reverse mapping.
  *
+ * Sorting on every period can waste bandwidth when particles diffuse slowly. With a nonzero
+ * maximum disorder (setMaxDisorder()), the order is still computed every period, but it is only
+ * applied when the fraction of particles that do not directly follow their predecessor in the
+ * new order exceeds the threshold. A freshly sorted system has zero disorder.
+ *
  * When there are virtual particles in the mpcd::ParticleData, the Sorter will ignore
  * the virtual particles and leave them in place at the end of the arrays. This is
  * because they cannot be removed easily if they are sorted with the rest of the particles,
@@ -75,6 +80,32 @@ class PYBIND11_EXPORT Sorter
             m_next_timestep = multiple * m_period;
             }
 
+        //! Set the disorder below which a scheduled sort is skipped
+        /*!
+         * \param max_disorder Fraction of particles out of order, 0 to sort every period
+         */
+        void setMaxDisorder(Scalar max_disorder)
+            {
+            if (max_disorder < Scalar(0.0) || max_disorder > Scalar(1.0))
+                {
+                m_exec_conf->msg->error() << "mpcd.sort: maximum disorder must be between 0 and 1" << std::endl;
+                throw std::runtime_error("Invalid MPCD sorter disorder");
+                }
+            m_max_disorder = max_disorder;
+            }
+
+        //! Get the disorder below which a scheduled sort is skipped
+        Scalar getMaxDisorder() const
+            {
+            return m_max_disorder;
+            }
+
+        //! Get the disorder measured at the last scheduled sort
+        Scalar getDisorder() const
+            {
+            return m_disorder;
+            }
+
     protected:
         std::shared_ptr<mpcd::SystemData> m_mpcd_sys;       //!< MPCD system data
         std::shared_ptr<SystemDefinition> m_sysdef;         //!< HOOMD system definition
@@ -90,6 +121,8 @@ class PYBIND11_EXPORT Sorter
 
         unsigned int m_period;          //!< Sorting period
         unsigned int m_next_timestep;   //!< Next step to apply sorting
+        Scalar m_max_disorder;          //!< Disorder below which sorting is skipped
+        Scalar m_disorder;              //!< Disorder measured at the last scheduled sort
 
         //! Compute the sorting order at the current timestep
         virtual void computeOrder(unsigned int timestep);
@@ -97,6 +130,9 @@ class PYBIND11_EXPORT Sorter
         //! Apply the sorting order
         virtual void applyOrder() const;
 
+        //! Count the particles that do not directly follow their predecessor in the sorted order
+        virtual unsigned int countDisorder() const;
+
     private:
         bool shouldSort(unsigned int timestep);
     };
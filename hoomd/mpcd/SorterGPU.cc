@@ -10,6 +10,7 @@
 
 #include "SorterGPU.h"
 #include "SorterGPU.cuh"
+#include "hoomd/GPUReorder.cuh"
 
 /*!
  * \param sysdata MPCD system data
@@ -19,9 +20,10 @@ mpcd::SorterGPU::SorterGPU(std::shared_ptr<mpcd::SystemData> sysdata,
                            unsigned int period)
     : mpcd::Sorter(sysdata,cur_timestep,period)
     {
-    m_sentinel_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_sort_sentinel", m_exec_conf));
-    m_reverse_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_sort_reverse", m_exec_conf));
-    m_apply_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_sort_apply", m_exec_conf));
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_sentinel_tuner.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_sort_sentinel", m_exec_conf));
+    m_reverse_tuner.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_sort_reverse", m_exec_conf));
+    m_apply_tuner.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_sort_apply", m_exec_conf));
     }
 
 /*!
@@ -94,24 +96,21 @@ void mpcd::SorterGPU::applyOrder() const
         {
         ArrayHandle<unsigned int> d_order(m_order, access_location::device, access_mode::read);
 
-        ArrayHandle<Scalar4> d_pos(m_mpcd_pdata->getPositions(), access_location::device, access_mode::read);
-        ArrayHandle<Scalar4> d_vel(m_mpcd_pdata->getVelocities(), access_location::device, access_mode::read);
+        ArrayHandle<MPCDReal4> d_pos(m_mpcd_pdata->getPositions(), access_location::device, access_mode::read);
+        ArrayHandle<MPCDReal4> d_vel(m_mpcd_pdata->getVelocities(), access_location::device, access_mode::read);
         ArrayHandle<unsigned int> d_tag(m_mpcd_pdata->getTags(), access_location::device, access_mode::read);
 
-        ArrayHandle<Scalar4> d_pos_alt(m_mpcd_pdata->getAltPositions(), access_location::device, access_mode::overwrite);
-        ArrayHandle<Scalar4> d_vel_alt(m_mpcd_pdata->getAltVelocities(), access_location::device, access_mode::overwrite);
+        ArrayHandle<MPCDReal4> d_pos_alt(m_mpcd_pdata->getAltPositions(), access_location::device, access_mode::overwrite);
+        ArrayHandle<MPCDReal4> d_vel_alt(m_mpcd_pdata->getAltVelocities(), access_location::device, access_mode::overwrite);
         ArrayHandle<unsigned int> d_tag_alt(m_mpcd_pdata->getAltTags(), access_location::device, access_mode::overwrite);
 
+        gpu_reorder_table table;
+        table.add(d_pos.data, d_pos_alt.data);
+        table.add(d_vel.data, d_vel_alt.data);
+        table.add(d_tag.data, d_tag_alt.data);
+
         m_apply_tuner->begin();
-        mpcd::gpu::sort_apply(d_pos_alt.data,
-                              d_vel_alt.data,
-                              d_tag_alt.data,
-                              d_pos.data,
-                              d_vel.data,
-                              d_tag.data,
-                              d_order.data,
-                              m_mpcd_pdata->getN(),
-                              m_apply_tuner->getParam());
+        gpu_apply_reorder(table, d_order.data, m_mpcd_pdata->getN(), m_apply_tuner->getParam());
         if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
         m_apply_tuner->end();
 
@@ -120,8 +119,8 @@ void mpcd::SorterGPU::applyOrder() const
             {
             const unsigned int N = m_mpcd_pdata->getN();
             const unsigned int Nvirtual = m_mpcd_pdata->getNVirtual();
-            cudaMemcpyAsync(d_pos_alt.data + N, d_pos.data + N, Nvirtual*sizeof(Scalar4), cudaMemcpyDeviceToDevice);
-            cudaMemcpyAsync(d_vel_alt.data + N, d_vel.data + N, Nvirtual*sizeof(Scalar4), cudaMemcpyDeviceToDevice);
+            cudaMemcpyAsync(d_pos_alt.data + N, d_pos.data + N, Nvirtual*sizeof(MPCDReal4), cudaMemcpyDeviceToDevice);
+            cudaMemcpyAsync(d_vel_alt.data + N, d_vel.data + N, Nvirtual*sizeof(MPCDReal4), cudaMemcpyDeviceToDevice);
             cudaMemcpyAsync(d_tag_alt.data + N, d_tag.data + N, Nvirtual*sizeof(unsigned int), cudaMemcpyDeviceToDevice);
             cudaDeviceSynchronize();
             }
@@ -133,6 +132,14 @@ void mpcd::SorterGPU::applyOrder() const
     m_mpcd_pdata->swapTags();
     }
 
+unsigned int mpcd::SorterGPU::countDisorder() const
+    {
+    ArrayHandle<unsigned int> d_order(m_order, access_location::device, access_mode::read);
+    const unsigned int count = mpcd::gpu::sort_count_disorder(d_order.data, m_mpcd_pdata->getN());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled()) CHECK_CUDA_ERROR();
+    return count;
+    }
+
 /*!
  * \param m Python module to export to
  */
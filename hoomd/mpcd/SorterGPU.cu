@@ -14,6 +14,8 @@
 #pragma GCC diagnostic ignored "-Wconversion"
 #include <thrust/copy.h>
 #include <thrust/execution_policy.h>
+#include <thrust/functional.h>
+#include <thrust/inner_product.h>
 #pragma GCC diagnostic pop
 
 namespace mpcd
@@ -22,41 +24,6 @@ namespace gpu
 {
 namespace kernel
 {
-//! Kernel to apply sorted particle order
-/*!
- * \param d_pos_alt Alternate array of particle positions (output)
- * \param d_vel_alt Alternate array of particle velocities (output)
- * \param d_tag_alt Alternate array of particle tags (output)
- * \param d_pos Particle positions
- * \param d_vel Particle velocities
- * \param d_tag Particle tags
- * \param d_order Mapping of new particle index onto old particle index
- * \param N Number of particles
- *
- * \b Implementation
- * Using one thread per particle, particle data is reordered from the old arrays
- * into the new arrays. This coalesces writes but fragments reads.
- */
-__global__ void sort_apply(Scalar4 *d_pos_alt,
-                           Scalar4 *d_vel_alt,
-                           unsigned int *d_tag_alt,
-                           const Scalar4 *d_pos,
-                           const Scalar4 *d_vel,
-                           const unsigned int *d_tag,
-                           const unsigned int *d_order,
-                           const unsigned int N)
-    {
-    // one thread per particle
-    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
-    if (idx >= N)
-        return;
-
-    const unsigned int old_idx = d_order[idx];
-    d_pos_alt[idx] = d_pos[old_idx];
-    d_vel_alt[idx] = d_vel[old_idx];
-    d_tag_alt[idx] = d_tag[old_idx];
-    }
-
 //! Kernel to set the empty-cell-entry sentinel
 /*!
  * \param d_cell_list Cell list to fill in
@@ -121,55 +88,6 @@ __global__ void sort_gen_reverse(unsigned int *d_rorder,
 
 } // end namespace kernel
 
-/*!
- * \param d_pos_alt Alternate array of particle positions (output)
- * \param d_vel_alt Alternate array of particle velocities (output)
- * \param d_tag_alt Alternate array of particle tags (output)
- * \param d_pos Particle positions
- * \param d_vel Particle velocities
- * \param d_tag Particle tags
- * \param d_order Mapping of new particle index onto old particle index
- * \param N Number of particles
- * \param block_size Number of threads per block
- *
- * \returns cudaSuccess on completion
- *
- * \sa mpcd::gpu::kernel::sort_apply
- */
-cudaError_t sort_apply(Scalar4 *d_pos_alt,
-                       Scalar4 *d_vel_alt,
-                       unsigned int *d_tag_alt,
-                       const Scalar4 *d_pos,
-                       const Scalar4 *d_vel,
-                       const unsigned int *d_tag,
-                       const unsigned int *d_order,
-                       const unsigned int N,
-                       const unsigned int block_size)
-    {
-    if (N == 0) return cudaSuccess;
-
-    static unsigned int max_block_size = UINT_MAX;
-    if (max_block_size == UINT_MAX)
-        {
-        cudaFuncAttributes attr;
-        cudaFuncGetAttributes(&attr, (const void*)mpcd::gpu::kernel::sort_apply);
-        max_block_size = attr.maxThreadsPerBlock;
-        }
-
-    unsigned int run_block_size = min(block_size, max_block_size);
-    dim3 grid(N / run_block_size + 1);
-    mpcd::gpu::kernel::sort_apply<<<grid, run_block_size>>>(d_pos_alt,
-                                                            d_vel_alt,
-                                                            d_tag_alt,
-                                                            d_pos,
-                                                            d_vel,
-                                                            d_tag,
-                                                            d_order,
-                                                            N);
-
-    return cudaSuccess;
-    }
-
 /*!
  * \param d_cell_list Cell list to fill in
  * \param d_cell_np Number of particles per cell
@@ -295,5 +213,45 @@ cudaError_t sort_gen_reverse(unsigned int *d_rorder,
 
     return cudaSuccess;
     }
+
+//! Functor to flag a particle that does not directly follow its predecessor
+struct NotSuccessor
+    {
+    //! Successor comparison functor
+    /*!
+     * \param cur Old index of the current particle
+     * \param prev Old index of the previous particle
+     * \returns 1 if \a cur is not one more than \a prev, 0 otherwise
+     */
+    __host__ __device__
+    unsigned int operator()(const unsigned int& cur, const unsigned int& prev) const
+        {
+        return (cur != prev + 1) ? 1 : 0;
+        }
+    };
+
+/*!
+ * \param d_order Map of new particle indexes onto old particle indexes
+ * \param N Number of particles
+ *
+ * \returns Number of particles whose old index is not one more than the old index of the particle before them.
+ *
+ * \b Implementation
+ * thrust::inner_product pairs each entry of \a d_order with the entry before it and sums the
+ * NotSuccessor flags. The result is copied back to the host, so this call synchronizes.
+ */
+unsigned int sort_count_disorder(const unsigned int *d_order,
+                                 const unsigned int N)
+    {
+    if (N < 2) return 0;
+
+    return thrust::inner_product(thrust::device,
+                                 d_order + 1,
+                                 d_order + N,
+                                 d_order,
+                                 0u,
+                                 thrust::plus<unsigned int>(),
+                                 NotSuccessor());
+    }
 } // end namespace gpu
 } // end namespace mpcd
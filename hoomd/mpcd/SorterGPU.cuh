@@ -13,6 +13,7 @@
 
 #include <cuda_runtime.h>
 
+#include "ParticleDataUtilities.h"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
 
@@ -20,17 +21,6 @@ namespace mpcd
 {
 namespace gpu
 {
-//! Kernel driver to apply sorted particle order
-cudaError_t sort_apply(Scalar4 *d_pos_alt,
-                       Scalar4 *d_vel_alt,
-                       unsigned int *d_tag_alt,
-                       const Scalar4 *d_pos,
-                       const Scalar4 *d_vel,
-                       const unsigned int *d_tag,
-                       const unsigned int *d_order,
-                       const unsigned int N,
-                       const unsigned int block_size);
-
 //! Kernel driver to fill empty cell list entries with sentinel
 cudaError_t sort_set_sentinel(unsigned int *d_cell_list,
                               const unsigned int *d_cell_np,
@@ -49,6 +39,10 @@ cudaError_t sort_gen_reverse(unsigned int *d_rorder,
                              const unsigned int *d_order,
                              const unsigned int N,
                              const unsigned int block_size);
+
+//! Driver for thrust to count the out of order particles
+unsigned int sort_count_disorder(const unsigned int *d_order,
+                                 const unsigned int N);
 } // end namespace gpu
 } // end namespace mpcd
 
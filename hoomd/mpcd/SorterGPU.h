@@ -58,6 +58,9 @@ class PYBIND11_EXPORT SorterGPU : public mpcd::Sorter
 
         //! Apply the sorting order on the GPU
         virtual void applyOrder() const;
+
+        //! Count the out of order particles on the GPU
+        virtual unsigned int countDisorder() const;
     };
 
 namespace detail
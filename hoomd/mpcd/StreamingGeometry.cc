@@ -10,6 +10,8 @@
 
 #include "StreamingGeometry.h"
 
+#include <pybind11/stl.h>
+
 namespace mpcd
 {
 namespace detail
@@ -50,5 +52,13 @@ void export_SlitPoreGeometry(pybind11::module& m)
         .def("getBoundaryCondition", &SlitPoreGeometry::getBoundaryCondition);
     }
 
+void export_SDFGeometry(pybind11::module& m)
+    {
+    namespace py = pybind11;
+    py::class_<SDFGeometry, std::shared_ptr<SDFGeometry> >(m, "SDFGeometry")
+        .def(py::init(&SDFGeometry::create))
+        .def("getBoundaryCondition", &SDFGeometry::getBoundaryCondition);
+    }
+
 } // end namespace detail
 } // end namespace mpcd
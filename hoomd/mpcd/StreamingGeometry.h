@@ -13,6 +13,7 @@
 
 #include "BoundaryCondition.h"
 #include "BulkGeometry.h"
+#include "SDFGeometry.h"
 #include "SlitGeometry.h"
 #include "SlitPoreGeometry.h"
 
@@ -35,6 +36,9 @@ void export_SlitGeometry(pybind11::module& m);
 //! Export SlitPoreGeometry to python
 void export_SlitPoreGeometry(pybind11::module& m);
 
+//! Export SDFGeometry to python
+void export_SDFGeometry(pybind11::module& m);
+
 } // end namespace detail
 } // end namespace mpcd
 
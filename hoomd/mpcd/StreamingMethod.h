@@ -43,6 +43,21 @@ class PYBIND11_EXPORT StreamingMethod
         //! Implementation of the streaming rule
         virtual void stream(unsigned int timestep) { }
 
+        //! Stream the particles and bin them into the cell list
+        /*!
+         * \param timestep Current time to stream
+         * \param bin_timestep Timestep the cell list is binned for
+         * \returns True if the cell list was built for \a bin_timestep
+         *
+         * Derived classes that can bin the particles as they are streamed should override this method.
+         * By default, the particles are only streamed and the cell list is built later by compute().
+         */
+        virtual bool streamAndBin(unsigned int timestep, unsigned int bin_timestep)
+            {
+            stream(timestep);
+            return false;
+            }
+
         //! Peek if the next step requires streaming
         virtual bool peekStream(unsigned int timestep) const;
 
@@ -97,6 +112,12 @@ class PYBIND11_EXPORT StreamingMethod
         //! Set the period of the streaming method
         void setPeriod(unsigned int cur_timestep, unsigned int period);
 
+        //! Get the period of the streaming method
+        unsigned int getPeriod() const
+            {
+            return m_period;
+            }
+
     protected:
         std::shared_ptr<mpcd::SystemData> m_mpcd_sys;                   //!< MPCD system data
         std::shared_ptr<SystemDefinition> m_sysdef;                     //!< HOOMD system definition
@@ -9,6 +9,7 @@
  */
 
 #include "VirtualParticleFiller.h"
+#include "hoomd/RNGIdentifiers.h"
 
 mpcd::VirtualParticleFiller::VirtualParticleFiller(std::shared_ptr<mpcd::SystemData> sysdata,
                                                    Scalar density,
@@ -20,7 +21,8 @@ mpcd::VirtualParticleFiller::VirtualParticleFiller(std::shared_ptr<mpcd::SystemD
       m_exec_conf(m_pdata->getExecConf()),
       m_mpcd_pdata(sysdata->getParticleData()),
       m_cl(sysdata->getCellList()),
-      m_density(density), m_type(type), m_T(T), m_seed(seed), m_N_fill(0), m_first_tag(0)
+      m_density(density), m_type(type), m_T(T), m_seed(seed), m_N_fill(0), m_first_tag(0),
+      m_num_fill_boxes(0)
     {
     #ifdef ENABLE_MPI
     // synchronize seed from root across all ranks in MPI in case users has seeded from system time or entropy
@@ -57,6 +59,88 @@ void mpcd::VirtualParticleFiller::fill(unsigned int timestep)
     m_mpcd_pdata->invalidateCellCache();
     }
 
+/*!
+ * \param cell_vel Momentum and mass of the virtual particles in each cell (output)
+ * \param cell_energy Kinetic energy and number of the virtual particles in each cell (output)
+ * \param timestep Current timestep
+ * \param thermal_only If true, the virtual particles do not carry the mean velocity of their fill box
+ *
+ * The contributions are added to \a cell_vel and \a cell_energy, which must be sized to the current cells.
+ * No particles are added to the particle data.
+ */
+void mpcd::VirtualParticleFiller::fillCells(GPUArray<double4>& cell_vel,
+                                            GPUArray<double2>& cell_energy,
+                                            unsigned int timestep,
+                                            bool thermal_only)
+    {
+    // update the fill volume
+    computeNumFill();
+    if (m_num_fill_boxes == 0) return;
+
+    if (m_prof) m_prof->push(m_exec_conf, "MPCD fill");
+    drawCells(cell_vel, cell_energy, timestep, thermal_only);
+    if (m_prof) m_prof->pop(m_exec_conf);
+    }
+
+/*!
+ * \param cell_vel Momentum and mass of the virtual particles in each cell (output)
+ * \param cell_energy Kinetic energy and number of the virtual particles in each cell (output)
+ * \param timestep Current timestep
+ * \param thermal_only If true, the virtual particles do not carry the mean velocity of their fill box
+ */
+void mpcd::VirtualParticleFiller::drawCells(GPUArray<double4>& cell_vel,
+                                            GPUArray<double2>& cell_energy,
+                                            unsigned int timestep,
+                                            bool thermal_only)
+    {
+    ArrayHandle<double4> h_cell_vel(cell_vel, access_location::host, access_mode::readwrite);
+    ArrayHandle<double2> h_cell_energy(cell_energy, access_location::host, access_mode::readwrite);
+    ArrayHandle<mpcd::detail::VirtualFillBox> h_boxes(m_fill_boxes, access_location::host, access_mode::read);
+
+    // lower corner of the first local cell
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const Scalar cell_size = m_cl->getCellSize();
+    const int3 origin = m_cl->getOriginIndex();
+    const Scalar3 first_lo = global_box.getLo() + m_cl->getGridShift()
+                           + cell_size * make_scalar3(origin.x, origin.y, origin.z);
+    const Scalar3 L = global_box.getL();
+    const uchar3 periodic = m_pdata->getBox().getPeriodic();
+
+    const Scalar kT = (*m_T)(timestep);
+    const Scalar mass = m_mpcd_pdata->getMass();
+    const unsigned int ndim = m_sysdef->getNDimensions();
+    const unsigned int stream = (m_exec_conf->getRank() << 1) | thermal_only;
+
+    const Index3D& ci = m_cl->getCellIndexer();
+    for (unsigned int k=0; k < ci.getD(); ++k)
+        {
+        for (unsigned int j=0; j < ci.getH(); ++j)
+            {
+            for (unsigned int i=0; i < ci.getW(); ++i)
+                {
+                const unsigned int cell = ci(i,j,k);
+                const Scalar3 cell_lo = first_lo + cell_size * make_scalar3(i,j,k);
+
+                hoomd::RandomGenerator rng(hoomd::RNGIdentifier::VirtualParticleFiller, m_seed, cell, timestep, stream);
+                mpcd::detail::fill_cell(h_cell_vel.data[cell],
+                                        h_cell_energy.data[cell],
+                                        cell_lo,
+                                        cell_size,
+                                        L,
+                                        periodic,
+                                        h_boxes.data,
+                                        m_num_fill_boxes,
+                                        m_density,
+                                        mass,
+                                        kT,
+                                        ndim,
+                                        rng,
+                                        thermal_only);
+                }
+            }
+        }
+    }
+
 void mpcd::VirtualParticleFiller::setDensity(Scalar density)
     {
     if (density <= Scalar(0.0))
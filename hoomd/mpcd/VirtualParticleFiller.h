@@ -16,6 +16,7 @@
 #endif
 
 #include "SystemData.h"
+#include "VirtualParticleFillerUtilities.h"
 #include "hoomd/Variant.h"
 #include <pybind11/pybind11.h>
 
@@ -30,6 +31,10 @@ namespace mpcd
  * particle data. Each deriving class must then implement two methods:
  *  1. computeNumFill(), which is the number of virtual particles to add.
  *  2. drawParticles(), which is the rule to determine where to put the particles.
+ *
+ * Inserting the particles every collision is costly, so fillCells() adds the virtual particles to the cell properties
+ * without inserting them. computeNumFill() must then also set the boxes that are filled, m_fill_boxes, and the
+ * contributions of these boxes to each cell are drawn by drawCells().
  */
 class PYBIND11_EXPORT VirtualParticleFiller
     {
@@ -45,6 +50,12 @@ class PYBIND11_EXPORT VirtualParticleFiller
         //! Fill up virtual particles
         void fill(unsigned int timestep);
 
+        //! Add the virtual particles to the cell properties
+        void fillCells(GPUArray<double4>& cell_vel,
+                       GPUArray<double2>& cell_energy,
+                       unsigned int timestep,
+                       bool thermal_only);
+
         //! Sets the profiler for the integration method to use
         virtual void setProfiler(std::shared_ptr<Profiler> prof)
             {
@@ -95,11 +106,20 @@ class PYBIND11_EXPORT VirtualParticleFiller
         unsigned int m_N_fill;      //!< Number of particles to fill locally
         unsigned int m_first_tag;   //!< First tag of locally held particles
 
+        GPUArray<mpcd::detail::VirtualFillBox> m_fill_boxes;    //!< Boxes filled with virtual particles
+        unsigned int m_num_fill_boxes;                          //!< Number of boxes filled locally
+
         //! Compute the total number of particles to fill
         virtual void computeNumFill() {}
 
         //! Draw particles within the fill volume
         virtual void drawParticles(unsigned int timestep) {}
+
+        //! Draw the contributions of the virtual particles to the cell properties
+        virtual void drawCells(GPUArray<double4>& cell_vel,
+                               GPUArray<double2>& cell_energy,
+                               unsigned int timestep,
+                               bool thermal_only);
     };
 
 namespace detail
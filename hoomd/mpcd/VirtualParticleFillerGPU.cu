@@ -0,0 +1,178 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: mphoward
+
+/*!
+ * \file mpcd/VirtualParticleFillerGPU.cu
+ * \brief Defines GPU functions and kernels for filling cells with virtual particles
+ */
+
+#include "VirtualParticleFillerGPU.cuh"
+#include "hoomd/RandomNumbers.h"
+#include "hoomd/RNGIdentifiers.h"
+
+namespace mpcd
+{
+namespace gpu
+{
+namespace kernel
+{
+/*!
+ * \param d_cell_vel Momentum and mass of the virtual particles in each cell (output)
+ * \param d_cell_energy Kinetic energy and number of the virtual particles in each cell (output)
+ * \param ci Cell indexer
+ * \param first_lo Lower corner of the first local cell
+ * \param cell_size Edge length of a cell
+ * \param L Global box length
+ * \param periodic Flags if the cells wrap through the box
+ * \param d_boxes Fill boxes
+ * \param num_boxes Number of fill boxes
+ * \param density Number density of the virtual particles
+ * \param mass Mass of a virtual particle
+ * \param kT Temperature of the virtual particles
+ * \param ndim Number of dimensions
+ * \param timestep Current timestep
+ * \param seed User seed to PRNG
+ * \param stream Additional counter to PRNG (rank and \a thermal_only)
+ * \param thermal_only If true, the mean velocity of the fill boxes is not added to the momentum
+ *
+ * \b Implementation:
+ *
+ * Using one thread per cell, the overlap of the cell with the fill boxes is computed, and the contribution of the
+ * virtual particles in this volume is added to the cell. The fill boxes are read by every thread, so they are
+ * staged in shared memory.
+ */
+__global__ void fill_virtual_cells(double4 *d_cell_vel,
+                                   double2 *d_cell_energy,
+                                   const Index3D ci,
+                                   const Scalar3 first_lo,
+                                   const Scalar cell_size,
+                                   const Scalar3 L,
+                                   const uchar3 periodic,
+                                   const mpcd::detail::VirtualFillBox *d_boxes,
+                                   const unsigned int num_boxes,
+                                   const Scalar density,
+                                   const Scalar mass,
+                                   const Scalar kT,
+                                   const unsigned int ndim,
+                                   const unsigned int timestep,
+                                   const unsigned int seed,
+                                   const unsigned int stream,
+                                   const bool thermal_only)
+    {
+    extern __shared__ mpcd::detail::VirtualFillBox s_boxes[];
+    for (unsigned int cur_offset = 0; cur_offset < num_boxes; cur_offset += blockDim.x)
+        {
+        if (cur_offset + threadIdx.x < num_boxes)
+            s_boxes[cur_offset + threadIdx.x] = d_boxes[cur_offset + threadIdx.x];
+        }
+    __syncthreads();
+
+    // one thread per cell
+    const unsigned int cell = blockIdx.x * blockDim.x + threadIdx.x;
+    if (cell >= ci.getNumElements())
+        return;
+
+    const uint3 cell_idx = ci.getTriple(cell);
+    const Scalar3 cell_lo = first_lo + cell_size * make_scalar3(cell_idx.x, cell_idx.y, cell_idx.z);
+
+    double4 momentum = d_cell_vel[cell];
+    double2 energy = d_cell_energy[cell];
+    hoomd::RandomGenerator rng(hoomd::RNGIdentifier::VirtualParticleFiller, seed, cell, timestep, stream);
+    mpcd::detail::fill_cell(momentum,
+                            energy,
+                            cell_lo,
+                            cell_size,
+                            L,
+                            periodic,
+                            s_boxes,
+                            num_boxes,
+                            density,
+                            mass,
+                            kT,
+                            ndim,
+                            rng,
+                            thermal_only);
+    d_cell_vel[cell] = momentum;
+    d_cell_energy[cell] = energy;
+    }
+} // end namespace kernel
+
+/*!
+ * \param d_cell_vel Momentum and mass of the virtual particles in each cell (output)
+ * \param d_cell_energy Kinetic energy and number of the virtual particles in each cell (output)
+ * \param ci Cell indexer
+ * \param first_lo Lower corner of the first local cell
+ * \param cell_size Edge length of a cell
+ * \param L Global box length
+ * \param periodic Flags if the cells wrap through the box
+ * \param d_boxes Fill boxes
+ * \param num_boxes Number of fill boxes
+ * \param density Number density of the virtual particles
+ * \param mass Mass of a virtual particle
+ * \param kT Temperature of the virtual particles
+ * \param ndim Number of dimensions
+ * \param timestep Current timestep
+ * \param seed User seed to PRNG
+ * \param stream Additional counter to PRNG (rank and \a thermal_only)
+ * \param thermal_only If true, the mean velocity of the fill boxes is not added to the momentum
+ * \param block_size Number of threads per block
+ *
+ * \sa kernel::fill_virtual_cells
+ */
+cudaError_t fill_virtual_cells(double4 *d_cell_vel,
+                               double2 *d_cell_energy,
+                               const Index3D& ci,
+                               const Scalar3& first_lo,
+                               const Scalar cell_size,
+                               const Scalar3& L,
+                               const uchar3& periodic,
+                               const mpcd::detail::VirtualFillBox *d_boxes,
+                               const unsigned int num_boxes,
+                               const Scalar density,
+                               const Scalar mass,
+                               const Scalar kT,
+                               const unsigned int ndim,
+                               const unsigned int timestep,
+                               const unsigned int seed,
+                               const unsigned int stream,
+                               const bool thermal_only,
+                               const unsigned int block_size)
+    {
+    if (num_boxes == 0 || ci.getNumElements() == 0) return cudaSuccess;
+
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        cudaFuncAttributes attr;
+        cudaFuncGetAttributes(&attr, (const void*)kernel::fill_virtual_cells);
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    dim3 grid(ci.getNumElements() / run_block_size + 1);
+    const size_t shared_bytes = num_boxes * sizeof(mpcd::detail::VirtualFillBox);
+    kernel::fill_virtual_cells<<<grid, run_block_size, shared_bytes>>>(d_cell_vel,
+                                                                       d_cell_energy,
+                                                                       ci,
+                                                                       first_lo,
+                                                                       cell_size,
+                                                                       L,
+                                                                       periodic,
+                                                                       d_boxes,
+                                                                       num_boxes,
+                                                                       density,
+                                                                       mass,
+                                                                       kT,
+                                                                       ndim,
+                                                                       timestep,
+                                                                       seed,
+                                                                       stream,
+                                                                       thermal_only);
+
+    return cudaSuccess;
+    }
+
+} // end namespace gpu
+} // end namespace mpcd
@@ -0,0 +1,48 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: mphoward
+
+#ifndef MPCD_VIRTUAL_PARTICLE_FILLER_GPU_CUH_
+#define MPCD_VIRTUAL_PARTICLE_FILLER_GPU_CUH_
+
+/*!
+ * \file mpcd/VirtualParticleFillerGPU.cuh
+ * \brief Declaration of CUDA kernels for filling cells with virtual particles
+ */
+
+#include <cuda_runtime.h>
+
+#include "VirtualParticleFillerUtilities.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/Index1D.h"
+
+namespace mpcd
+{
+namespace gpu
+{
+
+//! Add the virtual particles in the fill boxes to the cell properties
+cudaError_t fill_virtual_cells(double4 *d_cell_vel,
+                               double2 *d_cell_energy,
+                               const Index3D& ci,
+                               const Scalar3& first_lo,
+                               const Scalar cell_size,
+                               const Scalar3& L,
+                               const uchar3& periodic,
+                               const mpcd::detail::VirtualFillBox *d_boxes,
+                               const unsigned int num_boxes,
+                               const Scalar density,
+                               const Scalar mass,
+                               const Scalar kT,
+                               const unsigned int ndim,
+                               const unsigned int timestep,
+                               const unsigned int seed,
+                               const unsigned int stream,
+                               const bool thermal_only,
+                               const unsigned int block_size);
+
+} // end namespace gpu
+} // end namespace mpcd
+
+#endif // MPCD_VIRTUAL_PARTICLE_FILLER_GPU_CUH_
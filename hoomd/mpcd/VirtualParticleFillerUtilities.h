@@ -0,0 +1,148 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: mphoward
+
+#ifndef MPCD_VIRTUAL_PARTICLE_FILLER_UTILITIES_H_
+#define MPCD_VIRTUAL_PARTICLE_FILLER_UTILITIES_H_
+
+/*!
+ * \file mpcd/VirtualParticleFillerUtilities.h
+ * \brief Utilities for filling cells with virtual particles on the CPU and GPU
+ */
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/RandomNumbers.h"
+
+// DEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#ifdef __HIPCC__
+#define DEVICE __host__ __device__
+#else
+#define DEVICE
+#endif
+
+namespace mpcd
+{
+namespace detail
+{
+//! Volume filled with virtual particles
+/*!
+ * The virtual particles in the box are uniformly distributed with a mean velocity \a vel.
+ */
+struct VirtualFillBox
+    {
+    Scalar3 lo;     //!< Lower corner of the box
+    Scalar3 hi;     //!< Upper corner of the box
+    Scalar3 vel;    //!< Mean velocity of the virtual particles
+    };
+
+//! Length of the overlap of a cell with an interval
+/*!
+ * \param c0 Lower edge of the cell
+ * \param c1 Upper edge of the cell
+ * \param f0 Lower edge of the interval
+ * \param f1 Upper edge of the interval
+ * \param L Box length
+ * \param periodic True if the cell wraps through the box in this direction
+ *
+ * Cells that are cut by a periodic boundary also overlap the interval through their images.
+ */
+DEVICE inline Scalar fill_overlap(const Scalar c0,
+                                  const Scalar c1,
+                                  const Scalar f0,
+                                  const Scalar f1,
+                                  const Scalar L,
+                                  const bool periodic)
+    {
+    Scalar overlap = fmax(Scalar(0.0), fmin(c1,f1) - fmax(c0,f0));
+    if (periodic)
+        {
+        overlap += fmax(Scalar(0.0), fmin(c1-L,f1) - fmax(c0-L,f0));
+        overlap += fmax(Scalar(0.0), fmin(c1+L,f1) - fmax(c0+L,f0));
+        }
+    return overlap;
+    }
+
+//! Adds the contribution of the virtual particles in the fill boxes to a cell
+/*!
+ * \param momentum Cell momentum and mass (input/output)
+ * \param energy Cell kinetic energy and number of particles (input/output)
+ * \param cell_lo Lower corner of the cell
+ * \param cell_size Edge length of the cell
+ * \param L Global box length
+ * \param periodic Flags if the cells wrap through the box
+ * \param boxes Fill boxes
+ * \param num_boxes Number of fill boxes
+ * \param density Number density of the virtual particles
+ * \param mass Mass of a virtual particle
+ * \param kT Temperature of the virtual particles
+ * \param ndim Number of dimensions
+ * \param rng Random number generator for this cell
+ * \param thermal_only If true, the mean velocity of the fill boxes is not added to the momentum
+ *
+ * The cell is filled with the average number of virtual particles, ρV, that fill() would insert into the overlap V
+ * of the cell with the fill boxes. The momentum of these particles is Gaussian, with the mean velocity of the boxes
+ * and variance M kT, where M is the mass of the virtual particles. Their kinetic energy relative to the center of
+ * mass is given by its average (D/2)(N-1) kT. The momentum is drawn, so the cell properties have the same statistics
+ * as if the particles had been inserted, but no particles are needed.
+ */
+DEVICE inline void fill_cell(double4& momentum,
+                             double2& energy,
+                             const Scalar3& cell_lo,
+                             const Scalar cell_size,
+                             const Scalar3& L,
+                             const uchar3& periodic,
+                             const mpcd::detail::VirtualFillBox *boxes,
+                             const unsigned int num_boxes,
+                             const Scalar density,
+                             const Scalar mass,
+                             const Scalar kT,
+                             const unsigned int ndim,
+                             hoomd::RandomGenerator& rng,
+                             const bool thermal_only)
+    {
+    const Scalar3 cell_hi = cell_lo + make_scalar3(cell_size, cell_size, cell_size);
+
+    Scalar volume(0.0);
+    Scalar3 vel_sum = make_scalar3(0.0, 0.0, 0.0);
+    for (unsigned int b=0; b < num_boxes; ++b)
+        {
+        const mpcd::detail::VirtualFillBox box = boxes[b];
+        const Scalar V = fill_overlap(cell_lo.x, cell_hi.x, box.lo.x, box.hi.x, L.x, periodic.x)
+                        *fill_overlap(cell_lo.y, cell_hi.y, box.lo.y, box.hi.y, L.y, periodic.y)
+                        *fill_overlap(cell_lo.z, cell_hi.z, box.lo.z, box.hi.z, L.z, periodic.z);
+        volume += V;
+        vel_sum += V * box.vel;
+        }
+    if (volume <= Scalar(0.0)) return;
+
+    const Scalar M = mass * density * volume;
+    const unsigned int np = (unsigned int)round(density * volume);
+
+    hoomd::NormalDistribution<Scalar> gen(fast::sqrt(M * kT), 0.0);
+    Scalar3 p;
+    gen(p.x, p.y, rng);
+    p.z = gen(rng);
+    if (!thermal_only)
+        {
+        p += (mass * density) * vel_sum;
+        }
+
+    momentum.x += p.x;
+    momentum.y += p.y;
+    momentum.z += p.z;
+    momentum.w += M;
+
+    double ke = 0.5 * dot(p,p) / M;
+    if (np > 1)
+        ke += 0.5 * ndim * (np-1) * kT;
+    energy.x += ke;
+    energy.y += np;
+    }
+
+} // end namespace detail
+} // end namespace mpcd
+
+#undef DEVICE
+
+#endif // MPCD_VIRTUAL_PARTICLE_FILLER_UTILITIES_H_
@@ -115,6 +115,8 @@ class integrator(hoomd.integrate._integrator):
                     advance the real time of the system forward by *dt* (in time units).
         aniso (bool): Whether to integrate rotational degrees of freedom (bool),
                       default None (autodetect).
+        fuse_cell_list (bool): If True, bin the MPCD particles into the cell
+                               list while they are streamed (default False).
 
     The MPCD integrator enables the MPCD algorithm concurrently with standard
     MD :py:mod:`~hoomd.md.methods` methods. An integrator must be created
@@ -139,13 +141,21 @@ class integrator(hoomd.integrate._integrator):
     The MD particles can be read at any time step because their positions
     are updated every step.
 
+    With *fuse_cell_list*, the streaming step also builds the cell list for
+    the next collision, which saves reading the MPCD particles again. The
+    cell list is still built separately when there are embedded particles,
+    when the cell list needs to be resized, or when the simulation is run on
+    more than one rank, because the particles migrate before each collision.
+    The results are the same either way.
+
     Examples::
 
         mpcd.integrator(dt=0.1)
         mpcd.integrator(dt=0.01, aniso=True)
+        mpcd.integrator(dt=0.1, fuse_cell_list=True)
 
     """
-    def __init__(self, dt, aniso=None):
+    def __init__(self, dt, aniso=None, fuse_cell_list=False):
         # check system is initialized
         if hoomd.context.current.mpcd is None:
             hoomd.context.current.device.cpp_msg.error('mpcd.integrate: an MPCD system must be initialized before the integrator\n')
@@ -156,12 +166,14 @@ class integrator(hoomd.integrate._integrator):
         self.supports_methods = True
         self.dt = dt
         self.aniso = aniso
-        self.metadata_fields = ['dt','aniso']
+        self.fuse_cell_list = fuse_cell_list
+        self.metadata_fields = ['dt','aniso','fuse_cell_list']
 
         # configure C++ integrator
         self.cpp_integrator = _mpcd.Integrator(hoomd.context.current.mpcd.data, self.dt)
         if hoomd.context.current.mpcd.comm is not None:
             self.cpp_integrator.setMPCDCommunicator(hoomd.context.current.mpcd.comm)
+        self.cpp_integrator.setFuseCellList(self.fuse_cell_list)
         hoomd.context.current.system.setIntegrator(self.cpp_integrator)
 
         if self.aniso is not None:
@@ -172,17 +184,19 @@ class integrator(hoomd.integrate._integrator):
         True: _md.IntegratorAnisotropicMode.Anisotropic,
         False: _md.IntegratorAnisotropicMode.Isotropic}
 
-    def set_params(self, dt=None, aniso=None):
+    def set_params(self, dt=None, aniso=None, fuse_cell_list=None):
         """ Changes parameters of an existing integration mode.
 
         Args:
             dt (float): New time step delta (if set) (in time units).
             aniso (bool): Anisotropic integration mode (bool), default None (autodetect).
+            fuse_cell_list (bool): Bin the MPCD particles into the cell list while they are streamed (if set).
 
         Examples::
 
             integrator.set_params(dt=0.007)
             integrator.set_params(dt=0.005, aniso=False)
+            integrator.set_params(fuse_cell_list=True)
 
         """
         self.check_initialization()
@@ -201,6 +215,10 @@ class integrator(hoomd.integrate._integrator):
             self.aniso = aniso
             self.cpp_integrator.setAnisotropicMode(anisoMode)
 
+        if fuse_cell_list is not None:
+            self.fuse_cell_list = fuse_cell_list
+            self.cpp_integrator.setFuseCellList(fuse_cell_list)
+
     def update_methods(self):
         self.check_initialization()
 
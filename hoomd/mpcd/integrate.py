@@ -39,6 +39,7 @@ import hoomd
 from hoomd import _hoomd
 
 from . import _mpcd
+from .stream import _sdf_geometry
 
 class _bounce_back(hoomd.integrate._integration_method):
     """ NVE integration with bounce-back rules.
@@ -231,3 +232,61 @@ class slit_pore(_bounce_back):
 
         bc = self._process_boundary(self.boundary)
         self.cpp_method.geometry = _mpcd.SlitPoreGeometry(self.H,self.L,bc)
+
+class sdf(_bounce_back):
+    """ NVE integration with bounce-back rules in a signed distance field geometry.
+
+    Args:
+        group (``hoomd.group``): Group of particles on which to apply this method.
+        sdf (array): signed distance at the grid points, with shape (nx, ny, nz).
+        boundary : 'slip' or 'no_slip' boundary condition at wall (default: 'no_slip')
+
+    This integration method applies to particles in *group* in a geometry defined by a
+    signed distance field. This method is the MD analog of :py:class:`.stream.sdf`, which
+    documents additional details about the geometry.
+
+    Examples::
+
+        all = group.all()
+        sdf = mpcd.integrate.sdf(group=all, sdf=phi)
+
+    """
+    def __init__(self, group, sdf, boundary="no_slip"):
+        # initialize base class
+        _bounce_back.__init__(self,group)
+
+        # initialize the c++ class
+        if not hoomd.context.current.device.mode == 'gpu':
+            cpp_class = _mpcd.BounceBackNVESDF
+        else:
+            cpp_class = _mpcd.BounceBackNVESDFGPU
+
+        self.sdf = sdf
+        self.boundary = boundary
+
+        bc = self._process_boundary(boundary)
+        geom = _sdf_geometry(sdf, bc)
+
+        self.cpp_method = cpp_class(hoomd.context.current.system_definition, group.cpp_group, geom)
+        self.cpp_method.validateGroup()
+
+    def set_params(self, sdf=None, boundary=None):
+        """ Set parameters for the signed distance field geometry.
+
+        Args:
+            sdf (array): signed distance at the grid points, with shape (nx, ny, nz).
+            boundary : 'slip' or 'no_slip' boundary condition at wall (default: 'no_slip')
+
+        Examples::
+
+            sdf.set_params(boundary='slip')
+
+        """
+        if sdf is not None:
+            self.sdf = sdf
+
+        if boundary is not None:
+            self.boundary = boundary
+
+        bc = self._process_boundary(self.boundary)
+        self.cpp_method.geometry = _sdf_geometry(self.sdf, bc)
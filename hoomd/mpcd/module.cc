@@ -139,23 +139,28 @@ PYBIND11_MODULE(_mpcd, m)
     mpcd::detail::export_BulkGeometry(m);
     mpcd::detail::export_SlitGeometry(m);
     mpcd::detail::export_SlitPoreGeometry(m);
+    mpcd::detail::export_SDFGeometry(m);
 
     mpcd::detail::export_StreamingMethod(m);
     mpcd::detail::export_ExternalFieldPolymorph(m);
     mpcd::detail::export_ConfinedStreamingMethod<mpcd::detail::BulkGeometry>(m);
     mpcd::detail::export_ConfinedStreamingMethod<mpcd::detail::SlitGeometry>(m);
     mpcd::detail::export_ConfinedStreamingMethod<mpcd::detail::SlitPoreGeometry>(m);
+    mpcd::detail::export_ConfinedStreamingMethod<mpcd::detail::SDFGeometry>(m);
     #ifdef ENABLE_HIP
     mpcd::detail::export_ConfinedStreamingMethodGPU<mpcd::detail::BulkGeometry>(m);
     mpcd::detail::export_ConfinedStreamingMethodGPU<mpcd::detail::SlitGeometry>(m);
     mpcd::detail::export_ConfinedStreamingMethodGPU<mpcd::detail::SlitPoreGeometry>(m);
+    mpcd::detail::export_ConfinedStreamingMethodGPU<mpcd::detail::SDFGeometry>(m);
     #endif // ENABLE_HIP
 
     mpcd::detail::export_BounceBackNVE<mpcd::detail::SlitGeometry>(m);
     mpcd::detail::export_BounceBackNVE<mpcd::detail::SlitPoreGeometry>(m);
+    mpcd::detail::export_BounceBackNVE<mpcd::detail::SDFGeometry>(m);
     #ifdef ENABLE_HIP
     mpcd::detail::export_BounceBackNVEGPU<mpcd::detail::SlitGeometry>(m);
     mpcd::detail::export_BounceBackNVEGPU<mpcd::detail::SlitPoreGeometry>(m);
+    mpcd::detail::export_BounceBackNVEGPU<mpcd::detail::SDFGeometry>(m);
     #endif // ENABLE_HIP
 
     mpcd::detail::export_VirtualParticleFiller(m);
@@ -542,3 +542,103 @@ class slit_pore(_streaming_method):
         self._cpp.geometry = _mpcd.SlitPoreGeometry(self.H,self.L,bc)
         if self._filler is not None:
             self._filler.setGeometry(self._cpp.geometry)
+
+def _sdf_geometry(sdf, bc):
+    """ Make a signed distance field geometry spanning the global box
+
+    Args:
+        sdf (array): Signed distance at the grid points, shape (nx, ny, nz).
+        bc: Boundary condition enum.
+
+    """
+    import numpy
+    sdf = numpy.asarray(sdf, dtype=numpy.float64)
+    if sdf.ndim != 3:
+        hoomd.context.current.device.cpp_msg.error('mpcd: signed distance field must be a 3D array\n')
+        raise ValueError('Signed distance field must be a 3D array')
+
+    nx, ny, nz = sdf.shape
+    box = hoomd.context.current.system_definition.getParticleData().getGlobalBox()
+    return _mpcd.SDFGeometry(hoomd.context.current.device.cpp_exec_conf,
+                             sdf.flatten(order='F').tolist(),
+                             nx, ny, nz,
+                             box,
+                             bc)
+
+class sdf(_streaming_method):
+    r""" Signed distance field streaming geometry.
+
+    Args:
+        sdf (array): signed distance at the grid points, with shape (nx, ny, nz)
+        boundary (str): boundary condition at wall ("slip" or "no_slip"")
+        period (int): Number of integration steps between collisions
+
+    The signed distance field geometry confines the fluid by walls of any shape,
+    such as a porous medium. The walls are given by a signed distance
+    :math:`\phi` that is negative in the fluid and positive in the walls,
+    sampled on a regular grid that spans the periodic simulation box. Grid
+    point :math:`(i,j,k)` lies at :math:`\mathbf{r}_{\rm lo} + (i h_x, j h_y, k h_z)`,
+    where :math:`\mathbf{r}_{\rm lo}` is the lower corner of the box and
+    :math:`h_x = L_x/n_x` (etc.) is the grid spacing. The distance is trilinearly
+    interpolated between the grid points, and the surface of the walls is where
+    the interpolated distance is zero.
+
+    The "inside" of the :py:class:`sdf` is the space where :math:`\phi \le 0`.
+
+    The walls are periodic with the grid, so the box does not need to be padded,
+    but it must not change after the geometry is created. The walls are
+    stationary. Virtual particles cannot be added to this geometry.
+
+    Example::
+
+        x = numpy.linspace(-L/2, L/2, 64, endpoint=False)
+        X, Y, Z = numpy.meshgrid(x, x, x, indexing='ij')
+        # fluid outside a sphere of radius 5 at the origin
+        phi = 5.0 - numpy.sqrt(X**2 + Y**2 + Z**2)
+        stream.sdf(sdf=phi, period=1)
+
+    """
+    def __init__(self, sdf, boundary="no_slip", period=1):
+
+        _streaming_method.__init__(self, period)
+
+        self.sdf = sdf
+        self.boundary = boundary
+
+        bc = self._process_boundary(boundary)
+
+        # create the base streaming class
+        if not hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
+            stream_class = _mpcd.ConfinedStreamingMethodSDF
+        else:
+            stream_class = _mpcd.ConfinedStreamingMethodGPUSDF
+        self._cpp = stream_class(hoomd.context.current.mpcd.data,
+                                 hoomd.context.current.system.getCurrentTimeStep(),
+                                 self.period,
+                                 0,
+                                 _sdf_geometry(sdf, bc))
+
+    def set_params(self, sdf=None, boundary=None):
+        """ Set parameters for the signed distance field geometry.
+
+        Args:
+            sdf (array): signed distance at the grid points, with shape (nx, ny, nz)
+            boundary (str): boundary condition at wall ("slip" or "no_slip"")
+
+        Changing any of these parameters will require the geometry to be
+        constructed and validated, so do not change these too often.
+
+        Examples::
+
+            sdf.set_params(boundary="slip")
+
+        """
+
+        if sdf is not None:
+            self.sdf = sdf
+
+        if boundary is not None:
+            self.boundary = boundary
+
+        bc = self._process_boundary(self.boundary)
+        self._cpp.geometry = _sdf_geometry(self.sdf, bc)
@@ -162,7 +162,7 @@ void cell_thermo_basic_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
 
     // scale all particles so that they move into one common cell
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
         for (unsigned int i=0; i < pdata->getN(); ++i)
             {
             h_pos.data[i].x *= 0.25;
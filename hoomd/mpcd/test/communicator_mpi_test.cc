@@ -227,7 +227,7 @@ void test_communicator_migrate(communicator_creator comm_creator, std::shared_pt
 
     // move particles to new ranks
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
 
         Scalar3 new_pos;
         switch(my_rank)
@@ -334,7 +334,7 @@ void test_communicator_migrate(communicator_creator comm_creator, std::shared_pt
 
     // move particles through the global boundary
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
 
         Scalar3 new_pos;
         switch(my_rank)
@@ -593,7 +593,7 @@ void test_communicator_migrate_ortho(communicator_creator comm_creator, std::sha
 
     // move particles to new ranks
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
 
         Scalar3 new_pos;
         switch(exec_conf->getRank())
@@ -645,7 +645,7 @@ void test_communicator_migrate_ortho(communicator_creator comm_creator, std::sha
     // move all particles onto domains 5 and 6
     const unsigned int rank = exec_conf->getRank();
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
 
         // just get them all in the same place
         // this first set will put tags 7, 0, 3, and 4 on rank 5
@@ -676,7 +676,7 @@ void test_communicator_migrate_ortho(communicator_creator comm_creator, std::sha
 
     // now send multiple particles out from each rank in different directions
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
         if (rank == 5)
             {
             // send one particle to rank 6, rank 4, and rank 0
@@ -47,8 +47,8 @@ void slit_fill_basic_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
     UP_ASSERT_EQUAL(pdata->getNVirtual(), 2*(2*20*20)*2);
     // count that particles have been placed on the right sides
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<MPCDReal4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
         ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
 
         // ensure first particle did not get overwritten
@@ -66,7 +66,7 @@ void slit_fill_basic_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
             // tag should equal index on one rank with one filler
             UP_ASSERT_EQUAL(h_tag.data[i], i);
             // type should be set
-            UP_ASSERT_EQUAL(__scalar_as_int(h_pos.data[i].w), 1);
+            UP_ASSERT_EQUAL(__mpcdreal_as_int(h_pos.data[i].w), 1);
 
             const Scalar z = h_pos.data[i].z;
             if (z < Scalar(-5.0))
@@ -85,8 +85,8 @@ void slit_fill_basic_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
     UP_ASSERT_EQUAL(pdata->getNVirtual(), 2*2*(2*20*20)*2);
     // count that particles have been placed on the right sides
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<MPCDReal4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
         ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
 
         unsigned int N_lo(0), N_hi(0);
@@ -115,7 +115,7 @@ void slit_fill_basic_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
     UP_ASSERT_EQUAL(pdata->getNVirtual(), 2*(20*20/2)*2);
     // count that particles have been placed on the right sides
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
         unsigned int N_lo(0), N_hi(0);
         for (unsigned int i=pdata->getN(); i < pdata->getN() + pdata->getNVirtual(); ++i)
             {
@@ -142,13 +142,13 @@ void slit_fill_basic_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
         pdata->removeVirtualParticles();
         filler->fill(3+t);
 
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<MPCDReal4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
 
         for (unsigned int i=pdata->getN(); i < pdata->getN() + pdata->getNVirtual(); ++i)
             {
             const Scalar z = h_pos.data[i].z;
-            const Scalar4 vel_cell = h_vel.data[i];
+            const MPCDReal4 vel_cell = h_vel.data[i];
             const Scalar3 vel = make_scalar3(vel_cell.x, vel_cell.y, vel_cell.z);
             if (z < Scalar(-5.0))
                 {
@@ -178,6 +178,121 @@ void slit_fill_basic_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
     CHECK_CLOSE(T_avg, 1.5, tol);
     }
 
+template<class F>
+void slit_fill_cells_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap( new SnapshotSystemData<Scalar>() );
+    snap->global_box = BoxDim(20.0);
+    snap->particle_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    auto mpcd_sys_snap = std::make_shared<mpcd::SystemDataSnapshot>(sysdef);
+    auto mpcd_sys = std::make_shared<mpcd::SystemData>(mpcd_sys_snap);
+    auto pdata = mpcd_sys->getParticleData();
+    auto cl = mpcd_sys->getCellList();
+    cl->setCellSize(2.0);
+    cl->compute(0);
+
+    // create slit channel with half width 5
+    auto slit = std::make_shared<const mpcd::detail::SlitGeometry>(5.0, 1.0, mpcd::detail::boundary::no_slip);
+    std::shared_ptr<::Variant> kT = std::make_shared<::VariantConstant>(1.5);
+    std::shared_ptr<mpcd::SlitGeometryFiller> filler = std::make_shared<F>(mpcd_sys, 2.0, 1, kT, 42, slit);
+
+    const Index3D& ci = cl->getCellIndexer();
+    GPUArray<double4> cell_vel(ci.getNumElements(), exec_conf);
+    GPUArray<double2> cell_energy(ci.getNumElements(), exec_conf);
+
+    /*
+     * The fill volume is 7->5 and 5->7, which covers half of the cells 1, 2, 7, and 8 in z without a grid shift.
+     * Each of these cells gets 2 * 2 * 2 * 1 = 8 virtual particles, and no particles are inserted.
+     */
+    Scalar3 p_lo = make_scalar3(0,0,0);
+    Scalar3 p_hi = make_scalar3(0,0,0);
+    Scalar ke_avg(0);
+    const unsigned int num_steps = 100;
+    for (unsigned int t=0; t < num_steps; ++t)
+        {
+            {
+            ArrayHandle<double4> h_cell_vel(cell_vel, access_location::host, access_mode::overwrite);
+            ArrayHandle<double2> h_cell_energy(cell_energy, access_location::host, access_mode::overwrite);
+            memset(h_cell_vel.data, 0, sizeof(double4)*ci.getNumElements());
+            memset(h_cell_energy.data, 0, sizeof(double2)*ci.getNumElements());
+            }
+        filler->fillCells(cell_vel, cell_energy, t, false);
+        UP_ASSERT_EQUAL(pdata->getNVirtual(), 0);
+
+        ArrayHandle<double4> h_cell_vel(cell_vel, access_location::host, access_mode::read);
+        ArrayHandle<double2> h_cell_energy(cell_energy, access_location::host, access_mode::read);
+        for (unsigned int k=0; k < ci.getD(); ++k)
+            {
+            const bool filled = (k == 1 || k == 2 || k == 7 || k == 8);
+            for (unsigned int j=0; j < ci.getH(); ++j)
+                {
+                for (unsigned int i=0; i < ci.getW(); ++i)
+                    {
+                    const unsigned int cell = ci(i,j,k);
+                    const double4 vel = h_cell_vel.data[cell];
+                    const double2 energy = h_cell_energy.data[cell];
+                    if (filled)
+                        {
+                        CHECK_CLOSE(vel.w, 8.0, tol_small);
+                        CHECK_CLOSE(energy.y, 8.0, tol_small);
+                        ke_avg += energy.x;
+                        if (k < 5)
+                            p_lo += make_scalar3(vel.x, vel.y, vel.z);
+                        else
+                            p_hi += make_scalar3(vel.x, vel.y, vel.z);
+                        }
+                    else
+                        {
+                        CHECK_SMALL(vel.w, tol_small);
+                        CHECK_SMALL(energy.y, tol_small);
+                        }
+                    }
+                }
+            }
+        }
+    const unsigned int num_samples = num_steps*2*ci.getW()*ci.getH();
+    p_lo /= num_samples; p_hi /= num_samples; ke_avg /= 2*num_samples;
+
+    // momentum moves with the walls, and the kinetic energy is (1/2)(3 kT + M U^2) + (3/2)(N-1) kT
+    CHECK_CLOSE(p_lo.x, -8.0, tol);
+    CHECK_SMALL(p_lo.y, 0.1);
+    CHECK_SMALL(p_lo.z, 0.1);
+    CHECK_CLOSE(p_hi.x, 8.0, tol);
+    CHECK_SMALL(p_hi.y, 0.1);
+    CHECK_SMALL(p_hi.z, 0.1);
+    CHECK_CLOSE(ke_avg, 0.5*(3*1.5 + 8.0) + 1.5*7*1.5, tol);
+
+    /*
+     * Only the thermal part of the momentum is added for random velocities.
+     */
+    p_hi = make_scalar3(0,0,0);
+    for (unsigned int t=0; t < num_steps; ++t)
+        {
+            {
+            ArrayHandle<double4> h_cell_vel(cell_vel, access_location::host, access_mode::overwrite);
+            memset(h_cell_vel.data, 0, sizeof(double4)*ci.getNumElements());
+            }
+        filler->fillCells(cell_vel, cell_energy, t, true);
+
+        ArrayHandle<double4> h_cell_vel(cell_vel, access_location::host, access_mode::read);
+        for (unsigned int j=0; j < ci.getH(); ++j)
+            {
+            for (unsigned int i=0; i < ci.getW(); ++i)
+                {
+                const double4 vel = h_cell_vel.data[ci(i,j,8)];
+                CHECK_CLOSE(vel.w, 8.0, tol_small);
+                p_hi += make_scalar3(vel.x, vel.y, vel.z);
+                }
+            }
+        }
+    p_hi /= num_steps*ci.getW()*ci.getH();
+    CHECK_SMALL(p_hi.x, 0.2);
+    CHECK_SMALL(p_hi.y, 0.2);
+    CHECK_SMALL(p_hi.z, 0.2);
+    }
+
 UP_TEST( slit_fill_basic )
     {
     slit_fill_basic_test<mpcd::SlitGeometryFiller>(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
@@ -188,3 +303,14 @@ UP_TEST( slit_fill_basic_gpu )
     slit_fill_basic_test<mpcd::SlitGeometryFillerGPU>(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::GPU));
     }
 #endif // ENABLE_HIP
+
+UP_TEST( slit_fill_cells )
+    {
+    slit_fill_cells_test<mpcd::SlitGeometryFiller>(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
+    }
+#ifdef ENABLE_HIP
+UP_TEST( slit_fill_cells_gpu )
+    {
+    slit_fill_cells_test<mpcd::SlitGeometryFillerGPU>(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::GPU));
+    }
+#endif // ENABLE_HIP
@@ -58,7 +58,7 @@ void slit_pore_fill_mpi_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
     // globally, all ranks should have particles (8x larger)
     UP_ASSERT_EQUAL(pdata->getNVirtualGlobal(), 2*2*(1*3+2*16+1*3)*20);
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
         ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
         const BoxDim& box = sysdef->getParticleData()->getBox();
         for (unsigned int i = 0; i < pdata->getNVirtual(); ++i)
@@ -50,7 +50,7 @@ void streaming_method_basic_test(std::shared_ptr<ExecutionConfiguration> exec_co
     stream->stream(2);
     std::shared_ptr<mpcd::ParticleData> pdata_2 = mpcd_sys->getParticleData();
         {
-        ArrayHandle<Scalar4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<MPCDReal4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::read);
         CHECK_CLOSE(h_pos.data[0].x, 1.0, tol);
         CHECK_CLOSE(h_pos.data[0].y, 4.85, tol);
         CHECK_CLOSE(h_pos.data[0].z, 3.0, tol);
@@ -64,7 +64,7 @@ void streaming_method_basic_test(std::shared_ptr<ExecutionConfiguration> exec_co
     UP_ASSERT(stream->peekStream(3));
     stream->stream(3);
         {
-        ArrayHandle<Scalar4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<MPCDReal4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::read);
         CHECK_CLOSE(h_pos.data[0].x, 1.1, tol);
         CHECK_CLOSE(h_pos.data[0].y, 4.95, tol);
         CHECK_CLOSE(h_pos.data[0].z, 3.1, tol);
@@ -80,7 +80,7 @@ void streaming_method_basic_test(std::shared_ptr<ExecutionConfiguration> exec_co
     UP_ASSERT(stream->peekStream(5));
     stream->stream(5);
         {
-        ArrayHandle<Scalar4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<MPCDReal4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::read);
         CHECK_CLOSE(h_pos.data[0].x, 1.2, tol);
         CHECK_CLOSE(h_pos.data[0].y, -4.95, tol);
         CHECK_CLOSE(h_pos.data[0].z, 3.2, tol);
@@ -94,7 +94,7 @@ void streaming_method_basic_test(std::shared_ptr<ExecutionConfiguration> exec_co
     stream->setDeltaT(0.1);
     stream->stream(7);
         {
-        ArrayHandle<Scalar4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<MPCDReal4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::read);
         CHECK_CLOSE(h_pos.data[0].x, 1.4, tol);
         CHECK_CLOSE(h_pos.data[0].y, -4.75, tol);
         CHECK_CLOSE(h_pos.data[0].z, 3.4, tol);
@@ -105,6 +105,170 @@ void streaming_method_basic_test(std::shared_ptr<ExecutionConfiguration> exec_co
         }
     }
 
+//! Test for streaming in the signed distance field geometry
+/*!
+ * The signed distance field of a slit, |z| - H, is exact on the grid, so the particles should be reflected
+ * from the walls as in the slit geometry.
+ */
+template<class SM>
+void streaming_method_sdf_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap( new SnapshotSystemData<Scalar>() );
+    snap->global_box = BoxDim(10.0);
+    snap->particle_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    // 2 particle system, both heading toward the upper wall
+    auto mpcd_sys_snap = std::make_shared<mpcd::SystemDataSnapshot>(sysdef);
+        {
+        auto mpcd_snap = mpcd_sys_snap->particles;
+        mpcd_snap->resize(2);
+
+        mpcd_snap->position[0] = vec3<Scalar>(0.0, 0.0, 3.0);
+        mpcd_snap->position[1] = vec3<Scalar>(1.0, -1.0, 2.0);
+
+        mpcd_snap->velocity[0] = vec3<Scalar>(1.0, 0.0, 1.0);
+        mpcd_snap->velocity[1] = vec3<Scalar>(0.0, 1.0, 0.5);
+        }
+    auto mpcd_sys = std::make_shared<mpcd::SystemData>(mpcd_sys_snap);
+
+    // walls at z = +/- 3.5 sampled with a grid spacing of 1
+    const unsigned int n = 10;
+    std::vector<Scalar> sdf(n*n*n);
+    Index3D indexer(n,n,n);
+    for (unsigned int k=0; k < n; ++k)
+        for (unsigned int j=0; j < n; ++j)
+            for (unsigned int i=0; i < n; ++i)
+                sdf[indexer(i,j,k)] = fabs(Scalar(-5.0) + k) - Scalar(3.5);
+
+    auto geom = mpcd::detail::SDFGeometry::create(exec_conf, sdf, n, n, n, snap->global_box,
+        mpcd::detail::boundary::no_slip);
+    UP_ASSERT(geom->validateBox(snap->global_box, 1.0));
+    UP_ASSERT(!geom->validateBox(BoxDim(12.0), 1.0));
+    UP_ASSERT(!geom->isOutside(make_scalar3(0.0, 0.0, 3.4)));
+    UP_ASSERT(geom->isOutside(make_scalar3(0.0, 0.0, 3.6)));
+    UP_ASSERT(geom->isOutside(make_scalar3(0.0, 0.0, -3.6)));
+    CHECK_CLOSE(geom->evaluate(make_scalar3(2.3, -4.9, 4.5)), 1.0, tol);
+
+    std::shared_ptr<mpcd::StreamingMethod> stream = std::make_shared<SM>(mpcd_sys, 2, 2, 1, geom);
+
+    // the MPCD step is 2 x 0.5 = 1.0
+    stream->setDeltaT(0.5);
+    stream->stream(3);
+        {
+        // the first particle hits the wall at t = 0.5 and returns, the other one does not reach it
+        std::shared_ptr<mpcd::ParticleData> pdata = mpcd_sys->getParticleData();
+        ArrayHandle<MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<MPCDReal4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
+        CHECK_CLOSE(h_pos.data[0].x, 0.0, tol);
+        CHECK_SMALL(h_pos.data[0].y, tol_small);
+        CHECK_CLOSE(h_pos.data[0].z, 3.0, tol);
+        CHECK_CLOSE(h_vel.data[0].x, -1.0, tol);
+        CHECK_SMALL(h_vel.data[0].y, tol_small);
+        CHECK_CLOSE(h_vel.data[0].z, -1.0, tol);
+
+        CHECK_CLOSE(h_pos.data[1].x, 1.0, tol);
+        CHECK_SMALL(h_pos.data[1].y, tol_small);
+        CHECK_CLOSE(h_pos.data[1].z, 2.5, tol);
+        CHECK_SMALL(h_vel.data[1].x, tol_small);
+        CHECK_CLOSE(h_vel.data[1].y, 1.0, tol);
+        CHECK_CLOSE(h_vel.data[1].z, 0.5, tol);
+        }
+
+    // with slip, only the normal component of the velocity is reversed
+    stream->setDeltaT(0.375);
+    std::static_pointer_cast<SM>(stream)->setGeometry(mpcd::detail::SDFGeometry::create(exec_conf, sdf, n, n, n,
+        snap->global_box, mpcd::detail::boundary::slip));
+        {
+        std::shared_ptr<mpcd::ParticleData> pdata = mpcd_sys->getParticleData();
+        ArrayHandle<MPCDReal4> h_vel(pdata->getVelocities(), access_location::host, access_mode::readwrite);
+        h_vel.data[0] = make_mpcdreal4(1.0, 0.0, 1.0, h_vel.data[0].w);
+        }
+    stream->stream(5);
+        {
+        std::shared_ptr<mpcd::ParticleData> pdata = mpcd_sys->getParticleData();
+        ArrayHandle<MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<MPCDReal4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
+        CHECK_CLOSE(h_pos.data[0].x, 0.75, tol);
+        CHECK_SMALL(h_pos.data[0].y, tol_small);
+        CHECK_CLOSE(h_pos.data[0].z, 3.25, tol);
+        CHECK_CLOSE(h_vel.data[0].x, 1.0, tol);
+        CHECK_SMALL(h_vel.data[0].y, tol_small);
+        CHECK_CLOSE(h_vel.data[0].z, -1.0, tol);
+        }
+    }
+
+//! Test that binning the particles while they are streamed gives the same cell list as compute()
+template<class SM>
+void streaming_method_fused_bin_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap( new SnapshotSystemData<Scalar>() );
+    snap->global_box = BoxDim(10.0);
+    snap->particle_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    // 3 particle system, two of which end up in the same cell after streaming
+    auto mpcd_sys_snap = std::make_shared<mpcd::SystemDataSnapshot>(sysdef);
+        {
+        auto mpcd_snap = mpcd_sys_snap->particles;
+        mpcd_snap->resize(3);
+
+        mpcd_snap->position[0] = vec3<Scalar>(1.0, 4.85, 3.0);
+        mpcd_snap->position[1] = vec3<Scalar>(-3.0, -4.75, -1.0);
+        mpcd_snap->position[2] = vec3<Scalar>(1.2, 4.7, 3.2);
+
+        mpcd_snap->velocity[0] = vec3<Scalar>(1.0, 1.0, 1.0);
+        mpcd_snap->velocity[1] = vec3<Scalar>(-1.0, -1.0, -1.0);
+        mpcd_snap->velocity[2] = vec3<Scalar>(0.0, 1.0, 0.0);
+        }
+    auto mpcd_sys = std::make_shared<mpcd::SystemData>(mpcd_sys_snap);
+    std::shared_ptr<mpcd::ParticleData> pdata = mpcd_sys->getParticleData();
+    std::shared_ptr<mpcd::CellList> cl = mpcd_sys->getCellList();
+    cl->compute(0);
+
+    // stream at step 1 with period 2, and bin for a collision at step 2 with a grid shift
+    auto geom = std::make_shared<const mpcd::detail::BulkGeometry>();
+    std::shared_ptr<mpcd::StreamingMethod> stream = std::make_shared<SM>(mpcd_sys, 1, 2, 1, geom);
+    stream->setDeltaT(0.05);
+    cl->setGridShift(make_scalar3(-0.2, 0.1, 0.3));
+    UP_ASSERT(stream->streamAndBin(1, 2));
+    UP_ASSERT(pdata->checkCellCache());
+
+    // save the fused cell list
+    const unsigned int ncells = cl->getNCells();
+    std::vector<unsigned int> cell_np(ncells);
+    std::vector<unsigned int> cells(pdata->getN());
+        {
+        ArrayHandle<unsigned int> h_cell_np(cl->getCellSizeArray(), access_location::host, access_mode::read);
+        std::copy(h_cell_np.data, h_cell_np.data + ncells, cell_np.begin());
+
+        ArrayHandle<MPCDReal4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
+        for (unsigned int i=0; i < pdata->getN(); ++i)
+            {
+            cells[i] = __mpcdreal_as_int(h_vel.data[i].w);
+            }
+        UP_ASSERT_EQUAL(cells[0], cells[2]);
+        UP_ASSERT_EQUAL(cell_np[cells[0]], 2);
+        UP_ASSERT_EQUAL(cell_np[cells[1]], 1);
+        }
+
+    // rebuilding the cell list at step 2 should give the same result
+    cl->forceCompute(2);
+        {
+        ArrayHandle<unsigned int> h_cell_np(cl->getCellSizeArray(), access_location::host, access_mode::read);
+        for (unsigned int i=0; i < ncells; ++i)
+            {
+            UP_ASSERT_EQUAL(h_cell_np.data[i], cell_np[i]);
+            }
+
+        ArrayHandle<MPCDReal4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
+        for (unsigned int i=0; i < pdata->getN(); ++i)
+            {
+            UP_ASSERT_EQUAL(__mpcdreal_as_int(h_vel.data[i].w), cells[i]);
+            }
+        }
+    }
+
 //! basic test case for MPCD StreamingMethod class
 UP_TEST( mpcd_streaming_method_basic )
     {
@@ -119,3 +283,33 @@ UP_TEST( mpcd_streaming_method_setup )
     streaming_method_basic_test<method>(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::GPU));
     }
 #endif // ENABLE_HIP
+
+//! fused binning test case for MPCD ConfinedStreamingMethod class
+UP_TEST( mpcd_streaming_method_fused_bin )
+    {
+    typedef mpcd::ConfinedStreamingMethod<mpcd::detail::BulkGeometry> method;
+    streaming_method_fused_bin_test<method>(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
+    }
+#ifdef ENABLE_HIP
+//! fused binning test case for MPCD ConfinedStreamingMethodGPU class
+UP_TEST( mpcd_streaming_method_fused_bin_gpu )
+    {
+    typedef mpcd::ConfinedStreamingMethodGPU<mpcd::detail::BulkGeometry> method;
+    streaming_method_fused_bin_test<method>(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::GPU));
+    }
+#endif // ENABLE_HIP
+
+//! signed distance field test case for MPCD ConfinedStreamingMethod class
+UP_TEST( mpcd_streaming_method_sdf )
+    {
+    typedef mpcd::ConfinedStreamingMethod<mpcd::detail::SDFGeometry> method;
+    streaming_method_sdf_test<method>(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
+    }
+#ifdef ENABLE_HIP
+//! signed distance field test case for MPCD ConfinedStreamingMethodGPU class
+UP_TEST( mpcd_streaming_method_sdf_gpu )
+    {
+    typedef mpcd::ConfinedStreamingMethodGPU<mpcd::detail::SDFGeometry> method;
+    streaming_method_sdf_test<method>(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::GPU));
+    }
+#endif // ENABLE_HIP
@@ -21,6 +21,8 @@ class sort():
         system (:py:class:`hoomd.mpcd.data.system`): MPCD system to create sorter for
         period (int): Sort whenever the timestep is a multiple of *period*.
             .. versionadded:: 2.6
+        max_disorder (float): Skip a scheduled sort when less than this fraction
+            of the particles is out of order (0 sorts every *period*).
 
     Warning:
         Do not create :py:class:`hoomd.mpcd.update.sort` explicitly in your script.
@@ -36,6 +38,14 @@ class sort():
         The *period* should be no smaller than the MPCD collision period, or unnecessary
         cell list builds will occur.
 
+    With a nonzero *max_disorder*, the sorted order is still computed every *period*
+    time steps, but it is only applied when the fraction of particles that do not
+    directly follow their predecessor in the new order is at least *max_disorder*.
+    A freshly sorted system has no disorder, and a randomly ordered one has a disorder
+    close to 1. This lets a short *period* check the order often while the particles
+    are only moved in memory once the order has degraded. The disorder measured at the
+    last check is available as :py:attr:`disorder`.
+
     Essentially all MPCD systems benefit from sorting, and so a sorter is created by
     default with the MPCD system. To disable it or modify parameters, save the system
     and access the sorter through it::
@@ -47,7 +57,7 @@ class sort():
 
     """
 
-    def __init__(self, system, period=50):
+    def __init__(self, system, period=50, max_disorder=0.0):
 
         # check for mpcd initialization
         if system.sorter is not None:
@@ -63,6 +73,7 @@ class sort():
 
         self.period = period
         self.enabled = True
+        self.set_max_disorder(max_disorder)
 
     def disable(self):
         self.enabled = False
@@ -90,6 +101,30 @@ class sort():
         self.period = period
         self._cpp.setPeriod(hoomd.context.current.system.getCurrentTimeStep(), self.period)
 
+    def set_max_disorder(self, max_disorder):
+        """ Change the disorder below which a scheduled sort is skipped.
+
+        Args:
+            max_disorder (float): Fraction of particles out of order, between 0 and 1.
+
+        Examples::
+
+            sorter.set_max_disorder(0.2)
+            sorter.set_max_disorder(0.0)
+
+        """
+
+        self.max_disorder = max_disorder
+        self._cpp.setMaxDisorder(self.max_disorder)
+
+    @property
+    def disorder(self):
+        """ float: Fraction of particles out of order at the last scheduled sort.
+
+        Only measured when *max_disorder* is nonzero.
+        """
+        return self._cpp.getDisorder()
+
     def tune(self, start, stop, step, tsteps, quiet=False):
         """ Tune the sorting period.
 
@@ -0,0 +1,58 @@
+"""Test the benchmark workloads."""
+
+import json
+
+import hoomd
+import hoomd.benchmark
+import pytest
+
+
+@pytest.mark.parametrize("workload", sorted(hoomd.benchmark.workloads))
+def test_run(device, workload):
+    """Test that each workload runs and reports its performance."""
+    if workload.startswith('hpmc'):
+        pytest.importorskip('hoomd.hpmc')
+    else:
+        pytest.importorskip('hoomd.md')
+
+    result = hoomd.benchmark.run(workload,
+                                 device,
+                                 N=200,
+                                 warmup=10,
+                                 repeat=2,
+                                 steps=10)
+
+    assert result['workload'] == workload
+    assert 0 < result['N'] <= 200
+    assert len(result['tps']) == 2
+    assert all(tps > 0 for tps in result['tps'])
+    assert result['profile']
+    assert result['memory']['host_max_rss'] > 0
+    if isinstance(device, hoomd.device.GPU):
+        assert len(result['memory']['gpu_used']) == len(device.devices)
+    else:
+        assert result['memory']['gpu_used'] is None
+
+    # results must be serializable
+    json.dumps(result)
+
+
+@pytest.mark.serial
+def test_main(device, tmp_path):
+    """Test that the command line writes a JSON report."""
+    pytest.importorskip('hoomd.md')
+
+    filename = tmp_path / 'benchmarks.json'
+    hoomd.benchmark.main([
+        '--workloads', 'lj_liquid', '--N', '100', '--device', 'cpu',
+        '--warmup', '0', '--repeat', '1', '--steps', '5', '--output',
+        str(filename)
+    ])
+
+    with open(filename) as f:
+        report = json.load(f)
+
+    assert report['schema_version'] == 1
+    assert report['hoomd']['version'] == hoomd.version.version
+    assert report['device']['type'] == 'CPU'
+    assert [r['workload'] for r in report['results']] == ['lj_liquid']
@@ -42,6 +42,8 @@ def test_common_properties(device):
         # make sure we can pass a communciator
         com = hoomd.communicator.Communicator(nrank=1)
         assert device_type(communicator=com).communicator.num_ranks == 1
+        assert com.num_partitions == com.cpp_mpi_conf.getNRanksGlobal()
+        assert com.partition < com.num_partitions
         # make sure we can pass a shared_msg_file
         dev2 = device_type(shared_msg_file="shared.txt")
     else:
@@ -68,6 +70,37 @@ def test_gpu_specific_properties(device):
     # make sure we can give a list of GPU ids to the constructor
     hoomd.device.GPU(gpu_ids=[0])
 
+
+@pytest.mark.gpu
+def test_mpi_device_direct(device):
+    # the default depends on whether the build has CUDA-aware MPI
+    default = device.mpi_device_direct
+    assert isinstance(default, bool)
+
+    device.mpi_device_direct = False
+    assert not device.mpi_device_direct
+
+    if default:
+        device.mpi_device_direct = True
+        assert device.mpi_device_direct
+    else:
+        with pytest.raises(RuntimeError):
+            device.mpi_device_direct = True
+
+    device.mpi_device_direct = default
+
+
+@pytest.mark.gpu
+def test_deterministic(device):
+    assert not device.deterministic
+
+    device.deterministic = True
+    assert device.deterministic
+
+    device.deterministic = False
+    assert not device.deterministic
+
+
 @pytest.mark.gpu
 def test_other_gpu_specifics(device):
     # make sure GPU is available and auto-select gives a GPU
@@ -94,9 +127,55 @@ def test_query_hardware_info(device):
     _assert_list_str(devices)
 
 
+def test_cpu_host_memory_hints():
+    dev = hoomd.device.CPU()
+    assert not dev.huge_pages
+    assert not dev.numa_interleave
+
+    dev.huge_pages = True
+    dev.numa_interleave = True
+    assert dev.huge_pages
+    assert dev.numa_interleave
+
+
 def test_cpu_build_specifics():
     if hoomd.version.gpu_enabled == True:
         pytest.skip("Don't run CPU-build specific tests when GPU is available")
     assert hoomd.device.GPU.is_available() == False
     assert type(hoomd.device.auto_select()) == hoomd.device.CPU
 
+
+
+@pytest.mark.serial
+def test_tuning_database(device, tmp_path):
+    filename = tmp_path / 'tuning.txt'
+    with open(filename, 'w') as f:
+        f.write('# comment\n')
+        f.write('kernel|GPU|N=2^10|P=3:abc\t64\t0.5\n')
+
+    dev = type(device)()
+    assert dev.tuning_database is None
+    assert not dev.tuning_database_frozen
+
+    # the entries are read when the database is set
+    dev.tuning_database = str(filename)
+    database = dev._cpp_exec_conf.getAutotunerDatabase()
+    assert database.getNumEntries() == 1
+
+    # and written back after runs
+    filename.unlink()
+    dev._save_tuning_database()
+    with open(filename) as f:
+        lines = [line for line in f if not line.startswith('#')]
+    assert lines == ['kernel|GPU|N=2^10|P=3:abc\t64\t0.5\n']
+
+    # a frozen database is not written
+    filename.unlink()
+    dev.tuning_database_frozen = True
+    dev._save_tuning_database()
+    assert not filename.exists()
+
+    with open(filename, 'w') as f:
+        f.write('missing values\n')
+    with pytest.raises(RuntimeError):
+        dev.tuning_database = str(filename)
@@ -0,0 +1,36 @@
+"""Test InSitu."""
+
+import hoomd
+import numpy as np
+import pytest
+
+
+@pytest.mark.parametrize("queue_depth", [0, 1, 3])
+def test_callback(simulation_factory, lattice_snapshot_factory, device,
+                  queue_depth):
+    """Test that the callback receives every staged frame in order."""
+    if isinstance(device, hoomd.device.GPU):
+        pytest.skip("Host arrays are only passed in CPU simulations")
+
+    sim = simulation_factory(lattice_snapshot_factory(n=3))
+    frames = []
+
+    def callback(timestep, arrays):
+        frames.append((timestep, arrays['tag'].copy(),
+                       arrays['position'].copy()))
+
+    in_situ = hoomd.write.InSitu(trigger=hoomd.trigger.Periodic(2),
+                                 callback=callback,
+                                 queue_depth=queue_depth)
+    sim.operations.writers.append(in_situ)
+    sim.run(10)
+
+    # all frames are passed to the callback by the end of the run
+    assert [frame[0] for frame in frames] == [2, 4, 6, 8, 10]
+
+    with sim.state.cpu_local_snapshot as data:
+        tag = np.array(data.particles.tag, copy=True)
+        position = np.array(data.particles.position, copy=True)
+    timestep, staged_tag, staged_position = frames[-1]
+    np.testing.assert_array_equal(staged_tag, tag)
+    np.testing.assert_allclose(staged_position, position)
@@ -467,6 +467,28 @@ class _TestLocalSnapshots:
                 property_check(hoomd_buffer, property_dict, tags)
 
 
+    def test_rows(self, simulation_factory, base_snapshot):
+        sim = simulation_factory()
+        with sim.state.cpu_local_snapshot as data:
+            stop = min(len(data.particles.tag), 2)
+            rows = data.particles.rows(0, stop)
+            position = np.array(rows.position, copy=True)
+            typeid = np.array(rows.typeid, copy=True)
+            rows.velocity = 1
+            with pytest.raises(AttributeError):
+                rows.ghost_position
+
+        with sim.state.cpu_local_snapshot as data:
+            velocity = np.array(data.particles.velocity, copy=True)
+            np.testing.assert_allclose(data.particles.position[:stop], position)
+            np.testing.assert_array_equal(data.particles.typeid[:stop], typeid)
+            np.testing.assert_allclose(velocity[:stop], 1)
+
+        with sim.state.cpu_local_snapshot as data:
+            rows = data.particles.rows(stop, len(data.particles.tag))
+            np.testing.assert_allclose(rows.velocity, velocity[stop:])
+
+
 @pytest.mark.cpu
 class TestLocalSnapshotCPUDevice(_TestLocalSnapshots):
     _lcl_snapshot_attrs = ['cpu_local_snapshot']
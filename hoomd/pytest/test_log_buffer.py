@@ -0,0 +1,73 @@
+"""Test LogBuffer."""
+
+import hoomd
+import hoomd.md
+import numpy as np
+import pytest
+
+
+def _make_simulation(simulation_factory, two_particle_snapshot_factory,
+                     **kwargs):
+    sim = simulation_factory(two_particle_snapshot_factory())
+    thermo = hoomd.md.compute.ThermodynamicQuantities(hoomd.filter.All())
+    sim.operations.computes.append(thermo)
+    log_buffer = hoomd.write.LogBuffer(
+        trigger=hoomd.trigger.Periodic(1),
+        quantities={
+            'ke': (thermo, 'kinetic_energy'),
+            'n': (thermo, 'num_particles')
+        },
+        **kwargs)
+    sim.operations.writers.append(log_buffer)
+    return sim, log_buffer
+
+
+def test_read(simulation_factory, two_particle_snapshot_factory):
+    """Test that the ring buffer keeps the most recent samples."""
+    sim, log_buffer = _make_simulation(simulation_factory,
+                                       two_particle_snapshot_factory,
+                                       buffer_size=4)
+    assert log_buffer.buffer_size == 4
+    assert log_buffer.filename is None
+
+    sim.run(10)
+    samples = log_buffer.read()
+    np.testing.assert_array_equal(samples['timestep'], [7, 8, 9, 10])
+    np.testing.assert_array_equal(samples['n'], [2, 2, 2, 2])
+    assert samples['ke'].shape == (4,)
+
+    # read removes the samples
+    assert len(log_buffer.read()['timestep']) == 0
+
+
+@pytest.mark.serial
+def test_file(simulation_factory, two_particle_snapshot_factory, tmp_path):
+    """Test that the samples are written to the file in bulk."""
+    filename = str(tmp_path / 'log.txt')
+    sim, log_buffer = _make_simulation(simulation_factory,
+                                       two_particle_snapshot_factory,
+                                       filename=filename,
+                                       buffer_size=3,
+                                       mode='w')
+    sim.run(10)
+
+    with open(filename) as f:
+        lines = f.read().splitlines()
+    assert lines[0].split() == ['timestep', 'ke', 'n']
+    assert len(lines) == 11
+    assert [int(line.split()[0]) for line in lines[1:]] == list(range(1, 11))
+    assert all(float(line.split()[2]) == 2 for line in lines[1:])
+
+
+def test_invalid_quantity(simulation_factory, two_particle_snapshot_factory):
+    """Test that LogBuffer checks the quantity names."""
+    sim = simulation_factory(two_particle_snapshot_factory())
+    thermo = hoomd.md.compute.ThermodynamicQuantities(hoomd.filter.All())
+    sim.operations.computes.append(thermo)
+    log_buffer = hoomd.write.LogBuffer(
+        trigger=hoomd.trigger.Periodic(1),
+        quantities={'x': (thermo, 'not_a_quantity')})
+    sim.operations.writers.append(log_buffer)
+
+    with pytest.raises(RuntimeError):
+        sim.run(0)
@@ -393,3 +393,23 @@ class TestLogger:
         inner_dict = logged['pytest']['test_logging']['DummyLoggable']
         assert inner_dict['prop'] == (logged_obj.prop, 'scalar')
         assert inner_dict['proplist'] == (logged_obj.proplist, 'sequence')
+
+    def test_flags(self, logged_obj):
+
+        class FlaggedLoggable(metaclass=Loggable):
+
+            @log(requires=[1])
+            def kinetic(self):
+                return 1
+
+            @log(requires=[0, 1])
+            def pressure(self):
+                return 2
+
+        logger = Logger()
+        logger += logged_obj
+        assert logger.flags == []
+        logger += FlaggedLoggable()
+        assert logger.flags == [0, 1]
+        logger -= ('pytest', 'test_logging', 'FlaggedLoggable', 'pressure')
+        assert logger.flags == [1]
@@ -0,0 +1,49 @@
+import pytest
+import hoomd
+
+
+def test_attributes():
+    remd = hoomd.update.ReplicaExchange(trigger=10, parameter='pressure',
+                                        values=[1.0, 2.0], seed=3, kT=1.5)
+    assert remd.parameter == 'pressure'
+    assert remd.values == [1.0, 2.0]
+    assert remd.seed == 3
+    assert remd.kT == 1.5
+    assert remd.variant.value == 1.0
+
+    with pytest.raises(ValueError):
+        remd.parameter = 'fugacity'
+
+
+def test_single_partition(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory())
+    n_partitions = sim.device.communicator.num_partitions
+    values = [1.0 + p for p in range(n_partitions)]
+    remd = hoomd.update.ReplicaExchange(trigger=1, parameter='pressure',
+                                        values=values, seed=3)
+    sim.operations.updaters.append(remd)
+    sim.run(10)
+
+    partition = sim.device.communicator.partition
+    if n_partitions == 1:
+        assert remd.index == partition
+        assert remd.value == values[partition]
+        assert remd.num_attempted == []
+        assert remd.acceptance == []
+    assert remd.variant.value == values[remd.index]
+
+    with pytest.raises(AttributeError):
+        remd.values = [2.0]
+    remd.kT = 2.0
+    assert remd.kT == 2.0
+
+
+def test_wrong_number_of_values(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory())
+    n_partitions = sim.device.communicator.num_partitions
+    remd = hoomd.update.ReplicaExchange(trigger=1, parameter='pressure',
+                                        values=[1.0] * (n_partitions + 1),
+                                        seed=3)
+    sim.operations.updaters.append(remd)
+    with pytest.raises(RuntimeError):
+        sim.run(1)
@@ -1,6 +1,8 @@
 import hoomd
+import json
 import numpy as np
 import pytest
+import threading
 from copy import deepcopy
 try:
     import gsd.hoomd
@@ -127,6 +129,82 @@ def test_tps(simulation_factory, get_snapshot, device):
     assert sim.tps > 0
 
 
+def test_communication_times(simulation_factory, get_snapshot, device):
+    sim = hoomd.Simulation(device)
+    assert sim.communication_times is None
+
+    sim = simulation_factory(get_snapshot())
+    sim.run(10)
+
+    times = sim.communication_times
+    if device.communicator.num_ranks == 1:
+        assert times is None
+    else:
+        assert set(times.keys()) == {'migrate', 'exchange_ghosts',
+                                     'update_ghosts'}
+        assert all(t >= 0 for t in times.values())
+
+
+def test_step_times(simulation_factory, get_snapshot, device):
+    sim = hoomd.Simulation(device)
+    assert sim.step_times is None
+    assert sim.straggler_report is None
+
+    sim = simulation_factory(get_snapshot())
+    sim.straggler_period = 5
+    sim.run(10)
+
+    times = sim.step_times
+    assert times['steps'] == 10
+    assert 0 <= times['p50'] <= times['p90'] <= times['p99'] <= times['max']
+
+    report = sim.straggler_report
+    assert report['step'] == sim.timestep
+    for phase in ('update', 'integrate', 'analyze'):
+        assert 0 <= report[phase]['rank'] < device.communicator.num_ranks
+        assert report[phase]['mean_time'] <= report[phase]['max_time']
+
+
+def test_profile(simulation_factory, get_snapshot, device, tmp_path):
+    sim = hoomd.Simulation(device)
+    assert not sim.profiling
+    assert sim.profile is None
+
+    sim = simulation_factory(get_snapshot())
+    sim.run(10)
+    assert sim.profile is None
+    with pytest.raises(RuntimeError):
+        sim.write_profile_trace(str(tmp_path / 'trace.{rank}.json'))
+
+    sim.profiling = True
+    sim.operations.integrator = hoomd.md.Integrator(0.005)
+    sim.run(10)
+
+    profile = sim.profile
+    assert isinstance(profile, dict)
+    for entry in profile.values():
+        assert entry['time'] >= 0
+        assert entry['calls'] > 0
+        assert entry['transferred_bytes'] >= 0
+        assert entry['page_faults'] >= 0
+
+    filename = str(tmp_path / 'trace.{rank}.json')
+    sim.write_profile_trace(filename)
+    rank = device.communicator.rank
+    with open(filename.format(rank=rank)) as f:
+        trace = json.load(f)
+    events = trace['traceEvents']
+    assert events[0]['ph'] == 'M'
+    assert events[0]['args']['name'] == 'rank {}'.format(rank)
+    assert all(event['ph'] == 'X' for event in events[1:])
+
+    assert sim.profiling_synchronize
+    sim.profiling_synchronize = False
+    sim.run(10)
+    assert not sim.profiling_synchronize
+    assert len(sim.profile) > 0
+
+
 def test_timestep(simulation_factory, get_snapshot, device):
     sim = hoomd.Simulation(device)
     assert sim.timestep is None
@@ -198,6 +276,62 @@ def test_state_from_gsd(simulation_factory, get_snapshot,
         assert_equivalent_snapshots(snap, sim.state.snapshot)
 
 
+@skip_gsd
+def test_state_from_gsd_parallel_io(simulation_factory,
+                                    lattice_snapshot_factory, device,
+                                    tmp_path):
+    """Ensure that parallel GSD reads load the same particles as the root."""
+    filename = tmp_path / "restart.gsd"
+    sim = simulation_factory(
+        lattice_snapshot_factory(particle_types=['A', 'B'], n=4))
+    snap = sim.state.snapshot
+    if snap.exists:
+        snap.particles.typeid[::2] = 1
+        snap.particles.mass[:] = 2.0
+    sim.state.snapshot = snap
+    hoomd.write.GSD.write(state=sim.state, filename=filename)
+
+    sim2 = hoomd.Simulation(device)
+    sim2.create_state_from_gsd(filename, parallel_io=True)
+    assert sim2.state.N_particles == sim.state.N_particles
+    assert sim2.state.particle_types == ['A', 'B']
+    assert_equivalent_snapshots(snap, sim2.state.snapshot)
+
+
+def test_state_from_lattice(device):
+    """Ensure that the distributed lattice places every site once."""
+    sim = hoomd.Simulation(device)
+    sim.create_state_from_lattice(cell=hoomd.Box.cube(1.5), n=4,
+                                  basis=[(0, 0, 0), (0.5, 0.5, 0.5)],
+                                  typeid=[0, 1], particle_types=['A', 'B'])
+    assert sim.timestep == 0
+    assert sim.state.N_particles == 128
+    assert sim.state.particle_types == ['A', 'B']
+
+    snap = sim.state.snapshot
+    if snap.exists:
+        assert snap.configuration.box == (6, 6, 6, 0, 0, 0)
+        np.testing.assert_array_equal(snap.particles.typeid[:2], [0, 1])
+        np.testing.assert_allclose(snap.particles.position[0], [-3, -3, -3])
+        np.testing.assert_allclose(snap.particles.position[1],
+                                      [-2.25, -2.25, -2.25])
+        assert len(np.unique(snap.particles.position, axis=0)) == 128
+
+
+def test_state_random(device):
+    """Ensure that the distributed random initializer places N particles."""
+    sim = hoomd.Simulation(device)
+    sim.create_state_random(box=hoomd.Box.cube(10), N=1000, seed=3)
+    assert sim.state.N_particles == 1000
+
+    snap = sim.state.snapshot
+    if snap.exists:
+        assert np.all(np.abs(snap.particles.position) <= 5)
+
+    with pytest.raises(RuntimeError):
+        sim.create_state_random(box=hoomd.Box.cube(10), N=1000, seed=3)
+
+
 def test_writer_order(simulation_factory, two_particle_snapshot_factory):
     """Ensure that writers run at the end of the loop step."""
 
@@ -222,6 +356,42 @@ def test_writer_order(simulation_factory, two_particle_snapshot_factory):
     assert record.steps == [100, 200, 300, 400, 500, 600, 700, 800, 900, 1000]
 
 
+def test_run_async(simulation_factory, two_particle_snapshot_factory):
+    """Ensure that run_async steps in the background until the result."""
+
+    class Pause(hoomd.custom.Action):
+
+        def __init__(self):
+            self.reached = threading.Event()
+            self.resume = threading.Event()
+
+        def act(self, timestep):
+            if not self.reached.is_set():
+                self.reached.set()
+                self.resume.wait(timeout=60)
+
+    pause = Pause()
+    writer = hoomd.write.CustomWriter(action=pause,
+                                      trigger=hoomd.trigger.Periodic(10))
+    sim = simulation_factory(two_particle_snapshot_factory())
+    sim.operations.writers.append(writer)
+    start = sim.timestep
+
+    future = sim.run_async(20)
+    assert pause.reached.wait(timeout=60)
+    with pytest.raises(RuntimeError):
+        sim.state
+    with pytest.raises(RuntimeError):
+        sim.run(1)
+    assert start < sim.timestep < start + 20
+    pause.resume.set()
+
+    assert future.result(timeout=60) is None
+    assert sim.timestep == start + 20
+    assert sim.state is not None
+    sim.run(1)
+
+
 def test_writer_order_initial(simulation_factory,
                               two_particle_snapshot_factory):
     """Ensure that writers optionally run at the beginning of the loop."""
@@ -258,3 +428,166 @@ def test_writer_order_initial(simulation_factory,
         900,
         1000,
     ]
+
+
+@skip_gsd
+@pytest.mark.parametrize("async_queue_depth", [0, 1, 4])
+def test_gsd_async(simulation_factory, two_particle_snapshot_factory, tmp_path,
+                   async_queue_depth):
+    """Ensure that asynchronous GSD output writes all frames by run exit."""
+    filename = tmp_path / "async.gsd"
+    sim = simulation_factory(two_particle_snapshot_factory())
+    writer = hoomd.write.GSD(filename=filename,
+                             trigger=hoomd.trigger.Periodic(10),
+                             mode='wb',
+                             async_queue_depth=async_queue_depth)
+    sim.operations.writers.append(writer)
+
+    sim.run(100)
+    assert writer.async_queue_depth == async_queue_depth
+
+    if sim.device.communicator.rank == 0:
+        with gsd.hoomd.open(name=filename, mode='rb') as file:
+            assert len(file) == 10
+            steps = [frame.configuration.step for frame in file]
+            assert steps == list(range(10, 101, 10))
+
+
+@skip_gsd
+def test_gsd_parallel_io(simulation_factory, lattice_snapshot_factory,
+                         tmp_path):
+    """Ensure that parallel GSD output writes the same data as gathering."""
+    filename = tmp_path / "parallel.gsd"
+    sim = simulation_factory(lattice_snapshot_factory(n=4))
+    snap = sim.state.snapshot
+    hoomd.write.GSD.write(state=sim.state, filename=filename,
+                          parallel_io=True)
+
+    if sim.device.communicator.rank == 0:
+        with gsd.hoomd.open(name=filename, mode='rb') as file:
+            frame = file[0]
+            assert frame.particles.N == snap.particles.N
+            np.testing.assert_allclose(frame.particles.position,
+                                       snap.particles.position,
+                                       rtol=1e-6)
+            np.testing.assert_equal(frame.particles.image,
+                                    snap.particles.image)
+
+
+@skip_gsd
+def test_gsd_quantize(simulation_factory, lattice_snapshot_factory, device,
+                      tmp_path):
+    """Ensure that quantized positions read back within the error bound."""
+    filename = tmp_path / "quantized.gsd"
+    sim = simulation_factory(lattice_snapshot_factory(n=4, a=1.3))
+    snap = sim.state.snapshot
+    writer = hoomd.write.GSD(filename=filename,
+                             trigger=hoomd.trigger.Periodic(1),
+                             mode='wb',
+                             quantize=True)
+    sim.operations.writers.append(writer)
+    sim.run(1)
+
+    sim2 = hoomd.Simulation(device)
+    sim2.create_state_from_gsd(filename)
+    snap2 = sim2.state.snapshot
+    if snap.exists:
+        L = sim.state.box.Lx
+        np.testing.assert_allclose(snap2.particles.position,
+                                   snap.particles.position,
+                                   atol=L / 2**16)
+
+
+@skip_gsd
+def test_gsd_region(simulation_factory, lattice_snapshot_factory, tmp_path):
+    """Ensure that region output writes only the particles in the region."""
+    filename = tmp_path / "region.gsd"
+    sim = simulation_factory(lattice_snapshot_factory(n=4, a=1.3))
+    snap = sim.state.snapshot
+    L = sim.state.box.Lx
+    region = ((-L / 2, -L / 2, -L / 2), (0, L / 2, L / 2))
+    writer = hoomd.write.GSD(filename=filename,
+                             trigger=hoomd.trigger.Periodic(1),
+                             mode='wb',
+                             region=region)
+    sim.operations.writers.append(writer)
+    sim.run(1)
+
+    if sim.device.communicator.rank == 0:
+        tags = np.nonzero(snap.particles.position[:, 0] < 0)[0]
+        with gsd.hoomd.open(name=filename, mode='rb') as file:
+            frame = file[0]
+            assert frame.particles.N == len(tags)
+            np.testing.assert_equal(frame.log['particles/tag'], tags)
+            np.testing.assert_allclose(frame.particles.position,
+                                       snap.particles.position[tags],
+                                       rtol=1e-6)
+
+
+@skip_gsd
+def test_checkpoint(simulation_factory, lattice_snapshot_factory, device,
+                    tmp_path):
+    """Ensure that checkpoints restore the thermostat variables."""
+    filename = tmp_path / "checkpoint.gsd"
+    sim = simulation_factory(lattice_snapshot_factory(n=2, a=2.0))
+    nvt = hoomd.md.methods.NVT(filter=hoomd.filter.All(), kT=1.0, tau=0.5)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005, methods=[nvt])
+    checkpoint = hoomd.write.Checkpoint(filename=filename,
+                                        trigger=hoomd.trigger.Periodic(10))
+    sim.operations.writers.append(checkpoint)
+    sim.run(0)
+    nvt.translational_thermostat_dof = (0.5, 0.25)
+    sim.run(10)
+    snap = sim.state.snapshot
+    dof = nvt.translational_thermostat_dof
+
+    sim2 = hoomd.Simulation(device)
+    sim2.create_state_from_gsd(filename)
+    nvt2 = hoomd.md.methods.NVT(filter=hoomd.filter.All(), kT=1.0, tau=0.5)
+    sim2.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                     methods=[nvt2])
+    sim2.run(0)
+    assert sim2.timestep == sim.timestep
+    assert_equivalent_snapshots(snap, sim2.state.snapshot)
+    np.testing.assert_allclose(nvt2.translational_thermostat_dof, dof)
+
+
+@skip_gsd
+def test_preemption(simulation_factory, lattice_snapshot_factory, device,
+                    tmp_path):
+    """Ensure that a walltime limit ends the run with a checkpoint."""
+    filename = tmp_path / "preempt.gsd"
+    sim = simulation_factory(lattice_snapshot_factory(n=2, a=2.0))
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005)
+    checkpoint = hoomd.write.Checkpoint(filename=filename,
+                                        trigger=hoomd.trigger.Periodic(1000))
+    sim.operations.writers.append(checkpoint)
+    sim.set_preemption(checkpoint, walltime_limit=1e-9, exit=False)
+    sim.run(100)
+
+    assert sim.preempted
+    assert 0 < sim.timestep < 100
+
+    sim2 = hoomd.Simulation(device)
+    sim2.create_state_from_gsd(filename)
+    assert sim2.timestep == sim.timestep
+
+    sim.set_preemption(None)
+    sim.run(10)
+    assert not sim.preempted
+
+
+def test_run_interleaved(simulation_factory, lattice_snapshot_factory):
+    simulations = [
+        simulation_factory(lattice_snapshot_factory(n=n)) for n in (3, 4)
+    ]
+    for sim in simulations:
+        sim.operations.integrator = hoomd.md.Integrator(dt=0.005)
+    start = [sim.timestep for sim in simulations]
+
+    hoomd.Simulation.run_interleaved(simulations, steps=25, steps_per_turn=10)
+    for sim, t in zip(simulations, start):
+        assert sim.timestep == t + 25
+
+    with pytest.raises(ValueError):
+        hoomd.Simulation.run_interleaved(simulations, 1, steps_per_turn=0)
@@ -31,3 +31,33 @@ def test_default_sorter(simulation_factory, two_particle_snapshot_factory):
 
     assert len(sim.operations.tuners) == 1
     assert isinstance(sim.operations.tuners[0], hoomd.tune.ParticleSorter)
+
+
+def test_max_disorder(simulation_factory, two_particle_snapshot_factory):
+    """Test that ParticleSorter measures the disorder when enabled."""
+    sorter = hoomd.tune.ParticleSorter(trigger=hoomd.trigger.Periodic(1),
+                                       max_disorder=0.5)
+    assert sorter.max_disorder == 0.5
+
+    sim = simulation_factory(two_particle_snapshot_factory())
+    sim.operations.tuners.append(sorter)
+    sim.run(2)
+
+    assert sorter.max_disorder == 0.5
+    assert 0.0 <= sorter.disorder <= 1.0
+
+
+def test_order(simulation_factory, two_particle_snapshot_factory):
+    """Test that ParticleSorter runs with each order."""
+    for order in ['hilbert', 'morton', 'cell']:
+        sorter = hoomd.tune.ParticleSorter(trigger=hoomd.trigger.Periodic(1),
+                                           grid=32,
+                                           order=order)
+        assert sorter.order == order
+
+        sim = simulation_factory(two_particle_snapshot_factory())
+        sim.operations.tuners.clear()
+        sim.operations.tuners.append(sorter)
+        sim.run(2)
+
+        assert sorter.order == order
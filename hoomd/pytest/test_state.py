@@ -211,3 +211,54 @@ def test_thermalize_angular_momentum(simulation_factory,
         # too large for an allclose check.
         expected_K = (3 * snap.particles.N) / 2 * 1.5
         assert K > expected_K * 3 / 4 and K < expected_K * 4 / 3
+
+
+def test_distributed_snapshot(simulation_factory, lattice_snapshot_factory):
+    snap = lattice_snapshot_factory(n=4)
+    if snap.exists:
+        snap.particles.velocity[:] = numpy.random.uniform(-1, 1, size=(64, 3))
+    sim = simulation_factory(snap)
+
+    dsnap = sim.state.distributed_snapshot
+    assert dsnap.N_global == 64
+    tags = dsnap.particles.tag
+    assert numpy.all(numpy.diff(tags) > 0)
+    if snap.exists:
+        assert dsnap.offset == 0
+        numpy.testing.assert_allclose(dsnap.particles.position,
+                                      snap.particles.position[tags])
+        numpy.testing.assert_allclose(dsnap.particles.velocity,
+                                      snap.particles.velocity[tags])
+
+    dsnap.particles.velocity[:] *= 0.5
+    sim.state.distributed_snapshot = dsnap
+
+    snap2 = sim.state.snapshot
+    if snap2.exists:
+        numpy.testing.assert_allclose(snap2.particles.velocity,
+                                      snap.particles.velocity * 0.5)
+        numpy.testing.assert_allclose(snap2.particles.position,
+                                      snap.particles.position)
+
+
+def test_checkpoint(device, snap):
+    sim = Simulation(device)
+    sim.create_state_from_snapshot(snap)
+
+    checkpoint = sim.state.take_checkpoint()
+    assert isinstance(checkpoint, hoomd.StateCheckpoint)
+
+    snap2 = sim.state.snapshot
+    if snap2.exists:
+        snap2.particles.position[:] *= 0.5
+        snap2.particles.velocity[:] = 0
+        snap2.bonds.typeid[:] = 0
+    sim.state.snapshot = snap2
+
+    sim.state.restore_checkpoint(checkpoint)
+    assert_snapshots_equal(snap, sim.state.snapshot)
+
+    # restore the same checkpoint again, and overwrite it
+    sim.state.restore_checkpoint(checkpoint)
+    assert sim.state.take_checkpoint(checkpoint) is checkpoint
+    assert_snapshots_equal(snap, sim.state.snapshot)
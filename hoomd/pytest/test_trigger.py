@@ -130,6 +130,16 @@ def test_eval(trigger, eval_func):
         assert trigger(i) == eval_func(i)
 
 
+@pytest.mark.parametrize('trigger', triggers(), ids=_test_name)
+def test_next_active(trigger):
+    for step in itertools.chain(range(600), range(10000000000, 10000000600)):
+        next_step = hoomd._hoomd._test_trigger_next_active(trigger, step)
+        assert next_step >= step
+        # the trigger is not active on the steps that the lookahead skips
+        last = min(next_step, step + 500)
+        assert not any(trigger(i) for i in range(step, last))
+
+
 @pytest.mark.parametrize('trigger', triggers(), ids=_test_name)
 def test_pickling(trigger):
     pkled_trigger = pickle.loads(pickle.dumps(trigger))
@@ -142,3 +152,18 @@ def test_custom():
     # test that the custom trigger can be called from c++
     assert hoomd._hoomd._test_trigger_call(c, 0)
     assert not hoomd._hoomd._test_trigger_call(c, 250000000001)
+
+
+def test_expression():
+    trigger = hoomd.trigger.Expression(
+        "(t < 1000 and t % 100 == 0) or t % 1000 == 0")
+    assert trigger.expression == "(t < 1000 and t % 100 == 0) or t % 1000 == 0"
+    for i in range(5000):
+        assert trigger(i) == ((i < 1000 and i % 100 == 0) or i % 1000 == 0)
+
+    pkled_trigger = pickle.loads(pickle.dumps(trigger))
+    assert trigger == pkled_trigger
+    assert str(trigger).startswith("hoomd.trigger.Expression(")
+
+    with pytest.raises(ValueError):
+        hoomd.trigger.Expression("t <")
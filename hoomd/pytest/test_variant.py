@@ -216,3 +216,29 @@ def test_custom():
     assert pkled_variant._a == 1
     for i in range(0, 10000, 100):
         assert hoomd._hoomd._test_variant_call(pkled_variant, i) == float(i)**(1 / 2)
+
+
+def test_expression():
+    v = hoomd.variant.Expression('1.5 + 0.5 * sin(2 * pi * t / 1000)',
+                                 min=1.0, max=2.0)
+    assert v.expression == '1.5 + 0.5 * sin(2 * pi * t / 1000)'
+    assert v.min == 1.0
+    assert v.max == 2.0
+    for i in range(0, 10000, 7):
+        expected = 1.5 + 0.5 * np.sin(2 * np.pi * i / 1000)
+        assert hoomd._hoomd._test_variant_call(v, i) == pytest.approx(expected)
+
+    ramp = hoomd.variant.Expression('clip((t - 100) / 50, 0, 1) ** 2',
+                                    min=0, max=1)
+    for i in range(0, 300, 5):
+        expected = min(max((i - 100) / 50, 0), 1)**2
+        assert ramp(i) == pytest.approx(expected)
+
+    pkled_variant = pickle.loads(pickle.dumps(ramp))
+    assert pkled_variant.expression == ramp.expression
+    assert pkled_variant(125) == pytest.approx(0.25)
+
+    with pytest.raises(ValueError):
+        hoomd.variant.Expression('1 + ', min=0, max=1)
+    with pytest.raises(ValueError):
+        hoomd.variant.Expression('foo(t)', min=0, max=1)
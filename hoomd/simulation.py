@@ -10,7 +10,10 @@ from hoomd.state import State
 from hoomd.snapshot import Snapshot
 from hoomd.operations import Operations
 import hoomd
+import concurrent.futures
 import json
+import sys
+import threading
 
 
 class Simulation(metaclass=Loggable):
@@ -31,6 +34,14 @@ class Simulation(metaclass=Loggable):
         self._operations = Operations()
         self._operations._simulation = self
         self._timestep = None
+        self._profiling = False
+        self._profiling_synchronize = True
+        self._straggler_period = 0
+        self._preemption_checkpoint = None
+        self._walltime_limit = None
+        self._preemption_signals = True
+        self._preemption_exit = True
+        self._async_thread = None
 
     @property
     def device(self):
@@ -92,7 +103,7 @@ class Simulation(metaclass=Loggable):
         else:
             self._system_communicator = None
 
-    def create_state_from_gsd(self, filename, frame=-1):
+    def create_state_from_gsd(self, filename, frame=-1, parallel_io=False):
         """Create the simulation state from a GSD file.
 
         Args:
@@ -100,23 +111,54 @@ class Simulation(metaclass=Loggable):
 
             frame (int): Index of the frame to read from the file. Negative
                 values index back from the last frame in the file.
+
+            parallel_io (bool): When `True` in MPI simulations with more
+                than one rank, read each rank's particles directly from the
+                file.
+
+        By default, the root rank reads the whole frame and scatters the
+        particles to the other ranks. With ``parallel_io=True``, every rank
+        memory maps the file, scans the positions to find the particles in
+        its domain, and copies only those particles into its particle data.
+        The root rank reads the header, types, and topology. This avoids
+        holding the whole system in the memory of the root rank and
+        removes the scatter, which bound the time to restart large runs.
+        All ranks must be able to read *filename*. *parallel_io* has no
+        effect on a single rank.
+
+        When the frame stores the variables of integration methods, as
+        written by `hoomd.write.Checkpoint`, integration methods added in the
+        same order continue with them at the start of the first
+        `Simulation.run`. A checkpoint also stores the domain decomposition,
+        which a simulation on the same number of MPI ranks continues with.
         """
         if self.state is not None:
             raise RuntimeError("Cannot initialize more than once\n")
         filename = _hoomd.mpi_bcast_str(filename,
                                         self.device._cpp_exec_conf)
+        parallel_io = parallel_io and self.device.communicator.num_ranks > 1
+
         # Grab snapshot and timestep
         reader = _hoomd.GSDReader(self.device._cpp_exec_conf,
-                                  filename, abs(frame), frame < 0)
+                                  filename, abs(frame), frame < 0, parallel_io)
         snapshot = Snapshot._from_cpp_snapshot(reader.getSnapshot(),
                                                self.device.communicator)
 
         step = reader.getTimeStep() if self.timestep is None else self.timestep
-        self._state = State(self, snapshot)
+        self._state = State(self, snapshot, reader.getDomainDecomposition())
+
+        if parallel_io:
+            reader.readParticlesParallel(self.state._cpp_sys_def)
+
+        # Integration methods continue with the variables in checkpoints
+        reader.restoreIntegratorData(self.state._cpp_sys_def)
 
         reader.clearSnapshot()
         # Store System and Reader for Operations
         self._cpp_sys = _hoomd.System(self.state._cpp_sys_def, step)
+        self._cpp_sys.enableProfiler(self._profiling,
+                                     self._profiling_synchronize)
+        self._cpp_sys.straggler_period = self._straggler_period
         self._init_communicator()
         self.operations._store_reader(reader)
 
@@ -145,13 +187,130 @@ class Simulation(metaclass=Loggable):
 
         # Store System and Reader for Operations
         self._cpp_sys = _hoomd.System(self.state._cpp_sys_def, step)
+        self._cpp_sys.enableProfiler(self._profiling,
+                                     self._profiling_synchronize)
+        self._cpp_sys.straggler_period = self._straggler_period
+        self._init_communicator()
+
+    def create_state_from_lattice(self, cell, n, basis=((0, 0, 0),),
+                                  typeid=None, particle_types=['A']):
+        """Create the simulation state with particles on a lattice.
+
+        Args:
+            cell (`hoomd.Box` or `dict`): Unit cell of the lattice.
+
+            n (`int` or `tuple` [`int`, `int`, `int`]): Number of unit cells
+                along each box vector. An `int` replicates the cell *n* times
+                along x and y, and along z in 3D.
+
+            basis (list [`tuple` [`float`, `float`, `float`]]): Positions of
+                the particles in the unit cell in fractions of the cell, in
+                the range [0, 1).
+
+            typeid (list [`int`]): Type id of each particle in the basis.
+                Defaults to type 0 for all particles.
+
+            particle_types (list [`str`]): Names of the particle types.
+
+        The global box is the unit cell scaled by *n*. The particles have
+        zero velocity, unit mass, and unit diameter.
+
+        Each rank generates only the lattice sites in its domain, and no
+        `Snapshot` of the whole system is built on the root rank. Use
+        `create_state_from_lattice` to create large systems in MPI
+        simulations.
+
+        When `timestep` is `None` before calling, `create_state_from_lattice`
+        sets `timestep` to 0.
+        """
+        cell = hoomd.Box.from_box(cell)
+        if isinstance(n, int):
+            n = (n, n, 1 if cell.is2D else n)
+        n = tuple(int(v) for v in n)
+        if typeid is None:
+            typeid = [0] * len(basis)
+
+        box = hoomd.Box(Lx=cell.Lx * n[0], Ly=cell.Ly * n[1],
+                        Lz=cell.Lz * n[2], xy=cell.xy, xz=cell.xz, yz=cell.yz)
+
+        cpp_basis = _hoomd.std_vector_scalar3()
+        for b in basis:
+            cpp_basis.append(_hoomd.make_scalar3(*b))
+        cpp_typeid = _hoomd.std_vector_uint()
+        for t in typeid:
+            cpp_typeid.append(int(t))
+
+        initializer = _hoomd.DistributedLatticeInitializer(
+            n[0], n[1], n[2], cpp_basis, cpp_typeid)
+        self._create_state_distributed(box, particle_types, initializer)
+
+    def create_state_random(self, box, N, seed, particle_types=['A']):
+        """Create the simulation state with randomly placed particles.
+
+        Args:
+            box (`hoomd.Box` or `dict`): Simulation box.
+
+            N (`int`): Number of particles.
+
+            seed (`int`): Random seed. In MPI simulations, all ranks use the
+                seed of the root rank.
+
+            particle_types (list [`str`]): Names of the particle types.
+
+        The particles are placed uniformly in the box, may overlap, and all
+        have the first type, zero velocity, unit mass, and unit diameter.
+
+        Each rank generates only the particles in its domain, and no
+        `Snapshot` of the whole system is built on the root rank.
+
+        When `timestep` is `None` before calling, `create_state_random`
+        sets `timestep` to 0.
+        """
+        initializer = _hoomd.DistributedRandomInitializer(int(N), int(seed))
+        self._create_state_distributed(hoomd.Box.from_box(box),
+                                       particle_types, initializer)
+
+    def _create_state_distributed(self, box, particle_types, initializer):
+        """Create the state from an initializer that works on each rank."""
+        if self.state is not None:
+            raise RuntimeError("Cannot initialize more than once\n")
+
+        # the state starts with the box and types only, the initializer adds
+        # the particles of each domain
+        snapshot = Snapshot(self.device.communicator)
+        if snapshot.exists:
+            snapshot.configuration.box = box
+            snapshot.particles.types = list(particle_types)
+
+        self._state = State(self, snapshot)
+        initializer.initialize(self.state._cpp_sys_def)
+
+        step = 0
+        if self.timestep is not None:
+            step = self.timestep
+
+        self._cpp_sys = _hoomd.System(self.state._cpp_sys_def, step)
+        self._cpp_sys.enableProfiler(self._profiling,
+                                     self._profiling_synchronize)
+        self._cpp_sys.straggler_period = self._straggler_period
         self._init_communicator()
 
     @property
     def state(self):
-        """hoomd.State: The current simulation state."""
+        """hoomd.State: The current simulation state.
+
+        Access `state` only after the future of `run_async` completes.
+        """
+        self._check_not_running()
         return self._state
 
+    def _check_not_running(self):
+        """Raise an error when another thread executes a run."""
+        thread = self._async_thread
+        if thread is not None and thread is not threading.current_thread():
+            raise RuntimeError("Wait for the result of run_async before "
+                               "accessing the simulation.")
+
     @property
     def operations(self):
         """hoomd.Operations: The operations that apply to the state."""
@@ -165,6 +324,7 @@ class Simulation(metaclass=Loggable):
             self._operations = operations
         else:
             # Handle error cases first
+            self._check_not_running()
             if operations._scheduled or operations._simulation is not None:
                 raise RuntimeError(
                     "Cannot add `hoomd.Operations` object that belongs to "
@@ -189,7 +349,7 @@ class Simulation(metaclass=Loggable):
             The start time and step are reset at the beginning of each call to
             `run`.
         """
-        if self.state is None:
+        if self._state is None:
             return None
         else:
             return self._cpp_sys.getLastTPS()
@@ -205,11 +365,192 @@ class Simulation(metaclass=Loggable):
         Note:
             `walltime` resets to 0 at the beginning of each call to `run`.
         """
-        if self.state is None:
+        if self._state is None:
             return 0
         else:
             return self._cpp_sys.walltime
 
+    @log(category='object')
+    def communication_times(self):
+        """dict: Wall clock time spent in each communication phase [seconds].
+
+        The keys are ``'migrate'`` (moving particles to the ranks that own
+        them), ``'exchange_ghosts'`` (rebuilding and sending the ghost
+        particles), and ``'update_ghosts'`` (refreshing the ghost positions).
+        The times are for this MPI rank, accumulate from the start of the first
+        `run`, and include the time spent waiting for the neighboring ranks.
+
+        `communication_times` is `None` when the simulation does not use domain
+        decomposition.
+        """
+        if (self.state is None
+                or getattr(self, '_system_communicator', None) is None):
+            return None
+        else:
+            return self._system_communicator.getCommunicationTimes()
+
+    @log(category='object')
+    def step_times(self):
+        """dict: Distribution of the wall clock time per step [seconds].
+
+        The keys are ``'p50'``, ``'p90'``, ``'p99'``, and ``'p99.9'`` (the
+        percentiles of the step times), ``'max'`` (the longest step), and
+        ``'steps'`` (the number of steps). The percentiles come from a
+        histogram with 20 logarithmic bins per decade, which resolves them to
+        about 12%. A `p99.9` or `max` much larger than `p50` points to
+        occasional slow steps, for example from I/O or operating system
+        jitter.
+
+        The times are for this MPI rank and measure the host side of GPU work.
+        They are updated during the `run` loop and reset at the beginning of
+        each call to `run`.
+        """
+        if self.state is None:
+            return None
+        else:
+            return self._cpp_sys.getStepTimes()
+
+    @property
+    def straggler_period(self):
+        """int: Steps between reports of the slowest rank (defaults to 0).
+
+        Every `straggler_period` steps of a `run`, the ranks compare the wall
+        clock time they spent in each phase of the steps since the last
+        report: ``'update'`` (tuners and updaters), ``'integrate'``, and
+        ``'analyze'``. A notice at verbosity 2 and `straggler_report` give the
+        slowest rank of each phase. Set `straggler_period` to 0 to disable the
+        reports.
+
+        Note:
+            Each report is a collective operation over all ranks.
+        """
+        return self._straggler_period
+
+    @straggler_period.setter
+    def straggler_period(self, value):
+        self._straggler_period = int(value)
+        if hasattr(self, '_cpp_sys'):
+            self._cpp_sys.straggler_period = self._straggler_period
+
+    @log(category='object')
+    def straggler_report(self):
+        """dict: The last report of the slowest rank per phase.
+
+        The keys are ``'step'`` (the step of the report) and the names of the
+        phases. The value for each phase is a `dict` with the keys
+        ``'max_time'`` (the time of the slowest rank [seconds]), ``'rank'``
+        (the slowest rank), and ``'mean_time'`` (the mean over the ranks
+        [seconds]). The times cover the steps since the previous report.
+
+        `straggler_report` is `None` before the first report. See
+        `straggler_period`.
+        """
+        if not hasattr(self, '_cpp_sys'):
+            return None
+        return self._cpp_sys.getStragglerReport()
+
+    @property
+    def profiling(self):
+        """bool: Profile the operations during `run` (defaults to ``False``).
+
+        When `profiling` is `True`, each `run` records the wall clock time
+        spent in the operations and the steps they perform, and `profile`
+        reports the totals. `write_profile_trace` writes the individual events
+        as a timeline.
+
+        Builds with ``ENABLE_NVTOOLS`` or ``ENABLE_ROCTRACER`` also mark each
+        profiled step as an NVTX or roctx range for Nsight Systems or rocprof.
+
+        Note:
+            Profiling synchronizes the GPU at the start and end of every
+            profiled step, which slows down GPU simulations. Set
+            `profiling_synchronize` to `False` to avoid this.
+        """
+        return self._profiling
+
+    @profiling.setter
+    def profiling(self, value):
+        self._profiling = bool(value)
+        if hasattr(self, '_cpp_sys'):
+            self._cpp_sys.enableProfiler(self._profiling,
+                                         self._profiling_synchronize)
+
+    @property
+    def profiling_synchronize(self):
+        """bool: Synchronize the GPU in profiled steps (defaults to ``True``).
+
+        When `False`, profiling does not wait for the GPU, so the NVTX or roctx
+        ranges show how CPU and GPU work overlap. The times in `profile` and
+        `write_profile_trace` then measure only the CPU side of GPU work.
+        """
+        return self._profiling_synchronize
+
+    @profiling_synchronize.setter
+    def profiling_synchronize(self, value):
+        self._profiling_synchronize = bool(value)
+        if hasattr(self, '_cpp_sys'):
+            self._cpp_sys.enableProfiler(self._profiling,
+                                         self._profiling_synchronize)
+
+    def _get_profiler(self):
+        if not hasattr(self, '_cpp_sys'):
+            return None
+        return self._cpp_sys.getProfiler()
+
+    @log(category='object')
+    def profile(self):
+        """dict: Totals of the profiled steps in the current or last `run`.
+
+        The keys are the names of the profiled steps, with the names of the
+        enclosing steps prepended and separated by ``/``. Each value is a
+        `dict` with the keys:
+
+        * ``'time'`` - Wall clock time on this MPI rank [seconds].
+        * ``'calls'`` - Number of times the step executed.
+        * ``'transferred_bytes'`` - Bytes copied between the host and the GPU
+          while the step executed.
+        * ``'page_faults'`` - Page faults of the process while the step
+          executed.
+
+        `profile` is `None` when the last `run` was not profiled.
+        """
+        profiler = self._get_profiler()
+        if profiler is None:
+            return None
+        return profiler.getTimings()
+
+    def write_profile_trace(self, filename):
+        """Write the profiled steps of the current or last `run` as a trace.
+
+        Args:
+            filename (str): Name of file to write.
+
+        The file uses the Chrome trace event JSON format, which
+        ``chrome://tracing`` and https://ui.perfetto.dev display as a timeline.
+        The trace holds at most about one million events per `run`.
+
+        With more than one MPI rank, each rank writes its own file. Include
+        ``{rank}`` in *filename* to insert the rank, for example
+        ``'trace.{rank}.json'``. The clocks of all ranks start together at the
+        beginning of the `run` and each file names its rank, so the events of
+        all files can be merged into one timeline to show load imbalance and
+        the time spent waiting in MPI communication.
+
+        Warning:
+            The specified file name will be overwritten.
+        """
+        profiler = self._get_profiler()
+        if profiler is None:
+            raise RuntimeError("Set profiling to True to record a trace.")
+
+        communicator = self.device.communicator
+        if communicator.num_ranks > 1 and '{rank}' not in filename:
+            raise ValueError("filename must include {rank} with more than "
+                             "one MPI rank.")
+
+        profiler.writeTrace(filename.format(rank=communicator.rank),
+                            communicator.rank)
+
     @log
     def final_timestep(self):
         """float: `run` will end at this timestep.
@@ -217,7 +558,7 @@ class Simulation(metaclass=Loggable):
         `final_timestep` is the timestep on which the currently executing `run`
         will complete.
         """
-        if self.state is None:
+        if self._state is None:
             return self.timestep
         else:
             return self._cpp_sys.final_timestep
@@ -255,6 +596,32 @@ class Simulation(metaclass=Loggable):
             if value:
                 self._state._cpp_sys_def.getParticleData().setPressureFlag()
 
+    @property
+    def always_compute_energy(self):
+        """bool: Always compute the potential energy (defaults to ``True``).
+
+        Set `always_compute_energy` to False to compute the potential energy
+        only on timesteps where it is needed (when a logged quantity requires
+        it or when using an energy minimizer). On the other timesteps, the
+        pair, bond, and special pair potentials skip the energy accumulation
+        and report zero per particle energies.
+        """
+        if not hasattr(self, '_cpp_sys'):
+            return True
+        else:
+            return self._cpp_sys.getEnergyFlag()
+
+    @always_compute_energy.setter
+    def always_compute_energy(self, value):
+        if not hasattr(self, '_cpp_sys'):
+            raise RuntimeError('Cannot set flag without state')
+        else:
+            self._cpp_sys.setEnergyFlag(value)
+
+            # if the flag is true, also set it in the particle data
+            if value:
+                self._state._cpp_sys_def.getParticleData().setEnergyFlag()
+
     def run(self, steps, write_at_start=False):
         """Advance the simulation a number of steps.
 
@@ -307,13 +674,222 @@ class Simulation(metaclass=Loggable):
             Using ``write_at_start=True`` in subsequent
             calls to `run` will result in duplicate output frames.
         """
+        self._prepare_run()
+        self._cpp_sys.run(int(steps), write_at_start)
+        self.device._save_tuning_database()
+
+        if self._cpp_sys.preempted and self._preemption_exit:
+            sys.exit(0)
+
+    def _prepare_run(self):
+        """Check the simulation and set up the operations for a run."""
+        self._check_not_running()
         # check if initialization has occurred
         if not hasattr(self, '_cpp_sys'):
             raise RuntimeError('Cannot run before state is set.')
         if not self.operations._scheduled:
             self.operations._schedule()
 
-        self._cpp_sys.run(int(steps), write_at_start)
+        checkpoint = self._preemption_checkpoint
+        if checkpoint is not None and not checkpoint._attached:
+            raise RuntimeError("Add the preemption checkpoint to "
+                               "operations.writers before calling run.")
+        self._cpp_sys.setPreemption(
+            None if checkpoint is None else checkpoint._cpp_obj,
+            0.0 if self._walltime_limit is None else self._walltime_limit,
+            self._preemption_signals)
+
+    def run_async(self, steps, write_at_start=False):
+        """Advance the simulation a number of steps in a background thread.
+
+        Args:
+            steps (int): Number of steps to advance the simulation.
+
+            write_at_start (bool): When `True`, writers
+               with triggers that evaluate `True` for the initial step will be
+               exected before the time step loop.
+
+        Returns:
+            concurrent.futures.Future: Completes with `None` when the run
+            ends, or with the exception that ended it.
+
+        `run_async` executes the same steps as `run`, but returns immediately.
+        The steps run in a new thread that releases the GIL, so the calling
+        thread can prepare the next simulation, analyze earlier output, or
+        stream results while the simulation advances. Custom actions, log
+        writers, and other Python callbacks execute in the run's thread and
+        hold the GIL while they execute.
+
+        Call ``future.result()`` to wait for the run to complete. Until then,
+        the simulation raises `RuntimeError` on access to its `state`, on
+        changes to its `operations`, and on calls to `run` or `run_async` from
+        other threads. `timestep`, `tps`, `walltime`, and `final_timestep`
+        remain available to report progress.
+
+        Example::
+
+            future = sim.run_async(1_000_000)
+            analyze(previous_frames)
+            future.result()
+            snapshot = sim.state.get_snapshot()
+
+        Note:
+            In MPI simulations, every rank must call `run_async` and wait for
+            the result, and the calling threads must not make MPI calls
+            until the run completes. Runs with more than one rank require MPI
+            initialized with at least ``MPI_THREAD_SERIALIZED``, which HOOMD
+            requests when it initializes MPI.
+
+        Note:
+            A run that is preempted (see `set_preemption`) completes the
+            future and does not exit the script. Check `preempted` after the
+            future completes.
+
+            The worker thread handles ``SIGINT`` during the run and completes
+            the future with `KeyboardInterrupt`.
+        """
+        self._prepare_run()
+        if (self.device.communicator.num_ranks > 1
+                and not _hoomd.mpi_threads_serialized()):
+            raise RuntimeError("run_async requires MPI initialized with "
+                               "MPI_THREAD_SERIALIZED or higher.")
+
+        future = concurrent.futures.Future()
+        future.set_running_or_notify_cancel()
+        thread = threading.Thread(target=self._run_async_worker,
+                                  args=(future, int(steps), write_at_start),
+                                  name='hoomd-run')
+        self._async_thread = thread
+        thread.start()
+        return future
+
+    def _run_async_worker(self, future, steps, write_at_start):
+        """Run the steps and complete the future."""
+        try:
+            self._cpp_sys.runWithoutGIL(steps, write_at_start)
+            self.device._save_tuning_database()
+        except BaseException as error:
+            self._async_thread = None
+            future.set_exception(error)
+        else:
+            self._async_thread = None
+            future.set_result(None)
+
+    def set_preemption(self,
+                       checkpoint,
+                       walltime_limit=None,
+                       signals=True,
+                       exit=True):
+        """End runs early with a checkpoint before the job is stopped.
+
+        Args:
+            checkpoint (hoomd.write.Checkpoint): Writer of the checkpoint.
+                Set to `None` to disable preemption.
+            walltime_limit (float): Wall clock time since the simulation state
+                was created at which to preempt the run [seconds]. Set to
+                `None` for no limit.
+            signals (bool): When `True`, preempt the run when the process
+                receives ``SIGUSR1`` or ``SIGTERM``.
+            exit (bool): When `True`, exit the script with status 0 after a
+                preempted run.
+
+        Batch schedulers send ``SIGUSR1`` or ``SIGTERM`` shortly before they
+        stop a job, for example with ``sbatch --signal=USR1@120`` in
+        SLURM. When a signal arrives or the wall clock time reaches
+        *walltime_limit* during `run`, the current step completes,
+        *checkpoint* writes a checkpoint on that step (unless its trigger
+        already did), and `run` returns after all output, including queued
+        asynchronous frames, is written. All MPI ranks stop on the
+        same step, at most one step after the first rank receives the signal.
+        With *exit*, the script then exits, so that the job ends cleanly.
+
+        *checkpoint* must be in `operations.writers`. Continue the simulation
+        in the next job with `create_state_from_gsd`, which also continues
+        with the domain decomposition stored in the checkpoint.
+
+        Example::
+
+            checkpoint = hoomd.write.Checkpoint(
+                filename='restart.gsd', trigger=hoomd.trigger.Periodic(100000))
+            sim.operations.writers.append(checkpoint)
+            sim.set_preemption(checkpoint, walltime_limit=23.5 * 3600)
+            sim.run(10_000_000)
+
+        Note:
+            Outside of `run`, the signals keep their default action, which
+            stops the process.
+        """
+        self._preemption_checkpoint = checkpoint
+        self._walltime_limit = walltime_limit
+        self._preemption_signals = bool(signals)
+        self._preemption_exit = bool(exit)
+
+    @property
+    def preempted(self):
+        """bool: `True` when the last `run` ended early for preemption.
+
+        See `set_preemption`.
+        """
+        if not hasattr(self, '_cpp_sys'):
+            return False
+        return self._cpp_sys.preempted
+
+    @staticmethod
+    def run_interleaved(simulations, steps, steps_per_turn=100):
+        """Advance several simulations in turns.
+
+        Args:
+            simulations (list[Simulation]): Simulations to run.
+            steps (int): Number of steps to advance each simulation.
+            steps_per_turn (int): Number of steps each simulation runs
+                before the next one takes its turn.
+
+        `run_interleaved` runs ``steps_per_turn`` steps of each simulation
+        in turn until all have advanced ``steps`` steps. When the
+        simulations share one `hoomd.device.GPU`, they share its GPU context,
+        its pool of cached temporary allocations, and its autotuner results,
+        so a kernel tuned in one simulation starts at its tuned parameter in
+        the others with the same number of particles. The GPU executes the
+        kernels of one simulation while the host launches those of the next,
+        which keeps it busier than separate processes that each create a
+        context and time share the device.
+
+        Example::
+
+            gpu = hoomd.device.GPU()
+            simulations = [hoomd.Simulation(device=gpu) for i in range(8)]
+            # ... initialize the state and operations of each simulation
+            hoomd.Simulation.run_interleaved(simulations, steps=10000)
+
+        Writers do not write at the start of the run. Call `run` with
+        ``write_at_start=True`` on each simulation first when that
+        output is needed.
+        """
+        simulations = list(simulations)
+        for simulation in simulations:
+            simulation._check_not_running()
+            if not hasattr(simulation, '_cpp_sys'):
+                raise RuntimeError('Cannot run before state is set.')
+            if not simulation.operations._scheduled:
+                simulation.operations._schedule()
+
+        steps = int(steps)
+        steps_per_turn = int(steps_per_turn)
+        if steps_per_turn < 1:
+            raise ValueError('steps_per_turn must be positive.')
+
+        while steps > 0:
+            turn = min(steps, steps_per_turn)
+            for simulation in simulations:
+                simulation._cpp_sys.run(turn, False)
+            steps -= turn
+
+        devices = []
+        for simulation in simulations:
+            if not any(simulation.device is d for d in devices):
+                devices.append(simulation.device)
+        for device in devices:
+            device._save_tuning_database()
 
     def write_debug_data(self, filename):
         """Write debug data to a JSON file.
@@ -109,3 +109,44 @@ class Snapshot:
 
     def _broadcast_box(self):
         self._cpp_obj._broadcast_box(self._comm.cpp_mpi_conf)
+
+
+class DistributedSnapshot:
+    """Particles owned by one MPI rank.
+
+    `DistributedSnapshot` holds a copy of the particles in the local domain
+    of one MPI rank, ordered by tag. Unlike `Snapshot`, which gathers the
+    whole system on the root rank, every rank takes and applies its own
+    part without communicating particle data. Use it for periodic analysis
+    of large MPI simulations where the gather dominates the cost. Obtain one
+    from `State.distributed_snapshot`.
+
+    `particles` has the same array attributes as `Snapshot.particles`,
+    with the same conventions: positions are wrapped into the box and the
+    images count the periods crossed. ``particles.tag`` holds the global
+    tag of each local particle. Row ``i`` of this rank's arrays is row
+    ``offset + i`` of the concatenation of all ranks' arrays in rank order.
+
+    Note:
+        `DistributedSnapshot` holds only particle data. Bonds, angles, and
+        the other topology are not included and remain unchanged when a
+        `DistributedSnapshot` is applied.
+    """
+
+    def __init__(self, cpp_obj):
+        self._cpp_obj = cpp_obj
+
+    @property
+    def particles(self):
+        """Particle data of the local particles."""
+        return self._cpp_obj
+
+    @property
+    def N_global(self):
+        """int: Number of particles on all ranks."""
+        return self._cpp_obj.N_global
+
+    @property
+    def offset(self):
+        """int: Number of particles on the lower ranks."""
+        return self._cpp_obj.offset
@@ -8,17 +8,21 @@ from collections import defaultdict
 
 from . import _hoomd
 from hoomd.box import Box
-from hoomd.snapshot import Snapshot
+from hoomd.snapshot import Snapshot, DistributedSnapshot
 from hoomd.data import LocalSnapshot, LocalSnapshotGPU
 import hoomd
 
 
-def _create_domain_decomposition(device, box):
+def _create_domain_decomposition(device, box, stored=None):
     """Create a default domain decomposition.
 
     This method is a quick hack to get basic MPI simulations working with
     the new API. We will need to consider designing an appropriate user-facing
     API to set the domain decomposition.
+
+    *stored* is the ``(grid, cumulative_x, cumulative_y, cumulative_z)`` tuple
+    of the domain decomposition in a checkpoint. When the grid matches the
+    number of ranks, the decomposition continues with the stored domains.
     """
     if not hoomd.version.mpi_enabled:
         return None
@@ -28,13 +32,26 @@ def _create_domain_decomposition(device, box):
     if device.communicator.num_ranks == 1:
         return None
 
-    # create a default domain decomposition
+    if stored is not None:
+        grid, cumulative_x, cumulative_y, cumulative_z = stored
+        if grid[0] * grid[1] * grid[2] == device.communicator.num_ranks:
+            result = _hoomd.DomainDecomposition(device._cpp_exec_conf,
+                                                box.getL(), grid[0], grid[1],
+                                                grid[2], False)
+            result.setCumulativeFractions(cumulative_x, cumulative_y,
+                                          cumulative_z, 0)
+            return result
+
+    # create a default domain decomposition, mapped onto the nodes so that
+    # neighboring domains share a node where possible. The C++ code falls back
+    # to a one-level decomposition when the nodes have different numbers of
+    # ranks.
     result = _hoomd.DomainDecomposition(device._cpp_exec_conf,
                                         box.getL(),
                                         0,
                                         0,
                                         0,
-                                        False)
+                                        True)
 
     return result
 
@@ -59,12 +76,13 @@ class State:
         `State` object.
     """
 
-    def __init__(self, simulation, snapshot):
+    def __init__(self, simulation, snapshot, domain_decomposition=None):
         self._simulation = simulation
         snapshot._broadcast_box()
         domain_decomp = _create_domain_decomposition(
             simulation.device,
-            snapshot._cpp_obj._global_box)
+            snapshot._cpp_obj._global_box,
+            domain_decomposition)
 
         if domain_decomp is not None:
             self._cpp_sys_def = _hoomd.SystemDefinition(
@@ -78,10 +96,12 @@ class State:
         # snapshots are not contexted at once.
         self._in_context_manager = False
 
-        # self._groups provides a cache of C++ group objects of the form:
-        # {type(filter): {filter: C++ group}}
-        # The first layer is to prevent user created filters with poorly implemented
-        # __hash__ and __eq__ from causing cache errors.
+        # self._groups maps equal filters to the first filter object seen:
+        # {type(filter): {filter: filter}}
+        # The C++ SystemDefinition caches groups by filter object, so equal
+        # filters share one group. The first layer is to prevent user created
+        # filters with poorly implemented __hash__ and __eq__ from causing cache
+        # errors.
         self._groups = defaultdict(dict)
 
     @property
@@ -137,6 +157,83 @@ class State:
 
         self._cpp_sys_def.initializeFromSnapshot(snapshot._cpp_obj)
 
+    @property
+    def distributed_snapshot(self):
+        r"""hoomd.DistributedSnapshot: Local particles of this MPI rank.
+
+        Each rank gets a copy of its own particles in tag order, without the
+        gather on the root rank that `State.snapshot` performs. Getting and
+        setting `distributed_snapshot` is an order :math:`O(N_{local})`
+        operation on each rank. Both must be called on all ranks.
+
+        Setting `distributed_snapshot` replaces the particle data on every
+        rank. Each rank must keep its own particles: the tags of all ranks
+        together must be ``0`` to ``N_global - 1`` and each particle must
+        remain in the local domain of its rank. The particle types cannot
+        change. Bonds and other topology are unchanged.
+
+        Example::
+
+            snap = sim.state.distributed_snapshot
+            snap.particles.velocity[:] *= 0.5
+            sim.state.distributed_snapshot = snap
+        """
+        cpp_snapshot = _hoomd.DistributedSnapshotParticleData_double()
+        self._cpp_sys_def.getParticleData().takeDistributedSnapshot_double(
+            cpp_snapshot)
+        return DistributedSnapshot(cpp_snapshot)
+
+    @distributed_snapshot.setter
+    def distributed_snapshot(self, snapshot):
+        if len(snapshot.particles.types) != len(self.particle_types):
+            raise RuntimeError("Number of particle types must remain the same")
+        pdata = self._cpp_sys_def.getParticleData()
+        pdata.initializeFromDistributedSnapshot_double(snapshot._cpp_obj)
+
+    def take_checkpoint(self, checkpoint=None):
+        """Copy the system state into an in-memory checkpoint.
+
+        Args:
+            checkpoint (StateCheckpoint): Checkpoint to overwrite. When
+                `None`, create a new one.
+
+        Returns:
+            StateCheckpoint: The checkpoint.
+
+        The checkpoint holds a copy of the particles, bonded groups, box, and
+        integrator variables of each MPI rank, in device memory on the GPU.
+        Unlike `snapshot`, it does not gather the data on the root rank or
+        copy it to the host. Overwriting the same checkpoint reuses its
+        memory. Must be called on all ranks.
+
+        Use checkpoints to reset the simulation to an earlier state many
+        times, as in forward flux sampling::
+
+            checkpoint = sim.state.take_checkpoint()
+            for trial in range(n_trials):
+                sim.state.restore_checkpoint(checkpoint)
+                sim.run(1000)
+        """
+        if checkpoint is None:
+            checkpoint = StateCheckpoint()
+        self._cpp_sys_def.takeCheckpoint(checkpoint._cpp_obj)
+        return checkpoint
+
+    def restore_checkpoint(self, checkpoint):
+        """Reset the system state to an in-memory checkpoint.
+
+        Args:
+            checkpoint (StateCheckpoint): Checkpoint to restore, taken with
+                `take_checkpoint` from this state.
+
+        The particle data is copied back in place and is reallocated only
+        when a rank has more local particles than at any time before. The
+        checkpoint does not store the timestep, which continues to
+        increase. Particles and bonds may not be added or removed between
+        taking and restoring a checkpoint. Must be called on all ranks.
+        """
+        self._cpp_sys_def.restoreCheckpoint(checkpoint._cpp_obj)
+
     @property
     def particle_types(self):
         """list[str]: List of all particle types in the simulation."""
@@ -249,12 +346,8 @@ class State:
 
     def _get_group(self, filter_):
         cls = filter_.__class__
-        if filter_ in self._groups[cls]:
-            return self._groups[cls][filter_]
-        else:
-            group = _hoomd.ParticleGroup(self._cpp_sys_def, filter_)
-            self._groups[cls][filter_] = group
-            return group
+        filter_ = self._groups[cls].setdefault(filter_, filter_)
+        return self._cpp_sys_def.getGroup(filter_)
 
     def update_group_dof(self):
         """Update the number of degrees of freedom in each group.
@@ -269,17 +362,15 @@ class State:
         """
         integrator = self._simulation.operations.integrator
 
-        for groups in self._groups.values():
-            for group in groups.values():
-                if integrator is not None:
-                    if not integrator._attached:
-                        raise RuntimeError(
-                            "Call update_group_dof after attaching")
+        for group in self._cpp_sys_def.getGroups():
+            if integrator is not None:
+                if not integrator._attached:
+                    raise RuntimeError("Call update_group_dof after attaching")
 
-                    integrator._cpp_obj.updateGroupDOF(group)
-                else:
-                    group.setTranslationalDOF(0)
-                    group.setRotationalDOF(0)
+                integrator._cpp_obj.updateGroupDOF(group)
+            else:
+                group.setTranslationalDOF(0)
+                group.setRotationalDOF(0)
 
     @property
     def cpu_local_snapshot(self):
@@ -308,6 +399,16 @@ class State:
             with sim.state.cpu_local_snapshot as data:
                 data.particles.position[:, 2] = 0
 
+        In GPU simulations, accessing an array copies all of it to the host.
+        Use ``rows`` to copy only a range of the local data, which is written
+        back only if it changed:
+
+        .. code-block:: python
+
+            with sim.state.cpu_local_snapshot as data:
+                first = data.particles.rows(0, 10)
+                first.velocity[:] = 0
+
         Note:
             The state's box and the number of particles, bonds, angles,
             dihedrals, impropers, constaints, and pairs cannot change within the
@@ -409,3 +510,15 @@ class State:
         """
         group = self._get_group(filter)
         group.thermalizeParticleMomenta(kT, seed, self._simulation.timestep)
+
+
+class StateCheckpoint:
+    """In-memory copy of the simulation state.
+
+    Create checkpoints with `State.take_checkpoint` and restore them with
+    `State.restore_checkpoint`. The checkpoint can only be restored to the
+    state it was taken from.
+    """
+
+    def __init__(self):
+        self._cpp_obj = _hoomd.SystemCheckpoint()
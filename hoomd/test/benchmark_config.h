@@ -0,0 +1,194 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+/*! \file benchmark_config.h
+    \brief Minimal harness for the C++ microbenchmarks
+    \details The benchmarks time small kernels (evaluators, shape overlap checks, tree and neighbor list builds) in
+    isolation, without Python. Each benchmark executable accepts these arguments:
+
+    - `--repeat=N` number of timed repetitions of each workload (default 10)
+    - `--filter=S` only run the workloads whose name contains S
+    - `--json=FILE` write the results to FILE instead of standard output
+    - `name=value` override the integer workload parameter `name`
+
+    The results are written as JSON: one entry per workload with its parameters and the minimum, median, and mean
+    time of the repetitions in seconds.
+
+    \note This file should be included only once and by a file that will compile into a benchmark executable
+*/
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/HOOMDMPI.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace hoomd
+{
+namespace benchmark
+{
+
+//! Sink for the results of the benchmarked kernels, so that the compiler cannot remove the computation
+volatile double sink = 0;
+
+//! Parses the arguments, times the workloads, and writes the results
+class Runner
+    {
+    public:
+        //! Parse the command line
+        Runner(int argc, char **argv)
+            : m_repeat(10)
+            {
+            for (int i = 1; i < argc; ++i)
+                {
+                std::string arg(argv[i]);
+                if (arg.compare(0, 9, "--repeat=") == 0)
+                    m_repeat = std::max(1, std::atoi(arg.c_str() + 9));
+                else if (arg.compare(0, 9, "--filter=") == 0)
+                    m_filter = arg.substr(9);
+                else if (arg.compare(0, 7, "--json=") == 0)
+                    m_json_file = arg.substr(7);
+                else if (arg.find('=') != std::string::npos && arg.compare(0, 2, "--") != 0)
+                    m_params[arg.substr(0, arg.find('='))] = std::atol(arg.substr(arg.find('=') + 1).c_str());
+                else
+                    throw std::runtime_error("Unknown benchmark argument: " + arg);
+                }
+            }
+
+        //! Get a workload parameter
+        /*! \param name Name of the parameter
+            \param default_value Value when the parameter is not given on the command line
+        */
+        unsigned int getParam(const std::string& name, unsigned int default_value) const
+            {
+            auto param = m_params.find(name);
+            return (param == m_params.end()) ? default_value : (unsigned int)param->second;
+            }
+
+        //! Time a workload
+        /*! \param name Name of the workload
+            \param params Parameters of the workload, reported with the results
+            \param items Number of items (pairs, particles, ...) that one call to \a f processes
+            \param f Function that runs the workload once
+
+            \a f is called once untimed to warm up the caches, then timed \a repeat times.
+        */
+        template<class F>
+        void run(const std::string& name, const std::map<std::string, unsigned int>& params, uint64_t items, F f)
+            {
+            if (!m_filter.empty() && name.find(m_filter) == std::string::npos)
+                return;
+
+            f();
+
+            std::vector<double> times(m_repeat);
+            for (unsigned int i = 0; i < m_repeat; ++i)
+                {
+                auto start = std::chrono::steady_clock::now();
+                f();
+                auto end = std::chrono::steady_clock::now();
+                times[i] = std::chrono::duration<double>(end - start).count();
+                }
+
+            Result result;
+            result.name = name;
+            result.params = params;
+            result.items = items;
+            std::sort(times.begin(), times.end());
+            result.min_time = times.front();
+            result.median_time = times[times.size() / 2];
+            result.mean_time = 0;
+            for (auto t : times)
+                result.mean_time += t / double(times.size());
+            m_results.push_back(result);
+
+            std::cerr << name << ": " << result.median_time << " s (median of " << m_repeat << ")" << std::endl;
+            }
+
+        //! Write the results as JSON
+        /*! \returns The exit code of the benchmark executable
+        */
+        int finish() const
+            {
+            std::ofstream file;
+            if (!m_json_file.empty())
+                file.open(m_json_file);
+            std::ostream& out = m_json_file.empty() ? std::cout : file;
+
+            out << "{\"repeat\": " << m_repeat << ", \"benchmarks\": [";
+            for (unsigned int i = 0; i < m_results.size(); ++i)
+                {
+                const Result& result = m_results[i];
+                out << (i ? ",\n  " : "\n  ") << "{\"name\": \"" << result.name << "\", \"params\": {";
+                bool first = true;
+                for (auto const& param : result.params)
+                    {
+                    out << (first ? "" : ", ") << "\"" << param.first << "\": " << param.second;
+                    first = false;
+                    }
+                out << "}, \"items\": " << result.items
+                    << ", \"min_time\": " << result.min_time
+                    << ", \"median_time\": " << result.median_time
+                    << ", \"mean_time\": " << result.mean_time
+                    << ", \"items_per_second\": " << double(result.items) / result.median_time << "}";
+                }
+            out << "\n]}" << std::endl;
+            return out.good() ? 0 : 1;
+            }
+
+    private:
+        //! Timings of one workload
+        struct Result
+            {
+            std::string name;                           //!< Name of the workload
+            std::map<std::string, unsigned int> params; //!< Parameters of the workload
+            uint64_t items;                             //!< Items processed per repetition
+            double min_time;                            //!< Shortest repetition [seconds]
+            double median_time;                         //!< Median repetition [seconds]
+            double mean_time;                           //!< Mean repetition [seconds]
+            };
+
+        unsigned int m_repeat;                  //!< Number of timed repetitions
+        std::string m_filter;                   //!< Only run workloads whose name contains this
+        std::string m_json_file;                //!< Output file, empty for standard output
+        std::map<std::string, long> m_params;   //!< Parameters given on the command line
+        std::vector<Result> m_results;          //!< Results of the workloads
+    };
+
+} // end namespace benchmark
+} // end namespace hoomd
+
+//! Define the main function of a benchmark executable
+/*! \param body Function taking a hoomd::benchmark::Runner& that runs the workloads
+*/
+#ifdef ENABLE_MPI
+#define HOOMD_BENCHMARK_MAIN(body) \
+int main(int argc, char **argv) \
+    { \
+    MPI_Init(&argc, &argv); \
+    int val; \
+        { \
+        hoomd::benchmark::Runner runner(argc, argv); \
+        body(runner); \
+        val = runner.finish(); \
+        } \
+    MPI_Finalize(); \
+    return val; \
+    }
+#else
+#define HOOMD_BENCHMARK_MAIN(body) \
+int main(int argc, char **argv) \
+    { \
+    hoomd::benchmark::Runner runner(argc, argv); \
+    body(runner); \
+    return runner.finish(); \
+    }
+#endif
@@ -336,6 +336,42 @@ UP_TEST( uniform_float_test )
     check_range(gen, 5000000, a, b);
     }
 
+//! Test that RandomGeneratorBatch reproduces the streams of RandomGenerator
+UP_TEST( batch_matches_generator_test )
+    {
+    const unsigned int W = hoomd::RandomGeneratorBatch<>::width;
+    uint32_t tags[W];
+    for (unsigned int l = 0; l < W; l++)
+        tags[l] = 1000*l + 7;
+
+    hoomd::RandomGeneratorBatch<> batch(12, 345, tags, 6789, 3);
+    std::vector<hoomd::RandomGenerator> rngs;
+    for (unsigned int l = 0; l < W; l++)
+        rngs.push_back(hoomd::RandomGenerator(12, 345, tags[l], 6789, 3));
+
+    // raw values
+    uint32_t u[4][W];
+    batch(u);
+    for (unsigned int l = 0; l < W; l++)
+        {
+        auto v = rngs[l]();
+        for (unsigned int i = 0; i < 4; i++)
+            UP_ASSERT_EQUAL(u[i][l], v.v[i]);
+        }
+
+    // uniform values
+    double uniform[W];
+    batch.uniform(-1.0, 1.0, uniform);
+    for (unsigned int l = 0; l < W; l++)
+        UP_ASSERT_EQUAL(uniform[l], hoomd::UniformDistribution<double>(-1.0, 1.0)(rngs[l]));
+
+    // normal values
+    float normal[W];
+    batch.normal(normal);
+    for (unsigned int l = 0; l < W; l++)
+        UP_ASSERT_EQUAL(normal[l]*2.5f, hoomd::NormalDistribution<float>(2.5f)(rngs[l]));
+    }
+
 //! Test case for UniformIntDistribution
 UP_TEST( uniform_int_test_1000 )
     {
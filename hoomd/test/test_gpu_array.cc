@@ -204,6 +204,58 @@ UP_TEST( GPUArray_transfer_tests )
         }
     }
 
+//! test case for host access to ranges of elements of data on the device
+UP_TEST( GPUArray_range_transfer_tests )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::GPU));
+    UP_ASSERT(exec_conf->isCUDAEnabled());
+
+    // several pages of data
+    GPUArray<int> gpu_array(10000, exec_conf);
+
+        {
+        ArrayHandle<int> d_handle(gpu_array, access_location::device, access_mode::readwrite);
+        gpu_fill_test_pattern(d_handle.data, gpu_array.getNumElements());
+        hipError_t err_sync = hipGetLastError();
+        exec_conf->handleHIPError(err_sync, __FILE__, __LINE__);
+        }
+
+    // read and write single elements on the host
+        {
+        ArrayHandle<int> h_handle(gpu_array, access_location::host, access_mode::read, 10, 1);
+        UP_ASSERT_EQUAL(h_handle.data[10], 100);
+        }
+
+        {
+        ArrayHandle<int> h_handle(gpu_array, access_location::host, access_mode::readwrite, 5000, 2);
+        UP_ASSERT_EQUAL(h_handle.data[5000], 5000*5000);
+        UP_ASSERT_EQUAL(h_handle.data[5001], 5001*5001);
+        h_handle.data[5000] = -1;
+        h_handle.data[5001] = -2;
+        }
+
+    // the written elements reach the device and the rest of the data stays valid there
+        {
+        ArrayHandle<int> d_handle(gpu_array, access_location::device, access_mode::readwrite);
+        gpu_add_one(d_handle.data, gpu_array.getNumElements());
+        hipError_t err_sync = hipGetLastError();
+        exec_conf->handleHIPError(err_sync, __FILE__, __LINE__);
+        }
+
+        {
+        ArrayHandle<int> h_handle(gpu_array, access_location::host, access_mode::read);
+        for (int i = 0; i < (int)gpu_array.getNumElements(); i++)
+            {
+            if (i == 5000)
+                UP_ASSERT_EQUAL(h_handle.data[i], 0);
+            else if (i == 5001)
+                UP_ASSERT_EQUAL(h_handle.data[i], -1);
+            else
+                UP_ASSERT_EQUAL(h_handle.data[i], i*i+1);
+            }
+        }
+    }
+
 //! Tests operations on NULL GPUArrays
 UP_TEST( GPUArray_null_tests )
     {
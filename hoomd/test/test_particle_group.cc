@@ -223,6 +223,49 @@ UP_TEST( ParticleGroup_sort_test )
     }
     }
 
+//! Checks that ParticleGroup remaps its index list after a permutation of the particles
+UP_TEST( ParticleGroup_permutation_test )
+    {
+    std::shared_ptr<SystemDefinition> sysdef = create_sysdef();
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::shared_ptr<ParticleFilter> selector04(new ParticleFilterTags(std::vector<unsigned int>({0,1,2,3,4})));
+    ParticleGroup tags04(sysdef, selector04);
+    CHECK_EQUAL_UINT(tags04.getNumMembers(), 5);
+
+    // rotate the particles, particle i now has tag (i+3) % 10
+    {
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_rtag(pdata->getRTags(), access_location::host, access_mode::readwrite);
+    for (unsigned int i = 0; i < 10; i++)
+        {
+        h_tag.data[i] = (i + 3) % 10;
+        h_rtag.data[(i + 3) % 10] = i;
+        }
+    }
+
+    pdata->notifyParticleSort(particle_sort::permutation);
+
+    // tags 0-4 are now particles 7, 8, 9, 0, 1, listed in index order
+    unsigned int expected_idx[] = {0, 1, 7, 8, 9};
+    CHECK_EQUAL_UINT(tags04.getNumMembers(), 5);
+    for (unsigned int i = 0; i < 5; i++)
+        {
+        CHECK_EQUAL_UINT(tags04.getMemberTag(i), i);
+        CHECK_EQUAL_UINT(tags04.getMemberIndex(i), expected_idx[i]);
+        }
+    {
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        if (h_tag.data[i] <= 4)
+            UP_ASSERT(tags04.isMember(i));
+        else
+            UP_ASSERT(!tags04.isMember(i));
+        }
+    }
+    }
+
 //! Checks that ParticleGroup can initialize by particle type
 UP_TEST( ParticleGroup_type_test )
     {
@@ -342,6 +385,43 @@ UP_TEST( ParticleGroup_tag_test )
     CHECK_EQUAL_UINT(tags59.getMemberTag(4), 9);
     }
 
+//! Checks that a small group in a large system looks up its members in the hash set of member tags
+UP_TEST( ParticleGroup_sparse_tag_test )
+    {
+    BoxDim box(100.0);
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(1000, box, 1));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::shared_ptr<ParticleFilter> selector(new ParticleFilterTags(std::vector<unsigned int>({3,500,999})));
+    ParticleGroup sparse(sysdef, selector);
+    CHECK_EQUAL_UINT(sparse.getNumMembers(), 3);
+    CHECK_EQUAL_UINT(sparse.getMemberTag(0), 3);
+    CHECK_EQUAL_UINT(sparse.getMemberTag(1), 500);
+    CHECK_EQUAL_UINT(sparse.getMemberTag(2), 999);
+
+    // reverse the particles and force a rebuild of the index list
+    {
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_rtag(pdata->getRTags(), access_location::host, access_mode::readwrite);
+    for (unsigned int i = 0; i < 1000; i++)
+        {
+        h_tag.data[i] = 999 - i;
+        h_rtag.data[999 - i] = i;
+        }
+    }
+    pdata->notifyParticleSort();
+
+    CHECK_EQUAL_UINT(sparse.getNumMembers(), 3);
+    CHECK_EQUAL_UINT(sparse.getMemberIndex(0), 0);
+    CHECK_EQUAL_UINT(sparse.getMemberIndex(1), 499);
+    CHECK_EQUAL_UINT(sparse.getMemberIndex(2), 996);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        bool member = (i == 0 || i == 499 || i == 996);
+        UP_ASSERT_EQUAL(sparse.isMember(i), member);
+        }
+    }
+
 //! Checks that ParticleGroup can initialize by cuboid
 UP_TEST( ParticleGroup_cuboid_test )
     {
@@ -382,3 +382,42 @@ class Or(_hoomd.OrTrigger, Trigger):
         """Return a Boolean indicating whether the two triggers are equivalent.
         """
         return isinstance(other, Or) and self.triggers == other.triggers
+
+
+class Expression(_hoomd.ExpressionTrigger, Trigger):
+    """Trigger on the steps where a formula is nonzero.
+
+    Args:
+        expression (str): The formula in the time step ``t``.
+
+    `hoomd.trigger.Expression` compiles *expression* once and evaluates it in
+    C++ without calling Python. It returns `True` when the value is not zero::
+
+        return expression(t) != 0
+
+    The formula uses the syntax of `hoomd.variant.Expression`.
+
+    Example::
+
+            # trigger every 100 time steps during the first 10000 steps,
+            # then every 1000
+            trigger = hoomd.trigger.Expression(
+                "(t < 10000 and t % 100 == 0) or t % 1000 == 0")
+
+    Attributes:
+        expression (str): The formula in the time step ``t``.
+    """
+
+    def __init__(self, expression):
+        Trigger.__init__(self)
+        _hoomd.ExpressionTrigger.__init__(self, expression)
+
+    def __str__(self):
+        """Human readable representation of the trigger as a string."""
+        return f"hoomd.trigger.Expression(expression={self.expression!r})"
+
+    def __eq__(self, other):
+        """Return a Boolean indicating whether the two triggers are equivalent.
+        """
+        return (isinstance(other, Expression)
+                and self.expression == other.expression)
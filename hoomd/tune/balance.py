@@ -1,6 +1,7 @@
 """Define LoadBalancer."""
 
 from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyFrom
 from hoomd.operation import Tuner
 from hoomd.trigger import Trigger
 from hoomd import _hoomd
@@ -19,6 +20,10 @@ class LoadBalancer(Tuner):
         tolerance (:obj:`float`): Load imbalance tolerance.
         max_iterations (:obj:`int`): Maximum number of iterations to
             attempt in a single step.
+        weight (:obj:`str`): Quantity to balance, ``'particles'`` or
+            ``'time'``.
+        fit (:obj:`bool`): Fit the domain boundaries to the load
+            distribution on the first update when `True`.
 
     `LoadBalancer` adjusts the boundaries of the MPI domains to distribute
     the particle load close to evenly between them. The load imbalance is
@@ -48,6 +53,36 @@ class LoadBalancer(Tuner):
     significantly more pair force neighbors than others, this estimate of the
     load imbalance may not produce the optimal results.
 
+    Set *weight* to ``'time'`` to balance the measured cost instead of the
+    number of particles. `LoadBalancer` then measures the wall clock time per
+    step that each rank spends outside of communication between two updates,
+    and weights every particle on a rank by that time divided by the number of
+    particles on the rank:
+
+    .. math::
+
+        I = \frac{c_i N_i}{\sum_j c_j N_j / P}
+
+    where :math:`c_i` is the measured cost per particle on rank :math:`i`.
+    Ranks with expensive particles, such as those in a dense liquid next to a
+    vapor or in clusters of rigid bodies, shrink. The first update after
+    attaching (or after changing *weight*) has no measurement and balances the
+    number of particles. Time weighting needs several time steps between
+    updates for a meaningful measurement, and work that synchronizes all ranks
+    outside of the communicator (such as computing thermodynamic quantities)
+    adds noise to it.
+
+    The 5% limit makes the incremental adjustment slow to follow strongly
+    non-uniform systems, such as a droplet in vapor or a slab. Set *fit* to
+    `True` to fit the boundaries directly on the first update.
+    `LoadBalancer` then bins the load along each balanced dimension and places
+    the cut planes at the quantiles of the histogram, so that every slab of
+    domains holds the same load. This is a coordinate bisection restricted to
+    the rectilinear grid of domains: the cut planes still span the whole box.
+    Every domain remains at least twice the ghost layer wide. Later updates
+    refine the fit incrementally. Setting *fit* to `True` again fits the
+    boundaries on the next update.
+
     A load balancing adjustment is only performed when the maximum load
     imbalance exceeds a *tolerance*. The ideal load balance is 1.0, so setting
     *tolerance* less than 1.0 will force an adjustment every update. The load
@@ -82,6 +117,10 @@ class LoadBalancer(Tuner):
         tolerance (:obj:`float`): Load imbalance tolerance.
         max_iterations (:obj:`int`): Maximum number of iterations to
             attempt in a single step.
+        weight (:obj:`str`): Quantity to balance, ``'particles'`` or
+            ``'time'``.
+        fit (:obj:`bool`): Fit the domain boundaries to the load
+            distribution on the first update when `True`.
     """
 
     def __init__(self,
@@ -90,18 +129,24 @@ class LoadBalancer(Tuner):
                  y=True,
                  z=True,
                  tolerance=1.02,
-                 max_iterations=1):
+                 max_iterations=1,
+                 weight='particles',
+                 fit=False):
         defaults = dict(x=x,
                         y=y,
                         z=z,
                         tolerance=tolerance,
                         max_iterations=max_iterations,
+                        weight=weight,
+                        fit=fit,
                         trigger=trigger)
         self._param_dict = ParameterDict(x=bool,
                                          y=bool,
                                          z=bool,
                                          max_iterations=int,
                                          tolerance=float,
+                                         weight=OnlyFrom(['particles', 'time']),
+                                         fit=bool,
                                          trigger=Trigger)
         self._param_dict.update(defaults)
 
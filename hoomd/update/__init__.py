@@ -1,5 +1,6 @@
 from hoomd.update.box_resize import BoxResize
 from hoomd.update.custom_updater import CustomUpdater
+from hoomd.update.replica_exchange import ReplicaExchange
 
 
 # TODO remove class
@@ -4,6 +4,7 @@ from hoomd.data.parameterdicts import ParameterDict
 from hoomd.data.typeconverter import OnlyType, box_preprocessing
 from hoomd.variant import Variant, Constant
 from hoomd import _hoomd
+import hoomd
 
 
 class BoxResize(Updater):
@@ -63,7 +64,11 @@ class BoxResize(Updater):
         super().__init__(trigger)
 
     def _attach(self):
-        self._cpp_obj = _hoomd.BoxResizeUpdater(
+        if isinstance(self._simulation.device, hoomd.device.GPU):
+            cpp_cls = _hoomd.BoxResizeUpdaterGPU
+        else:
+            cpp_cls = _hoomd.BoxResizeUpdater
+        self._cpp_obj = cpp_cls(
             self._simulation.state._cpp_sys_def,
             self.box1,
             self.box2,
@@ -96,8 +101,9 @@ class BoxResize(Updater):
             state (State): System state to scale.
             box (Box): New box.
         """
-        updater = _hoomd.BoxResizeUpdater(state._cpp_sys_def,
-                                          state.box,
-                                          box,
-                                          Constant(1))
+        if isinstance(state._simulation.device, hoomd.device.GPU):
+            cpp_cls = _hoomd.BoxResizeUpdaterGPU
+        else:
+            cpp_cls = _hoomd.BoxResizeUpdater
+        updater = cpp_cls(state._cpp_sys_def, state.box, box, Constant(1))
         updater.update(state._simulation.timestep)
@@ -0,0 +1,214 @@
+"""Define the ReplicaExchange updater."""
+
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyFrom, OnlyType
+from hoomd.integrate import BaseIntegrator
+from hoomd.logging import log
+from hoomd.operation import Compute, Updater
+from hoomd.variant import Constant
+from hoomd import _hoomd
+
+
+class ReplicaExchange(Updater):
+    r"""Exchange thermodynamic parameters between replicas.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps on which to
+            attempt exchanges.
+
+        parameter (str): Exchanged parameter: ``'kT'``, ``'pressure'``, or
+            ``'hamiltonian'``.
+
+        values (list[float]): Parameter value of each replica.
+
+        seed (int): Random number seed, the same on all partitions.
+
+        observable (hoomd.operation.Operation): Compute or
+            integrator that provides the observable conjugate to the
+            parameter.
+
+        quantity (str): Name of the observable's log quantity, such as
+            ``'potential_energy'`` for
+            `hoomd.md.compute.ThermodynamicQuantities` or
+            ``'hpmc_patch_energy'`` for an HPMC integrator.
+
+        kT (float): Temperature of the ``'pressure'`` and ``'hamiltonian'``
+            exchanges :math:`[\mathrm{energy}]`.
+
+    Run one replica per MPI partition (see `hoomd.communicator.Communicator`)
+    with one `ReplicaExchange` in each. Replica :math:`p` starts at
+    ``values[p]``. On each triggered step, `ReplicaExchange` attempts to swap
+    the values of the replicas at ``values[k]`` and ``values[k+1]`` for all even
+    :math:`k`, and for all odd :math:`k` on the next triggered step. A swap is
+    accepted with the probability
+
+    .. math::
+
+        \min\left(1, e^{(c_k - c_{k+1}) (x_p - x_q)}\right)
+
+    where :math:`p` and :math:`q` are the replicas at the values :math:`k` and
+    :math:`k+1`, and:
+
+    * ``'kT'``: :math:`c_k = 1/kT_k` and :math:`x` is the potential energy.
+    * ``'pressure'``: :math:`c_k = P_k/kT` and :math:`x` is the box volume
+      (*observable* is not needed).
+    * ``'hamiltonian'``: :math:`c_k = \lambda_k/kT` and :math:`x` is the
+      energy term that :math:`\lambda` scales.
+
+    The partitions exchange only the observables. The configurations stay in
+    place and the values move between the partitions: `variant` holds the
+    value of the replica on this partition. Pass it as the ``kT`` parameter of
+    MD integration methods or the pressure parameter of barostats and HPMC box
+    moves so they follow the exchanges.
+
+    Examples::
+
+        communicator = hoomd.communicator.Communicator(nrank=1)
+        remd = hoomd.update.ReplicaExchange(
+            trigger=hoomd.trigger.Periodic(1000),
+            parameter='kT',
+            values=[1.0, 1.1, 1.2, 1.3],
+            seed=2,
+            observable=thermo,
+            quantity='potential_energy')
+        nvt = hoomd.md.methods.NVT(filter=hoomd.filter.All(),
+                                   kT=remd.variant, tau=1.0)
+        sim.operations.updaters.append(remd)
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps on which to
+            attempt exchanges.
+
+        parameter (str): Exchanged parameter.
+
+        values (list[float]): Parameter value of each replica.
+
+        seed (int): Random number seed.
+
+        observable (hoomd.operation.Operation): Operation that provides the
+            observable.
+
+        quantity (str): Name of the observable's log quantity.
+
+        kT (float): Temperature of the ``'pressure'`` and ``'hamiltonian'``
+            exchanges :math:`[\mathrm{energy}]`.
+
+        variant (hoomd.variant.Constant): Value of the replica on this
+            partition.
+    """
+
+    _parameters = ['kT', 'pressure', 'hamiltonian']
+
+    def __init__(self, trigger, parameter, values, seed, observable=None,
+                 quantity='', kT=1.0):
+        super().__init__(trigger)
+        self._param_dict.update(ParameterDict(
+            parameter=OnlyFrom(self._parameters),
+            values=[float],
+            seed=int,
+            observable=OnlyType((Compute, BaseIntegrator), strict=True,
+                                allow_none=True),
+            quantity=str,
+            kT=float))
+        self.parameter = parameter
+        self.values = values
+        self.seed = seed
+        self.observable = observable
+        self.quantity = quantity
+        self.kT = kT
+        self._variant = Constant(self.values[0])
+
+    @property
+    def variant(self):
+        return self._variant
+
+    def _attach(self):
+        self._cpp_obj = self._make_cpp_obj()
+        self._set_observable()
+        super()._attach()
+
+    def _make_cpp_obj(self):
+        return _hoomd.UpdaterReplicaExchange(
+            self._simulation.state._cpp_sys_def, list(self.values),
+            self.parameter, self.kT, self._variant, self.seed)
+
+    def _set_observable(self):
+        observable = self.observable
+        if observable is None:
+            if self.parameter != 'pressure':
+                raise RuntimeError("The {} exchange needs an observable."
+                                   .format(self.parameter))
+            return
+        if not observable._attached:
+            raise RuntimeError("The observable must be added to the "
+                               "simulation's operations.")
+        if isinstance(observable, BaseIntegrator):
+            self._cpp_obj.setObservableIntegrator(observable._cpp_obj,
+                                                  self.quantity)
+        else:
+            self._cpp_obj.setObservableCompute(observable._cpp_obj,
+                                               self.quantity)
+
+    def _getattr_param(self, attr):
+        # the parameters other than kT are fixed at construction of the C++
+        # object
+        if self._attached and attr == 'kT':
+            return self._cpp_obj.kT
+        return self._param_dict[attr]
+
+    def _setattr_param(self, attr, value):
+        if self._attached and attr != 'kT':
+            raise AttributeError("{} cannot be set after cpp"
+                                 " initialization".format(attr))
+        super()._setattr_param(attr, value)
+
+    def _update_param_dict(self):
+        self._param_dict['kT'] = self._cpp_obj.kT
+
+    def reset_statistics(self):
+        """Reset the exchange counters."""
+        if self._attached:
+            self._cpp_obj.resetStats()
+
+    @log
+    def index(self):
+        """int: Index of the value of the replica on this partition."""
+        if not self._attached:
+            return None
+        return self._cpp_obj.index
+
+    @log
+    def value(self):
+        """float: Value of the replica on this partition."""
+        if not self._attached:
+            return None
+        return self._cpp_obj.value
+
+    @log(category='sequence')
+    def num_attempted(self):
+        """list[int]: Attempted swaps between ``values[k]`` and \
+        ``values[k+1]``."""
+        if not self._attached:
+            return None
+        return self._cpp_obj.num_attempted
+
+    @log(category='sequence')
+    def num_accepted(self):
+        """list[int]: Accepted swaps between ``values[k]`` and \
+        ``values[k+1]``."""
+        if not self._attached:
+            return None
+        return self._cpp_obj.num_accepted
+
+    @log(category='sequence')
+    def acceptance(self):
+        """list[float]: Fraction of accepted swaps between ``values[k]`` and \
+        ``values[k+1]``.
+
+        Pairs without attempts report 0.
+        """
+        if not self._attached:
+            return None
+        return [accepted / attempted if attempted > 0 else 0.0
+                for accepted, attempted in zip(self._cpp_obj.num_accepted,
+                                               self._cpp_obj.num_attempted)]
@@ -166,3 +166,35 @@ class Power(_hoomd.VariantPower, Variant):
     def __init__(self, A, B, power, t_start, t_ramp):
         Variant.__init__(self)
         _hoomd.VariantPower.__init__(self, A, B, power, t_start, t_ramp)
+
+
+class Expression(_hoomd.VariantExpression, Variant):
+    """A formula of the time step evaluated in C++.
+
+    Args:
+        expression (str): The formula in the time step ``t``.
+        min (float): The minimum value of the formula.
+        max (float): The maximum value of the formula.
+
+    :py:class:`Expression` compiles *expression* once, and evaluates it on
+    each time step without calling Python. The formula uses Python syntax with
+    the operators ``+``, ``-``, ``*``, ``/``, ``%``, ``**``, the comparisons,
+    ``and``, ``or``, ``not``, the constant ``pi``, and the functions ``sin``,
+    ``cos``, ``tan``, ``exp``, ``log``, ``sqrt``, ``abs``, ``floor``,
+    ``ceil``, ``min(a, b)``, ``max(a, b)``, ``pow(a, b)``, and
+    ``clip(x, lo, hi)``. Comparisons and logical operators evaluate to 1 or 0.
+
+    *min* and *max* must bound the values of *expression*.
+
+    .. code-block:: python
+
+        kT = hoomd.variant.Expression('1.5 + 0.5 * sin(2 * pi * t / 1000)',
+                                      min=1.0, max=2.0)
+
+    Attributes:
+        expression (str): The formula in the time step ``t``.
+    """
+
+    def __init__(self, expression, min, max):
+        Variant.__init__(self)
+        _hoomd.VariantExpression.__init__(self, expression, min, max)
@@ -1,3 +1,6 @@
 from hoomd.write.custom_writer import CustomWriter
 from hoomd.write.gsd import GSD
 from hoomd.write.table import Table
+from hoomd.write.log_buffer import LogBuffer
+from hoomd.write.checkpoint import Checkpoint
+from hoomd.write.in_situ import InSitu
@@ -0,0 +1,84 @@
+# Copyright (c) 2009-2020 The Regents of the University of Michigan This file is
+# part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+"""Write checkpoints to continue simulations."""
+
+from hoomd.filter import All
+from hoomd.write.gsd import GSD
+
+
+class Checkpoint(GSD):
+    """Write checkpoints to continue simulations.
+
+    Args:
+        filename (str): File name to write.
+        trigger (hoomd.trigger.Trigger): Select the timesteps to write.
+        async_queue_depth (int): Maximum number of checkpoints waiting to be
+            written by a background thread. Set to 0 to write checkpoints
+            synchronously. Defaults to 1.
+        parallel_io (bool): When `True`, write the particle data from all MPI
+            ranks in parallel. Defaults to `False`.
+
+    `Checkpoint` writes a GSD file with a single frame that holds all
+    particle and topology data of the system, together with the variables of
+    the integration methods, such as the thermostat and barostat degrees of
+    freedom of `hoomd.md.methods.NVT` and `hoomd.md.methods.NPT`. It writes
+    each checkpoint to the file *filename* with the suffix ``.tmp`` and then
+    renames it to *filename*, which atomically replaces the previous
+    checkpoint. A simulation that stops while writing a checkpoint leaves
+    the previous checkpoint intact.
+
+    To continue the simulation, pass the checkpoint to
+    `hoomd.Simulation.create_state_from_gsd` and add the same integration
+    methods in the same order as in the simulation that wrote it. The
+    integration methods continue with the stored variables at the start of
+    the next `hoomd.Simulation.run`, which take precedence over the values of
+    parameters such as ``translational_thermostat_dof``. Random numbers in
+    HOOMD-blue depend only on the seeds of the operations and the timestep,
+    which the checkpoint stores, so they continue when the same seeds are
+    given.
+
+    With ``async_queue_depth`` greater than 0, a background thread writes the
+    checkpoints while the simulation continues, see `GSD`. In MPI
+    simulations, ``parallel_io=True`` writes the particle data of each rank
+    directly to the checkpoint, and ``create_state_from_gsd`` with
+    ``parallel_io=True`` reads it back on each rank. Set
+    ``async_queue_depth=0`` to use ``parallel_io``.
+
+    Note:
+        GSD files store positions and velocities in single precision.
+        Continuation is bitwise identical in single precision builds of
+        HOOMD-blue.
+
+    Example::
+
+        checkpoint = hoomd.write.Checkpoint(
+            filename='restart.gsd', trigger=hoomd.trigger.Periodic(10000))
+        sim.operations.writers.append(checkpoint)
+
+    Attributes:
+        filename (str): File name to write.
+        trigger (hoomd.trigger.Trigger): Select the timesteps to write.
+        async_queue_depth (int): Maximum number of checkpoints waiting to be
+            written by a background thread.
+        parallel_io (bool): When `True`, write the particle data from all MPI
+            ranks in parallel.
+    """
+
+    def __init__(self,
+                 filename,
+                 trigger,
+                 async_queue_depth=1,
+                 parallel_io=False):
+        super().__init__(filename,
+                         trigger,
+                         filter=All(),
+                         mode='wb',
+                         dynamic=['attribute', 'momentum', 'topology'],
+                         async_queue_depth=async_queue_depth,
+                         parallel_io=parallel_io)
+
+    def _attach(self):
+        super()._attach()
+        self._cpp_obj.atomic = True
+        self._cpp_obj.integrator_state = True
@@ -6,7 +6,7 @@
 from collections.abc import Mapping, Collection
 from hoomd import _hoomd
 from hoomd.util import dict_flatten, array_to_strings
-from hoomd.data.typeconverter import OnlyFrom, RequiredArg
+from hoomd.data.typeconverter import OnlyFrom, OnlyType, RequiredArg
 from hoomd.filter import ParticleFilter, All
 from hoomd.data.parameterdicts import ParameterDict
 from hoomd.logging import Logger, LoggerCategories
@@ -30,6 +30,16 @@ class GSD(Writer):
             Defaults to ``['property']``.
         log (hoomd.logging.Logger): Provide log quantities to write. Defaults to
             `None`.
+        async_queue_depth (int): Maximum number of frames waiting to be
+            written by a background thread. Set to 0 to write frames
+            synchronously. Defaults to 0.
+        parallel_io (bool): When `True`, write the particle data from all MPI
+            ranks in parallel. Defaults to `False`.
+        quantize (bool): When `True`, store positions and orientations as 16-bit
+            fixed point numbers. Defaults to `False`.
+        region (tuple): Write only the selected particles inside the
+            axis-aligned region given by a ``(lower, upper)`` tuple of corners.
+            Defaults to `None`, which writes all selected particles.
 
     `GSD` writes a simulation snapshot to the specified file each time it
     triggers. `GSD` can store all particle, bond, angle, dihedral, improper,
@@ -121,6 +131,65 @@ class GSD(Writer):
         to `None` or remove specific quantities from the logger, but do not
         add additional quantities after the first frame.
 
+    .. rubric:: Asynchronous output
+
+    When ``async_queue_depth`` is greater than 0, `GSD` copies each frame into
+    a staging buffer and a background thread writes it to the file while the
+    simulation continues. The simulation waits only when
+    ``async_queue_depth`` frames are already waiting to be written. Each
+    queued frame holds a copy of the written data in memory. `GSD` writes all
+    queued frames before `hoomd.Simulation.run` returns. Errors that occur
+    while writing a frame are raised on a later time step or at the end of the
+    run.
+
+    Note:
+        `GSD` writes frames synchronously when other operations store state
+        information in the file (for example, HPMC shape specifications).
+
+    .. rubric:: Parallel output
+
+    By default, `GSD` gathers all particles to MPI rank 0, which writes the
+    file. With ``parallel_io=True``, every rank writes the particle data of
+    its own domain directly to the file with collective MPI-IO, so the memory
+    needed on rank 0 does not grow with the system size. The file is an
+    ordinary GSD file. Parallel output applies when `filter` selects all
+    particles and the particle tags are contiguous, otherwise `GSD` gathers
+    the particles. Bonds and other topology data are always gathered. Use
+    parallel output on a parallel file system, and do not combine it with
+    ``async_queue_depth``.
+
+    .. rubric:: Subset output
+
+    When ``filter`` selects only part of the system or ``region`` is set,
+    each MPI rank selects its own particles before any communication and only
+    the selected particles are sent to rank 0. Particles that are not written
+    are never gathered, so writing a small part of a large system at a high
+    frequency is inexpensive.
+
+    With ``region``, `GSD` writes the selected particles whose positions
+    :math:`\vec{r}` satisfy ``lower <= r < upper`` in every component. The
+    particles inside the region change from frame to frame, so `GSD` writes all
+    **attribute**, **property**, and **momentum** quantities in every frame and
+    stores the tags of the written particles in the ``log/particles/tag``
+    chunk. Per-particle log quantities are not restricted to the region.
+
+    .. rubric:: Quantized output
+
+    With ``quantize=True``, `GSD` stores positions as 16-bit fractional
+    coordinates of the box in the ``particles/quantized/position`` chunk and
+    orientation quaternion components as 16-bit fixed point numbers in the
+    ``particles/quantized/orientation`` chunk, in place of
+    ``particles/position`` and ``particles/orientation``. This halves the
+    space taken by these chunks. The position error is at most
+    :math:`L/2^{17}` along each box vector of length :math:`L`, and the error
+    in each quaternion component is at most :math:`1/65534`.
+    `hoomd.Simulation.create_state_from_gsd` decodes quantized chunks.
+
+    Warning:
+        Other GSD readers (such as the ``gsd`` Python package and
+        visualization tools) do not decode quantized chunks. Quantized files are
+        not suitable for exact restarts.
+
     Attributes:
         filename (str): File name to write.
         trigger (hoomd.trigger.Trigger): Select the timesteps to write.
@@ -129,6 +198,14 @@ class GSD(Writer):
         truncate (bool): When `True`, truncate the file and write a new frame 0
             each time this operation triggers.
         dynamic (list[str]): Quantity categories to save in every frame.
+        async_queue_depth (int): Maximum number of frames waiting to be
+            written by a background thread.
+        parallel_io (bool): When `True`, write the particle data from all MPI
+            ranks in parallel.
+        quantize (bool): When `True`, store positions and orientations as 16-bit
+            fixed point numbers.
+        region (tuple): Write only the selected particles inside the
+            axis-aligned region given by a ``(lower, upper)`` tuple of corners.
     """
 
     def __init__(self,
@@ -138,7 +215,11 @@ class GSD(Writer):
                  mode='ab',
                  truncate=False,
                  dynamic=None,
-                 log=None):
+                 log=None,
+                 async_queue_depth=0,
+                 parallel_io=False,
+                 quantize=False,
+                 region=None):
 
         super().__init__(trigger)
 
@@ -153,7 +234,15 @@ class GSD(Writer):
                           mode=str(mode),
                           truncate=bool(truncate),
                           dynamic=[dynamic_validation],
-                          _defaults=dict(filter=filter, dynamic=dynamic)))
+                          async_queue_depth=int(async_queue_depth),
+                          parallel_io=bool(parallel_io),
+                          quantize=bool(quantize),
+                          region=OnlyType(tuple,
+                                          preprocess=_to_region,
+                                          allow_none=True),
+                          _defaults=dict(filter=filter,
+                                         dynamic=dynamic,
+                                         region=region)))
 
         self._log = None if log is None else _GSDLogWriter(log)
 
@@ -173,7 +262,7 @@ class GSD(Writer):
         self._cpp_obj = _hoomd.GSDDumpWriter(
             self._simulation.state._cpp_sys_def, self.filename,
             self._simulation.state._get_group(self.filter), self.mode,
-            self.truncate)
+            self.truncate, self.async_queue_depth)
 
         self._cpp_obj.setWriteAttribute('attribute' in dynamic_quantities)
         self._cpp_obj.setWriteProperty('property' in dynamic_quantities)
@@ -183,7 +272,12 @@ class GSD(Writer):
         super()._attach()
 
     @staticmethod
-    def write(state, filename, filter=All(), mode='wb', log=None):
+    def write(state,
+              filename,
+              filter=All(),
+              mode='wb',
+              log=None,
+              parallel_io=False):
         """Write the given simulation state out to a GSD file.
 
         Args:
@@ -192,6 +286,8 @@ class GSD(Writer):
             filter (`hoomd.filter.ParticleFilter`): Select the particles to write.
             mode (str): The file open mode. Defaults to ``'wb'``.
             log (`hoomd.logging.Logger`): Provide log quantities to write.
+            parallel_io (bool): When `True`, write the particle data from all
+                MPI ranks in parallel.
 
         The valid file modes for `write` are ``'wb'`` and ``'xb'``.
         """
@@ -199,7 +295,8 @@ class GSD(Writer):
             raise ValueError(f"Invalid GSD.write file mode: {mode}")
 
         writer = _hoomd.GSDDumpWriter(state._cpp_sys_def, filename,
-                                      state._get_group(filter), mode, False)
+                                      state._get_group(filter), mode, False, 0)
+        writer.parallel_io = parallel_io
 
         if log is not None:
             writer.log_writer = _GSDLogWriter(log)
@@ -224,6 +321,16 @@ class GSD(Writer):
         self._log = log
 
 
+def _to_region(region):
+    """Convert a pair of corners to a tuple of two 3-tuples of floats."""
+    lower, upper = region
+    lower = tuple(float(x) for x in lower)
+    upper = tuple(float(x) for x in upper)
+    if len(lower) != 3 or len(upper) != 3:
+        raise ValueError("region corners must have 3 components.")
+    return (lower, upper)
+
+
 def _iterable_is_incomplete(iterable):
     """Checks that any nested attribute has no instances of RequiredArg.
 
@@ -277,6 +384,11 @@ class _GSDLogWriter:
     def __init__(self, logger):
         self.logger = logger
 
+    @property
+    def flags(self):
+        """`list` of `int`: The flags the logged quantities require."""
+        return self.logger.flags
+
     def log(self):
         """Get the flattened dictionary for consumption by GSD object."""
         log = dict()
@@ -0,0 +1,93 @@
+# Copyright (c) 2009-2020 The Regents of the University of Michigan This file is
+# part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+"""Pass copies of the particle data to in-situ analysis callbacks."""
+
+from hoomd import _hoomd
+from hoomd.device import GPU
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.operation import Writer
+import numpy as np
+
+
+class InSitu(Writer):
+    """Pass staged copies of the local particle data to a callback.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to stage.
+        callback (callable): Function to call with the timestep and the
+            staged arrays.
+        queue_depth (int): Number of newer frames to stage before the
+            callback receives a frame. Defaults to 1.
+
+    `hoomd.State.gpu_local_snapshot` provides the particle data on the GPU
+    only inside a context manager that the simulation waits for. `InSitu`
+    instead copies the positions, velocities, images, and tags of the local
+    particles into staging buffers each time it triggers and continues the
+    simulation. On the GPU, the copies run on a separate stream and do not
+    block the host.
+
+    ``callback(timestep, arrays)`` receives a frame after ``queue_depth``
+    newer frames have been staged, or at the end of each
+    `hoomd.Simulation.run`, so the simulation has already continued and the
+    copies are complete. Frames arrive in order. *arrays* is a dict with the
+    keys ``'position'``, ``'typeid'``, ``'velocity'``, ``'mass'``,
+    ``'image'``, and ``'tag'``. The arrays are read only views of the
+    staging buffers, which are not copied again:
+
+    * On the GPU, each value implements the ``__cuda_array_interface__``
+      and can be passed to CuPy, Numba, or PyTorch, for example with
+      ``cupy.asarray``.
+    * On the CPU, each value is a `numpy.ndarray`.
+
+    The arrays are valid only until *callback* returns. Copy the data that
+    the analysis keeps. With ``queue_depth=0``, *callback* receives each frame
+    on the step it is staged.
+
+    In MPI simulations, *callback* receives the local particles of each rank
+    on that rank.
+
+    Example::
+
+        def analyze(timestep, arrays):
+            position = cupy.asarray(arrays['position'])
+            ...
+
+        in_situ = hoomd.write.InSitu(trigger=hoomd.trigger.Periodic(100),
+                                     callback=analyze)
+        sim.operations.writers.append(in_situ)
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to stage.
+        queue_depth (int): Number of newer frames to stage before the
+            callback receives a frame.
+    """
+
+    def __init__(self, trigger, callback, queue_depth=1):
+        super().__init__(trigger)
+        self._param_dict.update(ParameterDict(queue_depth=int(queue_depth)))
+        self._callback = callback
+
+    def _attach(self):
+        self._on_gpu = isinstance(self._simulation.device, GPU)
+        self._cpp_obj = _hoomd.ParticleDataStager(
+            self._simulation.state._cpp_sys_def, self.queue_depth,
+            self._consume)
+        super()._attach()
+
+    def _consume(self, timestep, buffers):
+        if self._on_gpu:
+            arrays = dict(buffers)
+        else:
+            arrays = {
+                name: np.asarray(buffer) for name, buffer in buffers.items()
+            }
+        self._callback(timestep, arrays)
+
+    @property
+    def callback(self):
+        """callable: Function to call with the timestep and the staged arrays.
+
+        Read only.
+        """
+        return self._callback
@@ -0,0 +1,129 @@
+# Copyright (c) 2009-2020 The Regents of the University of Michigan This file is
+# part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+"""Buffer scalar log quantities in C++ and write them in bulk."""
+
+from hoomd import _hoomd
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyFrom, OnlyType
+from hoomd.operation import Writer
+import numpy as np
+
+
+class LogBuffer(Writer):
+    """Sample scalar quantities into a buffer and write them in bulk.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to sample.
+        quantities (dict): Map column names to ``(operation, quantity)``
+            tuples.
+        filename (str): File name to write. When `None`, only buffer the
+            samples for `read`. Defaults to `None`.
+        buffer_size (int): Number of samples to buffer. Defaults to 1000.
+        delimiter (str): String placed between columns in the file. Defaults
+            to ``' '``.
+        mode (str): ``'w'`` to overwrite an existing file, ``'a'`` to append to
+            it. Defaults to ``'a'``.
+
+    `hoomd.write.Table` evaluates every loggable property of its
+    `hoomd.logging.Logger` in Python and writes a line of text each time it
+    triggers. `LogBuffer` samples the quantities in C++ without calling into
+    Python and stores them in a buffer of ``buffer_size`` rows that is
+    allocated once.
+
+    Each ``quantity`` is the name of a log quantity that the C++ object of
+    ``operation`` provides, such as ``'potential_energy'`` or ``'pressure'``
+    for `hoomd.md.compute.ThermodynamicQuantities`. `LogBuffer` raises an
+    exception listing the available names when ``operation`` does not provide
+    ``quantity``. The operations must be part of the simulation's operations.
+
+    When ``filename`` is set, `LogBuffer` writes all buffered rows to the file
+    at once when the buffer is full and at the end of every
+    `hoomd.Simulation.run`. The first column is the timestep. When
+    ``filename`` is `None`, the buffer keeps the most recent ``buffer_size``
+    samples, and `read` returns and removes them, for example to write them to
+    a GSD or HDF5 file in bulk.
+
+    Example::
+
+        thermo = hoomd.md.compute.ThermodynamicQuantities(
+            filter=hoomd.filter.All())
+        sim.operations.computes.append(thermo)
+        log_buffer = hoomd.write.LogBuffer(
+            trigger=hoomd.trigger.Periodic(100),
+            quantities={'pe': (thermo, 'potential_energy'),
+                        'p': (thermo, 'pressure')},
+            filename='log.txt')
+        sim.operations.writers.append(log_buffer)
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to sample.
+        filename (str): File name to write.
+        buffer_size (int): Number of samples to buffer.
+        delimiter (str): String placed between columns in the file.
+        mode (str): ``'w'`` to overwrite an existing file, ``'a'`` to append to
+            it.
+    """
+
+    def __init__(self,
+                 trigger,
+                 quantities,
+                 filename=None,
+                 buffer_size=1000,
+                 delimiter=' ',
+                 mode='a'):
+
+        super().__init__(trigger)
+
+        self._param_dict.update(
+            ParameterDict(filename=OnlyType(str, allow_none=True),
+                          buffer_size=int(buffer_size),
+                          delimiter=str(delimiter),
+                          mode=OnlyFrom(['w', 'a']),
+                          _defaults=dict(filename=filename, mode=mode)))
+
+        self._quantities = dict(quantities)
+
+    def _attach(self):
+        filename = '' if self.filename is None else self.filename
+        self._cpp_obj = _hoomd.LogBuffer(self._simulation.state._cpp_sys_def,
+                                         self.buffer_size, filename,
+                                         self.delimiter, self.mode == 'w')
+
+        for name, (operation, quantity) in self._quantities.items():
+            if not operation._attached:
+                raise RuntimeError(
+                    "Add the operation that provides {} to the simulation "
+                    "before LogBuffer.".format(name))
+            self._cpp_obj.addQuantity(name, operation._cpp_obj, quantity)
+
+        super()._attach()
+
+    @property
+    def quantities(self):
+        """dict: Map column names to ``(operation, quantity)`` tuples.
+
+        Read only.
+        """
+        return dict(self._quantities)
+
+    def read(self):
+        """Remove the buffered samples and return them.
+
+        Returns:
+            dict[str, numpy.ndarray]: The timesteps of the samples under the key
+            ``'timestep'`` and the values of each quantity under its column
+            name, oldest sample first.
+        """
+        if not self._attached:
+            raise RuntimeError("LogBuffer must be attached to read samples.")
+
+        timesteps, values = self._cpp_obj.getSamples()
+        names = self._cpp_obj.getNames()
+        values = np.array(values, dtype=np.float64).reshape(
+            (len(timesteps), len(names)))
+
+        samples = {'timestep': np.array(timesteps, dtype=np.uint64)}
+        for i, name in enumerate(names):
+            samples[name] = values[:, i]
+        return samples
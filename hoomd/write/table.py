@@ -197,6 +197,11 @@ class _TableInternal(_InternalAction):
         """Makes self._param_dict attributes read only."""
         raise ValueError("Attribute {} is read-only.".format(attr))
 
+    @property
+    def flags(self):
+        """`list` of `int`: The flags the logged quantities require."""
+        return self.logger.flags
+
     def attach(self, simulation):
         self._comm = simulation.device._comm
 